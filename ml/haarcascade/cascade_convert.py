@@ -306,50 +306,27 @@ def cascade_binary_old(path, n_stages, name):
     print("rectangles:%d"%n_rectangles)
     print("binary cascade generated")
 
-def cascade_header(path, n_stages, name):
-    #parse xml file
+def cascade_header_universal(path, n_stages, name):
     xmldoc = minidom.parse(path)
+    old_format = xmldoc.getElementsByTagName('stageNum').length == 0
+    if old_format:
+        print("Converting old XML format..")
+        cascade_header_old(path, n_stages, name)
+    else:
+        print("Converting new XML format..")
+        cascade_header(path, n_stages, name)
 
-    trees = xmldoc.getElementsByTagName('trees')
-    max_stages = len(trees)
-    if n_stages > max_stages:
-        raise Exception("The max number of stages is: %d"%(max_stages))
-
-    if n_stages == 0:
-        n_stages = max_stages
-
-    # read stages
-    stages = [len(t.childNodes)/2 for t in trees][0:n_stages]
-    stage_threshold = xmldoc.getElementsByTagName('stage_threshold')[0:n_stages]
-
-    # total number of features
+def write_header(name, size, stages, stage_threshold, threshold, alpha1, alpha2, rects):
+    # rects is a list of [x, y, w, h, weight] lists per feature.
+    # The tables and the descriptor are const so the cascade stays in flash and
+    # imlib_load_cascade() only has to point at them.
     n_features = sum(stages)
-
-    # read features threshold
-    threshold = xmldoc.getElementsByTagName('threshold')[0:n_features]
-
-    # theres one of each per feature
-    alpha1 = xmldoc.getElementsByTagName('left_val')[0:n_features]
-    alpha2 = xmldoc.getElementsByTagName('right_val')[0:n_features]
-
-    # read rectangles
-    feature = xmldoc.getElementsByTagName('rects')[0:n_features]
-
-    # read cascade size
-    size = list(map(int, xmldoc.getElementsByTagName('size')[0].childNodes[0].nodeValue.split()))
-
-    # open output file with the specified name or xml file name
-    if not name:
-        name = os.path.basename(path).split('.')[0]
+    n_rectangles = sum(len(r) for r in rects)
     fout = open(name+".h", "w")
-
-    n_rectangles = 0
-    for f in feature:
-        rects = f.getElementsByTagName('_')
-        n_rectangles = n_rectangles + len(rects)
+    fout.write("// *INDENT-OFF*\n")
 
     # write detection window size
-    fout.write("const int %s_window_w=%d;\n" %( name, size[0]))
+    fout.write("const int %s_window_w=%d;\n" %(name, size[0]))
     fout.write("const int %s_window_h=%d;\n" %(name, size[1]))
 
     # write num stages
@@ -361,34 +338,40 @@ def cascade_header(path, n_stages, name):
 
     # write stages thresholds
     fout.write("const int16_t %s_stages_thresh_array[]={%s};\n"
-            %(name, ", ".join(str(int(float(t.childNodes[0].nodeValue)*256)) for t in stage_threshold)))
+            %(name, ", ".join(str(int(t*256)) for t in stage_threshold)))
 
     # write features threshold 1 per feature
     fout.write("const int16_t %s_tree_thresh_array[]={%s};\n"
-            %(name, ", ".join(str(int(float(t.childNodes[0].nodeValue)*4096)) for t in threshold)))
+            %(name, ", ".join(str(int(t*4096)) for t in threshold)))
 
     # write alpha1 1 per feature
     fout.write("const int16_t %s_alpha1_array[]={%s};\n"
-            %(name, ", ".join(str(int(float(t.childNodes[0].nodeValue)*256)) for t in alpha1)))
+            %(name, ", ".join(str(int(a*256)) for a in alpha1)))
 
     # write alpha2 1 per feature
     fout.write("const int16_t %s_alpha2_array[]={%s};\n"
-            %(name, ", ".join(str(int(float(t.childNodes[0].nodeValue)*256)) for t in alpha2)))
+            %(name, ", ".join(str(int(a*256)) for a in alpha2)))
 
     # write num_rects per feature
     fout.write("const int8_t %s_num_rectangles_array[]={%s};\n"
-            %(name, ", ".join(str(len(f.getElementsByTagName('_'))) for f in feature)))
+            %(name, ", ".join(str(len(r)) for r in rects)))
 
     # write rects weights 1 per rectangle
-    rect_weights = lambda rects:", ".join(r.childNodes[0].nodeValue[:-1].split()[4] for r in rects)
     fout.write("const int8_t %s_weights_array[]={%s};\n"
-            %(name, ", ".join(rect_weights(f.getElementsByTagName('_')) for f in feature)))
-
+            %(name, ", ".join(str(l[4]) for r in rects for l in r)))
 
     # write rects
-    rect = lambda rects:", ".join(", ".join(r.childNodes[0].nodeValue.split()[:-1]) for r in rects)
     fout.write("const int8_t %s_rectangles_array[]={%s};\n"
-            %(name, ", ".join(rect(f.getElementsByTagName('_')) for f in feature)))
+            %(name, ", ".join(", ".join(str(x) for x in l[:4]) for r in rects for l in r)))
+
+    # write the cascade descriptor
+    arrays = ["stages_array", "stages_thresh_array", "tree_thresh_array", "alpha1_array",
+              "alpha2_array", "num_rectangles_array", "weights_array", "rectangles_array"]
+    fout.write("const haar_cascade_rom_t %s_cascade={\"%s\", %d, %d, %d, %d, %d, %s};\n"
+            %(name, name, size[0], size[1], len(stages), n_features, n_rectangles,
+              ", ".join("%s_%s"%(name, a) for a in arrays)))
+    fout.write("// *INDENT-ON*\n")
+    fout.close()
 
     # print cascade info
     print("size:%dx%d"%(size[0], size[1]))
@@ -397,13 +380,109 @@ def cascade_header(path, n_stages, name):
     print("rectangles:%d"%n_rectangles)
     print("C header cascade generated")
 
+def cascade_header(path, n_stages, name):
+    #parse xml file
+    xmldoc = minidom.parse(path)
+
+    max_stages = int(xmldoc.getElementsByTagName('stageNum')[0].childNodes[0].nodeValue)
+    if n_stages > max_stages:
+        raise Exception("The max number of stages is: %d"%(max_stages))
+
+    if n_stages == 0:
+        n_stages = max_stages
+
+    # read stages
+    stages_elements = xmldoc.getElementsByTagName('stages')
+    stages = []
+    for node in stages_elements[0].childNodes:
+        if node.nodeType == 1:
+            stages.append(int(node.getElementsByTagName('maxWeakCount')[0].childNodes[0].nodeValue))
+    stages = stages[0:n_stages]
+    stage_threshold = xmldoc.getElementsByTagName('stageThreshold')[0:n_stages]
+
+    # total number of features
+    n_features = sum(stages)
+
+    # read features threshold and leaf values, one of each per feature
+    internal_nodes = xmldoc.getElementsByTagName('internalNodes')[0:n_features]
+    leaf_values = xmldoc.getElementsByTagName('leafValues')[0:n_features]
+
+    # read rectangles
+    feature = xmldoc.getElementsByTagName('rects')
+
+    # read cascade size
+    size = [int(xmldoc.getElementsByTagName('width')[0].childNodes[0].nodeValue), int(xmldoc.getElementsByTagName('height')[0].childNodes[0].nodeValue)]
+
+    # open output file with the specified name or xml file name
+    if not name:
+        name = os.path.basename(path).split('.')[0]
+
+    rects = []
+    for f in internal_nodes:
+        idx = int(f.childNodes[0].nodeValue.split()[2])
+        rects.append([list(map(int, r.childNodes[0].nodeValue[:-1].split()))
+                      for r in feature[idx].getElementsByTagName('_')])
+
+    write_header(name, size, stages,
+                 [float(t.childNodes[0].nodeValue) for t in stage_threshold],
+                 [float(t.childNodes[0].nodeValue.split()[3]) for t in internal_nodes],
+                 [float(v.childNodes[0].nodeValue.split()[0]) for v in leaf_values],
+                 [float(v.childNodes[0].nodeValue.split()[1]) for v in leaf_values],
+                 rects)
+
+def cascade_header_old(path, n_stages, name):
+    #parse xml file
+    xmldoc = minidom.parse(path)
+
+    trees = xmldoc.getElementsByTagName('trees')
+    max_stages = len(trees)
+    if n_stages > max_stages:
+        raise Exception("The max number of stages is: %d"%(max_stages))
+
+    if n_stages == 0:
+        n_stages = max_stages
+
+    # read stages
+    stages = [len(t.childNodes)//2 for t in trees][0:n_stages]
+    stage_threshold = xmldoc.getElementsByTagName('stage_threshold')[0:n_stages]
+
+    # total number of features
+    n_features = sum(stages)
+
+    # read features threshold
+    threshold = xmldoc.getElementsByTagName('threshold')[0:n_features]
+
+    # theres one of each per feature
+    alpha1 = xmldoc.getElementsByTagName('left_val')[0:n_features]
+    alpha2 = xmldoc.getElementsByTagName('right_val')[0:n_features]
+
+    # read rectangles
+    feature = xmldoc.getElementsByTagName('rects')[0:n_features]
+
+    # read cascade size
+    size = list(map(int, xmldoc.getElementsByTagName('size')[0].childNodes[0].nodeValue.split()))
+
+    # open output file with the specified name or xml file name
+    if not name:
+        name = os.path.basename(path).split('.')[0]
+
+    rects = [[list(map(int, r.childNodes[0].nodeValue[:-1].split())) for r in f.getElementsByTagName('_')]
+             for f in feature]
+
+    write_header(name, size, stages,
+                 [float(t.childNodes[0].nodeValue) for t in stage_threshold],
+                 [float(t.childNodes[0].nodeValue) for t in threshold],
+                 [float(a.childNodes[0].nodeValue) for a in alpha1],
+                 [float(a.childNodes[0].nodeValue) for a in alpha2],
+                 rects)
+
 def main():
     # CMD args parser
     parser = argparse.ArgumentParser(description='haar cascade generator')
     parser.add_argument("-i", "--info",     action = "store_true",  help = "print cascade info and exit")
     parser.add_argument("-n", "--name",     action = "store",       help = "set cascade name", default = "")
     parser.add_argument("-s", "--stages",   action = "store",       help = "set the maximum number of stages", type = int, default=0)
-    parser.add_argument("-c", "--header",   action = "store_true",  help = "generate a C header")
+    parser.add_argument("-c", "--header",   action = "store_true",  help = "generate a C header to build the cascade into the firmware")
     parser.add_argument("file", action = "store", help = "OpenCV xml cascade file path")
 
     # Parse CMD args
@@ -416,7 +495,7 @@ def main():
 
     if args.header:
         # generate a C header from the xml cascade
-        cascade_header(args.file, args.stages, args.name)
+        cascade_header_universal(args.file, args.stages, args.name)
         return
 
     # generate a binary cascade from the xml cascade
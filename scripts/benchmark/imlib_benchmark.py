@@ -0,0 +1,130 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# imlib Benchmark
+#
+# This script measures the throughput of imlib kernels across pixel formats and
+# resolutions and prints one CSV line per kernel. The synthetic test pattern is
+# drawn into the frame buffer so results don't depend on the attached sensor.
+#
+# Run it from the IDE, or with tools/pyopenmv_benchmark.py to record a report and
+# compare it against a previous one.
+
+import image
+import machine
+import omv
+import time
+
+RUNS = 3
+
+SIZES = (
+    ("QQVGA", 160, 120),
+    ("QVGA", 320, 240),
+    ("VGA", 640, 480),
+)
+
+FORMATS = (
+    ("GRAYSCALE", image.GRAYSCALE),
+    ("RGB565", image.RGB565),
+    ("BAYER", image.BAYER),
+)
+
+GRAYSCALE_THRESHOLDS = [(128, 255)]
+RGB565_THRESHOLDS = [(30, 100, 15, 127, 15, 127)]
+
+
+def thresholds(img):
+    return GRAYSCALE_THRESHOLDS if img.format() == image.GRAYSCALE else RGB565_THRESHOLDS
+
+
+# name, supported formats, max width, kernel
+KERNELS = (
+    ("find_blobs", ("GRAYSCALE", "RGB565"), 640,
+     lambda img: img.find_blobs(thresholds(img), pixels_threshold=10)),
+    ("binary", ("GRAYSCALE", "RGB565"), 640,
+     lambda img: img.binary(thresholds(img))),
+    ("erode", ("GRAYSCALE", "RGB565"), 640,
+     lambda img: img.erode(1)),
+    ("mean", ("GRAYSCALE", "RGB565"), 640,
+     lambda img: img.mean(1)),
+    ("median", ("GRAYSCALE", "RGB565"), 640,
+     lambda img: img.median(1)),
+    ("gaussian", ("GRAYSCALE", "RGB565"), 640,
+     lambda img: img.gaussian(1)),
+    ("get_histogram", ("GRAYSCALE", "RGB565"), 640,
+     lambda img: img.get_histogram()),
+    ("to_grayscale", ("RGB565", "BAYER"), 640,
+     lambda img: img.to_grayscale(copy=True)),
+    ("to_rgb565", ("GRAYSCALE", "BAYER"), 640,
+     lambda img: img.to_rgb565(copy=True)),
+    ("jpeg_compress", ("GRAYSCALE", "RGB565", "BAYER"), 640,
+     lambda img: img.to_jpeg(quality=90, copy=True)),
+    ("find_apriltags", ("GRAYSCALE",), 320,
+     lambda img: img.find_apriltags()),
+)
+
+
+def cpu_hz():
+    f = machine.freq()
+    return f[0] if isinstance(f, tuple) else f
+
+
+def draw_pattern(img):
+    # Deterministic content with edges, blobs and flat regions.
+    img.clear()
+    w = img.width()
+    h = img.height()
+    for i in range(8):
+        x = (i * w) // 8
+        img.draw_rectangle(x, 0, w // 16, h, color=(i * 32, 255 - i * 32, 128), fill=True)
+    for i in range(4):
+        img.draw_circle((i * 2 + 1) * w // 8, h // 2, h // 8, color=(255, 64, 64), fill=True)
+    img.draw_line(0, 0, w - 1, h - 1, color=(255, 255, 255), thickness=3)
+
+
+def run(kernel, img, pattern):
+    best = None
+    buf = img.bytearray()
+    for i in range(RUNS):
+        buf[:] = pattern
+        t = time.ticks_us()
+        kernel(img)
+        t = time.ticks_diff(time.ticks_us(), t)
+        best = t if best is None else min(best, t)
+    return best
+
+
+def main():
+    hz = cpu_hz()
+    print("# board=%s arch=%s version=%s cpu_hz=%d runs=%d" %
+          (omv.board_type(), omv.arch(), omv.version_string(), hz, RUNS))
+    print("kernel,format,size,us,cycles_per_pixel")
+    for size_name, w, h in SIZES:
+        for fmt_name, fmt in FORMATS:
+            try:
+                # The frame buffer is used for the test image to support large resolutions.
+                img = image.Image(w, h, image.GRAYSCALE if fmt == image.BAYER else fmt, copy_to_fb=True)
+                draw_pattern(img)
+                if fmt == image.BAYER:
+                    # Reinterpret the grayscale pattern as raw bayer data.
+                    img = image.Image(w, h, image.BAYER, buffer=img.bytearray())
+                pattern = bytes(img.bytearray())
+            except MemoryError:
+                print("# skipped %s %s: out of memory" % (fmt_name, size_name))
+                continue
+            for name, formats, max_w, kernel in KERNELS:
+                if fmt_name not in formats or w > max_w:
+                    continue
+                try:
+                    us = run(kernel, img, pattern)
+                except (MemoryError, OSError, ValueError) as e:
+                    print("# skipped %s %s %s: %s" % (name, fmt_name, size_name, e))
+                    continue
+                cpp = (us * (hz / 1000000)) / (w * h)
+                print("%s,%s,%s,%d,%.2f" % (name, fmt_name, size_name, us, cpp))
+            del pattern
+            del img
+
+
+main()
@@ -0,0 +1,25 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# JPEG Capture Example
+#
+# On boards with a hardware JPEG encoder (STM32H7) the camera can compress frames while
+# they are being received, so the raw frame is never stored and the JPEG image is ready
+# right after the end of the frame. snapshot() then returns JPEG images. This is useful
+# when the frames are only being streamed or saved.
+
+import sensor
+import time
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.VGA)  # Set frame size to VGA (640x480)
+sensor.set_jpeg_capture(90)  # Compress frames with quality 90 (0 turns this off).
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+clock = time.clock()  # Create a clock object to track the FPS.
+
+while True:
+    clock.tick()  # Update the FPS clock.
+    img = sensor.snapshot()  # Take a picture and return the JPEG image.
+    print(clock.fps(), img.size())
@@ -0,0 +1,28 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Frame Timestamps and Latency Example
+#
+# Each frame is timestamped when its first line is received and when it's complete, and
+# again when snapshot() returns. The timestamps use the same clock as time.ticks_us() so
+# they can be matched with IMU or other sensor samples. record_latency() adds the time
+# from the start of the frame to now to a histogram of 1ms bins.
+
+import sensor
+import time
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+
+frames = 0
+while True:
+    img = sensor.snapshot()  # Take a picture and return the image.
+    start_us, end_us, snapshot_us, trigger_us = sensor.get_timestamps()
+    print(time.ticks_diff(end_us, start_us), time.ticks_diff(snapshot_us, end_us))
+    sensor.record_latency()  # Record the latency once the frame has been processed.
+    frames += 1
+    if frames % 100 == 0:
+        print(sensor.get_latency_histogram(reset=True))
@@ -0,0 +1,39 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Pipelined Snapshot Example
+#
+# With more than one frame buffer the camera keeps capturing the next frame into a
+# free buffer while your code is processing the current one. Passing blocking=False
+# to snapshot() returns None instead of waiting when the next frame isn't ready yet,
+# so the remaining time can be spent on other work.
+
+import image
+import sensor
+import time
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.set_framebuffers(sensor.TRIPLE_BUFFER)  # Capture and processing run in parallel.
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+clock = time.clock()  # Create a clock object to track the FPS.
+
+img = sensor.snapshot()
+idle = 0
+
+while True:
+    clock.tick()  # Update the FPS clock.
+    # Process the current frame while the next one is being captured.
+    img.find_edges(image.EDGE_SIMPLE)
+
+    # Poll for the next frame. Other work can be done while waiting.
+    next_img = None
+    while next_img is None:
+        next_img = sensor.snapshot(blocking=False)
+        idle += 1
+
+    img = next_img
+    print(clock.fps(), idle)
+    idle = 0
@@ -11,7 +11,9 @@
 import image
 import time
 
-stream = image.ImageIO("/stream.bin", "r")
+# prefetch=N reads up to N frames ahead in the background so that read() doesn't wait on
+# the SD card (uses frame buffer memory).
+stream = image.ImageIO("/stream.bin", "r", prefetch=4)
 
 clock = time.clock()  # Create a clock object to track the FPS.
 while True:
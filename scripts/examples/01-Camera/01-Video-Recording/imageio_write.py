@@ -33,6 +33,7 @@ while time.ticks_diff(time.ticks_ms(), start) < record_time:
     clock.tick()
     img = sensor.snapshot()
     # Modify the image if you feel like here...
+    # Frames can be compressed with compression=image.ImageIO.JPEG/PNG/RLE to save space.
     stream.write(img)
     print(clock.fps())
 
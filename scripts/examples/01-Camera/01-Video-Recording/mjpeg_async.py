@@ -0,0 +1,39 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# MJPEG Asynchronous Video Recording Example
+#
+# Note: You will need an SD card to run this demo.
+#
+# write_async() queues frames into a RAM buffer which is written to the SD card in the
+# background. If the SD card stalls for too long and the buffer fills up frames are
+# dropped instead of slowing down the script. The file is also preallocated so that
+# no clusters have to be allocated while recording.
+
+import sensor
+import time
+import mjpeg
+import machine
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+
+led = machine.LED("LED_RED")
+
+led.on()
+# Buffer up to 128KB of frames and preallocate 8MB for the file.
+m = mjpeg.Mjpeg("example.mjpeg", buffer_size=128 * 1024, preallocate=8 * 1024 * 1024)
+
+clock = time.clock()  # Create a clock object to track the FPS.
+for i in range(200):
+    clock.tick()
+    m.write_async(sensor.snapshot())
+    print(clock.fps(), m.dropped())
+
+m.close()
+led.off()
+
+raise (Exception("Please reset the camera to see the new file."))
@@ -0,0 +1,52 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# MJPEG Pre-Trigger Video Recording Example
+#
+# Note: You will need an SD card to run this demo.
+#
+# A Recorder compresses every frame written to it into a RAM ring buffer which always holds
+# the latest frames. Nothing is written to the SD card until trigger() is called, then the
+# frames in the ring are written to the file in the background followed by the frames after
+# the trigger. This records what happened before the event in a few MBs of RAM.
+
+import sensor
+import time
+import mjpeg
+import machine
+import random
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+sensor.set_auto_whitebal(False)  # Turn off white balance.
+
+led = machine.LED("LED_RED")
+
+# Keep up to 4MB of compressed frames before the trigger.
+m = mjpeg.Recorder(buffer_size=4 * 1024 * 1024)
+bg = sensor.alloc_extra_fb(sensor.width(), sensor.height(), sensor.RGB565)
+bg.replace(sensor.snapshot())
+
+clock = time.clock()  # Create a clock object to track the FPS.
+while m.is_armed():
+    clock.tick()
+    img = sensor.snapshot()
+    m.write(img, quality=70)
+    # Trigger on motion, the lighting max of the difference is zero normally.
+    if img.difference(bg).statistics()[5] > 20:
+        led.on()
+        # Record 200 more frames after the trigger.
+        m.trigger("example-%d.mjpeg" % random.getrandbits(32), frames=200)
+    print(clock.fps(), m.count())
+
+while m.remaining():
+    m.write(sensor.snapshot(), quality=70)
+    print(m.remaining(), m.dropped())
+
+m.close()
+led.off()
+
+raise (Exception("Please reset the camera to see the new file."))
@@ -0,0 +1,49 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Lucas-Kanade Sparse Optical Flow
+#
+# This example shows off using the OpticalFlow object to track FAST corners
+# between consecutive frames. The object keeps an image pyramid of the previous
+# frame around and tracks each point from the coarsest level to the finest, so
+# it can follow motion that is several times larger than the tracking window.
+#
+# The average displacement of the tracked points can be used for stabilization
+# or visual odometry without computing a dense flow field.
+
+import sensor
+import time
+import image
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.GRAYSCALE)  # Set pixel format to GRAYSCALE (or RGB565)
+sensor.set_framesize(sensor.QQVGA)  # Set frame size to QQVGA (160x120)
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+clock = time.clock()  # Create a clock object to track the FPS.
+
+# 3 pyramid levels with a 15x15 window track motions up to ~50 pixels per frame.
+flow = image.OpticalFlow(sensor.width(), sensor.height(), levels=3, window=15)
+points = []
+
+while True:
+    clock.tick()  # Track elapsed milliseconds between snapshots().
+    img = sensor.snapshot()  # Take a picture and return the image.
+
+    tracks = flow.update(img, points)
+
+    if tracks:
+        # Lost points are None.
+        points = [(x, y) for (x, y, dx, dy) in filter(None, tracks)]
+        if points:
+            dx = sum(t[2] for t in tracks if t) / len(points)
+            dy = sum(t[3] for t in tracks if t) / len(points)
+            print("{0:+f}x {1:+f}y {2} points {3} FPS".format(dx, dy, len(points), clock.fps()))
+        for x, y in points:
+            img.draw_circle(int(x), int(y), 2, color=255)
+
+    # Refill the points with new corners when too many are lost. Keypoints can
+    # be passed to update() directly, they are tracked from this frame on.
+    if len(points) < 32:
+        kpts = img.find_keypoints(max_keypoints=100, threshold=10, corner_detector=image.CORNER_FAST)
+        points = kpts if kpts else []
@@ -0,0 +1,49 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Phase Correlator Differential Translation
+#
+# This example shows off using the PhaseCorrelator object to measure
+# translation in the X and Y direction between consecutive frames. Unlike
+# find_displacement() the correlator keeps the spectrum of the previous
+# frame around, so no second frame buffer is needed and only one forward
+# FFT is computed per frame.
+#
+# NOTE Use a small power of 2 resolution like B64X64 or B64X32 (2x faster).
+
+import sensor
+import time
+import image
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.GRAYSCALE)  # Set pixel format to GRAYSCALE (or RGB565)
+sensor.set_framesize(sensor.B64X64)  # Set frame size to 64x64... (or 64x32)...
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+clock = time.clock()  # Create a clock object to track the FPS.
+
+# Pass logpolar=True to measure rotation and scale instead of translation.
+correlator = image.PhaseCorrelator(sensor.width(), sensor.height())
+
+while True:
+    clock.tick()  # Track elapsed milliseconds between snapshots().
+    img = sensor.snapshot()  # Take a picture and return the image.
+
+    displacement = correlator.update(img)
+
+    # The first frame only primes the correlator.
+    if displacement is None:
+        continue
+
+    # Below 0.1 or so (YMMV) and the results are just noise.
+    if displacement.response() > 0.1:
+        print(
+            "{0:+f}x {1:+f}y {2} {3} FPS".format(
+                displacement.x_translation(),
+                displacement.y_translation(),
+                displacement.response(),
+                clock.fps(),
+            )
+        )
+    else:
+        print(clock.fps())
@@ -0,0 +1,33 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Global Shutter External Trigger Burst Example
+#
+# This example shows off starting exposures from an external trigger, like a conveyor
+# encoder, instead of from snapshot(). Each rising edge on the board's trigger input starts
+# an exposure and the frames are queued into the frame buffers in the background, so no
+# triggers are missed while Python is busy. Each frame is tagged with its trigger time.
+#
+# Note: This requires a board with a trigger input (OMV_CSI_TRIGGER_PIN) and a sensor with
+# a frame sync input, such as the MT9V0XX.
+
+import sensor
+import time
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.GRAYSCALE)  # Set pixel format to GRAYSCALE
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+
+sensor.set_framebuffers(8)  # Queue up to 8 frames.
+sensor.disable_full_flush(True)  # Keep the queued frames when the queue is full.
+sensor.ioctl(sensor.IOCTL_SET_TRIGGERED_MODE, True)
+sensor.set_ext_trigger(True)
+
+while True:
+    img = sensor.snapshot(blocking=False)  # Returns None if no frame is queued.
+    if img is None:
+        continue
+    start_us, end_us, snapshot_us, trigger_us = sensor.get_timestamps()
+    print("trigger:", trigger_us, "latency:", time.ticks_diff(snapshot_us, trigger_us))
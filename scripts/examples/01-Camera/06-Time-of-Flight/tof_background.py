@@ -0,0 +1,38 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Time of Flight Background Ranging Demo
+#
+# This example shows off how to read the ToF sensor in the background. The ranging
+# results are read while the main camera captures a frame, so reading the depth map
+# doesn't stall the loop. GRAYSCALE16 snapshots hold the distance of each zone in mm.
+import sensor
+import time
+import tof
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+
+# Initialize the ToF sensor and start background ranging.
+tof.init()
+tof.background(True)
+
+# FPS clock
+clock = time.clock()
+
+while True:
+    clock.tick()
+
+    # Capture an image
+    img = sensor.snapshot()
+
+    # Get the latest depth map without waiting for a new one.
+    try:
+        depth = tof.snapshot(pixformat=tof.GRAYSCALE16, copy_to_fb=True, timeout=0)
+    except ValueError:
+        continue
+
+    # The closest zone in mm.
+    print(depth.get_statistics().min(), clock.fps())
@@ -0,0 +1,50 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Sensor HDR Fusion Example
+#
+# This example captures the same scene with a short, a normal and a long exposure and fuses
+# them into one image with hdr_fuse(). Each pixel is the average of the exposures weighted by
+# how well exposed they are, so dark areas come from the long exposure and bright areas from
+# the short exposure. The fusion is done in one pass over the three images.
+#
+# Note: Exposure changes take one or two frames to take effect, set SETTLE_FRAMES to match
+# your sensor. The scene should be static while the exposures are captured.
+
+import sensor
+import image
+import time
+
+EXPOSURE_SCALES = (0.25, 1.0, 4.0)
+SETTLE_FRAMES = 2
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+
+# Lock the auto gain and exposure to the current scene.
+sensor.set_auto_gain(False)
+sensor.set_auto_exposure(False)
+exposure_us = sensor.get_exposure_us()
+
+# The first exposures are copied to a pool while the last one stays in the frame buffer.
+pool = image.Pool(sensor.width(), sensor.height(), sensor.RGB565, len(EXPOSURE_SCALES) - 1)
+clock = time.clock()  # Create a clock object to track the FPS.
+
+while True:
+    clock.tick()  # Update the FPS clock.
+    exposures = []
+    for scale in EXPOSURE_SCALES:
+        sensor.set_auto_exposure(False, exposure_us=int(exposure_us * scale))
+        sensor.skip_frames(SETTLE_FRAMES)
+        img = sensor.snapshot()
+        if len(exposures) < len(EXPOSURE_SCALES) - 1:
+            img = img.copy(pool=pool)
+        exposures.append(img)
+
+    img = exposures[-1].hdr_fuse(*exposures[:-1])
+    for other in exposures[:-1]:
+        pool.release(other)
+    print(clock.fps())
@@ -0,0 +1,39 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# ISP Statistics Example
+#
+# get_isp_stats() samples the image on a sparse grid (every step pixels in both directions)
+# and returns the channel averages, the average luma, a focus metric and a 16 bin luma
+# histogram in a single pass. This is much cheaper than the full image statistics and
+# is enough to drive a simple auto exposure and auto white balance loop.
+
+import sensor
+import time
+
+TARGET_Y = 110  # Target average luma.
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.set_auto_gain(False)  # Auto gain control must be turned off.
+sensor.set_auto_exposure(False)
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+clock = time.clock()  # Create a clock object to track the FPS.
+
+exposure = sensor.get_exposure_us()
+
+while True:
+    clock.tick()  # Update the FPS clock.
+    img = sensor.snapshot()  # Take a picture and return the image.
+    r, g, b, y, focus, hist = img.get_isp_stats(step=8)
+
+    # Simple proportional exposure control.
+    if y:
+        exposure = max(100, min(100000, (exposure * TARGET_Y) // y))
+        sensor.set_auto_exposure(False, exposure_us=exposure)
+
+    # Gray world white balance using the sparse averages.
+    img.awb(step=8)
+    print(clock.fps(), y, focus, hist)
@@ -0,0 +1,34 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Image Pool Example
+#
+# copy(), crop() and to_*(copy=True) allocate a new image on the MicroPython heap on every
+# call, which eventually triggers garbage collections that stall random frames. An image
+# pool preallocates a few images once. Passing pool= to copy(), crop() or to_*() copies
+# into a free pool image instead, and release() gives the image back to the pool.
+
+import sensor
+import image
+import time
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+clock = time.clock()  # Create a clock object to track the FPS.
+
+# Two grayscale QQVGA images (160x120), allocated once.
+pool = image.Pool(160, 120, sensor.GRAYSCALE, 2)
+
+while True:
+    clock.tick()  # Update the FPS clock.
+    img = sensor.snapshot()  # Take a picture and return the image.
+
+    # Scale the frame down into a pool image instead of allocating a new one.
+    small = img.to_grayscale(x_scale=0.5, y_scale=0.5, pool=pool)
+    print(clock.fps(), small.get_statistics().mean(), pool.available())
+
+    # Give the image back to the pool once it's no longer needed.
+    pool.release(small)
@@ -0,0 +1,26 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Image View Example
+#
+# view() returns an image that shares the pixels of a band of rows of the frame, so no
+# pixels are copied. The view is copied the first time it's modified (copy-on-write), so
+# drawing on the view never changes the frame. Views of a partial width ROI are copied.
+
+import sensor
+import time
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.GRAYSCALE)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.skip_frames(time=2000)  # Wait for settings take effect.
+clock = time.clock()  # Create a clock object to track the FPS.
+
+while True:
+    clock.tick()  # Update the FPS clock.
+    img = sensor.snapshot()  # Take a picture and return the image.
+
+    # The bottom half of the frame, without copying it.
+    bottom = img.view((0, img.height() // 2, img.width(), img.height() // 2))
+    print(clock.fps(), bottom.get_statistics().mean())
@@ -0,0 +1,30 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# ISP Example
+#
+# This example shows off applying auto white balance, a color correction matrix and
+# gamma correction with isp(). This does the same as calling awb(), ccm() and gamma()
+# one after the other, but, in a single pass over the image using integer math.
+
+import sensor
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.RGB565)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_whitebal(False)  # white balance is done by isp() instead.
+clock = time.clock()
+
+# Slightly boosts the saturation.
+ccm = [[1.2, -0.1, -0.1], [-0.1, 1.2, -0.1], [-0.1, -0.1, 1.2]]
+
+while True:
+    clock.tick()
+
+    # step=8 computes the white balance gains from a sparse grid of pixels.
+    img = sensor.snapshot().isp(awb=True, step=8, ccm=ccm, gamma=1.2)
+
+    print(clock.fps())
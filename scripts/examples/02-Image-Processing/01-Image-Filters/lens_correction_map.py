@@ -0,0 +1,29 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Lens Correction Map
+#
+# This example shows off how to precompute the lens correction once with a
+# LensCorrection object. The per pixel radial math is done when the object is
+# created, so correcting each frame is only a table lookup per pixel. The map
+# must match the image size. x_corr and y_corr can still be passed per frame.
+
+import sensor
+import image
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.RGB565)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+clock = time.clock()
+
+corr = image.LensCorrection(sensor.width(), sensor.height(), strength=1.8, zoom=1.0)
+
+while True:
+    clock.tick()
+
+    img = sensor.snapshot().lens_corr(map=corr)
+
+    print(clock.fps())
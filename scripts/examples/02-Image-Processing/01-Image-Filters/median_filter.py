@@ -28,5 +28,9 @@ while True:
     # would be the upper quartile.
     img.median(1, percentile=0.5)
 
+    # For large kernels pass fast=True. This uses per-column histograms so the
+    # filter runs in constant time per pixel regardless of the kernel size, at
+    # the cost of more frame buffer memory. E.g. img.median(5, fast=True)
+
     print(clock.fps())  # Note: Your OpenMV Cam runs about half as fast while
     # connected to your computer. The FPS should increase once disconnected.
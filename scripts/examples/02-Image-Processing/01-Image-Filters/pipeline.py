@@ -0,0 +1,34 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Image Pipeline Example
+#
+# This example shows off image.Pipeline() which runs a chain of filters on a
+# grayscale image in a single pass. Each stage only keeps a few rows in fast
+# memory so the image is read and written once instead of once per filter.
+#
+# Supported stages are ("gaussian", ksize), ("morph", ksize, kernel[, mul[, add]]),
+# ("binary", thresholds[, invert[, zero]]), ("invert",), ("erode", ksize[, threshold])
+# and ("dilate", ksize[, threshold]).
+
+import sensor
+import image
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+clock = time.clock()
+
+# Same result as img.gaussian(1).binary([(170, 255)]).erode(1)
+pipeline = image.Pipeline([("gaussian", 1), ("binary", [(170, 255)]), ("erode", 1)])
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    pipeline.run(img)
+    for blob in img.find_blobs([(128, 255)], pixels_threshold=50):
+        img.draw_rectangle(blob.rect(), color=127)
+    print(clock.fps())
@@ -5,6 +5,10 @@
 # Ulab is a numpy-like module for micropython, meant to simplify and speed up common
 # mathematical operations on arrays. This basic example shows mean/std on an image.
 #
+# The ndarray returned by to_ndarray() with copy=False aliases the pixels of the image so
+# nothing is copied or allocated per frame. Its dtype must match the pixel format, uint8 for
+# GRAYSCALE and uint16 for RGB565.
+#
 # NOTE: ndarrays cause the heap to be fragmented easily. If you run out of memory,
 # there's not much that can be done about it, lowering the resolution might help.
 
@@ -19,5 +23,5 @@ clock = time.clock()  # Create a clock object to track the FPS.
 
 while True:
     img = sensor.snapshot()  # Take a picture and return the image.
-    a = np.array(img, dtype=np.uint8)
+    a = img.to_ndarray(np.uint8, copy=False)
     print("mean: %d std:%d" % (np.mean(a), np.std(a)))
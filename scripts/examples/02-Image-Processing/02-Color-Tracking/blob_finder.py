@@ -0,0 +1,37 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Blob Finder Example
+#
+# This example shows off the BlobFinder object. It takes the same arguments as find_blobs(),
+# but the thresholds and the other arguments are only parsed once when the finder is created,
+# so calling find() every frame has less overhead than calling find_blobs().
+
+import sensor
+import image
+import time
+
+# Color Tracking Thresholds (L Min, L Max, A Min, A Max, B Min, B Max)
+thresholds = [
+    (30, 100, 15, 127, 15, 127),  # generic_red_thresholds
+    (30, 100, -64, -8, -32, 32),  # generic_green_thresholds
+]
+
+sensor.reset()
+sensor.set_pixformat(sensor.RGB565)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)  # must be turned off for color tracking
+sensor.set_auto_whitebal(False)  # must be turned off for color tracking
+clock = time.clock()
+
+finder = image.BlobFinder(thresholds, pixels_threshold=200, area_threshold=200, merge=True)
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    for blob in finder.find(img):
+        img.draw_rectangle(blob.rect())
+        img.draw_cross(blob.cx(), blob.cy())
+    print(clock.fps())
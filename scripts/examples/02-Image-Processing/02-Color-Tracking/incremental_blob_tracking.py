@@ -0,0 +1,36 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Incremental Blob Tracking Example
+#
+# This example shows off blob tracking with an image.BlobTracker. When a tracker
+# is passed to find_blobs() only the areas around the blobs found in the last
+# frame are searched, with a full scan every "full_scan_interval" frames to pick
+# up new blobs. Each blob keeps the same id() from frame to frame.
+
+import sensor
+import image
+import time
+
+# Color Tracking Thresholds (Grayscale Min, Grayscale Max)
+thresholds = (245, 255)
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.VGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)  # must be turned off for color tracking
+sensor.set_auto_whitebal(False)  # must be turned off for color tracking
+clock = time.clock()
+
+# "search_margin" is how far in pixels a blob may move between frames.
+tracker = image.BlobTracker(full_scan_interval=10, search_margin=16)
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    for blob in img.find_blobs([thresholds], pixels_threshold=100, area_threshold=100, tracker=tracker):
+        img.draw_rectangle(blob.rect(), color=127)
+        img.draw_string(blob.x(), blob.y() - 10, str(blob.id()), color=127)
+    print(clock.fps())
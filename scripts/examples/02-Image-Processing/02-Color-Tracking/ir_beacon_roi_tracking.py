@@ -0,0 +1,40 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# IR Beacon ROI Tracking Example
+#
+# This example captures only a small window around the IR beacon and moves the window to
+# follow it. sensor.move_windowing() keeps the window size and the captured frames, so the
+# window moves between frames without reconfiguring the camera, which allows very high FPS.
+
+import sensor
+import time
+
+thresholds = (255, 255)  # thresholds for bright white light from IR.
+roi_w, roi_h = 128, 128
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.VGA)
+sensor.set_windowing((roi_w, roi_h))  # 128x128 center pixels of VGA
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)  # must be turned off for color tracking
+sensor.set_auto_whitebal(False)  # must be turned off for color tracking
+clock = time.clock()
+
+frame_w, frame_h = sensor.width(), sensor.height()
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    x, y, w, h = sensor.get_windowing()
+    blobs = img.find_blobs([thresholds], pixels_threshold=20, area_threshold=20, merge=True)
+    if blobs:
+        blob = max(blobs, key=lambda b: b.pixels())
+        img.draw_cross(blob.cx(), blob.cy())
+        # Center the window on the beacon.
+        x = min(max(x + blob.cx() - (roi_w // 2), 0), frame_w - roi_w)
+        y = min(max(y + blob.cy() - (roi_h // 2), 0), frame_h - roi_h)
+        sensor.move_windowing(x, y)
+    print(clock.fps())
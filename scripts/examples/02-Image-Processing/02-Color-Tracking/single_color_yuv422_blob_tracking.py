@@ -0,0 +1,44 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Single Color YUV422 Blob Tracking Example
+#
+# This example shows off single color tracking on YUV422 frames without converting them.
+# For YUV422 images the thresholds bound Y, U and V instead of L, A and B. Y is 0 to 255
+# while U and V are centered on zero (-128 to 127).
+
+import sensor
+import time
+
+threshold_index = 0  # 0 for red, 1 for green, 2 for blue
+
+# Color Tracking Thresholds (Y Min, Y Max, U Min, U Max, V Min, V Max)
+# The below thresholds track in general red/green/blue things. You may wish to tune them...
+thresholds = [
+    (40, 255, -64, 0, 24, 127),  # generic_red_thresholds
+    (40, 255, -64, 0, -128, -16),  # generic_green_thresholds
+    (0, 160, 24, 127, -64, 0),
+]  # generic_blue_thresholds
+
+sensor.reset()
+sensor.set_pixformat(sensor.YUV422)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)  # must be turned off for color tracking
+sensor.set_auto_whitebal(False)  # must be turned off for color tracking
+clock = time.clock()
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    blobs = img.find_blobs(
+        [thresholds[threshold_index]],
+        pixels_threshold=200,
+        area_threshold=200,
+        merge=True,
+    )
+    # YUV422 images can't be drawn on, so the blobs are printed instead.
+    for blob in blobs:
+        print(blob.rect(), blob.cx(), blob.cy())
+    print(clock.fps())
@@ -0,0 +1,37 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Motion Detector Example
+#
+# This example shows off the background subtraction motion detector. The background
+# is modeled per cell of (1 << shift) x (1 << shift) pixels with a running average, so
+# no second frame buffer is needed. update() returns the moving blobs in image
+# coordinates. rate is the learning rate out of 256 and threshold is the minimum
+# difference to the background for a cell to count as moving.
+#
+# With capture(True), the model is updated by the camera driver while each frame is
+# captured, and update() is called without an image to get the blobs.
+
+import sensor
+import image
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)
+sensor.set_auto_whitebal(False)
+clock = time.clock()
+
+motion = image.MotionDetector(sensor.width(), sensor.height(), sensor.GRAYSCALE, shift=2, rate=8, threshold=16)
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+
+    for blob in motion.update(img, area_threshold=4, merge=True):
+        img.draw_rectangle(blob.rect(), color=255)
+
+    print(clock.fps())
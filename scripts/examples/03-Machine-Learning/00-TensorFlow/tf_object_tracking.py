@@ -0,0 +1,48 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# TensorFlow Lite Object Tracking Example
+#
+# This example uses the builtin FOMO model to detect faces and the tracker module to give each
+# face a stable id across frames. The tracker accepts the list per class returned by the FOMO
+# post-processing directly, the class index becomes the track label. It also accepts a flat list
+# of rects or of objects with a rect() method, like the results of find_apriltags() or find_blobs().
+
+import sensor
+import time
+import ml
+import tracker
+
+sensor.reset()  # Reset and initialize the sensor.
+sensor.set_pixformat(sensor.RGB565)  # Set pixel format to RGB565 (or GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)  # Set frame size to QVGA (320x240)
+sensor.skip_frames(time=2000)  # Let the camera adjust.
+
+min_confidence = 0.4
+
+# Load built-in FOMO face detection model
+model = ml.Model("fomo_face_detection")
+print(model)
+
+# FOMO boxes are small and jump between grid cells, so detections are also matched to tracks
+# whose centroid is within max_distance pixels. Tracks are reported after min_hits detections
+# and dropped after max_misses frames without one.
+t = tracker.Tracker(max_distance=40, min_hits=2, max_misses=10)
+
+clock = time.clock()
+while True:
+    clock.tick()
+
+    img = sensor.snapshot()
+
+    detections = model.predict([img], postprocess=ml.FOMO, threshold=min_confidence)
+
+    for track_id, rect, predicted, label, index in t.update(detections):
+        if label == 0:
+            continue  # background class
+        img.draw_rectangle(rect, color=(0, 255, 0) if index >= 0 else (255, 0, 0))
+        img.draw_rectangle(predicted, color=(0, 0, 255))
+        img.draw_string(rect[0], rect[1] - 10, "%s %d" % (model.labels[label], track_id), color=(255, 255, 255))
+
+    print(clock.fps(), "fps", end="\n")
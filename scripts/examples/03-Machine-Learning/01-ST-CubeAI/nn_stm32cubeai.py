@@ -7,7 +7,7 @@
 
 import sensor
 import time
-import nn_st
+import ml
 
 sensor.reset()  # Reset and initialize the sensor.
 sensor.set_contrast(3)
@@ -19,8 +19,8 @@ sensor.set_framesize(sensor.QQQVGA)  # Set frame size to 80x60
 sensor.skip_frames(time=2000)  # Wait for settings take effect.
 clock = time.clock()  # Create a clock object to track the FPS.
 
-# [CUBE.AI] Initialize the network
-net = nn_st.loadnnst("network")
+# [CUBE.AI] Load the network linked into the firmware, it's used like any other ml.Model.
+net = ml.Model("network")
 
 nn_input_sz = 28  # The NN input is 28x28
 
@@ -41,8 +41,8 @@ while True:
     # Binarize the image
     img.midpoint(2, bias=0.5, threshold=True, offset=5, invert=True)
 
-    # [CUBE.AI] Run the inference
-    out = net.predict(img)
+    # [CUBE.AI] Run the inference, the image is scaled to the input tensor's shape.
+    out = list(net.predict([img])[0].flatten())
     print("Network argmax output: {}".format(out.index(max(out))))
     img.draw_string(0, 0, str(out.index(max(out))))
     print(
@@ -29,3 +29,13 @@ for s in range(1, NUM_SUBJECTS + 1):
         d1 = img.find_lbp((0, 0, img.width(), img.height()))
         dist += image.match_descriptor(d0, d1)
     print("Average dist for subject %d: %d" % (s, dist / NUM_SUBJECTS_IMGS))
+
+# Match against all the enrolled faces at once, returns (index, distance) of the 3 closest.
+gallery = []
+for s in range(1, NUM_SUBJECTS + 1):
+    img = image.Image("orl_faces/s%d/%d.pgm" % (s, NUM_SUBJECTS_IMGS)).mask_ellipse()
+    gallery.append(img.find_lbp((0, 0, img.width(), img.height())))
+img = None
+
+for index, dist in image.match_descriptor(d0, gallery, k=3):
+    print("Subject %d: %d" % (index + 1, dist))
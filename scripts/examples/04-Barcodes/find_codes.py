@@ -0,0 +1,33 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Multi-Code Example
+#
+# This example shows off finding QR Codes, Data Matrices, Bar Codes and AprilTags in one call.
+# The image is converted to grayscale once for all the detectors, and timeout_us bounds the
+# time spent on the whole frame. The results are a mix of the four code object types.
+
+import sensor
+import image
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.RGB565)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)  # must turn this off to prevent image washout...
+sensor.set_auto_whitebal(False)  # must turn this off to prevent image washout...
+clock = time.clock()
+
+types = image.QRCODES | image.DATAMATRICES | image.BARCODES | image.APRILTAGS
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    for code in img.find_codes(types=types, timeout_us=50000):
+        img.draw_rectangle(code.rect(), color=(255, 0, 0))
+        print(code)
+    if image.timed_out():
+        print("Out of time, some codes may have been missed.")
+    print(clock.fps())
@@ -0,0 +1,43 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Fast Data Matrices Example
+#
+# This example shows off how to speed up data matrix detection by only searching the parts of
+# the image that may contain a code. Dark blobs are found first and their bounding boxes are
+# passed to find_datamatrices() as candidate rois, the decoder then skips the rest of the image.
+
+import sensor
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)  # must turn this off to prevent image washout...
+sensor.set_auto_whitebal(False)  # must turn this off to prevent image washout...
+clock = time.clock()
+
+# Data matrices are dark modules on a light background.
+threshold = (0, 80)
+margin = 8
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+
+    rois = []
+    for blob in img.find_blobs([threshold], pixels_threshold=100, merge=True, margin=margin):
+        x = max(blob.x() - margin, 0)
+        y = max(blob.y() - margin, 0)
+        w = min(blob.w() + (margin * 2), img.width() - x)
+        h = min(blob.h() + (margin * 2), img.height() - y)
+        rois.append((x, y, w, h))
+
+    matrices = img.find_datamatrices(rois=rois) if rois else []
+    for matrix in matrices:
+        img.draw_rectangle(matrix.rect(), color=255)
+        print('Matrix [%d:%d], Payload "%s"' % (matrix.rows(), matrix.columns(), matrix.payload()))
+
+    print("FPS %f" % clock.fps())
@@ -0,0 +1,35 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Fast QRCode Example
+#
+# This example shows off two ways of speeding up QR Code detection. First, decimate finds the
+# finder patterns on a smaller copy of the image and then only decodes around the codes that
+# were found. The code modules must be at least 2 * decimate pixels wide for this to work.
+#
+# Second, a binary image can be shared between detectors. QR codes are decoded from it without
+# thresholding the image again, and the same image can be passed to find_apriltags().
+
+import sensor
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)  # must turn this off to prevent image washout...
+clock = time.clock()
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    # White pixels must be set in the binary image.
+    bitmap = img.binary([(128, 255)], to_bitmap=True, copy=True)
+    for code in bitmap.find_qrcodes(decimate=2):
+        img.draw_rectangle(code.rect(), color=127)
+        print(code)
+    for tag in bitmap.find_apriltags():
+        img.draw_rectangle(tag.rect(), color=127)
+        print(tag)
+    print(clock.fps())
@@ -0,0 +1,35 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Find Rects on Binary Images Example
+#
+# This example shows off how to find rectangles in a thresholded image. On binary images
+# find_rects() follows the borders of the set pixels and keeps the ones that fit a convex
+# quad, which is much faster than the quad detection used on grayscale and color images.
+# The threshold is then the minimum perimeter of the rectangles in pixels.
+
+import sensor
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+clock = time.clock()
+
+# Dark objects on a light background, use invert=False for light objects.
+threshold = (0, 80)
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    binary = img.binary([threshold], invert=False, copy=True, to_bitmap=True)
+
+    for r in binary.find_rects(threshold=80):
+        img.draw_rectangle(r.rect(), color=255)
+        for p in r.corners():
+            img.draw_circle(p[0], p[1], 5, color=0)
+        print(r)
+
+    print("FPS %f" % clock.fps())
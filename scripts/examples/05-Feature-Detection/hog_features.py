@@ -0,0 +1,46 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2023 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# HoG Features Example
+#
+# This example shows how to get HoG features for a sliding window detector. get_hog() computes
+# the cell histograms once per frame and returns the normalized blocks for each pyramid level.
+# Blocks are 2x2 cells (36 bytes) with a stride of one cell, so the descriptor of a window is
+# the concatenation of the blocks it covers.
+
+import sensor
+import time
+
+CELL = 8
+WIN_W = 8  # Window width in blocks (64 pixels with 8x8 cells).
+WIN_H = 16  # Window height in blocks (128 pixels with 8x8 cells).
+
+sensor.reset()
+sensor.set_framesize(sensor.QVGA)
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.skip_frames(time=2000)
+
+
+def window(blocks, bx, by, x, y):
+    desc = bytearray()
+    for j in range(y, y + WIN_H):
+        start = ((j * bx) + x) * 36
+        desc.extend(blocks[start:start + (WIN_W * 36)])
+    return desc
+
+
+clock = time.clock()  # Tracks FPS.
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+
+    for level, (bx, by, blocks) in enumerate(img.get_hog(size=CELL, levels=2)):
+        windows = 0
+        for y in range(0, by - WIN_H + 1, 2):
+            for x in range(0, bx - WIN_W + 1, 2):
+                desc = window(blocks, bx, by, x, y)  # Feed desc to a classifier here.
+                windows += 1
+        print("level %d: %dx%d blocks, %d windows" % (level, bx, by, windows))
+
+    print(clock.fps())
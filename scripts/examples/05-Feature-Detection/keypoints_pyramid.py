@@ -0,0 +1,36 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Keypoints Pyramid Example
+#
+# This example shows off how to build an image pyramid once per frame with a
+# Pyramid object and pass it to find_keypoints(). The down scaled levels are
+# box filtered and gaussian smoothed in one pass, so detectors sharing the same
+# frame don't each have to rebuild them. The pyramid must match the image size,
+# and its scale replaces the scale_factor argument.
+
+import sensor
+import image
+import time
+
+sensor.reset()
+sensor.set_contrast(3)
+sensor.set_gainceiling(16)
+sensor.set_framesize(sensor.QVGA)
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.skip_frames(time=2000)
+clock = time.clock()
+
+pyr = image.Pyramid(sensor.width(), sensor.height(), scale=1.2)
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+
+    pyr.build(img)
+    kpts = img.find_keypoints(max_keypoints=150, threshold=10, pyramid=pyr)
+    if kpts:
+        img.draw_keypoints(kpts)
+
+    print(clock.fps())
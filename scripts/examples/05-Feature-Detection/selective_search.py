@@ -19,7 +19,7 @@ clock = time.clock()  # Create a clock object to track the FPS.
 while True:
     clock.tick()  # Update the FPS clock.
     img = sensor.snapshot()  # Take a picture and return the image.
-    rois = img.selective_search(threshold=200, size=20, a1=0.5, a2=1.0, a3=1.0)
+    rois = img.selective_search(threshold=200, size=20, a1=0.5, a2=1.0, a3=1.0, max_proposals=50)
     for r in rois:
         img.draw_rectangle(r, color=(255, 0, 0))
         # from random import randint
@@ -0,0 +1,32 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# AprilTag Detector Example
+#
+# This example shows off the AprilTagDetector object. It takes the same arguments as
+# find_apriltags(), but they are only parsed once when the detector is created, so calling
+# detect() every frame has less overhead than calling find_apriltags().
+
+import sensor
+import image
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.QQVGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)  # must turn this off to prevent image washout...
+sensor.set_auto_whitebal(False)  # must turn this off to prevent image washout...
+clock = time.clock()
+
+detector = image.AprilTagDetector(image.TAG36H11 | image.TAG16H5)
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    for tag in detector.detect(img):
+        img.draw_rectangle(tag.rect(), color=255)
+        img.draw_cross(tag.cx(), tag.cy(), color=0)
+        print("Tag Family %d, Tag ID %d, rotation %f" % (tag.family(), tag.id(), tag.rotation()))
+    print(clock.fps())
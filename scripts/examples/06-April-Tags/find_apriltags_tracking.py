@@ -0,0 +1,35 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# AprilTags Tracking Example
+#
+# This example shows off tracking AprilTags from frame to frame. After a full scan finds the
+# tags, following frames only search around where each tag is predicted to be, which is much
+# faster than searching the whole image. A full scan is done every full_scan_interval frames,
+# or right away if a tag is lost, to pick up new tags.
+
+import sensor
+import image
+import time
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)
+sensor.skip_frames(time=2000)
+sensor.set_auto_gain(False)  # must turn this off to prevent image washout...
+sensor.set_auto_whitebal(False)  # must turn this off to prevent image washout...
+clock = time.clock()
+
+# search_margin is how many pixels around the predicted tag position are searched.
+tracker = image.AprilTagTracker(full_scan_interval=10, search_margin=16)
+
+while True:
+    clock.tick()
+    img = sensor.snapshot()
+    # decimate=2 finds quads at half resolution, decoding is still done at full resolution.
+    for tag in img.find_apriltags(decimate=2, tracker=tracker):
+        img.draw_rectangle(tag.rect(), color=255)
+        img.draw_cross(tag.cx(), tag.cy(), color=0)
+        print("Tag ID %d" % tag.id())
+    print(clock.fps())
@@ -0,0 +1,93 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Chunked MJPEG Streaming
+#
+# This example shows off how to do MJPEG streaming while the frame is still being
+# compressed. compress_stream() calls the callback with each chunk of the JPEG byte
+# stream (one row of MCUs) as soon as it's ready, so the first part of the frame is
+# already on the network before the rest is compressed and no frame sized JPEG
+# buffer is needed. Connect to the IP address/port printed out from ifconfig to
+# view the stream.
+
+import sensor
+import time
+import network
+import socket
+
+SSID = ""  # Network SSID
+KEY = ""  # Network key
+HOST = ""  # Use first available interface
+PORT = 8080  # Arbitrary non-privileged port
+
+# Init sensor
+sensor.reset()
+sensor.set_framesize(sensor.QVGA)
+sensor.set_pixformat(sensor.RGB565)
+
+# Init wlan module and connect to network
+wlan = network.WLAN(network.STA_IF)
+wlan.active(True)
+wlan.connect(SSID, KEY)
+
+while not wlan.isconnected():
+    print('Trying to connect to "{:s}"...'.format(SSID))
+    time.sleep_ms(1000)
+
+# We should have a valid IP now via DHCP
+print("WiFi Connected ", wlan.ifconfig())
+
+# Create server socket
+s = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+s.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, True)
+
+# Bind and listen
+s.bind([HOST, PORT])
+s.listen(5)
+
+# Set server socket to blocking
+s.setblocking(True)
+
+
+def start_streaming(s):
+    print("Waiting for connections..")
+    client, addr = s.accept()
+    # set client socket timeout to 5s
+    client.settimeout(5.0)
+    print("Connected to " + addr[0] + ":" + str(addr[1]))
+
+    # Read request from client
+    data = client.recv(1024)
+    # Should parse client request here
+
+    # Send multipart header
+    client.sendall(
+        "HTTP/1.1 200 OK\r\n"
+        "Server: OpenMV\r\n"
+        "Content-Type: multipart/x-mixed-replace;boundary=openmv\r\n"
+        "Cache-Control: no-cache\r\n"
+        "Pragma: no-cache\r\n\r\n"
+    )
+
+    # FPS clock
+    clock = time.clock()
+
+    # Start streaming images
+    # NOTE: Disable IDE preview to increase streaming FPS.
+    while True:
+        clock.tick()  # Track elapsed milliseconds between snapshots().
+        frame = sensor.snapshot()
+        # The size isn't known up front, so the boundary alone delimits the frames.
+        client.sendall("\r\n--openmv\r\nContent-Type: image/jpeg\r\n\r\n")
+        # The chunk passed to the callback is only valid during the call.
+        frame.compress_stream(client.sendall, quality=35, buffer_size=1460)
+        print(clock.fps())
+
+
+while True:
+    try:
+        start_streaming(s)
+    except OSError as e:
+        print("socket error: ", e)
+        # sys.print_exception(e)
@@ -0,0 +1,25 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# IMU FIFO example.
+#
+# This example shows how to log the gyro at a high rate while capturing frames. The IMU
+# buffers the samples in its FIFO and read_fifo() drains them in bursts. The timestamps
+# of the samples use the same clock as sensor.get_timestamps() so each sample can be
+# matched to the frame that was being exposed.
+import imu
+import sensor
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)
+
+print("FIFO rate: %.1f Hz" % imu.fifo(833))
+
+while True:
+    img = sensor.snapshot()
+    start_us, end_us = sensor.get_timestamps()[0:2]
+    samples = imu.read_fifo()
+    during = [gyro for ticks_us, accel, gyro in samples if start_us <= ticks_us <= end_us]
+    print("%d samples, %d during the frame" % (len(samples), len(during)))
@@ -13,9 +13,9 @@ def callback(label, scores):
     print(f'\nHeard: "{label}" @{time.ticks_ms()}ms Scores: {scores}')
 
 
-# By default, the MicroSpeech object uses the built-in audio preprocessor (float) and the
-# micro speech module for audio preprocessing and speech recognition, respectively. The
-# user can override both by passing two models:
+# By default, the MicroSpeech object computes the audio features in the audio module (or
+# with the built-in audio preprocessor model if that's not supported) and uses the built-in
+# micro speech model for speech recognition. The user can override both by passing two models:
 # MicroSpeech(preprocessor=ml.Model(...), micro_speech=ml.Model(...), labels=["label",...])
 speech = MicroSpeech()
 
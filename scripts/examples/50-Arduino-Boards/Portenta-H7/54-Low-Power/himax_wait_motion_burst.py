@@ -0,0 +1,30 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# This example shows how to sleep until the Himax sensor detects motion and then capture
+# a burst of frames. While waiting the sensor runs in its low-power motion detection mode
+# and nothing is captured, wait_motion() returns when the sensor raises its INT pin.
+
+import sensor
+import pyb
+
+sensor.reset()
+sensor.set_pixformat(sensor.GRAYSCALE)
+sensor.set_framesize(sensor.QVGA)
+sensor.set_framerate(30)
+
+sensor.ioctl(sensor.IOCTL_HIMAX_MD_THRESHOLD, 10)
+sensor.ioctl(sensor.IOCTL_HIMAX_MD_WINDOW, (0, 0, 320, 240))
+sensor.ioctl(sensor.IOCTL_HIMAX_MD_ENABLE, True)
+
+led = pyb.LED(3)
+
+while True:
+    led.off()
+    if not sensor.wait_motion(60000):  # Wait up to a minute for motion.
+        print("No motion")
+        continue
+    led.on()
+    for i in range(0, 30):  # Capture a burst of frames at the full frame rate.
+        img = sensor.snapshot()
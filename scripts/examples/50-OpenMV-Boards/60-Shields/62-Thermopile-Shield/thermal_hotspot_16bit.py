@@ -0,0 +1,62 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# Thermal Hot Spot 16-bit Demo
+#
+# This example shows off how to track hot spots using the temperatures directly.
+# GRAYSCALE16 snapshots store each pixel in centi-kelvin, so thresholds are
+# temperatures and don't depend on the range of the frame.
+
+import image
+import time
+import fir
+
+IMAGE_SCALE = 10  # Scale image to 10x.
+MIN_TEMP = 30.0  # Track anything hotter than this (celsius).
+
+
+def to_centi_kelvin(celsius):
+    return int((celsius + 273.15) * 100)
+
+
+def to_celsius(centi_kelvin):
+    return (centi_kelvin / 100) - 273.15
+
+
+# Initialize the thermal sensor
+fir.init()
+
+if fir.type() == fir.FIR_AMG8833:
+    IMAGE_SCALE = IMAGE_SCALE * 2
+
+threshold_list = [(to_centi_kelvin(MIN_TEMP), 65535)]
+
+# FPS clock
+clock = time.clock()
+
+while True:
+    clock.tick()
+
+    try:
+        raw = fir.snapshot(pixformat=image.GRAYSCALE16)
+    except OSError:
+        continue
+
+    stats = raw.get_statistics()
+    blobs = raw.find_blobs(threshold_list, pixels_threshold=1, area_threshold=1, merge=True)
+
+    # Drawing stretches the frame to its min/max range.
+    img = raw.to_rgb565(
+        x_scale=IMAGE_SCALE,
+        y_scale=IMAGE_SCALE,
+        color_palette=image.PALETTE_IRONBOW,
+        copy_to_fb=True,
+    )
+
+    for blob in blobs:
+        x, y, w, h = blob.rect()
+        img.draw_rectangle(x * IMAGE_SCALE, y * IMAGE_SCALE, w * IMAGE_SCALE, h * IMAGE_SCALE)
+
+    # Print the frame temperature range and FPS.
+    print("%.2fC - %.2fC" % (to_celsius(stats.min()), to_celsius(stats.max())), clock.fps())
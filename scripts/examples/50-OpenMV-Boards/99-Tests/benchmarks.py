@@ -0,0 +1,69 @@
+# This work is licensed under the MIT license.
+# Copyright (c) 2013-2024 OpenMV LLC. All rights reserved.
+# https://github.com/openmv/openmv/blob/master/LICENSE
+#
+# OpenMV Benchmarks.
+#
+# Times each script in unittest/benchmark on the unittest data and prints one CSV
+# line per API with the best time per call and the fb_alloc and umm_malloc peaks of
+# the call. The peaks are only reported by firmware built with FB_ALLOC_STATS and
+# UMM_STATS, respectively.
+#
+# Run it with tools/pyopenmv_test.py --benchmark to compare against a baseline.
+import os
+import gc
+import omv
+import time
+
+RUNS = 5
+TEST_DIR = "unittest"
+DATA_DIR = "unittest/data"
+BENCHMARK_DIR = "unittest/benchmark"
+
+if not (TEST_DIR in os.listdir("")):
+    raise Exception("Unittest dir not found!")
+
+
+def fb_peak(reset):
+    if not hasattr(omv, "fb_stats"):
+        return -1
+    return omv.fb_stats(reset)["peak"]
+
+
+def umm_peak(reset):
+    if not hasattr(omv, "umm_stats"):
+        return -1
+    return omv.umm_stats(reset)["peak"]
+
+
+def run(call):
+    best = None
+    peak = -1
+    heap_peak = -1
+    for i in range(RUNS):
+        gc.collect()
+        fb_peak(True)
+        umm_peak(True)
+        t = time.ticks_us()
+        call()
+        t = time.ticks_diff(time.ticks_us(), t)
+        peak = max(peak, fb_peak(False))
+        heap_peak = max(heap_peak, umm_peak(False))
+        best = t if best is None else min(best, t)
+    return best, peak, heap_peak
+
+
+print("# board=%s arch=%s version=%s runs=%d" %
+      (omv.board_type(), omv.arch(), omv.version_string(), RUNS))
+print("api,us,fb_peak,umm_peak")
+
+for test in sorted(os.listdir(BENCHMARK_DIR)):
+    if test.endswith(".py"):
+        test_path = "/".join((BENCHMARK_DIR, test))
+        try:
+            exec(open(test_path).read())
+            gc.collect()
+            us, peak, heap_peak = run(benchmark(DATA_DIR))
+            print("%s,%d,%d,%d" % (test[:-3], us, peak, heap_peak))
+        except Exception as e:
+            print("# skipped %s: %s" % (test, e))
@@ -8,3 +8,4 @@
 # This is an extension package to the ml C user-module.
 
 from .model import *  # noqa
+from uml import FOMO, YOLO_V5, YOLO_V8  # noqa
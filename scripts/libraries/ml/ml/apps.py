@@ -27,7 +27,10 @@ class MicroSpeech:
 
     def __init__(self, preprocessor=None, micro_speech=None, labels=None):
         self.preprocessor = preprocessor
-        if preprocessor is None:
+        # The audio module computes the features in C if it can, otherwise they're computed
+        # by the audio preprocessor model.
+        self.native_features = preprocessor is None and hasattr(audio, "FEATURE_CHANNELS")
+        if preprocessor is None and not self.native_features:
             self.preprocessor = Model("audio_preprocessor")
         self.labels, self.micro_speech = (labels, micro_speech)
         if micro_speech is None:
@@ -53,11 +56,19 @@ class MicroSpeech:
         self.pred_history = np.roll(self.pred_history, -1, axis=0)
         self.pred_history[-1] = self.micro_speech.predict([self.spectrogram])[0]
 
+    def features_callback(self, spectrogram):
+        # The spectrogram was already updated with the new slice.
+        self.pred_history = np.roll(self.pred_history, -1, axis=0)
+        self.pred_history[-1] = self.micro_speech.predict([spectrogram])[0]
+
     def start_audio_streaming(self):
         if self.audio_started is False:
             self.spectrogram[:] = 0
             self.pred_history[:] = 0
-            audio.start_streaming(self.audio_callback)
+            if self.native_features:
+                audio.start_streaming(self.features_callback, features=self.spectrogram)
+            else:
+                audio.start_streaming(self.audio_callback)
             self.audio_started = True
 
     def stop_audio_streaming(self):
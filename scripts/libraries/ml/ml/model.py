@@ -5,14 +5,17 @@
 #
 # This work is licensed under the MIT license, see the file LICENSE for details.
 import uml
-import image
-from ml.preprocessing import Normalization
 
 
 class Model(uml.Model):
     def __init__(self, *args, **kwargs):
-        super().__init__(*args, kwargs.get("load_to_fb", False))
+        super().__init__(
+            *args,
+            kwargs.get("load_to_fb", False),
+            shared_arena=kwargs.get("shared_arena", False),
+        )
 
     def predict(self, args, **kwargs):
-        args = [Normalization()(x) if isinstance(x, image.Image) else x for x in args]
+        # Images are converted to the input tensors by the C module, which also takes the roi, scale,
+        # mean and stdev keyword arguments of ml.preprocessing.Normalization.
         return super().predict(args, **kwargs)
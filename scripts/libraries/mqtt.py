@@ -146,7 +146,9 @@ class MQTTClient:
     def publish(self, topic, msg, retain=False, qos=0):
         pkt = bytearray(b"\x30\0\0\0")
         pkt[0] |= qos << 1 | retain
-        sz = 2 + len(topic) + len(msg)
+        # Images are written straight from their buffer.
+        is_image = hasattr(msg, "write_to")
+        sz = 2 + len(topic) + (msg.size() if is_image else len(msg))
         if qos > 0:
             sz += 2
         assert sz < 2097152
@@ -164,7 +166,10 @@ class MQTTClient:
             pid = self.pid
             struct.pack_into("!H", pkt, 0, pid)
             self.sock.write(pkt[0:2])
-        self.sock.write(msg)
+        if is_image:
+            msg.write_to(self.sock)
+        else:
+            self.sock.write(msg)
         if qos == 1:
             while 1:
                 op = self.wait_msg()
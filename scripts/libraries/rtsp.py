@@ -9,8 +9,8 @@ import errno
 import image
 import random
 import re
+import rtp
 import socket
-import struct
 import time
 
 
@@ -94,8 +94,10 @@ class rtsp_server:
         self.__client_rtp_addr = None
         self.__playing = False
         self.__playing_session = 0
-        self.__sequence_number = random.getrandbits(16)
         self.__ssrc = random.getrandbits(30)
+        self.__rtp = rtp.JPEGPacketizer(self.__ssrc, seq=random.getrandbits(16))
+        self.__last_hash = None
+        self.__last_send_ms = 0
         print("IP Address:Port %s:%d\nRunning..." % self.__myaddr)
 
     def register_setup_cb(self, cb):  # public
@@ -189,6 +191,9 @@ class rtsp_server:
                                 )
                                 self.__session = random.getrandbits(30)
                                 self.__ssrc = random.getrandbits(30)
+                                self.__rtp = rtp.JPEGPacketizer(
+                                    self.__ssrc, seq=self.__rtp.sequence_number()
+                                )
                                 self.__valid_udp_socket()
                                 self.__send_rtsp_response_ok(
                                     seq,
@@ -213,6 +218,9 @@ class rtsp_server:
                                 self.__client_rtcp_channel = int(m.group(2))
                                 self.__session = random.getrandbits(30)
                                 self.__ssrc = random.getrandbits(30)
+                                self.__rtp = rtp.JPEGPacketizer(
+                                    self.__ssrc, seq=self.__rtp.sequence_number()
+                                )
                                 self.__send_rtsp_response_ok(
                                     seq, "%s\r\nSession: %d\r\n" % (s[2], self.__session)
                                 )
@@ -229,7 +237,7 @@ class rtsp_server:
                                 self.__send_rtsp_response_ok(
                                     seq,
                                     "RTP-Info: url=%s;seq=%d\r\n"
-                                    % (line0[1], self.__sequence_number),
+                                    % (line0[1], self.__rtp.sequence_number()),
                                 )
                                 if self.__play_cb:
                                     self.__play_cb(self.__pathname, self.__playing_session)
@@ -273,15 +281,6 @@ class rtsp_server:
             self.__udp_rtp__socket.settimeout(timeout)
             self.__udp_rtcp__socket.settimeout(timeout)
 
-    def __send(self, data):  # private
-        if self.__transport_is_tcp:
-            self.__tcp__socket.sendall(
-                struct.pack(">BBH", 0x24, self.__client_rtp_channel, len(data)) + data
-            )
-            return True
-        else:
-            return self.__udp_rtp__socket.sendto(data, self.__client_rtp_addr)
-
     def __recv(self):  # private
         if self.__transport_is_tcp:
             return self.__tcp__socket.recv(1400)
@@ -294,46 +293,39 @@ class rtsp_server:
         else:
             self.__close_udp_socket()
 
-    def __send_rtp(self, image_callback, quality):  # private
+    # returns true if the frame looks the same as the last frame sent
+    def __skip_frame(self, img, skip_threshold, max_skip_ms):  # private
+        if skip_threshold < 0 or img.format() in (image.JPEG, image.PNG):
+            return False
+        h = img.get_hash()
+        ms = time.ticks_ms()
+        if (
+            self.__last_hash is not None
+            and image.hash_distance(h, self.__last_hash) <= skip_threshold
+            and time.ticks_diff(ms, self.__last_send_ms) < max_skip_ms
+        ):
+            return True
+        self.__last_hash = h
+        self.__last_send_ms = ms
+        return False
+
+    def __send_rtp(self, image_callback, quality, skip_threshold, max_skip_ms):  # private
         img = image_callback(self.__pathname, self.__session)
-        img = img.to_jpeg(quality=quality, subsampling=image.JPEG_SUBSAMPLING_422)
-        if img.width() >= 2040:
-            raise ValueError("Maximum width is 2040")
-        if img.height() >= 2040:
-            raise ValueError("Maximum height is 2040")
-        i = 0
-        l = img.size()
-        rtp_header_size = 12
-        jpeg_header_size = 8
-        max_packet_size = 1400 - rtp_header_size - jpeg_header_size
-        if self.__transport_is_tcp:
-            max_packet_size -= 4
-        if self.__valid_socket():
+        skip = self.__skip_frame(img, skip_threshold, max_skip_ms)
+        if not skip:
+            img = img.to_jpeg(quality=quality, subsampling=image.JPEG_SUBSAMPLING_422)
+        if not skip and self.__valid_socket():
             try:
                 self.__settimeout(5)
                 timestamp = (time.ticks_ms() * 90) & 0xFFFFFFFF
-                mv = memoryview(img)
-                while l:
-                    rtp_header = struct.pack(
-                        ">BBHII",
-                        0x80,
-                        0x9A if l <= max_packet_size else 0x1A,
-                        self.__sequence_number,
-                        timestamp,
-                        self.__ssrc,
+                if self.__transport_is_tcp:
+                    self.__rtp.send(
+                        self.__tcp__socket, img, timestamp, channel=self.__client_rtp_channel
                     )
-                    self.__sequence_number = (self.__sequence_number + 1) & 0xFFFF
-                    jpeg_header = struct.pack(
-                        ">IBBBB", i, 0, quality, int(img.width() // 8), int(img.height() // 8)
+                else:
+                    self.__rtp.send(
+                        self.__udp_rtp__socket, img, timestamp, addr=self.__client_rtp_addr
                     )
-                    img_data = mv[i : i + min(l, max_packet_size)]
-                    img_data_len = len(img_data)
-                    if not self.__send(rtp_header + jpeg_header + img_data):
-                        break
-                    i += img_data_len
-                    l -= img_data_len
-                if l:
-                    self.__close_socket()
             except OSError:
                 self.__close_socket()
         if not self.__transport_is_tcp and self.__valid_socket():
@@ -353,7 +345,11 @@ class rtsp_server:
     def __process_not_playing(self, not_playing_process_callback):  # private
         not_playing_process_callback()
 
-    def stream(self, image_callback, not_playing_process_callback, quality=90):  # public
+    # Frames whose hash is within skip_threshold bits of the last frame sent are not sent, but a
+    # frame is always sent at least every max_skip_ms so that clients do not time out.
+    def stream(
+        self, image_callback, not_playing_process_callback, quality=90, skip_threshold=-1, max_skip_ms=1000
+    ):  # public
         while True:
             if self.__valid_tcp_socket():
                 try:
@@ -368,7 +364,7 @@ class rtsp_server:
                         if e.errno != errno.EAGAIN and e.errno != errno.ETIMEDOUT:
                             raise e
                     if self.__playing:
-                        self.__send_rtp(image_callback, quality)
+                        self.__send_rtp(image_callback, quality, skip_threshold, max_skip_ms)
                     else:
                         self.__process_not_playing(not_playing_process_callback)
                 except OSError:
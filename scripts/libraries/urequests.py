@@ -64,6 +64,18 @@ def readline(s):
     return l
 
 
+# Images are written straight from their buffer instead of being copied into the request.
+def part_len(part):
+    return part.size() if hasattr(part, "write_to") else len(part)
+
+
+def part_write(s, part):
+    if hasattr(part, "write_to"):
+        part.write_to(s)
+    else:
+        s.write(part)
+
+
 def socket_readall(s):
     buf = b""
     while True:
@@ -133,22 +145,28 @@ def request(method, url, data=None, json=None, files=None, headers={}, auth=None
             s.write(b"Content-Type: application/json\r\n")
 
         if files is not None:
-            data = bytearray()
+            data = []
             boundary = b"37a4bcce91521f74142f1868e328a6b9"
             s.write(b"Content-Type: multipart/form-data; boundary=%s\r\n" % (boundary))
             for name, fileobj in files.items():
-                data += b"--%s\r\n" % (boundary)
-                data += b'Content-Disposition: form-data; name="%s"; filename="%s"\r\n\r\n' % (
-                    name,
-                    fileobj[0],
+                data.append(
+                    b'--%s\r\nContent-Disposition: form-data; name="%s"; filename="%s"\r\n\r\n'
+                    % (boundary, name, fileobj[0])
                 )
-                data += fileobj[1].read()
-                data += b"\r\n"
-            data += b"\r\n--%s--\r\n" % (boundary)
+                data.append(fileobj[1] if hasattr(fileobj[1], "write_to") else fileobj[1].read())
+                data.append(b"\r\n")
+            data.append(b"\r\n--%s--\r\n" % (boundary))
+        elif hasattr(data, "write_to"):
+            data = [data]
 
         if data:
-            s.write(b"Content-Length: %d\r\n\r\n" % len(data))
-            s.write(data)
+            if isinstance(data, list):
+                s.write(b"Content-Length: %d\r\n\r\n" % sum(part_len(part) for part in data))
+                for part in data:
+                    part_write(s, part)
+            else:
+                s.write(b"Content-Length: %d\r\n\r\n" % len(data))
+                s.write(data)
         else:
             s.write(b"\r\n")
 
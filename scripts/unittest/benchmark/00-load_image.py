@@ -0,0 +1,3 @@
+def benchmark(data_path):
+    import image
+    return lambda: image.Image(data_path + "/blobs.ppm", copy_to_fb=True)
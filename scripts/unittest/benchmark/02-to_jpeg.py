@@ -0,0 +1,4 @@
+def benchmark(data_path):
+    import image
+    img = image.Image(data_path + "/blobs.ppm", copy_to_fb=True)
+    return lambda: img.to_jpeg(quality=90, copy=True)
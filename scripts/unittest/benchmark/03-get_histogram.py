@@ -0,0 +1,4 @@
+def benchmark(data_path):
+    import image
+    img = image.Image(data_path + "/cat.pgm", copy_to_fb=True)
+    return lambda: img.get_histogram()
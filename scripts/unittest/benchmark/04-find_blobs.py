@@ -0,0 +1,7 @@
+def benchmark(data_path):
+    import image
+    thresholds = [(0, 100, 56, 95, 41, 74),  # generic_red_thresholds
+                  (0, 100, -128, -22, -128, 99),  # generic_green_thresholds
+                  (0, 100, -128, 98, -128, -16)]     # generic_blue_thresholds
+    img = image.Image(data_path + "/blobs.ppm", copy_to_fb=True)
+    return lambda: img.find_blobs(thresholds, pixels_threshold=2000, area_threshold=200)
@@ -0,0 +1,5 @@
+def benchmark(data_path):
+    import image
+    cascade = image.HaarCascade(data_path + "/frontalface.cascade")
+    img = image.Image(data_path + "/dennis.pgm", copy_to_fb=True)
+    return lambda: img.find_features(cascade, threshold=0.75, scale_factor=1.25)
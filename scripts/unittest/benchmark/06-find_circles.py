@@ -0,0 +1,4 @@
+def benchmark(data_path):
+    import image
+    img = image.Image(data_path + "/shapes.ppm", copy_to_fb=True)
+    return lambda: img.find_circles(threshold=5000, x_margin=30, y_margin=30, r_margin=30)
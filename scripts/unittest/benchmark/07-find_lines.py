@@ -0,0 +1,4 @@
+def benchmark(data_path):
+    import image
+    img = image.Image(data_path + "/shapes.ppm", copy_to_fb=True)
+    return lambda: img.find_lines(threshold=5000, theta_margin=25, rho_margin=25)
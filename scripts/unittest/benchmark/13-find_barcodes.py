@@ -0,0 +1,4 @@
+def benchmark(data_path):
+    import image
+    img = image.Image(data_path + "/barcode.pgm", copy_to_fb=True)
+    return lambda: img.find_barcodes()
@@ -0,0 +1,9 @@
+def benchmark(data_path):
+    import image
+    try:
+        from image import SEARCH_DS
+    except Exception as e:
+        raise Exception("function unavailable")
+    img = image.Image(data_path + "/graffiti.pgm", copy_to_fb=True)
+    temp = image.Image(data_path + "/template.pgm", copy_to_fb=False)
+    return lambda: img.find_template(temp, 0.70, step=4, search=SEARCH_DS)
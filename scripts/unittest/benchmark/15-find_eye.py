@@ -0,0 +1,4 @@
+def benchmark(data_path):
+    import image
+    img = image.Image(data_path + "/eye.pgm", copy_to_fb=True)
+    return lambda: img.find_eye((100, 70, 250, 100))
@@ -0,0 +1,4 @@
+def benchmark(data_path):
+    import image
+    img = image.Image(data_path + "/graffiti.pgm", copy_to_fb=True)
+    return lambda: img.find_keypoints(max_keypoints=150, threshold=20, normalized=False)
@@ -411,27 +411,41 @@ void MLX90640_CalculateTo(uint16_t *frameData, const paramsMLX90640 *params, flo
     float alphaScale;
     float kta;
     float kv;
+    float dTa;
+    float dVdd;
+    float cpFactor;
+    float invEmissivity;
+    float ksTo1;
+    float tgcCP;
     
     subPage = frameData[833];
     vdd = MLX90640_GetVdd(frameData, params);
     ta = MLX90640_GetTa(frameData, params);
     
-    ta4 = (ta + 273.15);
+    // Everything that doesn't depend on the pixel is computed once per
+    // sub-page in single precision (no double constants in the pixel loop).
+    dTa = ta - 25.0f;
+    dVdd = vdd - 3.3f;
+    invEmissivity = 1.0f / emissivity;
+    
+    ta4 = (ta + 273.15f);
     ta4 = ta4 * ta4;
     ta4 = ta4 * ta4;
-    tr4 = (tr + 273.15);
+    tr4 = (tr + 273.15f);
     tr4 = tr4 * tr4;
     tr4 = tr4 * tr4;
-    taTr = tr4 - (tr4-ta4)/emissivity;
+    taTr = tr4 - (tr4-ta4)*invEmissivity;
     
-    ktaScale = pow(2,(float)params->ktaScale);
-    kvScale = pow(2,(float)params->kvScale);
-    alphaScale = pow(2,(float)params->alphaScale);
+    // The scales are powers of 2, so multiplying by the reciprocals is exact.
+    ktaScale = ldexpf(1.0f, -params->ktaScale);
+    kvScale = ldexpf(1.0f, -params->kvScale);
+    alphaScale = (float) SCALEALPHA * ldexpf(1.0f, params->alphaScale) * (1 + params->KsTa * dTa);
     
     alphaCorrR[0] = 1 / (1 + params->ksTo[0] * 40);
     alphaCorrR[1] = 1 ;
     alphaCorrR[2] = (1 + params->ksTo[1] * params->ct[2]);
     alphaCorrR[3] = alphaCorrR[2] * (1 + params->ksTo[2] * (params->ct[3] - params->ct[2]));
+    ksTo1 = 1 - params->ksTo[1] * 273.15f;
     
 //------------------------- Gain calculation -----------------------------------    
     gain = frameData[778];
@@ -455,21 +469,22 @@ void MLX90640_CalculateTo(uint16_t *frameData, const paramsMLX90640 *params, flo
         }
         irDataCP[i] = irDataCP[i] * gain;
     }
-    irDataCP[0] = irDataCP[0] - params->cpOffset[0] * (1 + params->cpKta * (ta - 25)) * (1 + params->cpKv * (vdd - 3.3));
+    cpFactor = (1 + params->cpKta * dTa) * (1 + params->cpKv * dVdd);
+    irDataCP[0] = irDataCP[0] - params->cpOffset[0] * cpFactor;
     if( mode ==  params->calibrationModeEE)
     {
-        irDataCP[1] = irDataCP[1] - params->cpOffset[1] * (1 + params->cpKta * (ta - 25)) * (1 + params->cpKv * (vdd - 3.3));
+        irDataCP[1] = irDataCP[1] - params->cpOffset[1] * cpFactor;
     }
     else
     {
-      irDataCP[1] = irDataCP[1] - (params->cpOffset[1] + params->ilChessC[0]) * (1 + params->cpKta * (ta - 25)) * (1 + params->cpKv * (vdd - 3.3));
+      irDataCP[1] = irDataCP[1] - (params->cpOffset[1] + params->ilChessC[0]) * cpFactor;
     }
+    tgcCP = params->tgc * irDataCP[subPage];
 
     for( int pixelNumber = 0; pixelNumber < 768; pixelNumber++)
     {
         ilPattern = pixelNumber / 32 - (pixelNumber / 64) * 2; 
         chessPattern = ilPattern ^ (pixelNumber - (pixelNumber/2)*2); 
-        conversionPattern = ((pixelNumber + 2) / 4 - (pixelNumber + 3) / 4 + (pixelNumber + 1) / 4 - pixelNumber / 4) * (1 - 2 * ilPattern);
         
         if(mode == 0)
         {
@@ -480,34 +495,30 @@ void MLX90640_CalculateTo(uint16_t *frameData, const paramsMLX90640 *params, flo
           pattern = chessPattern; 
         }               
         
-        if(pattern == frameData[833])
+        if(pattern == subPage)
         {    
-            irData = frameData[pixelNumber];
-            if(irData > 32767)
-            {
-                irData = irData - 65536;
-            }
+            irData = (int16_t) frameData[pixelNumber];
             irData = irData * gain;
             
-            kta = params->kta[pixelNumber]/ktaScale;
-            kv = params->kv[pixelNumber]/kvScale;
-            irData = irData - params->offset[pixelNumber]*(1 + kta*(ta - 25))*(1 + kv*(vdd - 3.3));
+            kta = params->kta[pixelNumber]*ktaScale;
+            kv = params->kv[pixelNumber]*kvScale;
+            irData = irData - params->offset[pixelNumber]*(1 + kta*dTa)*(1 + kv*dVdd);
             
             if(mode !=  params->calibrationModeEE)
             {
+              conversionPattern = ((pixelNumber + 2) / 4 - (pixelNumber + 3) / 4 + (pixelNumber + 1) / 4 - pixelNumber / 4) * (1 - 2 * ilPattern);
               irData = irData + params->ilChessC[2] * (2 * ilPattern - 1) - params->ilChessC[1] * conversionPattern; 
             }                       
     
-            irData = irData - params->tgc * irDataCP[subPage];
-            irData = irData / emissivity;
+            irData = irData - tgcCP;
+            irData = irData * invEmissivity;
             
-            alphaCompensated = SCALEALPHA*alphaScale/params->alpha[pixelNumber];
-            alphaCompensated = alphaCompensated*(1 + params->KsTa * (ta - 25));
+            alphaCompensated = alphaScale/params->alpha[pixelNumber];
                         
             Sx = alphaCompensated * alphaCompensated * alphaCompensated * (irData + alphaCompensated * taTr);
-            Sx = sqrt(sqrt(Sx)) * params->ksTo[1];            
+            Sx = sqrtf(sqrtf(Sx)) * params->ksTo[1];            
             
-            To = sqrt(sqrt(irData/(alphaCompensated * (1 - params->ksTo[1] * 273.15) + Sx) + taTr)) - 273.15;                     
+            To = sqrtf(sqrtf(irData/(alphaCompensated * ksTo1 + Sx) + taTr)) - 273.15f;                     
                     
             if(To < params->ct[1])
             {
@@ -526,7 +537,7 @@ void MLX90640_CalculateTo(uint16_t *frameData, const paramsMLX90640 *params, flo
                 range = 3;            
             }      
             
-            To = sqrt(sqrt(irData / (alphaCompensated * alphaCorrR[range] * (1 + params->ksTo[range] * (To - params->ct[range]))) + taTr)) - 273.15;
+            To = sqrtf(sqrtf(irData / (alphaCompensated * alphaCorrR[range] * (1 + params->ksTo[range] * (To - params->ct[range]))) + taTr)) - 273.15f;
                         
             result[pixelNumber] = To;
         }
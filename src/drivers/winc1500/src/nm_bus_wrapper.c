@@ -10,6 +10,7 @@
  */
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 
 #include "py/mphal.h"
@@ -25,6 +26,7 @@
 
 #define NM_BUS_MAX_TRX_SZ   (4096)
 #define NM_BUS_SPI_TIMEOUT  (1000)
+#define NM_BUS_DMA_MIN_SIZE (256)
 
 static omv_spi_t spi_bus;
 
@@ -40,6 +42,7 @@ sint8 nm_bus_init(void *pvinit) {
 
     spi_config.baudrate    = OMV_WINC_SPI_BAUDRATE;
     spi_config.nss_enable  = false; // Soft NSS
+    spi_config.dma_flags   = OMV_SPI_DMA_NORMAL;
 
     if (omv_spi_init(&spi_bus, &spi_config) != 0) {
         result = M2M_ERR_BUS_FAIL;
@@ -55,6 +58,53 @@ sint8 nm_bus_deinit(void) {
 	return M2M_SUCCESS;
 }
 
+// Large writes (socket data) are sent with DMA, if the DMA can read the buffer.
+static bool nm_bus_dma_capable(const uint8 *txbuf, uint16 size) {
+    if (size < NM_BUS_DMA_MIN_SIZE) {
+        return false;
+    }
+
+    #if defined(D1_DTCMRAM_BASE)
+    // The (128K) DTCM is not accessible by DMA1/2.
+    if (((uintptr_t) txbuf >= D1_DTCMRAM_BASE) && ((uintptr_t) txbuf < (D1_DTCMRAM_BASE + 0x20000))) {
+        return false;
+    }
+    #endif
+
+    return true;
+}
+
+static int nm_bus_write_dma(uint8 *txbuf, uint16 size) {
+    omv_spi_transfer_t spi_xfer = {
+        .txbuf = txbuf,
+        .rxbuf = NULL,
+        .size = size,
+        .timeout = NM_BUS_SPI_TIMEOUT,
+        .flags = OMV_SPI_XFER_DMA,
+        .callback = NULL,
+        .userdata = NULL,
+    };
+
+    #if __DCACHE_PRESENT
+    SCB_CleanDCache_by_Addr((uint32_t *) txbuf, size);
+    #endif
+
+    if (omv_spi_transfer_start(&spi_bus, &spi_xfer) != 0) {
+        return -1;
+    }
+
+    mp_uint_t start = mp_hal_ticks_ms();
+    while (!(spi_bus.xfer_flags & (OMV_SPI_XFER_COMPLETE | OMV_SPI_XFER_FAILED))) {
+        if ((mp_hal_ticks_ms() - start) > NM_BUS_SPI_TIMEOUT) {
+            omv_spi_transfer_abort(&spi_bus);
+            return -1;
+        }
+        __WFI();
+    }
+
+    return (spi_bus.xfer_flags & OMV_SPI_XFER_FAILED) ? -1 : 0;
+}
+
 static sint8 nm_bus_rw(uint8 *txbuf, uint8 *rxbuf, uint16 size) {
     sint8 result = M2M_SUCCESS;
     omv_spi_transfer_t spi_xfer = {
@@ -74,7 +124,13 @@ static sint8 nm_bus_rw(uint8 *txbuf, uint8 *rxbuf, uint16 size) {
     }
 
     omv_gpio_write(spi_bus.cs, 0);
-    omv_spi_transfer_start(&spi_bus, &spi_xfer);
+    if ((rxbuf == NULL) && nm_bus_dma_capable(txbuf, size)) {
+        if (nm_bus_write_dma(txbuf, size) != 0) {
+            result = M2M_ERR_BUS_FAIL;
+        }
+    } else {
+        omv_spi_transfer_start(&spi_bus, &spi_xfer);
+    }
     omv_gpio_write(spi_bus.cs, 1);
 
     return result;
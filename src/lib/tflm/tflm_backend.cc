@@ -17,7 +17,12 @@
 #include "tensorflow/lite/micro/micro_mutable_op_resolver.h"
 #include "tensorflow/lite/micro/cortex_m_generic/debug_log_callback.h"
 #include "tensorflow/lite/micro/micro_interpreter.h"
+#include "tensorflow/lite/micro/micro_profiler_interface.h"
+#include "tensorflow/lite/micro/micro_allocator.h"
+#include "tensorflow/lite/micro/arena_allocator/single_arena_buffer_allocator.h"
+#include "tensorflow/lite/micro/memory_planner/greedy_memory_planner.h"
 #include "tensorflow/lite/schema/schema_generated.h"
+#include "tensorflow/lite/schema/schema_utils.h"
 
 extern "C" {
 #include "py/runtime.h"
@@ -25,6 +30,7 @@ extern "C" {
 #include "py/objlist.h"
 #include "py/objtuple.h"
 #include "py/binary.h"
+#include "py/mphal.h"
 #include "py_ml.h"
 #include "fb_alloc.h"
 
@@ -32,11 +38,50 @@ using namespace tflite;
 #define TF_ARENA_ALIGNMENT  (16 - 1)
 typedef MicroMutableOpResolver<113> MicroOpsResolver;
 
+typedef struct ml_backend_event {
+    const char *tag;
+    uint32_t start;
+    uint32_t cycles;
+} ml_backend_event_t;
+
+// Records the cycles spent in each operator of the last inference.
+class MLBackendProfiler : public MicroProfilerInterface {
+    public:
+        ml_backend_event_t *events;
+        size_t max_events;
+        size_t n_events;
+
+        uint32_t BeginEvent(const char *tag) override {
+            if (n_events >= max_events) {
+                return max_events;
+            }
+            events[n_events].tag = tag;
+            events[n_events].start = mp_hal_ticks_cpu();
+            return n_events++;
+        }
+
+        void EndEvent(uint32_t event_handle) override {
+            if (event_handle < max_events) {
+                events[event_handle].cycles = mp_hal_ticks_cpu() - events[event_handle].start;
+            }
+        }
+};
+
+// Non-persistent (activations and scratch buffers) arena shared by models that never run at the
+// same time. The owner is the last model that used it, whose tensors are still valid.
+typedef struct ml_backend_shared_arena {
+    size_t size;
+    py_ml_model_obj_t *owner;
+    uint8_t *data;
+} ml_backend_shared_arena_t;
+
 typedef struct ml_backend_state {
     void *arena;
+    ml_backend_shared_arena_t *shared;
     const Model *model;
     MicroOpsResolver *resolver;
     MicroInterpreter *interpreter;
+    MLBackendProfiler *profiler;
 } ml_backend_state_t;
 
 void abort(void) {
@@ -71,159 +116,349 @@ static char ml_backend_map_dtype(TfLiteType type) {
     }
 }
 
-static void ml_backend_init_ops_resolver(MicroOpsResolver *resolver) {
-    resolver->AddAbs();
-    resolver->AddAdd();
-    resolver->AddAddN();
-    resolver->AddArgMax();
-    resolver->AddArgMin();
-    resolver->AddAssignVariable();
-    resolver->AddAveragePool2D();
-    resolver->AddBatchMatMul();
-    resolver->AddBatchToSpaceNd();
-    resolver->AddBroadcastArgs();
-    resolver->AddBroadcastTo();
-    resolver->AddCallOnce();
-    resolver->AddCast();
-    resolver->AddCeil();
+// Custom operators (Ethos-U and the signal library) are identified by name, they're all added if
+// the model uses any custom operator.
+static void ml_backend_add_custom_ops(MicroOpsResolver *resolver) {
     resolver->AddCircularBuffer();
-    resolver->AddConcatenation();
-    resolver->AddConv2D();
-    resolver->AddCos();
-    resolver->AddCumSum();
     resolver->AddDelay();
-    resolver->AddDepthToSpace();
-    resolver->AddDepthwiseConv2D();
-    resolver->AddDequantize();
-    //resolver->AddDetectionPostprocess();
-    resolver->AddDiv();
-    resolver->AddElu();
-    resolver->AddEmbeddingLookup();
     resolver->AddEnergy();
-    resolver->AddEqual();
     #ifdef ETHOS_U
     resolver->AddEthosU();
     #endif
-    resolver->AddExp();
-    resolver->AddExpandDims();
     resolver->AddFftAutoScale();
-    resolver->AddFill();
     resolver->AddFilterBank();
     resolver->AddFilterBankLog();
     resolver->AddFilterBankSpectralSubtraction();
     resolver->AddFilterBankSquareRoot();
-    resolver->AddFloor();
-    resolver->AddFloorDiv();
-    resolver->AddFloorMod();
     resolver->AddFramer();
-    resolver->AddFullyConnected();
-    resolver->AddGather();
-    resolver->AddGatherNd();
-    resolver->AddGreater();
-    resolver->AddGreaterEqual();
-    resolver->AddHardSwish();
-    resolver->AddIf();
     resolver->AddIrfft();
-    resolver->AddL2Normalization();
-    resolver->AddL2Pool2D();
-    resolver->AddLeakyRelu();
-    resolver->AddLess();
-    resolver->AddLessEqual();
-    resolver->AddLog();
-    resolver->AddLogSoftmax();
-    resolver->AddLogicalAnd();
-    resolver->AddLogicalNot();
-    resolver->AddLogicalOr();
-    resolver->AddLogistic();
-    resolver->AddMaxPool2D();
-    resolver->AddMaximum();
-    resolver->AddMean();
-    resolver->AddMinimum();
-    resolver->AddMirrorPad();
-    resolver->AddMul();
-    resolver->AddNeg();
-    resolver->AddNotEqual();
     resolver->AddOverlapAdd();
     resolver->AddPCAN();
-    resolver->AddPack();
-    resolver->AddPad();
-    resolver->AddPadV2();
-    resolver->AddPrelu();
-    resolver->AddQuantize();
-    resolver->AddReadVariable();
-    resolver->AddReduceMax();
-    resolver->AddRelu();
-    resolver->AddRelu6();
-    resolver->AddReshape();
-    resolver->AddResizeBilinear();
-    resolver->AddResizeNearestNeighbor();
     resolver->AddRfft();
-    resolver->AddRound();
-    resolver->AddRsqrt();
-    resolver->AddSelectV2();
-    resolver->AddShape();
-    resolver->AddSin();
-    resolver->AddSlice();
-    resolver->AddSoftmax();
-    resolver->AddSpaceToBatchNd();
-    resolver->AddSpaceToDepth();
-    resolver->AddSplit();
-    resolver->AddSplitV();
-    resolver->AddSqrt();
-    resolver->AddSquare();
-    resolver->AddSquaredDifference();
-    resolver->AddSqueeze();
     resolver->AddStacker();
-    resolver->AddStridedSlice();
-    resolver->AddSub();
-    resolver->AddSum();
-    resolver->AddSvdf();
-    resolver->AddTanh();
-    resolver->AddTranspose();
-    resolver->AddTransposeConv();
-    resolver->AddUnidirectionalSequenceLSTM();
-    resolver->AddUnpack();
-    resolver->AddVarHandle();
-    resolver->AddWhile();
     resolver->AddWindow();
-    resolver->AddZerosLike();
 }
 
-int ml_backend_init_model(py_ml_model_obj_t *model) {
-    RegisterDebugLogCallback(ml_backend_log_handler);
+#define ML_BACKEND_OP(op, func) case BuiltinOperator_##op: resolver->func(); break
+
+static bool ml_backend_add_op(MicroOpsResolver *resolver, BuiltinOperator op) {
+    switch (op) {
+        ML_BACKEND_OP(ABS, AddAbs);
+        ML_BACKEND_OP(ADD, AddAdd);
+        ML_BACKEND_OP(ADD_N, AddAddN);
+        ML_BACKEND_OP(ARG_MAX, AddArgMax);
+        ML_BACKEND_OP(ARG_MIN, AddArgMin);
+        ML_BACKEND_OP(ASSIGN_VARIABLE, AddAssignVariable);
+        ML_BACKEND_OP(AVERAGE_POOL_2D, AddAveragePool2D);
+        ML_BACKEND_OP(BATCH_MATMUL, AddBatchMatMul);
+        ML_BACKEND_OP(BATCH_TO_SPACE_ND, AddBatchToSpaceNd);
+        ML_BACKEND_OP(BROADCAST_ARGS, AddBroadcastArgs);
+        ML_BACKEND_OP(BROADCAST_TO, AddBroadcastTo);
+        ML_BACKEND_OP(CALL_ONCE, AddCallOnce);
+        ML_BACKEND_OP(CAST, AddCast);
+        ML_BACKEND_OP(CEIL, AddCeil);
+        ML_BACKEND_OP(CONCATENATION, AddConcatenation);
+        ML_BACKEND_OP(CONV_2D, AddConv2D);
+        ML_BACKEND_OP(COS, AddCos);
+        ML_BACKEND_OP(CUMSUM, AddCumSum);
+        ML_BACKEND_OP(DEPTH_TO_SPACE, AddDepthToSpace);
+        ML_BACKEND_OP(DEPTHWISE_CONV_2D, AddDepthwiseConv2D);
+        ML_BACKEND_OP(DEQUANTIZE, AddDequantize);
+        ML_BACKEND_OP(DIV, AddDiv);
+        ML_BACKEND_OP(ELU, AddElu);
+        ML_BACKEND_OP(EMBEDDING_LOOKUP, AddEmbeddingLookup);
+        ML_BACKEND_OP(EQUAL, AddEqual);
+        ML_BACKEND_OP(EXP, AddExp);
+        ML_BACKEND_OP(EXPAND_DIMS, AddExpandDims);
+        ML_BACKEND_OP(FILL, AddFill);
+        ML_BACKEND_OP(FLOOR, AddFloor);
+        ML_BACKEND_OP(FLOOR_DIV, AddFloorDiv);
+        ML_BACKEND_OP(FLOOR_MOD, AddFloorMod);
+        ML_BACKEND_OP(FULLY_CONNECTED, AddFullyConnected);
+        ML_BACKEND_OP(GATHER, AddGather);
+        ML_BACKEND_OP(GATHER_ND, AddGatherNd);
+        ML_BACKEND_OP(GREATER, AddGreater);
+        ML_BACKEND_OP(GREATER_EQUAL, AddGreaterEqual);
+        ML_BACKEND_OP(HARD_SWISH, AddHardSwish);
+        ML_BACKEND_OP(IF, AddIf);
+        ML_BACKEND_OP(L2_NORMALIZATION, AddL2Normalization);
+        ML_BACKEND_OP(L2_POOL_2D, AddL2Pool2D);
+        ML_BACKEND_OP(LEAKY_RELU, AddLeakyRelu);
+        ML_BACKEND_OP(LESS, AddLess);
+        ML_BACKEND_OP(LESS_EQUAL, AddLessEqual);
+        ML_BACKEND_OP(LOG, AddLog);
+        ML_BACKEND_OP(LOG_SOFTMAX, AddLogSoftmax);
+        ML_BACKEND_OP(LOGICAL_AND, AddLogicalAnd);
+        ML_BACKEND_OP(LOGICAL_NOT, AddLogicalNot);
+        ML_BACKEND_OP(LOGICAL_OR, AddLogicalOr);
+        ML_BACKEND_OP(LOGISTIC, AddLogistic);
+        ML_BACKEND_OP(MAX_POOL_2D, AddMaxPool2D);
+        ML_BACKEND_OP(MAXIMUM, AddMaximum);
+        ML_BACKEND_OP(MEAN, AddMean);
+        ML_BACKEND_OP(MINIMUM, AddMinimum);
+        ML_BACKEND_OP(MIRROR_PAD, AddMirrorPad);
+        ML_BACKEND_OP(MUL, AddMul);
+        ML_BACKEND_OP(NEG, AddNeg);
+        ML_BACKEND_OP(NOT_EQUAL, AddNotEqual);
+        ML_BACKEND_OP(PACK, AddPack);
+        ML_BACKEND_OP(PAD, AddPad);
+        ML_BACKEND_OP(PADV2, AddPadV2);
+        ML_BACKEND_OP(PRELU, AddPrelu);
+        ML_BACKEND_OP(QUANTIZE, AddQuantize);
+        ML_BACKEND_OP(READ_VARIABLE, AddReadVariable);
+        ML_BACKEND_OP(REDUCE_MAX, AddReduceMax);
+        ML_BACKEND_OP(RELU, AddRelu);
+        ML_BACKEND_OP(RELU6, AddRelu6);
+        ML_BACKEND_OP(RESHAPE, AddReshape);
+        ML_BACKEND_OP(RESIZE_BILINEAR, AddResizeBilinear);
+        ML_BACKEND_OP(RESIZE_NEAREST_NEIGHBOR, AddResizeNearestNeighbor);
+        ML_BACKEND_OP(ROUND, AddRound);
+        ML_BACKEND_OP(RSQRT, AddRsqrt);
+        ML_BACKEND_OP(SELECT_V2, AddSelectV2);
+        ML_BACKEND_OP(SHAPE, AddShape);
+        ML_BACKEND_OP(SIN, AddSin);
+        ML_BACKEND_OP(SLICE, AddSlice);
+        ML_BACKEND_OP(SOFTMAX, AddSoftmax);
+        ML_BACKEND_OP(SPACE_TO_BATCH_ND, AddSpaceToBatchNd);
+        ML_BACKEND_OP(SPACE_TO_DEPTH, AddSpaceToDepth);
+        ML_BACKEND_OP(SPLIT, AddSplit);
+        ML_BACKEND_OP(SPLIT_V, AddSplitV);
+        ML_BACKEND_OP(SQRT, AddSqrt);
+        ML_BACKEND_OP(SQUARE, AddSquare);
+        ML_BACKEND_OP(SQUARED_DIFFERENCE, AddSquaredDifference);
+        ML_BACKEND_OP(SQUEEZE, AddSqueeze);
+        ML_BACKEND_OP(STRIDED_SLICE, AddStridedSlice);
+        ML_BACKEND_OP(SUB, AddSub);
+        ML_BACKEND_OP(SUM, AddSum);
+        ML_BACKEND_OP(SVDF, AddSvdf);
+        ML_BACKEND_OP(TANH, AddTanh);
+        ML_BACKEND_OP(TRANSPOSE, AddTranspose);
+        ML_BACKEND_OP(TRANSPOSE_CONV, AddTransposeConv);
+        ML_BACKEND_OP(UNIDIRECTIONAL_SEQUENCE_LSTM, AddUnidirectionalSequenceLSTM);
+        ML_BACKEND_OP(UNPACK, AddUnpack);
+        ML_BACKEND_OP(VAR_HANDLE, AddVarHandle);
+        ML_BACKEND_OP(WHILE, AddWhile);
+        ML_BACKEND_OP(ZEROS_LIKE, AddZerosLike);
+        default:
+            return false;
+    }
+    return true;
+}
 
-    // Parse model's data.
-    const Model *tflite_model = GetModel(model->data);
-    if (tflite_model->version() != TFLITE_SCHEMA_VERSION) {
-        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unsupported model schema"));
+// Registers only the operators used by the model. Operator codes may repeat with different
+// versions, so each operator is added once.
+static void ml_backend_init_ops_resolver(MicroOpsResolver *resolver, const Model *tflite_model) {
+    uint32_t added[256 / 32] = { 0 };
+    bool custom_added = false;
+    const auto *opcodes = tflite_model->operator_codes();
+
+    for (size_t i = 0; opcodes && (i < opcodes->size()); i++) {
+        BuiltinOperator op = GetBuiltinCode(opcodes->Get(i));
+
+        if (op == BuiltinOperator_CUSTOM) {
+            if (!custom_added) {
+                ml_backend_add_custom_ops(resolver);
+                custom_added = true;
+            }
+        } else if ((op >= 256) || (!(added[op / 32] & (1 << (op % 32))))) {
+            if (!ml_backend_add_op(resolver, op)) {
+                mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("Unsupported operator %d"), op);
+            }
+            if (op < 256) {
+                added[op / 32] |= 1 << (op % 32);
+            }
+        }
+    }
+}
+
+// The arena size of recently loaded models is cached, so loading a model again (or switching
+// between models) builds the interpreter only once. Models are identified by the djb2 hash of
+// their operator sequence (same as tools/tflite_model_hash.py) and their size.
+#define ML_BACKEND_PLAN_CACHE_SIZE  (8)
+
+typedef struct ml_backend_plan {
+    uint32_t hash;
+    uint32_t model_size;
+    uint32_t persistent_size;
+    uint32_t non_persistent_size;
+} ml_backend_plan_t;
+
+static ml_backend_plan_t ml_backend_plans[ML_BACKEND_PLAN_CACHE_SIZE];
+static size_t ml_backend_plans_next;
+
+static uint32_t ml_backend_model_hash(const Model *tflite_model) {
+    uint32_t hash = 5381;
+    const auto *opcodes = tflite_model->operator_codes();
+    const auto *subgraphs = tflite_model->subgraphs();
+
+    if (opcodes && subgraphs && subgraphs->size() && subgraphs->Get(0)->operators()) {
+        const auto *operators = subgraphs->Get(0)->operators();
+        for (size_t i = 0; i < operators->size(); i++) {
+            uint32_t op = GetBuiltinCode(opcodes->Get(operators->Get(i)->opcode_index()));
+            for (size_t j = 0; j < sizeof(op); j++) {
+                hash = ((hash << 5) + hash) + ((op >> (j * 8)) & 0xFF);
+            }
+        }
     }
 
-    // Initialize the op resolver.
-    MicroOpsResolver resolver;
-    ml_backend_init_ops_resolver(&resolver);
+    return hash;
+}
+
+static ml_backend_plan_t *ml_backend_find_plan(uint32_t hash, uint32_t model_size) {
+    for (size_t i = 0; i < ML_BACKEND_PLAN_CACHE_SIZE; i++) {
+        ml_backend_plan_t *plan = &ml_backend_plans[i];
+        if (plan->persistent_size && (plan->hash == hash) && (plan->model_size == model_size)) {
+            return plan;
+        }
+    }
+    return NULL;
+}
 
-    // Allocate the interpreter and tensors once to initialize the model, check input
-    // and output data types and to get the optimal tensor arena size.
+// Builds the interpreter in a temporary arena to find the size of the persistent (model state)
+// and non-persistent (activations) parts of the arena the model needs.
+static void ml_backend_measure_arena(const Model *tflite_model, MicroOpsResolver *resolver, ml_backend_plan_t *plan) {
     fb_alloc_mark();
     uint32_t tensor_arena_size;
     uint8_t *tensor_arena = (uint8_t *) fb_alloc_all(&tensor_arena_size, FB_ALLOC_PREFER_SIZE | FB_ALLOC_CACHE_ALIGN);
 
-    MicroInterpreter interpreter(tflite_model,
-                                 resolver,
-                                 tensor_arena,
-                                 tensor_arena_size);
+    SingleArenaBufferAllocator *buffer_allocator = SingleArenaBufferAllocator::Create(tensor_arena, tensor_arena_size);
+    uint8_t *planner_buffer = buffer_allocator->AllocatePersistentBuffer(sizeof(GreedyMemoryPlanner),
+                                                                        alignof(GreedyMemoryPlanner));
+    GreedyMemoryPlanner *planner = new(planner_buffer) GreedyMemoryPlanner();
+    MicroAllocator *allocator = MicroAllocator::Create(buffer_allocator, planner);
+
+    MicroInterpreter interpreter(tflite_model, *resolver, allocator);
     if (interpreter.AllocateTensors() != kTfLiteOk) {
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Failed to allocate tensors"));
     }
 
-    model->inputs_size = interpreter.inputs_size();
+    plan->persistent_size = buffer_allocator->GetPersistentUsedBytes() + 512;
+    plan->non_persistent_size = buffer_allocator->GetNonPersistentUsedBytes() + 512;
+    fb_alloc_free_till_mark();
+}
+
+// Returns the shared arena, allocating a larger one if it's too small. Models using a previous
+// arena keep it alive, so only models loaded with the same arena share memory.
+static ml_backend_shared_arena_t *ml_backend_get_shared_arena(size_t size) {
+    ml_backend_shared_arena_t *shared = (ml_backend_shared_arena_t *) MP_STATE_PORT(ml_shared_arena);
+
+    if ((!shared) || (shared->size < size)) {
+        shared = m_new0(ml_backend_shared_arena_t, 1);
+        shared->size = size;
+        shared->data = m_new(uint8_t, size + TF_ARENA_ALIGNMENT);
+        MP_STATE_PORT(ml_shared_arena) = shared;
+    }
+
+    return shared;
+}
+
+static bool ml_backend_init_interpreter(ml_backend_state_t *state, ml_backend_plan_t *plan, bool shared) {
+    size_t arena_size = plan->persistent_size + (shared ? 0 : plan->non_persistent_size);
+    state->arena = m_new(char, arena_size + TF_ARENA_ALIGNMENT);
+    uint8_t *aligned_arena = (uint8_t *) (((uintptr_t) state->arena + TF_ARENA_ALIGNMENT) & ~(TF_ARENA_ALIGNMENT));
+
+    if (shared) {
+        state->shared = ml_backend_get_shared_arena(plan->non_persistent_size);
+        uint8_t *aligned_shared = (uint8_t *) (((uintptr_t) state->shared->data + TF_ARENA_ALIGNMENT) &
+                                               ~(TF_ARENA_ALIGNMENT));
+        MicroAllocator *allocator = MicroAllocator::Create(aligned_arena, plan->persistent_size,
+                                                           aligned_shared, state->shared->size);
+        if (allocator) {
+            state->interpreter = new(m_new0(MicroInterpreter, 1)) MicroInterpreter(state->model,
+                                                                                   *state->resolver,
+                                                                                   allocator,
+                                                                                   nullptr,
+                                                                                   state->profiler);
+        }
+    } else {
+        state->interpreter = new(m_new0(MicroInterpreter, 1)) MicroInterpreter(state->model,
+                                                                               *state->resolver,
+                                                                               aligned_arena,
+                                                                               arena_size,
+                                                                               nullptr,
+                                                                               state->profiler);
+    }
+
+    if (state->interpreter && (state->interpreter->AllocateTensors() == kTfLiteOk)) {
+        // Allocating tensors overwrites the activations of the previous owner.
+        if (state->shared) {
+            state->shared->owner = NULL;
+        }
+        return true;
+    }
+
+    m_del(char, state->arena, arena_size + TF_ARENA_ALIGNMENT);
+    if (state->interpreter) {
+        m_del(MicroInterpreter, state->interpreter, 1);
+    }
+    state->arena = NULL;
+    state->shared = NULL;
+    state->interpreter = NULL;
+    return false;
+}
+
+static int ml_backend_init_model(py_ml_model_obj_t *model) {
+    RegisterDebugLogCallback(ml_backend_log_handler);
+
+    // Parse model's data.
+    const Model *tflite_model = GetModel(model->data);
+    if (tflite_model->version() != TFLITE_SCHEMA_VERSION) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unsupported model schema"));
+    }
+
+    // Allocate the persistent state and initialize the op resolver.
+    ml_backend_state_t *state = m_new0(ml_backend_state_t, 1);
+    state->model = tflite_model;
+    state->resolver = new(m_new0(MicroOpsResolver, 1)) MicroOpsResolver();
+    ml_backend_init_ops_resolver(state->resolver, tflite_model);
+
+    // One event per operator of the main graph, control flow operators may add more.
+    const auto *subgraphs = tflite_model->subgraphs();
+    state->profiler = new(m_new0(MLBackendProfiler, 1)) MLBackendProfiler();
+    state->profiler->max_events = 0;
+    for (size_t i = 0; subgraphs && (i < subgraphs->size()); i++) {
+        if (subgraphs->Get(i)->operators()) {
+            state->profiler->max_events += subgraphs->Get(i)->operators()->size();
+        }
+    }
+    state->profiler->events = m_new(ml_backend_event_t, state->profiler->max_events);
+    state->profiler->n_events = 0;
+
+    // Build the interpreter directly with a cached arena size. If the model isn't cached, or
+    // the cached size turns out to be too small, the arena size is measured first.
+    uint32_t hash = ml_backend_model_hash(tflite_model);
+    ml_backend_plan_t *plan = ml_backend_find_plan(hash, model->size);
+
+    if ((!plan) || (!ml_backend_init_interpreter(state, plan, model->shared_arena))) {
+        if (!plan) {
+            plan = &ml_backend_plans[ml_backend_plans_next];
+            ml_backend_plans_next = (ml_backend_plans_next + 1) % ML_BACKEND_PLAN_CACHE_SIZE;
+        }
+
+        // Invalidate the entry until the model is successfully initialized.
+        plan->persistent_size = 0;
+        ml_backend_plan_t new_plan = { hash, model->size, 0, 0 };
+        ml_backend_measure_arena(tflite_model, state->resolver, &new_plan);
+
+        if (!ml_backend_init_interpreter(state, &new_plan, model->shared_arena)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Failed to allocate tensors"));
+        }
+
+        *plan = new_plan;
+    }
+
+    // With a shared arena only the persistent part is owned by the model.
+    MicroInterpreter *interpreter = state->interpreter;
+    model->memory_size = plan->persistent_size + (model->shared_arena ? 0 : plan->non_persistent_size);
+
+    model->inputs_size = interpreter->inputs_size();
     model->input_shape = (mp_obj_tuple_t *) MP_OBJ_TO_PTR(mp_obj_new_tuple(model->inputs_size, NULL));
     model->input_scale = (mp_obj_tuple_t *) MP_OBJ_TO_PTR(mp_obj_new_tuple(model->inputs_size, NULL));
     model->input_zero_point = (mp_obj_tuple_t *) MP_OBJ_TO_PTR(mp_obj_new_tuple(model->inputs_size, NULL));
     model->input_dtype = (mp_obj_tuple_t *) MP_OBJ_TO_PTR(mp_obj_new_tuple(model->inputs_size, NULL));
 
     for (size_t i=0; i<model->inputs_size; i++) {
-        TfLiteTensor *input = interpreter.input(i);
+        TfLiteTensor *input = interpreter->input(i);
 
         // Check input data type.
         if (!ml_backend_valid_dataype(input->type)) {
@@ -242,14 +477,14 @@ int ml_backend_init_model(py_ml_model_obj_t *model) {
         model->input_dtype->items[i] = mp_obj_new_int(ml_backend_map_dtype(input->type));
     }
 
-    model->outputs_size = interpreter.outputs_size();
+    model->outputs_size = interpreter->outputs_size();
     model->output_shape = (mp_obj_tuple_t *) MP_OBJ_TO_PTR(mp_obj_new_tuple(model->outputs_size, NULL));
     model->output_scale = (mp_obj_tuple_t *) MP_OBJ_TO_PTR(mp_obj_new_tuple(model->outputs_size, NULL));
     model->output_zero_point = (mp_obj_tuple_t *) MP_OBJ_TO_PTR(mp_obj_new_tuple(model->outputs_size, NULL));
     model->output_dtype = (mp_obj_tuple_t *) MP_OBJ_TO_PTR(mp_obj_new_tuple(model->outputs_size, NULL));
 
     for (size_t i=0; i<model->outputs_size; i++) {
-        TfLiteTensor *output = interpreter.output(i);
+        TfLiteTensor *output = interpreter->output(i);
 
         // Check output data type.
         if (!ml_backend_valid_dataype(output->type)) {
@@ -268,35 +503,16 @@ int ml_backend_init_model(py_ml_model_obj_t *model) {
         model->output_dtype->items[i] = mp_obj_new_int(ml_backend_map_dtype(output->type));
     }
 
-    model->memory_size = interpreter.arena_used_bytes() + 1024;
-
-    // Free the temporary arena.
-    fb_alloc_free_till_mark();
-
-    // Allocate the persistent state.
-    ml_backend_state_t *state = m_new0(ml_backend_state_t, 1);
-    state->model = GetModel(model->data);
-    state->arena = m_new(char, model->memory_size + TF_ARENA_ALIGNMENT);
-    state->resolver = new(m_new0(MicroOpsResolver, 1)) MicroOpsResolver();
-    ml_backend_init_ops_resolver(state->resolver);
-    uint8_t *aligned_arena = (uint8_t *) (((uintptr_t) state->arena + TF_ARENA_ALIGNMENT) & ~(TF_ARENA_ALIGNMENT));
-    state->interpreter = new(m_new0(MicroInterpreter, 1)) MicroInterpreter(state->model,
-                                                                           *state->resolver,
-                                                                           aligned_arena,
-                                                                           model->memory_size);
-    if (state->interpreter->AllocateTensors() != kTfLiteOk) {
-        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Failed to allocate tensors"));
-    }
-
     model->state = state;
     model->memory_addr = (uint32_t) state->arena;
     return 0;
 }
 
-int ml_backend_run_inference(py_ml_model_obj_t *model) {
+static int ml_backend_run_inference(py_ml_model_obj_t *model) {
     RegisterDebugLogCallback(ml_backend_log_handler);
     ml_backend_state_t *state = (ml_backend_state_t *) model->state;
 
+    state->profiler->n_events = 0;
     if (state->interpreter->Invoke() != kTfLiteOk) {
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invoke failed"));
     }
@@ -304,7 +520,95 @@ int ml_backend_run_inference(py_ml_model_obj_t *model) {
     return 0;
 }
 
-void *ml_backend_get_input(py_ml_model_obj_t *model, size_t index) {
+static py_ml_model_obj_t *ml_backend_acquire_arena(py_ml_model_obj_t *model) {
+    ml_backend_state_t *state = (ml_backend_state_t *) model->state;
+    if ((!state->shared) || (state->shared->owner == model)) {
+        return NULL;
+    }
+
+    py_ml_model_obj_t *owner = state->shared->owner;
+    state->shared->owner = model;
+    return owner;
+}
+
+// TFLM's Ethos-U operator waits for the NPU inside Invoke(), so the inference is always done
+// when ml_backend_start_inference() returns.
+static int ml_backend_start_inference(py_ml_model_obj_t *model) {
+    return ml_backend_run_inference(model);
+}
+
+static bool ml_backend_wait_inference(py_ml_model_obj_t *model, bool block) {
+    return true;
+}
+
+static size_t ml_backend_tensor_type_size(TensorType type) {
+    switch (type) {
+        case TensorType_FLOAT64:
+        case TensorType_INT64:
+        case TensorType_UINT64:
+        case TensorType_COMPLEX64:
+            return 8;
+        case TensorType_FLOAT32:
+        case TensorType_INT32:
+        case TensorType_UINT32:
+            return 4;
+        case TensorType_FLOAT16:
+        case TensorType_INT16:
+        case TensorType_UINT16:
+            return 2;
+        default:
+            return 1;
+    }
+}
+
+// Bytes of the non-constant tensors (inputs, outputs and intermediates) used by an operator of
+// the main graph. Constant tensors are read from the model and don't use the arena.
+static size_t ml_backend_op_arena_bytes(const Model *tflite_model, size_t index) {
+    const auto *subgraph = tflite_model->subgraphs()->Get(0);
+    const auto *op = subgraph->operators()->Get(index);
+    const flatbuffers::Vector<int32_t> *lists[3] = { op->inputs(), op->outputs(), op->intermediates() };
+    size_t bytes = 0;
+
+    for (size_t l = 0; l < 3; l++) {
+        for (size_t i = 0; lists[l] && (i < lists[l]->size()); i++) {
+            int32_t t = lists[l]->Get(i);
+            if (t < 0) {
+                continue; // Optional tensor.
+            }
+
+            const Tensor *tensor = subgraph->tensors()->Get(t);
+            const Buffer *buffer = tflite_model->buffers()->Get(tensor->buffer());
+            if (buffer && buffer->data() && buffer->data()->size()) {
+                continue;
+            }
+
+            size_t size = ml_backend_tensor_type_size(tensor->type());
+            for (size_t j = 0; tensor->shape() && (j < tensor->shape()->size()); j++) {
+                size *= tensor->shape()->Get(j);
+            }
+            bytes += size;
+        }
+    }
+
+    return bytes;
+}
+
+static bool ml_backend_get_profile(py_ml_model_obj_t *model, size_t index, ml_backend_op_profile_t *profile) {
+    ml_backend_state_t *state = (ml_backend_state_t *) model->state;
+    if (index >= state->profiler->n_events) {
+        return false;
+    }
+
+    const auto *operators = state->model->subgraphs()->Get(0)->operators();
+    profile->name = state->profiler->events[index].tag;
+    profile->cycles = state->profiler->events[index].cycles;
+    // Events map to the main graph operators unless the model uses control flow.
+    bool main_graph = (state->profiler->n_events == operators->size());
+    profile->arena_bytes = main_graph ? ml_backend_op_arena_bytes(state->model, index) : 0;
+    return true;
+}
+
+static void *ml_backend_get_input(py_ml_model_obj_t *model, size_t index) {
     ml_backend_state_t *state = (ml_backend_state_t *) model->state;
     if (index < state->interpreter->inputs_size()) {
         return state->interpreter->input(index)->data.data;
@@ -312,12 +616,23 @@ void *ml_backend_get_input(py_ml_model_obj_t *model, size_t index) {
     mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid input tensor index"));
 }
 
-void *ml_backend_get_output(py_ml_model_obj_t *model, size_t index) {
+static void *ml_backend_get_output(py_ml_model_obj_t *model, size_t index) {
     ml_backend_state_t *state = (ml_backend_state_t *) model->state;
     if (index < state->interpreter->outputs_size()) {
         return state->interpreter->output(index)->data.data;
     }
     mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid output tensor index"));
 }
+
+const ml_backend_t ml_backend_tflm = {
+    ml_backend_init_model,
+    ml_backend_acquire_arena,
+    ml_backend_run_inference,
+    ml_backend_start_inference,
+    ml_backend_wait_inference,
+    ml_backend_get_profile,
+    ml_backend_get_input,
+    ml_backend_get_output,
+};
 } // extern "C"
 #endif // IMLIB_ENABLE_TFLM
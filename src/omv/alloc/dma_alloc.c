@@ -10,6 +10,11 @@
  *
  * This is a very simple dynamic memory allocator for DMA buffers, that
  * can allocate memory in multiple domains based on the board configuration.
+ *
+ * Blocks are reference counted, so a buffer can be shared by a peripheral and by the code
+ * consuming its data, and it's only returned to the chain when the last reference is dropped.
+ * Blocks start and end on cache lines, and the cache maintenance is done per block, based on
+ * who owns the block (the CPU or the DMA), so redundant clean/invalidate calls are skipped.
  */
 #include <string.h>
 #include <stdint.h>
@@ -23,15 +28,20 @@
 typedef union block block_t;
 union block {
     struct {
-        uint32_t used;  // Set to 1/true if the block is used.
+        uint16_t refs;  // Number of references to the block, 0 if the block is free.
+        uint16_t owner; // DMA_OWNER_CPU or DMA_OWNER_DMA.
         uint32_t size;  // Size of the memory block in bytes.
         void *periph;   // The peripheral that owns this block.
         block_t *next;  // Pointer to the the next block in chain.
     };
-    // Make sure that blocks are always aligned to 32 bytes.
+    // Make sure that blocks are always aligned to 32 bytes (a cache line).
     uint8_t alignment[32];
 };// Actual block memory starts right after the block header.
 
+// Block ownership, used to skip redundant cache maintenance.
+#define DMA_OWNER_CPU       (0)
+#define DMA_OWNER_DMA       (1)
+
 // Note block sizes can Not be adjusted after the first allocation.
 // When a block is allocated the first time, the block size is fixed to the requested
 // memory size, when the block is free'd and reused again the same block size is used.
@@ -50,20 +60,21 @@ union block {
 #define INIT_BLOCK_CHAIN(D)                                         \
     ({                                                              \
         block_t *block = (block_t *) DMA_MEMORY_##D;                \
-        block->used = false;                                        \
+        block->refs = 0;                                            \
+        block->owner = DMA_OWNER_CPU;                               \
         block->size = OMV_DMA_ALLOC_ ##D ##_SIZE - sizeof(block_t); \
         block->next = NULL;                                         \
         block->periph = NULL;                                       \
     })
 
 #if defined(OMV_DMA_ALLOC_D1_SIZE)
-static uint8_t OMV_ATTR_SECTION(OMV_ATTR_ALIGNED(DMA_MEMORY_D1[OMV_DMA_ALLOC_D1_SIZE], 16), ".d1_dma_buffer");
+static uint8_t OMV_ATTR_SECTION(OMV_ATTR_ALIGNED_DMA(DMA_MEMORY_D1[OMV_DMA_ALLOC_D1_SIZE]), ".d1_dma_buffer");
 #endif
 #if defined(OMV_DMA_ALLOC_D2_SIZE)
-static uint8_t OMV_ATTR_SECTION(OMV_ATTR_ALIGNED(DMA_MEMORY_D2[OMV_DMA_ALLOC_D2_SIZE], 16), ".d2_dma_buffer");
+static uint8_t OMV_ATTR_SECTION(OMV_ATTR_ALIGNED_DMA(DMA_MEMORY_D2[OMV_DMA_ALLOC_D2_SIZE]), ".d2_dma_buffer");
 #endif
 #if defined(OMV_DMA_ALLOC_D3_SIZE)
-static uint8_t OMV_ATTR_SECTION(OMV_ATTR_ALIGNED(DMA_MEMORY_D3[OMV_DMA_ALLOC_D3_SIZE], 16), ".d3_dma_buffer");
+static uint8_t OMV_ATTR_SECTION(OMV_ATTR_ALIGNED_DMA(DMA_MEMORY_D3[OMV_DMA_ALLOC_D3_SIZE]), ".d3_dma_buffer");
 #endif
 
 NORETURN static void dma_alloc_fail(uint32_t size) {
@@ -156,7 +167,7 @@ void *dma_alloc(uint32_t size, void *periph) {
 
     block_t *block;
     for (block = block_chain_start; block != NULL; block = block->next) {
-        if (!block->used && block->size >= size) {
+        if (!block->refs && block->size >= size) {
             // Found a free block that's large enough.
             break;
         }
@@ -180,7 +191,8 @@ void *dma_alloc(uint32_t size, void *periph) {
         dma_alloc_fail(size);
     }
 
-    block->used = true;     // Mark block as used.
+    block->refs = 1;        // Mark block as used.
+    block->owner = DMA_OWNER_CPU;
     block->periph = periph;
     if (block->next == NULL) {
         // Adjust/set the block size only if it's newly allocated or if it's the first and only
@@ -195,6 +207,12 @@ void *dma_alloc(uint32_t size, void *periph) {
     return BLOCK_TO_PTR(block);
 }
 
+void dma_alloc_ref(void *ptr) {
+    if (ptr != NULL) {
+        PTR_TO_BLOCK(ptr)->refs++;
+    }
+}
+
 void dma_alloc_free(void *ptr) {
     if (ptr != NULL) {
         block_t *block = PTR_TO_BLOCK(ptr);
@@ -202,8 +220,42 @@ void dma_alloc_free(void *ptr) {
         printf("free DMA buffer at 0x%p size: %lu next in chain: 0x%p for periph 0x%p in domain %d\n",
                block, block->size, block->next, block->periph, periph_to_domain(block->periph));
         #endif
+        if (block->refs && --block->refs) {
+            // Still referenced.
+            return;
+        }
         // Just mark the block as unused.
-        block->used = false;
         block->periph = NULL;
     }
 }
+
+uint32_t dma_alloc_size(void *ptr) {
+    return (ptr != NULL) ? PTR_TO_BLOCK(ptr)->size : 0;
+}
+
+void dma_alloc_to_device(void *ptr) {
+    if (ptr != NULL) {
+        block_t *block = PTR_TO_BLOCK(ptr);
+        if (block->owner == DMA_OWNER_CPU) {
+            #ifdef __DCACHE_PRESENT
+            // Write back the CPU writes, this also makes sure that no dirty lines are evicted
+            // from the cache on top of the DMA writes later.
+            SCB_CleanDCache_by_Addr(ptr, block->size);
+            #endif
+            block->owner = DMA_OWNER_DMA;
+        }
+    }
+}
+
+void dma_alloc_to_cpu(void *ptr) {
+    if (ptr != NULL) {
+        block_t *block = PTR_TO_BLOCK(ptr);
+        if (block->owner == DMA_OWNER_DMA) {
+            #ifdef __DCACHE_PRESENT
+            // Discard any stale lines so the CPU reads the DMA writes.
+            SCB_InvalidateDCache_by_Addr(ptr, block->size);
+            #endif
+            block->owner = DMA_OWNER_CPU;
+        }
+    }
+}
@@ -13,5 +13,12 @@
 #include <stdint.h>
 void dma_alloc_init0();
 void *dma_alloc(uint32_t size, void *periph);
+// Take another reference to a buffer, the buffer is free'd when all references are dropped.
+void dma_alloc_ref(void *ptr);
 void dma_alloc_free(void *ptr);
+uint32_t dma_alloc_size(void *ptr);
+// Hand the buffer over to the DMA (clean) and back to the CPU (invalidate). Calls that don't
+// change the owner are no-ops, as are both calls on cores without a data cache.
+void dma_alloc_to_device(void *ptr);
+void dma_alloc_to_cpu(void *ptr);
 #endif // __DMA_ALLOC_H__
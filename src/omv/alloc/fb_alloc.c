@@ -6,8 +6,10 @@
  * Interface for using extra frame buffer RAM as a stack.
  *
  */
+#include <string.h>
 #include "py/obj.h"
 #include "py/runtime.h"
+#include "py/mphal.h"
 #include "fb_alloc.h"
 #include "framebuffer.h"
 #include "omv_boardconfig.h"
@@ -17,8 +19,23 @@ extern char _fb_alloc_end;
 static char *pointer = &_fb_alloc_end;
 
 #if defined(FB_ALLOC_STATS)
-static uint32_t alloc_bytes;
-static uint32_t alloc_bytes_peak;
+// Open regions are tracked with a small stack of (header address, lowest stack pointer) pairs.
+// A region closes once the stack pointer is popped past its header.
+typedef struct fb_alloc_region {
+    char *header;
+    char *low;
+    uint32_t caller;
+    uint32_t ticks;
+} fb_alloc_region_t;
+
+static fb_alloc_stats_t stats = { .min_avail = UINT32_MAX };
+static fb_alloc_region_t marks[FB_ALLOC_STATS_DEPTH];
+static fb_alloc_region_t alls[FB_ALLOC_STATS_DEPTH];
+static uint32_t marks_depth;
+static uint32_t alls_depth;
+#define FB_ALLOC_CALLER()    ((uint32_t) __builtin_return_address(0))
+#else
+#define FB_ALLOC_CALLER()    (0)
 #endif
 
 #if defined(OMV_FB_OVERLAY_MEMORY)
@@ -27,10 +44,84 @@ extern char _fballoc_overlay_end, _fballoc_overlay_start;
 static char *pointer_overlay = &_fballoc_overlay_end;
 #endif
 
+#if defined(OMV_FB_TCM_MEMORY)
+// Allocation sizes are far below 2GB so the top bit is free to use as a flag.
+#define FB_TCM_MEMORY_FLAG        0x80000000
+extern char _fballoc_tcm_end, _fballoc_tcm_start;
+static char *pointer_tcm = &_fballoc_tcm_end;
+#endif
+
 // fb_alloc_free_till_mark() will not free past this.
 // Use fb_alloc_free_till_mark_permanent() instead.
 #define FB_PERMANENT_FLAG         0x2
 
+#if defined(FB_ALLOC_STATS)
+static fb_alloc_site_t *fb_alloc_stats_site(fb_alloc_site_t *sites, uint32_t caller) {
+    for (int i = 0; i < FB_ALLOC_STATS_SITES; i++) {
+        if (sites[i].caller == caller) {
+            return &sites[i];
+        }
+
+        if (!sites[i].caller) {
+            sites[i].caller = caller;
+            return &sites[i];
+        }
+    }
+
+    stats.dropped += 1;
+    return NULL;
+}
+
+// Called after the stack grows to update the peaks of the whole stack and of the open regions.
+static void fb_alloc_stats_push(uint32_t caller, uint32_t requested, uint32_t size) {
+    uint32_t used = &_fb_alloc_end - pointer;
+    uint32_t avail = pointer - framebuffer_get_buffers_end();
+
+    stats.alloc_count += 1;
+    stats.requested_bytes += requested;
+    stats.overhead_bytes += size - requested;
+    stats.peak_bytes = OMV_MAX(stats.peak_bytes, used);
+    stats.min_avail = OMV_MIN(stats.min_avail, avail);
+
+    if (marks_depth) {
+        marks[marks_depth - 1].low = OMV_MIN(marks[marks_depth - 1].low, pointer);
+    }
+
+    fb_alloc_site_t *site = fb_alloc_stats_site(stats.allocs, caller);
+    if (site) {
+        site->count += 1;
+        site->peak_bytes = OMV_MAX(site->peak_bytes, requested);
+        site->total_bytes += requested;
+    }
+}
+
+// Called after the stack shrinks to close all regions that were popped.
+static void fb_alloc_stats_pop() {
+    while (alls_depth && (pointer > alls[alls_depth - 1].header)) {
+        uint32_t ticks = mp_hal_ticks_us() - alls[--alls_depth].ticks;
+        stats.alloc_all_us += ticks;
+        stats.alloc_all_max_us = OMV_MAX(stats.alloc_all_max_us, ticks);
+    }
+
+    while (marks_depth && (pointer > marks[marks_depth - 1].header)) {
+        fb_alloc_region_t *region = &marks[--marks_depth];
+        uint32_t used = region->header - region->low;
+
+        // The allocations of a child region also count towards its parent.
+        if (marks_depth) {
+            marks[marks_depth - 1].low = OMV_MIN(marks[marks_depth - 1].low, region->low);
+        }
+
+        fb_alloc_site_t *site = fb_alloc_stats_site(stats.marks, region->caller);
+        if (site) {
+            site->count += 1;
+            site->peak_bytes = OMV_MAX(site->peak_bytes, used);
+            site->total_bytes += used;
+        }
+    }
+}
+#endif
+
 char *fb_alloc_stack_pointer() {
     return pointer;
 }
@@ -44,8 +135,27 @@ void fb_alloc_init0() {
     #if defined(OMV_FB_OVERLAY_MEMORY)
     pointer_overlay = &_fballoc_overlay_end;
     #endif
+    #if defined(OMV_FB_TCM_MEMORY)
+    pointer_tcm = &_fballoc_tcm_end;
+    #endif
+    #if defined(FB_ALLOC_STATS)
+    // The statistics survive soft-resets so they can be read after a script stops.
+    marks_depth = 0;
+    alls_depth = 0;
+    #endif
+}
+
+#if defined(FB_ALLOC_STATS)
+void fb_alloc_stats_reset() {
+    memset(&stats, 0, sizeof(stats));
+    stats.min_avail = UINT32_MAX;
 }
 
+const fb_alloc_stats_t *fb_alloc_get_stats() {
+    return &stats;
+}
+#endif
+
 uint32_t fb_avail() {
     uint32_t temp = pointer - framebuffer_get_buffers_end() - sizeof(uint32_t);
     return (temp < sizeof(uint32_t)) ? 0 : temp;
@@ -66,8 +176,13 @@ void fb_alloc_mark() {
     *((uint32_t *) new_pointer) = sizeof(uint32_t); // Save size.
     pointer = new_pointer;
     #if defined(FB_ALLOC_STATS)
-    alloc_bytes = 0;
-    alloc_bytes_peak = 0;
+    if (marks_depth < FB_ALLOC_STATS_DEPTH) {
+        marks[marks_depth++] = (fb_alloc_region_t) {
+            .header = new_pointer, .low = new_pointer, .caller = FB_ALLOC_CALLER()
+        };
+    } else {
+        stats.dropped += 1;
+    }
     #endif
 }
 
@@ -82,7 +197,7 @@ static void int_fb_alloc_free_till_mark(bool free_permanent) {
     while (pointer < &_fb_alloc_end) {
         uint32_t size = *((uint32_t *) pointer);
         if ((!free_permanent) && (size & FB_PERMANENT_FLAG)) {
-            return;
+            break;
         }
         size &= ~FB_PERMANENT_FLAG;
         #if defined(OMV_FB_OVERLAY_MEMORY)
@@ -92,13 +207,20 @@ static void int_fb_alloc_free_till_mark(bool free_permanent) {
             pointer_overlay += size - sizeof(uint32_t);
         }
         #endif
+        #if defined(OMV_FB_TCM_MEMORY)
+        if (size & FB_TCM_MEMORY_FLAG) {
+            // Check for TCM flag.
+            size &= ~FB_TCM_MEMORY_FLAG; // Remove it.
+            pointer_tcm += size - sizeof(uint32_t);
+        }
+        #endif
         pointer += size; // Get size and pop.
         if (size == sizeof(uint32_t)) {
             break;                           // Break on first marker.
         }
     }
     #if defined(FB_ALLOC_STATS)
-    printf("fb_alloc peak memory: %lu\n", alloc_bytes_peak);
+    fb_alloc_stats_pop();
     #endif
 }
 
@@ -116,12 +238,15 @@ void fb_alloc_free_till_mark_past_mark_permanent() {
     int_fb_alloc_free_till_mark(true);
 }
 
-// returns null pointer without error if size==0
-void *fb_alloc(uint32_t size, int hints) {
+static void *int_fb_alloc(uint32_t size, int hints, uint32_t caller) {
     if (!size) {
         return NULL;
     }
 
+    #if defined(FB_ALLOC_STATS)
+    uint32_t requested = size;
+    #endif
+
     size = ((size + sizeof(uint32_t) - 1) / sizeof(uint32_t)) * sizeof(uint32_t); // Round Up
 
     if (hints & FB_ALLOC_CACHE_ALIGN) {
@@ -134,6 +259,11 @@ void *fb_alloc(uint32_t size, int hints) {
 
     // Check if allocation overwrites the framebuffer pixels
     if (new_pointer < framebuffer_get_buffers_end()) {
+        #if defined(FB_ALLOC_STATS)
+        stats.fail_caller = caller;
+        stats.fail_bytes = requested;
+        stats.fail_avail = pointer - framebuffer_get_buffers_end();
+        #endif
         fb_alloc_fail();
     }
 
@@ -142,17 +272,24 @@ void *fb_alloc(uint32_t size, int hints) {
     pointer = new_pointer;
 
     #if defined(FB_ALLOC_STATS)
-    alloc_bytes += size;
-    if (alloc_bytes > alloc_bytes_peak) {
-        alloc_bytes_peak = alloc_bytes;
+    fb_alloc_stats_push(caller, requested, size + sizeof(uint32_t));
+    #endif
+
+    #if defined(OMV_FB_TCM_MEMORY)
+    if ((hints & FB_ALLOC_PREFER_TCM)
+        && (((uint32_t) (pointer_tcm - &_fballoc_tcm_start)) >= size)) {
+        // Return TCM memory instead.
+        pointer_tcm -= size;
+        result = pointer_tcm;
+        *((uint32_t *) new_pointer) |= FB_TCM_MEMORY_FLAG; // Add flag.
+        hints |= FB_ALLOC_PREFER_SIZE; // Don't use the overlay memory too.
     }
-    printf("fb_alloc %lu bytes\n", size);
     #endif
 
     #if defined(OMV_FB_OVERLAY_MEMORY)
     if ((!(hints & FB_ALLOC_PREFER_SIZE))
         && (((uint32_t) (pointer_overlay - &_fballoc_overlay_start)) >= size)) {
-        // Return overlay memory instead.
+        // Return overlay memory instead (TCM allocations spill here when the TCM is full).
         pointer_overlay -= size;
         result = pointer_overlay;
         *new_pointer |= FB_OVERLAY_MEMORY_FLAG; // Add flag.
@@ -169,14 +306,19 @@ void *fb_alloc(uint32_t size, int hints) {
     return result;
 }
 
+// returns null pointer without error if size==0
+void *fb_alloc(uint32_t size, int hints) {
+    return int_fb_alloc(size, hints, FB_ALLOC_CALLER());
+}
+
 // returns null pointer without error if passed size==0
 void *fb_alloc0(uint32_t size, int hints) {
-    void *mem = fb_alloc(size, hints);
+    void *mem = int_fb_alloc(size, hints, FB_ALLOC_CALLER());
     memset(mem, 0, size); // does nothing if size is zero.
     return mem;
 }
 
-void *fb_alloc_all(uint32_t *size, int hints) {
+static void *int_fb_alloc_all(uint32_t *size, int hints, uint32_t caller) {
     uint32_t temp = pointer - framebuffer_get_buffers_end() - sizeof(uint32_t);
 
     if (temp < sizeof(uint32_t)) {
@@ -201,11 +343,13 @@ void *fb_alloc_all(uint32_t *size, int hints) {
     pointer = new_pointer;
 
     #if defined(FB_ALLOC_STATS)
-    alloc_bytes += *size;
-    if (alloc_bytes > alloc_bytes_peak) {
-        alloc_bytes_peak = alloc_bytes;
+    fb_alloc_stats_push(caller, *size, *size + sizeof(uint32_t));
+    stats.alloc_all_count += 1;
+    if (alls_depth < FB_ALLOC_STATS_DEPTH) {
+        alls[alls_depth++] = (fb_alloc_region_t) {
+            .header = new_pointer, .low = new_pointer, .caller = caller, .ticks = mp_hal_ticks_us()
+        };
     }
-    printf("fb_alloc_all %lu bytes\n", *size);
     #endif
 
     #if defined(OMV_FB_OVERLAY_MEMORY)
@@ -231,9 +375,13 @@ void *fb_alloc_all(uint32_t *size, int hints) {
     return result;
 }
 
+void *fb_alloc_all(uint32_t *size, int hints) {
+    return int_fb_alloc_all(size, hints, FB_ALLOC_CALLER());
+}
+
 // returns null pointer without error if returned size==0
 void *fb_alloc0_all(uint32_t *size, int hints) {
-    void *mem = fb_alloc_all(size, hints);
+    void *mem = int_fb_alloc_all(size, hints, FB_ALLOC_CALLER());
     memset(mem, 0, *size); // does nothing if size is zero.
     return mem;
 }
@@ -249,11 +397,18 @@ void fb_free() {
             pointer_overlay += size - sizeof(uint32_t);
         }
         #endif
-        #if defined(FB_ALLOC_STATS)
-        alloc_bytes -= size;
+        #if defined(OMV_FB_TCM_MEMORY)
+        if (size & FB_TCM_MEMORY_FLAG) {
+            // Check for TCM flag.
+            size &= ~FB_TCM_MEMORY_FLAG; // Remove it.
+            pointer_tcm += size - sizeof(uint32_t);
+        }
         #endif
         pointer += size; // Get size and pop.
     }
+    #if defined(FB_ALLOC_STATS)
+    fb_alloc_stats_pop();
+    #endif
 }
 
 void fb_free_all() {
@@ -267,9 +422,16 @@ void fb_free_all() {
             pointer_overlay += size - sizeof(uint32_t);
         }
         #endif
-        #if defined(FB_ALLOC_STATS)
-        alloc_bytes -= size;
+        #if defined(OMV_FB_TCM_MEMORY)
+        if (size & FB_TCM_MEMORY_FLAG) {
+            // Check for TCM flag.
+            size &= ~FB_TCM_MEMORY_FLAG; // Remove it.
+            pointer_tcm += size - sizeof(uint32_t);
+        }
         #endif
         pointer += size; // Get size and pop.
     }
+    #if defined(FB_ALLOC_STATS)
+    fb_alloc_stats_pop();
+    #endif
 }
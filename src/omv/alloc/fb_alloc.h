@@ -48,6 +48,26 @@
  *                          flag is set then fb_alloc_all() will use the SDRAM (default).
  * - FB_ALLOC_CACHE_ALIGN - Aligns the starting address returned to a cache line and makes sure
  *                          the amount of memory allocated is padded to the end of a cache line.
+ * - FB_ALLOC_PREFER_TCM - fb_alloc will place the allocated region in tightly coupled memory (DTCM)
+ *                         on boards that define OMV_FB_TCM_MEMORY. This is meant for small hot
+ *                         scratch buffers (line buffers, histograms, integral image rows, etc.).
+ *                         TCM is not accessible by DMA so don't use it for DMA buffers. When the
+ *                         TCM is full the allocation spills to the fast memory and then to the
+ *                         frame buffer memory like any other allocation.
+ *
+ * Memory tiers (fastest first), all allocations also reserve space on the main stack:
+ * - OMV_FB_TCM_MEMORY     - Only used with FB_ALLOC_PREFER_TCM.
+ * - OMV_FB_OVERLAY_MEMORY - Used unless FB_ALLOC_PREFER_SIZE is set.
+ * - OMV_FB_MEMORY         - The main stack, used when the faster memories are full.
+ *
+ * Statistics:
+ *
+ * When built with FB_ALLOC_STATS=1 fb_alloc records the peak stack usage, the smallest free space
+ * seen, the bytes lost to headers and alignment padding, the largest request from each call site,
+ * the peak usage of each fb_alloc_mark() region (keyed by the caller of fb_alloc_mark()), the time
+ * fb_alloc_all() regions are held and the call site of the last failed allocation. Callers are
+ * return addresses that are resolved to function names on the host using the firmware ELF file.
+ * The statistics are read with omv.fb_stats() or USBDBG_FB_STATS_SIZE/USBDBG_FB_STATS_DUMP.
  */
 #ifndef __FB_ALLOC_H__
 #define __FB_ALLOC_H__
@@ -56,6 +76,40 @@
 #define FB_ALLOC_PREFER_SPEED    1
 #define FB_ALLOC_PREFER_SIZE     2
 #define FB_ALLOC_CACHE_ALIGN     4
+#define FB_ALLOC_PREFER_TCM      8
+
+#ifndef FB_ALLOC_STATS_SITES
+#define FB_ALLOC_STATS_SITES     (32)
+#endif
+
+#ifndef FB_ALLOC_STATS_DEPTH
+#define FB_ALLOC_STATS_DEPTH     (16)
+#endif
+
+typedef struct fb_alloc_site {
+    uint32_t caller;            // Return address of the call site (0 if the record is unused).
+    uint32_t count;             // Number of allocations or closed regions.
+    uint32_t peak_bytes;        // Largest allocation or region.
+    uint32_t total_bytes;       // Sum of all allocations or regions.
+} fb_alloc_site_t;
+
+typedef struct fb_alloc_stats {
+    uint32_t peak_bytes;        // Peak stack usage including headers.
+    uint32_t min_avail;         // Smallest free space left after an allocation.
+    uint32_t alloc_count;       // Number of allocations.
+    uint32_t requested_bytes;   // Sum of the requested sizes.
+    uint32_t overhead_bytes;    // Sum of the headers and rounding/alignment padding.
+    uint32_t alloc_all_count;   // Number of fb_alloc_all() calls.
+    uint32_t alloc_all_us;      // Total time fb_alloc_all() regions were held.
+    uint32_t alloc_all_max_us;  // Longest time an fb_alloc_all() region was held.
+    uint32_t fail_caller;       // Call site of the last failed allocation.
+    uint32_t fail_bytes;        // Size of the last failed allocation.
+    uint32_t fail_avail;        // Free space left when the last allocation failed.
+    uint32_t dropped;           // Sites or regions that didn't fit in the tables.
+    fb_alloc_site_t allocs[FB_ALLOC_STATS_SITES];
+    fb_alloc_site_t marks[FB_ALLOC_STATS_SITES];
+} fb_alloc_stats_t;
+
 char *fb_alloc_stack_pointer();
 void fb_alloc_fail();
 void fb_alloc_init0();
@@ -70,4 +124,6 @@ void *fb_alloc_all(uint32_t *size, int hints); // returns pointer and sets size
 void *fb_alloc0_all(uint32_t *size, int hints); // returns pointer and sets size
 void fb_free();
 void fb_free_all();
+void fb_alloc_stats_reset();
+const fb_alloc_stats_t *fb_alloc_get_stats();
 #endif /* __FF_ALLOC_H__ */
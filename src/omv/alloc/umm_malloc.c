@@ -62,6 +62,20 @@ UMM_H_ATTPACKPRE typedef struct umm_block_t {
 umm_block *umm_heap = NULL;
 unsigned short int umm_numblocks = 0;
 
+/*
+ * Quick lists: apriltag, zbar, etc. allocate and free thousands of small objects per call. Freed
+ * blocks of up to UMM_QUICK_CLASSES blocks are pushed on a LIFO list per size instead of being
+ * returned to the free list, so they can be reused in O(1) without walking the free list. Blocks
+ * on a quick list stay marked as used so their neighbours don't coalesce with them. The lists are
+ * emptied when umm_init_x() resets the heap, or flushed back to the free list when an allocation
+ * would fail otherwise. Entry 0 of each list terminates it (block 0 is the free list head).
+ */
+#ifndef UMM_QUICK_CLASSES
+#define UMM_QUICK_CLASSES    (4)
+#endif
+static unsigned short int umm_quick[UMM_QUICK_CLASSES];
+#define UMM_QNEXT(b)         (*((unsigned short int *) UMM_DATA(b)))
+
 #define UMM_NUMBLOCKS        (umm_numblocks)
 #define UMM_BLOCK(b)         (umm_heap[b])
 #define UMM_NBLOCK(b)        (UMM_BLOCK(b).header.used.next)
@@ -70,6 +84,56 @@ unsigned short int umm_numblocks = 0;
 #define UMM_PFREE(b)         (UMM_BLOCK(b).body.free.prev)
 #define UMM_DATA(b)          (UMM_BLOCK(b).body.data)
 
+#if defined(UMM_STATS)
+static umm_stats_t umm_stats;
+static uint32_t umm_used_blocks;
+#define UMM_STATS_INC(x)     (umm_stats.x += 1)
+#define UMM_STATS_USED(n)    umm_stats_used(n)
+
+static void umm_stats_used(int blocks) {
+    umm_used_blocks += blocks;
+    if ((umm_used_blocks * sizeof(umm_block)) > umm_stats.peak_bytes) {
+        umm_stats.peak_bytes = umm_used_blocks * sizeof(umm_block);
+    }
+}
+
+// Summarizes the free space of the heap, which must still be valid.
+static void umm_stats_summarize(void) {
+    umm_stats.free_bytes = 0;
+    umm_stats.quick_bytes = 0;
+    umm_stats.largest_bytes = 0;
+    memset(umm_stats.histogram, 0, sizeof(umm_stats.histogram));
+
+    for (unsigned short int c = UMM_NFREE(0); c; c = UMM_NFREE(c)) {
+        uint32_t blocks = (UMM_NBLOCK(c) & UMM_BLOCKNO_MASK) - c;
+        int bin = 31 - __builtin_clz(blocks);
+        umm_stats.free_bytes += blocks * sizeof(umm_block);
+        if ((blocks * sizeof(umm_block)) > umm_stats.largest_bytes) {
+            umm_stats.largest_bytes = blocks * sizeof(umm_block);
+        }
+        umm_stats.histogram[(bin < UMM_STATS_BINS) ? bin : (UMM_STATS_BINS - 1)] += 1;
+    }
+
+    for (int i = 0; i < UMM_QUICK_CLASSES; i++) {
+        for (unsigned short int c = umm_quick[i]; c; c = UMM_QNEXT(c)) {
+            umm_stats.quick_bytes += (i + 1) * sizeof(umm_block);
+        }
+    }
+}
+
+void umm_stats_reset() {
+    memset(&umm_stats, 0, sizeof(umm_stats));
+    umm_used_blocks = 0;
+}
+
+const umm_stats_t *umm_get_stats() {
+    return &umm_stats;
+}
+#else
+#define UMM_STATS_INC(x)
+#define UMM_STATS_USED(n)
+#endif
+
 NORETURN void umm_alloc_fail() {
     mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("Out of fast frame buffer stack memory"));
 }
@@ -186,6 +250,12 @@ void umm_init_x(size_t size) {
     umm_heap = (umm_block *) UMM_MALLOC_CFG_HEAP_ADDR;
     umm_numblocks = (UMM_MALLOC_CFG_HEAP_SIZE / sizeof(umm_block));
     memset(umm_heap, 0x00, UMM_MALLOC_CFG_HEAP_SIZE);
+    memset(umm_quick, 0x00, sizeof(umm_quick));
+
+    #if defined(UMM_STATS)
+    umm_stats.heap_bytes = UMM_MALLOC_CFG_HEAP_SIZE;
+    umm_used_blocks = 0;
+    #endif
 
     /* setup initial blank heap structure */
     {
@@ -241,11 +311,69 @@ void umm_init(void) {
     umm_init_x(0);
 }
 
+void umm_deinit(void) {
+    #if defined(UMM_STATS)
+    if (umm_heap) {
+        umm_stats_summarize();
+    }
+    #endif
+    umm_heap = NULL;
+}
+
 /* ------------------------------------------------------------------------ */
 
+static void umm_free_block(unsigned short int c) {
+
+    DBGLOG_DEBUG("Freeing block %6i\n", c);
+
+    /* Now let's assimilate this block with the next one if possible. */
+
+    umm_assimilate_up(c);
+
+    /* Then assimilate with the previous block if possible */
+
+    if (UMM_NBLOCK(UMM_PBLOCK(c)) & UMM_FREELIST_MASK) {
+
+        DBGLOG_DEBUG("Assimilate down to next block, which is FREE\n");
+
+        c = umm_assimilate_down(c, UMM_FREELIST_MASK);
+    } else {
+        /*
+         * The previous block is not a free block, so add this one to the head
+         * of the free list
+         */
+
+        DBGLOG_DEBUG("Just add to head of free list\n");
+
+        UMM_PFREE(UMM_NFREE(0)) = c;
+        UMM_NFREE(c) = UMM_NFREE(0);
+        UMM_PFREE(c) = 0;
+        UMM_NFREE(0) = c;
+
+        UMM_NBLOCK(c) |= UMM_FREELIST_MASK;
+    }
+}
+
+/* Return all blocks on the quick lists to the free list. */
+static bool umm_quick_flush(void) {
+    bool flushed = false;
+
+    for (int i = 0; i < UMM_QUICK_CLASSES; i++) {
+        while (umm_quick[i]) {
+            unsigned short int c = umm_quick[i];
+            umm_quick[i] = UMM_QNEXT(c);
+            umm_free_block(c);
+            flushed = true;
+        }
+    }
+
+    return flushed;
+}
+
 void umm_free(void *ptr) {
 
     unsigned short int c;
+    unsigned short int blocks;
 
     /* If we're being asked to free a NULL pointer, well that's just silly! */
 
@@ -271,33 +399,18 @@ void umm_free(void *ptr) {
 
     c = (((char *) ptr) - (char *) (&(umm_heap[0]))) / sizeof(umm_block);
 
-    DBGLOG_DEBUG("Freeing block %6i\n", c);
+    /* Small blocks go on their quick list, everything else back to the free list. */
 
-    /* Now let's assimilate this block with the next one if possible. */
+    blocks = UMM_NBLOCK(c) - c;
 
-    umm_assimilate_up(c);
+    UMM_STATS_INC(free_count);
+    UMM_STATS_USED(-blocks);
 
-    /* Then assimilate with the previous block if possible */
-
-    if (UMM_NBLOCK(UMM_PBLOCK(c)) & UMM_FREELIST_MASK) {
-
-        DBGLOG_DEBUG("Assimilate down to next block, which is FREE\n");
-
-        c = umm_assimilate_down(c, UMM_FREELIST_MASK);
+    if (blocks <= UMM_QUICK_CLASSES) {
+        UMM_QNEXT(c) = umm_quick[blocks - 1];
+        umm_quick[blocks - 1] = c;
     } else {
-        /*
-         * The previous block is not a free block, so add this one to the head
-         * of the free list
-         */
-
-        DBGLOG_DEBUG("Just add to head of free list\n");
-
-        UMM_PFREE(UMM_NFREE(0)) = c;
-        UMM_NFREE(c) = UMM_NFREE(0);
-        UMM_PFREE(c) = 0;
-        UMM_NFREE(0) = c;
-
-        UMM_NBLOCK(c) |= UMM_FREELIST_MASK;
+        umm_free_block(c);
     }
 
     /* Release the critical section... */
@@ -337,6 +450,25 @@ void *umm_malloc(size_t size) {
 
     blocks = umm_blocks(size);
 
+    UMM_STATS_INC(malloc_count);
+
+    /* Reuse a block from the quick list of this size if there's one. */
+
+    if ((blocks <= UMM_QUICK_CLASSES) && umm_quick[blocks - 1]) {
+        cf = umm_quick[blocks - 1];
+        umm_quick[blocks - 1] = UMM_QNEXT(cf);
+
+        UMM_STATS_INC(quick_count);
+        UMM_STATS_USED(blocks);
+
+        /* Release the critical section... */
+        UMM_CRITICAL_EXIT();
+
+        return( (void *) &UMM_DATA(cf) );
+    }
+
+retry:
+
     /*
      * Now we can scan through the free list until we find a space that's big
      * enough to hold the number of blocks we need.
@@ -359,6 +491,10 @@ void *umm_malloc(size_t size) {
         if ( (blockSize >= blocks) && (blockSize < bestSize) ) {
             bestBlock = cf;
             bestSize = blockSize;
+            /* Nothing fits better than an exact fit. */
+            if (blockSize == blocks) {
+                break;
+            }
         }
         #elif defined UMM_FIRST_FIT
         /* This is the first block that fits! */
@@ -419,16 +555,27 @@ void *umm_malloc(size_t size) {
             UMM_NFREE(cf + blocks) = UMM_NFREE(cf);
         }
     } else {
-        /* Out of memory */
+        /* Out of memory, unless the quick lists are holding on to free blocks */
+
+        if (umm_quick_flush()) {
+            goto retry;
+        }
 
         DBGLOG_DEBUG("Can't allocate %5i blocks\n", blocks);
 
+        #if defined(UMM_STATS)
+        umm_stats.fail_count += 1;
+        umm_stats_summarize();
+        #endif
+
         /* Release the critical section... */
         UMM_CRITICAL_EXIT();
 
         return( (void *) NULL);
     }
 
+    UMM_STATS_USED(blocks);
+
     /* Release the critical section... */
     UMM_CRITICAL_EXIT();
 
@@ -499,6 +646,10 @@ void *umm_realloc(void *ptr, size_t size) {
 
     blockSize = (UMM_NBLOCK(c) - c);
 
+    #if defined(UMM_STATS)
+    unsigned short int oldBlockSize = blockSize;
+    #endif
+
     /* Figure out how many bytes are in this block */
 
     curSize = (blockSize * sizeof(umm_block)) - (sizeof(((umm_block *) 0)->header));
@@ -588,6 +739,9 @@ void *umm_realloc(void *ptr, size_t size) {
             /* This space intentionally left blnk */
         }
         blockSize = blocks;
+        #if defined(UMM_STATS)
+        oldBlockSize = blocks; // Counted by umm_malloc() and umm_free().
+        #endif
     }
 
     /* Now all we need to do is figure out if the block fit exactly or if we
@@ -597,9 +751,11 @@ void *umm_realloc(void *ptr, size_t size) {
     if (blockSize > blocks) {
         DBGLOG_DEBUG("split and free %i blocks from %i\n", blocks, blockSize);
         umm_split_block(c, blocks, 0);
-        umm_free( (void *) &UMM_DATA(c + blocks) );
+        umm_free_block(c + blocks);
     }
 
+    UMM_STATS_USED(blocks - oldBlockSize);
+
     /* Release the critical section... */
     UMM_CRITICAL_EXIT();
 
@@ -12,10 +12,39 @@
 #ifndef __UMM_MALLOC_H__
 #define __UMM_MALLOC_H__
 #include <stdlib.h>
+#include <stdint.h>
+
+/*
+ * When built with UMM_STATS=1 the allocator counts the allocations, frees, quick list hits and
+ * failures and tracks the peak allocated size across all heaps. The free space is summarized
+ * (free bytes, largest free chunk and a histogram of the free chunk sizes) when a heap is
+ * released with umm_deinit() or when an allocation fails. Read with omv.umm_stats().
+ */
+#ifndef UMM_STATS_BINS
+#define UMM_STATS_BINS      (8)
+#endif
+
+typedef struct umm_stats {
+    uint32_t heap_bytes;        // Size of the last heap.
+    uint32_t peak_bytes;        // Peak allocated size, including the block headers.
+    uint32_t malloc_count;      // Number of allocations.
+    uint32_t quick_count;       // Allocations reused from the quick lists.
+    uint32_t free_count;        // Number of frees.
+    uint32_t fail_count;        // Number of failed allocations.
+    uint32_t free_bytes;        // Free list space when summarized.
+    uint32_t quick_bytes;       // Space held by the quick lists when summarized.
+    uint32_t largest_bytes;     // Largest free chunk when summarized.
+    // Free chunks by size, bin i counts chunks of [2^i, 2^(i+1)) blocks, the last bin all larger.
+    uint32_t histogram[UMM_STATS_BINS];
+} umm_stats_t;
+
 void umm_alloc_fail();
 void  umm_init_x(size_t size);   // Min of 2.5KB - Max of 640 KB.
+void  umm_deinit();              // Call before the heap memory is freed.
 void *umm_malloc(size_t size);
 void *umm_calloc(size_t num, size_t size);
 void *umm_realloc(void *ptr, size_t size);
 void  umm_free(void *ptr);
+void umm_stats_reset();
+const umm_stats_t *umm_get_stats();
 #endif /* __UMM_MALLOC_H__ */
@@ -127,6 +127,7 @@
 #define OMV_DMA_MEMORY                      SRAM3   // Misc DMA buffers memory.
 #define OMV_DMA_MEMORY_D1                   AXI_SRAM // Domain 1 DMA buffers.
 #define OMV_DMA_MEMORY_D2                   SRAM3   // Domain 2 DMA buffers.
+#define OMV_DMA_ALLOC_D2_SIZE               (5 * 1024) // D2 DMA pool size (audio).
 #define OMV_OPENAMP_MEMORY                  SRAM4
 #define OMV_OPENAMP_SIZE                    (64K)
 #define OMV_CORE1_MEMORY                    DRAM
@@ -114,6 +114,7 @@
 #define OMV_DMA_MEMORY                        SRAM2     // DMA buffers memory.
 #define OMV_DMA_MEMORY_D1                     AXI_SRAM  // Domain 1 DMA buffers.
 #define OMV_DMA_MEMORY_D2                     SRAM2     // Domain 2 DMA buffers.
+#define OMV_DMA_ALLOC_D2_SIZE                 (5 * 1024) // D2 DMA pool size (audio).
 #define OMV_CM4_BOOT_MEMORY                   SRAM4     // Use to boot CM4 for low-power mode.
 #define OMV_CM4_BOOT_SIZE                     1K
 #define OMV_GC_BLOCK0_MEMORY                  DTCM      // Main GC block 0.
@@ -20,6 +20,9 @@
 // Enable LAB LUT
 //#define IMLIB_ENABLE_LAB_LUT
 
+// Enable fixed-point LAB conversion (used when the LAB LUT is disabled)
+#define IMLIB_ENABLE_LAB_FIXED
+
 // Enable YUV LUT
 //#define IMLIB_ENABLE_YUV_LUT
 
@@ -76,6 +79,12 @@
 #define IMLIB_ENABLE_FIND_DISPLACEMENT
 #endif
 
+// Use CMSIS-DSP for the FFTs used by phasecorrelate()
+#define IMLIB_ENABLE_CMSIS_FFT
+
+// Use q15 instead of float32 for the 8-bit input FFTs (faster, less accurate)
+//#define IMLIB_ENABLE_CMSIS_FFT_Q15
+
 // Enable get_similarity()
 #define IMLIB_ENABLE_GET_SIMILARITY
 
@@ -150,4 +159,7 @@
 // Stereo Imaging
 // #define IMLIB_ENABLE_STEREO_DISPARITY
 
+// Enable the tracker module
+#define IMLIB_ENABLE_TRACKER
+
 #endif //__IMLIB_CONFIG_H__
@@ -130,6 +130,7 @@
 #define OMV_DMA_MEMORY_D1                   AXI_SRAM // Domain 1 DMA buffers.
 #define OMV_DMA_MEMORY_D2                   SRAM3   // Domain 2 DMA buffers.
 #define OMV_DMA_MEMORY_D3                   SRAM4   // Domain 3 DMA buffers.
+#define OMV_DMA_ALLOC_D3_SIZE               (17 * 1024) // D3 DMA pool size (audio).
 #define OMV_OPENAMP_MEMORY                  SRAM1
 #define OMV_OPENAMP_SIZE                    (64K)
 #define OMV_CORE1_MEMORY                    DRAM
@@ -235,6 +236,8 @@
 // the Portenta breakout board and to the INT pin (OUTPUT) on the Himax
 // shield, so it can't be enabled for the two boards at the same time.
 //#define OMV_CSI_FSYNC_PIN                    (&omv_pin_C15_GPIO)
+// The INT pin is only an input here, so it's used to wake up on motion.
+#define OMV_CSI_MD_INT_PIN                  (&omv_pin_C15_GPIO)
 
 // GPIO.3 is connected to the powerdown pin on the Portenta breakout board,
 // and to the STROBE pin on the Himax shield, however it's not actually
@@ -20,6 +20,9 @@
 // Enable LAB LUT
 #define IMLIB_ENABLE_LAB_LUT
 
+// Enable fixed-point LAB conversion (used when the LAB LUT is disabled)
+//#define IMLIB_ENABLE_LAB_FIXED
+
 // Enable YUV LUT
 //#define IMLIB_ENABLE_YUV_LUT
 
@@ -135,4 +138,7 @@
 // Stereo Imaging
 // #define IMLIB_ENABLE_STEREO_DISPARITY
 
+// Enable the tracker module
+//#define IMLIB_ENABLE_TRACKER
+
 #endif //__IMLIB_CONFIG_H__
@@ -20,6 +20,12 @@
 // Enable LAB LUT
 #define IMLIB_ENABLE_LAB_LUT
 
+// Enable fixed-point LAB conversion (used when the LAB LUT is disabled)
+//#define IMLIB_ENABLE_LAB_FIXED
+
+// Enable precompiled RGB565 color threshold tables (8KB of RAM per slot)
+#define IMLIB_ENABLE_THRESHOLD_LUT
+
 // Enable YUV LUT
 //#define IMLIB_ENABLE_YUV_LUT
 
@@ -76,6 +82,12 @@
 #define IMLIB_ENABLE_FIND_DISPLACEMENT
 #endif
 
+// Use CMSIS-DSP for the FFTs used by phasecorrelate()
+#define IMLIB_ENABLE_CMSIS_FFT
+
+// Use q15 instead of float32 for the 8-bit input FFTs (faster, less accurate)
+//#define IMLIB_ENABLE_CMSIS_FFT_Q15
+
 // Enable get_similarity()
 #define IMLIB_ENABLE_GET_SIMILARITY
 
@@ -136,16 +148,19 @@
 #define IMLIB_ENABLE_DESCRIPTOR
 
 // Enable find_hog()
-// #define IMLIB_ENABLE_HOG
+#define IMLIB_ENABLE_HOG
 
 // Enable selective_search()
-// #define IMLIB_ENABLE_SELECTIVE_SEARCH
+#define IMLIB_ENABLE_SELECTIVE_SEARCH
 
 // Enable PNG encoder/decoder
 #define IMLIB_ENABLE_PNG_ENCODER
 #define IMLIB_ENABLE_PNG_DECODER
 
 // Stereo Imaging
-// #define IMLIB_ENABLE_STEREO_DISPARITY
+#define IMLIB_ENABLE_STEREO_DISPARITY
+
+// Enable the tracker module
+#define IMLIB_ENABLE_TRACKER
 
 #endif //__IMLIB_CONFIG_H__
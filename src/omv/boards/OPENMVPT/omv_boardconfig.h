@@ -118,6 +118,8 @@
 #define OMV_FB_ALLOC_SIZE                       (23M)   // minimum fb alloc size
 #define OMV_FB_OVERLAY_MEMORY                   AXI_SRAM // Fast fb_alloc memory.
 #define OMV_FB_OVERLAY_SIZE                     (496K)  // Fast fb_alloc memory size.
+#define OMV_FB_TCM_MEMORY                       DTCM    // Hot fb_alloc scratch memory (not DMA accessible).
+#define OMV_FB_TCM_SIZE                         (128K)  // Hot fb_alloc scratch memory size.
 #define OMV_JPEG_MEMORY                         DRAM    // JPEG buffer memory buffer.
 #define OMV_JPEG_SIZE                           (1M)    // IDE JPEG buffer (header + data).
 #define OMV_VOSPI_MEMORY                        SRAM4   // VoSPI buffer memory.
@@ -24,6 +24,9 @@
 #define OMV_JPEG_QUALITY_HIGH           (90)
 #define OMV_JPEG_QUALITY_THRESHOLD      (320 * 240 * 2)
 
+// GPU Configuration
+#define OMV_GPU_ENABLE                  (1)
+
 // Image sensor drivers configuration.
 #define OMV_OV5640_ENABLE               (1)
 #define OMV_OV5640_AF_ENABLE            (1)
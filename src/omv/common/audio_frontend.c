@@ -0,0 +1,120 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Streaming audio feature extractor.
+ *
+ * The stages use the scaling of the fixed-point micro frontend so the features match: the
+ * filterbank outputs the square root of the mel energies of the 1/N scaled FFT in Q6, the PCAN
+ * lookup uses the noise estimate with 3 extra bits and the log is scaled by 64.
+ */
+#include <string.h>
+#include <math.h>
+#include "audio_frontend.h"
+
+#define FE_LOWER_FREQ       (125.0f)
+#define FE_UPPER_FREQ       (7500.0f)
+#define FE_EVEN_SMOOTHING   (0.025f)
+#define FE_ODD_SMOOTHING    (0.06f)
+#define FE_MIN_SIGNAL       (0.05f)
+#define FE_PCAN_STRENGTH    (0.95f)
+#define FE_PCAN_OFFSET      (80.0f)
+#define FE_PCAN_GAIN        (2097152.0f / 64.0f)  // (1 << gain_bits) >> snr_shift
+#define FE_PCAN_CORRECTION  (8.0f)  // 1 << input_correction_bits
+#define FE_LOG_SCALE        (64.0f) // 1 << scale_shift
+// Features are quantized as (value * 256 / 666) - 128, see the micro_speech example.
+#define FE_FEATURE_SCALE    (256.0f / 666.0f)
+
+static inline float fe_freq_to_mel(float freq) {
+    return 1127.0f * logf(1.0f + (freq / 700.0f));
+}
+
+void audio_frontend_init(audio_frontend_t *fe) {
+    arm_rfft_fast_init_f32(&fe->rfft, AUDIO_FRONTEND_FFT_SIZE);
+
+    // Periodic Hann window, the micro frontend centers it on the samples.
+    float arg = (2.0f * PI) / AUDIO_FRONTEND_WINDOW_SIZE;
+    for (int i = 0; i < AUDIO_FRONTEND_WINDOW_SIZE; i++) {
+        fe->window[i] = 0.5f - (0.5f * cosf(arg * (i + 0.5f)));
+    }
+
+    // Mel channel centers are evenly spaced between the lower and upper frequencies, the last
+    // center is the upper edge of the last channel.
+    float mel_low = fe_freq_to_mel(FE_LOWER_FREQ);
+    float mel_spacing = (fe_freq_to_mel(FE_UPPER_FREQ) - mel_low) / (AUDIO_FRONTEND_CHANNELS + 1);
+    float hz_per_bin = (AUDIO_FRONTEND_SAMPLE_RATE / 2.0f) / (AUDIO_FRONTEND_BINS - 1);
+
+    fe->bin_start = (uint16_t) (FE_LOWER_FREQ / hz_per_bin + 1.5f);
+    fe->bin_end = (uint16_t) (FE_UPPER_FREQ / hz_per_bin + 0.5f);
+
+    for (int i = fe->bin_start, c = 0; i < fe->bin_end; i++) {
+        float mel = fe_freq_to_mel(i * hz_per_bin);
+        while ((c < AUDIO_FRONTEND_CHANNELS) && (mel >= (mel_low + (mel_spacing * (c + 1))))) {
+            c++;
+        }
+        float center = mel_low + (mel_spacing * (c + 1));
+        fe->bin_channel[i] = c;
+        fe->bin_weight[i] = (center - mel) / mel_spacing;
+    }
+
+    audio_frontend_reset(fe);
+}
+
+void audio_frontend_reset(audio_frontend_t *fe) {
+    memset(fe->samples, 0, sizeof(fe->samples));
+    memset(fe->noise, 0, sizeof(fe->noise));
+}
+
+void audio_frontend_process(audio_frontend_t *fe, const int16_t *samples, size_t n, int8_t *features) {
+    // Slide the window by n samples.
+    if (n >= AUDIO_FRONTEND_WINDOW_SIZE) {
+        memcpy(fe->samples, samples + n - AUDIO_FRONTEND_WINDOW_SIZE, sizeof(fe->samples));
+    } else {
+        memmove(fe->samples, fe->samples + n, (AUDIO_FRONTEND_WINDOW_SIZE - n) * sizeof(int16_t));
+        memcpy(fe->samples + AUDIO_FRONTEND_WINDOW_SIZE - n, samples, n * sizeof(int16_t));
+    }
+
+    for (int i = 0; i < AUDIO_FRONTEND_WINDOW_SIZE; i++) {
+        fe->fft_in[i] = fe->samples[i] * fe->window[i];
+    }
+    memset(fe->fft_in + AUDIO_FRONTEND_WINDOW_SIZE, 0,
+           (AUDIO_FRONTEND_FFT_SIZE - AUDIO_FRONTEND_WINDOW_SIZE) * sizeof(float));
+
+    // Output is packed as {DC, Nyquist, re[1], im[1], ...}, the filterbank never uses DC/Nyquist.
+    arm_rfft_fast_f32(&fe->rfft, fe->fft_in, fe->fft_out, 0);
+
+    // Channel c is accumulated in energy[c + 1], the first and last entries are unused edges.
+    float energy[AUDIO_FRONTEND_CHANNELS + 2] = { 0 };
+    for (int i = fe->bin_start; i < fe->bin_end; i++) {
+        float re = fe->fft_out[(i * 2) + 0];
+        float im = fe->fft_out[(i * 2) + 1];
+        float e = (re * re) + (im * im);
+        float w = fe->bin_weight[i];
+        int c = fe->bin_channel[i];
+        energy[c] += w * e;
+        energy[c + 1] += (1.0f - w) * e;
+    }
+
+    for (int c = 0; c < AUDIO_FRONTEND_CHANNELS; c++) {
+        // Q6 magnitude of the 1/N scaled FFT.
+        float signal = sqrtf(energy[c + 1]) * (64.0f / AUDIO_FRONTEND_FFT_SIZE);
+
+        // Noise reduction, subtract a slowly updated estimate of the noise floor.
+        float smoothing = (c & 1) ? FE_ODD_SMOOTHING : FE_EVEN_SMOOTHING;
+        float noise = (signal * smoothing) + (fe->noise[c] * (1.0f - smoothing));
+        fe->noise[c] = noise;
+        signal = fmaxf(signal * FE_MIN_SIGNAL, signal - fminf(noise, signal));
+
+        // Per-channel automatic gain control, snr is in units of 1 / 4096.
+        float gain = FE_PCAN_GAIN * powf((noise * FE_PCAN_CORRECTION) + FE_PCAN_OFFSET, -FE_PCAN_STRENGTH);
+        float snr = (signal * gain) / 4096.0f;
+        signal = (snr < 2.0f) ? (16.0f * snr * snr) : (64.0f * (snr - 1.0f));
+
+        float value = (signal >= 1.0f) ? (FE_LOG_SCALE * logf(signal)) : 0.0f;
+        features[c] = __SSAT((int32_t) lroundf(value * FE_FEATURE_SCALE) - 128, 8);
+    }
+}
@@ -0,0 +1,47 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Streaming audio feature extractor.
+ *
+ * Computes the log-mel features of the TFLM micro frontend, which the micro_speech model is trained
+ * on, without running the audio preprocessor model: a 30ms Hann window every step, a 512 point FFT,
+ * a 40 channel mel filterbank (125Hz-7.5KHz), noise reduction, PCAN gain control and log scaling.
+ * Each call consumes one step of new samples and produces one int8 feature frame, quantized like
+ * the micro_speech model input.
+ */
+#ifndef __AUDIO_FRONTEND_H__
+#define __AUDIO_FRONTEND_H__
+#include <stdint.h>
+#include <arm_math.h>
+
+#define AUDIO_FRONTEND_SAMPLE_RATE  (16000)
+#define AUDIO_FRONTEND_WINDOW_SIZE  (480)   // 30ms
+#define AUDIO_FRONTEND_FFT_SIZE     (512)
+#define AUDIO_FRONTEND_BINS         ((AUDIO_FRONTEND_FFT_SIZE / 2) + 1)
+#define AUDIO_FRONTEND_CHANNELS     (40)
+
+typedef struct audio_frontend {
+    arm_rfft_fast_instance_f32 rfft;
+    int16_t samples[AUDIO_FRONTEND_WINDOW_SIZE];
+    float window[AUDIO_FRONTEND_WINDOW_SIZE];
+    float fft_in[AUDIO_FRONTEND_FFT_SIZE];
+    float fft_out[AUDIO_FRONTEND_FFT_SIZE];
+    // Each FFT bin is split between the falling edge of channel - 1 and the rising edge of channel.
+    uint8_t bin_channel[AUDIO_FRONTEND_BINS];
+    float bin_weight[AUDIO_FRONTEND_BINS];
+    uint16_t bin_start;
+    uint16_t bin_end;
+    float noise[AUDIO_FRONTEND_CHANNELS];
+} audio_frontend_t;
+
+void audio_frontend_init(audio_frontend_t *fe);
+// Clears the sample history and the noise estimates.
+void audio_frontend_reset(audio_frontend_t *fe);
+// Shifts n new samples into the window and writes AUDIO_FRONTEND_CHANNELS features.
+void audio_frontend_process(audio_frontend_t *fe, const int16_t *samples, size_t n, int8_t *features);
+#endif // __AUDIO_FRONTEND_H__
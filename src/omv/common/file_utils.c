@@ -19,44 +19,77 @@
 #include "file_utils.h"
 #define FF_MIN(x, y)    (((x) < (y))?(x):(y))
 
+#define FILE_BUFFER_COUNT       (2)
+#define FILE_BUFFER_SECTOR_SIZE (512)
+#define FILE_BUFFER_MAX_SIZE    (32 * 1024)
+
+typedef struct file_buffer {
+    FIL *fp;
+    uint8_t *data;
+    uint32_t size;  // Multiple of the sector size.
+    uint32_t start; // First byte of the buffer to read/write.
+    uint32_t index; // Current read/write position.
+    uint32_t end;   // End of the data read.
+} file_buffer_t;
+
+static file_buffer_t file_buffers[FILE_BUFFER_COUNT];
+
+static file_buffer_t *file_buffer_get(FIL *fp) {
+    for (int i = 0; i < FILE_BUFFER_COUNT; i++) {
+        if (file_buffers[i].fp == fp) {
+            return &file_buffers[i];
+        }
+    }
+    return NULL;
+}
+
+// The buffer memory is released by the fb_alloc mark of the caller when raising.
+static void file_abort(FIL *fp) {
+    file_buffer_t *buf = file_buffer_get(fp);
+    if (buf) {
+        buf->fp = NULL;
+    }
+    f_close(fp);
+}
+
 NORETURN static void ff_read_fail(FIL *fp) {
     if (fp) {
-        f_close(fp);
+        file_abort(fp);
     }
     mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Failed to read requested bytes!"));
 }
 
 NORETURN static void ff_write_fail(FIL *fp) {
     if (fp) {
-        f_close(fp);
+        file_abort(fp);
     }
     mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Failed to write requested bytes!"));
 }
 
 NORETURN static void ff_expect_fail(FIL *fp) {
     if (fp) {
-        f_close(fp);
+        file_abort(fp);
     }
     mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Unexpected value read!"));
 }
 
 NORETURN void file_raise_format(FIL *fp) {
     if (fp) {
-        f_close(fp);
+        file_abort(fp);
     }
     mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Unsupported format!"));
 }
 
 NORETURN void file_raise_corrupted(FIL *fp) {
     if (fp) {
-        f_close(fp);
+        file_abort(fp);
     }
     mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("File corrupted!"));
 }
 
 NORETURN void file_raise_error(FIL *fp, FRESULT res) {
     if (fp) {
-        f_close(fp);
+        file_abort(fp);
     }
     mp_raise_msg(&mp_type_OSError, (mp_rom_error_text_t) ffs_strerror(res));
 }
@@ -156,95 +189,97 @@ FRESULT file_ll_touch(const TCHAR *path) {
 // more than 512 bytes left to write FatFs will detect that it can bypass
 // its internal write buffer and pass the data buffer passed to it directly
 // to the disk write function. However, the disk write function needs the
-// buffer to be aligned to a 4-byte boundary. FatFs doesn't know this and
-// will pass an unaligned buffer if we don't fix the issue. To fix this problem
-// we use a temporary buffer to fix the alignment and to speed everything up.
-// We use this temporary buffer for both reads and writes. The buffer allows us
-// to do multi-block reads and writes which significantly speed things up.
-
-static uint32_t file_buffer_offset = 0;
-static uint8_t *file_buffer_pointer = 0;
-static uint32_t file_buffer_size = 0;
-static uint32_t file_buffer_index = 0;
+// buffer to be aligned to a 4-byte boundary (and to a cache line for DMA).
+// FatFs doesn't know this and will pass an unaligned buffer if we don't fix
+// the issue. To fix this problem we use a temporary, cache aligned buffer that
+// is a multiple of the sector size and maps sector aligned file positions to
+// the start of the buffer. The buffer allows us to do multi-block reads and
+// writes which significantly speed things up. Each buffered file has its own
+// buffer, and buffers are allocated/freed from fb_alloc in LIFO order.
 
 void file_buffer_init0() {
-    file_buffer_offset = 0;
-    file_buffer_pointer = 0;
-    file_buffer_size = 0;
-    file_buffer_index = 0;
-}
-
-OMV_ATTR_ALWAYS_INLINE static void file_fill(FIL *fp) {
-    if (file_buffer_index == file_buffer_size) {
-        file_buffer_pointer -= file_buffer_offset;
-        file_buffer_size += file_buffer_offset;
-        file_buffer_offset = 0;
-        file_buffer_index = 0;
-        uint32_t file_remaining = f_size(fp) - f_tell(fp);
-        uint32_t can_do = FF_MIN(file_buffer_size, file_remaining);
+    memset(file_buffers, 0, sizeof(file_buffers));
+}
+
+// Reads the rest of the sector containing the current file position, or whole sectors.
+static void file_buffer_read(FIL *fp, file_buffer_t *buf) {
+    buf->start = buf->index = f_tell(fp) % FILE_BUFFER_SECTOR_SIZE;
+    uint32_t file_remaining = f_size(fp) - f_tell(fp);
+    uint32_t can_do = FF_MIN(buf->size - buf->start, file_remaining);
+    UINT bytes;
+    FRESULT res = f_read(fp, buf->data + buf->start, can_do, &bytes);
+    if (res != FR_OK) {
+        file_raise_error(fp, res);
+    }
+    if (bytes != can_do) {
+        ff_read_fail(fp);
+    }
+    buf->end = buf->start + can_do;
+}
+
+// Writes the buffered data, after which the file position is sector aligned if the buffer was full.
+static void file_buffer_write(FIL *fp, file_buffer_t *buf) {
+    uint32_t can_do = buf->index - buf->start;
+    if (can_do) {
         UINT bytes;
-        FRESULT res = f_read(fp, file_buffer_pointer, can_do, &bytes);
+        FRESULT res = f_write(fp, buf->data + buf->start, can_do, &bytes);
         if (res != FR_OK) {
             file_raise_error(fp, res);
         }
         if (bytes != can_do) {
-            ff_read_fail(fp);
+            ff_write_fail(fp);
         }
     }
+    buf->start = buf->index = buf->end = f_tell(fp) % FILE_BUFFER_SECTOR_SIZE;
 }
 
-OMV_ATTR_ALWAYS_INLINE static void file_flush(FIL *fp) {
-    if (file_buffer_index == file_buffer_size) {
-        UINT bytes;
-        FRESULT res = f_write(fp, file_buffer_pointer, file_buffer_index, &bytes);
-        if (res != FR_OK) {
-            file_raise_error(fp, res);
-        }
-        if (bytes != file_buffer_index) {
-            ff_write_fail(fp);
+OMV_ATTR_ALWAYS_INLINE static void file_fill(FIL *fp, file_buffer_t *buf) {
+    if (buf->index == buf->end) {
+        file_buffer_read(fp, buf);
+        if (buf->index == buf->end) {
+            ff_read_fail(fp);
         }
-        file_buffer_pointer -= file_buffer_offset;
-        file_buffer_size += file_buffer_offset;
-        file_buffer_offset = 0;
-        file_buffer_index = 0;
+    }
+}
+
+OMV_ATTR_ALWAYS_INLINE static void file_flush(FIL *fp, file_buffer_t *buf) {
+    if (buf->index == buf->size) {
+        file_buffer_write(fp, buf);
     }
 }
 
 void file_buffer_on(FIL *fp) {
-    file_buffer_offset = f_tell(fp) % 4;
-    file_buffer_pointer = fb_alloc_all(&file_buffer_size, FB_ALLOC_PREFER_SIZE) + file_buffer_offset;
-    if (!file_buffer_size) {
+    file_buffer_t *buf = file_buffer_get(NULL);
+    if (!buf) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Too many buffered files!"));
+    }
+    // Leave the rest of the memory to the caller.
+    buf->size = FF_MIN(fb_avail(), FILE_BUFFER_MAX_SIZE) & ~(FILE_BUFFER_SECTOR_SIZE - 1);
+    if (!buf->size) {
         mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("No memory!"));
     }
-    file_buffer_size -= file_buffer_offset;
-    file_buffer_index = 0;
+    buf->data = fb_alloc(buf->size, FB_ALLOC_PREFER_SIZE | FB_ALLOC_CACHE_ALIGN);
+    buf->fp = fp;
     if (fp->flag & FA_READ) {
-        uint32_t file_remaining = f_size(fp) - f_tell(fp);
-        uint32_t can_do = FF_MIN(file_buffer_size, file_remaining);
-        UINT bytes;
-        FRESULT res = f_read(fp, file_buffer_pointer, can_do, &bytes);
-        if (res != FR_OK) {
-            file_raise_error(fp, res);
-        }
-        if (bytes != can_do) {
-            ff_read_fail(fp);
-        }
+        file_buffer_read(fp, buf);
+    } else {
+        buf->start = buf->index = buf->end = f_tell(fp) % FILE_BUFFER_SECTOR_SIZE;
     }
 }
 
 void file_buffer_off(FIL *fp) {
-    if ((fp->flag & FA_WRITE) && file_buffer_index) {
-        UINT bytes;
-        FRESULT res = f_write(fp, file_buffer_pointer, file_buffer_index, &bytes);
-        if (res != FR_OK) {
-            file_raise_error(fp, res);
-        }
-        if (bytes != file_buffer_index) {
-            ff_write_fail(fp);
+    file_buffer_t *buf = file_buffer_get(fp);
+    if (buf) {
+        // Free the buffer first, a write error closes the file.
+        buf->fp = NULL;
+        if (fp->flag & FA_READ) {
+            // Move the file position back to what was read.
+            f_lseek(fp, f_tell(fp) - (buf->end - buf->index));
+        } else {
+            file_buffer_write(fp, buf);
         }
+        fb_free();
     }
-    file_buffer_pointer = 0;
-    fb_free();
 }
 
 void file_open(FIL *fp, const char *path, bool buffered, uint32_t flags) {
@@ -258,9 +293,7 @@ void file_open(FIL *fp, const char *path, bool buffered, uint32_t flags) {
 }
 
 void file_close(FIL *fp) {
-    if (file_buffer_pointer) {
-        file_buffer_off(fp);
-    }
+    file_buffer_off(fp);
 
     FRESULT res = f_close(fp);
     if (res != FR_OK) {
@@ -269,10 +302,18 @@ void file_close(FIL *fp) {
 }
 
 void file_seek(FIL *fp, UINT offset) {
+    file_buffer_t *buf = file_buffer_get(fp);
+    if (buf && (!(fp->flag & FA_READ))) {
+        file_buffer_write(fp, buf);
+    }
     FRESULT res = f_lseek(fp, offset);
     if (res != FR_OK) {
         file_raise_error(fp, res);
     }
+    if (buf) {
+        // Start over at the new position.
+        buf->start = buf->index = buf->end = offset % FILE_BUFFER_SECTOR_SIZE;
+    }
 }
 
 void file_truncate(FIL *fp) {
@@ -290,34 +331,40 @@ void file_sync(FIL *fp) {
 }
 
 uint32_t file_tell(FIL *fp) {
-    if (file_buffer_pointer) {
+    file_buffer_t *buf = file_buffer_get(fp);
+    if (buf) {
         if (fp->flag & FA_READ) {
-            return f_tell(fp) - file_buffer_size + file_buffer_index;
+            return f_tell(fp) - (buf->end - buf->index);
         } else {
-            return f_tell(fp) + file_buffer_index;
+            return f_tell(fp) + (buf->index - buf->start);
         }
     }
     return f_tell(fp);
 }
 
 uint32_t file_size(FIL *fp) {
-    if (file_buffer_pointer) {
+    file_buffer_t *buf = file_buffer_get(fp);
+    if (buf) {
         if (fp->flag & FA_READ) {
             return f_size(fp);
         } else {
-            return f_size(fp) + file_buffer_index;
+            return f_size(fp) + (buf->index - buf->start);
         }
     }
     return f_size(fp);
 }
 
 void file_read(FIL *fp, void *data, size_t size) {
+    file_buffer_t *buf = file_buffer_get(fp);
+
     if (data == NULL) {
         uint8_t byte;
-        if (file_buffer_pointer) {
-            for (size_t i = 0; i < size; i++) {
-                file_fill(fp);
-                byte = file_buffer_pointer[file_buffer_index++];
+        if (buf) {
+            while (size) {
+                file_fill(fp, buf);
+                uint32_t can_do = FF_MIN(size, buf->end - buf->index);
+                buf->index += can_do;
+                size -= can_do;
             }
         } else {
             for (size_t i = 0; i < size; i++) {
@@ -334,19 +381,18 @@ void file_read(FIL *fp, void *data, size_t size) {
         return;
     }
 
-    if (file_buffer_pointer) {
+    if (buf) {
         if (size <= 4) {
             for (size_t i = 0; i < size; i++) {
-                file_fill(fp);
-                ((uint8_t *) data)[i] = file_buffer_pointer[file_buffer_index++];
+                file_fill(fp, buf);
+                ((uint8_t *) data)[i] = buf->data[buf->index++];
             }
         } else {
             while (size) {
-                file_fill(fp);
-                uint32_t file_buffer_space_left = file_buffer_size - file_buffer_index;
-                uint32_t can_do = FF_MIN(size, file_buffer_space_left);
-                memcpy(data, file_buffer_pointer + file_buffer_index, can_do);
-                file_buffer_index += can_do;
+                file_fill(fp, buf);
+                uint32_t can_do = FF_MIN(size, buf->end - buf->index);
+                memcpy(data, buf->data + buf->index, can_do);
+                buf->index += can_do;
                 data += can_do;
                 size -= can_do;
             }
@@ -364,18 +410,19 @@ void file_read(FIL *fp, void *data, size_t size) {
 }
 
 void file_write(FIL *fp, const void *data, size_t size) {
-    if (file_buffer_pointer) {
+    file_buffer_t *buf = file_buffer_get(fp);
+
+    if (buf) {
         // We get a massive speed boost by buffering up as much data as possible
         // before a write to the SD card. So much so that the time wasted by
         // all these operations does not cost us.
         while (size) {
-            uint32_t file_buffer_space_left = file_buffer_size - file_buffer_index;
-            uint32_t can_do = FF_MIN(size, file_buffer_space_left);
-            memcpy(file_buffer_pointer + file_buffer_index, data, can_do);
-            file_buffer_index += can_do;
+            uint32_t can_do = FF_MIN(size, buf->size - buf->index);
+            memcpy(buf->data + buf->index, data, can_do);
+            buf->index += can_do;
             data += can_do;
             size -= can_do;
-            file_flush(fp);
+            file_flush(fp, buf);
         }
     } else {
         UINT bytes;
@@ -33,7 +33,7 @@ FRESULT file_ll_touch(const TCHAR *path);
 
 // File buffer functions.
 void file_buffer_init0();
-void file_buffer_on(FIL *fp);  // Calls fb_alloc_all()
+void file_buffer_on(FIL *fp);  // Calls fb_alloc()
 void file_buffer_off(FIL *fp); // Calls fb_free()
 
 void file_open(FIL *fp, const char *path, bool buffered, uint32_t flags);
@@ -47,16 +47,16 @@
 
 #define OMV_ARRAY_SIZE(a)         (sizeof(a) / sizeof(a[0]))
 
-#if OMV_PROFILE_ENABLE
-#include <stdio.h>
-#include "py/mphal.h"
+// Probe points, see probe.h.
+#if OMV_PROFILE_ENABLE && (__ARM_ARCH >= 7)
+#include "probe.h"
 #define OMV_CONCATENATE_DETAIL(x, y) x##y
 #define OMV_CONCATENATE(x, y)   OMV_CONCATENATE_DETAIL(x, y)
-#define OMV_PROFILE_START(F)    mp_uint_t OMV_CONCATENATE(_ticks_start_, F) = mp_hal_ticks_us()
-#define OMV_PROFILE_PRINT(F)    printf("%s:%s %u us\n", __FUNCTION__, #F, mp_hal_ticks_us() - OMV_CONCATENATE(_ticks_start_, F))
+#define OMV_PROFILE_START(F)    uint32_t OMV_CONCATENATE(_probe_start_, F) = probe_cycles()
+#define OMV_PROFILE_END(F)      probe_record(OMV_PROBE_ID_##F, probe_cycles() - OMV_CONCATENATE(_probe_start_, F))
 #else
 #define OMV_PROFILE_START(F)
-#define OMV_PROFILE_PRINT(F)
+#define OMV_PROFILE_END(F)
 #endif
 
 #endif //__OMV_COMMON_H__
@@ -0,0 +1,20 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * CRC functions.
+ *
+ * omv_crc16() computes the CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF, no
+ * reflection) used by the rpc library. The common implementation is table driven, ports with
+ * a CRC unit override it.
+ */
+#ifndef __OMV_CRC_H__
+#define __OMV_CRC_H__
+#include <stdint.h>
+#include <stddef.h>
+uint16_t omv_crc16(const void *buf, size_t size);
+#endif // __OMV_CRC_H__
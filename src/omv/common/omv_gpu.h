@@ -12,9 +12,16 @@
 #define __OMV_GPU_H__
 #include "imlib.h"
 
+// Smaller copies are done by the CPU, faster than the engine can be set up.
+#ifndef OMV_GPU_COPY_MIN_PIXELS
+#define OMV_GPU_COPY_MIN_PIXELS     (4096)
+#endif
+
 int omv_gpu_init();
 void omv_gpu_deinit();
 
+// All functions return 0 if the operation was done by the GPU, or -1 if it must be done in software.
+
 // Draws src_rect from src_img to dst_rect in dst_img.
 // If the sizes of src_rect and dst_rect are different then the image must be scaled.
 // Alpha is the alpha value (0-256) to use when blending the source image with the destination image.
@@ -36,4 +43,15 @@ int omv_gpu_draw_image(image_t *src_img,
                        const uint16_t *color_palette,
                        const uint8_t *alpha_palette,
                        image_hint_t hint);
+
+// Copies h rows of w pixels of bpp bytes from src to dst, which must not overlap. The strides are
+// the distances in bytes between the rows. The copy is complete when the function returns.
+int omv_gpu_copy(void *dst, size_t dst_stride, const void *src, size_t src_stride, size_t w, size_t h, size_t bpp);
+
+// Fills rect, which must be inside dst_img, with color in the pixel format of dst_img.
+int omv_gpu_fill_rect(image_t *dst_img, rectangle_t *rect, int color);
+
+// Draws a line of thickness pixels from (x0, y0) to (x1, y1) in dst_img with color, in the pixel
+// format of dst_img. The line may extend outside of the image.
+int omv_gpu_draw_line(image_t *dst_img, int x0, int y0, int x1, int y1, int color, int thickness);
 #endif // __OMV_GPU_H__
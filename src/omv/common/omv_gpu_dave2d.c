@@ -0,0 +1,218 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * GPU driver for the D/AVE 2D engine.
+ *
+ * Ports with a D/AVE 2D engine enable this driver with OMV_GPU_ENABLE and OMV_GPU_DAVE2D, and
+ * build drivers/dave2d with the port's low-level (d1) driver. Images are drawn with scaled,
+ * filtered and mirrored blits, grayscale images and palettes use the texture CLUT, and the
+ * rectangle and line primitives are rendered directly. Only RGB565 targets are supported.
+ */
+#include "omv_boardconfig.h"
+#if (OMV_GPU_ENABLE == 1) && (OMV_GPU_DAVE2D == 1)
+#include CMSIS_MCU_H
+#include "dave_driver.h"
+#include "imlib.h"
+#include "fb_alloc.h"
+#include "omv_gpu.h"
+
+#define GPU_FIX4(x)     ((x) << 4)
+
+static d2_device *d2_handle = NULL;
+
+int omv_gpu_init() {
+    d2_handle = d2_opendevice(0);
+    if (d2_handle == NULL) {
+        return -1;
+    }
+
+    if (d2_inithw(d2_handle, 0) != D2_OK) {
+        d2_closedevice(d2_handle);
+        d2_handle = NULL;
+        return -1;
+    }
+
+    return 0;
+}
+
+void omv_gpu_deinit() {
+    if (d2_handle != NULL) {
+        d2_deinithw(d2_handle);
+        d2_closedevice(d2_handle);
+        d2_handle = NULL;
+    }
+}
+
+static inline d2_color omv_gpu_color(int pixel) {
+    return (COLOR_RGB565_TO_R8(pixel) << 16) | (COLOR_RGB565_TO_G8(pixel) << 8) | COLOR_RGB565_TO_B8(pixel);
+}
+
+// Writes back the cache lines of a rectangle of rows before the engine reads (and writes) it.
+static void omv_gpu_clean(void *ptr, size_t stride, size_t len, int rows, bool invalidate) {
+    #if __DCACHE_PRESENT
+    size_t size = (stride * (rows - 1)) + len;
+    if (invalidate) {
+        SCB_CleanInvalidateDCache_by_Addr(ptr, size);
+    } else {
+        SCB_CleanDCache_by_Addr(ptr, size);
+    }
+    #endif
+}
+
+// Drops any cached reads of a rectangle of rows written by the engine.
+static void omv_gpu_invalidate(void *ptr, size_t stride, size_t len, int rows) {
+    #if __DCACHE_PRESENT
+    SCB_InvalidateDCache_by_Addr(ptr, (stride * (rows - 1)) + len);
+    #endif
+}
+
+static int omv_gpu_start_frame(image_t *dst_img, rectangle_t *rect) {
+    if ((d2_handle == NULL) || (dst_img->pixfmt != PIXFORMAT_RGB565)) {
+        return -1;
+    }
+
+    size_t stride = IMAGE_RGB565_ROW_STRIDE(dst_img);
+    omv_gpu_clean(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst_img, rect->y) + rect->x,
+                  stride, rect->w * sizeof(uint16_t), rect->h, true);
+
+    d2_startframe(d2_handle);
+    d2_framebuffer(d2_handle, dst_img->data, stride / sizeof(uint16_t), dst_img->w, dst_img->h, d2_mode_rgb565);
+    d2_cliprect(d2_handle, 0, 0, dst_img->w - 1, dst_img->h - 1);
+    d2_setalpha(d2_handle, 0xff);
+    return 0;
+}
+
+// Waits for the frame to be rendered.
+static void omv_gpu_end_frame(image_t *dst_img, rectangle_t *rect) {
+    d2_endframe(d2_handle);
+    d2_flushframe(d2_handle);
+
+    size_t stride = IMAGE_RGB565_ROW_STRIDE(dst_img);
+    omv_gpu_invalidate(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst_img, rect->y) + rect->x,
+                       stride, rect->w * sizeof(uint16_t), rect->h);
+}
+
+int omv_gpu_draw_image(image_t *src_img,
+                       rectangle_t *src_rect,
+                       image_t *dst_img,
+                       rectangle_t *dst_rect,
+                       int alpha,
+                       const uint16_t *color_palette,
+                       const uint8_t *alpha_palette,
+                       image_hint_t hint) {
+    // The engine can only read RGB565 or GRAYSCALE (with a CLUT) images.
+    // If the source image is RGB565, it must not have a color or alpha palette.
+    if ((src_img->pixfmt != PIXFORMAT_GRAYSCALE) &&
+        ((src_img->pixfmt != PIXFORMAT_RGB565) || color_palette || alpha_palette)) {
+        return -1;
+    }
+
+    if (omv_gpu_start_frame(dst_img, dst_rect) != 0) {
+        return -1;
+    }
+
+    OMV_PROFILE_START(gpu_draw_image);
+
+    // The destination is considered to be black, so clear it first.
+    if (hint & IMAGE_HINT_BLACK_BACKGROUND) {
+        d2_setcolor(d2_handle, 0, 0);
+        d2_renderbox(d2_handle, GPU_FIX4(dst_rect->x), GPU_FIX4(dst_rect->y),
+                     GPU_FIX4(dst_rect->w), GPU_FIX4(dst_rect->h));
+    }
+
+    d2_u32 flags = 0;
+    d2_u32 format = d2_mode_rgb565;
+    size_t src_stride = IMAGE_RGB565_ROW_STRIDE(src_img);
+    size_t src_bpp = sizeof(uint16_t);
+    d2_color *clut = NULL;
+
+    if (src_img->pixfmt == PIXFORMAT_GRAYSCALE) {
+        format = d2_mode_i8 | d2_mode_clut;
+        src_stride = IMAGE_GRAYSCALE_ROW_STRIDE(src_img);
+        src_bpp = sizeof(uint8_t);
+        clut = fb_alloc(256 * sizeof(d2_color), FB_ALLOC_CACHE_ALIGN);
+
+        for (int i = 0; i < 256; i++) {
+            d2_color a = alpha_palette ? alpha_palette[i] : 0xff;
+            d2_color c = color_palette ? omv_gpu_color(color_palette[i]) : COLOR_Y_TO_RGB888(i);
+            clut[i] = (a << 24) | c;
+        }
+
+        d2_settexclut(d2_handle, clut);
+        flags |= alpha_palette ? d2_bf_usealpha : 0;
+    }
+
+    flags |= (hint & IMAGE_HINT_BILINEAR) ? d2_bf_filter : 0;
+    flags |= (hint & IMAGE_HINT_HMIRROR) ? d2_bf_mirroru : 0;
+    flags |= (hint & IMAGE_HINT_VFLIP) ? d2_bf_mirrorv : 0;
+
+    // Global alpha is combined with the alpha of the source.
+    d2_setalpha(d2_handle, (alpha * 255) / 256);
+
+    omv_gpu_clean(src_img->data + (src_rect->y * src_stride) + (src_rect->x * src_bpp),
+                  src_stride, src_rect->w * src_bpp, src_rect->h, false);
+
+    d2_setblitsrc(d2_handle, src_img->data, src_stride / src_bpp, src_img->w, src_img->h, format);
+    d2_blitcopy(d2_handle, src_rect->w, src_rect->h, src_rect->x, src_rect->y,
+                GPU_FIX4(dst_rect->w), GPU_FIX4(dst_rect->h),
+                GPU_FIX4(dst_rect->x), GPU_FIX4(dst_rect->y), flags);
+
+    omv_gpu_end_frame(dst_img, dst_rect);
+
+    if (clut) {
+        fb_free(); // clut
+    }
+
+    OMV_PROFILE_END(gpu_draw_image);
+    return 0;
+}
+
+int omv_gpu_fill_rect(image_t *dst_img, rectangle_t *rect, int color) {
+    if (omv_gpu_start_frame(dst_img, rect) != 0) {
+        return -1;
+    }
+
+    d2_setcolor(d2_handle, 0, omv_gpu_color(color));
+    d2_renderbox(d2_handle, GPU_FIX4(rect->x), GPU_FIX4(rect->y), GPU_FIX4(rect->w), GPU_FIX4(rect->h));
+
+    omv_gpu_end_frame(dst_img, rect);
+    return 0;
+}
+
+// Copies are left to the CPU, the engine only renders to RGB565 framebuffers.
+int omv_gpu_copy(void *dst, size_t dst_stride, const void *src, size_t src_stride, size_t w, size_t h, size_t bpp) {
+    return -1;
+}
+
+int omv_gpu_draw_line(image_t *dst_img, int x0, int y0, int x1, int y1, int color, int thickness) {
+    // The rectangle covered by the line, used for cache maintenance.
+    int t = (thickness + 1) / 2;
+    rectangle_t rect = {IM_MIN(x0, x1) - t, IM_MIN(y0, y1) - t, abs(x1 - x0) + (t * 2) + 1, abs(y1 - y0) + (t * 2) + 1};
+    rectangle_t bounds = {0, 0, dst_img->w, dst_img->h};
+
+    if (!rectangle_overlap(&rect, &bounds)) {
+        return 0;
+    }
+
+    rectangle_intersected(&rect, &bounds);
+
+    if (omv_gpu_start_frame(dst_img, &rect) != 0) {
+        return -1;
+    }
+
+    // Lines go through the pixel centers, thin lines are aliased like the software path.
+    d2_setantialiasing(d2_handle, thickness > 1);
+    d2_setcolor(d2_handle, 0, omv_gpu_color(color));
+    d2_renderline(d2_handle, GPU_FIX4(x0) + 8, GPU_FIX4(y0) + 8, GPU_FIX4(x1) + 8, GPU_FIX4(y1) + 8,
+                  GPU_FIX4(IM_MAX(thickness, 1)), d2_le_exclude_none);
+    d2_setantialiasing(d2_handle, 1);
+
+    omv_gpu_end_frame(dst_img, &rect);
+    return 0;
+}
+#endif // (OMV_GPU_ENABLE == 1) && (OMV_GPU_DAVE2D == 1)
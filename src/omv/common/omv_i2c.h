@@ -38,6 +38,9 @@ typedef enum omv_i2c_xfer_flags {
     OMV_I2C_XFER_RESTART =   (1 << 3),
 } omv_i2c_xfer_flags_t;
 
+// Max number of consecutive registers written in one transfer by omv_i2c_write_regs2.
+#define OMV_I2C_REGS_MAX_BURST  (32)
+
 typedef struct _omv_i2c {
     uint32_t id;
     uint32_t speed;
@@ -69,4 +72,7 @@ int omv_i2c_readw2(omv_i2c_t *i2c, uint8_t slv_addr, uint16_t reg_addr,  uint16_
 int omv_i2c_writew2(omv_i2c_t *i2c, uint8_t slv_addr, uint16_t reg_addr, uint16_t reg_data);
 int omv_i2c_read_bytes(omv_i2c_t *i2c, uint8_t slv_addr, uint8_t *buf, int len, uint32_t flags);
 int omv_i2c_write_bytes(omv_i2c_t *i2c, uint8_t slv_addr, uint8_t *buf, int len, uint32_t flags);
+// Writes a table of { addr_h, addr_l, data } entries to a device with 16-bit register addresses
+// and auto-increment. Stops after count entries (or all if count < 0) or at a zero address entry.
+int omv_i2c_write_regs2(omv_i2c_t *i2c, uint8_t slv_addr, const uint8_t (*regs)[3], int count);
 #endif // __OMV_I2C_H__
@@ -0,0 +1,41 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * I2C register table writes.
+ *
+ * Consecutive table entries with incrementing register addresses are coalesced into a single
+ * auto-increment transfer with omv_i2c_write_bytes, instead of one transaction per register.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include "omv_i2c.h"
+
+int omv_i2c_write_regs2(omv_i2c_t *i2c, uint8_t slv_addr, const uint8_t (*regs)[3], int count) {
+    int ret = 0;
+    uint8_t buf[2 + OMV_I2C_REGS_MAX_BURST];
+
+    for (int i = 0; ((count < 0) || (i < count)) && (regs[i][0] || regs[i][1]);) {
+        uint16_t addr = (regs[i][0] << 8) | regs[i][1];
+        int len = 0;
+
+        buf[0] = regs[i][0];
+        buf[1] = regs[i][1];
+
+        // Collect the run of consecutive registers starting at this address.
+        do {
+            buf[2 + len++] = regs[i++][2];
+        } while (((count < 0) || (i < count))
+                 && (len < OMV_I2C_REGS_MAX_BURST)
+                 && (((regs[i][0] << 8) | regs[i][1]) == (addr + len))
+                 && (regs[i][0] || regs[i][1]));
+
+        ret |= omv_i2c_write_bytes(i2c, slv_addr, buf, 2 + len, OMV_I2C_XFER_NO_FLAGS);
+    }
+
+    return ret;
+}
@@ -0,0 +1,128 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Background tasks.
+ */
+#include <stdbool.h>
+#include "py/runtime.h"
+#include "py/mphal.h"
+#include "omv_task.h"
+
+static omv_task_t *omv_task_head;
+static omv_task_t *omv_task_current;
+static mp_sched_node_t omv_task_node;
+static bool omv_task_node_scheduled;
+
+static void omv_task_sched_callback(mp_sched_node_t *node);
+
+void omv_task_init0() {
+    for (omv_task_t *task = omv_task_head; task; task = task->next) {
+        task->queued = false;
+    }
+    omv_task_head = NULL;
+    omv_task_current = NULL;
+    omv_task_node_scheduled = false;
+    // The scheduler queue is cleared on soft-reset, the node must be reusable.
+    omv_task_node = (mp_sched_node_t) { 0 };
+}
+
+// Inserts the task behind the tasks with the same or a lower priority value.
+static void omv_task_insert(omv_task_t *task) {
+    omv_task_t **prev = &omv_task_head;
+    while (*prev && ((*prev)->priority <= task->priority)) {
+        prev = &(*prev)->next;
+    }
+    task->next = *prev;
+    *prev = task;
+}
+
+static void omv_task_remove(omv_task_t *task) {
+    for (omv_task_t **prev = &omv_task_head; *prev; prev = &(*prev)->next) {
+        if (*prev == task) {
+            *prev = task->next;
+            break;
+        }
+    }
+    task->next = NULL;
+}
+
+// Makes sure the scheduler runs the queue, must be called in an atomic section.
+static void omv_task_kick() {
+    if (omv_task_head && (!omv_task_node_scheduled)) {
+        omv_task_node_scheduled = true;
+        mp_sched_schedule_node(&omv_task_node, omv_task_sched_callback);
+    }
+}
+
+void omv_task_schedule(omv_task_t *task) {
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    if (!task->queued) {
+        task->queued = true;
+        // A task scheduled from its own step is queued again when the step returns.
+        if (task != omv_task_current) {
+            omv_task_insert(task);
+            omv_task_kick();
+        }
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+}
+
+void omv_task_cancel(omv_task_t *task) {
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    if (task->queued) {
+        task->queued = false;
+        omv_task_remove(task);
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+}
+
+bool omv_task_pending() {
+    return omv_task_head != NULL;
+}
+
+bool omv_task_run() {
+    // Steps don't nest, a driver waiting inside a step must not run another one.
+    if (omv_task_current) {
+        return false;
+    }
+
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    omv_task_t *task = omv_task_head;
+    if (task) {
+        omv_task_remove(task);
+        task->queued = false;
+        omv_task_current = task;
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+
+    if (!task) {
+        return false;
+    }
+
+    mp_uint_t start = mp_hal_ticks_us();
+    bool more = task->func(task);
+    task->run_us += mp_hal_ticks_us() - start;
+    task->runs += 1;
+
+    atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    omv_task_current = NULL;
+    // Round-robin between tasks of the same priority.
+    if (more || task->queued) {
+        task->queued = true;
+        omv_task_insert(task);
+        omv_task_kick();
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+    return true;
+}
+
+// Runs one step per pass of the scheduler, so the VM gets to run between steps.
+static void omv_task_sched_callback(mp_sched_node_t *node) {
+    omv_task_node_scheduled = false;
+    omv_task_run();
+}
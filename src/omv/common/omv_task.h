@@ -0,0 +1,52 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Background tasks.
+ *
+ * Deferred C work (file writes, read-ahead, etc.) is queued as tasks which run one step at a
+ * time, highest priority first, from the MicroPython scheduler (between bytecodes and in the
+ * MICROPY_EVENT_POLL_HOOK of blocking waits) and from drivers that wait for hardware, such as
+ * sensor_snapshot(). Steps run in thread mode with the VM state intact, so they may use FatFs
+ * and fb_alloc, but must not raise exceptions or leave fb_alloc allocations behind. Tasks are
+ * linked into the queue, so they must be statically allocated.
+ */
+#ifndef __OMV_TASK_H__
+#define __OMV_TASK_H__
+#include <stdint.h>
+#include <stdbool.h>
+
+// Task priorities, lower values run first.
+#define OMV_TASK_PRIORITY_HIGH      (0) // Work that frees resources, such as write-behind flushes.
+#define OMV_TASK_PRIORITY_NORMAL    (1)
+#define OMV_TASK_PRIORITY_LOW       (2) // Speculative work, such as read-ahead.
+
+typedef struct omv_task omv_task_t;
+
+// Runs a step of the task, returns true if the task has more work to do.
+typedef bool (*omv_task_func_t) (omv_task_t *task);
+
+typedef struct omv_task {
+    struct omv_task *next;
+    omv_task_func_t func;
+    uint32_t priority;  // Tasks with lower values run first.
+    bool queued;
+    uint32_t runs;      // Number of steps run.
+    uint32_t run_us;    // Total time spent in the steps.
+} omv_task_t;
+
+// Forgets all queued tasks, must be called on soft-reset.
+void omv_task_init0();
+// Queues the task if it's not queued already, it's dequeued when a step returns false.
+void omv_task_schedule(omv_task_t *task);
+// Removes the task from the queue. It must not be called from a step of the task.
+void omv_task_cancel(omv_task_t *task);
+// Returns true if any tasks are queued.
+bool omv_task_pending();
+// Runs a step of the highest priority task, returns false if there was nothing to run.
+bool omv_task_run();
+#endif // __OMV_TASK_H__
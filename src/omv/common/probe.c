@@ -0,0 +1,115 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Probe points.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "py/mphal.h"
+#include "omv_common.h"
+#include "probe.h"
+
+#define OMV_PROBE_NAME(name)    #name,
+static const char *probe_names[OMV_PROBE_COUNT] = {
+    OMV_PROBE_LIST(OMV_PROBE_NAME)
+};
+#undef OMV_PROBE_NAME
+
+const char *probe_name(uint32_t id) {
+    return (id < OMV_PROBE_COUNT) ? probe_names[id] : NULL;
+}
+
+static bool boot_started;
+static uint32_t boot_start_us;
+static uint32_t boot_marks_count;
+static boot_mark_t boot_marks[OMV_BOOT_MARKS_MAX];
+
+void boot_timeline_reset() {
+    // The first timeline includes the time spent before main() got here.
+    boot_start_us = boot_started ? mp_hal_ticks_us() : 0;
+    boot_started = true;
+    boot_marks_count = 0;
+}
+
+void boot_mark(const char *name) {
+    if (boot_marks_count < OMV_BOOT_MARKS_MAX) {
+        boot_marks[boot_marks_count].name = name;
+        boot_marks[boot_marks_count].us = mp_hal_ticks_us() - boot_start_us;
+        boot_marks_count += 1;
+    }
+}
+
+uint32_t boot_timeline(const boot_mark_t **marks) {
+    *marks = boot_marks;
+    return boot_marks_count;
+}
+
+#if OMV_PROFILE_ENABLE && (__ARM_ARCH >= 7)
+volatile uint32_t probe_head;
+probe_event_t probe_ring[OMV_PROBE_RING_SIZE];
+
+void probe_init() {
+    // Enable the DWT cycle counter.
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    #if (__CORTEX_M == 7)
+    DWT->LAR = 0xC5ACCE55;
+    #endif
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    probe_reset();
+}
+
+void probe_reset() {
+    // Unused slots have an invalid id.
+    for (size_t i = 0; i < OMV_PROBE_RING_SIZE; i++) {
+        probe_ring[i].id = OMV_PROBE_COUNT;
+    }
+}
+
+static int probe_compare(const void *a, const void *b) {
+    uint32_t x = *((const uint32_t *) a);
+    uint32_t y = *((const uint32_t *) b);
+    return (x > y) - (x < y);
+}
+
+bool probe_get_stats(uint32_t id, probe_stats_t *stats) {
+    uint32_t cycles[OMV_PROBE_RING_SIZE];
+    uint64_t sum = 0;
+    size_t n = 0;
+
+    // Events recorded while reading may or may not be included.
+    for (size_t i = 0; i < OMV_PROBE_RING_SIZE; i++) {
+        if (probe_ring[i].id == id) {
+            cycles[n] = probe_ring[i].cycles;
+            sum += cycles[n++];
+        }
+    }
+
+    if (!n) {
+        return false;
+    }
+
+    qsort(cycles, n, sizeof(uint32_t), probe_compare);
+    stats->count = n;
+    stats->min_cycles = cycles[0];
+    stats->mean_cycles = sum / n;
+    stats->p99_cycles = cycles[((n * 99) + 99) / 100 - 1];
+    return true;
+}
+#else
+void probe_init() {
+}
+
+void probe_reset() {
+}
+
+bool probe_get_stats(uint32_t id, probe_stats_t *stats) {
+    return false;
+}
+#endif // OMV_PROFILE_ENABLE && (__ARM_ARCH >= 7)
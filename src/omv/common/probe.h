@@ -0,0 +1,102 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Probe points.
+ *
+ * OMV_PROFILE_START(name)/OMV_PROFILE_END(name) time a block with the DWT cycle counter and
+ * append an (id, cycles) event to a lock-free ring. Recording an event is a couple of loads and
+ * stores, so probes stay enabled in release builds (build with PROFILE=0 to remove them). The
+ * ring keeps the most recent OMV_PROBE_RING_SIZE events, which are aggregated per probe when
+ * read with omv.probe_stats().
+ */
+#ifndef __PROBE_H__
+#define __PROBE_H__
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef OMV_PROBE_RING_SIZE
+#define OMV_PROBE_RING_SIZE     (256)   // Must be a power of 2.
+#endif
+
+// Probe names, new probes must be added here.
+#define OMV_PROBE_LIST(X) \
+    X(draw_image)         \
+    X(gpu_draw_image)     \
+    X(debayer)            \
+    X(debayer_awb)        \
+    X(debayer_half)       \
+    X(jpeg_compress)      \
+    X(jpeg_decompress)    \
+    X(png_compress)       \
+    X(png_decompress)     \
+    X(ml_preprocess)      \
+    X(ml_inference)       \
+    X(ml_postprocess)
+
+#define OMV_PROBE_ID(name)      OMV_PROBE_ID_##name,
+typedef enum {
+    OMV_PROBE_LIST(OMV_PROBE_ID)
+    OMV_PROBE_COUNT
+} omv_probe_id_t;
+#undef OMV_PROBE_ID
+
+typedef struct probe_event {
+    uint32_t id;
+    uint32_t cycles;
+} probe_event_t;
+
+typedef struct probe_stats {
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t mean_cycles;
+    uint32_t p99_cycles;
+} probe_stats_t;
+
+#if OMV_PROFILE_ENABLE && (__ARM_ARCH >= 7)
+#include CMSIS_MCU_H
+
+extern volatile uint32_t probe_head;
+extern probe_event_t probe_ring[OMV_PROBE_RING_SIZE];
+
+static inline uint32_t probe_cycles() {
+    return DWT->CYCCNT;
+}
+
+static inline void probe_record(uint32_t id, uint32_t cycles) {
+    // Claims a slot, so probes can also be recorded from IRQs.
+    uint32_t i = __atomic_fetch_add(&probe_head, 1, __ATOMIC_RELAXED) & (OMV_PROBE_RING_SIZE - 1);
+    probe_ring[i].cycles = cycles;
+    probe_ring[i].id = id;
+}
+#endif
+
+// Boot timeline. The ports' main() marks the end of each boot phase with OMV_BOOT_MARK(name),
+// the marks of the last reset are read with omv.boot_timeline(). Marks are always recorded.
+#ifndef OMV_BOOT_MARKS_MAX
+#define OMV_BOOT_MARKS_MAX      (24)
+#endif
+
+typedef struct boot_mark {
+    const char *name;
+    uint32_t us;    // Microseconds since the start of the boot.
+} boot_mark_t;
+
+#define OMV_BOOT_MARK(name)     boot_mark(#name)
+
+// Starts a new timeline, from reset on the first call or from now on soft resets.
+void boot_timeline_reset();
+void boot_mark(const char *name);
+// Returns the number of marks and sets marks to them.
+uint32_t boot_timeline(const boot_mark_t **marks);
+
+void probe_init();
+void probe_reset();
+const char *probe_name(uint32_t id);
+// Aggregates the events in the ring, returns false if the probe has no events.
+bool probe_get_stats(uint32_t id, probe_stats_t *stats);
+#endif // __PROBE_H__
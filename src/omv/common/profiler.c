@@ -0,0 +1,137 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Function-level cycle profiler.
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include CMSIS_MCU_H
+#include "profiler.h"
+
+#if OMV_PROFILER_ENABLE && (__ARM_ARCH >= 7)
+#define PROFILER_NO_INSTRUMENT  __attribute__((no_instrument_function))
+#define PROFILER_HASH(addr)     ((((addr) >> 1) * 2654435761U) >> (32 - __builtin_ctz(OMV_PROFILER_HASH_SIZE)))
+
+typedef struct profiler_frame {
+    profiler_record_t *record;
+    uint32_t start;
+    uint32_t children;
+} profiler_frame_t;
+
+static volatile bool profiler_paused;
+static uint32_t profiler_depth;
+static profiler_frame_t profiler_stack[OMV_PROFILER_STACK_SIZE];
+static profiler_record_t profiler_table[OMV_PROFILER_HASH_SIZE];
+
+PROFILER_NO_INSTRUMENT void profiler_init() {
+    // Enable the DWT cycle counter.
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    #if (__CORTEX_M == 7)
+    DWT->LAR = 0xC5ACCE55;
+    #endif
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+PROFILER_NO_INSTRUMENT void profiler_reset() {
+    profiler_paused = true;
+    profiler_depth = 0;
+    memset(profiler_table, 0, sizeof(profiler_table));
+    profiler_paused = false;
+}
+
+PROFILER_NO_INSTRUMENT void profiler_pause(bool pause) {
+    profiler_paused = pause;
+}
+
+PROFILER_NO_INSTRUMENT uint32_t profiler_record_count() {
+    return OMV_PROFILER_HASH_SIZE;
+}
+
+PROFILER_NO_INSTRUMENT const profiler_record_t *profiler_get_records() {
+    return profiler_table;
+}
+
+static PROFILER_NO_INSTRUMENT profiler_record_t *profiler_lookup(uint32_t address, uint32_t caller) {
+    for (uint32_t i = PROFILER_HASH(address), n = 0; n < OMV_PROFILER_HASH_SIZE; n++) {
+        profiler_record_t *record = &profiler_table[(i + n) & (OMV_PROFILER_HASH_SIZE - 1)];
+        if (record->address == address) {
+            return record;
+        }
+        if (record->address == 0) {
+            record->address = address;
+            record->caller = caller;
+            record->min_cycles = UINT32_MAX;
+            return record;
+        }
+    }
+    // Table is full.
+    return NULL;
+}
+
+PROFILER_NO_INSTRUMENT void __cyg_profile_func_enter(void *func, void *caller) {
+    // Only thread mode code is profiled, this keeps the stack consistent without locking.
+    if (profiler_paused || __get_IPSR()) {
+        return;
+    }
+
+    // Calls nested deeper than the stack are still counted by their parents.
+    if (profiler_depth < OMV_PROFILER_STACK_SIZE) {
+        profiler_frame_t *frame = &profiler_stack[profiler_depth];
+        frame->record = profiler_lookup((uint32_t) func, (uint32_t) caller);
+        frame->children = 0;
+        frame->start = DWT->CYCCNT;
+    }
+
+    profiler_depth++;
+}
+
+PROFILER_NO_INSTRUMENT void __cyg_profile_func_exit(void *func, void *caller) {
+    uint32_t cycles = DWT->CYCCNT;
+
+    if (profiler_paused || __get_IPSR() || !profiler_depth) {
+        return;
+    }
+
+    if (--profiler_depth < OMV_PROFILER_STACK_SIZE) {
+        profiler_frame_t *frame = &profiler_stack[profiler_depth];
+        cycles -= frame->start;
+
+        if (frame->record) {
+            profiler_record_t *record = frame->record;
+            record->calls += 1;
+            record->total_cycles += cycles;
+            record->self_cycles += cycles - frame->children;
+            record->min_cycles = (cycles < record->min_cycles) ? cycles : record->min_cycles;
+            record->max_cycles = (cycles > record->max_cycles) ? cycles : record->max_cycles;
+        }
+
+        if (profiler_depth) {
+            profiler_stack[profiler_depth - 1].children += cycles;
+        }
+    }
+}
+#else
+void profiler_init() {
+}
+
+void profiler_reset() {
+}
+
+void profiler_pause(bool pause) {
+}
+
+uint32_t profiler_record_count() {
+    return 0;
+}
+
+const profiler_record_t *profiler_get_records() {
+    return NULL;
+}
+#endif // OMV_PROFILER_ENABLE && (__ARM_ARCH >= 7)
@@ -0,0 +1,46 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Function-level cycle profiler.
+ *
+ * When built with PROFILER=1, imlib and the sensor driver are compiled with
+ * -finstrument-functions and every function entry/exit is timed with the DWT
+ * cycle counter. Per-function statistics are aggregated in a RAM table that's
+ * read by the IDE with USBDBG_PROFILE_SIZE/USBDBG_PROFILE_DUMP. Function
+ * addresses are resolved to names on the host using the firmware ELF file.
+ */
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifndef OMV_PROFILER_HASH_SIZE
+#define OMV_PROFILER_HASH_SIZE      (256)   // Must be a power of 2.
+#endif
+
+#ifndef OMV_PROFILER_STACK_SIZE
+#define OMV_PROFILER_STACK_SIZE     (64)
+#endif
+
+typedef struct profiler_record {
+    uint32_t address;       // Function address (0 if the record is unused).
+    uint32_t caller;        // Call site of the first call.
+    uint32_t calls;         // Number of calls.
+    uint32_t min_cycles;    // Shortest call (inclusive).
+    uint32_t max_cycles;    // Longest call (inclusive).
+    uint32_t reserved;
+    uint64_t total_cycles;  // Total cycles spent in the function including its callees.
+    uint64_t self_cycles;   // Total cycles spent in the function excluding its callees.
+} profiler_record_t;
+
+void profiler_init();
+void profiler_reset();
+void profiler_pause(bool pause);
+uint32_t profiler_record_count();
+const profiler_record_t *profiler_get_records();
+#endif // __PROFILER_H__
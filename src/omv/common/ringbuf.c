@@ -6,13 +6,44 @@
  *
  * This work is licensed under the MIT license, see the file LICENSE for details.
  *
- * Simple Ring Buffer implementation.
+ * Single-producer single-consumer ring buffer.
  */
 #include <string.h>
+#include "omv_common.h"
 #include "ringbuf.h"
 
-void ring_buf_init(ring_buf_t *buf) {
-    memset(buf, 0, sizeof(*buf));
+// Make sure the data is written before the index is published, and that the index
+// is read before the data.
+#define RING_BUF_RELEASE()  __atomic_thread_fence(__ATOMIC_RELEASE)
+#define RING_BUF_ACQUIRE()  __atomic_thread_fence(__ATOMIC_ACQUIRE)
+
+bool ring_buf_init(ring_buf_t *buf, uint8_t *data, uint32_t size) {
+    if ((!size) || (size & (size - 1))) {
+        return false;
+    }
+
+    buf->head = 0;
+    buf->tail = 0;
+    buf->mask = size - 1;
+    buf->data = data;
+    return true;
+}
+
+void ring_buf_reset(ring_buf_t *buf) {
+    buf->head = 0;
+    buf->tail = 0;
+}
+
+uint32_t ring_buf_size(ring_buf_t *buf) {
+    return buf->mask + 1;
+}
+
+uint32_t ring_buf_avail(ring_buf_t *buf) {
+    return buf->tail - buf->head;
+}
+
+uint32_t ring_buf_free(ring_buf_t *buf) {
+    return ring_buf_size(buf) - ring_buf_avail(buf);
 }
 
 int ring_buf_empty(ring_buf_t *buf) {
@@ -20,23 +51,85 @@ int ring_buf_empty(ring_buf_t *buf) {
 }
 
 void ring_buf_put(ring_buf_t *buf, uint8_t c) {
-    if ((buf->tail + 1) % BUFFER_SIZE == buf->head) {
+    if (!ring_buf_free(buf)) {
         /*buffer is full*/
         return;
     }
 
-    buf->data[buf->tail] = c;
-    buf->tail = (buf->tail + 1) % BUFFER_SIZE;
+    buf->data[buf->tail & buf->mask] = c;
+    RING_BUF_RELEASE();
+    buf->tail++;
 }
 
 uint8_t ring_buf_get(ring_buf_t *buf) {
-    uint8_t c;
-    if (buf->head == buf->tail) {
+    if (ring_buf_empty(buf)) {
         /*buffer is empty*/
         return 0;
     }
 
-    c = buf->data[buf->head];
-    buf->head = (buf->head + 1) % BUFFER_SIZE;
+    RING_BUF_ACQUIRE();
+    uint8_t c = buf->data[buf->head & buf->mask];
+    RING_BUF_RELEASE();
+    buf->head++;
     return c;
 }
+
+uint8_t *ring_buf_acquire_write_span(ring_buf_t *buf, uint32_t *len) {
+    uint32_t offset = buf->tail & buf->mask;
+    // Free space up to the end of the buffer.
+    *len = OMV_MIN(ring_buf_free(buf), ring_buf_size(buf) - offset);
+    RING_BUF_ACQUIRE();
+    return buf->data + offset;
+}
+
+void ring_buf_commit(ring_buf_t *buf, uint32_t len) {
+    RING_BUF_RELEASE();
+    buf->tail += len;
+}
+
+const uint8_t *ring_buf_acquire_read_span(ring_buf_t *buf, uint32_t *len) {
+    uint32_t offset = buf->head & buf->mask;
+    // Data up to the end of the buffer.
+    *len = OMV_MIN(ring_buf_avail(buf), ring_buf_size(buf) - offset);
+    RING_BUF_ACQUIRE();
+    return buf->data + offset;
+}
+
+void ring_buf_release(ring_buf_t *buf, uint32_t len) {
+    RING_BUF_RELEASE();
+    buf->head += len;
+}
+
+uint32_t ring_buf_write(ring_buf_t *buf, const void *src, uint32_t len) {
+    uint32_t bytes = 0;
+    // At most two spans, before and after the wrap point.
+    for (int i = 0; (i < 2) && (bytes < len); i++) {
+        uint32_t size;
+        uint8_t *span = ring_buf_acquire_write_span(buf, &size);
+        if (!size) {
+            break;
+        }
+        size = OMV_MIN(size, len - bytes);
+        memcpy(span, ((const uint8_t *) src) + bytes, size);
+        ring_buf_commit(buf, size);
+        bytes += size;
+    }
+    return bytes;
+}
+
+uint32_t ring_buf_read(ring_buf_t *buf, void *dst, uint32_t len) {
+    uint32_t bytes = 0;
+    // At most two spans, before and after the wrap point.
+    for (int i = 0; (i < 2) && (bytes < len); i++) {
+        uint32_t size;
+        const uint8_t *span = ring_buf_acquire_read_span(buf, &size);
+        if (!size) {
+            break;
+        }
+        size = OMV_MIN(size, len - bytes);
+        memcpy(((uint8_t *) dst) + bytes, span, size);
+        ring_buf_release(buf, size);
+        bytes += size;
+    }
+    return bytes;
+}
@@ -6,21 +6,43 @@
  *
  * This work is licensed under the MIT license, see the file LICENSE for details.
  *
- * Simple Ring Buffer implementation.
+ * Single-producer single-consumer ring buffer.
+ *
+ * The buffer size must be a power of two. The head and tail indices are free-running and only
+ * masked on access, so the full buffer can be used and each index is written by one side only.
+ * Besides the byte and bulk copy functions, the span functions return a pointer to contiguous
+ * memory inside the buffer that can be handed directly to a DMA or a USB endpoint, and then
+ * committed or released once the transfer is done.
  */
 #ifndef __RING_BUFFER_H__
 #define __RING_BUFFER_H__
 #include <stdint.h>
-#define BUFFER_SIZE    (1024)
+#include <stdbool.h>
 
 typedef struct ring_buffer {
-    volatile uint32_t head;
-    volatile uint32_t tail;
-    uint8_t data[BUFFER_SIZE];
+    volatile uint32_t head; // Read index, only written by the consumer.
+    volatile uint32_t tail; // Write index, only written by the producer.
+    uint32_t mask;
+    uint8_t *data;
 } ring_buf_t;
 
-void ring_buf_init(ring_buf_t *buf);
+// Static initializer, size must be a power of two.
+#define RING_BUF_INIT(buf, size)    { 0, 0, (size) - 1, (buf) }
+
+bool ring_buf_init(ring_buf_t *buf, uint8_t *data, uint32_t size);
+void ring_buf_reset(ring_buf_t *buf);
+uint32_t ring_buf_size(ring_buf_t *buf);
+uint32_t ring_buf_avail(ring_buf_t *buf);
+uint32_t ring_buf_free(ring_buf_t *buf);
 int ring_buf_empty(ring_buf_t *buf);
 void ring_buf_put(ring_buf_t *buf, uint8_t c);
 uint8_t ring_buf_get(ring_buf_t *buf);
+uint32_t ring_buf_write(ring_buf_t *buf, const void *src, uint32_t len);
+uint32_t ring_buf_read(ring_buf_t *buf, void *dst, uint32_t len);
+// Producer side: returns the contiguous free space at the tail, fill it then commit it.
+uint8_t *ring_buf_acquire_write_span(ring_buf_t *buf, uint32_t *len);
+void ring_buf_commit(ring_buf_t *buf, uint32_t len);
+// Consumer side: returns the contiguous data at the head, consume it then release it.
+const uint8_t *ring_buf_acquire_read_span(ring_buf_t *buf, uint32_t *len);
+void ring_buf_release(ring_buf_t *buf, uint32_t len);
 #endif /* __RING_BUFFER_H__ */
@@ -173,6 +173,7 @@ typedef enum {
     IOCTL_HIMAX_MD_WINDOW,
     IOCTL_HIMAX_MD_THRESHOLD,
     IOCTL_HIMAX_OSC_ENABLE,
+    IOCTL_HIMAX_MD_LOW_POWER,
 } ioctl_t;
 
 typedef enum {
@@ -197,8 +198,14 @@ typedef enum {
     SENSOR_ERROR_FRAMEBUFFER_ERROR     = -18,
     SENSOR_ERROR_FRAMEBUFFER_OVERFLOW  = -19,
     SENSOR_ERROR_JPEG_OVERFLOW         = -20,
+    SENSOR_ERROR_WOULD_BLOCK           = -21,
 } sensor_error_t;
 
+typedef enum {
+    SENSOR_SNAPSHOT_NO_FLAGS    = (0 << 0),
+    SENSOR_SNAPSHOT_NONBLOCKING = (1 << 0), // Return SENSOR_ERROR_WOULD_BLOCK if no frame is ready.
+} sensor_snapshot_flags_t;
+
 typedef enum {
     SENSOR_CONFIG_INIT      = (1 << 0),
     SENSOR_CONFIG_FRAMESIZE = (1 << 1),
@@ -206,8 +213,20 @@ typedef enum {
     SENSOR_CONFIG_WINDOWING = (1 << 3),
 } sensor_config_t;
 
+// Sensor probe result, cached across resets to skip the bus scan on boot.
+typedef struct _sensor_probe_cache {
+    uint16_t chip_id;           // Detected sensor ID.
+    uint8_t slv_addr;           // Sensor I2C slave address.
+    uint8_t bus_id;             // Sensor I2C bus.
+    uint32_t xclk_freq;         // Working xclk freq in hz.
+    uint8_t reset_pol;          // Reset polarity.
+    uint8_t power_pol;          // Power-down polarity.
+    uint16_t reserved;
+} sensor_probe_cache_t;
+
 typedef void (*vsync_cb_t) (uint32_t vsync);
 typedef void (*frame_cb_t) ();
+typedef void (*line_cb_t) (uint8_t *data, uint32_t line, uint32_t lines, void *arg);
 
 typedef struct _sensor sensor_t;
 typedef struct _sensor {
@@ -238,9 +257,15 @@ typedef struct _sensor {
     const uint16_t *color_palette;    // Color palette used for color lookup.
     bool disable_delays;        // Set to true to disable all sensor settling time delays.
     bool disable_full_flush;    // Turn off default frame buffer flush policy when full.
+    int jpeg_capture;           // JPEG quality to compress frames with while capturing (0 = off).
+    bool auto_quality;          // Adjust the quality of sensor JPEG frames so they fit the buffers.
+    int quality;                // Last quantization scale set with sensor_set_quality() (0 = unknown).
 
     vsync_cb_t vsync_callback;  // VSYNC callback.
     frame_cb_t frame_callback;  // Frame callback.
+    line_cb_t line_callback;    // Line/strip callback.
+    void *line_callback_arg;    // Line callback argument.
+    uint32_t line_callback_lines; // Number of lines per line callback.
 
     // Sensor state
     sde_t sde;                  // Special digital effects
@@ -251,12 +276,23 @@ typedef struct _sensor {
     bool drop_frame;            // Set to true to drop the current frame.
     uint32_t last_frame_ms;     // Last sampled frame timestamp in milliseconds.
     bool last_frame_ms_valid;   // Last sampled frame timestamp in milliseconds valid.
+    uint32_t last_frame_us;     // Start of the last frame read in microseconds, 0 if not valid.
+    uint32_t frame_period_us;   // Measured period of the frames output by the sensor.
+    int frame_skip;             // Frames skipped by the capture hardware after each frame read.
+    uint32_t frames_captured;   // Frames read and kept.
+    uint32_t frames_dropped;    // Frames read and dropped to match the frame rate.
+    uint32_t frames_skipped;    // Frames skipped by the capture hardware, never read.
     gainceiling_t gainceiling;  // AGC gainceiling
     bool hmirror;               // Horizontal Mirror
     bool vflip;                 // Vertical Flip
+    bool hmirror_copy;          // Horizontal Mirror done by the line copy (no sensor control).
+    bool vflip_copy;            // Vertical Flip done by the line copy (no sensor control).
     bool transpose;             // Transpose Image
     bool auto_rotation;         // Rotate Image Automatically
     bool detected;              // Set to true when the sensor is initialized.
+    bool hw_window;             // Set to true when the sensor outputs the window only.
+    bool ext_trigger;           // Set to true when exposures are started by the trigger input.
+    volatile uint32_t trigger_us; // Timestamp (mp_hal_ticks_us) of the last trigger.
 
     omv_i2c_t i2c_bus;          // SCCB/I2C bus.
 
@@ -267,6 +303,7 @@ typedef struct _sensor {
     int (*write_reg) (sensor_t *sensor, uint16_t reg_addr, uint16_t reg_data);
     int (*set_pixformat) (sensor_t *sensor, pixformat_t pixformat);
     int (*set_framesize) (sensor_t *sensor, framesize_t framesize);
+    int (*set_windowing) (sensor_t *sensor, int x, int y, int w, int h);
     int (*set_framerate) (sensor_t *sensor, int framerate);
     int (*set_contrast) (sensor_t *sensor, int level);
     int (*set_brightness) (sensor_t *sensor, int level);
@@ -304,6 +341,11 @@ int sensor_init();
 // Detect and initialize the image sensor.
 int sensor_probe_init(uint32_t bus_id, uint32_t bus_speed);
 
+// Load/store the cached probe result. Ports that can keep a record across resets
+// (backup registers, flash etc..) override these, by default nothing is cached.
+bool sensor_probe_cache_load(sensor_probe_cache_t *cache);
+void sensor_probe_cache_store(const sensor_probe_cache_t *cache);
+
 // This function is called after a setting that may require reconfiguring
 // the hardware changes, such as window size, frame size, or pixel format.
 int sensor_config(sensor_config_t config);
@@ -359,6 +401,10 @@ bool sensor_get_cropped();
 // Set window size.
 int sensor_set_windowing(int x, int y, int w, int h);
 
+// Move the window without changing its size. Captured frames are kept and, where the port
+// supports it, the new position takes effect from the next frame without stopping the capture.
+int sensor_move_windowing(int x, int y);
+
 // Set the sensor contrast level (from -3 to +3).
 int sensor_set_contrast(int level);
 
@@ -420,6 +466,22 @@ int sensor_set_transpose(bool enable);
 // Get transpose mode state.
 bool sensor_get_transpose();
 
+// Enable/disable adjusting the quantization scale of sensor JPEG frames so that they don't
+// overflow, the frame buffers are also split to use all of the frame buffer memory.
+int sensor_set_auto_quality(bool enable);
+
+// Get the auto quality state.
+bool sensor_get_auto_quality();
+
+// Updates the auto quality control with the size of the last sensor JPEG frame, or an overflow.
+void sensor_auto_quality_update(uint32_t size, bool overflow);
+
+// Set the JPEG quality used to compress frames in hardware while they are captured (0 = off).
+int sensor_set_jpeg_capture(int quality);
+
+// Get the JPEG capture quality.
+int sensor_get_jpeg_capture();
+
 // Enable/disable the auto rotation mode.
 int sensor_set_auto_rotation(bool enable);
 
@@ -432,6 +494,10 @@ int sensor_set_framebuffers(int count);
 // Drop the next frame to match the current frame rate.
 void sensor_throttle_framerate();
 
+// Returns the number of frames the capture hardware can skip after each frame read (0, 1 or 3)
+// to match the frame rate, so the frames that would be dropped are never transferred.
+int sensor_get_frame_skip();
+
 // Set special digital effects (SDE).
 int sensor_set_special_effect(sde_t sde);
 
@@ -447,6 +513,21 @@ int sensor_set_vsync_callback(vsync_cb_t vsync_cb);
 // Set frame callback function.
 int sensor_set_frame_callback(frame_cb_t vsync_cb);
 
+// Set a callback that's called from the capture IRQ with each strip of `lines` lines, as soon
+// as they are written to the frame buffer, so row-wise kernels run while the frame arrives.
+// The last strip of the frame may be shorter. Not called in transpose and JPEG modes.
+int sensor_set_line_callback(line_cb_t line_cb, uint32_t lines, void *arg);
+
+// Start an exposure on each rising edge of the trigger input instead of on each snapshot. The
+// frames are queued into the frame buffers by the capture IRQs, tagged with the trigger time.
+// The sensor must be in triggered mode, see IOCTL_SET_TRIGGERED_MODE.
+int sensor_set_ext_trigger(bool enable);
+
+// Stop the capture, put the sensor in its low-power motion detection mode and sleep until the
+// sensor's motion interrupt fires or timeout_ms expires (0 waits forever). The sensor is back in
+// its normal mode on return. Returns SENSOR_ERROR_CAPTURE_TIMEOUT if there was no motion.
+int sensor_wait_motion(uint32_t timeout_ms);
+
 // Set color palette
 int sensor_set_color_palette(const uint16_t *color_palette);
 
@@ -48,6 +48,21 @@
 #define OMV_CSI_POWER_DELAY (10)
 #endif
 
+#ifndef OMV_CSI_HW_WINDOWING_ENABLE
+#define OMV_CSI_HW_WINDOWING_ENABLE (0)
+#endif
+
+#ifndef OMV_CSI_LINE_FLIP_ENABLE
+#define OMV_CSI_LINE_FLIP_ENABLE (0)
+#endif
+
+// Sensor JPEG frames are kept between these percentages of the buffer size.
+#define SENSOR_AUTO_QUALITY_HIGH    (75)
+#define SENSOR_AUTO_QUALITY_LOW     (50)
+#define SENSOR_AUTO_QUALITY_QS_MIN  (4)
+#define SENSOR_AUTO_QUALITY_QS_MAX  (255)
+#define SENSOR_AUTO_QUALITY_QS_INIT (16)
+
 #ifndef __weak
 #define __weak    __attribute__((weak))
 #endif
@@ -119,6 +134,9 @@ __weak int sensor_reset() {
     // Disable any ongoing frame capture.
     sensor_abort(true, false);
 
+    // Disable the external trigger.
+    sensor_set_ext_trigger(false);
+
     // Reset the sensor state
     sensor.sde = 0;
     sensor.pixformat = 0;
@@ -128,10 +146,19 @@ __weak int sensor_reset() {
     sensor.drop_frame = false;
     sensor.last_frame_ms = 0;
     sensor.last_frame_ms_valid = false;
+    sensor.last_frame_us = 0;
+    sensor.frame_period_us = 0;
+    sensor.frame_skip = 0;
+    sensor.frames_captured = 0;
+    sensor.frames_dropped = 0;
+    sensor.frames_skipped = 0;
     sensor.gainceiling = 0;
     sensor.hmirror = false;
     sensor.vflip = false;
+    sensor.hmirror_copy = false;
+    sensor.vflip_copy = false;
     sensor.transpose = false;
+    sensor.hw_window = false;
     #if MICROPY_PY_IMU
     sensor.auto_rotation = (sensor.chip_id == OV7690_ID);
     #else
@@ -139,11 +166,15 @@ __weak int sensor_reset() {
     #endif // MICROPY_PY_IMU
     sensor.vsync_callback = NULL;
     sensor.frame_callback = NULL;
+    sensor.line_callback = NULL;
 
     // Reset default color palette.
     sensor.color_palette = rainbow_table;
 
     sensor.disable_full_flush = false;
+    sensor.jpeg_capture = 0;
+    sensor.auto_quality = false;
+    sensor.quality = 0;
 
     // Restore shutdown state on reset.
     sensor_shutdown(false);
@@ -181,82 +212,129 @@ __weak int sensor_reset() {
     return 0;
 }
 
+// Reads the chip ID of a supported sensor at this address, returns the address or 0.
+static int sensor_detect_addr(uint8_t slv_addr) {
+    switch (slv_addr) {
+        #if (OMV_OV2640_ENABLE == 1)
+        case OV2640_SLV_ADDR: // Or OV9650.
+            omv_i2c_readb(&sensor.i2c_bus, slv_addr, OV_CHIP_ID, &sensor.chip_id);
+            return slv_addr;
+        #endif // (OMV_OV2640_ENABLE == 1)
+
+        #if (OMV_OV5640_ENABLE == 1) || (OMV_GC2145_ENABLE == 1)
+        // OV5640 and GC2145 share the same I2C address
+        case OV5640_SLV_ADDR:   // Or GC2145
+            // Try to read GC2145 chip ID first
+            omv_i2c_readb(&sensor.i2c_bus, slv_addr, GC_CHIP_ID, &sensor.chip_id);
+            if (sensor.chip_id != GC2145_ID) {
+                // If it fails, try reading OV5640 chip ID.
+                omv_i2c_readb2(&sensor.i2c_bus, slv_addr, OV5640_CHIP_ID, &sensor.chip_id);
+            }
+            return slv_addr;
+        #endif // (OMV_OV5640_ENABLE == 1) || (OMV_GC2145_ENABLE == 1)
+
+        #if (OMV_OV7725_ENABLE == 1) || (OMV_OV7670_ENABLE == 1) || (OMV_OV7690_ENABLE == 1)
+        case OV7725_SLV_ADDR: // Or OV7690 or OV7670.
+            omv_i2c_readb(&sensor.i2c_bus, slv_addr, OV_CHIP_ID, &sensor.chip_id);
+            return slv_addr;
+        #endif //(OMV_OV7725_ENABLE == 1) || (OMV_OV7670_ENABLE == 1) || (OMV_OV7690_ENABLE == 1)
+
+        #if (OMV_MT9V0XX_ENABLE == 1)
+        case MT9V0XX_SLV_ADDR:
+            omv_i2c_readw(&sensor.i2c_bus, slv_addr, ON_CHIP_ID, &sensor.chip_id_w);
+            return slv_addr;
+        #endif //(OMV_MT9V0XX_ENABLE == 1)
+
+        #if (OMV_MT9M114_ENABLE == 1)
+        case MT9M114_SLV_ADDR:
+            omv_i2c_readw2(&sensor.i2c_bus, slv_addr, ON_CHIP_ID, &sensor.chip_id_w);
+            return slv_addr;
+        #endif // (OMV_MT9M114_ENABLE == 1)
+
+        #if (OMV_LEPTON_ENABLE == 1)
+        case LEPTON_SLV_ADDR:
+            sensor.chip_id = LEPTON_ID;
+            return slv_addr;
+        #endif // (OMV_LEPTON_ENABLE == 1)
+
+        #if (OMV_HM01B0_ENABLE == 1) || (OMV_HM0360_ENABLE == 1)
+        case HM0XX0_SLV_ADDR:
+            omv_i2c_readb2(&sensor.i2c_bus, slv_addr, HIMAX_CHIP_ID, &sensor.chip_id);
+            return slv_addr;
+        #endif // (OMV_HM01B0_ENABLE == 1) || (OMV_HM0360_ENABLE == 1)
+
+        #if (OMV_FROGEYE2020_ENABLE == 1)
+        case FROGEYE2020_SLV_ADDR:
+            sensor.chip_id_w = FROGEYE2020_ID;
+            return slv_addr;
+        #endif // (OMV_FROGEYE2020_ENABLE == 1)
+
+        #if (OMV_PAG7920_ENABLE == 1)
+        case PAG7920_SLV_ADDR:
+            omv_i2c_readw(&sensor.i2c_bus, slv_addr, ON_CHIP_ID, &sensor.chip_id_w);
+            sensor.chip_id_w = (sensor.chip_id_w << 8) | (sensor.chip_id_w >> 8);
+            return slv_addr;
+        #endif // (OMV_PAG7920_ENABLE == 1)
+    }
+
+    return 0;
+}
+
 static int sensor_detect() {
     uint8_t devs_list[OMV_CSI_MAX_DEVICES];
     int n_devs = omv_i2c_scan(&sensor.i2c_bus, devs_list, OMV_ARRAY_SIZE(devs_list));
 
     for (int i = 0; i < OMV_MIN(n_devs, OMV_CSI_MAX_DEVICES); i++) {
-        uint8_t slv_addr = devs_list[i];
-        switch (slv_addr) {
-            #if (OMV_OV2640_ENABLE == 1)
-            case OV2640_SLV_ADDR: // Or OV9650.
-                omv_i2c_readb(&sensor.i2c_bus, slv_addr, OV_CHIP_ID, &sensor.chip_id);
-                return slv_addr;
-            #endif // (OMV_OV2640_ENABLE == 1)
-
-            #if (OMV_OV5640_ENABLE == 1) || (OMV_GC2145_ENABLE == 1)
-            // OV5640 and GC2145 share the same I2C address
-            case OV5640_SLV_ADDR:   // Or GC2145
-                // Try to read GC2145 chip ID first
-                omv_i2c_readb(&sensor.i2c_bus, slv_addr, GC_CHIP_ID, &sensor.chip_id);
-                if (sensor.chip_id != GC2145_ID) {
-                    // If it fails, try reading OV5640 chip ID.
-                    omv_i2c_readb2(&sensor.i2c_bus, slv_addr, OV5640_CHIP_ID, &sensor.chip_id);
-                }
-                return slv_addr;
-            #endif // (OMV_OV5640_ENABLE == 1) || (OMV_GC2145_ENABLE == 1)
-
-            #if (OMV_OV7725_ENABLE == 1) || (OMV_OV7670_ENABLE == 1) || (OMV_OV7690_ENABLE == 1)
-            case OV7725_SLV_ADDR: // Or OV7690 or OV7670.
-                omv_i2c_readb(&sensor.i2c_bus, slv_addr, OV_CHIP_ID, &sensor.chip_id);
-                return slv_addr;
-            #endif //(OMV_OV7725_ENABLE == 1) || (OMV_OV7670_ENABLE == 1) || (OMV_OV7690_ENABLE == 1)
-
-            #if (OMV_MT9V0XX_ENABLE == 1)
-            case MT9V0XX_SLV_ADDR:
-                omv_i2c_readw(&sensor.i2c_bus, slv_addr, ON_CHIP_ID, &sensor.chip_id_w);
-                return slv_addr;
-            #endif //(OMV_MT9V0XX_ENABLE == 1)
-
-            #if (OMV_MT9M114_ENABLE == 1)
-            case MT9M114_SLV_ADDR:
-                omv_i2c_readw2(&sensor.i2c_bus, slv_addr, ON_CHIP_ID, &sensor.chip_id_w);
-                return slv_addr;
-            #endif // (OMV_MT9M114_ENABLE == 1)
-
-            #if (OMV_LEPTON_ENABLE == 1)
-            case LEPTON_SLV_ADDR:
-                sensor.chip_id = LEPTON_ID;
-                return slv_addr;
-            #endif // (OMV_LEPTON_ENABLE == 1)
-
-            #if (OMV_HM01B0_ENABLE == 1) || (OMV_HM0360_ENABLE == 1)
-            case HM0XX0_SLV_ADDR:
-                omv_i2c_readb2(&sensor.i2c_bus, slv_addr, HIMAX_CHIP_ID, &sensor.chip_id);
-                return slv_addr;
-            #endif // (OMV_HM01B0_ENABLE == 1) || (OMV_HM0360_ENABLE == 1)
-
-            #if (OMV_FROGEYE2020_ENABLE == 1)
-            case FROGEYE2020_SLV_ADDR:
-                sensor.chip_id_w = FROGEYE2020_ID;
-                return slv_addr;
-            #endif // (OMV_FROGEYE2020_ENABLE == 1)
-
-            #if (OMV_PAG7920_ENABLE == 1)
-            case PAG7920_SLV_ADDR:
-                omv_i2c_readw(&sensor.i2c_bus, slv_addr, ON_CHIP_ID, &sensor.chip_id_w);
-                sensor.chip_id_w = (sensor.chip_id_w << 8) | (sensor.chip_id_w >> 8);
-                return slv_addr;
-            #endif // (OMV_PAG7920_ENABLE == 1)
+        if (sensor_detect_addr(devs_list[i])) {
+            return devs_list[i];
         }
     }
 
     return 0;
 }
 
-int sensor_probe_init(uint32_t bus_id, uint32_t bus_speed) {
-    int init_ret = 0;
+__weak bool sensor_probe_cache_load(sensor_probe_cache_t *cache) {
+    return false;
+}
 
+__weak void sensor_probe_cache_store(const sensor_probe_cache_t *cache) {
+}
+
+// Powers up the sensor with the cached polarities and checks the cached chip ID, which
+// skips the power cycle, the bus scan and the polarity retries of the full probe.
+static bool sensor_probe_cached(const sensor_probe_cache_t *cache, uint32_t bus_id, uint32_t bus_speed) {
+    #if defined(OMV_CSI_POWER_PIN)
+    sensor.power_pol = cache->power_pol;
+    omv_gpio_write(OMV_CSI_POWER_PIN, (sensor.power_pol == ACTIVE_HIGH) ? 0 : 1);
+    mp_hal_delay_ms(OMV_CSI_POWER_DELAY);
+    #endif
+
+    #if defined(OMV_CSI_RESET_PIN)
+    sensor.reset_pol = cache->reset_pol;
+    omv_gpio_write(OMV_CSI_RESET_PIN, (sensor.reset_pol == ACTIVE_HIGH) ? 0 : 1);
+    mp_hal_delay_ms(OMV_CSI_RESET_DELAY);
+    #endif
+
+    if (cache->xclk_freq) {
+        sensor_set_xclk_frequency(cache->xclk_freq);
+    }
+
+    // Initialize the camera bus.
+    omv_i2c_init(&sensor.i2c_bus, bus_id, bus_speed);
+    mp_hal_delay_ms(10);
+
+    sensor.chip_id_w = 0;
+    if (sensor_detect_addr(cache->slv_addr) && (sensor.chip_id_w == cache->chip_id)) {
+        sensor.slv_addr = cache->slv_addr;
+        return true;
+    }
+
+    // The record is stale, fallback to the full probe.
+    omv_i2c_deinit(&sensor.i2c_bus);
+    return false;
+}
+
+static int sensor_probe(uint32_t bus_id, uint32_t bus_speed) {
     #if defined(OMV_CSI_POWER_PIN)
     sensor.power_pol = ACTIVE_HIGH;
     // Do a power cycle
@@ -325,6 +403,25 @@ int sensor_probe_init(uint32_t bus_id, uint32_t bus_speed) {
         }
     }
 
+    return 0;
+}
+
+int sensor_probe_init(uint32_t bus_id, uint32_t bus_speed) {
+    int init_ret = 0;
+    sensor_probe_cache_t cache;
+
+    // Try the sensor detected on the last boot first.
+    bool cached = sensor_probe_cache_load(&cache)
+                  && (cache.bus_id == bus_id)
+                  && sensor_probe_cached(&cache, bus_id, bus_speed);
+
+    if (!cached && ((init_ret = sensor_probe(bus_id, bus_speed)) != 0)) {
+        return init_ret;
+    }
+
+    // Save the detected ID, some drivers change it below.
+    uint16_t chip_id = sensor.chip_id_w;
+
     // A supported sensor was detected, try to initialize it.
     switch (sensor.chip_id_w) {
         #if (OMV_OV2640_ENABLE == 1)
@@ -479,6 +576,24 @@ int sensor_probe_init(uint32_t bus_id, uint32_t bus_speed) {
         return SENSOR_ERROR_ISC_INIT_FAILED;
     }
 
+    // Cache the probe result for the next boot (I2C sensors only).
+    if (sensor.slv_addr) {
+        int32_t xclk_freq = sensor_get_xclk_frequency();
+        sensor_probe_cache_t new_cache = {
+            .chip_id = chip_id,
+            .slv_addr = sensor.slv_addr,
+            .bus_id = bus_id,
+            .xclk_freq = (xclk_freq > 0) ? xclk_freq : 0,
+            .reset_pol = sensor.reset_pol,
+            .power_pol = sensor.power_pol,
+            .reserved = 0,
+        };
+
+        if (!cached || memcmp(&new_cache, &cache, sizeof(cache))) {
+            sensor_probe_cache_store(&new_cache);
+        }
+    }
+
     return 0;
 }
 
@@ -593,9 +708,10 @@ __weak int sensor_set_pixformat(pixformat_t pixformat) {
         return 0;
     }
 
-    // Cropping and transposing (and thus auto rotation) don't work in JPEG mode.
-    if (((pixformat == PIXFORMAT_YUV422) && (sensor.transpose || sensor.auto_rotation)) ||
-        ((pixformat == PIXFORMAT_JPEG) && (sensor_get_cropped() || sensor.transpose || sensor.auto_rotation))) {
+    // Cropping, transposing (and thus auto rotation) and flipping lines don't work in JPEG mode.
+    bool line_flip = sensor.hmirror_copy || sensor.vflip_copy;
+    if (((pixformat == PIXFORMAT_YUV422) && (sensor.transpose || sensor.auto_rotation || line_flip)) ||
+        ((pixformat == PIXFORMAT_JPEG) && (sensor_get_cropped() || sensor.transpose || sensor.auto_rotation || line_flip))) {
         return SENSOR_ERROR_PIXFORMAT_UNSUPPORTED;
     }
 
@@ -659,6 +775,7 @@ __weak int sensor_set_framesize(framesize_t framesize) {
 
     // Set framebuffer size
     sensor.framesize = framesize;
+    sensor.hw_window = false;
 
     // Set x and y offsets.
     MAIN_FB()->x = 0;
@@ -704,21 +821,44 @@ __weak void sensor_throttle_framerate() {
     if (!sensor.first_line) {
         sensor.first_line = true;
         uint32_t tick = mp_hal_ticks_ms();
+        uint32_t tick_us = mp_hal_ticks_us();
         uint32_t framerate_ms = IM_DIV(1000, sensor.framerate);
 
+        // Measure the sensor frame period, the frames skipped by the hardware are not seen.
+        if (sensor.last_frame_us) {
+            sensor.frame_period_us = (tick_us - sensor.last_frame_us) / (sensor.frame_skip + 1);
+        }
+        sensor.last_frame_us = tick_us ? tick_us : 1;
+        sensor.frames_skipped += sensor.frame_skip;
+
         if (sensor.last_frame_ms_valid && ((tick - sensor.last_frame_ms) < framerate_ms)) {
             // Drop the current frame to match the requested frame rate. Note that if the frame
             // is marked to be dropped, it should not be copied to SRAM/SDRAM to save CPU time.
             sensor.drop_frame = true;
+            sensor.frames_dropped += 1;
+            return;
         } else if (sensor.last_frame_ms_valid) {
             sensor.last_frame_ms += framerate_ms;
         } else {
             sensor.last_frame_ms = tick;
             sensor.last_frame_ms_valid = true;
         }
+
+        sensor.frames_captured += 1;
     }
 }
 
+int sensor_get_frame_skip() {
+    if (!sensor.framerate || !sensor.frame_period_us) {
+        return 0;
+    }
+
+    // Frames output by the sensor per frame wanted, rounded up by a small margin so that the
+    // skip doesn't flip when the frame rate is exactly 1/2 or 1/4 of the sensor frame rate.
+    uint32_t n = (IM_DIV(1000000, sensor.framerate) + (sensor.frame_period_us / 32)) / sensor.frame_period_us;
+    return (n >= 4) ? 3 : ((n >= 2) ? 1 : 0);
+}
+
 __weak bool sensor_get_cropped() {
     if (sensor.framesize != FRAMESIZE_INVALID) {
         return (MAIN_FB()->x != 0) ||
@@ -789,6 +929,12 @@ __weak int sensor_set_windowing(int x, int y, int w, int h) {
     // Reset pixel format to skip the first frame.
     MAIN_FB()->pixfmt = PIXFORMAT_INVALID;
 
+    #if (OMV_CSI_HW_WINDOWING_ENABLE == 1)
+    // Let the sensor output the window only if it can, so the cropped pixels are never
+    // transferred. Otherwise, the full frame is received and cropped by the CSI driver.
+    sensor.hw_window = (sensor.set_windowing != NULL) && (sensor.set_windowing(&sensor, x, y, w, h) == 0);
+    #endif
+
     // Auto-adjust the number of frame buffers.
     sensor_set_framebuffers(-1);
 
@@ -796,6 +942,21 @@ __weak int sensor_set_windowing(int x, int y, int w, int h) {
     return sensor_config(SENSOR_CONFIG_WINDOWING);
 }
 
+__weak int sensor_move_windowing(int x, int y) {
+    if (sensor.framesize == FRAMESIZE_INVALID) {
+        return SENSOR_ERROR_INVALID_FRAMESIZE;
+    }
+
+    if ((x < 0) || (y < 0) ||
+        ((x + MAIN_FB()->u) > resolution[sensor.framesize][0]) ||
+        ((y + MAIN_FB()->v) > resolution[sensor.framesize][1])) {
+        return SENSOR_ERROR_INVALID_WINDOW;
+    }
+
+    // Without a fast path the window is reconfigured.
+    return sensor_set_windowing(x, y, MAIN_FB()->u, MAIN_FB()->v);
+}
+
 __weak int sensor_set_contrast(int level) {
     // Check if the control is supported.
     if (sensor.set_contrast == NULL) {
@@ -871,9 +1032,66 @@ __weak int sensor_set_quality(int qs) {
         return SENSOR_ERROR_CTL_FAILED;
     }
 
+    // Set the new control value.
+    sensor.quality = qs;
+
+    return 0;
+}
+
+__weak int sensor_set_auto_quality(bool enable) {
+    // Check if the value has changed.
+    if (sensor.auto_quality == enable) {
+        return 0;
+    }
+
+    // Check if the control is supported.
+    if (sensor.set_quality == NULL) {
+        return SENSOR_ERROR_CTL_UNSUPPORTED;
+    }
+
+    // Set the new control value.
+    sensor.auto_quality = enable;
+
+    // Resize the frame buffers if needed.
+    if ((sensor.pixformat == PIXFORMAT_JPEG) && (sensor.framesize != FRAMESIZE_INVALID)) {
+        return sensor_set_framebuffers(framebuffer->n_buffers);
+    }
+
     return 0;
 }
 
+__weak bool sensor_get_auto_quality() {
+    return sensor.auto_quality;
+}
+
+void sensor_auto_quality_update(uint32_t size, bool overflow) {
+    // The size is unknown if 0.
+    if ((!sensor.auto_quality) || (sensor.pixformat != PIXFORMAT_JPEG) || ((!size) && (!overflow))) {
+        return;
+    }
+
+    // The JPEG size is about inversely proportional to the quantization scale. Frames over the
+    // high mark raise the scale right away to land back in the middle of the band, while frames
+    // under the low mark lower it slowly so that the quality doesn't oscillate.
+    uint32_t buffer_size = framebuffer_get_buffer_size() / 100;
+    uint32_t target = buffer_size * ((SENSOR_AUTO_QUALITY_HIGH + SENSOR_AUTO_QUALITY_LOW) / 2);
+    int qs = sensor.quality ? sensor.quality : SENSOR_AUTO_QUALITY_QS_INIT;
+
+    if (overflow) {
+        qs *= 2;
+    } else if (size > (buffer_size * SENSOR_AUTO_QUALITY_HIGH)) {
+        qs = (((uint64_t) qs * size) / target) + 1;
+    } else if (size < (buffer_size * SENSOR_AUTO_QUALITY_LOW)) {
+        qs -= IM_MAX(qs / 16, 1);
+    }
+
+    qs = IM_MAX(IM_MIN(qs, SENSOR_AUTO_QUALITY_QS_MAX), SENSOR_AUTO_QUALITY_QS_MIN);
+
+    if (qs != sensor.quality) {
+        sensor_set_quality(qs);
+    }
+}
+
 __weak int sensor_set_colorbar(int enable) {
     // Check if the control is supported.
     if (sensor.set_colorbar == NULL) {
@@ -1011,7 +1229,16 @@ __weak int sensor_set_hmirror(int enable) {
 
     // Check if the control is supported.
     if (sensor.set_hmirror == NULL) {
+        #if (OMV_CSI_LINE_FLIP_ENABLE == 1)
+        // Flip the image while copying lines to the frame buffer instead.
+        if ((sensor.pixformat == PIXFORMAT_YUV422) || (sensor.pixformat == PIXFORMAT_JPEG)) {
+            return SENSOR_ERROR_PIXFORMAT_UNSUPPORTED;
+        }
+        sensor.hmirror = sensor.hmirror_copy = enable;
+        return 0;
+        #else
         return SENSOR_ERROR_CTL_UNSUPPORTED;
+        #endif
     }
 
     // Call the sensor specific function.
@@ -1045,7 +1272,16 @@ __weak int sensor_set_vflip(int enable) {
 
     // Check if the control is supported.
     if (sensor.set_vflip == NULL) {
+        #if (OMV_CSI_LINE_FLIP_ENABLE == 1)
+        // Flip the image while copying lines to the frame buffer instead.
+        if ((sensor.pixformat == PIXFORMAT_YUV422) || (sensor.pixformat == PIXFORMAT_JPEG)) {
+            return SENSOR_ERROR_PIXFORMAT_UNSUPPORTED;
+        }
+        sensor.vflip = sensor.vflip_copy = enable;
+        return 0;
+        #else
         return SENSOR_ERROR_CTL_UNSUPPORTED;
+        #endif
     }
 
     // Call the sensor specific function.
@@ -1091,6 +1327,15 @@ __weak bool sensor_get_transpose() {
     return sensor.transpose;
 }
 
+__weak int sensor_set_jpeg_capture(int quality) {
+    // Compressing frames while capturing needs hardware support.
+    return quality ? SENSOR_ERROR_CTL_UNSUPPORTED : 0;
+}
+
+__weak int sensor_get_jpeg_capture() {
+    return sensor.jpeg_capture;
+}
+
 __weak int sensor_set_auto_rotation(bool enable) {
     // Check if the value has changed.
     if (sensor.auto_rotation == enable) {
@@ -1137,6 +1382,12 @@ __weak int sensor_set_framebuffers(int count) {
     // Otherwise, use the real frame size.
     MAIN_FB()->frame_size = resolution[sensor.framesize][0] * resolution[sensor.framesize][1] * bpp;
     #endif
+    // Sensor JPEG frames with auto quality get all of the frame buffer.
+    if ((sensor.pixformat == PIXFORMAT_JPEG) && sensor.auto_quality) {
+        MAIN_FB()->frame_size = 0;
+    }
+    // A JPEG capture may fill the whole buffer.
+    MAIN_FB()->dma_size = (sensor.pixformat == PIXFORMAT_JPEG) ? 0 : MAIN_FB()->frame_size;
     return framebuffer_set_buffers(count);
 }
 
@@ -1204,6 +1455,26 @@ __weak int sensor_set_frame_callback(frame_cb_t vsync_cb) {
     return 0;
 }
 
+__weak int sensor_set_line_callback(line_cb_t line_cb, uint32_t lines, void *arg) {
+    if (line_cb != NULL) {
+        return SENSOR_ERROR_CTL_UNSUPPORTED;
+    }
+    sensor.line_callback = NULL;
+    return 0;
+}
+
+__weak int sensor_set_ext_trigger(bool enable) {
+    if (enable) {
+        return SENSOR_ERROR_CTL_UNSUPPORTED;
+    }
+    sensor.ext_trigger = false;
+    return 0;
+}
+
+__weak int sensor_wait_motion(uint32_t timeout_ms) {
+    return SENSOR_ERROR_CTL_UNSUPPORTED;
+}
+
 __weak int sensor_set_color_palette(const uint16_t *color_palette) {
     sensor.color_palette = color_palette;
     return 0;
@@ -1307,64 +1578,75 @@ __weak int sensor_auto_crop_framebuffer() {
     return 0;
 }
 
-#define copy_transposed_line(dstp, srcp)                   \
-    for (int i = MAIN_FB()->u, h = MAIN_FB()->v; i; i--) { \
-        *dstp = *srcp++;                                   \
-        dstp += h;                                         \
+// Copies a line to every step-th pixel of the destination, step is negative for mirrored lines.
+#define copy_strided_line(dstp, srcp, step)   \
+    for (int i = MAIN_FB()->u; i; i--) {      \
+        *dstp = *srcp++;                      \
+        dstp += step;                         \
     }
 
-#define copy_transposed_line_rev16(dstp, srcp)             \
-    for (int i = MAIN_FB()->u, h = MAIN_FB()->v; i; i--) { \
-        *dstp = __REV16(*srcp++);                          \
-        dstp += h;                                         \
+#define copy_strided_line_rev16(dstp, srcp, step) \
+    for (int i = MAIN_FB()->u; i; i--) {          \
+        *dstp = __REV16(*srcp++);                 \
+        dstp += step;                             \
     }
 
 __weak int sensor_copy_line(void *dma, uint8_t *src, uint8_t *dst) {
     uint16_t *src16 = (uint16_t *) src;
     uint16_t *dst16 = (uint16_t *) dst;
     #if OMV_CSI_DMA_MEMCPY_ENABLE
-    extern int sensor_dma_memcpy(void *dma, void *dst, void *src, int bpp, bool transposed);
+    extern int sensor_dma_memcpy(void *dma, void *dst, void *src, int bpp, bool transposed, bool reversed);
     #endif
 
+    // Transposed lines are written down a column, mirrored lines are written from their last pixel.
+    bool strided = sensor.transpose || sensor.hmirror_copy;
+    int step = sensor.transpose ? MAIN_FB()->v : 1;
+
+    if (sensor.hmirror_copy) {
+        dst += (MAIN_FB()->u - 1) * step;
+        dst16 += (MAIN_FB()->u - 1) * step;
+        step = -step;
+    }
+
     switch (sensor.pixformat) {
         case PIXFORMAT_BAYER:
             #if OMV_CSI_DMA_MEMCPY_ENABLE
-            if (!sensor_dma_memcpy(dma, dst, src, sizeof(uint8_t), sensor.transpose)) {
+            if (!sensor_dma_memcpy(dma, dst, src, sizeof(uint8_t), sensor.transpose, sensor.hmirror_copy)) {
                 break;
             }
             #endif
-            if (!sensor.transpose) {
+            if (!strided) {
                 unaligned_memcpy(dst, src, MAIN_FB()->u);
             } else {
-                copy_transposed_line(dst, src);
+                copy_strided_line(dst, src, step);
             }
             break;
         case PIXFORMAT_GRAYSCALE:
             #if OMV_CSI_DMA_MEMCPY_ENABLE
-            if (!sensor_dma_memcpy(dma, dst, src, sizeof(uint8_t), sensor.transpose)) {
+            if (!sensor_dma_memcpy(dma, dst, src, sizeof(uint8_t), sensor.transpose, sensor.hmirror_copy)) {
                 break;
             }
             #endif
             if (sensor.mono_bpp == 1) {
                 // 1BPP GRAYSCALE.
-                if (!sensor.transpose) {
+                if (!strided) {
                     unaligned_memcpy(dst, src, MAIN_FB()->u);
                 } else {
-                    copy_transposed_line(dst, src);
+                    copy_strided_line(dst, src, step);
                 }
             } else {
                 // Extract Y channel from YUV.
-                if (!sensor.transpose) {
+                if (!strided) {
                     unaligned_2_to_1_memcpy(dst, src16, MAIN_FB()->u);
                 } else {
-                    copy_transposed_line(dst, src16);
+                    copy_strided_line(dst, src16, step);
                 }
             }
             break;
         case PIXFORMAT_RGB565:
         case PIXFORMAT_YUV422:
             #if OMV_CSI_DMA_MEMCPY_ENABLE
-            if (!sensor_dma_memcpy(dma, dst16, src16, sizeof(uint16_t), sensor.transpose)) {
+            if (!sensor_dma_memcpy(dma, dst16, src16, sizeof(uint16_t), sensor.transpose, sensor.hmirror_copy)) {
                 break;
             }
             #endif
@@ -1372,17 +1654,17 @@ __weak int sensor_copy_line(void *dma, uint8_t *src, uint8_t *dst) {
             #if !OMV_CSI_HW_SWAP_ENABLE
             } else if ((sensor.pixformat == PIXFORMAT_RGB565 && sensor.rgb_swap) ||
                        (sensor.pixformat == PIXFORMAT_YUV422 && sensor.yuv_swap)) {
-                if (!sensor.transpose) {
+                if (!strided) {
                     unaligned_memcpy_rev16(dst16, src16, MAIN_FB()->u);
                 } else {
-                    copy_transposed_line_rev16(dst16, src16);
+                    copy_strided_line_rev16(dst16, src16, step);
                 }
             #endif
             } else {
-                if (!sensor.transpose) {
+                if (!strided) {
                     unaligned_memcpy(dst16, src16, MAIN_FB()->u * sizeof(uint16_t));
                 } else {
-                    copy_transposed_line(dst16, src16);
+                    copy_strided_line(dst16, src16, step);
                 }
             }
             break;
@@ -1419,6 +1701,7 @@ const char *sensor_strerror(int error) {
         "Frame buffer error.",
         "Frame buffer overflow, try reducing the frame size.",
         "JPEG frame buffer overflow.",
+        "No frame is ready.",
     };
 
     // Sensor errors are negative.
@@ -14,12 +14,12 @@
 #include "py/runtime.h"
 #include "py/stream.h"
 #include "py/mphal.h"
-#include "py/ringbuf.h"
 #include "pendsv.h"
 
 #include "tusb.h"
 #include "usbdbg.h"
 #include "tinyusb_debug.h"
+#include "ringbuf.h"
 #include "omv_common.h"
 
 #define DEBUG_BAUDRATE_SLOW     (921600)
@@ -35,39 +35,29 @@ typedef struct __attribute__((packed)) {
 }
 usbdbg_cmd_t;
 
+#if (OMV_TUSBDBG_BUFFER & (OMV_TUSBDBG_BUFFER - 1))
+#error "OMV_TUSBDBG_BUFFER must be a power of two."
+#endif
+
 static uint8_t tx_array[OMV_TUSBDBG_BUFFER];
-static ringbuf_t tx_ringbuf = { tx_array, sizeof(tx_array) };
+static ring_buf_t tx_ringbuf = RING_BUF_INIT(tx_array, sizeof(tx_array));
 static volatile bool tinyusb_debug_mode = false;
 
 uint32_t usb_cdc_buf_len() {
-    return ringbuf_avail(&tx_ringbuf);
+    return ring_buf_avail(&tx_ringbuf);
 }
 
 uint32_t usb_cdc_get_buf(uint8_t *buf, uint32_t len) {
-    // Read all of the request bytes.
-    if (ringbuf_get_bytes(&tx_ringbuf, buf, len) == 0) {
-        return len;
-    }
-    // Try to read as much data as possible.
-    uint32_t bytes = 0;
-    for (; bytes < len; bytes++) {
-        int c = ringbuf_get(&tx_ringbuf);
-        if (c == -1) {
-            break;
-        }
-        buf[bytes] = c;
-    }
-    return bytes;
+    // Read as much of the requested data as possible.
+    return ring_buf_read(&tx_ringbuf, buf, len);
 }
 
 void usb_cdc_reset_buffers(void) {
-    tx_ringbuf.iget = 0;
-    tx_ringbuf.iput = 0;
+    ring_buf_reset(&tx_ringbuf);
 }
 
 void tud_cdc_line_coding_cb(uint8_t itf, cdc_line_coding_t const *coding) {
-    tx_ringbuf.iget = 0;
-    tx_ringbuf.iput = 0;
+    ring_buf_reset(&tx_ringbuf);
 
     if (0) {
         #if defined(MICROPY_BOARD_ENTER_BOOTLOADER)
@@ -113,16 +103,14 @@ mp_uint_t __wrap_mp_hal_stdout_tx_strn(const char *str, mp_uint_t len) {
     if (tinyusb_debug_enabled()) {
         if (tud_cdc_connected()) {
             NVIC_DisableIRQ(PendSV_IRQn);
-            for (int i = 0; i < len; i++) {
-                // The ring buffer overflows occasionally, espcially when using a slow poll
-                // rate and fast print rate. When this happens, reset the buffer and start
-                // over, if this string fits entirely in the buffer. This helps the ring buffer
-                // self-recover from broken strings.
-                if (ringbuf_put(&tx_ringbuf, str[i]) == -1 && len <= tx_ringbuf.size) {
-                    tx_ringbuf.iget = 0;
-                    tx_ringbuf.iput = 0;
-                }
+            // The ring buffer overflows occasionally, espcially when using a slow poll
+            // rate and fast print rate. When this happens, reset the buffer and start
+            // over, if this string fits entirely in the buffer. This helps the ring buffer
+            // self-recover from broken strings.
+            if (len > ring_buf_free(&tx_ringbuf) && len <= ring_buf_size(&tx_ringbuf)) {
+                ring_buf_reset(&tx_ringbuf);
             }
+            ring_buf_write(&tx_ringbuf, str, len);
             NVIC_EnableIRQ(PendSV_IRQn);
         }
         return len;
@@ -24,6 +24,9 @@
 #endif
 #include "framebuffer.h"
 #include "usbdbg.h"
+#include "profiler.h"
+#include "probe.h"
+#include "fb_alloc.h"
 #include "omv_boardconfig.h"
 #include "py_image.h"
 
@@ -34,6 +37,7 @@ static enum usbdbg_cmd cmd;
 static volatile bool script_ready;
 static volatile bool script_running;
 static volatile bool irq_enabled;
+static volatile bool frame_hold;
 static vstr_t script_buf;
 
 // These functions must be implemented by the stack.
@@ -47,8 +51,11 @@ void usbdbg_init() {
     script_ready = false;
     script_running = false;
     irq_enabled = false;
+    frame_hold = false;
 
     vstr_init(&script_buf, 32);
+    profiler_init();
+    probe_init();
 }
 
 bool usbdbg_script_ready() {
@@ -67,6 +74,10 @@ void usbdbg_set_script_running(bool running) {
     script_running = running;
 }
 
+void usbdbg_set_frame_hold(bool hold) {
+    frame_hold = hold;
+}
+
 inline void usbdbg_set_irq_enabled(bool enabled) {
     if (enabled) {
         NVIC_EnableIRQ(OMV_USB_IRQN);
@@ -144,34 +155,37 @@ void usbdbg_data_in(uint32_t size, usbdbg_write_callback_t write_callback) {
         }
 
         case USBDBG_FRAME_SIZE: {
-            // Return 0 if FB is locked or not ready.
-            uint32_t buffer[3] = { 0 };
-            // Try to lock FB. If header size == 0 frame is not ready
-            if (mutex_try_lock_alternate(&JPEG_FB()->lock, MUTEX_TID_IDE)) {
-                // If header size == 0 frame is not ready
-                if (JPEG_FB()->size == 0) {
-                    // unlock FB
-                    mutex_unlock(&JPEG_FB()->lock, MUTEX_TID_IDE);
-                } else {
-                    // Return header w, h and size/bpp
-                    buffer[0] = JPEG_FB()->w;
-                    buffer[1] = JPEG_FB()->h;
-                    buffer[2] = JPEG_FB()->size;
-                }
+            // Return 0 if no new frame is ready. Hosts that read more than the w, h and size/bpp
+            // header also get the pixel format, sequence number and timestamp of the frame.
+            uint32_t buffer[6] = { 0 };
+            // Take the last published frame, if any. It's returned after it has been dumped.
+            jpegbuffer_slot_t *slot = frame_hold ? NULL : jpegbuffer_acquire();
+            if (slot != NULL) {
+                // Return header w, h and size/bpp
+                buffer[0] = slot->w;
+                buffer[1] = slot->h;
+                buffer[2] = slot->size;
+                buffer[3] = slot->pixfmt;
+                buffer[4] = slot->seq;
+                buffer[5] = slot->ticks_us;
             }
             cmd = USBDBG_NONE;
-            write_callback(&buffer, sizeof(buffer));
+            write_callback(&buffer, OMV_MIN(size, sizeof(buffer)));
             break;
         }
 
         case USBDBG_FRAME_DUMP:
+            // Frames are pulled by the host: the debug transport only sends IN data in response to a
+            // command, and a new command can't be queued while a data phase is pending. The script is
+            // not blocked by the host, it encodes into the free JPEG buffer slot while this one is read.
             if (xfer_offs < xfer_size) {
-                write_callback(JPEG_FB()->pixels + xfer_offs, size);
+                int32_t reading = JPEG_FB()->reading;
+                uint32_t offset = (reading != JPEGBUFFER_NO_SLOT) ? JPEG_FB()->slots[reading].offset : 0;
+                write_callback(JPEG_FB()->pixels + offset + xfer_offs, size);
                 xfer_offs += size;
                 if (xfer_offs == xfer_size) {
                     cmd = USBDBG_NONE;
-                    JPEG_FB()->w = 0; JPEG_FB()->h = 0; JPEG_FB()->size = 0;
-                    mutex_unlock(&JPEG_FB()->lock, MUTEX_TID_IDE);
+                    jpegbuffer_release();
                 }
             }
             break;
@@ -215,21 +229,16 @@ void usbdbg_data_in(uint32_t size, usbdbg_write_callback_t write_callback) {
                 buffer[0] |= USBDBG_STATE_FLAGS_TEXT;
             }
 
-            // Try to lock FB. If header size == 0 frame is not ready
-            if (mutex_try_lock_alternate(&JPEG_FB()->lock, MUTEX_TID_IDE)) {
-                // If header size == 0 frame is not ready
-                if (JPEG_FB()->size == 0) {
-                    // unlock FB
-                    mutex_unlock(&JPEG_FB()->lock, MUTEX_TID_IDE);
-                } else {
-                    // Set valid frame flag.
-                    buffer[0] |= USBDBG_STATE_FLAGS_FRAME;
-
-                    // Set frame width, height and size/bpp
-                    buffer[1] = JPEG_FB()->w;
-                    buffer[2] = JPEG_FB()->h;
-                    buffer[3] = JPEG_FB()->size;
-                }
+            // Take the last published frame, if any. It's returned after it has been dumped.
+            jpegbuffer_slot_t *slot = frame_hold ? NULL : jpegbuffer_acquire();
+            if (slot != NULL) {
+                // Set valid frame flag.
+                buffer[0] |= USBDBG_STATE_FLAGS_FRAME;
+
+                // Set frame width, height and size/bpp
+                buffer[1] = slot->w;
+                buffer[2] = slot->h;
+                buffer[3] = slot->size;
             }
 
             // The rest of this packet is packed with text buffer.
@@ -245,6 +254,55 @@ void usbdbg_data_in(uint32_t size, usbdbg_write_callback_t write_callback) {
             break;
         }
 
+        case USBDBG_PROFILE_SIZE: {
+            // Return the number of records and the record size. Profiling
+            // is paused until the records are dumped.
+            uint32_t buffer[2] = {
+                profiler_record_count(),
+                sizeof(profiler_record_t),
+            };
+            profiler_pause(true);
+            cmd = USBDBG_NONE;
+            write_callback(&buffer, sizeof(buffer));
+            break;
+        }
+
+        case USBDBG_PROFILE_DUMP:
+            if (xfer_offs < xfer_size) {
+                write_callback(((uint8_t *) profiler_get_records()) + xfer_offs, size);
+                xfer_offs += size;
+                if (xfer_offs == xfer_size) {
+                    cmd = USBDBG_NONE;
+                    profiler_pause(false);
+                }
+            }
+            break;
+
+        case USBDBG_FB_STATS_SIZE: {
+            // Return the size of the statistics and the number of site records,
+            // or zeros if the firmware was built without FB_ALLOC_STATS.
+            uint32_t buffer[2] = { 0 };
+            #if defined(FB_ALLOC_STATS)
+            buffer[0] = sizeof(fb_alloc_stats_t);
+            buffer[1] = FB_ALLOC_STATS_SITES;
+            #endif
+            cmd = USBDBG_NONE;
+            write_callback(&buffer, sizeof(buffer));
+            break;
+        }
+
+        #if defined(FB_ALLOC_STATS)
+        case USBDBG_FB_STATS_DUMP:
+            if (xfer_offs < xfer_size) {
+                write_callback(((uint8_t *) fb_alloc_get_stats()) + xfer_offs, size);
+                xfer_offs += size;
+                if (xfer_offs == xfer_size) {
+                    cmd = USBDBG_NONE;
+                }
+            }
+            break;
+        #endif
+
         default: /* error */
             break;
     }
@@ -255,9 +313,8 @@ void usbdbg_data_out(uint32_t size, usbdbg_read_callback_t read_callback) {
         case USBDBG_FB_ENABLE: {
             read_callback(&(JPEG_FB()->enabled), 4);
             if (JPEG_FB()->enabled == 0) {
-                // When disabling framebuffer, the IDE might still be holding FB lock.
-                // If the IDE is not the current lock owner, this operation is ignored.
-                mutex_unlock(&JPEG_FB()->lock, MUTEX_TID_IDE);
+                // When disabling framebuffer, the IDE might still be holding a frame.
+                jpegbuffer_release();
             }
             cmd = USBDBG_NONE;
             break;
@@ -285,7 +342,7 @@ void usbdbg_data_out(uint32_t size, usbdbg_read_callback_t read_callback) {
 
         case USBDBG_TEMPLATE_SAVE: {
             #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
-            image_t image;
+            image_t image = {};
             framebuffer_init_image(&image);
 
             size = MIN(128, size);
@@ -304,7 +361,7 @@ void usbdbg_data_out(uint32_t size, usbdbg_read_callback_t read_callback) {
         case USBDBG_DESCRIPTOR_SAVE: {
             #if defined(IMLIB_ENABLE_IMAGE_FILE_IO) \
             && defined(IMLIB_ENABLE_KEYPOINTS)
-            image_t image;
+            image_t image = {};
             framebuffer_init_image(&image);
 
             size = MIN(128, size);
@@ -395,6 +452,10 @@ void usbdbg_control(void *buffer, uint8_t request, uint32_t size) {
             xfer_offs = 0;
             xfer_size = size;
             vstr_reset(&script_buf);
+            profiler_reset();
+            #if defined(FB_ALLOC_STATS)
+            fb_alloc_stats_reset();
+            #endif
             break;
 
         case USBDBG_SCRIPT_STOP:
@@ -479,6 +540,38 @@ void usbdbg_control(void *buffer, uint8_t request, uint32_t size) {
             xfer_size = size;
             break;
 
+        case USBDBG_PROFILE_SIZE:
+            xfer_offs = 0;
+            xfer_size = size;
+            break;
+
+        case USBDBG_PROFILE_DUMP:
+            xfer_offs = 0;
+            xfer_size = OMV_MIN(size, profiler_record_count() * sizeof(profiler_record_t));
+            break;
+
+        case USBDBG_PROFILE_RESET:
+            profiler_reset();
+            cmd = USBDBG_NONE;
+            break;
+
+        case USBDBG_FB_STATS_SIZE:
+            xfer_offs = 0;
+            xfer_size = size;
+            break;
+
+        #if defined(FB_ALLOC_STATS)
+        case USBDBG_FB_STATS_DUMP:
+            xfer_offs = 0;
+            xfer_size = OMV_MIN(size, sizeof(fb_alloc_stats_t));
+            break;
+
+        case USBDBG_FB_STATS_RESET:
+            fb_alloc_stats_reset();
+            cmd = USBDBG_NONE;
+            break;
+        #endif
+
         default: /* error */
             cmd = USBDBG_NONE;
             break;
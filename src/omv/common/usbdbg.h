@@ -50,6 +50,12 @@ enum usbdbg_cmd {
     USBDBG_TX_INPUT        =0x11,
     USBDBG_SET_TIME        =0x12,
     USBDBG_GET_STATE       =0x93,
+    USBDBG_PROFILE_SIZE    =0x94,
+    USBDBG_PROFILE_DUMP    =0x95,
+    USBDBG_PROFILE_RESET   =0x16,
+    USBDBG_FB_STATS_SIZE   =0x96,
+    USBDBG_FB_STATS_DUMP   =0x97,
+    USBDBG_FB_STATS_RESET  =0x17,
 };
 
 enum usbdbg_state_flags {
@@ -69,6 +75,8 @@ bool usbdbg_is_busy();
 bool usbdbg_get_irq_enabled();
 void usbdbg_set_irq_enabled(bool enabled);
 void usbdbg_set_script_running(bool running);
+// While held, no new frames are reported to the IDE (the transport can't keep up).
+void usbdbg_set_frame_hold(bool hold);
 void usbdbg_data_in(uint32_t size, usbdbg_write_callback_t write_callback);
 void usbdbg_data_out(uint32_t size, usbdbg_read_callback_t read_callback);
 void usbdbg_control(void *buffer, uint8_t brequest, uint32_t wlength);
@@ -17,18 +17,13 @@
 #include "xalloc.h"
 #include "fb_alloc.h"
 #include "gc.h"
+#include "simd.h"
 
 #define MAX_ROW          (480u)
 #define MIN_MEM          (10 * 1024)
 #define MAX_CORNERS      (2000u)
 #define Compare(X, Y)    ((X) >= (Y))
 
-typedef struct {
-    uint16_t x;
-    uint16_t y;
-    uint16_t score;
-} corner_t;
-
 static int s_width = -1;
 static int_fast16_t s_offset0;
 static int_fast16_t s_offset1;
@@ -39,9 +34,7 @@ static int_fast16_t s_offset5;
 static int_fast16_t s_offset6;
 static int_fast16_t s_offset7;
 
-static corner_t *agast58_detect(image_t *img, int b, int *num_corners, rectangle_t *roi);
 static int agast58_score(const unsigned char *p, int bstart);
-static void nonmax_suppression(corner_t *corners, int num_corners, array_t *keypoints);
 
 static kp_t *alloc_keypoint(uint16_t x, uint16_t y, uint16_t score) {
     // Note must set keypoint descriptor to zeros
@@ -69,866 +62,147 @@ static void init5_8_pattern(int image_width) {
     s_offset7 = (-1) + (1) * s_width;
 }
 
-void agast_detect(image_t *image, array_t *keypoints, int threshold, rectangle_t *roi) {
-    int num_corners = 0;
-    init5_8_pattern(image->w);
-
-    // Find corners
-    corner_t *corners = agast58_detect(image, threshold, &num_corners, roi);
-    if (num_corners) {
-        // Score corners
-        for (int i = 0; i < num_corners; i++) {
-            corners[i].score = agast58_score(image->pixels + (corners[i].y * image->w + corners[i].x), threshold);
-        }
-        // Non-max suppression
-        nonmax_suppression(corners, num_corners, keypoints);
-    }
-    // Free corners;
-    fb_free();
+// Returns true if 5 contiguous bits are set in the 8-bit circular mask.
+static inline bool agast58_segment(uint32_t m) {
+    m |= m << 8;
+    uint32_t m2 = m & (m >> 1);
+    uint32_t m4 = m2 & (m2 >> 2);
+    return (m4 & (m >> 4)) != 0;
 }
 
-static void nonmax_suppression(corner_t *corners, int num_corners, array_t *keypoints) {
-    gc_info_t info;
-
-    int last_row;
-    int16_t *row_start;
-    const int sz = num_corners;
-
-    /* Point above points (roughly) to the pixel above
-       the one of interest, if there is a feature there.*/
-    int point_above = 0;
-    int point_below = 0;
-
-    /* Find where each row begins (the corners are output in raster scan order).
-       A beginning of -1 signifies that there are no corners on that row. */
-    last_row = corners[sz - 1].y;
-    row_start = fb_alloc((last_row + 1) * sizeof(uint16_t), FB_ALLOC_NO_HINT);
-
-    for (int i = 0; i < last_row + 1; i++) {
-        row_start[i] = -1;
+static bool agast58_is_corner(const uint8_t *p, int b) {
+    const int_fast16_t offsets[8] = {
+        s_offset0, s_offset1, s_offset2, s_offset3, s_offset4, s_offset5, s_offset6, s_offset7
+    };
+    int cb = *p + b;
+    int c_b = *p - b;
+    uint32_t bright = 0, dark = 0;
+    for (int k = 0; k < 8; k++) {
+        int v = p[offsets[k]];
+        bright |= (v > cb) << k;
+        dark |= (v < c_b) << k;
     }
+    return agast58_segment(bright) || agast58_segment(dark);
+}
 
-    for (int i = 0, prev_row = -1; i < sz; i++) {
-        corner_t *c = &corners[i];
-        if (c->y != prev_row) {
-            row_start[c->y] = i;
-            prev_row = c->y;
+// Writes score + 1 for each corner in the row and 0 elsewhere. A 5 pixel arc always covers two
+// adjacent even ring pixels (0, 2, 4, 6), so it covers 0 or 4 and 2 or 6. That is tested for a
+// whole vector of pixels first and only the pixels passing it get the full segment test.
+static void agast58_score_row(image_t *image, int x_start, int y, int w, int b, uint16_t *scores) {
+    const uint8_t *row = image->pixels + (y * image->w) + x_start;
+    v128_t vb = vdup_u8(IM_MIN(IM_MAX(b, 0), 255));
+    uint8_t lanes[UINT8_VECTOR_SIZE];
+
+    for (int x = 0; x < w; x += UINT8_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_8(w - x);
+        const uint8_t *p = row + x;
+
+        v128_t c = vldr_u8_pred(p, pred);
+        v128_t hi = vqadd_u8(c, vb);
+        v128_t lo = vqsub_u8(c, vb);
+
+        v128_t p0 = vldr_u8_pred(p + s_offset0, pred);
+        v128_t p2 = vldr_u8_pred(p + s_offset2, pred);
+        v128_t p4 = vldr_u8_pred(p + s_offset4, pred);
+        v128_t p6 = vldr_u8_pred(p + s_offset6, pred);
+
+        // Lanes are non-zero where brighter (darker) than the threshold, so min is "and" and max is "or".
+        v128_t bright = vmin_u8(vmax_u8(vqsub_u8(p0, hi), vqsub_u8(p4, hi)),
+                                vmax_u8(vqsub_u8(p2, hi), vqsub_u8(p6, hi)));
+        v128_t dark = vmin_u8(vmax_u8(vqsub_u8(lo, p0), vqsub_u8(lo, p4)),
+                              vmax_u8(vqsub_u8(lo, p2), vqsub_u8(lo, p6)));
+        v128_t candidates = vmax_u8(bright, dark);
+
+        int n = vpredicate_8_get_n(pred);
+        for (int i = 0; i < n; i++) {
+            scores[x + i] = 0;
         }
-    }
-
-    for (int i = 0; i < sz; i++) {
-        corner_t pos = corners[i];
-        uint16_t score = pos.score;
 
-        /*Check left */
-        if (i > 0) {
-            if (corners[i - 1].x == pos.x - 1 && corners[i - 1].y == pos.y && Compare(corners[i - 1].score, score)) {
-                goto nonmax;
-            }
+        if (!vmaxv_u8(candidates)) {
+            continue;
         }
 
-        /*Check right*/
-        if (i < (sz - 1)) {
-            if (corners[i + 1].x == pos.x + 1 && corners[i + 1].y == pos.y && Compare(corners[i + 1].score, score)) {
-                goto nonmax;
+        vstr_u8_pred(lanes, candidates, pred);
+        for (int i = 0; i < n; i++) {
+            if (lanes[i] && agast58_is_corner(p + i, b)) {
+                scores[x + i] = agast58_score(p + i, b) + 1;
             }
         }
+    }
+}
 
-        /*Check above (if there is a valid row above)*/
-        if (pos.y != 0 && row_start[pos.y - 1] != -1) {
-            /*Make sure that current point_above is one row above.*/
-            if (corners[point_above].y < pos.y - 1) {
-                point_above = row_start[pos.y - 1];
-            }
+// Corners are detected, scored and non-max suppressed in one pass over the roi. Scores are kept
+// for three rows at a time, row y - 1 is suppressed once row y has been scored.
+void agast_detect(image_t *image, array_t *keypoints, int threshold, rectangle_t *roi) {
+    gc_info_t info;
+    int num_corners = 0;
+    init5_8_pattern(image->w);
 
-            /*Make point_above point to the first of the pixels above the current point, if it exists.*/
-            for (; corners[point_above].y < pos.y && corners[point_above].x < pos.x - 1; point_above++) {
+    int x_start = roi->x + 1;
+    int y_start = roi->y + 1;
+    int w = roi->w - 2;
+    int h = roi->h - 2;
 
-            }
+    if ((w <= 0) || (h <= 0)) {
+        return;
+    }
 
-            for (int j = point_above; corners[j].y < pos.y && corners[j].x <= pos.x + 1; j++) {
-                int x = corners[j].x;
-                if ( (x == pos.x - 1 || x == pos.x || x == pos.x + 1) && Compare(corners[j].score, score)) {
-                    goto nonmax;
-                }
-            }
+    // Each row has a zero border pixel on both sides.
+    int row_len = w + 2;
+    uint16_t *rows = fb_alloc0(3 * row_len * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    uint16_t *prev = rows + 1;
+    uint16_t *curr = prev + row_len;
+    uint16_t *next = curr + row_len;
+
+    for (int y = 0; y <= h; y++) {
+        if (y < h) {
+            agast58_score_row(image, x_start, y_start + y, w, threshold, next);
+        } else {
+            memset(next, 0, w * sizeof(uint16_t));
         }
 
-        /*Check below (if there is anything below)*/
-        if (pos.y != last_row && row_start[pos.y + 1] != -1 && point_below < sz) {
-            /*Nothing below*/
-            if (corners[point_below].y < pos.y + 1) {
-                point_below = row_start[pos.y + 1];
-            }
+        for (int x = 0; (y > 0) && (x < w); x++) {
+            uint16_t score = curr[x];
 
-            /* Make point below point to one of the pixels belowthe current point, if it exists.*/
-            for (; point_below < sz && corners[point_below].y == pos.y + 1 && corners[point_below].x < pos.x - 1;
-                 point_below++) {
+            // Neighbors with a greater or equal score suppress this corner.
+            if ((!score) ||
+                Compare(curr[x - 1], score) || Compare(curr[x + 1], score) ||
+                Compare(prev[x - 1], score) || Compare(prev[x], score) || Compare(prev[x + 1], score) ||
+                Compare(next[x - 1], score) || Compare(next[x], score) || Compare(next[x + 1], score)) {
+                continue;
             }
 
-            for (int j = point_below; j < sz && corners[j].y == pos.y + 1 && corners[j].x <= pos.x + 1; j++) {
-                int x = corners[j].x;
-                if ( (x == pos.x - 1 || x == pos.x || x == pos.x + 1) && Compare(corners[j].score, score)) {
-                    goto nonmax;
+            gc_info(&info);
+            // Allocate keypoints until we're almost out of memory
+            if (info.free < MIN_MEM) {
+                // Try collecting memory
+                gc_collect();
+                // If it didn't work break
+                gc_info(&info);
+                if (info.free < MIN_MEM) {
+                    goto done;
                 }
             }
-        }
 
-        gc_info(&info);
+            array_push_back(keypoints, alloc_keypoint(x_start + x, y_start + y - 1, score - 1));
 
-        // Allocate keypoints until we're almost out of memory
-        if (info.free < MIN_MEM) {
-            // Try collecting memory
-            gc_collect();
-            // If it didn't work break
-            gc_info(&info);
-            if (info.free < MIN_MEM) {
-                break;
+            if (++num_corners == MAX_CORNERS) {
+                goto done;
             }
         }
-        array_push_back(keypoints, alloc_keypoint(pos.x, pos.y, pos.score));
-        nonmax:
-        ;
+
+        uint16_t *tmp = prev;
+        prev = curr;
+        curr = next;
+        next = tmp;
     }
 
-    // Free temp rows.
+done:
+    // Free score rows.
     fb_free();
 }
 
 // *INDENT-OFF*
-static corner_t *agast58_detect(image_t *img, int b, int* num_corners, rectangle_t *roi)
-{
-	int total=0;
-	register int x, y;
-	register int xsizeB=(roi->x+roi->w) - 2;
-	register int ysizeB=(roi->y+roi->h) - 1;
-	register int_fast16_t offset0, offset1, offset2, offset3, offset4, offset5, offset6, offset7;
-	register int width;
-
-	offset0=s_offset0;
-	offset1=s_offset1;
-	offset2=s_offset2;
-	offset3=s_offset3;
-	offset4=s_offset4;
-	offset5=s_offset5;
-	offset6=s_offset6;
-	offset7=s_offset7;
-	width=s_width;
-
-    // Try to alloc MAX_CORNERS or the actual max corners we can alloc.
-    int max_corners = IM_MIN(MAX_CORNERS, (fb_avail() / sizeof(corner_t)));
-    corner_t *corners = (corner_t*) fb_alloc(max_corners * sizeof(corner_t), FB_ALLOC_NO_HINT);
-
-	for(y=roi->y+1; y < ysizeB; y++)
-	{										
-		x=roi->x;
-		while(1)							
-		{									
-homogeneous:
-{
-			x++;			
-			if(x>xsizeB)	
-				break;
-			else
-			{
-				register const unsigned char* const p = img->pixels + y*width + x;
-				register const int cb = *p + b;
-				register const int c_b = *p - b;
-				if(p[offset0] > cb)
-				  if(p[offset2] > cb)
-					if(p[offset3] > cb)
-					  if(p[offset5] > cb)
-						if(p[offset1] > cb)
-						  if(p[offset4] > cb)
-							goto success_structured;
-						  else
-							if(p[offset7] > cb)
-							  goto success_structured;
-							else
-							  goto homogeneous;
-						else
-						  if(p[offset4] > cb)
-							if(p[offset6] > cb)
-							  goto success_structured;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-					  else
-						if(p[offset1] > cb)
-						  if(p[offset4] > cb)
-							goto success_homogeneous;
-						  else
-							if(p[offset7] > cb)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  goto homogeneous;
-					else
-					  if(p[offset7] > cb)
-						if(p[offset6] > cb)
-						  if(p[offset5] > cb)
-							if(p[offset1] > cb)
-							  goto success_structured;
-							else
-							  if(p[offset4] > cb)
-								goto success_structured;
-							  else
-								goto homogeneous;
-						  else
-							if(p[offset1] > cb)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  goto homogeneous;
-					  else
-						if(p[offset5] < c_b)
-						  if(p[offset3] < c_b)
-							if(p[offset7] < c_b)
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_structured;
-								else
-								  goto structured;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-						else
-						  goto homogeneous;
-				  else
-					if(p[offset5] > cb)
-					  if(p[offset7] > cb)
-						if(p[offset6] > cb)
-						  if(p[offset1] > cb)
-							goto success_homogeneous;
-						  else
-							if(p[offset4] > cb)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  goto homogeneous;
-					  else
-						goto homogeneous;
-					else
-					  if(p[offset5] < c_b)
-						if(p[offset3] < c_b)
-						  if(p[offset2] < c_b)
-							if(p[offset1] < c_b)
-							  if(p[offset4] < c_b)
-								goto success_structured;
-							  else
-								goto homogeneous;
-							else
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_structured;
-								else
-								  goto homogeneous;
-							  else
-								goto homogeneous;
-						  else
-							if(p[offset7] < c_b)
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_structured;
-								else
-								  goto homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  goto homogeneous;
-					  else
-						goto homogeneous;
-				else if(p[offset0] < c_b)
-				  if(p[offset2] < c_b)
-					if(p[offset7] > cb)
-					  if(p[offset3] < c_b)
-						if(p[offset5] < c_b)
-						  if(p[offset1] < c_b)
-							if(p[offset4] < c_b)
-							  goto success_structured;
-							else
-							  goto structured;
-						  else
-							if(p[offset4] < c_b)
-							  if(p[offset6] < c_b)
-								goto success_structured;
-							  else
-								goto structured;
-							else
-							  goto homogeneous;
-						else
-						  if(p[offset1] < c_b)
-							if(p[offset4] < c_b)
-							  goto success_structured;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-					  else
-						if(p[offset5] > cb)
-						  if(p[offset3] > cb)
-							if(p[offset4] > cb)
-							  if(p[offset6] > cb)
-								goto success_structured;
-							  else
-								goto structured;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-						else
-						  goto homogeneous;
-					else
-					  if(p[offset7] < c_b)
-						if(p[offset3] < c_b)
-						  if(p[offset5] < c_b)
-							if(p[offset1] < c_b)
-							  goto success_structured;
-							else
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_structured;
-								else
-								  goto structured;
-							  else
-								goto homogeneous;
-						  else
-							if(p[offset1] < c_b)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  if(p[offset6] < c_b)
-							if(p[offset5] < c_b)
-							  if(p[offset1] < c_b)
-								goto success_structured;
-							  else
-								if(p[offset4] < c_b)
-								  goto success_structured;
-								else
-								  goto homogeneous;
-							else
-							  if(p[offset1] < c_b)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-						  else
-							goto homogeneous;
-					  else
-						if(p[offset3] < c_b)
-						  if(p[offset5] < c_b)
-							if(p[offset1] < c_b)
-							  if(p[offset4] < c_b)
-								goto success_structured;
-							  else
-								goto homogeneous;
-							else
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_structured;
-								else
-								  goto homogeneous;
-							  else
-								goto homogeneous;
-						  else
-							if(p[offset1] < c_b)
-							  if(p[offset4] < c_b)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  goto homogeneous;
-				  else
-					if(p[offset5] > cb)
-					  if(p[offset3] > cb)
-						if(p[offset2] > cb)
-						  if(p[offset1] > cb)
-							if(p[offset4] > cb)
-							  goto success_structured;
-							else
-							  goto homogeneous;
-						  else
-							if(p[offset4] > cb)
-							  if(p[offset6] > cb)
-								goto success_structured;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  if(p[offset7] > cb)
-							if(p[offset4] > cb)
-							  if(p[offset6] > cb)
-								goto success_structured;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-					  else
-						goto homogeneous;
-					else
-					  if(p[offset5] < c_b)
-						if(p[offset7] < c_b)
-						  if(p[offset6] < c_b)
-							if(p[offset1] < c_b)
-							  goto success_homogeneous;
-							else
-							  if(p[offset4] < c_b)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-						  else
-							goto homogeneous;
-						else
-						  goto homogeneous;
-					  else
-						goto homogeneous;
-				else
-				  if(p[offset3] > cb)
-					if(p[offset5] > cb)
-					  if(p[offset2] > cb)
-						if(p[offset1] > cb)
-						  if(p[offset4] > cb)
-							goto success_homogeneous;
-						  else
-							goto homogeneous;
-						else
-						  if(p[offset4] > cb)
-							if(p[offset6] > cb)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-					  else
-						if(p[offset7] > cb)
-						  if(p[offset4] > cb)
-							if(p[offset6] > cb)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-						else
-						  goto homogeneous;
-					else
-					  goto homogeneous;
-				  else
-					if(p[offset3] < c_b)
-					  if(p[offset5] < c_b)
-						if(p[offset2] < c_b)
-						  if(p[offset1] < c_b)
-							if(p[offset4] < c_b)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							if(p[offset4] < c_b)
-							  if(p[offset6] < c_b)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  if(p[offset7] < c_b)
-							if(p[offset4] < c_b)
-							  if(p[offset6] < c_b)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-					  else
-						goto homogeneous;
-					else
-					  goto homogeneous;
-			}
-}
-structured:
-{
-			x++;			
-			if(x>xsizeB)	
-				break;
-			else
-			{
-				register const unsigned char* const p = img->pixels + y*width + x;
-				register const int cb = *p + b;
-				register const int c_b = *p - b;
-				if(p[offset0] > cb)
-				  if(p[offset2] > cb)
-					if(p[offset3] > cb)
-					  if(p[offset5] > cb)
-						if(p[offset7] > cb)
-						  if(p[offset1] > cb)
-							goto success_structured;
-						  else
-							if(p[offset4] > cb)
-							  if(p[offset6] > cb)
-								goto success_structured;
-							  else
-								goto structured;
-							else
-							  goto structured;
-						else
-						  if(p[offset1] > cb)
-							if(p[offset4] > cb)
-							  goto success_structured;
-							else
-							  goto structured;
-						  else
-							if(p[offset4] > cb)
-							  if(p[offset6] > cb)
-								goto success_structured;
-							  else
-								goto structured;
-							else
-							  goto structured;
-					  else
-						if(p[offset7] > cb)
-						  if(p[offset1] > cb)
-							goto success_structured;
-						  else
-							goto structured;
-						else
-						  if(p[offset1] > cb)
-							if(p[offset4] > cb)
-							  goto success_structured;
-							else
-							  goto structured;
-						  else
-							goto structured;
-					else
-					  if(p[offset7] > cb)
-						if(p[offset6] > cb)
-						  if(p[offset5] > cb)
-							if(p[offset1] > cb)
-							  goto success_structured;
-							else
-							  if(p[offset4] > cb)
-								goto success_structured;
-							  else
-								goto structured;
-						  else
-							if(p[offset1] > cb)
-							  goto success_structured;
-							else
-							  goto structured;
-						else
-						  goto structured;
-					  else
-						if(p[offset5] < c_b)
-						  if(p[offset3] < c_b)
-							if(p[offset7] < c_b)
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_structured;
-								else
-								  goto structured;
-							  else
-								goto structured;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-						else
-						  goto structured;
-				  else
-					if(p[offset5] > cb)
-					  if(p[offset7] > cb)
-						if(p[offset6] > cb)
-						  if(p[offset1] > cb)
-							goto success_structured;
-						  else
-							if(p[offset4] > cb)
-							  goto success_structured;
-							else
-							  goto structured;
-						else
-						  goto structured;
-					  else
-						goto structured;
-					else
-					  if(p[offset5] < c_b)
-						if(p[offset3] < c_b)
-						  if(p[offset2] < c_b)
-							if(p[offset1] < c_b)
-							  if(p[offset4] < c_b)
-								goto success_structured;
-							  else
-								goto structured;
-							else
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_structured;
-								else
-								  goto structured;
-							  else
-								goto structured;
-						  else
-							if(p[offset7] < c_b)
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_homogeneous;
-								else
-								  goto homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  goto structured;
-					  else
-						goto homogeneous;
-				else if(p[offset0] < c_b)
-				  if(p[offset2] < c_b)
-					if(p[offset7] > cb)
-					  if(p[offset3] < c_b)
-						if(p[offset5] < c_b)
-						  if(p[offset1] < c_b)
-							if(p[offset4] < c_b)
-							  goto success_structured;
-							else
-							  goto structured;
-						  else
-							if(p[offset4] < c_b)
-							  if(p[offset6] < c_b)
-								goto success_structured;
-							  else
-								goto structured;
-							else
-							  goto structured;
-						else
-						  if(p[offset1] < c_b)
-							if(p[offset4] < c_b)
-							  goto success_structured;
-							else
-							  goto structured;
-						  else
-							goto structured;
-					  else
-						if(p[offset5] > cb)
-						  if(p[offset3] > cb)
-							if(p[offset4] > cb)
-							  if(p[offset6] > cb)
-								goto success_structured;
-							  else
-								goto structured;
-							else
-							  goto structured;
-						  else
-							goto homogeneous;
-						else
-						  goto structured;
-					else
-					  if(p[offset7] < c_b)
-						if(p[offset3] < c_b)
-						  if(p[offset5] < c_b)
-							if(p[offset1] < c_b)
-							  goto success_structured;
-							else
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_structured;
-								else
-								  goto structured;
-							  else
-								goto structured;
-						  else
-							if(p[offset1] < c_b)
-							  goto success_structured;
-							else
-							  goto structured;
-						else
-						  if(p[offset6] < c_b)
-							if(p[offset5] < c_b)
-							  if(p[offset1] < c_b)
-								goto success_structured;
-							  else
-								if(p[offset4] < c_b)
-								  goto success_structured;
-								else
-								  goto structured;
-							else
-							  if(p[offset1] < c_b)
-								goto success_structured;
-							  else
-								goto structured;
-						  else
-							goto structured;
-					  else
-						if(p[offset3] < c_b)
-						  if(p[offset5] < c_b)
-							if(p[offset1] < c_b)
-							  if(p[offset4] < c_b)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  if(p[offset4] < c_b)
-								if(p[offset6] < c_b)
-								  goto success_homogeneous;
-								else
-								  goto homogeneous;
-							  else
-								goto homogeneous;
-						  else
-							if(p[offset1] < c_b)
-							  if(p[offset4] < c_b)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  goto homogeneous;
-				  else
-					if(p[offset5] > cb)
-					  if(p[offset3] > cb)
-						if(p[offset2] > cb)
-						  if(p[offset1] > cb)
-							if(p[offset4] > cb)
-							  goto success_structured;
-							else
-							  goto structured;
-						  else
-							if(p[offset4] > cb)
-							  if(p[offset6] > cb)
-								goto success_structured;
-							  else
-								goto structured;
-							else
-							  goto structured;
-						else
-						  if(p[offset7] > cb)
-							if(p[offset4] > cb)
-							  if(p[offset6] > cb)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-					  else
-						goto structured;
-					else
-					  if(p[offset5] < c_b)
-						if(p[offset7] < c_b)
-						  if(p[offset6] < c_b)
-							if(p[offset1] < c_b)
-							  goto success_structured;
-							else
-							  if(p[offset4] < c_b)
-								goto success_structured;
-							  else
-								goto structured;
-						  else
-							goto structured;
-						else
-						  goto structured;
-					  else
-						goto homogeneous;
-				else
-				  if(p[offset3] > cb)
-					if(p[offset5] > cb)
-					  if(p[offset2] > cb)
-						if(p[offset1] > cb)
-						  if(p[offset4] > cb)
-							goto success_homogeneous;
-						  else
-							goto homogeneous;
-						else
-						  if(p[offset4] > cb)
-							if(p[offset6] > cb)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-					  else
-						if(p[offset7] > cb)
-						  if(p[offset4] > cb)
-							if(p[offset6] > cb)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-						else
-						  goto homogeneous;
-					else
-					  goto homogeneous;
-				  else
-					if(p[offset3] < c_b)
-					  if(p[offset5] < c_b)
-						if(p[offset2] < c_b)
-						  if(p[offset1] < c_b)
-							if(p[offset4] < c_b)
-							  goto success_homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							if(p[offset4] < c_b)
-							  if(p[offset6] < c_b)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						else
-						  if(p[offset7] < c_b)
-							if(p[offset4] < c_b)
-							  if(p[offset6] < c_b)
-								goto success_homogeneous;
-							  else
-								goto homogeneous;
-							else
-							  goto homogeneous;
-						  else
-							goto homogeneous;
-					  else
-						goto homogeneous;
-					else
-					  goto homogeneous;
-			}
-}
-success_homogeneous:
-			corners[total].x = x;				
-			corners[total].y = y;				
-			if(++total == max_corners) {
-                goto done;
-            }
-			goto homogeneous;				
-success_structured:
-			corners[total].x = x;				
-			corners[total].y = y;				
-			if(++total == max_corners) {
-                goto done;
-            }
-			goto structured;				
-		}									
-	}										
-done:
-	*num_corners = total;
-	return corners;								
-}
-
 //using also bisection as propsed by Edward Rosten in FAST,
 //but it is based on the OAST
 static int agast58_score(const unsigned char* p, int bstart)
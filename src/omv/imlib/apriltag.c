@@ -5139,6 +5139,9 @@ struct apriltag_family
     // minimum hamming distance between any two codes. (e.g. 36h11 => 11)
     uint32_t h;
 
+    // Indices of the codes sorted by value, for exact matches with a binary search.
+    const uint16_t *sorted_ids;
+
     // The codes in the family.
     uint64_t codes[];
 };
@@ -5183,6 +5186,13 @@ struct apriltag_detector
     ///////////////////////////////////////////////////////////////
     // User-configurable parameters.
 
+    // Detection of quads can be done on a lower-resolution image,
+    // improving speed and memory use at a cost of sensitivity to
+    // small tags. The image is box-filtered down by this integer
+    // factor before thresholding and segmentation. Decoding and
+    // edge refinement are always done on the full-resolution image.
+    int quad_decimate;
+
     // When non-zero, the edges of the each quad are adjusted to "snap
     // to" strong gradients nearby. This is useful when decimation is
     // employed, as it can increase the quality of the initial quad
@@ -5225,6 +5235,9 @@ struct apriltag_detector
     // between multiple users. The user should ultimately destroy the
     // tag family passed into the constructor.
     zarray_t *tag_families;
+
+    // OpenMV: quad fitting and decoding stop early once out of time.
+    imlib_deadline_t *deadline;
 };
 
 // Represents the detection of a tag. These are returned to the user
@@ -5313,11 +5326,18 @@ void apriltag_detections_destroy(zarray_t *detections);
 //////// "tag16h5"
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Code indices sorted by code value for quick_decode_exact().
+static const uint16_t tag16h5_sorted_ids[] = {
+    28, 16, 12, 9, 23, 0, 1, 2, 10, 3, 19, 13, 21, 25, 4, 5,
+    14, 17, 18, 26, 15, 29, 6, 27, 22, 20, 7, 24, 11, 8
+};
+
 const apriltag_family_t tag16h5 = {
     .ncodes = 30,
     .black_border = 1,
     .d = 4,
     .h = 5,
+    .sorted_ids = tag16h5_sorted_ids,
     .codes = {
         0x000000000000231bUL,
         0x0000000000002ea5UL,
@@ -5356,11 +5376,32 @@ const apriltag_family_t tag16h5 = {
 //////// "tag25h7"
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Code indices sorted by code value for quick_decode_exact().
+static const uint16_t tag25h7_sorted_ids[] = {
+    134, 240, 222, 190, 96, 135, 85, 111, 75, 64, 56, 196, 168, 162, 12, 40,
+    103, 87, 192, 102, 7, 160, 188, 239, 159, 212, 232, 131, 86, 65, 171, 0,
+    67, 197, 167, 93, 146, 185, 228, 205, 73, 62, 81, 50, 139, 47, 198, 194,
+    104, 231, 120, 125, 18, 90, 204, 129, 105, 34, 215, 181, 23, 100, 31, 16,
+    177, 173, 79, 72, 26, 211, 187, 161, 77, 234, 148, 210, 238, 175, 179, 180,
+    101, 130, 20, 164, 233, 98, 5, 145, 46, 149, 74, 156, 8, 137, 97, 165,
+    3, 124, 172, 11, 182, 117, 213, 219, 154, 30, 195, 71, 119, 78, 59, 142,
+    127, 51, 178, 126, 70, 60, 199, 237, 113, 94, 38, 32, 19, 208, 45, 122,
+    112, 114, 35, 236, 226, 1, 152, 91, 27, 229, 136, 225, 157, 69, 241, 132,
+    95, 169, 57, 218, 41, 220, 189, 140, 206, 153, 174, 58, 116, 158, 33, 141,
+    144, 147, 235, 29, 107, 13, 193, 24, 202, 9, 227, 17, 203, 4, 88, 28,
+    44, 186, 223, 22, 61, 48, 63, 166, 15, 42, 36, 121, 170, 68, 82, 118,
+    92, 89, 230, 83, 80, 163, 200, 53, 221, 99, 214, 10, 176, 209, 155, 66,
+    123, 109, 39, 183, 110, 216, 55, 43, 2, 37, 106, 108, 143, 128, 150, 201,
+    76, 21, 184, 6, 151, 14, 207, 115, 49, 191, 25, 138, 133, 224, 52, 84,
+    217, 54
+};
+
 const apriltag_family_t tag25h7 = {
     .ncodes = 242,
     .black_border = 1,
     .d = 5,
     .h = 7,
+    .sorted_ids = tag25h7_sorted_ids,
     .codes = {
         0x00000000004b770dUL,
         0x00000000011693e6UL,
@@ -5611,11 +5652,19 @@ const apriltag_family_t tag25h7 = {
 //////// "tag25h9"
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Code indices sorted by code value for quick_decode_exact().
+static const uint16_t tag25h9_sorted_ids[] = {
+    5, 11, 30, 20, 6, 10, 29, 25, 26, 17, 19, 34, 28, 12, 22, 9,
+    32, 7, 4, 31, 0, 14, 16, 27, 15, 18, 2, 23, 21, 33, 8, 24,
+    1, 13, 3
+};
+
 const apriltag_family_t tag25h9 = {
     .ncodes = 35,
     .black_border = 1,
     .d = 5,
     .h = 9,
+    .sorted_ids = tag25h9_sorted_ids,
     .codes = {
         0x000000000155cbf1UL,
         0x0000000001e4d1b6UL,
@@ -5659,11 +5708,161 @@ const apriltag_family_t tag25h9 = {
 //////// "tag36h10"
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Code indices sorted by code value for quick_decode_exact().
+static const uint16_t tag36h10_sorted_ids[] = {
+    99, 2067, 352, 1676, 1948, 1366, 329, 1715, 1641, 1430, 2208, 1345, 2072, 1361, 2014, 1801,
+    2236, 1486, 1542, 1741, 1916, 371, 1497, 893, 1812, 118, 1216, 1087, 1717, 129, 1525, 2204,
+    655, 1521, 1156, 806, 790, 1376, 408, 2097, 2299, 466, 815, 1859, 193, 998, 415, 1579,
+    1552, 302, 1023, 386, 27, 650, 883, 841, 72, 1021, 436, 1485, 1694, 515, 100, 1976,
+    1665, 1253, 152, 1054, 1268, 563, 381, 930, 1100, 2314, 1652, 1570, 2055, 2264, 1722, 1196,
+    691, 1140, 471, 769, 1615, 424, 1908, 73, 1212, 1620, 2045, 1354, 1203, 374, 2032, 1308,
+    817, 1804, 1198, 1576, 591, 2200, 2137, 1393, 474, 1861, 1297, 413, 1247, 1585, 926, 445,
+    1670, 2098, 804, 513, 1640, 1528, 1975, 666, 74, 2033, 1185, 1250, 997, 1476, 130, 779,
+    140, 669, 1810, 1543, 2005, 668, 289, 731, 2243, 767, 1690, 1164, 2233, 908, 2127, 2277,
+    2120, 1275, 220, 746, 227, 1256, 1282, 700, 682, 1865, 1711, 316, 2160, 1574, 489, 437,
+    1571, 1857, 1929, 713, 2059, 886, 1469, 270, 2311, 1399, 164, 1936, 1660, 2145, 194, 2222,
+    755, 918, 1573, 1072, 1890, 1344, 2105, 904, 1647, 1479, 28, 1438, 2257, 249, 91, 1426,
+    1255, 119, 258, 1943, 2025, 131, 2092, 153, 516, 812, 1416, 550, 850, 2150, 2249, 1718,
+    1400, 1650, 467, 1840, 1060, 1729, 819, 1569, 589, 876, 988, 1587, 651, 1420, 1081, 1296,
+    1846, 937, 1597, 788, 1133, 985, 1245, 692, 2095, 1383, 1200, 1555, 203, 1365, 1934, 948,
+    1967, 1681, 0, 497, 1135, 29, 1805, 2079, 1927, 57, 2197, 1320, 1342, 101, 1938, 1084,
+    1474, 811, 120, 1440, 572, 1622, 568, 1273, 1517, 1142, 2241, 1605, 1613, 1146, 1765, 204,
+    1956, 1061, 1234, 625, 1, 2103, 1796, 2010, 722, 1898, 58, 2154, 2207, 913, 521, 1601,
+    1982, 320, 736, 1158, 2213, 609, 2116, 605, 154, 1439, 2225, 554, 1165, 1018, 293, 1778,
+    205, 980, 1152, 880, 1586, 636, 30, 1972, 834, 244, 317, 2198, 800, 884, 1716, 1878,
+    1939, 2088, 1634, 1002, 1353, 1964, 380, 361, 1278, 1701, 1499, 2068, 670, 936, 1911, 1754,
+    485, 363, 1162, 476, 831, 2083, 588, 2, 1614, 31, 561, 647, 92, 1235, 102, 637,
+    1884, 2306, 1423, 271, 1403, 2165, 169, 1484, 1809, 2286, 1186, 2169, 1244, 827, 1977, 1050,
+    2077, 298, 653, 3, 233, 32, 1262, 481, 75, 250, 1727, 1222, 887, 2019, 1946, 1413,
+    1646, 325, 359, 1869, 1240, 409, 2147, 2142, 1631, 2275, 1995, 2153, 1619, 365, 477, 1994,
+    631, 881, 740, 59, 570, 1016, 1280, 1412, 121, 439, 1294, 2292, 1090, 759, 1875, 1259,
+    1669, 2252, 1191, 2012, 910, 847, 1849, 785, 1006, 540, 206, 846, 951, 221, 803, 955,
+    1968, 470, 1143, 1218, 766, 868, 33, 821, 542, 942, 2030, 1392, 2245, 2312, 141, 1111,
+    1077, 2017, 1708, 1013, 2139, 867, 1656, 1170, 1299, 1787, 671, 1662, 1123, 1962, 2056, 2029,
+    4, 34, 690, 1101, 1541, 245, 584, 688, 2108, 557, 1560, 2194, 487, 620, 1791, 1520,
+    1015, 2135, 2282, 1919, 142, 509, 823, 275, 1039, 170, 2178, 1417, 1257, 1721, 207, 765,
+    2058, 1723, 1258, 2240, 5, 1797, 2313, 422, 35, 2156, 1283, 60, 1482, 1516, 782, 643,
+    396, 103, 2303, 259, 1710, 1312, 1406, 1774, 1194, 1600, 798, 1609, 1886, 2089, 189, 1112,
+    2152, 1798, 1395, 1269, 600, 1649, 222, 862, 6, 1465, 36, 238, 2073, 1671, 2172, 76,
+    1364, 1824, 1958, 864, 525, 719, 1599, 2001, 1389, 155, 1277, 1433, 1536, 604, 1906, 807,
+    1398, 212, 614, 2273, 2124, 1028, 2288, 1548, 1825, 730, 1122, 2272, 982, 689, 1841, 1209,
+    1145, 2129, 2091, 2115, 1533, 443, 810, 2122, 1924, 1781, 1637, 7, 1020, 2318, 2287, 1808,
+    61, 311, 2187, 1287, 2094, 1793, 1113, 1999, 1993, 321, 1351, 2128, 717, 958, 1174, 758,
+    429, 410, 1418, 534, 603, 195, 444, 1762, 2182, 1281, 1457, 366, 2114, 1648, 37, 345,
+    1027, 1858, 595, 1524, 2180, 2305, 1130, 920, 2235, 707, 1677, 1730, 532, 1290, 2119, 1877,
+    536, 587, 331, 673, 1961, 1901, 382, 1390, 608, 1953, 1740, 1959, 2297, 934, 601, 989,
+    959, 720, 870, 777, 2123, 1518, 2290, 77, 571, 2002, 318, 1163, 1149, 531, 978, 1176,
+    559, 1523, 323, 2304, 2267, 171, 1456, 693, 1508, 2189, 196, 2061, 512, 907, 2044, 1767,
+    1529, 771, 799, 2250, 923, 1951, 747, 1534, 627, 78, 1985, 640, 1125, 1932, 1775, 968,
+    488, 104, 1987, 265, 2234, 1201, 1595, 533, 728, 1239, 2051, 933, 991, 208, 1915, 1768,
+    1659, 925, 1108, 699, 299, 8, 387, 826, 461, 1988, 62, 723, 79, 314, 619, 1530,
+    1415, 580, 1458, 2023, 1471, 1562, 2146, 375, 1540, 1444, 143, 709, 278, 1252, 2042, 1588,
+    1498, 772, 1624, 681, 762, 446, 1488, 1274, 1799, 9, 743, 342, 714, 38, 1371, 900,
+    814, 538, 869, 1363, 80, 251, 105, 1311, 1355, 1452, 1756, 1604, 2242, 132, 1357, 1172,
+    156, 1302, 1930, 455, 1359, 575, 1522, 735, 1207, 663, 2159, 1909, 1885, 209, 213, 698,
+    662, 957, 1254, 551, 448, 1150, 963, 1696, 239, 312, 1036, 1249, 315, 373, 624, 855,
+    820, 1783, 106, 2188, 1577, 710, 1566, 2085, 2065, 353, 2258, 1467, 1950, 1887, 144, 1461,
+    1099, 1010, 892, 1263, 1305, 1998, 1132, 1970, 2262, 548, 1047, 294, 2293, 2310, 2294, 2161,
+    1264, 1093, 2086, 1818, 1785, 1575, 2261, 303, 1450, 1493, 1059, 1870, 252, 483, 1928, 1507,
+    2054, 1397, 1314, 145, 1326, 404, 1043, 697, 2174, 1633, 1377, 1688, 611, 2071, 2053, 977,
+    1350, 776, 829, 2190, 1925, 478, 618, 1545, 39, 63, 1668, 1788, 1947, 830, 1835, 107,
+    1763, 260, 859, 2227, 2093, 1318, 1067, 2011, 524, 2158, 1881, 1210, 1144, 1625, 1310, 677,
+    984, 2008, 1856, 1040, 1022, 197, 1026, 1816, 1014, 674, 909, 1115, 1882, 364, 223, 866,
+    931, 2285, 10, 2274, 343, 40, 306, 1379, 944, 543, 2022, 93, 1897, 856, 499, 1391,
+    702, 2244, 822, 1654, 133, 2317, 266, 1559, 1035, 816, 599, 1747, 617, 1435, 1584, 1470,
+    577, 1472, 1233, 1823, 1300, 1030, 419, 344, 1369, 683, 81, 685, 2268, 392, 1914, 2048,
+    506, 1952, 1221, 535, 507, 602, 267, 157, 840, 1992, 165, 276, 1806, 929, 1894, 1899,
+    971, 752, 285, 1089, 1531, 1058, 1328, 383, 1544, 1755, 1957, 228, 41, 1905, 797, 1572,
+    82, 544, 1103, 397, 108, 2210, 796, 1064, 1623, 590, 711, 592, 1331, 166, 1017, 2217,
+    2087, 178, 286, 1029, 290, 1720, 1265, 2148, 1902, 530, 432, 2192, 1347, 1910, 2003, 11,
+    724, 1779, 1879, 585, 1431, 1852, 1449, 1519, 1863, 268, 405, 873, 510, 1011, 518, 547,
+    179, 2265, 1703, 1378, 606, 1830, 578, 416, 852, 1197, 2201, 1803, 229, 2099, 1680, 42,
+    701, 1986, 64, 1617, 899, 347, 1338, 818, 122, 451, 793, 2212, 279, 511, 2081, 1046,
+    1455, 708, 1291, 1686, 1304, 420, 1332, 2296, 434, 2255, 1106, 549, 2316, 2248, 1734, 398,
+    1219, 2104, 400, 1501, 726, 1008, 865, 1833, 517, 1454, 1334, 190, 362, 1226, 1657, 555,
+    1735, 1971, 634, 579, 992, 786, 1045, 1853, 976, 737, 845, 1225, 858, 1388, 1733, 261,
+    376, 1466, 1137, 2162, 906, 1381, 774, 1736, 1997, 1535, 1362, 1903, 1598, 1850, 1880, 12,
+    43, 1307, 1211, 1352, 2231, 1477, 995, 891, 2163, 2013, 1157, 2211, 502, 956, 1448, 1473,
+    1368, 919, 1789, 1096, 428, 1578, 475, 528, 1698, 1168, 2230, 13, 1828, 2151, 1771, 562,
+    482, 1051, 1866, 917, 109, 2251, 1643, 1503, 878, 134, 789, 853, 1567, 745, 1674, 2006,
+    780, 607, 1672, 1266, 2020, 1131, 1547, 1564, 2106, 14, 935, 1337, 1386, 770, 1844, 1839,
+    1289, 1114, 372, 486, 1092, 83, 1408, 764, 254, 1843, 1042, 402, 581, 1048, 1632, 272,
+    727, 1663, 491, 952, 1319, 854, 1969, 1179, 1942, 1744, 1750, 1945, 1151, 661, 1500, 1407,
+    15, 1876, 1055, 1053, 928, 1107, 390, 65, 1083, 1666, 1138, 1504, 94, 319, 836, 349,
+    905, 775, 1611, 972, 2173, 1095, 638, 1837, 1288, 172, 1409, 2269, 1761, 660, 1024, 962,
+    564, 2283, 894, 946, 1104, 1303, 1124, 214, 519, 479, 1790, 307, 2185, 1134, 391, 1487,
+    95, 1301, 824, 1539, 1679, 1327, 802, 983, 2057, 492, 639, 180, 1075, 1922, 1358, 215,
+    646, 44, 480, 2171, 110, 1205, 781, 426, 734, 123, 2170, 953, 545, 146, 355, 695,
+    895, 1893, 484, 641, 1356, 181, 630, 1813, 1871, 2141, 1954, 1855, 1702, 541, 1348, 216,
+    1402, 1590, 1086, 16, 234, 1751, 757, 45, 851, 2046, 246, 2034, 1489, 1005, 635, 472,
+    1556, 111, 1065, 763, 2062, 1612, 1136, 158, 356, 546, 2004, 656, 751, 2126, 173, 182,
+    287, 1913, 642, 198, 679, 2112, 844, 1592, 1154, 839, 1769, 742, 1009, 2038, 1509, 1082,
+    17, 235, 615, 46, 240, 2131, 84, 393, 1411, 1076, 2307, 694, 124, 1341, 1419, 147,
+    560, 326, 2300, 990, 280, 1591, 1286, 1155, 1384, 1819, 2177, 1941, 1063, 300, 369, 1349,
+    66, 1512, 112, 1394, 1401, 2167, 1468, 135, 879, 159, 327, 2209, 573, 1126, 2016, 174,
+    281, 183, 622, 332, 1085, 1442, 1180, 967, 1475, 1414, 18, 871, 1706, 1792, 47, 915,
+    247, 1664, 753, 96, 1121, 842, 2084, 1526, 1483, 125, 733, 2043, 377, 454, 1295, 809,
+    629, 2214, 282, 456, 494, 649, 1926, 922, 1618, 1410, 339, 1596, 1923, 927, 384, 1120,
+    1276, 1238, 2196, 520, 48, 1990, 2309, 1451, 505, 1432, 2132, 1227, 684, 1343, 427, 160,
+    1989, 1079, 167, 1242, 598, 576, 333, 431, 652, 1724, 1405, 2301, 2246, 49, 1317, 974,
+    67, 1766, 464, 1777, 148, 1066, 1918, 273, 2052, 1421, 493, 1838, 2096, 199, 2140, 2218,
+    1173, 794, 468, 849, 828, 224, 1752, 230, 1904, 368, 19, 628, 2191, 50, 1062, 996,
+    1714, 754, 248, 85, 1396, 721, 1511, 1546, 1038, 610, 1285, 136, 1387, 1049, 149, 657,
+    686, 1057, 1800, 875, 1031, 330, 1773, 200, 1728, 1204, 1177, 449, 304, 51, 552, 68,
+    1561, 2134, 522, 1261, 1478, 2113, 113, 500, 1214, 351, 872, 2164, 137, 738, 1236, 1080,
+    1129, 1159, 1889, 406, 2133, 2041, 808, 2021, 457, 1854, 430, 1019, 1505, 1071, 1991, 1188,
+    210, 417, 2315, 583, 1424, 1891, 2184, 20, 388, 241, 1693, 1627, 348, 1684, 1673, 1689,
+    114, 1153, 659, 1502, 2193, 1888, 1161, 969, 1807, 792, 787, 825, 1464, 1183, 283, 912,
+    1460, 191, 1558, 458, 201, 1949, 664, 1441, 297, 1795, 860, 1119, 225, 1506, 1851, 21,
+    236, 1895, 1661, 2253, 2101, 52, 1208, 69, 253, 566, 1279, 1243, 1229, 597, 126, 837,
+    1339, 2298, 1510, 1780, 761, 378, 274, 1920, 465, 1782, 954, 1603, 1900, 1213, 184, 1187,
+    1463, 1324, 848, 411, 192, 291, 1329, 1606, 633, 938, 1166, 433, 1748, 623, 1316, 970,
+    1178, 70, 1447, 1271, 1966, 2195, 1181, 127, 2220, 1323, 1636, 2076, 150, 269, 2289, 1731,
+    1786, 2047, 277, 1867, 1937, 1687, 288, 2206, 537, 334, 1848, 1167, 1580, 1193, 1845, 1549,
+    678, 2125, 1044, 22, 921, 964, 313, 1182, 350, 1553, 425, 890, 263, 452, 1425, 473,
+    151, 965, 1784, 360, 2216, 1494, 1811, 2308, 903, 1892, 301, 1691, 914, 1446, 2239, 975,
+    1306, 115, 2232, 2039, 1025, 264, 1965, 322, 1220, 567, 1707, 1719, 336, 2155, 1382, 385,
+    1860, 665, 1189, 2215, 2295, 1199, 1434, 885, 2063, 2247, 1770, 2237, 128, 616, 1215, 1628,
+    1557, 832, 1098, 403, 863, 1091, 1827, 490, 1169, 783, 1749, 760, 1367, 1490, 2037, 729,
+    1864, 1829, 750, 1033, 53, 1453, 346, 2018, 86, 394, 1712, 1195, 1041, 1184, 501, 1228,
+    1653, 1217, 1292, 773, 1102, 1105, 328, 1422, 2181, 357, 1462, 1190, 527, 1496, 732, 1224,
+    778, 1709, 1429, 645, 1267, 889, 979, 23, 1973, 1984, 504, 2027, 1655, 1621, 941, 1373,
+    1983, 676, 1581, 1537, 2078, 2279, 1732, 2107, 2202, 1697, 2157, 1336, 2138, 1874, 648, 292,
+    1481, 295, 2260, 1873, 1960, 2199, 2028, 675, 565, 1802, 242, 1004, 1001, 87, 898, 861,
+    1231, 716, 835, 1427, 1642, 950, 2024, 324, 161, 1981, 1443, 1116, 947, 1206, 175, 966,
+    185, 1491, 2229, 1007, 1836, 1563, 503, 1565, 2302, 1052, 704, 612, 1692, 54, 243, 1370,
+    1955, 1979, 932, 88, 2075, 1110, 2036, 255, 718, 1346, 2007, 791, 2015, 911, 138, 1127,
+    981, 1944, 626, 1175, 843, 877, 1513, 1117, 358, 1551, 2271, 2117, 593, 1593, 407, 186,
+    2186, 1821, 335, 1260, 337, 1737, 529, 882, 986, 1232, 217, 1360, 2226, 1246, 1629, 1616,
+    55, 1963, 999, 1069, 993, 741, 744, 2118, 1148, 1644, 2281, 1834, 888, 1428, 1933, 187,
+    1862, 1322, 1094, 2284, 1375, 1284, 1147, 1480, 1685, 1515, 231, 1794, 1667, 1753, 1298, 308,
+    399, 1746, 257, 1610, 1820, 1940, 162, 1832, 1635, 553, 1385, 1097, 2224, 1759, 1532, 1758,
+    414, 1607, 680, 1608, 1651, 1980, 1251, 1822, 418, 556, 226, 2319, 1527, 2136, 460, 341,
+    2082, 2219, 1272, 805, 2183, 987, 2254, 1700, 2026, 2111, 1974, 1907, 1139, 2110, 1583, 1638,
+    1713, 1333, 469, 1978, 1118, 24, 594, 1436, 916, 1645, 2179, 896, 1309, 1437, 939, 943,
+    1935, 523, 1726, 1582, 2031, 874, 1639, 2009, 354, 2256, 440, 1241, 2278, 168, 442, 176,
+    284, 2168, 188, 658, 1745, 1602, 1704, 961, 1445, 973, 367, 2109, 305, 423, 498, 1160,
+    309, 1012, 1372, 97, 256, 1675, 2035, 438, 801, 508, 2040, 1831, 1192, 574, 1315, 712,
+    1760, 1682, 2130, 218, 459, 2144, 739, 232, 447, 1074, 1842, 2064, 310, 462, 514, 2100,
+    1056, 89, 1757, 1550, 784, 116, 558, 1495, 632, 1459, 2000, 960, 613, 441, 902, 1293,
+    1594, 1237, 1223, 582, 2270, 177, 994, 705, 1739, 897, 1921, 2069, 338, 296, 945, 1917,
+    833, 421, 2166, 25, 2259, 1325, 1912, 725, 1380, 1705, 672, 715, 1202, 262, 586, 1313,
+    2074, 2263, 379, 2121, 1868, 949, 1738, 696, 924, 1248, 2090, 1514, 1776, 2050, 2291, 1764,
+    389, 56, 1678, 71, 857, 435, 1699, 569, 1340, 2080, 1171, 1088, 1321, 2049, 1815, 412,
+    1883, 838, 219, 26, 2223, 237, 1073, 370, 1109, 1658, 1141, 1037, 2175, 90, 2143, 1814,
+    395, 1000, 98, 703, 2266, 596, 2228, 1772, 1032, 2066, 756, 163, 1492, 1538, 1683, 687,
+    667, 1568, 202, 749, 901, 2176, 340, 2060, 1847, 1070, 1695, 813, 450, 2102, 117, 1404,
+    539, 1626, 2203, 1128, 401, 1996, 526, 1330, 1872, 1374, 644, 1630, 621, 795, 2070, 1068,
+    1230, 1589, 1826, 1742, 2280, 211, 1335, 1743, 768, 496, 1034, 463, 2221, 2205, 706, 1896,
+    748, 2149, 139, 453, 1078, 2276, 1725, 1817, 495, 1931, 1270, 2238, 940, 654, 1554, 1003
+};
+
 const apriltag_family_t tag36h10 = {
     .ncodes = 2320,
     .black_border = 1,
     .d = 6,
     .h = 10,
+    .sorted_ids = tag36h10_sorted_ids,
     .codes = {
         0x00000001ca92a687UL,
         0x000000020521ac4cUL,
@@ -7993,11 +8192,53 @@ const apriltag_family_t tag36h10 = {
 //////// "tag36h11"
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Code indices sorted by code value for quick_decode_exact().
+static const uint16_t tag36h11_sorted_ids[] = {
+    476, 283, 296, 208, 246, 510, 172, 6, 530, 138, 161, 237, 558, 418, 393, 176,
+    443, 394, 515, 577, 166, 349, 392, 206, 123, 249, 187, 302, 250, 297, 403, 538,
+    422, 528, 156, 493, 131, 429, 547, 447, 7, 364, 442, 361, 152, 359, 210, 572,
+    417, 570, 333, 372, 56, 427, 68, 189, 502, 197, 108, 178, 46, 179, 120, 581,
+    94, 313, 245, 279, 220, 281, 74, 153, 223, 196, 523, 477, 472, 353, 580, 199,
+    126, 318, 326, 8, 585, 300, 95, 525, 351, 146, 182, 9, 278, 47, 254, 345,
+    369, 501, 396, 171, 147, 231, 192, 317, 517, 173, 483, 582, 452, 362, 426, 267,
+    358, 31, 48, 514, 474, 298, 390, 242, 568, 508, 282, 268, 57, 416, 532, 583,
+    142, 98, 507, 473, 10, 482, 439, 526, 75, 461, 512, 360, 543, 563, 324, 397,
+    381, 356, 574, 87, 395, 150, 544, 375, 490, 391, 575, 11, 379, 562, 49, 387,
+    129, 467, 12, 32, 454, 541, 478, 487, 430, 485, 534, 165, 553, 13, 571, 524,
+    203, 376, 434, 469, 307, 99, 253, 135, 175, 137, 69, 303, 305, 215, 89, 520,
+    109, 494, 14, 560, 70, 216, 90, 559, 100, 334, 321, 15, 119, 259, 573, 465,
+    76, 365, 564, 308, 304, 540, 513, 262, 271, 33, 316, 521, 224, 408, 536, 260,
+    475, 16, 537, 241, 80, 145, 202, 77, 169, 471, 83, 557, 503, 234, 136, 159,
+    124, 280, 180, 211, 141, 274, 289, 34, 264, 185, 336, 71, 425, 101, 441, 158,
+    17, 35, 401, 448, 322, 140, 276, 535, 214, 18, 36, 58, 290, 511, 96, 37,
+    389, 263, 286, 181, 522, 116, 59, 186, 459, 188, 81, 332, 542, 411, 113, 339,
+    50, 121, 78, 410, 457, 240, 398, 419, 266, 342, 195, 127, 84, 384, 371, 565,
+    19, 184, 367, 498, 421, 584, 167, 314, 481, 191, 20, 550, 458, 257, 293, 151,
+    190, 435, 226, 164, 440, 21, 51, 354, 311, 229, 91, 415, 60, 350, 233, 567,
+    506, 309, 285, 446, 106, 491, 22, 38, 52, 61, 248, 405, 130, 227, 552, 272,
+    386, 148, 366, 62, 373, 275, 468, 480, 489, 566, 122, 451, 341, 432, 128, 157,
+    102, 288, 174, 258, 222, 368, 531, 299, 284, 273, 97, 295, 103, 400, 579, 200,
+    464, 132, 219, 556, 287, 23, 39, 505, 53, 218, 377, 125, 291, 551, 413, 24,
+    154, 412, 527, 144, 402, 518, 63, 72, 277, 466, 463, 88, 420, 92, 470, 492,
+    294, 545, 444, 569, 496, 555, 104, 212, 117, 319, 25, 40, 549, 504, 64, 149,
+    331, 168, 228, 388, 423, 193, 244, 431, 118, 26, 205, 160, 329, 374, 548, 194,
+    533, 352, 162, 407, 239, 255, 27, 320, 65, 66, 139, 252, 143, 437, 399, 346,
+    41, 155, 261, 509, 85, 462, 484, 236, 105, 54, 497, 460, 163, 221, 433, 310,
+    330, 115, 561, 347, 357, 378, 406, 306, 312, 213, 450, 55, 488, 344, 343, 404,
+    28, 42, 456, 232, 265, 170, 363, 110, 500, 0, 217, 207, 29, 486, 335, 516,
+    67, 133, 114, 1, 43, 325, 230, 578, 414, 315, 107, 134, 2, 382, 546, 111,
+    380, 201, 539, 238, 3, 30, 44, 251, 438, 499, 529, 204, 453, 177, 292, 338,
+    586, 554, 383, 79, 86, 93, 243, 576, 370, 348, 4, 409, 436, 495, 73, 82,
+    355, 198, 327, 455, 519, 209, 270, 247, 256, 5, 428, 449, 323, 424, 340, 445,
+    235, 337, 225, 183, 45, 301, 328, 269, 385, 112, 479
+};
+
 const apriltag_family_t tag36h11 = {
     .ncodes = 587,
     .black_border = 1,
     .d = 6,
     .h = 11,
+    .sorted_ids = tag36h11_sorted_ids,
     .codes = {
         0x0000000d5d628584UL,
         0x0000000d97f18b49UL,
@@ -8593,11 +8834,48 @@ const apriltag_family_t tag36h11 = {
 //////// "artoolkit"
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Code indices sorted by code value for quick_decode_exact().
+static const uint16_t artoolkit_sorted_ids[] = {
+    219, 218, 217, 216, 223, 222, 221, 220, 211, 210, 209, 208, 215, 214, 213, 212,
+    203, 202, 201, 200, 207, 206, 205, 204, 195, 194, 193, 192, 199, 198, 197, 196,
+    251, 250, 249, 248, 255, 254, 253, 252, 243, 242, 241, 240, 247, 246, 245, 244,
+    235, 234, 233, 232, 239, 238, 237, 236, 227, 226, 225, 224, 231, 230, 229, 228,
+    155, 154, 153, 152, 159, 158, 157, 156, 147, 146, 145, 144, 151, 150, 149, 148,
+    139, 138, 137, 136, 143, 142, 141, 140, 131, 130, 129, 128, 135, 134, 133, 132,
+    187, 186, 185, 184, 191, 190, 189, 188, 179, 178, 177, 176, 183, 182, 181, 180,
+    171, 170, 169, 168, 175, 174, 173, 172, 163, 162, 161, 160, 167, 166, 165, 164,
+    91, 90, 89, 88, 95, 94, 93, 92, 83, 82, 81, 80, 87, 86, 85, 84,
+    75, 74, 73, 72, 79, 78, 77, 76, 67, 66, 65, 64, 71, 70, 69, 68,
+    123, 122, 121, 120, 127, 126, 125, 124, 115, 114, 113, 112, 119, 118, 117, 116,
+    107, 106, 105, 104, 111, 110, 109, 108, 99, 98, 97, 96, 103, 102, 101, 100,
+    27, 26, 25, 24, 31, 30, 29, 28, 19, 18, 17, 16, 23, 22, 21, 20,
+    11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7, 6, 5, 4,
+    59, 58, 57, 56, 63, 62, 61, 60, 51, 50, 49, 48, 55, 54, 53, 52,
+    43, 42, 41, 40, 47, 46, 45, 44, 35, 34, 33, 32, 39, 38, 37, 36,
+    475, 474, 473, 472, 479, 478, 477, 476, 467, 466, 465, 464, 471, 470, 469, 468,
+    459, 458, 457, 456, 463, 462, 461, 460, 451, 450, 449, 448, 455, 454, 453, 452,
+    507, 506, 505, 504, 511, 510, 509, 508, 499, 498, 497, 496, 503, 502, 501, 500,
+    491, 490, 489, 488, 495, 494, 493, 492, 483, 482, 481, 480, 487, 486, 485, 484,
+    411, 410, 409, 408, 415, 414, 413, 412, 403, 402, 401, 400, 407, 406, 405, 404,
+    395, 394, 393, 392, 399, 398, 397, 396, 387, 386, 385, 384, 391, 390, 389, 388,
+    443, 442, 441, 440, 447, 446, 445, 444, 435, 434, 433, 432, 439, 438, 437, 436,
+    427, 426, 425, 424, 431, 430, 429, 428, 419, 418, 417, 416, 423, 422, 421, 420,
+    347, 346, 345, 344, 351, 350, 349, 348, 339, 338, 337, 336, 343, 342, 341, 340,
+    331, 330, 329, 328, 335, 334, 333, 332, 323, 322, 321, 320, 327, 326, 325, 324,
+    379, 378, 377, 376, 383, 382, 381, 380, 371, 370, 369, 368, 375, 374, 373, 372,
+    363, 362, 361, 360, 367, 366, 365, 364, 355, 354, 353, 352, 359, 358, 357, 356,
+    283, 282, 281, 280, 287, 286, 285, 284, 275, 274, 273, 272, 279, 278, 277, 276,
+    267, 266, 265, 264, 271, 270, 269, 268, 259, 258, 257, 256, 263, 262, 261, 260,
+    315, 314, 313, 312, 319, 318, 317, 316, 307, 306, 305, 304, 311, 310, 309, 308,
+    299, 298, 297, 296, 303, 302, 301, 300, 291, 290, 289, 288, 295, 294, 293, 292
+};
+
 const apriltag_family_t artoolkit = {
     .ncodes = 512,
     .black_border = 1,
     .d = 6,
     .h = 7,
+    .sorted_ids = artoolkit_sorted_ids,
     .codes = {
         0x0006dc269c27UL,
         0x0006d4229e26UL,
@@ -9169,29 +9447,17 @@ static inline uint32_t unionfind_get_representative(unionfind_t *uf, uint32_t id
 }
 */
 
-// this one seems to be every-so-slightly faster than the recursive
-// version above.
+// path halving: every node on the way to the root is pointed at its
+// grandparent. This flattens the tree in a single pass without the
+// second walk the two-pass collapsing version needs.
 static inline uint32_t unionfind_get_representative(unionfind_t *uf, uint32_t id)
 {
-    uint32_t root = id;
-
-    // chase down the root
-    while (uf->data[root].parent != root) {
-        root = uf->data[root].parent;
+    while (uf->data[id].parent != id) {
+        uf->data[id].parent = uf->data[uf->data[id].parent].parent;
+        id = uf->data[id].parent;
     }
 
-    // go back and collapse the tree.
-    //
-    // XXX: on some of our workloads that have very shallow trees
-    // (e.g. image segmentation), we are actually faster not doing
-    // this...
-    while (uf->data[id].parent != root) {
-        uint32_t tmp = uf->data[id].parent;
-        uf->data[id].parent = root;
-        id = tmp;
-    }
-
-    return root;
+    return id;
 }
 
 static inline uint32_t unionfind_connect(unionfind_t *uf, uint32_t aid, uint32_t bid)
@@ -9217,19 +9483,60 @@ static inline uint32_t unionfind_connect(unionfind_t *uf, uint32_t aid, uint32_t
 // because we use a fixed-point 16 bit integer representation with one
 // fractional bit.
 
-static inline uint32_t u64hash_2(uint64_t x) {
-    return (2654435761 * x) >> 32;
-    return (uint32_t) x;
-}
+// Edge points are grouped into clusters by sorting (cluster id, site)
+// records instead of hashing them into growing per-cluster arrays. Each
+// cluster's array is then allocated once at its exact size.
+#ifdef IMLIB_ENABLE_HIGH_RES_APRILTAGS
+typedef uint64_t cluster_id_t;
+#else
+typedef uint32_t cluster_id_t;
+#endif
 
-struct uint32_zarray_entry
-{
-    uint32_t id;
-    zarray_t *cluster;
+#define CLUSTER_ID_SHIFT (sizeof(cluster_id_t) * 4)
 
-    struct uint32_zarray_entry *next;
+struct cluster_rec
+{
+    // (larger rep << CLUSTER_ID_SHIFT) + smaller rep
+    cluster_id_t id;
+    // (pixel index << 3) | (connection << 1) | (v1 > v0)
+    uint32_t site;
 };
 
+// LSD radix sort of n records by id, 8 bits per pass. Passes where every
+// id has the same digit are skipped, so small images only do a few. The
+// sort is stable which keeps the points of each cluster in scan order.
+// Returns whichever of the two buffers holds the sorted records.
+static struct cluster_rec *cluster_rec_sort(struct cluster_rec *a, struct cluster_rec *b, uint32_t n)
+{
+    for (int shift = 0; (n > 1) && (shift < (sizeof(cluster_id_t) * 8)); shift += 8) {
+        uint32_t hist[256] = {0};
+
+        for (uint32_t i = 0; i < n; i++) {
+            hist[(a[i].id >> shift) & 0xff]++;
+        }
+
+        if (hist[(a[0].id >> shift) & 0xff] == n) {
+            continue;
+        }
+
+        for (uint32_t k = 0, sum = 0; k < 256; k++) {
+            uint32_t count = hist[k];
+            hist[k] = sum;
+            sum += count;
+        }
+
+        for (uint32_t i = 0; i < n; i++) {
+            b[hist[(a[i].id >> shift) & 0xff]++] = a[i];
+        }
+
+        struct cluster_rec *t = a;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
 #ifndef M_PI
 # define M_PI 3.141592653589793238462643383279502884196
 #endif
@@ -10593,10 +10900,8 @@ zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im, bool ove
         do_unionfind_line(uf, threshim, h, w, ts, y);
     }
 
-    uint32_t nclustermap;
-    struct uint32_zarray_entry **clustermap = fb_alloc0_all(&nclustermap, FB_ALLOC_PREFER_SPEED);
-    nclustermap /= sizeof(struct uint32_zarray_entry*);
-    if (!nclustermap) fb_alloc_fail();
+    // Count the edge points first so the records can be allocated once.
+    uint32_t nrecs = 0;
 
     for (int y = 1; y < h-1; y++) {
         for (int x = 1; x < w-1; x++) {
@@ -10605,6 +10910,37 @@ zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im, bool ove
             if (v0 == 127)
                 continue;
 
+#define COUNT_CONN(dx, dy) nrecs += ((v0 + threshim->buf[y*ts + dy*ts + x + dx]) == 255);
+            COUNT_CONN(1, 0);
+            COUNT_CONN(0, 1);
+
+#ifdef IMLIB_ENABLE_FINE_APRILTAGS
+            COUNT_CONN(-1, 1);
+            COUNT_CONN(1, 1);
+#endif
+#undef COUNT_CONN
+        }
+    }
+
+    // Keep as many points as fit if the heap is short, like zarray_add_fail_ok().
+    struct cluster_rec *recs = NULL, *recs_tmp = NULL;
+    for (; nrecs; nrecs /= 2) {
+        recs = umm_malloc(nrecs * sizeof(struct cluster_rec));
+        recs_tmp = recs ? umm_malloc(nrecs * sizeof(struct cluster_rec)) : NULL;
+        if (recs_tmp) break;
+        if (recs) umm_free(recs);
+        recs = NULL;
+    }
+
+    uint32_t nrec = 0;
+
+    for (int y = 1; (y < h-1) && (nrec < nrecs); y++) {
+        for (int x = 1; x < w-1; x++) {
+
+            uint8_t v0 = threshim->buf[y*ts + x];
+            if (v0 == 127)
+                continue;
+
             // XXX don't query this until we know we need it?
             uint32_t rep0 = unionfind_get_representative(uf, y*w + x);
 
@@ -10628,93 +10964,83 @@ zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im, bool ove
             // A possible optimization would be to combine entries
             // within the same cluster.
 
-#define DO_CONN(dx, dy)                                                 \
-            if (1) {                                                    \
+#define DO_CONN(dx, dy, conn)                                           \
+            if (nrec < nrecs) {                                         \
                 uint8_t v1 = threshim->buf[y*ts + dy*ts + x + dx];      \
                                                                         \
-                while (v0 + v1 == 255) {                                   \
+                if (v0 + v1 == 255) {                                   \
                     uint32_t rep1 = unionfind_get_representative(uf, y*w + dy*w + x + dx); \
-                    uint32_t clusterid;                                 \
                     if (rep0 < rep1)                                    \
-                        clusterid = (rep1 << 16) + rep0;                \
+                        recs[nrec].id = ((cluster_id_t) rep1 << CLUSTER_ID_SHIFT) + rep0; \
                     else                                                \
-                        clusterid = (rep0 << 16) + rep1;                \
-                                                                        \
-                    /* XXX lousy hash function */                       \
-                    uint32_t clustermap_bucket = u64hash_2(clusterid) % nclustermap; \
-                    struct uint32_zarray_entry *entry = clustermap[clustermap_bucket]; \
-                    while (entry && entry->id != clusterid)     {       \
-                        entry = entry->next;                            \
-                    }                                                   \
-                                                                        \
-                    if (!entry) {                                       \
-                        entry = umm_calloc(1, sizeof(struct uint32_zarray_entry)); \
-                        if (!entry) break;                              \
-                        entry->id = clusterid;                          \
-                        entry->cluster = zarray_create_fail_ok(sizeof(struct pt)); \
-                        if (!entry->cluster) {                          \
-                            free(entry);                                \
-                            break;                                      \
-                        }                                               \
-                        entry->next = clustermap[clustermap_bucket];    \
-                        clustermap[clustermap_bucket] = entry;          \
-                    }                                                   \
-                                                                        \
-                    struct pt p = { .x = 2*x + dx, .y = 2*y + dy, .gx = dx*((int) v1-v0), .gy = dy*((int) v1-v0)}; \
-                    zarray_add_fail_ok(entry->cluster, &p);             \
-                    break;                                              \
+                        recs[nrec].id = ((cluster_id_t) rep0 << CLUSTER_ID_SHIFT) + rep1; \
+                    recs[nrec++].site = ((y*w + x) << 3) | (conn << 1) | (v1 > v0); \
                 }                                                       \
             }
 
             // do 4 connectivity. NB: Arguments must be [-1, 1] or we'll overflow .gx, .gy
-            DO_CONN(1, 0);
-            DO_CONN(0, 1);
+            DO_CONN(1, 0, 0);
+            DO_CONN(0, 1, 1);
 
 #ifdef IMLIB_ENABLE_FINE_APRILTAGS
             // do 8 connectivity
-            DO_CONN(-1, 1);
-            DO_CONN(1, 1);
+            DO_CONN(-1, 1, 2);
+            DO_CONN(1, 1, 3);
 #endif
         }
     }
 #undef DO_CONN
 
+    struct cluster_rec *sorted = recs;
+    if (recs) {
+        sorted = cluster_rec_sort(recs, recs_tmp, nrec);
+        umm_free((sorted == recs) ? recs_tmp : recs);
+    }
+
     ////////////////////////////////////////////////////////
     // step 3. process each connected component.
-    zarray_t *clusters = zarray_create_fail_ok(sizeof(zarray_t*)); //, uint32_zarray_hash_size(clustermap));
+    static const int8_t conn_dxdy[4][2] = { {1, 0}, {0, 1}, {-1, 1}, {1, 1} };
+    zarray_t *clusters = zarray_create_fail_ok(sizeof(zarray_t*));
     if (clusters) {
-        for (int i = 0; i < nclustermap; i++) {
+        for (uint32_t i = 0, j; i < nrec; i = j) {
+            for (j = i + 1; (j < nrec) && (sorted[j].id == sorted[i].id); j++);
 
-            for (struct uint32_zarray_entry *entry = clustermap[i]; entry; entry = entry->next) {
-                // XXX reject clusters here?
-                zarray_add_fail_ok(clusters, &entry->cluster);
+            zarray_t *cluster = zarray_create_fail_ok(sizeof(struct pt));
+            if (!cluster)
+                break;
+
+            cluster->data = umm_malloc((j - i) * sizeof(struct pt));
+            if (!cluster->data) {
+                zarray_destroy(cluster);
+                break;
             }
-        }
-    }
 
+            cluster->alloc = j - i;
+            struct pt *pts = (struct pt *) cluster->data;
 
-    int sz = clusters ? zarray_size(clusters) : 0;
+            for (uint32_t k = i; k < j; k++) {
+                uint32_t site = sorted[k].site, idx = site >> 3;
+                int dx = conn_dxdy[(site >> 1) & 3][0];
+                int dy = conn_dxdy[(site >> 1) & 3][1];
+                int dv = (site & 1) ? 255 : -255;
+                pts[cluster->size++] = (struct pt) { .x = 2*(idx % w) + dx, .y = 2*(idx / w) + dy,
+                                                     .gx = dx*dv, .gy = dy*dv };
+            }
 
-    if (1) {
-      for (int i = 0; i < nclustermap; i++) {
-        struct uint32_zarray_entry *entry = clustermap[i];
-        while (entry) {
-          // free any leaked cluster (zarray_add_fail_ok)
-          bool leaked = true;
-          for (int j = 0; j < sz && leaked; j++) {
-              zarray_t *cluster;
-              zarray_get(clusters, j, &cluster);
-              leaked &= entry->cluster != cluster;
-          }
-          if (leaked) free(entry->cluster);
-          struct uint32_zarray_entry *tmp = entry->next;
-          free(entry);
-          entry = tmp;
+            // XXX reject clusters here?
+            int nclusters = zarray_size(clusters);
+            zarray_add_fail_ok(clusters, &cluster);
+            if (zarray_size(clusters) == nclusters) {
+                zarray_destroy(cluster);
+                break;
+            }
         }
-      }
-      fb_free(); // clustermap
     }
 
+    if (sorted) umm_free(sorted);
+
+    int sz = clusters ? zarray_size(clusters) : 0;
+
     unionfind_destroy();
 
     fb_free(); // threshim->buf
@@ -10723,7 +11049,7 @@ zarray_t *apriltag_quad_thresh(apriltag_detector_t *td, image_u8_t *im, bool ove
     zarray_t *quads = zarray_create_fail_ok(sizeof(struct quad));
 
     if (quads) {
-        for (int i = 0; i < sz; i++) {
+        for (int i = 0; (i < sz) && !imlib_deadline_expired(td->deadline); i++) {
 
             zarray_t *cluster;
             zarray_get(clusters, i, &cluster);
@@ -10974,12 +11300,56 @@ int popcount64c(uint64_t x)
     return (x * h01) >> 56;  //returns left 8 bits of x + (x<<8) + (x<<16) + (x<<24) + ...
 }
 
+// returns the id of the code equal to rcode or -1 if there is none.
+static int quick_decode_exact(apriltag_family_t *tf, uint64_t rcode)
+{
+    int lo = 0, hi = tf->ncodes - 1;
+
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        int id = tf->sorted_ids[mid];
+
+        if (tf->codes[id] == rcode) {
+            return id;
+        } else if (tf->codes[id] < rcode) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+
+    return -1;
+}
+
 // returns an entry with hamming set to 255 if no decode was found.
 static void quick_decode_codeword(apriltag_family_t *tf, uint64_t rcode,
                                   struct quick_decode_entry *entry)
 {
     int threshold = imax(tf->h - tf->d - 1, 0);
 
+    // Most tags decode without any bit errors, so the orientations below are first searched
+    // for an exact match using the sorted ids before the linear hamming distance search.
+    uint64_t code = rcode;
+
+    for (int i = 0; i < 16; i++) {
+        int id = quick_decode_exact(tf, code);
+        if (id >= 0) {
+            entry->rcode = code;
+            entry->id = id;
+            entry->hamming = 0;
+            entry->rotation = i & 3;
+            entry->hmirror = ((i >> 2) == 1) || ((i >> 2) == 2);
+            entry->vflip = ((i >> 2) == 2) || ((i >> 2) == 3);
+            return;
+        }
+
+        code = rotate90(code, tf->d);
+
+        if ((i & 3) == 3) {
+            code = ((i >> 2) == 1) ? vflip_code(code, tf->d) : hmirror_code(code, tf->d);
+        }
+    }
+
     for (int ridx = 0; ridx < 4; ridx++) {
 
         for (int i = 0, j = tf->ncodes; i < j; i++) {
@@ -11103,6 +11473,7 @@ apriltag_detector_t *apriltag_detector_create()
 
     td->tag_families = zarray_create(sizeof(apriltag_family_t*));
 
+    td->quad_decimate = 1;
     td->refine_edges = 1;
     td->refine_pose = 0;
     td->refine_decode = 0;
@@ -11573,7 +11944,7 @@ static void refine_edges(apriltag_detector_t *td, image_u8_t *im_orig, struct qu
             // search on another pixel in the first place. Likewise,
             // for very small tags, we don't want the range to be too
             // big.
-            float range = 1.0 + 1;
+            float range = td->quad_decimate + 1;
 
             // XXX tunable step size.
             for (float n = -range; n <= range; n +=  0.25) {
@@ -11707,7 +12078,36 @@ zarray_t *apriltag_detector_detect(apriltag_detector_t *td, image_u8_t *im_orig)
     // and blurring parameters.
 
 //    zarray_t *quads = apriltag_quad_gradient(td, im_orig);
-    zarray_t *quads = apriltag_quad_thresh(td, im_orig, false);
+    zarray_t *quads;
+
+    if (td->quad_decimate > 1) {
+        image_t src, dst;
+        image_init(&src, im_orig->width, im_orig->height, PIXFORMAT_GRAYSCALE, 0, im_orig->buf);
+        image_init(&dst, im_orig->width / td->quad_decimate, im_orig->height / td->quad_decimate,
+                   PIXFORMAT_GRAYSCALE, 0, NULL);
+        dst.data = fb_alloc(image_size(&dst), FB_ALLOC_NO_HINT);
+
+        float scale = 1.f / td->quad_decimate;
+        imlib_draw_image(&dst, &src, 0, 0, scale, scale, NULL, -1, 256, NULL, NULL,
+                         IMAGE_HINT_AREA, NULL, NULL, NULL);
+
+        image_u8_t im_quads = { .width = dst.w, .height = dst.h, .stride = dst.w, .buf = dst.data };
+        quads = apriltag_quad_thresh(td, &im_quads, false);
+        fb_free(); // im_quads
+
+        // Map the quad corners from decimated pixel centers back to full resolution pixel centers.
+        for (int i = 0; i < zarray_size(quads); i++) {
+            struct quad *q;
+            zarray_get_volatile(quads, i, &q);
+
+            for (int j = 0; j < 4; j++) {
+                q->p[j][0] = ((q->p[j][0] + 0.5f) * td->quad_decimate) - 0.5f;
+                q->p[j][1] = ((q->p[j][1] + 0.5f) * td->quad_decimate) - 0.5f;
+            }
+        }
+    } else {
+        quads = apriltag_quad_thresh(td, im_orig, false);
+    }
 
     zarray_t *detections = zarray_create(sizeof(apriltag_detection_t*));
 
@@ -11716,7 +12116,7 @@ zarray_t *apriltag_detector_detect(apriltag_detector_t *td, image_u8_t *im_orig)
     ////////////////////////////////////////////////////////////////
     // Step 2. Decode tags from each quad.
     if (1) {
-        for (int i = 0; i < zarray_size(quads); i++) {
+        for (int i = 0; (i < zarray_size(quads)) && !imlib_deadline_expired(td->deadline); i++) {
             struct quad *quad_original;
             zarray_get_volatile(quads, i, &quad_original);
 
@@ -11938,16 +12338,20 @@ void apriltag_detections_destroy(zarray_t *detections)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 void imlib_find_apriltags(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_families_t families,
-                          float fx, float fy, float cx, float cy)
+                          float fx, float fy, float cx, float cy, int decimate, imlib_deadline_t *deadline)
 {
     // Frame Buffer Memory Usage...
     // -> GRAYSCALE Input Image = w*h*1
-    // -> GRAYSCALE Threhsolded Image = w*h*1
-    // -> UnionFind = w*h*2 (+w*h*1 for hash table)
+    // -> GRAYSCALE Decimated Image = (w/d)*(h/d)*1 (if d > 1)
+    // -> GRAYSCALE Threhsolded Image = (w/d)*(h/d)*1
+    // -> UnionFind = (w/d)*(h/d)*2
     size_t resolution = roi->w * roi->h;
-    size_t fb_alloc_need = resolution * (1 + 1 + 2 + 1); // read above...
+    size_t quad_resolution = (roi->w / decimate) * (roi->h / decimate);
+    size_t fb_alloc_need = resolution + (quad_resolution * ((decimate > 1) + 1 + 2)); // read above...
     umm_init_x(((fb_avail() - fb_alloc_need) / resolution) * resolution);
     apriltag_detector_t *td = apriltag_detector_create();
+    td->quad_decimate = decimate;
+    td->deadline = deadline;
 
     if (families & TAG16H5) {
         apriltag_detector_add_family(td, (apriltag_family_t *) &tag16h5);
@@ -11973,7 +12377,7 @@ void imlib_find_apriltags(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_
         apriltag_detector_add_family(td, (apriltag_family_t *) &artoolkit);
     }
 
-    image_t img;
+    image_t img = {};
     img.w = roi->w;
     img.h = roi->h;
     img.pixfmt = PIXFORMAT_GRAYSCALE;
@@ -12062,22 +12466,154 @@ void imlib_find_apriltags(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_
     apriltag_detections_destroy(detections);
     fb_free(); // grayscale_image;
     apriltag_detector_destroy(td);
+    umm_deinit();
     fb_free(); // umm_init_x();
 }
 
+void imlib_track_apriltags(find_apriltags_tracker_t *tracker, list_t *out, image_t *ptr, rectangle_t *roi,
+                           apriltag_families_t families, float fx, float fy, float cx, float cy, int decimate,
+                           imlib_deadline_t *deadline)
+{
+    int search_margin = tracker->search_margin;
+    bool full_scan = (!list_size(&tracker->tracks)) || (tracker->frames >= tracker->full_scan_interval);
+
+    if (!full_scan) {
+        // Search around where each tag is predicted to be given its motion over the last frame.
+        list_t rects;
+        list_init(&rects, sizeof(rectangle_t));
+
+        list_for_each(it, (&tracker->tracks)) {
+            find_apriltags_track_t *track = list_get_data(it);
+            rectangle_t rect;
+            rectangle_init(&rect, track->rect.x + track->dx - search_margin, track->rect.y + track->dy - search_margin,
+                           track->rect.w + (search_margin * 2), track->rect.h + (search_margin * 2));
+
+            if (rectangle_overlap(&rect, roi)) {
+                rectangle_intersected(&rect, roi);
+                list_push_back(&rects, &rect);
+            }
+        }
+
+        // Merge overlapping search areas so that no tag is found twice.
+        for (bool merged = true; merged;) {
+            merged = false;
+
+            list_for_each(it0, (&rects)) {
+                rectangle_t *rect0 = list_get_data(it0);
+
+                for (list_lnk_t *it1 = it0->next; it1; it1 = it1->next) {
+                    rectangle_t rect1;
+
+                    if (rectangle_overlap(rect0, list_get_data(it1))) {
+                        list_remove(&rects, it1, &rect1);
+                        rectangle_united(rect0, &rect1);
+                        merged = true;
+                        break;
+                    }
+                }
+
+                if (merged) {
+                    break;
+                }
+            }
+        }
+
+        list_init(out, sizeof(find_apriltags_list_lnk_data_t));
+
+        while (list_size(&rects) && !imlib_deadline_expired(deadline)) {
+            rectangle_t rect;
+            list_t tags;
+            list_pop_front(&rects, &rect);
+
+            if ((rect.w < (4 * decimate)) || (rect.h < (4 * decimate))) {
+                continue;
+            }
+
+            // The pose is computed from the search area homography, so move the optical center with it.
+            imlib_find_apriltags(&tags, ptr, &rect, families, fx, fy,
+                                 cx - (rect.x - roi->x), cy - (rect.y - roi->y), decimate, deadline);
+
+            while (list_size(&tags)) {
+                list_move_back(out, &tags, tags.head);
+            }
+        }
+
+        list_free(&rects);
+
+        // Fall back to a full scan when any tag was lost, unless out of time.
+        full_scan = (list_size(out) < list_size(&tracker->tracks)) && !imlib_deadline_expired(deadline);
+
+        if (full_scan) {
+            list_free(out);
+        }
+    }
+
+    if (full_scan) {
+        imlib_find_apriltags(out, ptr, roi, families, fx, fy, cx, cy, decimate, deadline);
+    }
+
+    tracker->frames = full_scan ? 1 : (tracker->frames + 1);
+
+    // Match each tag to the closest unclaimed tag from the last frame to estimate its motion.
+    list_t tracks;
+    list_init(&tracks, sizeof(find_apriltags_track_t));
+
+    list_for_each(it, out) {
+        find_apriltags_list_lnk_data_t *lnk_data = list_get_data(it);
+        int tx = lnk_data->rect.x + (lnk_data->rect.w / 2);
+        int ty = lnk_data->rect.y + (lnk_data->rect.h / 2);
+        list_lnk_t *best = NULL;
+        int best_dist = INT_MAX;
+
+        list_for_each(jt, (&tracker->tracks)) {
+            find_apriltags_track_t *track = list_get_data(jt);
+            rectangle_t rect;
+            rectangle_init(&rect, track->rect.x + track->dx - search_margin, track->rect.y + track->dy - search_margin,
+                           track->rect.w + (search_margin * 2), track->rect.h + (search_margin * 2));
+
+            if (rectangle_overlap(&rect, &lnk_data->rect)) {
+                int dx = tx - (track->rect.x + (track->rect.w / 2));
+                int dy = ty - (track->rect.y + (track->rect.h / 2));
+                int dist = (dx * dx) + (dy * dy);
+
+                if (dist < best_dist) {
+                    best_dist = dist;
+                    best = jt;
+                }
+            }
+        }
+
+        find_apriltags_track_t track = { .dx = 0, .dy = 0 };
+
+        if (best) {
+            find_apriltags_track_t old;
+            list_remove(&tracker->tracks, best, &old);
+            track.dx = tx - (old.rect.x + (old.rect.w / 2));
+            track.dy = ty - (old.rect.y + (old.rect.h / 2));
+        }
+
+        rectangle_copy(&track.rect, &lnk_data->rect);
+        list_push_back(&tracks, &track);
+    }
+
+    // Tags from the last frame that were not found again are dropped.
+    list_free(&tracker->tracks);
+    tracker->tracks = tracks;
+}
+
 #ifdef IMLIB_ENABLE_FIND_RECTS
 void imlib_find_rects(list_t *out, image_t *ptr, rectangle_t *roi, uint32_t threshold)
 {
     // Frame Buffer Memory Usage...
     // -> GRAYSCALE Input Image = w*h*1
     // -> GRAYSCALE Threhsolded Image = w*h*1
-    // -> UnionFind = w*h*2 (+w*h*1 for hash table)
+    // -> UnionFind = w*h*2
     size_t resolution = roi->w * roi->h;
-    size_t fb_alloc_need = resolution * (1 + 1 + 2 + 2); // read above...
+    size_t fb_alloc_need = resolution * (1 + 1 + 2 + 1); // read above...
     umm_init_x(((fb_avail() - fb_alloc_need) / resolution) * resolution);
     apriltag_detector_t *td = apriltag_detector_create();
 
-    image_t img;
+    image_t img = {};
     img.w = roi->w;
     img.h = roi->h;
     img.pixfmt = PIXFORMAT_GRAYSCALE;
@@ -12257,6 +12793,7 @@ void imlib_find_rects(list_t *out, image_t *ptr, rectangle_t *roi, uint32_t thre
     zarray_destroy(detections);
     fb_free(); // grayscale_image;
     apriltag_detector_destroy(td);
+    umm_deinit();
     fb_free(); // umm_init_x();
 }
 #endif //IMLIB_ENABLE_FIND_RECTS
@@ -12522,6 +13059,7 @@ void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation, float
     matd_destroy(RX);
     matd_destroy(A1);
 
+    umm_deinit();
     fb_free(); // umm_init_x();
 
     fb_free();
@@ -263,29 +263,30 @@ static inline vrgb_pixels_t vdebayer_all_1(image_t *src, v128_t row_0, v128_t ro
 // created by debayering the image.
 static inline v4x_row_ptrs_t vdebayer_rowptrs_init(const image_t *src, int32_t y) {
     v4x_row_ptrs_t rowptrs;
+    int32_t stride = IMAGE_GRAYSCALE_ROW_STRIDE(src);
 
     // keep row pointers in bounds
     if (y == 0) {
         rowptrs.p1.u8 = src->data;
-        rowptrs.p2.u8 = rowptrs.p1.u8 + ((src->h >= 2) ? src->w : 0);
-        rowptrs.p3.u8 = rowptrs.p1.u8 + ((src->h >= 3) ? (src->w * 2) : 0);
+        rowptrs.p2.u8 = rowptrs.p1.u8 + ((src->h >= 2) ? stride : 0);
+        rowptrs.p3.u8 = rowptrs.p1.u8 + ((src->h >= 3) ? (stride * 2) : 0);
         rowptrs.p0.u8 = rowptrs.p2.u8;
     } else if (y == (src->h - 2)) {
-        rowptrs.p0.u8 = src->data + ((y - 1) * src->w);
-        rowptrs.p1.u8 = rowptrs.p0.u8 + src->w;
-        rowptrs.p2.u8 = rowptrs.p1.u8 + src->w;
+        rowptrs.p0.u8 = src->data + ((y - 1) * stride);
+        rowptrs.p1.u8 = rowptrs.p0.u8 + stride;
+        rowptrs.p2.u8 = rowptrs.p1.u8 + stride;
         rowptrs.p3.u8 = rowptrs.p1.u8;
     } else if (y == (src->h - 1)) {
-        rowptrs.p0.u8 = src->data + ((y - 1) * src->w);
-        rowptrs.p1.u8 = rowptrs.p0.u8 + src->w;
+        rowptrs.p0.u8 = src->data + ((y - 1) * stride);
+        rowptrs.p1.u8 = rowptrs.p0.u8 + stride;
         rowptrs.p2.u8 = rowptrs.p0.u8;
         rowptrs.p3.u8 = rowptrs.p1.u8;
     } else {
         // get 4 neighboring rows
-        rowptrs.p0.u8 = src->data + ((y - 1) * src->w);
-        rowptrs.p1.u8 = rowptrs.p0.u8 + src->w;
-        rowptrs.p2.u8 = rowptrs.p1.u8 + src->w;
-        rowptrs.p3.u8 = rowptrs.p2.u8 + src->w;
+        rowptrs.p0.u8 = src->data + ((y - 1) * stride);
+        rowptrs.p1.u8 = rowptrs.p0.u8 + stride;
+        rowptrs.p2.u8 = rowptrs.p1.u8 + stride;
+        rowptrs.p3.u8 = rowptrs.p2.u8 + stride;
     }
 
     // Shift loaded pointers up by 1 to account for the offset created by debayering the image.
@@ -298,18 +299,19 @@ static inline v4x_row_ptrs_t vdebayer_rowptrs_init(const image_t *src, int32_t y
 
 static inline v2x_row_ptrs_t vdebayer_quarter_rowptrs_init(const image_t *src, int32_t y) {
     v2x_row_ptrs_t rowptrs;
+    int32_t stride = IMAGE_GRAYSCALE_ROW_STRIDE(src);
 
     // keep row pointers in bounds
     if (y == 0) {
         rowptrs.p0.u8 = src->data;
-        rowptrs.p1.u8 = rowptrs.p0.u8 + ((src->h >= 2) ? src->w : 0);
+        rowptrs.p1.u8 = rowptrs.p0.u8 + ((src->h >= 2) ? stride : 0);
     } else if (y == (src->h - 1)) {
-        rowptrs.p0.u8 = src->data + (y * src->w);
-        rowptrs.p1.u8 = rowptrs.p0.u8 - src->w;
+        rowptrs.p0.u8 = src->data + (y * stride);
+        rowptrs.p1.u8 = rowptrs.p0.u8 - stride;
     } else {
         // get 2 neighboring rows
-        rowptrs.p0.u8 = src->data + (y * src->w);
-        rowptrs.p1.u8 = rowptrs.p0.u8 + src->w;
+        rowptrs.p0.u8 = src->data + (y * stride);
+        rowptrs.p1.u8 = rowptrs.p0.u8 + stride;
     }
 
     return rowptrs;
@@ -1145,7 +1147,7 @@ void imlib_debayer_line(int x_start, int x_end, int y_row, void *dst_row_ptr, pi
 // assumes dst->h == src->h
 // src and dst may not overlap, but, faster than imlib_debayer_image_awb
 void imlib_debayer_image(image_t *dst, image_t *src) {
-    OMV_PROFILE_START();
+    OMV_PROFILE_START(debayer);
     rectangle_t roi = {
         .x = 0,
         .y = 0,
@@ -1153,7 +1155,7 @@ void imlib_debayer_image(image_t *dst, image_t *src) {
         .h = src->h,
     };
     vdebayer(src, &roi, 0, dst);
-    OMV_PROFILE_PRINT();
+    OMV_PROFILE_END(debayer);
 }
 
 #if defined(IMLIB_ENABLE_DEBAYER_OPTIMIZATION)
@@ -2279,7 +2281,7 @@ static void vdebayer_rggb_to_rgb565_awb_quarter(image_t *src, image_t *dst, uint
 // RGB565: src->data == dst->data + image_size(src)
 // YUV422: Not supported
 void imlib_debayer_image_awb(image_t *dst, image_t *src, bool fast, uint32_t r_out, uint32_t g_out, uint32_t b_out) {
-    OMV_PROFILE_START();
+    OMV_PROFILE_START(debayer_awb);
 
     uint32_t red_gain = IM_DIV(g_out * 32, r_out);
     red_gain = IM_MIN(red_gain, 128U);
@@ -2445,5 +2447,57 @@ void imlib_debayer_image_awb(image_t *dst, image_t *src, bool fast, uint32_t r_o
         }
     }
 
-    OMV_PROFILE_PRINT();
+    OMV_PROFILE_END(debayer_awb);
+}
+
+// assumes dst->w == src->w / 2
+// assumes dst->h == src->h / 2
+// src and dst may not overlap
+// Each 2x2 bayer quad becomes one output pixel so no interpolation is done at all, which is
+// much faster than debayering at full resolution when the image is being shrunk anyway.
+// BINARY: Not supported
+// YUV422: Not supported
+void imlib_debayer_image_half(image_t *dst, image_t *src) {
+    OMV_PROFILE_START(debayer_half);
+
+    // 32 is a gain of 1.0.
+    switch (src->pixfmt) {
+        case PIXFORMAT_BAYER_BGGR: {
+            if (dst->pixfmt == PIXFORMAT_GRAYSCALE) {
+                vdebayer_bggr_to_grayscale_awb_quarter(src, dst, 32, 32);
+            } else {
+                vdebayer_bggr_to_rgb565_awb_quarter(src, dst, 32, 32);
+            }
+            break;
+        }
+        case PIXFORMAT_BAYER_GBRG: {
+            if (dst->pixfmt == PIXFORMAT_GRAYSCALE) {
+                vdebayer_gbrg_to_grayscale_awb_quarter(src, dst, 32, 32);
+            } else {
+                vdebayer_gbrg_to_rgb565_awb_quarter(src, dst, 32, 32);
+            }
+            break;
+        }
+        case PIXFORMAT_BAYER_GRBG: {
+            if (dst->pixfmt == PIXFORMAT_GRAYSCALE) {
+                vdebayer_grbg_to_grayscale_awb_quarter(src, dst, 32, 32);
+            } else {
+                vdebayer_grbg_to_rgb565_awb_quarter(src, dst, 32, 32);
+            }
+            break;
+        }
+        case PIXFORMAT_BAYER_RGGB: {
+            if (dst->pixfmt == PIXFORMAT_GRAYSCALE) {
+                vdebayer_rggb_to_grayscale_awb_quarter(src, dst, 32, 32);
+            } else {
+                vdebayer_rggb_to_rgb565_awb_quarter(src, dst, 32, 32);
+            }
+            break;
+        }
+        default: {
+            __builtin_unreachable();
+        }
+    }
+
+    OMV_PROFILE_END(debayer_half);
 }
@@ -119,15 +119,44 @@ void imlib_mask_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data
 
 #ifdef IMLIB_ENABLE_BINARY_OPS
 void imlib_binary(image_t *out, image_t *img, list_t *thresholds, bool invert, bool zero, image_t *mask) {
-    image_t bmp;
+    image_t bmp = {};
     bmp.w = img->w;
     bmp.h = img->h;
     bmp.pixfmt = PIXFORMAT_BINARY;
     bmp.data = fb_alloc0(image_size(&bmp), FB_ALLOC_NO_HINT);
 
+    const uint32_t *lut = NULL;
+    if ((img->pixfmt == PIXFORMAT_RGB565) && (list_size(thresholds) <= IMLIB_THRESHOLD_LUT_MAX_THRESHOLDS)) {
+        // All thresholds are OR'd together into one table so the image is scanned once.
+        color_thresholds_list_lnk_data_t lut_thresholds[IMLIB_THRESHOLD_LUT_MAX_THRESHOLDS];
+        size_t n = 0;
+        list_for_each(it, thresholds) {
+            lut_thresholds[n++] = *((color_thresholds_list_lnk_data_t *) list_get_data(it));
+        }
+
+        lut = imlib_rgb565_threshold_lut(lut_thresholds, n, invert);
+    }
+
+    if (lut) {
+        for (int y = 0, yy = img->h; y < yy; y++) {
+            uint16_t *old_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                uint16_t pixel = IMAGE_GET_RGB565_PIXEL_FAST(old_row_ptr, x);
+                if ((lut[pixel >> 5] >> (pixel & 0x1f)) & 1) {
+                    IMAGE_SET_BINARY_PIXEL_FAST(bmp_row_ptr, x);
+                }
+            }
+        }
+    }
+
     list_for_each(it, thresholds) {
         color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
 
+        if (lut) {
+            break;
+        }
+
         switch (img->pixfmt) {
             case PIXFORMAT_BINARY: {
                 for (int y = 0, yy = img->h; y < yy; y++) {
@@ -165,6 +194,13 @@ void imlib_binary(image_t *out, image_t *img, list_t *thresholds, bool invert, b
                 }
                 break;
             }
+            case PIXFORMAT_YUV_ANY: {
+                for (int y = 0, yy = img->h; y < yy; y++) {
+                    uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
+                    imlib_yuv_threshold_line(0, img->w, y, bmp_row_ptr, img, lnk_data, invert);
+                }
+                break;
+            }
             default: {
                 break;
             }
@@ -194,7 +230,107 @@ void imlib_binary(image_t *out, image_t *img, list_t *thresholds, bool invert, b
     fb_free(); // bmp.data
 }
 
+// Bradley's threshold is a fraction of the local mean, Sauvola's also depends on the local
+// deviation. The window sums come from moving window integral images of 2 * radius + 2 rows,
+// so the cost per pixel doesn't depend on the window size.
+void imlib_adaptive_threshold(image_t *out, image_t *img, int window, float k, adaptive_method_t method, bool invert) {
+    int radius = window / 2;
+    int mw_h = IM_MIN((radius * 2) + 2, img->h);
+    bool sauvola = method == ADAPTIVE_SAUVOLA;
+    int k_q8 = fast_roundf(k * 256);
+
+    image_t bmp = {};
+    bmp.w = img->w;
+    bmp.h = img->h;
+    bmp.pixfmt = PIXFORMAT_BINARY;
+    bmp.data = fb_alloc0(image_size(&bmp), FB_ALLOC_NO_HINT);
+
+    rectangle_t roi = {0, 0, img->w, img->h};
+    mw_image_t sum, ssq;
+    imlib_integral_mw_alloc(&sum, img->w, mw_h);
+
+    if (sauvola) {
+        imlib_integral_mw_alloc(&ssq, img->w, mw_h);
+        imlib_integral_mw_ss(img, &sum, &ssq, &roi);
+    } else {
+        imlib_integral_mw(img, &sum);
+    }
+
+    // Image row of the first integral image row.
+    int base = 0;
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        int y0 = IM_MAX(y - radius, 0);
+        int y1 = IM_MIN(y + radius, img->h - 1);
+
+        for (; (base + mw_h - 1) < y1; base++) {
+            if (sauvola) {
+                imlib_integral_mw_shift_ss(img, &sum, &ssq, &roi, 1);
+            } else {
+                imlib_integral_mw_shift(img, &sum, 1);
+            }
+        }
+
+        // The sums wrap around but the window sums don't, unsigned differences are exact.
+        uint32_t *sum_t = y0 ? sum.data[y0 - 1 - base] : NULL;
+        uint32_t *sum_b = sum.data[y1 - base];
+        uint32_t *ssq_t = (sauvola && y0) ? ssq.data[y0 - 1 - base] : NULL;
+        uint32_t *ssq_b = sauvola ? ssq.data[y1 - base] : NULL;
+        uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            int x0 = IM_MAX(x - radius, 0);
+            int x1 = IM_MIN(x + radius, img->w - 1);
+            uint32_t area = (x1 - x0 + 1) * (y1 - y0 + 1);
+
+            uint32_t s = sum_b[x1] - (x0 ? sum_b[x0 - 1] : 0);
+            if (sum_t) {
+                s -= sum_t[x1] - (x0 ? sum_t[x0 - 1] : 0);
+            }
+
+            int thresh;
+
+            if (sauvola) {
+                uint32_t sq = ssq_b[x1] - (x0 ? ssq_b[x0 - 1] : 0);
+                if (ssq_t) {
+                    sq -= ssq_t[x1] - (x0 ? ssq_t[x0 - 1] : 0);
+                }
+
+                float m = ((float) s) / area;
+                float dev = fast_sqrtf(IM_MAX((((float) sq) / area) - (m * m), 0.0f));
+                thresh = fast_roundf(m * (1.0f + (k * ((dev / 128.0f) - 1.0f))));
+            } else {
+                thresh = ((s / area) * (256 - k_q8)) >> 8;
+            }
+
+            if ((IM_TO_GS_PIXEL(img, x, y) > thresh) ^ invert) {
+                IMAGE_SET_BINARY_PIXEL_FAST(bmp_row_ptr, x);
+            }
+        }
+    }
+
+    if (sauvola) {
+        imlib_integral_mw_free(&ssq);
+    }
+
+    imlib_integral_mw_free(&sum);
+
+    imlib_draw_image(out, &bmp, 0, 0, 1.0f, 1.0f, NULL, -1, 256, NULL, NULL, 0, NULL, NULL, NULL);
+
+    fb_free(); // bmp.data
+}
+
 void imlib_invert(image_t *img) {
+    if (img->stride) {
+        // Invert each row as a packed single row image, skipping the row padding.
+        image_t row = {.w = img->w, .h = 1, .pixfmt = img->pixfmt};
+        for (int y = 0; y < img->h; y++) {
+            row.data = img->data + (img->stride * y);
+            imlib_invert(&row);
+        }
+        return;
+    }
+
     uint32_t n = image_size(img);
     uint32_t *p32 = (uint32_t *) img->data;
 
@@ -907,13 +1043,19 @@ void imlib_b_xnor_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *da
 
 static void imlib_erode_dilate(image_t *img, int ksize, int threshold, int e_or_d, image_t *mask) {
     int brows = ksize + 1;
-    image_t buf;
+    image_t buf = {};
     buf.w = img->w;
     buf.h = brows;
     buf.pixfmt = img->pixfmt;
 
     switch (img->pixfmt) {
         case PIXFORMAT_BINARY: {
+            // Plain erosion or dilation runs on the set pixel runs instead of every pixel.
+            if ((!mask) && (threshold == (e_or_d ? 0 : (imlib_ksize_to_n(ksize) - 1)))) {
+                imlib_rle_erode_dilate(img, ksize, e_or_d);
+                break;
+            }
+
             buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
 
             for (int y = 0; y < img->h; y++) {
@@ -1232,12 +1374,12 @@ void imlib_close(image_t *img, int ksize, int threshold, image_t *mask) {
 }
 
 static void imlib_hat(image_t *img, int ksize, int threshold, image_t *mask, binary_morph_op_t op) {
-    image_t temp;
+    image_t temp = {};
     temp.w = img->w;
     temp.h = img->h;
     temp.pixfmt = img->pixfmt;
     temp.data = fb_alloc(image_size(img), FB_ALLOC_CACHE_ALIGN);
-    memcpy(temp.data, img->data, image_size(img));
+    image_copy_rows(&temp, img);
     op(&temp, ksize, threshold, mask);
     void *dst_row_override = fb_alloc0(image_line_size(img), FB_ALLOC_CACHE_ALIGN);
     imlib_draw_image(img, &temp, 0, 0, 1.0f, 1.0f, NULL, -1, 256, NULL, NULL, 0,
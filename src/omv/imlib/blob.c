@@ -15,6 +15,23 @@ typedef struct xylr {
 }
 xylr_t;
 
+// Sets pixels left to right (inclusive) of a binary row a word at a time.
+static void binary_row_set_span(uint32_t *row_ptr, int left, int right) {
+    int l_word = left >> UINT32_T_SHIFT, r_word = right >> UINT32_T_SHIFT;
+    uint32_t l_mask = 0xFFFFFFFF << (left & UINT32_T_MASK);
+    uint32_t r_mask = 0xFFFFFFFF >> (UINT32_T_MASK - (right & UINT32_T_MASK));
+
+    if (l_word == r_word) {
+        row_ptr[l_word] |= l_mask & r_mask;
+    } else {
+        row_ptr[l_word] |= l_mask;
+        for (int i = l_word + 1; i < r_word; i++) {
+            row_ptr[i] = 0xFFFFFFFF;
+        }
+        row_ptr[r_word] |= r_mask;
+    }
+}
+
 static float sign(float x) {
     return x / fabsf(x);
 }
@@ -122,6 +139,146 @@ static float calc_roundness(float blob_a, float blob_b, float blob_c) {
     return IM_DIV(roundness_min, roundness_max);
 }
 
+// Marks the pixels that pass any of the thresholds in one pass over the roi, only the pixels
+// visited by the strided seed scan are tested.
+static void find_blobs_candidates(image_t *cand, image_t *ptr, rectangle_t *roi,
+                                  unsigned int x_stride, unsigned int y_stride, list_t *thresholds, bool invert) {
+    size_t n = 0;
+    color_thresholds_list_lnk_data_t t[IMLIB_THRESHOLD_LUT_MAX_THRESHOLDS];
+    list_for_each(it, thresholds) {
+        t[n++] = *((color_thresholds_list_lnk_data_t *) list_get_data(it));
+    }
+
+    // Binary and grayscale pixels are classified with a table.
+    uint8_t table[256] = {};
+    if (ptr->pixfmt != PIXFORMAT_RGB565) {
+        for (int i = 0, ii = (ptr->pixfmt == PIXFORMAT_BINARY) ? 2 : 256; i < ii; i++) {
+            for (size_t j = 0; (j < n) && (!table[i]); j++) {
+                table[i] = (ptr->pixfmt == PIXFORMAT_BINARY)
+                           ? COLOR_THRESHOLD_BINARY(i, &t[j], invert)
+                           : COLOR_THRESHOLD_GRAYSCALE(i, &t[j], invert);
+            }
+        }
+    }
+
+    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
+        uint32_t *cand_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(cand, y);
+        for (int x = roi->x + (y % x_stride), xx = roi->x + roi->w; x < xx; x += x_stride) {
+            bool pass = false;
+            switch (ptr->pixfmt) {
+                case PIXFORMAT_BINARY: {
+                    pass = table[IMAGE_GET_BINARY_PIXEL(ptr, x, y)];
+                    break;
+                }
+                case PIXFORMAT_GRAYSCALE: {
+                    pass = table[IMAGE_GET_GRAYSCALE_PIXEL(ptr, x, y)];
+                    break;
+                }
+                case PIXFORMAT_RGB565: {
+                    int pixel = IMAGE_GET_RGB565_PIXEL(ptr, x, y);
+                    int l = COLOR_RGB565_TO_L(pixel);
+                    int a = COLOR_RGB565_TO_A(pixel);
+                    int b = COLOR_RGB565_TO_B(pixel);
+                    for (size_t j = 0; (j < n) && (!pass); j++) {
+                        pass = ((t[j].LMin <= l) && (l <= t[j].LMax) &&
+                                (t[j].AMin <= a) && (a <= t[j].AMax) &&
+                                (t[j].BMin <= b) && (b <= t[j].BMax)) ^ invert;
+                    }
+                    break;
+                }
+                default: {
+                    break;
+                }
+            }
+            if (pass) {
+                IMAGE_SET_BINARY_PIXEL_FAST(cand_row_ptr, x);
+            }
+        }
+    }
+}
+
+// Returns the next candidate at or after x that isn't part of a blob yet, or xx. Without
+// candidates every pixel is a seed.
+static int find_blobs_next_seed(const uint32_t *cand_row_ptr, const uint32_t *bmp_row_ptr, int x, int xx) {
+    if (!cand_row_ptr) {
+        return x;
+    }
+
+    while (x < xx) {
+        int i = x >> UINT32_T_SHIFT;
+        uint32_t word = (cand_row_ptr[i] & ~bmp_row_ptr[i]) >> (x & UINT32_T_MASK);
+        if (word) {
+            return IM_MIN(x + __builtin_ctz(word), xx);
+        }
+        x = (i + 1) << UINT32_T_SHIFT;
+    }
+
+    return xx;
+}
+
+static void find_blobs_merge(find_blobs_list_lnk_data_t *dst, find_blobs_list_lnk_data_t *src,
+                             unsigned int x_hist_bins_max, unsigned int y_hist_bins_max) {
+    // Have to merge these first before merging rects.
+    if (x_hist_bins_max) {
+        merge_bins(dst->rect.x,
+                   dst->rect.x + dst->rect.w - 1,
+                   &dst->x_hist_bins,
+                   &dst->x_hist_bins_count,
+                   src->rect.x,
+                   src->rect.x + src->rect.w - 1,
+                   &src->x_hist_bins,
+                   &src->x_hist_bins_count,
+                   x_hist_bins_max);
+    }
+    if (y_hist_bins_max) {
+        merge_bins(dst->rect.y,
+                   dst->rect.y + dst->rect.h - 1,
+                   &dst->y_hist_bins,
+                   &dst->y_hist_bins_count,
+                   src->rect.y,
+                   src->rect.y + src->rect.h - 1,
+                   &src->y_hist_bins,
+                   &src->y_hist_bins_count,
+                   y_hist_bins_max);
+    }
+    // Merge corners...
+    for (int i = 0; i < FIND_BLOBS_CORNERS_RESOLUTION; i++) {
+        float z_dst = (dst->corners[i].x * cos_table[FIND_BLOBS_ANGLE_RESOLUTION * i]) +
+                      (dst->corners[i].y * sin_table[FIND_BLOBS_ANGLE_RESOLUTION * i]);
+        float z_src = (src->corners[i].x * cos_table[FIND_BLOBS_ANGLE_RESOLUTION * i]) +
+                      (src->corners[i].y * cos_table[FIND_BLOBS_ANGLE_RESOLUTION * i]);
+        if (z_src < z_dst) {
+            dst->corners[i].x = src->corners[i].x;
+            dst->corners[i].y = src->corners[i].y;
+        }
+    }
+    // Merge rects...
+    rectangle_united(&(dst->rect), &(src->rect));
+    // Merge counters...
+    dst->pixels += src->pixels; // won't overflow
+    dst->perimeter += src->perimeter; // won't overflow
+    dst->code |= src->code; // won't overflow
+    dst->count += src->count; // won't overflow
+    // Merge accumulators...
+    dst->centroid_x_acc += src->centroid_x_acc;
+    dst->centroid_y_acc += src->centroid_y_acc;
+    dst->rotation_acc_x += src->rotation_acc_x;
+    dst->rotation_acc_y += src->rotation_acc_y;
+    dst->roundness_acc += src->roundness_acc;
+    // Compute current values...
+    dst->centroid_x = dst->centroid_x_acc / dst->pixels;
+    dst->centroid_y = dst->centroid_y_acc / dst->pixels;
+    dst->rotation = fast_atan2f(dst->rotation_acc_y / dst->pixels,
+                                dst->rotation_acc_x / dst->pixels);
+    dst->roundness = dst->roundness_acc / dst->pixels;
+}
+
+static int find_blobs_compare_x(const void *a, const void *b) {
+    const find_blobs_list_lnk_data_t *blob_a = *((find_blobs_list_lnk_data_t *const *) a);
+    const find_blobs_list_lnk_data_t *blob_b = *((find_blobs_list_lnk_data_t *const *) b);
+    return blob_a->rect.x - blob_b->rect.x;
+}
+
 void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
                       list_t *thresholds, bool invert, unsigned int area_threshold, unsigned int pixels_threshold,
                       bool merge, int margin,
@@ -129,12 +286,28 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                       bool (*merge_cb) (void *, find_blobs_list_lnk_data_t *, find_blobs_list_lnk_data_t *), void *merge_cb_arg,
                       unsigned int x_hist_bins_max, unsigned int y_hist_bins_max) {
     // Same size as the image so we don't have to translate.
-    image_t bmp;
+    image_t bmp = {};
     bmp.w = ptr->w;
     bmp.h = ptr->h;
     bmp.pixfmt = PIXFORMAT_BINARY;
     bmp.data = fb_alloc0(image_size(&bmp), FB_ALLOC_NO_HINT);
 
+    // YUV pixels are thresholded natively into a bitmap per threshold which is then traced
+    // like a binary image, so the image is never converted.
+    image_t *yuv = NULL;
+    image_t yuv_bmp = {};
+    bool yuv_invert = invert;
+    color_thresholds_list_lnk_data_t yuv_lnk_data = { .LMin = 1, .LMax = 1 };
+    if (ptr->is_yuv) {
+        yuv = ptr;
+        yuv_bmp.w = ptr->w;
+        yuv_bmp.h = ptr->h;
+        yuv_bmp.pixfmt = PIXFORMAT_BINARY;
+        yuv_bmp.data = fb_alloc0(image_size(&yuv_bmp), FB_ALLOC_NO_HINT);
+        ptr = &yuv_bmp;
+        invert = false;
+    }
+
     uint16_t *x_hist_bins = NULL;
     if (x_hist_bins_max) {
         x_hist_bins = fb_alloc(ptr->w * sizeof(uint16_t), FB_ALLOC_NO_HINT);
@@ -145,6 +318,17 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
         y_hist_bins = fb_alloc(ptr->h * sizeof(uint16_t), FB_ALLOC_NO_HINT);
     }
 
+    // With multiple thresholds the image is classified once, each threshold's seed scan
+    // then skips 32 pixels at a time where no threshold passes (or the pixels are taken).
+    image_t cand = {};
+    if ((!yuv) && (list_size(thresholds) > 1) && (list_size(thresholds) <= IMLIB_THRESHOLD_LUT_MAX_THRESHOLDS)) {
+        cand.w = ptr->w;
+        cand.h = ptr->h;
+        cand.pixfmt = PIXFORMAT_BINARY;
+        cand.data = fb_alloc0(image_size(&cand), FB_ALLOC_NO_HINT);
+        find_blobs_candidates(&cand, ptr, roi, x_stride, y_stride, thresholds, invert);
+    }
+
     lifo_t lifo;
     size_t lifo_len;
     lifo_alloc_all(&lifo, &lifo_len, sizeof(xylr_t));
@@ -155,12 +339,25 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
     list_for_each(it, thresholds) {
         color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
 
+        if (yuv) {
+            for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                uint32_t *yuv_bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&yuv_bmp, y);
+                memset(yuv_bmp_row_ptr, 0, IMAGE_BINARY_LINE_LEN_BYTES(&yuv_bmp));
+                imlib_yuv_threshold_line(roi->x, roi->x + roi->w, y, yuv_bmp_row_ptr, yuv, lnk_data, yuv_invert);
+            }
+
+            lnk_data = &yuv_lnk_data;
+        }
+
         switch (ptr->pixfmt) {
             case PIXFORMAT_BINARY: {
                 for (int y = roi->y, yy = roi->y + roi->h, y_max = yy - 1; y < yy; y += y_stride) {
                     uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
                     uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                    for (int x = roi->x + (y % x_stride), xx = roi->x + roi->w, x_max = xx - 1; x < xx; x += x_stride) {
+                    uint32_t *cand_row_ptr = cand.data ? IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&cand, y) : NULL;
+                    for (int xx = roi->x + roi->w, x_max = xx - 1,
+                         x = find_blobs_next_seed(cand_row_ptr, bmp_row_ptr, roi->x + (y % x_stride), xx); x < xx;
+                         x = find_blobs_next_seed(cand_row_ptr, bmp_row_ptr, x + x_stride, xx)) {
                         if ((!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x))
                             && COLOR_THRESHOLD_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x), lnk_data, invert)) {
                             int old_x = x;
@@ -216,9 +413,7 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                     right++;
                                 }
 
-                                for (int i = left; i <= right; i++) {
-                                    IMAGE_SET_BINARY_PIXEL_FAST(bmp_row, i);
-                                }
+                                binary_row_set_span(bmp_row, left, right);
 
                                 int sum = sum_m_to_n(left, right);
                                 int sum_2 = sum_2_m_to_n(left, right);
@@ -264,7 +459,7 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                 int bot_left = left;
                                 bool break_out = false;
                                 for (;;) {
-                                    if (lifo_size(&lifo) < lifo_len) {
+                                    if (lifo_is_not_full(&lifo)) {
 
                                         if (y > roi->y) {
                                             row = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y - 1);
@@ -279,14 +474,9 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                                             COLOR_THRESHOLD_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, i),
                                                                                    lnk_data,
                                                                                    invert))) {
-                                                    xylr_t context;
-                                                    context.x = x;
-                                                    context.y = y;
-                                                    context.l = left;
-                                                    context.r = right;
-                                                    context.t_l = i + 1; // Don't test the same pixel again...
-                                                    context.b_l = bot_left;
-                                                    lifo_enqueue(&lifo, &context);
+                                                    // Don't test the same pixel again...
+                                                    xylr_t context = { x, y, left, right, i + 1, bot_left };
+                                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                                     x = i;
                                                     y = y - 1;
                                                     recurse = true;
@@ -315,14 +505,9 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                                             COLOR_THRESHOLD_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, i),
                                                                                    lnk_data,
                                                                                    invert))) {
-                                                    xylr_t context;
-                                                    context.x = x;
-                                                    context.y = y;
-                                                    context.l = left;
-                                                    context.r = right;
-                                                    context.t_l = top_left;
-                                                    context.b_l = i + 1; // Don't test the same pixel again...
-                                                    lifo_enqueue(&lifo, &context);
+                                                    // Don't test the same pixel again...
+                                                    xylr_t context = { x, y, left, right, top_left, i + 1 };
+                                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                                     x = i;
                                                     y = y + 1;
                                                     recurse = true;
@@ -341,13 +526,12 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                         blob_perimeter += (right - left + 1) * 2;
                                     }
 
-                                    if (!lifo_size(&lifo)) {
+                                    if (!lifo_is_not_empty(&lifo)) {
                                         break_out = true;
                                         break;
                                     }
 
-                                    xylr_t context;
-                                    lifo_dequeue(&lifo, &context);
+                                    xylr_t context = lifo_dequeue_fast(&lifo, xylr_t);
                                     x = context.x;
                                     y = context.y;
                                     left = context.l;
@@ -466,7 +650,10 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                 for (int y = roi->y, yy = roi->y + roi->h, y_max = yy - 1; y < yy; y += y_stride) {
                     uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
                     uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                    for (int x = roi->x + (y % x_stride), xx = roi->x + roi->w, x_max = xx - 1; x < xx; x += x_stride) {
+                    uint32_t *cand_row_ptr = cand.data ? IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&cand, y) : NULL;
+                    for (int xx = roi->x + roi->w, x_max = xx - 1,
+                         x = find_blobs_next_seed(cand_row_ptr, bmp_row_ptr, roi->x + (y % x_stride), xx); x < xx;
+                         x = find_blobs_next_seed(cand_row_ptr, bmp_row_ptr, x + x_stride, xx)) {
                         if ((!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x))
                             && COLOR_THRESHOLD_GRAYSCALE(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x), lnk_data, invert)) {
                             int old_x = x;
@@ -522,9 +709,7 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                     right++;
                                 }
 
-                                for (int i = left; i <= right; i++) {
-                                    IMAGE_SET_BINARY_PIXEL_FAST(bmp_row, i);
-                                }
+                                binary_row_set_span(bmp_row, left, right);
 
                                 int sum = sum_m_to_n(left, right);
                                 int sum_2 = sum_2_m_to_n(left, right);
@@ -570,7 +755,7 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                 int bot_left = left;
                                 bool break_out = false;
                                 for (;;) {
-                                    if (lifo_size(&lifo) < lifo_len) {
+                                    if (lifo_is_not_full(&lifo)) {
 
                                         if (y > roi->y) {
                                             row = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y - 1);
@@ -585,14 +770,9 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                                             COLOR_THRESHOLD_GRAYSCALE(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row, i),
                                                                                       lnk_data,
                                                                                       invert))) {
-                                                    xylr_t context;
-                                                    context.x = x;
-                                                    context.y = y;
-                                                    context.l = left;
-                                                    context.r = right;
-                                                    context.t_l = i + 1; // Don't test the same pixel again...
-                                                    context.b_l = bot_left;
-                                                    lifo_enqueue(&lifo, &context);
+                                                    // Don't test the same pixel again...
+                                                    xylr_t context = { x, y, left, right, i + 1, bot_left };
+                                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                                     x = i;
                                                     y = y - 1;
                                                     recurse = true;
@@ -621,14 +801,9 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                                             COLOR_THRESHOLD_GRAYSCALE(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row, i),
                                                                                       lnk_data,
                                                                                       invert))) {
-                                                    xylr_t context;
-                                                    context.x = x;
-                                                    context.y = y;
-                                                    context.l = left;
-                                                    context.r = right;
-                                                    context.t_l = top_left;
-                                                    context.b_l = i + 1; // Don't test the same pixel again...
-                                                    lifo_enqueue(&lifo, &context);
+                                                    // Don't test the same pixel again...
+                                                    xylr_t context = { x, y, left, right, top_left, i + 1 };
+                                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                                     x = i;
                                                     y = y + 1;
                                                     recurse = true;
@@ -647,13 +822,12 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                         blob_perimeter += (right - left + 1) * 2;
                                     }
 
-                                    if (!lifo_size(&lifo)) {
+                                    if (!lifo_is_not_empty(&lifo)) {
                                         break_out = true;
                                         break;
                                     }
 
-                                    xylr_t context;
-                                    lifo_dequeue(&lifo, &context);
+                                    xylr_t context = lifo_dequeue_fast(&lifo, xylr_t);
                                     x = context.x;
                                     y = context.y;
                                     left = context.l;
@@ -769,12 +943,17 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                 break;
             }
             case PIXFORMAT_RGB565: {
+                const uint32_t *lut = imlib_rgb565_threshold_lut(lnk_data, 1, invert);
                 for (int y = roi->y, yy = roi->y + roi->h, y_max = yy - 1; y < yy; y += y_stride) {
                     uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
                     uint32_t *bmp_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&bmp, y);
-                    for (int x = roi->x + (y % x_stride), xx = roi->x + roi->w, x_max = xx - 1; x < xx; x += x_stride) {
+                    uint32_t *cand_row_ptr = cand.data ? IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&cand, y) : NULL;
+                    for (int xx = roi->x + roi->w, x_max = xx - 1,
+                         x = find_blobs_next_seed(cand_row_ptr, bmp_row_ptr, roi->x + (y % x_stride), xx); x < xx;
+                         x = find_blobs_next_seed(cand_row_ptr, bmp_row_ptr, x + x_stride, xx)) {
                         if ((!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row_ptr, x))
-                            && COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x), lnk_data, invert)) {
+                            && COLOR_THRESHOLD_RGB565_LUT(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x), lut, lnk_data,
+                                                          invert)) {
                             int old_x = x;
                             int old_y = y;
 
@@ -816,21 +995,19 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
 
                                 while ((left > roi->x)
                                        && (!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row, left - 1))
-                                       && COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, left - 1), lnk_data,
-                                                                 invert)) {
+                                       && COLOR_THRESHOLD_RGB565_LUT(IMAGE_GET_RGB565_PIXEL_FAST(row, left - 1), lut,
+                                                                     lnk_data, invert)) {
                                     left--;
                                 }
 
                                 while ((right < (roi->x + roi->w - 1))
                                        && (!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row, right + 1))
-                                       && COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, right + 1), lnk_data,
-                                                                 invert)) {
+                                       && COLOR_THRESHOLD_RGB565_LUT(IMAGE_GET_RGB565_PIXEL_FAST(row, right + 1), lut,
+                                                                     lnk_data, invert)) {
                                     right++;
                                 }
 
-                                for (int i = left; i <= right; i++) {
-                                    IMAGE_SET_BINARY_PIXEL_FAST(bmp_row, i);
-                                }
+                                binary_row_set_span(bmp_row, left, right);
 
                                 int sum = sum_m_to_n(left, right);
                                 int sum_2 = sum_2_m_to_n(left, right);
@@ -876,7 +1053,7 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                 int bot_left = left;
                                 bool break_out = false;
                                 for (;;) {
-                                    if (lifo_size(&lifo) < lifo_len) {
+                                    if (lifo_is_not_full(&lifo)) {
 
                                         if (y > roi->y) {
                                             row = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y - 1);
@@ -888,17 +1065,13 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
 
                                                 if ((!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row, i))
                                                     && (ok =
-                                                            COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i),
-                                                                                   lnk_data,
-                                                                                   invert))) {
-                                                    xylr_t context;
-                                                    context.x = x;
-                                                    context.y = y;
-                                                    context.l = left;
-                                                    context.r = right;
-                                                    context.t_l = i + 1; // Don't test the same pixel again...
-                                                    context.b_l = bot_left;
-                                                    lifo_enqueue(&lifo, &context);
+                                                            COLOR_THRESHOLD_RGB565_LUT(IMAGE_GET_RGB565_PIXEL_FAST(row, i),
+                                                                                       lut,
+                                                                                       lnk_data,
+                                                                                       invert))) {
+                                                    // Don't test the same pixel again...
+                                                    xylr_t context = { x, y, left, right, i + 1, bot_left };
+                                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                                     x = i;
                                                     y = y - 1;
                                                     recurse = true;
@@ -924,17 +1097,13 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
 
                                                 if ((!IMAGE_GET_BINARY_PIXEL_FAST(bmp_row, i))
                                                     && (ok =
-                                                            COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i),
-                                                                                   lnk_data,
-                                                                                   invert))) {
-                                                    xylr_t context;
-                                                    context.x = x;
-                                                    context.y = y;
-                                                    context.l = left;
-                                                    context.r = right;
-                                                    context.t_l = top_left;
-                                                    context.b_l = i + 1; // Don't test the same pixel again...
-                                                    lifo_enqueue(&lifo, &context);
+                                                            COLOR_THRESHOLD_RGB565_LUT(IMAGE_GET_RGB565_PIXEL_FAST(row, i),
+                                                                                       lut,
+                                                                                       lnk_data,
+                                                                                       invert))) {
+                                                    // Don't test the same pixel again...
+                                                    xylr_t context = { x, y, left, right, top_left, i + 1 };
+                                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                                     x = i;
                                                     y = y + 1;
                                                     recurse = true;
@@ -953,13 +1122,12 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                                         blob_perimeter += (right - left + 1) * 2;
                                     }
 
-                                    if (!lifo_size(&lifo)) {
+                                    if (!lifo_is_not_empty(&lifo)) {
                                         break_out = true;
                                         break;
                                     }
 
-                                    xylr_t context;
-                                    lifo_dequeue(&lifo, &context);
+                                    xylr_t context = lifo_dequeue_fast(&lifo, xylr_t);
                                     x = context.x;
                                     y = context.y;
                                     left = context.l;
@@ -1083,108 +1251,291 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
     }
 
     lifo_free(&lifo);
+    if (cand.data) {
+        fb_free();
+    }
     if (y_hist_bins) {
         fb_free();
     }
     if (x_hist_bins) {
         fb_free();
     }
+    if (yuv) {
+        fb_free(); // yuv bitmap
+    }
     fb_free(); // bitmap
 
-    if (merge) {
-        for (;;) {
-            bool merge_occured = false;
+    if (merge && (list_size(out) > 1)) {
+        // Blobs are swept in x order so each blob is only compared with the blobs that start
+        // before it ends. Merged blobs grow, so passes repeat until nothing merges. The merged
+        // blob keeps the position of the earliest blob in the output.
+        size_t n = list_size(out);
+        find_blobs_list_lnk_data_t *blobs = xalloc(n * sizeof(find_blobs_list_lnk_data_t));
+        find_blobs_list_lnk_data_t **sorted = xalloc(n * sizeof(find_blobs_list_lnk_data_t *));
+
+        for (size_t i = 0; i < n; i++) {
+            list_pop_front(out, &blobs[i]);
+            sorted[i] = &blobs[i];
+        }
+
+        for (bool merge_occured = true; merge_occured;) {
+            merge_occured = false;
+            qsort(sorted, n, sizeof(find_blobs_list_lnk_data_t *), find_blobs_compare_x);
 
-            list_t out_temp;
-            list_init(&out_temp, sizeof(find_blobs_list_lnk_data_t));
+            for (size_t i = 0; i < n; i++) {
+                find_blobs_list_lnk_data_t *lnk_blob = sorted[i];
 
-            while (list_size(out)) {
-                find_blobs_list_lnk_data_t lnk_blob;
-                list_pop_front(out, &lnk_blob);
+                if (!lnk_blob->rect.w) {
+                    continue;
+                }
+
+                for (size_t j = i + 1; j < n; j++) {
+                    find_blobs_list_lnk_data_t *tmp_blob = sorted[j];
+
+                    // The remaining blobs start too far right to overlap.
+                    if ((tmp_blob->rect.x - margin) >= (lnk_blob->rect.x + lnk_blob->rect.w)) {
+                        break;
+                    }
 
-                for (size_t k = 0, l = list_size(out); k < l; k++) {
-                    find_blobs_list_lnk_data_t tmp_blob;
-                    list_pop_front(out, &tmp_blob);
+                    if (!tmp_blob->rect.w) {
+                        continue;
+                    }
 
                     rectangle_t temp;
-                    temp.x = __SSAT(tmp_blob.rect.x - margin, 16);
-                    temp.y = __SSAT(tmp_blob.rect.y - margin, 16);
-                    temp.w = __USAT(tmp_blob.rect.w + (margin * 2), 15);
-                    temp.h = __USAT(tmp_blob.rect.h + (margin * 2), 15);
-
-                    if (rectangle_overlap(&(lnk_blob.rect), &temp)
-                        && ((merge_cb_arg == NULL) || merge_cb(merge_cb_arg, &lnk_blob, &tmp_blob))) {
-                        // Have to merge these first before merging rects.
-                        if (x_hist_bins_max) {
-                            merge_bins(lnk_blob.rect.x,
-                                       lnk_blob.rect.x + lnk_blob.rect.w - 1,
-                                       &lnk_blob.x_hist_bins,
-                                       &lnk_blob.x_hist_bins_count,
-                                       tmp_blob.rect.x,
-                                       tmp_blob.rect.x + tmp_blob.rect.w - 1,
-                                       &tmp_blob.x_hist_bins,
-                                       &tmp_blob.x_hist_bins_count,
-                                       x_hist_bins_max);
+                    temp.x = __SSAT(tmp_blob->rect.x - margin, 16);
+                    temp.y = __SSAT(tmp_blob->rect.y - margin, 16);
+                    temp.w = __USAT(tmp_blob->rect.w + (margin * 2), 15);
+                    temp.h = __USAT(tmp_blob->rect.h + (margin * 2), 15);
+
+                    if (rectangle_overlap(&(lnk_blob->rect), &temp)
+                        && ((merge_cb_arg == NULL) || merge_cb(merge_cb_arg, lnk_blob, tmp_blob))) {
+                        find_blobs_merge(lnk_blob, tmp_blob, x_hist_bins_max, y_hist_bins_max);
+
+                        // Keep the merged blob in the earlier slot, the other slot is marked empty.
+                        if (tmp_blob < lnk_blob) {
+                            *tmp_blob = *lnk_blob;
+                            sorted[i] = tmp_blob;
+                            sorted[j] = lnk_blob;
+                            lnk_blob = tmp_blob;
+                            tmp_blob = sorted[j];
                         }
-                        if (y_hist_bins_max) {
-                            merge_bins(lnk_blob.rect.y,
-                                       lnk_blob.rect.y + lnk_blob.rect.h - 1,
-                                       &lnk_blob.y_hist_bins,
-                                       &lnk_blob.y_hist_bins_count,
-                                       tmp_blob.rect.y,
-                                       tmp_blob.rect.y + tmp_blob.rect.h - 1,
-                                       &tmp_blob.y_hist_bins,
-                                       &tmp_blob.y_hist_bins_count,
-                                       y_hist_bins_max);
-                        }
-                        // Merge corners...
-                        for (int i = 0; i < FIND_BLOBS_CORNERS_RESOLUTION; i++) {
-                            float z_dst = (lnk_blob.corners[i].x * cos_table[FIND_BLOBS_ANGLE_RESOLUTION * i]) +
-                                          (lnk_blob.corners[i].y * sin_table[FIND_BLOBS_ANGLE_RESOLUTION * i]);
-                            float z_src = (tmp_blob.corners[i].x * cos_table[FIND_BLOBS_ANGLE_RESOLUTION * i]) +
-                                          (tmp_blob.corners[i].y * cos_table[FIND_BLOBS_ANGLE_RESOLUTION * i]);
-                            if (z_src < z_dst) {
-                                lnk_blob.corners[i].x = tmp_blob.corners[i].x;
-                                lnk_blob.corners[i].y = tmp_blob.corners[i].y;
-                            }
-                        }
-                        // Merge rects...
-                        rectangle_united(&(lnk_blob.rect), &(tmp_blob.rect));
-                        // Merge counters...
-                        lnk_blob.pixels += tmp_blob.pixels; // won't overflow
-                        lnk_blob.perimeter += tmp_blob.perimeter; // won't overflow
-                        lnk_blob.code |= tmp_blob.code; // won't overflow
-                        lnk_blob.count += tmp_blob.count; // won't overflow
-                        // Merge accumulators...
-                        lnk_blob.centroid_x_acc += tmp_blob.centroid_x_acc;
-                        lnk_blob.centroid_y_acc += tmp_blob.centroid_y_acc;
-                        lnk_blob.rotation_acc_x += tmp_blob.rotation_acc_x;
-                        lnk_blob.rotation_acc_y += tmp_blob.rotation_acc_y;
-                        lnk_blob.roundness_acc += tmp_blob.roundness_acc;
-                        // Compute current values...
-                        lnk_blob.centroid_x = lnk_blob.centroid_x_acc / lnk_blob.pixels;
-                        lnk_blob.centroid_y = lnk_blob.centroid_y_acc / lnk_blob.pixels;
-                        lnk_blob.rotation = fast_atan2f(lnk_blob.rotation_acc_y / lnk_blob.pixels,
-                                                        lnk_blob.rotation_acc_x / lnk_blob.pixels);
-                        lnk_blob.roundness = lnk_blob.roundness_acc / lnk_blob.pixels;
+
+                        tmp_blob->rect.w = 0;
                         merge_occured = true;
-                    } else {
-                        list_push_back(out, &tmp_blob);
                     }
                 }
+            }
+        }
 
-                list_push_back(&out_temp, &lnk_blob);
+        for (size_t i = 0; i < n; i++) {
+            if (blobs[i].rect.w) {
+                list_push_back(out, &blobs[i]);
             }
+        }
 
-            list_copy(out, &out_temp);
+        xfree(sorted);
+        xfree(blobs);
+    }
+}
 
-            if (!merge_occured) {
-                break;
+void imlib_track_blobs(find_blobs_tracker_t *tracker, list_t *out, image_t *ptr, rectangle_t *roi,
+                       unsigned int x_stride, unsigned int y_stride,
+                       list_t *thresholds, bool invert, unsigned int area_threshold, unsigned int pixels_threshold,
+                       bool merge, int margin,
+                       bool (*threshold_cb) (void *, find_blobs_list_lnk_data_t *), void *threshold_cb_arg,
+                       bool (*merge_cb) (void *, find_blobs_list_lnk_data_t *, find_blobs_list_lnk_data_t *), void *merge_cb_arg,
+                       unsigned int x_hist_bins_max, unsigned int y_hist_bins_max) {
+    int search_margin = tracker->search_margin;
+    bool full_scan = (!list_size(&tracker->tracks)) || (tracker->frames >= tracker->full_scan_interval);
+    tracker->frames = full_scan ? 1 : (tracker->frames + 1);
+
+    if (full_scan) {
+        imlib_find_blobs(out, ptr, roi, x_stride, y_stride, thresholds, invert,
+                         area_threshold, pixels_threshold, merge, margin,
+                         threshold_cb, threshold_cb_arg, merge_cb, merge_cb_arg,
+                         x_hist_bins_max, y_hist_bins_max);
+    } else {
+        // Search around where each blob was in the last frame.
+        list_t rects;
+        list_init(&rects, sizeof(rectangle_t));
+
+        list_for_each(it, (&tracker->tracks)) {
+            find_blobs_track_t *track = list_get_data(it);
+            rectangle_t rect;
+            rectangle_init(&rect, track->rect.x - search_margin, track->rect.y - search_margin,
+                           track->rect.w + (search_margin * 2), track->rect.h + (search_margin * 2));
+
+            if (rectangle_overlap(&rect, roi)) {
+                rectangle_intersected(&rect, roi);
+                list_push_back(&rects, &rect);
             }
         }
+
+        // Merge overlapping search areas so that no blob is found twice.
+        for (bool merged = true; merged;) {
+            merged = false;
+
+            list_for_each(it0, (&rects)) {
+                rectangle_t *rect0 = list_get_data(it0);
+
+                for (list_lnk_t *it1 = it0->next; it1; it1 = it1->next) {
+                    rectangle_t rect1;
+
+                    if (rectangle_overlap(rect0, list_get_data(it1))) {
+                        list_remove(&rects, it1, &rect1);
+                        rectangle_united(rect0, &rect1);
+                        merged = true;
+                        break;
+                    }
+                }
+
+                if (merged) {
+                    break;
+                }
+            }
+        }
+
+        list_init(out, sizeof(find_blobs_list_lnk_data_t));
+
+        while (list_size(&rects)) {
+            rectangle_t rect;
+            list_t blobs;
+            list_pop_front(&rects, &rect);
+            imlib_find_blobs(&blobs, ptr, &rect, x_stride, y_stride, thresholds, invert,
+                             area_threshold, pixels_threshold, merge, margin,
+                             threshold_cb, threshold_cb_arg, merge_cb, merge_cb_arg,
+                             x_hist_bins_max, y_hist_bins_max);
+
+            while (list_size(&blobs)) {
+                list_move_back(out, &blobs, blobs.head);
+            }
+        }
+    }
+
+    // Match each blob to the closest unclaimed blob from the last frame.
+    list_t tracks;
+    list_init(&tracks, sizeof(find_blobs_track_t));
+
+    list_for_each(it, out) {
+        find_blobs_list_lnk_data_t *lnk_data = list_get_data(it);
+        int cx = lnk_data->rect.x + (lnk_data->rect.w / 2);
+        int cy = lnk_data->rect.y + (lnk_data->rect.h / 2);
+        list_lnk_t *best = NULL;
+        int best_dist = INT_MAX;
+
+        list_for_each(jt, (&tracker->tracks)) {
+            find_blobs_track_t *track = list_get_data(jt);
+            rectangle_t rect;
+            rectangle_init(&rect, track->rect.x - search_margin, track->rect.y - search_margin,
+                           track->rect.w + (search_margin * 2), track->rect.h + (search_margin * 2));
+
+            if (rectangle_overlap(&rect, &lnk_data->rect)) {
+                int dx = cx - (track->rect.x + (track->rect.w / 2));
+                int dy = cy - (track->rect.y + (track->rect.h / 2));
+                int dist = (dx * dx) + (dy * dy);
+
+                if (dist < best_dist) {
+                    best_dist = dist;
+                    best = jt;
+                }
+            }
+        }
+
+        find_blobs_track_t track;
+
+        if (best) {
+            list_remove(&tracker->tracks, best, &track);
+        } else {
+            track.id = tracker->next_id++;
+        }
+
+        rectangle_copy(&track.rect, &lnk_data->rect);
+        list_push_back(&tracks, &track);
+    }
+
+    // Blobs from the last frame that were not found again are dropped.
+    list_free(&tracker->tracks);
+    tracker->tracks = tracks;
+}
+
+#define FLOOD_FILL_BINARY_MATCH_NONE     (0)
+#define FLOOD_FILL_BINARY_MATCH_EQUAL    (1)
+#define FLOOD_FILL_BINARY_MATCH_ALL      (2)
+
+// Binary pixels are within the thresholds of each other either never (negative thresholds), when
+// they are equal (thresholds below 1), or always. Returns the word of pixels that can be filled.
+static inline uint32_t flood_fill_binary_match(int mode, uint32_t pixels, uint32_t ref, uint32_t out) {
+    switch (mode) {
+        case FLOOD_FILL_BINARY_MATCH_EQUAL: {
+            return ~(pixels ^ ref) & ~out;
+        }
+        case FLOOD_FILL_BINARY_MATCH_ALL: {
+            return ~out;
+        }
+        default: {
+            return 0;
+        }
     }
 }
 
+// Returns the leftmost pixel of the span that grows left from x.
+static int flood_fill_binary_left(int mode, uint32_t *row, uint32_t ref, uint32_t *out_row, int x) {
+    if (!x) {
+        return x;
+    }
+
+    int i = (x - 1) >> UINT32_T_SHIFT;
+    uint32_t m = ~flood_fill_binary_match(mode, row[i], ref, out_row[i]) &
+                 (0xFFFFFFFF >> (UINT32_T_MASK - ((x - 1) & UINT32_T_MASK)));
+
+    while ((!m) && (i > 0)) {
+        i -= 1;
+        m = ~flood_fill_binary_match(mode, row[i], ref, out_row[i]);
+    }
+
+    return m ? ((i << UINT32_T_SHIFT) + (UINT32_T_MASK - __builtin_clz(m)) + 1) : 0;
+}
+
+// Returns the rightmost pixel of the span that grows right from x.
+static int flood_fill_binary_right(int mode, uint32_t *row, uint32_t ref, uint32_t *out_row, int x, int w) {
+    if ((x + 1) >= w) {
+        return x;
+    }
+
+    int i = (x + 1) >> UINT32_T_SHIFT, ii = (w - 1) >> UINT32_T_SHIFT;
+    uint32_t m = ~flood_fill_binary_match(mode, row[i], ref, out_row[i]) &
+                 (0xFFFFFFFF << ((x + 1) & UINT32_T_MASK));
+
+    while ((!m) && (i < ii)) {
+        i += 1;
+        m = ~flood_fill_binary_match(mode, row[i], ref, out_row[i]);
+    }
+
+    return m ? IM_MIN((i << UINT32_T_SHIFT) + __builtin_ctz(m) - 1, w - 1) : (w - 1);
+}
+
+// Returns the first pixel from l to r (inclusive) that grows from the row above or below, or -1.
+static int flood_fill_binary_find(int mode, uint32_t *row, uint32_t *old_row, uint32_t *out_row, int l, int r) {
+    if (l > r) {
+        return -1;
+    }
+
+    for (int i = l >> UINT32_T_SHIFT, ii = r >> UINT32_T_SHIFT; i <= ii; i++) {
+        uint32_t m = flood_fill_binary_match(mode, row[i], old_row[i], out_row[i]);
+
+        if (i == (l >> UINT32_T_SHIFT)) {
+            m &= 0xFFFFFFFF << (l & UINT32_T_MASK);
+        }
+
+        if (m) {
+            int x = (i << UINT32_T_SHIFT) + __builtin_ctz(m);
+            return (x <= r) ? x : -1;
+        }
+    }
+
+    return -1;
+}
+
 void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
                           int seed_threshold, int floating_threshold,
                           flood_fill_call_back_t cb, void *data) {
@@ -1194,92 +1545,53 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
 
     switch (img->pixfmt) {
         case PIXFORMAT_BINARY: {
-            for (int seed_pixel = IMAGE_GET_BINARY_PIXEL(img, x, y);;) {
-                int left = x, right = x;
+            int mode = ((seed_threshold < 0) || (floating_threshold < 0)) ? FLOOD_FILL_BINARY_MATCH_NONE :
+                       (((seed_threshold >= 1) && (floating_threshold >= 1)) ? FLOOD_FILL_BINARY_MATCH_ALL :
+                        FLOOD_FILL_BINARY_MATCH_EQUAL);
+
+            for (;;) {
                 uint32_t *row     = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
                 uint32_t *out_row = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y);
+                // Pixels in a span are all equal to the pixel the span grows from.
+                uint32_t ref = IMAGE_GET_BINARY_PIXEL_FAST(row, x) ? 0xFFFFFFFF : 0;
+                int left = flood_fill_binary_left(mode, row, ref, out_row, x);
+                int right = flood_fill_binary_right(mode, row, ref, out_row, x, img->w);
 
-                while ((left > 0)
-                       && (!IMAGE_GET_BINARY_PIXEL_FAST(out_row, left - 1))
-                       && COLOR_BOUND_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, left - 1), seed_pixel, seed_threshold)
-                       && COLOR_BOUND_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, left - 1),
-                                             IMAGE_GET_BINARY_PIXEL_FAST(row, left), floating_threshold)) {
-                    left--;
-                }
-
-                while ((right < (img->w - 1))
-                       && (!IMAGE_GET_BINARY_PIXEL_FAST(out_row, right + 1))
-                       && COLOR_BOUND_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, right + 1), seed_pixel, seed_threshold)
-                       && COLOR_BOUND_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, right + 1),
-                                             IMAGE_GET_BINARY_PIXEL_FAST(row, right), floating_threshold)) {
-                    right++;
-                }
-
-                for (int i = left; i <= right; i++) {
-                    IMAGE_SET_BINARY_PIXEL_FAST(out_row, i);
-                }
+                binary_row_set_span(out_row, left, right);
 
                 int top_left = left;
                 int bot_left = left;
                 bool break_out = false;
                 for (;;) {
-                    if (lifo_size(&lifo) < lifo_len) {
+                    if (lifo_is_not_full(&lifo)) {
                         uint32_t *old_row = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
 
                         if (y > 0) {
-                            row = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y - 1);
-                            out_row = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y - 1);
-
-                            bool recurse = false;
-                            for (int i = top_left; i <= right; i++) {
-                                if ((!IMAGE_GET_BINARY_PIXEL_FAST(out_row, i))
-                                    && COLOR_BOUND_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, i), seed_pixel, seed_threshold)
-                                    && COLOR_BOUND_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, i),
-                                                          IMAGE_GET_BINARY_PIXEL_FAST(old_row, i), floating_threshold)) {
-                                    xylr_t context;
-                                    context.x = x;
-                                    context.y = y;
-                                    context.l = left;
-                                    context.r = right;
-                                    context.t_l = i + 1; // Don't test the same pixel again...
-                                    context.b_l = bot_left;
-                                    lifo_enqueue(&lifo, &context);
-                                    x = i;
-                                    y = y - 1;
-                                    recurse = true;
-                                    break;
-                                }
-                            }
-                            if (recurse) {
+                            int i = flood_fill_binary_find(mode, IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y - 1), old_row,
+                                                           IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y - 1),
+                                                           top_left, right);
+                            if (i >= 0) {
+                                // Don't test the same pixel again...
+                                xylr_t context = { x, y, left, right, i + 1, bot_left };
+                                lifo_enqueue_fast(&lifo, xylr_t, context);
+                                x = i;
+                                y = y - 1;
                                 break;
                             }
+                            // Nothing above grows, the pixels only get filled from here on.
+                            top_left = right + 1;
                         }
 
                         if (y < (img->h - 1)) {
-                            row = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y + 1);
-                            out_row = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y + 1);
-
-                            bool recurse = false;
-                            for (int i = bot_left; i <= right; i++) {
-                                if ((!IMAGE_GET_BINARY_PIXEL_FAST(out_row, i))
-                                    && COLOR_BOUND_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, i), seed_pixel, seed_threshold)
-                                    && COLOR_BOUND_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row, i),
-                                                          IMAGE_GET_BINARY_PIXEL_FAST(old_row, i), floating_threshold)) {
-                                    xylr_t context;
-                                    context.x = x;
-                                    context.y = y;
-                                    context.l = left;
-                                    context.r = right;
-                                    context.t_l = top_left;
-                                    context.b_l = i + 1; // Don't test the same pixel again...
-                                    lifo_enqueue(&lifo, &context);
-                                    x = i;
-                                    y = y + 1;
-                                    recurse = true;
-                                    break;
-                                }
-                            }
-                            if (recurse) {
+                            int i = flood_fill_binary_find(mode, IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y + 1), old_row,
+                                                           IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y + 1),
+                                                           bot_left, right);
+                            if (i >= 0) {
+                                // Don't test the same pixel again...
+                                xylr_t context = { x, y, left, right, top_left, i + 1 };
+                                lifo_enqueue_fast(&lifo, xylr_t, context);
+                                x = i;
+                                y = y + 1;
                                 break;
                             }
                         }
@@ -1289,13 +1601,12 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
                         cb(img, y, left, right, data);
                     }
 
-                    if (!lifo_size(&lifo)) {
+                    if (!lifo_is_not_empty(&lifo)) {
                         break_out = true;
                         break;
                     }
 
-                    xylr_t context;
-                    lifo_dequeue(&lifo, &context);
+                    xylr_t context = lifo_dequeue_fast(&lifo, xylr_t);
                     x = context.x;
                     y = context.y;
                     left = context.l;
@@ -1332,15 +1643,13 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
                     right++;
                 }
 
-                for (int i = left; i <= right; i++) {
-                    IMAGE_SET_BINARY_PIXEL_FAST(out_row, i);
-                }
+                binary_row_set_span(out_row, left, right);
 
                 int top_left = left;
                 int bot_left = left;
                 bool break_out = false;
                 for (;;) {
-                    if (lifo_size(&lifo) < lifo_len) {
+                    if (lifo_is_not_full(&lifo)) {
                         uint8_t *old_row = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
 
                         if (y > 0) {
@@ -1349,18 +1658,18 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
 
                             bool recurse = false;
                             for (int i = top_left; i <= right; i++) {
+                                if ((!(i & UINT32_T_MASK)) && (out_row[i >> UINT32_T_SHIFT] == 0xFFFFFFFF)) {
+                                    i += UINT32_T_MASK; // Skip filled words.
+                                    continue;
+                                }
+
                                 if ((!IMAGE_GET_BINARY_PIXEL_FAST(out_row, i))
                                     && COLOR_BOUND_GRAYSCALE(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row, i), seed_pixel, seed_threshold)
                                     && COLOR_BOUND_GRAYSCALE(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row, i),
                                                              IMAGE_GET_GRAYSCALE_PIXEL_FAST(old_row, i), floating_threshold)) {
-                                    xylr_t context;
-                                    context.x = x;
-                                    context.y = y;
-                                    context.l = left;
-                                    context.r = right;
-                                    context.t_l = i + 1; // Don't test the same pixel again...
-                                    context.b_l = bot_left;
-                                    lifo_enqueue(&lifo, &context);
+                                    // Don't test the same pixel again...
+                                    xylr_t context = { x, y, left, right, i + 1, bot_left };
+                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                     x = i;
                                     y = y - 1;
                                     recurse = true;
@@ -1378,18 +1687,18 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
 
                             bool recurse = false;
                             for (int i = bot_left; i <= right; i++) {
+                                if ((!(i & UINT32_T_MASK)) && (out_row[i >> UINT32_T_SHIFT] == 0xFFFFFFFF)) {
+                                    i += UINT32_T_MASK; // Skip filled words.
+                                    continue;
+                                }
+
                                 if ((!IMAGE_GET_BINARY_PIXEL_FAST(out_row, i))
                                     && COLOR_BOUND_GRAYSCALE(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row, i), seed_pixel, seed_threshold)
                                     && COLOR_BOUND_GRAYSCALE(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row, i),
                                                              IMAGE_GET_GRAYSCALE_PIXEL_FAST(old_row, i), floating_threshold)) {
-                                    xylr_t context;
-                                    context.x = x;
-                                    context.y = y;
-                                    context.l = left;
-                                    context.r = right;
-                                    context.t_l = top_left;
-                                    context.b_l = i + 1; // Don't test the same pixel again...
-                                    lifo_enqueue(&lifo, &context);
+                                    // Don't test the same pixel again...
+                                    xylr_t context = { x, y, left, right, top_left, i + 1 };
+                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                     x = i;
                                     y = y + 1;
                                     recurse = true;
@@ -1406,13 +1715,12 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
                         cb(img, y, left, right, data);
                     }
 
-                    if (!lifo_size(&lifo)) {
+                    if (!lifo_is_not_empty(&lifo)) {
                         break_out = true;
                         break;
                     }
 
-                    xylr_t context;
-                    lifo_dequeue(&lifo, &context);
+                    xylr_t context = lifo_dequeue_fast(&lifo, xylr_t);
                     x = context.x;
                     y = context.y;
                     left = context.l;
@@ -1449,15 +1757,13 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
                     right++;
                 }
 
-                for (int i = left; i <= right; i++) {
-                    IMAGE_SET_BINARY_PIXEL_FAST(out_row, i);
-                }
+                binary_row_set_span(out_row, left, right);
 
                 int top_left = left;
                 int bot_left = left;
                 bool break_out = false;
                 for (;;) {
-                    if (lifo_size(&lifo) < lifo_len) {
+                    if (lifo_is_not_full(&lifo)) {
                         uint16_t *old_row = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
 
                         if (y > 0) {
@@ -1466,18 +1772,18 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
 
                             bool recurse = false;
                             for (int i = top_left; i <= right; i++) {
+                                if ((!(i & UINT32_T_MASK)) && (out_row[i >> UINT32_T_SHIFT] == 0xFFFFFFFF)) {
+                                    i += UINT32_T_MASK; // Skip filled words.
+                                    continue;
+                                }
+
                                 if ((!IMAGE_GET_BINARY_PIXEL_FAST(out_row, i))
                                     && COLOR_BOUND_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i), seed_pixel, seed_threshold)
                                     && COLOR_BOUND_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i),
                                                           IMAGE_GET_RGB565_PIXEL_FAST(old_row, i), floating_threshold)) {
-                                    xylr_t context;
-                                    context.x = x;
-                                    context.y = y;
-                                    context.l = left;
-                                    context.r = right;
-                                    context.t_l = i + 1; // Don't test the same pixel again...
-                                    context.b_l = bot_left;
-                                    lifo_enqueue(&lifo, &context);
+                                    // Don't test the same pixel again...
+                                    xylr_t context = { x, y, left, right, i + 1, bot_left };
+                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                     x = i;
                                     y = y - 1;
                                     recurse = true;
@@ -1495,18 +1801,18 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
 
                             bool recurse = false;
                             for (int i = bot_left; i <= right; i++) {
+                                if ((!(i & UINT32_T_MASK)) && (out_row[i >> UINT32_T_SHIFT] == 0xFFFFFFFF)) {
+                                    i += UINT32_T_MASK; // Skip filled words.
+                                    continue;
+                                }
+
                                 if ((!IMAGE_GET_BINARY_PIXEL_FAST(out_row, i))
                                     && COLOR_BOUND_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i), seed_pixel, seed_threshold)
                                     && COLOR_BOUND_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row, i),
                                                           IMAGE_GET_RGB565_PIXEL_FAST(old_row, i), floating_threshold)) {
-                                    xylr_t context;
-                                    context.x = x;
-                                    context.y = y;
-                                    context.l = left;
-                                    context.r = right;
-                                    context.t_l = top_left;
-                                    context.b_l = i + 1; // Don't test the same pixel again...
-                                    lifo_enqueue(&lifo, &context);
+                                    // Don't test the same pixel again...
+                                    xylr_t context = { x, y, left, right, top_left, i + 1 };
+                                    lifo_enqueue_fast(&lifo, xylr_t, context);
                                     x = i;
                                     y = y + 1;
                                     recurse = true;
@@ -1523,13 +1829,12 @@ void imlib_flood_fill_int(image_t *out, image_t *img, int x, int y,
                         cb(img, y, left, right, data);
                     }
 
-                    if (!lifo_size(&lifo)) {
+                    if (!lifo_is_not_empty(&lifo)) {
                         break_out = true;
                         break;
                     }
 
-                    xylr_t context;
-                    lifo_dequeue(&lifo, &context);
+                    xylr_t context = lifo_dequeue_fast(&lifo, xylr_t);
                     x = context.x;
                     y = context.y;
                     left = context.l;
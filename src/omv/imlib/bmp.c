@@ -162,93 +162,69 @@ bool bmp_read_geometry(FIL *fp, image_t *img, const char *path, bmp_read_setting
     return (rs->bmp_h >= 0);
 }
 
-// This function reads the pixel values of an image.
-void bmp_read_pixels(FIL *fp, image_t *img, int n_lines, bmp_read_settings_t *rs) {
+#define BMP_READ_CHUNK_PIXELS   (64)
+
+// This function reads the next row of the file (in file order) into row, or skips it if row is NULL.
+void bmp_read_row(FIL *fp, image_t *img, void *row, bmp_read_settings_t *rs) {
+    if (!row) {
+        file_seek(fp, file_tell(fp) + rs->bmp_row_bytes);
+        return;
+    }
+
     if (rs->bmp_bpp == 8) {
-        if ((rs->bmp_h < 0) && (rs->bmp_w >= 0) && (img->w == rs->bmp_row_bytes)) {
-            file_read(fp, img->pixels, n_lines * img->w);
-        } else {
-            for (int i = 0; i < n_lines; i++) {
-                for (int j = 0; j < rs->bmp_row_bytes; j++) {
-                    uint8_t pixel;
-                    file_read(fp, &pixel, 1);
-                    if (j < img->w) {
-                        if (rs->bmp_h < 0) {
-                            // vertical flip (BMP file perspective)
-                            if (rs->bmp_w < 0) {
-                                // horizontal flip (BMP file perspective)
-                                IM_SET_GS_PIXEL(img, (img->w - j - 1), i, pixel);
-                            } else {
-                                IM_SET_GS_PIXEL(img, j, i, pixel);
-                            }
-                        } else {
-                            if (rs->bmp_w < 0) {
-                                IM_SET_GS_PIXEL(img, (img->w - j - 1), (img->h - i - 1), pixel);
-                            } else {
-                                IM_SET_GS_PIXEL(img, j, (img->h - i - 1), pixel);
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        file_read(fp, row, img->w);
     } else if (rs->bmp_bpp == 16) {
-        for (int i = 0; i < n_lines; i++) {
-            for (int j = 0, jj = rs->bmp_row_bytes / 2; j < jj; j++) {
-                uint16_t pixel;
-                file_read(fp, &pixel, 2);
-                if (j < img->w) {
-                    if (rs->bmp_h < 0) {
-                        // vertical flip (BMP file perspective)
-                        if (rs->bmp_w < 0) {
-                            // horizontal flip (BMP file perspective)
-                            IM_SET_RGB565_PIXEL(img, (img->w - j - 1), i, pixel);
-                        } else {
-                            IM_SET_RGB565_PIXEL(img, j, i, pixel);
-                        }
-                    } else {
-                        if (rs->bmp_w < 0) {
-                            IM_SET_RGB565_PIXEL(img, (img->w - j - 1), (img->h - i - 1), pixel);
-                        } else {
-                            IM_SET_RGB565_PIXEL(img, j, (img->h - i - 1), pixel);
-                        }
-                    }
-                }
+        file_read(fp, row, img->w * sizeof(uint16_t));
+    } else {
+        uint16_t *row16 = (uint16_t *) row;
+
+        // Converted in chunks so the reads stay large without a row sized buffer.
+        for (int x = 0; x < img->w; x += BMP_READ_CHUNK_PIXELS) {
+            uint8_t buf[BMP_READ_CHUNK_PIXELS * 3];
+            int n = IM_MIN(img->w - x, BMP_READ_CHUNK_PIXELS);
+            file_read(fp, buf, n * 3);
+
+            for (int i = 0; i < n; i++) {
+                row16[x + i] = COLOR_R8_G8_B8_TO_RGB565(buf[(i * 3) + 2], buf[(i * 3) + 1], buf[i * 3]);
             }
         }
-    } else if (rs->bmp_bpp == 24) {
-        for (int i = 0; i < n_lines; i++) {
-            for (int j = 0, jj = rs->bmp_row_bytes / 3; j < jj; j++) {
-                uint8_t b, g, r;
-                file_read(fp, &b, 1);
-                file_read(fp, &g, 1);
-                file_read(fp, &r, 1);
-                uint16_t pixel = COLOR_R8_G8_B8_TO_RGB565(r, g, b);
-                if (j < img->w) {
-                    if (rs->bmp_h < 0) {
-                        // vertical flip
-                        if (rs->bmp_w < 0) {
-                            // horizontal flip
-                            IM_SET_RGB565_PIXEL(img, (img->w - j - 1), i, pixel);
-                        } else {
-                            IM_SET_RGB565_PIXEL(img, j, i, pixel);
-                        }
-                    } else {
-                        if (rs->bmp_w < 0) {
-                            IM_SET_RGB565_PIXEL(img, (img->w - j - 1), (img->h - i - 1), pixel);
-                        } else {
-                            IM_SET_RGB565_PIXEL(img, j, (img->h - i - 1), pixel);
-                        }
-                    }
-                }
+    }
+
+    // Skip the row padding.
+    int pad = rs->bmp_row_bytes - (((img->w * rs->bmp_bpp) + 7) / 8);
+    if (pad) {
+        file_read(fp, NULL, pad);
+    }
+
+    if (rs->bmp_w < 0) {
+        // horizontal flip (BMP file perspective)
+        if (rs->bmp_bpp == 8) {
+            uint8_t *row8 = (uint8_t *) row;
+            for (int i = 0, j = img->w - 1; i < j; i++, j--) {
+                uint8_t tmp = row8[i];
+                row8[i] = row8[j];
+                row8[j] = tmp;
             }
-            for (int j = 0, jj = rs->bmp_row_bytes % 3; j < jj; j++) {
-                file_read(fp, NULL, 1);
+        } else {
+            uint16_t *row16 = (uint16_t *) row;
+            for (int i = 0, j = img->w - 1; i < j; i++, j--) {
+                uint16_t tmp = row16[i];
+                row16[i] = row16[j];
+                row16[j] = tmp;
             }
         }
     }
 }
 
+// This function reads the pixel values of an image.
+void bmp_read_pixels(FIL *fp, image_t *img, int n_lines, bmp_read_settings_t *rs) {
+    for (int i = 0; i < n_lines; i++) {
+        // vertical flip (BMP file perspective)
+        int y = (rs->bmp_h < 0) ? i : (img->h - i - 1);
+        bmp_read_row(fp, img, img->pixels + (y * img->w * img->bpp), rs);
+    }
+}
+
 void bmp_read(image_t *img, const char *path) {
     FIL fp;
     bmp_read_settings_t rs;
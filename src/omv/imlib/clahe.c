@@ -1,392 +1,153 @@
 /*
- * ANSI C code from the article
+ * Based on the ANSI C code from the article
  * "Contrast Limited Adaptive Histogram Equalization"
  * by Karel Zuiderveld, karel@cv.ruu.nl
  * in "Graphics Gems IV", Academic Press, 1994
  *
- *
- *  These functions implement Contrast Limited Adaptive Histogram Equalization.
- *  The main routine (CLAHE) expects an input image that is stored contiguously in
- *  memory;  the CLAHE output image overwrites the original input image and has the
- *  same minimum and maximum values (which must be provided by the user).
- *  This implementation assumes that the X- and Y image resolutions are an integer
- *  multiple of the X- and Y sizes of the contextual regions. A check on various other
- *  error conditions is performed.
- *
- *  #define the symbol BYTE_IMAGE to make this implementation suitable for
- *  8-bit images. The maximum number of contextual regions can be redefined
- *  by changing uiMAX_REG_X and/or uiMAX_REG_Y; the use of more than 256
- *  contextual regions is not recommended.
- *
- *  The code is ANSI-C and is also C++ compliant.
- *
  *  Author: Karel Zuiderveld, Computer Vision Research Group,
  *           Utrecht, The Netherlands (karel@cv.ruu.nl)
+ *
+ * The image is split into contextual regions (tiles) and a clipped, equalized 8-bit mapping is
+ * computed for each tile. The output pixel is a bilinear blend of the mappings of the 4 closest
+ * tile centers. The image is processed in place (on the luminance for RGB565) and the tiles don't
+ * have to divide the image evenly.
  */
 #include "imlib.h"
-#define BYTE_IMAGE
-
-#ifdef BYTE_IMAGE
-typedef unsigned char kz_pixel_t;        /* for 8 bit-per-pixel images */
-#define uiNR_OF_GREY    (256)
-#else
-typedef unsigned short kz_pixel_t;       /* for 12 bit-per-pixel images (default) */
-#define uiNR_OF_GREY    (4096)
-#endif
 
-/******** Prototype of CLAHE function. Put this in a separate include file. *****/
-int CLAHE(kz_pixel_t *pImage, unsigned int uiXRes, unsigned int uiYRes, kz_pixel_t Min,
-          kz_pixel_t Max, unsigned int uiNrX, unsigned int uiNrY,
-          unsigned int uiNrBins, float fCliplimit);
-
-/*********************** Local prototypes ************************/
-static void ClipHistogram(unsigned long *, unsigned int, unsigned long);
-static void MakeHistogram(kz_pixel_t *, unsigned int, unsigned int, unsigned int,
-                          unsigned long *, unsigned int, kz_pixel_t *);
-static void MapHistogram(unsigned long *, kz_pixel_t, kz_pixel_t,
-                         unsigned int, unsigned long);
-static void MakeLut(kz_pixel_t *, kz_pixel_t, kz_pixel_t, unsigned int);
-static void Interpolate(kz_pixel_t *, int, unsigned long *, unsigned long *,
-                        unsigned long *, unsigned long *, unsigned int, unsigned int, kz_pixel_t *);
-
-/**************  Start of actual code **************/
-const unsigned int uiMAX_REG_X = 16;      /* max. # contextual regions in x-direction */
-const unsigned int uiMAX_REG_Y = 16;      /* max. # contextual regions in y-direction */
-
-/************************** main function CLAHE ******************/
-int CLAHE(kz_pixel_t *pImage, unsigned int uiXRes, unsigned int uiYRes,
-          kz_pixel_t Min, kz_pixel_t Max, unsigned int uiNrX, unsigned int uiNrY,
-          unsigned int uiNrBins, float fCliplimit) {
-/*   pImage - Pointer to the input/output image
- *   uiXRes - Image resolution in the X direction
- *   uiYRes - Image resolution in the Y direction
- *   Min - Minimum greyvalue of input image (also becomes minimum of output image)
- *   Max - Maximum greyvalue of input image (also becomes maximum of output image)
- *   uiNrX - Number of contextial regions in the X direction (min 2, max uiMAX_REG_X)
- *   uiNrY - Number of contextial regions in the Y direction (min 2, max uiMAX_REG_Y)
- *   uiNrBins - Number of greybins for histogram ("dynamic range")
- *   float fCliplimit - Normalized cliplimit (higher values give more contrast)
- * The number of "effective" greylevels in the output image is set by uiNrBins; selecting
- * a small value (eg. 128) speeds up processing and still produce an output image of
- * good quality. The output image will have the same minimum and maximum value as the input
- * image. A clip limit smaller than 1 results in standard (non-contrast limited) AHE.
- */
-    unsigned int uiX, uiY;                /* counters */
-    unsigned int uiXSize, uiYSize, uiSubX, uiSubY; /* size of context. reg. and subimages */
-    unsigned int uiXL, uiXR, uiYU, uiYB;  /* auxiliary variables interpolation routine */
-    unsigned long ulClipLimit, ulNrPixels;/* clip limit and region pixel count */
-    kz_pixel_t *pImPointer;               /* pointer to image */
-    kz_pixel_t aLUT[uiNR_OF_GREY];        /* lookup table used for scaling of input image */
-    unsigned long *pulHist, *pulMapArray; /* pointer to histogram and mappings*/
-    unsigned long *pulLU, *pulLB, *pulRU, *pulRB; /* auxiliary pointers interpolation */
-
-    if (uiNrX > uiMAX_REG_X) {
-        return -1;                        /* # of regions x-direction too large */
-    }
-    if (uiNrY > uiMAX_REG_Y) {
-        return -2;                        /* # of regions y-direction too large */
-    }
-    if (uiXRes % uiNrX) {
-        return -3;                        /* x-resolution no multiple of uiNrX */
-    }
-    if (uiYRes % uiNrY) {
-        return -4;                        /* y-resolution no multiple of uiNrY */
-    }
-    if (Max >= uiNR_OF_GREY) {
-        return -5;                        /* maximum too large */
-    }
-    if (Min >= Max) {
-        return -6;                        /* minimum equal or larger than maximum */
-    }
-    if (uiNrX < 2 || uiNrY < 2) {
-        return -7;                        /* at least 4 contextual regions required */
-    }
-    if (fCliplimit == 1.0) {
-        return 0;                         /* is OK, immediately returns original image. */
-    }
-    if (uiNrBins == 0) {
-        uiNrBins = 128;                   /* default value when not specified */
+#define CLAHE_BINS      (COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN + 1)
+#define CLAHE_MAX_REG_X (16) // max. # contextual regions in x-direction
+#define CLAHE_MAX_REG_Y (16) // max. # contextual regions in y-direction
 
-    }
-    pulMapArray = (unsigned long *) fb_alloc(sizeof(unsigned long) * uiNrX * uiNrY * uiNrBins, FB_ALLOC_NO_HINT);
-    if (pulMapArray == 0) {
-        return -8;                        /* Not enough memory! (try reducing uiNrBins) */
+// Tile i spans [CLAHE_TILE_START(i), CLAHE_TILE_START(i + 1)).
+#define CLAHE_TILE_START(i, n, size) (((i) * (size)) / (n))
 
-    }
-    uiXSize = uiXRes / uiNrX; uiYSize = uiYRes / uiNrY;  /* Actual size of contextual regions */
-    ulNrPixels = (unsigned long) uiXSize * (unsigned long) uiYSize;
+static void clip_histogram(uint32_t *hist, uint32_t clip_limit) {
+    // This function performs clipping of the histogram and redistribution of bins.
+    // The histogram is clipped and the number of excess pixels is counted. Afterwards
+    // the excess pixels are equally redistributed across the whole histogram (providing
+    // the bin count is smaller than the cliplimit).
+    uint32_t excess = 0;
 
-    if (fCliplimit > 0.0) {
-        /* Calculate actual cliplimit  */
-        ulClipLimit = (unsigned long) (fCliplimit * (uiXSize * uiYSize) / uiNrBins);
-        ulClipLimit = (ulClipLimit < 1UL) ? 1UL : ulClipLimit;
-    } else {
-        ulClipLimit = 1UL << 14;          /* Large value, do not clip (AHE) */
-    }
-    MakeLut(aLUT, Min, Max, uiNrBins);    /* Make lookup table for mapping of greyvalues */
-    /* Calculate greylevel mappings for each contextual region */
-    for (uiY = 0, pImPointer = pImage; uiY < uiNrY; uiY++) {
-        for (uiX = 0; uiX < uiNrX; uiX++, pImPointer += uiXSize) {
-            pulHist = &pulMapArray[uiNrBins * (uiY * uiNrX + uiX)];
-            MakeHistogram(pImPointer, uiXRes, uiXSize, uiYSize, pulHist, uiNrBins, aLUT);
-            ClipHistogram(pulHist, uiNrBins, ulClipLimit);
-            MapHistogram(pulHist, Min, Max, uiNrBins, ulNrPixels);
+    for (int i = 0; i < CLAHE_BINS; i++) {
+        if (hist[i] > clip_limit) {
+            excess += hist[i] - clip_limit;
         }
-        pImPointer += (uiYSize - 1) * uiXRes;             /* skip lines, set pointer */
     }
 
-    /* Interpolate greylevel mappings to get CLAHE image */
-    for (pImPointer = pImage, uiY = 0; uiY <= uiNrY; uiY++) {
-        if (uiY == 0) {
-            /* special case: top row */
-            uiSubY = uiYSize >> 1;  uiYU = 0; uiYB = 0;
-        } else {
-            if (uiY == uiNrY) {
-                /* special case: bottom row */
-                uiSubY = (uiYSize + 1) >> 1;        uiYU = uiNrY - 1;  uiYB = uiYU;
-            } else {
-                /* default values */
-                uiSubY = uiYSize; uiYU = uiY - 1; uiYB = uiYU + 1;
-            }
-        }
-        for (uiX = 0; uiX <= uiNrX; uiX++) {
-            if (uiX == 0) {
-                /* special case: left column */
-                uiSubX = uiXSize >> 1; uiXL = 0; uiXR = 0;
-            } else {
-                if (uiX == uiNrX) {
-                    /* special case: right column */
-                    uiSubX = (uiXSize + 1) >> 1;  uiXL = uiNrX - 1; uiXR = uiXL;
-                } else {
-                    /* default values */
-                    uiSubX = uiXSize; uiXL = uiX - 1; uiXR = uiXL + 1;
-                }
-            }
-
-            pulLU = &pulMapArray[uiNrBins * (uiYU * uiNrX + uiXL)];
-            pulRU = &pulMapArray[uiNrBins * (uiYU * uiNrX + uiXR)];
-            pulLB = &pulMapArray[uiNrBins * (uiYB * uiNrX + uiXL)];
-            pulRB = &pulMapArray[uiNrBins * (uiYB * uiNrX + uiXR)];
-            Interpolate(pImPointer, uiXRes, pulLU, pulRU, pulLB, pulRB, uiSubX, uiSubY, aLUT);
-            pImPointer += uiSubX;                         /* set pointer on next matrix */
-        }
-        pImPointer += (uiSubY - 1) * uiXRes;
-    }
-    fb_free();                                            /* free space for histograms */
-    return 0;                                             /* return status OK */
-}
-
-void ClipHistogram(unsigned long *pulHistogram, unsigned int
-                   uiNrGreylevels, unsigned long ulClipLimit) {
-/* This function performs clipping of the histogram and redistribution of bins.
- * The histogram is clipped and the number of excess pixels is counted. Afterwards
- * the excess pixels are equally redistributed across the whole histogram (providing
- * the bin count is smaller than the cliplimit).
- */
-    unsigned long *pulBinPointer, *pulEndPointer, *pulHisto;
-    unsigned long ulNrExcess, ulUpper, ulBinIncr, ulStepSize, i;
-    long lBinExcess;
+    uint32_t bin_incr = excess / CLAHE_BINS; // average bin increment
+    uint32_t upper = clip_limit - bin_incr; // bins larger than upper are set to the clip limit
 
-    ulNrExcess = 0;  pulBinPointer = pulHistogram;
-    for (i = 0; i < uiNrGreylevels; i++) {
-        /* calculate total number of excess pixels */
-        lBinExcess = (long) pulBinPointer[i] - (long) ulClipLimit;
-        if (lBinExcess > 0) {
-            ulNrExcess += lBinExcess;                   /* excess in current bin */
-        }
-    }
-    ;
-
-    /* Second part: clip histogram and redistribute excess pixels in each bin */
-    ulBinIncr = ulNrExcess / uiNrGreylevels;            /* average binincrement */
-    ulUpper = ulClipLimit - ulBinIncr;     /* Bins larger than ulUpper set to cliplimit */
-
-    for (i = 0; i < uiNrGreylevels; i++) {
-        if (pulHistogram[i] > ulClipLimit) {
-            pulHistogram[i] = ulClipLimit;                              /* clip bin */
+    for (int i = 0; i < CLAHE_BINS; i++) {
+        if (hist[i] > clip_limit) {
+            hist[i] = clip_limit;
+        } else if (hist[i] > upper) {
+            excess -= hist[i] - upper;
+            hist[i] = clip_limit;
         } else {
-            if (pulHistogram[i] > ulUpper) {
-                /* high bin count */
-                ulNrExcess -= pulHistogram[i] - ulUpper; pulHistogram[i] = ulClipLimit;
-            } else {
-                /* low bin count */
-                ulNrExcess -= ulBinIncr; pulHistogram[i] += ulBinIncr;
-            }
+            excess -= bin_incr;
+            hist[i] += bin_incr;
         }
     }
 
-    while (ulNrExcess) {
-        /* Redistribute remaining excess  */
-        pulEndPointer = &pulHistogram[uiNrGreylevels]; pulHisto = pulHistogram;
-
-        while (ulNrExcess && pulHisto < pulEndPointer) {
-            ulStepSize = uiNrGreylevels / ulNrExcess;
-            if (ulStepSize < 1) {
-                ulStepSize = 1;                         /* stepsize at least 1 */
-            }
-            for (pulBinPointer = pulHisto; pulBinPointer < pulEndPointer && ulNrExcess;
-                 pulBinPointer += ulStepSize) {
-                if (*pulBinPointer < ulClipLimit) {
-                    (*pulBinPointer)++;  ulNrExcess--;  /* reduce excess */
+    // Redistribute the remaining excess.
+    for (int start = 0; excess; start = 0) {
+        for (; excess && (start < CLAHE_BINS); start++) {
+            int step = IM_MAX(CLAHE_BINS / (int) excess, 1);
+            for (int i = start; (i < CLAHE_BINS) && excess; i += step) {
+                if (hist[i] < clip_limit) {
+                    hist[i]++;
+                    excess--;
                 }
             }
-            pulHisto++;  /* restart redistributing on other bin location */
-        }
-    }
-}
-
-void MakeHistogram(kz_pixel_t *pImage, unsigned int uiXRes,
-                   unsigned int uiSizeX, unsigned int uiSizeY,
-                   unsigned long *pulHistogram,
-                   unsigned int uiNrGreylevels, kz_pixel_t *pLookupTable) {
-/* This function classifies the greylevels present in the array image into
- * a greylevel histogram. The pLookupTable specifies the relationship
- * between the greyvalue of the pixel (typically between 0 and 4095) and
- * the corresponding bin in the histogram (usually containing only 128 bins).
- */
-    kz_pixel_t *pImagePointer;
-    unsigned int i;
-
-    for (i = 0; i < uiNrGreylevels; i++) {
-        pulHistogram[i] = 0L;                                  /* clear histogram */
-
-    }
-    for (i = 0; i < uiSizeY; i++) {
-        pImagePointer = &pImage[uiSizeX];
-        while (pImage < pImagePointer) {
-            pulHistogram[pLookupTable[*pImage++]]++;
         }
-        pImagePointer += uiXRes;
-        pImage = &pImagePointer[-(int) uiSizeX];        /* go to bdeginning of next row */
     }
 }
 
-void MapHistogram(unsigned long *pulHistogram, kz_pixel_t Min, kz_pixel_t Max,
-                  unsigned int uiNrGreylevels, unsigned long ulNrOfPixels) {
-/* This function calculates the equalized lookup table (mapping) by
- * cumulating the input histogram. Note: lookup table is rescaled in range [Min..Max].
- */
-    unsigned int i;  unsigned long ulSum = 0;
-    const float fScale = ((float) (Max - Min)) / ulNrOfPixels;
-    const unsigned long ulMin = (unsigned long) Min;
+// Computes the blend coefficients of a pixel between the two closest tile centers.
+static void clahe_coefs(int pos, int n, int size, int *t0, int *t1, int *weight) {
+    // Positions are doubled so that pixel and tile centers are integers.
+    int p2 = (pos * 2) + 1;
+    int t = IM_MIN((pos * n) / size, n - 1);
+    int c2 = CLAHE_TILE_START(t, n, size) + CLAHE_TILE_START(t + 1, n, size);
 
-    for (i = 0; i < uiNrGreylevels; i++) {
-        ulSum += pulHistogram[i]; pulHistogram[i] = (unsigned long) (ulMin + ulSum * fScale);
-        if (pulHistogram[i] > Max) {
-            pulHistogram[i] = Max;
-        }
+    if (p2 < c2) {
+        t--;
     }
-}
-
-void MakeLut(kz_pixel_t *pLUT, kz_pixel_t Min, kz_pixel_t Max, unsigned int uiNrBins) {
-/* To speed up histogram clipping, the input image [Min,Max] is scaled down to
- * [0,uiNrBins-1]. This function calculates the LUT.
- */
-    int i;
-    const kz_pixel_t BinSize = (kz_pixel_t) (1 + (Max - Min) / uiNrBins);
 
-    for (i = Min; i <= Max; i++) {
-        pLUT[i] = (i - Min) / BinSize;
+    if (t < 0) {
+        *t0 = *t1 = 0;
+        *weight = 0;
+    } else if (t >= (n - 1)) {
+        *t0 = *t1 = n - 1;
+        *weight = 0;
+    } else {
+        int c2_0 = CLAHE_TILE_START(t, n, size) + CLAHE_TILE_START(t + 1, n, size);
+        int c2_1 = CLAHE_TILE_START(t + 1, n, size) + CLAHE_TILE_START(t + 2, n, size);
+        *t0 = t;
+        *t1 = t + 1;
+        *weight = ((p2 - c2_0) << 8) / (c2_1 - c2_0);
     }
 }
 
-void Interpolate(kz_pixel_t *pImage, int uiXRes, unsigned long *pulMapLU,
-                 unsigned long *pulMapRU, unsigned long *pulMapLB,  unsigned long *pulMapRB,
-                 unsigned int uiXSize, unsigned int uiYSize, kz_pixel_t *pLUT) {
-/* pImage      - pointer to input/output image
- * uiXRes      - resolution of image in x-direction
- * pulMap*     - mappings of greylevels from histograms
- * uiXSize     - uiXSize of image submatrix
- * uiYSize     - uiYSize of image submatrix
- * pLUT        - lookup table containing mapping greyvalues to bins
- * This function calculates the new greylevel assignments of pixels within a submatrix
- * of the image with size uiXSize and uiYSize. This is done by a bilinear interpolation
- * between four different mappings in order to eliminate boundary artifacts.
- * It uses a division; since division is often an expensive operation, I added code to
- * perform a logical shift instead when feasible.
- */
-    const unsigned int uiIncr = uiXRes - uiXSize; /* Pointer increment after processing row */
-    kz_pixel_t GreyValue; unsigned int uiNum = uiXSize * uiYSize; /* Normalization factor */
-
-    unsigned int uiXCoef, uiYCoef, uiXInvCoef, uiYInvCoef, uiShift = 0;
-
-    if (uiNum & (uiNum - 1)) {
-        /* If uiNum is not a power of two, use division */
-        for (uiYCoef = 0, uiYInvCoef = uiYSize; uiYCoef < uiYSize;
-             uiYCoef++, uiYInvCoef--, pImage += uiIncr) {
-            for (uiXCoef = 0, uiXInvCoef = uiXSize; uiXCoef < uiXSize;
-                 uiXCoef++, uiXInvCoef--) {
-                GreyValue = pLUT[*pImage];         /* get histogram bin value */
-                *pImage++ = (kz_pixel_t) ((uiYInvCoef * (uiXInvCoef * pulMapLU[GreyValue]
-                                                         + uiXCoef * pulMapRU[GreyValue])
-                                           + uiYCoef * (uiXInvCoef * pulMapLB[GreyValue]
-                                                        + uiXCoef * pulMapRB[GreyValue])) / uiNum);
+static uint8_t *clahe_get_line(image_t *img, int y, uint8_t *line) {
+    switch (img->pixfmt) {
+        case PIXFORMAT_BINARY: {
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                line[x] = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
             }
+            return line;
         }
-    } else{
-        /* avoid the division and use a right shift instead */
-        while (uiNum >>= 1) {
-            uiShift++;                             /* Calculate 2log of uiNum */
+        case PIXFORMAT_GRAYSCALE: {
+            return IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
         }
-        for (uiYCoef = 0, uiYInvCoef = uiYSize; uiYCoef < uiYSize;
-             uiYCoef++, uiYInvCoef--, pImage += uiIncr) {
-            for (uiXCoef = 0, uiXInvCoef = uiXSize; uiXCoef < uiXSize;
-                 uiXCoef++, uiXInvCoef--) {
-                GreyValue = pLUT[*pImage];        /* get histogram bin value */
-                *pImage++ = (kz_pixel_t) ((uiYInvCoef * (uiXInvCoef * pulMapLU[GreyValue]
-                                                         + uiXCoef * pulMapRU[GreyValue])
-                                           + uiYCoef * (uiXInvCoef * pulMapLB[GreyValue]
-                                                        + uiXCoef * pulMapRB[GreyValue])) >> uiShift);
+        case PIXFORMAT_RGB565: {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                line[x] = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
             }
+            return line;
+        }
+        default: {
+            return NULL;
         }
     }
 }
 
-void imlib_clahe_histeq(image_t *img, float clip_limit, image_t *mask) {
-    int xTileSize = IM_MAX(uiMAX_REG_X >> (10 - IM_MIN(IM_LOG2_32(img->w), 10)), 2u);
-    int yTileSize = IM_MAX(uiMAX_REG_Y >> (10 - IM_MIN(IM_LOG2_32(img->h), 10)), 2u);
-    int pImageW = img->w + ((img->w % xTileSize) ? (xTileSize - (img->w % xTileSize)) : 0);
-    int pImageH = img->h + ((img->h % yTileSize) ? (yTileSize - (img->h % yTileSize)) : 0);
-    int xOffset = (pImageW - img->w) / 2;
-    int yOffset = (pImageH - img->h) / 2;
-
-    image_t temp;
-    temp.w = img->w;
-    temp.h = img->h;
-    temp.pixfmt = img->pixfmt;
-    temp.data = fb_alloc0(pImageW * pImageH * sizeof(kz_pixel_t), FB_ALLOC_NO_HINT);
-
+static void clahe_put_line(image_t *img, int y, uint8_t *line, image_t *mask) {
     switch (img->pixfmt) {
         case PIXFORMAT_BINARY: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset,
-                                                   COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x)));
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                    continue;
                 }
+                IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, COLOR_GRAYSCALE_TO_BINARY(line[x]));
             }
             break;
         }
         case PIXFORMAT_GRAYSCALE: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset,
-                                                   IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x));
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+            if (!mask) {
+                memcpy(row_ptr, line, img->w);
+                break;
+            }
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                if (image_get_mask_pixel(mask, x, y)) {
+                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row_ptr, x, line[x]);
                 }
             }
             break;
         }
         case PIXFORMAT_RGB565: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset,
-                                                   COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x)));
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                    continue;
                 }
+                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+                IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x,
+                                            imlib_yuv_to_rgb(line[x], COLOR_RGB565_TO_U(pixel), COLOR_RGB565_TO_V(pixel)));
             }
             break;
         }
@@ -394,65 +155,101 @@ void imlib_clahe_histeq(image_t *img, float clip_limit, image_t *mask) {
             break;
         }
     }
+}
 
-    CLAHE((kz_pixel_t *) temp.data,
-          pImageW, pImageH,
-          COLOR_GRAYSCALE_MIN, COLOR_GRAYSCALE_MAX,
-          xTileSize, yTileSize,
-          COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN + 1,
-          clip_limit);
-
-    switch (img->pixfmt) {
-        case PIXFORMAT_BINARY: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        continue;
-                    }
-                    IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x,
-                                                COLOR_GRAYSCALE_TO_BINARY(IMAGE_GET_GRAYSCALE_PIXEL_FAST(clahe_row_ptr,
-                                                                                                         x + xOffset)));
+void imlib_clahe_histeq(image_t *img, float clip_limit, image_t *mask) {
+    int x_tiles = IM_MAX(CLAHE_MAX_REG_X >> (10 - IM_MIN((int) IM_LOG2_32(img->w), 10)), 2);
+    int y_tiles = IM_MAX(CLAHE_MAX_REG_Y >> (10 - IM_MIN((int) IM_LOG2_32(img->h), 10)), 2);
+    x_tiles = IM_MIN(x_tiles, img->w);
+    y_tiles = IM_MIN(y_tiles, img->h);
+
+    // A clip limit of 1 leaves the image unchanged.
+    if ((clip_limit == 1.0f) || ((img->pixfmt != PIXFORMAT_BINARY) &&
+                                 (img->pixfmt != PIXFORMAT_GRAYSCALE) &&
+                                 (img->pixfmt != PIXFORMAT_RGB565))) {
+        return;
+    }
+
+    uint8_t *luts = fb_alloc(x_tiles * y_tiles * CLAHE_BINS, FB_ALLOC_PREFER_TCM);
+    uint32_t *hist = fb_alloc(x_tiles * CLAHE_BINS * sizeof(uint32_t), FB_ALLOC_PREFER_TCM);
+    uint8_t *line = fb_alloc(img->w, FB_ALLOC_PREFER_TCM);
+
+    // Compute the mapping of each tile, one row of tiles at a time.
+    for (int ty = 0; ty < y_tiles; ty++) {
+        int y_start = CLAHE_TILE_START(ty, y_tiles, img->h);
+        int y_end = CLAHE_TILE_START(ty + 1, y_tiles, img->h);
+        memset(hist, 0, x_tiles * CLAHE_BINS * sizeof(uint32_t));
+
+        for (int y = y_start; y < y_end; y++) {
+            uint8_t *pixels = clahe_get_line(img, y, line);
+            for (int tx = 0; tx < x_tiles; tx++) {
+                uint32_t *tile_hist = hist + (tx * CLAHE_BINS);
+                for (int x = CLAHE_TILE_START(tx, x_tiles, img->w),
+                     xx = CLAHE_TILE_START(tx + 1, x_tiles, img->w); x < xx; x++) {
+                    tile_hist[pixels[x]]++;
                 }
             }
-            break;
         }
-        case PIXFORMAT_GRAYSCALE: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        continue;
-                    }
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row_ptr, x,
-                                                   IMAGE_GET_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset));
-                }
+
+        for (int tx = 0; tx < x_tiles; tx++) {
+            uint32_t *tile_hist = hist + (tx * CLAHE_BINS);
+            uint8_t *lut = luts + (((ty * x_tiles) + tx) * CLAHE_BINS);
+            uint32_t pixels = (y_end - y_start) *
+                              (CLAHE_TILE_START(tx + 1, x_tiles, img->w) - CLAHE_TILE_START(tx, x_tiles, img->w));
+
+            // A clip limit of 0 or less results in standard (non-contrast limited) AHE. The limit
+            // is kept high enough for the clipped pixels to fit back into the histogram.
+            if (clip_limit > 0.0f) {
+                uint32_t limit = (clip_limit * pixels) / CLAHE_BINS;
+                clip_histogram(tile_hist, IM_MAX(limit, (pixels + CLAHE_BINS - 1) / CLAHE_BINS));
             }
-            break;
-        }
-        case PIXFORMAT_RGB565: {
-            for (int y = 0, yy = img->h; y < yy; y++) {
-                uint8_t *clahe_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&temp, y + yOffset);
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
-                for (int x = 0, xx = img->w; x < xx; x++) {
-                    if (mask && (!image_get_mask_pixel(mask, x, y))) {
-                        continue;
-                    }
-                    int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
-                    IMAGE_PUT_RGB565_PIXEL_FAST(row_ptr, x,
-                                                imlib_yuv_to_rgb(IMAGE_GET_GRAYSCALE_PIXEL_FAST(clahe_row_ptr, x + xOffset),
-                                                                 COLOR_RGB565_TO_U(pixel),
-                                                                 COLOR_RGB565_TO_V(pixel)));
-                }
+
+            for (uint32_t i = 0, sum = 0; i < CLAHE_BINS; i++) {
+                sum += tile_hist[i];
+                lut[i] = IM_MIN((sum * COLOR_GRAYSCALE_MAX) / pixels, (uint32_t) COLOR_GRAYSCALE_MAX);
             }
-            break;
         }
-        default: {
-            break;
+    }
+
+    fb_free(); // line
+    fb_free(); // hist
+
+    // Per column LUT offsets and blend weights (0-256).
+    uint16_t *x_lut_l = fb_alloc(img->w * sizeof(uint16_t), FB_ALLOC_PREFER_TCM);
+    uint16_t *x_lut_r = fb_alloc(img->w * sizeof(uint16_t), FB_ALLOC_PREFER_TCM);
+    uint16_t *x_weight = fb_alloc(img->w * sizeof(uint16_t), FB_ALLOC_PREFER_TCM);
+    line = fb_alloc(img->w, FB_ALLOC_PREFER_TCM);
+
+    for (int x = 0; x < img->w; x++) {
+        int tl, tr, w;
+        clahe_coefs(x, x_tiles, img->w, &tl, &tr, &w);
+        x_lut_l[x] = tl * CLAHE_BINS;
+        x_lut_r[x] = tr * CLAHE_BINS;
+        x_weight[x] = w;
+    }
+
+    for (int y = 0; y < img->h; y++) {
+        int tt, tb, wy;
+        clahe_coefs(y, y_tiles, img->h, &tt, &tb, &wy);
+        uint8_t *lut_t = luts + (tt * x_tiles * CLAHE_BINS);
+        uint8_t *lut_b = luts + (tb * x_tiles * CLAHE_BINS);
+        uint8_t *pixels = clahe_get_line(img, y, line);
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            int l = x_lut_l[x] + pixels[x];
+            int r = x_lut_r[x] + pixels[x];
+            int wx = x_weight[x];
+            int t = (lut_t[l] << 8) + ((lut_t[r] - lut_t[l]) * wx);
+            int b = (lut_b[l] << 8) + ((lut_b[r] - lut_b[l]) * wx);
+            line[x] = ((t << 8) + ((b - t) * wy) + (1 << 15)) >> 16;
         }
+
+        clahe_put_line(img, y, line, mask);
     }
 
-    fb_free();
+    fb_free(); // line
+    fb_free(); // x_weight
+    fb_free(); // x_lut_r
+    fb_free(); // x_lut_l
+    fb_free(); // luts
 }
@@ -0,0 +1,97 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Multi-code scanner.
+ *
+ * Runs the enabled 1/2D bar code detectors over one grayscale copy of the roi, sharing a
+ * single time budget. Grayscale images are used in place, which the data matrix and bar code
+ * detectors read directly without a copy of their own.
+ */
+#include "imlib.h"
+
+// Every code result starts with its corners and bounding rect.
+typedef struct find_codes_lnk_data {
+    point_t corners[4];
+    rectangle_t rect;
+} find_codes_lnk_data_t;
+
+static void imlib_find_codes_offset(list_t *list, int x_offset, int y_offset) {
+    list_for_each(it, list) {
+        find_codes_lnk_data_t *lnk_data = list_get_data(it);
+
+        for (int i = 0; i < 4; i++) {
+            lnk_data->corners[i].x += x_offset;
+            lnk_data->corners[i].y += y_offset;
+        }
+
+        lnk_data->rect.x += x_offset;
+        lnk_data->rect.y += y_offset;
+    }
+}
+
+void imlib_find_codes(find_codes_t *out, image_t *ptr, rectangle_t *roi, find_codes_types_t types,
+                      apriltag_families_t families, float fx, float fy, float cx, float cy, int effort,
+                      imlib_deadline_t *deadline) {
+    list_init(&out->qrcodes, sizeof(find_qrcodes_list_lnk_data_t));
+    list_init(&out->apriltags, sizeof(find_apriltags_list_lnk_data_t));
+    list_init(&out->datamatrices, sizeof(find_datamatrices_list_lnk_data_t));
+    list_init(&out->barcodes, sizeof(find_barcodes_list_lnk_data_t));
+
+    image_t img = *ptr;
+    rectangle_t rect = *roi;
+
+    if (ptr->pixfmt != PIXFORMAT_GRAYSCALE) {
+        image_init(&img, roi->w, roi->h, PIXFORMAT_GRAYSCALE, 0, NULL);
+        img.data = fb_alloc(image_size(&img), FB_ALLOC_NO_HINT);
+        imlib_draw_image(&img, ptr, 0, 0, 1.f, 1.f, roi, -1, 256, NULL, NULL, 0, NULL, NULL, NULL);
+        rectangle_init(&rect, 0, 0, roi->w, roi->h);
+    }
+
+    // Moves results from the grayscale copy back into the source image.
+    int x_offset = roi->x - rect.x;
+    int y_offset = roi->y - rect.y;
+
+    #ifdef IMLIB_ENABLE_QRCODES
+    if ((types & FIND_CODES_QRCODES) && !imlib_deadline_expired(deadline)) {
+        imlib_find_qrcodes(&out->qrcodes, &img, &rect, 1, deadline);
+        imlib_find_codes_offset(&out->qrcodes, x_offset, y_offset);
+    }
+    #endif
+
+    #ifdef IMLIB_ENABLE_DATAMATRICES
+    if ((types & FIND_CODES_DATAMATRICES) && !imlib_deadline_expired(deadline)) {
+        imlib_find_datamatrices(&out->datamatrices, &img, &rect, NULL, effort, deadline);
+        imlib_find_codes_offset(&out->datamatrices, x_offset, y_offset);
+    }
+    #endif
+
+    #if defined(IMLIB_ENABLE_BARCODES) && (!defined(OMV_NO_GPL))
+    if ((types & FIND_CODES_BARCODES) && !imlib_deadline_expired(deadline)) {
+        imlib_find_barcodes(&out->barcodes, &img, &rect, 1, 1, false, false, deadline);
+        imlib_find_codes_offset(&out->barcodes, x_offset, y_offset);
+    }
+    #endif
+
+    #ifdef IMLIB_ENABLE_APRILTAGS
+    if ((types & FIND_CODES_APRILTAGS) && (rect.w >= 4) && (rect.h >= 4) && !imlib_deadline_expired(deadline)) {
+        // The pose is computed relative to the optical center, so move it with the copy.
+        imlib_find_apriltags(&out->apriltags, &img, &rect, families, fx, fy, cx - x_offset, cy - y_offset, 1, deadline);
+        imlib_find_codes_offset(&out->apriltags, x_offset, y_offset);
+
+        list_for_each(it, (&out->apriltags)) {
+            find_apriltags_list_lnk_data_t *lnk_data = list_get_data(it);
+            lnk_data->centroid_x += x_offset;
+            lnk_data->centroid_y += y_offset;
+        }
+    }
+    #endif
+
+    if (ptr->pixfmt != PIXFORMAT_GRAYSCALE) {
+        fb_free(); // img.data
+    }
+}
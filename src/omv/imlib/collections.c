@@ -64,18 +64,6 @@ void lifo_clear(lifo_t *ptr) {
     ptr->len = 0;
 }
 
-size_t lifo_size(lifo_t *ptr) {
-    return ptr->len;
-}
-
-bool lifo_is_not_empty(lifo_t *ptr) {
-    return ptr->len;
-}
-
-bool lifo_is_not_full(lifo_t *ptr) {
-    return ptr->len != ptr->size;
-}
-
 void lifo_enqueue(lifo_t *ptr, void *data) {
     memcpy(ptr->data + (ptr->len * ptr->data_len), data, ptr->data_len);
 
@@ -131,18 +119,6 @@ void fifo_clear(fifo_t *ptr) {
     ptr->len = 0;
 }
 
-size_t fifo_size(fifo_t *ptr) {
-    return ptr->len;
-}
-
-bool fifo_is_not_empty(fifo_t *ptr) {
-    return ptr->len;
-}
-
-bool fifo_is_not_full(fifo_t *ptr) {
-    return ptr->len != ptr->size;
-}
-
 void fifo_enqueue(fifo_t *ptr, void *data) {
     memcpy(ptr->data + (ptr->head * ptr->data_len), data, ptr->data_len);
 
@@ -207,10 +183,6 @@ void list_clear(list_t *ptr) {
     ptr->size = 0;
 }
 
-size_t list_size(list_t *ptr) {
-    return ptr->size;
-}
-
 static void list_link(list_t *dst, list_lnk_t *insert_before, list_lnk_t *lnk) {
     if (!dst->size) {
         lnk->next = NULL;
@@ -39,13 +39,27 @@ void lifo_alloc(lifo_t *ptr, size_t size, size_t data_len);
 void lifo_alloc_all(lifo_t *ptr, size_t *size, size_t data_len);
 void lifo_free(lifo_t *ptr);
 void lifo_clear(lifo_t *ptr);
-size_t lifo_size(lifo_t *ptr);
-bool lifo_is_not_empty(lifo_t *ptr);
-bool lifo_is_not_full(lifo_t *ptr);
+
+static inline size_t lifo_size(lifo_t *ptr) {
+    return ptr->len;
+}
+
+static inline bool lifo_is_not_empty(lifo_t *ptr) {
+    return ptr->len;
+}
+
+static inline bool lifo_is_not_full(lifo_t *ptr) {
+    return ptr->len != ptr->size;
+}
+
 void lifo_enqueue(lifo_t *ptr, void *data);
 void lifo_dequeue(lifo_t *ptr, void *data);
 void lifo_poke(lifo_t *ptr, void *data);
 void lifo_peek(lifo_t *ptr, void *data);
+// Typed variants of the above for hot loops, the element copy is inlined instead of a memcpy().
+#define lifo_enqueue_fast(ptr, type, value)    (((type *) (ptr)->data)[(ptr)->len++] = (value))
+#define lifo_dequeue_fast(ptr, type)           (((type *) (ptr)->data)[--(ptr)->len])
+#define lifo_peek_fast(ptr, type)              (((type *) (ptr)->data)[(ptr)->len - 1])
 
 // FIFO
 typedef struct fifo {
@@ -61,13 +75,40 @@ void fifo_alloc(fifo_t *ptr, size_t size, size_t data_len);
 void fifo_alloc_all(fifo_t *ptr, size_t *size, size_t data_len);
 void fifo_free(fifo_t *ptr);
 void fifo_clear(fifo_t *ptr);
-size_t fifo_size(fifo_t *ptr);
-bool fifo_is_not_empty(fifo_t *ptr);
-bool fifo_is_not_full(fifo_t *ptr);
+
+static inline size_t fifo_size(fifo_t *ptr) {
+    return ptr->len;
+}
+
+static inline bool fifo_is_not_empty(fifo_t *ptr) {
+    return ptr->len;
+}
+
+static inline bool fifo_is_not_full(fifo_t *ptr) {
+    return ptr->len != ptr->size;
+}
+
 void fifo_enqueue(fifo_t *ptr, void *data);
 void fifo_dequeue(fifo_t *ptr, void *data);
 void fifo_poke(fifo_t *ptr, void *data);
 void fifo_peek(fifo_t *ptr, void *data);
+// Typed variants of the above for hot loops, the element copy is inlined instead of a memcpy().
+#define fifo_enqueue_fast(ptr, type, value)                                    \
+    ({                                                                         \
+        __typeof__ (ptr) _ptr = (ptr);                                         \
+        ((type *) _ptr->data)[_ptr->head] = (value);                           \
+        _ptr->head = ((_ptr->head + 1) == _ptr->size) ? 0 : (_ptr->head + 1);  \
+        _ptr->len += 1;                                                        \
+    })
+#define fifo_dequeue_fast(ptr, type)                                           \
+    ({                                                                         \
+        __typeof__ (ptr) _ptr = (ptr);                                         \
+        type _value = ((type *) _ptr->data)[_ptr->tail];                       \
+        _ptr->tail = ((_ptr->tail + 1) == _ptr->size) ? 0 : (_ptr->tail + 1);  \
+        _ptr->len -= 1;                                                        \
+        _value;                                                                \
+    })
+#define fifo_peek_fast(ptr, type)              (((type *) (ptr)->data)[(ptr)->tail])
 
 // Linked List
 typedef struct list_lnk {
@@ -87,7 +128,11 @@ void list_init(list_t *ptr, size_t data_len);
 void list_copy(list_t *dst, list_t *src);
 void list_free(list_t *ptr);
 void list_clear(list_t *ptr);
-size_t list_size(list_t *ptr);
+
+static inline size_t list_size(list_t *ptr) {
+    return ptr->size;
+}
+
 void list_insert(list_t *ptr, list_lnk_t *lnk, void *data);
 void list_push_front(list_t *ptr, void *data);
 void list_push_back(list_t *ptr, void *data);
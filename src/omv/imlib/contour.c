@@ -0,0 +1,257 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Contour based rectangle finder for binary images.
+ *
+ * The outer border of each set pixel region is followed with Moore neighbor tracing, then
+ * the border is simplified to the 4 points that best bound it (the farthest pair and the
+ * farthest point on each side of it). The region is a rect if all border pixels lie within
+ * a small distance of the 4 edges and the quad is convex.
+ */
+#include "imlib.h"
+#include "fb_alloc.h"
+
+#ifdef IMLIB_ENABLE_FIND_RECTS
+#define CONTOUR_MIN_POINTS      (8)
+#define CONTOUR_EPSILON_MIN     (2.0f)
+#define CONTOUR_EPSILON_SCALE   (0.02f) // Of the perimeter.
+
+// Clockwise in image coordinates starting from east.
+static const int8_t contour_dx[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+static const int8_t contour_dy[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+// Direction of the (dx + 1) + ((dy + 1) * 3) offset.
+static const int8_t contour_dir[9] = {5, 6, 7, 4, -1, 0, 3, 2, 1};
+
+static inline bool contour_get_pixel(image_t *ptr, rectangle_t *roi, int x, int y) {
+    if ((x < 0) || (x >= roi->w) || (y < 0) || (y >= roi->h)) {
+        return false;
+    }
+    uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, roi->y + y);
+    return IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, roi->x + x);
+}
+
+// Follows the border that starts at (sx, sy), whose west neighbor is not set. Returns the number
+// of border pixels, only the first max_points are stored. Outer borders are followed clockwise,
+// so their area is positive, and hole borders anti-clockwise.
+static int contour_trace(image_t *ptr, rectangle_t *roi, image_t *visited, int sx, int sy,
+                         point_t *points, int max_points, int32_t *area) {
+    int x = sx, y = sy, bd = 4, first_d = -1, n = 0;
+    *area = 0;
+
+    for (;;) {
+        int d = -1;
+
+        for (int k = 1; k <= 8; k++) {
+            int dd = (bd + k) & 7;
+            if (contour_get_pixel(ptr, roi, x + contour_dx[dd], y + contour_dy[dd])) {
+                d = dd;
+                break;
+            }
+        }
+
+        if ((x == sx) && (y == sy)) {
+            if (d == first_d) {
+                break;
+            } else if (first_d < 0) {
+                first_d = d;
+            }
+        }
+
+        IMAGE_SET_BINARY_PIXEL_FAST(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(visited, y), x);
+
+        if (n < max_points) {
+            points[n].x = x;
+            points[n].y = y;
+        }
+
+        // An isolated pixel, or a border too long to be a rect which is only marked as visited.
+        if ((d < 0) || (++n > (max_points * 2))) {
+            break;
+        }
+
+        // The new backtrack is the last unset neighbor checked around the current pixel.
+        int nx = x + contour_dx[d];
+        int ny = y + contour_dy[d];
+        int pd = (d + 7) & 7;
+        bd = contour_dir[(x + contour_dx[pd] - nx + 1) + ((y + contour_dy[pd] - ny + 1) * 3)];
+        *area += (x * ny) - (nx * y);
+        x = nx;
+        y = ny;
+    }
+
+    return n;
+}
+
+// Returns the index of the point between i0 and i1 farthest from the line through them.
+static int contour_farthest(point_t *points, int n, int i0, int i1, float *distance) {
+    float lx = points[i1].x - points[i0].x;
+    float ly = points[i1].y - points[i0].y;
+    float max = 0.0f;
+    int index = i0;
+
+    for (int i = i0; i != i1; i = ((i + 1) == n) ? 0 : (i + 1)) {
+        float c = fast_fabsf(((points[i].x - points[i0].x) * ly) - ((points[i].y - points[i0].y) * lx));
+        if (c > max) {
+            max = c;
+            index = i;
+        }
+    }
+
+    *distance = max / fast_sqrtf((lx * lx) + (ly * ly));
+    return index;
+}
+
+static bool contour_fit_edge(point_t *points, int n, int i0, int i1, float epsilon) {
+    float distance;
+    contour_farthest(points, n, i0, i1, &distance);
+    return distance <= epsilon;
+}
+
+// Simplifies the border to a quad, the corners are returned in border (clockwise) order.
+static bool contour_fit_quad(point_t *points, int n, float epsilon, int *corners) {
+    int a = 0, b = 0, max = 0;
+
+    for (int i = 0; i < n; i++) {
+        int dx = points[i].x - points[0].x, dy = points[i].y - points[0].y;
+        if (((dx * dx) + (dy * dy)) > max) {
+            max = (dx * dx) + (dy * dy);
+            a = i;
+        }
+    }
+
+    max = 0;
+    for (int i = 0; i < n; i++) {
+        int dx = points[i].x - points[a].x, dy = points[i].y - points[a].y;
+        if (((dx * dx) + (dy * dy)) > max) {
+            max = (dx * dx) + (dy * dy);
+            b = i;
+        }
+    }
+
+    if (a == b) {
+        return false;
+    }
+
+    float c_distance, d_distance;
+    int c = contour_farthest(points, n, a, b, &c_distance);
+    int d = contour_farthest(points, n, b, a, &d_distance);
+
+    if ((c_distance <= epsilon) || (d_distance <= epsilon)) {
+        return false;
+    }
+
+    corners[0] = a;
+    corners[1] = c;
+    corners[2] = b;
+    corners[3] = d;
+
+    for (int i = 0; i < 4; i++) {
+        point_t *p0 = &points[corners[i]];
+        point_t *p1 = &points[corners[(i + 1) & 3]];
+        point_t *p2 = &points[corners[(i + 2) & 3]];
+        int cross = ((p1->x - p0->x) * (p2->y - p1->y)) - ((p1->y - p0->y) * (p2->x - p1->x));
+
+        if ((cross <= 0) || (!contour_fit_edge(points, n, corners[i], corners[(i + 1) & 3], epsilon))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void contour_add_rect(list_t *out, rectangle_t *roi, point_t *points, int *corners, uint32_t magnitude) {
+    find_rects_list_lnk_data_t lnk_data;
+    int first = 0;
+
+    // Start from the top-left corner, the rest follow clockwise.
+    for (int i = 1; i < 4; i++) {
+        if ((points[corners[i]].x + points[corners[i]].y) < (points[corners[first]].x + points[corners[first]].y)) {
+            first = i;
+        }
+    }
+
+    for (int i = 0; i < 4; i++) {
+        point_t *p = &points[corners[(first + i) & 3]];
+        lnk_data.corners[i].x = p->x + roi->x;
+        lnk_data.corners[i].y = p->y + roi->y;
+    }
+
+    rectangle_init(&lnk_data.rect, lnk_data.corners[0].x, lnk_data.corners[0].y, 0, 0);
+
+    for (int i = 1; i < 4; i++) {
+        rectangle_t temp;
+        rectangle_init(&temp, lnk_data.corners[i].x, lnk_data.corners[i].y, 0, 0);
+        rectangle_united(&lnk_data.rect, &temp);
+    }
+
+    lnk_data.magnitude = magnitude;
+    list_push_back(out, &lnk_data);
+}
+
+void imlib_find_binary_rects(list_t *out, image_t *ptr, rectangle_t *roi, uint32_t threshold) {
+    list_init(out, sizeof(find_rects_list_lnk_data_t));
+
+    image_t visited = {
+        .w = roi->w,
+        .h = roi->h,
+        .pixfmt = PIXFORMAT_BINARY,
+    };
+
+    fb_alloc_mark();
+    visited.data = fb_alloc0(image_size(&visited), FB_ALLOC_NO_HINT);
+    int max_points = (roi->w + roi->h) * 4;
+    point_t *points = fb_alloc(max_points * sizeof(point_t), FB_ALLOC_PREFER_SPEED);
+
+    int x_end = roi->x + roi->w;
+
+    for (int y = 0; y < roi->h; y++) {
+        uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, roi->y + y);
+        uint32_t *visited_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&visited, y);
+
+        // Only the set pixels with an unset west neighbor can start a border.
+        for (int i = roi->x >> UINT32_T_SHIFT, j = (x_end - 1) >> UINT32_T_SHIFT; i <= j; i++) {
+            int lo = IM_MAX(roi->x - (i * ((int) UINT32_T_BITS)), 0);
+            int hi = IM_MIN(x_end - (i * ((int) UINT32_T_BITS)), ((int) UINT32_T_BITS));
+            uint32_t pixels = row_ptr[i];
+            uint32_t carry = (i > 0) ? (row_ptr[i - 1] >> UINT32_T_MASK) : 0;
+            uint32_t starts = pixels & (~((pixels << 1) | carry));
+
+            // The roi edge is unset.
+            if (i == (roi->x >> UINT32_T_SHIFT)) {
+                starts |= pixels & (1UL << lo);
+            }
+
+            starts &= (hi == UINT32_T_BITS) ? (~0UL << lo) : (((1UL << hi) - 1) & (~0UL << lo));
+
+            for (; starts; starts &= starts - 1) {
+                int x = (i * UINT32_T_BITS) + __builtin_ctz(starts) - roi->x;
+
+                if (IMAGE_GET_BINARY_PIXEL_FAST(visited_row_ptr, x)) {
+                    continue;
+                }
+
+                int32_t area;
+                int n = contour_trace(ptr, roi, &visited, x, y, points, max_points, &area);
+
+                if ((area <= 0) || (n < CONTOUR_MIN_POINTS) || (n > max_points) || (((uint32_t) n) < threshold)) {
+                    continue;
+                }
+
+                int corners[4];
+                float epsilon = IM_MAX(n * CONTOUR_EPSILON_SCALE, CONTOUR_EPSILON_MIN);
+
+                if (contour_fit_quad(points, n, epsilon, corners)) {
+                    contour_add_rect(out, roi, points, corners, n);
+                }
+            }
+        }
+    }
+
+    fb_alloc_free_till_mark();
+}
+#endif // IMLIB_ENABLE_FIND_RECTS
@@ -0,0 +1,183 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Unscaled pixel format conversion.
+ *
+ * These are the fast paths of Image.to_grayscale(), to_rgb565(), to_bitmap(), etc, when the whole
+ * image is converted without scaling or blending. The results are the same as imlib_draw_image().
+ * Shrinking conversions run from the start of the image and expanding conversions from the end
+ * so both can be done in place.
+ */
+#include "imlib.h"
+#include "simd.h"
+#include "fb_alloc.h"
+
+// Same as COLOR_RGB565_TO_Y() for a vector of RGB565 pixels.
+static inline v128_t vrgb565_to_y(v128_t pixels) {
+    v128_t r = vand_u32(vlsr_u16(pixels, 8), vdup_u16(0xF8));
+    v128_t g = vand_u32(vlsr_u16(pixels, 3), vdup_u16(0xFC));
+    v128_t b = vand_u32(vlsl_u16(pixels, 3), vdup_u16(0xF8));
+    r = vorr_u32(r, vlsr_u16(r, 5));
+    g = vorr_u32(g, vlsr_u16(g, 6));
+    b = vorr_u32(b, vlsr_u16(b, 5));
+    return vlsr_u16(vmla_n_u16(b, 15, vmla_n_u16(g, 75, vmul_n_u16(r, 38))), 7);
+}
+
+// Same as COLOR_Y_TO_RGB565() for a vector of 16-bit grayscale pixels.
+static inline v128_t vy_to_rgb565(v128_t pixels) {
+    return vadd_u16(vmul_n_u16(vlsr_u16(pixels, 3), 0x0801), vand_u32(vlsl_u16(pixels, 3), vdup_u16(0x7E0)));
+}
+
+static void imlib_convert_rgb565_to_grayscale(uint8_t *dst, uint16_t *src, size_t n) {
+    for (size_t i = 0; i < n; i += UINT16_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_16(n - i);
+        vstr_u16_narrow_u8_pred(dst + i, vrgb565_to_y(vldr_u16_pred(src + i, pred)), pred);
+    }
+}
+
+static void imlib_convert_grayscale_to_rgb565(uint16_t *dst, uint8_t *src, size_t n, const uint16_t *color_palette) {
+    if (color_palette) {
+        for (size_t i = n; i > 0; i--) {
+            dst[i - 1] = color_palette[src[i - 1]];
+        }
+    } else {
+        for (size_t i = n; i > 0; ) {
+            size_t len = IM_MIN(i, UINT16_VECTOR_SIZE);
+            v128_predicate_t pred = vpredicate_16(len);
+            i -= len;
+            vstr_u16_pred(dst + i, vy_to_rgb565(vldr_u8_widen_u16_pred(src + i, pred)), pred);
+        }
+    }
+}
+
+// Packs a row of grayscale pixels into a binary row, pixels above the middle are set.
+static void imlib_convert_grayscale_to_binary_row(uint32_t *dst, uint8_t *src, int w) {
+    for (int x = 0; x < w; x += UINT32_T_BITS) {
+        uint32_t word = 0;
+
+        for (int i = 0, ii = IM_MIN(w - x, (int) UINT32_T_BITS); i < ii; i++) {
+            word |= ((uint32_t) COLOR_GRAYSCALE_TO_BINARY(src[x + i])) << i;
+        }
+
+        dst[x >> UINT32_T_SHIFT] = word;
+    }
+}
+
+static void imlib_convert_to_binary(image_t *dst, image_t *src) {
+    uint8_t *y_row = NULL;
+
+    if (src->pixfmt == PIXFORMAT_RGB565) {
+        y_row = fb_alloc(src->w, FB_ALLOC_PREFER_SPEED);
+    }
+
+    for (int y = 0; y < src->h; y++) {
+        uint8_t *src_row = (src->pixfmt == PIXFORMAT_RGB565) ? y_row : IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, y);
+
+        if (src->pixfmt == PIXFORMAT_RGB565) {
+            imlib_convert_rgb565_to_grayscale(y_row, IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(src, y), src->w);
+        }
+
+        imlib_convert_grayscale_to_binary_row(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(dst, y), src_row, src->w);
+    }
+
+    if (y_row) {
+        fb_free();
+    }
+}
+
+static void imlib_convert_from_binary(image_t *dst, image_t *src, const uint16_t *color_palette) {
+    uint16_t pal0 = color_palette ? color_palette[0] : COLOR_RGB565_BINARY_MIN;
+    uint16_t pal255 = color_palette ? color_palette[255] : COLOR_RGB565_BINARY_MAX;
+
+    for (int y = src->h - 1; y >= 0; y--) {
+        uint32_t *src_row = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(src, y);
+
+        if (dst->pixfmt == PIXFORMAT_GRAYSCALE) {
+            uint8_t *dst_row = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(dst, y);
+
+            for (int x = src->w - 1; x >= 0; x--) {
+                dst_row[x] = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(src_row, x));
+            }
+        } else {
+            uint16_t *dst_row = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst, y);
+
+            for (int x = src->w - 1; x >= 0; x--) {
+                dst_row[x] = IMAGE_GET_BINARY_PIXEL_FAST(src_row, x) ? pal255 : pal0;
+            }
+        }
+    }
+}
+
+bool imlib_convert(image_t *dst, image_t *src, const uint16_t *color_palette) {
+    if ((dst->w != src->w) || (dst->h != src->h) ||
+        ((src->pixfmt != PIXFORMAT_BINARY) && (src->pixfmt != PIXFORMAT_GRAYSCALE) && (src->pixfmt != PIXFORMAT_RGB565)) ||
+        ((dst->pixfmt != PIXFORMAT_BINARY) && (dst->pixfmt != PIXFORMAT_GRAYSCALE) && (dst->pixfmt != PIXFORMAT_RGB565))) {
+        return false;
+    }
+
+    // The color palette only applies to grayscale and binary images converted to RGB565.
+    if (color_palette && ((dst->pixfmt != PIXFORMAT_RGB565) || (src->pixfmt == PIXFORMAT_RGB565))) {
+        return false;
+    }
+
+    // In place, binary rows are padded to 32-bits so they may be longer than the other rows.
+    size_t dst_line_size = image_line_size(dst), src_line_size = image_line_size(src);
+    if ((dst->data == src->data) &&
+        (((dst->pixfmt == PIXFORMAT_BINARY) && (dst_line_size > src_line_size)) ||
+         ((src->pixfmt == PIXFORMAT_BINARY) && (dst_line_size < src_line_size)))) {
+        return false;
+    }
+
+    size_t n = src->w * src->h;
+
+    if (dst->pixfmt == src->pixfmt) {
+        if (dst->data != src->data) {
+            memcpy(dst->data, src->data, image_size(src));
+        }
+    } else if (src->pixfmt == PIXFORMAT_BINARY) {
+        imlib_convert_from_binary(dst, src, color_palette);
+    } else if (dst->pixfmt == PIXFORMAT_BINARY) {
+        imlib_convert_to_binary(dst, src);
+    } else if (dst->pixfmt == PIXFORMAT_GRAYSCALE) {
+        imlib_convert_rgb565_to_grayscale(dst->data, (uint16_t *) src->data, n);
+    } else {
+        imlib_convert_grayscale_to_rgb565((uint16_t *) dst->data, src->data, n, color_palette);
+    }
+
+    return true;
+}
+
+void imlib_rgb565_to_rgb888(uint8_t *dst, const uint16_t *src, size_t n, uint8_t mask) {
+    uint32_t mask32 = mask * 0x01010101;
+    size_t i = 0;
+
+    // Every 4 pixels are packed into 3 words.
+    for (; (i + 4) <= n; i += 4, dst += 12) {
+        uint32_t p[4];
+
+        for (int j = 0; j < 4; j++) {
+            int pixel = src[i + j];
+            p[j] = COLOR_RGB565_TO_R8(pixel) | (COLOR_RGB565_TO_G8(pixel) << 8) | (COLOR_RGB565_TO_B8(pixel) << 16);
+        }
+
+        uint32_t words[3] = {
+            (p[0] | (p[1] << 24)) ^ mask32,
+            ((p[1] >> 8) | (p[2] << 16)) ^ mask32,
+            ((p[2] >> 16) | (p[3] << 8)) ^ mask32,
+        };
+
+        memcpy(dst, words, sizeof(words));
+    }
+
+    for (; i < n; i++, dst += 3) {
+        int pixel = src[i];
+        dst[0] = COLOR_RGB565_TO_R8(pixel) ^ mask;
+        dst[1] = COLOR_RGB565_TO_G8(pixel) ^ mask;
+        dst[2] = COLOR_RGB565_TO_B8(pixel) ^ mask;
+    }
+}
@@ -492,6 +492,7 @@ typedef struct DmtxDecode_struct {
    /* Internals */
 /* int             cacheComplete; */
    unsigned char  *cache;
+   uint16_t       *flowCache; /* Optional, see GetPointFlow() */
    DmtxImage      *image;
    DmtxScanGrid    grid;
 } DmtxDecode;
@@ -509,7 +510,8 @@ extern DmtxMessage *dmtxDecodeMosaicRegion(DmtxDecode *dec, DmtxRegion *reg, int
 /* dmtxregion.c */
 extern DmtxRegion *dmtxRegionCreate(DmtxRegion *reg);
 extern DmtxPassFail dmtxRegionDestroy(DmtxRegion **reg);
-extern DmtxRegion *dmtxRegionFindNext(DmtxDecode *dec, int max_iterations, int *current_iterations);
+extern DmtxRegion *dmtxRegionFindNext(DmtxDecode *dec, int max_iterations, int *current_iterations,
+      imlib_deadline_t *deadline);
 extern DmtxRegion *dmtxRegionScanPixel(DmtxDecode *dec, int x, int y);
 extern DmtxPassFail dmtxRegionUpdateCorners(DmtxDecode *dec, DmtxRegion *reg, DmtxVector2 p00,
       DmtxVector2 p10, DmtxVector2 p11, DmtxVector2 p01);
@@ -599,6 +601,7 @@ extern char *dmtxVersion(void);
  */
 
 #define DmtxAlmostZero          0.000001
+#define DmtxFlowCacheValid      0x8000
 #define DmtxAlmostInfinity            -1
 
 #define DmtxValueC40Latch            230
@@ -2270,7 +2273,7 @@ dmtxRegionDestroy(DmtxRegion **reg)
  * \return Detected region (if found)
  */
 extern DmtxRegion *
-dmtxRegionFindNext(DmtxDecode *dec, int max_iterations, int *current_iterations)
+dmtxRegionFindNext(DmtxDecode *dec, int max_iterations, int *current_iterations, imlib_deadline_t *deadline)
 {
    int locStatus;
    DmtxPixelLoc loc;
@@ -2278,6 +2281,10 @@ dmtxRegionFindNext(DmtxDecode *dec, int max_iterations, int *current_iterations)
 
    /* Continue until we find a region or run out of chances */
    for(; *current_iterations < max_iterations; *current_iterations += 1) {
+      /* Most locations are rejected quickly, so only check the time every so often */
+      if(!(*current_iterations & 15) && imlib_deadline_expired(deadline))
+         break;
+
       locStatus = PopGridLocation(&(dec->grid), &loc);
       if(locStatus == DmtxRangeEnd)
          break;
@@ -2830,21 +2837,32 @@ ReadModuleColor(DmtxDecode *dec, DmtxRegion *reg, int symbolRow, int symbolCol,
    color = colorTmp = 0;
     if (dec->image->channelCount == 1) // quicker for grayscale
     {
-        int x, y;
-        for(i = 0; i < 5; i++) {
+        // The 5 samples are small steps from the module center in fitted space, so they are
+        // moved along the matrix rows instead of being transformed from scratch, leaving a
+        // single reciprocal per sample.
+        static const int8_t sampleDu[] = { 0, -1, 0, 1, 0 };
+        static const int8_t sampleDv[] = { 0, 0, -1, 0, 1 };
+        float (*m)[3] = reg->fit2raw;
+        float du = 0.1f / symbolCols;
+        float dv = 0.1f / symbolRows;
+        float u = (symbolCol + 0.5f) / symbolCols;
+        float v = (symbolRow + 0.5f) / symbolRows;
+        float xc = u*m[0][0] + v*m[1][0] + m[2][0];
+        float yc = u*m[0][1] + v*m[1][1] + m[2][1];
+        float wc = u*m[0][2] + v*m[1][2] + m[2][2];
 
-           p.X = (1.0/symbolCols) * (symbolCol + sampleX[i]);
-           p.Y = (1.0/symbolRows) * (symbolRow + sampleY[i]);
-
-//           dmtxMatrix3VMultiplyBy(&p, reg->fit2raw);
-            Matrix3VMultFast(&p, reg->fit2raw);
-            x = (int)(p.X + 0.5f);
-            y = (int)(p.Y + 0.5f);
-            if (x >= 0 && y >= 0 && x < dec->image->width && y < dec->image->height)
-                colorTmp = dec->image->pxl[(dec->image->height - 1 - y) * dec->image->rowSizeBytes + x];
- //          err = dmtxDecodeGetPixelValue(dec, (int)(p.X + 0.5), (int)(p.Y + 0.5),
- //                colorPlane, &colorTmp);
-           color += colorTmp;
+        for(i = 0; i < 5; i++) {
+            float su = sampleDu[i] * du, sv = sampleDv[i] * dv;
+            float w = wc + su*m[0][2] + sv*m[1][2];
+
+            if(fabsf(w) > DmtxAlmostZero) {
+                float wInv = 1.0f / w;
+                int x = (int)((xc + su*m[0][0] + sv*m[1][0]) * wInv + 0.5f);
+                int y = (int)((yc + su*m[0][1] + sv*m[1][1]) * wInv + 0.5f);
+                if (x >= 0 && y >= 0 && x < dec->image->width && y < dec->image->height)
+                    colorTmp = dec->image->pxl[(dec->image->height - 1 - y) * dec->image->rowSizeBytes + x];
+            }
+            color += colorTmp;
         }
     }
     else
@@ -3082,6 +3100,7 @@ GetPointFlow(DmtxDecode *dec, int colorPlane, DmtxPixelLoc loc, int arrive)
    int mag[4] = { 0 };
    int xAdjust, yAdjust;
    int color, colorPattern[8];
+   uint16_t *flowCache = NULL;
    DmtxPointFlow flow;
 
     // check boundary conditions outside of the loop
@@ -3090,11 +3109,47 @@ GetPointFlow(DmtxDecode *dec, int colorPlane, DmtxPixelLoc loc, int arrive)
     if (dec->image->channelCount == 1) // grayscale, do it quicker
     {
         uint8_t *s;
-        s = &dec->image->pxl[(dec->image->height - 1 - loc.Y) * dec->image->rowSizeBytes + loc.X];
-        for (patternIdx=0; patternIdx < 8; patternIdx++)
-        {
-            colorPattern[patternIdx] = s[dmtxPatternX[patternIdx] - dmtxPatternY[patternIdx] * dec->image->rowSizeBytes];
+        int stride = dec->image->rowSizeBytes;
+
+        flow.plane = colorPlane;
+        flow.arrive = arrive;
+        flow.loc = loc;
+
+        // The flow of a pixel only depends on its neighbors, so it is computed once and cached
+        // for the other trails and scan lines that cross the same pixel.
+        if (dec->flowCache) {
+            flowCache = &dec->flowCache[loc.Y * dec->image->width + loc.X];
+            if (*flowCache & DmtxFlowCacheValid) {
+                flow.depart = *flowCache & 0x7;
+                flow.mag = (*flowCache >> 3) & 0x3ff;
+                return flow;
+            }
+        }
+
+        s = &dec->image->pxl[(dec->image->height - 1 - loc.Y) * stride + loc.X];
+        int c0 = s[stride - 1], c1 = s[stride], c2 = s[stride + 1], c3 = s[1];
+        int c4 = s[1 - stride], c5 = s[-stride], c6 = s[-stride - 1], c7 = s[-1];
+
+        /* The compass kernels of the loop below with the zero coefficients dropped */
+        mag[0] = c1 + (c2 << 1) + c3 - c5 - (c6 << 1) - c7;
+        mag[1] = c2 + (c3 << 1) + c4 - c6 - (c7 << 1) - c0;
+        mag[2] = c3 + (c4 << 1) + c5 - c7 - (c0 << 1) - c1;
+        mag[3] = c4 + (c5 << 1) + c6 - c0 - (c1 << 1) - c2;
+
+        compassMax = 0;
+        for(compass = 1; compass < 4; compass++) {
+           if(abs(mag[compass]) > abs(mag[compassMax]))
+              compassMax = compass;
         }
+
+        flow.depart = (mag[compassMax] > 0) ? compassMax + 4 : compassMax;
+        flow.mag = abs(mag[compassMax]);
+
+        if (flowCache) {
+            *flowCache = DmtxFlowCacheValid | (flow.mag << 3) | flow.depart;
+        }
+
+        return flow;
     }
     else
     {
@@ -6332,12 +6387,66 @@ dmtxMatrix3Print(DmtxMatrix3 m)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, int effort)
+static void imlib_find_datamatrices_add(list_t *out, DmtxDecode *decode, DmtxRegion *region, DmtxMessage *message,
+                                        int x_offset, int y_offset)
 {
-    uint8_t *grayscale_image = (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->data : fb_alloc(roi->w * roi->h, FB_ALLOC_NO_HINT);
+    find_datamatrices_list_lnk_data_t lnk_data;
+
+    DmtxVector2 p[4];
+
+    p[0].X = p[0].Y = p[1].Y = p[3].X = 0.0;
+    p[1].X = p[3].Y = p[2].X = p[2].Y = 1.0;
+
+    dmtxMatrix3VMultiplyBy(&p[0], region->fit2raw);
+    dmtxMatrix3VMultiplyBy(&p[1], region->fit2raw);
+    dmtxMatrix3VMultiplyBy(&p[2], region->fit2raw);
+    dmtxMatrix3VMultiplyBy(&p[3], region->fit2raw);
+
+    int height = dmtxDecodeGetProp(decode, DmtxPropHeight);
 
-    if (ptr->pixfmt != PIXFORMAT_GRAYSCALE) {
-        image_t img;
+    rectangle_init(&(lnk_data.rect), fast_roundf(p[0].X) + x_offset, height - 1 - fast_roundf(p[0].Y) + y_offset, 0, 0);
+
+    for (size_t k = 1, l = (sizeof(p) / sizeof(p[0])); k < l; k++) {
+        rectangle_t temp;
+        rectangle_init(&temp, fast_roundf(p[k].X) + x_offset, height - 1 - fast_roundf(p[k].Y) + y_offset, 0, 0);
+        rectangle_united(&(lnk_data.rect), &temp);
+    }
+
+    // Add corners...
+    lnk_data.corners[0].x =              fast_roundf(p[3].X) + x_offset; // top-left
+    lnk_data.corners[0].y = height - 1 - fast_roundf(p[3].Y) + y_offset; // top-left
+    lnk_data.corners[1].x =              fast_roundf(p[2].X) + x_offset; // top-right
+    lnk_data.corners[1].y = height - 1 - fast_roundf(p[2].Y) + y_offset; // top-right
+    lnk_data.corners[2].x =              fast_roundf(p[1].X) + x_offset; // bottom-right
+    lnk_data.corners[2].y = height - 1 - fast_roundf(p[1].Y) + y_offset; // bottom-right
+    lnk_data.corners[3].x =              fast_roundf(p[0].X) + x_offset; // bottom-left
+    lnk_data.corners[3].y = height - 1 - fast_roundf(p[0].Y) + y_offset; // bottom-left
+
+    // Payload is NOT already null terminated.
+    lnk_data.payload_len = message->outputIdx;
+    lnk_data.payload = xalloc(message->outputIdx);
+    memcpy(lnk_data.payload, message->output, message->outputIdx);
+
+    int rotate = fast_roundf((((2 * M_PI) + fast_atan2f(p[1].Y - p[0].Y, p[1].X - p[0].X)) * 180) / M_PI);
+    if(rotate >= 360) rotate -= 360;
+
+    lnk_data.rotation = rotate;
+    lnk_data.rows = dmtxGetSymbolAttribute(DmtxSymAttribSymbolRows, region->sizeIdx);
+    lnk_data.columns = dmtxGetSymbolAttribute(DmtxSymAttribSymbolCols, region->sizeIdx);
+    lnk_data.capacity = dmtxGetSymbolAttribute(DmtxSymAttribSymbolDataWords, region->sizeIdx);
+    lnk_data.padding = message->padCount;
+
+    list_push_back(out, &lnk_data);
+}
+
+void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, list_t *rois, int effort,
+                             imlib_deadline_t *deadline)
+{
+    bool in_place = ptr->pixfmt == PIXFORMAT_GRAYSCALE;
+    uint8_t *grayscale_image = in_place ? ptr->data : fb_alloc(roi->w * roi->h, FB_ALLOC_NO_HINT);
+
+    if (!in_place) {
+        image_t img = {};
         img.w = roi->w;
         img.h = roi->h;
         img.pixfmt = PIXFORMAT_GRAYSCALE;
@@ -6345,89 +6454,82 @@ void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, int ef
         imlib_draw_image(&img, ptr, 0, 0, 1.f, 1.f, roi, -1, 256, NULL, NULL, 0, NULL, NULL, NULL);
     }
 
-    umm_init_x(fb_avail());
+    int width = in_place ? ptr->w : roi->w;
+    int height = in_place ? ptr->h : roi->h;
+    // Moves results from the decoder image back into the source image.
+    int x_offset = in_place ? 0 : roi->x;
+    int y_offset = in_place ? 0 : roi->y;
+
+    // The edge flow cache takes 2 bytes per pixel, it's only used when the decoder keeps most
+    // of the memory, otherwise the edge flow is recomputed each time a pixel is visited.
+    uint16_t *flow_cache = NULL;
+    size_t flow_cache_size = width * height * sizeof(uint16_t);
+    if ((flow_cache_size * 4) <= fb_avail()) {
+        flow_cache = fb_alloc0(flow_cache_size, FB_ALLOC_NO_HINT);
+    }
 
-    DmtxImage *image = dmtxImageCreate(grayscale_image,
-                                       (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->w : roi->w,
-                                       (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->h : roi->h,
-                                       DmtxPack8bppK);
+    umm_init_x(fb_avail());
 
+    DmtxImage *image = dmtxImageCreate(grayscale_image, width, height, DmtxPack8bppK);
     DmtxDecode *decode = dmtxDecodeCreate(image, 1);
-    dmtxDecodeSetProp(decode, DmtxPropXmin, (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? roi->x : 0);
-    dmtxDecodeSetProp(decode, DmtxPropYmin, (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? roi->y : 0);
-    dmtxDecodeSetProp(decode, DmtxPropXmax, ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? roi->x : 0) + (roi->w - 1));
-    dmtxDecodeSetProp(decode, DmtxPropYmax, ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? roi->y : 0) + (roi->h - 1));
+    decode->flowCache = flow_cache;
 
     list_init(out, sizeof(find_datamatrices_list_lnk_data_t));
 
-    int max_iterations = effort;
-    int current_iterations = 0;
-    for (DmtxRegion *region = dmtxRegionFindNext(decode, max_iterations, &current_iterations); region; region = dmtxRegionFindNext(decode, max_iterations, &current_iterations)) {
-        DmtxMessage *message = dmtxDecodeMatrixRegion(decode, region, DmtxUndefined);
+    // Each candidate roi is scanned with its own effort. The decoder cache is shared, so a symbol
+    // found in overlapping candidates is only decoded once.
+    list_lnk_t *it = rois ? rois->head : NULL;
+
+    do {
+        rectangle_t r = *roi;
 
-        if (message) {
-            find_datamatrices_list_lnk_data_t lnk_data;
+        if (it) {
+            rectangle_t *candidate = list_get_data(it);
+            it = it->next;
 
-            DmtxVector2 p[4];
+            if (!rectangle_overlap(&r, candidate)) {
+                continue;
+            }
 
-            p[0].X = p[0].Y = p[1].Y = p[3].X = 0.0;
-            p[1].X = p[3].Y = p[2].X = p[2].Y = 1.0;
+            rectangle_intersected(&r, candidate);
+        }
 
-            dmtxMatrix3VMultiplyBy(&p[0], region->fit2raw);
-            dmtxMatrix3VMultiplyBy(&p[1], region->fit2raw);
-            dmtxMatrix3VMultiplyBy(&p[2], region->fit2raw);
-            dmtxMatrix3VMultiplyBy(&p[3], region->fit2raw);
+        r.x -= x_offset;
+        r.y -= y_offset;
 
-            int height = dmtxDecodeGetProp(decode, DmtxPropHeight);
+        // The decoder image is bottom-up.
+        dmtxDecodeSetProp(decode, DmtxPropXmin, r.x);
+        dmtxDecodeSetProp(decode, DmtxPropXmax, r.x + r.w - 1);
+        dmtxDecodeSetProp(decode, DmtxPropYmin, height - (r.y + r.h));
+        dmtxDecodeSetProp(decode, DmtxPropYmax, height - 1 - r.y);
 
-            rectangle_init(&(lnk_data.rect),
-                           fast_roundf(p[0].X) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->x),
-                           height - 1 - fast_roundf(p[0].Y) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->y), 0, 0);
+        int max_iterations = effort;
+        int current_iterations = 0;
+        for (DmtxRegion *region = dmtxRegionFindNext(decode, max_iterations, &current_iterations, deadline); region; region = dmtxRegionFindNext(decode, max_iterations, &current_iterations, deadline)) {
+            DmtxMessage *message = dmtxDecodeMatrixRegion(decode, region, DmtxUndefined);
 
-            for (size_t k = 1, l = (sizeof(p) / sizeof(p[0])); k < l; k++) {
-                rectangle_t temp;
-                rectangle_init(&temp, fast_roundf(p[k].X) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->x),
-                        height - 1 - fast_roundf(p[k].Y) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->y), 0, 0);
-                rectangle_united(&(lnk_data.rect), &temp);
+            if (message) {
+                imlib_find_datamatrices_add(out, decode, region, message, x_offset, y_offset);
+                dmtxMessageDestroy(&message);
             }
 
-            // Add corners...
-            lnk_data.corners[0].x =              fast_roundf(p[3].X) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->x); // top-left
-            lnk_data.corners[0].y = height - 1 - fast_roundf(p[3].Y) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->y); // top-left
-            lnk_data.corners[1].x =              fast_roundf(p[2].X) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->x); // top-right
-            lnk_data.corners[1].y = height - 1 - fast_roundf(p[2].Y) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->y); // top-right
-            lnk_data.corners[2].x =              fast_roundf(p[1].X) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->x); // bottom-right
-            lnk_data.corners[2].y = height - 1 - fast_roundf(p[1].Y) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->y); // bottom-right
-            lnk_data.corners[3].x =              fast_roundf(p[0].X) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->x); // bottom-left
-            lnk_data.corners[3].y = height - 1 - fast_roundf(p[0].Y) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->y); // bottom-left
-
-            // Payload is NOT already null terminated.
-            lnk_data.payload_len = message->outputIdx;
-            lnk_data.payload = xalloc(message->outputIdx);
-            memcpy(lnk_data.payload, message->output, message->outputIdx);
-
-            int rotate = fast_roundf((((2 * M_PI) + fast_atan2f(p[1].Y - p[0].Y, p[1].X - p[0].X)) * 180) / M_PI);
-            if(rotate >= 360) rotate -= 360;
-
-            lnk_data.rotation = rotate;
-            lnk_data.rows = dmtxGetSymbolAttribute(DmtxSymAttribSymbolRows, region->sizeIdx);
-            lnk_data.columns = dmtxGetSymbolAttribute(DmtxSymAttribSymbolCols, region->sizeIdx);
-            lnk_data.capacity = dmtxGetSymbolAttribute(DmtxSymAttribSymbolDataWords, region->sizeIdx);
-            lnk_data.padding = message->padCount;
-
-            list_push_back(out, &lnk_data);
-
-            dmtxMessageDestroy(&message);
+            dmtxRegionDestroy(&region);
         }
 
-        dmtxRegionDestroy(&region);
-    }
+        if (imlib_deadline_expired(deadline)) {
+            break;
+        }
+    } while (it);
 
     dmtxDecodeDestroy(&decode);
     dmtxImageDestroy(&image);
 
+    umm_deinit();
     fb_free(); // umm_init_x();
-    if (ptr->pixfmt != PIXFORMAT_GRAYSCALE) {
+    if (flow_cache) {
+        fb_free(); // flow_cache
+    }
+    if (!in_place) {
         fb_free(); // grayscale_image;
     }
 }
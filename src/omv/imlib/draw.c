@@ -72,14 +72,129 @@ void imlib_set_pixel(image_t *img, int x, int y, int p) {
     }
 }
 
+// Fills [x0, x1) on row y, clipped to the image.
+static void imlib_draw_span(image_t *img, int x0, int x1, int y, int c) {
+    if ((y < 0) || (y >= img->h)) {
+        return;
+    }
+
+    x0 = IM_MAX(x0, 0);
+    x1 = IM_MIN(x1, img->w);
+
+    if (x0 >= x1) {
+        return;
+    }
+
+    switch (img->pixfmt) {
+        case PIXFORMAT_BINARY: {
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+            uint32_t fill = (c & 1) ? UINT32_MAX : 0;
+
+            // Partial words at the ends, whole words in between.
+            for (; (x0 < x1) && (x0 & UINT32_T_MASK); x0++) {
+                IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x0, c);
+            }
+
+            for (; (x1 - x0) >= UINT32_T_BITS; x0 += UINT32_T_BITS) {
+                row_ptr[x0 >> UINT32_T_SHIFT] = fill;
+            }
+
+            for (; x0 < x1; x0++) {
+                IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x0, c);
+            }
+            break;
+        }
+        case PIXFORMAT_GRAYSCALE: {
+            memset(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y) + x0, c, x1 - x0);
+            break;
+        }
+        case PIXFORMAT_RGB565: {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y) + x0;
+            size_t n = x1 - x0;
+
+            // Two pixels per store once the pointer is word aligned.
+            if (((uintptr_t) row_ptr) & 2) {
+                *row_ptr++ = c;
+                n -= 1;
+            }
+
+            uint32_t *ptr32 = (uint32_t *) row_ptr;
+            uint32_t fill = (c & 0xFFFF) * 0x00010001;
+
+            for (; n >= 2; n -= 2) {
+                *ptr32++ = fill;
+            }
+
+            if (n) {
+                *((uint16_t *) ptr32) = c;
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+// Fills [y0, y1) on column x, clipped to the image.
+static void imlib_draw_vspan(image_t *img, int x, int y0, int y1, int c) {
+    if ((x < 0) || (x >= img->w)) {
+        return;
+    }
+
+    y0 = IM_MAX(y0, 0);
+    y1 = IM_MIN(y1, img->h);
+
+    switch (img->pixfmt) {
+        case PIXFORMAT_BINARY: {
+            for (int y = y0; y < y1; y++) {
+                IMAGE_PUT_BINARY_PIXEL_FAST(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y), x, c);
+            }
+            break;
+        }
+        case PIXFORMAT_GRAYSCALE: {
+            for (int y = y0; y < y1; y++) {
+                IMAGE_PUT_GRAYSCALE_PIXEL_FAST(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y), x, c);
+            }
+            break;
+        }
+        case PIXFORMAT_RGB565: {
+            for (int y = y0; y < y1; y++) {
+                IMAGE_PUT_RGB565_PIXEL_FAST(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y), x, c);
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
+
+// Fills a rectangle, clipped to the image.
+static void imlib_fill_rect(image_t *img, int x, int y, int w, int h, int c) {
+    for (int i = IM_MAX(y, 0), ii = IM_MIN(y + h, img->h); i < ii; i++) {
+        imlib_draw_span(img, x, x + w, i, c);
+    }
+}
+
 // https://stackoverflow.com/questions/1201200/fast-algorithm-for-drawing-filled-circles
 static void point_fill(image_t *img, int cx, int cy, int r0, int r1, int c) {
     for (int y = r0; y <= r1; y++) {
-        for (int x = r0; x <= r1; x++) {
-            if (((x * x) + (y * y)) <= (r0 * r0)) {
-                imlib_set_pixel(img, cx + x, cy + y, c);
-            }
+        // Each row of the disk is one span, |x| <= sqrt(r0^2 - y^2).
+        int d = (r0 * r0) - (y * y);
+        if (d < 0) {
+            continue;
+        }
+
+        int k = fast_sqrtf(d);
+        while ((k * k) > d) {
+            k--;
         }
+        while (((k + 1) * (k + 1)) <= d) {
+            k++;
+        }
+
+        imlib_draw_span(img, cx + IM_MAX(r0, -k), cx + IM_MIN(r1, k) + 1, cy + y, c);
     }
 }
 
@@ -170,6 +285,13 @@ static void imlib_draw_thin_line(image_t *img, int x0, int y0, int x1, int y1, i
 
 // https://gist.github.com/randvoorhies/807ce6e20840ab5314eb7c547899de68#file-bresenham-js-L813
 void imlib_draw_line(image_t *img, int x0, int y0, int x1, int y1, int c, int th) {
+    #if (OMV_GPU_ENABLE == 1)
+    imlib_gpu_init();
+    if (!omv_gpu_draw_line(img, x0, y0, x1, y1, c, th)) {
+        return;
+    }
+    #endif
+
     line_t line = {x0, y0, x1, y1};
     if (!lb_clip_line(&line, 0, 0, img->w, img->h)) {
         return;
@@ -241,39 +363,64 @@ void imlib_draw_line(image_t *img, int x0, int y0, int x1, int y1, int c, int th
 }
 
 static void xLine(image_t *img, int x1, int x2, int y, int c) {
-    while (x1 <= x2) {
-        imlib_set_pixel(img, x1++, y, c);
-    }
+    imlib_draw_span(img, x1, x2 + 1, y, c);
 }
 
 static void yLine(image_t *img, int x, int y1, int y2, int c) {
-    while (y1 <= y2) {
-        imlib_set_pixel(img, x, y1++, c);
+    imlib_draw_vspan(img, x, y1, y2 + 1, c);
+}
+
+#if (OMV_GPU_ENABLE == 1)
+// Clips the rectangle to the image and fills it with the GPU, returns false if it must be done in software.
+static bool imlib_gpu_fill_rect(image_t *img, int x, int y, int w, int h, int c) {
+    rectangle_t rect = {x, y, w, h};
+    rectangle_t bounds = {0, 0, img->w, img->h};
+
+    if (!rectangle_overlap(&rect, &bounds)) {
+        return true;
     }
+
+    rectangle_intersected(&rect, &bounds);
+    imlib_gpu_init();
+    return !omv_gpu_fill_rect(img, &rect, c);
 }
+#endif
 
 void imlib_draw_rectangle(image_t *img, int rx, int ry, int rw, int rh, int c, int thickness, bool fill) {
+    #if (OMV_GPU_ENABLE == 1)
     if (fill) {
-
-        for (int y = ry, yy = ry + rh; y < yy; y++) {
-            for (int x = rx, xx = rx + rw; x < xx; x++) {
-                imlib_set_pixel(img, x, y, c);
-            }
+        if (imlib_gpu_fill_rect(img, rx, ry, rw, rh, c)) {
+            return;
+        }
+    } else if (thickness > 0) {
+        int t0 = (thickness - 0) / 2;
+        int t1 = (thickness - 1) / 2;
+        int tw = rw + t0 + t1;
+        int th = rh + t0 + t1;
+        // Top, bottom, left and right edges, the same pixels as the software path.
+        if (imlib_gpu_fill_rect(img, rx - t0, ry - t0, tw, t0 + t1 + 1, c) &&
+            imlib_gpu_fill_rect(img, rx - t0, ry + rh - 1 - t0, tw, t0 + t1 + 1, c) &&
+            imlib_gpu_fill_rect(img, rx - t0, ry - t0, t0 + t1 + 1, th, c) &&
+            imlib_gpu_fill_rect(img, rx + rw - 1 - t0, ry - t0, t0 + t1 + 1, th, c)) {
+            return;
         }
+    }
+    #endif
 
+    if (fill) {
+        imlib_fill_rect(img, rx, ry, rw, rh, c);
     } else if (thickness > 0) {
         int thickness0 = (thickness - 0) / 2;
         int thickness1 = (thickness - 1) / 2;
-
-        for (int i = rx - thickness0, j = rx + rw + thickness1, k = ry + rh - 1; i < j; i++) {
-            yLine(img, i, ry - thickness0, ry + thickness1, c);
-            yLine(img, i, k - thickness0, k + thickness1, c);
-        }
-
-        for (int i = ry - thickness0, j = ry + rh + thickness1, k = rx + rw - 1; i < j; i++) {
-            xLine(img, rx - thickness0, rx + thickness1, i, c);
-            xLine(img, k - thickness0, k + thickness1, i, c);
-        }
+        int tw = rw + thickness0 + thickness1;
+        int th = rh + thickness0 + thickness1;
+        int t = thickness0 + thickness1 + 1;
+
+        // Top, bottom, left and right edges.
+        imlib_fill_rect(img, rx - thickness0, ry - thickness0, tw, t, c);
+        imlib_fill_rect(img, rx - thickness0, ry + rh - 1 - thickness0, tw, t, c);
+        imlib_fill_rect(img, rx - thickness0, ry - thickness0, t, th, c);
+        imlib_fill_rect(img, rx + rw - 1 - thickness0, ry - thickness0, t, th, c);
     }
 }
 
@@ -582,6 +729,28 @@ void imlib_draw_string(image_t *img,
     int org_y_off = y_off;
     const int anchor = x_off;
 
+    // Unrotated glyphs are drawn a span at a time. Each bit of a glyph row covers the scaled
+    // columns [col_edge[bit], col_edge[bit + 1]), which are the same for all glyphs.
+    bool spans = (char_rotation == 0) && (string_rotation == 0);
+    int col_edge[sizeof(font[0].data[0]) * 8 + 1];
+
+    if (spans) {
+        int w = font[0].w, xx = fast_floorf(w * scale);
+
+        for (int i = 0; i <= w; i++) {
+            col_edge[i] = xx;
+        }
+
+        for (int x = xx - 1; x >= 0; x--) {
+            col_edge[IM_MIN(fast_floorf(x / scale), w - 1)] = x;
+        }
+
+        // Bits not covered by any column (scale < 1) have empty spans.
+        for (int i = w - 1; i >= 0; i--) {
+            col_edge[i] = IM_MIN(col_edge[i], col_edge[i + 1]);
+        }
+    }
+
     for (char ch, last = '\0'; (ch = *str); str++, last = ch) {
 
         if ((last == '\r') && (ch == '\n')) {
@@ -640,13 +809,40 @@ void imlib_draw_string(image_t *img,
             }
         }
 
-        for (int y = 0, yy = fast_floorf(g->h * scale); y < yy; y++) {
-            for (int x = 0, xx = fast_floorf(g->w * scale); x < xx; x++) {
-                if (g->data[fast_floorf(y / scale)] & (1 << (g->w - 1 - fast_floorf(x / scale)))) {
-                    int16_t x_tmp = x_off + (char_hmirror ? (xx - x - 1) : x), y_tmp = y_off + (char_vflip ? (yy - y - 1) : y);
-                    point_rotate(x_tmp, y_tmp, IM_DEG2RAD(char_rotation), x_off + (xx / 2), y_off + (yy / 2), &x_tmp, &y_tmp);
-                    point_rotate(x_tmp, y_tmp, IM_DEG2RAD(string_rotation), org_x_off, org_y_off, &x_tmp, &y_tmp);
-                    imlib_set_pixel(img, x_tmp, y_tmp, c);
+        if (spans) {
+            for (int y = 0, yy = fast_floorf(g->h * scale), xx = fast_floorf(g->w * scale); y < yy; y++) {
+                int row = g->data[fast_floorf(y / scale)];
+                int y_tmp = y_off + (char_vflip ? (yy - y - 1) : y);
+
+                // Draw each run of set bits as one span.
+                for (int i = 0; i < g->w;) {
+                    if (!(row & (1 << (g->w - 1 - i)))) {
+                        i++;
+                        continue;
+                    }
+
+                    int x0 = col_edge[i];
+                    while ((i < g->w) && (row & (1 << (g->w - 1 - i)))) {
+                        i++;
+                    }
+                    int x1 = col_edge[i];
+
+                    if (char_hmirror) {
+                        imlib_draw_span(img, x_off + xx - x1, x_off + xx - x0, y_tmp, c);
+                    } else {
+                        imlib_draw_span(img, x_off + x0, x_off + x1, y_tmp, c);
+                    }
+                }
+            }
+        } else {
+            for (int y = 0, yy = fast_floorf(g->h * scale); y < yy; y++) {
+                for (int x = 0, xx = fast_floorf(g->w * scale); x < xx; x++) {
+                    if (g->data[fast_floorf(y / scale)] & (1 << (g->w - 1 - fast_floorf(x / scale)))) {
+                        int16_t x_tmp = x_off + (char_hmirror ? (xx - x - 1) : x), y_tmp = y_off + (char_vflip ? (yy - y - 1) : y);
+                        point_rotate(x_tmp, y_tmp, IM_DEG2RAD(char_rotation), x_off + (xx / 2), y_off + (yy / 2), &x_tmp, &y_tmp);
+                        point_rotate(x_tmp, y_tmp, IM_DEG2RAD(string_rotation), org_x_off, org_y_off, &x_tmp, &y_tmp);
+                        imlib_set_pixel(img, x_tmp, y_tmp, c);
+                    }
                 }
             }
         }
@@ -697,7 +893,7 @@ void imlib_draw_string(image_t *img,
 }
 
 void imlib_draw_row_setup(imlib_draw_row_data_t *data) {
-    image_t temp;
+    image_t temp = {};
     temp.w = data->dst_img->w;
     temp.h = data->dst_img->h;
     temp.pixfmt = data->src_img_pixfmt;
@@ -2843,7 +3039,74 @@ void imlib_draw_image(image_t *dst_img,
                       imlib_draw_row_callback_t callback,
                       void *callback_arg,
                       void *dst_row_override) {
-    OMV_PROFILE_START();
+    // 16-bit images are drawn through an 8-bit copy of the ROI stretched to its range.
+    if (src_img->pixfmt == PIXFORMAT_GRAYSCALE16) {
+        rectangle_t src_roi = { 0, 0, src_img->w, src_img->h };
+        if (roi) {
+            src_roi = *roi;
+        }
+
+        image_t gray_img = {
+            .w = src_roi.w,
+            .h = src_roi.h,
+            .pixfmt = PIXFORMAT_GRAYSCALE,
+        };
+
+        int min, max;
+        imlib_gray16_get_min_max(src_img, &src_roi, &min, &max);
+        gray_img.data = fb_alloc(image_size(&gray_img), FB_ALLOC_NO_HINT);
+        imlib_gray16_to_grayscale(&gray_img, src_img, &src_roi, min, max);
+        imlib_draw_image(dst_img, &gray_img, dst_x_start, dst_y_start, x_scale, y_scale, NULL,
+                         rgb_channel, alpha, color_palette, alpha_palette, hint,
+                         callback, callback_arg, dst_row_override);
+        fb_free(); // gray_img.data
+        return;
+    }
+
+    // If a bayer image is shrunk by 2x or more it's debayered straight to half resolution, which
+    // doesn't interpolate the pixels that would be thrown away, and that's drawn at twice the scale.
+    if (src_img->is_bayer && (!dst_img->is_bayer)) {
+        int new_pixfmt = (rgb_channel != -1) ? PIXFORMAT_RGB565 :
+                         (color_palette ? PIXFORMAT_GRAYSCALE : dst_img->pixfmt);
+        int src_img_w = roi ? roi->w : src_img->w;
+        int src_img_h = roi ? roi->h : src_img->h;
+        int src_width_scaled, src_height_scaled;
+        int half_x_start = dst_x_start, half_y_start = dst_y_start;
+        float half_x_scale = x_scale, half_y_scale = y_scale;
+        image_hint_t half_hint = hint;
+        imlib_draw_image_scale_and_center_helper(dst_img, src_img_w, src_img_h, &src_width_scaled, &src_height_scaled,
+                                                 &half_x_start, &half_y_start, &half_x_scale, &half_y_scale,
+                                                 &half_hint);
+
+        if ((fast_fabsf(half_x_scale) <= 0.5f) && (fast_fabsf(half_y_scale) <= 0.5f)
+            && (src_img_w >= 2) && (src_img_h >= 2)
+            && ((new_pixfmt == PIXFORMAT_GRAYSCALE) || (new_pixfmt == PIXFORMAT_RGB565))
+            && ((!roi) || (!((roi->x | roi->y) & 1)))) { // Keep the bayer pattern phase.
+            image_t roi_img = *src_img;
+            if (roi) {
+                roi_img.w = roi->w;
+                roi_img.h = roi->h;
+                roi_img.stride = IMAGE_GRAYSCALE_ROW_STRIDE(src_img);
+                roi_img.data = src_img->data + (roi->y * roi_img.stride) + roi->x;
+            }
+
+            image_t half_img = {
+                .w = src_img_w / 2,
+                .h = src_img_h / 2,
+                .pixfmt = new_pixfmt,
+            };
+
+            half_img.data = fb_alloc(image_size(&half_img), FB_ALLOC_CACHE_ALIGN);
+            imlib_debayer_image_half(&half_img, &roi_img);
+            imlib_draw_image(dst_img, &half_img, half_x_start, half_y_start, half_x_scale * 2.f, half_y_scale * 2.f,
+                             NULL, rgb_channel, alpha, color_palette, alpha_palette, half_hint,
+                             callback, callback_arg, dst_row_override);
+            fb_free(); // half_img.data
+            return;
+        }
+    }
+
+    OMV_PROFILE_START(draw_image);
     int dst_delta_x = 1; // positive direction
     if (x_scale < 0.f) {
         // flip X
@@ -3010,7 +3273,7 @@ void imlib_draw_image(image_t *dst_img,
     }
 
     // rgb_channel extracted / color_palette applied image
-    image_t new_src_img;
+    image_t new_src_img = {};
 
     if (((hint & IMAGE_HINT_EXTRACT_RGB_CHANNEL_FIRST) && (rgb_channel != -1) && src_img->is_color)
         || ((hint & IMAGE_HINT_APPLY_COLOR_PALETTE_FIRST) && color_palette)) {
@@ -3057,6 +3320,76 @@ void imlib_draw_image(image_t *dst_img,
     // Force a deep copy if we are scaling.
     bool is_color_conversion_scaling = is_color_conversion && is_scaling;
 
+    // Nearest neighbor scaling only samples some of the source rows, so instead of converting the
+    // whole bayer/yuv image first each sampled row is converted once into a line buffer and drawn
+    // from there. Only the source columns that are sampled are converted.
+    if (is_color_conversion_scaling
+        && (!(hint & (IMAGE_HINT_AREA | IMAGE_HINT_BICUBIC | IMAGE_HINT_BILINEAR | IMAGE_HINT_TRANSPOSE)))
+        && (dst_img->data != src_img->data)
+        && ((new_not_mutable_pixfmt == PIXFORMAT_GRAYSCALE) || (new_not_mutable_pixfmt == PIXFORMAT_RGB565))) {
+        int dst_w = dst_x_end - dst_x_start;
+        int line_x_start = (src_x_accum_reset >> 16) & ~1;
+        int line_x_end = IM_MIN(((src_x_accum_reset + (src_x_frac * (dst_w - 1))) >> 16) + 2, src_img->w);
+
+        image_t line = {.w = src_img->w, .h = 1, .pixfmt = new_not_mutable_pixfmt};
+        void *line_buffer = fb_alloc(image_line_size(&line), FB_ALLOC_PREFER_SPEED | FB_ALLOC_CACHE_ALIGN);
+
+        imlib_draw_row_data_t imlib_draw_row_data;
+        imlib_draw_row_data.dst_img = dst_img;
+        imlib_draw_row_data.src_img_pixfmt = new_not_mutable_pixfmt;
+        imlib_draw_row_data.rgb_channel = rgb_channel;
+        imlib_draw_row_data.alpha = alpha;
+        imlib_draw_row_data.color_palette = color_palette;
+        imlib_draw_row_data.alpha_palette = alpha_palette;
+        imlib_draw_row_data.black_background = hint & IMAGE_HINT_BLACK_BACKGROUND;
+        imlib_draw_row_data.callback = callback;
+        imlib_draw_row_data.callback_arg = callback_arg;
+        imlib_draw_row_data.dst_row_override = dst_row_override;
+        imlib_draw_row_setup(&imlib_draw_row_data);
+
+        int dst_y = dst_y_reset;
+        long src_y_accum = src_y_accum_reset;
+
+        for (int y = dst_y_start, src_y_index = -1; y < dst_y_end; y++) {
+            if ((src_y_accum >> 16) != src_y_index) {
+                src_y_index = src_y_accum >> 16;
+
+                if (src_img->is_bayer) {
+                    imlib_debayer_line(line_x_start, line_x_end, src_y_index, line_buffer, line.pixfmt, src_img);
+                } else {
+                    imlib_deyuv_line(line_x_start, line_x_end, src_y_index, line_buffer, line.pixfmt, src_img);
+                }
+            }
+
+            long src_x_accum = src_x_accum_reset;
+
+            if (line.pixfmt == PIXFORMAT_GRAYSCALE) {
+                uint8_t *src_row_ptr = (uint8_t *) line_buffer;
+                uint8_t *dst_row_ptr = (uint8_t *) imlib_draw_row_data.row_buffer;
+                for (int x = 0, dst_x = dst_x_reset; x < dst_w; x++, dst_x += dst_delta_x) {
+                    dst_row_ptr[dst_x] = src_row_ptr[src_x_accum >> 16];
+                    src_x_accum += src_x_frac;
+                }
+            } else {
+                uint16_t *src_row_ptr = (uint16_t *) line_buffer;
+                uint16_t *dst_row_ptr = (uint16_t *) imlib_draw_row_data.row_buffer;
+                for (int x = 0, dst_x = dst_x_reset; x < dst_w; x++, dst_x += dst_delta_x) {
+                    dst_row_ptr[dst_x] = src_row_ptr[src_x_accum >> 16];
+                    src_x_accum += src_x_frac;
+                }
+            }
+
+            imlib_draw_row(dst_x_start, dst_x_end, dst_y, &imlib_draw_row_data);
+
+            dst_y += dst_delta_y;
+            src_y_accum += src_y_frac;
+        }
+
+        imlib_draw_row_teardown(&imlib_draw_row_data);
+        fb_free(); // line_buffer
+        goto exit_cleanup;
+    }
+
     // Make a deep copy of the source image.
     if (need_deep_copy || is_color_conversion_scaling || is_jpeg || is_png) {
         new_src_img.w = src_img->w; // same width as source image
@@ -3084,7 +3417,7 @@ void imlib_draw_image(image_t *dst_img,
                 }
                 case PIXFORMAT_BAYER_ANY:
                 case PIXFORMAT_YUV_ANY: {
-                    memcpy(new_src_img.data, src_img->data, size);
+                    image_copy_rows(&new_src_img, src_img);
                     break;
                 }
                 default: {
@@ -3098,7 +3431,7 @@ void imlib_draw_image(image_t *dst_img,
             new_src_img.pixfmt = src_img->pixfmt;
             size_t size = image_size(&new_src_img);
             new_src_img.data = fb_alloc(size, FB_ALLOC_CACHE_ALIGN);
-            memcpy(new_src_img.data, src_img->data, size);
+            image_copy_rows(&new_src_img, src_img);
         }
 
         src_img = &new_src_img;
@@ -3110,7 +3443,7 @@ void imlib_draw_image(image_t *dst_img,
     // first if that is requested.
     if (hint & IMAGE_HINT_TRANSPOSE) {
         rectangle_t t_roi = {};
-        image_t t_src_img;
+        image_t t_src_img = {};
         t_src_img.pixfmt = src_img->pixfmt;
 
         // Are we scaling?
@@ -3127,6 +3460,7 @@ void imlib_draw_image(image_t *dst_img,
             t_src_img.w = src_img->w;
             t_src_img.h = src_img->h;
             t_src_img.data = src_img->data;
+            t_src_img.stride = src_img->stride;
         }
 
         uint32_t size;
@@ -3141,8 +3475,8 @@ void imlib_draw_image(image_t *dst_img,
             line_num = IM_MIN(line_num, (t_roi.h - i));
 
             // Make an image that is a slice of the input image.
-            image_t in = {.w = t_src_img.w, .h = line_num, .pixfmt = t_src_img.pixfmt};
-            in.data = t_src_img.data + (image_line_size(&t_src_img) *
+            image_t in = {.w = t_src_img.w, .h = line_num, .pixfmt = t_src_img.pixfmt, .stride = t_src_img.stride};
+            in.data = t_src_img.data + (image_row_stride(&t_src_img) *
                                         ((dst_delta_y < 0) ? (t_roi.h - i - 1) : i));
 
             // Make an image that will hold the transposed output.
@@ -3150,6 +3484,7 @@ void imlib_draw_image(image_t *dst_img,
             out.w = line_num;
             out.h = t_roi.w;
             out.data = data;
+            out.stride = 0;
 
             switch (t_src_img.pixfmt) {
                 case PIXFORMAT_BINARY: {
@@ -3227,6 +3562,8 @@ void imlib_draw_image(image_t *dst_img,
     #if (OMV_GPU_ENABLE == 1)
     // Try to offload this to the GPU for processing.
     if ((rgb_channel < 0) && (!(hint & (IMAGE_HINT_AREA | IMAGE_HINT_BICUBIC))) && (!callback)) {
+        imlib_gpu_init();
+
         rectangle_t dst_rect;
         dst_rect.x = dst_x_start;
         dst_rect.y = dst_y_start;
@@ -3243,6 +3580,25 @@ void imlib_draw_image(image_t *dst_img,
         gpu_hint |= (dst_delta_x < 0) ? IMAGE_HINT_HMIRROR : 0;
         gpu_hint |= (dst_delta_y < 0) ? IMAGE_HINT_VFLIP : 0;
 
+        // Unscaled, unblended copies between images of the same format are plain 2D memory moves.
+        if ((src_img->pixfmt == dst_img->pixfmt) && (src_img->data != dst_img->data)
+            && ((src_img->pixfmt == PIXFORMAT_GRAYSCALE) || (src_img->pixfmt == PIXFORMAT_RGB565))
+            && (src_rect.w == dst_rect.w) && (src_rect.h == dst_rect.h)
+            && (!(gpu_hint & (IMAGE_HINT_HMIRROR | IMAGE_HINT_VFLIP)))
+            && (alpha == 256) && (!color_palette) && (!alpha_palette) && (!dst_row_override)
+            && ((dst_rect.w * dst_rect.h) >= OMV_GPU_COPY_MIN_PIXELS)) {
+            bool grayscale = (src_img->pixfmt == PIXFORMAT_GRAYSCALE);
+            size_t bpp = grayscale ? sizeof(uint8_t) : sizeof(uint16_t);
+            size_t src_stride = grayscale ? IMAGE_GRAYSCALE_ROW_STRIDE(src_img) : IMAGE_RGB565_ROW_STRIDE(src_img);
+            size_t dst_stride = grayscale ? IMAGE_GRAYSCALE_ROW_STRIDE(dst_img) : IMAGE_RGB565_ROW_STRIDE(dst_img);
+            uint8_t *src8 = src_img->data + (src_rect.y * src_stride) + (src_rect.x * bpp);
+            uint8_t *dst8 = dst_img->data + (dst_rect.y * dst_stride) + (dst_rect.x * bpp);
+
+            if (!omv_gpu_copy(dst8, dst_stride, src8, src_stride, dst_rect.w, dst_rect.h, bpp)) {
+                goto exit_cleanup;
+            }
+        }
+
         if (!omv_gpu_draw_image(src_img, &src_rect, dst_img, &dst_rect, alpha, color_palette, alpha_palette, gpu_hint)) {
             goto exit_cleanup;
         }
@@ -5418,6 +5774,68 @@ void imlib_draw_image(image_t *dst_img,
             case PIXFORMAT_GRAYSCALE:
             // Re-use grayscale for bayer.
             case PIXFORMAT_BAYER_ANY: {
+                // Palette expansion (e.g. thermal images): the palette is applied once per sampled
+                // source pixel while scaling, instead of in a second pass over the row buffer, and
+                // repeated destination rows are copied.
+                if ((src_img->pixfmt == PIXFORMAT_GRAYSCALE) && (dst_img->pixfmt == PIXFORMAT_RGB565)
+                    && color_palette && (!alpha_palette) && (alpha == 256)) {
+                    size_t dst_row_bytes = (dst_x_end - dst_x_start) * sizeof(uint16_t);
+
+                    while (y_not_done) {
+                        int src_y_index = next_src_y_index;
+                        uint8_t *src_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src_img, src_y_index);
+                        uint16_t *last_dst_row_ptr = NULL;
+
+                        do {
+                            uint16_t *dst_row_ptr = dst_row_override
+                                ? ((uint16_t *) dst_row_override)
+                                : IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst_img, dst_y);
+
+                            if (last_dst_row_ptr) {
+                                memcpy(dst_row_ptr + dst_x_start, last_dst_row_ptr + dst_x_start, dst_row_bytes);
+                            } else {
+                                // X loop iteration variables
+                                int dst_x = dst_x_reset;
+                                long src_x_accum = src_x_accum_reset;
+                                int next_src_x_index = src_x_accum >> 16;
+                                int x = dst_x_start;
+                                bool x_not_done = x < dst_x_end;
+
+                                while (x_not_done) {
+                                    int src_x_index = next_src_x_index;
+                                    int pixel = color_palette[IMAGE_GET_GRAYSCALE_PIXEL_FAST(src_row_ptr, src_x_index)];
+
+                                    do {
+                                        // Cache the results of getting the source pixel
+                                        IMAGE_PUT_RGB565_PIXEL_FAST(dst_row_ptr, dst_x, pixel);
+
+                                        // Increment offsets
+                                        dst_x += dst_delta_x;
+                                        src_x_accum += src_x_frac;
+                                        next_src_x_index = src_x_accum >> 16;
+                                        x_not_done = ++x < dst_x_end;
+                                    } while (x_not_done && (src_x_index == next_src_x_index));
+                                } // while x
+                            }
+
+                            if (callback) {
+                                ((imlib_draw_row_callback_t) callback) (dst_x_start, dst_x_end, dst_y,
+                                                                        &imlib_draw_row_data);
+                            }
+
+                            // The override row may be modified by the callback.
+                            last_dst_row_ptr = dst_row_override ? NULL : dst_row_ptr;
+
+                            // Increment offsets
+                            dst_y += dst_delta_y;
+                            src_y_accum += src_y_frac;
+                            next_src_y_index = src_y_accum >> 16;
+                            y_not_done = ++y < dst_y_end;
+                        } while (y_not_done && (src_y_index == next_src_y_index));
+                    } // while y
+                    break;
+                }
+
                 while (y_not_done) {
                     int src_y_index = next_src_y_index;
                     uint8_t *src_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src_img, src_y_index);
@@ -5518,7 +5936,7 @@ exit_cleanup:
     if (&new_src_img == src_img) {
         fb_free();
     }
-    OMV_PROFILE_PRINT();
+    OMV_PROFILE_END(draw_image);
 }
 
 #ifdef IMLIB_ENABLE_FLOOD_FILL
@@ -5526,7 +5944,7 @@ void imlib_flood_fill(image_t *img, int x, int y,
                       float seed_threshold, float floating_threshold,
                       int c, bool invert, bool clear_background, image_t *mask) {
     if ((0 <= x) && (x < img->w) && (0 <= y) && (y < img->h)) {
-        image_t out;
+        image_t out = {};
         out.w = img->w;
         out.h = img->h;
         out.pixfmt = PIXFORMAT_BINARY;
@@ -15,11 +15,6 @@
 #include "fb_alloc.h"
 #ifdef IMLIB_ENABLE_BINARY_OPS
 
-typedef struct gvec {
-    uint16_t t;
-    uint16_t g;
-} gvec_t;
-
 void imlib_edge_simple(image_t *src, rectangle_t *roi, int low_thresh, int high_thresh) {
     imlib_morph(src, 1, kernel_high_pass_3, 1.0f, 0.0f, false, 0, false, NULL);
     list_t thresholds;
@@ -33,53 +28,41 @@ void imlib_edge_simple(image_t *src, rectangle_t *roi, int low_thresh, int high_
     imlib_erode(src, 1, 2, NULL);
 }
 
-void imlib_edge_canny(image_t *src, rectangle_t *roi, int low_thresh, int high_thresh) {
-    int w = src->w;
+// The gradient map packs the magnitude with the direction (0 to 3) in the top bits.
+#define CANNY_DIR_SHIFT     (14)
+#define CANNY_MAG_MASK      ((1 << CANNY_DIR_SHIFT) - 1)
 
-    gvec_t *gm = fb_alloc0(roi->w * roi->h * sizeof *gm, FB_ALLOC_NO_HINT);
+static inline uint16_t canny_gvec(int gx, int gy) {
+    return imlib_gradient_magnitude(gx, gy) | (imlib_gradient_direction(gx, gy) << CANNY_DIR_SHIFT);
+}
+
+void imlib_edge_canny(image_t *src, rectangle_t *roi, int low_thresh, int high_thresh, gradients_t *gradients) {
+    int w = src->w;
 
-    //1. Noise Reduction with a Gaussian filter
-    imlib_sepconv3(src, kernel_gauss_3, 1.0f / 16.0f, 0.0f);
+    uint16_t *gm = fb_alloc0(roi->w * roi->h * sizeof *gm, FB_ALLOC_NO_HINT);
 
+    //1. Noise Reduction with a Gaussian filter, shared gradients are used as they are.
     //2. Finding Image Gradients
-    for (int gy = 1, y = roi->y + 1; y < roi->y + roi->h - 1; y++, gy++) {
-        for (int gx = 1, x = roi->x + 1; x < roi->x + roi->w - 1; x++, gx++) {
-            int vx = 0, vy = 0;
-            // sobel kernel in the horizontal direction
-            vx = src->data [(y - 1) * w + x - 1]
-                 - src->data [(y - 1) * w + x + 1]
-                 + (src->data[(y + 0) * w + x - 1] << 1)
-                 - (src->data[(y + 0) * w + x + 1] << 1)
-                 + src->data [(y + 1) * w + x - 1]
-                 - src->data [(y + 1) * w + x + 1];
-
-            // sobel kernel in the vertical direction
-            vy = src->data [(y - 1) * w + x - 1]
-                 + (src->data[(y - 1) * w + x + 0] << 1)
-                 + src->data [(y - 1) * w + x + 1]
-                 - src->data [(y + 1) * w + x - 1]
-                 - (src->data[(y + 1) * w + x + 0] << 1)
-                 - src->data [(y + 1) * w + x + 1];
-
-            // Find magnitude
-            int g = (int) fast_sqrtf(vx * vx + vy * vy);
-            // Find the direction and round angle to 0, 45, 90 or 135
-            int t = (int) fast_fabsf((atan2f(vy, vx) * 180.0f / M_PI));
-            if (t < 22) {
-                t = 0;
-            } else if (t < 67) {
-                t = 45;
-            } else if (t < 112) {
-                t = 90;
-            } else if (t < 160) {
-                t = 135;
-            } else if (t <= 180) {
-                t = 0;
+    if (gradients) {
+        for (int gy = 1, y = roi->y + 1; y < roi->y + roi->h - 1; y++, gy++) {
+            gradient_t *g = imlib_gradients_at(gradients, roi->x, y);
+            for (int gx = 1; gx < roi->w - 1; gx++) {
+                gm[gy * roi->w + gx] = canny_gvec(g[gx].x, g[gx].y);
+            }
+        }
+    } else {
+        imlib_sepconv3(src, kernel_gauss_3, 1.0f / 16.0f, 0.0f);
+
+        gradient_t *g = fb_alloc(roi->w * sizeof(gradient_t), FB_ALLOC_NO_HINT);
+        for (int gy = 1, y = roi->y + 1; y < roi->y + roi->h - 1; y++, gy++) {
+            imlib_gradients_row(src->data + ((y - 1) * w) + roi->x,
+                                src->data + ((y + 0) * w) + roi->x,
+                                src->data + ((y + 1) * w) + roi->x, roi->w, g);
+            for (int gx = 1; gx < roi->w - 1; gx++) {
+                gm[gy * roi->w + gx] = canny_gvec(g[gx].x, g[gx].y);
             }
-
-            gm[gy * roi->w + gx].t = t;
-            gm[gy * roi->w + gx].g = g;
         }
+        fb_free();
     }
 
     // 3. Hysteresis Thresholding
@@ -87,7 +70,9 @@ void imlib_edge_canny(image_t *src, rectangle_t *roi, int low_thresh, int high_t
     for (int gy = 0, y = roi->y; y < roi->y + roi->h; y++, gy++) {
         for (int gx = 0, x = roi->x; x < roi->x + roi->w; x++, gx++) {
             int i = y * w + x;
-            gvec_t *va = NULL, *vb = NULL, *vc = &gm[gy * roi->w + gx];
+            uint16_t *vc = &gm[gy * roi->w + gx];
+            int g = *vc & CANNY_MAG_MASK;
+            int va = 0, vb = 0;
 
             // Clear the borders
             if (y == (roi->y) || y == (roi->y + roi->h - 1) ||
@@ -96,54 +81,53 @@ void imlib_edge_canny(image_t *src, rectangle_t *roi, int low_thresh, int high_t
                 continue;
             }
 
-            if (vc->g < low_thresh) {
+            if (g < low_thresh) {
                 // Not an edge
                 src->data[i] = 0;
                 continue;
                 // Check if strong or weak edge
-            } else if (vc->g >= high_thresh ||
-                       gm[(gy - 1) * roi->w + (gx - 1)].g >= high_thresh ||
-                       gm[(gy - 1) * roi->w + (gx + 0)].g >= high_thresh ||
-                       gm[(gy - 1) * roi->w + (gx + 1)].g >= high_thresh ||
-                       gm[(gy + 0) * roi->w + (gx - 1)].g >= high_thresh ||
-                       gm[(gy + 0) * roi->w + (gx + 1)].g >= high_thresh ||
-                       gm[(gy + 1) * roi->w + (gx - 1)].g >= high_thresh ||
-                       gm[(gy + 1) * roi->w + (gx + 0)].g >= high_thresh ||
-                       gm[(gy + 1) * roi->w + (gx + 1)].g >= high_thresh) {
-                vc->g = vc->g;
-            } else {
+            } else if (g < high_thresh &&
+                       (vc[-roi->w - 1] & CANNY_MAG_MASK) < high_thresh &&
+                       (vc[-roi->w + 0] & CANNY_MAG_MASK) < high_thresh &&
+                       (vc[-roi->w + 1] & CANNY_MAG_MASK) < high_thresh &&
+                       (vc[-1] & CANNY_MAG_MASK) < high_thresh &&
+                       (vc[+1] & CANNY_MAG_MASK) < high_thresh &&
+                       (vc[+roi->w - 1] & CANNY_MAG_MASK) < high_thresh &&
+                       (vc[+roi->w + 0] & CANNY_MAG_MASK) < high_thresh &&
+                       (vc[+roi->w + 1] & CANNY_MAG_MASK) < high_thresh) {
                 // Not an edge
                 src->data[i] = 0;
                 continue;
             }
 
-            switch (vc->t) {
+            // Compare with the neighbors along the gradient.
+            switch (*vc >> CANNY_DIR_SHIFT) {
                 case 0: {
-                    va = &gm[(gy + 0) * roi->w + (gx - 1)];
-                    vb = &gm[(gy + 0) * roi->w + (gx + 1)];
+                    va = vc[-1];
+                    vb = vc[+1];
                     break;
                 }
 
-                case 45: {
-                    va = &gm[(gy + 1) * roi->w + (gx - 1)];
-                    vb = &gm[(gy - 1) * roi->w + (gx + 1)];
+                case 1: {
+                    va = vc[-roi->w - 1];
+                    vb = vc[+roi->w + 1];
                     break;
                 }
 
-                case 90: {
-                    va = &gm[(gy + 1) * roi->w + (gx + 0)];
-                    vb = &gm[(gy - 1) * roi->w + (gx + 0)];
+                case 2: {
+                    va = vc[-roi->w];
+                    vb = vc[+roi->w];
                     break;
                 }
 
-                case 135: {
-                    va = &gm[(gy + 1) * roi->w + (gx + 1)];
-                    vb = &gm[(gy - 1) * roi->w + (gx - 1)];
+                case 3: {
+                    va = vc[-roi->w + 1];
+                    vb = vc[+roi->w - 1];
                     break;
                 }
             }
 
-            if (!(vc->g > va->g && vc->g > vb->g)) {
+            if (!(g > (va & CANNY_MAG_MASK) && g > (vb & CANNY_MAG_MASK))) {
                 src->data[i] = 0;
             } else {
                 src->data[i] = 255;
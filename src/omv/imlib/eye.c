@@ -12,25 +12,33 @@
 #include "xalloc.h"
 #include "fmath.h"
 
-static void find_gradients(image_t *src, array_t *gradients, int x_off, int y_off, int box_w, int box_h) {
+static void find_gradients(image_t *src, gradients_t *map, array_t *gradients,
+                           int x_off, int y_off, int box_w, int box_h) {
     for (int y = y_off; y < y_off + box_h - 3; y++) {
         for (int x = x_off; x < x_off + box_w - 3; x++) {
             int vx = 0, vy = 0, w = src->w;
-            // sobel_kernel
-            vx = src->data[(y + 0) * w + x + 0]
-                 - src->data[(y + 0) * w + x + 2]
-                 + (src->data[(y + 1) * w + x + 0] << 1)
-                 - (src->data[(y + 1) * w + x + 2] << 1)
-                 + src->data[(y + 2) * w + x + 0]
-                 - src->data[(y + 2) * w + x + 2];
-
-            // sobel_kernel
-            vy = src->data[(y + 0) * w + x + 0]
-                 + (src->data[(y + 0) * w + x + 1] << 1)
-                 + src->data[(y + 0) * w + x + 2]
-                 - src->data[(y + 2) * w + x + 0]
-                 - (src->data[(y + 2) * w + x + 1] << 1)
-                 - src->data[(y + 2) * w + x + 2];
+            if (map) {
+                // Shared gradients are centered on the pixel, the kernels below start at its corner.
+                gradient_t *g = imlib_gradients_at(map, x + 1, y + 1);
+                vx = g->x;
+                vy = g->y;
+            } else {
+                // sobel_kernel
+                vx = src->data[(y + 0) * w + x + 0]
+                     - src->data[(y + 0) * w + x + 2]
+                     + (src->data[(y + 1) * w + x + 0] << 1)
+                     - (src->data[(y + 1) * w + x + 2] << 1)
+                     + src->data[(y + 2) * w + x + 0]
+                     - src->data[(y + 2) * w + x + 2];
+
+                // sobel_kernel
+                vy = src->data[(y + 0) * w + x + 0]
+                     + (src->data[(y + 0) * w + x + 1] << 1)
+                     + src->data[(y + 0) * w + x + 2]
+                     - src->data[(y + 2) * w + x + 0]
+                     - (src->data[(y + 2) * w + x + 1] << 1)
+                     - src->data[(y + 2) * w + x + 2];
+            }
 
             float m = fast_sqrtf(vx * vx + vy * vy);
             if (m > 200) {
@@ -110,7 +118,7 @@ static void find_iris(image_t *src, array_t *gradients, int x_off, int y_off, in
 }
 
 // This function should be called on an ROI detected with the eye Haar cascade.
-void imlib_find_iris(image_t *src, point_t *iris, rectangle_t *roi) {
+void imlib_find_iris(image_t *src, point_t *iris, rectangle_t *roi, gradients_t *gradients) {
     array_t *iris_gradients;
     array_alloc(&iris_gradients, xfree);
 
@@ -121,7 +129,7 @@ void imlib_find_iris(image_t *src, point_t *iris, rectangle_t *roi) {
     int y_off = roi->y + ((int) (0.40f * roi->h));
 
     // find gradients with strong magnitudes
-    find_gradients(src, iris_gradients,  x_off, y_off, box_w, box_h);
+    find_gradients(src, gradients, iris_gradients, x_off, y_off, box_w, box_h);
 
     // filter gradients
     filter_gradients(iris_gradients);
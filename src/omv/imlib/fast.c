@@ -34,6 +34,7 @@
 #include "xalloc.h"
 #include "fb_alloc.h"
 #include "gc.h"
+#include "simd.h"
 
 #ifdef IMLIB_ENABLE_FAST
 
@@ -41,16 +42,8 @@
 #define MAX_CORNERS      (2000U)
 #define Compare(X, Y)    ((X) >= (Y))
 
-typedef struct {
-    uint16_t x;
-    uint16_t y;
-    uint16_t score;
-} corner_t;
-
 static int pixel[16];
-static corner_t *fast9_detect(image_t *image, rectangle_t *roi, int *n_corners, int b);
-static void fast9_score(image_t *image, corner_t *corners, int num_corners, int b);
-static void nonmax_suppression(corner_t *corners, int num_corners, array_t *keypoints);
+static int fast9_corner_score(const uint8_t *p, int bstart);
 
 static kp_t *alloc_keypoint(uint16_t x, uint16_t y, uint16_t score) {
     // Note must set keypoint descriptor to zeros
@@ -80,127 +73,141 @@ static void make_offsets(int pixel[], int row_stride) {
     pixel[15] = -1 + row_stride * 3;
 }
 
-void fast_detect(image_t *image, array_t *keypoints, int threshold, rectangle_t *roi) {
-    int num_corners = 0;
-    make_offsets(pixel, image->w);
+// Returns true if 9 contiguous bits are set in the 16-bit circular mask.
+static inline bool fast9_segment(uint32_t m) {
+    m |= m << 16;
+    uint32_t m2 = m & (m >> 1);
+    uint32_t m4 = m2 & (m2 >> 2);
+    uint32_t m8 = m4 & (m4 >> 4);
+    return (m8 & (m >> 8)) != 0;
+}
 
-    // Find corners
-    corner_t *corners = fast9_detect(image, roi, &num_corners, threshold);
-    if (num_corners) {
-        // Score corners
-        fast9_score(image, corners, num_corners, threshold);
-        // Non-max suppression
-        nonmax_suppression(corners, num_corners, keypoints);
+static bool fast9_is_corner(const uint8_t *p, int b) {
+    int cb = *p + b;
+    int c_b = *p - b;
+    uint32_t bright = 0, dark = 0;
+    for (int k = 0; k < 16; k++) {
+        int v = p[pixel[k]];
+        bright |= (v > cb) << k;
+        dark |= (v < c_b) << k;
     }
-
-    // Free corners;
-    fb_free();
+    return fast9_segment(bright) || fast9_segment(dark);
 }
 
-static void nonmax_suppression(corner_t *corners, int num_corners, array_t *keypoints) {
-    gc_info_t info;
+// Writes score + 1 for each corner in the row and 0 elsewhere. A 9 pixel arc always covers two
+// adjacent compass pixels (0, 4, 8, 12), so it covers 0 or 8 and 4 or 12. That is tested for a
+// whole vector of pixels first and only the pixels passing it get the full segment test.
+static void fast9_score_row(image_t *image, int x_start, int y, int w, int b, uint16_t *scores) {
+    const uint8_t *row = image->pixels + (y * image->w) + x_start;
+    v128_t vb = vdup_u8(IM_MIN(IM_MAX(b, 0), 255));
+    uint8_t lanes[UINT8_VECTOR_SIZE];
 
-    int last_row;
-    int16_t *row_start;
-    const int sz = num_corners;
+    for (int x = 0; x < w; x += UINT8_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_8(w - x);
+        const uint8_t *p = row + x;
 
-    /* Point above points (roughly) to the pixel above
-       the one of interest, if there is a feature there.*/
-    int point_above = 0;
-    int point_below = 0;
+        v128_t c = vldr_u8_pred(p, pred);
+        v128_t hi = vqadd_u8(c, vb);
+        v128_t lo = vqsub_u8(c, vb);
 
-    /* Find where each row begins (the corners are output in raster scan order).
-       A beginning of -1 signifies that there are no corners on that row. */
-    last_row = corners[sz - 1].y;
-    row_start = fb_alloc((last_row + 1) * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+        v128_t p0 = vldr_u8_pred(p + pixel[0], pred);
+        v128_t p4 = vldr_u8_pred(p + pixel[4], pred);
+        v128_t p8 = vldr_u8_pred(p + pixel[8], pred);
+        v128_t p12 = vldr_u8_pred(p + pixel[12], pred);
 
-    for (int i = 0; i < last_row + 1; i++) {
-        row_start[i] = -1;
-    }
+        // Lanes are non-zero where brighter (darker) than the threshold, so min is "and" and max is "or".
+        v128_t bright = vmin_u8(vmax_u8(vqsub_u8(p0, hi), vqsub_u8(p8, hi)),
+                                vmax_u8(vqsub_u8(p4, hi), vqsub_u8(p12, hi)));
+        v128_t dark = vmin_u8(vmax_u8(vqsub_u8(lo, p0), vqsub_u8(lo, p8)),
+                              vmax_u8(vqsub_u8(lo, p4), vqsub_u8(lo, p12)));
+        v128_t candidates = vmax_u8(bright, dark);
 
-    for (int i = 0, prev_row = -1; i < sz; i++) {
-        corner_t *c = &corners[i];
-        if (c->y != prev_row) {
-            row_start[c->y] = i;
-            prev_row = c->y;
+        int n = vpredicate_8_get_n(pred);
+        for (int i = 0; i < n; i++) {
+            scores[x + i] = 0;
         }
-    }
 
-    for (int i = 0; i < sz; i++) {
-        corner_t pos = corners[i];
-        uint16_t score = pos.score;
-
-        /*Check left */
-        if (i > 0) {
-            if (corners[i - 1].x == pos.x - 1 && corners[i - 1].y == pos.y && Compare(corners[i - 1].score, score)) {
-                goto nonmax;
-            }
+        if (!vmaxv_u8(candidates)) {
+            continue;
         }
 
-        /*Check right*/
-        if (i < (sz - 1)) {
-            if (corners[i + 1].x == pos.x + 1 && corners[i + 1].y == pos.y && Compare(corners[i + 1].score, score)) {
-                goto nonmax;
+        vstr_u8_pred(lanes, candidates, pred);
+        for (int i = 0; i < n; i++) {
+            if (lanes[i] && fast9_is_corner(p + i, b)) {
+                scores[x + i] = fast9_corner_score(p + i, b) + 1;
             }
         }
+    }
+}
 
-        /*Check above (if there is a valid row above)*/
-        if (pos.y != 0 && row_start[pos.y - 1] != -1) {
-            /*Make sure that current point_above is one row above.*/
-            if (corners[point_above].y < pos.y - 1) {
-                point_above = row_start[pos.y - 1];
-            }
+// Corners are detected, scored and non-max suppressed in one pass over the roi. Scores are kept
+// for three rows at a time, row y - 1 is suppressed once row y has been scored.
+void fast_detect(image_t *image, array_t *keypoints, int threshold, rectangle_t *roi) {
+    gc_info_t info;
+    int num_corners = 0;
+    make_offsets(pixel, image->w);
 
-            /*Make point_above point to the first of the pixels above the current point, if it exists.*/
-            for (; corners[point_above].y < pos.y && corners[point_above].x < pos.x - 1; point_above++) {
+    int x_start = roi->x + 3;
+    int y_start = roi->y + 3;
+    int w = roi->w - 6;
+    int h = roi->h - 6;
 
-            }
+    if ((w <= 0) || (h <= 0)) {
+        return;
+    }
 
-            for (int j = point_above; corners[j].y < pos.y && corners[j].x <= pos.x + 1; j++) {
-                int x = corners[j].x;
-                if ( (x == pos.x - 1 || x == pos.x || x == pos.x + 1) && Compare(corners[j].score, score)) {
-                    goto nonmax;
-                }
-            }
+    // Each row has a zero border pixel on both sides.
+    int row_len = w + 2;
+    uint16_t *rows = fb_alloc0(3 * row_len * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    uint16_t *prev = rows + 1;
+    uint16_t *curr = prev + row_len;
+    uint16_t *next = curr + row_len;
+
+    for (int y = 0; y <= h; y++) {
+        if (y < h) {
+            fast9_score_row(image, x_start, y_start + y, w, threshold, next);
+        } else {
+            memset(next, 0, w * sizeof(uint16_t));
         }
 
-        /*Check below (if there is anything below)*/
-        if (pos.y != last_row && row_start[pos.y + 1] != -1 && point_below < sz) {
-            /*Nothing below*/
-            if (corners[point_below].y < pos.y + 1) {
-                point_below = row_start[pos.y + 1];
-            }
+        for (int x = 0; (y > 0) && (x < w); x++) {
+            uint16_t score = curr[x];
 
-            /* Make point below point to one of the pixels belowthe current point, if it exists.*/
-            for (; point_below < sz && corners[point_below].y == pos.y + 1 && corners[point_below].x < pos.x - 1;
-                 point_below++) {
+            // Neighbors with a greater or equal score suppress this corner.
+            if ((!score) ||
+                Compare(curr[x - 1], score) || Compare(curr[x + 1], score) ||
+                Compare(prev[x - 1], score) || Compare(prev[x], score) || Compare(prev[x + 1], score) ||
+                Compare(next[x - 1], score) || Compare(next[x], score) || Compare(next[x + 1], score)) {
+                continue;
             }
 
-            for (int j = point_below; j < sz && corners[j].y == pos.y + 1 && corners[j].x <= pos.x + 1; j++) {
-                int x = corners[j].x;
-                if ( (x == pos.x - 1 || x == pos.x || x == pos.x + 1) && Compare(corners[j].score, score)) {
-                    goto nonmax;
+            gc_info(&info);
+            // Allocate keypoints until we're almost out of memory
+            if (info.free < MIN_MEM) {
+                // Try collecting memory
+                gc_collect();
+                // If it didn't work break
+                gc_info(&info);
+                if (info.free < MIN_MEM) {
+                    goto done;
                 }
             }
-        }
 
-        gc_info(&info);
-        // Allocate keypoints until we're almost out of memory
-        if (info.free < MIN_MEM) {
-            // Try collecting memory
-            gc_collect();
-            // If it didn't work break
-            gc_info(&info);
-            if (info.free < MIN_MEM) {
-                break;
+            array_push_back(keypoints, alloc_keypoint(x_start + x, y_start + y - 1, score - 1));
+
+            if (++num_corners == MAX_CORNERS) {
+                goto done;
             }
         }
-        array_push_back(keypoints, alloc_keypoint(pos.x, pos.y, pos.score));
-        nonmax:
-        ;
+
+        uint16_t *tmp = prev;
+        prev = curr;
+        curr = next;
+        next = tmp;
     }
 
-    // Free temp rows.
+done:
+    // Free score rows.
     fb_free();
 }
 
@@ -3137,2942 +3144,4 @@ static int fast9_corner_score(const uint8_t *p, int bstart)
 }
 // *INDENT-ON*
 
-static void fast9_score(image_t *image, corner_t *corners, int num_corners, int b) {
-    for (int i = 0; i < num_corners; i++) {
-        corner_t *c = &corners[i];
-        c->score = fast9_corner_score(image->pixels + c->y * image->w + c->x, b);
-    }
-}
-
-// *INDENT-OFF*
-static corner_t *fast9_detect(image_t *image, rectangle_t *roi, int *n_corners, int b)
-{
-    int num_corners = 0;
-    // Try to alloc MAX_CORNERS or the actual max corners we can alloc.
-    int max_corners = IM_MIN(MAX_CORNERS, (fb_avail() / sizeof(corner_t)));
-    corner_t *corners = (corner_t*) fb_alloc(max_corners * sizeof(corner_t), FB_ALLOC_NO_HINT);
-
-    for(int y=roi->y+3; y<roi->y+roi->h-3; y++) {
-        for(int x=roi->x+3; x<roi->x+roi->w-3; x++) {
-            const uint8_t *p = image->pixels+(y * image->w + x);
-			int cb = *p + b;
-			int c_b= *p - b;
-            if(p[pixel[0]] > cb)
-             if(p[pixel[1]] > cb)
-              if(p[pixel[2]] > cb)
-               if(p[pixel[3]] > cb)
-                if(p[pixel[4]] > cb)
-                 if(p[pixel[5]] > cb)
-                  if(p[pixel[6]] > cb)
-                   if(p[pixel[7]] > cb)
-                    if(p[pixel[8]] > cb)
-                     {}
-                    else
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      continue;
-                   else if(p[pixel[7]] < c_b)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      continue;
-                    else if(p[pixel[14]] < c_b)
-                     if(p[pixel[8]] < c_b)
-                      if(p[pixel[9]] < c_b)
-                       if(p[pixel[10]] < c_b)
-                        if(p[pixel[11]] < c_b)
-                         if(p[pixel[12]] < c_b)
-                          if(p[pixel[13]] < c_b)
-                           if(p[pixel[15]] < c_b)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      continue;
-                    else
-                     continue;
-                  else if(p[pixel[6]] < c_b)
-                   if(p[pixel[15]] > cb)
-                    if(p[pixel[13]] > cb)
-                     if(p[pixel[14]] > cb)
-                      {}
-                     else
-                      continue;
-                    else if(p[pixel[13]] < c_b)
-                     if(p[pixel[7]] < c_b)
-                      if(p[pixel[8]] < c_b)
-                       if(p[pixel[9]] < c_b)
-                        if(p[pixel[10]] < c_b)
-                         if(p[pixel[11]] < c_b)
-                          if(p[pixel[12]] < c_b)
-                           if(p[pixel[14]] < c_b)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    if(p[pixel[7]] < c_b)
-                     if(p[pixel[8]] < c_b)
-                      if(p[pixel[9]] < c_b)
-                       if(p[pixel[10]] < c_b)
-                        if(p[pixel[11]] < c_b)
-                         if(p[pixel[12]] < c_b)
-                          if(p[pixel[13]] < c_b)
-                           if(p[pixel[14]] < c_b)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      continue;
-                    else
-                     continue;
-                   else if(p[pixel[13]] < c_b)
-                    if(p[pixel[7]] < c_b)
-                     if(p[pixel[8]] < c_b)
-                      if(p[pixel[9]] < c_b)
-                       if(p[pixel[10]] < c_b)
-                        if(p[pixel[11]] < c_b)
-                         if(p[pixel[12]] < c_b)
-                          if(p[pixel[14]] < c_b)
-                           if(p[pixel[15]] < c_b)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else if(p[pixel[5]] < c_b)
-                  if(p[pixel[14]] > cb)
-                   if(p[pixel[12]] > cb)
-                    if(p[pixel[13]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          if(p[pixel[10]] > cb)
-                           if(p[pixel[11]] > cb)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     continue;
-                   else if(p[pixel[12]] < c_b)
-                    if(p[pixel[6]] < c_b)
-                     if(p[pixel[7]] < c_b)
-                      if(p[pixel[8]] < c_b)
-                       if(p[pixel[9]] < c_b)
-                        if(p[pixel[10]] < c_b)
-                         if(p[pixel[11]] < c_b)
-                          if(p[pixel[13]] < c_b)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else if(p[pixel[14]] < c_b)
-                   if(p[pixel[7]] < c_b)
-                    if(p[pixel[8]] < c_b)
-                     if(p[pixel[9]] < c_b)
-                      if(p[pixel[10]] < c_b)
-                       if(p[pixel[11]] < c_b)
-                        if(p[pixel[12]] < c_b)
-                         if(p[pixel[13]] < c_b)
-                          if(p[pixel[6]] < c_b)
-                           {}
-                          else
-                           if(p[pixel[15]] < c_b)
-                            {}
-                           else
-                            continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   if(p[pixel[6]] < c_b)
-                    if(p[pixel[7]] < c_b)
-                     if(p[pixel[8]] < c_b)
-                      if(p[pixel[9]] < c_b)
-                       if(p[pixel[10]] < c_b)
-                        if(p[pixel[11]] < c_b)
-                         if(p[pixel[12]] < c_b)
-                          if(p[pixel[13]] < c_b)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[12]] > cb)
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          if(p[pixel[10]] > cb)
-                           if(p[pixel[11]] > cb)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else if(p[pixel[12]] < c_b)
-                   if(p[pixel[7]] < c_b)
-                    if(p[pixel[8]] < c_b)
-                     if(p[pixel[9]] < c_b)
-                      if(p[pixel[10]] < c_b)
-                       if(p[pixel[11]] < c_b)
-                        if(p[pixel[13]] < c_b)
-                         if(p[pixel[14]] < c_b)
-                          if(p[pixel[6]] < c_b)
-                           {}
-                          else
-                           if(p[pixel[15]] < c_b)
-                            {}
-                           else
-                            continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else if(p[pixel[4]] < c_b)
-                 if(p[pixel[13]] > cb)
-                  if(p[pixel[11]] > cb)
-                   if(p[pixel[12]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          if(p[pixel[10]] > cb)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          if(p[pixel[10]] > cb)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    continue;
-                  else if(p[pixel[11]] < c_b)
-                   if(p[pixel[5]] < c_b)
-                    if(p[pixel[6]] < c_b)
-                     if(p[pixel[7]] < c_b)
-                      if(p[pixel[8]] < c_b)
-                       if(p[pixel[9]] < c_b)
-                        if(p[pixel[10]] < c_b)
-                         if(p[pixel[12]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else if(p[pixel[13]] < c_b)
-                  if(p[pixel[7]] < c_b)
-                   if(p[pixel[8]] < c_b)
-                    if(p[pixel[9]] < c_b)
-                     if(p[pixel[10]] < c_b)
-                      if(p[pixel[11]] < c_b)
-                       if(p[pixel[12]] < c_b)
-                        if(p[pixel[6]] < c_b)
-                         if(p[pixel[5]] < c_b)
-                          {}
-                         else
-                          if(p[pixel[14]] < c_b)
-                           {}
-                          else
-                           continue;
-                        else
-                         if(p[pixel[14]] < c_b)
-                          if(p[pixel[15]] < c_b)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  if(p[pixel[5]] < c_b)
-                   if(p[pixel[6]] < c_b)
-                    if(p[pixel[7]] < c_b)
-                     if(p[pixel[8]] < c_b)
-                      if(p[pixel[9]] < c_b)
-                       if(p[pixel[10]] < c_b)
-                        if(p[pixel[11]] < c_b)
-                         if(p[pixel[12]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 if(p[pixel[11]] > cb)
-                  if(p[pixel[12]] > cb)
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          if(p[pixel[10]] > cb)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          if(p[pixel[10]] > cb)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else if(p[pixel[11]] < c_b)
-                  if(p[pixel[7]] < c_b)
-                   if(p[pixel[8]] < c_b)
-                    if(p[pixel[9]] < c_b)
-                     if(p[pixel[10]] < c_b)
-                      if(p[pixel[12]] < c_b)
-                       if(p[pixel[13]] < c_b)
-                        if(p[pixel[6]] < c_b)
-                         if(p[pixel[5]] < c_b)
-                          {}
-                         else
-                          if(p[pixel[14]] < c_b)
-                           {}
-                          else
-                           continue;
-                        else
-                         if(p[pixel[14]] < c_b)
-                          if(p[pixel[15]] < c_b)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-               else if(p[pixel[3]] < c_b)
-                if(p[pixel[10]] > cb)
-                 if(p[pixel[11]] > cb)
-                  if(p[pixel[12]] > cb)
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else if(p[pixel[10]] < c_b)
-                 if(p[pixel[7]] < c_b)
-                  if(p[pixel[8]] < c_b)
-                   if(p[pixel[9]] < c_b)
-                    if(p[pixel[11]] < c_b)
-                     if(p[pixel[6]] < c_b)
-                      if(p[pixel[5]] < c_b)
-                       if(p[pixel[4]] < c_b)
-                        {}
-                       else
-                        if(p[pixel[12]] < c_b)
-                         if(p[pixel[13]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                      else
-                       if(p[pixel[12]] < c_b)
-                        if(p[pixel[13]] < c_b)
-                         if(p[pixel[14]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                     else
-                      if(p[pixel[12]] < c_b)
-                       if(p[pixel[13]] < c_b)
-                        if(p[pixel[14]] < c_b)
-                         if(p[pixel[15]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else
-                if(p[pixel[10]] > cb)
-                 if(p[pixel[11]] > cb)
-                  if(p[pixel[12]] > cb)
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         if(p[pixel[9]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else if(p[pixel[10]] < c_b)
-                 if(p[pixel[7]] < c_b)
-                  if(p[pixel[8]] < c_b)
-                   if(p[pixel[9]] < c_b)
-                    if(p[pixel[11]] < c_b)
-                     if(p[pixel[12]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[5]] < c_b)
-                        if(p[pixel[4]] < c_b)
-                         {}
-                        else
-                         if(p[pixel[13]] < c_b)
-                          {}
-                         else
-                          continue;
-                       else
-                        if(p[pixel[13]] < c_b)
-                         if(p[pixel[14]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                      else
-                       if(p[pixel[13]] < c_b)
-                        if(p[pixel[14]] < c_b)
-                         if(p[pixel[15]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else
-                 continue;
-              else if(p[pixel[2]] < c_b)
-               if(p[pixel[9]] > cb)
-                if(p[pixel[10]] > cb)
-                 if(p[pixel[11]] > cb)
-                  if(p[pixel[12]] > cb)
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[3]] > cb)
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else if(p[pixel[9]] < c_b)
-                if(p[pixel[7]] < c_b)
-                 if(p[pixel[8]] < c_b)
-                  if(p[pixel[10]] < c_b)
-                   if(p[pixel[6]] < c_b)
-                    if(p[pixel[5]] < c_b)
-                     if(p[pixel[4]] < c_b)
-                      if(p[pixel[3]] < c_b)
-                       {}
-                      else
-                       if(p[pixel[11]] < c_b)
-                        if(p[pixel[12]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                     else
-                      if(p[pixel[11]] < c_b)
-                       if(p[pixel[12]] < c_b)
-                        if(p[pixel[13]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[11]] < c_b)
-                      if(p[pixel[12]] < c_b)
-                       if(p[pixel[13]] < c_b)
-                        if(p[pixel[14]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[11]] < c_b)
-                     if(p[pixel[12]] < c_b)
-                      if(p[pixel[13]] < c_b)
-                       if(p[pixel[14]] < c_b)
-                        if(p[pixel[15]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else
-                continue;
-              else
-               if(p[pixel[9]] > cb)
-                if(p[pixel[10]] > cb)
-                 if(p[pixel[11]] > cb)
-                  if(p[pixel[12]] > cb)
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[3]] > cb)
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        if(p[pixel[8]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else if(p[pixel[9]] < c_b)
-                if(p[pixel[7]] < c_b)
-                 if(p[pixel[8]] < c_b)
-                  if(p[pixel[10]] < c_b)
-                   if(p[pixel[11]] < c_b)
-                    if(p[pixel[6]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[4]] < c_b)
-                       if(p[pixel[3]] < c_b)
-                        {}
-                       else
-                        if(p[pixel[12]] < c_b)
-                         {}
-                        else
-                         continue;
-                      else
-                       if(p[pixel[12]] < c_b)
-                        if(p[pixel[13]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                     else
-                      if(p[pixel[12]] < c_b)
-                       if(p[pixel[13]] < c_b)
-                        if(p[pixel[14]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[12]] < c_b)
-                      if(p[pixel[13]] < c_b)
-                       if(p[pixel[14]] < c_b)
-                        if(p[pixel[15]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else
-                continue;
-             else if(p[pixel[1]] < c_b)
-              if(p[pixel[8]] > cb)
-               if(p[pixel[9]] > cb)
-                if(p[pixel[10]] > cb)
-                 if(p[pixel[11]] > cb)
-                  if(p[pixel[12]] > cb)
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[3]] > cb)
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[2]] > cb)
-                   if(p[pixel[3]] > cb)
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 continue;
-               else
-                continue;
-              else if(p[pixel[8]] < c_b)
-               if(p[pixel[7]] < c_b)
-                if(p[pixel[9]] < c_b)
-                 if(p[pixel[6]] < c_b)
-                  if(p[pixel[5]] < c_b)
-                   if(p[pixel[4]] < c_b)
-                    if(p[pixel[3]] < c_b)
-                     if(p[pixel[2]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[10]] < c_b)
-                       if(p[pixel[11]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[10]] < c_b)
-                      if(p[pixel[11]] < c_b)
-                       if(p[pixel[12]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[10]] < c_b)
-                     if(p[pixel[11]] < c_b)
-                      if(p[pixel[12]] < c_b)
-                       if(p[pixel[13]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[10]] < c_b)
-                    if(p[pixel[11]] < c_b)
-                     if(p[pixel[12]] < c_b)
-                      if(p[pixel[13]] < c_b)
-                       if(p[pixel[14]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[10]] < c_b)
-                   if(p[pixel[11]] < c_b)
-                    if(p[pixel[12]] < c_b)
-                     if(p[pixel[13]] < c_b)
-                      if(p[pixel[14]] < c_b)
-                       if(p[pixel[15]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 continue;
-               else
-                continue;
-              else
-               continue;
-             else
-              if(p[pixel[8]] > cb)
-               if(p[pixel[9]] > cb)
-                if(p[pixel[10]] > cb)
-                 if(p[pixel[11]] > cb)
-                  if(p[pixel[12]] > cb)
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[15]] > cb)
-                      {}
-                     else
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[3]] > cb)
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[2]] > cb)
-                   if(p[pixel[3]] > cb)
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[7]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 continue;
-               else
-                continue;
-              else if(p[pixel[8]] < c_b)
-               if(p[pixel[7]] < c_b)
-                if(p[pixel[9]] < c_b)
-                 if(p[pixel[10]] < c_b)
-                  if(p[pixel[6]] < c_b)
-                   if(p[pixel[5]] < c_b)
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[3]] < c_b)
-                      if(p[pixel[2]] < c_b)
-                       {}
-                      else
-                       if(p[pixel[11]] < c_b)
-                        {}
-                       else
-                        continue;
-                     else
-                      if(p[pixel[11]] < c_b)
-                       if(p[pixel[12]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[11]] < c_b)
-                      if(p[pixel[12]] < c_b)
-                       if(p[pixel[13]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[11]] < c_b)
-                     if(p[pixel[12]] < c_b)
-                      if(p[pixel[13]] < c_b)
-                       if(p[pixel[14]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[11]] < c_b)
-                    if(p[pixel[12]] < c_b)
-                     if(p[pixel[13]] < c_b)
-                      if(p[pixel[14]] < c_b)
-                       if(p[pixel[15]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else
-                continue;
-              else
-               continue;
-            else if(p[pixel[0]] < c_b)
-             if(p[pixel[1]] > cb)
-              if(p[pixel[8]] > cb)
-               if(p[pixel[7]] > cb)
-                if(p[pixel[9]] > cb)
-                 if(p[pixel[6]] > cb)
-                  if(p[pixel[5]] > cb)
-                   if(p[pixel[4]] > cb)
-                    if(p[pixel[3]] > cb)
-                     if(p[pixel[2]] > cb)
-                      {}
-                     else
-                      if(p[pixel[10]] > cb)
-                       if(p[pixel[11]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[10]] > cb)
-                      if(p[pixel[11]] > cb)
-                       if(p[pixel[12]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[10]] > cb)
-                     if(p[pixel[11]] > cb)
-                      if(p[pixel[12]] > cb)
-                       if(p[pixel[13]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[10]] > cb)
-                    if(p[pixel[11]] > cb)
-                     if(p[pixel[12]] > cb)
-                      if(p[pixel[13]] > cb)
-                       if(p[pixel[14]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[10]] > cb)
-                   if(p[pixel[11]] > cb)
-                    if(p[pixel[12]] > cb)
-                     if(p[pixel[13]] > cb)
-                      if(p[pixel[14]] > cb)
-                       if(p[pixel[15]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 continue;
-               else
-                continue;
-              else if(p[pixel[8]] < c_b)
-               if(p[pixel[9]] < c_b)
-                if(p[pixel[10]] < c_b)
-                 if(p[pixel[11]] < c_b)
-                  if(p[pixel[12]] < c_b)
-                   if(p[pixel[13]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[3]] < c_b)
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[2]] < c_b)
-                   if(p[pixel[3]] < c_b)
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 continue;
-               else
-                continue;
-              else
-               continue;
-             else if(p[pixel[1]] < c_b)
-              if(p[pixel[2]] > cb)
-               if(p[pixel[9]] > cb)
-                if(p[pixel[7]] > cb)
-                 if(p[pixel[8]] > cb)
-                  if(p[pixel[10]] > cb)
-                   if(p[pixel[6]] > cb)
-                    if(p[pixel[5]] > cb)
-                     if(p[pixel[4]] > cb)
-                      if(p[pixel[3]] > cb)
-                       {}
-                      else
-                       if(p[pixel[11]] > cb)
-                        if(p[pixel[12]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                     else
-                      if(p[pixel[11]] > cb)
-                       if(p[pixel[12]] > cb)
-                        if(p[pixel[13]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[11]] > cb)
-                      if(p[pixel[12]] > cb)
-                       if(p[pixel[13]] > cb)
-                        if(p[pixel[14]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[11]] > cb)
-                     if(p[pixel[12]] > cb)
-                      if(p[pixel[13]] > cb)
-                       if(p[pixel[14]] > cb)
-                        if(p[pixel[15]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else if(p[pixel[9]] < c_b)
-                if(p[pixel[10]] < c_b)
-                 if(p[pixel[11]] < c_b)
-                  if(p[pixel[12]] < c_b)
-                   if(p[pixel[13]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[3]] < c_b)
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else
-                continue;
-              else if(p[pixel[2]] < c_b)
-               if(p[pixel[3]] > cb)
-                if(p[pixel[10]] > cb)
-                 if(p[pixel[7]] > cb)
-                  if(p[pixel[8]] > cb)
-                   if(p[pixel[9]] > cb)
-                    if(p[pixel[11]] > cb)
-                     if(p[pixel[6]] > cb)
-                      if(p[pixel[5]] > cb)
-                       if(p[pixel[4]] > cb)
-                        {}
-                       else
-                        if(p[pixel[12]] > cb)
-                         if(p[pixel[13]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                      else
-                       if(p[pixel[12]] > cb)
-                        if(p[pixel[13]] > cb)
-                         if(p[pixel[14]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                     else
-                      if(p[pixel[12]] > cb)
-                       if(p[pixel[13]] > cb)
-                        if(p[pixel[14]] > cb)
-                         if(p[pixel[15]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else if(p[pixel[10]] < c_b)
-                 if(p[pixel[11]] < c_b)
-                  if(p[pixel[12]] < c_b)
-                   if(p[pixel[13]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else if(p[pixel[3]] < c_b)
-                if(p[pixel[4]] > cb)
-                 if(p[pixel[13]] > cb)
-                  if(p[pixel[7]] > cb)
-                   if(p[pixel[8]] > cb)
-                    if(p[pixel[9]] > cb)
-                     if(p[pixel[10]] > cb)
-                      if(p[pixel[11]] > cb)
-                       if(p[pixel[12]] > cb)
-                        if(p[pixel[6]] > cb)
-                         if(p[pixel[5]] > cb)
-                          {}
-                         else
-                          if(p[pixel[14]] > cb)
-                           {}
-                          else
-                           continue;
-                        else
-                         if(p[pixel[14]] > cb)
-                          if(p[pixel[15]] > cb)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else if(p[pixel[13]] < c_b)
-                  if(p[pixel[11]] > cb)
-                   if(p[pixel[5]] > cb)
-                    if(p[pixel[6]] > cb)
-                     if(p[pixel[7]] > cb)
-                      if(p[pixel[8]] > cb)
-                       if(p[pixel[9]] > cb)
-                        if(p[pixel[10]] > cb)
-                         if(p[pixel[12]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else if(p[pixel[11]] < c_b)
-                   if(p[pixel[12]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          if(p[pixel[10]] < c_b)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          if(p[pixel[10]] < c_b)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  if(p[pixel[5]] > cb)
-                   if(p[pixel[6]] > cb)
-                    if(p[pixel[7]] > cb)
-                     if(p[pixel[8]] > cb)
-                      if(p[pixel[9]] > cb)
-                       if(p[pixel[10]] > cb)
-                        if(p[pixel[11]] > cb)
-                         if(p[pixel[12]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else if(p[pixel[4]] < c_b)
-                 if(p[pixel[5]] > cb)
-                  if(p[pixel[14]] > cb)
-                   if(p[pixel[7]] > cb)
-                    if(p[pixel[8]] > cb)
-                     if(p[pixel[9]] > cb)
-                      if(p[pixel[10]] > cb)
-                       if(p[pixel[11]] > cb)
-                        if(p[pixel[12]] > cb)
-                         if(p[pixel[13]] > cb)
-                          if(p[pixel[6]] > cb)
-                           {}
-                          else
-                           if(p[pixel[15]] > cb)
-                            {}
-                           else
-                            continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else if(p[pixel[14]] < c_b)
-                   if(p[pixel[12]] > cb)
-                    if(p[pixel[6]] > cb)
-                     if(p[pixel[7]] > cb)
-                      if(p[pixel[8]] > cb)
-                       if(p[pixel[9]] > cb)
-                        if(p[pixel[10]] > cb)
-                         if(p[pixel[11]] > cb)
-                          if(p[pixel[13]] > cb)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else if(p[pixel[12]] < c_b)
-                    if(p[pixel[13]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          if(p[pixel[10]] < c_b)
-                           if(p[pixel[11]] < c_b)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   if(p[pixel[6]] > cb)
-                    if(p[pixel[7]] > cb)
-                     if(p[pixel[8]] > cb)
-                      if(p[pixel[9]] > cb)
-                       if(p[pixel[10]] > cb)
-                        if(p[pixel[11]] > cb)
-                         if(p[pixel[12]] > cb)
-                          if(p[pixel[13]] > cb)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else if(p[pixel[5]] < c_b)
-                  if(p[pixel[6]] > cb)
-                   if(p[pixel[15]] < c_b)
-                    if(p[pixel[13]] > cb)
-                     if(p[pixel[7]] > cb)
-                      if(p[pixel[8]] > cb)
-                       if(p[pixel[9]] > cb)
-                        if(p[pixel[10]] > cb)
-                         if(p[pixel[11]] > cb)
-                          if(p[pixel[12]] > cb)
-                           if(p[pixel[14]] > cb)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else if(p[pixel[13]] < c_b)
-                     if(p[pixel[14]] < c_b)
-                      {}
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    if(p[pixel[7]] > cb)
-                     if(p[pixel[8]] > cb)
-                      if(p[pixel[9]] > cb)
-                       if(p[pixel[10]] > cb)
-                        if(p[pixel[11]] > cb)
-                         if(p[pixel[12]] > cb)
-                          if(p[pixel[13]] > cb)
-                           if(p[pixel[14]] > cb)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else if(p[pixel[6]] < c_b)
-                   if(p[pixel[7]] > cb)
-                    if(p[pixel[14]] > cb)
-                     if(p[pixel[8]] > cb)
-                      if(p[pixel[9]] > cb)
-                       if(p[pixel[10]] > cb)
-                        if(p[pixel[11]] > cb)
-                         if(p[pixel[12]] > cb)
-                          if(p[pixel[13]] > cb)
-                           if(p[pixel[15]] > cb)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      continue;
-                    else
-                     continue;
-                   else if(p[pixel[7]] < c_b)
-                    if(p[pixel[8]] < c_b)
-                     {}
-                    else
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      continue;
-                   else
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[13]] > cb)
-                    if(p[pixel[7]] > cb)
-                     if(p[pixel[8]] > cb)
-                      if(p[pixel[9]] > cb)
-                       if(p[pixel[10]] > cb)
-                        if(p[pixel[11]] > cb)
-                         if(p[pixel[12]] > cb)
-                          if(p[pixel[14]] > cb)
-                           if(p[pixel[15]] > cb)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else if(p[pixel[13]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[12]] > cb)
-                   if(p[pixel[7]] > cb)
-                    if(p[pixel[8]] > cb)
-                     if(p[pixel[9]] > cb)
-                      if(p[pixel[10]] > cb)
-                       if(p[pixel[11]] > cb)
-                        if(p[pixel[13]] > cb)
-                         if(p[pixel[14]] > cb)
-                          if(p[pixel[6]] > cb)
-                           {}
-                          else
-                           if(p[pixel[15]] > cb)
-                            {}
-                           else
-                            continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else if(p[pixel[12]] < c_b)
-                   if(p[pixel[13]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          if(p[pixel[10]] < c_b)
-                           if(p[pixel[11]] < c_b)
-                            {}
-                           else
-                            continue;
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 if(p[pixel[11]] > cb)
-                  if(p[pixel[7]] > cb)
-                   if(p[pixel[8]] > cb)
-                    if(p[pixel[9]] > cb)
-                     if(p[pixel[10]] > cb)
-                      if(p[pixel[12]] > cb)
-                       if(p[pixel[13]] > cb)
-                        if(p[pixel[6]] > cb)
-                         if(p[pixel[5]] > cb)
-                          {}
-                         else
-                          if(p[pixel[14]] > cb)
-                           {}
-                          else
-                           continue;
-                        else
-                         if(p[pixel[14]] > cb)
-                          if(p[pixel[15]] > cb)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else if(p[pixel[11]] < c_b)
-                  if(p[pixel[12]] < c_b)
-                   if(p[pixel[13]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          if(p[pixel[10]] < c_b)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          if(p[pixel[10]] < c_b)
-                           {}
-                          else
-                           continue;
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-               else
-                if(p[pixel[10]] > cb)
-                 if(p[pixel[7]] > cb)
-                  if(p[pixel[8]] > cb)
-                   if(p[pixel[9]] > cb)
-                    if(p[pixel[11]] > cb)
-                     if(p[pixel[12]] > cb)
-                      if(p[pixel[6]] > cb)
-                       if(p[pixel[5]] > cb)
-                        if(p[pixel[4]] > cb)
-                         {}
-                        else
-                         if(p[pixel[13]] > cb)
-                          {}
-                         else
-                          continue;
-                       else
-                        if(p[pixel[13]] > cb)
-                         if(p[pixel[14]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                      else
-                       if(p[pixel[13]] > cb)
-                        if(p[pixel[14]] > cb)
-                         if(p[pixel[15]] > cb)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else if(p[pixel[10]] < c_b)
-                 if(p[pixel[11]] < c_b)
-                  if(p[pixel[12]] < c_b)
-                   if(p[pixel[13]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         if(p[pixel[9]] < c_b)
-                          {}
-                         else
-                          continue;
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else
-                 continue;
-              else
-               if(p[pixel[9]] > cb)
-                if(p[pixel[7]] > cb)
-                 if(p[pixel[8]] > cb)
-                  if(p[pixel[10]] > cb)
-                   if(p[pixel[11]] > cb)
-                    if(p[pixel[6]] > cb)
-                     if(p[pixel[5]] > cb)
-                      if(p[pixel[4]] > cb)
-                       if(p[pixel[3]] > cb)
-                        {}
-                       else
-                        if(p[pixel[12]] > cb)
-                         {}
-                        else
-                         continue;
-                      else
-                       if(p[pixel[12]] > cb)
-                        if(p[pixel[13]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                     else
-                      if(p[pixel[12]] > cb)
-                       if(p[pixel[13]] > cb)
-                        if(p[pixel[14]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[12]] > cb)
-                      if(p[pixel[13]] > cb)
-                       if(p[pixel[14]] > cb)
-                        if(p[pixel[15]] > cb)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else if(p[pixel[9]] < c_b)
-                if(p[pixel[10]] < c_b)
-                 if(p[pixel[11]] < c_b)
-                  if(p[pixel[12]] < c_b)
-                   if(p[pixel[13]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[3]] < c_b)
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        if(p[pixel[8]] < c_b)
-                         {}
-                        else
-                         continue;
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else
-                continue;
-             else
-              if(p[pixel[8]] > cb)
-               if(p[pixel[7]] > cb)
-                if(p[pixel[9]] > cb)
-                 if(p[pixel[10]] > cb)
-                  if(p[pixel[6]] > cb)
-                   if(p[pixel[5]] > cb)
-                    if(p[pixel[4]] > cb)
-                     if(p[pixel[3]] > cb)
-                      if(p[pixel[2]] > cb)
-                       {}
-                      else
-                       if(p[pixel[11]] > cb)
-                        {}
-                       else
-                        continue;
-                     else
-                      if(p[pixel[11]] > cb)
-                       if(p[pixel[12]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[11]] > cb)
-                      if(p[pixel[12]] > cb)
-                       if(p[pixel[13]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[11]] > cb)
-                     if(p[pixel[12]] > cb)
-                      if(p[pixel[13]] > cb)
-                       if(p[pixel[14]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[11]] > cb)
-                    if(p[pixel[12]] > cb)
-                     if(p[pixel[13]] > cb)
-                      if(p[pixel[14]] > cb)
-                       if(p[pixel[15]] > cb)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  continue;
-                else
-                 continue;
-               else
-                continue;
-              else if(p[pixel[8]] < c_b)
-               if(p[pixel[9]] < c_b)
-                if(p[pixel[10]] < c_b)
-                 if(p[pixel[11]] < c_b)
-                  if(p[pixel[12]] < c_b)
-                   if(p[pixel[13]] < c_b)
-                    if(p[pixel[14]] < c_b)
-                     if(p[pixel[15]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                    else
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[3]] < c_b)
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[2]] < c_b)
-                   if(p[pixel[3]] < c_b)
-                    if(p[pixel[4]] < c_b)
-                     if(p[pixel[5]] < c_b)
-                      if(p[pixel[6]] < c_b)
-                       if(p[pixel[7]] < c_b)
-                        {}
-                       else
-                        continue;
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 continue;
-               else
-                continue;
-              else
-               continue;
-            else
-             if(p[pixel[7]] > cb)
-              if(p[pixel[8]] > cb)
-               if(p[pixel[9]] > cb)
-                if(p[pixel[6]] > cb)
-                 if(p[pixel[5]] > cb)
-                  if(p[pixel[4]] > cb)
-                   if(p[pixel[3]] > cb)
-                    if(p[pixel[2]] > cb)
-                     if(p[pixel[1]] > cb)
-                      {}
-                     else
-                      if(p[pixel[10]] > cb)
-                       {}
-                      else
-                       continue;
-                    else
-                     if(p[pixel[10]] > cb)
-                      if(p[pixel[11]] > cb)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[10]] > cb)
-                     if(p[pixel[11]] > cb)
-                      if(p[pixel[12]] > cb)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[10]] > cb)
-                    if(p[pixel[11]] > cb)
-                     if(p[pixel[12]] > cb)
-                      if(p[pixel[13]] > cb)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[10]] > cb)
-                   if(p[pixel[11]] > cb)
-                    if(p[pixel[12]] > cb)
-                     if(p[pixel[13]] > cb)
-                      if(p[pixel[14]] > cb)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 if(p[pixel[10]] > cb)
-                  if(p[pixel[11]] > cb)
-                   if(p[pixel[12]] > cb)
-                    if(p[pixel[13]] > cb)
-                     if(p[pixel[14]] > cb)
-                      if(p[pixel[15]] > cb)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-               else
-                continue;
-              else
-               continue;
-             else if(p[pixel[7]] < c_b)
-              if(p[pixel[8]] < c_b)
-               if(p[pixel[9]] < c_b)
-                if(p[pixel[6]] < c_b)
-                 if(p[pixel[5]] < c_b)
-                  if(p[pixel[4]] < c_b)
-                   if(p[pixel[3]] < c_b)
-                    if(p[pixel[2]] < c_b)
-                     if(p[pixel[1]] < c_b)
-                      {}
-                     else
-                      if(p[pixel[10]] < c_b)
-                       {}
-                      else
-                       continue;
-                    else
-                     if(p[pixel[10]] < c_b)
-                      if(p[pixel[11]] < c_b)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                   else
-                    if(p[pixel[10]] < c_b)
-                     if(p[pixel[11]] < c_b)
-                      if(p[pixel[12]] < c_b)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                  else
-                   if(p[pixel[10]] < c_b)
-                    if(p[pixel[11]] < c_b)
-                     if(p[pixel[12]] < c_b)
-                      if(p[pixel[13]] < c_b)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                 else
-                  if(p[pixel[10]] < c_b)
-                   if(p[pixel[11]] < c_b)
-                    if(p[pixel[12]] < c_b)
-                     if(p[pixel[13]] < c_b)
-                      if(p[pixel[14]] < c_b)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                else
-                 if(p[pixel[10]] < c_b)
-                  if(p[pixel[11]] < c_b)
-                   if(p[pixel[12]] < c_b)
-                    if(p[pixel[13]] < c_b)
-                     if(p[pixel[14]] < c_b)
-                      if(p[pixel[15]] < c_b)
-                       {}
-                      else
-                       continue;
-                     else
-                      continue;
-                    else
-                     continue;
-                   else
-                    continue;
-                  else
-                   continue;
-                 else
-                  continue;
-               else
-                continue;
-              else
-               continue;
-             else
-              continue;
-
-            // Add corner
-            corners[num_corners].x = x;
-            corners[num_corners].y = y;
-
-            if (++num_corners == max_corners) {
-                goto done;
-            }
-		}
-    }
-
-done:
-    *n_corners = num_corners;
-    return corners;
-}
-// *INDENT-ON*
-
 #endif //IMLIB_ENABLE_FAST
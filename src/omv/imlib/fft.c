@@ -430,6 +430,96 @@ static void do_ifft(float *inout, int N_pow2, int stride) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+#if defined(IMLIB_ENABLE_CMSIS_FFT)
+// CMSIS-DSP transforms (MVE accelerated on Helium cores). The real transforms
+// only exist from 32 to 4096 points and the complex ones from 16 to 4096 points,
+// anything else falls back to the generic code above.
+#define CMSIS_RFFT_MIN_POW2    (5)
+#define CMSIS_CFFT_MIN_POW2    (4)
+#define CMSIS_FFT_MAX_POW2     (12)
+
+// Real N point transform where N = 1 << pow2.
+OMV_ATTR_ALWAYS_INLINE static bool cmsis_rfft_supported(int pow2) {
+    return (CMSIS_RFFT_MIN_POW2 <= pow2) && (pow2 <= CMSIS_FFT_MAX_POW2);
+}
+
+// Complex N point transform where N = 1 << pow2.
+OMV_ATTR_ALWAYS_INLINE static bool cmsis_cfft_supported(int pow2) {
+    return (CMSIS_CFFT_MIN_POW2 <= pow2) && (pow2 <= CMSIS_FFT_MAX_POW2);
+}
+
+// CMSIS packs the real fft output as {DC, Nyquist, X[1], ..., X[N/2-1]} which
+// already puts X[1] to X[N/2-1] in the right place. This moves the Nyquist bin
+// and mirrors the conjugate half so the N complex point layout is the same as
+// unpack_fft() produces.
+static void cmsis_unpack_rfft(float *data, int pow2) {
+    int N = 1 << pow2;
+    data[N + 0] = data[1];
+    data[N + 1] = 0;
+    data[1] = 0;
+    for (int k = 2, l = N; k < l; k += 2) {
+        data[(2 * N) - k + 0] = data[k + 0];
+        data[(2 * N) - k + 1] = -data[k + 1];
+    }
+}
+
+// Real N point forward fft of 8-bit data into N complex points.
+static void cmsis_rfft_u8(uint8_t *in, int in_len, float *out, int pow2) {
+    int N = 1 << pow2;
+    #if defined(IMLIB_ENABLE_CMSIS_FFT_Q15)
+    // Input is scaled to q15 as x/256 and the rfft downscales the result by
+    // N/2, so the output is converted back to float using 256*(N/2)/32768.
+    q15_t *q_in = fb_alloc(N * 3 * sizeof(q15_t), FB_ALLOC_NO_HINT);
+    q15_t *q_out = q_in + N;
+    for (int k = 0; k < N; k++) {
+        q_in[k] = (k < in_len) ? (in[k] << 7) : 0;
+    }
+    arm_rfft_instance_q15 S;
+    arm_rfft_init_q15(&S, N, 0, 1);
+    arm_rfft_q15(&S, q_in, q_out);
+    float scale = (float) (1 << pow2) / 128.0f;
+    for (int k = 0, l = 2 * N; k < l; k++) {
+        out[k] = q_out[k] * scale;
+    }
+    fb_free();
+    #else
+    float *h_buffer = fb_alloc(N * sizeof(float), FB_ALLOC_NO_HINT);
+    for (int k = 0; k < N; k++) {
+        h_buffer[k] = (k < in_len) ? in[k] : 0;
+    }
+    arm_rfft_fast_instance_f32 S;
+    arm_rfft_fast_init_f32(&S, N);
+    arm_rfft_fast_f32(&S, h_buffer, out, 0);
+    cmsis_unpack_rfft(out, pow2);
+    fb_free();
+    #endif
+}
+
+// Complex N point fft (or ifft) of a strided column. CMSIS needs the points to
+// be contiguous so the column is gathered into a buffer and scattered back.
+static void cmsis_cfft_columns(float *data, int w_pow2, int h_pow2, bool inverse) {
+    int H = 1 << h_pow2, row_len = 2 << w_pow2;
+    arm_cfft_instance_f32 S;
+    arm_cfft_init_f32(&S, H);
+    float *col = fb_alloc(2 * H * sizeof(float), FB_ALLOC_NO_HINT);
+    for (int i = 0; i < row_len; i += 2) {
+        float *p = data + i;
+        for (int j = 0; j < H; j++) {
+            col[(j * 2) + 0] = p[(j * row_len) + 0];
+            col[(j * 2) + 1] = p[(j * row_len) + 1];
+        }
+        arm_cfft_f32(&S, col, inverse, 1);
+        for (int j = 0; j < H; j++) {
+            p[(j * row_len) + 0] = col[(j * 2) + 0];
+            p[(j * row_len) + 1] = col[(j * 2) + 1];
+        }
+    }
+    fb_free();
+}
+#endif // IMLIB_ENABLE_CMSIS_FFT
+
+///////////////////////////////////////////////////////////////////////////////
+
 void fft1d_alloc(fft1d_controller_t *controller, uint8_t *buf, int len) {
     controller->d_pointer = buf;
     controller->d_len = len;
@@ -445,6 +535,13 @@ void fft1d_run(fft1d_controller_t *controller) {
     // We can speed up the FFT by packing data into both the real and imaginary
     // values. This results in having to do an FFT of half the size normally.
 
+    #if defined(IMLIB_ENABLE_CMSIS_FFT)
+    if (cmsis_rfft_supported(controller->pow2)) {
+        cmsis_rfft_u8(controller->d_pointer, controller->d_len, controller->data, controller->pow2);
+        return;
+    }
+    #endif
+
     float *h_buffer = fb_alloc((1 << controller->pow2) * sizeof(float), FB_ALLOC_NO_HINT);
     prepare_real_input(controller->d_pointer, controller->d_len,
                        h_buffer, controller->pow2 - 1);
@@ -457,6 +554,22 @@ void ifft1d_run(fft1d_controller_t *controller) {
     // We can speed up the FFT by packing data into both the real and imaginary
     // values. This results in having to do an FFT of half the size normally.
 
+    #if defined(IMLIB_ENABLE_CMSIS_FFT)
+    if (cmsis_rfft_supported(controller->pow2)) {
+        int N = 1 << controller->pow2;
+        float *buffer = fb_alloc(N * sizeof(float), FB_ALLOC_NO_HINT);
+        // Pack back to {DC, Nyquist, X[1], ..., X[N/2-1]}.
+        memcpy(buffer, controller->data, N * sizeof(float));
+        buffer[1] = controller->data[N];
+        arm_rfft_fast_instance_f32 S;
+        arm_rfft_fast_init_f32(&S, N);
+        arm_rfft_fast_f32(&S, buffer, controller->data, 1);
+        memset(controller->data + N, 0, N * sizeof(float));
+        fb_free();
+        return;
+    }
+    #endif
+
     float *h_buffer = fb_alloc((1 << controller->pow2) * sizeof(float), FB_ALLOC_NO_HINT);
     pack_fft(controller->data, h_buffer, controller->pow2 - 1);
     prepare_complex_input(h_buffer, h_buffer,
@@ -467,6 +580,38 @@ void ifft1d_run(fft1d_controller_t *controller) {
     fb_free();
 }
 
+#define FFT_POLAR_BLOCK (32)
+
+// Replaces the complex points with their phase, or with (log(magnitude), phase). The points are
+// converted in blocks so that the angles (and logs) of a block are computed together.
+static void fft_polar(float *data, int n, bool to_log) {
+    float re[FFT_POLAR_BLOCK], im[FFT_POLAR_BLOCK], phase[FFT_POLAR_BLOCK];
+
+    for (int i = 0; i < n; i += FFT_POLAR_BLOCK, data += FFT_POLAR_BLOCK * 2) {
+        int count = IM_MIN(n - i, FFT_POLAR_BLOCK);
+
+        for (int k = 0; k < count; k++) {
+            re[k] = data[(k * 2) + 0];
+            im[k] = data[(k * 2) + 1];
+        }
+
+        fast_atan2f_v(im, re, phase, count);
+
+        if (to_log) {
+            for (int k = 0; k < count; k++) {
+                re[k] = fast_sqrtf((re[k] * re[k]) + (im[k] * im[k]));
+            }
+
+            fast_log2_v(re, re, count);
+        }
+
+        for (int k = 0; k < count; k++) {
+            data[(k * 2) + 0] = to_log ? (re[k] * 0.69314718f) : phase[k];
+            data[(k * 2) + 1] = to_log ? phase[k] : 0;
+        }
+    }
+}
+
 void fft1d_mag(fft1d_controller_t *controller) {
     for (int i = 0, j = 2 << controller->pow2; i < j; i += 2) {
         float tmp_r = controller->data[i + 0];
@@ -477,21 +622,11 @@ void fft1d_mag(fft1d_controller_t *controller) {
 }
 
 void fft1d_phase(fft1d_controller_t *controller) {
-    for (int i = 0, j = 2 << controller->pow2; i < j; i += 2) {
-        float tmp_r = controller->data[i + 0];
-        float tmp_i = controller->data[i + 1];
-        controller->data[i + 0] = tmp_r ? fast_atan2f(tmp_i, tmp_r) : ((tmp_i < 0) ? (M_PI * 1.5) : (M_PI * 0.5));
-        controller->data[i + 1] = 0;
-    }
+    fft_polar(controller->data, 1 << controller->pow2, false);
 }
 
 void fft1d_log(fft1d_controller_t *controller) {
-    for (int i = 0, j = 2 << controller->pow2; i < j; i += 2) {
-        float tmp_r = controller->data[i + 0];
-        float tmp_i = controller->data[i + 1];
-        controller->data[i + 0] = fast_log(fast_sqrtf((tmp_r * tmp_r) + (tmp_i * tmp_i)));
-        controller->data[i + 1] = tmp_r ? fast_atan2f(tmp_i, tmp_r) : ((tmp_i < 0) ? (M_PI * 1.5) : (M_PI * 0.5));
-    }
+    fft_polar(controller->data, 1 << controller->pow2, true);
 }
 
 void fft1d_exp(fft1d_controller_t *controller) {
@@ -518,6 +653,22 @@ void fft1d_run_again(fft1d_controller_t *controller) {
     // We can speed up the FFT by packing data into both the real and imaginary
     // values. This results in having to do an FFT of half the size normally.
 
+    #if defined(IMLIB_ENABLE_CMSIS_FFT)
+    if (cmsis_rfft_supported(controller->pow2)) {
+        int N = 1 << controller->pow2;
+        float *buffer = fb_alloc(N * sizeof(float), FB_ALLOC_NO_HINT);
+        for (int k = 0; k < N; k++) {
+            buffer[k] = controller->data[k * 2];
+        }
+        arm_rfft_fast_instance_f32 S;
+        arm_rfft_fast_init_f32(&S, N);
+        arm_rfft_fast_f32(&S, buffer, controller->data, 0);
+        cmsis_unpack_rfft(controller->data, controller->pow2);
+        fb_free();
+        return;
+    }
+    #endif
+
     float *h_buffer = fb_alloc((1 << controller->pow2) * sizeof(float), FB_ALLOC_NO_HINT);
     prepare_real_input_again(controller->data, 1 << controller->pow2,
                              h_buffer, controller->pow2 - 1);
@@ -529,13 +680,17 @@ void fft1d_run_again(fft1d_controller_t *controller) {
 ///////////////////////////////////////////////////////////////////////////////
 
 void fft2d_alloc(fft2d_controller_t *controller, image_t *img, rectangle_t *r) {
+    fft2d_alloc_pad(controller, img, r, 0, 0);
+}
+
+void fft2d_alloc_pad(fft2d_controller_t *controller, image_t *img, rectangle_t *r, int w, int h) {
     controller->img = img;
     if (!rectangle_subimg(controller->img, r, &controller->r)) {
         mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("No intersection!"));
     }
 
-    controller->w_pow2 = int_clog2(controller->r.w);
-    controller->h_pow2 = int_clog2(controller->r.h);
+    controller->w_pow2 = int_clog2(IM_MAX(controller->r.w, w));
+    controller->h_pow2 = int_clog2(IM_MAX(controller->r.h, h));
 
     controller->data =
         fb_alloc0(2 * (1 << controller->w_pow2) * (1 << controller->h_pow2) * sizeof(float), FB_ALLOC_NO_HINT);
@@ -545,13 +700,33 @@ void fft2d_dealloc() {
     fb_free();
 }
 
+size_t fft2d_data_len(int w, int h) {
+    return 2 * (1 << int_clog2(w)) * (1 << int_clog2(h));
+}
+
+void fft2d_init(fft2d_controller_t *controller, image_t *img, rectangle_t *r, float *data) {
+    controller->img = img;
+    if (!rectangle_subimg(controller->img, r, &controller->r)) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("No intersection!"));
+    }
+
+    controller->w_pow2 = int_clog2(controller->r.w);
+    controller->h_pow2 = int_clog2(controller->r.h);
+    controller->data = data;
+
+    // fft2d_run() writes every row it has image data for, only the padding rows must be cleared.
+    int row_len = 2 << controller->w_pow2;
+    memset(controller->data + (controller->r.h * row_len), 0,
+           ((1 << controller->h_pow2) - controller->r.h) * row_len * sizeof(float));
+}
+
 void fft2d_run(fft2d_controller_t *controller) {
     // This section copies image data into the fft buffer. It takes care of
     // extracting the grey channel from RGB images if necessary. The code
     // also handles dealing with a rect less than the image size.
+    uint8_t *tmp = fb_alloc(controller->r.w * sizeof(uint8_t), FB_ALLOC_NO_HINT);
     for (int i = 0; i < controller->r.h; i++) {
         // Get image data into buffer.
-        uint8_t *tmp = fb_alloc(controller->r.w * sizeof(uint8_t), FB_ALLOC_NO_HINT);
         for (int j = 0; j < controller->r.w; j++) {
             if (IM_IS_GS(controller->img)) {
                 tmp[j] = IM_GET_GS_PIXEL(controller->img,
@@ -561,19 +736,26 @@ void fft2d_run(fft2d_controller_t *controller) {
                                                                controller->r.x + j, controller->r.y + i));
             }
         }
-        // Do FFT on image data and copy to main buffer.
+        // Do FFT on image data straight into its row of the main buffer.
         fft1d_controller_t fft1d_controller_i;
-        fft1d_alloc(&fft1d_controller_i, tmp, controller->r.w);
+        fft1d_controller_i.d_pointer = tmp;
+        fft1d_controller_i.d_len = controller->r.w;
+        fft1d_controller_i.pow2 = controller->w_pow2;
+        fft1d_controller_i.data = controller->data + (i * (2 << controller->w_pow2));
         fft1d_run(&fft1d_controller_i);
-        memcpy(controller->data + (i * (2 << controller->w_pow2)),
-               fft1d_controller_i.data, (2 << fft1d_controller_i.pow2) * sizeof(float));
-        fft1d_dealloc();
-        // Free image data buffer.
-        fb_free();
     }
+    // Free image data buffer.
+    fb_free();
 
     // The above operates on the rows and this fft operates on the columns. To
     // avoid having to transpose the array the fft takes a stride input.
+    #if defined(IMLIB_ENABLE_CMSIS_FFT)
+    if (cmsis_cfft_supported(controller->h_pow2)) {
+        cmsis_cfft_columns(controller->data, controller->w_pow2, controller->h_pow2, false);
+        return;
+    }
+    #endif
+
     for (int i = 0, ii = 2 << controller->w_pow2; i < ii; i += 2) {
         float *p = controller->data + i;
 //        apply_hann_window(p, controller->h_pow2, (1 << controller->w_pow2));
@@ -584,10 +766,17 @@ void fft2d_run(fft2d_controller_t *controller) {
 
 void ifft2d_run(fft2d_controller_t *controller) {
     // Do columns...
-    for (int i = 0, ii = 2 << controller->w_pow2; i < ii; i += 2) {
-        float *p = controller->data + i;
-        prepare_complex_input(p, p, controller->h_pow2, (1 << controller->w_pow2));
-        do_ifft(p, controller->h_pow2, (1 << controller->w_pow2));
+    #if defined(IMLIB_ENABLE_CMSIS_FFT)
+    if (cmsis_cfft_supported(controller->h_pow2)) {
+        cmsis_cfft_columns(controller->data, controller->w_pow2, controller->h_pow2, true);
+    } else
+    #endif
+    {
+        for (int i = 0, ii = 2 << controller->w_pow2; i < ii; i += 2) {
+            float *p = controller->data + i;
+            prepare_complex_input(p, p, controller->h_pow2, (1 << controller->w_pow2));
+            do_ifft(p, controller->h_pow2, (1 << controller->w_pow2));
+        }
     }
 
     // Do rows...
@@ -609,21 +798,11 @@ void fft2d_mag(fft2d_controller_t *controller) {
 }
 
 void fft2d_phase(fft2d_controller_t *controller) {
-    for (int i = 0, j = (1 << controller->h_pow2) * (1 << controller->w_pow2) * 2; i < j; i += 2) {
-        float tmp_r = controller->data[i + 0];
-        float tmp_i = controller->data[i + 1];
-        controller->data[i + 0] = tmp_r ? fast_atan2f(tmp_i, tmp_r) : ((tmp_i < 0) ? (M_PI * 1.5) : (M_PI * 0.5));
-        controller->data[i + 1] = 0;
-    }
+    fft_polar(controller->data, (1 << controller->h_pow2) * (1 << controller->w_pow2), false);
 }
 
 void fft2d_log(fft2d_controller_t *controller) {
-    for (int i = 0, j = (1 << controller->h_pow2) * (1 << controller->w_pow2) * 2; i < j; i += 2) {
-        float tmp_r = controller->data[i + 0];
-        float tmp_i = controller->data[i + 1];
-        controller->data[i + 0] = fast_log(fast_sqrtf((tmp_r * tmp_r) + (tmp_i * tmp_i)));
-        controller->data[i + 1] = tmp_r ? fast_atan2f(tmp_i, tmp_r) : ((tmp_i < 0) ? (M_PI * 1.5) : (M_PI * 0.5));
-    }
+    fft_polar(controller->data, (1 << controller->h_pow2) * (1 << controller->w_pow2), true);
 }
 
 void fft2d_exp(fft2d_controller_t *controller) {
@@ -739,6 +918,13 @@ void fft2d_run_again(fft2d_controller_t *controller) {
 
     // The above operates on the rows and this fft operates on the columns. To
     // avoid having to transpose the array the fft takes a stride input.
+    #if defined(IMLIB_ENABLE_CMSIS_FFT)
+    if (cmsis_cfft_supported(controller->h_pow2)) {
+        cmsis_cfft_columns(controller->data, controller->w_pow2, controller->h_pow2, false);
+        return;
+    }
+    #endif
+
     for (int i = 0, ii = 2 << controller->w_pow2; i < ii; i += 2) {
         float *p = controller->data + i;
 //        apply_hann_window(p, controller->h_pow2, (1 << controller->w_pow2));
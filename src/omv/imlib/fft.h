@@ -33,7 +33,10 @@ typedef struct fft2d_controller {
     float *data;
 } fft2d_controller_t;
 void fft2d_alloc(fft2d_controller_t *controller, image_t *img, rectangle_t *r);
+void fft2d_alloc_pad(fft2d_controller_t *controller, image_t *img, rectangle_t *r, int w, int h); // Pad to >= w x h.
 void fft2d_dealloc();
+size_t fft2d_data_len(int w, int h); // Number of floats in the data of a w x h fft2d.
+void fft2d_init(fft2d_controller_t *controller, image_t *img, rectangle_t *r, float *data); // Caller owned data.
 void fft2d_run(fft2d_controller_t *controller);
 void ifft2d_run(fft2d_controller_t *controller);
 void fft2d_mag(fft2d_controller_t *controller);
@@ -10,13 +10,14 @@
  */
 #include "fsort.h"
 #include "imlib.h"
+#include "simd.h"
 
 void imlib_histeq(image_t *img, image_t *mask) {
     switch (img->pixfmt) {
         case PIXFORMAT_BINARY: {
             int a = img->w * img->h;
             float s = (COLOR_BINARY_MAX - COLOR_BINARY_MIN) / ((float) a);
-            uint32_t *hist = fb_alloc0((COLOR_BINARY_MAX - COLOR_BINARY_MIN + 1) * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+            uint32_t *hist = fb_alloc0((COLOR_BINARY_MAX - COLOR_BINARY_MIN + 1) * sizeof(uint32_t), FB_ALLOC_PREFER_TCM);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
                 uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
@@ -48,7 +49,7 @@ void imlib_histeq(image_t *img, image_t *mask) {
         case PIXFORMAT_GRAYSCALE: {
             int a = img->w * img->h;
             float s = (COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN) / ((float) a);
-            uint32_t *hist = fb_alloc0((COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN + 1) * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+            uint32_t *hist = fb_alloc0((COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN + 1) * sizeof(uint32_t), FB_ALLOC_PREFER_TCM);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
                 uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
@@ -80,7 +81,7 @@ void imlib_histeq(image_t *img, image_t *mask) {
         case PIXFORMAT_RGB565: {
             int a = img->w * img->h;
             float s = (COLOR_Y_MAX - COLOR_Y_MIN) / ((float) a);
-            uint32_t *hist = fb_alloc0((COLOR_Y_MAX - COLOR_Y_MIN + 1) * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+            uint32_t *hist = fb_alloc0((COLOR_Y_MAX - COLOR_Y_MIN + 1) * sizeof(uint32_t), FB_ALLOC_PREFER_TCM);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
@@ -135,10 +136,236 @@ void imlib_histeq(image_t *img, image_t *mask) {
 //   of every pixel. This will allow very large filters to be used without
 //   much change in performance.
 //
+#if defined(IMLIB_ENABLE_MEAN) || defined(IMLIB_ENABLE_MEDIAN) || defined(IMLIB_ENABLE_GAUSSIAN)
+// Adds an 8-bit array to and removes an 8-bit array (if not NULL) from a 16-bit accumulator.
+static void imlib_accumulate_u8(uint16_t *acc, uint8_t *add, uint8_t *sub, int len) {
+    for (int i = 0; i < len; i += UINT16_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_16(len - i);
+        v128_t sum = vadd_u16(vldr_u16_pred(acc + i, pred), vldr_u8_widen_u16_pred(add + i, pred));
+
+        if (sub) {
+            sum = vsub_u16(sum, vldr_u8_widen_u16_pred(sub + i, pred));
+        }
+
+        vstr_u16_pred(acc + i, sum, pred);
+    }
+}
+#endif
+
+#if defined(IMLIB_ENABLE_MEAN) || defined(IMLIB_ENABLE_GAUSSIAN)
+static void imlib_mean_filter_update_sums_rgb565(uint16_t *r_sums, uint16_t *g_sums, uint16_t *b_sums,
+                                                 uint16_t *add_row, uint16_t *sub_row, int w) {
+    v128_t g_mask = vdup_u16(0x3f);
+    v128_t b_mask = vdup_u16(0x1f);
+
+    for (int x = 0; x < w; x += UINT16_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_16(w - x);
+        v128_t r_acc = vldr_u16_pred(r_sums + x, pred);
+        v128_t g_acc = vldr_u16_pred(g_sums + x, pred);
+        v128_t b_acc = vldr_u16_pred(b_sums + x, pred);
+
+        v128_t pixels = vldr_u16_pred(add_row + x, pred);
+        r_acc = vadd_u16(r_acc, vlsr_u16(pixels, 11));
+        g_acc = vadd_u16(g_acc, vand_u32(vlsr_u16(pixels, 5), g_mask));
+        b_acc = vadd_u16(b_acc, vand_u32(pixels, b_mask));
+
+        if (sub_row) {
+            pixels = vldr_u16_pred(sub_row + x, pred);
+            r_acc = vsub_u16(r_acc, vlsr_u16(pixels, 11));
+            g_acc = vsub_u16(g_acc, vand_u32(vlsr_u16(pixels, 5), g_mask));
+            b_acc = vsub_u16(b_acc, vand_u32(pixels, b_mask));
+        }
+
+        vstr_u16_pred(r_sums + x, r_acc, pred);
+        vstr_u16_pred(g_sums + x, g_acc, pred);
+        vstr_u16_pred(b_sums + x, b_acc, pred);
+    }
+}
+
+// Adds row y_add to and removes row y_sub (if not negative) from the column sums.
+static void imlib_mean_filter_update_sums(image_t *img, uint16_t *sums, int stride, int y_add, int y_sub) {
+    if (img->pixfmt == PIXFORMAT_GRAYSCALE) {
+        imlib_accumulate_u8(sums,
+                            IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y_add),
+                            (y_sub >= 0) ? IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y_sub) : NULL,
+                            img->w);
+    } else {
+        imlib_mean_filter_update_sums_rgb565(sums, sums + stride, sums + (stride * 2),
+                                             IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y_add),
+                                             (y_sub >= 0) ? IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y_sub) : NULL,
+                                             img->w);
+    }
+}
+
+// Unmasked GRAYSCALE/RGB565 mean filter. Each column's vertical sum is kept in a line buffer and
+// slid down one row at a time with vector adds/subtracts, and the horizontal sum is slid across
+// the column sums. The cost per pixel is constant regardless of ksize. The edges are clamped the
+// same way as the generic filter, so the output is identical. When thresholding, pixels are
+// compared against ref, which may be img itself. If round is set the mean is rounded instead
+// of truncated so repeated passes don't darken the image.
+static void imlib_mean_filter_simd(image_t *img, image_t *ref, const int ksize,
+                                   bool threshold, int offset, bool invert, bool round) {
+    int brows = ksize + 1;
+    image_t buf = {};
+    buf.w = img->w;
+    buf.h = brows;
+    buf.pixfmt = img->pixfmt;
+    size_t line_size = image_line_size(img);
+    size_t row_stride = image_row_stride(img);
+    buf.data = fb_alloc(line_size * brows, FB_ALLOC_PREFER_TCM);
+
+    int32_t over32_n = 65536 / (((ksize * 2) + 1) * ((ksize * 2) + 1));
+    int32_t bias = round ? 32768 : 0;
+    int channels = (img->pixfmt == PIXFORMAT_RGB565) ? 3 : 1;
+    int stride = (img->w + 1) & ~1;
+    uint16_t *sums = fb_alloc0(stride * channels * sizeof(uint16_t), FB_ALLOC_PREFER_TCM | FB_ALLOC_CACHE_ALIGN);
+    uint16_t *r_sums = sums, *g_sums = sums + stride, *b_sums = sums + (stride * 2);
+
+    // Sum the window of the first row, the top edge is clamped.
+    for (int j = -ksize; j <= ksize; j++) {
+        imlib_mean_filter_update_sums(img, sums, stride, IM_CLAMP(j, 0, (img->h - 1)), -1);
+    }
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        int r_acc = 0, g_acc = 0, b_acc = 0;
+        for (int k = -ksize; k <= ksize; k++) {
+            int x_k = IM_CLAMP(k, 0, (img->w - 1));
+            r_acc += r_sums[x_k];
+            if (channels == 3) {
+                g_acc += g_sums[x_k];
+                b_acc += b_sums[x_k];
+            }
+        }
+
+        if (img->pixfmt == PIXFORMAT_GRAYSCALE) {
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ref, y);
+            uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
+
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                int pixel = (int) (((r_acc * over32_n) + bias) >> 16);
+
+                if (threshold) {
+                    if (((pixel - offset) < IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x)) ^ invert) {
+                        pixel = COLOR_GRAYSCALE_BINARY_MAX;
+                    } else {
+                        pixel = COLOR_GRAYSCALE_BINARY_MIN;
+                    }
+                }
+
+                IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
+                r_acc += r_sums[IM_MIN(x + ksize + 1, xx - 1)] - r_sums[IM_MAX(x - ksize, 0)];
+            }
+        } else {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ref, y);
+            uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
+
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                int r = (int) (((r_acc * over32_n) + bias) >> 16);
+                int g = (int) (((g_acc * over32_n) + bias) >> 16);
+                int b = (int) (((b_acc * over32_n) + bias) >> 16);
+                int pixel = COLOR_R5_G6_B5_TO_RGB565(r, g, b);
+
+                if (threshold) {
+                    if (((COLOR_RGB565_TO_Y(pixel) - offset) <
+                         COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) ^ invert) {
+                        pixel = COLOR_RGB565_BINARY_MAX;
+                    } else {
+                        pixel = COLOR_RGB565_BINARY_MIN;
+                    }
+                }
+
+                IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
+                int x_add = IM_MIN(x + ksize + 1, xx - 1), x_sub = IM_MAX(x - ksize, 0);
+                r_acc += r_sums[x_add] - r_sums[x_sub];
+                g_acc += g_sums[x_add] - g_sums[x_sub];
+                b_acc += b_sums[x_add] - b_sums[x_sub];
+            }
+        }
+
+        // Slide the column sums down one row, this must be done before the top row is overwritten.
+        if ((y + 1) < yy) {
+            imlib_mean_filter_update_sums(img, sums, stride, IM_MIN(y + ksize + 1, yy - 1), IM_MAX(y - ksize, 0));
+        }
+
+        if (y >= ksize) {
+            // Transfer buffer lines...
+            memcpy(img->data + (row_stride * (y - ksize)),
+                   buf.data + (line_size * ((y - ksize) % brows)),
+                   line_size);
+        }
+    }
+
+    // Copy any remaining lines from the buffer image...
+    for (int y = IM_MAX(img->h - ksize, 0), yy = img->h; y < yy; y++) {
+        memcpy(img->data + (row_stride * y),
+               buf.data + (line_size * (y % brows)),
+               line_size);
+    }
+
+    fb_free(); // sums
+    fb_free(); // buf
+}
+#endif // IMLIB_ENABLE_MEAN || IMLIB_ENABLE_GAUSSIAN
+
+#ifdef IMLIB_ENABLE_GAUSSIAN
+// Approximates the binomial gaussian kernel of imlib_morph() with three stacked box blurs, which
+// makes the cost per pixel independent of ksize. A (2k+1) binomial kernel has a variance of k/2
+// and a box of radius r has a variance of r(r+1)/3, so the radii are picked such that the sum
+// of the three box variances is as close as possible to k/2.
+bool imlib_gaussian_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask) {
+    if ((mask) || (ksize < IMLIB_GAUSSIAN_BOX_MIN_KSIZE) ||
+        ((img->pixfmt != PIXFORMAT_GRAYSCALE) && (img->pixfmt != PIXFORMAT_RGB565))) {
+        return false;
+    }
+
+    int r = 0;
+    while (((r + 1) * (r + 2) * 2) <= ksize) {
+        r += 1;
+    }
+
+    // Number of passes that use r + 1 instead of r, each adds 2(r+1) to the variance sum.
+    int m = IM_MIN(((ksize * 3) - (r * (r + 1) * 6) + ((r + 1) * 2)) / ((r + 1) * 4), 3);
+    int radii[3] = { r + (m > 0), r + (m > 1), r + (m > 2) };
+    int passes = (radii[2] > 0) ? 3 : ((radii[1] > 0) ? 2 : 1);
+
+    // Thresholding compares against the unfiltered image, so it has to be kept around.
+    int channels = (img->pixfmt == PIXFORMAT_RGB565) ? 3 : 1;
+    size_t work = (image_line_size(img) * (radii[0] + 1)) +
+                  ((((img->w + 1) & ~1) * channels * sizeof(uint16_t)) + (OMV_ALLOC_ALIGNMENT * 2));
+    if (threshold && (fb_avail() < (image_size(img) + work))) {
+        return false;
+    }
+
+    image_t ref = *img;
+    if (threshold) {
+        ref.data = fb_alloc(image_size(img), FB_ALLOC_NO_HINT);
+        memcpy(ref.data, img->data, image_size(img));
+    }
+
+    for (int i = 0; i < passes; i++) {
+        bool last = (i == (passes - 1));
+        imlib_mean_filter_simd(img, &ref, radii[i], threshold && last, offset, invert, true);
+    }
+
+    if (threshold) {
+        fb_free(); // ref
+    }
+
+    return true;
+}
+#endif // IMLIB_ENABLE_GAUSSIAN
+
 #ifdef IMLIB_ENABLE_MEAN
 void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask) {
+    // The column sums are 16-bits.
+    if ((!mask) && (((ksize * 2) + 1) * COLOR_GRAYSCALE_MAX <= UINT16_MAX) &&
+        ((img->pixfmt == PIXFORMAT_GRAYSCALE) || (img->pixfmt == PIXFORMAT_RGB565))) {
+        imlib_mean_filter_simd(img, img, ksize, threshold, offset, invert, false);
+        return;
+    }
+
     int brows = ksize + 1;
-    image_t buf;
+    image_t buf = {};
     buf.w = img->w;
     buf.h = brows;
     buf.pixfmt = img->pixfmt;
@@ -388,10 +615,215 @@ static uint8_t hist_median(uint8_t *data, int len, const int cutoff) {
     return i - 1;
 } /* hist_median() */
 
+static int hist_median_u16(uint16_t *data, int len, const int cutoff) {
+    int i, sum = 0;
+    for (i = 0; i < len && sum < cutoff; i++) {
+        sum += data[i];
+    }
+    return i - 1;
+}
+
+// Adds (delta = 1) or removes (delta = -1) row y to/from the column histograms.
+static void imlib_median_filter_update_cols(image_t *img, uint8_t *col_hist, int bins, int y, int delta) {
+    if (img->pixfmt == PIXFORMAT_GRAYSCALE) {
+        uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+
+        for (int x = 0, xx = img->w; x < xx; x++, col_hist += bins) {
+            col_hist[IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x) >> 2] += delta;
+        }
+    } else {
+        uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+
+        for (int x = 0, xx = img->w; x < xx; x++, col_hist += bins) {
+            int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+            col_hist[COLOR_RGB565_TO_R5(pixel)] += delta;
+            col_hist[32 + COLOR_RGB565_TO_G6(pixel)] += delta;
+            col_hist[96 + COLOR_RGB565_TO_B5(pixel)] += delta;
+        }
+    }
+}
+
+// Constant time median filter (Perreault and Hebert). A histogram is kept for each column of the
+// window and slid down one row at a time. The window histogram is slid across the row by adding
+// the column histogram entering the window and removing the one leaving it, so the cost per pixel
+// depends on the number of bins and not on ksize. The bins and edge clamping are the same as the
+// generic filter.
+static void imlib_median_filter_fast(image_t *img, const int ksize, const int median_cutoff,
+                                     bool threshold, int offset, bool invert, image_t *mask) {
+    int brows = ksize + 1;
+    image_t buf = {};
+    buf.w = img->w;
+    buf.h = brows;
+    buf.pixfmt = img->pixfmt;
+    size_t line_size = image_line_size(img);
+    size_t row_stride = image_row_stride(img);
+    buf.data = fb_alloc(line_size * brows, FB_ALLOC_PREFER_TCM);
+
+    // GRAYSCALE uses 64 bins, RGB565 uses 32 (R5) + 64 (G6) + 32 (B5) bins.
+    int bins = (img->pixfmt == PIXFORMAT_GRAYSCALE) ? 64 : 128;
+    uint8_t *col_hist = fb_alloc0(img->w * bins, FB_ALLOC_PREFER_TCM);
+    uint16_t *hist = fb_alloc(bins * sizeof(uint16_t), FB_ALLOC_PREFER_TCM | FB_ALLOC_CACHE_ALIGN);
+
+    // Add the window of the first row, the top edge is clamped.
+    for (int j = -ksize; j <= ksize; j++) {
+        imlib_median_filter_update_cols(img, col_hist, bins, IM_CLAMP(j, 0, (img->h - 1)), 1);
+    }
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        memset(hist, 0, bins * sizeof(uint16_t));
+
+        for (int k = -ksize; k <= ksize; k++) {
+            imlib_accumulate_u8(hist, col_hist + (IM_CLAMP(k, 0, (img->w - 1)) * bins), NULL, bins);
+        }
+
+        if (img->pixfmt == PIXFORMAT_GRAYSCALE) {
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+            uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
+
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                uint8_t pixel = hist_median_u16(hist, 64, median_cutoff) << 2;
+
+                if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                } else if (threshold) {
+                    if (((pixel - offset) < IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x)) ^ invert) {
+                        pixel = COLOR_GRAYSCALE_BINARY_MAX;
+                    } else {
+                        pixel = COLOR_GRAYSCALE_BINARY_MIN;
+                    }
+                }
+
+                IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
+
+                // Slide the window histogram right.
+                imlib_accumulate_u8(hist,
+                                    col_hist + (IM_MIN(x + ksize + 1, xx - 1) * bins),
+                                    col_hist + (IM_MAX(x - ksize, 0) * bins), bins);
+            }
+        } else {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
+
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                int r = hist_median_u16(hist, 32, median_cutoff);
+                int g = hist_median_u16(hist + 32, 64, median_cutoff);
+                int b = hist_median_u16(hist + 96, 32, median_cutoff);
+                int pixel = COLOR_R5_G6_B5_TO_RGB565(r, g, b);
+
+                if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                    pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+                } else if (threshold) {
+                    if (((COLOR_RGB565_TO_Y(pixel) - offset) <
+                         COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) ^ invert) {
+                        pixel = COLOR_RGB565_BINARY_MAX;
+                    } else {
+                        pixel = COLOR_RGB565_BINARY_MIN;
+                    }
+                }
+
+                IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
+
+                // Slide the window histogram right.
+                imlib_accumulate_u8(hist,
+                                    col_hist + (IM_MIN(x + ksize + 1, xx - 1) * bins),
+                                    col_hist + (IM_MAX(x - ksize, 0) * bins), bins);
+            }
+        }
+
+        // Slide the column histograms down one row, this must be done before the top row is overwritten.
+        if ((y + 1) < yy) {
+            imlib_median_filter_update_cols(img, col_hist, bins, IM_MAX(y - ksize, 0), -1);
+            imlib_median_filter_update_cols(img, col_hist, bins, IM_MIN(y + ksize + 1, yy - 1), 1);
+        }
+
+        if (y >= ksize) {
+            // Transfer buffer lines...
+            memcpy(img->data + (row_stride * (y - ksize)),
+                   buf.data + (line_size * ((y - ksize) % brows)),
+                   line_size);
+        }
+    }
+
+    // Copy any remaining lines from the buffer image...
+    for (int y = IM_MAX(img->h - ksize, 0), yy = img->h; y < yy; y++) {
+        memcpy(img->data + (row_stride * y),
+               buf.data + (line_size * (y % brows)),
+               line_size);
+    }
+
+    fb_free(); // hist
+    fb_free(); // col_hist
+    fb_free(); // buf
+}
+
+// Small grayscale windows (3x3 and 5x5) are sorted with the fsort networks, which is about as
+// fast as sliding the 64 bin histogram and gives the exact rank instead of a multiple of 4.
+static void imlib_median_filter_sort(image_t *img, const int ksize, const int median_cutoff,
+                                     bool threshold, int offset, bool invert, image_t *mask) {
+    int brows = ksize + 1;
+    image_t buf = {};
+    buf.w = img->w;
+    buf.h = brows;
+    buf.pixfmt = img->pixfmt;
+    size_t line_size = image_line_size(img);
+    size_t row_stride = image_row_stride(img);
+    buf.data = fb_alloc(line_size * brows, FB_ALLOC_PREFER_TCM);
+
+    int window[25];
+    int n = ((ksize * 2) + 1) * ((ksize * 2) + 1);
+    int rank = IM_CLAMP(median_cutoff - 1, 0, n - 1);
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+        uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+
+            if ((!mask) || image_get_mask_pixel(mask, x, y)) {
+                for (int j = -ksize, i = 0; j <= ksize; j++) {
+                    uint8_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, IM_CLAMP(y + j, 0, (yy - 1)));
+                    for (int k = -ksize; k <= ksize; k++) {
+                        window[i++] = IMAGE_GET_GRAYSCALE_PIXEL_FAST(k_row_ptr, IM_CLAMP(x + k, 0, (xx - 1)));
+                    }
+                }
+
+                fsort(window, n);
+
+                if (!threshold) {
+                    pixel = window[rank];
+                } else if (((window[rank] - offset) < pixel) ^ invert) {
+                    pixel = COLOR_GRAYSCALE_BINARY_MAX;
+                } else {
+                    pixel = COLOR_GRAYSCALE_BINARY_MIN;
+                }
+            }
+
+            IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
+        }
+
+        if (y >= ksize) {
+            // Transfer buffer lines...
+            memcpy(img->data + (row_stride * (y - ksize)),
+                   buf.data + (line_size * ((y - ksize) % brows)),
+                   line_size);
+        }
+    }
+
+    // Copy any remaining lines from the buffer image...
+    for (int y = IM_MAX(img->h - ksize, 0), yy = img->h; y < yy; y++) {
+        memcpy(img->data + (row_stride * y),
+               buf.data + (line_size * (y % brows)),
+               line_size);
+    }
+
+    fb_free(); // buf
+}
+
 void imlib_median_filter(image_t *img, const int ksize, float percentile, bool threshold, int offset, bool invert,
-                         image_t *mask) {
+                         image_t *mask, bool fast) {
     int brows = ksize + 1;
-    image_t buf;
+    image_t buf = {};
     buf.w = img->w;
     buf.h = brows;
     buf.pixfmt = img->pixfmt;
@@ -399,6 +831,18 @@ void imlib_median_filter(image_t *img, const int ksize, float percentile, bool t
     const int n = ((ksize * 2) + 1) * ((ksize * 2) + 1);
     const int median_cutoff = fast_floorf(percentile * (float) n);
 
+    // The column histograms are 8-bits and the window histogram is 16-bits.
+    if (fast && (((ksize * 2) + 1) <= UINT8_MAX) &&
+        ((img->pixfmt == PIXFORMAT_GRAYSCALE) || (img->pixfmt == PIXFORMAT_RGB565))) {
+        imlib_median_filter_fast(img, ksize, median_cutoff, threshold, offset, invert, mask);
+        return;
+    }
+
+    if ((ksize >= 1) && (ksize <= 2) && (img->pixfmt == PIXFORMAT_GRAYSCALE)) {
+        imlib_median_filter_sort(img, ksize, median_cutoff, threshold, offset, invert, mask);
+        return;
+    }
+
     switch (img->pixfmt) {
         case PIXFORMAT_BINARY: {
             buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
@@ -644,7 +1088,7 @@ static uint8_t find_mode(uint8_t *bins, int len) {
 
 void imlib_mode_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask) {
     int brows = ksize + 1;
-    image_t buf;
+    image_t buf = {};
     buf.w = img->w;
     buf.h = brows;
     buf.pixfmt = img->pixfmt;
@@ -961,9 +1405,91 @@ void imlib_mode_filter(image_t *img, const int ksize, bool threshold, int offset
 #endif // IMLIB_ENABLE_MODE
 
 #ifdef IMLIB_ENABLE_MIDPOINT
+// Unmasked GRAYSCALE midpoint filter. The min/max of each column of the window is computed with
+// vector min/max ops into line buffers that are padded with ksize replicated pixels on each side,
+// then the horizontal min/max is taken from the line buffers without any boundary checks.
+static void imlib_midpoint_filter_grayscale_simd(image_t *img, const int ksize, const uint8_t *u8BiasTable,
+                                                 bool threshold, int offset, bool invert) {
+    int brows = ksize + 1;
+    image_t buf = {};
+    buf.w = img->w;
+    buf.h = brows;
+    buf.pixfmt = img->pixfmt;
+    buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
+
+    int padded_w = img->w + (ksize * 2);
+    uint8_t *col_min = fb_alloc(padded_w * 2, FB_ALLOC_PREFER_SPEED | FB_ALLOC_CACHE_ALIGN);
+    uint8_t *col_max = col_min + padded_w;
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+        uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
+
+        for (int x = 0, xx = img->w; x < xx; x += UINT8_VECTOR_SIZE) {
+            v128_predicate_t pred = vpredicate_8(xx - x);
+            v128_t min = vldr_u8_pred(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, IM_MAX(y - ksize, 0)) + x, pred);
+            v128_t max = min;
+
+            for (int j = -ksize + 1; j <= ksize; j++) {
+                int y_j = IM_CLAMP(y + j, 0, (yy - 1));
+                v128_t pixels = vldr_u8_pred(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y_j) + x, pred);
+                min = vmin_u8(min, pixels);
+                max = vmax_u8(max, pixels);
+            }
+
+            vstr_u8_pred(col_min + ksize + x, min, pred);
+            vstr_u8_pred(col_max + ksize + x, max, pred);
+        }
+
+        // Replicate the edge columns into the padding.
+        memset(col_min, col_min[ksize], ksize);
+        memset(col_max, col_max[ksize], ksize);
+        memset(col_min + ksize + img->w, col_min[ksize + img->w - 1], ksize);
+        memset(col_max + ksize + img->w, col_max[ksize + img->w - 1], ksize);
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            int min = COLOR_GRAYSCALE_MAX, max = COLOR_GRAYSCALE_MIN;
+
+            for (int k = x, kk = x + (ksize * 2); k <= kk; k++) {
+                min = IM_MIN(min, col_min[k]);
+                max = IM_MAX(max, col_max[k]);
+            }
+
+            int pixel = min + u8BiasTable[max - min];
+
+            if (threshold) {
+                if (((pixel - offset) < IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x)) ^ invert) {
+                    pixel = COLOR_GRAYSCALE_BINARY_MAX;
+                } else {
+                    pixel = COLOR_GRAYSCALE_BINARY_MIN;
+                }
+            }
+
+            IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
+        }
+
+        if (y >= ksize) {
+            // Transfer buffer lines...
+            memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, (y - ksize)),
+                   IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, ((y - ksize) % brows)),
+                   IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
+        }
+    }
+
+    // Copy any remaining lines from the buffer image...
+    for (int y = IM_MAX(img->h - ksize, 0), yy = img->h; y < yy; y++) {
+        memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y),
+               IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows)),
+               IMAGE_GRAYSCALE_LINE_LEN_BYTES(img));
+    }
+
+    fb_free(); // col_min/col_max
+    fb_free(); // buf
+}
+
 void imlib_midpoint_filter(image_t *img, const int ksize, float bias, bool threshold, int offset, bool invert, image_t *mask) {
     int brows = ksize + 1;
-    image_t buf;
+    image_t buf = {};
     buf.w = img->w;
     buf.h = brows;
     buf.pixfmt = img->pixfmt;
@@ -1046,6 +1572,11 @@ void imlib_midpoint_filter(image_t *img, const int ksize, float bias, bool thres
             break;
         }
         case PIXFORMAT_GRAYSCALE: {
+            if (!mask) {
+                imlib_midpoint_filter_grayscale_simd(img, ksize, u8BiasTable, threshold, offset, invert);
+                break;
+            }
+
             buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
 
             for (int y = 0, yy = img->h; y < yy; y++) {
@@ -1233,6 +1764,254 @@ void imlib_midpoint_filter(image_t *img, const int ksize, float bias, bool thres
 }
 #endif // IMLIB_ENABLE_MIDPOINT
 
+// Splits the kernel into the outer product of a column and a row vector. Returns false if the
+// kernel is not rank-1 with integer factors, or if the column pass could overflow 16-bits for
+// channels of up to max.
+static bool imlib_morph_factor(const int *krn, int n, int max, int16_t *krn_col, int16_t *krn_row) {
+    int pivot = 0, gcd = 0, col_sum = 0;
+
+    while ((pivot < (n * n)) && (!krn[pivot])) {
+        pivot += 1;
+    }
+
+    if (pivot == (n * n)) {
+        return false;
+    }
+
+    // The row vector is the first non-zero row reduced by its gcd.
+    const int *pivot_row = krn + ((pivot / n) * n);
+    int pivot_x = pivot % n;
+
+    for (int k = 0; k < n; k++) {
+        for (int a = abs(pivot_row[k]); a; ) {
+            int t = gcd % a;
+            gcd = a;
+            a = t;
+        }
+    }
+
+    for (int k = 0; k < n; k++) {
+        int r = pivot_row[k] / gcd;
+
+        if ((r < INT16_MIN) || (r > INT16_MAX)) {
+            return false;
+        }
+
+        krn_row[k] = r;
+    }
+
+    for (int j = 0; j < n; j++) {
+        int c = krn[(j * n) + pivot_x] / krn_row[pivot_x];
+        col_sum += abs(c);
+
+        if ((col_sum * max) > INT16_MAX) {
+            return false;
+        }
+
+        for (int k = 0; k < n; k++) {
+            if (krn[(j * n) + k] != (c * krn_row[k])) {
+                return false;
+            }
+        }
+
+        krn_col[j] = c;
+    }
+
+    return true;
+}
+
+// Column pass of a separable kernel, line[x] = sum(krn_col[j] * rows[j][x]).
+static void imlib_morph_sep_cols(int16_t *line, uint8_t **rows, const int16_t *krn_col, int n, int w) {
+    for (int x = 0; x < w; x += INT16_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_16(w - x);
+        v128_t acc = vmul_n_s16(vldr_u8_widen_u16_pred(rows[0] + x, pred), krn_col[0]);
+
+        for (int j = 1; j < n; j++) {
+            acc = vmla_n_s16(vldr_u8_widen_u16_pred(rows[j] + x, pred), krn_col[j], acc);
+        }
+
+        vstr_u16_pred((uint16_t *) (line + x), acc, pred);
+    }
+}
+
+static void imlib_morph_sep_cols_rgb565(int16_t *r_line, int16_t *g_line, int16_t *b_line,
+                                        uint8_t **rows, const int16_t *krn_col, int n, int w) {
+    v128_t g_mask = vdup_u16(0x3f);
+    v128_t b_mask = vdup_u16(0x1f);
+
+    for (int x = 0; x < w; x += INT16_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_16(w - x);
+        v128_t r_acc = vdup_u16(0), g_acc = vdup_u16(0), b_acc = vdup_u16(0);
+
+        for (int j = 0; j < n; j++) {
+            v128_t pixels = vldr_u16_pred(((uint16_t *) rows[j]) + x, pred);
+            r_acc = vmla_n_s16(vlsr_u16(pixels, 11), krn_col[j], r_acc);
+            g_acc = vmla_n_s16(vand_u32(vlsr_u16(pixels, 5), g_mask), krn_col[j], g_acc);
+            b_acc = vmla_n_s16(vand_u32(pixels, b_mask), krn_col[j], b_acc);
+        }
+
+        vstr_u16_pred((uint16_t *) (r_line + x), r_acc, pred);
+        vstr_u16_pred((uint16_t *) (g_line + x), g_acc, pred);
+        vstr_u16_pred((uint16_t *) (b_line + x), b_acc, pred);
+    }
+}
+
+// Row pass of a separable kernel at one pixel, krn_row is zero padded to the vector size.
+static inline int32_t imlib_morph_sep_row(const int16_t *line, const int16_t *krn_row, int n) {
+    // 3x3 kernels are the common case, their 3 taps are cheaper without the padding.
+    if (n == 3) {
+        return (line[0] * krn_row[0]) + (line[1] * krn_row[1]) + (line[2] * krn_row[2]);
+    }
+
+    int32_t acc = 0;
+
+    for (int k = 0; k < n; k += INT16_VECTOR_SIZE) {
+        acc = vmladava_s16(vldr_u16((const uint16_t *) (line + k)), vldr_u16((const uint16_t *) (krn_row + k)), acc);
+    }
+
+    return acc;
+}
+
+// GRAYSCALE/RGB565 morph for separable kernels (gaussian, sobel, box, etc). The column vector is
+// applied with vector multiply-accumulates into a 16-bit line per channel and then the row vector
+// is applied across the line with dot products, so the cost per pixel is O(ksize) instead of
+// O(ksize^2). The sums are the same as the 2D kernel's, so the output is identical. Returns false
+// if the kernel is not separable.
+static bool imlib_morph_separable(image_t *img, const int ksize, const int *krn, int32_t m_int, int32_t b_int,
+                                  bool threshold, int offset, bool invert, image_t *mask) {
+    if ((img->pixfmt != PIXFORMAT_GRAYSCALE) && (img->pixfmt != PIXFORMAT_RGB565)) {
+        return false;
+    }
+
+    #if defined(ARM_MATH_DSP)
+    // The unmasked 3x3 grayscale kernel has its own SIMD path.
+    if ((img->pixfmt == PIXFORMAT_GRAYSCALE) && (ksize == 1) && (!mask)) {
+        return false;
+    }
+    #endif
+
+    int n = (ksize * 2) + 1;
+    int n_pad = (n + INT16_VECTOR_SIZE - 1) & ~(INT16_VECTOR_SIZE - 1);
+    int channels = (img->pixfmt == PIXFORMAT_RGB565) ? 3 : 1;
+
+    fb_alloc_mark();
+    int16_t *krn_col = fb_alloc(n * sizeof(int16_t), FB_ALLOC_NO_HINT);
+    int16_t *krn_row = fb_alloc0(n_pad * sizeof(int16_t), FB_ALLOC_NO_HINT);
+
+    if (!imlib_morph_factor(krn, n, (channels == 3) ? COLOR_G6_MAX : COLOR_GRAYSCALE_MAX, krn_col, krn_row)) {
+        fb_alloc_free_till_mark();
+        return false;
+    }
+
+    int brows = ksize + 1;
+    image_t buf = {};
+    buf.w = img->w;
+    buf.h = brows;
+    buf.pixfmt = img->pixfmt;
+    size_t line_size = image_line_size(img);
+    size_t row_stride = image_row_stride(img);
+    buf.data = fb_alloc(line_size * brows, FB_ALLOC_PREFER_TCM);
+
+    // The lines are padded on the left by ksize and on the right by ksize plus the row vector
+    // padding. The edges are clamped like the 2D kernel.
+    int stride = img->w + (ksize * 2) + n_pad;
+    int16_t *lines = fb_alloc0(stride * channels * sizeof(int16_t), FB_ALLOC_PREFER_TCM);
+    int16_t *r_line = lines, *g_line = lines + stride, *b_line = lines + (stride * 2);
+    uint8_t **rows = fb_alloc(n * sizeof(uint8_t *), FB_ALLOC_NO_HINT);
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        for (int j = 0; j < n; j++) {
+            rows[j] = img->data + (row_stride * IM_CLAMP(y + j - ksize, 0, (yy - 1)));
+        }
+
+        if (channels == 1) {
+            imlib_morph_sep_cols(r_line + ksize, rows, krn_col, n, img->w);
+        } else {
+            imlib_morph_sep_cols_rgb565(r_line + ksize, g_line + ksize, b_line + ksize, rows, krn_col, n, img->w);
+        }
+
+        for (int c = 0; c < channels; c++) {
+            int16_t *line = lines + (stride * c) + ksize;
+
+            for (int k = 1; k <= ksize; k++) {
+                line[-k] = line[0];
+                line[img->w - 1 + k] = line[img->w - 1];
+            }
+        }
+
+        if (channels == 1) {
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+            uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % brows));
+
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                    int p = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, p);
+                    continue; // Short circuit.
+                }
+
+                int32_t tmp = (imlib_morph_sep_row(r_line + x, krn_row, n) * m_int) + b_int;
+                int pixel = __USAT_ASR(tmp, 8, 16);
+
+                if (threshold) {
+                    pixel -= offset;
+                    pixel = pixel < IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                    pixel = (pixel ^ invert) * COLOR_GRAYSCALE_BINARY_MAX;
+                }
+
+                IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, x, pixel);
+            }
+        } else {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+            uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
+
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                    int p = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
+                    IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, p);
+                    continue; // Short circuit.
+                }
+
+                int32_t r_tmp = (imlib_morph_sep_row(r_line + x, krn_row, n) * m_int) + b_int;
+                int r_pixel = __USAT_ASR(r_tmp, 5, 16);
+
+                int32_t g_tmp = (imlib_morph_sep_row(g_line + x, krn_row, n) * m_int) + b_int;
+                int g_pixel = __USAT_ASR(g_tmp, 6, 16);
+
+                int32_t b_tmp = (imlib_morph_sep_row(b_line + x, krn_row, n) * m_int) + b_int;
+                int b_pixel = __USAT_ASR(b_tmp, 5, 16);
+
+                int pixel = COLOR_R5_G6_B5_TO_RGB565(r_pixel, g_pixel, b_pixel);
+
+                if (threshold) {
+                    pixel = COLOR_RGB565_TO_Y(pixel) - offset;
+                    pixel = pixel < COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                    pixel = (pixel ^ invert) * COLOR_RGB565_BINARY_MAX;
+                }
+
+                IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
+            }
+        }
+
+        if (y >= ksize) {
+            // Transfer buffer lines...
+            memcpy(img->data + (row_stride * (y - ksize)),
+                   buf.data + (line_size * ((y - ksize) % brows)),
+                   line_size);
+        }
+    }
+
+    // Copy any remaining lines from the buffer image...
+    for (int y = IM_MAX(img->h - ksize, 0), yy = img->h; y < yy; y++) {
+        memcpy(img->data + (row_stride * y),
+               buf.data + (line_size * (y % brows)),
+               line_size);
+    }
+
+    fb_alloc_free_till_mark();
+    return true;
+}
+
 // http://www.fmwconcepts.com/imagemagick/digital_image_filtering.pdf
 
 void imlib_morph(image_t *img,
@@ -1245,7 +2024,7 @@ void imlib_morph(image_t *img,
                  bool invert,
                  image_t *mask) {
     int brows = ksize + 1;
-    image_t buf;
+    image_t buf = {};
     buf.w = img->w;
     buf.h = brows;
     buf.pixfmt = img->pixfmt;
@@ -1253,6 +2032,10 @@ void imlib_morph(image_t *img,
     const int32_t b_int = fast_roundf(65536 * b);
     invert = invert ? 1 : 0; // ensure binary
 
+    if (imlib_morph_separable(img, ksize, krn, m_int, b_int, threshold, offset, invert, mask)) {
+        return;
+    }
+
     switch (img->pixfmt) {
         case PIXFORMAT_BINARY: {
             buf.data = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(img) * brows, FB_ALLOC_NO_HINT);
@@ -1770,7 +2553,7 @@ void imlib_bilateral_filter(image_t *img,
                             bool invert,
                             image_t *mask) {
     int brows = ksize + 1;
-    image_t buf;
+    image_t buf = {};
     buf.w = img->w;
     buf.h = brows;
     buf.pixfmt = img->pixfmt;
@@ -2077,4 +2860,161 @@ void imlib_bilateral_filter(image_t *img,
         }
     }
 }
+
+// Bilateral grid (Chen, Paris and Durand), the image is splatted into a grid of cells of
+// cell_size pixels by range_size intensity levels, blurred with a [1 2 1] kernel along each
+// axis and sliced back with trilinear interpolation. The cost doesn't depend on the kernel size.
+#define BILATERAL_GRID_MAX_CELL     (32) // Keeps the blurred sums (x64) interpolated in Q8 within 32-bits.
+#define BILATERAL_GRID_MAX_LEVELS   (32)
+
+static void bilateral_grid_blur(uint32_t *line, int n, int stride, int channels) {
+    for (int c = 0; c < channels; c++) {
+        uint32_t prev = 0;
+        for (int i = 0; i < n; i++) {
+            uint32_t *p = line + (i * stride) + c;
+            uint32_t curr = *p;
+            uint32_t next = (i < (n - 1)) ? p[stride] : 0;
+            *p = prev + (curr * 2) + next;
+            prev = curr;
+        }
+    }
+}
+
+static inline uint32_t bilateral_grid_lerp(uint32_t a, uint32_t b, int t) {
+    return ((a * (256 - t)) + (b * t)) >> 8;
+}
+
+void imlib_bilateral_grid(image_t *img,
+                          const int ksize,
+                          float color_sigma,
+                          float space_sigma,
+                          bool threshold,
+                          int offset,
+                          bool invert,
+                          image_t *mask) {
+    if (img->pixfmt == PIXFORMAT_BINARY) {
+        // There are only two intensity levels, the grid doesn't save anything.
+        imlib_bilateral_filter(img, ksize, color_sigma, space_sigma, threshold, offset, invert, mask);
+        return;
+    }
+
+    // RGB565 images use their luma as the range of the grid, a single grid for all channels.
+    int channels = (img->pixfmt == PIXFORMAT_RGB565) ? 4 : 2; // Sums and the weight.
+    int cell_size = IM_CLAMP(fast_roundf(ksize * space_sigma), 1, BILATERAL_GRID_MAX_CELL);
+    int range_size = IM_MAX(fast_roundf(color_sigma * COLOR_GRAYSCALE_MAX),
+                            (COLOR_GRAYSCALE_MAX / BILATERAL_GRID_MAX_LEVELS) + 1);
+
+    // Pixels are splatted to the nearest cell and sliced from the cells around them.
+    int gw = ((img->w - 1) / cell_size) + 2;
+    int gh = ((img->h - 1) / cell_size) + 2;
+    int gd = (COLOR_GRAYSCALE_MAX / range_size) + 2;
+    int x_stride = gd * channels;
+    int y_stride = gw * x_stride;
+    uint32_t *grid = fb_alloc0(gh * y_stride * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        uint32_t *grid_row = grid + (((y + (cell_size / 2)) / cell_size) * y_stride);
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            uint32_t *cell = grid_row + (((x + (cell_size / 2)) / cell_size) * x_stride);
+            if (img->pixfmt == PIXFORMAT_GRAYSCALE) {
+                int pixel = IMAGE_GET_GRAYSCALE_PIXEL(img, x, y);
+                cell += ((pixel + (range_size / 2)) / range_size) * channels;
+                cell[0] += pixel;
+            } else {
+                int pixel = IMAGE_GET_RGB565_PIXEL(img, x, y);
+                cell += ((COLOR_RGB565_TO_Y(pixel) + (range_size / 2)) / range_size) * channels;
+                cell[0] += COLOR_RGB565_TO_R5(pixel);
+                cell[1] += COLOR_RGB565_TO_G6(pixel);
+                cell[2] += COLOR_RGB565_TO_B5(pixel);
+            }
+            cell[channels - 1] += 1;
+        }
+    }
+
+    for (int i = 0; i < (gw * gh); i++) {
+        bilateral_grid_blur(grid + (i * x_stride), gd, channels, channels);
+    }
+
+    for (int y = 0; y < gh; y++) {
+        for (int z = 0; z < gd; z++) {
+            bilateral_grid_blur(grid + (y * y_stride) + (z * channels), gw, x_stride, channels);
+        }
+    }
+
+    for (int x = 0; x < gw; x++) {
+        for (int z = 0; z < gd; z++) {
+            bilateral_grid_blur(grid + (x * x_stride) + (z * channels), gh, y_stride, channels);
+        }
+    }
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        int y_q8 = (y << 8) / cell_size, fy = y_q8 & 0xff;
+        uint32_t *grid_row = grid + ((y_q8 >> 8) * y_stride);
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                continue; // Short circuit.
+            }
+
+            int x_q8 = (x << 8) / cell_size, fx = x_q8 & 0xff;
+            int old_pixel, range;
+
+            if (img->pixfmt == PIXFORMAT_GRAYSCALE) {
+                old_pixel = range = IMAGE_GET_GRAYSCALE_PIXEL(img, x, y);
+            } else {
+                old_pixel = IMAGE_GET_RGB565_PIXEL(img, x, y);
+                range = COLOR_RGB565_TO_Y(old_pixel);
+            }
+
+            int z_q8 = (range << 8) / range_size, fz = z_q8 & 0xff;
+            uint32_t *c00 = grid_row + ((x_q8 >> 8) * x_stride) + ((z_q8 >> 8) * channels);
+            uint32_t *c01 = c00 + x_stride, *c10 = c00 + y_stride, *c11 = c10 + x_stride;
+            uint32_t acc[4];
+
+            for (int c = 0; c < channels; c++) {
+                uint32_t v00 = bilateral_grid_lerp(c00[c], c00[c + channels], fz);
+                uint32_t v01 = bilateral_grid_lerp(c01[c], c01[c + channels], fz);
+                uint32_t v10 = bilateral_grid_lerp(c10[c], c10[c + channels], fz);
+                uint32_t v11 = bilateral_grid_lerp(c11[c], c11[c + channels], fz);
+                acc[c] = bilateral_grid_lerp(bilateral_grid_lerp(v00, v01, fx), bilateral_grid_lerp(v10, v11, fx), fy);
+            }
+
+            uint32_t w = acc[channels - 1];
+
+            if (img->pixfmt == PIXFORMAT_GRAYSCALE) {
+                int pixel = w ? IM_MIN((acc[0] + (w / 2)) / w, (uint32_t) COLOR_GRAYSCALE_MAX) : old_pixel;
+
+                if (threshold) {
+                    if (((pixel - offset) < old_pixel) ^ invert) {
+                        pixel = COLOR_GRAYSCALE_BINARY_MAX;
+                    } else {
+                        pixel = COLOR_GRAYSCALE_BINARY_MIN;
+                    }
+                }
+
+                IMAGE_PUT_GRAYSCALE_PIXEL(img, x, y, pixel);
+            } else {
+                int pixel = old_pixel;
+
+                if (w) {
+                    pixel = COLOR_R5_G6_B5_TO_RGB565(IM_MIN((acc[0] + (w / 2)) / w, (uint32_t) COLOR_R5_MAX),
+                                                     IM_MIN((acc[1] + (w / 2)) / w, (uint32_t) COLOR_G6_MAX),
+                                                     IM_MIN((acc[2] + (w / 2)) / w, (uint32_t) COLOR_B5_MAX));
+                }
+
+                if (threshold) {
+                    if (((COLOR_RGB565_TO_Y(pixel) - offset) < range) ^ invert) {
+                        pixel = COLOR_RGB565_BINARY_MAX;
+                    } else {
+                        pixel = COLOR_RGB565_BINARY_MIN;
+                    }
+                }
+
+                IMAGE_PUT_RGB565_PIXEL(img, x, y, pixel);
+            }
+        }
+    }
+
+    fb_free();
+}
 #endif // IMLIB_ENABLE_BILATERAL
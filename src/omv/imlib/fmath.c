@@ -9,6 +9,10 @@
  * Fast approximate math functions.
  */
 #include "fmath.h"
+#if (__ARM_ARCH >= 8) && (__ARM_FEATURE_MVE & 2)
+#include <arm_mve.h>
+#define FMATH_MVE_ENABLED   (1)
+#endif
 
 const float __atanf_lut[4] = {
     -0.0443265554792128f,    //p7
@@ -114,7 +118,7 @@ float fast_atan2f(float y, float x) {
         return 2 * M_PI - fast_atanf(-y / x);
     }
 
-    return (y == 0) ? 0 : ((y > 0) ? M_PI : -M_PI);
+    return (y == 0) ? 0 : ((y > 0) ? (M_PI * 0.5) : (M_PI * 1.5));
 }
 
 float fast_log2(float x) {
@@ -164,3 +168,138 @@ void fast_get_min_max(float *data, size_t data_len, float *p_min, float *p_max)
     *p_min = min;
     *p_max = max;
 }
+
+#if defined(FMATH_MVE_ENABLED)
+// There's no vector divide, the reciprocal starts from an exponent estimate and is refined with
+// Newton-Raphson steps, each one doubles the number of correct bits.
+static inline float32x4_t fast_recipf_m(float32x4_t x) {
+    float32x4_t r = vreinterpretq_f32_s32(vsubq_s32(vdupq_n_s32(0x7EF311C7), vreinterpretq_s32_f32(x)));
+    r = vmulq_f32(r, vfmsq_f32(vdupq_n_f32(2.0f), x, r));
+    r = vmulq_f32(r, vfmsq_f32(vdupq_n_f32(2.0f), x, r));
+    return vmulq_f32(r, vfmsq_f32(vdupq_n_f32(2.0f), x, r));
+}
+#endif
+
+void fast_atan2f_v(const float *y, const float *x, float *out, size_t n) {
+    #if defined(FMATH_MVE_ENABLED)
+    // Same range as fast_atan2f(), [0, 2 * PI). The angle is found from atan(min / max) in the
+    // first octant which is then mirrored to the octant of (x, y).
+    for (; n > 0; n -= ((n < 4) ? n : 4), x += 4, y += 4, out += 4) {
+        mve_pred16_t pred = vctp32q(n);
+        float32x4_t vx = vld1q_z_f32(x, pred);
+        float32x4_t vy = vld1q_z_f32(y, pred);
+        float32x4_t ax = vabsq_f32(vx);
+        float32x4_t ay = vabsq_f32(vy);
+        float32x4_t mn = vminnmq_f32(ax, ay);
+        float32x4_t mx = vmaxnmq_f32(ax, ay);
+        mx = vpselq_f32(vdupq_n_f32(1.0f), mx, vcmpeqq_n_f32(mx, 0.0f));
+
+        // Range reduction around tan(PI / 8).
+        float32x4_t t = vmulq_f32(mn, fast_recipf_m(mx));
+        mve_pred16_t big = vcmpgtq_n_f32(t, 0.4142135623730950f);
+        float32x4_t u = vmulq_f32(vsubq_f32(t, vdupq_n_f32(1.0f)), fast_recipf_m(vaddq_f32(t, vdupq_n_f32(1.0f))));
+        t = vpselq_f32(u, t, big);
+
+        float32x4_t z = vmulq_f32(t, t);
+        float32x4_t p = vfmaq_f32(vdupq_n_f32(-1.38776856032E-1f), z, vdupq_n_f32(8.05374449538e-2f));
+        p = vfmaq_f32(vdupq_n_f32(1.99777106478E-1f), z, p);
+        p = vfmaq_f32(vdupq_n_f32(-3.33329491539E-1f), z, p);
+        float32x4_t a = vfmaq_f32(t, vmulq_f32(z, t), p);
+        a = vaddq_f32(a, vpselq_f32(vdupq_n_f32(M_PI_4), vdupq_n_f32(0.0f), big));
+
+        a = vpselq_f32(vsubq_f32(vdupq_n_f32(M_PI_2), a), a, vcmpgtq_f32(ay, ax));
+        a = vpselq_f32(vsubq_f32(vdupq_n_f32(M_PI), a), a, vcmpltq_n_f32(vx, 0.0f));
+        a = vpselq_f32(vsubq_f32(vdupq_n_f32(M_PI * 2), a), a, vcmpltq_n_f32(vy, 0.0f));
+        vst1q_p_f32(out, a, pred);
+    }
+    #else
+    for (size_t i = 0; i < n; i++) {
+        out[i] = fast_atan2f(y[i], x[i]);
+    }
+    #endif
+}
+
+void fast_expf_v(const float *x, float *out, size_t n) {
+    #if defined(FMATH_MVE_ENABLED)
+    for (; n > 0; n -= ((n < 4) ? n : 4), x += 4, out += 4) {
+        mve_pred16_t pred = vctp32q(n);
+        float32x4_t vx = vld1q_z_f32(x, pred);
+        uint32x4_t l = vcvtq_u32_f32(vfmaq_f32(vdupq_n_f32(1072632447), vx, vdupq_n_f32(1512775)));
+        // Repack the binary64 fields into binary32, see fast_expf().
+        uint32x4_t e = vandq_u32(vsubq_u32(vshrq_n_u32(l, 20), vdupq_n_u32(1023 - 127)), vdupq_n_u32(0xFF));
+        uint32x4_t r = vandq_u32(l, vdupq_n_u32(0x80000000));
+        r = vorrq_u32(r, vshlq_n_u32(e, 23));
+        r = vorrq_u32(r, vshlq_n_u32(vandq_u32(l, vdupq_n_u32(0xFFFFF)), 3));
+        vst1q_p_f32(out, vreinterpretq_f32_u32(r), pred);
+    }
+    #else
+    for (size_t i = 0; i < n; i++) {
+        out[i] = fast_expf(x[i]);
+    }
+    #endif
+}
+
+void fast_log2_v(const float *x, float *out, size_t n) {
+    #if defined(FMATH_MVE_ENABLED)
+    for (; n > 0; n -= ((n < 4) ? n : 4), x += 4, out += 4) {
+        mve_pred16_t pred = vctp32q(n);
+        uint32x4_t vx = vreinterpretq_u32_f32(vld1q_z_f32(x, pred));
+        float32x4_t mx = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vx, vdupq_n_u32(0x007FFFFF)),
+                                                         vdupq_n_u32(0x3f000000)));
+        float32x4_t y = vmulq_n_f32(vcvtq_f32_u32(vx), 1.1920928955078125e-7f);
+        y = vsubq_f32(y, vdupq_n_f32(124.22551499f));
+        y = vfmsq_f32(y, vdupq_n_f32(1.498030302f), mx);
+        y = vfmsq_f32(y, vdupq_n_f32(1.72587999f), fast_recipf_m(vaddq_f32(vdupq_n_f32(0.3520887068f), mx)));
+        vst1q_p_f32(out, y, pred);
+    }
+    #else
+    for (size_t i = 0; i < n; i++) {
+        out[i] = fast_log2(x[i]);
+    }
+    #endif
+}
+
+void fast_powf_v(const float *a, float b, float *out, size_t n) {
+    #if defined(FMATH_MVE_ENABLED)
+    for (; n > 0; n -= ((n < 4) ? n : 4), a += 4, out += 4) {
+        mve_pred16_t pred = vctp32q(n);
+        int32x4_t va = vreinterpretq_s32_f32(vld1q_z_f32(a, pred));
+        float32x4_t d = vcvtq_f32_s32(vsubq_s32(va, vdupq_n_s32(1064866805)));
+        int32x4_t r = vcvtq_s32_f32(vfmaq_f32(vdupq_n_f32(1064866805), d, vdupq_n_f32(b)));
+        vst1q_p_f32(out, vreinterpretq_f32_s32(r), pred);
+    }
+    #else
+    for (size_t i = 0; i < n; i++) {
+        out[i] = fast_powf(a[i], b);
+    }
+    #endif
+}
+
+void fast_atan2_q15_v(const q15_t *y, const q15_t *x, q15_t *out, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        int32_t ax = (x[i] < 0) ? -x[i] : x[i];
+        int32_t ay = (y[i] < 0) ? -y[i] : y[i];
+        int32_t mn = (ax < ay) ? ax : ay;
+        int32_t mx = (ax < ay) ? ay : ax;
+
+        // With z = min / max, atan(z) / PI ~= (z / 4) + (z * (1 - z) * (0.0779 + (0.0211 * z))),
+        // the error is under 0.1 degrees.
+        int32_t z = mx ? ((mn << 15) / mx) : 0;
+        int32_t a = (z >> 2) + ((((z * (32768 - z)) >> 15) * (2552 + ((691 * z) >> 15))) >> 15);
+
+        if (ay > ax) {
+            a = 16384 - a;
+        }
+
+        if (x[i] < 0) {
+            a = 32768 - a;
+        }
+
+        if (y[i] < 0) {
+            a = -a;
+        }
+
+        // PI wraps to -PI.
+        out[i] = (int16_t) a;
+    }
+}
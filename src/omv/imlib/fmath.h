@@ -25,6 +25,15 @@ float fast_log2(float x);
 float fast_powf(float a, float b);
 void fast_get_min_max(float *data, size_t data_len, float *p_min, float *p_max);
 
+// Array versions of the above, vectorized with Helium when available. The out array may be
+// the same as an input array.
+void fast_atan2f_v(const float *y, const float *x, float *out, size_t n);
+void fast_expf_v(const float *x, float *out, size_t n);
+void fast_log2_v(const float *x, float *out, size_t n);
+void fast_powf_v(const float *a, float b, float *out, size_t n);
+// Fixed-point atan2, the angle is returned in q15 units of PI ([-PI, PI)).
+void fast_atan2_q15_v(const q15_t *y, const q15_t *x, q15_t *out, size_t n);
+
 static inline float fast_sqrtf(float x) {
     #if (__ARM_ARCH >= 7)
     __asm__ volatile (
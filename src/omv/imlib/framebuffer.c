@@ -9,6 +9,7 @@
  * Framebuffer functions.
  */
 #include <stdio.h>
+#include "py/mphal.h"
 #include "mpprint.h"
 #include "fmath.h"
 #include "framebuffer.h"
@@ -18,6 +19,16 @@
 #define FB_ALIGN_SIZE_ROUND_UP(x)   FB_ALIGN_SIZE_ROUND_DOWN(((x) + FRAMEBUFFER_ALIGNMENT - 1))
 #define OMV_JPEG_BUFFER_SIZE_MAX    ((&_jpeg_memory_end - &_jpeg_memory_start) - sizeof(jpegbuffer_t))
 
+// Adaptive preview limits.
+#define PREVIEW_MAX_SCALE           (3)     // Down-scale by up to 8x.
+#define PREVIEW_MAX_SKIP            (15)    // Preview at least every 16th frame.
+#define PREVIEW_MIN_SIZE            (32)    // Don't down-scale below this width/height.
+
+// The framebuffer memory needs no cache maintenance if the MPU maps it non-cacheable.
+#if defined(__DCACHE_PRESENT) && (!defined(OMV_FB_NO_CACHE))
+#define FB_DCACHE_ENABLED           (1)
+#endif
+
 extern char _fb_memory_start;
 extern char _fb_memory_end;
 framebuffer_t *framebuffer = (framebuffer_t *) &_fb_memory_start;
@@ -34,6 +45,19 @@ bool fb_get_streaming_enabled() {
     return framebuffer->streaming_enabled;
 }
 
+void fb_set_preview_budget(uint32_t percent) {
+    jpeg_framebuffer->budget = OMV_MIN(percent, 100U);
+    jpeg_framebuffer->scale = 0;
+    jpeg_framebuffer->skip = 0;
+    jpeg_framebuffer->skipped = 0;
+    jpeg_framebuffer->frame_ticks = 0;
+    jpeg_framebuffer->frame_us = 0;
+}
+
+uint32_t fb_get_preview_budget() {
+    return jpeg_framebuffer->budget;
+}
+
 int fb_encode_for_ide_new_size(image_t *img) {
     return (((img->size * 8) + 5) / 6) + 2;
 }
@@ -81,7 +105,8 @@ void framebuffer_init0() {
     memset(MAIN_FB(), 0, sizeof(*MAIN_FB()));
     memset(JPEG_FB(), 0, sizeof(*JPEG_FB()));
 
-    mutex_init0(&JPEG_FB()->lock);
+    JPEG_FB()->ready = JPEGBUFFER_NO_SLOT;
+    JPEG_FB()->reading = JPEGBUFFER_NO_SLOT;
 
     // Enable streaming.
     MAIN_FB()->streaming_enabled = true; // controlled by the OpenMV Cam.
@@ -103,6 +128,7 @@ void framebuffer_init_image(image_t *img) {
         img->size = framebuffer->size;
         img->pixfmt = framebuffer->pixfmt;
         img->pixels = framebuffer_get_buffer(framebuffer->head)->data;
+        img->stride = 0;
     }
 }
 
@@ -113,43 +139,143 @@ void framebuffer_init_from_image(image_t *img) {
     framebuffer->pixfmt = img->pixfmt;
 }
 
-static void jpegbuffer_init_from_image(image_t *img) {
-    if (img == NULL) {
-        jpeg_framebuffer->w = 0;
-        jpeg_framebuffer->h = 0;
-        jpeg_framebuffer->size = 0;
-    } else {
-        jpeg_framebuffer->w = img->w;
-        jpeg_framebuffer->h = img->h;
-        jpeg_framebuffer->size = img->size;
+// Returns the slot to encode the next frame to and the space available for it, which is
+// all of the buffer, or the larger space before or after the frame being read by the IDE.
+static jpegbuffer_slot_t *jpegbuffer_get_free_slot(uint32_t *max_size) {
+    int32_t reading = jpeg_framebuffer->reading;
+    jpegbuffer_slot_t *slot = &jpeg_framebuffer->slots[(reading == 0) ? 1 : 0];
+
+    slot->offset = 0;
+    *max_size = OMV_JPEG_BUFFER_SIZE_MAX;
+
+    if (reading != JPEGBUFFER_NO_SLOT) {
+        jpegbuffer_slot_t *busy = &jpeg_framebuffer->slots[reading];
+        uint32_t busy_end = FB_ALIGN_SIZE_ROUND_UP(busy->offset + busy->size);
+        uint32_t after = (busy_end < OMV_JPEG_BUFFER_SIZE_MAX) ? (OMV_JPEG_BUFFER_SIZE_MAX - busy_end) : 0;
+        if (after > busy->offset) {
+            slot->offset = busy_end;
+            *max_size = after;
+        } else {
+            *max_size = busy->offset;
+        }
+    }
+
+    return slot;
+}
+
+static void jpegbuffer_publish(jpegbuffer_slot_t *slot, image_t *img) {
+    slot->w = img->w;
+    slot->h = img->h;
+    slot->size = img->size;
+    slot->pixfmt = img->pixfmt;
+    slot->seq = ++jpeg_framebuffer->seq;
+    slot->ticks_us = mp_hal_ticks_us();
+    // Make sure the frame is written before it's published.
+    __DMB();
+    jpeg_framebuffer->ready = slot - jpeg_framebuffer->slots;
+}
+
+jpegbuffer_slot_t *jpegbuffer_acquire() {
+    int32_t ready = jpeg_framebuffer->ready;
+
+    if ((jpeg_framebuffer->reading != JPEGBUFFER_NO_SLOT) || (ready == JPEGBUFFER_NO_SLOT)) {
+        return NULL;
+    }
+
+    jpeg_framebuffer->reading = ready;
+    jpeg_framebuffer->acquire_ticks = mp_hal_ticks_us();
+    __DMB();
+    // The script can encode the next frame now.
+    jpeg_framebuffer->ready = JPEGBUFFER_NO_SLOT;
+    return &jpeg_framebuffer->slots[ready];
+}
+
+void jpegbuffer_release() {
+    if (jpeg_framebuffer->reading != JPEGBUFFER_NO_SLOT) {
+        jpeg_framebuffer->drain_us = mp_hal_ticks_us() - jpeg_framebuffer->acquire_ticks;
+    }
+    __DMB();
+    jpeg_framebuffer->reading = JPEGBUFFER_NO_SLOT;
+}
+
+// Returns true if a preview frame should be encoded for this frame.
+static bool jpegbuffer_preview_frame() {
+    if (!jpeg_framebuffer->budget) {
+        return true;
+    }
+
+    uint32_t ticks = mp_hal_ticks_us();
+    uint32_t elapsed = ticks - jpeg_framebuffer->frame_ticks;
+
+    if (jpeg_framebuffer->frame_ticks) {
+        // Running average of the frame time.
+        jpeg_framebuffer->frame_us = jpeg_framebuffer->frame_us
+                                   ? ((jpeg_framebuffer->frame_us * 7) + elapsed) / 8 : elapsed;
+    }
+
+    jpeg_framebuffer->frame_ticks = ticks;
+
+    if (jpeg_framebuffer->skipped < jpeg_framebuffer->skip) {
+        jpeg_framebuffer->skipped++;
+        return false;
+    }
+
+    jpeg_framebuffer->skipped = 0;
+    return true;
+}
+
+// Returns true if the IDE takes longer to read a frame than the time between preview frames.
+static bool jpegbuffer_drain_limited() {
+    uint32_t interval_us = jpeg_framebuffer->frame_us * (jpeg_framebuffer->skip + 1);
+    return jpeg_framebuffer->budget && jpeg_framebuffer->frame_us && (jpeg_framebuffer->drain_us > interval_us);
+}
+
+// Adjusts the preview scale and frame skip to keep the encoding time within the budget.
+static void jpegbuffer_adapt(uint32_t encode_us) {
+    if ((!jpeg_framebuffer->budget) || (!jpeg_framebuffer->frame_us)) {
+        return;
+    }
+
+    uint32_t interval_us = jpeg_framebuffer->frame_us * (jpeg_framebuffer->skip + 1);
+    uint32_t budget_us = (interval_us / 100) * jpeg_framebuffer->budget;
+
+    if (encode_us > budget_us) {
+        // Down-scale first, then skip more frames.
+        if (jpeg_framebuffer->scale < PREVIEW_MAX_SCALE) {
+            jpeg_framebuffer->scale++;
+        } else if (jpeg_framebuffer->skip < PREVIEW_MAX_SKIP) {
+            jpeg_framebuffer->skip++;
+        }
+    } else if (encode_us < (budget_us / 4)) {
+        // Going up a scale step costs about 4x, skip fewer frames first, then up-scale.
+        if (jpeg_framebuffer->skip) {
+            jpeg_framebuffer->skip--;
+        } else if (jpeg_framebuffer->scale) {
+            jpeg_framebuffer->scale--;
+        }
     }
 }
 
 void framebuffer_update_jpeg_buffer() {
     static int overflow_count = 0;
 
-    image_t main_fb_src;
+    image_t main_fb_src = {};
     framebuffer_init_image(&main_fb_src);
     image_t *src = &main_fb_src;
 
     if (src->pixfmt != PIXFORMAT_INVALID &&
         framebuffer->streaming_enabled && jpeg_framebuffer->enabled) {
-        if (src->is_compressed) {
-            bool does_not_fit = false;
-
-            if (mutex_try_lock_alternate(&jpeg_framebuffer->lock, MUTEX_TID_OMV)) {
-                if (OMV_JPEG_BUFFER_SIZE_MAX < src->size) {
-                    jpegbuffer_init_from_image(NULL);
-                    does_not_fit = true;
-                } else {
-                    jpegbuffer_init_from_image(src);
-                    memcpy(jpeg_framebuffer->pixels, src->pixels, src->size);
-                }
+        // Don't encode frames faster than the IDE reads them, or more often than the budget allows.
+        if ((!jpegbuffer_preview_frame()) || (jpeg_framebuffer->ready != JPEGBUFFER_NO_SLOT)) {
+            return;
+        }
 
-                mutex_unlock(&jpeg_framebuffer->lock, MUTEX_TID_OMV);
-            }
+        uint32_t max_size;
+        jpegbuffer_slot_t *slot = jpegbuffer_get_free_slot(&max_size);
+        uint8_t *pixels = jpeg_framebuffer->pixels + slot->offset;
 
-            if (does_not_fit) {
+        if (src->is_compressed) {
+            if (OMV_JPEG_BUFFER_SIZE_MAX < src->size) {
                 printf("Warning: JPEG/PNG too big! Trying framebuffer transfer using fallback method!\n");
                 int new_size = fb_encode_for_ide_new_size(src);
                 fb_alloc_mark();
@@ -157,78 +283,115 @@ void framebuffer_update_jpeg_buffer() {
                 fb_encode_for_ide(temp, src);
                 (MP_PYTHON_PRINTER)->print_strn((MP_PYTHON_PRINTER)->data, (const char *) temp, new_size);
                 fb_alloc_free_till_mark();
+            } else if (src->size <= max_size) {
+                // Otherwise, wait for the IDE to finish reading the previous frame.
+                memcpy(pixels, src->pixels, src->size);
+                jpegbuffer_publish(slot, src);
             }
         } else if (src->pixfmt != PIXFORMAT_INVALID) {
-            if (mutex_try_lock_alternate(&jpeg_framebuffer->lock, MUTEX_TID_OMV)) {
-                image_t dst = {
-                    .w = src->w,
-                    .h = src->h,
-                    .pixfmt = PIXFORMAT_JPEG,
-                    .size = OMV_JPEG_BUFFER_SIZE_MAX,
-                    .pixels = jpeg_framebuffer->pixels
-                };
+            image_t dst = {
+                .w = src->w,
+                .h = src->h,
+                .pixfmt = PIXFORMAT_JPEG,
+                .size = max_size,
+                .pixels = pixels
+            };
+
+            bool compress = true;
+            bool overflow = false;
+
+            if ((jpeg_framebuffer->enabled == JPEGBUFFER_RAW) && (image_size(src) <= max_size)) {
+                // Send the frame as is, the size is in bytes for raw frames.
+                memcpy(dst.pixels, src->pixels, image_size(src));
+                dst.pixfmt = src->pixfmt;
+                dst.size = image_size(src);
+                compress = false;
+            }
 
-                bool compress = true;
-                bool overflow = false;
-
-                #if OMV_RAW_PREVIEW_ENABLE
-                if (src->is_mutable) {
-                    // Down-scale the frame (if necessary) and send the raw frame.
-                    dst.size = src->bpp;
-                    dst.pixfmt = src->pixfmt;
-                    if (src->w <= OMV_RAW_PREVIEW_WIDTH && src->h <= OMV_RAW_PREVIEW_HEIGHT) {
-                        if (image_size(&dst) <= OMV_JPEG_BUFFER_SIZE_MAX) {
-                            memcpy(dst.pixels, src->pixels, image_size(src));
-                            compress = false;
-                        }
-                    } else {
-                        float x_scale = OMV_RAW_PREVIEW_WIDTH / (float) src->w;
-                        float y_scale = OMV_RAW_PREVIEW_HEIGHT / (float) src->h;
-                        float scale = IM_MIN(x_scale, y_scale);
-                        dst.w = fast_floorf(src->w * scale);
-                        dst.h = fast_floorf(src->h * scale);
-                        if (image_size(&dst) <= OMV_JPEG_BUFFER_SIZE_MAX) {
-                            imlib_draw_image(&dst, src, 0, 0, scale, scale, NULL, -1, 255, NULL, NULL,
-                                             IMAGE_HINT_BILINEAR | IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
-                            compress = false;
-                        }
+            #if OMV_RAW_PREVIEW_ENABLE
+            if (compress && src->is_mutable) {
+                // Down-scale the frame (if necessary) and send the raw frame.
+                dst.size = src->bpp;
+                dst.pixfmt = src->pixfmt;
+                if (src->w <= OMV_RAW_PREVIEW_WIDTH && src->h <= OMV_RAW_PREVIEW_HEIGHT) {
+                    if (image_size(&dst) <= max_size) {
+                        memcpy(dst.pixels, src->pixels, image_size(src));
+                        compress = false;
+                    }
+                } else {
+                    float x_scale = OMV_RAW_PREVIEW_WIDTH / (float) src->w;
+                    float y_scale = OMV_RAW_PREVIEW_HEIGHT / (float) src->h;
+                    float scale = IM_MIN(x_scale, y_scale);
+                    dst.w = fast_floorf(src->w * scale);
+                    dst.h = fast_floorf(src->h * scale);
+                    if (image_size(&dst) <= max_size) {
+                        imlib_draw_image(&dst, src, 0, 0, scale, scale, NULL, -1, 255, NULL, NULL,
+                                         IMAGE_HINT_BILINEAR | IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
+                        compress = false;
                     }
                 }
-                #endif
+            }
+            #endif
+
+            if (compress) {
+                uint32_t ticks = mp_hal_ticks_us();
+                image_t *enc = src;
+                image_t scaled = {
+                    .w = src->w >> jpeg_framebuffer->scale,
+                    .h = src->h >> jpeg_framebuffer->scale,
+                    .pixfmt = src->is_color ? PIXFORMAT_RGB565 : PIXFORMAT_GRAYSCALE,
+                };
 
-                if (compress) {
-                    // For all other formats, send a compressed frame.
-                    overflow = jpeg_compress(src, &dst, jpeg_framebuffer->quality, false, JPEG_SUBSAMPLING_AUTO);
+                fb_alloc_mark();
+
+                // Down-scale the preview if the frame buffer has room for it.
+                if (jpeg_framebuffer->scale
+                    && (scaled.w >= PREVIEW_MIN_SIZE) && (scaled.h >= PREVIEW_MIN_SIZE)
+                    && (fb_avail() > (image_size(&scaled) + image_line_size(src) * 2))) {
+                    float scale = 1.0f / (1 << jpeg_framebuffer->scale);
+                    scaled.data = fb_alloc(image_size(&scaled), FB_ALLOC_NO_HINT);
+                    imlib_draw_image(&scaled, src, 0, 0, scale, scale, NULL, -1, 256, NULL, NULL,
+                                     IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
+                    enc = &scaled;
+                    dst.w = scaled.w;
+                    dst.h = scaled.h;
                 }
 
-                if (overflow) {
-                    // JPEG buffer overflowed, reduce JPEG quality for the next frame
-                    // and skip the current frame. The IDE doesn't receive this frame.
-                    if (jpeg_framebuffer->quality > 1) {
-                        // Keep this quality for the next n frames
-                        overflow_count = 60;
-                        jpeg_framebuffer->quality = IM_MAX(1, (jpeg_framebuffer->quality / 2));
-                    }
+                // For all other formats, send a compressed frame.
+                overflow = jpeg_compress(enc, &dst, jpeg_framebuffer->quality, false, JPEG_SUBSAMPLING_AUTO);
+                fb_alloc_free_till_mark();
+                jpegbuffer_adapt(mp_hal_ticks_us() - ticks);
+            }
 
-                    jpegbuffer_init_from_image(NULL);
-                } else {
-                    if (overflow_count) {
-                        overflow_count--;
-                    }
+            if (overflow) {
+                // JPEG buffer overflowed, reduce JPEG quality for the next frame and skip the
+                // current frame. The IDE doesn't receive this frame. The quality is not reduced
+                // if the frame only overflowed the space left while the IDE reads a frame.
+                if ((jpeg_framebuffer->quality > 1) && (max_size == OMV_JPEG_BUFFER_SIZE_MAX)) {
+                    // Keep this quality for the next n frames
+                    overflow_count = 60;
+                    jpeg_framebuffer->quality = IM_MAX(1, (jpeg_framebuffer->quality / 2));
+                }
+            } else {
+                if (overflow_count) {
+                    overflow_count--;
+                }
 
-                    // Dynamically adjust our quality if the image is huge.
-                    bool big_frame_buffer = image_size(src) > OMV_JPEG_QUALITY_THRESHOLD;
-                    int jpeg_quality_max = big_frame_buffer ? OMV_JPEG_QUALITY_LOW : OMV_JPEG_QUALITY_HIGH;
+                // Dynamically adjust our quality if the image is huge.
+                bool big_frame_buffer = image_size(src) > OMV_JPEG_QUALITY_THRESHOLD;
+                int jpeg_quality_max = big_frame_buffer ? OMV_JPEG_QUALITY_LOW : OMV_JPEG_QUALITY_HIGH;
 
-                    // No buffer overflow, increase quality up to max quality based on frame size...
-                    if ((!overflow_count) && (jpeg_framebuffer->quality < jpeg_quality_max)) {
-                        jpeg_framebuffer->quality++;
+                if (jpegbuffer_drain_limited()) {
+                    // The IDE reads frames slower than they are produced, send smaller frames.
+                    if (jpeg_framebuffer->quality > OMV_JPEG_QUALITY_LOW) {
+                        jpeg_framebuffer->quality--;
                     }
-
-                    jpegbuffer_init_from_image(&dst);
+                } else if ((!overflow_count) && (jpeg_framebuffer->quality < jpeg_quality_max)) {
+                    // No buffer overflow, increase quality up to max quality based on frame size...
+                    jpeg_framebuffer->quality++;
                 }
 
-                mutex_unlock(&jpeg_framebuffer->lock, MUTEX_TID_OMV);
+                jpegbuffer_publish(slot, &dst);
             }
         }
     }
@@ -294,6 +457,37 @@ vbuffer_t *framebuffer_get_buffer(int32_t index) {
     return (vbuffer_t *) (framebuffer->data + offset);
 }
 
+int32_t framebuffer_get_buffer_index(image_t *img) {
+    for (int32_t i = 0; i < framebuffer->n_buffers; i++) {
+        if (img->data == framebuffer_get_buffer(i)->data) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void framebuffer_set_scanout(uint32_t mask) {
+    framebuffer->scanout = mask;
+}
+
+// Returns a bitmask of the buffers held by readers and of the buffers the capture must not
+// advance to because a queue reader hasn't taken the frames after them yet.
+static uint32_t framebuffer_readers_busy() {
+    uint32_t busy = 0;
+    for (int32_t i = 0; i < FB_MAX_READERS; i++) {
+        framebuffer_reader_t *reader = &framebuffer->readers[i];
+        if (reader->active) {
+            if (reader->held >= 0) {
+                busy |= 1 << reader->held;
+            }
+            if (reader->policy == FB_READER_QUEUE) {
+                busy |= 1 << reader->pos;
+            }
+        }
+    }
+    return busy;
+}
+
 void framebuffer_flush_buffers(bool fifo_flush) {
     if (fifo_flush) {
         // Drop all frame buffers.
@@ -306,19 +500,40 @@ void framebuffer_flush_buffers(bool fifo_flush) {
     framebuffer->tail = framebuffer->head;
     framebuffer->check_head = true;
     framebuffer->sampled_head = 0;
+
+    // Readers start over from the current frame.
+    for (int32_t i = 0; i < FB_MAX_READERS; i++) {
+        framebuffer->readers[i].seq = framebuffer->seq;
+        framebuffer->readers[i].pos = framebuffer->tail;
+        framebuffer->readers[i].held = -1;
+    }
 }
 
 int framebuffer_set_buffers(int32_t n_buffers) {
     uint32_t avail_size = FB_ALIGN_SIZE_ROUND_DOWN(framebuffer_max_buffer_size());
+    uint32_t max_count = (n_buffers == -1) ? 3 : IM_MAX(n_buffers, 1);
     uint32_t frame_size = FB_ALIGN_SIZE_ROUND_UP(framebuffer->frame_size + sizeof(vbuffer_t));
+
+    // A frame size of 0 splits all of the frame buffer between the buffers.
+    if (!framebuffer->frame_size) {
+        frame_size = FB_ALIGN_SIZE_ROUND_DOWN(avail_size / max_count);
+    }
+
     uint32_t vbuff_size = (n_buffers == 1) ? avail_size : frame_size;
-    uint32_t vbuff_count = IM_MIN((avail_size / vbuff_size), (n_buffers == -1) ? 3 : (uint32_t) n_buffers);
 
-    if (vbuff_count == 0 || vbuff_size < sizeof(vbuffer_t)) {
+    if (vbuff_size <= sizeof(vbuffer_t)) {
+        return -1;
+    }
+
+    uint32_t vbuff_count = IM_MIN((avail_size / vbuff_size), max_count);
+
+    if (vbuff_count == 0) {
         return -1;
     }
 
     framebuffer->head = 0;
+    framebuffer->scanout = 0;
+    memset(framebuffer->readers, 0, sizeof(framebuffer->readers));
     framebuffer->buff_size = vbuff_size;
     framebuffer->n_buffers = vbuff_count;
     framebuffer->pixfmt = PIXFORMAT_INVALID;
@@ -331,7 +546,7 @@ int framebuffer_set_buffers(int32_t n_buffers) {
 static uint32_t framebuffer_total_buffer_size() {
     if (framebuffer->n_buffers == 1) {
         // Allow fb_alloc to use frame buffer space up until the image size.
-        image_t img;
+        image_t img = {};
         framebuffer_init_image(&img);
         return sizeof(vbuffer_t) + FB_ALIGN_SIZE_ROUND_UP(image_size(&img));
     } else {
@@ -340,13 +555,113 @@ static uint32_t framebuffer_total_buffer_size() {
     }
 }
 
+#ifdef FB_DCACHE_ENABLED
+// Returns the number of bytes a capture DMA writes to a buffer, which is all of the buffer for
+// JPEG captures and only the frame for raw ones.
+static uint32_t framebuffer_dma_size() {
+    uint32_t size = framebuffer_get_buffer_size();
+    if (framebuffer->dma_size) {
+        size = IM_MIN(FB_ALIGN_SIZE_ROUND_UP(framebuffer->dma_size), size);
+    }
+    return size;
+}
+#endif
+
+// Makes sure all cached CPU writes a DMA would write over are discarded.
+static void framebuffer_clean_buffer(vbuffer_t *buffer) {
+    if (buffer->cache == VBUFFER_CPU_DIRTY) {
+        #ifdef FB_DCACHE_ENABLED
+        SCB_InvalidateDCache_by_Addr(buffer->data, framebuffer_dma_size());
+        #endif
+        buffer->cache = VBUFFER_CLEAN;
+    }
+}
+
+int32_t framebuffer_reader_open(framebuffer_reader_policy_t policy, uint32_t every) {
+    if ((framebuffer->n_buffers == 1) || ((policy == FB_READER_QUEUE) && (framebuffer->n_buffers == 3))) {
+        return -1;
+    }
+
+    for (int32_t i = 0; i < FB_MAX_READERS; i++) {
+        framebuffer_reader_t *reader = &framebuffer->readers[i];
+        if (!reader->active) {
+            mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+            reader->policy = policy;
+            reader->every = OMV_MAX(every, 1U);
+            reader->seq = framebuffer->seq;
+            reader->pos = framebuffer->tail;
+            reader->held = -1;
+            reader->active = true;
+            MICROPY_END_ATOMIC_SECTION(atomic_state);
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void framebuffer_reader_close(int32_t id) {
+    framebuffer->readers[id].active = false;
+    framebuffer->readers[id].held = -1;
+}
+
+vbuffer_t *framebuffer_reader_acquire(int32_t id) {
+    framebuffer_reader_t *reader = &framebuffer->readers[id];
+    vbuffer_t *buffer = NULL;
+
+    // The capture can't pick the buffer between sampling the tail and holding it.
+    mp_uint_t atomic_state = MICROPY_BEGIN_ATOMIC_SECTION();
+    int32_t tail = framebuffer->tail;
+    int32_t index = -1;
+
+    switch (reader->policy) {
+        case FB_READER_QUEUE: {
+            if (reader->pos != tail) {
+                index = (reader->pos + 1) % framebuffer->n_buffers;
+                reader->pos = index;
+            }
+            break;
+        }
+        case FB_READER_LATEST: {
+            if (((int32_t) (framebuffer_get_buffer(tail)->seq - reader->seq)) > 0) {
+                index = tail;
+            }
+            break;
+        }
+        case FB_READER_SAMPLED: {
+            if (((int32_t) (framebuffer_get_buffer(tail)->seq - reader->seq)) >= ((int32_t) reader->every)) {
+                index = tail;
+            }
+            break;
+        }
+    }
+
+    if (index >= 0) {
+        buffer = framebuffer_get_buffer(index);
+        reader->held = index;
+        reader->seq = buffer->seq;
+    }
+    MICROPY_END_ATOMIC_SECTION(atomic_state);
+
+    #ifdef FB_DCACHE_ENABLED
+    if (buffer && (buffer->cache == VBUFFER_DMA_OWNED)) {
+        SCB_InvalidateDCache_by_Addr(buffer->data, framebuffer_dma_size());
+        buffer->cache = VBUFFER_CPU_DIRTY;
+    }
+    #endif
+
+    return buffer;
+}
+
+void framebuffer_reader_release(int32_t id) {
+    framebuffer->readers[id].held = -1;
+}
+
 void framebuffer_free_current_buffer() {
     vbuffer_t *buffer = framebuffer_get_buffer(framebuffer->head);
 
-    #ifdef __DCACHE_PRESENT
     // Make sure all cached CPU writes are discarded before returning the buffer.
-    SCB_InvalidateDCache_by_Addr(buffer->data, framebuffer_get_buffer_size());
-    #endif
+    framebuffer_clean_buffer(buffer);
 
     // Invalidate frame.
     framebuffer->pixfmt = PIXFORMAT_INVALID;
@@ -358,15 +673,15 @@ void framebuffer_free_current_buffer() {
 }
 
 void framebuffer_setup_buffers() {
-    #ifdef __DCACHE_PRESENT
+    uint32_t busy = framebuffer_readers_busy();
+
     for (int32_t i = 0; i < framebuffer->n_buffers; i++) {
-        if (i != framebuffer->head) {
-            vbuffer_t *buffer = framebuffer_get_buffer(i);
-            // Make sure all cached CPU writes are discarded before returning the buffer.
-            SCB_InvalidateDCache_by_Addr(buffer->data, framebuffer_get_buffer_size());
+        // Buffers readers hold may have been drawn on by the script.
+        if ((i != framebuffer->head) && (!(busy & (1 << i)))) {
+            // Only buffers the CPU had since they were last cleaned are invalidated.
+            framebuffer_clean_buffer(framebuffer_get_buffer(i));
         }
     }
-    #endif
 }
 
 vbuffer_t *framebuffer_get_head(framebuffer_flags_t flags) {
@@ -397,19 +712,28 @@ vbuffer_t *framebuffer_get_head(framebuffer_flags_t flags) {
         }
     }
 
+    vbuffer_t *buffer = framebuffer_get_buffer(new_head);
+
     if (!(flags & FB_PEEK)) {
         framebuffer->head = new_head;
+        framebuffer->start_us = buffer->start_us;
+        framebuffer->end_us = buffer->end_us;
+        framebuffer->trigger_us = buffer->trigger_us;
     }
 
-    vbuffer_t *buffer = framebuffer_get_buffer(new_head);
-
-    #ifdef __DCACHE_PRESENT
-    if (flags & FB_INVALIDATE) {
-        // Make sure any cached CPU reads are dropped before returning the buffer.
-        SCB_InvalidateDCache_by_Addr(buffer->data, framebuffer_get_buffer_size());
+    #ifdef FB_DCACHE_ENABLED
+    if ((flags & FB_INVALIDATE) && (buffer->cache == VBUFFER_DMA_OWNED)) {
+        // Make sure any cached CPU reads are dropped before returning the buffer. Lines may be
+        // speculatively loaded while the DMA writes, so this can't be done before the capture.
+        SCB_InvalidateDCache_by_Addr(buffer->data, framebuffer_dma_size());
     }
     #endif
 
+    if (!(flags & FB_PEEK)) {
+        // The CPU owns the buffer until it's freed.
+        buffer->cache = VBUFFER_CPU_DIRTY;
+    }
+
     return buffer;
 }
 
@@ -431,7 +755,7 @@ vbuffer_t *framebuffer_get_tail(framebuffer_flags_t flags) {
         }
         // Double Buffer Mode.
     } else if (framebuffer->n_buffers == 2) {
-        if (new_tail == framebuffer->sampled_head) {
+        if ((new_tail == framebuffer->sampled_head) || (framebuffer_readers_busy() & (1 << new_tail))) {
             // Setup to check head again.
             framebuffer->check_head = true;
             return NULL;
@@ -440,12 +764,18 @@ vbuffer_t *framebuffer_get_tail(framebuffer_flags_t flags) {
     } else if (framebuffer->n_buffers == 3) {
         // For triple buffering we are never writing where tail or head
         // (which may instantly update to be equal to tail) is.
-        if (new_tail == framebuffer->sampled_head) {
+        uint32_t busy = (1 << framebuffer->sampled_head) | framebuffer->scanout | framebuffer_readers_busy();
+        if (busy & (1 << new_tail)) {
             new_tail = (new_tail + 1) % framebuffer->n_buffers;
         }
+        // Drop the frame if the display scans out from the only other buffer.
+        if (busy & (1 << new_tail)) {
+            framebuffer->check_head = true;
+            return NULL;
+        }
         // Video FIFO Mode.
     } else {
-        if (new_tail == framebuffer->sampled_head) {
+        if ((new_tail == framebuffer->sampled_head) || (framebuffer_readers_busy() & (1 << new_tail))) {
             // Setup to check head again.
             framebuffer->check_head = true;
             return NULL;
@@ -459,11 +789,16 @@ vbuffer_t *framebuffer_get_tail(framebuffer_flags_t flags) {
         buffer->reset_state = false;
         buffer->offset = 0;
         buffer->jpeg_buffer_overflow = false;
+        // The first line of the frame, this is as close to VSYNC as the buffer code gets.
+        buffer->start_us = mp_hal_ticks_us();
     }
 
     if (!(flags & FB_PEEK)) {
         // Trigger reset on the frame buffer the next time it is used.
         buffer->reset_state = true;
+        buffer->cache = VBUFFER_DMA_OWNED;
+        buffer->end_us = mp_hal_ticks_us();
+        buffer->seq = ++framebuffer->seq;
 
         // Mark the frame buffer ready in single buffer mode.
         if (framebuffer->n_buffers == 1) {
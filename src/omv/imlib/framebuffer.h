@@ -22,6 +22,26 @@
 #define FRAMEBUFFER_ALIGNMENT    __SCB_DCACHE_LINE_SIZE
 #endif
 
+// Frames can be shared with up to FB_MAX_READERS consumers besides the script, like a recorder or
+// a display. A reader takes frames with its own policy and holds at most one buffer at a time,
+// which is not captured to until the reader releases it.
+#define FB_MAX_READERS    (4)
+
+typedef enum {
+    FB_READER_LATEST,   // Takes the newest frame, older frames are skipped.
+    FB_READER_QUEUE,    // Takes every frame in order, new frames are dropped while the reader is behind.
+    FB_READER_SAMPLED,  // Takes the newest frame once every N frames were captured.
+} framebuffer_reader_policy_t;
+
+typedef struct framebuffer_reader {
+    bool active;
+    framebuffer_reader_policy_t policy;
+    uint32_t every;         // Sampling period of FB_READER_SAMPLED.
+    uint32_t seq;           // Sequence number of the last frame taken.
+    volatile int32_t pos;   // Buffer of the last frame taken by FB_READER_QUEUE.
+    volatile int32_t held;  // Buffer held by the reader, or -1.
+} framebuffer_reader_t;
+
 typedef struct framebuffer {
     int32_t x, y;
     int32_t w, h;
@@ -31,10 +51,22 @@ typedef struct framebuffer {
     uint32_t buff_size;
     uint32_t n_buffers;
     uint32_t frame_size;
+    // Max bytes a capture DMA writes to a buffer, 0 if it may fill the whole buffer.
+    uint32_t dma_size;
     int32_t head;
     volatile int32_t tail;
     bool check_head;
     int32_t sampled_head;
+    // Bitmask of the buffers a display scans out from, which are not captured to.
+    volatile uint32_t scanout;
+    // Timestamps (mp_hal_ticks_us) of the last frame returned by snapshot().
+    uint32_t start_us;
+    uint32_t end_us;
+    uint32_t snapshot_us;
+    uint32_t trigger_us;
+    // Sequence number of the last captured frame.
+    uint32_t seq;
+    framebuffer_reader_t readers[FB_MAX_READERS];
     OMV_ATTR_ALIGNED(uint8_t data[], FRAMEBUFFER_ALIGNMENT);
 } framebuffer_t;
 
@@ -43,9 +75,17 @@ extern framebuffer_t *framebuffer;
 typedef enum {
     FB_NO_FLAGS   = (0 << 0),
     FB_PEEK       = (1 << 0),   // If set, will not move the head/tail.
-    FB_INVALIDATE = (1 << 1),   // If set, invalidate the buffer on return.
+    FB_INVALIDATE = (1 << 1),   // If set, invalidate the bytes written by a DMA on return.
 } framebuffer_flags_t;
 
+// Cache ownership of a buffer, so only the bytes a capture DMA writes are maintained and only
+// when the CPU may have touched them. Buffers start as CPU dirty.
+typedef enum {
+    VBUFFER_CPU_DIRTY,  // The CPU may hold dirty lines, which are discarded before a DMA writes.
+    VBUFFER_CLEAN,      // Nothing is cached, a DMA may write to the buffer.
+    VBUFFER_DMA_OWNED,  // Written by a DMA, cached reads are dropped before the CPU gets it.
+} vbuffer_cache_t;
+
 typedef struct vbuffer {
     // Used by snapshot code to figure out the jpeg size (bpp).
     int32_t offset;
@@ -53,25 +93,70 @@ typedef struct vbuffer {
     // Used internally by frame buffer code.
     volatile bool waiting_for_data;
     bool reset_state;
+    vbuffer_cache_t cache;
+    // Capture timestamps (mp_hal_ticks_us) of the first line and of the end of the frame.
+    uint32_t start_us;
+    uint32_t end_us;
+    // Timestamp of the external trigger that started the exposure, set by the CSI driver.
+    uint32_t trigger_us;
+    // Sequence number of the frame, set when it's captured.
+    uint32_t seq;
     // Image data array.
     OMV_ATTR_ALIGNED(uint8_t data[], FRAMEBUFFER_ALIGNMENT);
 } vbuffer_t;
 
-typedef struct jpegbuffer {
+// The JPEG buffer holds up to two frames: the one the IDE is reading and the next one. The frame
+// slots are handed over without locks, the script publishes a slot with `ready` and the IDE takes
+// it with `reading`. The script only encodes a new frame after the IDE took the previous one.
+#define JPEGBUFFER_NO_SLOT    (-1)
+// Value of `enabled` set by capture tools: frames are sent uncompressed, at full resolution.
+#define JPEGBUFFER_RAW        (2)
+
+typedef struct jpegbuffer_slot {
     int32_t w, h;
     int32_t size;
+    uint32_t offset;    // Offset of the frame data in pixels[].
+    uint32_t seq;       // Sequence number of the frame.
+    uint32_t pixfmt;    // Pixel format of the frame data.
+    uint32_t ticks_us;  // Time the frame was published.
+} jpegbuffer_slot_t;
+
+typedef struct jpegbuffer {
     int32_t enabled;
     int32_t quality;
-    omv_mutex_t lock;
+    // Adaptive preview state, see fb_set_preview_budget().
+    uint32_t budget;                // Max percent of the frame time spent on the preview, 0 if off.
+    uint32_t scale;                 // The preview is down-scaled by 1 << scale.
+    uint32_t skip;                  // Number of frames skipped after each preview frame.
+    uint32_t skipped;
+    uint32_t frame_ticks;
+    uint32_t frame_us;              // Average time between frames.
+    uint32_t acquire_ticks;
+    uint32_t drain_us;              // Time the IDE took to read the last frame.
+    uint32_t seq;                   // Sequence number of the last published frame.
+    volatile int32_t ready;         // Slot published to the IDE (set by the script, cleared by the IDE).
+    volatile int32_t reading;       // Slot being read by the IDE (set and cleared by the IDE).
+    jpegbuffer_slot_t slots[2];
     OMV_ATTR_ALIGNED(uint8_t pixels[], FRAMEBUFFER_ALIGNMENT);
 } jpegbuffer_t;
 
 extern jpegbuffer_t *jpeg_framebuffer;
 
+// Called by the IDE: take the published frame, returns NULL if there's no new frame.
+jpegbuffer_slot_t *jpegbuffer_acquire();
+// Called by the IDE: return the frame taken with jpegbuffer_acquire().
+void jpegbuffer_release();
+
 // Force fb streaming to the IDE off.
 void fb_set_streaming_enabled(bool enable);
 bool fb_get_streaming_enabled();
 
+// Limit the time spent on the IDE preview to a percent of the frame time, by down-scaling the
+// preview, skipping frames, and lowering its quality if the IDE reads frames slowly. 0 turns
+// the adaptive preview off.
+void fb_set_preview_budget(uint32_t percent);
+uint32_t fb_get_preview_budget();
+
 // Encode jpeg data for transmission over a text channel.
 int fb_encode_for_ide_new_size(image_t *img);
 void fb_encode_for_ide(uint8_t *ptr, image_t *img);
@@ -110,8 +195,31 @@ void framebuffer_flush_buffers(bool fifo_flush);
 // Set the number of virtual buffers in the frame buffer.
 // If n_buffers = -1 the number of virtual buffers will be set to 3 each  if possible.
 // If n_buffers = 1 the whole framebuffer is used. In this case, `frame_size` is ignored.
+// If `frame_size` is 0 the whole framebuffer is split between the virtual buffers.
 int framebuffer_set_buffers(int32_t n_buffers);
 
+// Returns the index of the vbuffer holding the image data, or -1 if the image is not in a vbuffer.
+int32_t framebuffer_get_buffer_index(image_t *img);
+
+// Hands the buffers in mask (a bitmask of indices) to a display, which scans out from them until
+// they are handed back with another call. Only supported in triple buffer mode.
+void framebuffer_set_scanout(uint32_t mask);
+
+// Opens a reader, returns its id or -1 if all readers are in use. Single buffering has no readers
+// and FB_READER_QUEUE needs double buffering or a video FIFO, the buffers of triple buffering are
+// not captured in order. Readers are closed when the number of buffers changes.
+int32_t framebuffer_reader_open(framebuffer_reader_policy_t policy, uint32_t every);
+
+// Closes a reader, releasing the buffer it holds.
+void framebuffer_reader_close(int32_t id);
+
+// Takes the next frame for the reader and releases the previous one. Returns NULL if there's no
+// new frame, the previous frame is kept then. The script may draw on a frame readers share.
+vbuffer_t *framebuffer_reader_acquire(int32_t id);
+
+// Releases the frame held by the reader so it can be captured to again.
+void framebuffer_reader_release(int32_t id);
+
 // Call when done with the current vbuffer to mark it as free.
 void framebuffer_free_current_buffer();
 
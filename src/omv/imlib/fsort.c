@@ -3,10 +3,9 @@
  * Copyright (c) 2013-2016 Kwabena W. Agyeman <kwagyeman@openmv.io>
  * This work is licensed under the MIT license, see the file LICENSE for details.
  *
- * Fast 9 and 25 bin sort.
+ * Fast 9 and 25 bin sort, and integer sort and selection.
  *
  */
-#include <stdlib.h>
 #include "fsort.h"
 
 // http://pages.ripco.net/~jgamble/nw.html
@@ -290,8 +289,57 @@ static void fsort25(int *data) {
     cmpswp(data + 11, data + 12);
 }
 
-static int fsort_compare(const void *a, const void *b) {
-    return (*((int *) a)) - (*((int *) b));
+#define FSORT_INSERTION_MAX  (16)
+
+static void fsort_insertion(int *data, int n) {
+    for (int i = 1; i < n; i++) {
+        int v = data[i], j = i;
+        for (; (j > 0) && (v < data[j - 1]); j--) {
+            data[j] = data[j - 1];
+        }
+        data[j] = v;
+    }
+}
+
+// Hoare partition around the median of the first, middle and last elements. Returns p such
+// that data[0..p] <= pivot <= data[p+1..n-1].
+static int fsort_partition(int *data, int n) {
+    int *m = data + (n / 2), *l = data + (n - 1);
+    cmpswp(data, m);
+    cmpswp(m, l);
+    cmpswp(data, m);
+
+    int pivot = *m, i = -1, j = n;
+    for (;;) {
+        while (data[++i] < pivot) {
+        }
+        while (data[--j] > pivot) {
+        }
+        if (i >= j) {
+            return j;
+        }
+        int tmp = data[i];
+        data[i] = data[j];
+        data[j] = tmp;
+    }
+}
+
+// Quicksort without comparison callbacks. It recurses on the smaller side only, so the stack
+// depth is bounded by log2(n).
+static void fsort_quick(int *data, int n) {
+    while (n > FSORT_INSERTION_MAX) {
+        int p = fsort_partition(data, n) + 1;
+        if (p < (n - p)) {
+            fsort_quick(data, p);
+            data += p;
+            n -= p;
+        } else {
+            fsort_quick(data + p, n - p);
+            n = p;
+        }
+    }
+
+    fsort_insertion(data, n);
 }
 
 void fsort(int *data, int n) {
@@ -299,6 +347,23 @@ void fsort(int *data, int n) {
         case 1: return;
         case 9: fsort9(data); return;
         case 25: fsort25(data); return;
-        default: qsort(data, n, sizeof(int), fsort_compare);
+        default: fsort_quick(data, n);
+    }
+}
+
+int fselect(int *data, int n, int k) {
+    // Only the side that holds the k-th element is partitioned further.
+    while (n > FSORT_INSERTION_MAX) {
+        int p = fsort_partition(data, n) + 1;
+        if (k < p) {
+            n = p;
+        } else {
+            data += p;
+            n -= p;
+            k -= p;
+        }
     }
+
+    fsort_insertion(data, n);
+    return data[k];
 }
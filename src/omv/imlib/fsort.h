@@ -3,11 +3,13 @@
  * Copyright (c) 2013-2016 Kwabena W. Agyeman <kwagyeman@openmv.io>
  * This work is licensed under the MIT license, see the file LICENSE for details.
  *
- * Fast 9 and 25 bin sort.
+ * Fast 9 and 25 bin sort, and integer sort and selection.
  *
  */
 #ifndef __FSORT_H__
 #define __FSORT_H__
 #include <stdint.h>
 void fsort(int *data, int n);
+// Partially sorts data so data[k] is the k-th smallest element and returns it. O(n) on average.
+int fselect(int *data, int n, int k);
 #endif /* __FSORT_H__ */
@@ -13,8 +13,6 @@
 
 #include "fb_alloc.h"
 #include "file_utils.h"
-#define BLOCK_SIZE    (126) // (2^7) - 2 // (DO NOT CHANGE!)
-
 void gif_open(FIL *fp, int width, int height, bool color, bool loop) {
     file_buffer_on(fp);
 
@@ -45,7 +43,297 @@ void gif_open(FIL *fp, int width, int height, bool color, bool loop) {
     file_buffer_off(fp);
 }
 
-void gif_add_frame(FIL *fp, image_t *img, uint16_t delay) {
+#define LZW_MAX_BITS    (12)
+#define LZW_MAX_CODE    ((1 << LZW_MAX_BITS) - 1)
+#define LZW_HASH_SIZE   (8192) // Must be a power of 2 larger than LZW_MAX_CODE.
+#define LZW_HASH_EMPTY  (0xFFFFFFFF)
+#define GIF_BLOCK_SIZE  (255)
+
+// Median cut works on a 4-bit per channel color histogram.
+#define HIST_BITS       (4)
+#define HIST_SIZE       (1 << (HIST_BITS * 3))
+#define PALETTE_SIZE    (256)
+
+typedef struct gif_lzw {
+    FIL *fp;
+    uint32_t *hash; // (key << LZW_MAX_BITS) | code
+    int min_code_size, code_size, clear_code, next_code, prefix;
+    uint32_t bit_buf;
+    int bit_count, block_len;
+    uint8_t block[GIF_BLOCK_SIZE];
+} gif_lzw_t;
+
+typedef struct gif_box {
+    uint8_t min[3], max[3];
+    uint32_t count;
+} gif_box_t;
+
+static void gif_lzw_write_byte(gif_lzw_t *lzw, uint8_t byte) {
+    lzw->block[lzw->block_len++] = byte;
+
+    if (lzw->block_len == GIF_BLOCK_SIZE) {
+        file_write_byte(lzw->fp, GIF_BLOCK_SIZE);
+        file_write(lzw->fp, lzw->block, GIF_BLOCK_SIZE);
+        lzw->block_len = 0;
+    }
+}
+
+static void gif_lzw_clear(gif_lzw_t *lzw) {
+    memset(lzw->hash, 0xFF, LZW_HASH_SIZE * sizeof(uint32_t));
+    lzw->code_size = lzw->min_code_size + 1;
+    lzw->next_code = lzw->clear_code + 2;
+}
+
+static void gif_lzw_write_code(gif_lzw_t *lzw, int code) {
+    lzw->bit_buf |= code << lzw->bit_count;
+    lzw->bit_count += lzw->code_size;
+
+    while (lzw->bit_count >= 8) {
+        gif_lzw_write_byte(lzw, lzw->bit_buf);
+        lzw->bit_buf >>= 8;
+        lzw->bit_count -= 8;
+    }
+
+    // The decoder widens its codes one code after the encoder adds the entry.
+    if ((lzw->next_code >= (1 << lzw->code_size)) && (lzw->code_size < LZW_MAX_BITS)) {
+        lzw->code_size += 1;
+    }
+}
+
+static void gif_lzw_init(gif_lzw_t *lzw, FIL *fp, uint32_t *hash, int min_code_size) {
+    lzw->fp = fp;
+    lzw->hash = hash;
+    lzw->min_code_size = min_code_size;
+    lzw->clear_code = 1 << min_code_size;
+    lzw->prefix = -1;
+    lzw->bit_buf = 0;
+    lzw->bit_count = 0;
+    lzw->block_len = 0;
+
+    file_write_byte(fp, min_code_size);
+    gif_lzw_clear(lzw);
+    gif_lzw_write_code(lzw, lzw->clear_code);
+}
+
+static void gif_lzw_add_pixels(gif_lzw_t *lzw, const uint8_t *pixels, int n) {
+    int prefix = lzw->prefix;
+    int i = 0;
+
+    if (prefix < 0 && n) {
+        prefix = pixels[i++];
+    }
+
+    for (; i < n; i++) {
+        uint32_t key = (prefix << 8) | pixels[i];
+        uint32_t slot = ((key >> LZW_MAX_BITS) ^ key) & (LZW_HASH_SIZE - 1);
+        uint32_t entry;
+
+        while ((entry = lzw->hash[slot]) != LZW_HASH_EMPTY) {
+            if ((entry >> LZW_MAX_BITS) == key) {
+                break;
+            }
+            slot = (slot + 1) & (LZW_HASH_SIZE - 1);
+        }
+
+        if (entry != LZW_HASH_EMPTY) {
+            prefix = entry & LZW_MAX_CODE;
+            continue;
+        }
+
+        gif_lzw_write_code(lzw, prefix);
+        prefix = pixels[i];
+
+        if (lzw->next_code >= LZW_MAX_CODE) {
+            gif_lzw_write_code(lzw, lzw->clear_code);
+            gif_lzw_clear(lzw);
+        } else {
+            lzw->hash[slot] = (key << LZW_MAX_BITS) | lzw->next_code++;
+        }
+    }
+
+    lzw->prefix = prefix;
+}
+
+static void gif_lzw_finish(gif_lzw_t *lzw) {
+    if (lzw->prefix >= 0) {
+        gif_lzw_write_code(lzw, lzw->prefix);
+    }
+
+    gif_lzw_write_code(lzw, lzw->clear_code + 1); // end code
+
+    if (lzw->bit_count) {
+        gif_lzw_write_byte(lzw, lzw->bit_buf);
+    }
+
+    if (lzw->block_len) {
+        file_write_byte(lzw->fp, lzw->block_len);
+        file_write(lzw->fp, lzw->block, lzw->block_len);
+    }
+
+    file_write_byte(lzw->fp, 0x00); // block terminator
+}
+
+static inline int gif_hist_index(uint16_t pixel) {
+    return ((COLOR_RGB565_TO_R5(pixel) >> 1) << (HIST_BITS * 2)) |
+           ((COLOR_RGB565_TO_G6(pixel) >> 2) << HIST_BITS) |
+           (COLOR_RGB565_TO_B5(pixel) >> 1);
+}
+
+static void gif_get_rgb565_row(image_t *img, int y, uint16_t *row) {
+    if (img->is_bayer) {
+        imlib_debayer_line(0, img->w, y, row, PIXFORMAT_RGB565, img);
+    } else if (img->is_yuv) {
+        imlib_deyuv_line(0, img->w, y, row, PIXFORMAT_RGB565, img);
+    } else {
+        memcpy(row, IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y), img->w * sizeof(uint16_t));
+    }
+}
+
+static void gif_box_shrink(gif_box_t *box, uint32_t *hist) {
+    uint8_t min[3] = {255, 255, 255}, max[3] = {0, 0, 0};
+    box->count = 0;
+
+    for (int r = box->min[0]; r <= box->max[0]; r++) {
+        for (int g = box->min[1]; g <= box->max[1]; g++) {
+            for (int b = box->min[2]; b <= box->max[2]; b++) {
+                uint32_t count = hist[(r << (HIST_BITS * 2)) | (g << HIST_BITS) | b];
+
+                if (count) {
+                    min[0] = IM_MIN(min[0], r); max[0] = IM_MAX(max[0], r);
+                    min[1] = IM_MIN(min[1], g); max[1] = IM_MAX(max[1], g);
+                    min[2] = IM_MIN(min[2], b); max[2] = IM_MAX(max[2], b);
+                    box->count += count;
+                }
+            }
+        }
+    }
+
+    if (box->count) {
+        memcpy(box->min, min, sizeof(min));
+        memcpy(box->max, max, sizeof(max));
+    }
+}
+
+// Builds an adaptive palette with median cut and a histogram bin to palette index table.
+static void gif_median_cut(uint32_t *hist, uint8_t *lut, uint8_t *palette) {
+    gif_box_t boxes[PALETTE_SIZE];
+    int n_boxes = 1;
+
+    boxes[0] = (gif_box_t) {{0, 0, 0}, {(1 << HIST_BITS) - 1, (1 << HIST_BITS) - 1, (1 << HIST_BITS) - 1}, 0};
+    gif_box_shrink(&boxes[0], hist);
+
+    while (n_boxes < PALETTE_SIZE) {
+        // Split the most populated box that still covers more than one bin.
+        int best = -1;
+
+        for (int i = 0; i < n_boxes; i++) {
+            bool splittable = (boxes[i].min[0] != boxes[i].max[0]) ||
+                              (boxes[i].min[1] != boxes[i].max[1]) ||
+                              (boxes[i].min[2] != boxes[i].max[2]);
+
+            if (splittable && ((best < 0) || (boxes[i].count > boxes[best].count))) {
+                best = i;
+            }
+        }
+
+        if (best < 0) {
+            break;
+        }
+
+        gif_box_t *box = &boxes[best];
+        int axis = 0;
+
+        for (int c = 1; c < 3; c++) {
+            if ((box->max[c] - box->min[c]) > (box->max[axis] - box->min[axis])) {
+                axis = c;
+            }
+        }
+
+        // Find the median plane along the longest axis.
+        uint32_t acc = 0;
+        int split = box->min[axis];
+
+        for (int v = box->min[axis]; v < box->max[axis]; v++) {
+            uint8_t min[3], max[3];
+            memcpy(min, box->min, sizeof(min));
+            memcpy(max, box->max, sizeof(max));
+            min[axis] = max[axis] = v;
+
+            for (int r = min[0]; r <= max[0]; r++) {
+                for (int g = min[1]; g <= max[1]; g++) {
+                    for (int b = min[2]; b <= max[2]; b++) {
+                        acc += hist[(r << (HIST_BITS * 2)) | (g << HIST_BITS) | b];
+                    }
+                }
+            }
+
+            split = v;
+
+            if ((acc * 2) >= box->count) {
+                break;
+            }
+        }
+
+        gif_box_t *new_box = &boxes[n_boxes++];
+        *new_box = *box;
+        box->max[axis] = split;
+        new_box->min[axis] = split + 1;
+        gif_box_shrink(box, hist);
+        gif_box_shrink(new_box, hist);
+    }
+
+    memset(palette, 0, PALETTE_SIZE * 3);
+
+    for (int i = 0; i < n_boxes; i++) {
+        gif_box_t *box = &boxes[i];
+        uint32_t sum[3] = {0, 0, 0}, count = 0;
+
+        for (int r = box->min[0]; r <= box->max[0]; r++) {
+            for (int g = box->min[1]; g <= box->max[1]; g++) {
+                for (int b = box->min[2]; b <= box->max[2]; b++) {
+                    int index = (r << (HIST_BITS * 2)) | (g << HIST_BITS) | b;
+                    sum[0] += hist[index] * r;
+                    sum[1] += hist[index] * g;
+                    sum[2] += hist[index] * b;
+                    count += hist[index];
+                    lut[index] = i;
+                }
+            }
+        }
+
+        for (int c = 0; c < 3; c++) {
+            // Scale the bin center back to 8-bits.
+            float v = count ? (((float) sum[c]) / count) : 0.0f;
+            palette[(i * 3) + c] = IM_MIN(fast_roundf((v + 0.5f) * (256 / (1 << HIST_BITS))), 255);
+        }
+    }
+}
+
+void gif_add_frame(FIL *fp, image_t *img, uint16_t delay, bool adaptive_palette) {
+    bool color = !IM_IS_GS(img);
+    adaptive_palette = adaptive_palette && color;
+
+    // Everything has to be allocated before the file buffer takes the rest of the fb.
+    uint32_t *hash = fb_alloc(LZW_HASH_SIZE * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+    uint8_t *indices = fb_alloc(img->w, FB_ALLOC_PREFER_SPEED);
+    uint16_t *row = color ? fb_alloc(img->w * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED) : NULL;
+    uint8_t *lut = NULL, *palette = NULL;
+
+    if (adaptive_palette) {
+        uint32_t *hist = fb_alloc0(HIST_SIZE * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+        lut = fb_alloc(HIST_SIZE, FB_ALLOC_NO_HINT);
+        palette = fb_alloc(PALETTE_SIZE * 3, FB_ALLOC_NO_HINT);
+
+        for (int y = 0; y < img->h; y++) {
+            gif_get_rgb565_row(img, y, row);
+            for (int x = 0; x < img->w; x++) {
+                hist[gif_hist_index(row[x])] += 1;
+            }
+        }
+
+        gif_median_cut(hist, lut, palette);
+    }
+
     file_buffer_on(fp);
 
     if (delay) {
@@ -57,57 +345,60 @@ void gif_add_frame(FIL *fp, image_t *img, uint16_t delay) {
     file_write_byte(fp, 0x2C);
     file_write_long(fp, 0);
     file_write(fp, (uint16_t []) {img->w, img->h}, 4);
-    file_write(fp, (uint8_t []) {0x00, 0x07}, 2); // 7-bits
-
-    int bytes = img->h * img->w;
-    int blocks = (bytes + BLOCK_SIZE - 1) / BLOCK_SIZE;
-
-    if (IM_IS_GS(img)) {
-        for (int y = 0; y < blocks; y++) {
-            int block_size = IM_MIN(BLOCK_SIZE, bytes - (y * BLOCK_SIZE));
-            file_write_byte(fp, 1 + block_size);
-            file_write_byte(fp, 0x80); // clear code
-            for (int x = 0; x < block_size; x++) {
-                file_write_byte(fp, img->pixels[(y * BLOCK_SIZE) + x] >> 1);
-            }
-        }
-    } else if (IM_IS_RGB565(img)) {
-        for (int y = 0; y < blocks; y++) {
-            int block_size = IM_MIN(BLOCK_SIZE, bytes - (y * BLOCK_SIZE));
-            file_write_byte(fp, 1 + block_size);
-            file_write_byte(fp, 0x80); // clear code
-            for (int x = 0; x < block_size; x++) {
-                uint16_t pixel = ((uint16_t *) img->pixels)[(y * BLOCK_SIZE) + x];
-                uint16_t r = COLOR_RGB565_TO_R5(pixel) >> 3;
-                uint16_t g = COLOR_RGB565_TO_G6(pixel) >> 3;
-                uint16_t b = COLOR_RGB565_TO_B5(pixel) >> 3;
-                file_write_byte(fp, (r << 5) | (g << 2) | b);
+
+    if (adaptive_palette) {
+        file_write_byte(fp, 0x87); // 8-bit local color table
+        file_write(fp, palette, PALETTE_SIZE * 3);
+    } else {
+        file_write_byte(fp, 0x00); // global color table
+    }
+
+    gif_lzw_t lzw;
+    gif_lzw_init(&lzw, fp, hash, adaptive_palette ? 8 : 7);
+
+    for (int y = 0; y < img->h; y++) {
+        if (!color) {
+            uint8_t *src = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+            for (int x = 0; x < img->w; x++) {
+                indices[x] = src[x] >> 1;
             }
-        }
-    } else if (img->is_bayer || img->is_yuv) {
-        for (int y = 0; y < blocks; y++) {
-            int block_size = IM_MIN(BLOCK_SIZE, bytes - (y * BLOCK_SIZE));
-            file_write_byte(fp, 1 + block_size);
-            file_write_byte(fp, 0x80); // clear code
-            uint16_t pixels[block_size];
-            if (img->is_bayer) {
-                imlib_debayer_line(0, block_size, y, pixels, PIXFORMAT_RGB565, img);
+        } else {
+            gif_get_rgb565_row(img, y, row);
+
+            if (adaptive_palette) {
+                for (int x = 0; x < img->w; x++) {
+                    indices[x] = lut[gif_hist_index(row[x])];
+                }
             } else {
-                imlib_deyuv_line(0, block_size, y, pixels, PIXFORMAT_RGB565, img);
-            }
-            for (int x = 0; x < block_size; x++) {
-                uint16_t pixel = pixels[2];
-                uint16_t r = COLOR_RGB565_TO_R5(pixel) >> 3;
-                uint16_t g = COLOR_RGB565_TO_G6(pixel) >> 3;
-                uint16_t b = COLOR_RGB565_TO_B5(pixel) >> 3;
-                file_write_byte(fp, (r << 5) | (g << 2) | b);
+                for (int x = 0; x < img->w; x++) {
+                    uint16_t pixel = row[x];
+                    uint16_t r = COLOR_RGB565_TO_R5(pixel) >> 3;
+                    uint16_t g = COLOR_RGB565_TO_G6(pixel) >> 3;
+                    uint16_t b = COLOR_RGB565_TO_B5(pixel) >> 3;
+                    indices[x] = (r << 5) | (g << 2) | b;
+                }
             }
         }
+
+        gif_lzw_add_pixels(&lzw, indices, img->w);
     }
 
-    file_write(fp, (uint8_t []) {0x01, 0x81, 0x00}, 3); // end code
+    gif_lzw_finish(&lzw);
 
     file_buffer_off(fp);
+
+    if (adaptive_palette) {
+        fb_free(); // palette
+        fb_free(); // lut
+        fb_free(); // hist
+    }
+
+    if (row) {
+        fb_free(); // row
+    }
+
+    fb_free(); // indices
+    fb_free(); // hash
 }
 
 void gif_close(FIL *fp) {
@@ -0,0 +1,122 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Sobel gradients.
+ *
+ * The gradients of an ROI are computed once and shared by the edge, line, circle, HoG and eye
+ * detectors, which used to run their own Sobel kernels on the same image.
+ */
+#include <string.h>
+#include "imlib.h"
+#include "fb_alloc.h"
+#include "simd.h"
+
+// Converts row y of the ROI to grayscale, or returns a pointer to it if it's grayscale already.
+static uint8_t *gradients_load_row(image_t *src, rectangle_t *roi, int y, uint8_t *buf) {
+    switch (src->pixfmt) {
+        case PIXFORMAT_BINARY: {
+            uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(src, y);
+            for (int x = 0; x < roi->w; x++) {
+                buf[x] = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, roi->x + x));
+            }
+            return buf;
+        }
+        case PIXFORMAT_GRAYSCALE: {
+            return IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, y) + roi->x;
+        }
+        case PIXFORMAT_RGB565: {
+            uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(src, y);
+            for (int x = 0; x < roi->w; x++) {
+                buf[x] = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, roi->x + x));
+            }
+            return buf;
+        }
+        default: {
+            memset(buf, 0, roi->w);
+            return buf;
+        }
+    }
+}
+
+void imlib_gradients_row(const uint8_t *r0, const uint8_t *r1, const uint8_t *r2, int w, gradient_t *out) {
+    int x = 1;
+
+    out[0] = (gradient_t) { 0, 0 };
+
+    #if defined(ARM_MATH_DSP)
+    // Two pixels per iteration, each row provides the left, middle and right pairs of pixels.
+    for (; x < (w - 2); x += 2) {
+        uint32_t a0 = *((uint32_t *) (r0 + x - 1));
+        uint32_t a1 = *((uint32_t *) (r1 + x - 1));
+        uint32_t a2 = *((uint32_t *) (r2 + x - 1));
+
+        uint32_t e0 = __UXTB16(a0), o0 = __UXTB16_RORn(a0, 8);
+        uint32_t e1 = __UXTB16(a1), o1 = __UXTB16_RORn(a1, 8);
+        uint32_t e2 = __UXTB16(a2), o2 = __UXTB16_RORn(a2, 8);
+
+        uint32_t l0 = __PKHBT(e0, o0, 16), m0 = __PKHBT(o0, e0, 0), r0_ = __PKHTB(o0, e0, 16);
+        uint32_t l1 = __PKHBT(e1, o1, 16), r1_ = __PKHTB(o1, e1, 16);
+        uint32_t l2 = __PKHBT(e2, o2, 16), m2 = __PKHBT(o2, e2, 0), r2_ = __PKHTB(o2, e2, 16);
+
+        // gx = (l0 - r0) + 2 * (l1 - r1) + (l2 - r2)
+        uint32_t d1 = __SSUB16(l1, r1_);
+        uint32_t gx = __SADD16(__SADD16(__SSUB16(l0, r0_), __SSUB16(l2, r2_)), __SADD16(d1, d1));
+        // gy = (l0 + 2 * m0 + r0) - (l2 + 2 * m2 + r2)
+        uint32_t s0 = __SADD16(__SADD16(l0, r0_), __SADD16(m0, m0));
+        uint32_t s2 = __SADD16(__SADD16(l2, r2_), __SADD16(m2, m2));
+        uint32_t gy = __SSUB16(s0, s2);
+
+        *((uint32_t *) (out + x + 0)) = __PKHBT(gx, gy, 16);
+        *((uint32_t *) (out + x + 1)) = __PKHTB(gy, gx, 16);
+    }
+    #endif
+
+    for (; x < (w - 1); x++) {
+        out[x].x = (r0[x - 1] - r0[x + 1]) + ((r1[x - 1] - r1[x + 1]) << 1) + (r2[x - 1] - r2[x + 1]);
+        out[x].y = (r0[x - 1] + (r0[x] << 1) + r0[x + 1]) - (r2[x - 1] + (r2[x] << 1) + r2[x + 1]);
+    }
+
+    if (w > 1) {
+        out[w - 1] = (gradient_t) { 0, 0 };
+    }
+}
+
+void imlib_find_gradients(image_t *src, rectangle_t *roi, gradient_t *data) {
+    uint8_t *bufs[3] = { NULL };
+
+    if (src->pixfmt != PIXFORMAT_GRAYSCALE) {
+        for (int i = 0; i < 3; i++) {
+            bufs[i] = fb_alloc(roi->w, FB_ALLOC_NO_HINT);
+        }
+    }
+
+    memset(data, 0, roi->w * sizeof(gradient_t));
+
+    if (roi->h > 2) {
+        // Each row is converted once, the buffers rotate with the rows.
+        uint8_t *r0 = gradients_load_row(src, roi, roi->y, bufs[0]);
+        uint8_t *r1 = gradients_load_row(src, roi, roi->y + 1, bufs[1]);
+
+        for (int y = 1; y < (roi->h - 1); y++) {
+            uint8_t *r2 = gradients_load_row(src, roi, roi->y + y + 1, bufs[(y + 1) % 3]);
+            imlib_gradients_row(r0, r1, r2, roi->w, data + (y * roi->w));
+            r0 = r1;
+            r1 = r2;
+        }
+    }
+
+    if (roi->h > 1) {
+        memset(data + ((roi->h - 1) * roi->w), 0, roi->w * sizeof(gradient_t));
+    }
+
+    if (src->pixfmt != PIXFORMAT_GRAYSCALE) {
+        for (int i = 0; i < 3; i++) {
+            fb_free();
+        }
+    }
+}
@@ -0,0 +1,366 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * 16-bit grayscale image functions.
+ *
+ * Thermal and high bit depth sensors output more than 8-bits per pixel, these functions work
+ * on the raw 16-bit values so the precision is kept until the image is drawn.
+ */
+#include <string.h>
+#include "imlib.h"
+#include "fb_alloc.h"
+
+#define GRAY16_HIST_BINS    (4096) // The histogram bins are wider if the range is larger.
+
+static inline bool gray16_threshold(int pixel, list_t *thresholds, bool invert) {
+    list_for_each(it, thresholds) {
+        gray16_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
+        if (((lnk_data->min <= pixel) && (pixel <= lnk_data->max)) ^ invert) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void imlib_gray16_get_min_max(image_t *ptr, rectangle_t *roi, int *min, int *max) {
+    int new_min = COLOR_GRAYSCALE16_MAX;
+    int new_max = COLOR_GRAYSCALE16_MIN;
+
+    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+        uint16_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(ptr, y);
+        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+            int pixel = row_ptr[x];
+            new_min = IM_MIN(new_min, pixel);
+            new_max = IM_MAX(new_max, pixel);
+        }
+    }
+
+    *min = new_min;
+    *max = new_max;
+}
+
+void imlib_gray16_to_grayscale(image_t *dst, image_t *src, rectangle_t *roi, int min, int max) {
+    // Maps [min, max] to [0, 255] in Q16.
+    int scale = (max > min) ? ((COLOR_GRAYSCALE_MAX << 16) / (max - min)) : 0;
+
+    for (int y = 0; y < roi->h; y++) {
+        uint16_t *src_row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(src, roi->y + y) + roi->x;
+        uint8_t *dst_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(dst, y);
+
+        for (int x = 0; x < roi->w; x++) {
+            int pixel = IM_CLAMP(src_row_ptr[x], min, max);
+            dst_row_ptr[x] = __USAT((((pixel - min) * scale) + 0x8000) >> 16, 8);
+        }
+    }
+}
+
+void imlib_gray16_copy(image_t *dst, image_t *src, rectangle_t *roi) {
+    // Rows only move towards the start of the buffer when cropping in place.
+    for (int y = 0; y < roi->h; y++) {
+        memmove(IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(dst, y),
+                IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(src, roi->y + y) + roi->x,
+                roi->w * sizeof(uint16_t));
+    }
+}
+
+void imlib_gray16_get_statistics(gray16_statistics_t *out, image_t *ptr, rectangle_t *roi,
+                                 int x_stride, int y_stride) {
+    int min = COLOR_GRAYSCALE16_MAX;
+    int max = COLOR_GRAYSCALE16_MIN;
+    uint64_t sum = 0, sum_sq = 0;
+    uint32_t count = 0;
+
+    memset(out, 0, sizeof(gray16_statistics_t));
+
+    // The first pass finds the range so the histogram only covers the values in the image.
+    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
+        uint16_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(ptr, y);
+        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
+            uint32_t pixel = row_ptr[x];
+            min = IM_MIN(min, (int) pixel);
+            max = IM_MAX(max, (int) pixel);
+            sum += pixel;
+            sum_sq += pixel * pixel;
+            count += 1;
+        }
+    }
+
+    if (!count) {
+        return;
+    }
+
+    int shift = 0;
+    while (((max - min) >> shift) >= GRAY16_HIST_BINS) {
+        shift += 1;
+    }
+
+    int bins = ((max - min) >> shift) + 1;
+    uint32_t *hist = fb_alloc0(bins * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+
+    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
+        uint16_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(ptr, y);
+        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
+            hist[(row_ptr[x] - min) >> shift] += 1;
+        }
+    }
+
+    // Values are the center of the bins, which are exact if the range fits.
+    int half = (1 << shift) >> 1;
+    uint32_t acc = 0, mode_count = 0;
+    uint64_t lq = count, median = count * 2ULL, uq = count * 3ULL;
+    bool lq_found = false, median_found = false, uq_found = false;
+
+    for (int i = 0; i < bins; i++) {
+        int value = IM_MIN(min + (i << shift) + half, max);
+
+        if (hist[i] > mode_count) {
+            mode_count = hist[i];
+            out->mode = value;
+        }
+
+        acc += hist[i];
+
+        if ((!lq_found) && ((acc * 4ULL) >= lq)) {
+            out->lq = value;
+            lq_found = true;
+        }
+
+        if ((!median_found) && ((acc * 4ULL) >= median)) {
+            out->median = value;
+            median_found = true;
+        }
+
+        if ((!uq_found) && ((acc * 4ULL) >= uq)) {
+            out->uq = value;
+            uq_found = true;
+        }
+    }
+
+    fb_free(); // hist
+
+    float mean = ((float) sum) / count;
+    float variance = (((float) sum_sq) / count) - (mean * mean);
+    out->mean = fast_roundf(mean);
+    out->stdev = fast_roundf(fast_sqrtf(IM_MAX(variance, 0.0f)));
+    out->min = min;
+    out->max = max;
+}
+
+#ifdef IMLIB_ENABLE_BINARY_OPS
+void imlib_gray16_binary(image_t *out, image_t *img, list_t *thresholds, bool invert, bool zero, image_t *mask) {
+    if (out->pixfmt == PIXFORMAT_BINARY) {
+        // A bitmap row is smaller than a 16-bit row so the rows can be converted in place.
+        uint32_t *bmp_row_ptr = fb_alloc(IMAGE_BINARY_LINE_LEN_BYTES(out), FB_ALLOC_NO_HINT);
+
+        for (int y = 0, yy = img->h; y < yy; y++) {
+            uint16_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(img, y);
+            memset(bmp_row_ptr, 0, IMAGE_BINARY_LINE_LEN_BYTES(out));
+
+            for (int x = 0, xx = img->w; x < xx; x++) {
+                if (gray16_threshold(row_ptr[x], thresholds, invert)) {
+                    IMAGE_SET_BINARY_PIXEL_FAST(bmp_row_ptr, x);
+                }
+            }
+
+            memcpy(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(out, y), bmp_row_ptr, IMAGE_BINARY_LINE_LEN_BYTES(out));
+        }
+
+        fb_free(); // bmp_row_ptr
+        return;
+    }
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        uint16_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(img, y);
+        uint16_t *out_row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(out, y);
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            int pixel = row_ptr[x];
+
+            if ((!mask) || image_get_mask_pixel(mask, x, y)) {
+                bool match = gray16_threshold(pixel, thresholds, invert);
+
+                if (zero) {
+                    pixel = match ? COLOR_GRAYSCALE16_MIN : pixel;
+                } else {
+                    pixel = match ? COLOR_GRAYSCALE16_MAX : COLOR_GRAYSCALE16_MIN;
+                }
+            }
+
+            out_row_ptr[x] = pixel;
+        }
+    }
+}
+#endif // IMLIB_ENABLE_BINARY_OPS
+
+#if defined(IMLIB_ENABLE_MEAN) || defined(IMLIB_ENABLE_MEDIAN)
+// Filters write to a buffer of ksize + 1 rows, the rows are copied back once they are no
+// longer part of any window.
+static void gray16_filter_flush(image_t *img, image_t *buf, int y, int ksize) {
+    if (y >= ksize) {
+        memcpy(IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(img, y - ksize),
+               IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(buf, (y - ksize) % buf->h),
+               IMAGE_GRAYSCALE16_LINE_LEN_BYTES(img));
+    }
+}
+
+static void gray16_filter_flush_remaining(image_t *img, image_t *buf, int ksize) {
+    for (int y = IM_MAX(img->h - ksize, 0), yy = img->h; y < yy; y++) {
+        memcpy(IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(img, y),
+               IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(buf, y % buf->h),
+               IMAGE_GRAYSCALE16_LINE_LEN_BYTES(img));
+    }
+}
+
+static inline int gray16_filter_threshold(int pixel, int src, bool threshold, int offset, bool invert) {
+    if (threshold) {
+        return (((pixel - offset) < src) ^ invert) ? COLOR_GRAYSCALE16_MAX : COLOR_GRAYSCALE16_MIN;
+    }
+
+    return pixel;
+}
+#endif // defined(IMLIB_ENABLE_MEAN) || defined(IMLIB_ENABLE_MEDIAN)
+
+#ifdef IMLIB_ENABLE_MEAN
+void imlib_gray16_mean_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask) {
+    int n = ((ksize * 2) + 1) * ((ksize * 2) + 1);
+    image_t buf = {
+        .w = img->w,
+        .h = ksize + 1,
+        .pixfmt = PIXFORMAT_GRAYSCALE16,
+    };
+    buf.data = fb_alloc(image_size(&buf), FB_ALLOC_NO_HINT);
+
+    // Column sums of the window rows, updated as the window moves down.
+    uint32_t *col_sums = fb_alloc(img->w * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+
+    for (int x = 0; x < img->w; x++) {
+        uint32_t acc = 0;
+        for (int j = -ksize; j <= ksize; j++) {
+            acc += IMAGE_GET_GRAYSCALE16_PIXEL(img, x, IM_CLAMP(j, 0, img->h - 1));
+        }
+        col_sums[x] = acc;
+    }
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        uint16_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(img, y);
+        uint16_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(&buf, y % buf.h);
+        uint32_t acc = 0;
+
+        for (int k = -ksize; k <= ksize; k++) {
+            acc += col_sums[IM_CLAMP(k, 0, img->w - 1)];
+        }
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            if (x) {
+                acc += col_sums[IM_MIN(x + ksize, img->w - 1)] - col_sums[IM_MAX(x - ksize - 1, 0)];
+            }
+
+            if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                buf_row_ptr[x] = row_ptr[x];
+                continue; // Short circuit.
+            }
+
+            int pixel = (acc + (n / 2)) / n;
+            buf_row_ptr[x] = gray16_filter_threshold(pixel, row_ptr[x], threshold, offset, invert);
+        }
+
+        // The rows leaving and entering the window are still unfiltered.
+        if ((y + 1) < img->h) {
+            uint16_t *old_row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(img, IM_MAX(y - ksize, 0));
+            uint16_t *new_row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(img, IM_MIN(y + ksize + 1, img->h - 1));
+            for (int x = 0; x < img->w; x++) {
+                col_sums[x] += new_row_ptr[x] - old_row_ptr[x];
+            }
+        }
+
+        gray16_filter_flush(img, &buf, y, ksize);
+    }
+
+    gray16_filter_flush_remaining(img, &buf, ksize);
+    fb_free(); // col_sums
+    fb_free(); // buf.data
+}
+#endif // IMLIB_ENABLE_MEAN
+
+#ifdef IMLIB_ENABLE_MEDIAN
+// Returns the k-th smallest value, the array is reordered.
+static int gray16_select(uint16_t *data, int n, int k) {
+    int lo = 0, hi = n - 1;
+
+    while (lo < hi) {
+        int pivot = data[(lo + hi) / 2];
+        int i = lo, j = hi;
+
+        while (i <= j) {
+            while (data[i] < pivot) {
+                i++;
+            }
+            while (data[j] > pivot) {
+                j--;
+            }
+            if (i <= j) {
+                uint16_t tmp = data[i];
+                data[i++] = data[j];
+                data[j--] = tmp;
+            }
+        }
+
+        if (k <= j) {
+            hi = j;
+        } else if (k >= i) {
+            lo = i;
+        } else {
+            break;
+        }
+    }
+
+    return data[k];
+}
+
+void imlib_gray16_median_filter(image_t *img, const int ksize, float percentile, bool threshold, int offset,
+                                bool invert, image_t *mask) {
+    int n = ((ksize * 2) + 1) * ((ksize * 2) + 1);
+    int k = fast_roundf((n - 1) * percentile);
+    image_t buf = {
+        .w = img->w,
+        .h = ksize + 1,
+        .pixfmt = PIXFORMAT_GRAYSCALE16,
+    };
+    buf.data = fb_alloc(image_size(&buf), FB_ALLOC_NO_HINT);
+    uint16_t *window = fb_alloc(n * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+
+    for (int y = 0, yy = img->h; y < yy; y++) {
+        uint16_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(img, y);
+        uint16_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(&buf, y % buf.h);
+
+        for (int x = 0, xx = img->w; x < xx; x++) {
+            if (mask && (!image_get_mask_pixel(mask, x, y))) {
+                buf_row_ptr[x] = row_ptr[x];
+                continue; // Short circuit.
+            }
+
+            for (int j = -ksize, i = 0; j <= ksize; j++) {
+                uint16_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(img, IM_CLAMP(y + j, 0, img->h - 1));
+                for (int l = -ksize; l <= ksize; l++) {
+                    window[i++] = k_row_ptr[IM_CLAMP(x + l, 0, img->w - 1)];
+                }
+            }
+
+            int pixel = gray16_select(window, n, k);
+            buf_row_ptr[x] = gray16_filter_threshold(pixel, row_ptr[x], threshold, offset, invert);
+        }
+
+        gray16_filter_flush(img, &buf, y, ksize);
+    }
+
+    gray16_filter_flush_remaining(img, &buf, ksize);
+    fb_free(); // window
+    fb_free(); // buf.data
+}
+#endif // IMLIB_ENABLE_MEDIAN
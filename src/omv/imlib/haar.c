@@ -10,16 +10,159 @@
  * Based on the work of Francesco Comaschi (f.comaschi@tue.nl)
  */
 #include <stdio.h>
+#include <float.h>
 #include "py/obj.h"
 #include "py/nlr.h"
 
 #include "xalloc.h"
 #include "imlib.h"
-// built-in cascades
-#include "cascade.h"
 #include "file_utils.h"
 
 #ifdef IMLIB_ENABLE_FEATURES
+// A cascade compiled into flash, generated by ml/haarcascade/cascade_convert.py --header.
+// Loading it only points the cascade at the tables, nothing is parsed or copied to RAM.
+typedef struct haar_cascade_rom {
+    const char *name;
+    int window_w;
+    int window_h;
+    int n_stages;
+    int n_features;
+    int n_rectangles;
+    const uint8_t *stages_array;
+    const int16_t *stages_thresh_array;
+    const int16_t *tree_thresh_array;
+    const int16_t *alpha1_array;
+    const int16_t *alpha2_array;
+    const int8_t *num_rectangles_array;
+    const int8_t *weights_array;
+    const int8_t *rectangles_array;
+} haar_cascade_rom_t;
+
+// built-in cascades
+#include "cascade.h"
+
+static const haar_cascade_rom_t *const haar_cascades_rom[] = {
+    #ifdef IMLIB_ENABLE_FEATURES_BUILTIN_FACE_CASCADE
+    &frontalface_cascade,
+    #endif
+    #ifdef IMLIB_ENABLE_FEATURES_BUILTIN_EYES_CASCADE
+    &eye_cascade,
+    #endif
+    NULL
+};
+
+// The first stages reject most windows. Their features are packed in evaluation order and run
+// over all the windows of a row at once, so each feature is decoded once per row.
+#define HAAR_EARLY_FEATURES_MAX     (64)
+#define HAAR_NODE_RECTS_MAX         (3)
+
+typedef struct haar_node {
+    int16_t thresh;
+    int16_t alpha1;
+    int16_t alpha2;
+    int8_t n_rects;
+    struct {
+        int8_t x, y, w, h;
+        int32_t weight;                 // Pre-shifted weight.
+    } rects[HAAR_NODE_RECTS_MAX];
+} haar_node_t;
+
+static void haar_pack_early_stages(cascade_t *cascade) {
+    int n_stages = 0;
+    int n_features = 0;
+
+    for (int i = 0, t_idx = 0; i < cascade->n_stages; i++) {
+        bool ok = (n_features + cascade->stages_array[i]) <= HAAR_EARLY_FEATURES_MAX;
+
+        for (int j = 0; ok && (j < cascade->stages_array[i]); j++) {
+            ok = cascade->num_rectangles_array[t_idx + j] <= HAAR_NODE_RECTS_MAX;
+        }
+
+        if (!ok) {
+            break;
+        }
+
+        n_stages += 1;
+        n_features += cascade->stages_array[i];
+        t_idx += cascade->stages_array[i];
+    }
+
+    cascade->n_early_stages = 0;
+    cascade->early_nodes = n_features ? xalloc_try_alloc(n_features * sizeof(haar_node_t)) : NULL;
+
+    if (!cascade->early_nodes) {
+        return;
+    }
+
+    haar_node_t *node = cascade->early_nodes;
+    for (int t_idx = 0, w_idx = 0; t_idx < n_features; t_idx++, node++) {
+        node->thresh = cascade->tree_thresh_array[t_idx];
+        node->alpha1 = cascade->alpha1_array[t_idx];
+        node->alpha2 = cascade->alpha2_array[t_idx];
+        node->n_rects = cascade->num_rectangles_array[t_idx];
+
+        for (int i = 0; i < node->n_rects; i++, w_idx++) {
+            node->rects[i].x = cascade->rectangles_array[(w_idx << 2) + 0];
+            node->rects[i].y = cascade->rectangles_array[(w_idx << 2) + 1];
+            node->rects[i].w = cascade->rectangles_array[(w_idx << 2) + 2];
+            node->rects[i].h = cascade->rectangles_array[(w_idx << 2) + 3];
+            node->rects[i].weight = cascade->weights_array[w_idx] << 12;
+        }
+    }
+
+    cascade->n_early_stages = n_stages;
+}
+
+// Runs the packed early stages over n windows of the current row, returns the windows left.
+static int run_early_stages(cascade_t *cascade, const int32_t *stage_thresh,
+                            uint16_t *win_x, int32_t *win_std, int32_t *win_sum, int n) {
+    uint32_t **data = cascade->sum->data;
+    haar_node_t *node = cascade->early_nodes;
+    int n_stages = IM_MIN(cascade->n_early_stages, cascade->n_stages);
+
+    for (int s = 0; (s < n_stages) && n; s++) {
+        memset(win_sum, 0, n * sizeof(int32_t));
+
+        for (int j = 0; j < cascade->stages_array[s]; j++, node++) {
+            const uint32_t *top[HAAR_NODE_RECTS_MAX], *bottom[HAAR_NODE_RECTS_MAX];
+            int rw[HAAR_NODE_RECTS_MAX];
+
+            for (int k = 0; k < node->n_rects; k++) {
+                top[k] = data[node->rects[k].y] + node->rects[k].x;
+                bottom[k] = data[node->rects[k].y + node->rects[k].h] + node->rects[k].x;
+                rw[k] = node->rects[k].w;
+            }
+
+            for (int i = 0; i < n; i++) {
+                int x = win_x[i];
+                int32_t sumw = 0;
+
+                for (int k = 0; k < node->n_rects; k++) {
+                    int32_t area = bottom[k][x + rw[k]] + top[k][x] - top[k][x + rw[k]] - bottom[k][x];
+                    sumw += area * node->rects[k].weight;
+                }
+
+                /* The node threshold is multiplied by the standard deviation of the sub window */
+                win_sum[i] += (sumw >= (node->thresh * win_std[i])) ? node->alpha2 : node->alpha1;
+            }
+        }
+
+        // Drop the windows below the stage threshold, in order.
+        int m = 0;
+        for (int i = 0; i < n; i++) {
+            if (win_sum[i] >= stage_thresh[s]) {
+                win_x[m] = win_x[i];
+                win_std[m] = win_std[i];
+                m++;
+            }
+        }
+
+        n = m;
+    }
+
+    return n;
+}
+
 static int eval_weak_classifier(cascade_t *cascade, point_t pt, int t_idx, int w_idx, int r_idx) {
     int32_t sumw = 0;
     mw_image_t *sum = cascade->sum;
@@ -43,22 +186,18 @@ static int eval_weak_classifier(cascade_t *cascade, point_t pt, int t_idx, int w
     return cascade->alpha1_array[t_idx];
 }
 
-static int run_cascade_classifier(cascade_t *cascade, point_t pt) {
-    int win_w = cascade->window.w;
-    int win_h = cascade->window.h;
-    uint32_t n = (win_w * win_h);
-    uint32_t i_s = imlib_integral_mw_lookup(cascade->sum, pt.x, 0, win_w, win_h);
-    uint32_t i_sq = imlib_integral_mw_lookup(cascade->ssq, pt.x, 0, win_w, win_h);
-    uint32_t m = i_s / n;
-    uint32_t v = i_sq / n - (m * m);
-
-    // Skip homogeneous regions.
-    if (v < (50 * 50)) {
-        return 0;
+// Runs the remaining stages on a window that passed the early stages.
+static int run_cascade_classifier(cascade_t *cascade, const int32_t *stage_thresh, point_t pt) {
+    int w_idx = 0, t_idx = 0;
+    int start = IM_MIN(cascade->early_nodes ? cascade->n_early_stages : 0, cascade->n_stages);
+
+    for (int i = 0; i < start; i++) {
+        for (int j = 0; j < cascade->stages_array[i]; j++, t_idx++) {
+            w_idx += cascade->num_rectangles_array[t_idx];
+        }
     }
 
-    cascade->std = fast_sqrtf(i_sq * n - (i_s * i_s));
-    for (int i = 0, w_idx = 0, r_idx = 0, t_idx = 0; i < cascade->n_stages; i++) {
+    for (int i = start, r_idx = w_idx * 4; i < cascade->n_stages; i++) {
         int stage_sum = 0;
         for (int j = 0; j < cascade->stages_array[i]; j++, t_idx++) {
             // Send the shifted window to a haar filter
@@ -67,24 +206,20 @@ static int run_cascade_classifier(cascade_t *cascade, point_t pt) {
             r_idx += cascade->num_rectangles_array[t_idx] * 4;
         }
         // If the sum is below the stage threshold, no objects were detected
-        if (stage_sum < (cascade->threshold * cascade->stages_thresh_array[i])) {
+        if (stage_sum < stage_thresh[i]) {
             return 0;
         }
     }
     return 1;
 }
 
-array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *roi) {
+// Scans roi at the pyramid scales in [min_factor, max_factor] and appends the detections.
+static void haar_scan(image_t *image, cascade_t *cascade, const int32_t *stage_thresh,
+                      rectangle_t *roi, float min_factor, float max_factor, array_t *objects) {
     // Integral images
     mw_image_t sum;
     mw_image_t ssq;
 
-    // Detected objects array
-    array_t *objects;
-
-    // Allocate the objects array
-    array_alloc(&objects, xfree);
-
     // Set cascade image pointers
     cascade->img = image;
     cascade->sum = &sum;
@@ -105,8 +240,17 @@ array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *r
     imlib_integral_mw_alloc(&sum, roi->w, cascade->window.h + 1);
     imlib_integral_mw_alloc(&ssq, roi->w, cascade->window.h + 1);
 
+    // Windows of the current row that are still being evaluated.
+    uint16_t *win_x = fb_alloc(roi->w * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    int32_t *win_std = fb_alloc(roi->w * sizeof(int32_t), FB_ALLOC_NO_HINT);
+    int32_t *win_sum = fb_alloc(roi->w * sizeof(int32_t), FB_ALLOC_NO_HINT);
+
+    int win_w = cascade->window.w;
+    int win_h = cascade->window.h;
+    uint32_t win_n = (win_w * win_h);
+
     // Iterate over the image pyramid
-    for (float factor = 1.0f; ; factor *= cascade->scale_factor) {
+    for (float factor = 1.0f; factor <= max_factor; factor *= cascade->scale_factor) {
         // Set the scaled width and height
         int szw = roi->w / factor;
         int szh = roi->h / factor;
@@ -116,6 +260,14 @@ array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *r
             break;
         }
 
+        // Scale the scanning step
+        cascade->step = cascade->step / factor;
+        cascade->step = (cascade->step == 0) ? 1 : cascade->step;
+
+        if (factor < min_factor) {
+            continue;
+        }
+
         // Set the integral images scale
         imlib_integral_mw_scale(roi, &sum, szw, szh);
         imlib_integral_mw_scale(roi, &ssq, szw, szh);
@@ -123,10 +275,6 @@ array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *r
         // Compute new scaled integral images
         imlib_integral_mw_ss(image, &sum, &ssq, roi);
 
-        // Scale the scanning step
-        cascade->step = cascade->step / factor;
-        cascade->step = (cascade->step == 0) ? 1 : cascade->step;
-
         // Process image at the current scale
         // When filter window shifts to borders, some margin need to be kept
         int y2 = szh - cascade->window.h;
@@ -134,12 +282,35 @@ array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *r
 
         // Shift the filter window over the image.
         for (int y = 0; y < y2; y += cascade->step) {
+            int n = 0;
+
             for (int x = 0; x < x2; x += cascade->step) {
-                point_t p = {x, y};
+                uint32_t i_s = imlib_integral_mw_lookup(&sum, x, 0, win_w, win_h);
+                uint32_t i_sq = imlib_integral_mw_lookup(&ssq, x, 0, win_w, win_h);
+                uint32_t m = i_s / win_n;
+                uint32_t v = i_sq / win_n - (m * m);
+
+                // Skip homogeneous regions.
+                if (v < (50 * 50)) {
+                    continue;
+                }
+
+                win_x[n] = x;
+                win_std[n] = fast_sqrtf(i_sq * win_n - (i_s * i_s));
+                n++;
+            }
+
+            if (cascade->early_nodes) {
+                n = run_early_stages(cascade, stage_thresh, win_x, win_std, win_sum, n);
+            }
+
+            for (int i = 0; i < n; i++) {
+                point_t p = {win_x[i], y};
+                cascade->std = win_std[i];
                 // If an object is detected, record the coordinates of the filter window
-                if (run_cascade_classifier(cascade, p) > 0) {
+                if (run_cascade_classifier(cascade, stage_thresh, p) > 0) {
                     array_push_back(objects,
-                                    rectangle_alloc(fast_roundf(x * factor) + roi->x, fast_roundf(y * factor) + roi->y,
+                                    rectangle_alloc(fast_roundf(p.x * factor) + roi->x, fast_roundf(y * factor) + roi->y,
                                                     fast_roundf(cascade->window.w * factor),
                                                     fast_roundf(cascade->window.h * factor)));
                 }
@@ -152,14 +323,78 @@ array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *r
         }
     }
 
+    fb_free(); // win_sum
+    fb_free(); // win_std
+    fb_free(); // win_x
     imlib_integral_mw_free(&ssq);
     imlib_integral_mw_free(&sum);
+}
+
+// Scans a region twice the size of each tracked object at the neighbouring scales only.
+static void haar_scan_tracks(image_t *image, cascade_t *cascade, const int32_t *stage_thresh,
+                             rectangle_t *roi, array_t *objects) {
+    for (int i = 0; i < cascade->n_tracks; i++) {
+        rectangle_t *t = &cascade->tracks[i];
+        int x1 = IM_MAX(t->x - (t->w / 2), roi->x);
+        int y1 = IM_MAX(t->y - (t->h / 2), roi->y);
+        int x2 = IM_MIN(t->x + t->w + (t->w / 2), roi->x + roi->w);
+        int y2 = IM_MIN(t->y + t->h + (t->h / 2), roi->y + roi->h);
+        rectangle_t region = {x1, y1, x2 - x1, y2 - y1};
+
+        if ((region.w <= cascade->window.w) || (region.h <= cascade->window.h)) {
+            continue;
+        }
+
+        // The pyramid of the region starts at 1.0 like the full scan, so it runs on the same scales.
+        float factor = (float) t->w / cascade->window.w;
+        haar_scan(image, cascade, stage_thresh, &region,
+                  (factor / cascade->scale_factor) * 0.99f,
+                  (factor * cascade->scale_factor) * 1.01f, objects);
+    }
+}
+
+array_t *imlib_detect_objects(image_t *image, cascade_t *cascade, rectangle_t *roi) {
+    // Detected objects array
+    array_t *objects;
+
+    // Allocate the objects array
+    array_alloc(&objects, xfree);
+
+    // The stage sums are integers, so compare them against the rounded up thresholds.
+    int32_t *stage_thresh = fb_alloc(cascade->n_stages * sizeof(int32_t), FB_ALLOC_NO_HINT);
+    for (int i = 0; i < cascade->n_stages; i++) {
+        stage_thresh[i] = ceilf(cascade->threshold * cascade->stages_thresh_array[i]);
+    }
+
+    bool tracking = (cascade->track_interval > 0) && (cascade->n_tracks > 0) &&
+                    (cascade->track_frames < cascade->track_interval);
+
+    if (tracking) {
+        haar_scan_tracks(image, cascade, stage_thresh, roi, objects);
+        cascade->track_frames += 1;
+    }
+
+    // Fall back to a full scan when the tracked objects are lost.
+    if (!array_length(objects)) {
+        haar_scan(image, cascade, stage_thresh, roi, 0.0f, FLT_MAX, objects);
+        cascade->track_frames = 0;
+    }
+
+    fb_free(); // stage_thresh
 
     if (array_length(objects) > 1) {
         // Merge objects detected at different scales
         objects = rectangle_merge(objects);
     }
 
+    // Track the objects found in the next frames.
+    cascade->n_tracks = 0;
+    for (int i = 0; (cascade->track_interval > 0) && (i < array_length(objects)); i++) {
+        if (cascade->n_tracks < HAAR_TRACKS_MAX) {
+            cascade->tracks[cascade->n_tracks++] = *((rectangle_t *) array_at(objects, i));
+        }
+    }
+
     return objects;
 }
 
@@ -249,55 +484,47 @@ error:
 #endif //(IMLIB_ENABLE_IMAGE_FILE_IO)
 
 int imlib_load_cascade(cascade_t *cascade, const char *path) {
-    // built-in cascade
-    if (0) {
-    #ifdef IMLIB_ENABLE_FEATURES_BUILTIN_FACE_CASCADE
-    } else if (strcmp(path, "frontalface") == 0) {
-        cascade->window.w = frontalface_window_w;
-        cascade->window.h = frontalface_window_h;
-        cascade->n_stages = frontalface_n_stages;
-        cascade->stages_array = (uint8_t *) frontalface_stages_array;
-        cascade->stages_thresh_array = (int16_t *) frontalface_stages_thresh_array;
-        cascade->tree_thresh_array = (int16_t *) frontalface_tree_thresh_array;
-        cascade->alpha1_array = (int16_t *) frontalface_alpha1_array;
-        cascade->alpha2_array = (int16_t *) frontalface_alpha2_array;
-        cascade->num_rectangles_array = (int8_t *) frontalface_num_rectangles_array;
-        cascade->weights_array = (int8_t *) frontalface_weights_array;
-        cascade->rectangles_array = (int8_t *) frontalface_rectangles_array;
-    #endif
-    #ifdef IMLIB_ENABLE_FEATURES_BUILTIN_EYES_CASCADE
-    } else if (strcmp(path, "eye") == 0) {
-        cascade->window.w = eye_window_w;
-        cascade->window.h = eye_window_h;
-        cascade->n_stages = eye_n_stages;
-        cascade->stages_array = (uint8_t *) eye_stages_array;
-        cascade->stages_thresh_array = (int16_t *) eye_stages_thresh_array;
-        cascade->tree_thresh_array = (int16_t *) eye_tree_thresh_array;
-        cascade->alpha1_array = (int16_t *) eye_alpha1_array;
-        cascade->alpha2_array = (int16_t *) eye_alpha2_array;
-        cascade->num_rectangles_array = (int8_t *) eye_num_rectangles_array;
-        cascade->weights_array = (int8_t *) eye_weights_array;
-        cascade->rectangles_array = (int8_t *) eye_rectangles_array;
-    #endif
+    const haar_cascade_rom_t *rom = NULL;
+
+    for (int i = 0; haar_cascades_rom[i]; i++) {
+        if (strcmp(path, haar_cascades_rom[i]->name) == 0) {
+            rom = haar_cascades_rom[i];
+            break;
+        }
+    }
+
+    if (rom) {
+        // built-in cascade
+        cascade->window.w = rom->window_w;
+        cascade->window.h = rom->window_h;
+        cascade->n_stages = rom->n_stages;
+        cascade->n_features = rom->n_features;
+        cascade->n_rectangles = rom->n_rectangles;
+        cascade->stages_array = (uint8_t *) rom->stages_array;
+        cascade->stages_thresh_array = (int16_t *) rom->stages_thresh_array;
+        cascade->tree_thresh_array = (int16_t *) rom->tree_thresh_array;
+        cascade->alpha1_array = (int16_t *) rom->alpha1_array;
+        cascade->alpha2_array = (int16_t *) rom->alpha2_array;
+        cascade->num_rectangles_array = (int8_t *) rom->num_rectangles_array;
+        cascade->weights_array = (int8_t *) rom->weights_array;
+        cascade->rectangles_array = (int8_t *) rom->rectangles_array;
     } else {
         #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
         // xml cascade
-        return imlib_load_cascade_from_file(cascade, path);
+        int res = imlib_load_cascade_from_file(cascade, path);
+        if (res != FR_OK) {
+            return res;
+        }
         #else
         return -1;
         #endif
     }
 
-    int i;
-    // sum the number of features in all stages
-    for (i = 0, cascade->n_features = 0; i < cascade->n_stages; i++) {
-        cascade->n_features += cascade->stages_array[i];
-    }
+    cascade->n_tracks = 0;
+    cascade->track_frames = 0;
+    cascade->track_interval = 0;
 
-    // sum the number of recatngles in all features
-    for (i = 0, cascade->n_rectangles = 0; i < cascade->n_features; i++) {
-        cascade->n_rectangles += cascade->num_rectangles_array[i];
-    }
+    haar_pack_early_stages(cascade);
     return FR_OK;
 }
 #endif // IMLIB_ENABLE_FEATURES
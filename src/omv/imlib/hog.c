@@ -8,6 +8,11 @@
  *
  * HoG.
  * See Histograms of Oriented Gradients (Navneet Dalal and Bill Triggs)
+ *
+ * Cell histograms are computed once per frame with integer gradients. Blocks of 2x2 cells with a
+ * stride of 1 cell are L2-Hys normalized once, so the descriptor of any window aligned to the
+ * cell grid is the concatenation of the blocks it covers. Coarser levels of the feature pyramid
+ * reuse the cell histograms by merging 2x2 cells.
  */
 #include <stdio.h>
 #include <math.h>
@@ -17,120 +22,181 @@
 #include "xalloc.h"
 
 #ifdef IMLIB_ENABLE_HOG
-#define N_BINS    (9)
-typedef struct bin {
-    int d;
-    int m;
-} bin_t;
-
-int bin_array_comp(const void *obj0, const void *obj1) {
-    const bin_t *b0 = obj0;
-    const bin_t *b1 = obj1;
-    if (b0->m < b1->m) {
-        return -1;
+#define HOG_BIN_DEGREES (180 / HOG_BINS)
+#define HOG_CLIP        (0.2f) // L2-Hys clipping.
+
+// Q14 cos/sin of the bin boundaries (20, 40, ..., 160 degrees).
+static const int16_t hog_boundaries[HOG_BINS - 1][2] = {
+    {  15396,  5604 }, {  12551, 10531 }, {   8192, 14189 }, {  2845, 16135 },
+    {  -2845, 16135 }, {  -8192, 14189 }, { -12551, 10531 }, { -15396, 5604 },
+};
+
+static inline int hog_bin(int vx, int vy) {
+    // Unsigned gradients, fold the angle into [0, 180).
+    if ((vy < 0) || ((vy == 0) && (vx < 0))) {
+        vx = -vx;
+        vy = -vy;
     }
-    if (b0->m > b1->m) {
-        return 1;
+
+    // The angle is past a boundary when the gradient is on the left of the boundary direction.
+    int bin = 0;
+    for (int i = 0; i < (HOG_BINS - 1); i++) {
+        bin += ((vy * hog_boundaries[i][0]) - (vx * hog_boundaries[i][1])) >= 0;
     }
 
-    return 0;
+    return bin;
+}
+
+static inline int hog_magnitude(int vx, int vy) {
+    // Alpha max plus beta min approximation of sqrt(vx^2 + vy^2) (max error ~7%).
+    int ax = abs(vx), ay = abs(vy);
+    int mx = IM_MAX(ax, ay), mn = IM_MIN(ax, ay);
+    return mx + ((mn * 3) >> 3);
 }
 
-void imlib_find_hog(image_t *src, rectangle_t *roi, int cell_size) {
-    int s = src->w;
-    int w = roi->x + roi->w - 1;
-    int h = roi->y + roi->h - 1;
-
-    int block_size = cell_size * 2;
-    int x_cells = (roi->w / cell_size);
-    int y_cells = (roi->h / cell_size);
-
-    // TODO: Assert row->w/h >= cell_size *2;
-    float *hog = fb_alloc0(x_cells * y_cells * N_BINS * sizeof *hog, FB_ALLOC_NO_HINT);
-
-    //2. Finding Image Gradients
-    for (int y = roi->y, hog_index = 0; y < h; y += block_size) {
-        for (int x = roi->x; x < w; x += block_size) {
-            float k = 0.0f;
-            for (int cy = 0; cy < block_size; cy++) {
-                for (int cx = 0; cx < block_size; cx++) {
-                    if ((y + cy) > 0 && (y + cy) < h && (x + cx) > 0 && (x + cx) < w) {
-                        // Find horizontal/vertical direction
-                        int vx = src->data[(y + cy + 0) * s + (x + cx + 1)] - src->data[(y + cy - 0) * s + (x + cx - 1)];
-                        int vy = src->data[(y + cy + 1) * s + (x + cx + 0)] - src->data[(y + cy - 1) * s + (x + cx - 0)];
-                        // Find magnitude
-                        float m = fast_sqrtf(vx * vx + vy * vy);
-                        if (((int) m) > 1) {
-                            k += m * m;
-                            // Find and quantize gradient degree
-                            // TODO atan2f is swapped for visualization
-                            int t = ((int) fast_fabsf((atan2f(vx, vy) * 180.0f / M_PI))) / 20;
-                            t = (t == 9)? 0 : t;
-
-                            // hog[((cy/cell_size) * x_cells + (cx/cell_size)) * N_BINS + t] += m;
-                            hog[hog_index + (((cy / 8) * 2 + (cx / 8)) * N_BINS) + t] += m;
-                        }
+void imlib_hog_cells(image_t *src, rectangle_t *roi, int cell_size, uint32_t *cells, gradients_t *gradients) {
+    int x_cells = roi->w / cell_size;
+    int y_cells = roi->h / cell_size;
+    int w_end = src->w - 1;
+    int h_end = src->h - 1;
+
+    memset(cells, 0, x_cells * y_cells * HOG_BINS * sizeof(uint32_t));
+
+    if (gradients) {
+        // Sobel gradients, the sign and scale don't matter after folding and normalization.
+        for (int cy = 0; cy < y_cells; cy++) {
+            for (int j = 0; j < cell_size; j++) {
+                int y = roi->y + (cy * cell_size) + j;
+                gradient_t *g = imlib_gradients_at(gradients, roi->x, y);
+                uint32_t *cell = cells + (cy * x_cells * HOG_BINS);
+
+                for (int cx = 0; cx < x_cells; cx++, cell += HOG_BINS) {
+                    for (int i = 0; i < cell_size; i++, g++) {
+                        cell[hog_bin(g->x, g->y)] += hog_magnitude(g->x, g->y);
                     }
                 }
             }
+        }
+        return;
+    }
 
-            // Normalize the last block
-            k = sqrtf(k);
-            for (int i = hog_index; i < (hog_index + (N_BINS * 4)); i++) {
-                hog[i] = hog[i] / k;
+    for (int cy = 0; cy < y_cells; cy++) {
+        for (int j = 0; j < cell_size; j++) {
+            int y = roi->y + (cy * cell_size) + j;
+            uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, y);
+            uint8_t *row_ptr_u = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, IM_MAX(y - 1, 0));
+            uint8_t *row_ptr_d = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, IM_MIN(y + 1, h_end));
+            uint32_t *cell = cells + (cy * x_cells * HOG_BINS);
+
+            for (int cx = 0; cx < x_cells; cx++, cell += HOG_BINS) {
+                for (int i = 0, x = roi->x + (cx * cell_size); i < cell_size; i++, x++) {
+                    int vx = row_ptr[IM_MIN(x + 1, w_end)] - row_ptr[IM_MAX(x - 1, 0)];
+                    int vy = row_ptr_d[x] - row_ptr_u[x];
+                    cell[hog_bin(vx, vy)] += hog_magnitude(vx, vy);
+                }
             }
+        }
+    }
+}
 
-            hog_index += (N_BINS * 4);
+void imlib_hog_cells_downscale(int *x_cells, int *y_cells, uint32_t *cells) {
+    int x_cells_2 = *x_cells / 2;
+    int y_cells_2 = *y_cells / 2;
+
+    // In place, each output cell is written before or at its first input cell.
+    for (int cy = 0; cy < y_cells_2; cy++) {
+        for (int cx = 0; cx < x_cells_2; cx++) {
+            uint32_t *out = cells + (((cy * x_cells_2) + cx) * HOG_BINS);
+            uint32_t *in0 = cells + ((((cy * 2) * (*x_cells)) + (cx * 2)) * HOG_BINS);
+            uint32_t *in1 = in0 + ((*x_cells) * HOG_BINS);
+            for (int i = 0; i < HOG_BINS; i++) {
+                out[i] = in0[i] + in0[i + HOG_BINS] + in1[i] + in1[i + HOG_BINS];
+            }
         }
     }
 
-    memset(src->pixels, 0, src->w * src->h);
+    *x_cells = x_cells_2;
+    *y_cells = y_cells_2;
+}
 
-    array_t *gds;
-    bin_t bins[9];
-    array_alloc(&gds, NULL);
+void imlib_hog_blocks(int x_cells, int y_cells, uint32_t *cells, uint8_t *blocks) {
+    for (int by = 0; by < (y_cells - 1); by++) {
+        for (int bx = 0; bx < (x_cells - 1); bx++, blocks += HOG_BLOCK_BINS) {
+            float block[HOG_BLOCK_BINS];
+            float sum = 0.0f;
+
+            for (int j = 0, k = 0; j < 2; j++) {
+                uint32_t *cell = cells + ((((by + j) * x_cells) + bx) * HOG_BINS);
+                for (int i = 0; i < (HOG_BINS * 2); i++, k++) {
+                    block[k] = cell[i];
+                    sum += block[k] * block[k];
+                }
+            }
 
-    for (int i = 0; i < N_BINS; i++) {
-        array_push_back(gds, &bins[i]);
+            // Normalize, clip and normalize again.
+            float scale = 1.0f / (fast_sqrtf(sum) + 1.0f);
+            sum = 0.0f;
+            for (int k = 0; k < HOG_BLOCK_BINS; k++) {
+                block[k] = IM_MIN(block[k] * scale, HOG_CLIP);
+                sum += block[k] * block[k];
+            }
+
+            scale = COLOR_GRAYSCALE_MAX / (fast_sqrtf(sum) + 1e-6f);
+            for (int k = 0; k < HOG_BLOCK_BINS; k++) {
+                blocks[k] = IM_MIN(fast_roundf(block[k] * scale), COLOR_GRAYSCALE_MAX);
+            }
+        }
     }
+}
 
-    int l = cell_size / 2;
-    // Note cells are not ordered histograms of 4 cells
-    for (int by = 0, hog_index = 0; by < y_cells; by += 2) {
-        for (int bx = 0; bx < x_cells; bx += 2) {
-            for (int y = 0; y < 2; y++) {
-                for (int x = 0; x < 2; x++) {
-                    // Sort and draw bins
-                    for (int i = hog_index; i < hog_index + N_BINS; i++) {
-                        int m = (int) (hog[i] * 255);
-                        if (m > 255) {
-                            m = 255;
-                        } else if (m < 0) {
-                            m = 0;
-                        }
-                        bin_t *bin = array_at(gds, (i % N_BINS));
-                        bin->m = m;
-                        bin->d = ((i % N_BINS) * 20);
-                    }
+void imlib_find_hog(image_t *src, rectangle_t *roi, int cell_size, gradients_t *gradients) {
+    int x_cells = roi->w / cell_size;
+    int y_cells = roi->h / cell_size;
+    uint32_t *cells = fb_alloc(x_cells * y_cells * HOG_BINS * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    imlib_hog_cells(src, roi, cell_size, cells, gradients);
 
-                    array_sort(gds, bin_array_comp);
+    memset(src->pixels, 0, src->w * src->h);
 
-                    int x1 = (x + bx) * cell_size + l;
-                    int y1 = (y + by) * cell_size + l;
-                    for (int i = 0; i < N_BINS; i++) {
-                        bin_t *bin = array_at(gds, i);
-                        int x2 = l * cos_table[bin->d];
-                        int y2 = l * sin_table[bin->d];
-                        imlib_draw_line(src, (x1 - x2), (y1 + y2), (x1 + x2), (y1 - y2), bin->m, 1);
+    int l = cell_size / 2;
+    for (int cy = 0; cy < y_cells; cy++) {
+        for (int cx = 0; cx < x_cells; cx++) {
+            // Cells are normalized by the L2 norm of their 2x2 block.
+            uint32_t *cell = cells + (((cy * x_cells) + cx) * HOG_BINS);
+            float sum = 0.0f;
+            for (int j = cy & ~1; j < IM_MIN((cy & ~1) + 2, y_cells); j++) {
+                for (int i = cx & ~1; i < IM_MIN((cx & ~1) + 2, x_cells); i++) {
+                    uint32_t *c = cells + (((j * x_cells) + i) * HOG_BINS);
+                    for (int b = 0; b < HOG_BINS; b++) {
+                        sum += ((float) c[b]) * c[b];
                     }
+                }
+            }
 
-                    hog_index += N_BINS;
+            float scale = COLOR_GRAYSCALE_MAX / (fast_sqrtf(sum) + 1.0f);
+            uint8_t m[HOG_BINS], order[HOG_BINS];
+
+            // Insertion sort the bins by magnitude so the strongest ones are drawn last.
+            for (int b = 0; b < HOG_BINS; b++) {
+                m[b] = IM_MIN(fast_roundf(cell[b] * scale), COLOR_GRAYSCALE_MAX);
+                int k = b;
+                for (; (k > 0) && (m[order[k - 1]] > m[b]); k--) {
+                    order[k] = order[k - 1];
                 }
+                order[k] = b;
+            }
+
+            int x1 = roi->x + (cx * cell_size) + l;
+            int y1 = roi->y + (cy * cell_size) + l;
+            for (int b = 0; b < HOG_BINS; b++) {
+                // Draw along the edge, perpendicular to the bin center gradient.
+                int d = (360 + 90 - ((order[b] * HOG_BIN_DEGREES) + (HOG_BIN_DEGREES / 2))) % 360;
+                int x2 = l * cos_table[d];
+                int y2 = l * sin_table[d];
+                imlib_draw_line(src, (x1 - x2), (y1 + y2), (x1 + x2), (y1 - y2), m[order[b]], 1);
             }
         }
     }
 
-    xfree(gds);
     fb_free();
 }
 #endif // IMLIB_ENABLE_HOG
@@ -10,18 +10,52 @@
  */
 #include "imlib.h"
 
+// Fractional bits of the fixed-point sin/cos tables.
+#define HOUGH_TRIG_SHIFT    (14)
+
 #ifdef IMLIB_ENABLE_FIND_LINES
+// Votes are Sobel magnitudes scaled down by this shift so that the accumulators fit in 16-bits.
+#define HOUGH_VOTE_SHIFT    (2)
+
+typedef struct hough {
+    uint16_t *acc;
+    int16_t *cos_q;
+    int16_t *sin_q;
+    int theta_size;
+    int r_diag_len_div;
+    int hough_divide;
+} hough_t;
+
+// Votes for the line through (x, y) that is normal to the gradient, a single theta per pixel.
+static inline void hough_vote(hough_t *h, int x, int y, int x_acc, int y_acc) {
+    int mag = (abs(x_acc) + abs(y_acc)) / 2;
+    if (mag < 126) {
+        return;
+    }
+
+    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 180; // * (180 / PI)
+    if (theta < 0) {
+        theta += 180;
+    }
+    int rho = (x * h->cos_q[theta]) + (y * h->sin_q[theta]);
+    rho = ((rho + (1 << (HOUGH_TRIG_SHIFT - 1))) >> HOUGH_TRIG_SHIFT) / h->hough_divide;
+    uint16_t *acc = h->acc + ((rho + h->r_diag_len_div) * h->theta_size) + ((theta / h->hough_divide) + 1); // add offset
+    // Saturate instead of wrapping around on very long lines.
+    *acc = IM_MIN(*acc + ((mag + (1 << (HOUGH_VOTE_SHIFT - 1))) >> HOUGH_VOTE_SHIFT), UINT16_MAX);
+}
+
 void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
-                      uint32_t threshold, unsigned int theta_margin, unsigned int rho_margin) {
-    int r_diag_len, r_diag_len_div, theta_size, r_size, hough_divide = 1; // divides theta and rho accumulators
+                      uint32_t threshold, unsigned int theta_margin, unsigned int rho_margin, gradients_t *gradients) {
+    int r_diag_len, r_diag_len_div, theta_bins, theta_size, r_size, hough_divide = 1; // divides theta and rho accumulators
 
     for (;;) {
         // shrink to fit...
         r_diag_len = fast_roundf(fast_sqrtf((roi->w * roi->w) + (roi->h * roi->h)));
         r_diag_len_div = (r_diag_len + hough_divide - 1) / hough_divide;
-        theta_size = 1 + ((180 + hough_divide - 1) / hough_divide) + 1; // left & right padding
+        theta_bins = (180 + hough_divide - 1) / hough_divide;
+        theta_size = (1 + theta_bins + 1 + 1) & ~1; // left & right padding, even for word access
         r_size = (r_diag_len_div * 2) + 1; // -r_diag_len to +r_diag_len
-        if ((sizeof(uint32_t) * theta_size * r_size) <= fb_avail()) {
+        if ((sizeof(uint16_t) * theta_size * r_size) <= fb_avail()) {
             break;
         }
         hough_divide = hough_divide << 1; // powers of 2...
@@ -30,228 +64,234 @@ void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
         }
     }
 
-    uint32_t *acc = fb_alloc0(sizeof(uint32_t) * theta_size * r_size, FB_ALLOC_NO_HINT);
+    int16_t *cos_q = fb_alloc(sizeof(int16_t) * 180, FB_ALLOC_PREFER_TCM);
+    int16_t *sin_q = fb_alloc(sizeof(int16_t) * 180, FB_ALLOC_PREFER_TCM);
 
-    switch (ptr->pixfmt) {
-        case PIXFORMAT_BINARY: {
-            for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
-                for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
-                    int pixel; // Sobel Algorithm Below
-                    int x_acc = 0;
-                    int y_acc = 0;
+    for (int i = 0; i < 180; i++) {
+        cos_q[i] = fast_roundf(cos_table[i] * (1 << HOUGH_TRIG_SHIFT));
+        sin_q[i] = fast_roundf(sin_table[i] * (1 << HOUGH_TRIG_SHIFT));
+    }
 
-                    row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
+    uint16_t *acc = fb_alloc0(sizeof(uint16_t) * theta_size * r_size, FB_ALLOC_PREFER_TCM);
+
+    hough_t h = {
+        .acc = acc,
+        .cos_q = cos_q,
+        .sin_q = sin_q,
+        .theta_size = theta_size,
+        .r_diag_len_div = r_diag_len_div,
+        .hough_divide = hough_divide
+    };
+
+    if (gradients) {
+        // Shared gradients are used instead of the Sobel kernels below.
+        for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+            gradient_t *row_ptr = imlib_gradients_at(gradients, roi->x, y);
+            for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
+                hough_vote(&h, x - roi->x, y - roi->y, row_ptr[x - roi->x].x, row_ptr[x - roi->x].y);
+            }
+        }
+    } else {
+        switch (ptr->pixfmt) {
+            case PIXFORMAT_BINARY: {
+                for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+                    uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
+                    for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
+                        int pixel; // Sobel Algorithm Below
+                        int x_acc = 0;
+                        int y_acc = 0;
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +1; // x[0,0] -> pixel * +1
-                    y_acc += pixel * +1; // y[0,0] -> pixel * +1
+                        row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
-                    // x[0,1] -> pixel * 0
-                    y_acc += pixel * +2; // y[0,1] -> pixel * +2
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +1; // x[0,0] -> pixel * +1
+                        y_acc += pixel * +1; // y[0,0] -> pixel * +1
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -1; // x[0,2] -> pixel * -1
-                    y_acc += pixel * +1; // y[0,2] -> pixel * +1
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                        // x[0,1] -> pixel * 0
+                        y_acc += pixel * +2; // y[0,1] -> pixel * +2
 
-                    row_ptr += ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -1; // x[0,2] -> pixel * -1
+                        y_acc += pixel * +1; // y[0,2] -> pixel * +1
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +2; // x[1,0] -> pixel * +2
-                                         // y[1,0] -> pixel * 0
+                        row_ptr += ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
 
-                    // pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
-                    // x[1,1] -> pixel * 0
-                    // y[1,1] -> pixel * 0
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +2; // x[1,0] -> pixel * +2
+                                             // y[1,0] -> pixel * 0
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -2; // x[1,2] -> pixel * -2
-                                         // y[1,2] -> pixel * 0
+                        // pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                        // x[1,1] -> pixel * 0
+                        // y[1,1] -> pixel * 0
 
-                    row_ptr += ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -2; // x[1,2] -> pixel * -2
+                                             // y[1,2] -> pixel * 0
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +1; // x[2,0] -> pixel * +1
-                    y_acc += pixel * -1; // y[2,0] -> pixel * -1
+                        row_ptr += ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
-                    // x[2,1] -> pixel * 0
-                    y_acc += pixel * -2; // y[2,1] -> pixel * -2
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +1; // x[2,0] -> pixel * +1
+                        y_acc += pixel * -1; // y[2,0] -> pixel * -1
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -1; // x[2,2] -> pixel * -1
-                    y_acc += pixel * -1; // y[2,2] -> pixel * -1
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                        // x[2,1] -> pixel * 0
+                        y_acc += pixel * -2; // y[2,1] -> pixel * -2
 
-                    row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -1; // x[2,2] -> pixel * -1
+                        y_acc += pixel * -1; // y[2,2] -> pixel * -1
 
-                    int mag = (abs(x_acc) + abs(y_acc)) / 2;
-                    if (mag < 126) {
-                        continue;
-                    }
+                        row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
 
-                    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 180; // * (180 / PI)
-                    if (theta < 0) {
-                        theta += 180;
+                        hough_vote(&h, x - roi->x, y - roi->y, x_acc, y_acc);
                     }
-                    int rho = (fast_roundf(((x - roi->x) * cos_table[theta]) +
-                                           ((y - roi->y) * sin_table[theta])) / hough_divide) + r_diag_len_div;
-                    int acc_index = (rho * theta_size) + ((theta / hough_divide) + 1); // add offset
-                    acc[acc_index] += mag;
                 }
+                break;
             }
-            break;
-        }
-        case PIXFORMAT_GRAYSCALE: {
-            for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
-                for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
-                    int pixel; // Sobel Algorithm Below
-                    int x_acc = 0;
-                    int y_acc = 0;
+            case PIXFORMAT_GRAYSCALE: {
+                for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+                    uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
+                    for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
+                        int pixel; // Sobel Algorithm Below
+                        int x_acc = 0;
+                        int y_acc = 0;
 
-                    row_ptr -= ptr->w;
+                        row_ptr -= ptr->w;
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
-                    x_acc += pixel * +1; // x[0,0] -> pixel * +1
-                    y_acc += pixel * +1; // y[0,0] -> pixel * +1
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
+                        x_acc += pixel * +1; // x[0,0] -> pixel * +1
+                        y_acc += pixel * +1; // y[0,0] -> pixel * +1
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
-                    // x[0,1] -> pixel * 0
-                    y_acc += pixel * +2; // y[0,1] -> pixel * +2
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                        // x[0,1] -> pixel * 0
+                        y_acc += pixel * +2; // y[0,1] -> pixel * +2
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
-                    x_acc += pixel * -1; // x[0,2] -> pixel * -1
-                    y_acc += pixel * +1; // y[0,2] -> pixel * +1
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
+                        x_acc += pixel * -1; // x[0,2] -> pixel * -1
+                        y_acc += pixel * +1; // y[0,2] -> pixel * +1
 
-                    row_ptr += ptr->w;
+                        row_ptr += ptr->w;
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
-                    x_acc += pixel * +2; // x[1,0] -> pixel * +2
-                                         // y[1,0] -> pixel * 0
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
+                        x_acc += pixel * +2; // x[1,0] -> pixel * +2
+                                             // y[1,0] -> pixel * 0
 
-                    // pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
-                    // x[1,1] -> pixel * 0
-                    // y[1,1] -> pixel * 0
+                        // pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                        // x[1,1] -> pixel * 0
+                        // y[1,1] -> pixel * 0
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
-                    x_acc += pixel * -2; // x[1,2] -> pixel * -2
-                                         // y[1,2] -> pixel * 0
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
+                        x_acc += pixel * -2; // x[1,2] -> pixel * -2
+                                             // y[1,2] -> pixel * 0
 
-                    row_ptr += ptr->w;
+                        row_ptr += ptr->w;
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
-                    x_acc += pixel * +1; // x[2,0] -> pixel * +1
-                    y_acc += pixel * -1; // y[2,0] -> pixel * -1
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
+                        x_acc += pixel * +1; // x[2,0] -> pixel * +1
+                        y_acc += pixel * -1; // y[2,0] -> pixel * -1
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
-                    // x[2,1] -> pixel * 0
-                    y_acc += pixel * -2; // y[2,1] -> pixel * -2
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                        // x[2,1] -> pixel * 0
+                        y_acc += pixel * -2; // y[2,1] -> pixel * -2
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
-                    x_acc += pixel * -1; // x[2,2] -> pixel * -1
-                    y_acc += pixel * -1; // y[2,2] -> pixel * -1
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
+                        x_acc += pixel * -1; // x[2,2] -> pixel * -1
+                        y_acc += pixel * -1; // y[2,2] -> pixel * -1
 
-                    row_ptr -= ptr->w;
+                        row_ptr -= ptr->w;
 
-                    int mag = (abs(x_acc) + abs(y_acc)) / 2;
-                    if (mag < 126) {
-                        continue;
+                        hough_vote(&h, x - roi->x, y - roi->y, x_acc, y_acc);
                     }
-
-                    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 180; // * (180 / PI)
-                    if (theta < 0) {
-                        theta += 180;
-                    }
-                    int rho = (fast_roundf(((x - roi->x) * cos_table[theta]) +
-                                           ((y - roi->y) * sin_table[theta])) / hough_divide) + r_diag_len_div;
-                    int acc_index = (rho * theta_size) + ((theta / hough_divide) + 1); // add offset
-                    acc[acc_index] += mag;
                 }
+                break;
             }
-            break;
-        }
-        case PIXFORMAT_RGB565: {
-            for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
-                for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
-                    int pixel; // Sobel Algorithm Below
-                    int x_acc = 0;
-                    int y_acc = 0;
-
-                    row_ptr -= ptr->w;
+            case PIXFORMAT_RGB565: {
+                for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+                    uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
+                    for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
+                        int pixel; // Sobel Algorithm Below
+                        int x_acc = 0;
+                        int y_acc = 0;
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +1; // x[0,0] -> pixel * +1
-                    y_acc += pixel * +1; // y[0,0] -> pixel * +1
+                        row_ptr -= ptr->w;
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
-                    // x[0,1] -> pixel * 0
-                    y_acc += pixel * +2; // y[0,1] -> pixel * +2
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +1; // x[0,0] -> pixel * +1
+                        y_acc += pixel * +1; // y[0,0] -> pixel * +1
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -1; // x[0,2] -> pixel * -1
-                    y_acc += pixel * +1; // y[0,2] -> pixel * +1
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                        // x[0,1] -> pixel * 0
+                        y_acc += pixel * +2; // y[0,1] -> pixel * +2
 
-                    row_ptr += ptr->w;
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -1; // x[0,2] -> pixel * -1
+                        y_acc += pixel * +1; // y[0,2] -> pixel * +1
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +2; // x[1,0] -> pixel * +2
-                                         // y[1,0] -> pixel * 0
+                        row_ptr += ptr->w;
 
-                    // pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
-                    // x[1,1] -> pixel * 0
-                    // y[1,1] -> pixel * 0
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +2; // x[1,0] -> pixel * +2
+                                             // y[1,0] -> pixel * 0
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -2; // x[1,2] -> pixel * -2
-                                         // y[1,2] -> pixel * 0
+                        // pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                        // x[1,1] -> pixel * 0
+                        // y[1,1] -> pixel * 0
 
-                    row_ptr += ptr->w;
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -2; // x[1,2] -> pixel * -2
+                                             // y[1,2] -> pixel * 0
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +1; // x[2,0] -> pixel * +1
-                    y_acc += pixel * -1; // y[2,0] -> pixel * -1
+                        row_ptr += ptr->w;
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
-                    // x[2,1] -> pixel * 0
-                    y_acc += pixel * -2; // y[2,1] -> pixel * -2
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +1; // x[2,0] -> pixel * +1
+                        y_acc += pixel * -1; // y[2,0] -> pixel * -1
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -1; // x[2,2] -> pixel * -1
-                    y_acc += pixel * -1; // y[2,2] -> pixel * -1
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                        // x[2,1] -> pixel * 0
+                        y_acc += pixel * -2; // y[2,1] -> pixel * -2
 
-                    row_ptr -= ptr->w;
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -1; // x[2,2] -> pixel * -1
+                        y_acc += pixel * -1; // y[2,2] -> pixel * -1
 
-                    int mag = (abs(x_acc) + abs(y_acc)) / 2;
-                    if (mag < 126) {
-                        continue;
-                    }
+                        row_ptr -= ptr->w;
 
-                    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 180; // * (180 / PI)
-                    if (theta < 0) {
-                        theta += 180;
+                        hough_vote(&h, x - roi->x, y - roi->y, x_acc, y_acc);
                     }
-                    int rho = (fast_roundf(((x - roi->x) * cos_table[theta]) +
-                                           ((y - roi->y) * sin_table[theta])) / hough_divide) + r_diag_len_div;
-                    int acc_index = (rho * theta_size) + ((theta / hough_divide) + 1); // add offset
-                    acc[acc_index] += mag;
                 }
+                break;
+            }
+            default: {
+                break;
             }
-            break;
-        }
-        default: {
-            break;
         }
     }
 
     list_init(out, sizeof(find_lines_list_lnk_data_t));
 
+    // Compare accumulators against the threshold in the vote domain (rounded up).
+    uint32_t acc_threshold = (threshold + (1 << HOUGH_VOTE_SHIFT) - 1) >> HOUGH_VOTE_SHIFT;
+    #if defined(ARM_MATH_DSP)
+    uint32_t acc_threshold2 = IM_MIN(acc_threshold, UINT16_MAX + 1) - 1;
+    acc_threshold2 |= acc_threshold2 << 16;
+    #endif
+
     for (int y = 1, yy = r_size - 1; y < yy; y++) {
-        uint32_t *row_ptr = acc + (theta_size * y);
+        uint16_t *row_ptr = acc + (theta_size * y);
+
+        for (int x = 1, xx = theta_bins + 1; x < xx; x++) {
+            #if defined(ARM_MATH_DSP)
+            // Skip pairs of accumulators that are both below the threshold.
+            if ((!(x & 1)) && (acc_threshold > 0) && (!__UQSUB16(*((uint32_t *) (row_ptr + x)), acc_threshold2))) {
+                x += 1;
+                continue;
+            }
+            #endif
 
-        for (int x = 1, xx = theta_size - 1; x < xx; x++) {
-            if ((row_ptr[x] >= threshold)
+            if ((row_ptr[x] >= acc_threshold)
                 && (row_ptr[x] >= row_ptr[x - theta_size - 1])
                 && (row_ptr[x] >= row_ptr[x - theta_size])
                 && (row_ptr[x] >= row_ptr[x - theta_size + 1])
@@ -264,7 +304,7 @@ void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                 find_lines_list_lnk_data_t lnk_line;
                 memset(&lnk_line, 0, sizeof(find_lines_list_lnk_data_t));
 
-                lnk_line.magnitude = row_ptr[x];
+                lnk_line.magnitude = row_ptr[x] << HOUGH_VOTE_SHIFT;
                 lnk_line.theta = (x - 1) * hough_divide; // remove offset
                 lnk_line.rho = (y - r_diag_len_div) * hough_divide;
 
@@ -274,6 +314,8 @@ void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
     }
 
     fb_free(); // acc
+    fb_free(); // sin_q
+    fb_free(); // cos_q
 
     for (;;) {
         // Merge overlapping.
@@ -392,7 +434,7 @@ void imlib_find_line_segments(list_t *out, image_t *ptr, rectangle_t *roi, unsig
     const unsigned int max_gap_pixels = 5;
 
     list_t temp_out;
-    imlib_find_lines(&temp_out, ptr, roi, x_stride, y_stride, threshold, theta_margin, rho_margin);
+    imlib_find_lines(&temp_out, ptr, roi, x_stride, y_stride, threshold, theta_margin, rho_margin, NULL);
     list_init(out, sizeof(find_lines_list_lnk_data_t));
 
     const int r_diag_len = fast_roundf(fast_sqrtf((roi->w * roi->w) + (roi->h * roi->h))) * 2;
@@ -483,210 +525,320 @@ void imlib_find_line_segments(list_t *out, image_t *ptr, rectangle_t *roi, unsig
 #endif //IMLIB_ENABLE_FIND_LINE_SEGMENTS
 
 #ifdef IMLIB_ENABLE_FIND_CIRCLES
+// Gradient directions are only good to a couple of degrees, so the distance that the ray of an edge
+// may miss a center by grows by 1/32 (~1.8 degrees) per pixel of radius.
+#define HOUGH_CIRCLE_RAY_SLOPE_SHIFT    (5)
+
+typedef struct hough_circle {
+    uint32_t *edges; // (y << 16) | x of each pixel with a non-zero gradient
+    size_t edge_count;
+    uint16_t *theta_acc;
+    uint16_t *magnitude_acc;
+    int16_t *cos_q;
+    int16_t *sin_q;
+    uint32_t *hist;
+    int w, h;
+    int r_min, r_max, r_step;
+    int ray_tol; // how close (Q14) the gradient ray of an edge has to pass by a center
+    uint32_t threshold;
+} hough_circle_t;
+
+// The rays of a circle's edges cross all over its inside, so a center also has to be the largest
+// accumulator within the margins that it would be merged with anyway.
+static bool hough_circle_is_peak(uint32_t *acc, int a_size, int b_size, int x, int y, int x_win, int y_win) {
+    uint32_t val = acc[(a_size * y) + x];
+    for (int j = IM_MAX(y - y_win, 1), jj = IM_MIN(y + y_win, b_size - 2); j <= jj; j++) {
+        uint32_t *row_ptr = acc + (a_size * j);
+        for (int i = IM_MAX(x - x_win, 1), ii = IM_MIN(x + x_win, a_size - 2); i <= ii; i++) {
+            if (row_ptr[i] > val) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Histograms the distance from (cx, cy) to each edge whose gradient points at it, one bin per r_step,
+// and reports every radius peak above the threshold.
+static void hough_circle_radii(list_t *out, hough_circle_t *c, rectangle_t *roi, int cx, int cy) {
+    // Largest radius for which the circle still fits in the roi.
+    int r_fit = IM_MIN(IM_MIN(cx, cy), IM_MIN(c->w - 1 - cx, c->h - 1 - cy));
+    int r_hi = IM_MIN(r_fit, c->r_max - 1);
+    if (r_hi < c->r_min) {
+        return;
+    }
+
+    int bins = ((r_hi - c->r_min) / c->r_step) + 1;
+    int d_max = c->r_min + (bins * c->r_step) - (c->r_step / 2) - 1;
+    memset(c->hist, 0, sizeof(uint32_t) * (bins + 2)); // left & right padding
+
+    for (size_t i = 0; i < c->edge_count; i++) {
+        int dx = ((int) (c->edges[i] & 0xFFFF)) - cx;
+        int dy = ((int) (c->edges[i] >> 16)) - cy;
+        if ((abs(dx) > d_max) || (abs(dy) > d_max)) {
+            continue;
+        }
+
+        int d2 = (dx * dx) + (dy * dy);
+        if (d2 > (d_max * d_max)) {
+            continue;
+        }
+
+        int d = fast_roundf(fast_sqrtf(d2));
+        int t = d - c->r_min + (c->r_step / 2);
+        if (t < 0) {
+            continue;
+        }
+
+        // The gradient may be pointing inside or outside the circle.
+        int index = (c->w * (dy + cy)) + (dx + cx);
+        int theta = c->theta_acc[index];
+        int cross = (dx * c->sin_q[theta]) - (dy * c->cos_q[theta]);
+        if (abs(cross) > (c->ray_tol + (d << (HOUGH_TRIG_SHIFT - HOUGH_CIRCLE_RAY_SLOPE_SHIFT)))) {
+            continue;
+        }
+
+        c->hist[(t / c->r_step) + 1] += c->magnitude_acc[index]; // add offset
+    }
+
+    for (int i = 1; i <= bins; i++) {
+        uint32_t val = c->hist[i];
+        if ((val >= c->threshold) && (val > c->hist[i - 1]) && (val >= c->hist[i + 1])) {
+            find_circles_list_lnk_data_t lnk_data;
+            lnk_data.magnitude = IM_MIN(val, (uint32_t) UINT16_MAX);
+            lnk_data.p.x = cx + roi->x;
+            lnk_data.p.y = cy + roi->y;
+            lnk_data.r = c->r_min + ((i - 1) * c->r_step); // remove offset
+            list_push_back(out, &lnk_data);
+        }
+    }
+}
+
 void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
                         uint32_t threshold, unsigned int x_margin, unsigned int y_margin, unsigned int r_margin,
-                        unsigned int r_min, unsigned int r_max, unsigned int r_step) {
+                        unsigned int r_min, unsigned int r_max, unsigned int r_step, gradients_t *gradients) {
     uint16_t *theta_acc = fb_alloc0(sizeof(uint16_t) * roi->w * roi->h, FB_ALLOC_NO_HINT);
     uint16_t *magnitude_acc = fb_alloc0(sizeof(uint16_t) * roi->w * roi->h, FB_ALLOC_NO_HINT);
 
-    switch (ptr->pixfmt) {
-        case PIXFORMAT_BINARY: {
-            for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
-                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
-                for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
-                    int pixel; // Sobel Algorithm Below
-                    int x_acc = 0;
-                    int y_acc = 0;
+    if (gradients) {
+        // Shared gradients are used instead of the Sobel kernels below.
+        for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+            gradient_t *row_ptr = imlib_gradients_at(gradients, roi->x, y);
+            for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
+                int x_acc = row_ptr[x - roi->x].x;
+                int y_acc = row_ptr[x - roi->x].y;
+
+                int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
+                if (theta < 0) {
+                    theta += 360;
+                }
+                int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
+                int index = (roi->w * (y - roi->y)) + (x - roi->x);
 
-                    row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
+                theta_acc[index] = theta;
+                magnitude_acc[index] = magnitude;
+            }
+        }
+    } else {
+        switch (ptr->pixfmt) {
+            case PIXFORMAT_BINARY: {
+                for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+                    uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
+                    for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
+                        int pixel; // Sobel Algorithm Below
+                        int x_acc = 0;
+                        int y_acc = 0;
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +1; // x[0,0] -> pixel * +1
-                    y_acc += pixel * +1; // y[0,0] -> pixel * +1
+                        row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
-                    // x[0,1] -> pixel * 0
-                    y_acc += pixel * +2; // y[0,1] -> pixel * +2
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +1; // x[0,0] -> pixel * +1
+                        y_acc += pixel * +1; // y[0,0] -> pixel * +1
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -1; // x[0,2] -> pixel * -1
-                    y_acc += pixel * +1; // y[0,2] -> pixel * +1
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                        // x[0,1] -> pixel * 0
+                        y_acc += pixel * +2; // y[0,1] -> pixel * +2
 
-                    row_ptr += ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -1; // x[0,2] -> pixel * -1
+                        y_acc += pixel * +1; // y[0,2] -> pixel * +1
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +2; // x[1,0] -> pixel * +2
-                                         // y[1,0] -> pixel * 0
+                        row_ptr += ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
 
-                    // pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
-                    // x[1,1] -> pixel * 0
-                    // y[1,1] -> pixel * 0
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +2; // x[1,0] -> pixel * +2
+                                             // y[1,0] -> pixel * 0
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -2; // x[1,2] -> pixel * -2
-                                         // y[1,2] -> pixel * 0
+                        // pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                        // x[1,1] -> pixel * 0
+                        // y[1,1] -> pixel * 0
 
-                    row_ptr += ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -2; // x[1,2] -> pixel * -2
+                                             // y[1,2] -> pixel * 0
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +1; // x[2,0] -> pixel * +1
-                    y_acc += pixel * -1; // y[2,0] -> pixel * -1
+                        row_ptr += ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
-                    // x[2,1] -> pixel * 0
-                    y_acc += pixel * -2; // y[2,1] -> pixel * -2
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +1; // x[2,0] -> pixel * +1
+                        y_acc += pixel * -1; // y[2,0] -> pixel * -1
 
-                    pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -1; // x[2,2] -> pixel * -1
-                    y_acc += pixel * -1; // y[2,2] -> pixel * -1
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                        // x[2,1] -> pixel * 0
+                        y_acc += pixel * -2; // y[2,1] -> pixel * -2
 
-                    row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
+                        pixel = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -1; // x[2,2] -> pixel * -1
+                        y_acc += pixel * -1; // y[2,2] -> pixel * -1
 
-                    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
-                    if (theta < 0) {
-                        theta += 360;
-                    }
-                    int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
-                    int index = (roi->w * (y - roi->y)) + (x - roi->x);
+                        row_ptr -= ((ptr->w + UINT32_T_MASK) >> UINT32_T_SHIFT);
+
+                        int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
+                        if (theta < 0) {
+                            theta += 360;
+                        }
+                        int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
+                        int index = (roi->w * (y - roi->y)) + (x - roi->x);
 
-                    theta_acc[index] = theta;
-                    magnitude_acc[index] = magnitude;
+                        theta_acc[index] = theta;
+                        magnitude_acc[index] = magnitude;
+                    }
                 }
+                break;
             }
-            break;
-        }
-        case PIXFORMAT_GRAYSCALE: {
-            for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
-                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
-                for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
-                    int pixel; // Sobel Algorithm Below
-                    int x_acc = 0;
-                    int y_acc = 0;
+            case PIXFORMAT_GRAYSCALE: {
+                for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+                    uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
+                    for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
+                        int pixel; // Sobel Algorithm Below
+                        int x_acc = 0;
+                        int y_acc = 0;
 
-                    row_ptr -= ptr->w;
+                        row_ptr -= ptr->w;
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
-                    x_acc += pixel * +1; // x[0,0] -> pixel * +1
-                    y_acc += pixel * +1; // y[0,0] -> pixel * +1
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
+                        x_acc += pixel * +1; // x[0,0] -> pixel * +1
+                        y_acc += pixel * +1; // y[0,0] -> pixel * +1
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
-                    // x[0,1] -> pixel * 0
-                    y_acc += pixel * +2; // y[0,1] -> pixel * +2
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                        // x[0,1] -> pixel * 0
+                        y_acc += pixel * +2; // y[0,1] -> pixel * +2
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
-                    x_acc += pixel * -1; // x[0,2] -> pixel * -1
-                    y_acc += pixel * +1; // y[0,2] -> pixel * +1
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
+                        x_acc += pixel * -1; // x[0,2] -> pixel * -1
+                        y_acc += pixel * +1; // y[0,2] -> pixel * +1
 
-                    row_ptr += ptr->w;
+                        row_ptr += ptr->w;
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
-                    x_acc += pixel * +2; // x[1,0] -> pixel * +2
-                                         // y[1,0] -> pixel * 0
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
+                        x_acc += pixel * +2; // x[1,0] -> pixel * +2
+                                             // y[1,0] -> pixel * 0
 
-                    // pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
-                    // x[1,1] -> pixel * 0
-                    // y[1,1] -> pixel * 0
+                        // pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                        // x[1,1] -> pixel * 0
+                        // y[1,1] -> pixel * 0
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
-                    x_acc += pixel * -2; // x[1,2] -> pixel * -2
-                                         // y[1,2] -> pixel * 0
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
+                        x_acc += pixel * -2; // x[1,2] -> pixel * -2
+                                             // y[1,2] -> pixel * 0
 
-                    row_ptr += ptr->w;
+                        row_ptr += ptr->w;
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
-                    x_acc += pixel * +1; // x[2,0] -> pixel * +1
-                    y_acc += pixel * -1; // y[2,0] -> pixel * -1
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x - 1);
+                        x_acc += pixel * +1; // x[2,0] -> pixel * +1
+                        y_acc += pixel * -1; // y[2,0] -> pixel * -1
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
-                    // x[2,1] -> pixel * 0
-                    y_acc += pixel * -2; // y[2,1] -> pixel * -2
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                        // x[2,1] -> pixel * 0
+                        y_acc += pixel * -2; // y[2,1] -> pixel * -2
 
-                    pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
-                    x_acc += pixel * -1; // x[2,2] -> pixel * -1
-                    y_acc += pixel * -1; // y[2,2] -> pixel * -1
+                        pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x + 1);
+                        x_acc += pixel * -1; // x[2,2] -> pixel * -1
+                        y_acc += pixel * -1; // y[2,2] -> pixel * -1
 
-                    row_ptr -= ptr->w;
+                        row_ptr -= ptr->w;
 
-                    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
-                    if (theta < 0) {
-                        theta += 360;
-                    }
-                    int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
-                    int index = (roi->w * (y - roi->y)) + (x - roi->x);
+                        int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
+                        if (theta < 0) {
+                            theta += 360;
+                        }
+                        int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
+                        int index = (roi->w * (y - roi->y)) + (x - roi->x);
 
-                    theta_acc[index] = theta;
-                    magnitude_acc[index] = magnitude;
+                        theta_acc[index] = theta;
+                        magnitude_acc[index] = magnitude;
+                    }
                 }
+                break;
             }
-            break;
-        }
-        case PIXFORMAT_RGB565: {
-            for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
-                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
-                for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
-                    int pixel; // Sobel Algorithm Below
-                    int x_acc = 0;
-                    int y_acc = 0;
+            case PIXFORMAT_RGB565: {
+                for (int y = roi->y + 1, yy = roi->y + roi->h - 1; y < yy; y += y_stride) {
+                    uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
+                    for (int x = roi->x + (y % x_stride) + 1, xx = roi->x + roi->w - 1; x < xx; x += x_stride) {
+                        int pixel; // Sobel Algorithm Below
+                        int x_acc = 0;
+                        int y_acc = 0;
 
-                    row_ptr -= ptr->w;
+                        row_ptr -= ptr->w;
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +1; // x[0,0] -> pixel * +1
-                    y_acc += pixel * +1; // y[0,0] -> pixel * +1
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +1; // x[0,0] -> pixel * +1
+                        y_acc += pixel * +1; // y[0,0] -> pixel * +1
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
-                    // x[0,1] -> pixel * 0
-                    y_acc += pixel * +2; // y[0,1] -> pixel * +2
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                        // x[0,1] -> pixel * 0
+                        y_acc += pixel * +2; // y[0,1] -> pixel * +2
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -1; // x[0,2] -> pixel * -1
-                    y_acc += pixel * +1; // y[0,2] -> pixel * +1
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -1; // x[0,2] -> pixel * -1
+                        y_acc += pixel * +1; // y[0,2] -> pixel * +1
 
-                    row_ptr += ptr->w;
+                        row_ptr += ptr->w;
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +2; // x[1,0] -> pixel * +2
-                                         // y[1,0] -> pixel * 0
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +2; // x[1,0] -> pixel * +2
+                                             // y[1,0] -> pixel * 0
 
-                    // pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
-                    // x[1,1] -> pixel * 0
-                    // y[1,1] -> pixel * 0
+                        // pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                        // x[1,1] -> pixel * 0
+                        // y[1,1] -> pixel * 0
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -2; // x[1,2] -> pixel * -2
-                                         // y[1,2] -> pixel * 0
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -2; // x[1,2] -> pixel * -2
+                                             // y[1,2] -> pixel * 0
 
-                    row_ptr += ptr->w;
+                        row_ptr += ptr->w;
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
-                    x_acc += pixel * +1; // x[2,0] -> pixel * +1
-                    y_acc += pixel * -1; // y[2,0] -> pixel * -1
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x - 1));
+                        x_acc += pixel * +1; // x[2,0] -> pixel * +1
+                        y_acc += pixel * -1; // y[2,0] -> pixel * -1
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
-                    // x[2,1] -> pixel * 0
-                    y_acc += pixel * -2; // y[2,1] -> pixel * -2
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                        // x[2,1] -> pixel * 0
+                        y_acc += pixel * -2; // y[2,1] -> pixel * -2
 
-                    pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
-                    x_acc += pixel * -1; // x[2,2] -> pixel * -1
-                    y_acc += pixel * -1; // y[2,2] -> pixel * -1
+                        pixel = COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x + 1));
+                        x_acc += pixel * -1; // x[2,2] -> pixel * -1
+                        y_acc += pixel * -1; // y[2,2] -> pixel * -1
 
-                    row_ptr -= ptr->w;
+                        row_ptr -= ptr->w;
 
-                    int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
-                    if (theta < 0) {
-                        theta += 360;
-                    }
-                    int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
-                    int index = (roi->w * (y - roi->y)) + (x - roi->x);
+                        int theta = fast_roundf((x_acc ? fast_atan2f(y_acc, x_acc) : 1.570796f) * 57.295780) % 360; // * (180 / PI)
+                        if (theta < 0) {
+                            theta += 360;
+                        }
+                        int magnitude = fast_roundf(fast_sqrtf((x_acc * x_acc) + (y_acc * y_acc)));
+                        int index = (roi->w * (y - roi->y)) + (x - roi->x);
 
-                    theta_acc[index] = theta;
-                    magnitude_acc[index] = magnitude;
+                        theta_acc[index] = theta;
+                        magnitude_acc[index] = magnitude;
+                    }
                 }
+                break;
+            }
+            default: {
+                break;
             }
-            break;
-        }
-        default: {
-            break;
         }
     }
 
@@ -712,116 +864,144 @@ void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned in
 
     list_init(out, sizeof(find_circles_list_lnk_data_t));
 
-    for (int r = r_min, rr = r_max; r < rr; r += r_step) {
-        // ignore r = 0/1
-        int a_size, b_size, hough_divide = 1; // divides a and b accumulators
-        int hough_shift = 0;
-        int w_size = roi->w - (2 * r);
-        int h_size = roi->h - (2 * r);
-
-        for (;;) {
-            // shrink to fit...
-            a_size = 1 + ((w_size + hough_divide - 1) / hough_divide) + 1; // left & right padding
-            b_size = 1 + ((h_size + hough_divide - 1) / hough_divide) + 1; // top & bottom padding
-            if ((sizeof(uint32_t) * a_size * b_size) <= fb_avail()) {
-                break;
-            }
-            hough_divide = hough_divide << 1; // powers of 2...
-            hough_shift++;
-            if (hough_divide > 4) {
-                fb_alloc_fail();                   // support 1, 2, 4
+    // Only pixels with a gradient vote, so gather them once instead of rescanning the whole roi.
+    size_t edge_count = 0;
+    for (int i = 0, ii = roi->w * roi->h; i < ii; i++) {
+        edge_count += magnitude_acc[i] != 0;
+    }
+
+    uint32_t *edges = fb_alloc(sizeof(uint32_t) * IM_MAX(edge_count, (size_t) 1), FB_ALLOC_NO_HINT);
+    for (int y = 0, yy = roi->h, i = 0; y < yy; y++) {
+        for (int x = 0, xx = roi->w; x < xx; x++) {
+            if (magnitude_acc[(roi->w * y) + x]) {
+                edges[i++] = (y << 16) | x;
             }
         }
+    }
 
-        uint32_t *acc = fb_alloc0(sizeof(uint32_t) * a_size * b_size, FB_ALLOC_NO_HINT);
-        int16_t *rcos = fb_alloc(sizeof(int16_t) * 360, FB_ALLOC_NO_HINT);
-        int16_t *rsin = fb_alloc(sizeof(int16_t) * 360, FB_ALLOC_NO_HINT);
-        for (int i = 0; i < 360; i++) {
-            rcos[i] = (int16_t) roundf(r * cos_table[i]);
-            rsin[i] = (int16_t) roundf(r * sin_table[i]);
-        }
+    int16_t *cos_q = fb_alloc(sizeof(int16_t) * 360, FB_ALLOC_PREFER_TCM);
+    int16_t *sin_q = fb_alloc(sizeof(int16_t) * 360, FB_ALLOC_PREFER_TCM);
 
-        for (int y = 0, yy = roi->h; y < yy; y++) {
-            for (int x = 0, xx = roi->w; x < xx; x++) {
-                int index = (roi->w * y) + x;
-                int theta = theta_acc[index];
-                int magnitude = magnitude_acc[index];
-                if (!magnitude) {
-                    continue;
-                }
+    for (int i = 0; i < 360; i++) {
+        cos_q[i] = fast_roundf(cos_table[i] * (1 << HOUGH_TRIG_SHIFT));
+        sin_q[i] = fast_roundf(sin_table[i] * (1 << HOUGH_TRIG_SHIFT));
+    }
 
-                // We have to do the below step twice because the gradient may be pointing inside or outside the circle.
-                // Only graidents pointing inside of the circle sum up to produce a large magnitude.
-                for (;;) {
-                    // Hi to lo edge direction
-                    int a = x + rcos[theta] - r;
-                    if ((a < 0) || (w_size <= a)) {
-                        break;                           // circle doesn't fit in the window
-                    }
-                    int b = y + rsin[theta] - r;
-                    if ((b < 0) || (h_size <= b)) {
-                        break;                           // circle doesn't fit in the window
-                    }
-                    int acc_index = (((b >> hough_shift) + 1) * a_size) + ((a >> hough_shift) + 1); // add offset
+    int r_bins = (r_min < r_max) ? (((r_max - r_min) + r_step - 1) / r_step) : 0;
+    uint32_t *hist = fb_alloc(sizeof(uint32_t) * (r_bins + 2), FB_ALLOC_NO_HINT);
 
-                    int acc_value = acc[acc_index] += magnitude;
-                    acc[acc_index] = acc_value;
-                    break;
-                }
+    // Stage 1: every edge votes for the centers along its gradient ray for all radii at once.
+    int a_size, b_size, hough_divide = 1; // divides a and b accumulators
+    int hough_shift = 0;
 
-                for (;;) {
-                    // Lo to hi edge direction
-                    int a = x - rcos[theta] - r;
-                    if ((a < 0) || (w_size <= a)) {
-                        break;                           // circle doesn't fit in the window
-                    }
-                    int b = y - rsin[theta] - r;
-                    if ((b < 0) || (h_size <= b)) {
-                        break;                           // circle doesn't fit in the window
-                    }
-                    int acc_index = (((b >> hough_shift) + 1) * a_size) + ((a >> hough_shift) + 1); // add offset
+    for (;;) {
+        // shrink to fit...
+        a_size = 1 + ((roi->w + hough_divide - 1) / hough_divide) + 1; // left & right padding
+        b_size = 1 + ((roi->h + hough_divide - 1) / hough_divide) + 1; // top & bottom padding
+        if ((sizeof(uint32_t) * a_size * b_size) <= fb_avail()) {
+            break;
+        }
+        hough_divide = hough_divide << 1; // powers of 2...
+        hough_shift++;
+        if (hough_divide > 4) {
+            fb_alloc_fail();                   // support 1, 2, 4
+        }
+    }
 
-                    int acc_value = acc[acc_index] += magnitude;
-                    acc[acc_index] = acc_value;
+    uint32_t *acc = fb_alloc0(sizeof(uint32_t) * a_size * b_size, FB_ALLOC_NO_HINT);
+
+    for (size_t i = 0; i < edge_count; i++) {
+        int x = edges[i] & 0xFFFF;
+        int y = edges[i] >> 16;
+        int index = (roi->w * y) + x;
+        int theta = theta_acc[index];
+        int magnitude = magnitude_acc[index];
+
+        // We have to walk the ray both ways because the gradient may be pointing inside or outside the circle.
+        // Only graidents pointing inside of the circle sum up to produce a large magnitude.
+        for (int sign = 1; sign >= -1; sign -= 2) {
+            int dx = sign * cos_q[theta];
+            int dy = sign * sin_q[theta];
+            int px = (x << HOUGH_TRIG_SHIFT) + (dx * r_min) + (1 << (HOUGH_TRIG_SHIFT - 1));
+            int py = (y << HOUGH_TRIG_SHIFT) + (dy * r_min) + (1 << (HOUGH_TRIG_SHIFT - 1));
+
+            for (int r = r_min; r < r_max; r += r_step, px += dx * r_step, py += dy * r_step) {
+                int a = px >> HOUGH_TRIG_SHIFT;
+                int b = py >> HOUGH_TRIG_SHIFT;
+                // Once the circle doesn't fit in the window it won't for any larger radius either.
+                if ((a < r) || ((roi->w - r) <= a) || (b < r) || ((roi->h - r) <= b)) {
                     break;
                 }
+                acc[(((b >> hough_shift) + 1) * a_size) + ((a >> hough_shift) + 1)] += magnitude; // add offset
             }
         }
+    }
 
-        for (int y = 1, yy = b_size - 1; y < yy; y++) {
-            uint32_t *row_ptr = acc + (a_size * y);
-            uint32_t val;
-            for (int x = 1, xx = a_size - 1; x < xx; x++) {
-                val = row_ptr[x];
-                if ((val >= threshold)
-                    && (val >= row_ptr[x - a_size - 1])
-                    && (val >= row_ptr[x - a_size])
-                    && (val >= row_ptr[x - a_size + 1])
-                    && (val >= row_ptr[x - 1])
-                    && (val >= row_ptr[x + 1])
-                    && (val >= row_ptr[x + a_size - 1])
-                    && (val >= row_ptr[x + a_size])
-                    && (val >= row_ptr[x + a_size + 1])) {
-
-                    find_circles_list_lnk_data_t lnk_data;
-                    lnk_data.magnitude = val;
-                    lnk_data.p.x = ((x - 1) << hough_shift) + r + roi->x; // remove offset
-                    lnk_data.p.y = ((y - 1) << hough_shift) + r + roi->y; // remove offset
-                    lnk_data.r = r;
-
-                    list_push_back(out, &lnk_data);
-                    if (val > row_ptr[x + 1]) {
-                        x++; // can skip the next pixel
-                    }
+    // Stage 2: centers whose neighbourhood collected enough votes get their radii from a distance histogram.
+    hough_circle_t c = {
+        .edges = edges,
+        .edge_count = edge_count,
+        .theta_acc = theta_acc,
+        .magnitude_acc = magnitude_acc,
+        .cos_q = cos_q,
+        .sin_q = sin_q,
+        .hist = hist,
+        .w = roi->w,
+        .h = roi->h,
+        .r_min = r_min,
+        .r_max = r_max,
+        .r_step = r_step,
+        .ray_tol = hough_divide << (HOUGH_TRIG_SHIFT - 1), // same as hitting the center cell in stage 1
+        .threshold = threshold
+    };
+
+    for (int y = 1, yy = b_size - 1; y < yy; y++) {
+        uint32_t *row_ptr = acc + (a_size * y);
+        uint32_t val;
+        for (int x = 1, xx = a_size - 1; x < xx; x++) {
+            val = row_ptr[x];
+            if (val
+                && (val >= row_ptr[x - a_size - 1])
+                && (val >= row_ptr[x - a_size])
+                && (val >= row_ptr[x - a_size + 1])
+                && (val >= row_ptr[x - 1])
+                && (val >= row_ptr[x + 1])
+                && (val >= row_ptr[x + a_size - 1])
+                && (val >= row_ptr[x + a_size])
+                && (val >= row_ptr[x + a_size + 1])) {
+
+                // Rounding spreads the votes of a circle over the neighbouring cells.
+                uint32_t sum = val
+                               + row_ptr[x - a_size - 1] + row_ptr[x - a_size] + row_ptr[x - a_size + 1]
+                               + row_ptr[x - 1] + row_ptr[x + 1]
+                               + row_ptr[x + a_size - 1] + row_ptr[x + a_size] + row_ptr[x + a_size + 1];
+
+                if ((sum >= threshold)
+                    && hough_circle_is_peak(acc, a_size, b_size, x, y, x_margin >> hough_shift, y_margin >> hough_shift)) {
+                    // Move the center to the centroid of the neighbourhood.
+                    int x_diff = (int) (row_ptr[x - a_size + 1] + row_ptr[x + 1] + row_ptr[x + a_size + 1])
+                                 - (int) (row_ptr[x - a_size - 1] + row_ptr[x - 1] + row_ptr[x + a_size - 1]);
+                    int y_diff = (int) (row_ptr[x + a_size - 1] + row_ptr[x + a_size] + row_ptr[x + a_size + 1])
+                                 - (int) (row_ptr[x - a_size - 1] + row_ptr[x - a_size] + row_ptr[x - a_size + 1]);
+                    int cx = ((x - 1) << hough_shift) + (hough_divide / 2) // remove offset
+                             + fast_roundf(((float) (x_diff * hough_divide)) / sum);
+                    int cy = ((y - 1) << hough_shift) + (hough_divide / 2) // remove offset
+                             + fast_roundf(((float) (y_diff * hough_divide)) / sum);
+                    hough_circle_radii(out, &c, roi, cx, cy);
+                }
+
+                if (val > row_ptr[x + 1]) {
+                    x++; // can skip the next pixel
                 }
             }
         }
-
-        fb_free(); // rsin
-        fb_free(); // rcos
-        fb_free(); // acc
     }
 
+    fb_free(); // acc
+    fb_free(); // hist
+    fb_free(); // sin_q
+    fb_free(); // cos_q
+    fb_free(); // edges
     fb_free(); // magnitude_acc
     fb_free(); // theta_acc
 
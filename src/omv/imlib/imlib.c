@@ -9,8 +9,10 @@
  * Image library.
  */
 #include <stdlib.h>
+#include <string.h>
 #include "py/obj.h"
 #include "py/runtime.h"
+#include "py/mphal.h"
 
 #include "font.h"
 #include "array.h"
@@ -20,28 +22,80 @@
 #include "omv_gpu.h"
 #include "omv_boardconfig.h"
 
+// The GPU and the JPEG codec are brought up on their first use instead of at boot, so resets
+// (and wake ups) of scripts that don't use them aren't delayed.
+#if (OMV_GPU_ENABLE == 1)
+static bool imlib_gpu_initialized;
+#endif
+#if (OMV_JPEG_CODEC_ENABLE == 1)
+static bool imlib_jpeg_initialized;
+#endif
+
 void imlib_init_all() {
     #if (OMV_GPU_ENABLE == 1)
-    omv_gpu_init();
+    imlib_gpu_initialized = false;
     #endif
     #if (OMV_JPEG_CODEC_ENABLE == 1)
-    imlib_hardware_jpeg_init();
+    imlib_jpeg_initialized = false;
     #endif
 }
 
 void imlib_deinit_all() {
     #if (OMV_GPU_ENABLE == 1)
-    omv_gpu_deinit();
+    if (imlib_gpu_initialized) {
+        omv_gpu_deinit();
+        imlib_gpu_initialized = false;
+    }
     #endif
     #if (OMV_JPEG_CODEC_ENABLE == 1)
-    imlib_hardware_jpeg_deinit();
+    if (imlib_jpeg_initialized) {
+        imlib_hardware_jpeg_deinit();
+        imlib_jpeg_initialized = false;
+    }
     #endif
 }
 
+#if (OMV_GPU_ENABLE == 1)
+void imlib_gpu_init() {
+    if (!imlib_gpu_initialized) {
+        omv_gpu_init();
+        imlib_gpu_initialized = true;
+    }
+}
+#endif
+
+#if (OMV_JPEG_CODEC_ENABLE == 1)
+void imlib_jpeg_init() {
+    if (!imlib_jpeg_initialized) {
+        imlib_hardware_jpeg_init();
+        imlib_jpeg_initialized = true;
+    }
+}
+#endif
+
 int imlib_ksize_to_n(int ksize) {
     return ((ksize * 2) + 1) * ((ksize * 2) + 1);
 }
 
+void imlib_deadline_init(imlib_deadline_t *deadline, uint32_t budget_us) {
+    deadline->start_us = mp_hal_ticks_us();
+    deadline->budget_us = budget_us;
+    deadline->expired = false;
+}
+
+bool imlib_deadline_expired(imlib_deadline_t *deadline) {
+    if (!deadline || !deadline->budget_us) {
+        return false;
+    }
+
+    // Sticky, so that every stage after the first one to notice unwinds quickly.
+    if (!deadline->expired) {
+        deadline->expired = (mp_hal_ticks_us() - deadline->start_us) >= deadline->budget_us;
+    }
+
+    return deadline->expired;
+}
+
 /////////////////
 // Point Stuff //
 /////////////////
@@ -253,12 +307,28 @@ void image_init(image_t *ptr, int w, int h, pixformat_t pixfmt, uint32_t size, v
     ptr->pixfmt = pixfmt;
     ptr->size = size;
     ptr->pixels = pixels;
+    ptr->stride = 0;
 }
 
 void image_copy(image_t *dst, image_t *src) {
     memcpy(dst, src, sizeof(image_t));
 }
 
+// Copies the pixels of two images with the same geometry, either image may be strided.
+void image_copy_rows(image_t *dst, image_t *src) {
+    size_t line_size = image_line_size(src);
+
+    if (!dst->stride && !src->stride) {
+        memcpy(dst->data, src->data, line_size * src->h);
+    } else {
+        size_t dst_stride = image_row_stride(dst);
+        size_t src_stride = image_row_stride(src);
+        for (int y = 0; y < src->h; y++) {
+            memcpy(dst->data + (dst_stride * y), src->data + (src_stride * y), line_size);
+        }
+    }
+}
+
 size_t image_line_size(image_t *ptr) {
     switch (ptr->pixfmt) {
         case PIXFORMAT_BINARY: {
@@ -269,6 +339,9 @@ size_t image_line_size(image_t *ptr) {
             // re-use
             return IMAGE_GRAYSCALE_LINE_LEN_BYTES(ptr);
         }
+        case PIXFORMAT_GRAYSCALE16: {
+            return IMAGE_GRAYSCALE16_LINE_LEN_BYTES(ptr);
+        }
         case PIXFORMAT_RGB565:
         case PIXFORMAT_YUV_ANY: {
             // re-use
@@ -280,6 +353,10 @@ size_t image_line_size(image_t *ptr) {
     }
 }
 
+size_t image_row_stride(image_t *ptr) {
+    return ptr->stride ? ptr->stride : image_line_size(ptr);
+}
+
 size_t image_size(image_t *ptr) {
     switch (ptr->pixfmt) {
         case PIXFORMAT_BINARY: {
@@ -290,6 +367,9 @@ size_t image_size(image_t *ptr) {
             // re-use
             return IMAGE_GRAYSCALE_LINE_LEN_BYTES(ptr) * ptr->h;
         }
+        case PIXFORMAT_GRAYSCALE16: {
+            return IMAGE_GRAYSCALE16_LINE_LEN_BYTES(ptr) * ptr->h;
+        }
         case PIXFORMAT_RGB565:
         case PIXFORMAT_YUV_ANY: {
             // re-use
@@ -316,6 +396,9 @@ bool image_get_mask_pixel(image_t *ptr, int x, int y) {
             case PIXFORMAT_RGB565: {
                 return COLOR_RGB565_TO_BINARY(IMAGE_GET_RGB565_PIXEL(ptr, x, y));
             }
+            case PIXFORMAT_GRAYSCALE16: {
+                return IMAGE_GET_GRAYSCALE16_PIXEL(ptr, x, y) > (COLOR_GRAYSCALE16_MAX / 2);
+            }
             default: {
                 return false;
             }
@@ -358,6 +441,26 @@ const int kernel_high_pass_3[3 * 3] = {
 // between min and max. The image w*h must equal the floating point array w*h.
 void imlib_fill_image_from_float(image_t *img, int w, int h, float *data, float min, float max,
                                  bool mirror, bool flip, bool dst_transpose, bool src_transpose) {
+    // 16-bit images store the temperatures in centi-kelvin, which doesn't need a range.
+    if (img->pixfmt == PIXFORMAT_GRAYSCALE16) {
+        uint16_t *pixels = (uint16_t *) img->data;
+        int w_1 = w - 1;
+        int h_1 = h - 1;
+
+        for (int y = 0; y < h; y++) {
+            int y_dst = flip ? (h_1 - y) : y;
+
+            for (int x = 0; x < w; x++) {
+                int x_dst = mirror ? (w_1 - x) : x;
+                float raw = src_transpose ? data[(x * h) + y] : data[(y * w) + x];
+                int pixel = __USAT(fast_roundf((raw + 273.15f) * 100.f), 16);
+                pixels[dst_transpose ? ((x_dst * h) + y_dst) : ((y_dst * w) + x_dst)] = pixel;
+            }
+        }
+
+        return;
+    }
+
     float tmp = min;
     min = (min < max) ? min : max;
     max = (max > tmp) ? max : tmp;
@@ -502,6 +605,69 @@ uint16_t imlib_yuv_to_rgb(uint8_t y, int8_t u, int8_t v) {
     return COLOR_R8_G8_B8_TO_RGB565(r, g, b);
 }
 
+#if defined(IMLIB_ENABLE_THRESHOLD_LUT)
+typedef struct threshold_lut {
+    uint32_t age;
+    size_t n;
+    bool invert;
+    color_thresholds_list_lnk_data_t thresholds[IMLIB_THRESHOLD_LUT_MAX_THRESHOLDS];
+    uint32_t bitmap[65536 / 32];
+} threshold_lut_t;
+
+static threshold_lut_t threshold_lut_cache[IMLIB_THRESHOLD_LUT_SLOTS];
+static uint32_t threshold_lut_age;
+
+// Returns a 65536 bit table indexed by the RGB565 pixel value which is set when the pixel
+// passes any of the thresholds. The tables are cached, so tracking the same colors every
+// frame only pays for the compilation once. Returns NULL if the thresholds can't be compiled.
+const uint32_t *imlib_rgb565_threshold_lut(color_thresholds_list_lnk_data_t *thresholds, size_t n, bool invert) {
+    if ((!n) || (n > IMLIB_THRESHOLD_LUT_MAX_THRESHOLDS)) {
+        return NULL;
+    }
+
+    threshold_lut_t *lut = &threshold_lut_cache[0];
+
+    for (int i = 0; i < IMLIB_THRESHOLD_LUT_SLOTS; i++) {
+        threshold_lut_t *slot = &threshold_lut_cache[i];
+
+        if ((slot->n == n) && (slot->invert == invert)
+            && (!memcmp(slot->thresholds, thresholds, n * sizeof(color_thresholds_list_lnk_data_t)))) {
+            slot->age = ++threshold_lut_age;
+            return slot->bitmap;
+        }
+
+        // Replace the least recently used slot.
+        if (slot->age < lut->age) {
+            lut = slot;
+        }
+    }
+
+    memset(lut->bitmap, 0, sizeof(lut->bitmap));
+
+    for (uint32_t pixel = 0; pixel < 65536; pixel++) {
+        uint8_t l = COLOR_RGB565_TO_L(pixel);
+        int8_t a = COLOR_RGB565_TO_A(pixel);
+        int8_t b = COLOR_RGB565_TO_B(pixel);
+
+        for (size_t i = 0; i < n; i++) {
+            color_thresholds_list_lnk_data_t *t = &thresholds[i];
+            if (((t->LMin <= l) && (l <= t->LMax) &&
+                 (t->AMin <= a) && (a <= t->AMax) &&
+                 (t->BMin <= b) && (b <= t->BMax)) ^ invert) {
+                lut->bitmap[pixel >> 5] |= 1 << (pixel & 0x1f);
+                break;
+            }
+        }
+    }
+
+    lut->n = n;
+    lut->invert = invert;
+    memcpy(lut->thresholds, thresholds, n * sizeof(color_thresholds_list_lnk_data_t));
+    lut->age = ++threshold_lut_age;
+    return lut->bitmap;
+}
+#endif // IMLIB_ENABLE_THRESHOLD_LUT
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
@@ -636,6 +802,84 @@ void imlib_load_image(image_t *img, const char *path) {
     imblib_parse_extension(img, path); // Enforce extension!
 }
 
+// BMP and PPM files are streamed a band of scale rows at a time, which are scaled down and
+// converted into img, so only the band needs to be buffered instead of the whole image.
+static void imlib_load_image_rows(image_t *img, FIL *fp, image_t *src, img_read_settings_t *rs,
+                                  bool vflipped, rectangle_t *roi, int scale) {
+    int band_h = IM_MIN(scale, roi->h);
+    int y_start = roi->y;
+    int y_end = roi->y + (img->h * band_h);
+
+    image_t band = {
+        .w = src->w,
+        .h = band_h,
+        .pixfmt = src->pixfmt,
+    };
+
+    band.data = fb_alloc(image_size(&band), FB_ALLOC_PREFER_SPEED);
+    rectangle_t band_roi = {roi->x, 0, roi->w, band_h};
+
+    for (int i = 0, n = 0; i < src->h; i++) {
+        // BMP files are usually stored bottom-up.
+        int y = vflipped ? (src->h - i - 1) : i;
+
+        if ((vflipped && (y < y_start)) || ((!vflipped) && (y >= y_end))) {
+            break;
+        }
+
+        uint8_t *row = NULL;
+
+        if ((y >= y_start) && (y < y_end)) {
+            row = band.data + (((y - y_start) % band_h) * band.w * band.bpp);
+        }
+
+        if (rs->format == FORMAT_BMP) {
+            bmp_read_row(fp, src, row, &rs->bmp_rs);
+        } else {
+            ppm_read_row(fp, src, row, &rs->ppm_rs);
+        }
+
+        if (row && (++n == band_h)) {
+            n = 0;
+            imlib_draw_image(img, &band, 0, (y - y_start) / band_h, 1.0f / scale, 1.0f / band_h, &band_roi, -1, 256,
+                             NULL, NULL, IMAGE_HINT_AREA | IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
+        }
+    }
+
+    fb_free(); // band.data
+}
+
+void imlib_load_image_roi(image_t *img, const char *path, rectangle_t *roi, int scale) {
+    FIL fp;
+    img_read_settings_t rs;
+    image_t src = {0};
+
+    fb_alloc_mark();
+    bool vflipped = imlib_read_geometry(&fp, &src, path, &rs);
+
+    if ((rs.format == FORMAT_BMP) || (rs.format == FORMAT_PNM)) {
+        imlib_load_image_rows(img, &fp, &src, &rs, vflipped, roi, scale);
+        file_close(&fp);
+        fb_alloc_free_till_mark();
+        return;
+    }
+
+    file_close(&fp);
+
+    src.data = fb_alloc(image_size(&src), FB_ALLOC_PREFER_SIZE);
+    imlib_load_image(&src, path);
+
+    if (src.pixfmt == PIXFORMAT_JPEG) {
+        // Only the MCUs under the roi are decoded (and scaled down in the DCT domain).
+        jpeg_decompress_roi(img, &src, roi, scale);
+    } else {
+        imlib_draw_image(img, &src, 0, 0, 1.0f / scale, 1.0f / scale, roi, -1, 256, NULL, NULL,
+                         IMAGE_HINT_AREA | IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
+    }
+
+    fb_alloc_free_till_mark();
+}
+
 void imlib_save_image(image_t *img, const char *path, rectangle_t *roi, int quality) {
     switch (imblib_parse_extension(img, path)) {
         case FORMAT_BMP:
@@ -655,7 +899,7 @@ void imlib_save_image(image_t *img, const char *path, rectangle_t *roi, int qual
             jpeg_write(img, path, quality);
             break;
         case FORMAT_PNG:
-            png_write(img, path);
+            png_write(img, path, PNG_EFFORT_BEST);
             break;
         case FORMAT_DONT_CARE:
             // Path doesn't have an extension.
@@ -665,7 +909,7 @@ void imlib_save_image(image_t *img, const char *path, rectangle_t *roi, int qual
                 fb_free();
             } else if (img->pixfmt == PIXFORMAT_PNG) {
                 char *new_path = strcat(strcpy(fb_alloc(strlen(path) + 5, FB_ALLOC_NO_HINT), path), ".png");
-                png_write(img, new_path);
+                png_write(img, new_path, PNG_EFFORT_BEST);
                 fb_free();
             } else if (IM_IS_BAYER(img)) {
                 FIL fp;
@@ -731,7 +975,31 @@ void imlib_zero(image_t *img, image_t *mask, bool invert) {
 #ifdef IMLIB_ENABLE_LENS_CORR
 // A simple algorithm for correcting lens distortion.
 // See http://www.tannerhelland.com/4743/simple-algorithm-correcting-lens-distortion/
-void imlib_lens_corr(image_t *img, float strength, float zoom, float x_corr, float y_corr) {
+// Precomputes the lens correction source offsets of the top left quadrant of a w x h image,
+// the other 3 quadrants are mirrored. The map holds (w / 2) * (h / 2) (x, y) int16_t pairs.
+void imlib_lens_corr_map_init(int16_t *map, int w, int h, float strength, float zoom) {
+    int halfWidth = w / 2;
+    int halfHeight = h / 2;
+    float maximum_diameter = fast_sqrtf((w * w) + (h * h));
+    float lens_corr_diameter = strength / maximum_diameter;
+    zoom = 1 / zoom;
+
+    for (int y = 0; y < halfHeight; y++) {
+        int newY = y - halfHeight;
+        int newY2 = newY * newY;
+
+        for (int x = 0; x < halfWidth; x++) {
+            int newX = x - halfWidth;
+            int newX2 = newX * newX;
+            float r = lens_corr_diameter * ((int) fast_sqrtf(newX2 + newY2));
+            float precalculated = (fast_atanf(r) / r) * zoom;
+            *map++ = fast_roundf(precalculated * newX); // rounding is necessary
+            *map++ = fast_roundf(precalculated * newY); // rounding is necessary
+        }
+    }
+}
+
+void imlib_lens_corr(image_t *img, float strength, float zoom, float x_corr, float y_corr, const int16_t *map) {
     int w = img->w;
     int h = img->h;
     int halfWidth = w / 2;
@@ -751,11 +1019,15 @@ void imlib_lens_corr(image_t *img, float strength, float zoom, float x_corr, flo
     memset(img->data, 0, size);
 
     int maximum_radius = fast_ceilf(maximum_diameter / 2) + 1; // +1 inclusive of final value
-    float *precalculated_table = fb_alloc(maximum_radius * sizeof(float), FB_ALLOC_NO_HINT);
+    float *precalculated_table = NULL;
+
+    if (!map) {
+        precalculated_table = fb_alloc(maximum_radius * sizeof(float), FB_ALLOC_NO_HINT);
 
-    for (int i = 0; i < maximum_radius; i++) {
-        float r = lens_corr_diameter * i;
-        precalculated_table[i] = (fast_atanf(r) / r) * zoom;
+        for (int i = 0; i < maximum_radius; i++) {
+            float r = lens_corr_diameter * i;
+            precalculated_table[i] = (fast_atanf(r) / r) * zoom;
+        }
     }
 
     int down_adj = halfHeight + y_off;
@@ -776,9 +1048,15 @@ void imlib_lens_corr(image_t *img, float strength, float zoom, float x_corr, flo
                 for (int x = 0; x < halfWidth; x++) {
                     int newX = x - halfWidth;
                     int newX2 = newX * newX;
-                    float precalculated = precalculated_table[(int) fast_sqrtf(newX2 + newY2)];
-                    int sourceY = fast_roundf(precalculated * newY); // rounding is necessary
-                    int sourceX = fast_roundf(precalculated * newX); // rounding is necessary
+                    int sourceX, sourceY;
+                    if (map) {
+                        sourceX = *map++;
+                        sourceY = *map++;
+                    } else {
+                        float precalculated = precalculated_table[(int) fast_sqrtf(newX2 + newY2)];
+                        sourceY = fast_roundf(precalculated * newY); // rounding is necessary
+                        sourceX = fast_roundf(precalculated * newX); // rounding is necessary
+                    }
                     int sourceY_down = down_adj + sourceY;
                     int sourceY_up = up_adj - sourceY;
                     int sourceX_right = right_adj + sourceX;
@@ -830,9 +1108,15 @@ void imlib_lens_corr(image_t *img, float strength, float zoom, float x_corr, flo
                 for (int x = 0; x < halfWidth; x++) {
                     int newX = x - halfWidth;
                     int newX2 = newX * newX;
-                    float precalculated = precalculated_table[(int) fast_sqrtf(newX2 + newY2)];
-                    int sourceY = fast_roundf(precalculated * newY); // rounding is necessary
-                    int sourceX = fast_roundf(precalculated * newX); // rounding is necessary
+                    int sourceX, sourceY;
+                    if (map) {
+                        sourceX = *map++;
+                        sourceY = *map++;
+                    } else {
+                        float precalculated = precalculated_table[(int) fast_sqrtf(newX2 + newY2)];
+                        sourceY = fast_roundf(precalculated * newY); // rounding is necessary
+                        sourceX = fast_roundf(precalculated * newX); // rounding is necessary
+                    }
                     int sourceY_down = down_adj + sourceY;
                     int sourceY_up = up_adj - sourceY;
                     int sourceX_right = right_adj + sourceX;
@@ -880,9 +1164,15 @@ void imlib_lens_corr(image_t *img, float strength, float zoom, float x_corr, flo
                 for (int x = 0; x < halfWidth; x++) {
                     int newX = x - halfWidth;
                     int newX2 = newX * newX;
-                    float precalculated = precalculated_table[(int) fast_sqrtf(newX2 + newY2)];
-                    int sourceY = fast_roundf(precalculated * newY); // rounding is necessary
-                    int sourceX = fast_roundf(precalculated * newX); // rounding is necessary
+                    int sourceX, sourceY;
+                    if (map) {
+                        sourceX = *map++;
+                        sourceY = *map++;
+                    } else {
+                        float precalculated = precalculated_table[(int) fast_sqrtf(newX2 + newY2)];
+                        sourceY = fast_roundf(precalculated * newY); // rounding is necessary
+                        sourceX = fast_roundf(precalculated * newX); // rounding is necessary
+                    }
                     int sourceY_down = down_adj + sourceY;
                     int sourceY_up = up_adj - sourceY;
                     int sourceX_right = right_adj + sourceX;
@@ -923,7 +1213,10 @@ void imlib_lens_corr(image_t *img, float strength, float zoom, float x_corr, flo
         }
     }
 
-    fb_free(); // precalculated_table
+    if (precalculated_table) {
+        fb_free(); // precalculated_table
+    }
+
     fb_free(); // data
 }
 #endif //IMLIB_ENABLE_LENS_CORR
@@ -174,6 +174,11 @@ typedef struct color_thresholds_list_lnk_data {
 }
 color_thresholds_list_lnk_data_t;
 
+typedef struct gray16_thresholds_list_lnk_data {
+    uint16_t min, max;
+}
+gray16_thresholds_list_lnk_data_t;
+
 #define COLOR_THRESHOLD_BINARY(pixel, threshold, invert)                          \
     ({                                                                            \
         __typeof__ (pixel) _pixel = (pixel);                                      \
@@ -203,6 +208,19 @@ color_thresholds_list_lnk_data_t;
          (_threshold->BMin <= _b) && (_b <= _threshold->BMax)) ^ _invert; \
     })
 
+// Precompiled RGB565 thresholds, see imlib_rgb565_threshold_lut().
+#ifndef IMLIB_THRESHOLD_LUT_SLOTS
+#define IMLIB_THRESHOLD_LUT_SLOTS               (2)
+#endif
+#define IMLIB_THRESHOLD_LUT_MAX_THRESHOLDS      (16)
+
+#define COLOR_THRESHOLD_RGB565_LUT(pixel, lut, threshold, invert)              \
+    ({                                                                         \
+        __typeof__ (pixel) __pixel = (pixel);                                  \
+        (lut) ? (((lut)[__pixel >> 5] >> (__pixel & 0x1f)) & 1) :              \
+                COLOR_THRESHOLD_RGB565(__pixel, threshold, invert);            \
+    })
+
 #define COLOR_BOUND_BINARY(pixel0, pixel1, threshold)    \
     ({                                                   \
         __typeof__ (pixel0) _pixel0 = (pixel0);          \
@@ -239,6 +257,9 @@ color_thresholds_list_lnk_data_t;
 #define COLOR_GRAYSCALE_MIN                     0
 #define COLOR_GRAYSCALE_MAX                     255
 
+#define COLOR_GRAYSCALE16_MIN                   0
+#define COLOR_GRAYSCALE16_MAX                   65535
+
 #define COLOR_R5_MIN                            0
 #define COLOR_R5_MAX                            31
 #define COLOR_G6_MIN                            0
@@ -336,10 +357,55 @@ color_thresholds_list_lnk_data_t;
 
 extern const int8_t lab_table[196608 / 2];
 
-#ifdef IMLIB_ENABLE_LAB_LUT
+extern const uint16_t xyz_lin5_table[32];
+extern const uint16_t xyz_lin6_table[64];
+extern const uint16_t lab_f_table[257];
+
+// Fixed-point RGB565 to LAB using small tables (~700 bytes) instead of the 96KB LAB LUT.
+// Linear light and f(t) are scaled to 0-65535 and the XYZ matrix to 2^14. The results
+// are within +/-1 of the floating point conversion.
+#define COLOR_RGB565_TO_XYZ_FIXED(pixel, c0, c1, c2)                               \
+    ({                                                                             \
+        __typeof__ (pixel) __pixel = (pixel);                                      \
+        uint32_t __t = ((c0) * xyz_lin5_table[COLOR_RGB565_TO_R5(__pixel)] +       \
+                        (c1) * xyz_lin6_table[COLOR_RGB565_TO_G6(__pixel)] +       \
+                        (c2) * xyz_lin5_table[COLOR_RGB565_TO_B5(__pixel)]) >> 14; \
+        __t = IM_MIN(__t, 65535);                                                  \
+        int32_t __f0 = lab_f_table[__t >> 8];                                      \
+        int32_t __f1 = lab_f_table[(__t >> 8) + 1];                                \
+        __f0 + (((__f1 - __f0) * ((int32_t) (__t & 0xFF))) >> 8);                  \
+    })
+
+#define COLOR_RGB565_TO_X_FIXED(pixel)          COLOR_RGB565_TO_XYZ_FIXED(pixel, 7109, 6164, 3111)
+#define COLOR_RGB565_TO_Y_FIXED(pixel)          COLOR_RGB565_TO_XYZ_FIXED(pixel, 3483, 11718, 1183)
+#define COLOR_RGB565_TO_Z_FIXED(pixel)          COLOR_RGB565_TO_XYZ_FIXED(pixel, 290, 1794, 14303)
+
+#define COLOR_RGB565_TO_L_FIXED(pixel)                                             \
+    ({                                                                             \
+        int32_t __l = ((116 * COLOR_RGB565_TO_Y_FIXED(pixel)) >> 16) - 16;         \
+        IM_CLAMP(__l, COLOR_L_MIN, COLOR_L_MAX);                                   \
+    })
+
+#define COLOR_RGB565_TO_A_FIXED(pixel)                                             \
+    ({                                                                             \
+        __typeof__ (pixel) __p = (pixel);                                          \
+        __SSAT((500 * (COLOR_RGB565_TO_X_FIXED(__p) - COLOR_RGB565_TO_Y_FIXED(__p))) >> 16, 8); \
+    })
+
+#define COLOR_RGB565_TO_B_FIXED(pixel)                                             \
+    ({                                                                             \
+        __typeof__ (pixel) __p = (pixel);                                          \
+        __SSAT((200 * (COLOR_RGB565_TO_Y_FIXED(__p) - COLOR_RGB565_TO_Z_FIXED(__p))) >> 16, 8); \
+    })
+
+#if defined(IMLIB_ENABLE_LAB_LUT)
 #define COLOR_RGB565_TO_L(pixel)                lab_table[((pixel >> 1) * 3) + 0]
 #define COLOR_RGB565_TO_A(pixel)                lab_table[((pixel >> 1) * 3) + 1]
 #define COLOR_RGB565_TO_B(pixel)                lab_table[((pixel >> 1) * 3) + 2]
+#elif defined(IMLIB_ENABLE_LAB_FIXED)
+#define COLOR_RGB565_TO_L(pixel)                COLOR_RGB565_TO_L_FIXED(pixel)
+#define COLOR_RGB565_TO_A(pixel)                COLOR_RGB565_TO_A_FIXED(pixel)
+#define COLOR_RGB565_TO_B(pixel)                COLOR_RGB565_TO_B_FIXED(pixel)
 #else
 #define COLOR_RGB565_TO_L(pixel)                imlib_rgb565_to_l(pixel)
 #define COLOR_RGB565_TO_A(pixel)                imlib_rgb565_to_a(pixel)
@@ -440,6 +506,7 @@ typedef enum {
   PIXFORMAT_INVALID    = (0x00000000U),
   PIXFORMAT_BINARY     = (PIXFORMAT_FLAGS_M  | (PIXFORMAT_ID_BINARY << 16) | (0                   << 8) | PIXFORMAT_BPP_BINARY ),
   PIXFORMAT_GRAYSCALE  = (PIXFORMAT_FLAGS_M  | (PIXFORMAT_ID_GRAY   << 16) | (SUBFORMAT_ID_GRAY8  << 8) | PIXFORMAT_BPP_GRAY8  ),
+  PIXFORMAT_GRAYSCALE16 = (0                 | (PIXFORMAT_ID_GRAY   << 16) | (SUBFORMAT_ID_GRAY16 << 8) | PIXFORMAT_BPP_GRAY16 ),
   PIXFORMAT_RGB565     = (PIXFORMAT_FLAGS_CM | (PIXFORMAT_ID_RGB565 << 16) | (0                   << 8) | PIXFORMAT_BPP_RGB565 ),
   PIXFORMAT_ARGB8      = (PIXFORMAT_FLAGS_CM | (PIXFORMAT_ID_ARGB8  << 16) | (0                   << 8) | PIXFORMAT_BPP_ARGB8  ),
   PIXFORMAT_BAYER      = (PIXFORMAT_FLAGS_CR | (PIXFORMAT_ID_BAYER  << 16) | (SUBFORMAT_ID_BGGR   << 8) | PIXFORMAT_BPP_BAYER  ),
@@ -479,6 +546,7 @@ typedef enum {
 #define IMLIB_PIXFORMAT_IS_VALID(x) \
     ((x == PIXFORMAT_BINARY)        \
      || (x == PIXFORMAT_GRAYSCALE)  \
+     || (x == PIXFORMAT_GRAYSCALE16) \
      || (x == PIXFORMAT_RGB565)     \
      || (x == PIXFORMAT_ARGB8)      \
      || (x == PIXFORMAT_BAYER_BGGR) \
@@ -542,11 +610,16 @@ typedef struct image {
         uint8_t *pixels;
         uint8_t *data;
     };
+    // Distance between rows in bytes. Rows are tightly packed if 0, otherwise the stride
+    // must be at least the line size, and a multiple of 4 bytes for binary images.
+    uint32_t stride;
 } image_t;
 
 void image_init(image_t *ptr, int w, int h, pixformat_t pixfmt, uint32_t size, void *pixels);
 void image_copy(image_t *dst, image_t *src);
+void image_copy_rows(image_t *dst, image_t *src);
 size_t image_line_size(image_t *ptr);
+size_t image_row_stride(image_t *ptr);
 size_t image_size(image_t *ptr);
 bool image_get_mask_pixel(image_t *ptr, int x, int y);
 
@@ -556,123 +629,149 @@ bool image_get_mask_pixel(image_t *ptr, int x, int y);
 #define IMAGE_GRAYSCALE_LINE_LEN(image)          ((image)->w)
 #define IMAGE_GRAYSCALE_LINE_LEN_BYTES(image)    (IMAGE_GRAYSCALE_LINE_LEN(image) * sizeof(uint8_t))
 
+#define IMAGE_GRAYSCALE16_LINE_LEN(image)        ((image)->w)
+#define IMAGE_GRAYSCALE16_LINE_LEN_BYTES(image)  (IMAGE_GRAYSCALE16_LINE_LEN(image) * sizeof(uint16_t))
+
 #define IMAGE_RGB565_LINE_LEN(image)             ((image)->w)
 #define IMAGE_RGB565_LINE_LEN_BYTES(image)       (IMAGE_RGB565_LINE_LEN(image) * sizeof(uint16_t))
 
-#define IMAGE_GET_BINARY_PIXEL(image, x, y)                                                                              \
-    ({                                                                                                                   \
-        __typeof__ (image) _image = (image);                                                                             \
-        __typeof__ (x) _x = (x);                                                                                         \
-        __typeof__ (y) _y = (y);                                                                                         \
-        (((uint32_t *) _image->data)[(((_image->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * _y) + (_x >> UINT32_T_SHIFT)] >> \
-         (_x & UINT32_T_MASK)) & 1;                                                                                      \
+#define IMAGE_ROW_STRIDE(image, line_len_bytes)  ((int32_t) ((image)->stride ? (image)->stride : (line_len_bytes)))
+#define IMAGE_BINARY_ROW_STRIDE(image)           IMAGE_ROW_STRIDE(image, IMAGE_BINARY_LINE_LEN_BYTES(image))
+#define IMAGE_GRAYSCALE_ROW_STRIDE(image)        IMAGE_ROW_STRIDE(image, IMAGE_GRAYSCALE_LINE_LEN_BYTES(image))
+#define IMAGE_GRAYSCALE16_ROW_STRIDE(image)      IMAGE_ROW_STRIDE(image, IMAGE_GRAYSCALE16_LINE_LEN_BYTES(image))
+#define IMAGE_RGB565_ROW_STRIDE(image)           IMAGE_ROW_STRIDE(image, IMAGE_RGB565_LINE_LEN_BYTES(image))
+
+#define IMAGE_GET_BINARY_PIXEL(image, x, y)                                                              \
+    ({                                                                                                   \
+        __typeof__ (image) _image = (image);                                                             \
+        __typeof__ (x) _x = (x);                                                                         \
+        __typeof__ (y) _y = (y);                                                                         \
+        (((uint32_t *) (_image->data + (IMAGE_BINARY_ROW_STRIDE(_image) * _y)))[_x >> UINT32_T_SHIFT] >> \
+         (_x & UINT32_T_MASK)) & 1;                                                                      \
     })
 
-#define IMAGE_PUT_BINARY_PIXEL(image, x, y, v)                                                                 \
-    ({                                                                                                         \
-        __typeof__ (image) _image = (image);                                                                   \
-        __typeof__ (x) _x = (x);                                                                               \
-        __typeof__ (y) _y = (y);                                                                               \
-        __typeof__ (v) _v = (v);                                                                               \
-        size_t _i = (((_image->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * _y) + (_x >> UINT32_T_SHIFT);           \
-        size_t _j = _x & UINT32_T_MASK;                                                                        \
-        ((uint32_t *) _image->data)[_i] = (((uint32_t *) _image->data)[_i] & (~(1 << _j))) | ((_v & 1) << _j); \
+#define IMAGE_PUT_BINARY_PIXEL(image, x, y, v)                                                 \
+    ({                                                                                         \
+        __typeof__ (image) _image = (image);                                                   \
+        __typeof__ (x) _x = (x);                                                               \
+        __typeof__ (y) _y = (y);                                                               \
+        __typeof__ (v) _v = (v);                                                               \
+        uint32_t *_row = (uint32_t *) (_image->data + (IMAGE_BINARY_ROW_STRIDE(_image) * _y)); \
+        size_t _i = _x >> UINT32_T_SHIFT;                                                      \
+        size_t _j = _x & UINT32_T_MASK;                                                        \
+        _row[_i] = (_row[_i] & (~(1 << _j))) | ((_v & 1) << _j);                               \
     })
 
-#define IMAGE_CLEAR_BINARY_PIXEL(image, x, y)                                                                          \
-    ({                                                                                                                 \
-        __typeof__ (image) _image = (image);                                                                           \
-        __typeof__ (x) _x = (x);                                                                                       \
-        __typeof__ (y) _y = (y);                                                                                       \
-        ((uint32_t *) _image->data)[(((_image->w + UINT32_T_MASK) >>                                                   \
-                                      UINT32_T_SHIFT) * _y) + (_x >> UINT32_T_SHIFT)] &= ~(1 << (_x & UINT32_T_MASK)); \
+#define IMAGE_CLEAR_BINARY_PIXEL(image, x, y)                                                           \
+    ({                                                                                                  \
+        __typeof__ (image) _image = (image);                                                            \
+        __typeof__ (x) _x = (x);                                                                        \
+        __typeof__ (y) _y = (y);                                                                        \
+        ((uint32_t *) (_image->data + (IMAGE_BINARY_ROW_STRIDE(_image) * _y)))[_x >> UINT32_T_SHIFT] &= \
+            ~(1 << (_x & UINT32_T_MASK));                                                               \
     })
 
-#define IMAGE_SET_BINARY_PIXEL(image, x, y)                                                                                              \
-    ({                                                                                                                                   \
-        __typeof__ (image) _image = (image);                                                                                             \
-        __typeof__ (x) _x = (x);                                                                                                         \
-        __typeof__ (y) _y = (y);                                                                                                         \
-        ((uint32_t *) _image->data)[(((_image->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * _y) + (_x >> UINT32_T_SHIFT)] |= 1 <<             \
-                                                                                                                        (_x &            \
-                                                                                                                         UINT32_T_MASK); \
+#define IMAGE_SET_BINARY_PIXEL(image, x, y)                                                             \
+    ({                                                                                                  \
+        __typeof__ (image) _image = (image);                                                            \
+        __typeof__ (x) _x = (x);                                                                        \
+        __typeof__ (y) _y = (y);                                                                        \
+        ((uint32_t *) (_image->data + (IMAGE_BINARY_ROW_STRIDE(_image) * _y)))[_x >> UINT32_T_SHIFT] |= \
+            1 << (_x & UINT32_T_MASK);                                                                  \
     })
 
-#define IMAGE_GET_GRAYSCALE_PIXEL(image, x, y)             \
-    ({                                                     \
-        __typeof__ (image) _image = (image);               \
-        __typeof__ (x) _x = (x);                           \
-        __typeof__ (y) _y = (y);                           \
-        ((uint8_t *) _image->data)[(_image->w * _y) + _x]; \
+#define IMAGE_GET_GRAYSCALE_PIXEL(image, x, y)                          \
+    ({                                                                  \
+        __typeof__ (image) _image = (image);                            \
+        __typeof__ (x) _x = (x);                                        \
+        __typeof__ (y) _y = (y);                                        \
+        (_image->data + (IMAGE_GRAYSCALE_ROW_STRIDE(_image) * _y))[_x]; \
     })
 
-#define IMAGE_PUT_GRAYSCALE_PIXEL(image, x, y, v)               \
-    ({                                                          \
-        __typeof__ (image) _image = (image);                    \
-        __typeof__ (x) _x = (x);                                \
-        __typeof__ (y) _y = (y);                                \
-        __typeof__ (v) _v = (v);                                \
-        ((uint8_t *) _image->data)[(_image->w * _y) + _x] = _v; \
+#define IMAGE_PUT_GRAYSCALE_PIXEL(image, x, y, v)                            \
+    ({                                                                       \
+        __typeof__ (image) _image = (image);                                 \
+        __typeof__ (x) _x = (x);                                             \
+        __typeof__ (y) _y = (y);                                             \
+        __typeof__ (v) _v = (v);                                             \
+        (_image->data + (IMAGE_GRAYSCALE_ROW_STRIDE(_image) * _y))[_x] = _v; \
     })
 
-#define IMAGE_GET_RGB565_PIXEL(image, x, y)                 \
-    ({                                                      \
-        __typeof__ (image) _image = (image);                \
-        __typeof__ (x) _x = (x);                            \
-        __typeof__ (y) _y = (y);                            \
-        ((uint16_t *) _image->data)[(_image->w * _y) + _x]; \
+#define IMAGE_GET_GRAYSCALE16_PIXEL(image, x, y)                                         \
+    ({                                                                                   \
+        __typeof__ (image) _image = (image);                                             \
+        __typeof__ (x) _x = (x);                                                         \
+        __typeof__ (y) _y = (y);                                                         \
+        ((uint16_t *) (_image->data + (IMAGE_GRAYSCALE16_ROW_STRIDE(_image) * _y)))[_x]; \
     })
 
-#define IMAGE_PUT_RGB565_PIXEL(image, x, y, v)                   \
-    ({                                                           \
-        __typeof__ (image) _image = (image);                     \
-        __typeof__ (x) _x = (x);                                 \
-        __typeof__ (y) _y = (y);                                 \
-        __typeof__ (v) _v = (v);                                 \
-        ((uint16_t *) _image->data)[(_image->w * _y) + _x] = _v; \
+#define IMAGE_PUT_GRAYSCALE16_PIXEL(image, x, y, v)                                           \
+    ({                                                                                        \
+        __typeof__ (image) _image = (image);                                                  \
+        __typeof__ (x) _x = (x);                                                              \
+        __typeof__ (y) _y = (y);                                                              \
+        __typeof__ (v) _v = (v);                                                              \
+        ((uint16_t *) (_image->data + (IMAGE_GRAYSCALE16_ROW_STRIDE(_image) * _y)))[_x] = _v; \
+    })
+
+#define IMAGE_GET_RGB565_PIXEL(image, x, y)                                         \
+    ({                                                                              \
+        __typeof__ (image) _image = (image);                                        \
+        __typeof__ (x) _x = (x);                                                    \
+        __typeof__ (y) _y = (y);                                                    \
+        ((uint16_t *) (_image->data + (IMAGE_RGB565_ROW_STRIDE(_image) * _y)))[_x]; \
     })
 
-#define IMAGE_GET_YUV_PIXEL(image, x, y)                    \
-    ({                                                      \
-        __typeof__ (image) _image = (image);                \
-        __typeof__ (x) _x = (x);                            \
-        __typeof__ (y) _y = (y);                            \
-        ((uint16_t *) _image->data)[(_image->w * _y) + _x]; \
+#define IMAGE_PUT_RGB565_PIXEL(image, x, y, v)                                           \
+    ({                                                                                   \
+        __typeof__ (image) _image = (image);                                             \
+        __typeof__ (x) _x = (x);                                                         \
+        __typeof__ (y) _y = (y);                                                         \
+        __typeof__ (v) _v = (v);                                                         \
+        ((uint16_t *) (_image->data + (IMAGE_RGB565_ROW_STRIDE(_image) * _y)))[_x] = _v; \
     })
 
-#define IMAGE_PUT_YUV_PIXEL(image, x, y, v)                      \
-    ({                                                           \
-        __typeof__ (image) _image = (image);                     \
-        __typeof__ (x) _x = (x);                                 \
-        __typeof__ (y) _y = (y);                                 \
-        __typeof__ (v) _v = (v);                                 \
-        ((uint16_t *) _image->data)[(_image->w * _y) + _x] = _v; \
+#define IMAGE_GET_YUV_PIXEL(image, x, y)                                            \
+    ({                                                                              \
+        __typeof__ (image) _image = (image);                                        \
+        __typeof__ (x) _x = (x);                                                    \
+        __typeof__ (y) _y = (y);                                                    \
+        ((uint16_t *) (_image->data + (IMAGE_RGB565_ROW_STRIDE(_image) * _y)))[_x]; \
     })
 
-#define IMAGE_GET_BAYER_PIXEL(image, x, y)                 \
-    ({                                                     \
-        __typeof__ (image) _image = (image);               \
-        __typeof__ (x) _x = (x);                           \
-        __typeof__ (y) _y = (y);                           \
-        ((uint8_t *) _image->data)[(_image->w * _y) + _x]; \
+#define IMAGE_PUT_YUV_PIXEL(image, x, y, v)                                              \
+    ({                                                                                   \
+        __typeof__ (image) _image = (image);                                             \
+        __typeof__ (x) _x = (x);                                                         \
+        __typeof__ (y) _y = (y);                                                         \
+        __typeof__ (v) _v = (v);                                                         \
+        ((uint16_t *) (_image->data + (IMAGE_RGB565_ROW_STRIDE(_image) * _y)))[_x] = _v; \
+    })
+
+#define IMAGE_GET_BAYER_PIXEL(image, x, y)                              \
+    ({                                                                  \
+        __typeof__ (image) _image = (image);                            \
+        __typeof__ (x) _x = (x);                                        \
+        __typeof__ (y) _y = (y);                                        \
+        (_image->data + (IMAGE_GRAYSCALE_ROW_STRIDE(_image) * _y))[_x]; \
     })
 
-#define IMAGE_PUT_BAYER_PIXEL(image, x, y, v)                   \
-    ({                                                          \
-        __typeof__ (image) _image = (image);                    \
-        __typeof__ (x) _x = (x);                                \
-        __typeof__ (y) _y = (y);                                \
-        __typeof__ (v) _v = (v);                                \
-        ((uint8_t *) _image->data)[(_image->w * _y) + _x] = _v; \
+#define IMAGE_PUT_BAYER_PIXEL(image, x, y, v)                                \
+    ({                                                                       \
+        __typeof__ (image) _image = (image);                                 \
+        __typeof__ (x) _x = (x);                                             \
+        __typeof__ (y) _y = (y);                                             \
+        __typeof__ (v) _v = (v);                                             \
+        (_image->data + (IMAGE_GRAYSCALE_ROW_STRIDE(_image) * _y))[_x] = _v; \
     })
 
 // Fast Stuff //
 
-#define IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(image, y)                                          \
-    ({                                                                                        \
-        __typeof__ (image) _image = (image);                                                  \
-        __typeof__ (y) _y = (y);                                                              \
-        ((uint32_t *) _image->data) + (((_image->w + UINT32_T_MASK) >> UINT32_T_SHIFT) * _y); \
+#define IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(image, y)                          \
+    ({                                                                        \
+        __typeof__ (image) _image = (image);                                  \
+        __typeof__ (y) _y = (y);                                              \
+        (uint32_t *) (_image->data + (IMAGE_BINARY_ROW_STRIDE(_image) * _y)); \
     })
 
 #define IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x)                       \
@@ -706,11 +805,11 @@ bool image_get_mask_pixel(image_t *ptr, int x, int y);
         _row_ptr[_x >> UINT32_T_SHIFT] |= 1 << (_x & UINT32_T_MASK); \
     })
 
-#define IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(image, y) \
-    ({                                                  \
-        __typeof__ (image) _image = (image);            \
-        __typeof__ (y) _y = (y);                        \
-        ((uint8_t *) _image->data) + (_image->w * _y);  \
+#define IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(image, y)           \
+    ({                                                            \
+        __typeof__ (image) _image = (image);                      \
+        __typeof__ (y) _y = (y);                                  \
+        _image->data + (IMAGE_GRAYSCALE_ROW_STRIDE(_image) * _y); \
     })
 
 #define IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x) \
@@ -728,11 +827,18 @@ bool image_get_mask_pixel(image_t *ptr, int x, int y);
         _row_ptr[_x] = _v;                            \
     })
 
-#define IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(image, y)    \
-    ({                                                  \
-        __typeof__ (image) _image = (image);            \
-        __typeof__ (y) _y = (y);                        \
-        ((uint16_t *) _image->data) + (_image->w * _y); \
+#define IMAGE_COMPUTE_GRAYSCALE16_PIXEL_ROW_PTR(image, y)                          \
+    ({                                                                             \
+        __typeof__ (image) _image = (image);                                       \
+        __typeof__ (y) _y = (y);                                                   \
+        (uint16_t *) (_image->data + (IMAGE_GRAYSCALE16_ROW_STRIDE(_image) * _y)); \
+    })
+
+#define IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(image, y)                          \
+    ({                                                                        \
+        __typeof__ (image) _image = (image);                                  \
+        __typeof__ (y) _y = (y);                                              \
+        (uint16_t *) (_image->data + (IMAGE_RGB565_ROW_STRIDE(_image) * _y)); \
     })
 
 #define IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x)    \
@@ -750,18 +856,18 @@ bool image_get_mask_pixel(image_t *ptr, int x, int y);
         _row_ptr[_x] = _v;                         \
     })
 
-#define IMAGE_COMPUTE_BAYER_PIXEL_ROW_PTR(image, y)    \
-    ({                                                 \
-        __typeof__ (image) _image = (image);           \
-        __typeof__ (y) _y = (y);                       \
-        ((uint8_t *) _image->data) + (_image->w * _y); \
+#define IMAGE_COMPUTE_BAYER_PIXEL_ROW_PTR(image, y)               \
+    ({                                                            \
+        __typeof__ (image) _image = (image);                      \
+        __typeof__ (y) _y = (y);                                  \
+        _image->data + (IMAGE_GRAYSCALE_ROW_STRIDE(_image) * _y); \
     })
 
-#define IMAGE_COMPUTE_YUV_PIXEL_ROW_PTR(image, y)       \
-    ({                                                  \
-        __typeof__ (image) _image = (image);            \
-        __typeof__ (y) _y = (y);                        \
-        ((uint16_t *) _image->data) + (_image->w * _y); \
+#define IMAGE_COMPUTE_YUV_PIXEL_ROW_PTR(image, y)                             \
+    ({                                                                        \
+        __typeof__ (image) _image = (image);                                  \
+        __typeof__ (y) _y = (y);                                              \
+        (uint16_t *) (_image->data + (IMAGE_RGB565_ROW_STRIDE(_image) * _y)); \
     })
 
 ////////////////
@@ -782,6 +888,18 @@ typedef enum jpeg_subsampling {
     JPEG_SUBSAMPLING_420  = 0x22, // Chroma subsampling 4:2:0
 } jpeg_subsampling_t;
 
+// Minimum scratch buffer size for jpeg_compress_stream().
+#define JPEG_STREAM_BUFFER_MIN     (512)
+
+// Called with each chunk of the JPEG byte stream, return false to abort compression.
+typedef bool (*jpeg_stream_callback_t) (void *arg, const uint8_t *data, uint32_t size);
+
+typedef enum png_effort {
+    PNG_EFFORT_STORED = 0, // No compression, rows are stored.
+    PNG_EFFORT_FAST   = 1, // Run-length matches only.
+    PNG_EFFORT_BEST   = 2, // LZ77 matches with hash chains.
+} png_effort_t;
+
 // Old Image Macros - Will be refactor and removed. But, only after making sure through testing new macros work.
 
 // Image kernels
@@ -887,9 +1005,6 @@ typedef struct cluster {
     array_t *points;
 } cluster_t;
 
-// Return the distance between a cluster centroid and some object.
-typedef float (*cluster_dist_t) (int cx, int cy, void *obj);
-
 /* Keypoint */
 typedef struct kp {
     uint16_t x;
@@ -907,6 +1022,7 @@ typedef struct size {
 } wsize_t;
 
 /* Haar cascade struct */
+#define HAAR_TRACKS_MAX     (8)
 typedef struct cascade {
     int std;                        // Image standard deviation.
     int step;                       // Image scanning factor.
@@ -927,6 +1043,12 @@ typedef struct cascade {
     int8_t *num_rectangles_array;   // Number of rectangles per features (1 per feature).
     int8_t *weights_array;          // Rectangles weights (1 per rectangle).
     int8_t *rectangles_array;       // Rectangles array.
+    int n_early_stages;             // Number of stages packed in early_nodes.
+    struct haar_node *early_nodes;  // Packed features of the early stages.
+    int track_interval;             // Frames between full scans, 0 disables tracking.
+    int track_frames;               // Frames since the last full scan.
+    int n_tracks;                   // Number of objects tracked.
+    rectangle_t tracks[HAAR_TRACKS_MAX]; // Objects found in the previous frame.
 } cascade_t;
 
 typedef struct bmp_read_settings {
@@ -988,6 +1110,18 @@ typedef enum edge_detector_type {
     EDGE_SIMPLE,
 } edge_detector_t;
 
+typedef enum regression_method {
+    REGRESSION_LEAST_SQUARES,
+    REGRESSION_THEIL_SEN,           // All pairs of points.
+    REGRESSION_THEIL_SEN_SAMPLED,   // Random pairs of points.
+    REGRESSION_RANSAC,
+} regression_method_t;
+
+typedef enum adaptive_method {
+    ADAPTIVE_BRADLEY,
+    ADAPTIVE_SAUVOLA,
+} adaptive_method_t;
+
 typedef enum template_match {
     SEARCH_EX,  // Exhaustive search
     SEARCH_DS,  // Diamond search
@@ -1025,6 +1159,10 @@ typedef struct statistics {
     int8_t BMean, BMedian, BMode, BSTDev, BMin, BMax, BLQ, BUQ;
 } statistics_t;
 
+typedef struct gray16_statistics {
+    uint16_t mean, median, mode, stdev, min, max, lq, uq;
+} gray16_statistics_t;
+
 #define FIND_BLOBS_CORNERS_RESOLUTION    20 // multiple of 4
 #define FIND_BLOBS_ANGLE_RESOLUTION      (360 / FIND_BLOBS_CORNERS_RESOLUTION)
 
@@ -1037,6 +1175,19 @@ typedef struct find_blobs_list_lnk_data {
     float centroid_x_acc, centroid_y_acc, rotation_acc_x, rotation_acc_y, roundness_acc;
 } find_blobs_list_lnk_data_t;
 
+typedef struct find_blobs_track {
+    rectangle_t rect;
+    uint32_t id;
+} find_blobs_track_t;
+
+typedef struct find_blobs_tracker {
+    list_t tracks; // find_blobs_track_t, same order as the last output list.
+    uint32_t next_id;
+    unsigned int frames; // Frames since the last full scan.
+    unsigned int full_scan_interval;
+    int search_margin;
+} find_blobs_tracker_t;
+
 typedef struct find_lines_list_lnk_data {
     line_t line;
     uint32_t magnitude;
@@ -1054,6 +1205,14 @@ typedef struct find_rects_list_lnk_data {
     uint32_t magnitude;
 } find_rects_list_lnk_data_t;
 
+// Time budget shared by the 1/2D bar code detectors. They check it at coarse points and stop
+// early with the results found so far. A NULL deadline or a budget of 0 never expires.
+typedef struct imlib_deadline {
+    uint32_t start_us;
+    uint32_t budget_us;
+    bool expired;
+} imlib_deadline_t;
+
 typedef struct find_qrcodes_list_lnk_data {
     point_t corners[4];
     rectangle_t rect;
@@ -1083,6 +1242,18 @@ typedef struct find_apriltags_list_lnk_data {
     float x_rotation, y_rotation, z_rotation;
 } find_apriltags_list_lnk_data_t;
 
+typedef struct find_apriltags_track {
+    rectangle_t rect;
+    int dx, dy; // Motion since the previous frame, used to predict the next position.
+} find_apriltags_track_t;
+
+typedef struct find_apriltags_tracker {
+    list_t tracks; // find_apriltags_track_t
+    unsigned int frames; // Frames since the last full scan.
+    unsigned int full_scan_interval;
+    int search_margin;
+} find_apriltags_tracker_t;
+
 typedef struct find_datamatrices_list_lnk_data {
     point_t corners[4];
     rectangle_t rect;
@@ -1121,6 +1292,20 @@ typedef struct find_barcodes_list_lnk_data {
     int quality;
 } find_barcodes_list_lnk_data_t;
 
+typedef enum find_codes_types {
+    FIND_CODES_QRCODES      = (1 << 0),
+    FIND_CODES_APRILTAGS    = (1 << 1),
+    FIND_CODES_DATAMATRICES = (1 << 2),
+    FIND_CODES_BARCODES     = (1 << 3)
+} find_codes_types_t;
+
+typedef struct find_codes {
+    list_t qrcodes;      // find_qrcodes_list_lnk_data_t
+    list_t apriltags;    // find_apriltags_list_lnk_data_t
+    list_t datamatrices; // find_datamatrices_list_lnk_data_t
+    list_t barcodes;     // find_barcodes_list_lnk_data_t
+} find_codes_t;
+
 typedef enum image_hint {
     IMAGE_HINT_AREA      = (1 << 0),
     IMAGE_HINT_BILINEAR  = (1 << 1),
@@ -1155,9 +1340,124 @@ typedef struct imlib_draw_row_data {
 
 typedef void (*imlib_draw_row_callback_t) (int x_start, int x_end, int y_row, imlib_draw_row_data_t *data);
 
+typedef struct imlib_rle_run {
+    uint16_t x_start, x_end; // [x_start, x_end)
+} imlib_rle_run_t;
+
+#define IMLIB_PYRAMID_MAX_LEVELS (8)
+#define IMLIB_PYRAMID_MIN_SIZE   (16)
+
+typedef struct imlib_pyramid {
+    int w, h;           // Size of the base image.
+    float scale;        // Scale factor between levels.
+    int n_levels;       // Number of down scaled levels.
+    bool built;
+    image_t levels[IMLIB_PYRAMID_MAX_LEVELS]; // Level i is scaled by 1 / (scale ^ (i + 1)).
+} imlib_pyramid_t;
+
+#define IMLIB_MOTION_MAX_SHIFT (4)
+
+typedef struct imlib_motion {
+    int w, h;               // Size of the input image.
+    pixformat_t pixfmt;     // Input pixel format (grayscale or RGB565).
+    int shift;              // Each model cell covers (1 << shift) x (1 << shift) pixels.
+    int mw, mh;             // Size of the model in cells.
+    int rate;               // Learning rate (0.8 fixed-point).
+    int threshold;          // Minimum difference to the background for motion.
+    bool initialized;       // Set once the background has seen a frame.
+    volatile bool ready;    // Set when a new mask is complete.
+    uint16_t *acc;          // Cell sums of the current cell row.
+    uint16_t *mean;         // Background mean per cell (8.8 fixed-point).
+    uint16_t *dev;          // Background mean absolute deviation per cell (8.8 fixed-point).
+    image_t mask;           // Last complete motion mask (binary, model resolution).
+    image_t back;           // Motion mask being written.
+} imlib_motion_t;
+
+typedef struct imlib_phasecorr {
+    int w, h;               // Size of the roi that is correlated.
+    bool logpolar;          // Correlate log-polar images to get rotation/scale instead of translation.
+    bool initialized;       // Set once the previous spectrum is valid.
+    size_t len;             // Number of floats in each spectrum.
+    float *prev;            // Spectrum of the previous frame.
+    float *data;            // Spectrum of the current frame, then the phase correlation.
+    int16_t *map;           // Log-polar sampling map.
+} imlib_phasecorr_t;
+
+#define IMLIB_OPTFLOW_MAX_LEVELS (5)
+#define IMLIB_OPTFLOW_MIN_SIZE   (16)
+
+typedef struct imlib_optflow {
+    int w, h;               // Size of the frames.
+    int n_levels;           // Number of pyramid levels, each is half the size of the previous one.
+    int radius;             // Tracking windows are (2 * radius + 1) pixels square.
+    int iterations;         // Maximum number of iterations per level.
+    bool initialized;       // Set once the previous pyramid is valid.
+    image_t prev[IMLIB_OPTFLOW_MAX_LEVELS]; // Grayscale pyramid of the previous frame.
+    image_t curr[IMLIB_OPTFLOW_MAX_LEVELS]; // Grayscale pyramid of the current frame.
+} imlib_optflow_t;
+
+typedef struct imlib_optflow_point {
+    float x, y;             // Position in the previous frame.
+    float dx, dy;           // Displacement to the current frame.
+    bool found;             // False if the point was lost.
+} imlib_optflow_point_t;
+
+typedef struct imlib_tracker_track {
+    uint32_t id;            // Stable id, starting from 1.
+    int16_t label;          // Class of the detections, tracks are only matched within a class.
+    int16_t index;          // Index of the detection matched by the last update, -1 if missed.
+    uint16_t hits;          // Number of updates with a matched detection.
+    uint16_t misses;        // Number of consecutive updates without a matched detection.
+    float x, y;             // Centroid.
+    float vx, vy;           // Centroid velocity in pixels per update.
+    float w, h;             // Size of the last matched detection.
+    float p[2][3];          // Covariance of (position, velocity) per axis, as p00, p01 and p11.
+} imlib_tracker_track_t;
+
+typedef struct imlib_tracker_detection {
+    rectangle_t rect;
+    int16_t label;
+    int16_t index;
+} imlib_tracker_detection_t;
+
+typedef struct imlib_tracker {
+    imlib_tracker_track_t *tracks; // Preallocated track table.
+    size_t max_tracks;      // Size of the track table.
+    size_t n_tracks;        // Number of live tracks.
+    uint32_t next_id;       // Id of the next new track.
+    uint32_t max_misses;    // Tracks are removed after missing more updates than this.
+    float iou_threshold;    // Minimum overlap of a track and a detection to match them.
+    float max_distance;     // Maximum centroid distance to match non-overlapping boxes (0 to disable).
+    bool kalman;            // Predict the centroids with a constant velocity Kalman filter.
+    float process_noise;    // Kalman filter acceleration variance.
+    float measurement_noise; // Kalman filter position variance of the detections.
+} imlib_tracker_t;
+
+typedef enum imlib_pipeline_op {
+    IMLIB_PIPELINE_OP_LUT,
+    IMLIB_PIPELINE_OP_MORPH,
+    IMLIB_PIPELINE_OP_ERODE,
+    IMLIB_PIPELINE_OP_DILATE
+} imlib_pipeline_op_t;
+
+typedef struct imlib_pipeline_stage {
+    imlib_pipeline_op_t op; // user
+    int ksize; // user
+    int threshold; // user (erode/dilate)
+    int *krn; // user (morph)
+    int32_t m_int; // user (morph)
+    int32_t b_int; // user (morph)
+    uint8_t lut[256]; // user (lut)
+    uint8_t *rows; // private
+    uint16_t *cols; // private
+} imlib_pipeline_stage_t;
+
 // Library Hardware Init
 void imlib_init_all();
 void imlib_deinit_all();
+// Initialize the GPU/JPEG codec if they are not yet, call before using them.
+void imlib_gpu_init();
+void imlib_jpeg_init();
 
 // Generic Helper Functions
 void imlib_fill_image_from_float(image_t *img, int w, int h, float *data, float min, float max,
@@ -1169,11 +1469,14 @@ void imlib_debayer_ycbcr(image_t *src, rectangle_t *roi, int8_t *Y0, int8_t *CB,
 void imlib_debayer_line(int x_start, int x_end, int y_row, void *dst_row_ptr, pixformat_t pixfmt, image_t *src);
 void imlib_debayer_image(image_t *dst, image_t *src);
 void imlib_debayer_image_awb(image_t *dst, image_t *src, bool fast, uint32_t r_out, uint32_t g_out, uint32_t b_out);
+void imlib_debayer_image_half(image_t *dst, image_t *src);
 
 // YUV Image Processing
 pixformat_t imlib_yuv_shift(pixformat_t pixfmt, int x);
 void imlib_deyuv_line(int x_start, int x_end, int y_row, void *dst_row_ptr, pixformat_t pixfmt, image_t *src);
 void imlib_deyuv_image(image_t *dst, image_t *src);
+void imlib_yuv_threshold_line(int x_start, int x_end, int y_row, uint32_t *dst_row_ptr, image_t *src,
+                              color_thresholds_list_lnk_data_t *threshold, bool invert);
 
 /* Color space functions */
 int8_t imlib_rgb565_to_l(uint16_t pixel);
@@ -1181,24 +1484,43 @@ int8_t imlib_rgb565_to_a(uint16_t pixel);
 int8_t imlib_rgb565_to_b(uint16_t pixel);
 uint16_t imlib_lab_to_rgb(uint8_t l, int8_t a, int8_t b);
 uint16_t imlib_yuv_to_rgb(uint8_t y, int8_t u, int8_t v);
+#if defined(IMLIB_ENABLE_THRESHOLD_LUT)
+const uint32_t *imlib_rgb565_threshold_lut(color_thresholds_list_lnk_data_t *thresholds, size_t n, bool invert);
+#else
+#define imlib_rgb565_threshold_lut(thresholds, n, invert) ((const uint32_t *) NULL)
+#endif
 
 /* Image file functions */
 void ppm_read_geometry(FIL *fp, image_t *img, const char *path, ppm_read_settings_t *rs);
+void ppm_read_row(FIL *fp, image_t *img, void *row, ppm_read_settings_t *rs);
 void ppm_read_pixels(FIL *fp, image_t *img, int n_lines, ppm_read_settings_t *rs);
 void ppm_read(image_t *img, const char *path);
 void ppm_write_subimg(image_t *img, const char *path, rectangle_t *r);
 bool bmp_read_geometry(FIL *fp, image_t *img, const char *path, bmp_read_settings_t *rs);
+void bmp_read_row(FIL *fp, image_t *img, void *row, bmp_read_settings_t *rs);
 void bmp_read_pixels(FIL *fp, image_t *img, int n_lines, bmp_read_settings_t *rs);
 void bmp_read(image_t *img, const char *path);
 void bmp_write_subimg(image_t *img, const char *path, rectangle_t *r);
 #if (OMV_JPEG_CODEC_ENABLE == 1)
 void imlib_hardware_jpeg_init();
 void imlib_hardware_jpeg_deinit();
+// Line fed encoder for compressing frames while they are captured. Strips of JPEG_MCU_H lines are
+// converted in parts and queued to the JPEG core. The callback is called from interrupt context.
+typedef void (*jpeg_lines_callback_t) (uint32_t size, bool overflow);
+size_t jpeg_compress_lines_buffer_size(image_t *src, int quality);
+bool jpeg_compress_lines_start(image_t *src, image_t *dst, int quality, uint8_t *buffer,
+                               jpeg_lines_callback_t callback);
+bool jpeg_compress_lines_put(image_t *strip, int y_offset, int part, int parts);
+void jpeg_compress_lines_abort();
 #endif
 void jpeg_get_mcu(image_t *src, int x_offset, int y_offset, int dx, int dy,
                   int8_t *Y0, int8_t *CB, int8_t *CR);
 void jpeg_decompress(image_t *dst, image_t *src);
+// Decodes the roi of src scaled down by 1, 2, 4 or 8. dst must be (roi->w / scale) x (roi->h / scale).
+void jpeg_decompress_roi(image_t *dst, image_t *src, rectangle_t *roi, int scale);
 bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_subsampling_t subsampling);
+bool jpeg_compress_stream(image_t *src, int quality, jpeg_subsampling_t subsampling,
+                          uint8_t *buf, uint32_t size, jpeg_stream_callback_t callback, void *arg);
 bool jpeg_is_valid(image_t *img);
 int jpeg_clean_trailing_bytes(int bpp, uint8_t *data);
 void jpeg_read_geometry(FIL *fp, image_t *img, const char *path, jpg_read_settings_t *rs);
@@ -1206,23 +1528,29 @@ void jpeg_read_pixels(FIL *fp, image_t *img);
 void jpeg_read(image_t *img, const char *path);
 void jpeg_write(image_t *img, const char *path, int quality);
 void png_decompress(image_t *dst, image_t *src);
-bool png_compress(image_t *src, image_t *dst);
+bool png_compress(image_t *src, image_t *dst, png_effort_t effort);
 void png_read_geometry(FIL *fp, image_t *img, const char *path, png_read_settings_t *rs);
 void png_read_pixels(FIL *fp, image_t *img);
 void png_read(image_t *img, const char *path);
-void png_write(image_t *img, const char *path);
+void png_write(image_t *img, const char *path, png_effort_t effort);
 bool imlib_read_geometry(FIL *fp, image_t *img, const char *path, img_read_settings_t *rs);
 void imlib_image_operation(image_t *img, const char *path, image_t *other, int scalar, line_op_t op, void *data);
 void imlib_load_image(image_t *img, const char *path);
+void imlib_load_image_roi(image_t *img, const char *path, rectangle_t *roi, int scale);
 void imlib_save_image(image_t *img, const char *path, rectangle_t *roi, int quality);
 
 /* GIF functions */
 void gif_open(FIL *fp, int width, int height, bool color, bool loop);
-void gif_add_frame(FIL *fp, image_t *img, uint16_t delay);
+void gif_add_frame(FIL *fp, image_t *img, uint16_t delay, bool adaptive_palette);
 void gif_close(FIL *fp);
 
 /* MJPEG functions */
 void mjpeg_open(FIL *fp, int width, int height);
+bool mjpeg_preallocate(FIL *fp, uint32_t size);
+// Must be called between fb_alloc_mark() and fb_alloc_free_till_mark(), dst_img may point at img.
+void mjpeg_encode(image_t *dst_img, int width, int height, image_t *img, int quality, rectangle_t *roi,
+                  int rgb_channel, int alpha, const uint16_t *color_palette, const uint8_t *alpha_palette,
+                  image_hint_t hint);
 void mjpeg_write(FIL *fp, int width, int height, uint32_t *frames, uint32_t *bytes,
                  image_t *img, int quality, rectangle_t *roi, int rgb_channel, int alpha,
                  const uint16_t *color_palette, const uint8_t *alpha_palette, image_hint_t hint);
@@ -1249,14 +1577,34 @@ void imlib_sepconv3(image_t *img, const int8_t *krn, const float m, const int b)
 int imlib_image_mean(image_t *src, int *r_mean, int *g_mean, int *b_mean);
 int imlib_image_std(image_t *src); // grayscale only
 
-/* Template Matching */
+/* Pooling */
+typedef enum {
+    IMLIB_POOL_OUT_GRAYSCALE,       // One byte per pixel.
+    IMLIB_POOL_OUT_RGB565,          // One uint16_t per pixel.
+    IMLIB_POOL_OUT_RGB888,          // Three bytes per pixel, red first.
+} imlib_pool_out_t;
+
+// Called with each output row of imlib_mean_pool_rows().
+typedef void (*imlib_pool_row_cb_t) (int y, const void *row, void *arg);
+
+// Grayscale and RGB565 only, y_div must be <= 256.
+void imlib_mean_pool_rows(image_t *img, rectangle_t *roi, int x_div, int y_div, imlib_pool_out_t out,
+                          imlib_pool_row_cb_t cb, void *arg);
 void imlib_midpoint_pool(image_t *img_i, image_t *img_o, int x_div, int y_div, const int bias);
 void imlib_mean_pool(image_t *img_i, image_t *img_o, int x_div, int y_div);
+
+/* Template Matching */
 float imlib_template_match_ds(image_t *image, image_t *t, rectangle_t *r);
 float imlib_template_match_ex(image_t *image, image_t *t, rectangle_t *roi, int step, rectangle_t *r);
+void imlib_template_match_ex_n(image_t *image, image_t **t, int n, rectangle_t *roi, int step, rectangle_t *r, float *corr);
 
 /* Clustering functions */
-array_t *cluster_kmeans(array_t *points, int k, cluster_dist_t dist_func);
+// Points (n x dims) and centroids (k x dims) are stored one dimension after the other, i.e.
+// points[(d * n) + i]. k must be <= n. A batch size in (0, n) runs mini-batch k-means.
+// Returns the number of iterations run.
+int imlib_kmeans(const int16_t *points, int n, int dims, int k, int batch, int max_iter,
+                 float *centroids, uint16_t *labels, uint32_t *counts);
+array_t *cluster_kmeans(array_t *points, int k);
 
 /* Integral image functions */
 void imlib_integral_image_alloc(struct integral_image *sum, int w, int h);
@@ -1264,6 +1612,10 @@ void imlib_integral_image_free(struct integral_image *sum);
 void imlib_integral_image(struct image *src, struct integral_image *sum);
 void imlib_integral_image_sq(struct image *src, struct integral_image *sum);
 void imlib_integral_image_scaled(struct image *src, struct integral_image *sum);
+void imlib_integral_image_ss(struct image *src, struct integral_image *sum, struct integral_image *ssq);
+void imlib_integral_row_ss(const uint8_t *pixels, int w,
+                           uint32_t *sum_row, const uint32_t *sum_prev,
+                           uint32_t *ssq_row, const uint32_t *ssq_prev);
 uint32_t imlib_integral_lookup(struct integral_image *src, int x, int y, int w, int h);
 
 // Integral moving window
@@ -1287,9 +1639,22 @@ void fast_detect(image_t *image, array_t *keypoints, int threshold, rectangle_t
 void agast_detect(image_t *image, array_t *keypoints, int threshold, rectangle_t *roi);
 
 /* ORB descriptor */
+// Multi-probe LSH index over a keypoints array (see orb.c).
+typedef struct orb_index {
+    int n;
+    uint16_t stamp;
+    uint16_t *stamps;
+    uint16_t *offsets;
+    uint16_t *indices;
+} orb_index_t;
+
 array_t *orb_find_keypoints(image_t *image, bool normalized, int threshold,
-                            float scale_factor, int max_keypoints, corner_detector_t corner_detector, rectangle_t *roi);
-int orb_match_keypoints(array_t *kpts1, array_t *kpts2, int *match, int threshold, rectangle_t *r, point_t *c, int *angle);
+                            float scale_factor, int max_keypoints, corner_detector_t corner_detector, rectangle_t *roi,
+                            imlib_pyramid_t *pyramid);
+size_t orb_index_size(array_t *kpts);
+void orb_index_build(orb_index_t *index, array_t *kpts, uint8_t *buffer);
+int orb_match_keypoints(array_t *kpts1, orb_index_t *index1, array_t *kpts2, orb_index_t *index2,
+                        int *match, int threshold, rectangle_t *r, point_t *c, int *angle);
 int orb_filter_keypoints(array_t *kpts, rectangle_t *r, point_t *c);
 int orb_save_descriptor(FIL *fp, array_t *kpts);
 int orb_load_descriptor(FIL *fp, array_t *kpts);
@@ -1298,11 +1663,52 @@ float orb_cluster_dist(int cx, int cy, void *kp);
 /* LBP Operator */
 uint8_t *imlib_lbp_desc(image_t *image, rectangle_t *roi);
 int imlib_lbp_desc_distance(uint8_t *d0, uint8_t *d1);
+int imlib_lbp_desc_match(uint8_t *desc, uint8_t **gallery, int n, int k, int *index, int *distance);
 int imlib_lbp_desc_save(FIL *fp, uint8_t *desc);
 int imlib_lbp_desc_load(FIL *fp, uint8_t **desc);
 
+// Sobel gradients, gx = (left - right) and gy = (top - bottom).
+typedef struct gradient {
+    int16_t x;
+    int16_t y;
+} gradient_t;
+
+// Gradients of an ROI of an image, 0 on the border of the ROI.
+typedef struct gradients {
+    rectangle_t roi;
+    gradient_t *data;
+} gradients_t;
+
+static inline gradient_t *imlib_gradients_at(gradients_t *gradients, int x, int y) {
+    return gradients->data + ((y - gradients->roi.y) * gradients->roi.w) + (x - gradients->roi.x);
+}
+
+// Alpha max plus beta min approximation of the gradient magnitude (max error ~7%).
+static inline int imlib_gradient_magnitude(int gx, int gy) {
+    int ax = abs(gx), ay = abs(gy);
+    return IM_MAX(ax, ay) + ((IM_MIN(ax, ay) * 3) >> 3);
+}
+
+// Rounds the gradient direction to 0, 45, 90 or 135 degrees (returned as 0 to 3) without atan2.
+static inline int imlib_gradient_direction(int gx, int gy) {
+    int ax = abs(gx), ay = abs(gy);
+    if ((ay * 70) < (ax * 29)) {
+        // tan(22.5) ~= 29/70
+        return 0;
+    } else if ((ax * 70) < (ay * 29)) {
+        return 2;
+    } else {
+        return ((gx ^ gy) >= 0) ? 1 : 3;
+    }
+}
+
+// Computes the gradients of the w - 2 inner pixels of row r1, the outer pixels are set to 0.
+void imlib_gradients_row(const uint8_t *r0, const uint8_t *r1, const uint8_t *r2, int w, gradient_t *out);
+// Computes the gradients of the ROI of a binary, grayscale or RGB565 image, data holds roi->w * roi->h.
+void imlib_find_gradients(image_t *src, rectangle_t *roi, gradient_t *data);
+
 /* Iris detector */
-void imlib_find_iris(image_t *src, point_t *iris, rectangle_t *roi);
+void imlib_find_iris(image_t *src, point_t *iris, rectangle_t *roi, gradients_t *gradients);
 
 // Image filter functions
 void im_filter_bw(uint8_t *src, uint8_t *dst, int size, int bpp, void *args);
@@ -1310,10 +1716,15 @@ void im_filter_skin(uint8_t *src, uint8_t *dst, int size, int bpp, void *args);
 
 // Edge detection
 void imlib_edge_simple(image_t *src, rectangle_t *roi, int low_thresh, int high_thresh);
-void imlib_edge_canny(image_t *src, rectangle_t *roi, int low_thresh, int high_thresh);
+void imlib_edge_canny(image_t *src, rectangle_t *roi, int low_thresh, int high_thresh, gradients_t *gradients);
 
 // HoG
-void imlib_find_hog(image_t *src, rectangle_t *roi, int cell_size);
+#define HOG_BINS        (9)
+#define HOG_BLOCK_BINS  (HOG_BINS * 4) // 2x2 cells per block.
+void imlib_hog_cells(image_t *src, rectangle_t *roi, int cell_size, uint32_t *cells, gradients_t *gradients);
+void imlib_hog_cells_downscale(int *x_cells, int *y_cells, uint32_t *cells);
+void imlib_hog_blocks(int x_cells, int y_cells, uint32_t *cells, uint8_t *blocks);
+void imlib_find_hog(image_t *src, rectangle_t *roi, int cell_size, gradients_t *gradients);
 
 // Helper Functions
 void imlib_zero(image_t *img, image_t *mask, bool invert);
@@ -1373,19 +1784,44 @@ void imlib_draw_image(image_t *dst_img,
                       imlib_draw_row_callback_t callback,
                       void *callback_arg,
                       void *dst_row_override);
+// Unscaled conversion of the whole image, returns false if imlib_draw_image() must be used instead.
+bool imlib_convert(image_t *dst, image_t *src, const uint16_t *color_palette);
+// Packs RGB565 pixels into RGB888 bytes, the bytes are xored with mask.
+void imlib_rgb565_to_rgb888(uint8_t *dst, const uint16_t *src, size_t n, uint8_t mask);
 void imlib_flood_fill(image_t *img, int x, int y,
                       float seed_threshold, float floating_threshold,
                       int c, bool invert, bool clear_background, image_t *mask);
 // ISP Functions
+#define IMLIB_ISP_STATS_BINS    (16)
+typedef struct imlib_isp_stats {
+    uint32_t samples;       // Number of grid points sampled.
+    uint32_t r_avg;         // Channel averages (0-255) for AWB.
+    uint32_t g_avg;
+    uint32_t b_avg;
+    uint32_t y_avg;         // Luma average (0-255) for AE.
+    uint32_t focus;         // Average local gradient, higher is sharper.
+    uint32_t histogram[IMLIB_ISP_STATS_BINS]; // Luma histogram for AE.
+} imlib_isp_stats_t;
+void imlib_isp_stats(image_t *img, int step, imlib_isp_stats_t *stats);
 void imlib_awb_rgb_avg(image_t *img, uint32_t *r_out, uint32_t *g_out, uint32_t *b_out);
 void imlib_awb_rgb_max(image_t *img, uint32_t *r_out, uint32_t *g_out, uint32_t *b_out);
 void imlib_awb(image_t *img, uint32_t r_out, uint32_t g_out, uint32_t b_out);
 void imlib_ccm(image_t *img, float *ccm, bool offset);
 void imlib_gamma(image_t *img, float gamma, float scale, float offset);
+// Fused AWB, CCM and gamma correction, see imlib_isp_params_init().
+typedef struct imlib_isp_params {
+    int16_t ccm[9];         // Q8 color correction matrix with the AWB gains folded into its columns.
+    int32_t offset[3];      // Q8 channel offsets (0-255 range) including rounding.
+    uint16_t lut[3][256];   // Gamma/contrast/brightness LUTs returning the RGB565 channel bits.
+} imlib_isp_params_t;
+void imlib_isp_params_init(imlib_isp_params_t *params, const float *gains, const float *ccm,
+                           float gamma, float contrast, float brightness);
+void imlib_isp(image_t *dst, image_t *src, const imlib_isp_params_t *params);
 // Binary Functions
 void imlib_zero_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data);
 void imlib_mask_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data);
 void imlib_binary(image_t *out, image_t *img, list_t *thresholds, bool invert, bool zero, image_t *mask);
+void imlib_adaptive_threshold(image_t *out, image_t *img, int window, float k, adaptive_method_t method, bool invert);
 void imlib_invert(image_t *img);
 void imlib_b_and_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data);
 void imlib_b_nand_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data);
@@ -1399,6 +1835,34 @@ void imlib_open(image_t *img, int ksize, int threshold, image_t *mask);
 void imlib_close(image_t *img, int ksize, int threshold, image_t *mask);
 void imlib_top_hat(image_t *img, int ksize, int threshold, image_t *mask);
 void imlib_black_hat(image_t *img, int ksize, int threshold, image_t *mask);
+// RLE Functions
+int imlib_rle_encode_row(const uint32_t *row, int w, imlib_rle_run_t *runs);
+void imlib_rle_decode_row(const imlib_rle_run_t *runs, int n, uint32_t *row, int w);
+int imlib_rle_or(const imlib_rle_run_t *a, int na, const imlib_rle_run_t *b, int nb, imlib_rle_run_t *out);
+int imlib_rle_and(const imlib_rle_run_t *a, int na, const imlib_rle_run_t *b, int nb, imlib_rle_run_t *out);
+int imlib_rle_xor(const imlib_rle_run_t *a, int na, const imlib_rle_run_t *b, int nb, imlib_rle_run_t *out);
+int imlib_rle_dilate_row(const imlib_rle_run_t *runs, int n, int ksize, int w, imlib_rle_run_t *out);
+int imlib_rle_erode_row(const imlib_rle_run_t *runs, int n, int ksize, int w, imlib_rle_run_t *out);
+void imlib_rle_erode_dilate(image_t *img, int ksize, bool dilate);
+// Pyramid Functions
+size_t imlib_pyramid_init(imlib_pyramid_t *pyr, int w, int h, float scale, int max_levels);
+void imlib_pyramid_set_buffer(imlib_pyramid_t *pyr, uint8_t *buffer);
+void imlib_pyramid_build(imlib_pyramid_t *pyr, image_t *img);
+
+// Motion Functions
+size_t imlib_motion_init(imlib_motion_t *m, int w, int h, pixformat_t pixfmt, int shift, int rate, int threshold);
+void imlib_motion_set_buffer(imlib_motion_t *m, uint8_t *buffer);
+void imlib_motion_reset(imlib_motion_t *m);
+void imlib_motion_update_rows(imlib_motion_t *m, uint8_t *data, int y, int lines);
+void imlib_motion_update(imlib_motion_t *m, image_t *img);
+void imlib_motion_line_cb(uint8_t *data, uint32_t line, uint32_t lines, void *arg);
+void imlib_motion_find_blobs(imlib_motion_t *m, list_t *out, unsigned int area_threshold,
+                             unsigned int pixels_threshold, bool merge, int margin);
+
+// Pipeline Functions
+void imlib_pipeline_lut_binary(imlib_pipeline_stage_t *stage, list_t *thresholds, bool invert, bool zero);
+void imlib_pipeline_lut_invert(imlib_pipeline_stage_t *stage);
+void imlib_pipeline(image_t *img, imlib_pipeline_stage_t *stages, int n_stages);
 // Math Functions
 void imlib_add_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data);
 void imlib_sub_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data);
@@ -1406,14 +1870,19 @@ void imlib_rsub_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data
 void imlib_min_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data);
 void imlib_max_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data);
 void imlib_difference_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data);
+#define IMLIB_HDR_MAX_EXPOSURES    (3)
+void imlib_hdr_fuse(image_t *img, image_t **others, int n_others);
 // Filtering Functions
 void imlib_histeq(image_t *img, image_t *mask);
 void imlib_clahe_histeq(image_t *img, float clip_limit, image_t *mask);
 void imlib_mean_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask);
 void imlib_median_filter(image_t *img, const int ksize, float percentile, bool threshold, int offset, bool invert,
-                         image_t *mask);
+                         image_t *mask, bool fast);
 void imlib_mode_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask);
 void imlib_midpoint_filter(image_t *img, const int ksize, float bias, bool threshold, int offset, bool invert, image_t *mask);
+// Gaussian kernels this large or larger are approximated with stacked box blurs.
+#define IMLIB_GAUSSIAN_BOX_MIN_KSIZE    (3)
+bool imlib_gaussian_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask);
 void imlib_morph(image_t *img,
                  const int ksize,
                  const int *krn,
@@ -1431,11 +1900,23 @@ void imlib_bilateral_filter(image_t *img,
                             int offset,
                             bool invert,
                             image_t *mask);
+void imlib_bilateral_grid(image_t *img,
+                          const int ksize,
+                          float color_sigma,
+                          float space_sigma,
+                          bool threshold,
+                          int offset,
+                          bool invert,
+                          image_t *mask);
 // Image Correction
 void imlib_logpolar_int(image_t *dst, image_t *src, rectangle_t *roi, bool linear, bool reverse); // helper/internal
+size_t imlib_logpolar_map_size(int w, int h);
+void imlib_logpolar_map(int16_t *map, int w, int h, bool linear, bool reverse);
+void imlib_logpolar_remap(image_t *dst, image_t *src, rectangle_t *roi, int16_t *map);
 void imlib_logpolar(image_t *img, bool linear, bool reverse);
 // Lens/Rotation Correction
-void imlib_lens_corr(image_t *img, float strength, float zoom, float x_corr, float y_corr);
+void imlib_lens_corr_map_init(int16_t *map, int w, int h, float strength, float zoom);
+void imlib_lens_corr(image_t *img, float strength, float zoom, float x_corr, float y_corr, const int16_t *map);
 void imlib_rotation_corr(image_t *img, float x_rotation, float y_rotation,
                          float z_rotation, float x_translation, float y_translation,
                          float zoom, float fov, float *corners);
@@ -1457,10 +1938,24 @@ void imlib_get_similarity(image_t *img,
                           float *std,
                           float *min,
                           float *max);
-void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_t *thresholds, bool invert, image_t *other);
+uint64_t imlib_get_hash(image_t *img, rectangle_t *roi);
+int imlib_hash_distance(uint64_t a, uint64_t b);
+void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_t *thresholds, bool invert, image_t *other,
+                         int x_stride, int y_stride);
 void imlib_get_percentile(percentile_t *out, pixformat_t pixfmt, histogram_t *ptr, float percentile);
 void imlib_get_threshold(threshold_t *out, pixformat_t pixfmt, histogram_t *ptr);
 void imlib_get_statistics(statistics_t *out, pixformat_t pixfmt, histogram_t *ptr);
+
+/* 16-bit grayscale functions */
+void imlib_gray16_get_min_max(image_t *ptr, rectangle_t *roi, int *min, int *max);
+void imlib_gray16_to_grayscale(image_t *dst, image_t *src, rectangle_t *roi, int min, int max);
+void imlib_gray16_copy(image_t *dst, image_t *src, rectangle_t *roi);
+void imlib_gray16_get_statistics(gray16_statistics_t *out, image_t *ptr, rectangle_t *roi,
+                                 int x_stride, int y_stride);
+void imlib_gray16_binary(image_t *out, image_t *img, list_t *thresholds, bool invert, bool zero, image_t *mask);
+void imlib_gray16_mean_filter(image_t *img, const int ksize, bool threshold, int offset, bool invert, image_t *mask);
+void imlib_gray16_median_filter(image_t *img, const int ksize, float percentile, bool threshold, int offset,
+                                bool invert, image_t *mask);
 bool imlib_get_regression(find_lines_list_lnk_data_t *out,
                           image_t *ptr,
                           rectangle_t *roi,
@@ -1470,7 +1965,9 @@ bool imlib_get_regression(find_lines_list_lnk_data_t *out,
                           bool invert,
                           unsigned int area_threshold,
                           unsigned int pixels_threshold,
-                          bool robust);
+                          regression_method_t method,
+                          unsigned int iterations,
+                          unsigned int tolerance);
 // Color Tracking
 void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
                       list_t *thresholds, bool invert, unsigned int area_threshold, unsigned int pixels_threshold,
@@ -1478,11 +1975,18 @@ void imlib_find_blobs(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int
                       bool (*threshold_cb) (void *, find_blobs_list_lnk_data_t *), void *threshold_cb_arg,
                       bool (*merge_cb) (void *, find_blobs_list_lnk_data_t *, find_blobs_list_lnk_data_t *), void *merge_cb_arg,
                       unsigned int x_hist_bins_max, unsigned int y_hist_bins_max);
+void imlib_track_blobs(find_blobs_tracker_t *tracker, list_t *out, image_t *ptr, rectangle_t *roi,
+                       unsigned int x_stride, unsigned int y_stride,
+                       list_t *thresholds, bool invert, unsigned int area_threshold, unsigned int pixels_threshold,
+                       bool merge, int margin,
+                       bool (*threshold_cb) (void *, find_blobs_list_lnk_data_t *), void *threshold_cb_arg,
+                       bool (*merge_cb) (void *, find_blobs_list_lnk_data_t *, find_blobs_list_lnk_data_t *), void *merge_cb_arg,
+                       unsigned int x_hist_bins_max, unsigned int y_hist_bins_max);
 // Shape Detection
 size_t trace_line(image_t *ptr, line_t *l, int *theta_buffer, uint32_t *mag_buffer, point_t *point_buffer); // helper/internal
 void merge_alot(list_t *out, int threshold, int theta_threshold); // helper/internal
 void imlib_find_lines(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
-                      uint32_t threshold, unsigned int theta_margin, unsigned int rho_margin);
+                      uint32_t threshold, unsigned int theta_margin, unsigned int rho_margin, gradients_t *gradients);
 void imlib_lsd_find_line_segments(list_t *out,
                                   image_t *ptr,
                                   rectangle_t *roi,
@@ -1493,15 +1997,26 @@ void imlib_find_line_segments(list_t *out, image_t *ptr, rectangle_t *roi, unsig
                               uint32_t segment_threshold);
 void imlib_find_circles(list_t *out, image_t *ptr, rectangle_t *roi, unsigned int x_stride, unsigned int y_stride,
                         uint32_t threshold, unsigned int x_margin, unsigned int y_margin, unsigned int r_margin,
-                        unsigned int r_min, unsigned int r_max, unsigned int r_step);
+                        unsigned int r_min, unsigned int r_max, unsigned int r_step, gradients_t *gradients);
 void imlib_find_rects(list_t *out, image_t *ptr, rectangle_t *roi,
                       uint32_t threshold);
+void imlib_find_binary_rects(list_t *out, image_t *ptr, rectangle_t *roi, uint32_t threshold);
 // 1/2D Bar Codes
-void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi);
+void imlib_deadline_init(imlib_deadline_t *deadline, uint32_t budget_us);
+bool imlib_deadline_expired(imlib_deadline_t *deadline);
+void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi, int decimate, imlib_deadline_t *deadline);
 void imlib_find_apriltags(list_t *out, image_t *ptr, rectangle_t *roi, apriltag_families_t families,
-                          float fx, float fy, float cx, float cy);
-void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, int effort);
-void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi);
+                          float fx, float fy, float cx, float cy, int decimate, imlib_deadline_t *deadline);
+void imlib_track_apriltags(find_apriltags_tracker_t *tracker, list_t *out, image_t *ptr, rectangle_t *roi,
+                           apriltag_families_t families, float fx, float fy, float cx, float cy, int decimate,
+                           imlib_deadline_t *deadline);
+void imlib_find_datamatrices(list_t *out, image_t *ptr, rectangle_t *roi, list_t *rois, int effort,
+                             imlib_deadline_t *deadline);
+void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi, int x_stride, int y_stride,
+                         bool first_only, bool localize, imlib_deadline_t *deadline);
+void imlib_find_codes(find_codes_t *out, image_t *ptr, rectangle_t *roi, find_codes_types_t types,
+                      apriltag_families_t families, float fx, float fy, float cx, float cy, int effort,
+                      imlib_deadline_t *deadline);
 // Template Matching
 void imlib_phasecorrelate(image_t *img0,
                           image_t *img1,
@@ -1514,8 +2029,23 @@ void imlib_phasecorrelate(image_t *img0,
                           float *rotation,
                           float *scale,
                           float *response);
+size_t imlib_phasecorr_init(imlib_phasecorr_t *pc, int w, int h, bool logpolar);
+void imlib_phasecorr_set_buffer(imlib_phasecorr_t *pc, uint8_t *buffer);
+void imlib_phasecorr_reset(imlib_phasecorr_t *pc);
+bool imlib_phasecorr_update(imlib_phasecorr_t *pc, image_t *img, rectangle_t *roi,
+                            float *x_translation, float *y_translation,
+                            float *rotation, float *scale, float *response);
+size_t imlib_optflow_init(imlib_optflow_t *of, int w, int h, int levels, int radius, int iterations);
+void imlib_optflow_set_buffer(imlib_optflow_t *of, uint8_t *buffer);
+void imlib_optflow_reset(imlib_optflow_t *of);
+bool imlib_optflow_update(imlib_optflow_t *of, image_t *img, imlib_optflow_point_t *points, size_t n);
+// Multi-object tracking
+void imlib_tracker_init(imlib_tracker_t *tracker, imlib_tracker_track_t *tracks, size_t max_tracks);
+void imlib_tracker_reset(imlib_tracker_t *tracker);
+void imlib_tracker_update(imlib_tracker_t *tracker, imlib_tracker_detection_t *detections, size_t n);
+void imlib_tracker_track_rect(imlib_tracker_track_t *track, bool predicted, rectangle_t *r);
 // Stereo Imaging
 void imlib_stereo_disparity(image_t *img, bool reversed, int max_disparity, int threshold);
 
-array_t *imlib_selective_search(image_t *src, float t, int min_size, float a1, float a2, float a3);
+array_t *imlib_selective_search(image_t *src, int t, int min_size, float a1, float a2, float a3, int max_proposals);
 #endif //__IMLIB_H__
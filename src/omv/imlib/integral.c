@@ -13,6 +13,7 @@
 #include <arm_math.h>
 #include "imlib.h"
 #include "fb_alloc.h"
+#include "simd.h"
 
 void imlib_integral_image_alloc(i_image_t *sum, int w, int h) {
     sum->w = w;
@@ -96,6 +97,78 @@ void imlib_integral_image_sq(image_t *src, i_image_t *sum) {
 
 }
 
+#if (__ARM_ARCH >= 8)
+static void imlib_integral_add_row(uint32_t *row, const uint32_t *prev, int w) {
+    for (int x = 0; x < w; x += UINT32_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_32(w - x);
+        vstr_u32_pred(row + x, vadd_u32(vldr_u32_pred(row + x, pred), vldr_u32_pred(prev + x, pred)), pred);
+    }
+}
+#endif
+
+void imlib_integral_row_ss(const uint8_t *pixels, int w,
+                           uint32_t *sum_row, const uint32_t *sum_prev,
+                           uint32_t *ssq_row, const uint32_t *ssq_prev) {
+    #if (__ARM_ARCH >= 8)
+    // The row prefix sums are serial, so they are computed first and the
+    // previous rows are added afterwards a vector at a time.
+    for (uint32_t s = 0, sq = 0, x = 0; x < w; x++) {
+        uint32_t pixel = pixels[x];
+        s += pixel;
+        sq += pixel * pixel;
+        sum_row[x] = s;
+        ssq_row[x] = sq;
+    }
+
+    if (sum_prev) {
+        imlib_integral_add_row(sum_row, sum_prev, w);
+        imlib_integral_add_row(ssq_row, ssq_prev, w);
+    }
+    #else
+    uint32_t s = 0, sq = 0;
+    int x = 0;
+
+    if (!sum_prev) {
+        for (; x < w; x++) {
+            s += pixels[x];
+            sq += pixels[x] * pixels[x];
+            sum_row[x] = s;
+            ssq_row[x] = sq;
+        }
+        return;
+    }
+
+    // Load 4 pixels at a time and add the previous rows in the same pass.
+    for (; (x + 4) <= w; x += 4) {
+        uint32_t pixels4 = *((const uint32_t *) (pixels + x));
+        for (int i = 0; i < 4; i++, pixels4 >>= 8) {
+            uint32_t pixel = pixels4 & 0xff;
+            s += pixel;
+            sq += pixel * pixel;
+            sum_row[x + i] = s + sum_prev[x + i];
+            ssq_row[x + i] = sq + ssq_prev[x + i];
+        }
+    }
+
+    for (; x < w; x++) {
+        s += pixels[x];
+        sq += pixels[x] * pixels[x];
+        sum_row[x] = s + sum_prev[x];
+        ssq_row[x] = sq + ssq_prev[x];
+    }
+    #endif
+}
+
+void imlib_integral_image_ss(image_t *src, i_image_t *sum, i_image_t *ssq) {
+    for (int y = 0; y < src->h; y++) {
+        uint32_t *sum_row = sum->data + (y * src->w);
+        uint32_t *ssq_row = ssq->data + (y * src->w);
+        imlib_integral_row_ss(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, y), src->w,
+                              sum_row, y ? (sum_row - src->w) : NULL,
+                              ssq_row, y ? (ssq_row - src->w) : NULL);
+    }
+}
+
 uint32_t imlib_integral_lookup(i_image_t *sum, int x, int y, int w, int h) {
 #define PIXEL_AT(x, y) \
     (sum->data[((y) - 1) * sum->w + ((x) - 1)])
@@ -66,13 +66,13 @@ void imlib_integral_mw_alloc(mw_image_t *sum, int w, int h) {
     sum->y_offs = 0;
     sum->x_ratio = (1 << 16) + 1;
     sum->y_ratio = (1 << 16) + 1;
-    sum->data = fb_alloc(h * sizeof(*sum->data), FB_ALLOC_NO_HINT);
+    sum->data = fb_alloc(h * sizeof(*sum->data), FB_ALLOC_PREFER_TCM);
     // swap is used when shifting the image pointers
     // to avoid overwriting the image rows in sum->data
-    sum->swap = fb_alloc(h * sizeof(*sum->data), FB_ALLOC_NO_HINT);
+    sum->swap = fb_alloc(h * sizeof(*sum->data), FB_ALLOC_PREFER_TCM);
 
     for (int i = 0; i < h; i++) {
-        sum->data[i] = fb_alloc(w * sizeof(**sum->data), FB_ALLOC_NO_HINT);
+        sum->data[i] = fb_alloc(w * sizeof(**sum->data), FB_ALLOC_PREFER_TCM);
     }
 }
 
@@ -219,45 +219,37 @@ void imlib_integral_mw_shift_sq(image_t *src, mw_image_t *sum, int n) {
     }
 }
 
-void imlib_integral_mw_ss(image_t *src, mw_image_t *sum, mw_image_t *ssq, rectangle_t *roi) {
-    // Image data pointers
-    typeof(*sum->data) * sum_data = sum->data;
-    typeof(*sum->data) * ssq_data = ssq->data;
-
-    // Compute the first row to avoid branching
-    for (int sx, s = 0, sq = 0, x = 0; x < sum->w; x++) {
-        // X offset
-        sx = roi->x + ((x * sum->x_ratio) >> 16);
-
-        // Accumulate row data
-        s += IM_TO_GS_PIXEL(src, sx, roi->y);
-        sq += IM_TO_GS_PIXEL(src, sx, roi->y) * IM_TO_GS_PIXEL(src, sx, roi->y);
-
-        sum_data[0][x] = s;
-        ssq_data[0][x] = sq;
+// Samples one scaled grayscale row of the roi and computes both integral image rows from it.
+static void imlib_integral_mw_ss_row(image_t *src, mw_image_t *sum, mw_image_t *ssq, rectangle_t *roi,
+                                     uint8_t *pixels, int y, int sy) {
+    if (src->pixfmt == PIXFORMAT_GRAYSCALE) {
+        uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, sy) + roi->x;
+        for (int x = 0; x < sum->w; x++) {
+            pixels[x] = row_ptr[(x * sum->x_ratio) >> 16];
+        }
+    } else {
+        for (int x = 0; x < sum->w; x++) {
+            pixels[x] = IM_TO_GS_PIXEL(src, roi->x + ((x * sum->x_ratio) >> 16), sy);
+        }
     }
 
-    // Compute the last n lines
-    for (int sy, y = 1; y < sum->h; y++) {
-        // Y offset
-        sy = roi->y + ((y * sum->y_ratio) >> 16);
-
-        // Sum the current row
-        for (int sx, s = 0, sq = 0, x = 0; x < sum->w; x++) {
-            // X offset
-            sx = roi->x + ((x * sum->x_ratio) >> 16);
+    imlib_integral_row_ss(pixels, sum->w,
+                          sum->data[y], y ? sum->data[y - 1] : NULL,
+                          ssq->data[y], y ? ssq->data[y - 1] : NULL);
+}
 
-            // Accumulate row data
-            s += IM_TO_GS_PIXEL(src, sx, sy);
-            sq += IM_TO_GS_PIXEL(src, sx, sy) * IM_TO_GS_PIXEL(src, sx, sy);
+void imlib_integral_mw_ss(image_t *src, mw_image_t *sum, mw_image_t *ssq, rectangle_t *roi) {
+    uint8_t *pixels = fb_alloc(sum->w, FB_ALLOC_PREFER_TCM);
 
-            sum_data[y][x] = s + sum_data[y - 1][x];
-            ssq_data[y][x] = sq + ssq_data[y - 1][x];
-        }
+    for (int y = 0; y < sum->h; y++) {
+        // Y offset
+        int sy = roi->y + ((y * sum->y_ratio) >> 16);
+        imlib_integral_mw_ss_row(src, sum, ssq, roi, pixels, y, sy);
     }
 
     sum->y_offs = sum->h;
     ssq->y_offs = sum->h;
+    fb_free();
 }
 
 void imlib_integral_mw_shift_ss(image_t *src, mw_image_t *sum, mw_image_t *ssq, rectangle_t *roi, int n) {
@@ -271,28 +263,16 @@ void imlib_integral_mw_shift_ss(image_t *src, mw_image_t *sum, mw_image_t *ssq,
     SWAP_PTRS(sum->data, sum->swap);
     SWAP_PTRS(ssq->data, ssq->swap);
 
-    // Pointer to the current sum and ssq data
-    typeof(*sum->data) * sum_data = sum->data;
-    typeof(*ssq->data) * ssq_data = ssq->data;
+    uint8_t *pixels = fb_alloc(sum->w, FB_ALLOC_PREFER_TCM);
 
     // Compute the last n lines
-    for (int sy, y = (sum->h - n); y < sum->h; y++, sum->y_offs++, ssq->y_offs++) {
+    for (int y = (sum->h - n); y < sum->h; y++, sum->y_offs++, ssq->y_offs++) {
         // The y offset is set to the last line + 1
-        sy = roi->y + ((sum->y_offs * sum->y_ratio) >> 16);
-
-        // Sum of the current row
-        for (int sx, s = 0, sq = 0, x = 0; x < sum->w; x++) {
-            // X offset
-            sx = roi->x + ((x * sum->x_ratio) >> 16);
-
-            // Accumulate row data
-            s += IM_TO_GS_PIXEL(src, sx, sy);
-            sq += IM_TO_GS_PIXEL(src, sx, sy) * IM_TO_GS_PIXEL(src, sx, sy);
-
-            sum_data[y][x] = s + sum_data[y - 1][x];
-            ssq_data[y][x] = sq + ssq_data[y - 1][x];
-        }
+        int sy = roi->y + ((sum->y_offs * sum->y_ratio) >> 16);
+        imlib_integral_mw_ss_row(src, sum, ssq, roi, pixels, y, sy);
     }
+
+    fb_free();
 }
 
 long imlib_integral_mw_lookup(mw_image_t *sum, int x, int y, int w, int h) {
@@ -712,6 +712,109 @@ void imlib_awb_rgb_max(image_t *img, uint32_t *r_out, uint32_t *g_out, uint32_t
     }
 }
 
+// Computes the AWB, AE and focus statistics on a grid of one sample every step pixels, so the
+// cost is divided by step^2 versus the full frame methods above. Bayer images are sampled per
+// 2x2 quad (step is rounded up to be even to keep the bayer phase) and the focus metric is the
+// difference between the two greens. Otherwise it's the horizontal luma gradient.
+void imlib_isp_stats(image_t *img, int step, imlib_isp_stats_t *stats) {
+    uint32_t r_acc = 0, g_acc = 0, b_acc = 0, y_acc = 0, f_acc = 0, n = 0;
+    memset(stats, 0, sizeof(imlib_isp_stats_t));
+
+    step = IM_MAX(step, 1);
+
+    if (img->is_bayer) {
+        step = (step + 1) & ~1;
+
+        for (int y = 0; y < (img->h - 1); y += step) {
+            uint8_t *row0 = IMAGE_COMPUTE_BAYER_PIXEL_ROW_PTR(img, y);
+            uint8_t *row1 = IMAGE_COMPUTE_BAYER_PIXEL_ROW_PTR(img, y + 1);
+
+            for (int x = 0; x < (img->w - 1); x += step) {
+                uint32_t p00 = row0[x], p01 = row0[x + 1], p10 = row1[x], p11 = row1[x + 1];
+                uint32_t r, g0, g1, b;
+
+                switch (img->pixfmt) {
+                    case PIXFORMAT_BAYER_BGGR: {
+                        b = p00; g0 = p01; g1 = p10; r = p11;
+                        break;
+                    }
+                    case PIXFORMAT_BAYER_GBRG: {
+                        g0 = p00; b = p01; r = p10; g1 = p11;
+                        break;
+                    }
+                    case PIXFORMAT_BAYER_GRBG: {
+                        g0 = p00; r = p01; b = p10; g1 = p11;
+                        break;
+                    }
+                    default: {
+                        r = p00; g0 = p01; g1 = p10; b = p11;
+                        break;
+                    }
+                }
+
+                uint32_t g = (g0 + g1) >> 1;
+                uint32_t luma = COLOR_RGB888_TO_Y(r, g, b);
+                r_acc += r;
+                g_acc += g;
+                b_acc += b;
+                y_acc += luma;
+                f_acc += abs(((int) g0) - ((int) g1));
+                stats->histogram[(luma * IMLIB_ISP_STATS_BINS) >> 8] += 1;
+                n += 1;
+            }
+        }
+    } else {
+        switch (img->pixfmt) {
+            case PIXFORMAT_GRAYSCALE: {
+                for (int y = 0; y < img->h; y += step) {
+                    uint8_t *row = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+
+                    for (int x = 0; x < (img->w - 1); x += step) {
+                        uint32_t luma = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row, x);
+                        y_acc += luma;
+                        f_acc += abs(((int) IMAGE_GET_GRAYSCALE_PIXEL_FAST(row, x + 1)) - ((int) luma));
+                        stats->histogram[(luma * IMLIB_ISP_STATS_BINS) >> 8] += 1;
+                        n += 1;
+                    }
+                }
+
+                r_acc = g_acc = b_acc = y_acc;
+                break;
+            }
+            case PIXFORMAT_RGB565: {
+                for (int y = 0; y < img->h; y += step) {
+                    uint16_t *row = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+
+                    for (int x = 0; x < (img->w - 1); x += step) {
+                        uint32_t pixel = IMAGE_GET_RGB565_PIXEL_FAST(row, x);
+                        uint32_t luma = COLOR_RGB565_TO_Y(pixel);
+                        r_acc += COLOR_RGB565_TO_R8(pixel);
+                        g_acc += COLOR_RGB565_TO_G8(pixel);
+                        b_acc += COLOR_RGB565_TO_B8(pixel);
+                        y_acc += luma;
+                        f_acc += abs(((int) COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row, x + 1))) - ((int) luma));
+                        stats->histogram[(luma * IMLIB_ISP_STATS_BINS) >> 8] += 1;
+                        n += 1;
+                    }
+                }
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+    }
+
+    if (n) {
+        stats->samples = n;
+        stats->r_avg = r_acc / n;
+        stats->g_avg = g_acc / n;
+        stats->b_avg = b_acc / n;
+        stats->y_avg = y_acc / n;
+        stats->focus = f_acc / n;
+    }
+}
+
 void imlib_awb(image_t *img, uint32_t r_out, uint32_t g_out, uint32_t b_out) {
     uint32_t area = img->w * img->h;
 
@@ -1136,4 +1239,97 @@ void imlib_gamma(image_t *img, float gamma, float contrast, float brightness) {
     }
 }
 
+// Builds the integer tables for imlib_isp(). gains are the per channel AWB gains (or NULL) which
+// are folded into the columns of ccm (or the identity when NULL), which has the same layout and
+// offset units as imlib_ccm(). The gamma, contrast and brightness work like imlib_gamma().
+void imlib_isp_params_init(imlib_isp_params_t *params, const float *gains, const float *ccm,
+                           float gamma, float contrast, float brightness) {
+    static const float identity[12] = {
+        1.0f, 0.0f, 0.0f, 0.0f,
+        0.0f, 1.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 1.0f, 0.0f
+    };
+    // Offsets are in 5/6-bit channel units like imlib_ccm().
+    static const float offset_scale[3] = {
+        (COLOR_R8_MAX / (float) COLOR_R5_MAX),
+        (COLOR_G8_MAX / (float) COLOR_G6_MAX),
+        (COLOR_B8_MAX / (float) COLOR_B5_MAX)
+    };
+
+    if (!ccm) {
+        ccm = identity;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            float c = ccm[(i * 4) + j] * (gains ? gains[j] : 1.0f);
+            params->ccm[(i * 3) + j] = IM_CLAMP(fast_roundf(c * 256), INT16_MIN, INT16_MAX);
+        }
+
+        params->offset[i] = fast_roundf(ccm[(i * 4) + 3] * offset_scale[i] * 256) + 128;
+    }
+
+    gamma = IM_DIV(1.0f, gamma);
+    float pScale = COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN;
+    float pDiv = 1 / pScale;
+
+    for (int i = COLOR_GRAYSCALE_MIN; i <= COLOR_GRAYSCALE_MAX; i++) {
+        int p = ((fast_powf(i * pDiv, gamma) * contrast) + brightness) * pScale;
+        p = __USAT(p, 8);
+        params->lut[0][i] = COLOR_R8_G8_B8_TO_RGB565(p, 0, 0);
+        params->lut[1][i] = COLOR_R8_G8_B8_TO_RGB565(0, p, 0);
+        params->lut[2][i] = COLOR_R8_G8_B8_TO_RGB565(0, 0, p);
+    }
+}
+
+static void imlib_isp_rgb565(uint16_t *dst, const uint16_t *src, long n, const imlib_isp_params_t *params) {
+    const int16_t *m = params->ccm;
+    const int32_t *o = params->offset;
+
+    #if defined(ARM_MATH_DSP)
+    long smuad_rr_rb = __PKHBT(m[2], m[0], 16);
+    long smuad_gr_gb = __PKHBT(m[5], m[3], 16);
+    long smuad_br_bb = __PKHBT(m[8], m[6], 16);
+    #endif
+
+    for (; n > 0; n -= 1) {
+        int pixel = *src++;
+        int r = COLOR_RGB565_TO_R8(pixel);
+        int g = COLOR_RGB565_TO_G8(pixel);
+        int b = COLOR_RGB565_TO_B8(pixel);
+        #if defined(ARM_MATH_DSP)
+        int r_b = __PKHBT(b, r, 16);
+        int new_r = __USAT_ASR(__SMLAD(r_b, smuad_rr_rb, (m[1] * g) + o[0]), 8, 8);
+        int new_g = __USAT_ASR(__SMLAD(r_b, smuad_gr_gb, (m[4] * g) + o[1]), 8, 8);
+        int new_b = __USAT_ASR(__SMLAD(r_b, smuad_br_bb, (m[7] * g) + o[2]), 8, 8);
+        #else
+        int new_r = __USAT_ASR((m[0] * r) + (m[1] * g) + (m[2] * b) + o[0], 8, 8);
+        int new_g = __USAT_ASR((m[3] * r) + (m[4] * g) + (m[5] * b) + o[1], 8, 8);
+        int new_b = __USAT_ASR((m[6] * r) + (m[7] * g) + (m[8] * b) + o[2], 8, 8);
+        #endif
+        *dst++ = params->lut[0][new_r] | params->lut[1][new_g] | params->lut[2][new_b];
+    }
+}
+
+// Applies the AWB gains, CCM and gamma in one pass, which is the same as imlib_awb(), imlib_ccm()
+// and imlib_gamma() back to back but without the intermediate rounding and 3x the memory traffic.
+// dst must be an RGB565 image the same size as src.
+// RGB565: src and dst may overlap.
+// BAYER: Each row is debayered into a buffer and corrected while still in the cache, so
+//        src and dst may not overlap.
+void imlib_isp(image_t *dst, image_t *src, const imlib_isp_params_t *params) {
+    if (src->is_bayer) {
+        uint16_t *row = fb_alloc(src->w * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+
+        for (int y = 0; y < src->h; y++) {
+            imlib_debayer_line(0, src->w, y, row, PIXFORMAT_RGB565, src);
+            imlib_isp_rgb565(IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst, y), row, src->w, params);
+        }
+
+        fb_free();
+    } else if (src->pixfmt == PIXFORMAT_RGB565) {
+        imlib_isp_rgb565((uint16_t *) dst->data, (uint16_t *) src->data, src->w * src->h, params);
+    }
+}
+
 #endif // IMLIB_ENABLE_ISP_OPS
@@ -155,6 +155,8 @@ typedef struct jpeg_image_tag {
     int iVLCSize;                // current quantity of data in the VLC buffer
     int iResInterval, iResCount; // restart interval
     int iMaxMCUs;                // max MCUs of pixels per JPEGDraw call
+    int bCrop;                   // only decode the output window below
+    int iCropX, iCropY, iCropCX, iCropCY; // output window (in scaled pixels)
     JPEG_READ_CALLBACK *pfnRead;
     JPEG_SEEK_CALLBACK *pfnSeek;
     JPEG_DRAW_CALLBACK *pfnDraw;
@@ -2564,6 +2566,94 @@ static void JPEGPutMCU21(JPEGIMAGE *pJPEG, int x, int y) {
     } // for row
 }
 
+// Returns pixel (u, v) of a decoded block scaled down by 1 << iScaleShift. The reduced
+// IDCTs store 2x2 (1/4) or 1x1 (1/8) pixels while 1/2 averages the full size block.
+static inline int JPEGGetScaledPixel(const uint8_t *pBlock, int u, int v, int iScaleShift) {
+    switch (iScaleShift) {
+        case 1: {
+            const uint8_t *p = pBlock + (v * 16) + (u * 2);
+            return (p[0] + p[1] + p[8] + p[9] + 2) >> 2;
+        }
+        case 2:
+            return pBlock[(v * 2) + u];
+        case 3:
+            return pBlock[0];
+        default:
+            return pBlock[(v * 8) + u];
+    }
+}
+
+// Returns the average of the su x sv pixels at (u, v) of a full size block.
+static inline int JPEGGetChromaPixel(const uint8_t *pBlock, int u, int v, int su, int sv) {
+    const uint8_t *p = pBlock + (v * 8) + u;
+    if (su == 1 && sv == 1) {
+        return p[0];
+    } else if (sv == 1) {
+        return (p[0] + p[1] + 1) >> 1;
+    } else if (su == 1) {
+        return (p[0] + p[8] + 1) >> 1;
+    }
+    return (p[0] + p[1] + p[8] + p[9] + 2) >> 2;
+}
+
+// Writes the part of the MCU at (x, y) that overlaps the output window into the image.
+static void JPEGPutMCUCrop(JPEGIMAGE *pJPEG, int x, int y, int mcuCX, int mcuCY,
+                           int iCbOffset, int iCrOffset, int iScaleShift) {
+    image_t *dst = (image_t *) pJPEG->pUser;
+    const uint8_t *pCb = (const uint8_t *) &pJPEG->sMCUs[iCbOffset];
+    const uint8_t *pCr = (const uint8_t *) &pJPEG->sMCUs[iCrOffset];
+    const int iBlockSize = 8 >> iScaleShift;
+    const int bColor = pJPEG->ucSubSample && (pJPEG->ucNumComponents == 3);
+    int x_start = IM_MAX(x, pJPEG->iCropX), x_end = IM_MIN(x + mcuCX, pJPEG->iCropX + pJPEG->iCropCX);
+    int y_start = IM_MAX(y, pJPEG->iCropY), y_end = IM_MIN(y + mcuCY, pJPEG->iCropY + pJPEG->iCropCY);
+
+    for (int oy = y_start; oy < y_end; oy++) {
+        int ty = oy - y, dy = oy - pJPEG->iCropY;
+
+        for (int ox = x_start; ox < x_end; ox++) {
+            int tx = ox - x, dx = ox - pJPEG->iCropX;
+            // Luma blocks are stored left to right and then top to bottom.
+            int iBlock = ((ty / iBlockSize) * (mcuCX / iBlockSize)) + (tx / iBlockSize);
+            const uint8_t *pY = (const uint8_t *) &pJPEG->sMCUs[iBlock * DCTSIZE];
+            int Y = JPEGGetScaledPixel(pY, tx % iBlockSize, ty % iBlockSize, iScaleShift);
+
+            switch (dst->pixfmt) {
+                case PIXFORMAT_BINARY: {
+                    IMAGE_PUT_BINARY_PIXEL(dst, dx, dy, Y > 127);
+                    break;
+                }
+                case PIXFORMAT_GRAYSCALE: {
+                    IMAGE_PUT_GRAYSCALE_PIXEL(dst, dx, dy, Y);
+                    break;
+                }
+                case PIXFORMAT_RGB565: {
+                    uint16_t pixel = usGrayTo565[Y];
+                    if (bColor) {
+                        int Cb, Cr;
+                        // The chroma blocks cover the whole MCU.
+                        if (iScaleShift <= 1) {
+                            // Full size chroma blocks, only average along the axes that aren't subsampled.
+                            int su = IM_MAX(8 / mcuCX, 1), sv = IM_MAX(8 / mcuCY, 1);
+                            Cb = JPEGGetChromaPixel(pCb, (tx * 8) / mcuCX, (ty * 8) / mcuCY, su, sv);
+                            Cr = JPEGGetChromaPixel(pCr, (tx * 8) / mcuCX, (ty * 8) / mcuCY, su, sv);
+                        } else {
+                            int cu = (tx * iBlockSize) / mcuCX, cv = (ty * iBlockSize) / mcuCY;
+                            Cb = JPEGGetScaledPixel(pCb, cu, cv, iScaleShift);
+                            Cr = JPEGGetScaledPixel(pCr, cu, cv, iScaleShift);
+                        }
+                        JPEGPixelLE(&pixel, Y << 12, Cb, Cr);
+                    }
+                    IMAGE_PUT_RGB565_PIXEL(dst, dx, dy, pixel);
+                    break;
+                }
+                default: {
+                    break;
+                }
+            }
+        }
+    }
+}
+
 // Decode the image
 // returns 0 for error, 1 for success
 static int DecodeJPEG(JPEGIMAGE *pJPEG) {
@@ -2686,12 +2776,20 @@ static int DecodeJPEG(JPEGIMAGE *pJPEG) {
         iMCUCount = cx; // do the whole row
     }
     for (y = 0; y < cy && bContinue; y++) {
+        if (pJPEG->bCrop && ((y * mcuCY) >= (pJPEG->iCropY + pJPEG->iCropCY))) {
+            break; // past the output window
+        }
         for (x = 0; x < cx && bContinue && iErr == 0; x++) {
+            // MCUs outside of the output window still have to be entropy decoded, but
+            // the IDCT can be skipped.
+            int bSkip = pJPEG->bCrop && ((((y + 1) * mcuCY) <= pJPEG->iCropY)
+                                         || (((x + 1) * mcuCX) <= pJPEG->iCropX)
+                                         || ((x * mcuCX) >= (pJPEG->iCropX + pJPEG->iCropCX)));
             pJPEG->ucACTable = cACTable0;
             pJPEG->ucDCTable = cDCTable0;
             // do the first luminance component
             iErr = JPEGDecodeMCU(pJPEG, iLum0, &iDCPred0);
-            if (pJPEG->ucMaxACCol == 0 || bThumbnail) {
+            if (bSkip || pJPEG->ucMaxACCol == 0 || bThumbnail) {
                 // no AC components, save some time
                 pl = (uint32_t *) &pJPEG->sMCUs[iLum0];
                 c = ucRangeTable[((iDCPred0 * iQuant1) >> 5) & 0x3ff];
@@ -2709,7 +2807,7 @@ static int DecodeJPEG(JPEGIMAGE *pJPEG) {
             if (pJPEG->ucSubSample > 0x11) {
                 // subsampling
                 iErr |= JPEGDecodeMCU(pJPEG, iLum1, &iDCPred0);
-                if (pJPEG->ucMaxACCol == 0 || bThumbnail) {
+                if (bSkip || pJPEG->ucMaxACCol == 0 || bThumbnail) {
                     // no AC components, save some time
                     c = ucRangeTable[((iDCPred0 * iQuant1) >> 5) & 0x3ff];
                     l = c | ((uint32_t) c << 8) | ((uint32_t) c << 16) | ((uint32_t) c << 24);
@@ -2725,7 +2823,7 @@ static int DecodeJPEG(JPEGIMAGE *pJPEG) {
                 }
                 if (pJPEG->ucSubSample == 0x22) {
                     iErr |= JPEGDecodeMCU(pJPEG, iLum2, &iDCPred0);
-                    if (pJPEG->ucMaxACCol == 0 || bThumbnail) {
+                    if (bSkip || pJPEG->ucMaxACCol == 0 || bThumbnail) {
                         // no AC components, save some time
                         c = ucRangeTable[((iDCPred0 * iQuant1) >> 5) & 0x3ff];
                         l = c | ((uint32_t) c << 8) | ((uint32_t) c << 16) | ((uint32_t) c << 24);
@@ -2740,7 +2838,7 @@ static int DecodeJPEG(JPEGIMAGE *pJPEG) {
                         JPEGIDCT(pJPEG, iLum2, pJPEG->JPCI[0].quant_tbl_no, (pJPEG->ucMaxACCol | (pJPEG->ucMaxACRow << 8)));
                     }
                     iErr |= JPEGDecodeMCU(pJPEG, iLum3, &iDCPred0);
-                    if (pJPEG->ucMaxACCol == 0 || bThumbnail) {
+                    if (bSkip || pJPEG->ucMaxACCol == 0 || bThumbnail) {
                         // no AC components, save some time
                         c = ucRangeTable[((iDCPred0 * iQuant1) >> 5) & 0x3ff];
                         l = c | ((uint32_t) c << 8) | ((uint32_t) c << 16) | ((uint32_t) c << 24);
@@ -2762,7 +2860,7 @@ static int DecodeJPEG(JPEGIMAGE *pJPEG) {
                 pJPEG->ucACTable = cACTable1;
                 pJPEG->ucDCTable = cDCTable1;
                 iErr |= JPEGDecodeMCU(pJPEG, iCr, &iDCPred1);
-                if (pJPEG->ucMaxACCol == 0 || bThumbnail) {
+                if (bSkip || pJPEG->ucMaxACCol == 0 || bThumbnail) {
                     // no AC components, save some time
                     c = ucRangeTable[((iDCPred1 * iQuant2) >> 5) & 0x3ff];
                     l = c | ((uint32_t) c << 8) | ((uint32_t) c << 16) | ((uint32_t) c << 24);
@@ -2780,7 +2878,7 @@ static int DecodeJPEG(JPEGIMAGE *pJPEG) {
                 pJPEG->ucACTable = cACTable2;
                 pJPEG->ucDCTable = cDCTable2;
                 iErr |= JPEGDecodeMCU(pJPEG, iCb, &iDCPred2);
-                if (pJPEG->ucMaxACCol == 0 || bThumbnail) {
+                if (bSkip || pJPEG->ucMaxACCol == 0 || bThumbnail) {
                     // no AC components, save some time
                     c = ucRangeTable[((iDCPred2 * iQuant3) >> 5) & 0x3ff];
                     l = c | ((uint32_t) c << 8) | ((uint32_t) c << 16) | ((uint32_t) c << 24);
@@ -2794,7 +2892,12 @@ static int DecodeJPEG(JPEGIMAGE *pJPEG) {
                     JPEGIDCT(pJPEG, iCb, pJPEG->JPCI[2].quant_tbl_no, (pJPEG->ucMaxACCol | (pJPEG->ucMaxACRow << 8)));
                 }
             } // if color components present
-            if (pJPEG->ucPixelType == EIGHT_BIT_GRAYSCALE) {
+            if (pJPEG->bCrop) {
+                if (!bSkip) {
+                    // The first chroma component (Cb) is stored at iCr.
+                    JPEGPutMCUCrop(pJPEG, x * mcuCX, y * mcuCY, mcuCX, mcuCY, iCr, iCb, iScaleShift);
+                }
+            } else if (pJPEG->ucPixelType == EIGHT_BIT_GRAYSCALE) {
                 JPEGPutMCU8BitGray(pJPEG, x * mcuCX, y * mcuCY);
             } else if (pJPEG->ucPixelType == ONE_BIT_GRAYSCALE) {
                 JPEGPutMCU1BitGray(pJPEG, x * mcuCX, y * mcuCY);
@@ -2840,8 +2943,8 @@ static int DecodeJPEG(JPEGIMAGE *pJPEG) {
     return (iErr == 0);
 }
 
-void jpeg_decompress(image_t *dst, image_t *src) {
-    OMV_PROFILE_START();
+static void jpeg_decompress_window(image_t *dst, image_t *src, rectangle_t *roi, int scale) {
+    OMV_PROFILE_START(jpeg_decompress);
     JPEGIMAGE jpg;
 
     // Supports decoding baseline JPEGs only.
@@ -2871,6 +2974,20 @@ void jpeg_decompress(image_t *dst, image_t *src) {
             mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Unsupported format."));
     }
 
+    int options = 0;
+
+    if (roi) {
+        // Decode the ROI scaled down in the DCT domain.
+        options = (scale == 2) ? JPEG_SCALE_HALF :
+                  (scale == 4) ? JPEG_SCALE_QUARTER :
+                  (scale == 8) ? JPEG_SCALE_EIGHTH : 0;
+        jpg.bCrop = 1;
+        jpg.iCropX = roi->x / scale;
+        jpg.iCropY = roi->y / scale;
+        jpg.iCropCX = dst->w;
+        jpg.iCropCY = dst->h;
+    }
+
     // Set up dest image params
     jpg.pUser = (void *) dst;
 
@@ -2878,10 +2995,24 @@ void jpeg_decompress(image_t *dst, image_t *src) {
     memset(dst->data, 0, image_size(dst));
 
     // Start decoding.
-    if (JPEG_decode(&jpg, 0, 0, 0) == 0) {
+    if (JPEG_decode(&jpg, 0, 0, options) == 0) {
         mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("JPEG decoder failed."));
     }
 
-    OMV_PROFILE_PRINT();
+    OMV_PROFILE_END(jpeg_decompress);
+}
+
+void jpeg_decompress(image_t *dst, image_t *src) {
+    jpeg_decompress_window(dst, src, NULL, 1);
+}
+
+void jpeg_decompress_roi(image_t *dst, image_t *src, rectangle_t *roi, int scale) {
+    rectangle_t bounds = {0, 0, src->w, src->h};
+
+    if (!roi) {
+        roi = &bounds;
+    }
+
+    jpeg_decompress_window(dst, src, roi, scale);
 }
 #endif
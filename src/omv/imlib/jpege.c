@@ -323,14 +323,16 @@ typedef struct {
     int idx;
     int length;
     uint8_t *buf;
-    uint32_t bitb;
+    uint64_t bitb; // right aligned, only the low bitc bits are valid
     uint32_t bitc;
     bool realloc;
     bool overflow;
+    jpeg_stream_callback_t callback;
+    void *callback_arg;
 } jpeg_buf_t;
 
-// Quantization tables
-static float fdtbl_Y[64], fdtbl_UV[64];
+// Quantization tables (reciprocals in Q18 fixed point)
+static int32_t fdtbl_Y[64], fdtbl_UV[64];
 static uint8_t YTable[64], UVTable[64];
 
 static const uint8_t s_jpeg_ZigZag[] = {
@@ -567,11 +569,26 @@ static const uint16_t UVAC_HT[256][2] = {
     {0x0000, 0x0000}, {0x0000, 0x0000}, {0x0000, 0x0000}, {0x0000, 0x0000},
 };
 
+// Hand the buffered bytes to the stream callback and start over at the
+// beginning of the buffer. Does nothing if the output isn't streamed.
+static void jpeg_flush(jpeg_buf_t *jpeg_buf) {
+    if (jpeg_buf->callback && jpeg_buf->idx) {
+        if ((!jpeg_buf->overflow) && (!jpeg_buf->callback(jpeg_buf->callback_arg, jpeg_buf->buf, jpeg_buf->idx))) {
+            // Callback aborted the stream.
+            jpeg_buf->overflow = true;
+        }
+        jpeg_buf->idx = 0;
+    }
+}
+
 // Check if the output buffer is nearly full and allocate more space
 // if needed. If realloc is disabled, return true to halt the encoding.
 static int jpeg_check_highwater(jpeg_buf_t *jpeg_buf) {
     if ((jpeg_buf->idx + 1) >= jpeg_buf->length - 256) {
-        if (jpeg_buf->realloc == false) {
+        if (jpeg_buf->callback) {
+            jpeg_flush(jpeg_buf);
+            return jpeg_buf->overflow;
+        } else if (jpeg_buf->realloc == false) {
             // Can't realloc buffer
             jpeg_buf->overflow = true;
             return 1;
@@ -584,13 +601,16 @@ static int jpeg_check_highwater(jpeg_buf_t *jpeg_buf) {
 
 static void jpeg_put_char(jpeg_buf_t *jpeg_buf, char c) {
     if ((jpeg_buf->idx + 1) >= jpeg_buf->length) {
-        if (jpeg_buf->realloc == false) {
+        if (jpeg_buf->callback) {
+            jpeg_flush(jpeg_buf);
+        } else if (jpeg_buf->realloc == false) {
             // Can't realloc buffer
             jpeg_buf->overflow = true;
             return;
+        } else {
+            jpeg_buf->length += 1024;
+            jpeg_buf->buf = xrealloc(jpeg_buf->buf, jpeg_buf->length);
         }
-        jpeg_buf->length += 1024;
-        jpeg_buf->buf = xrealloc(jpeg_buf->buf, jpeg_buf->length);
     }
 
     jpeg_buf->buf[jpeg_buf->idx++] = c;
@@ -598,32 +618,67 @@ static void jpeg_put_char(jpeg_buf_t *jpeg_buf, char c) {
 
 static void jpeg_put_bytes(jpeg_buf_t *jpeg_buf, const void *data, int size) {
     if ((jpeg_buf->idx + size) >= jpeg_buf->length) {
-        if (jpeg_buf->realloc == false) {
+        if (jpeg_buf->callback) {
+            jpeg_flush(jpeg_buf);
+        } else if (jpeg_buf->realloc == false) {
             // Can't realloc buffer
             jpeg_buf->overflow = true;
             return;
+        } else {
+            jpeg_buf->length += 1024;
+            jpeg_buf->buf = xrealloc(jpeg_buf->buf, jpeg_buf->length);
         }
-        jpeg_buf->length += 1024;
-        jpeg_buf->buf = xrealloc(jpeg_buf->buf, jpeg_buf->length);
     }
 
     memcpy(jpeg_buf->buf + jpeg_buf->idx, data, size);
     jpeg_buf->idx += size;
 }
 
+static inline void jpeg_put_entropy_byte(jpeg_buf_t *jpeg_buf, uint8_t c) {
+    jpeg_put_char(jpeg_buf, c);
+    if (c == 255) {
+        jpeg_put_char(jpeg_buf, 0);
+    }
+}
+
+// Writes 32 bits of entropy coded data. Words without any 0xFF bytes (no
+// zero bytes in ~w) don't need byte stuffing and are written at once.
+static inline void jpeg_put_entropy_word(jpeg_buf_t *jpeg_buf, uint32_t w) {
+    uint32_t n = ~w;
+    if (!((n - 0x01010101) & ~n & 0x80808080)) {
+        w = __REV(w);
+        jpeg_put_bytes(jpeg_buf, &w, 4);
+    } else {
+        for (int i = 24; i >= 0; i -= 8) {
+            jpeg_put_entropy_byte(jpeg_buf, w >> i);
+        }
+    }
+}
+
+// Codes are at most 16 bits, so the accumulator never holds more than 47 bits.
 static inline void jpeg_write_bits(jpeg_buf_t *jpeg_buf, const uint16_t *bs) {
+    jpeg_buf->bitb = (jpeg_buf->bitb << bs[1]) | bs[0];
     jpeg_buf->bitc += bs[1];
-    jpeg_buf->bitb |= bs[0] << (24 - jpeg_buf->bitc);
 
-    while (jpeg_buf->bitc > 7) {
-        uint8_t c = (jpeg_buf->bitb >> 16) & 255;
-        jpeg_put_char(jpeg_buf, c);
-        if (c == 255) {
-            jpeg_put_char(jpeg_buf, 0);
-        }
-        jpeg_buf->bitb <<= 8;
+    if (jpeg_buf->bitc >= 32) {
+        jpeg_buf->bitc -= 32;
+        jpeg_put_entropy_word(jpeg_buf, jpeg_buf->bitb >> jpeg_buf->bitc);
+    }
+}
+
+// Pads the entropy coded data with 1 bits to a byte boundary and writes out
+// the bits left in the accumulator.
+static void jpeg_flush_bits(jpeg_buf_t *jpeg_buf) {
+    uint32_t pad = (8 - (jpeg_buf->bitc & 7)) & 7;
+    jpeg_buf->bitb = (jpeg_buf->bitb << pad) | ((1 << pad) - 1);
+    jpeg_buf->bitc += pad;
+
+    while (jpeg_buf->bitc) {
         jpeg_buf->bitc -= 8;
+        jpeg_put_entropy_byte(jpeg_buf, jpeg_buf->bitb >> jpeg_buf->bitc);
     }
+
+    jpeg_buf->bitb = 0;
 }
 
 //Huffman-encoded magnitude value
@@ -637,7 +692,7 @@ static inline void jpeg_calc_bits(int val, uint16_t bits[2]) {
     bits[0] = val & ((1 << bits[1]) - 1);
 }
 
-static int jpeg_processDU(jpeg_buf_t *jpeg_buf, int8_t *CDU, float *fdtbl, int DC, const uint16_t (*HTDC)[2],
+static int jpeg_processDU(jpeg_buf_t *jpeg_buf, int8_t *CDU, const int32_t *fdtbl, int DC, const uint16_t (*HTDC)[2],
                           const uint16_t (*HTAC)[2]) {
     int DU[64];
     int DUQ[64];
@@ -734,10 +789,13 @@ static int jpeg_processDU(jpeg_buf_t *jpeg_buf, int8_t *CDU, float *fdtbl, int D
 
     // first non-zero element in reverse order
     int end0pos = 0;
-    // Quantize/descale/zigzag the coefficients
+    // Quantize/descale/zigzag the coefficients. The quantized coefficients fit in
+    // 12 bits so the Q18 products can't overflow. Rounds half away from zero.
     for (int i = 0; i < 64; ++i) {
-        DUQ[s_jpeg_ZigZag[i]] = fast_roundf(DU[i] * fdtbl[i]);
-        if (s_jpeg_ZigZag[i] > end0pos && DUQ[s_jpeg_ZigZag[i]]) {
+        int32_t v = DU[i] * fdtbl[i];
+        int q = (v + (1 << 17) + (v >> 31)) >> 18;
+        DUQ[s_jpeg_ZigZag[i]] = q;
+        if (s_jpeg_ZigZag[i] > end0pos && q) {
             end0pos = s_jpeg_ZigZag[i];
         }
     }
@@ -804,14 +862,15 @@ static void jpeg_init(int quality) {
 
         for (int r = 0, k = 0; r < 8; ++r) {
             for (int c = 0; c < 8; ++c, ++k) {
-                fdtbl_Y[k] = 1.0f / (aasf[r] * aasf[c] * YTable [s_jpeg_ZigZag[k]] * 8.0f);
-                fdtbl_UV[k] = 1.0f / (aasf[r] * aasf[c] * UVTable[s_jpeg_ZigZag[k]] * 8.0f);
+                fdtbl_Y[k] = fast_roundf((1 << 18) / (aasf[r] * aasf[c] * YTable [s_jpeg_ZigZag[k]] * 8.0f));
+                fdtbl_UV[k] = fast_roundf((1 << 18) / (aasf[r] * aasf[c] * UVTable[s_jpeg_ZigZag[k]] * 8.0f));
             }
         }
     }
 }
 
-static void jpeg_write_headers(jpeg_buf_t *jpeg_buf, int w, int h, int bpp, jpeg_subsampling_t subsampling) {
+static void jpeg_write_headers(jpeg_buf_t *jpeg_buf, int w, int h, int bpp, jpeg_subsampling_t subsampling,
+                               int restart_interval) {
     // Number of components (1 or 3)
     uint8_t nr_comp = (bpp == 1)? 1 : 3;
 
@@ -848,6 +907,12 @@ static void jpeg_write_headers(jpeg_buf_t *jpeg_buf, int w, int h, int bpp, jpeg
         (bpp * 208 + 2) & 0xFF,   // Header length LSB
     };
 
+    uint8_t m_dri[] = {
+        0xFF, 0xDD,         // DRI
+        0x00, 0x04,         // Header length
+        restart_interval >> 8, restart_interval & 0xFF, // MCUs per restart interval
+    };
+
     uint8_t m_sos[] = {
         0xFF, 0xDA,         // SOS
         (nr_comp * 2 + 6) >> 8,   // Header length MSB
@@ -905,6 +970,11 @@ static void jpeg_write_headers(jpeg_buf_t *jpeg_buf, int w, int h, int bpp, jpeg
         jpeg_put_bytes(jpeg_buf, std_ac_chrominance_values, sizeof(std_ac_chrominance_values));
     }
 
+    if (restart_interval) {
+        // Write DRI marker
+        jpeg_put_bytes(jpeg_buf, m_dri, sizeof(m_dri));
+    }
+
     // Write SOS marker
     jpeg_put_bytes(jpeg_buf, m_sos, sizeof(m_sos));
     for (int i = 0; i < nr_comp; i++) {
@@ -915,29 +985,26 @@ static void jpeg_write_headers(jpeg_buf_t *jpeg_buf, int w, int h, int bpp, jpeg
     jpeg_put_bytes(jpeg_buf, (uint8_t [3]) {0x00, 0x3F, 0x0}, 3);
 }
 
-bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_subsampling_t subsampling) {
-    OMV_PROFILE_START();
-
-    if (!dst->data) {
-        uint32_t size = 0;
-        dst->data = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE | FB_ALLOC_CACHE_ALIGN);
-        dst->size = IMLIB_IMAGE_MAX_SIZE(size);
+// Ends the restart interval of an MCU row when streaming. The entropy coded
+// segment is padded to a byte boundary, the DC predictors are reset and the
+// next interval is started with a RSTn marker once the chunk was handed off.
+static void jpeg_restart(jpeg_buf_t *jpeg_buf, int *DCY, int *DCU, int *DCV, int *rst, bool last) {
+    if ((!jpeg_buf->callback) || last) {
+        return;
     }
 
-    if (src->is_compressed) {
-        return true;
-    }
+    jpeg_flush_bits(jpeg_buf);
+    jpeg_flush(jpeg_buf);
 
-    // JPEG buffer
-    jpeg_buf_t jpeg_buf = {
-        .idx = 0,
-        .buf = dst->pixels,
-        .length = dst->size,
-        .bitc = 0,
-        .bitb = 0,
-        .realloc = realloc,
-        .overflow = false,
-    };
+    jpeg_put_char(jpeg_buf, 0xFF);
+    jpeg_put_char(jpeg_buf, 0xD0 + *rst);
+    *rst = (*rst + 1) & 7;
+    *DCY = *DCU = *DCV = 0;
+}
+
+// Returns true if the output buffer overflowed or the stream was aborted.
+static bool jpeg_encode(image_t *src, jpeg_buf_t *jpeg_buf, int quality, jpeg_subsampling_t subsampling) {
+    OMV_PROFILE_START(jpeg_compress);
 
     // Initialize quantization tables
     jpeg_init(quality);
@@ -956,9 +1023,13 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
         subsampling = JPEG_SUBSAMPLING_444;
     }
 
-    jpeg_write_headers(&jpeg_buf, src->w, src->h, src->is_color ? 2 : 1, subsampling);
+    // When streaming every MCU row is a restart interval.
+    int mcu_w = (subsampling == JPEG_SUBSAMPLING_444) ? JPEG_MCU_W : (JPEG_MCU_W * 2);
+    int restart_interval = jpeg_buf->callback ? ((src->w + mcu_w - 1) / mcu_w) : 0;
+
+    jpeg_write_headers(jpeg_buf, src->w, src->h, src->is_color ? 2 : 1, subsampling, restart_interval);
 
-    int DCY = 0, DCU = 0, DCV = 0;
+    int DCY = 0, DCU = 0, DCV = 0, RST = 0;
 
     switch (subsampling) {
         // Quiet GCC compiler warning (this is never reached)
@@ -977,15 +1048,17 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
                     int dx = IM_MIN(JPEG_MCU_W, src->w - x_offset);
 
                     jpeg_get_mcu(src, x_offset, y_offset, dx, dy, YDU, UDU, VDU);
-                    DCY = jpeg_processDU(&jpeg_buf, YDU, fdtbl_Y, DCY, YDC_HT, YAC_HT);
+                    DCY = jpeg_processDU(jpeg_buf, YDU, fdtbl_Y, DCY, YDC_HT, YAC_HT);
 
                     if (src->is_color) {
-                        DCU = jpeg_processDU(&jpeg_buf, UDU, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
-                        DCV = jpeg_processDU(&jpeg_buf, VDU, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
+                        DCU = jpeg_processDU(jpeg_buf, UDU, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                        DCV = jpeg_processDU(jpeg_buf, VDU, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
                     }
                 }
 
-                if (jpeg_buf.overflow) {
+                jpeg_restart(jpeg_buf, &DCY, &DCU, &DCV, &RST, (y_offset + JPEG_MCU_H) >= src->h);
+
+                if (jpeg_buf->overflow) {
                     return true;
                 }
             }
@@ -1015,7 +1088,7 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
                             memset(VDU + i, 0, JPEG_444_GS_MCU_SIZE);
                         }
 
-                        DCY = jpeg_processDU(&jpeg_buf, YDU + i, fdtbl_Y, DCY, YDC_HT, YAC_HT);
+                        DCY = jpeg_processDU(jpeg_buf, YDU + i, fdtbl_Y, DCY, YDC_HT, YAC_HT);
                     }
 
                     // horizontal subsampling of U & V
@@ -1085,11 +1158,13 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
                         #endif
                     }
 
-                    DCU = jpeg_processDU(&jpeg_buf, UDU_avg, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
-                    DCV = jpeg_processDU(&jpeg_buf, VDU_avg, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
+                    DCU = jpeg_processDU(jpeg_buf, UDU_avg, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                    DCV = jpeg_processDU(jpeg_buf, VDU_avg, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
                 }
 
-                if (jpeg_buf.overflow) {
+                jpeg_restart(jpeg_buf, &DCY, &DCU, &DCV, &RST, (y_offset + JPEG_MCU_H) >= src->h);
+
+                if (jpeg_buf->overflow) {
                     return true;
                 }
             }
@@ -1121,7 +1196,7 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
                                 memset(VDU + i + j, 0, JPEG_444_GS_MCU_SIZE);
                             }
 
-                            DCY = jpeg_processDU(&jpeg_buf, YDU + i + j, fdtbl_Y, DCY, YDC_HT, YAC_HT);
+                            DCY = jpeg_processDU(jpeg_buf, YDU + i + j, fdtbl_Y, DCY, YDC_HT, YAC_HT);
                         }
 
                         // Reset back two columns.
@@ -1222,11 +1297,13 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
                         #endif
                     }
 
-                    DCU = jpeg_processDU(&jpeg_buf, UDU_avg, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
-                    DCV = jpeg_processDU(&jpeg_buf, VDU_avg, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
+                    DCU = jpeg_processDU(jpeg_buf, UDU_avg, fdtbl_UV, DCU, UVDC_HT, UVAC_HT);
+                    DCV = jpeg_processDU(jpeg_buf, VDU_avg, fdtbl_UV, DCV, UVDC_HT, UVAC_HT);
                 }
 
-                if (jpeg_buf.overflow) {
+                jpeg_restart(jpeg_buf, &DCY, &DCU, &DCV, &RST, (y_offset + (JPEG_MCU_H * 2)) >= src->h);
+
+                if (jpeg_buf->overflow) {
                     return true;
                 }
 
@@ -1238,19 +1315,74 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
     }
 
     // Do the bit alignment of the EOI marker
-    jpeg_write_bits(&jpeg_buf, (const uint16_t []) {0x7F, 7});
+    jpeg_flush_bits(jpeg_buf);
 
     // EOI
-    jpeg_put_char(&jpeg_buf, 0xFF);
-    jpeg_put_char(&jpeg_buf, 0xD9);
+    jpeg_put_char(jpeg_buf, 0xFF);
+    jpeg_put_char(jpeg_buf, 0xD9);
+
+    jpeg_flush(jpeg_buf);
+
+    OMV_PROFILE_END(jpeg_compress);
+    return jpeg_buf->overflow;
+}
+
+bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_subsampling_t subsampling) {
+    if (!dst->data) {
+        uint32_t size = 0;
+        dst->data = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE | FB_ALLOC_CACHE_ALIGN);
+        dst->size = IMLIB_IMAGE_MAX_SIZE(size);
+    }
+
+    if (src->is_compressed) {
+        return true;
+    }
+
+    // JPEG buffer
+    jpeg_buf_t jpeg_buf = {
+        .idx = 0,
+        .buf = dst->pixels,
+        .length = dst->size,
+        .bitc = 0,
+        .bitb = 0,
+        .realloc = realloc,
+        .overflow = false,
+        .callback = NULL,
+        .callback_arg = NULL,
+    };
+
+    if (jpeg_encode(src, &jpeg_buf, quality, subsampling)) {
+        return true;
+    }
 
     dst->size = jpeg_buf.idx;
     dst->data = jpeg_buf.buf;
-
-    OMV_PROFILE_PRINT();
     return false;
 }
 
+bool jpeg_compress_stream(image_t *src, int quality, jpeg_subsampling_t subsampling,
+                          uint8_t *buf, uint32_t size, jpeg_stream_callback_t callback, void *arg) {
+    if (src->is_compressed || (size < JPEG_STREAM_BUFFER_MIN)) {
+        return true;
+    }
+
+    // The buffer only has to hold one chunk at a time. It's flushed to the
+    // callback at the end of each MCU row and whenever it fills up.
+    jpeg_buf_t jpeg_buf = {
+        .idx = 0,
+        .buf = buf,
+        .length = size,
+        .bitc = 0,
+        .bitb = 0,
+        .realloc = false,
+        .overflow = false,
+        .callback = callback,
+        .callback_arg = arg,
+    };
+
+    return jpeg_encode(src, &jpeg_buf, quality, subsampling);
+}
+
 #endif // (OMV_JPEG_CODEC_ENABLE == 0)
 
 bool jpeg_is_valid(image_t *img) {
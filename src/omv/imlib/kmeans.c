@@ -7,6 +7,12 @@
  * This work is licensed under the MIT license, see the file LICENSE for details.
  *
  * Kmeans clustering.
+ *
+ * Points and centroids are stored as structures of arrays (all x's, then all y's, ...) so the
+ * assignment step runs over contiguous memory one centroid at a time. Centroids are seeded with
+ * k-means++ (Arthur and Vassilvitskii) and Lloyd's iterations stop once no assignment changes.
+ * With a batch size smaller than the number of points mini-batch k-means (Sculley) is used and
+ * iterations stop once the centroids settle.
  */
 #include <float.h>
 #include <limits.h>
@@ -14,122 +20,239 @@
 #include <stdio.h>
 #include "imlib.h"
 #include "array.h"
+#include "fb_alloc.h"
 #include "xalloc.h"
 
-extern uint32_t rng_randint(uint32_t min, uint32_t max);
-
-static cluster_t *cluster_alloc(int cx, int cy) {
-    cluster_t *c = NULL;
-    c = xalloc(sizeof(*c));
-    if (c != NULL) {
-        c->x = cx;
-        c->y = cy;
-        c->w = 0;
-        c->h = 0;
-        array_alloc(&c->points, NULL);
+#define KMEANS_BATCH_SHIFT  (0.25f) // Squared centroid shift below which mini-batch stops.
+
+static inline uint32_t kmeans_rand(uint32_t *state) {
+    // xorshift32
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static inline float kmeans_dist(const int16_t *points, int n, int i, int dims,
+                                const float *centroids, int k, int j) {
+    float d = 0.0f;
+    for (int c = 0; c < dims; c++) {
+        float v = points[(c * n) + i] - centroids[(c * k) + j];
+        d += v * v;
     }
-    return c;
+    return d;
 }
 
-static void cluster_free(void *c) {
-    cluster_t *cl = c;
-    array_free(cl->points);
-    xfree(cl);
+// Updates the distance to the nearest centroid of each point with centroid j.
+static void kmeans_assign(const int16_t *points, int n, int dims, const float *centroids,
+                          int k, int j, float *dist, uint16_t *labels) {
+    for (int i = 0; i < n; i++) {
+        float d = kmeans_dist(points, n, i, dims, centroids, k, j);
+        if (d < dist[i]) {
+            dist[i] = d;
+            labels[i] = j;
+        }
+    }
 }
 
-static void cluster_reset(array_t *clusters, array_t *points) {
-    // Reset all clusters
-    for (int j = 0; j < array_length(clusters); j++) {
-        cluster_t *cl = array_at(clusters, j);
-        while (array_length(cl->points)) {
-            array_push_back(points, array_pop_back(cl->points));
+static void kmeans_seed(const int16_t *points, int n, int dims, int k, float *centroids,
+                        float *dist, uint16_t *labels, uint32_t *rng) {
+    int p = kmeans_rand(rng) % n;
+
+    for (int i = 0; i < n; i++) {
+        dist[i] = FLT_MAX;
+    }
+
+    for (int j = 0; j < k; j++) {
+        for (int c = 0; c < dims; c++) {
+            centroids[(c * k) + j] = points[(c * n) + p];
+        }
+
+        kmeans_assign(points, n, dims, centroids, k, j, dist, labels);
+
+        // Pick the next centroid with a probability proportional to the squared distance.
+        float sum = 0.0f;
+        for (int i = 0; i < n; i++) {
+            sum += dist[i];
+        }
+
+        float r = sum * ((kmeans_rand(rng) >> 8) / 16777216.0f);
+        for (p = 0; p < (n - 1); p++) {
+            r -= dist[p];
+            if (r < 0.0f) {
+                break;
+            }
         }
-        array_free(cl->points);
-        array_alloc(&cl->points, NULL);
     }
 }
 
-static int cluster_update(array_t *clusters) {
-    // Update clusters
-    for (int j = 0; j < array_length(clusters); j++) {
-        cluster_t *cl = array_at(clusters, j);
-        int cx = cl->x, cy = cl->y;
-        int cl_size = array_length(cl->points);
-
-        // Sum all points in this cluster
-        for (int i = 0; i < cl_size; i++) {
-            kp_t *p = array_at(cl->points, i);
-            cl->x += p->x;
-            cl->y += p->y;
-            // Find out the max x and y while we're at it
-            if (p->x > cl->w) {
-                cl->w = p->x;
+static void kmeans_update(const int16_t *points, int n, int dims, int k, float *centroids,
+                          uint16_t *labels, uint32_t *counts, int64_t *sums) {
+    memset(counts, 0, k * sizeof(uint32_t));
+
+    for (int i = 0; i < n; i++) {
+        counts[labels[i]]++;
+    }
+
+    for (int c = 0; c < dims; c++) {
+        float *centroid = centroids + (c * k);
+        const int16_t *coords = points + (c * n);
+        memset(sums, 0, k * sizeof(int64_t));
+
+        for (int i = 0; i < n; i++) {
+            sums[labels[i]] += coords[i];
+        }
+
+        // Empty clusters keep their centroid.
+        for (int j = 0; j < k; j++) {
+            if (counts[j]) {
+                centroid[j] = ((float) sums[j]) / counts[j];
             }
-            if (p->y > cl->h) {
-                cl->h = p->y;
+        }
+    }
+}
+
+int imlib_kmeans(const int16_t *points, int n, int dims, int k, int batch, int max_iter,
+                 float *centroids, uint16_t *labels, uint32_t *counts) {
+    uint32_t rng = 0x9E3779B9;
+    float *dist = fb_alloc(n * sizeof(float), FB_ALLOC_PREFER_SPEED);
+    int iter = 0;
+
+    kmeans_seed(points, n, dims, k, centroids, dist, labels, &rng);
+
+    if ((batch > 0) && (batch < n)) {
+        // Mini-batch, the per centroid learning rate is 1 / (points assigned so far).
+        memset(counts, 0, k * sizeof(uint32_t));
+
+        for (; iter < max_iter; iter++) {
+            float shift = 0.0f;
+
+            for (int b = 0; b < batch; b++) {
+                int i = kmeans_rand(&rng) % n;
+                int j = 0;
+                float d = FLT_MAX;
+
+                for (int m = 0; m < k; m++) {
+                    float dm = kmeans_dist(points, n, i, dims, centroids, k, m);
+                    if (dm < d) {
+                        d = dm;
+                        j = m;
+                    }
+                }
+
+                float lr = 1.0f / (++counts[j]);
+                float s = 0.0f;
+                for (int c = 0; c < dims; c++) {
+                    float *centroid = centroids + (c * k) + j;
+                    float delta = (points[(c * n) + i] - *centroid) * lr;
+                    *centroid += delta;
+                    s += delta * delta;
+                }
+                shift = IM_MAX(shift, s);
+            }
+
+            if (shift < KMEANS_BATCH_SHIFT) {
+                iter++;
+                break;
             }
         }
 
-        // Update centroid
-        cl->x = cl->x / cl_size;
-        cl->y = cl->y / cl_size;
-        // Update cluster size
-        cl->w = (cl->w - cl->x) * 2;
-        cl->h = (cl->h - cl->y) * 2;
-        if (cl->x == cx && cl->y == cy) {
-            // Cluster centroid did not change
-            return 0;
+        // Final assignment of all points.
+        for (int i = 0; i < n; i++) {
+            dist[i] = FLT_MAX;
         }
-    }
 
-    return 1;
-}
+        for (int j = 0; j < k; j++) {
+            kmeans_assign(points, n, dims, centroids, k, j, dist, labels);
+        }
+
+        memset(counts, 0, k * sizeof(uint32_t));
+        for (int i = 0; i < n; i++) {
+            counts[labels[i]]++;
+        }
+    } else {
+        int64_t *sums = fb_alloc(k * sizeof(int64_t), FB_ALLOC_NO_HINT);
+        uint16_t *prev = fb_alloc(n * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+
+        // Seeding assigned every point to its nearest seed.
+        for (; iter < max_iter; iter++) {
+            kmeans_update(points, n, dims, k, centroids, labels, counts, sums);
+            memcpy(prev, labels, n * sizeof(uint16_t));
+
+            for (int i = 0; i < n; i++) {
+                dist[i] = FLT_MAX;
+            }
 
-static void cluster_points(array_t *clusters, array_t *points, cluster_dist_t dist_func) {
-    // Add objects to cluster
-    while (array_length(points)) {
-        float distance = FLT_MAX;
-        cluster_t *cl_nearest = NULL;
-        kp_t *p = array_pop_back(points);
-
-        for (int j = 0; j < array_length(clusters); j++) {
-            cluster_t *cl = array_at(clusters, j);
-            float d = dist_func(cl->x, cl->y, p);
-            if (d < distance) {
-                distance = d;
-                cl_nearest = cl;
+            for (int j = 0; j < k; j++) {
+                kmeans_assign(points, n, dims, centroids, k, j, dist, labels);
+            }
+
+            if (!memcmp(prev, labels, n * sizeof(uint16_t))) {
+                iter++;
+                break;
             }
         }
-        // Add pointer to point to cluster.
-        // Note: Objects in the cluster are not free'd
-        array_push_back(cl_nearest->points, p);
+
+        kmeans_update(points, n, dims, k, centroids, labels, counts, sums);
+        fb_free(); // prev
+        fb_free(); // sums
     }
+
+    fb_free(); // dist
+    return iter;
 }
 
-array_t *cluster_kmeans(array_t *points, int k, cluster_dist_t dist_func) {
-    // Alloc clusters array
+static void cluster_free(void *c) {
+    cluster_t *cl = c;
+    array_free(cl->points);
+    xfree(cl);
+}
+
+array_t *cluster_kmeans(array_t *points, int k) {
+    int n = array_length(points);
     array_t *clusters = NULL;
     array_alloc(&clusters, cluster_free);
 
-    // Select K clusters randomly
-    for (int i = 0; i < k; i++) {
-        int pidx = rng_randint(0, array_length(points) - 1);
-        kp_t *p = array_at(points, pidx);
-        array_push_back(clusters, cluster_alloc(p->x, p->y));
+    if (!n) {
+        return clusters;
     }
 
-    int cl_changed = 1;
-    do {
-        // Reset clusters
-        cluster_reset(clusters, points);
+    k = IM_MIN(k, n);
+    int16_t *coords = fb_alloc(n * 2 * sizeof(int16_t), FB_ALLOC_NO_HINT);
+    uint16_t *labels = fb_alloc(n * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    uint32_t *counts = fb_alloc(k * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    float *centroids = fb_alloc(k * 2 * sizeof(float), FB_ALLOC_NO_HINT);
 
-        // Add points to clusters
-        cluster_points(clusters, points, dist_func);
+    for (int i = 0; i < n; i++) {
+        kp_t *p = array_at(points, i);
+        coords[i] = p->x;
+        coords[n + i] = p->y;
+    }
 
-        // Update centroids
-        cl_changed = cluster_update(clusters);
+    imlib_kmeans(coords, n, 2, k, 0, INT_MAX, centroids, labels, counts);
 
-    } while (cl_changed);
+    for (int j = 0; j < k; j++) {
+        cluster_t *cl = xalloc(sizeof(cluster_t));
+        cl->x = fast_roundf(centroids[j]);
+        cl->y = fast_roundf(centroids[k + j]);
+        cl->w = 0;
+        cl->h = 0;
+        array_alloc(&cl->points, NULL);
+        array_push_back(clusters, cl);
+    }
+
+    for (int i = 0; i < n; i++) {
+        cluster_t *cl = array_at(clusters, labels[i]);
+        kp_t *p = array_at(points, i);
+        array_push_back(cl->points, p);
+        cl->w = IM_MAX(cl->w, (abs(p->x - cl->x) * 2));
+        cl->h = IM_MAX(cl->h, (abs(p->y - cl->y) * 2));
+    }
 
+    fb_free(); // centroids
+    fb_free(); // counts
+    fb_free(); // labels
+    fb_free(); // coords
     return clusters;
 }
@@ -16,7 +16,9 @@
 
 #include "imlib.h"
 #include "xalloc.h"
+#include "fb_alloc.h"
 #include "file_utils.h"
+#include "simd.h"
 #ifdef IMLIB_ENABLE_FIND_LBP
 
 #define LBP_HIST_SIZE      (59) //58 uniform hist + 1
@@ -52,44 +54,110 @@ const static uint8_t uniform_tbl[256] = {
     47, 48, 58, 49, 58, 58, 58, 50, 51, 52, 58, 53, 54, 55, 56, 57
 };
 
+// Computes the codes of w pixels of a row, the 8 neighbour comparisons run on all the lanes at once.
+static void lbp_codes_row(const uint8_t *row, int s, int w, uint8_t *codes) {
+    v128_t one = vdup_u8(1);
+    v128_t ones = vdup_u8(0xff);
+
+    for (int x = 0; x < w; x += UINT8_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_8(w - x);
+        const uint8_t *p = row + x;
+        v128_t c = vldr_u8_pred(p + s + 1, pred);
+
+        // Lanes are 1 where the neighbour is below the center, so the code is the complement.
+        v128_t lt = vmin_u8(vqsub_u8(c, vldr_u8_pred(p + 0, pred)), one);
+        lt = vsli_u8(lt, vmin_u8(vqsub_u8(c, vldr_u8_pred(p + 1, pred)), one), 1);
+        lt = vsli_u8(lt, vmin_u8(vqsub_u8(c, vldr_u8_pred(p + 2, pred)), one), 2);
+        lt = vsli_u8(lt, vmin_u8(vqsub_u8(c, vldr_u8_pred(p + s + 2, pred)), one), 3);
+        lt = vsli_u8(lt, vmin_u8(vqsub_u8(c, vldr_u8_pred(p + s + s + 2, pred)), one), 4);
+        lt = vsli_u8(lt, vmin_u8(vqsub_u8(c, vldr_u8_pred(p + s + s + 1, pred)), one), 5);
+        lt = vsli_u8(lt, vmin_u8(vqsub_u8(c, vldr_u8_pred(p + s + s + 0, pred)), one), 6);
+        lt = vsli_u8(lt, vmin_u8(vqsub_u8(c, vldr_u8_pred(p + s + 0, pred)), one), 7);
+
+        vstr_u8_pred(codes + x, veor_u32(lt, ones), pred);
+    }
+}
+
 uint8_t *imlib_lbp_desc(image_t *image, rectangle_t *roi) {
     int s = image->w; //stride
     int RX = roi->w / LBP_NUM_REGIONS;
     int RY = roi->h / LBP_NUM_REGIONS;
-    uint8_t *data = image->data;
+    int w = roi->w - 3;
     uint8_t *desc = xalloc0(LBP_DESC_SIZE);
+    uint8_t *codes = fb_alloc(IM_MAX(w, 1), FB_ALLOC_NO_HINT);
 
     for (int y = roi->y; y < (roi->y + roi->h) - 3; y++) {
         int y_idx = ((y - roi->y) / RY) * LBP_NUM_REGIONS;
-        for (int x = roi->x; x < (roi->x + roi->w) - 3; x++) {
-            uint8_t lbp = 0;
-            uint8_t p = data[(y + 1) * s + x + 1];
-            int hist_idx = y_idx + (x - roi->x) / RX;
-
-            lbp |= (data[(y + 0) * s + x + 0] >= p) << 0;
-            lbp |= (data[(y + 0) * s + x + 1] >= p) << 1;
-            lbp |= (data[(y + 0) * s + x + 2] >= p) << 2;
-            lbp |= (data[(y + 1) * s + x + 2] >= p) << 3;
-            lbp |= (data[(y + 2) * s + x + 2] >= p) << 4;
-            lbp |= (data[(y + 2) * s + x + 1] >= p) << 5;
-            lbp |= (data[(y + 2) * s + x + 0] >= p) << 6;
-            lbp |= (data[(y + 1) * s + x + 0] >= p) << 7;
-
-            desc[hist_idx * LBP_HIST_SIZE + uniform_tbl[lbp]]++;
+        lbp_codes_row(image->data + (y * s) + roi->x, s, w, codes);
+
+        for (int x = 0; x < w; x++) {
+            int hist_idx = y_idx + x / RX;
+            desc[hist_idx * LBP_HIST_SIZE + uniform_tbl[codes[x]]]++;
         }
     }
+
+    fb_free(); // codes
     return desc;
 }
 
-int imlib_lbp_desc_distance(uint8_t *d0, uint8_t *d1) {
+// Stops early once the distance is above limit, the result is then only known to be above it.
+static uint32_t lbp_desc_distance(const uint8_t *d0, const uint8_t *d1, uint32_t limit) {
     uint32_t sum = 0;
-    for (int i = 0; i < LBP_DESC_SIZE; i++) {
-        int w = lbp_weights[i / LBP_HIST_SIZE];
-        sum += w * ((((d0[i] - d1[i]) * (d0[i] - d1[i])) / IM_MAX((d0[i] + d1[i]), 1)));
+
+    for (int r = 0; r < (LBP_NUM_REGIONS * LBP_NUM_REGIONS); r++, d0 += LBP_HIST_SIZE, d1 += LBP_HIST_SIZE) {
+        uint32_t w = lbp_weights[r];
+        uint32_t region = 0;
+
+        if (!w) {
+            continue;
+        }
+
+        for (int i = 0; i < LBP_HIST_SIZE; i++) {
+            int a = d0[i], b = d1[i];
+            // Equal bins add nothing, which skips the division for most of the (empty) bins.
+            if (a != b) {
+                region += ((a - b) * (a - b)) / (a + b);
+            }
+        }
+
+        sum += w * region;
+        if (sum > limit) {
+            break;
+        }
     }
     return sum;
 }
 
+int imlib_lbp_desc_distance(uint8_t *d0, uint8_t *d1) {
+    return lbp_desc_distance(d0, d1, UINT32_MAX);
+}
+
+int imlib_lbp_desc_match(uint8_t *desc, uint8_t **gallery, int n, int k, int *index, int *distance) {
+    int count = 0;
+
+    for (int i = 0; i < n; i++) {
+        // Once k matches are kept, a descriptor only matters if it beats the worst of them.
+        uint32_t limit = (count < k) ? UINT32_MAX : distance[count - 1];
+        uint32_t d = lbp_desc_distance(desc, gallery[i], limit);
+
+        if (d >= limit) {
+            continue;
+        }
+
+        // Insert sorted by distance.
+        int j = (count < k) ? count++ : (count - 1);
+        for (; (j > 0) && (((uint32_t) distance[j - 1]) > d); j--) {
+            index[j] = index[j - 1];
+            distance[j] = distance[j - 1];
+        }
+
+        index[j] = i;
+        distance[j] = d;
+    }
+
+    return count;
+}
+
 int imlib_lbp_desc_save(FIL *fp, uint8_t *desc) {
     UINT bytes;
     // Write descriptor
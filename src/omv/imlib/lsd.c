@@ -329,11 +329,10 @@ float *lsd(int *n_out, unsigned char *img, int X, int Y);
 #define USED          1
 
 /*----------------------------------------------------------------------------*/
-/** Chained list of coordinates.
+/** List of coordinates.
  */
 struct coorlist {
     int16_t x, y;
-    struct coorlist *next;
 };
 
 /*----------------------------------------------------------------------------*/
@@ -978,32 +977,28 @@ static image_double gaussian_sampler(image_double in, float scale,
     The result is:
     - an image_int with the angle at each pixel, or NOTDEF if not defined.
     - the image_int 'modgrad' (a pointer is passed as argument)
-      with the gradient magnitude at each point.
-    - a list of pixels 'list_p' roughly ordered by decreasing
-      gradient magnitude. (The order is made by classifying points
-      into bins by gradient magnitude. The parameters 'n_bins' and
-      'max_grad' specify the number of bins and the gradient modulus
-      at the highest bin. The pixels in the list would be in
-      decreasing gradient magnitude, up to a precision of the size of
-      the bins.)
-    - a pointer 'mem_p' to the memory used by 'list_p' to be able to
-      free the memory when it is not used anymore.
+      with the gradient magnitude at each point where the angle is
+      defined, zero elsewhere.
+    - an array 'list_p' of the 'list_size_p' pixels with a defined
+      angle, roughly ordered by decreasing gradient magnitude. (The
+      order is made by a counting sort of the points into bins by
+      gradient magnitude. The parameters 'n_bins' and 'max_grad'
+      specify the number of bins and the gradient modulus at the
+      highest bin. The pixels in the list would be in decreasing
+      gradient magnitude, up to a precision of the size of the bins.)
  */
 static image_int ll_angle(image_char in, float threshold,
-                          struct coorlist **list_p, void **mem_p,
+                          struct coorlist **list_p, unsigned int *list_size_p,
                           image_int *modgrad, unsigned int n_bins) {
     image_int g;
-    unsigned int n, p, x, y, adr, i;
-    float com1, com2, gx, gy, norm, norm2;
+    unsigned int n, p, x, y, adr, i, sum;
+    int com1, com2, gx, gy, norm2, norm2_th;
     /* the rest of the variables are used for pseudo-ordering
        the gradient magnitude values */
-    int list_count = 0;
+    unsigned int list_size = 0;
     struct coorlist *list;
-    struct coorlist **range_l_s; /* array of pointers to start of bin list */
-    struct coorlist **range_l_e; /* array of pointers to end of bin list */
-    struct coorlist *start;
-    struct coorlist *end;
-    float max_grad = 0.0;
+    unsigned int *range; /* size of, then next free slot in, each bin */
+    int max_grad = 0;
 
     /* check parameters */
     if (in == NULL || in->data == NULL || in->xsize == 0 || in->ysize == 0) {
@@ -1015,8 +1010,8 @@ static image_int ll_angle(image_char in, float threshold,
     if (list_p == NULL) {
         error("ll_angle: NULL pointer 'list_p'.");
     }
-    if (mem_p == NULL) {
-        error("ll_angle: NULL pointer 'mem_p'.");
+    if (list_size_p == NULL) {
+        error("ll_angle: NULL pointer 'list_size_p'.");
     }
     if (modgrad == NULL) {
         error("ll_angle: NULL pointer 'modgrad'.");
@@ -1032,23 +1027,14 @@ static image_int ll_angle(image_char in, float threshold,
     /* allocate output image */
     g = new_image_int(in->xsize, in->ysize);
 
+    /* the gradients of the defined points of a row, whose angles are computed together */
+    q15_t *row_x = (q15_t *) malloc(p * sizeof(q15_t));
+    q15_t *row_gx = (q15_t *) malloc(p * sizeof(q15_t));
+    q15_t *row_gy = (q15_t *) malloc(p * sizeof(q15_t));
+
     /* get memory for the image of gradient modulus */
     *modgrad = new_image_int(in->xsize, in->ysize);
 
-    /* get memory for "ordered" list of pixels */
-    list = (struct coorlist *) calloc( (size_t) (n * p), sizeof(struct coorlist) );
-    *mem_p = (void *) list;
-    range_l_s = (struct coorlist **) calloc( (size_t) n_bins,
-                                             sizeof(struct coorlist *) );
-    range_l_e = (struct coorlist **) calloc( (size_t) n_bins,
-                                             sizeof(struct coorlist *) );
-    if (list == NULL || range_l_s == NULL || range_l_e == NULL) {
-        error("not enough memory.");
-    }
-    for (i = 0; i < n_bins; i++) {
-        range_l_s[i] = range_l_e[i] = NULL;
-    }
-
     /* 'undefined' on the down and right boundaries */
     for (x = 0; x < p; x++) {
         g->data[(n - 1) * p + x] = NOTDEF;
@@ -1057,9 +1043,15 @@ static image_int ll_angle(image_char in, float threshold,
         g->data[p * y + p - 1] = NOTDEF;
     }
 
+    /* the gradient is integer, so compare its squared norm against the
+       squared threshold and only take the square root of defined points */
+    norm2_th = (int) (4.0 * threshold * threshold);
+
     /* compute gradient on the remaining pixels */
-    for (x = 0; x < p - 1; x++) {
-        for (y = 0; y < n - 1; y++) {
+    for (y = 0; y < n - 1; y++) {
+        unsigned int row_n = 0;
+
+        for (x = 0; x < p - 1; x++) {
             adr = y * p + x;
 
             /*
@@ -1079,71 +1071,89 @@ static image_int ll_angle(image_char in, float threshold,
             gx = com1 + com2; /* gradient x component */
             gy = com1 - com2; /* gradient y component */
             norm2 = gx * gx + gy * gy;
-            norm = sqrt(norm2 / 4.0); /* gradient norm */
 
-            (*modgrad)->data[adr] = norm; /* store gradient norm */
-
-            if (norm <= threshold) {
+            if (norm2 <= norm2_th) {
                 /* norm too small, gradient no defined */
-                g->data[adr] = NOTDEF_INT; //radToDeg(NOTDEF); /* gradient angle not defined */
+                g->data[adr] = NOTDEF_INT; /* gradient angle not defined */
             } else{
-                /* gradient angle computation */
-                g->data[adr] = radToDeg(atan2(gx, -gy));
+                int norm = sqrt(norm2 / 4.0); /* gradient norm */
+
+                (*modgrad)->data[adr] = norm; /* store gradient norm */
+
+                /* the gradient angle is computed below */
+                row_x[row_n] = x;
+                row_gx[row_n] = gx;
+                row_gy[row_n] = -gy;
+                row_n++;
 
                 /* look for the maximum of the gradient */
                 if (norm > max_grad) {
                     max_grad = norm;
                 }
+
+                list_size++;
             }
         }
+
+        /* gradient angle computation, in degrees in [0, 360) */
+        fast_atan2_q15_v(row_gx, row_gy, row_gx, row_n);
+
+        for (i = 0; i < row_n; i++) {
+            g->data[y * p + row_x[i]] = (((uint16_t) row_gx[i]) * 360) >> 16;
+        }
     }
 
-    /* compute histogram of gradient values */
-    for (x = 0; x < p - 1; x++) {
-        for (y = 0; y < n - 1; y++) {
-            norm = (*modgrad)->data[y * p + x];
+    free((void *) row_gy);
+    free((void *) row_gx);
+    free((void *) row_x);
 
-            /* store the point in the right bin according to its norm */
-            i = (unsigned int) (norm * (float) n_bins / max_grad);
-            if (i >= n_bins) {
-                i = n_bins - 1;
-            }
-            if (range_l_e[i] == NULL) {
-                range_l_s[i] = range_l_e[i] = list + list_count++;
-            } else{
-                range_l_e[i]->next = list + list_count;
-                range_l_e[i] = list + list_count++;
+    /* get memory for "ordered" list of pixels */
+    list = (struct coorlist *) malloc(IM_MAX(list_size, 1U) * sizeof(struct coorlist) );
+    range = (unsigned int *) calloc( (size_t) n_bins, sizeof(unsigned int) );
+
+    /* compute histogram of gradient values, the highest bin first */
+    if (list_size) {
+        for (x = 0; x < p - 1; x++) {
+            for (y = 0; y < n - 1; y++) {
+                adr = y * p + x;
+                if (g->data[adr] != NOTDEF_INT) {
+                    i = ( (unsigned int) (*modgrad)->data[adr] * n_bins) / max_grad;
+                    range[n_bins - 1 - IM_MIN(i, n_bins - 1)]++;
+                }
             }
-            range_l_e[i]->x = (int) x;
-            range_l_e[i]->y = (int) y;
-            range_l_e[i]->next = NULL;
         }
     }
 
+    /* turn the bin sizes into the position of the first pixel of each bin */
+    for (i = 0, sum = 0; i < n_bins; i++) {
+        unsigned int size = range[i];
+        range[i] = sum;
+        sum += size;
+    }
+
     /* Make the list of pixels (almost) ordered by norm value.
        It starts by the larger bin, so the list starts by the
        pixels with the highest gradient value. Pixels would be ordered
        by norm value, up to a precision given by max_grad/n_bins.
      */
-    for (i = n_bins - 1; i > 0 && range_l_s[i] == NULL; i--) {
-        ;
-    }
-    start = range_l_s[i];
-    end = range_l_e[i];
-    if (start != NULL) {
-        while (i > 0) {
-            --i;
-            if (range_l_s[i] != NULL) {
-                end->next = range_l_s[i];
-                end = range_l_e[i];
+    if (list_size) {
+        for (x = 0; x < p - 1; x++) {
+            for (y = 0; y < n - 1; y++) {
+                adr = y * p + x;
+                if (g->data[adr] != NOTDEF_INT) {
+                    i = ( (unsigned int) (*modgrad)->data[adr] * n_bins) / max_grad;
+                    struct coorlist *c = list + range[n_bins - 1 - IM_MIN(i, n_bins - 1)]++;
+                    c->x = (int16_t) x;
+                    c->y = (int16_t) y;
+                }
             }
         }
     }
-    *list_p = start;
+    *list_p = list;
+    *list_size_p = list_size;
 
     /* free memory */
-    free( (void *) range_l_s);
-    free( (void *) range_l_e);
+    free( (void *) range);
 
     return g;
 }
@@ -1327,6 +1337,47 @@ static float log_gamma_windschitl(float x) {
  */
 #define log_gamma(x)    ((x) > 15.0?log_gamma_windschitl(x):log_gamma_lanczos(x))
 
+/** Size of the tables used by nfa(), larger values are computed. */
+#define TABSIZE         1024
+
+/** log(Gamma(i)) and 1/i for i < TABSIZE, allocated by nfa_tables_init()
+    for the duration of one LineSegmentDetection() call.
+ */
+static float *log_gamma_tab;
+static float *inv_tab;
+
+/** Fills the nfa() tables. log(Gamma(i)) = log((i-1)!) is a running sum,
+    so this costs one log() per entry instead of a log_gamma() per call.
+ */
+static void nfa_tables_init(void) {
+    int i;
+
+    log_gamma_tab = (float *) malloc(TABSIZE * sizeof(float) );
+    inv_tab = (float *) malloc(TABSIZE * sizeof(float) );
+
+    log_gamma_tab[0] = 0.0; /* not used */
+    log_gamma_tab[1] = 0.0;
+    inv_tab[0] = 0.0;       /* not used */
+    inv_tab[1] = 1.0;
+    for (i = 2; i < TABSIZE; i++) {
+        log_gamma_tab[i] = log_gamma_tab[i - 1] + logf( (float) (i - 1) );
+        inv_tab[i] = 1.0 / (float) i;
+    }
+}
+
+/** Frees the nfa() tables.
+ */
+static void nfa_tables_free(void) {
+    free( (void *) inv_tab);
+    free( (void *) log_gamma_tab);
+}
+
+/** log(Gamma(x)) for a positive integer x.
+ */
+static inline float log_gamma_int(int x) {
+    return (x < TABSIZE) ? log_gamma_tab[x] : log_gamma( (float) x);
+}
+
 /** Computes -log10(NFA).
 
     NFA stands for Number of False Alarms:
@@ -1369,7 +1420,6 @@ static float log_gamma_windschitl(float x) {
     (an error of 10% in the result is accepted).
  */
 static float nfa(int n, int k, float p, float logNT) {
-//  static float inv[TABSIZE];   /* table to keep computed inverse values */
     float tolerance = 0.1;     /* an error of 10% in the result is accepted */
     float log1term, term, bin_term, mult_term, bin_tail, err, p_term;
     int i;
@@ -1398,8 +1448,8 @@ static float nfa(int n, int k, float p, float logNT) {
          bincoef(n,k) = gamma(n+1) / ( gamma(k+1) * gamma(n-k+1) ).
        We use this to compute the first term. Actually the log of it.
      */
-    log1term = log_gamma( (float) n + 1.0) - log_gamma( (float) k + 1.0)
-               - log_gamma( (float) (n - k) + 1.0)
+    log1term = log_gamma_int(n + 1) - log_gamma_int(k + 1)
+               - log_gamma_int(n - k + 1)
                + (float) k * log(p) + (float) (n - k) * log(1.0 - p);
     term = exp(log1term);
 
@@ -1426,14 +1476,11 @@ static float nfa(int n, int k, float p, float logNT) {
              term_i / term_i-1 = (n-i+1)/i * p/(1-p)
            and
              term_i = term_i-1 * (n-i+1)/i * p/(1-p).
-           1/i is stored in a table as they are computed,
+           1/i is stored in a table filled by nfa_tables_init(),
            because divisions are expensive.
            p/(1-p) is computed only once and stored in 'p_term'.
          */
-//      bin_term = (float) (n-i+1) * ( i<TABSIZE ?
-//                   ( inv[i]!=0.0 ? inv[i] : ( inv[i] = 1.0 / (float) i ) ) :
-//                   1.0 / (float) i );
-        bin_term = (float) (n - i + 1) * (1.0 / (float) i);
+        bin_term = (float) (n - i + 1) * ( i < TABSIZE ? inv_tab[i] : 1.0 / (float) i);
 
         mult_term = bin_term * p_term;
         term *= mult_term;
@@ -2467,7 +2514,7 @@ float *LineSegmentDetection(int *n_out,
     image_char used;
     image_int region = NULL;
     struct coorlist *list_p;
-    void *mem_p;
+    unsigned int list_size, list_i;
     struct rect rec;
     struct lsd_point *reg;
     int reg_size, min_reg_size, i;
@@ -2508,7 +2555,7 @@ float *LineSegmentDetection(int *n_out,
 
     /* load and scale image (if necessary) and compute angle at each pixel */
     image = new_image_char_ptr( (unsigned int) X, (unsigned int) Y, img);
-    angles = ll_angle(image, rho, &list_p, &mem_p, &modgrad,
+    angles = ll_angle(image, rho, &list_p, &list_size, &modgrad,
                       (unsigned int) n_bins);
     xsize = angles->xsize;
     ysize = angles->ysize;
@@ -2533,6 +2580,7 @@ float *LineSegmentDetection(int *n_out,
 
 
 //  /* initialize some structures */
+    nfa_tables_init();
     used = new_image_char_ini(xsize, ysize, NOTUSED);
     reg = (struct lsd_point *) calloc( (size_t) (xsize * ysize), sizeof(struct lsd_point) );
     if (reg == NULL) {
@@ -2541,13 +2589,11 @@ float *LineSegmentDetection(int *n_out,
 
 
     /* search for line segments */
-    for (; list_p != NULL; list_p = list_p->next) {
-        if (used->data[ list_p->x + list_p->y * used->xsize ] == NOTUSED &&
-            angles->data[ list_p->x + list_p->y * angles->xsize ] != NOTDEF_INT) {
-            /* there is no risk of float comparison problems here
-               because we are only interested in the exact NOTDEF value */
+    for (list_i = 0; list_i < list_size; list_i++) {
+        /* only points with a defined angle are in the list */
+        if (used->data[ list_p[list_i].x + list_p[list_i].y * used->xsize ] == NOTUSED) {
             /* find the region of connected point and ~equal angle */
-            region_grow(list_p->x, list_p->y, angles, reg, &reg_size,
+            region_grow(list_p[list_i].x, list_p[list_i].y, angles, reg, &reg_size,
                         &reg_angle, used, prec);
 
             /* reject small regions */
@@ -2617,7 +2663,8 @@ float *LineSegmentDetection(int *n_out,
     free_image_int(modgrad);
     free_image_char(used);
     free( (void *) reg);
-    free( (void *) mem_p);
+    free( (void *) list_p);
+    nfa_tables_free();
 
 //  /* return the result */
 //  if( reg_img != NULL && reg_x != NULL && reg_y != NULL )
@@ -2694,7 +2741,7 @@ void imlib_lsd_find_line_segments(list_t *out,
                                   unsigned int max_theta_diff) {
     uint8_t *grayscale_image = fb_alloc(roi->w * roi->h, FB_ALLOC_NO_HINT);
 
-    image_t img;
+    image_t img = {};
     img.w = roi->w;
     img.h = roi->h;
     img.pixfmt = PIXFORMAT_GRAYSCALE;
@@ -2754,6 +2801,7 @@ void imlib_lsd_find_line_segments(list_t *out,
         merge_alot(out, merge_distance, max_theta_diff);
     }
 
+    umm_deinit();
     fb_free(); // umm_init_x();
     fb_free(); // grayscale_image;
 }
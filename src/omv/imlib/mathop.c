@@ -9,8 +9,49 @@
  * Image math operations.
  */
 #include "imlib.h"
+#include "simd.h"
 
 #ifdef IMLIB_ENABLE_MATH_OPS
+typedef v128_t (*imlib_vop_t) (v128_t v0, v128_t v1);
+
+static inline v128_t vqrsub_u8(v128_t v0, v128_t v1) {
+    return vqsub_u8(v1, v0);
+}
+
+// Applies a byte-wise vector op to a grayscale row (row0 = op(row0, row1)).
+static OMV_ATTR_ALWAYS_INLINE void imlib_vop_grayscale(uint8_t *row0, uint8_t *row1, int x, int x_end, imlib_vop_t op) {
+    for (; x < x_end; x += UINT8_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_8(x_end - x);
+        vstr_u8_pred(row0 + x, op(vldr_u8_pred(row0 + x, pred), vldr_u8_pred(row1 + x, pred)), pred);
+    }
+}
+
+// Applies a byte-wise vector op to an RGB565 row (row0 = op(row0, row1)). Each pixel is split
+// into an R/B vector and a G vector with every channel moved to the top of its own byte, so the
+// byte-wise saturating ops clip each channel at its own range.
+static OMV_ATTR_ALWAYS_INLINE void imlib_vop_rgb565(uint16_t *row0, uint16_t *row1, int x, int x_end, imlib_vop_t op) {
+    v128_t r_mask = vdup_u16(0xf800);
+    v128_t b_mask = vdup_u16(0x00f8);
+    v128_t g_mask = vdup_u16(0x00fc);
+
+    for (; x < x_end; x += UINT16_VECTOR_SIZE) {
+        v128_predicate_t pred = vpredicate_16(x_end - x);
+        v128_t p0 = vldr_u16_pred(row0 + x, pred);
+        v128_t p1 = vldr_u16_pred(row1 + x, pred);
+
+        v128_t rb0 = vorr_u32(vand_u32(p0, r_mask), vand_u32(vlsl_u32(p0, 3), b_mask));
+        v128_t rb1 = vorr_u32(vand_u32(p1, r_mask), vand_u32(vlsl_u32(p1, 3), b_mask));
+        v128_t rb = op(rb0, rb1);
+
+        v128_t g0 = vand_u32(vlsr_u32(p0, 3), g_mask);
+        v128_t g1 = vand_u32(vlsr_u32(p1, 3), g_mask);
+        v128_t g = op(g0, g1);
+
+        v128_t p = vorr_u32(vand_u32(rb, r_mask), vlsr_u32(vand_u32(rb, b_mask), 3));
+        vstr_u16_pred(row0 + x, vorr_u32(p, vlsl_u32(vand_u32(g, g_mask), 3)), pred);
+    }
+}
+
 void imlib_add_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data) {
     image_t *mask = (image_t *) data->callback_arg;
 
@@ -24,20 +65,7 @@ void imlib_add_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data)
             uint8_t *row1 = (uint8_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 4; x += 4) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    *((uint32_t *) (row0 + x)) = __UQADD8(p0, p1);
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row1, x);
-                    uint32_t p = __USAT(p0 + p1, 8);
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row0, x, p);
-                }
+                imlib_vop_grayscale(row0, row1, x, x_end, vqadd_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -55,25 +83,7 @@ void imlib_add_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data)
             uint16_t *row1 = (uint16_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 2; x += 2) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    uint32_t r = __USAT16(((p0 >> 11) & 0x1f001f) + ((p1 >> 11) & 0x1f001f), 5);
-                    uint32_t g = __USAT16(((p0 >> 5) & 0x3f003f) + ((p1 >> 5) & 0x3f003f), 6);
-                    uint32_t b = __USAT16((p0 & 0x1f001f) + (p1 & 0x1f001f), 5);
-                    *((uint32_t *) (row0 + x)) = COLOR_R5_G6_B5_TO_RGB565(r, g, b);
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_RGB565_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_RGB565_PIXEL_FAST(row1, x);
-                    uint32_t r = __USAT(COLOR_RGB565_TO_R5(p0) + COLOR_RGB565_TO_R5(p1), 5);
-                    uint32_t g = __USAT(COLOR_RGB565_TO_G6(p0) + COLOR_RGB565_TO_G6(p1), 6);
-                    uint32_t b = __USAT(COLOR_RGB565_TO_B5(p0) + COLOR_RGB565_TO_B5(p1), 5);
-                    IMAGE_PUT_RGB565_PIXEL_FAST(row0, x, COLOR_R5_G6_B5_TO_RGB565(r, g, b));
-                }
+                imlib_vop_rgb565(row0, row1, x, x_end, vqadd_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -142,20 +152,7 @@ void imlib_sub_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data)
             uint8_t *row1 = (uint8_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 4; x += 4) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    *((uint32_t *) (row0 + x)) = __UQSUB8(p0, p1);
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row1, x);
-                    uint32_t p = __USAT((int32_t) (p0 - p1), 8);
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row0, x, p);
-                }
+                imlib_vop_grayscale(row0, row1, x, x_end, vqsub_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -173,25 +170,7 @@ void imlib_sub_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data)
             uint16_t *row1 = (uint16_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 2; x += 2) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    uint32_t r = __USAT16(__SSUB16((p0 >> 11) & 0x1f001f, (p1 >> 11) & 0x1f001f), 5);
-                    uint32_t g = __USAT16(__SSUB16((p0 >> 5) & 0x3f003f, (p1 >> 5) & 0x3f003f), 6);
-                    uint32_t b = __USAT16(__SSUB16(p0 & 0x1f001f, p1 & 0x1f001f), 5);
-                    *((uint32_t *) (row0 + x)) = COLOR_R5_G6_B5_TO_RGB565(r, g, b);
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_RGB565_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_RGB565_PIXEL_FAST(row1, x);
-                    uint32_t r = __USAT((int32_t) (COLOR_RGB565_TO_R5(p0) - COLOR_RGB565_TO_R5(p1)), 5);
-                    uint32_t g = __USAT((int32_t) (COLOR_RGB565_TO_G6(p0) - COLOR_RGB565_TO_G6(p1)), 6);
-                    uint32_t b = __USAT((int32_t) (COLOR_RGB565_TO_B5(p0) - COLOR_RGB565_TO_B5(p1)), 5);
-                    IMAGE_PUT_RGB565_PIXEL_FAST(row0, x, COLOR_R5_G6_B5_TO_RGB565(r, g, b));
-                }
+                imlib_vop_rgb565(row0, row1, x, x_end, vqsub_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -260,20 +239,7 @@ void imlib_rsub_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data
             uint8_t *row1 = (uint8_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 4; x += 4) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    *((uint32_t *) (row0 + x)) = __UQSUB8(p1, p0);
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row1, x);
-                    uint32_t p = __USAT((int32_t) (p1 - p0), 8);
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row0, x, p);
-                }
+                imlib_vop_grayscale(row0, row1, x, x_end, vqrsub_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -291,25 +257,7 @@ void imlib_rsub_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data
             uint16_t *row1 = (uint16_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 2; x += 2) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    uint32_t r = __USAT16(__SSUB16((p1 >> 11) & 0x1f001f, (p0 >> 11) & 0x1f001f), 5);
-                    uint32_t g = __USAT16(__SSUB16((p1 >> 5) & 0x3f003f, (p0 >> 5) & 0x3f003f), 6);
-                    uint32_t b = __USAT16(__SSUB16(p1 & 0x1f001f, p0 & 0x1f001f), 5);
-                    *((uint32_t *) (row0 + x)) = COLOR_R5_G6_B5_TO_RGB565(r, g, b);
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_RGB565_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_RGB565_PIXEL_FAST(row1, x);
-                    uint32_t r = __USAT((int32_t) (COLOR_RGB565_TO_R5(p1) - COLOR_RGB565_TO_R5(p0)), 5);
-                    uint32_t g = __USAT((int32_t) (COLOR_RGB565_TO_G6(p1) - COLOR_RGB565_TO_G6(p0)), 6);
-                    uint32_t b = __USAT((int32_t) (COLOR_RGB565_TO_B5(p1) - COLOR_RGB565_TO_B5(p0)), 5);
-                    IMAGE_PUT_RGB565_PIXEL_FAST(row0, x, COLOR_R5_G6_B5_TO_RGB565(r, g, b));
-                }
+                imlib_vop_rgb565(row0, row1, x, x_end, vqrsub_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -336,27 +284,14 @@ void imlib_min_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data)
     switch (data->dst_img->pixfmt) {
         case PIXFORMAT_BINARY: {
             imlib_b_and_line_op(x, x_end, y_row, data);
+            break;
         }
         case PIXFORMAT_GRAYSCALE: {
             uint8_t *row0 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(data->dst_img, y_row);
             uint8_t *row1 = (uint8_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 4; x += 4) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    __USUB8(p0, p1);
-                    *((uint32_t *) (row0 + x)) = __SEL(p1, p0);
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row1, x);
-                    uint32_t p = IM_MIN(p0, p1);
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row0, x, p);
-                }
+                imlib_vop_grayscale(row0, row1, x, x_end, vmin_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -374,28 +309,7 @@ void imlib_min_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data)
             uint16_t *row1 = (uint16_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 2; x += 2) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    uint32_t p0_rb = p0 & 0xf81ff81f, p1_rb = p1 & 0xf81ff81f;
-                    __USUB8(p0_rb, p1_rb);
-                    uint32_t rb = __SEL(p1_rb, p0_rb);
-                    uint32_t p0_g = p0 & 0x07e007e0, p1_g = p1 & 0x07e007e0;
-                    __USUB16(p0_g, p1_g);
-                    uint32_t g = __SEL(p1_g, p0_g);
-                    *((uint32_t *) (row0 + x)) = rb | g;
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_RGB565_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_RGB565_PIXEL_FAST(row1, x);
-                    uint32_t r = IM_MIN(COLOR_RGB565_TO_R5(p0), COLOR_RGB565_TO_R5(p1));
-                    uint32_t g = IM_MIN(COLOR_RGB565_TO_G6(p0), COLOR_RGB565_TO_G6(p1));
-                    uint32_t b = IM_MIN(COLOR_RGB565_TO_B5(p0), COLOR_RGB565_TO_B5(p1));
-                    IMAGE_PUT_RGB565_PIXEL_FAST(row0, x, COLOR_R5_G6_B5_TO_RGB565(r, g, b));
-                }
+                imlib_vop_rgb565(row0, row1, x, x_end, vmin_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -429,21 +343,7 @@ void imlib_max_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data)
             uint8_t *row1 = (uint8_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 4; x += 4) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    __USUB8(p0, p1);
-                    *((uint32_t *) (row0 + x)) = __SEL(p0, p1);
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row1, x);
-                    uint32_t p = IM_MAX(p0, p1);
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row0, x, p);
-                }
+                imlib_vop_grayscale(row0, row1, x, x_end, vmax_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -461,28 +361,7 @@ void imlib_max_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t *data)
             uint16_t *row1 = (uint16_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 2; x += 2) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    uint32_t p0_rb = p0 & 0xf81ff81f, p1_rb = p1 & 0xf81ff81f;
-                    __USUB8(p0_rb, p1_rb);
-                    uint32_t rb = __SEL(p0_rb, p1_rb);
-                    uint32_t p0_g = p0 & 0x07e007e0, p1_g = p1 & 0x07e007e0;
-                    __USUB16(p0_g, p1_g);
-                    uint32_t g = __SEL(p0_g, p1_g);
-                    *((uint32_t *) (row0 + x)) = rb | g;
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_RGB565_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_RGB565_PIXEL_FAST(row1, x);
-                    uint32_t r = IM_MAX(COLOR_RGB565_TO_R5(p0), COLOR_RGB565_TO_R5(p1));
-                    uint32_t g = IM_MAX(COLOR_RGB565_TO_G6(p0), COLOR_RGB565_TO_G6(p1));
-                    uint32_t b = IM_MAX(COLOR_RGB565_TO_B5(p0), COLOR_RGB565_TO_B5(p1));
-                    IMAGE_PUT_RGB565_PIXEL_FAST(row0, x, COLOR_R5_G6_B5_TO_RGB565(r, g, b));
-                }
+                imlib_vop_rgb565(row0, row1, x, x_end, vmax_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -516,22 +395,7 @@ void imlib_difference_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t
             uint8_t *row1 = (uint8_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 4; x += 4) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    uint32_t sub0 = __USUB8(p0, p1);
-                    uint32_t sub1 = __USUB8(p1, p0);
-                    *((uint32_t *) (row0 + x)) = __SEL(sub1, sub0);
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row1, x);
-                    uint32_t p = __USAD8(p0, p1);
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row0, x, p);
-                }
+                imlib_vop_grayscale(row0, row1, x, x_end, vabd_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -549,30 +413,7 @@ void imlib_difference_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t
             uint16_t *row1 = (uint16_t *) data->dst_row_override;
 
             if (!mask) {
-                #if defined(ARM_MATH_DSP)
-                for (; (x_end - x) >= 2; x += 2) {
-                    uint32_t p0 = *((uint32_t *) (row0 + x));
-                    uint32_t p1 = *((uint32_t *) (row1 + x));
-                    uint32_t p0_rb = p0 & 0xf81ff81f, p1_rb = p1 & 0xf81ff81f;
-                    uint32_t sub0 = __USUB8(p0_rb, p1_rb);
-                    uint32_t sub1 = __USUB8(p1_rb, p0_rb);
-                    uint32_t rb = __SEL(sub1, sub0);
-                    uint32_t p0_g = p0 & 0x07e007e0, p1_g = p1 & 0x07e007e0;
-                    sub0 = __USUB16(p0_g, p1_g);
-                    sub1 = __USUB16(p1_g, p0_g);
-                    uint32_t g = __SEL(sub1, sub0);
-                    *((uint32_t *) (row0 + x)) = rb | g;
-                }
-                #endif
-
-                for (; x < x_end; x++) {
-                    uint32_t p0 = IMAGE_GET_RGB565_PIXEL_FAST(row0, x);
-                    uint32_t p1 = IMAGE_GET_RGB565_PIXEL_FAST(row1, x);
-                    uint32_t r = __USAD8(COLOR_RGB565_TO_R5(p0), COLOR_RGB565_TO_R5(p1));
-                    uint32_t g = __USAD8(COLOR_RGB565_TO_G6(p0), COLOR_RGB565_TO_G6(p1));
-                    uint32_t b = __USAD8(COLOR_RGB565_TO_B5(p0), COLOR_RGB565_TO_B5(p1));
-                    IMAGE_PUT_RGB565_PIXEL_FAST(row0, x, COLOR_R5_G6_B5_TO_RGB565(r, g, b));
-                }
+                imlib_vop_rgb565(row0, row1, x, x_end, vabd_u8);
             } else {
                 for (; x < x_end; x++) {
                     if (image_get_mask_pixel(mask, x, y_row)) {
@@ -592,4 +433,66 @@ void imlib_difference_line_op(int x, int x_end, int y_row, imlib_draw_row_data_t
         }
     }
 }
+
+// Well-exposedness weight of a pixel, highest for mid tones and never zero so that a pixel
+// which is clipped in all exposures is still defined.
+#define HDR_WEIGHT(y)    (129 - abs(((int) (y)) - 128))
+
+// Fuses the exposures of the same scene into img (which is also the first exposure) in one
+// pass. Each output pixel is the average of the exposures weighted by how well exposed they
+// are (exposure fusion), which tone maps the result back to 8-bit without a radiance map.
+void imlib_hdr_fuse(image_t *img, image_t **others, int n_others) {
+    switch (img->pixfmt) {
+        case PIXFORMAT_GRAYSCALE: {
+            for (int y = 0; y < img->h; y++) {
+                uint8_t *rows[IMLIB_HDR_MAX_EXPOSURES];
+                rows[0] = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+                for (int i = 0; i < n_others; i++) {
+                    rows[i + 1] = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(others[i], y);
+                }
+
+                for (int x = 0; x < img->w; x++) {
+                    uint32_t acc = 0, w_sum = 0;
+                    for (int i = 0; i <= n_others; i++) {
+                        uint32_t p = IMAGE_GET_GRAYSCALE_PIXEL_FAST(rows[i], x);
+                        uint32_t w = HDR_WEIGHT(p);
+                        acc += w * p;
+                        w_sum += w;
+                    }
+                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(rows[0], x, (acc + (w_sum / 2)) / w_sum);
+                }
+            }
+            break;
+        }
+        case PIXFORMAT_RGB565: {
+            for (int y = 0; y < img->h; y++) {
+                uint16_t *rows[IMLIB_HDR_MAX_EXPOSURES];
+                rows[0] = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+                for (int i = 0; i < n_others; i++) {
+                    rows[i + 1] = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(others[i], y);
+                }
+
+                for (int x = 0; x < img->w; x++) {
+                    uint32_t r_acc = 0, g_acc = 0, b_acc = 0, w_sum = 0;
+                    for (int i = 0; i <= n_others; i++) {
+                        uint32_t p = IMAGE_GET_RGB565_PIXEL_FAST(rows[i], x);
+                        uint32_t w = HDR_WEIGHT(COLOR_RGB565_TO_Y(p));
+                        r_acc += w * COLOR_RGB565_TO_R5(p);
+                        g_acc += w * COLOR_RGB565_TO_G6(p);
+                        b_acc += w * COLOR_RGB565_TO_B5(p);
+                        w_sum += w;
+                    }
+                    uint32_t r = (r_acc + (w_sum / 2)) / w_sum;
+                    uint32_t g = (g_acc + (w_sum / 2)) / w_sum;
+                    uint32_t b = (b_acc + (w_sum / 2)) / w_sum;
+                    IMAGE_PUT_RGB565_PIXEL_FAST(rows[0], x, COLOR_R5_G6_B5_TO_RGB565(r, g, b));
+                }
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+}
 #endif // IMLIB_ENABLE_MATH_OPS
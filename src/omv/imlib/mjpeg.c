@@ -93,21 +93,36 @@ void mjpeg_open(FIL *fp, int width, int height) {
     file_write(fp, "movi", 4); // FOURCC fcc; - 55
 }
 
-void mjpeg_write(FIL *fp, int width, int height, uint32_t *frames, uint32_t *bytes,
-                 image_t *img, int quality, rectangle_t *roi, int rgb_channel, int alpha,
-                 const uint16_t *color_palette, const uint8_t *alpha_palette, image_hint_t hint) {
+bool mjpeg_preallocate(FIL *fp, uint32_t size) {
+    // Preallocating the clusters up front avoids FAT updates and cluster allocations while
+    // recording, which are what cause most of the long SD card write stalls.
+    #if FF_USE_EXPAND
+    // Try to get contiguous clusters first (the file must be empty).
+    if (f_expand(fp, size, 1) == FR_OK) {
+        return true;
+    }
+    #endif
+    // Seeking past the end of a file opened for writing allocates the cluster chain.
+    if ((f_lseek(fp, size) != FR_OK) || (f_tell(fp) != size)) {
+        f_lseek(fp, 0);
+        return false;
+    }
+    return f_lseek(fp, 0) == FR_OK;
+}
+
+void mjpeg_encode(image_t *dst_img, int width, int height, image_t *img, int quality, rectangle_t *roi,
+                  int rgb_channel, int alpha, const uint16_t *color_palette, const uint8_t *alpha_palette,
+                  image_hint_t hint) {
     float xscale = width / ((float) roi->w);
     float yscale = height / ((float) roi->h);
     // MAX == KeepAspectRatioByExpanding - MIN == KeepAspectRatio
     float scale = IM_MIN(xscale, yscale);
 
-    image_t dst_img = {
-        .w = width,
-        .h = height,
-        .pixfmt = PIXFORMAT_JPEG,
-        .size = 0,
-        .data = NULL
-    };
+    dst_img->w = width;
+    dst_img->h = height;
+    dst_img->pixfmt = PIXFORMAT_JPEG;
+    dst_img->size = 0;
+    dst_img->data = NULL;
 
     bool simple = (xscale == 1) &&
                   (yscale == 1) &&
@@ -120,15 +135,13 @@ void mjpeg_write(FIL *fp, int width, int height, uint32_t *frames, uint32_t *byt
                   (color_palette == NULL) &&
                   (alpha_palette == NULL);
 
-    fb_alloc_mark();
-
-    if ((dst_img.pixfmt != img->pixfmt) || (!simple)) {
-        image_t temp;
+    if ((dst_img->pixfmt != img->pixfmt) || (!simple)) {
+        image_t temp = {};
         memcpy(&temp, img, sizeof(image_t));
 
         if (img->is_compressed || (!simple)) {
-            temp.w = dst_img.w;
-            temp.h = dst_img.h;
+            temp.w = dst_img->w;
+            temp.h = dst_img->h;
             temp.pixfmt = PIXFORMAT_RGB565; // TODO PIXFORMAT_ARGB8888
             temp.size = 0;
             temp.data = fb_alloc(image_size(&temp), FB_ALLOC_NO_HINT);
@@ -181,11 +194,22 @@ void mjpeg_write(FIL *fp, int width, int height, uint32_t *frames, uint32_t *byt
         // When jpeg_compress needs more memory than in currently allocated it
         // will try to realloc. MP will detect that the pointer is outside of
         // the heap and return NULL which will cause an out of memory error.
-        jpeg_compress(&temp, &dst_img, quality, true, JPEG_SUBSAMPLING_AUTO);
+        jpeg_compress(&temp, dst_img, quality, true, JPEG_SUBSAMPLING_AUTO);
     } else {
-        dst_img.size = img->size;
-        dst_img.data = img->data;
+        dst_img->size = img->size;
+        dst_img->data = img->data;
     }
+}
+
+void mjpeg_write(FIL *fp, int width, int height, uint32_t *frames, uint32_t *bytes,
+                 image_t *img, int quality, rectangle_t *roi, int rgb_channel, int alpha,
+                 const uint16_t *color_palette, const uint8_t *alpha_palette, image_hint_t hint) {
+    image_t dst_img = {};
+
+    fb_alloc_mark();
+
+    mjpeg_encode(&dst_img, width, height, img, quality, roi, rgb_channel, alpha,
+                 color_palette, alpha_palette, hint);
 
     uint32_t size_padded = (((dst_img.size + 3) / 4) * 4);
     file_write(fp, "00dc", 4); // FOURCC fcc;
@@ -237,6 +261,8 @@ void mjpeg_sync(FIL *fp, uint32_t frames, uint32_t bytes, uint32_t us_avg) {
 
 void mjpeg_close(FIL *fp, uint32_t frames, uint32_t bytes, uint32_t us_avg) {
     mjpeg_sync(fp, frames, bytes, us_avg);
+    // Drop any preallocated space past the end of the stream.
+    file_truncate(fp);
     file_close(fp);
 }
 
@@ -0,0 +1,174 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Background subtraction motion detector.
+ *
+ * The background is modeled per cell of (1 << shift) x (1 << shift) pixels by a running mean
+ * and a running mean absolute deviation, both in 8.8 fixed-point. A cell is moving when its
+ * average differs from the mean by more than the threshold and by more than 3 deviations.
+ * Rows are consumed in order as they arrive, so the model and the mask are updated in one
+ * streaming pass, either over a frame or from the capture line callback.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "imlib.h"
+
+// Number of deviations from the background mean for a cell to be moving.
+#define MOTION_DEV_K        (3)
+// Moving cells are learned this many times slower (as a shift) so objects fade in slowly.
+#define MOTION_FG_SHIFT     (3)
+
+size_t imlib_motion_init(imlib_motion_t *m, int w, int h, pixformat_t pixfmt, int shift, int rate, int threshold) {
+    m->w = w;
+    m->h = h;
+    m->pixfmt = pixfmt;
+    m->shift = shift;
+    m->mw = w >> shift;
+    m->mh = h >> shift;
+    m->rate = rate;
+    m->threshold = threshold;
+    m->initialized = false;
+    m->ready = false;
+
+    image_init(&m->mask, m->mw, m->mh, PIXFORMAT_BINARY, 0, NULL);
+    image_init(&m->back, m->mw, m->mh, PIXFORMAT_BINARY, 0, NULL);
+
+    return (m->mw * sizeof(uint16_t)) + (m->mw * m->mh * sizeof(uint16_t) * 2) + (image_size(&m->mask) * 2);
+}
+
+void imlib_motion_set_buffer(imlib_motion_t *m, uint8_t *buffer) {
+    m->acc = (uint16_t *) buffer;
+    m->mean = m->acc + m->mw;
+    m->dev = m->mean + (m->mw * m->mh);
+    m->mask.data = (uint8_t *) (m->dev + (m->mw * m->mh));
+    m->back.data = m->mask.data + image_size(&m->mask);
+    imlib_motion_reset(m);
+}
+
+void imlib_motion_reset(imlib_motion_t *m) {
+    m->initialized = false;
+    m->ready = false;
+    memset(m->acc, 0, m->mw * sizeof(uint16_t));
+    memset(m->mask.data, 0, image_size(&m->mask));
+}
+
+// Updates the model and the mask for one row of cells from the accumulated sums.
+static void imlib_motion_update_cells(imlib_motion_t *m, int cy) {
+    uint16_t *mean = m->mean + (cy * m->mw);
+    uint16_t *dev = m->dev + (cy * m->mw);
+    uint32_t *mask = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&m->back, cy);
+    int area_shift = m->shift * 2;
+
+    for (int x = 0; x < m->mw; x++) {
+        int p = (m->acc[x] >> area_shift) << 8;
+        m->acc[x] = 0;
+
+        if (!m->initialized) {
+            mean[x] = p;
+            dev[x] = 0;
+            IMAGE_CLEAR_BINARY_PIXEL_FAST(mask, x);
+            continue;
+        }
+
+        int diff = p - mean[x];
+        int abs_diff = abs(diff);
+        bool moving = (abs_diff > (m->threshold << 8)) && (abs_diff > (dev[x] * MOTION_DEV_K));
+        int rate = moving ? (m->rate >> MOTION_FG_SHIFT) : m->rate;
+
+        mean[x] += (diff * rate) >> 8;
+        dev[x] += ((abs_diff - dev[x]) * rate) >> 8;
+        IMAGE_PUT_BINARY_PIXEL_FAST(mask, x, moving);
+    }
+}
+
+void imlib_motion_update_rows(imlib_motion_t *m, uint8_t *data, int y, int lines) {
+    int cell_mask = (1 << m->shift) - 1;
+    int w = m->mw << m->shift;
+
+    // A new frame starts, drop any partial cell row.
+    if (y == 0) {
+        memset(m->acc, 0, m->mw * sizeof(uint16_t));
+    }
+
+    for (int y_end = IM_MIN(y + lines, m->mh << m->shift); y < y_end; y++) {
+        switch (m->pixfmt) {
+            case PIXFORMAT_GRAYSCALE: {
+                uint8_t *row_ptr = data;
+                for (int x = 0; x < w; x++) {
+                    m->acc[x >> m->shift] += IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                }
+                data += m->w;
+                break;
+            }
+            case PIXFORMAT_RGB565: {
+                uint16_t *row_ptr = (uint16_t *) data;
+                for (int x = 0; x < w; x++) {
+                    m->acc[x >> m->shift] += COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                }
+                data += m->w * sizeof(uint16_t);
+                break;
+            }
+            default: {
+                return;
+            }
+        }
+
+        if ((y & cell_mask) == cell_mask) {
+            int cy = y >> m->shift;
+            imlib_motion_update_cells(m, cy);
+
+            // Publish the mask once the last row of cells is done.
+            if (cy == (m->mh - 1)) {
+                uint8_t *mask = m->mask.data;
+                m->mask.data = m->back.data;
+                m->back.data = mask;
+                m->initialized = true;
+                m->ready = true;
+            }
+        }
+    }
+}
+
+void imlib_motion_update(imlib_motion_t *m, image_t *img) {
+    imlib_motion_update_rows(m, img->data, 0, img->h);
+}
+
+void imlib_motion_line_cb(uint8_t *data, uint32_t line, uint32_t lines, void *arg) {
+    imlib_motion_update_rows((imlib_motion_t *) arg, data, line, lines);
+}
+
+void imlib_motion_find_blobs(imlib_motion_t *m, list_t *out, unsigned int area_threshold,
+                             unsigned int pixels_threshold, bool merge, int margin) {
+    list_t thresholds;
+    list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
+    color_thresholds_list_lnk_data_t lnk_data = { .LMin = 1, .LMax = 1 };
+    list_push_back(&thresholds, &lnk_data);
+
+    rectangle_t roi = { 0, 0, m->mw, m->mh };
+    imlib_find_blobs(out, &m->mask, &roi, 1, 1, &thresholds, false, area_threshold, pixels_threshold,
+                     merge, margin, NULL, NULL, NULL, NULL, 0, 0);
+    list_free(&thresholds);
+
+    // Scale the blobs from cells back to pixels.
+    int cell = 1 << m->shift;
+    list_for_each(it, out) {
+        find_blobs_list_lnk_data_t *blob = list_get_data(it);
+        blob->rect.x *= cell;
+        blob->rect.y *= cell;
+        blob->rect.w *= cell;
+        blob->rect.h *= cell;
+        blob->centroid_x = (blob->centroid_x + 0.5f) * cell;
+        blob->centroid_y = (blob->centroid_y + 0.5f) * cell;
+        blob->pixels *= cell * cell;
+        blob->perimeter *= cell;
+        for (int i = 0; i < FIND_BLOBS_CORNERS_RESOLUTION; i++) {
+            blob->corners[i].x *= cell;
+            blob->corners[i].y *= cell;
+        }
+    }
+}
@@ -0,0 +1,258 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Pyramidal Lucas-Kanade sparse optical flow.
+ *
+ * Points are tracked from the coarsest pyramid level to the finest, the displacement found
+ * on each level is the initial guess of the next one. Windows are sampled with fixed-point
+ * bilinear interpolation and the spatial gradients of the previous frame are computed once
+ * per level, so each iteration only samples the current frame.
+ */
+#include "imlib.h"
+
+#ifdef IMLIB_ENABLE_FIND_DISPLACEMENT
+#define OPTFLOW_W_BITS      (8)     // Fractional bits of the bilinear weights.
+#define OPTFLOW_P_BITS      (5)     // Fractional bits of the interpolated pixels.
+#define OPTFLOW_MIN_EIGEN   (4.0f)  // Minimum eigenvalue (per pixel) of the gradient matrix.
+#define OPTFLOW_EPSILON     (0.01f) // Iterations stop once the update is below this (in pixels).
+
+size_t imlib_optflow_init(imlib_optflow_t *of, int w, int h, int levels, int radius, int iterations) {
+    size_t size = 0;
+
+    of->w = w;
+    of->h = h;
+    of->radius = radius;
+    of->iterations = iterations;
+    of->n_levels = 0;
+    of->initialized = false;
+
+    for (int i = 0, lw = w, lh = h; i < IM_MIN(levels, IMLIB_OPTFLOW_MAX_LEVELS); i++, lw /= 2, lh /= 2) {
+        if (i && ((lw < IMLIB_OPTFLOW_MIN_SIZE) || (lh < IMLIB_OPTFLOW_MIN_SIZE))) {
+            break;
+        }
+
+        for (int j = 0; j < 2; j++) {
+            image_t *level = j ? &of->curr[i] : &of->prev[i];
+            level->w = lw;
+            level->h = lh;
+            level->pixfmt = PIXFORMAT_GRAYSCALE;
+            level->size = 0;
+            level->data = NULL;
+            size += image_size(level);
+        }
+
+        of->n_levels += 1;
+    }
+
+    return size;
+}
+
+void imlib_optflow_set_buffer(imlib_optflow_t *of, uint8_t *buffer) {
+    for (int i = 0; i < of->n_levels; i++) {
+        of->prev[i].data = buffer;
+        buffer += image_size(&of->prev[i]);
+        of->curr[i].data = buffer;
+        buffer += image_size(&of->curr[i]);
+    }
+
+    imlib_optflow_reset(of);
+}
+
+void imlib_optflow_reset(imlib_optflow_t *of) {
+    of->initialized = false;
+}
+
+static void optflow_build(imlib_optflow_t *of, image_t *img) {
+    // The first level is a grayscale copy, the frame buffer is reused by the next frame.
+    imlib_draw_image(&of->curr[0], img, 0, 0, 1.0f, 1.0f, NULL, -1, 256, NULL, NULL, 0, NULL, NULL, NULL);
+
+    for (int i = 1; i < of->n_levels; i++) {
+        image_t *src = &of->curr[i - 1];
+        image_t *dst = &of->curr[i];
+
+        for (int y = 0; y < dst->h; y++) {
+            uint8_t *row_ptr_0 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, (y * 2));
+            uint8_t *row_ptr_1 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, (y * 2) + 1);
+            uint8_t *dst_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(dst, y);
+
+            for (int x = 0; x < dst->w; x++) {
+                int sum = row_ptr_0[x * 2] + row_ptr_0[(x * 2) + 1] + row_ptr_1[x * 2] + row_ptr_1[(x * 2) + 1];
+                dst_row_ptr[x] = (sum + 2) >> 2;
+            }
+        }
+    }
+}
+
+// Samples the (2 * r + 1) pixels square window centered on (x, y) with bilinear interpolation.
+// The window is clamped to the image, samples have OPTFLOW_P_BITS fractional bits.
+static void optflow_window(image_t *img, float x, float y, int r, int16_t *window) {
+    const int shift = (OPTFLOW_W_BITS * 2) - OPTFLOW_P_BITS;
+    int ix = fast_floorf(x), iy = fast_floorf(y);
+    int fx = fast_roundf((x - ix) * (1 << OPTFLOW_W_BITS));
+    int fy = fast_roundf((y - iy) * (1 << OPTFLOW_W_BITS));
+    // All samples share the same sub-pixel offset, so the weights are computed once.
+    int w00 = ((1 << OPTFLOW_W_BITS) - fx) * ((1 << OPTFLOW_W_BITS) - fy);
+    int w01 = fx * ((1 << OPTFLOW_W_BITS) - fy);
+    int w10 = ((1 << OPTFLOW_W_BITS) - fx) * fy;
+    int w11 = fx * fy;
+    bool inside = ((ix - r) >= 0) && ((iy - r) >= 0) && ((ix + r + 1) < img->w) && ((iy + r + 1) < img->h);
+
+    for (int j = -r; j <= r; j++) {
+        int y0 = iy + j, y1 = y0 + 1;
+
+        if (!inside) {
+            y0 = IM_CLAMP(y0, 0, img->h - 1);
+            y1 = IM_CLAMP(y1, 0, img->h - 1);
+        }
+
+        uint8_t *row_ptr_0 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y0);
+        uint8_t *row_ptr_1 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y1);
+
+        if (inside) {
+            for (int i = ix - r, ii = ix + r; i <= ii; i++) {
+                int p = (row_ptr_0[i] * w00) + (row_ptr_0[i + 1] * w01) + (row_ptr_1[i] * w10) + (row_ptr_1[i + 1] * w11);
+                *window++ = (p + (1 << (shift - 1))) >> shift;
+            }
+        } else {
+            for (int i = ix - r, ii = ix + r; i <= ii; i++) {
+                int x0 = IM_CLAMP(i, 0, img->w - 1), x1 = IM_CLAMP(i + 1, 0, img->w - 1);
+                int p = (row_ptr_0[x0] * w00) + (row_ptr_0[x1] * w01) + (row_ptr_1[x0] * w10) + (row_ptr_1[x1] * w11);
+                *window++ = (p + (1 << (shift - 1))) >> shift;
+            }
+        }
+    }
+}
+
+static void optflow_track(imlib_optflow_t *of, imlib_optflow_point_t *pt, int16_t *buf) {
+    int r = of->radius, n = ((r * 2) + 1) * ((r * 2) + 1), stride = (r * 2) + 3;
+    int16_t *border = buf;      // Previous frame window with a 1 pixel border for the gradients.
+    int16_t *tmpl = border + (stride * stride);
+    int16_t *grad_x = tmpl + n;
+    int16_t *grad_y = grad_x + n;
+    int16_t *curr = grad_y + n;
+    float gx = 0.0f, gy = 0.0f;
+
+    pt->found = true;
+
+    for (int l = of->n_levels - 1; l >= 0; l--) {
+        image_t *prev_img = &of->prev[l];
+        image_t *curr_img = &of->curr[l];
+        float px = pt->x / (1 << l);
+        float py = pt->y / (1 << l);
+        float vx = 0.0f, vy = 0.0f;
+
+        // Central differences are 2x the gradient, the gradient matrix is scaled by 4 << (P_BITS * 2).
+        optflow_window(prev_img, px, py, r + 1, border);
+        long long a = 0, b = 0, c = 0;
+
+        for (int j = 0, k = 0; j < ((r * 2) + 1); j++) {
+            int16_t *p = border + ((j + 1) * stride) + 1;
+            for (int i = 0; i < ((r * 2) + 1); i++, k++, p++) {
+                int dx = p[1] - p[-1];
+                int dy = p[stride] - p[-stride];
+                tmpl[k] = p[0];
+                grad_x[k] = dx;
+                grad_y[k] = dy;
+                a += dx * dx;
+                b += dx * dy;
+                c += dy * dy;
+            }
+        }
+
+        float fa = a, fb = b, fc = c;
+        float det = (fa * fc) - (fb * fb);
+        float min_eigen = (fa + fc - fast_sqrtf(((fa - fc) * (fa - fc)) + (4.0f * fb * fb))) / 2.0f;
+        bool textured = (det > 0.0f) &&
+                        ((min_eigen / (n * (4 << (OPTFLOW_P_BITS * 2)))) >= OPTFLOW_MIN_EIGEN);
+
+        // Flat windows are skipped on the coarse levels, there may be texture on the finer ones.
+        if (!textured) {
+            if (!l) {
+                pt->found = false;
+            }
+        } else {
+            // The update is scaled by 2 because the gradients are.
+            float inv_det = 2.0f / det;
+
+            for (int k = 0; k < of->iterations; k++) {
+                float qx = px + gx + vx, qy = py + gy + vy;
+
+                if ((qx < 0.0f) || (qy < 0.0f) || (qx > (curr_img->w - 1)) || (qy > (curr_img->h - 1))) {
+                    pt->found = false;
+                    break;
+                }
+
+                optflow_window(curr_img, qx, qy, r, curr);
+                long long bx = 0, by = 0;
+
+                for (int i = 0; i < n; i++) {
+                    int diff = tmpl[i] - curr[i];
+                    bx += diff * grad_x[i];
+                    by += diff * grad_y[i];
+                }
+
+                float ex = ((fc * bx) - (fb * by)) * inv_det;
+                float ey = ((fa * by) - (fb * bx)) * inv_det;
+                vx += ex;
+                vy += ey;
+
+                if (((ex * ex) + (ey * ey)) < (OPTFLOW_EPSILON * OPTFLOW_EPSILON)) {
+                    break;
+                }
+            }
+        }
+
+        if (!pt->found) {
+            break;
+        }
+
+        gx += vx;
+        gy += vy;
+
+        if (l) {
+            gx *= 2.0f;
+            gy *= 2.0f;
+        }
+    }
+
+    pt->dx = gx;
+    pt->dy = gy;
+
+    if (pt->found) {
+        float x = pt->x + gx, y = pt->y + gy;
+        pt->found = (x >= 0.0f) && (y >= 0.0f) && (x <= (of->w - 1)) && (y <= (of->h - 1));
+    }
+}
+
+bool imlib_optflow_update(imlib_optflow_t *of, image_t *img, imlib_optflow_point_t *points, size_t n) {
+    bool valid = of->initialized;
+
+    optflow_build(of, img);
+
+    if (valid) {
+        int r = of->radius, stride = (r * 2) + 3, window = ((r * 2) + 1) * ((r * 2) + 1);
+        int16_t *buf = fb_alloc(((stride * stride) + (window * 4)) * sizeof(int16_t), FB_ALLOC_NO_HINT);
+
+        for (size_t i = 0; i < n; i++) {
+            optflow_track(of, &points[i], buf);
+        }
+
+        fb_free(); // buf
+    }
+
+    // The current frame is the previous frame of the next update.
+    for (int i = 0; i < of->n_levels; i++) {
+        image_t tmp = of->prev[i];
+        of->prev[i] = of->curr[i];
+        of->curr[i] = tmp;
+    }
+
+    of->initialized = true;
+    return valid;
+}
+#endif // IMLIB_ENABLE_FIND_DISPLACEMENT
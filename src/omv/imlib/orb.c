@@ -377,10 +377,18 @@ static void image_scale(image_t *src, image_t *dst) {
 }
 
 array_t *orb_find_keypoints(image_t *img, bool normalized, int threshold,
-                            float scale_factor, int max_keypoints, corner_detector_t corner_detector, rectangle_t *roi) {
+                            float scale_factor, int max_keypoints, corner_detector_t corner_detector, rectangle_t *roi,
+                            imlib_pyramid_t *pyramid) {
     array_t *kpts;
     array_alloc(&kpts, xfree);
 
+    // The octaves must match the pyramid levels to reuse them.
+    if (pyramid && pyramid->built) {
+        scale_factor = pyramid->scale;
+    } else {
+        pyramid = NULL;
+    }
+
     int octave = 1;
     int kpts_index = 0;
     rectangle_t roi_scaled;
@@ -404,12 +412,19 @@ array_t *orb_find_keypoints(image_t *img, bool normalized, int threshold,
             break;
         }
 
-        img_scaled.pixels = fb_alloc(img_scaled.w * img_scaled.h, FB_ALLOC_NO_HINT);
-        // Down scale image
-        image_scale(img, &img_scaled);
+        // Octave 1 is the full size image, the rest are the pyramid levels (already smoothed).
+        bool cached = pyramid && ((octave - 2) < pyramid->n_levels) && (octave > 1);
+
+        if (cached) {
+            img_scaled.pixels = pyramid->levels[octave - 2].pixels;
+        } else {
+            img_scaled.pixels = fb_alloc(img_scaled.w * img_scaled.h, FB_ALLOC_NO_HINT);
+            // Down scale image
+            image_scale(img, &img_scaled);
 
-        // Gaussian smooth the image before extracting keypoints
-        imlib_sepconv3(&img_scaled, kernel_gauss_3, 1.0f / 16.0f, 0.0f);
+            // Gaussian smooth the image before extracting keypoints
+            imlib_sepconv3(&img_scaled, kernel_gauss_3, 1.0f / 16.0f, 0.0f);
+        }
 
         // Find kpts
         #ifdef IMLIB_ENABLE_FAST
@@ -499,7 +514,9 @@ array_t *orb_find_keypoints(image_t *img, bool normalized, int threshold,
         }
 
         // Free current scale
-        fb_free();
+        if (!cached) {
+            fb_free();
+        }
 
         if (normalized) {
             break;
@@ -515,50 +532,176 @@ array_t *orb_find_keypoints(image_t *img, bool normalized, int threshold,
     return kpts;
 }
 
-// This is a modified popcount that counts every 2 different bits as 1.
-// This is what should actually be used with wta_k == 3 or 4.
-static inline uint32_t popcount(uint32_t i) {
-    i = i - ((i >> 1) & 0x55555555);
-    i = ((i & 0xAAAAAAAA) >> 1) | (i & 0x55555555);
-    i = (i & 0x33333333) + ((i >> 2) & 0x33333333);
-    return (((i + (i >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+// The distance is a modified popcount that counts every 2 different bits as 1.
+// This is what should actually be used with wta_k == 3 or 4. The nibble and byte
+// sums of all descriptor words are accumulated before the final horizontal add.
+static inline uint32_t kp_dist(const kp_t *kp1, const kp_t *kp2) {
+    const uint32_t *d1 = (const uint32_t *) kp1->desc;
+    const uint32_t *d2 = (const uint32_t *) kp2->desc;
+    uint32_t acc = 0;
+
+    for (int m = 0; m < (KDESC_SIZE / 4); m += 4) {
+        uint32_t nibbles = 0;
+        for (int k = m; k < (m + 4); k++) {
+            uint32_t i = d1[k] ^ d2[k];
+            i = (i | (i >> 1)) & 0x55555555;
+            // Each nibble holds at most 2, so 4 words fit in a nibble.
+            nibbles += (i & 0x33333333) + ((i >> 2) & 0x33333333);
+        }
+        acc += (nibbles & 0x0F0F0F0F) + ((nibbles >> 4) & 0x0F0F0F0F);
+    }
+
+    return (acc * 0x01010101) >> 24;
+}
+
+// Multi-probe LSH (Lv et al. "Multi-Probe LSH: Efficient Indexing for High-Dimensional
+// Similarity Search"). Each table hashes a keypoint by ORB_LSH_GROUPS of the 128 2-bit
+// descriptor groups. A query probes its own bucket and every bucket one group away, so
+// near neighbors that differ in one hashed group are still found.
+#define ORB_LSH_TABLES      (4)
+#define ORB_LSH_GROUPS      (5)
+#define ORB_LSH_BUCKETS     (1 << (ORB_LSH_GROUPS * 2))
+#define ORB_INDEX_MIN_KPTS  (128) // Brute force is faster below this.
+
+// Hashed groups, 37 is coprime with the 128 groups so none repeats.
+#define ORB_LSH_GROUP(t, k) (((((t) * ORB_LSH_GROUPS) + (k)) * 37) % (KDESC_SIZE * 4))
+
+static inline uint32_t orb_lsh_key(const kp_t *kp, int t) {
+    uint32_t key = 0;
+    for (int k = 0; k < ORB_LSH_GROUPS; k++) {
+        int g = ORB_LSH_GROUP(t, k);
+        key |= ((kp->desc[g >> 2] >> ((g & 3) * 2)) & 3) << (k * 2);
+    }
+    return key;
+}
+
+size_t orb_index_size(array_t *kpts) {
+    int n = array_length(kpts);
+    if ((n < ORB_INDEX_MIN_KPTS) || (n > UINT16_MAX)) {
+        return 0;
+    }
+    return (n + (ORB_LSH_TABLES * (ORB_LSH_BUCKETS + 1)) + (ORB_LSH_TABLES * n)) * sizeof(uint16_t);
+}
+
+void orb_index_build(orb_index_t *index, array_t *kpts, uint8_t *buffer) {
+    int n = array_length(kpts);
+    index->n = n;
+    index->stamp = 0;
+    index->stamps = (uint16_t *) buffer;
+    index->offsets = index->stamps + n;
+    index->indices = index->offsets + (ORB_LSH_TABLES * (ORB_LSH_BUCKETS + 1));
+    memset(index->stamps, 0, n * sizeof(uint16_t));
+
+    // Counting sort the keypoints into the buckets of each table.
+    for (int t = 0; t < ORB_LSH_TABLES; t++) {
+        uint16_t *offsets = index->offsets + (t * (ORB_LSH_BUCKETS + 1));
+        uint16_t *indices = index->indices + (t * n);
+        memset(offsets, 0, (ORB_LSH_BUCKETS + 1) * sizeof(uint16_t));
+
+        for (int i = 0; i < n; i++) {
+            offsets[orb_lsh_key(array_at(kpts, i), t) + 1]++;
+        }
+
+        for (int b = 0; b < ORB_LSH_BUCKETS; b++) {
+            offsets[b + 1] += offsets[b];
+        }
+
+        for (int i = 0; i < n; i++) {
+            indices[offsets[orb_lsh_key(array_at(kpts, i), t)]++] = i;
+        }
+
+        // The fill above advanced each offset to the next bucket's start.
+        for (int b = ORB_LSH_BUCKETS; b > 0; b--) {
+            offsets[b] = offsets[b - 1];
+        }
+        offsets[0] = 0;
+    }
+}
+
+static inline void update_best_match(kp_t *kp1, kp_t *kp2, int i, kp_t **min_kp,
+                                     int *min_dist1, int *min_dist2, int *index) {
+    if (kp2->matched == 0) {
+        int dist = kp_dist(kp1, kp2);
+        if (dist < *min_dist1) {
+            *index = i;
+            *min_kp = kp2;
+            *min_dist2 = *min_dist1;
+            *min_dist1 = dist;
+        }
+    }
 }
 
-static kp_t *find_best_match(kp_t *kp1, array_t *kpts, int *dist_out1, int *dist_out2, int *index) {
+static kp_t *find_best_match(kp_t *kp1, array_t *kpts, orb_index_t *kpts_index,
+                             int *dist_out1, int *dist_out2, int *index) {
     kp_t *min_kp = NULL;
     int min_dist1 = MAX_KP_DIST;
     int min_dist2 = MAX_KP_DIST;
     int kpts_size = array_length(kpts);
+    int candidates = 0;
 
-    for (int i = 0; i < kpts_size; i++) {
-        int dist = 0;
-        kp_t *kp2 = array_at(kpts, i);
+    if (kpts_index) {
+        if (++kpts_index->stamp == 0) {
+            memset(kpts_index->stamps, 0, kpts_index->n * sizeof(uint16_t));
+            kpts_index->stamp = 1;
+        }
 
-        if (kp2->matched == 0) {
-            for (int m = 0; m < (KDESC_SIZE / 4); m++) {
-                dist += popcount(((uint32_t *) (kp1->desc))[m] ^ ((uint32_t *) (kp2->desc))[m]);
-            }
+        for (int t = 0; t < ORB_LSH_TABLES; t++) {
+            uint16_t *offsets = kpts_index->offsets + (t * (ORB_LSH_BUCKETS + 1));
+            uint16_t *indices = kpts_index->indices + (t * kpts_index->n);
+            uint32_t key = orb_lsh_key(kp1, t);
 
-            if (dist < min_dist1) {
-                *index = i;
-                min_kp = kp2;
-                min_dist2 = min_dist1;
-                min_dist1 = dist;
+            // Probe the key and the keys differing in one group.
+            for (int probe = 0; probe < ((ORB_LSH_GROUPS * 3) + 1); probe++) {
+                uint32_t probe_key = key;
+                if (probe) {
+                    probe_key ^= (((probe - 1) % 3) + 1) << (((probe - 1) / 3) * 2);
+                }
+
+                for (int j = offsets[probe_key], jj = offsets[probe_key + 1]; j < jj; j++) {
+                    int i = indices[j];
+                    if (kpts_index->stamps[i] != kpts_index->stamp) {
+                        kpts_index->stamps[i] = kpts_index->stamp;
+                        update_best_match(kp1, array_at(kpts, i), i, &min_kp, &min_dist1, &min_dist2, index);
+                        candidates++;
+                    }
+                }
             }
         }
     }
 
+    // The ratio test needs two neighbors, fall back to a full scan if the probes found fewer.
+    if (candidates < 2) {
+        min_kp = NULL;
+        min_dist1 = MAX_KP_DIST;
+        min_dist2 = MAX_KP_DIST;
+        for (int i = 0; i < kpts_size; i++) {
+            update_best_match(kp1, array_at(kpts, i), i, &min_kp, &min_dist1, &min_dist2, index);
+        }
+    }
+
     *dist_out1 = min_dist1;
     *dist_out2 = min_dist2;
     return min_kp;
 }
 
-int orb_match_keypoints(array_t *kpts1, array_t *kpts2, int *match, int threshold, rectangle_t *r, point_t *c, int *angle) {
+int orb_match_keypoints(array_t *kpts1, orb_index_t *index1, array_t *kpts2, orb_index_t *index2,
+                        int *match, int threshold, rectangle_t *r, point_t *c, int *angle) {
     int matches = 0;
     int cx = 0, cy = 0;
     uint16_t angles[360] = {0};
     int kpts1_size = array_length(kpts1);
 
+    // Callers pass the persistent index of a set (e.g. a loaded descriptor) if it has one,
+    // otherwise the second set is indexed for this match only if it's large enough.
+    orb_index_t index2_data;
+    bool index2_temp = false;
+    size_t index2_size = index2 ? 0 : orb_index_size(kpts2);
+    if (index2_size && (fb_avail() >= index2_size)) {
+        index2 = &index2_data;
+        index2_temp = true;
+        orb_index_build(index2, kpts2, fb_alloc(index2_size, FB_ALLOC_NO_HINT));
+    }
+
     r->w = r->h = 0;
     r->x = r->y = 20000;
 
@@ -574,14 +717,14 @@ int orb_match_keypoints(array_t *kpts1, array_t *kpts2, int *match, int threshol
         kp_t *kp1 = array_at(kpts1, i);
 
         // Find the best match in second set
-        min_kp = find_best_match(kp1, kpts2, &min_dist1, &min_dist2, &kp_index2);
+        min_kp = find_best_match(kp1, kpts2, index2, &min_dist1, &min_dist2, &kp_index2);
         // Test the distance ratio between the best two matches
         if ((min_dist1 * 100 / min_dist2) > threshold) {
             continue;
         }
 
         // Cross-match the keypoint in the first set
-        kp_t *kp2 = find_best_match(min_kp, kpts1, &min_dist1, &min_dist2, &kp_index1);
+        kp_t *kp2 = find_best_match(min_kp, kpts1, index1, &min_dist1, &min_dist2, &kp_index1);
         // Test the distance ratio between the best two matches
         if ((min_dist1 * 100 / min_dist2) > threshold) {
             continue;
@@ -604,6 +747,10 @@ int orb_match_keypoints(array_t *kpts1, array_t *kpts2, int *match, int threshol
         }
     }
 
+    if (index2_temp) {
+        fb_free();
+    }
+
     if (matches == 0) {
         r->x = r->y = 0;
         return 0;
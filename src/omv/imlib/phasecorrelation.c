@@ -11,9 +11,13 @@
 #include "imlib.h"
 #include "fft.h"
 
-void imlib_logpolar_int(image_t *dst, image_t *src, rectangle_t *roi, bool linear, bool reverse) {
-    int w = roi->w; // == dst_w
-    int h = roi->h; // == dst_h
+// The log-polar (or lin-polar) sampling map has the source (x, y) of each destination pixel in the
+// left half of the destination image, relative to the roi. The right half mirrors the left half.
+size_t imlib_logpolar_map_size(int w, int h) {
+    return (w / 2) * h * 2 * sizeof(int16_t);
+}
+
+void imlib_logpolar_map(int16_t *map, int w, int h, bool linear, bool reverse) {
     int w_2 = w / 2;
     int h_2 = h / 2;
     float rho_scale = fast_sqrtf((w_2 * w_2) + (h_2 * h_2));
@@ -31,216 +35,112 @@ void imlib_logpolar_int(image_t *dst, image_t *src, rectangle_t *roi, bool linea
     if (!reverse) {
         rho_scale /= h;
 
-        switch (src->pixfmt) {
-            case PIXFORMAT_BINARY: {
-                uint32_t *tmp = (uint32_t *) src->data;
-                int tmp_w = src->w, tmp_h = src->h, tmp_x = roi->x + w_2 - 1, tmp_y = roi->y + h_2;
-
-                for (int y = 0, yy = h; y < yy; y++) {
-                    uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(dst, y);
-                    float rho = y * rho_scale;
-                    if (!linear) {
-                        rho = fast_expf(rho);
-                    }
-                    for (int x = 0, xx = w_2; x < xx; x++) {
-
-                        int theta = fast_roundf(m_pi_1_5_d - (x * theta_scale_d));
-                        if (theta < 0) {
-                            theta += m_pi_2_0_d_i;            // wrap for table access
-                        }
-                        int sourceX = tmp_x + fast_roundf(rho * cos_table[theta]); // rounding is necessary
-                        int sourceY = tmp_y + fast_roundf(rho * sin_table[theta]); // rounding is necessary
-
-                        if ((0 <= sourceX) && (0 <= sourceY) && (sourceY < tmp_h)) {
-                            // plot the 2 symmetrical pixels
-                            uint32_t *ptr, pixel;
-                            ptr = tmp + (((tmp_w + UINT32_T_MASK) >> UINT32_T_SHIFT) * sourceY);
-                            pixel = IMAGE_GET_BINARY_PIXEL_FAST(ptr, sourceX);
-                            IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, pixel);
-                            pixel = IMAGE_GET_BINARY_PIXEL_FAST(ptr, tmp_w - 1 - sourceX);
-                            IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, w - 1 - x, pixel);
-                        }
-                    }
-                }
-                break;
+        for (int y = 0; y < h; y++) {
+            float rho = y * rho_scale;
+            if (!linear) {
+                rho = fast_expf(rho);
             }
-            case PIXFORMAT_GRAYSCALE: {
-                uint8_t *tmp = (uint8_t *) src->data;
-                int tmp_w = src->w, tmp_h = src->h, tmp_x = roi->x + w_2 - 1, tmp_y = roi->y + h_2;
-
-                for (int y = 0, yy = h; y < yy; y++) {
-                    uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(dst, y);
-                    float rho = y * rho_scale;
-                    if (!linear) {
-                        rho = fast_expf(rho);
-                    }
-                    for (int x = 0, xx = w_2; x < xx; x++) {
-
-                        int theta = fast_roundf(m_pi_1_5_d - (x * theta_scale_d));
-                        if (theta < 0) {
-                            theta += m_pi_2_0_d_i;            // wrap for table access
-                        }
-                        int sourceX = tmp_x + fast_roundf(rho * cos_table[theta]); // rounding is necessary
-                        int sourceY = tmp_y + fast_roundf(rho * sin_table[theta]); // rounding is necessary
-
-                        if ((0 <= sourceX) && (0 <= sourceY) && (sourceY < tmp_h)) {
-                            // plot the 2 symmetrical pixels
-                            uint8_t *ptr, pixel;
-                            ptr = tmp + (tmp_w * sourceY);
-                            pixel = ptr[sourceX];
-                            row_ptr[x] = pixel;
-                            pixel = ptr[tmp_w - 1 - sourceX];
-                            row_ptr[w - 1 - x] = pixel;
-                        }
-                    }
-                }
-                break;
-            }
-            case PIXFORMAT_RGB565: {
-                uint16_t *tmp = (uint16_t *) src->data;
-                int tmp_w = src->w, tmp_h = src->h, tmp_x = roi->x + w_2 - 1, tmp_y = roi->y + h_2;
-
-                for (int y = 0, yy = h; y < yy; y++) {
-                    uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst, y);
-                    float rho = y * rho_scale;
-                    if (!linear) {
-                        rho = fast_expf(rho);
-                    }
-                    for (int x = 0, xx = w_2; x < xx; x++) {
-
-                        int theta = fast_roundf(m_pi_1_5_d - (x * theta_scale_d));
-                        if (theta < 0) {
-                            theta += m_pi_2_0_d_i;            // wrap for table access
-                        }
-                        int sourceX = tmp_x + fast_roundf(rho * cos_table[theta]); // rounding is necessary
-                        int sourceY = tmp_y + fast_roundf(rho * sin_table[theta]); // rounding is necessary
-
-                        if ((0 <= sourceX) && (0 <= sourceY) && (sourceY < tmp_h)) {
-                            // plot the 2 symmetrical pixels
-                            uint16_t *ptr, pixel;
-                            ptr = tmp + (tmp_w * sourceY);
-                            pixel = ptr[sourceX];
-                            row_ptr[x] = pixel;
-                            pixel = ptr[tmp_w - 1 - sourceX];
-                            row_ptr[w - 1 - x] = pixel;
-                        }
-                    }
+            for (int x = 0; x < w_2; x++) {
+                int theta = fast_roundf(m_pi_1_5_d - (x * theta_scale_d));
+                if (theta < 0) {
+                    theta += m_pi_2_0_d_i;            // wrap for table access
                 }
-                break;
-            }
-            default: {
-                break;
+                *map++ = w_2 - 1 + fast_roundf(rho * cos_table[theta]); // rounding is necessary
+                *map++ = h_2 + fast_roundf(rho * sin_table[theta]); // rounding is necessary
             }
         }
     } else {
         float rho_scale_inv = (h - 1) / rho_scale;
-        switch (src->pixfmt) {
-            case PIXFORMAT_BINARY: {
-                uint32_t *tmp = (uint32_t *) src->data;
-                int tmp_w = src->w, tmp_x = roi->x, tmp_y = roi->y;
-
-                for (int y = 0, yy = h; y < yy; y++) {
-                    uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(dst, y);
-                    int y_2 = y - h_2;
-                    int y_2_2 = y_2 * y_2;
-
-                    for (int x = 0, xx = w_2; x < xx; x++) {
-                        int x_2 = x - w_2;
-                        int x_2_2 = x_2 * x_2;
-
-                        float rho = fast_sqrtf(x_2_2 + y_2_2);
-                        if (!linear) {
-                            rho = fast_log(rho);
-                        }
-                        float theta = m_pi_1_5 - fast_atan2f(y_2, x_2);
-                        int sourceX = tmp_x + fast_roundf(theta * theta_scale_inv); // rounding is necessary
-                        int sourceY = tmp_y + fast_roundf(rho * rho_scale_inv); // rounding is necessary
 
-                        // plot the 2 symmetrical pixels
-                        uint32_t *ptr, pixel;
-                        ptr = tmp + (((tmp_w + UINT32_T_MASK) >> UINT32_T_SHIFT) * sourceY);
-                        pixel = IMAGE_GET_BINARY_PIXEL_FAST(ptr, sourceX);
-                        IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, pixel);
-                        pixel = IMAGE_GET_BINARY_PIXEL_FAST(ptr, tmp_w - 1 - sourceX);
-                        IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, w - 1 - x, pixel);
-                    }
+        for (int y = 0; y < h; y++) {
+            int y_2 = y - h_2;
+            int y_2_2 = y_2 * y_2;
+
+            for (int x = 0; x < w_2; x++) {
+                int x_2 = x - w_2;
+                int x_2_2 = x_2 * x_2;
+
+                float rho = fast_sqrtf(x_2_2 + y_2_2);
+                if (!linear) {
+                    rho = fast_log(rho);
                 }
-                break;
+                float theta = m_pi_1_5 - fast_atan2f(y_2, x_2);
+                *map++ = fast_roundf(theta * theta_scale_inv); // rounding is necessary
+                *map++ = fast_roundf(rho * rho_scale_inv); // rounding is necessary
             }
-            case PIXFORMAT_GRAYSCALE: {
-                uint8_t *tmp = (uint8_t *) src->data;
-                int tmp_w = src->w, tmp_x = roi->x, tmp_y = roi->y;
-
-                for (int y = 0, yy = h; y < yy; y++) {
-                    uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(dst, y);
-                    int y_2 = y - h_2;
-                    int y_2_2 = y_2 * y_2;
-
-                    for (int x = 0, xx = w_2; x < xx; x++) {
-                        int x_2 = x - w_2;
-                        int x_2_2 = x_2 * x_2;
-
-                        float rho = fast_sqrtf(x_2_2 + y_2_2);
-                        if (!linear) {
-                            rho = fast_log(rho);
-                        }
-                        float theta = m_pi_1_5 - fast_atan2f(y_2, x_2);
-                        int sourceX = tmp_x + fast_roundf(theta * theta_scale_inv); // rounding is necessary
-                        int sourceY = tmp_y + fast_roundf(rho * rho_scale_inv); // rounding is necessary
+        }
+    }
+}
 
+// Gathers the pixels of the map, destination pixels that map outside of the source are not written.
+void imlib_logpolar_remap(image_t *dst, image_t *src, rectangle_t *roi, int16_t *map) {
+    int w = roi->w; // == dst_w
+    int h = roi->h; // == dst_h
+    int w_2 = w / 2;
+
+    switch (src->pixfmt) {
+        case PIXFORMAT_BINARY: {
+            for (int y = 0; y < h; y++) {
+                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(dst, y);
+                for (int x = 0; x < w_2; x++, map += 2) {
+                    int sourceX = roi->x + map[0], sourceY = roi->y + map[1];
+                    if ((0 <= sourceX) && (sourceX < src->w) && (0 <= sourceY) && (sourceY < src->h)) {
                         // plot the 2 symmetrical pixels
-                        uint8_t *ptr, pixel;
-                        ptr = tmp + (tmp_w * sourceY);
-                        pixel = ptr[sourceX];
-                        row_ptr[x] = pixel;
-                        pixel = ptr[tmp_w - 1 - sourceX];
-                        row_ptr[w - 1 - x] = pixel;
+                        uint32_t *ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(src, sourceY);
+                        IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, x, IMAGE_GET_BINARY_PIXEL_FAST(ptr, sourceX));
+                        IMAGE_PUT_BINARY_PIXEL_FAST(row_ptr, w - 1 - x,
+                                                    IMAGE_GET_BINARY_PIXEL_FAST(ptr, src->w - 1 - sourceX));
                     }
                 }
-                break;
             }
-            case PIXFORMAT_RGB565: {
-                uint16_t *tmp = (uint16_t *) src->data;
-                int tmp_w = src->w, tmp_x = roi->x, tmp_y = roi->y;
-
-                for (int y = 0, yy = h; y < yy; y++) {
-                    uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst, y);
-                    int y_2 = y - h_2;
-                    int y_2_2 = y_2 * y_2;
-
-                    for (int x = 0, xx = w_2; x < xx; x++) {
-                        int x_2 = x - w_2;
-                        int x_2_2 = x_2 * x_2;
-
-                        float rho = fast_sqrtf(x_2_2 + y_2_2);
-                        if (!linear) {
-                            rho = fast_log(rho);
-                        }
-                        float theta = m_pi_1_5 - fast_atan2f(y_2, x_2);
-                        int sourceX = tmp_x + fast_roundf(theta * theta_scale_inv); // rounding is necessary
-                        int sourceY = tmp_y + fast_roundf(rho * rho_scale_inv); // rounding is necessary
-
+            break;
+        }
+        case PIXFORMAT_GRAYSCALE: {
+            for (int y = 0; y < h; y++) {
+                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(dst, y);
+                for (int x = 0; x < w_2; x++, map += 2) {
+                    int sourceX = roi->x + map[0], sourceY = roi->y + map[1];
+                    if ((0 <= sourceX) && (sourceX < src->w) && (0 <= sourceY) && (sourceY < src->h)) {
                         // plot the 2 symmetrical pixels
-                        uint16_t *ptr, pixel;
-                        ptr = tmp + (tmp_w * sourceY);
-                        pixel = ptr[sourceX];
-                        row_ptr[x] = pixel;
-                        pixel = ptr[tmp_w - 1 - sourceX];
-                        row_ptr[w - 1 - x] = pixel;
+                        uint8_t *ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, sourceY);
+                        row_ptr[x] = ptr[sourceX];
+                        row_ptr[w - 1 - x] = ptr[src->w - 1 - sourceX];
                     }
                 }
-                break;
             }
-            default: {
-                break;
+            break;
+        }
+        case PIXFORMAT_RGB565: {
+            for (int y = 0; y < h; y++) {
+                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst, y);
+                for (int x = 0; x < w_2; x++, map += 2) {
+                    int sourceX = roi->x + map[0], sourceY = roi->y + map[1];
+                    if ((0 <= sourceX) && (sourceX < src->w) && (0 <= sourceY) && (sourceY < src->h)) {
+                        // plot the 2 symmetrical pixels
+                        uint16_t *ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(src, sourceY);
+                        row_ptr[x] = ptr[sourceX];
+                        row_ptr[w - 1 - x] = ptr[src->w - 1 - sourceX];
+                    }
+                }
             }
+            break;
+        }
+        default: {
+            break;
         }
     }
 }
 
+void imlib_logpolar_int(image_t *dst, image_t *src, rectangle_t *roi, bool linear, bool reverse) {
+    int16_t *map = fb_alloc(imlib_logpolar_map_size(roi->w, roi->h), FB_ALLOC_NO_HINT);
+    imlib_logpolar_map(map, roi->w, roi->h, linear, reverse);
+    imlib_logpolar_remap(dst, src, roi, map);
+    fb_free(); // map
+}
+
 #if defined(IMLIB_ENABLE_LOGPOLAR) || defined(IMLIB_ENABLE_LINPOLAR)
 void imlib_logpolar(image_t *img, bool linear, bool reverse) {
-    image_t img_2;
+    image_t img_2 = {};
     img_2.w = img->w;
     img_2.h = img->h;
     img_2.pixfmt = img->pixfmt;
@@ -263,6 +163,97 @@ void imlib_logpolar(image_t *img, bool linear, bool reverse) {
 #endif //defined(IMLIB_ENABLE_LOGPOLAR) || defined(IMLIB_ENABLE_LINPOLAR)
 
 #ifdef IMLIB_ENABLE_FIND_DISPLACEMENT
+// Finds the peak of the inverse FFT of a normalized cross power spectrum and returns its sub-pixel
+// offset (FFT shifted and with y pointing up) and the response, or all zeros if it is just noise.
+static void phasecorrelate_peak(float *data, int w, int h, float *x_offset, float *y_offset, float *response) {
+    float sum = 0;
+    float max = 0;
+    int off_x = 0;
+    int off_y = 0;
+
+    for (int i = 0; i < h; i++) {
+        for (int j = 0; j < w; j++) {
+            // Note that the output of the FFT is packed with real data in both
+            // the real and imaginary parts... (right side of the array is zero).
+            float f_r = data[(i * w * 2) + j];
+            sum += f_r;
+            if (f_r > max) {
+                max = f_r;
+                off_x = j;
+                off_y = i;
+            }
+        }
+    }
+
+    *response = max / sum; // normalize this to [0:1].
+
+    float f_sum = 0;
+    float f_off_x = 0;
+    float f_off_y = 0;
+
+    for (int i = -2; i < 2; i++) {
+        for (int j = -2; j < 2; j++) {
+
+            // Wrap around
+            int new_x = off_x + j;
+            if (new_x < 0) {
+                new_x += w;
+            }
+            if (new_x >= w) {
+                new_x -= w;
+            }
+
+            // Wrap around
+            int new_y = off_y + i;
+            if (new_y < 0) {
+                new_y += h;
+            }
+            if (new_y >= h) {
+                new_y -= h;
+            }
+
+            // Compute centroid.
+            float f_r = data[(new_y * w * 2) + new_x];
+            f_off_x += (off_x + j) * f_r; // don't use new_x here
+            f_off_y += (off_y + i) * f_r; // don't use new_y here
+            f_sum += f_r;
+        }
+    }
+
+    f_off_x /= f_sum;
+    f_off_y /= f_sum;
+
+    // FFT Shift X
+    if (f_off_x >= (w / 2.0f)) {
+        *x_offset = f_off_x - w;
+    } else {
+        *x_offset = f_off_x;
+    }
+
+    // FFT Shift Y
+    if (f_off_y >= (h / 2.0f)) {
+        *y_offset = -(f_off_y - h);
+    } else {
+        *y_offset = -f_off_y;
+    }
+
+    if ((*x_offset < (-w / 2.0f))
+        || ((w / 2.0f) <= *x_offset)
+        || (*y_offset < (-h / 2.0f))
+        || ((h / 2.0f) <= *y_offset)
+        || isnanf(*x_offset)
+        || isinff(*x_offset)
+        || isnanf(*y_offset)
+        || isinff(*y_offset)
+        || isnanf(*response)
+        || isinff(*response)) {
+        // Noise Filter
+        *x_offset = 0;
+        *y_offset = 0;
+        *response = 0;
+    }
+}
+
 // Note that both ROI widths and heights must be equal.
 void imlib_phasecorrelate(image_t *img0,
                           image_t *img1,
@@ -315,92 +306,8 @@ void imlib_phasecorrelate(image_t *img0,
 
         ifft2d_run(&fft0);
 
-        float sum = 0;
-        float max = 0;
-        int off_x = 0;
-        int off_y = 0;
-
-        for (int i = 0; i < h; i++) {
-            for (int j = 0; j < w; j++) {
-                // Note that the output of the FFT is packed with real data in both
-                // the real and imaginary parts... (right side of the array is zero).
-                float f_r = fft0.data[(i * w * 2) + j];
-                sum += f_r;
-                if (f_r > max) {
-                    max = f_r;
-                    off_x = j;
-                    off_y = i;
-                }
-            }
-        }
-
-        float tmp_response = max / sum; // normalize this to [0:1].
-
-        float f_sum = 0;
-        float f_off_x = 0;
-        float f_off_y = 0;
-
-        for (int i = -2; i < 2; i++) {
-            for (int j = -2; j < 2; j++) {
-
-                // Wrap around
-                int new_x = off_x + j;
-                if (new_x < 0) {
-                    new_x += w;
-                }
-                if (new_x >= w) {
-                    new_x -= w;
-                }
-
-                // Wrap around
-                int new_y = off_y + i;
-                if (new_y < 0) {
-                    new_y += h;
-                }
-                if (new_y >= h) {
-                    new_y -= h;
-                }
-
-                // Compute centroid.
-                float f_r = fft0.data[(new_y * w * 2) + new_x];
-                f_off_x += (off_x + j) * f_r; // don't use new_x here
-                f_off_y += (off_y + i) * f_r; // don't use new_y here
-                f_sum += f_r;
-            }
-        }
-
-        f_off_x /= f_sum;
-        f_off_y /= f_sum;
-
-        // FFT Shift X
-        if (f_off_x >= (w / 2.0f)) {
-            f_off_x = f_off_x - w;
-        } else {
-            f_off_x = f_off_x;
-        }
-
-        // FFT Shift Y
-        if (f_off_y >= (h / 2.0f)) {
-            f_off_y = -(f_off_y - h);
-        } else {
-            f_off_y = -f_off_y;
-        }
-
-        if ((f_off_x < (-w / 2.0f))
-            || ((w / 2.0f) <= f_off_x)
-            || (f_off_y < (-h / 2.0f))
-            || ((h / 2.0f) <= f_off_y)
-            || isnanf(f_off_x)
-            || isinff(f_off_x)
-            || isnanf(f_off_y)
-            || isinff(f_off_y)
-            || isnanf(tmp_response)
-            || isinff(tmp_response)) {
-            // Noise Filter
-            f_off_x = 0;
-            f_off_y = 0;
-            tmp_response = 0;
-        }
+        float f_off_x, f_off_y, tmp_response;
+        phasecorrelate_peak(fft0.data, w, h, &f_off_x, &f_off_y, &tmp_response);
 
         fft2d_dealloc(); // fft1
         fft2d_dealloc(); // fft0
@@ -417,7 +324,7 @@ void imlib_phasecorrelate(image_t *img0,
         *scale = 0;
     }
 
-    image_t img0_fixed;
+    image_t img0_fixed = {};
     rectangle_t roi0_fixed;
 
     // Step 2 - Fix Rotation/Scale Differences
@@ -475,15 +382,19 @@ void imlib_phasecorrelate(image_t *img0,
 
     // Step 3 - Get Translation Differences
     {
-        image_t img0alt, img1alt;
+        image_t img0alt = {}, img1alt = {};
         rectangle_t roi0alt, roi1alt;
 
         if (logpolar) {
+            // Both rois have the same size, so they share the sampling map.
+            int16_t *map = fb_alloc(imlib_logpolar_map_size(roi1->w, roi1->h), FB_ALLOC_NO_HINT);
+            imlib_logpolar_map(map, roi1->w, roi1->h, false, false);
+
             img0alt.w = roi0_fixed.w;
             img0alt.h = roi0_fixed.h;
             img0alt.pixfmt = img0_fixed.pixfmt;
             img0alt.data = fb_alloc0(image_size(&img0alt), FB_ALLOC_NO_HINT);
-            imlib_logpolar_int(&img0alt, &img0_fixed, &roi0_fixed, false, false);
+            imlib_logpolar_remap(&img0alt, &img0_fixed, &roi0_fixed, map);
             roi0alt.x = 0;
             roi0alt.y = 0;
             roi0alt.w = roi0_fixed.w;
@@ -493,7 +404,7 @@ void imlib_phasecorrelate(image_t *img0,
             img1alt.h = roi1->h;
             img1alt.pixfmt = img1->pixfmt;
             img1alt.data = fb_alloc0(image_size(&img1alt), FB_ALLOC_NO_HINT);
-            imlib_logpolar_int(&img1alt, img1, roi1, false, false);
+            imlib_logpolar_remap(&img1alt, img1, roi1, map);
             roi1alt.x = 0;
             roi1alt.y = 0;
             roi1alt.w = roi1->w;
@@ -525,92 +436,7 @@ void imlib_phasecorrelate(image_t *img0,
 
         ifft2d_run(&fft0);
 
-        float sum = 0;
-        float max = 0;
-        int off_x = 0;
-        int off_y = 0;
-
-        for (int i = 0; i < h; i++) {
-            for (int j = 0; j < w; j++) {
-                // Note that the output of the FFT is packed with real data in both
-                // the real and imaginary parts... (right side of the array is zero).
-                float f_r = fft0.data[(i * w * 2) + j];
-                sum += f_r;
-                if (f_r > max) {
-                    max = f_r;
-                    off_x = j;
-                    off_y = i;
-                }
-            }
-        }
-
-        *response = max / sum; // normalize this to [0:1].
-
-        float f_sum = 0;
-        float f_off_x = 0;
-        float f_off_y = 0;
-
-        for (int i = -2; i < 2; i++) {
-            for (int j = -2; j < 2; j++) {
-
-                // Wrap around
-                int new_x = off_x + j;
-                if (new_x < 0) {
-                    new_x += w;
-                }
-                if (new_x >= w) {
-                    new_x -= w;
-                }
-
-                // Wrap around
-                int new_y = off_y + i;
-                if (new_y < 0) {
-                    new_y += h;
-                }
-                if (new_y >= h) {
-                    new_y -= h;
-                }
-
-                // Compute centroid.
-                float f_r = fft0.data[(new_y * w * 2) + new_x];
-                f_off_x += (off_x + j) * f_r; // don't use new_x here
-                f_off_y += (off_y + i) * f_r; // don't use new_y here
-                f_sum += f_r;
-            }
-        }
-
-        f_off_x /= f_sum;
-        f_off_y /= f_sum;
-
-        // FFT Shift X
-        if (f_off_x >= (w / 2.0f)) {
-            *x_translation = f_off_x - w;
-        } else {
-            *x_translation = f_off_x;
-        }
-
-        // FFT Shift Y
-        if (f_off_y >= (h / 2.0f)) {
-            *y_translation = -(f_off_y - h);
-        } else {
-            *y_translation = -f_off_y;
-        }
-
-        if ((*x_translation < (-w / 2.0f))
-            || ((w / 2.0f) <= *x_translation)
-            || (*y_translation < (-h / 2.0f))
-            || ((h / 2.0f) <= *y_translation)
-            || isnanf(*x_translation)
-            || isinff(*x_translation)
-            || isnanf(*y_translation)
-            || isinff(*y_translation)
-            || isnanf(*response)
-            || isinff(*response)) {
-            // Noise Filter
-            *x_translation = 0;
-            *y_translation = 0;
-            *response = 0;
-        }
+        phasecorrelate_peak(fft0.data, w, h, x_translation, y_translation, response);
 
         fft2d_dealloc(); // fft1
         fft2d_dealloc(); // fft0
@@ -618,6 +444,7 @@ void imlib_phasecorrelate(image_t *img0,
         if (logpolar) {
             fb_free(); // img1alt
             fb_free(); // img0alt
+            fb_free(); // map
 
             float w_2 = roi0->w / 2.0f;
             float h_2 = roi0->h / 2.0f;
@@ -635,4 +462,100 @@ void imlib_phasecorrelate(image_t *img0,
         fb_free();
     }
 }
+
+size_t imlib_phasecorr_init(imlib_phasecorr_t *pc, int w, int h, bool logpolar) {
+    pc->w = w;
+    pc->h = h;
+    pc->logpolar = logpolar;
+    pc->initialized = false;
+    pc->len = fft2d_data_len(w, h);
+    // The log-polar sampling map is computed once and kept with the spectra.
+    return (pc->len * sizeof(float) * 2) + (logpolar ? imlib_logpolar_map_size(w, h) : 0);
+}
+
+void imlib_phasecorr_set_buffer(imlib_phasecorr_t *pc, uint8_t *buffer) {
+    pc->prev = (float *) buffer;
+    pc->data = pc->prev + pc->len;
+    pc->map = NULL;
+    if (pc->logpolar) {
+        pc->map = (int16_t *) (pc->data + pc->len);
+        imlib_logpolar_map(pc->map, pc->w, pc->h, false, false);
+    }
+    imlib_phasecorr_reset(pc);
+}
+
+void imlib_phasecorr_reset(imlib_phasecorr_t *pc) {
+    pc->initialized = false;
+}
+
+bool imlib_phasecorr_update(imlib_phasecorr_t *pc, image_t *img, rectangle_t *roi,
+                            float *x_translation, float *y_translation,
+                            float *rotation, float *scale, float *response) {
+    image_t img_alt = {};
+    rectangle_t roi_alt;
+
+    if (pc->logpolar) {
+        img_alt.w = roi->w;
+        img_alt.h = roi->h;
+        img_alt.pixfmt = img->pixfmt;
+        img_alt.data = fb_alloc0(image_size(&img_alt), FB_ALLOC_NO_HINT);
+        imlib_logpolar_remap(&img_alt, img, roi, pc->map);
+        roi_alt.x = 0;
+        roi_alt.y = 0;
+        roi_alt.w = roi->w;
+        roi_alt.h = roi->h;
+    }
+
+    fft2d_controller_t fft;
+    fft2d_init(&fft, pc->logpolar ? &img_alt : img, pc->logpolar ? &roi_alt : roi, pc->data);
+    fft2d_run(&fft);
+
+    if (pc->logpolar) {
+        fb_free(); // img_alt
+    }
+
+    // The first frame only has a spectrum to keep.
+    if (!pc->initialized) {
+        memcpy(pc->prev, pc->data, pc->len * sizeof(float));
+        pc->initialized = true;
+        return false;
+    }
+
+    // Correlate the previous frame against this one and keep this frame's spectrum for the next
+    // call in the same pass, so that only one forward and one inverse FFT are done per frame.
+    for (size_t i = 0; i < pc->len; i += 2) {
+        float ga_r = pc->prev[i + 0];
+        float ga_i = pc->prev[i + 1];
+        float gb_r = pc->data[i + 0];
+        float gb_i = -pc->data[i + 1]; // complex conjugate...
+        float hp_r = (ga_r * gb_r) - (ga_i * gb_i); // hadamard product
+        float hp_i = (ga_r * gb_i) + (ga_i * gb_r); // hadamard product
+        float mag = 1 / fast_sqrtf((hp_r * hp_r) + (hp_i * hp_i)); // magnitude
+        pc->prev[i + 0] = gb_r;
+        pc->prev[i + 1] = -gb_i;
+        pc->data[i + 0] = hp_r * mag;
+        pc->data[i + 1] = hp_i * mag;
+    }
+
+    ifft2d_run(&fft);
+
+    phasecorrelate_peak(fft.data, 1 << fft.w_pow2, 1 << fft.h_pow2, x_translation, y_translation, response);
+
+    if (pc->logpolar) {
+        float w_2 = roi->w / 2.0f;
+        float h_2 = roi->h / 2.0f;
+        float rho_scale = fast_log(fast_sqrtf((w_2 * w_2) + (h_2 * h_2))) / roi->h;
+        float theta_scale = (2 * M_PI) / roi->w;
+
+        *rotation = *x_translation * theta_scale;
+        *scale = (*y_translation * rho_scale) + 1;
+        *x_translation = 0;
+        *y_translation = 0;
+    } else {
+        *rotation = 0;
+        *scale = 0;
+    }
+
+    return true;
+}
 #endif //IMLIB_ENABLE_FIND_DISPLACEMENT
@@ -0,0 +1,207 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Fused line operation pipeline.
+ *
+ * Each stage keeps a small ring of input rows in fast memory and produces an
+ * output row as soon as all the rows under its kernel are available. Output
+ * rows are written directly into the ring of the next stage, so the image is
+ * only read and written once no matter how many stages there are.
+ */
+#include "imlib.h"
+#ifdef IMLIB_ENABLE_BINARY_OPS
+
+void imlib_pipeline_lut_binary(imlib_pipeline_stage_t *stage, list_t *thresholds, bool invert, bool zero) {
+    stage->op = IMLIB_PIPELINE_OP_LUT;
+    stage->ksize = 0;
+
+    for (int i = 0; i < 256; i++) {
+        bool match = false;
+
+        list_for_each(it, thresholds) {
+            color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
+
+            if (COLOR_THRESHOLD_GRAYSCALE(i, lnk_data, invert)) {
+                match = true;
+                break;
+            }
+        }
+
+        if (zero) {
+            stage->lut[i] = match ? COLOR_GRAYSCALE_BINARY_MIN : i;
+        } else {
+            stage->lut[i] = match ? COLOR_GRAYSCALE_BINARY_MAX : COLOR_GRAYSCALE_BINARY_MIN;
+        }
+    }
+}
+
+void imlib_pipeline_lut_invert(imlib_pipeline_stage_t *stage) {
+    stage->op = IMLIB_PIPELINE_OP_LUT;
+    stage->ksize = 0;
+
+    for (int i = 0; i < 256; i++) {
+        stage->lut[i] = COLOR_GRAYSCALE_MAX - i;
+    }
+}
+
+static inline uint8_t *imlib_pipeline_row(imlib_pipeline_stage_t *stage, int w, int h, int y) {
+    int n = (stage->ksize * 2) + 1;
+    return stage->rows + ((IM_CLAMP(y, 0, (h - 1)) % n) * w);
+}
+
+static void imlib_pipeline_lut(imlib_pipeline_stage_t *stage, uint8_t *src, uint8_t *dst, int w) {
+    for (int x = 0; x < w; x++) {
+        dst[x] = stage->lut[src[x]];
+    }
+}
+
+static void imlib_pipeline_morph(imlib_pipeline_stage_t *stage, uint8_t **rows, uint8_t *dst, int w) {
+    int ksize = stage->ksize, n = (ksize * 2) + 1;
+
+    for (int x = 0; x < w; x++) {
+        int32_t acc = 0;
+        int *krn = stage->krn;
+
+        if (x >= ksize && x < w - ksize) {
+            for (int j = 0; j < n; j++) {
+                uint8_t *k_row_ptr = rows[j] + x - ksize;
+                for (int k = 0; k < n; k++) {
+                    acc += *krn++ * k_row_ptr[k];
+                }
+            }
+        } else {
+            for (int j = 0; j < n; j++) {
+                for (int k = -ksize; k <= ksize; k++) {
+                    acc += *krn++ * rows[j][IM_CLAMP(x + k, 0, (w - 1))];
+                }
+            }
+        }
+
+        int32_t tmp = (acc * stage->m_int) + stage->b_int;
+        dst[x] = __USAT_ASR(tmp, 8, 16);
+    }
+}
+
+static void imlib_pipeline_erode_dilate(imlib_pipeline_stage_t *stage, uint8_t **rows, uint8_t *src, uint8_t *dst, int w) {
+    int ksize = stage->ksize, n = (ksize * 2) + 1;
+    uint16_t *cols = stage->cols;
+    bool dilate = stage->op == IMLIB_PIPELINE_OP_DILATE;
+    // Same threshold convention as imlib_erode() and imlib_dilate().
+    int threshold = dilate ? stage->threshold : ((n * n) - 1 - stage->threshold);
+
+    // Count the set pixels in each column under the kernel first.
+    memset(cols, 0, w * sizeof(uint16_t));
+    for (int j = 0; j < n; j++) {
+        for (int x = 0; x < w; x++) {
+            cols[x] += rows[j][x] > 0;
+        }
+    }
+
+    int acc = dilate ? 0 : -1; // Don't count center pixel...
+    for (int k = -ksize; k <= ksize; k++) {
+        acc += cols[IM_CLAMP(k, 0, (w - 1))];
+    }
+
+    for (int x = 0; x < w; x++) {
+        if (x) {
+            // Subtract old left edge and add new right edge to sum.
+            acc -= cols[IM_MAX(x - ksize - 1, 0)];
+            acc += cols[IM_MIN(x + ksize, (w - 1))];
+        }
+
+        int pixel = src[x];
+
+        if (!dilate) {
+            // Preserve original pixel value... or clear it.
+            if (acc < threshold) {
+                pixel = COLOR_GRAYSCALE_BINARY_MIN;
+            }
+        } else {
+            // Preserve original pixel value... or set it.
+            if (acc > threshold) {
+                pixel = COLOR_GRAYSCALE_BINARY_MAX;
+            }
+        }
+
+        dst[x] = pixel;
+    }
+}
+
+// Called after row y has been written into the ring of stage i.
+static void imlib_pipeline_push(image_t *img, imlib_pipeline_stage_t *stages, int n_stages, int i, int y) {
+    imlib_pipeline_stage_t *stage = &stages[i];
+    int ksize = stage->ksize, n = (ksize * 2) + 1;
+    uint8_t *rows[n];
+
+    // Once the last row arrives all remaining output rows can be produced.
+    int o_start = y - ksize, o_end = (y == (img->h - 1)) ? y : o_start;
+
+    for (int o = IM_MAX(o_start, 0); o <= o_end; o++) {
+        uint8_t *dst;
+
+        if (i == (n_stages - 1)) {
+            // The first stage copied its input, so the image can be written in place.
+            dst = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, o);
+        } else {
+            dst = imlib_pipeline_row(&stages[i + 1], img->w, img->h, o);
+        }
+
+        for (int j = 0; j < n; j++) {
+            rows[j] = imlib_pipeline_row(stage, img->w, img->h, o + j - ksize);
+        }
+
+        switch (stage->op) {
+            case IMLIB_PIPELINE_OP_LUT: {
+                imlib_pipeline_lut(stage, rows[ksize], dst, img->w);
+                break;
+            }
+            case IMLIB_PIPELINE_OP_MORPH: {
+                imlib_pipeline_morph(stage, rows, dst, img->w);
+                break;
+            }
+            case IMLIB_PIPELINE_OP_ERODE:
+            case IMLIB_PIPELINE_OP_DILATE: {
+                imlib_pipeline_erode_dilate(stage, rows, rows[ksize], dst, img->w);
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+
+        if (i < (n_stages - 1)) {
+            imlib_pipeline_push(img, stages, n_stages, i + 1, o);
+        }
+    }
+}
+
+void imlib_pipeline(image_t *img, imlib_pipeline_stage_t *stages, int n_stages) {
+    if ((img->pixfmt != PIXFORMAT_GRAYSCALE) || (!n_stages)) {
+        return;
+    }
+
+    fb_alloc_mark();
+
+    for (int i = 0; i < n_stages; i++) {
+        int n = (stages[i].ksize * 2) + 1;
+        stages[i].rows = fb_alloc(img->w * n, FB_ALLOC_PREFER_SPEED);
+
+        if ((stages[i].op == IMLIB_PIPELINE_OP_ERODE) || (stages[i].op == IMLIB_PIPELINE_OP_DILATE)) {
+            stages[i].cols = fb_alloc(img->w * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+        }
+    }
+
+    for (int y = 0; y < img->h; y++) {
+        memcpy(imlib_pipeline_row(&stages[0], img->w, img->h, y),
+               IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y), img->w);
+        imlib_pipeline_push(img, stages, n_stages, 0, y);
+    }
+
+    fb_alloc_free_till_mark();
+}
+#endif // IMLIB_ENABLE_BINARY_OPS
@@ -11,7 +11,7 @@
 #include "imlib.h"
 #include "py/runtime.h"
 #include "file_utils.h"
-#if defined(IMLIB_ENABLE_PNG_ENCODER) || defined(IMLIB_ENABLE_PNG_DECODER)
+#if defined(IMLIB_ENABLE_PNG_DECODER)
 #include "lodepng.h"
 #include "umm_malloc.h"
 
@@ -32,41 +32,7 @@ unsigned lodepng_convert_cb(unsigned char *out, const unsigned char *in,
     unsigned error = 0;
     unsigned numpixels = w * h;
 
-    if (mode_in->colortype == LCT_CUSTOM) {
-        // Compression.
-        // Note: we're always encoding to 8 bits.
-        switch (mode_in->customfmt) {
-            case PIXFORMAT_RGB565: {
-                uint16_t *pixels = (uint16_t *) in;
-                if (mode_out->colortype == LCT_RGB) {
-                    // RGB565 -> RGB888
-                    for (int i = 0; i < numpixels; i++, out += 3) {
-                        out[0] = COLOR_RGB565_TO_R8(pixels[i]);
-                        out[1] = COLOR_RGB565_TO_G8(pixels[i]);
-                        out[2] = COLOR_RGB565_TO_B8(pixels[i]);
-                    }
-                } else if (mode_out->colortype == LCT_RGBA) {
-                    // RGB565 -> RGBA888
-                    for (int i = 0; i < numpixels; i++, out += 4) {
-                        out[0] = COLOR_RGB565_TO_R8(pixels[i]);
-                        out[1] = COLOR_RGB565_TO_G8(pixels[i]);
-                        out[2] = COLOR_RGB565_TO_B8(pixels[i]);
-                        out[3] = 255;
-                    }
-                } else {
-                    error = 56; // unsupported color mode conversion.
-                }
-                break;
-            }
-            case PIXFORMAT_YUV_ANY:
-            // YUV   -> RGB888
-            case PIXFORMAT_BAYER_ANY:
-            // BAYER -> RGB888
-            default:
-                error = 56; // unsupported color mode conversion.
-                break;
-        }
-    } else if (mode_out->colortype == LCT_CUSTOM) {
+    if (mode_out->colortype == LCT_CUSTOM) {
         // Decompression.
         // NOTE: decode from 16 bits needs to be implemented.
         switch (mode_out->customfmt) {
@@ -103,88 +69,8 @@ unsigned lodepng_convert_cb(unsigned char *out, const unsigned char *in,
     return error;
 }
 
-#if defined(IMLIB_ENABLE_PNG_ENCODER)
-bool png_compress(image_t *src, image_t *dst) {
-    OMV_PROFILE_START();
-
-    if (src->is_compressed) {
-        return true;
-    }
-
-    umm_init_x(fb_avail());
-
-    LodePNGState state;
-    lodepng_state_init(&state);
-    // Invoked on custom formats.
-    state.lodepng_convert = &lodepng_convert_cb;
-    // Faster compression.
-    state.encoder.zlibsettings.windowsize = 1024;
-
-    switch (src->pixfmt) {
-        case PIXFORMAT_BINARY:
-            state.info_raw.bitdepth = 1;
-            state.info_raw.colortype = LCT_GREY;
-
-            state.encoder.auto_convert = false;
-            state.info_png.color.bitdepth = 8;
-            state.info_png.color.colortype = LCT_GREY;
-            break;
-        case PIXFORMAT_GRAYSCALE:
-            state.info_raw.bitdepth = 8;
-            state.info_raw.colortype = LCT_GREY;
-
-            state.encoder.auto_convert = false;
-            state.info_png.color.bitdepth = 8;
-            state.info_png.color.colortype = LCT_GREY;
-            break;
-        case PIXFORMAT_RGB565:
-            state.info_raw.bitdepth = 16;
-            state.info_raw.colortype = LCT_CUSTOM;
-            state.info_raw.customfmt = PIXFORMAT_RGB565;
-
-            state.encoder.auto_convert = false;
-            state.info_png.color.bitdepth = 8;
-            state.info_png.color.colortype = LCT_RGB;
-            break;
-        case PIXFORMAT_YUV_ANY:
-            mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("Input format is not supported"));
-            break;
-        case PIXFORMAT_BAYER_ANY:
-            mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("Input format is not supported"));
-            break;
-    }
-
-    size_t png_size = 0;
-    uint8_t *png_data = NULL;
-    unsigned error = lodepng_encode(&png_data, &png_size, src->data, src->w, src->h, &state);
-    lodepng_state_cleanup(&state);
-    if (error) {
-        mp_raise_msg(&mp_type_RuntimeError, (mp_rom_error_text_t) lodepng_error_text(error));
-    }
-
-    if (dst->data == NULL) {
-        dst->data = png_data;
-        dst->size = png_size;
-        // fb_alloc() memory ill be free'd by called.
-    } else {
-        if (image_size(dst) <= png_size) {
-            dst->size = png_size;
-            memcpy(dst->data, png_data, png_size);
-        } else {
-            mp_raise_msg_varg(&mp_type_RuntimeError,
-                              MP_ERROR_TEXT("Failed to compress image in place"));
-        }
-        // free fb_alloc() memory used for umm_init_x().
-        fb_free(); // umm_init_x();
-    }
-    OMV_PROFILE_PRINT();
-    return false;
-}
-#endif // IMLIB_ENABLE_PNG_ENCODER
-
-#if defined(IMLIB_ENABLE_PNG_DECODER)
 void png_decompress(image_t *dst, image_t *src) {
-    OMV_PROFILE_START();
+    OMV_PROFILE_START(png_decompress);
     umm_init_x(fb_avail());
 
     LodePNGState state;
@@ -225,15 +111,15 @@ void png_decompress(image_t *dst, image_t *src) {
     }
 
     // free fb_alloc() memory used for umm_init_x().
+    umm_deinit();
     fb_free(); // umm_init_x();
-    OMV_PROFILE_PRINT();
+    OMV_PROFILE_END(png_decompress);
 }
 #endif // IMLIB_ENABLE_PNG_DECODER
-#endif // IMLIB_ENABLE_PNG_ENCODER || IMLIB_ENABLE_PNG_DECODER
 
 
 #if !defined(IMLIB_ENABLE_PNG_ENCODER)
-bool png_compress(image_t *src, image_t *dst) {
+bool png_compress(image_t *src, image_t *dst, png_effort_t effort) {
     mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("PNG encoder is not enabled"));
 }
 #endif
@@ -294,14 +180,17 @@ void png_read(image_t *img, const char *path) {
     file_close(&fp);
 }
 
-void png_write(image_t *img, const char *path) {
+void png_write(image_t *img, const char *path, png_effort_t effort) {
     FIL fp;
     file_open(&fp, path, false, FA_WRITE | FA_CREATE_ALWAYS);
     if (img->pixfmt == PIXFORMAT_PNG) {
         file_write(&fp, img->pixels, img->size);
     } else {
         image_t out = { .w = img->w, .h = img->h, .pixfmt = PIXFORMAT_PNG, .size = 0, .pixels = NULL }; // alloc in png compress
-        png_compress(img, &out);
+        if (png_compress(img, &out, effort)) {
+            file_close(&fp);
+            mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("Out of memory"));
+        }
         file_write(&fp, out.pixels, out.size);
         fb_free(); // frees alloc in png_compress()
     }
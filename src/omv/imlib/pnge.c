@@ -0,0 +1,806 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Minimalistic streaming PNG encoder.
+ *
+ * Rows are converted and filtered one at a time straight from the image and
+ * then deflated into the output buffer. All working memory (the LZ77 window,
+ * hash chains and block symbols) lives in one fb_alloc arena, nothing is
+ * allocated on the heap and no full image intermediate buffer is used.
+ */
+#include "imlib.h"
+#include "py/runtime.h"
+#if defined(IMLIB_ENABLE_PNG_ENCODER)
+
+#define PNG_WINDOW_SIZE     (16384) // LZ77 window size (power of 2).
+#define PNG_WINDOW_MASK     (PNG_WINDOW_SIZE - 1)
+#define PNG_HASH_BITS       (12)
+#define PNG_HASH_SIZE       (1 << PNG_HASH_BITS)
+#define PNG_MAX_CHAIN       (16)    // Hash chain entries checked per match.
+#define PNG_MIN_MATCH       (3)
+#define PNG_MAX_MATCH       (258)
+#define PNG_SYMBOLS         (8192)  // Symbols per deflate block.
+#define PNG_STORED_MAX      (65535) // Max stored deflate block size.
+#define PNG_LL_CODES        (286)
+#define PNG_D_CODES         (30)
+#define PNG_CL_CODES        (19)
+#define PNG_ALIGN(x)        (((x) + 3) & ~3)
+
+static const uint8_t png_signature[8] = {
+    0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A
+};
+
+static const uint16_t png_len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint8_t png_len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const uint16_t png_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+
+static const uint8_t png_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+static const uint8_t png_cl_order[PNG_CL_CODES] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+typedef struct png_enc {
+    // Output buffer.
+    uint8_t *buf;
+    uint32_t idx;
+    uint32_t length;
+    bool overflow;
+    uint64_t bitb;
+    uint32_t bitc;
+    png_effort_t effort;
+    uint32_t adler_a;
+    uint32_t adler_b;
+    uint32_t *crc_table;
+    // Length/distance to code lookup tables.
+    uint8_t *len_sym;
+    uint8_t *dist_sym;
+    // LZ77 window, holds two window sizes so that it can slide.
+    uint8_t *window;
+    uint32_t wpos;
+    uint32_t wend;
+    int16_t *head;
+    int16_t *prev;
+    // Block symbols.
+    uint16_t *syms_ll;
+    uint16_t *syms_dist;
+    uint32_t nsyms;
+    uint16_t ll_freq[PNG_LL_CODES + 2]; // Codes 286 and 287 are only used by the fixed code.
+    uint16_t d_freq[PNG_D_CODES];
+    uint16_t ll_codes[PNG_LL_CODES + 2];
+    uint8_t ll_lens[PNG_LL_CODES + 2];
+    uint16_t d_codes[PNG_D_CODES];
+    uint8_t d_lens[PNG_D_CODES];
+} png_enc_t;
+
+static uint32_t png_arena_size(png_effort_t effort, uint32_t row_bytes) {
+    uint32_t size = PNG_ALIGN(sizeof(png_enc_t)) + (256 * sizeof(uint32_t)) + 256 + 512;
+    size += PNG_ALIGN(row_bytes) * 2 + PNG_ALIGN(row_bytes + 1) * 2;
+    if (effort != PNG_EFFORT_STORED) {
+        size += (PNG_WINDOW_SIZE * 2) + (PNG_SYMBOLS * sizeof(uint16_t) * 2);
+    }
+    if (effort == PNG_EFFORT_BEST) {
+        size += (PNG_HASH_SIZE + PNG_WINDOW_SIZE) * sizeof(int16_t);
+    }
+    return size;
+}
+
+static void *png_arena_take(uint8_t **arena, uint32_t size) {
+    void *ptr = *arena;
+    *arena += PNG_ALIGN(size);
+    return ptr;
+}
+
+static void png_init_tables(png_enc_t *enc) {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int j = 0; j < 8; j++) {
+            c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+        }
+        enc->crc_table[i] = c;
+    }
+
+    for (int i = 0; i < 29; i++) {
+        for (int j = png_len_base[i]; (j < (png_len_base[i] + (1 << png_len_extra[i]))) && (j <= PNG_MAX_MATCH); j++) {
+            enc->len_sym[j - PNG_MIN_MATCH] = i;
+        }
+    }
+
+    // Distances up to 256 are looked up directly, larger ones by (dist - 1) >> 7.
+    for (int i = 0; i < PNG_D_CODES; i++) {
+        for (int j = png_dist_base[i]; j < (png_dist_base[i] + (1 << png_dist_extra[i])); j++) {
+            if (j <= 256) {
+                enc->dist_sym[j - 1] = i;
+            } else {
+                enc->dist_sym[256 + ((j - 1) >> 7)] = i;
+            }
+        }
+    }
+}
+
+static uint32_t png_crc(png_enc_t *enc, uint32_t crc, const uint8_t *data, uint32_t size) {
+    for (uint32_t i = 0; i < size; i++) {
+        crc = enc->crc_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static inline uint32_t png_dist_sym(png_enc_t *enc, uint32_t dist) {
+    return (dist <= 256) ? enc->dist_sym[dist - 1] : enc->dist_sym[256 + ((dist - 1) >> 7)];
+}
+
+static void png_put_raw(png_enc_t *enc, const void *data, uint32_t size) {
+    if ((enc->idx + size) > enc->length) {
+        enc->overflow = true;
+        return;
+    }
+    memcpy(enc->buf + enc->idx, data, size);
+    enc->idx += size;
+}
+
+static void png_put_be32(png_enc_t *enc, uint32_t value) {
+    value = __REV(value);
+    png_put_raw(enc, &value, 4);
+}
+
+// Deflate packs bits starting with the least significant bit.
+static inline void png_put_bits(png_enc_t *enc, uint32_t bits, uint32_t count) {
+    enc->bitb |= ((uint64_t) bits) << enc->bitc;
+    enc->bitc += count;
+    if (enc->bitc >= 32) {
+        uint32_t word = enc->bitb;
+        png_put_raw(enc, &word, 4);
+        enc->bitb >>= 32;
+        enc->bitc -= 32;
+    }
+}
+
+static void png_flush_bits(png_enc_t *enc) {
+    while (enc->bitc) {
+        uint8_t byte = enc->bitb;
+        png_put_raw(enc, &byte, 1);
+        enc->bitb >>= 8;
+        enc->bitc = (enc->bitc > 8) ? (enc->bitc - 8) : 0;
+    }
+    enc->bitb = 0;
+}
+
+static void png_adler(png_enc_t *enc, const uint8_t *data, uint32_t size) {
+    uint32_t a = enc->adler_a, b = enc->adler_b;
+    while (size) {
+        // 5552 is the largest n such that the sums can't overflow 32 bits.
+        uint32_t n = IM_MIN(size, 5552U);
+        size -= n;
+        for (; n; n--) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    enc->adler_a = a;
+    enc->adler_b = b;
+}
+
+// Computes length limited Huffman code lengths (Moffat and Katajainen's in-place algorithm).
+static void png_huffman_lengths(const uint16_t *freq, int n, int max_len, uint8_t *lens) {
+    uint16_t syms[PNG_LL_CODES + 2];
+    uint32_t keys[PNG_LL_CODES + 2];
+    int used = 0;
+
+    memset(lens, 0, n);
+
+    // Insertion sort of the used symbols by frequency.
+    for (int i = 0; i < n; i++) {
+        if (freq[i]) {
+            int j = used++;
+            for (; (j > 0) && (keys[j - 1] > freq[i]); j--) {
+                keys[j] = keys[j - 1];
+                syms[j] = syms[j - 1];
+            }
+            keys[j] = freq[i];
+            syms[j] = i;
+        }
+    }
+
+    // A complete code needs at least two symbols.
+    if (used < 2) {
+        lens[(used && syms[0]) ? syms[0] : 0] = 1;
+        lens[(used && syms[0]) ? 0 : 1] = 1;
+        return;
+    }
+
+    keys[0] += keys[1];
+    int root = 0, leaf = 2;
+    for (int next = 1; next < (used - 1); next++) {
+        if ((leaf >= used) || (keys[root] < keys[leaf])) {
+            keys[next] = keys[root];
+            keys[root++] = next;
+        } else {
+            keys[next] = keys[leaf++];
+        }
+
+        if ((leaf >= used) || ((root < next) && (keys[root] < keys[leaf]))) {
+            keys[next] += keys[root];
+            keys[root++] = next;
+        } else {
+            keys[next] += keys[leaf++];
+        }
+    }
+
+    keys[used - 2] = 0;
+    for (int next = used - 3; next >= 0; next--) {
+        keys[next] = keys[keys[next]] + 1;
+    }
+
+    int avbl = 1, depth = 0, nodes = 0;
+    root = used - 2;
+    for (int next = used - 1; avbl > 0; depth++) {
+        for (; (root >= 0) && (keys[root] == depth); root--) {
+            nodes++;
+        }
+        for (; avbl > nodes; avbl--) {
+            keys[next--] = depth;
+        }
+        avbl = 2 * nodes;
+        nodes = 0;
+    }
+
+    // Limit the code lengths, then fix the Kraft sum.
+    int counts[33] = { 0 };
+    for (int i = 0; i < used; i++) {
+        counts[IM_MIN(keys[i], 32U)]++;
+    }
+
+    for (int i = max_len + 1; i <= 32; i++) {
+        counts[max_len] += counts[i];
+    }
+
+    uint32_t total = 0;
+    for (int i = max_len; i > 0; i--) {
+        total += ((uint32_t) counts[i]) << (max_len - i);
+    }
+
+    for (; total != (1UL << max_len); total--) {
+        counts[max_len]--;
+        for (int i = max_len - 1; i > 0; i--) {
+            if (counts[i]) {
+                counts[i]--;
+                counts[i + 1] += 2;
+                break;
+            }
+        }
+    }
+
+    // The least frequent symbols get the longest codes.
+    for (int i = max_len, j = 0; i > 0; i--) {
+        for (int k = counts[i]; k > 0; k--) {
+            lens[syms[j++]] = i;
+        }
+    }
+}
+
+// Generates canonical codes, bit reversed for the bit writer.
+static void png_huffman_codes(const uint8_t *lens, int n, uint16_t *codes) {
+    uint16_t counts[16] = { 0 }, next[16];
+
+    for (int i = 0; i < n; i++) {
+        counts[lens[i]]++;
+    }
+
+    counts[0] = 0;
+    for (int i = 1, code = 0; i < 16; i++) {
+        code = (code + counts[i - 1]) << 1;
+        next[i] = code;
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (lens[i]) {
+            uint32_t code = next[lens[i]]++;
+            codes[i] = __RBIT(code) >> (32 - lens[i]);
+        }
+    }
+}
+
+static void png_deflate_block(png_enc_t *enc, bool final) {
+    uint8_t lens[PNG_LL_CODES + PNG_D_CODES];
+    uint8_t rle_syms[PNG_LL_CODES + PNG_D_CODES], rle_extra[PNG_LL_CODES + PNG_D_CODES];
+    uint16_t cl_freq[PNG_CL_CODES] = { 0 }, cl_codes[PNG_CL_CODES];
+    uint8_t cl_lens[PNG_CL_CODES];
+    int nrle = 0;
+
+    enc->ll_freq[256] = 1; // End of block.
+    png_huffman_lengths(enc->ll_freq, PNG_LL_CODES + 2, 15, enc->ll_lens);
+    png_huffman_lengths(enc->d_freq, PNG_D_CODES, 15, enc->d_lens);
+
+    int hlit = PNG_LL_CODES, hdist = PNG_D_CODES;
+    for (; enc->ll_lens[hlit - 1] == 0; hlit--) {
+    }
+    for (; (hdist > 1) && (enc->d_lens[hdist - 1] == 0); hdist--) {
+    }
+
+    memcpy(lens, enc->ll_lens, hlit);
+    memcpy(lens + hlit, enc->d_lens, hdist);
+
+    // Run-length encode the code lengths.
+    for (int i = 0, total = hlit + hdist; i < total;) {
+        int len = lens[i], run = 1;
+        for (; ((i + run) < total) && (lens[i + run] == len); run++) {
+        }
+        i += run;
+
+        if (len == 0) {
+            for (; run >= 11; run -= IM_MIN(run, 138)) {
+                rle_syms[nrle] = 18;
+                rle_extra[nrle++] = IM_MIN(run, 138) - 11;
+            }
+            if (run >= 3) {
+                rle_syms[nrle] = 17;
+                rle_extra[nrle++] = run - 3;
+                run = 0;
+            }
+        } else {
+            rle_syms[nrle] = len;
+            rle_extra[nrle++] = 0;
+            for (run--; run >= 3; run -= IM_MIN(run, 6)) {
+                rle_syms[nrle] = 16;
+                rle_extra[nrle++] = IM_MIN(run, 6) - 3;
+            }
+        }
+
+        for (; run > 0; run--) {
+            rle_syms[nrle] = len;
+            rle_extra[nrle++] = 0;
+        }
+    }
+
+    for (int i = 0; i < nrle; i++) {
+        cl_freq[rle_syms[i]]++;
+    }
+
+    png_huffman_lengths(cl_freq, PNG_CL_CODES, 7, cl_lens);
+    png_huffman_codes(cl_lens, PNG_CL_CODES, cl_codes);
+
+    int hclen = PNG_CL_CODES;
+    for (; (hclen > 4) && (cl_lens[png_cl_order[hclen - 1]] == 0); hclen--) {
+    }
+
+    // Pick the cheaper of the dynamic and the fixed codes (extra bits cost the same).
+    uint32_t dynamic_bits = 14 + (hclen * 3), fixed_bits = 0;
+    for (int i = 0; i < nrle; i++) {
+        dynamic_bits += cl_lens[rle_syms[i]] + ((rle_syms[i] == 16) ? 2 : (rle_syms[i] == 17) ? 3 : (rle_syms[i] == 18) ? 7 : 0);
+    }
+
+    for (int i = 0; i < PNG_LL_CODES; i++) {
+        dynamic_bits += enc->ll_freq[i] * enc->ll_lens[i];
+        fixed_bits += enc->ll_freq[i] * ((i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8);
+    }
+
+    for (int i = 0; i < PNG_D_CODES; i++) {
+        dynamic_bits += enc->d_freq[i] * enc->d_lens[i];
+        fixed_bits += enc->d_freq[i] * 5;
+    }
+
+    png_put_bits(enc, final, 1);
+
+    if (fixed_bits <= dynamic_bits) {
+        png_put_bits(enc, 1, 2);
+        for (int i = 0; i < (PNG_LL_CODES + 2); i++) {
+            enc->ll_lens[i] = (i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8;
+        }
+        memset(enc->d_lens, 5, PNG_D_CODES);
+    } else {
+        png_put_bits(enc, 2, 2);
+        png_put_bits(enc, hlit - 257, 5);
+        png_put_bits(enc, hdist - 1, 5);
+        png_put_bits(enc, hclen - 4, 4);
+
+        for (int i = 0; i < hclen; i++) {
+            png_put_bits(enc, cl_lens[png_cl_order[i]], 3);
+        }
+
+        for (int i = 0; i < nrle; i++) {
+            int sym = rle_syms[i];
+            png_put_bits(enc, cl_codes[sym], cl_lens[sym]);
+            if (sym >= 16) {
+                png_put_bits(enc, rle_extra[i], (sym == 16) ? 2 : (sym == 17) ? 3 : 7);
+            }
+        }
+    }
+
+    png_huffman_codes(enc->ll_lens, PNG_LL_CODES + 2, enc->ll_codes);
+    png_huffman_codes(enc->d_lens, PNG_D_CODES, enc->d_codes);
+
+    for (uint32_t i = 0; i < enc->nsyms; i++) {
+        uint32_t ll = enc->syms_ll[i];
+        uint32_t dist = enc->syms_dist[i];
+        if (!dist) {
+            png_put_bits(enc, enc->ll_codes[ll], enc->ll_lens[ll]);
+        } else {
+            uint32_t len = ll - 256;
+            uint32_t sym = enc->len_sym[len];
+            png_put_bits(enc, enc->ll_codes[257 + sym], enc->ll_lens[257 + sym]);
+            png_put_bits(enc, len + PNG_MIN_MATCH - png_len_base[sym], png_len_extra[sym]);
+            sym = png_dist_sym(enc, dist);
+            png_put_bits(enc, enc->d_codes[sym], enc->d_lens[sym]);
+            png_put_bits(enc, dist - png_dist_base[sym], png_dist_extra[sym]);
+        }
+    }
+
+    png_put_bits(enc, enc->ll_codes[256], enc->ll_lens[256]);
+
+    memset(enc->ll_freq, 0, sizeof(enc->ll_freq));
+    memset(enc->d_freq, 0, sizeof(enc->d_freq));
+    enc->nsyms = 0;
+}
+
+static inline uint32_t png_hash(const uint8_t *data) {
+    return (((data[0] << 16) | (data[1] << 8) | data[2]) * 2654435761U) >> (32 - PNG_HASH_BITS);
+}
+
+static inline void png_insert(png_enc_t *enc, uint32_t pos) {
+    uint32_t hash = png_hash(enc->window + pos);
+    enc->prev[pos & PNG_WINDOW_MASK] = enc->head[hash];
+    enc->head[hash] = pos;
+}
+
+// Finds matches for the window data, keeping a full match length of look-ahead unless done.
+static void png_deflate_process(png_enc_t *enc, bool done) {
+    uint8_t *window = enc->window;
+    uint32_t limit = done ? enc->wend : ((enc->wend > PNG_MAX_MATCH) ? (enc->wend - PNG_MAX_MATCH) : 0);
+
+    while (enc->wpos < limit) {
+        uint32_t pos = enc->wpos;
+        uint32_t max_len = IM_MIN(enc->wend - pos, (uint32_t) PNG_MAX_MATCH);
+        uint32_t best_len = 0, best_dist = 0;
+
+        if (max_len >= PNG_MIN_MATCH) {
+            if (enc->effort == PNG_EFFORT_FAST) {
+                // Run-length matches only, filtered rows have long runs in flat areas.
+                if (pos) {
+                    uint8_t last = window[pos - 1];
+                    for (; (best_len < max_len) && (window[pos + best_len] == last); best_len++) {
+                    }
+                    best_dist = 1;
+                }
+            } else {
+                int32_t cur = enc->head[png_hash(window + pos)];
+                png_insert(enc, pos);
+
+                for (int chain = PNG_MAX_CHAIN; (cur >= 0) && chain; chain--) {
+                    uint32_t dist = pos - cur;
+                    if (dist >= PNG_WINDOW_SIZE) {
+                        break;
+                    }
+
+                    if (window[cur + best_len] == window[pos + best_len]) {
+                        uint32_t len = 0;
+                        for (; (len < max_len) && (window[cur + len] == window[pos + len]); len++) {
+                        }
+                        if (len > best_len) {
+                            best_len = len;
+                            best_dist = dist;
+                            if (len == max_len) {
+                                break;
+                            }
+                        }
+                    }
+
+                    int32_t next = enc->prev[cur & PNG_WINDOW_MASK];
+                    if (next >= cur) {
+                        break;
+                    }
+                    cur = next;
+                }
+            }
+        }
+
+        if (best_len >= PNG_MIN_MATCH) {
+            enc->syms_ll[enc->nsyms] = 256 + best_len - PNG_MIN_MATCH;
+            enc->syms_dist[enc->nsyms++] = best_dist;
+            enc->ll_freq[257 + enc->len_sym[best_len - PNG_MIN_MATCH]]++;
+            enc->d_freq[png_dist_sym(enc, best_dist)]++;
+
+            if (enc->effort == PNG_EFFORT_BEST) {
+                for (uint32_t i = 1; (i < best_len) && ((pos + i + PNG_MIN_MATCH) <= enc->wend); i++) {
+                    png_insert(enc, pos + i);
+                }
+            }
+
+            enc->wpos += best_len;
+        } else {
+            enc->syms_ll[enc->nsyms] = window[pos];
+            enc->syms_dist[enc->nsyms++] = 0;
+            enc->ll_freq[window[pos]]++;
+            enc->wpos += 1;
+        }
+
+        if (enc->nsyms == PNG_SYMBOLS) {
+            png_deflate_block(enc, false);
+        }
+    }
+}
+
+static void png_deflate_slide(png_enc_t *enc) {
+    memmove(enc->window, enc->window + PNG_WINDOW_SIZE, PNG_WINDOW_SIZE);
+    enc->wpos -= PNG_WINDOW_SIZE;
+    enc->wend -= PNG_WINDOW_SIZE;
+
+    if (enc->effort == PNG_EFFORT_BEST) {
+        for (int i = 0; i < PNG_HASH_SIZE; i++) {
+            enc->head[i] = (enc->head[i] >= PNG_WINDOW_SIZE) ? (enc->head[i] - PNG_WINDOW_SIZE) : -1;
+        }
+        for (int i = 0; i < PNG_WINDOW_SIZE; i++) {
+            enc->prev[i] = (enc->prev[i] >= PNG_WINDOW_SIZE) ? (enc->prev[i] - PNG_WINDOW_SIZE) : -1;
+        }
+    }
+}
+
+static void png_deflate(png_enc_t *enc, const uint8_t *data, uint32_t size, bool final) {
+    png_adler(enc, data, size);
+
+    if (enc->effort == PNG_EFFORT_STORED) {
+        do {
+            uint32_t len = IM_MIN(size, (uint32_t) PNG_STORED_MAX);
+            size -= len;
+            png_put_bits(enc, final && (!size), 1);
+            png_put_bits(enc, 0, 2);
+            png_flush_bits(enc);
+            png_put_bits(enc, len | ((len ^ 0xFFFF) << 16), 32);
+            png_put_raw(enc, data, len);
+            data += len;
+        } while (size);
+        return;
+    }
+
+    while (size) {
+        if (enc->wend == (PNG_WINDOW_SIZE * 2)) {
+            png_deflate_slide(enc);
+        }
+        uint32_t len = IM_MIN(size, (PNG_WINDOW_SIZE * 2) - enc->wend);
+        memcpy(enc->window + enc->wend, data, len);
+        enc->wend += len;
+        data += len;
+        size -= len;
+        png_deflate_process(enc, false);
+    }
+
+    if (final) {
+        png_deflate_process(enc, true);
+        png_deflate_block(enc, true);
+    }
+}
+
+// Applies the PNG row filter, bpp is the number of bytes per complete pixel.
+static void png_filter_row(uint8_t *dst, int filter, const uint8_t *row, const uint8_t *prev, uint32_t size, uint32_t bpp) {
+    dst[0] = filter;
+    dst += 1;
+    switch (filter) {
+        case 0:
+            memcpy(dst, row, size);
+            break;
+        case 1:
+            for (uint32_t i = 0; i < size; i++) {
+                dst[i] = row[i] - ((i >= bpp) ? row[i - bpp] : 0);
+            }
+            break;
+        case 2:
+            for (uint32_t i = 0; i < size; i++) {
+                dst[i] = row[i] - prev[i];
+            }
+            break;
+        case 3:
+            for (uint32_t i = 0; i < size; i++) {
+                dst[i] = row[i] - ((((i >= bpp) ? row[i - bpp] : 0) + prev[i]) >> 1);
+            }
+            break;
+        case 4:
+            for (uint32_t i = 0; i < size; i++) {
+                int a = (i >= bpp) ? row[i - bpp] : 0;
+                int b = prev[i];
+                int c = (i >= bpp) ? prev[i - bpp] : 0;
+                int pa = abs(b - c), pb = abs(a - c), pc = abs(a + b - c - c);
+                dst[i] = row[i] - (((pa <= pb) && (pa <= pc)) ? a : (pb <= pc) ? b : c);
+            }
+            break;
+    }
+}
+
+static uint32_t png_filter_cost(const uint8_t *data, uint32_t size) {
+    uint32_t cost = 0;
+    for (uint32_t i = 0; i < size; i++) {
+        cost += abs((int8_t) data[i]);
+    }
+    return cost;
+}
+
+bool png_compress(image_t *src, image_t *dst, png_effort_t effort) {
+    OMV_PROFILE_START(png_compress);
+
+    if (src->is_compressed) {
+        return true;
+    }
+
+    int bpp;
+    switch (src->pixfmt) {
+        case PIXFORMAT_BINARY:
+        case PIXFORMAT_GRAYSCALE:
+            bpp = 1;
+            break;
+        case PIXFORMAT_RGB565:
+            bpp = 3;
+            break;
+        default:
+            mp_raise_msg_varg(&mp_type_RuntimeError, MP_ERROR_TEXT("Input format is not supported"));
+            break;
+    }
+
+    uint32_t row_bytes = src->w * bpp;
+    uint32_t arena_size = png_arena_size(effort, row_bytes);
+    uint8_t *arena;
+    bool free_arena = false;
+
+    // When compressing to a new buffer the arena is placed at the end of the output.
+    if (!dst->data) {
+        uint32_t size = 0;
+        dst->data = fb_alloc_all(&size, FB_ALLOC_PREFER_SIZE | FB_ALLOC_CACHE_ALIGN);
+        if (size < (arena_size + 1024)) {
+            fb_free();
+            dst->data = NULL;
+            return true;
+        }
+        dst->size = size - arena_size;
+        arena = dst->data + dst->size;
+    } else {
+        dst->size = image_size(dst);
+        arena = fb_alloc(arena_size, FB_ALLOC_NO_HINT);
+        free_arena = true;
+    }
+
+    png_enc_t *enc = png_arena_take(&arena, sizeof(png_enc_t));
+    memset(enc, 0, sizeof(png_enc_t));
+    enc->buf = dst->data;
+    enc->length = dst->size;
+    enc->effort = effort;
+    enc->adler_a = 1;
+    enc->crc_table = png_arena_take(&arena, 256 * sizeof(uint32_t));
+    enc->len_sym = png_arena_take(&arena, 256);
+    enc->dist_sym = png_arena_take(&arena, 512);
+    png_init_tables(enc);
+
+    uint8_t *row = png_arena_take(&arena, row_bytes);
+    uint8_t *prev = png_arena_take(&arena, row_bytes);
+    uint8_t *line = png_arena_take(&arena, row_bytes + 1);
+    uint8_t *trial = png_arena_take(&arena, row_bytes + 1);
+
+    if (effort != PNG_EFFORT_STORED) {
+        enc->window = png_arena_take(&arena, PNG_WINDOW_SIZE * 2);
+        enc->syms_ll = png_arena_take(&arena, PNG_SYMBOLS * sizeof(uint16_t));
+        enc->syms_dist = png_arena_take(&arena, PNG_SYMBOLS * sizeof(uint16_t));
+    }
+
+    if (effort == PNG_EFFORT_BEST) {
+        enc->head = png_arena_take(&arena, PNG_HASH_SIZE * sizeof(int16_t));
+        enc->prev = png_arena_take(&arena, PNG_WINDOW_SIZE * sizeof(int16_t));
+        memset(enc->head, 0xFF, PNG_HASH_SIZE * sizeof(int16_t));
+        memset(enc->prev, 0xFF, PNG_WINDOW_SIZE * sizeof(int16_t));
+    }
+
+    // Signature and header.
+    uint8_t ihdr[17] = { 'I', 'H', 'D', 'R' };
+    uint32_t dims[2] = { __REV(src->w), __REV(src->h) };
+    memcpy(ihdr + 4, dims, sizeof(dims));
+    ihdr[12] = 8; // Bit depth.
+    ihdr[13] = (bpp == 3) ? 2 : 0; // Color type RGB or grayscale.
+    png_put_raw(enc, png_signature, sizeof(png_signature));
+    png_put_be32(enc, 13);
+    png_put_raw(enc, ihdr, 17);
+    png_put_be32(enc, png_crc(enc, 0xFFFFFFFF, ihdr, 17) ^ 0xFFFFFFFF);
+
+    // Image data, the chunk length is patched in when done.
+    uint32_t idat = enc->idx;
+    png_put_be32(enc, 0);
+    png_put_raw(enc, "IDAT", 4);
+    png_put_raw(enc, (uint8_t []) { 0x78, 0x01 }, 2);
+
+    // Grayscale rows are filtered straight from the image, others are converted first.
+    const uint8_t *last = memset(prev, 0, row_bytes);
+
+    for (int y = 0; (y < src->h) && (!enc->overflow); y++) {
+        const uint8_t *cur = row;
+        switch (src->pixfmt) {
+            case PIXFORMAT_BINARY: {
+                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(src, y);
+                for (int x = 0; x < src->w; x++) {
+                    row[x] = IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x) ? 255 : 0;
+                }
+                break;
+            }
+            case PIXFORMAT_GRAYSCALE: {
+                cur = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src, y);
+                break;
+            }
+            case PIXFORMAT_RGB565: {
+                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(src, y);
+                for (int x = 0; x < src->w; x++) {
+                    int pixel = row_ptr[x];
+                    row[(x * 3) + 0] = COLOR_RGB565_TO_R8(pixel);
+                    row[(x * 3) + 1] = COLOR_RGB565_TO_G8(pixel);
+                    row[(x * 3) + 2] = COLOR_RGB565_TO_B8(pixel);
+                }
+                break;
+            }
+        }
+
+        if (effort == PNG_EFFORT_STORED) {
+            png_filter_row(line, 0, cur, last, row_bytes, bpp);
+        } else if (effort == PNG_EFFORT_FAST) {
+            png_filter_row(line, 1, cur, last, row_bytes, bpp);
+        } else {
+            // Pick the filter with the smallest sum of absolute differences.
+            uint32_t best_cost = UINT32_MAX;
+            for (int filter = 0; filter < 5; filter++) {
+                png_filter_row(trial, filter, cur, last, row_bytes, bpp);
+                uint32_t cost = png_filter_cost(trial + 1, row_bytes);
+                if (cost < best_cost) {
+                    uint8_t *tmp = line;
+                    line = trial;
+                    trial = tmp;
+                    best_cost = cost;
+                }
+            }
+        }
+
+        png_deflate(enc, line, row_bytes + 1, y == (src->h - 1));
+
+        if (cur == row) {
+            uint8_t *tmp = prev;
+            prev = row;
+            row = tmp;
+        }
+        last = cur;
+    }
+
+    png_flush_bits(enc);
+    png_put_be32(enc, (enc->adler_b << 16) | enc->adler_a);
+
+    if (!enc->overflow) {
+        uint32_t idat_size = enc->idx - idat - 8;
+        uint32_t idat_len = __REV(idat_size);
+        memcpy(enc->buf + idat, &idat_len, 4);
+        png_put_be32(enc, png_crc(enc, 0xFFFFFFFF, enc->buf + idat + 4, idat_size + 4) ^ 0xFFFFFFFF);
+        png_put_be32(enc, 0);
+        png_put_raw(enc, "IEND", 4);
+        png_put_be32(enc, 0xAE426082);
+    }
+
+    bool overflow = enc->overflow;
+    dst->size = enc->idx;
+
+    if (free_arena) {
+        fb_free();
+    }
+
+    OMV_PROFILE_END(png_compress);
+    return overflow;
+}
+#endif // IMLIB_ENABLE_PNG_ENCODER
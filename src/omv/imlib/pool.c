@@ -0,0 +1,217 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Integer factor downscaling.
+ *
+ * The y_div rows of a block row are reduced into a row accumulator with vector operations,
+ * then every x_div columns of the accumulator are reduced to one output pixel.
+ */
+#include "imlib.h"
+#include "fb_alloc.h"
+#include "simd.h"
+
+// Sums y_div rows of w grayscale pixels into acc.
+static void pool_sum_rows_grayscale(image_t *img, int x, int y, int w, int y_div, uint16_t *acc) {
+    memset(acc, 0, w * sizeof(uint16_t));
+
+    for (int i = 0; i < y_div; i++) {
+        uint8_t *row = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y + i) + x;
+
+        for (int j = 0; j < w; j += UINT16_VECTOR_SIZE) {
+            v128_predicate_t pred = vpredicate_16(w - j);
+            v128_t sum = vadd_u16(vldr_u16_pred(acc + j, pred), vldr_u8_widen_u16_pred(row + j, pred));
+            vstr_u16_pred(acc + j, sum, pred);
+        }
+    }
+}
+
+// Sums y_div rows of w RGB565 pixels into the per channel accumulators.
+static void pool_sum_rows_rgb565(image_t *img, int x, int y, int w, int y_div,
+                                 uint16_t *r_acc, uint16_t *g_acc, uint16_t *b_acc) {
+    v128_t mask5 = vdup_u16(0x1f);
+    v128_t mask6 = vdup_u16(0x3f);
+
+    memset(r_acc, 0, w * sizeof(uint16_t));
+    memset(g_acc, 0, w * sizeof(uint16_t));
+    memset(b_acc, 0, w * sizeof(uint16_t));
+
+    for (int i = 0; i < y_div; i++) {
+        uint16_t *row = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y + i) + x;
+
+        for (int j = 0; j < w; j += UINT16_VECTOR_SIZE) {
+            v128_predicate_t pred = vpredicate_16(w - j);
+            v128_t pixels = vldr_u16_pred(row + j, pred);
+            v128_t r = vadd_u16(vldr_u16_pred(r_acc + j, pred), vlsr_u16(pixels, 11));
+            v128_t g = vadd_u16(vldr_u16_pred(g_acc + j, pred), vand_u32(vlsr_u16(pixels, 5), mask6));
+            v128_t b = vadd_u16(vldr_u16_pred(b_acc + j, pred), vand_u32(pixels, mask5));
+            vstr_u16_pred(r_acc + j, r, pred);
+            vstr_u16_pred(g_acc + j, g, pred);
+            vstr_u16_pred(b_acc + j, b, pred);
+        }
+    }
+}
+
+static inline uint32_t pool_sum_block(const uint16_t *acc, int x_div) {
+    uint32_t sum = 0;
+    for (int i = 0; i < x_div; i++) {
+        sum += acc[i];
+    }
+    return sum;
+}
+
+void imlib_mean_pool_rows(image_t *img, rectangle_t *roi, int x_div, int y_div, imlib_pool_out_t out,
+                          imlib_pool_row_cb_t cb, void *arg) {
+    int w = (roi->w / x_div) * x_div;
+    int ow = roi->w / x_div;
+    int oh = roi->h / y_div;
+    uint32_t n = x_div * y_div;
+    size_t out_bpp = (out == IMLIB_POOL_OUT_GRAYSCALE) ? 1 : ((out == IMLIB_POOL_OUT_RGB565) ? 2 : 3);
+
+    fb_alloc_mark();
+    uint8_t *out_row = fb_alloc(ow * out_bpp, FB_ALLOC_NO_HINT);
+
+    if (img->pixfmt == PIXFORMAT_GRAYSCALE) {
+        uint16_t *acc = fb_alloc(w * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+
+        for (int oy = 0; oy < oh; oy++) {
+            pool_sum_rows_grayscale(img, roi->x, roi->y + (oy * y_div), w, y_div, acc);
+
+            for (int ox = 0; ox < ow; ox++) {
+                int y = pool_sum_block(acc + (ox * x_div), x_div) / n;
+
+                if (out == IMLIB_POOL_OUT_GRAYSCALE) {
+                    out_row[ox] = y;
+                } else if (out == IMLIB_POOL_OUT_RGB565) {
+                    ((uint16_t *) out_row)[ox] = COLOR_Y_TO_RGB565(y);
+                } else {
+                    out_row[(ox * 3) + 0] = y;
+                    out_row[(ox * 3) + 1] = y;
+                    out_row[(ox * 3) + 2] = y;
+                }
+            }
+
+            cb(oy, out_row, arg);
+        }
+    } else {
+        uint16_t *r_acc = fb_alloc(w * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+        uint16_t *g_acc = fb_alloc(w * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+        uint16_t *b_acc = fb_alloc(w * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+
+        for (int oy = 0; oy < oh; oy++) {
+            pool_sum_rows_rgb565(img, roi->x, roi->y + (oy * y_div), w, y_div, r_acc, g_acc, b_acc);
+
+            for (int ox = 0; ox < ow; ox++) {
+                // Scale the 5/6-bit sums straight to 8-bits to keep the precision gained by pooling.
+                int r = (pool_sum_block(r_acc + (ox * x_div), x_div) * 255) / (n * 31);
+                int g = (pool_sum_block(g_acc + (ox * x_div), x_div) * 255) / (n * 63);
+                int b = (pool_sum_block(b_acc + (ox * x_div), x_div) * 255) / (n * 31);
+
+                if (out == IMLIB_POOL_OUT_GRAYSCALE) {
+                    out_row[ox] = COLOR_RGB888_TO_Y(r, g, b);
+                } else if (out == IMLIB_POOL_OUT_RGB565) {
+                    ((uint16_t *) out_row)[ox] = COLOR_R8_G8_B8_TO_RGB565(r, g, b);
+                } else {
+                    out_row[(ox * 3) + 0] = r;
+                    out_row[(ox * 3) + 1] = g;
+                    out_row[(ox * 3) + 2] = b;
+                }
+            }
+
+            cb(oy, out_row, arg);
+        }
+    }
+
+    fb_alloc_free_till_mark();
+}
+
+static void pool_image_row(int y, const void *row, void *arg) {
+    image_t *img = (image_t *) arg;
+    size_t size = image_line_size(img);
+    memcpy(img->data + (y * size), row, size);
+}
+
+void imlib_mean_pool(image_t *img_i, image_t *img_o, int x_div, int y_div) {
+    rectangle_t roi = {0, 0, img_i->w, img_i->h};
+    imlib_pool_out_t out = (img_i->pixfmt == PIXFORMAT_GRAYSCALE) ? IMLIB_POOL_OUT_GRAYSCALE : IMLIB_POOL_OUT_RGB565;
+    // Output row y is written after reading input rows y * y_div and up, so it can be in place.
+    imlib_mean_pool_rows(img_i, &roi, x_div, y_div, out, pool_image_row, img_o);
+}
+
+// Blends the min and max of each channel, a bias of 0 is the min and 256 the max.
+#define POOL_MIDPOINT(min, max, bias) ((((min) * (256 - (bias))) + ((max) * (bias))) >> 8)
+
+void imlib_midpoint_pool(image_t *img_i, image_t *img_o, int x_div, int y_div, const int bias) {
+    int ow = img_i->w / x_div;
+    int oh = img_i->h / y_div;
+    int w = ow * x_div;
+
+    fb_alloc_mark();
+
+    if (img_i->pixfmt == PIXFORMAT_GRAYSCALE) {
+        uint8_t *min_acc = fb_alloc(w, FB_ALLOC_PREFER_SPEED);
+        uint8_t *max_acc = fb_alloc(w, FB_ALLOC_PREFER_SPEED);
+
+        for (int oy = 0; oy < oh; oy++) {
+            memset(min_acc, 0xff, w);
+            memset(max_acc, 0x00, w);
+
+            for (int i = 0; i < y_div; i++) {
+                uint8_t *row = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img_i, (oy * y_div) + i);
+
+                for (int j = 0; j < w; j += UINT8_VECTOR_SIZE) {
+                    v128_predicate_t pred = vpredicate_8(w - j);
+                    v128_t pixels = vldr_u8_pred(row + j, pred);
+                    vstr_u8_pred(min_acc + j, vmin_u8(vldr_u8_pred(min_acc + j, pred), pixels), pred);
+                    vstr_u8_pred(max_acc + j, vmax_u8(vldr_u8_pred(max_acc + j, pred), pixels), pred);
+                }
+            }
+
+            uint8_t *out_row = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img_o, oy);
+            for (int ox = 0, j = 0; ox < ow; ox++) {
+                int min = 255, max = 0;
+                for (int k = 0; k < x_div; k++, j++) {
+                    min = IM_MIN(min, min_acc[j]);
+                    max = IM_MAX(max, max_acc[j]);
+                }
+                out_row[ox] = POOL_MIDPOINT(min, max, bias);
+            }
+        }
+    } else {
+        for (int oy = 0; oy < oh; oy++) {
+            uint16_t *out_row = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img_o, oy);
+
+            for (int ox = 0; ox < ow; ox++) {
+                int r_min = 31, g_min = 63, b_min = 31;
+                int r_max = 0, g_max = 0, b_max = 0;
+
+                for (int i = 0; i < y_div; i++) {
+                    uint16_t *row = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img_i, (oy * y_div) + i) + (ox * x_div);
+
+                    for (int k = 0; k < x_div; k++) {
+                        int pixel = row[k];
+                        int r = COLOR_RGB565_TO_R5(pixel);
+                        int g = COLOR_RGB565_TO_G6(pixel);
+                        int b = COLOR_RGB565_TO_B5(pixel);
+                        r_min = IM_MIN(r_min, r);
+                        r_max = IM_MAX(r_max, r);
+                        g_min = IM_MIN(g_min, g);
+                        g_max = IM_MAX(g_max, g);
+                        b_min = IM_MIN(b_min, b);
+                        b_max = IM_MAX(b_max, b);
+                    }
+                }
+
+                out_row[ox] = COLOR_R5_G6_B5_TO_RGB565(POOL_MIDPOINT(r_min, r_max, bias),
+                                                       POOL_MIDPOINT(g_min, g_max, bias),
+                                                       POOL_MIDPOINT(b_min, b_max, bias));
+            }
+        }
+    }
+
+    fb_alloc_free_till_mark();
+}
@@ -85,41 +85,63 @@ void ppm_read_geometry(FIL *fp, image_t *img, const char *path, ppm_read_setting
     }
 }
 
-// This function reads the pixel values of an image.
-void ppm_read_pixels(FIL *fp, image_t *img, int n_lines, ppm_read_settings_t *rs) {
+#define PPM_READ_CHUNK_PIXELS   (64)
+
+// This function reads the next row of the file into row, or skips it if row is NULL.
+void ppm_read_row(FIL *fp, image_t *img, void *row, ppm_read_settings_t *rs) {
     if (rs->ppm_fmt == '2') {
-        for (int i = 0; i < n_lines; i++) {
-            for (int j = 0; j < img->w; j++) {
-                uint32_t pixel;
-                read_int(fp, &pixel, rs);
-                IM_SET_GS_PIXEL(img, j, i, pixel);
+        uint8_t *row8 = (uint8_t *) row;
+        for (int j = 0; j < img->w; j++) {
+            uint32_t pixel;
+            read_int(fp, &pixel, rs);
+            if (row8) {
+                row8[j] = pixel;
             }
         }
     } else if (rs->ppm_fmt == '3') {
-        for (int i = 0; i < n_lines; i++) {
-            for (int j = 0; j < img->w; j++) {
-                uint32_t r, g, b;
-                read_int(fp, &r, rs);
-                read_int(fp, &g, rs);
-                read_int(fp, &b, rs);
-                IM_SET_RGB565_PIXEL(img, j, i, COLOR_R8_G8_B8_TO_RGB565(r, g, b));
+        uint16_t *row16 = (uint16_t *) row;
+        for (int j = 0; j < img->w; j++) {
+            uint32_t r, g, b;
+            read_int(fp, &r, rs);
+            read_int(fp, &g, rs);
+            read_int(fp, &b, rs);
+            if (row16) {
+                row16[j] = COLOR_R8_G8_B8_TO_RGB565(r, g, b);
             }
         }
     } else if (rs->ppm_fmt == '5') {
-        file_read(fp, img->pixels, n_lines * img->w);
+        if (row) {
+            file_read(fp, row, img->w);
+        } else {
+            file_seek(fp, file_tell(fp) + img->w);
+        }
     } else if (rs->ppm_fmt == '6') {
-        for (int i = 0; i < n_lines; i++) {
-            for (int j = 0; j < img->w; j++) {
-                uint8_t r, g, b;
-                file_read(fp, &r, 1);
-                file_read(fp, &g, 1);
-                file_read(fp, &b, 1);
-                IM_SET_RGB565_PIXEL(img, j, i, COLOR_R8_G8_B8_TO_RGB565(r, g, b));
+        if (row) {
+            uint16_t *row16 = (uint16_t *) row;
+
+            // Converted in chunks so the reads stay large without a row sized buffer.
+            for (int x = 0; x < img->w; x += PPM_READ_CHUNK_PIXELS) {
+                uint8_t buf[PPM_READ_CHUNK_PIXELS * 3];
+                int n = IM_MIN(img->w - x, PPM_READ_CHUNK_PIXELS);
+                file_read(fp, buf, n * 3);
+
+                for (int i = 0; i < n; i++) {
+                    row16[x + i] = COLOR_R8_G8_B8_TO_RGB565(buf[i * 3], buf[(i * 3) + 1], buf[(i * 3) + 2]);
+                }
             }
+        } else {
+            file_seek(fp, file_tell(fp) + (img->w * 3));
         }
     }
 }
 
+// This function reads the pixel values of an image.
+void ppm_read_pixels(FIL *fp, image_t *img, int n_lines, ppm_read_settings_t *rs) {
+    for (int i = 0; i < n_lines; i++) {
+        ppm_read_row(fp, img, img->pixels + (i * img->w * img->bpp), rs);
+    }
+}
+
 void ppm_read(image_t *img, const char *path) {
     FIL fp;
     ppm_read_settings_t rs;
@@ -0,0 +1,72 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Grayscale image pyramid.
+ *
+ * Each level is area downscaled from the previous level and smoothed with a 3x3
+ * gaussian, so the pyramid is built in one incremental pass per frame and can be
+ * shared by all the multi-scale detectors that run on that frame.
+ */
+#include "imlib.h"
+
+#ifdef IMLIB_ENABLE_FIND_KEYPOINTS
+
+size_t imlib_pyramid_init(imlib_pyramid_t *pyr, int w, int h, float scale, int max_levels) {
+    size_t size = 0;
+    float level_scale = scale;
+
+    pyr->w = w;
+    pyr->h = h;
+    pyr->scale = scale;
+    pyr->n_levels = 0;
+    pyr->built = false;
+
+    for (int i = 0; i < IM_MIN(max_levels, IMLIB_PYRAMID_MAX_LEVELS); i++, level_scale *= scale) {
+        image_t *level = &pyr->levels[i];
+        level->w = (int) roundf(w / level_scale);
+        level->h = (int) roundf(h / level_scale);
+        level->pixfmt = PIXFORMAT_GRAYSCALE;
+        level->size = 0;
+        level->data = NULL;
+
+        if ((level->w < IMLIB_PYRAMID_MIN_SIZE) || (level->h < IMLIB_PYRAMID_MIN_SIZE)) {
+            break;
+        }
+
+        size += image_size(level);
+        pyr->n_levels += 1;
+    }
+
+    return size;
+}
+
+void imlib_pyramid_set_buffer(imlib_pyramid_t *pyr, uint8_t *buffer) {
+    for (int i = 0; i < pyr->n_levels; i++) {
+        pyr->levels[i].data = buffer;
+        buffer += image_size(&pyr->levels[i]);
+    }
+}
+
+void imlib_pyramid_build(imlib_pyramid_t *pyr, image_t *img) {
+    image_t *src = img;
+
+    for (int i = 0; i < pyr->n_levels; i++) {
+        image_t *dst = &pyr->levels[i];
+        float x_scale = dst->w / ((float) src->w);
+        float y_scale = dst->h / ((float) src->h);
+
+        // Area scaling averages all the source pixels under each destination pixel (box filter).
+        imlib_draw_image(dst, src, 0, 0, x_scale, y_scale, NULL, -1, 256, NULL, NULL,
+                         IMAGE_HINT_AREA, NULL, NULL, NULL);
+        imlib_sepconv3(dst, kernel_gauss_3, 1.0f / 16.0f, 0.0f);
+        src = dst;
+    }
+
+    pyr->built = true;
+}
+#endif // IMLIB_ENABLE_FIND_KEYPOINTS
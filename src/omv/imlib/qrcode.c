@@ -257,6 +257,9 @@ struct quirc {
     quirc_pixel_t           *pixels;
     int                     w;
     int                     h;
+    int                     binarized;
+    int                     localize;
+    imlib_deadline_t        *deadline;
 
     int                     num_regions;
     struct quirc_region     regions[QUIRC_MAX_REGIONS];
@@ -841,18 +844,6 @@ typedef struct xylf
 }
 xylf_t;
 
-static void lifo_enqueue_fast(lifo_t *ptr, xylf_t *data)
-{
-    *((xylf_t *)(ptr->data + (ptr->len * ptr->data_len))) = *data;
-    ptr->len += 1;
-}
-
-static void lifo_dequeue_fast(lifo_t *ptr, xylf_t *data)
-{
-    ptr->len -= 1;
-    *data = *((xylf_t *)(ptr->data + (ptr->len * ptr->data_len)));
-}
-
 static void flood_fill_seed(struct quirc *q, int x, int y, int from, int to,
                             span_func_t func, void *user_data,
                             int depth)
@@ -884,7 +875,7 @@ static void flood_fill_seed(struct quirc *q, int x, int y, int from, int to,
             func(user_data, y, left, right);
 
         for(;;) {
-            if (/*lifo_size(&lifo)*/ lifo.len < lifo_len) {
+            if (lifo_is_not_full(&lifo)) {
                 /* Seed new flood-fills */
                 if (y > 0) {
                     row = q->pixels + (y - 1) * q->w;
@@ -897,7 +888,7 @@ static void flood_fill_seed(struct quirc *q, int x, int y, int from, int to,
                             context.y = y;
                             context.l = left;
                             context.r = right;
-                            lifo_enqueue_fast(&lifo, &context);
+                            lifo_enqueue_fast(&lifo, xylf_t, context);
                             x = i;
                             y = y - 1;
                             recurse = true;
@@ -918,7 +909,7 @@ static void flood_fill_seed(struct quirc *q, int x, int y, int from, int to,
                             context.y = y;
                             context.l = left;
                             context.r = right;
-                            lifo_enqueue_fast(&lifo, &context);
+                            lifo_enqueue_fast(&lifo, xylf_t, context);
                             x = i;
                             y = y + 1;
                             recurse = true;
@@ -929,13 +920,12 @@ static void flood_fill_seed(struct quirc *q, int x, int y, int from, int to,
                 }
             }
 
-            if (!lifo.len /*lifo_size(&lifo)*/) {
+            if (!lifo_is_not_empty(&lifo)) {
                 lifo_free(&lifo);
                 return;
             }
 
-            xylf_t context;
-            lifo_dequeue_fast(&lifo, &context);
+            xylf_t context = lifo_dequeue_fast(&lifo, xylf_t);
             x = context.x;
             y = context.y;
             left = context.l;
@@ -1015,6 +1005,15 @@ static void threshold(struct quirc *q)
     }
 } /* threshold() */
 
+// The image is already black and white (0 or 255), so skip the adaptive threshold.
+static void threshold_binarized(struct quirc *q)
+{
+    quirc_pixel_t *row = q->pixels;
+
+    for (int i = 0, j = q->w * q->h; i < j; i++)
+        row[i] = (row[i] < 128) ? QUIRC_PIXEL_BLACK : QUIRC_PIXEL_WHITE;
+}
+
 static void area_count(void *user_data, int y, int left, int right)
 {
     ((struct quirc_region *)user_data)->count += right - left + 1;
@@ -1634,7 +1633,9 @@ static void setup_qr_perspective(struct quirc *q, int index)
            sizeof(rect[0]));
     perspective_setup(qr->c, rect, qr->grid_size - 7, qr->grid_size - 7);
 
-    jiggle_perspective(q, index);
+    /* Only the outline is needed when localizing */
+    if (!q->localize)
+        jiggle_perspective(q, index);
 }
 
 /* Rotate the capstone with so that corner 0 is the leftmost with respect
@@ -1897,13 +1898,23 @@ void quirc_end(struct quirc *q)
     int i;
 
     pixels_setup(q);
-    threshold(q);
 
-    for (i = 0; i < q->h; i++)
+    if (q->binarized)
+        threshold_binarized(q);
+    else
+        threshold(q);
+
+    for (i = 0; i < q->h; i++) {
+        if (imlib_deadline_expired(q->deadline))
+            return;
         finder_scan(q, i);
+    }
 
-    for (i = 0; i < q->num_capstones; i++)
+    for (i = 0; i < q->num_capstones; i++) {
+        if (imlib_deadline_expired(q->deadline))
+            return;
         test_grouping(q, i);
+    }
 }
 
 void quirc_extract(const struct quirc *q, int index,
@@ -2958,23 +2969,28 @@ const char *quirc_strerror(quirc_decode_error_t err)
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi)
+// Quiet zone in modules added around each code found by the decimated pre-scan.
+#define QRCODE_LOCALIZE_PADDING 4
+
+static void imlib_find_qrcodes_roi(list_t *out, image_t *ptr, rectangle_t *roi, imlib_deadline_t *deadline)
 {
     struct quirc *controller = quirc_new();
     quirc_resize(controller, roi->w, roi->h);
     uint8_t *grayscale_image = quirc_begin(controller, NULL, NULL);
 
-    image_t img;
+    image_t img = {};
     img.w = roi->w;
     img.h = roi->h;
     img.pixfmt = PIXFORMAT_GRAYSCALE;
     img.data = grayscale_image;
     imlib_draw_image(&img, ptr, 0, 0, 1.f, 1.f, roi, -1, 256, NULL, NULL, 0, NULL, NULL, NULL);
 
+    // A binary image was thresholded by the caller (and may be shared with other detectors).
+    controller->binarized = ptr->pixfmt == PIXFORMAT_BINARY;
+    controller->deadline = deadline;
     quirc_end(controller);
-    list_init(out, sizeof(find_qrcodes_list_lnk_data_t));
 
-    for (int i = 0, j = quirc_count(controller); i < j; i++) {
+    for (int i = 0, j = quirc_count(controller); (i < j) && !imlib_deadline_expired(deadline); i++) {
         struct quirc_code *code = fb_alloc(sizeof(struct quirc_code), FB_ALLOC_NO_HINT);
         struct quirc_data *data = fb_alloc(sizeof(struct quirc_data), FB_ALLOC_NO_HINT);
         quirc_extract(controller, i, code);
@@ -3019,4 +3035,122 @@ void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi)
 
     quirc_destroy(controller);
 }
+
+// Finds the finder patterns on a decimated copy of the roi and returns the padded (full
+// resolution) rects of the codes they form. Returns false if finder patterns were found
+// that could not be grouped into a code, in which case the whole roi should be scanned.
+static bool imlib_find_qrcodes_localize(list_t *rects, image_t *ptr, rectangle_t *roi, int decimate,
+                                        imlib_deadline_t *deadline)
+{
+    bool ok = true;
+    list_init(rects, sizeof(rectangle_t));
+
+    struct quirc *controller = quirc_new();
+    quirc_resize(controller, roi->w / decimate, roi->h / decimate);
+    uint8_t *grayscale_image = quirc_begin(controller, NULL, NULL);
+
+    image_t img = {};
+    img.w = roi->w / decimate;
+    img.h = roi->h / decimate;
+    img.pixfmt = PIXFORMAT_GRAYSCALE;
+    img.data = grayscale_image;
+    imlib_draw_image(&img, ptr, 0, 0, 1.f / decimate, 1.f / decimate, roi, -1, 256, NULL, NULL,
+                     IMAGE_HINT_AREA, NULL, NULL, NULL);
+
+    controller->localize = 1;
+    controller->deadline = deadline;
+    quirc_end(controller);
+
+    for (int i = 0; i < controller->num_capstones; i++) {
+        if (controller->capstones[i].qr_grid < 0) {
+            ok = false;
+        }
+    }
+
+    for (int i = 0; i < controller->num_grids; i++) {
+        struct quirc_grid *qr = &controller->grids[i];
+        float lo = -QRCODE_LOCALIZE_PADDING, hi = qr->grid_size + QRCODE_LOCALIZE_PADDING;
+        struct quirc_point corners[4];
+        perspective_map(qr->c, lo, lo, &corners[0]);
+        perspective_map(qr->c, hi, lo, &corners[1]);
+        perspective_map(qr->c, hi, hi, &corners[2]);
+        perspective_map(qr->c, lo, hi, &corners[3]);
+
+        int x_min = corners[0].x, y_min = corners[0].y, x_max = corners[0].x, y_max = corners[0].y;
+        for (int k = 1; k < 4; k++) {
+            x_min = IM_MIN(x_min, corners[k].x);
+            y_min = IM_MIN(y_min, corners[k].y);
+            x_max = IM_MAX(x_max, corners[k].x);
+            y_max = IM_MAX(y_max, corners[k].y);
+        }
+
+        // Back to full resolution, the extra decimated pixel absorbs rounding.
+        rectangle_t rect;
+        rect.x = roi->x + ((x_min - 1) * decimate);
+        rect.y = roi->y + ((y_min - 1) * decimate);
+        rect.w = (x_max - x_min + 3) * decimate;
+        rect.h = (y_max - y_min + 3) * decimate;
+
+        if (rectangle_overlap(&rect, roi)) {
+            rectangle_intersected(&rect, roi);
+            list_push_back(rects, &rect);
+        }
+    }
+
+    quirc_destroy(controller);
+
+    // Merge overlapping rects so no code is decoded twice.
+    for (bool merged = true; merged; ) {
+        merged = false;
+        for (size_t i = 0, j = list_size(rects); i < j && !merged; i++) {
+            rectangle_t rect;
+            list_pop_front(rects, &rect);
+
+            list_for_each(it, rects) {
+                rectangle_t *other = list_get_data(it);
+                if (rectangle_overlap(&rect, other)) {
+                    rectangle_united(other, &rect);
+                    merged = true;
+                    break;
+                }
+            }
+
+            if (!merged) {
+                list_push_back(rects, &rect);
+            }
+        }
+    }
+
+    return ok;
+}
+
+void imlib_find_qrcodes(list_t *out, image_t *ptr, rectangle_t *roi, int decimate, imlib_deadline_t *deadline)
+{
+    list_init(out, sizeof(find_qrcodes_list_lnk_data_t));
+
+    // Too small to find finder patterns in once decimated.
+    if ((roi->w / decimate) < 21 || (roi->h / decimate) < 21) {
+        decimate = 1;
+    }
+
+    if (decimate > 1) {
+        list_t rects;
+
+        if (imlib_find_qrcodes_localize(&rects, ptr, roi, decimate, deadline)
+            || imlib_deadline_expired(deadline)) {
+            while (list_size(&rects) && !imlib_deadline_expired(deadline)) {
+                rectangle_t rect;
+                list_pop_front(&rects, &rect);
+                imlib_find_qrcodes_roi(out, ptr, &rect, deadline);
+            }
+
+            list_free(&rects);
+            return;
+        }
+
+        list_free(&rects);
+    }
+
+    imlib_find_qrcodes_roi(out, ptr, roi, deadline);
+}
 #endif //IMLIB_ENABLE_QRCODES *INDENT-ON*
@@ -0,0 +1,231 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Run-length encoded binary image rows.
+ *
+ * A row is stored as a sorted list of non-adjacent [x_start, x_end) runs of
+ * set pixels, so a row never has more than (w + 1) / 2 runs. Operations on
+ * runs take time proportional to the number of runs instead of the width.
+ */
+#include "imlib.h"
+
+int imlib_rle_encode_row(const uint32_t *row, int w, imlib_rle_run_t *runs) {
+    int n = 0, start = -1;
+
+    for (int i = 0, words = (w + UINT32_T_MASK) >> UINT32_T_SHIFT; i < words; i++) {
+        uint32_t word = row[i];
+
+        if ((i == (words - 1)) && (w & UINT32_T_MASK)) {
+            word &= (1 << (w & UINT32_T_MASK)) - 1;
+        }
+
+        // Skip words that don't change the current state.
+        if (((start < 0) && (!word)) || ((start >= 0) && (word == UINT32_MAX))) {
+            continue;
+        }
+
+        for (int b = 0; b < UINT32_T_BITS;) {
+            uint32_t rem = ((start < 0) ? word : ~word) >> b;
+
+            if (!rem) {
+                break;
+            }
+
+            b += __builtin_ctz(rem);
+
+            if (start < 0) {
+                start = (i * UINT32_T_BITS) + b;
+            } else {
+                runs[n].x_start = start;
+                runs[n++].x_end = (i * UINT32_T_BITS) + b;
+                start = -1;
+            }
+        }
+    }
+
+    if (start >= 0) {
+        runs[n].x_start = start;
+        runs[n++].x_end = w;
+    }
+
+    return n;
+}
+
+void imlib_rle_decode_row(const imlib_rle_run_t *runs, int n, uint32_t *row, int w) {
+    memset(row, 0, ((w + UINT32_T_MASK) >> UINT32_T_SHIFT) * sizeof(uint32_t));
+
+    for (int i = 0; i < n; i++) {
+        int x = runs[i].x_start, x_end = runs[i].x_end;
+
+        for (; (x & UINT32_T_MASK) && (x < x_end); x++) {
+            IMAGE_SET_BINARY_PIXEL_FAST(row, x);
+        }
+
+        for (; (x_end - x) >= UINT32_T_BITS; x += UINT32_T_BITS) {
+            row[x >> UINT32_T_SHIFT] = UINT32_MAX;
+        }
+
+        for (; x < x_end; x++) {
+            IMAGE_SET_BINARY_PIXEL_FAST(row, x);
+        }
+    }
+}
+
+// Appends a run merging it with the last run if they touch.
+static inline int imlib_rle_append(imlib_rle_run_t *out, int n, int x_start, int x_end) {
+    if (n && (x_start <= out[n - 1].x_end)) {
+        out[n - 1].x_end = IM_MAX(out[n - 1].x_end, x_end);
+        return n;
+    }
+
+    out[n].x_start = x_start;
+    out[n].x_end = x_end;
+    return n + 1;
+}
+
+int imlib_rle_or(const imlib_rle_run_t *a, int na, const imlib_rle_run_t *b, int nb, imlib_rle_run_t *out) {
+    int n = 0, i = 0, j = 0;
+
+    while ((i < na) || (j < nb)) {
+        if ((j >= nb) || ((i < na) && (a[i].x_start <= b[j].x_start))) {
+            n = imlib_rle_append(out, n, a[i].x_start, a[i].x_end);
+            i++;
+        } else {
+            n = imlib_rle_append(out, n, b[j].x_start, b[j].x_end);
+            j++;
+        }
+    }
+
+    return n;
+}
+
+int imlib_rle_and(const imlib_rle_run_t *a, int na, const imlib_rle_run_t *b, int nb, imlib_rle_run_t *out) {
+    int n = 0, i = 0, j = 0;
+
+    while ((i < na) && (j < nb)) {
+        int x_start = IM_MAX(a[i].x_start, b[j].x_start);
+        int x_end = IM_MIN(a[i].x_end, b[j].x_end);
+
+        if (x_start < x_end) {
+            out[n].x_start = x_start;
+            out[n++].x_end = x_end;
+        }
+
+        if (a[i].x_end < b[j].x_end) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+
+    return n;
+}
+
+int imlib_rle_xor(const imlib_rle_run_t *a, int na, const imlib_rle_run_t *b, int nb, imlib_rle_run_t *out) {
+    int n = 0, i = 0, j = 0, x = 0;
+
+    // Walk the run edges of both rows in order, toggling the output at each one.
+    while ((i < (na * 2)) || (j < (nb * 2))) {
+        int ea = (i < (na * 2)) ? ((i & 1) ? a[i / 2].x_end : a[i / 2].x_start) : INT_MAX;
+        int eb = (j < (nb * 2)) ? ((j & 1) ? b[j / 2].x_end : b[j / 2].x_start) : INT_MAX;
+        int e = IM_MIN(ea, eb);
+        bool was_set = (i & 1) ^ (j & 1);
+
+        i += (ea == e);
+        j += (eb == e);
+
+        bool is_set = (i & 1) ^ (j & 1);
+
+        if (!was_set && is_set) {
+            x = e;
+        } else if (was_set && !is_set && (x < e)) {
+            n = imlib_rle_append(out, n, x, e);
+        }
+    }
+
+    return n;
+}
+
+int imlib_rle_dilate_row(const imlib_rle_run_t *runs, int n, int ksize, int w, imlib_rle_run_t *out) {
+    int out_n = 0;
+
+    for (int i = 0; i < n; i++) {
+        out_n = imlib_rle_append(out, out_n, IM_MAX(runs[i].x_start - ksize, 0), IM_MIN(runs[i].x_end + ksize, w));
+    }
+
+    return out_n;
+}
+
+int imlib_rle_erode_row(const imlib_rle_run_t *runs, int n, int ksize, int w, imlib_rle_run_t *out) {
+    int out_n = 0;
+
+    // Pixels outside of the image don't count, so runs touching the edges stay there.
+    for (int i = 0; i < n; i++) {
+        int x_start = runs[i].x_start ? (runs[i].x_start + ksize) : 0;
+        int x_end = (runs[i].x_end == w) ? w : (runs[i].x_end - ksize);
+
+        if (x_start < x_end) {
+            out[out_n].x_start = x_start;
+            out[out_n++].x_end = x_end;
+        }
+    }
+
+    return out_n;
+}
+
+void imlib_rle_erode_dilate(image_t *img, int ksize, bool dilate) {
+    int n = (ksize * 2) + 1;
+    int max_runs = ((img->w + 1) / 2) + 1;
+
+    fb_alloc_mark();
+
+    imlib_rle_run_t *tmp = fb_alloc(max_runs * sizeof(imlib_rle_run_t), FB_ALLOC_PREFER_SPEED);
+    imlib_rle_run_t *acc[2];
+    acc[0] = fb_alloc(max_runs * sizeof(imlib_rle_run_t), FB_ALLOC_PREFER_SPEED);
+    acc[1] = fb_alloc(max_runs * sizeof(imlib_rle_run_t), FB_ALLOC_PREFER_SPEED);
+
+    // Ring of horizontally processed input rows.
+    imlib_rle_run_t *ring = fb_alloc(n * max_runs * sizeof(imlib_rle_run_t), FB_ALLOC_PREFER_SPEED);
+    int *ring_n = fb_alloc(n * sizeof(int), FB_ALLOC_PREFER_SPEED);
+
+    for (int y = 0; y < img->h; y++) {
+        int tmp_n = imlib_rle_encode_row(IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y), img->w, tmp);
+        imlib_rle_run_t *slot = ring + ((y % n) * max_runs);
+
+        if (dilate) {
+            ring_n[y % n] = imlib_rle_dilate_row(tmp, tmp_n, ksize, img->w, slot);
+        } else {
+            ring_n[y % n] = imlib_rle_erode_row(tmp, tmp_n, ksize, img->w, slot);
+        }
+
+        // Once the last row arrives all remaining output rows can be produced.
+        for (int o = IM_MAX(y - ksize, 0), o_end = (y == (img->h - 1)) ? y : (y - ksize); o <= o_end; o++) {
+            // Combine the rows under the kernel that are inside the image.
+            int j = IM_MAX(o - ksize, 0), j_end = IM_MIN(o + ksize, (img->h - 1));
+            int acc_n = ring_n[j % n], a = 0;
+            memcpy(acc[a], ring + ((j % n) * max_runs), acc_n * sizeof(imlib_rle_run_t));
+
+            for (j += 1; j <= j_end; j++) {
+                imlib_rle_run_t *row = ring + ((j % n) * max_runs);
+
+                if (dilate) {
+                    acc_n = imlib_rle_or(acc[a], acc_n, row, ring_n[j % n], acc[!a]);
+                } else {
+                    acc_n = imlib_rle_and(acc[a], acc_n, row, ring_n[j % n], acc[!a]);
+                }
+
+                a = !a;
+            }
+
+            // The input row was encoded already so it can be written in place.
+            imlib_rle_decode_row(acc[a], acc_n, IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, o), img->w);
+        }
+    }
+
+    fb_alloc_free_till_mark();
+}
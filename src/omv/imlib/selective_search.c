@@ -7,9 +7,15 @@
  * This work is licensed under the MIT license, see the file LICENSE for details.
  *
  * Selective search.
+ *
+ * The image is over-segmented with graph based segmentation (Felzenszwalb) and the segments
+ * are then grouped hierarchically by color, size and fill similarity, every grouping step
+ * outputs a region proposal. Everything runs on a downscaled copy of the image of at most
+ * SS_MAX_PIXELS pixels so component ids fit in 16-bits. The graph uses integer edge weights
+ * which are counting sorted, and the region adjacency is kept as a sorted list of pairs
+ * instead of dense matrices, so all the memory is taken from a small fb_alloc arena.
  */
 #include <stdio.h>
-#include <math.h>
 #include <string.h>
 #include <stdint.h>
 #include "imlib.h"
@@ -17,434 +23,375 @@
 #include "xalloc.h"
 #ifdef IMLIB_ENABLE_SELECTIVE_SEARCH
 
-#define THRESHOLD(size, c)    (c / size)
-typedef struct {
-    uint16_t y;
-    uint16_t h;
-    uint16_t x;
-    uint16_t w;
-} region;
+#define SS_MAX_PIXELS       (80 * 60)   // Must be less than 65536.
+#define SS_WEIGHTS          (442)       // sqrt(3 * 255^2) + 1
+#define SS_THRESHOLD_SHIFT  (4)
+#define SS_HIST_BINS        (25)
+#define SS_HIST_SIZE        (SS_HIST_BINS * 3)
 
 typedef struct {
-    uint16_t p;
-    uint16_t rank;
+    uint16_t x1;
+    uint16_t y1;
+    uint16_t x2;
+    uint16_t y2;
     uint16_t size;
-} uni_elt;
-
-typedef struct {
-    int num;
-    uni_elt *elts;
-} universe;
+} ss_region_t;
 
-typedef struct {
-    float w;
-    uint16_t a;
-    uint16_t b;
-} edge;
+// The 4 forward edges of a pixel, east, south, south-east and north-east.
+static const int8_t ss_dx[4] = {1, 0, 1, 1};
+static const int8_t ss_dy[4] = {0, 1, 1, -1};
 
-static inline int min(int a, int b) {
-    return (a < b) ? a : b;
-}
-static inline int max(int a, int b) {
-    return (a > b) ? a : b;
-}
-static inline float minf(float a, float b) {
-    return (a < b) ? a : b;
-}
-static inline float maxf(float a, float b) {
-    return (a > b) ? a : b;
-}
-extern uint32_t rng_randint(uint32_t min, uint32_t max);
-
-static universe *universe_create(int elements) {
-    universe *uni = (universe *) fb_alloc(sizeof(universe), FB_ALLOC_NO_HINT);
-    uni->elts = (uni_elt *) fb_alloc(sizeof(uni_elt) * elements, FB_ALLOC_NO_HINT);
-    uni->num = elements;
-    for (int i = 0; i < elements; ++i) {
-        uni->elts[i].p = i;
-        uni->elts[i].rank = 0;
-        uni->elts[i].size = 1;
-    }
-    return uni;
+static inline uint16_t ss_get_pixel(image_t *img, int scale, int x, int y) {
+    return IMAGE_GET_RGB565_PIXEL(img, x * scale, y * scale);
 }
 
-static int universe_size(universe *uni, int x) {
-    return uni->elts[x].size;
+static inline bool ss_edge_valid(int w, int h, int x, int y, int d) {
+    int nx = x + ss_dx[d], ny = y + ss_dy[d];
+    return (nx < w) && (ny >= 0) && (ny < h);
 }
 
-static int universe_num_sets(universe *uni) {
-    return uni->num;
-}
+static inline int ss_isqrt(uint32_t x) {
+    uint32_t r = 0;
 
-static int universe_find(universe *uni, int x) {
-    int y = x;
-    while (y != uni->elts[y].p) {
-        y = uni->elts[y].p;
-    }
-    // Path compression
-    uni->elts[x].p = y;
-    return y;
-}
-
-static void universe_join(universe *uni, int x, int y) {
-    if (uni->elts[x].rank > uni->elts[y].rank) {
-        uni->elts[y].p = x;
-        uni->elts[x].size += uni->elts[y].size;
-    } else {
-        uni->elts[x].p = y;
-        uni->elts[y].size += uni->elts[x].size;
-        if (uni->elts[x].rank == uni->elts[y].rank) {
-            uni->elts[y].rank++;
+    for (uint32_t b = 1UL << 18; b; b >>= 2) {
+        if (x >= (r + b)) {
+            x -= r + b;
+            r = (r >> 1) + b;
+        } else {
+            r >>= 1;
         }
     }
-    uni->num--;
-}
 
-static int universe_get_id(universe *this, int x) {
-    return this->elts[x].rank;
+    return r;
 }
 
-static void universe_set_id(universe *this, int x, int id) {
-    this->elts[x].rank = id;
+// Euclidean distance between the pixels in RGB888, from 0 to SS_WEIGHTS - 1.
+static inline int ss_weight(uint16_t p0, uint16_t p1) {
+    int r = COLOR_RGB565_TO_R8(p0) - COLOR_RGB565_TO_R8(p1);
+    int g = COLOR_RGB565_TO_G8(p0) - COLOR_RGB565_TO_G8(p1);
+    int b = COLOR_RGB565_TO_B8(p0) - COLOR_RGB565_TO_B8(p1);
+    return ss_isqrt((r * r) + (g * g) + (b * b));
 }
 
-static inline float color_similarity(float *hist1, float *hist2) {
-    float sim = 0;
-    for (int i = 0; i < 75; ++i) {
-        sim += minf(hist1[i], hist2[i]);
-    }
-    return sim;
+static inline int ss_edge_weight(image_t *img, int scale, int x, int y, int d) {
+    return ss_weight(ss_get_pixel(img, scale, x, y), ss_get_pixel(img, scale, x + ss_dx[d], y + ss_dy[d]));
 }
 
-static inline float size_similarity(int a, int b, int size) {
-    return 1.0f - (a + b) / size;
+static int ss_find(uint16_t *parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
 }
 
-static inline float fill_similarity(region *ra, region *rb, int a, int b, int size) {
-    int width = max(ra->w, rb->w) - min(ra->x, rb->x);
-    int height = max(ra->h, rb->h) - min(ra->y, rb->y);
-    return 1.0f - (width * height - a - b) / size;
+// Joins two roots by size, returns the new root.
+static int ss_join(uint16_t *parent, uint16_t *size, int a, int b) {
+    if (size[a] < size[b]) {
+        int t = a;
+        a = b;
+        b = t;
+    }
+    parent[b] = a;
+    size[a] += size[b];
+    return a;
 }
 
-static inline float square(float x) {
-    return x * x;
-};
+// LSD radix sort of 32-bit keys, 8-bits per pass. The result is returned in keys.
+static void ss_radix_sort(uint32_t *keys, uint32_t *tmp, size_t n) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        uint32_t offsets[257] = {0};
 
-static inline float diff(image_t *img, int x1, int y1, int x2, int y2) {
-    uint16_t p1 = IMAGE_GET_RGB565_PIXEL(img, x1, y1);
-    uint16_t p2 = IMAGE_GET_RGB565_PIXEL(img, x2, y2);
-    uint8_t r1 = COLOR_RGB565_TO_R8(p1);
-    uint8_t r2 = COLOR_RGB565_TO_R8(p2);
+        for (size_t i = 0; i < n; i++) {
+            offsets[((keys[i] >> shift) & 0xFF) + 1]++;
+        }
 
-    uint8_t g1 = COLOR_RGB565_TO_G8(p1);
-    uint8_t g2 = COLOR_RGB565_TO_G8(p2);
+        for (int i = 1; i < 257; i++) {
+            offsets[i] += offsets[i - 1];
+        }
 
-    uint8_t b1 = COLOR_RGB565_TO_B8(p1);
-    uint8_t b2 = COLOR_RGB565_TO_B8(p2);
-    // dissimilarity measure between pixels
-    return sqrtf((r1 - r2) * (r1 - r2) + (g1 - g2) * (g1 - g2) + (b1 - b2) * (b1 - b2));
-}
+        for (size_t i = 0; i < n; i++) {
+            tmp[offsets[(keys[i] >> shift) & 0xFF]++] = keys[i];
+        }
 
-int comp(const void *elem1, const void *elem2) {
-    edge *f = (edge *) elem1;
-    edge *s = (edge *) elem2;
-    if (f->w > s->w) {
-        return 1;
-    }
-    if (f->w < s->w) {
-        return -1;
+        uint32_t *t = keys;
+        keys = tmp;
+        tmp = t;
     }
-    return 0;
 }
 
-static void segment_graph(universe *u, int num_vertices, int num_edges, edge *edges, float c) {
-    qsort(edges, num_edges, sizeof(edge), comp);
+static float ss_similarity(ss_region_t *regions, uint16_t *hist, int i, int j, int size, float a1, float a2, float a3) {
+    ss_region_t *ri = regions + i, *rj = regions + j;
+    uint16_t *hi = hist + (i * SS_HIST_SIZE), *hj = hist + (j * SS_HIST_SIZE);
+    uint32_t ni = ri->size, nj = rj->size;
 
-    float *threshold = fb_alloc(num_vertices * sizeof(float), FB_ALLOC_NO_HINT);
-    for (int i = 0; i < num_vertices; i++) {
-        threshold[i] = THRESHOLD(1, c);
+    // Histogram intersection of the normalized histograms.
+    uint64_t color = 0;
+    for (int k = 0; k < SS_HIST_SIZE; k++) {
+        uint32_t ci = hi[k] * nj, cj = hj[k] * ni;
+        color += (ci < cj) ? ci : cj;
     }
 
-    for (int i = 0; i < num_edges; i++) {
-        edge *pedge = edges + i;
-        int a = universe_find(u, pedge->a);
-        int b = universe_find(u, pedge->b);
-        if (a != b) {
-            if ((pedge->w <= threshold[a]) && (pedge->w <= threshold[b])) {
-                universe_join(u, a, b);
-                a = universe_find(u, a);
-                threshold[a] = pedge->w + THRESHOLD(universe_size(u, a), c);
-            }
-        }
-    }
+    int x1 = (ri->x1 < rj->x1) ? ri->x1 : rj->x1;
+    int y1 = (ri->y1 < rj->y1) ? ri->y1 : rj->y1;
+    int x2 = (ri->x2 > rj->x2) ? ri->x2 : rj->x2;
+    int y2 = (ri->y2 > rj->y2) ? ri->y2 : rj->y2;
+    int bbox = (x2 - x1 + 1) * (y2 - y1 + 1);
 
-    // Free thresholds.
-    fb_free();
+    float color_sim = color / (3.0f * ni * nj);
+    float size_sim = 1.0f - ((ni + nj) / (float) size);
+    float fill_sim = 1.0f - ((bbox - ni - nj) / (float) size);
+    return (a1 * color_sim) + (a2 * size_sim) + (a3 * fill_sim);
 }
 
-static void image_scale(image_t *src, image_t *dst) {
-    int x_ratio = (int) ((src->w << 16) / dst->w) + 1;
-    int y_ratio = (int) ((src->h << 16) / dst->h) + 1;
+static void ss_add_proposal(array_t *proposals, image_t *src, int scale, ss_region_t *r) {
+    int x = r->x1 * scale, y = r->y1 * scale;
+    int w = IM_MIN((r->x2 - r->x1 + 1) * scale, src->w - x);
+    int h = IM_MIN((r->y2 - r->y1 + 1) * scale, src->h - y);
 
-    for (int y = 0; y < dst->h; y++) {
-        int sy = (y * y_ratio) >> 16;
-        for (int x = 0; x < dst->w; x++) {
-            int sx = (x * x_ratio) >> 16;
-            ((uint16_t *) dst->pixels)[y * dst->w + x] = ((uint16_t *) src->pixels)[sy * src->w + sx];
+    for (int i = 0; i < array_length(proposals); i++) {
+        rectangle_t *p = array_at(proposals, i);
+        if ((p->x == x) && (p->y == y) && (p->w == w) && (p->h == h)) {
+            return;
         }
     }
+
+    array_push_back(proposals, rectangle_alloc(x, y, w, h));
 }
 
-array_t *imlib_selective_search(image_t *src, float t, int min_size, float a1, float a2, float a3) {
-    int i, j;
-    int num = 0;
-    int width = 0, height = 0;
-    image_t *img = NULL;
+array_t *imlib_selective_search(image_t *src, int t, int min_size, float a1, float a2, float a3, int max_proposals) {
+    // Region proposals array
+    array_t *proposals;
+    array_alloc(&proposals, xfree);
 
-    fb_alloc_mark();
+    int scale = 1;
+    while (((src->w / scale) * (src->h / scale)) > SS_MAX_PIXELS) {
+        scale++;
+    }
 
-    if ((src->w * src->h) <= (80 * 60)) {
-        img = src;
-        width = src->w;
-        height = src->h;
-    } else {
-        // Down scale image
-        width = src->w / 4;
-        height = src->h / 4;
-        img = fb_alloc(sizeof(image_t), FB_ALLOC_NO_HINT);
-        img->w = width;
-        img->h = height;
-        img->pixels = fb_alloc(width * height * 2, FB_ALLOC_NO_HINT);
-        image_scale(src, img);
+    int w = src->w / scale, h = src->h / scale, n = w * h;
+    if ((w < 2) || (h < 2)) {
+        return proposals;
     }
 
-    // Region proposals array
-    array_t *proposals;
-    array_alloc(&proposals, xfree);
+    fb_alloc_mark();
 
-    universe *u = universe_create(width * height);
-    edge *edges = (edge *) fb_alloc(width * height * sizeof(edge) * 4, FB_ALLOC_NO_HINT);
+    uint16_t *parent = fb_alloc(n * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
+    uint16_t *size = fb_alloc(n * sizeof(uint16_t), FB_ALLOC_PREFER_SPEED);
 
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            if (x < width - 1) {
-                edges[num].a = y * width + x;
-                edges[num].b = y * width + (x + 1);
-                edges[num].w = diff(img, x, y, x + 1, y);
-                num++;
-            }
+    for (int i = 0; i < n; i++) {
+        parent[i] = i;
+        size[i] = 1;
+    }
 
-            if (y < height - 1) {
-                edges[num].a = y * width + x;
-                edges[num].b = (y + 1) * width + x;
-                edges[num].w = diff(img, x, y, x, y + 1);
-                num++;
+    // Counting sort the edges by weight, weights are computed again instead of being stored.
+    uint32_t *offsets = fb_alloc0((SS_WEIGHTS + 1) * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            for (int d = 0; d < 4; d++) {
+                if (ss_edge_valid(w, h, x, y, d)) {
+                    offsets[ss_edge_weight(src, scale, x, y, d) + 1]++;
+                }
             }
+        }
+    }
 
-            if ((x < width - 1) && (y < height - 1)) {
-                edges[num].a = y * width + x;
-                edges[num].b = (y + 1) * width + (x + 1);
-                edges[num].w = diff(img, x, y, x + 1, y + 1);
-                num++;
-            }
+    for (int i = 1; i <= SS_WEIGHTS; i++) {
+        offsets[i] += offsets[i - 1];
+    }
 
-            if ((x < width - 1) && (y > 0)) {
-                edges[num].a = y * width + x;
-                edges[num].b = (y - 1) * width + (x + 1);
-                edges[num].w = diff(img, x, y, x + 1, y - 1);
-                num++;
+    // Edges are stored as the pixel index and the direction.
+    int num_edges = offsets[SS_WEIGHTS];
+    uint32_t *edges = fb_alloc(num_edges * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            for (int d = 0; d < 4; d++) {
+                if (ss_edge_valid(w, h, x, y, d)) {
+                    edges[offsets[ss_edge_weight(src, scale, x, y, d)]++] = (d << 16) | ((y * w) + x);
+                }
             }
         }
     }
 
-    segment_graph(u, width * height, num, edges, t);
+    // Each offset now points to the end of its weight, which is the start of the next one.
+    uint32_t *threshold = fb_alloc(n * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+    for (int i = 0; i < n; i++) {
+        threshold[i] = t << SS_THRESHOLD_SHIFT;
+    }
+
+    for (int weight = 0, i = 0; weight < SS_WEIGHTS; weight++) {
+        uint32_t wt = weight << SS_THRESHOLD_SHIFT;
+
+        for (int end = offsets[weight]; i < end; i++) {
+            int p = edges[i] & 0xFFFF, d = edges[i] >> 16;
+            int a = ss_find(parent, p);
+            int b = ss_find(parent, p + (ss_dy[d] * w) + ss_dx[d]);
 
-    for (i = 0; i < num; i++) {
-        int a = universe_find(u, edges[i].a);
-        int b = universe_find(u, edges[i].b);
-        if ((a != b) && ((universe_size(u, a) < min_size) || (universe_size(u, b) < min_size))) {
-            universe_join(u, a, b);
+            if ((a != b) && (wt <= threshold[a]) && (wt <= threshold[b])) {
+                a = ss_join(parent, size, a, b);
+                threshold[a] = wt + ((t << SS_THRESHOLD_SHIFT) / size[a]);
+            }
         }
     }
 
-    // Free graph edges
+    // Free thresholds.
     fb_free();
 
-    int num_ccs = universe_num_sets(u);
-    region *regions = (region *) fb_alloc(num_ccs * sizeof(region), FB_ALLOC_NO_HINT);
-    for (i = 0; i < num_ccs; i++) {
-        regions[i].x = width;
-        regions[i].w = 0;
-        regions[i].y = height;
-        regions[i].h = 0;
-    }
+    // Merge small components.
+    for (int i = 0; i < num_edges; i++) {
+        int p = edges[i] & 0xFFFF, d = edges[i] >> 16;
+        int a = ss_find(parent, p);
+        int b = ss_find(parent, p + (ss_dy[d] * w) + ss_dx[d]);
 
-    int next_component = 0;
-    int *counts = (int *) fb_alloc0(num_ccs * sizeof(int), FB_ALLOC_NO_HINT);
-    int *components = (int *) fb_alloc(num_ccs * sizeof(int), FB_ALLOC_NO_HINT);
-    float *histogram = (float *) fb_alloc0(num_ccs * sizeof(float) * 75, FB_ALLOC_NO_HINT);
-
-    // Calc histograms
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int component_id = -1;
-            int comp = universe_find(u, y * width + x);
-            for (i = 0; i < next_component; i++) {
-                if (components[i] == comp) {
-                    component_id = i;
-                    break;
-                }
-            }
-            if (i == next_component) {
-                components[next_component] = comp;
-                component_id = next_component;
-                ++next_component;
-            }
-            universe_set_id(u, y * width + x, component_id);
-            region *r = regions + component_id;
-            r->y = min(r->y, y);
-            r->h = max(r->h, y);
-            r->x = min(r->x, x);
-            r->w = max(r->w, x);
-
-            uint16_t p = IMAGE_GET_RGB565_PIXEL(img, x, y);
-            int r_bin = min(COLOR_RGB565_TO_R8(p), 240) / 10;
-            int g_bin = min(COLOR_RGB565_TO_G8(p), 240) / 10;
-            int b_bin = min(COLOR_RGB565_TO_B8(p), 240) / 10;
-
-            histogram[75 * component_id + 0 + r_bin]++;
-            histogram[75 * component_id + 25 + g_bin]++;
-            histogram[75 * component_id + 50 + b_bin]++;
-            counts[component_id]++;
+        if ((a != b) && ((size[a] < min_size) || (size[b] < min_size))) {
+            ss_join(parent, size, a, b);
         }
     }
 
-    // Normalize histograms
-    for (i = 0; i < num_ccs; i++) {
-        float max_val = 0;
-        for (j = 0; j < 75; j++) {
-            max_val = max(max_val, histogram[75 * i + j]);
-        }
-        for (j = 0; j < 75; j++) {
-            histogram[75 * i + j] /= max_val;
+    // Free edges and offsets.
+    fb_free();
+    fb_free();
+
+    // Relabel the components from 0 to num_ccs - 1, parent becomes the component id of each pixel.
+    int num_ccs = 0;
+    for (int i = 0; i < n; i++) {
+        parent[i] = ss_find(parent, i);
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (parent[i] == i) {
+            size[i] = num_ccs++;
         }
     }
 
-    uint8_t *adjacency = (uint8_t *) fb_alloc0(num_ccs * num_ccs * sizeof(uint8_t), FB_ALLOC_NO_HINT);
-    for (int y = 0; y < height - 1; ++y) {
-        for (int x = 0; x < width - 1; ++x) {
-            int component1 = universe_get_id(u, y * width + x);
-            int component2 = universe_get_id(u, y * width + x + 1);
-            int component3 = universe_get_id(u, y * width + x + width);
+    for (int i = 0; i < n; i++) {
+        parent[i] = size[parent[i]];
+    }
 
-            if (component1 != component2) {
-                adjacency[component1 * num_ccs + component2] = 1;
-                adjacency[component2 * num_ccs + component1] = 1;
-            }
+    uint16_t *ids = parent;
+    ss_region_t *regions = fb_alloc(num_ccs * sizeof(ss_region_t), FB_ALLOC_NO_HINT);
+    uint16_t *hist = fb_alloc0(num_ccs * SS_HIST_SIZE * sizeof(uint16_t), FB_ALLOC_NO_HINT);
 
-            if (component1 != component3) {
-                adjacency[component1 * num_ccs + component3] = 1;
-                adjacency[component3 * num_ccs + component1] = 1;
-            }
-        }
+    for (int i = 0; i < num_ccs; i++) {
+        regions[i].x1 = w;
+        regions[i].y1 = h;
+        regions[i].x2 = 0;
+        regions[i].y2 = 0;
+        regions[i].size = 0;
     }
 
-    int size = height * width;
-    float *similarity_table = (float *) fb_alloc(num_ccs * num_ccs * sizeof(float), FB_ALLOC_NO_HINT);
-    for (i = 0; i < num_ccs; ++i) {
-        for (j = i + 1; j < num_ccs; ++j) {
-            float color_sim = a1 * color_similarity(histogram + 75 * i, histogram + 75 * j);
-            float size_sim = a2 * size_similarity(counts[i], counts[j], size);
-            float fill_sim = a3 * fill_similarity(regions + i, regions + j, counts[i], counts[j], size);
-            float similarity = color_sim + size_sim + fill_sim;
-            similarity_table[i * num_ccs + j] = similarity;
-            similarity_table[j * num_ccs + i] = similarity;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int id = ids[(y * w) + x];
+            ss_region_t *r = regions + id;
+            r->x1 = (x < r->x1) ? x : r->x1;
+            r->y1 = (y < r->y1) ? y : r->y1;
+            r->x2 = (x > r->x2) ? x : r->x2;
+            r->y2 = (y > r->y2) ? y : r->y2;
+            r->size++;
+
+            uint16_t pixel = ss_get_pixel(src, scale, x, y);
+            uint16_t *bins = hist + (id * SS_HIST_SIZE);
+            bins[IM_MIN(COLOR_RGB565_TO_R8(pixel), 240) / 10]++;
+            bins[SS_HIST_BINS + (IM_MIN(COLOR_RGB565_TO_G8(pixel), 240) / 10)]++;
+            bins[(SS_HIST_BINS * 2) + (IM_MIN(COLOR_RGB565_TO_B8(pixel), 240) / 10)]++;
         }
     }
 
-    int remaining = num_ccs;
-    while (remaining > 1) {
-        int best_i = -1;
-        int best_j = -1;
-        float best_similarity = 0;
-        for (i = 0; i < num_ccs; i++) {
-            for (j = i + 1; j < num_ccs; j++) {
-                if (adjacency[i * num_ccs + j] == 0) {
-                    continue;
-                }
-                float similarity = similarity_table[i * num_ccs + j];
-                if (similarity > best_similarity) {
-                    best_similarity = similarity;
-                    best_i = i;
-                    best_j = j;
+    // Collect the adjacent component pairs, smaller id in the upper half, and remove duplicates.
+    int num_pairs = 0;
+    uint32_t *pairs = fb_alloc(n * 2 * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+    uint32_t *tmp = fb_alloc(n * 2 * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int a = ids[(y * w) + x];
+            int neighbors[2] = {
+                (x < (w - 1)) ? ids[(y * w) + x + 1] : a,
+                (y < (h - 1)) ? ids[((y + 1) * w) + x] : a,
+            };
+
+            for (int k = 0; k < 2; k++) {
+                int b = neighbors[k];
+                if (a != b) {
+                    uint32_t key = (a < b) ? ((a << 16) | b) : ((b << 16) | a);
+                    if ((!num_pairs) || (pairs[num_pairs - 1] != key)) {
+                        pairs[num_pairs++] = key;
+                    }
                 }
             }
         }
+    }
+
+    ss_radix_sort(pairs, tmp, num_pairs);
+
+    int num_unique = 0;
+    for (int i = 0; i < num_pairs; i++) {
+        if ((!num_unique) || (pairs[num_unique - 1] != pairs[i])) {
+            pairs[num_unique++] = pairs[i];
+        }
+    }
+
+    num_pairs = num_unique;
+    float *similarity = fb_alloc(num_pairs * sizeof(float), FB_ALLOC_PREFER_SPEED);
+    uint16_t *stamps = fb_alloc0(num_ccs * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+
+    for (int i = 0; i < num_pairs; i++) {
+        similarity[i] = ss_similarity(regions, hist, pairs[i] >> 16, pairs[i] & 0xFFFF, n, a1, a2, a3);
+    }
 
-        if (best_i == -1) {
-            printf("failed to build tree\n");
+    // Group the most similar pair until one region is left or there are enough proposals.
+    for (uint16_t stamp = 1; num_pairs; stamp++) {
+        if ((max_proposals > 0) && (array_length(proposals) >= max_proposals)) {
             break;
         }
 
-        // update regions, histograms, counts, adjacency, similarity
-        regions[best_i].x = min(regions[best_i].x, regions[best_j].x);
-        regions[best_i].y = min(regions[best_i].y, regions[best_j].y);
-        regions[best_i].w = max(regions[best_i].w, regions[best_j].w);
-        regions[best_i].h = max(regions[best_i].h, regions[best_j].h);
-
-        bool add = true;
-        for (i = 0; i < array_length(proposals); i++) {
-            rectangle_t *r = array_at(proposals, i);
-            if (regions[best_i].x == r->x && regions[best_i].y == r->y &&
-                regions[best_i].w == r->w && regions[best_i].h == r->h) {
-                add = false;
-                break;
+        int best = 0;
+        for (int i = 1; i < num_pairs; i++) {
+            if (similarity[i] > similarity[best]) {
+                best = i;
             }
         }
-        if (add) {
-            array_push_back(proposals, rectangle_alloc(regions[best_i].x,
-                                                       regions[best_i].y, regions[best_i].w, regions[best_i].h));
-        }
 
+        int a = pairs[best] >> 16, b = pairs[best] & 0xFFFF;
+        ss_region_t *ra = regions + a, *rb = regions + b;
+        ra->x1 = (rb->x1 < ra->x1) ? rb->x1 : ra->x1;
+        ra->y1 = (rb->y1 < ra->y1) ? rb->y1 : ra->y1;
+        ra->x2 = (rb->x2 > ra->x2) ? rb->x2 : ra->x2;
+        ra->y2 = (rb->y2 > ra->y2) ? rb->y2 : ra->y2;
+        ra->size += rb->size;
 
-        for (i = 0; i < 75; i++) {
-            histogram[75 * best_i + i] = (counts[best_i] * histogram[75 * best_i + i]
-                                          + counts[best_j] * histogram[75 * best_j + i]) / (counts[best_i] + counts[best_j]);
+        for (int k = 0; k < SS_HIST_SIZE; k++) {
+            hist[(a * SS_HIST_SIZE) + k] += hist[(b * SS_HIST_SIZE) + k];
         }
-        counts[best_i] += counts[best_j];
 
-        for (i = 0; i < num_ccs; i++) {
-            adjacency[best_i * num_ccs + i] |= adjacency[best_j * num_ccs + i];
-            adjacency[i * num_ccs + best_i] |= adjacency[i * num_ccs + best_j];
-            adjacency[best_j * num_ccs + i] = adjacency[i * num_ccs + best_j] = 0;
-        }
-        adjacency[best_i * num_ccs + best_i] = 0;
+        ss_add_proposal(proposals, src, scale, ra);
+
+        // Move the pairs of b to a, removing the pair itself and duplicates, and update a's similarities.
+        for (int i = 0; i < num_pairs; ) {
+            int p = pairs[i] >> 16, q = pairs[i] & 0xFFFF;
+            p = (p == b) ? a : p;
+            q = (q == b) ? a : q;
 
-        for (i = 0; i < num_ccs; i++) {
-            if (adjacency[best_i * num_ccs + i] == 0) {
-                continue;
+            if ((p == a) || (q == a)) {
+                int o = (p == a) ? q : p;
+
+                if ((o == a) || (stamps[o] == stamp)) {
+                    num_pairs--;
+                    pairs[i] = pairs[num_pairs];
+                    similarity[i] = similarity[num_pairs];
+                    continue;
+                }
+
+                stamps[o] = stamp;
+                pairs[i] = (a < o) ? ((a << 16) | o) : ((o << 16) | a);
+                similarity[i] = ss_similarity(regions, hist, a, o, n, a1, a2, a3);
             }
-            float color_sim = a1 * color_similarity(histogram + 75 * i, histogram + 75 * best_i);
-            float size_sim = a2 * size_similarity(counts[i], counts[best_i], size);
-            float fill_sim = a3 * fill_similarity(regions + i, regions + best_i, counts[i], counts[best_i], size);
-            float similarity = color_sim + size_sim + fill_sim;
-            similarity_table[i * num_ccs + best_i] = similarity;
-            similarity_table[best_i * num_ccs + i] = similarity;
-        }
-        --remaining;
-    }
 
-    for (int i = 0; i < array_length(proposals); i++) {
-        rectangle_t *r = array_at(proposals, i);
-        r->w = r->w - r->x;
-        r->h = r->h - r->y;
-        if ((src->w * src->h) > (80 * 60)) {
-            r->x *= 4;
-            r->y *= 4;
-            r->w *= 4;
-            r->h *= 4;
+            i++;
         }
     }
+
     fb_alloc_free_till_mark();
     return proposals;
 }
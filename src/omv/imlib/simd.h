@@ -827,6 +827,20 @@ static inline v128_t vshlc(v128_t v0, uint32_t *reg, uint32_t n) {
 }
 #endif
 
+static inline v128_t vadd_u16(v128_t v0, v128_t v1) {
+    #if (__ARM_ARCH >= 8)
+    return (v128_t) vaddq(v0.u16, v1.u16);
+    #elif (__ARM_ARCH >= 7)
+    return (v128_t) {
+        .u32 = { __UADD16(v0.u32[0], v1.u32[0]) }
+    };
+    #else
+    return (v128_t) {
+        .u16 = v0.u16 + v1.u16
+    };
+    #endif
+}
+
 static inline v128_t vadd_u32(v128_t v0, v128_t v1) {
     #if (__ARM_ARCH >= 8)
     return (v128_t) vaddq(v0.u32, v1.u32);
@@ -903,6 +917,98 @@ static inline v128_t vsub_s16(v128_t v0, v128_t v1) {
     #endif
 }
 
+static inline v128_t vqadd_u8(v128_t v0, v128_t v1) {
+    #if (__ARM_ARCH >= 8)
+    return (v128_t) vqaddq(v0.u8, v1.u8);
+    #elif (__ARM_ARCH >= 7)
+    return (v128_t) {
+        .u32 = { __UQADD8(v0.u32[0], v1.u32[0]) }
+    };
+    #else
+    v128_t sum = { .u8 = v0.u8 + v1.u8 };
+    v128_t m = { .s8 = sum.u8 < v0.u8 };
+    return (v128_t) {
+        .u32 = sum.u32 | m.u32
+    };
+    #endif
+}
+
+static inline v128_t vqsub_u8(v128_t v0, v128_t v1) {
+    #if (__ARM_ARCH >= 8)
+    return (v128_t) vqsubq(v0.u8, v1.u8);
+    #elif (__ARM_ARCH >= 7)
+    return (v128_t) {
+        .u32 = { __UQSUB8(v0.u32[0], v1.u32[0]) }
+    };
+    #else
+    v128_t sub = { .u8 = v0.u8 - v1.u8 };
+    v128_t m = { .s8 = v0.u8 > v1.u8 };
+    return (v128_t) {
+        .u32 = sub.u32 & m.u32
+    };
+    #endif
+}
+
+static inline v128_t vabd_u8(v128_t v0, v128_t v1) {
+    #if (__ARM_ARCH >= 8)
+    return (v128_t) vabdq(v0.u8, v1.u8);
+    #elif (__ARM_ARCH >= 7)
+    uint32_t sub0 = __USUB8(v0.u32[0], v1.u32[0]);
+    uint32_t sub1 = __USUB8(v1.u32[0], v0.u32[0]); // Sets GE where v1 >= v0.
+    return (v128_t) {
+        .u32 = { __SEL(sub1, sub0) }
+    };
+    #else
+    v128_t sub0 = { .u8 = v0.u8 - v1.u8 };
+    v128_t sub1 = { .u8 = v1.u8 - v0.u8 };
+    v128_t m = { .s8 = v0.u8 > v1.u8 };
+    return (v128_t) {
+        .u32 = (sub0.u32 & m.u32) | (sub1.u32 & ~m.u32)
+    };
+    #endif
+}
+
+static inline v128_t vmin_u8(v128_t v0, v128_t v1) {
+    #if (__ARM_ARCH >= 8)
+    return (v128_t) vminq(v0.u8, v1.u8);
+    #elif (__ARM_ARCH >= 7)
+    __USUB8(v0.u32[0], v1.u32[0]); // Sets GE where v0 >= v1.
+    return (v128_t) {
+        .u32 = { __SEL(v1.u32[0], v0.u32[0]) }
+    };
+    #else
+    v128_t m = { .s8 = v0.u8 < v1.u8 };
+    return (v128_t) {
+        .u32 = (v0.u32 & m.u32) | (v1.u32 & ~m.u32)
+    };
+    #endif
+}
+
+static inline v128_t vmax_u8(v128_t v0, v128_t v1) {
+    #if (__ARM_ARCH >= 8)
+    return (v128_t) vmaxq(v0.u8, v1.u8);
+    #elif (__ARM_ARCH >= 7)
+    __USUB8(v0.u32[0], v1.u32[0]); // Sets GE where v0 >= v1.
+    return (v128_t) {
+        .u32 = { __SEL(v0.u32[0], v1.u32[0]) }
+    };
+    #else
+    v128_t m = { .s8 = v0.u8 > v1.u8 };
+    return (v128_t) {
+        .u32 = (v0.u32 & m.u32) | (v1.u32 & ~m.u32)
+    };
+    #endif
+}
+
+// Returns the largest lane.
+static inline uint8_t vmaxv_u8(v128_t v0) {
+    #if (__ARM_ARCH >= 8)
+    return vmaxvq_u8(0, v0.u8);
+    #else
+    return IM_MAX(IM_MAX(v0.u8[0], v0.u8[1]), IM_MAX(v0.u8[2], v0.u8[3]));
+    #endif
+}
+
 #if (__ARM_ARCH >= 8)
 #define vsli_u8(v0, v1, n) ((v128_t) vsliq_n_u8(v0.u8, v1.u8, n))
 #else
@@ -1387,6 +1493,24 @@ static inline void vstr_u16_pred(uint16_t *p, v128_t v0, v128_predicate_t pred)
     #endif
 }
 
+static inline v128_t vldr_u32_pred(const uint32_t *p, v128_predicate_t pred) {
+    #if (__ARM_ARCH >= 8)
+    return (v128_t) vldrwq_z_u32(p, pred);
+    #else
+    return (v128_t) {
+        .u32 = { p[0] }
+    };
+    #endif
+}
+
+static inline void vstr_u32_pred(uint32_t *p, v128_t v0, v128_predicate_t pred) {
+    #if (__ARM_ARCH >= 8)
+    vstrwq_p_u32(p, v0.u32, pred);
+    #else
+    p[0] = v0.u32[0];
+    #endif
+}
+
 static inline v128_t vldr_u8_widen_u16_pred(uint8_t *p, v128_predicate_t pred) {
     #if (__ARM_ARCH >= 8)
     return (v128_t) vldrbq_z_u16(p, pred);
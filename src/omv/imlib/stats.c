@@ -8,7 +8,9 @@
  *
  * Statistics functions.
  */
+#include "fsort.h"
 #include "imlib.h"
+#include "simd.h"
 
 #ifdef IMLIB_ENABLE_GET_SIMILARITY
 typedef struct imlib_similarity_line_op_state {
@@ -44,6 +46,31 @@ static void imlib_similarity_line_op(int x, int x_end, int y_row, imlib_draw_row
         case PIXFORMAT_GRAYSCALE: {
             uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(data->dst_img, y_row);
             uint8_t *other_row_ptr = (uint8_t *) data->dst_row_override;
+            #if defined(ARM_MATH_DSP)
+            // Full buckets are summed 4 pixels at a time, the squares and products are dual 16-bit MACs.
+            for (int bucket = 0; (x_end - x) >= 8; x += 8, bucket++) {
+                uint32_t sum_x = 0, sum_y = 0;
+                int32_t sum2_x = 0, sum2_y = 0, sum2 = 0;
+
+                for (int i = 0; i < 8; i += 4) {
+                    uint32_t a = *((uint32_t *) (row_ptr + x + i));
+                    uint32_t b = *((uint32_t *) (other_row_ptr + x + i));
+                    uint32_t a_e = __UXTB16(a), a_o = __UXTB16_RORn(a, 8);
+                    uint32_t b_e = __UXTB16(b), b_o = __UXTB16_RORn(b, 8);
+                    sum_x = __USADA8(a, 0, sum_x);
+                    sum_y = __USADA8(b, 0, sum_y);
+                    sum2_x = __SMLAD(a_e, a_e, __SMLAD(a_o, a_o, sum2_x));
+                    sum2_y = __SMLAD(b_e, b_e, __SMLAD(b_o, b_o, sum2_y));
+                    sum2 = __SMLAD(a_e, b_e, __SMLAD(a_o, b_o, sum2));
+                }
+
+                state->sumBucketsOfX[bucket] += sum_x;
+                state->sumBucketsOfY[bucket] += sum_y;
+                state->sum2BucketsOfX[bucket] += sum2_x;
+                state->sum2BucketsOfY[bucket] += sum2_y;
+                state->sum2Buckets[bucket] += sum2;
+            }
+            #endif
             for (; x < x_end; x++) {
                 int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
                 int other_pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(other_row_ptr, x);
@@ -150,14 +177,13 @@ void imlib_get_similarity(image_t *img,
         return;
     }
 
-    int int_h_blocks = h_blocks * sizeof(int);
     imlib_similarity_line_op_state_t state;
     state.dssim = dssim;
-    state.sumBucketsOfX = fb_alloc0(int_h_blocks * 5, FB_ALLOC_NO_HINT);
-    state.sumBucketsOfY = state.sumBucketsOfX + int_h_blocks;
-    state.sum2BucketsOfX = state.sumBucketsOfY + int_h_blocks;
-    state.sum2BucketsOfY = state.sum2BucketsOfX + int_h_blocks;
-    state.sum2Buckets = state.sum2BucketsOfY + int_h_blocks;
+    state.sumBucketsOfX = fb_alloc0(h_blocks * sizeof(int) * 5, FB_ALLOC_NO_HINT);
+    state.sumBucketsOfY = state.sumBucketsOfX + h_blocks;
+    state.sum2BucketsOfX = state.sumBucketsOfY + h_blocks;
+    state.sum2BucketsOfY = state.sum2BucketsOfX + h_blocks;
+    state.sum2Buckets = state.sum2BucketsOfY + h_blocks;
     state.similarity_sum = 0.0f;
     state.similarity_sum_2 = 0.0f;
     state.similarity_min = FLT_MAX;
@@ -180,29 +206,96 @@ void imlib_get_similarity(image_t *img,
 }
 #endif // IMLIB_ENABLE_GET_SIMILARITY
 
-void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_t *thresholds, bool invert, image_t *other) {
+// Returns the mean brightness of a block (scaled by 256), sampling at most 8x8 pixels.
+static int imlib_hash_block_mean(image_t *img, int x0, int x1, int y0, int y1) {
+    int x_step = IM_MAX((x1 - x0) / 8, 1);
+    int y_step = IM_MAX((y1 - y0) / 8, 1);
+    int sum = 0, n = 0;
+
+    for (int y = y0; y < y1; y += y_step) {
+        switch (img->pixfmt) {
+            case PIXFORMAT_BINARY: {
+                uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(img, y);
+                for (int x = x0; x < x1; x += x_step, n++) {
+                    sum += COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x));
+                }
+                break;
+            }
+            case PIXFORMAT_GRAYSCALE: {
+                uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
+                for (int x = x0; x < x1; x += x_step, n++) {
+                    sum += IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
+                }
+                break;
+            }
+            case PIXFORMAT_RGB565: {
+                uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(img, y);
+                for (int x = x0; x < x1; x += x_step, n++) {
+                    sum += COLOR_RGB565_TO_GRAYSCALE(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
+                }
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+    }
+
+    return n ? ((sum << 8) / n) : 0;
+}
+
+// Difference hash (dHash) of the ROI. The ROI is reduced to a 9x8 grid of block means and
+// each bit is set if a block is brighter than its right neighbor. Similar images have hashes
+// that differ in a few bits, and the hash does not change with the exposure or contrast.
+uint64_t imlib_get_hash(image_t *img, rectangle_t *roi) {
+    uint64_t hash = 0;
+
+    for (int j = 0; j < 8; j++) {
+        int y0 = roi->y + ((roi->h * j) / 8);
+        int y1 = roi->y + ((roi->h * (j + 1)) / 8);
+        int x1 = roi->x + (roi->w / 9);
+        int prev = imlib_hash_block_mean(img, roi->x, x1, y0, y1);
+
+        for (int i = 1; i < 9; i++) {
+            int x0 = x1;
+            x1 = roi->x + ((roi->w * (i + 1)) / 9);
+            int mean = imlib_hash_block_mean(img, x0, x1, y0, y1);
+            hash = (hash << 1) | (prev > mean);
+            prev = mean;
+        }
+    }
+
+    return hash;
+}
+
+int imlib_hash_distance(uint64_t a, uint64_t b) {
+    return __builtin_popcountll(a ^ b);
+}
+
+void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_t *thresholds, bool invert, image_t *other,
+                         int x_stride, int y_stride) {
     switch (ptr->pixfmt) {
         case PIXFORMAT_BINARY: {
             memset(out->LBins, 0, out->LBinCount * sizeof(uint32_t));
 
-            int pixel_count = roi->w * roi->h;
+            int pixel_count = ((roi->w + x_stride - 1) / x_stride) * ((roi->h + y_stride - 1) / y_stride);
             float mult = (out->LBinCount - 1) / ((float) (COLOR_BINARY_MAX - COLOR_BINARY_MIN));
 
             if ((!thresholds) || (!list_size(thresholds))) {
                 // Fast histogram code when no color thresholds list...
                 if (!other) {
-                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                         uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
-                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                             int pixel = IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x);
                             ((uint32_t *) out->LBins)[fast_roundf((pixel - COLOR_BINARY_MIN) * mult)]++;
                         }
                     }
                 } else {
-                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                         uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y),
                                  *other_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(other, y);
-                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                             int pixel = IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x) ^ IMAGE_GET_BINARY_PIXEL_FAST(other_row_ptr, x);
                             ((uint32_t *) out->LBins)[fast_roundf((pixel - COLOR_BINARY_MIN) * mult)]++;
                         }
@@ -214,9 +307,9 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
                 if (!other) {
                     list_for_each(it, thresholds) {
                         color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
-                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                             uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
-                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                                 int pixel = IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x);
                                 if (COLOR_THRESHOLD_BINARY(pixel, lnk_data, invert)) {
                                     ((uint32_t *) out->LBins)[fast_roundf((pixel - COLOR_BINARY_MIN) * mult)]++;
@@ -229,10 +322,10 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
                     list_for_each(it, thresholds) {
                         color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
 
-                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                             uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y),
                                      *other_row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(other, y);
-                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                                 int pixel = IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x) ^ IMAGE_GET_BINARY_PIXEL_FAST(other_row_ptr,
                                                                                                                   x);
                                 if (COLOR_THRESHOLD_BINARY(pixel, lnk_data, invert)) {
@@ -256,24 +349,50 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
         case PIXFORMAT_GRAYSCALE: {
             memset(out->LBins, 0, out->LBinCount * sizeof(uint32_t));
 
-            int pixel_count = roi->w * roi->h;
+            int pixel_count = ((roi->w + x_stride - 1) / x_stride) * ((roi->h + y_stride - 1) / y_stride);
             float mult = (out->LBinCount - 1) / ((float) (COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN));
 
             if ((!thresholds) || (!list_size(thresholds))) {
                 // Fast histogram code when no color thresholds list...
-                if (!other) {
-                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                if ((!other) && (out->LBinCount == (COLOR_GRAYSCALE_MAX - COLOR_GRAYSCALE_MIN + 1))) {
+                    // The pixel is the bin index. Runs of equal pixels would make each increment wait on
+                    // the previous store to the same bin, so 4 sub-histograms are accumulated and summed.
+                    uint32_t *bins = fb_alloc0(4 * 256 * sizeof(uint32_t), FB_ALLOC_PREFER_SPEED);
+
+                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                         uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
-                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                        int x = roi->x, xx = roi->x + roi->w;
+
+                        for (int step = x_stride * 4; (x + (x_stride * 3)) < xx; x += step) {
+                            bins[row_ptr[x]]++;
+                            bins[256 + row_ptr[x + x_stride]]++;
+                            bins[512 + row_ptr[x + (x_stride * 2)]]++;
+                            bins[768 + row_ptr[x + (x_stride * 3)]]++;
+                        }
+
+                        for (; x < xx; x += x_stride) {
+                            bins[row_ptr[x]]++;
+                        }
+                    }
+
+                    for (int i = 0; i < 256; i++) {
+                        ((uint32_t *) out->LBins)[i] = bins[i] + bins[256 + i] + bins[512 + i] + bins[768 + i];
+                    }
+
+                    fb_free();
+                } else if (!other) {
+                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
+                        uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
+                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                             int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
                             ((uint32_t *) out->LBins)[fast_roundf((pixel - COLOR_GRAYSCALE_MIN) * mult)]++;
                         }
                     }
                 } else {
-                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                         uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y),
                                 *other_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(other, y);
-                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                             int pixel =
                                 abs(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x) - IMAGE_GET_GRAYSCALE_PIXEL_FAST(other_row_ptr,
                                                                                                                 x));
@@ -288,9 +407,9 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
                     list_for_each(it, thresholds) {
                         color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
 
-                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                             uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
-                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                                 int pixel = IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x);
                                 if (COLOR_THRESHOLD_GRAYSCALE(pixel, lnk_data, invert)) {
                                     ((uint32_t *) out->LBins)[fast_roundf((pixel - COLOR_GRAYSCALE_MIN) * mult)]++;
@@ -303,10 +422,10 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
                     list_for_each(it, thresholds) {
                         color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
 
-                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                             uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y),
                                     *other_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(other, y);
-                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                                 int pixel =
                                     abs(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr,
                                                                        x) - IMAGE_GET_GRAYSCALE_PIXEL_FAST(other_row_ptr,
@@ -334,7 +453,7 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
             memset(out->ABins, 0, out->ABinCount * sizeof(uint32_t));
             memset(out->BBins, 0, out->BBinCount * sizeof(uint32_t));
 
-            int pixel_count = roi->w * roi->h;
+            int pixel_count = ((roi->w + x_stride - 1) / x_stride) * ((roi->h + y_stride - 1) / y_stride);
             float l_mult = (out->LBinCount - 1) / ((float) (COLOR_L_MAX - COLOR_L_MIN));
             float a_mult = (out->ABinCount - 1) / ((float) (COLOR_A_MAX - COLOR_A_MIN));
             float b_mult = (out->BBinCount - 1) / ((float) (COLOR_B_MAX - COLOR_B_MIN));
@@ -342,9 +461,9 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
             if ((!thresholds) || (!list_size(thresholds))) {
                 // Fast histogram code when no color thresholds list...
                 if (!other) {
-                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                         uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
-                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                             int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
                             ((uint32_t *) out->LBins)[fast_roundf((COLOR_RGB565_TO_L(pixel) - COLOR_L_MIN) * l_mult)]++;
                             ((uint32_t *) out->ABins)[fast_roundf((COLOR_RGB565_TO_A(pixel) - COLOR_A_MIN) * a_mult)]++;
@@ -352,10 +471,10 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
                         }
                     }
                 } else {
-                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                         uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y),
                                  *other_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(other, y);
-                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                        for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                             int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
                             int other_pixel = IMAGE_GET_RGB565_PIXEL_FAST(other_row_ptr, x);
                             int r = abs(COLOR_RGB565_TO_R5(pixel) - COLOR_RGB565_TO_R5(other_pixel));
@@ -375,9 +494,9 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
                     list_for_each(it, thresholds) {
                         color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
 
-                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                             uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
-                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                                 int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
                                 if (COLOR_THRESHOLD_RGB565(pixel, lnk_data, invert)) {
                                     ((uint32_t *) out->LBins)[fast_roundf((COLOR_RGB565_TO_L(pixel) - COLOR_L_MIN) * l_mult)]++;
@@ -392,10 +511,10 @@ void imlib_get_histogram(histogram_t *out, image_t *ptr, rectangle_t *roi, list_
                     list_for_each(it, thresholds) {
                         color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
 
-                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y++) {
+                        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
                             uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y),
                                      *other_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(other, y);
-                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x++) {
+                            for (int x = roi->x, xx = roi->x + roi->w; x < xx; x += x_stride) {
                                 int pixel = IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x);
                                 int other_pixel = IMAGE_GET_RGB565_PIXEL_FAST(other_row_ptr, x);
                                 int r = abs(COLOR_RGB565_TO_R5(pixel) - COLOR_RGB565_TO_R5(other_pixel));
@@ -856,6 +975,152 @@ static int get_median_l(long long *array, long long array_sum, int array_len) {
     return array_len - 1;
 }
 
+// Computes the line end points from theta and rho (relative to the roi) and clips them to the roi.
+static bool regression_line(find_lines_list_lnk_data_t *out, rectangle_t *roi) {
+    if ((45 <= out->theta) && (out->theta < 135)) {
+        // y = (r - x cos(t)) / sin(t)
+        out->line.x1 = 0;
+        out->line.y1 = fast_roundf((out->rho - (out->line.x1 * cos_table[out->theta])) / sin_table[out->theta]);
+        out->line.x2 = roi->w - 1;
+        out->line.y2 = fast_roundf((out->rho - (out->line.x2 * cos_table[out->theta])) / sin_table[out->theta]);
+    } else {
+        // x = (r - y sin(t)) / cos(t);
+        out->line.y1 = 0;
+        out->line.x1 = fast_roundf((out->rho - (out->line.y1 * sin_table[out->theta])) / cos_table[out->theta]);
+        out->line.y2 = roi->h - 1;
+        out->line.x2 = fast_roundf((out->rho - (out->line.y2 * sin_table[out->theta])) / cos_table[out->theta]);
+    }
+
+    if (lb_clip_line(&out->line, 0, 0, roi->w, roi->h)) {
+        out->line.x1 += roi->x;
+        out->line.y1 += roi->y;
+        out->line.x2 += roi->x;
+        out->line.y2 += roi->y;
+        // Move rho too.
+        out->rho += fast_roundf((roi->x * cos_table[out->theta]) + (roi->y * sin_table[out->theta]));
+        return true;
+    }
+
+    memset(out, 0, sizeof(find_lines_list_lnk_data_t));
+    return false;
+}
+
+// Least squares fit from the moments of the points.
+static bool regression_least_squares(find_lines_list_lnk_data_t *out, rectangle_t *roi, int blob_pixels,
+                                     int blob_cx, int blob_cy, long long blob_a, long long blob_b, long long blob_c) {
+    // http://www.cse.usf.edu/~r1k/MachineVisionBook/MachineVision.files/MachineVision_Chapter2.pdf
+    // https://www.strchr.com/standard_deviation_in_one_pass
+    //
+    // a = sigma(x*x) + (mx*sigma(x)) + (mx*sigma(x)) + (sigma()*mx*mx)
+    // b = sigma(x*y) + (mx*sigma(y)) + (my*sigma(x)) + (sigma()*mx*my)
+    // c = sigma(y*y) + (my*sigma(y)) + (my*sigma(y)) + (sigma()*my*my)
+    //
+    // blob_a = sigma(x*x)
+    // blob_b = sigma(x*y)
+    // blob_c = sigma(y*y)
+    // blob_cx = sigma(x)
+    // blob_cy = sigma(y)
+    // blob_pixels = sigma()
+
+    int mx = blob_cx / blob_pixels; // x centroid
+    int my = blob_cy / blob_pixels; // y centroid
+    int small_blob_a = blob_a - ((mx * blob_cx) + (mx * blob_cx)) + (blob_pixels * mx * mx);
+    int small_blob_b = blob_b - ((mx * blob_cy) + (my * blob_cx)) + (blob_pixels * mx * my);
+    int small_blob_c = blob_c - ((my * blob_cy) + (my * blob_cy)) + (blob_pixels * my * my);
+
+    float rotation =
+        ((small_blob_a !=
+          small_blob_c) ? (fast_atan2f(2 * small_blob_b, small_blob_a - small_blob_c) / 2.0f) : 1.570796f) + 1.570796f;                              // PI/2
+
+    out->theta = fast_roundf(rotation * 57.295780) % 180; // * (180 / PI)
+    if (out->theta < 0) {
+        out->theta += 180;
+    }
+    out->rho = fast_roundf(((mx - roi->x) * cos_table[out->theta]) + ((my - roi->y) * sin_table[out->theta]));
+
+    float part0 = (small_blob_a + small_blob_c) / 2.0f;
+    float f_b = (float) small_blob_b;
+    float f_a_c = (float) (small_blob_a - small_blob_c);
+    float part1 = fast_sqrtf((4 * f_b * f_b) + (f_a_c * f_a_c)) / 2.0f;
+    float p_add = fast_sqrtf(part0 + part1);
+    float p_sub = fast_sqrtf(part0 - part1);
+    float e_min = IM_MIN(p_add, p_sub);
+    float e_max = IM_MAX(p_add, p_sub);
+    out->magnitude = fast_roundf(e_max / e_min) - 1; // Circle -> [0, INF) -> Line
+
+    return regression_line(out, roi);
+}
+
+static inline uint32_t regression_rand(uint32_t *state) {
+    // xorshift32
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// Picks the line through two random points with the most points within tolerance of it, and
+// refits it with least squares on those points.
+static bool regression_ransac(find_lines_list_lnk_data_t *out, rectangle_t *roi, point_t *points,
+                              size_t points_count, unsigned int iterations, unsigned int tolerance) {
+    uint32_t state = 0x9E3779B9;
+    int best_inliers = 0;
+    point_t best_p0 = {}, best_p1 = {};
+    float best_tolerance = 0.0f;
+
+    for (unsigned int n = 0; n < iterations; n++) {
+        point_t *p0 = &points[regression_rand(&state) % points_count];
+        point_t *p1 = &points[regression_rand(&state) % points_count];
+        int dx = p1->x - p0->x;
+        int dy = p1->y - p0->y;
+
+        if ((!dx) && (!dy)) {
+            continue;
+        }
+
+        // |cross(p1 - p0, p - p0)| / |p1 - p0| is the distance of p to the line.
+        float tol = tolerance * fast_sqrtf((dx * dx) + (dy * dy));
+        int inliers = 0;
+
+        for (size_t i = 0; i < points_count; i++) {
+            int cross = (dx * (points[i].y - p0->y)) - (dy * (points[i].x - p0->x));
+            inliers += abs(cross) <= tol;
+        }
+
+        if (inliers > best_inliers) {
+            best_inliers = inliers;
+            best_p0 = *p0;
+            best_p1 = *p1;
+            best_tolerance = tol;
+        }
+    }
+
+    if (best_inliers < 2) {
+        return false;
+    }
+
+    int dx = best_p1.x - best_p0.x;
+    int dy = best_p1.y - best_p0.y;
+    int blob_pixels = 0, blob_cx = 0, blob_cy = 0;
+    long long blob_a = 0, blob_b = 0, blob_c = 0;
+
+    for (size_t i = 0; i < points_count; i++) {
+        int x = points[i].x, y = points[i].y;
+        int cross = (dx * (y - best_p0.y)) - (dy * (x - best_p0.x));
+        if (abs(cross) <= best_tolerance) {
+            blob_pixels += 1;
+            blob_cx += x;
+            blob_cy += y;
+            blob_a += x * x;
+            blob_b += x * y;
+            blob_c += y * y;
+        }
+    }
+
+    return regression_least_squares(out, roi, blob_pixels, blob_cx, blob_cy, blob_a, blob_b, blob_c);
+}
+
 bool imlib_get_regression(find_lines_list_lnk_data_t *out,
                           image_t *ptr,
                           rectangle_t *roi,
@@ -865,11 +1130,13 @@ bool imlib_get_regression(find_lines_list_lnk_data_t *out,
                           bool invert,
                           unsigned int area_threshold,
                           unsigned int pixels_threshold,
-                          bool robust) {
+                          regression_method_t method,
+                          unsigned int iterations,
+                          unsigned int tolerance) {
     bool result = false;
     memset(out, 0, sizeof(find_lines_list_lnk_data_t));
 
-    if (!robust) {
+    if (method == REGRESSION_LEAST_SQUARES) {
         // Least Squares
         int blob_x1 = roi->x + roi->w - 1;
         int blob_y1 = roi->y + roi->h - 1;
@@ -882,151 +1149,94 @@ bool imlib_get_regression(find_lines_list_lnk_data_t *out,
         long long blob_b = 0;
         long long blob_c = 0;
 
-        list_for_each(it, thresholds) {
-            color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
+        // The moments are accumulated per row in one pass, the y terms are applied once per row.
+        for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
+            int row_x1 = roi->x + roi->w - 1;
+            int row_x2 = roi->x;
+            int row_pixels = 0;
+            int row_cx = 0;
+            long long row_a = 0;
 
-            switch (ptr->pixfmt) {
-                case PIXFORMAT_BINARY: {
-                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
+            list_for_each(it, thresholds) {
+                color_thresholds_list_lnk_data_t *lnk_data = list_get_data(it);
+
+                switch (ptr->pixfmt) {
+                    case PIXFORMAT_BINARY: {
                         uint32_t *row_ptr = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(ptr, y);
                         for (int x = roi->x + (y % x_stride), xx = roi->x + roi->w; x < xx; x += x_stride) {
                             if (COLOR_THRESHOLD_BINARY(IMAGE_GET_BINARY_PIXEL_FAST(row_ptr, x), lnk_data, invert)) {
-                                blob_x1 = IM_MIN(blob_x1, x);
-                                blob_y1 = IM_MIN(blob_y1, y);
-                                blob_x2 = IM_MAX(blob_x2, x);
-                                blob_y2 = IM_MAX(blob_y2, y);
-                                blob_pixels += 1;
-                                blob_cx += x;
-                                blob_cy += y;
-                                blob_a += x * x;
-                                blob_b += x * y;
-                                blob_c += y * y;
+                                row_x1 = IM_MIN(row_x1, x);
+                                row_x2 = IM_MAX(row_x2, x);
+                                row_pixels += 1;
+                                row_cx += x;
+                                row_a += x * x;
                             }
                         }
+                        break;
                     }
-                    break;
-                }
-                case PIXFORMAT_GRAYSCALE: {
-                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
+                    case PIXFORMAT_GRAYSCALE: {
                         uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(ptr, y);
                         for (int x = roi->x + (y % x_stride), xx = roi->x + roi->w; x < xx; x += x_stride) {
                             if (COLOR_THRESHOLD_GRAYSCALE(IMAGE_GET_GRAYSCALE_PIXEL_FAST(row_ptr, x), lnk_data, invert)) {
-                                blob_x1 = IM_MIN(blob_x1, x);
-                                blob_y1 = IM_MIN(blob_y1, y);
-                                blob_x2 = IM_MAX(blob_x2, x);
-                                blob_y2 = IM_MAX(blob_y2, y);
-                                blob_pixels += 1;
-                                blob_cx += x;
-                                blob_cy += y;
-                                blob_a += x * x;
-                                blob_b += x * y;
-                                blob_c += y * y;
+                                row_x1 = IM_MIN(row_x1, x);
+                                row_x2 = IM_MAX(row_x2, x);
+                                row_pixels += 1;
+                                row_cx += x;
+                                row_a += x * x;
                             }
                         }
+                        break;
                     }
-                    break;
-                }
-                case PIXFORMAT_RGB565: {
-                    for (int y = roi->y, yy = roi->y + roi->h; y < yy; y += y_stride) {
+                    case PIXFORMAT_RGB565: {
                         uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(ptr, y);
                         for (int x = roi->x + (y % x_stride), xx = roi->x + roi->w; x < xx; x += x_stride) {
                             if (COLOR_THRESHOLD_RGB565(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x), lnk_data, invert)) {
-                                blob_x1 = IM_MIN(blob_x1, x);
-                                blob_y1 = IM_MIN(blob_y1, y);
-                                blob_x2 = IM_MAX(blob_x2, x);
-                                blob_y2 = IM_MAX(blob_y2, y);
-                                blob_pixels += 1;
-                                blob_cx += x;
-                                blob_cy += y;
-                                blob_a += x * x;
-                                blob_b += x * y;
-                                blob_c += y * y;
+                                row_x1 = IM_MIN(row_x1, x);
+                                row_x2 = IM_MAX(row_x2, x);
+                                row_pixels += 1;
+                                row_cx += x;
+                                row_a += x * x;
                             }
                         }
+                        break;
+                    }
+                    default: {
+                        break;
                     }
-                    break;
-                }
-                default: {
-                    break;
                 }
             }
+
+            if (row_pixels) {
+                blob_x1 = IM_MIN(blob_x1, row_x1);
+                blob_y1 = IM_MIN(blob_y1, y);
+                blob_x2 = IM_MAX(blob_x2, row_x2);
+                blob_y2 = IM_MAX(blob_y2, y);
+                blob_pixels += row_pixels;
+                blob_cx += row_cx;
+                blob_cy += row_pixels * y;
+                blob_a += row_a;
+                blob_b += ((long long) row_cx) * y;
+                blob_c += ((long long) row_pixels) * y * y;
+            }
         }
 
         int w = blob_x2 - blob_x1;
         int h = blob_y2 - blob_y1;
         if (blob_pixels && ((w * h) >= area_threshold) && (blob_pixels >= pixels_threshold)) {
-            // http://www.cse.usf.edu/~r1k/MachineVisionBook/MachineVision.files/MachineVision_Chapter2.pdf
-            // https://www.strchr.com/standard_deviation_in_one_pass
-            //
-            // a = sigma(x*x) + (mx*sigma(x)) + (mx*sigma(x)) + (sigma()*mx*mx)
-            // b = sigma(x*y) + (mx*sigma(y)) + (my*sigma(x)) + (sigma()*mx*my)
-            // c = sigma(y*y) + (my*sigma(y)) + (my*sigma(y)) + (sigma()*my*my)
-            //
-            // blob_a = sigma(x*x)
-            // blob_b = sigma(x*y)
-            // blob_c = sigma(y*y)
-            // blob_cx = sigma(x)
-            // blob_cy = sigma(y)
-            // blob_pixels = sigma()
-
-            int mx = blob_cx / blob_pixels; // x centroid
-            int my = blob_cy / blob_pixels; // y centroid
-            int small_blob_a = blob_a - ((mx * blob_cx) + (mx * blob_cx)) + (blob_pixels * mx * mx);
-            int small_blob_b = blob_b - ((mx * blob_cy) + (my * blob_cx)) + (blob_pixels * mx * my);
-            int small_blob_c = blob_c - ((my * blob_cy) + (my * blob_cy)) + (blob_pixels * my * my);
-
-            float rotation =
-                ((small_blob_a !=
-                  small_blob_c) ? (fast_atan2f(2 * small_blob_b, small_blob_a - small_blob_c) / 2.0f) : 1.570796f) + 1.570796f;                              // PI/2
-
-            out->theta = fast_roundf(rotation * 57.295780) % 180; // * (180 / PI)
-            if (out->theta < 0) {
-                out->theta += 180;
-            }
-            out->rho = fast_roundf(((mx - roi->x) * cos_table[out->theta]) + ((my - roi->y) * sin_table[out->theta]));
-
-            float part0 = (small_blob_a + small_blob_c) / 2.0f;
-            float f_b = (float) small_blob_b;
-            float f_a_c = (float) (small_blob_a - small_blob_c);
-            float part1 = fast_sqrtf((4 * f_b * f_b) + (f_a_c * f_a_c)) / 2.0f;
-            float p_add = fast_sqrtf(part0 + part1);
-            float p_sub = fast_sqrtf(part0 - part1);
-            float e_min = IM_MIN(p_add, p_sub);
-            float e_max = IM_MAX(p_add, p_sub);
-            out->magnitude = fast_roundf(e_max / e_min) - 1; // Circle -> [0, INF) -> Line
-
-            if ((45 <= out->theta) && (out->theta < 135)) {
-                // y = (r - x cos(t)) / sin(t)
-                out->line.x1 = 0;
-                out->line.y1 = fast_roundf((out->rho - (out->line.x1 * cos_table[out->theta])) / sin_table[out->theta]);
-                out->line.x2 = roi->w - 1;
-                out->line.y2 = fast_roundf((out->rho - (out->line.x2 * cos_table[out->theta])) / sin_table[out->theta]);
-            } else {
-                // x = (r - y sin(t)) / cos(t);
-                out->line.y1 = 0;
-                out->line.x1 = fast_roundf((out->rho - (out->line.y1 * sin_table[out->theta])) / cos_table[out->theta]);
-                out->line.y2 = roi->h - 1;
-                out->line.x2 = fast_roundf((out->rho - (out->line.y2 * sin_table[out->theta])) / cos_table[out->theta]);
-            }
-
-            if (lb_clip_line(&out->line, 0, 0, roi->w, roi->h)) {
-                out->line.x1 += roi->x;
-                out->line.y1 += roi->y;
-                out->line.x2 += roi->x;
-                out->line.y2 += roi->y;
-                // Move rho too.
-                out->rho += fast_roundf((roi->x * cos_table[out->theta]) + (roi->y * sin_table[out->theta]));
-                result = true;
-            } else {
-                memset(out, 0, sizeof(find_lines_list_lnk_data_t));
-            }
+            result = regression_least_squares(out, roi, blob_pixels, blob_cx, blob_cy, blob_a, blob_b, blob_c);
         }
     } else {
-        // Theil-Sen Estimator
+        // Theil-Sen Estimator and RANSAC
         int *x_histogram = fb_alloc0(ptr->w * sizeof(int), FB_ALLOC_NO_HINT);
         int *y_histogram = fb_alloc0(ptr->h * sizeof(int), FB_ALLOC_NO_HINT);
         long long *x_delta_histogram = fb_alloc0((2 * ptr->w) * sizeof(long long), FB_ALLOC_NO_HINT);
         long long *y_delta_histogram = fb_alloc0((2 * ptr->h) * sizeof(long long), FB_ALLOC_NO_HINT);
+        // The sampled deltas are few, their medians are selected directly.
+        int *x_deltas = NULL, *y_deltas = NULL;
+        if (method == REGRESSION_THEIL_SEN_SAMPLED) {
+            x_deltas = fb_alloc(IM_MAX(iterations, 1U) * sizeof(int), FB_ALLOC_NO_HINT);
+            y_deltas = fb_alloc(IM_MAX(iterations, 1U) * sizeof(int), FB_ALLOC_NO_HINT);
+        }
 
         uint32_t size;
         point_t *points = (point_t *) fb_alloc_all(&size, FB_ALLOC_NO_HINT);
@@ -1118,69 +1328,80 @@ bool imlib_get_regression(find_lines_list_lnk_data_t *out,
 
             int w = blob_x2 - blob_x1;
             int h = blob_y2 - blob_y1;
-            if (blob_pixels && ((w * h) >= area_threshold) && (blob_pixels >= pixels_threshold)) {
-                long long delta_sum = (points_count * (points_count - 1)) / 2;
-
-                if (delta_sum) {
-                    // The code below computes the average slope between all pairs of points.
-                    // This is a N^2 operation that can easily blow up if the image is not threshold carefully...
-
-                    for (int i = 0; i < points_count; i++) {
-                        point_t *p0 = &points[i];
-                        for (int j = i + 1; j < points_count; j++) {
-                            point_t *p1 = &points[j];
-                            // Note we allocated 1 extra above so we can do ptr->w instead of (ptr->w-1).
-                            x_delta_histogram[p0->x - p1->x + ptr->w]++;
-                            // Note we allocated 1 extra above so we can do ptr->h instead of (ptr->h-1).
-                            y_delta_histogram[p0->y - p1->y + ptr->h]++;
+            if (blob_pixels && ((w * h) >= area_threshold) && (blob_pixels >= pixels_threshold) && points_count) {
+                if (method == REGRESSION_RANSAC) {
+                    result = regression_ransac(out, roi, points, points_count, iterations, tolerance);
+                } else {
+                    long long delta_sum = 0;
+                    int mdx = 0, mdy = 0;
+
+                    if (method == REGRESSION_THEIL_SEN_SAMPLED) {
+                        // Random pairs of points, bounded by the number of iterations.
+                        uint32_t state = 0x9E3779B9;
+                        for (unsigned int n = 0; n < iterations; n++) {
+                            int i = regression_rand(&state) % points_count;
+                            int j = regression_rand(&state) % points_count;
+                            if (i != j) {
+                                point_t *p0 = &points[IM_MIN(i, j)];
+                                point_t *p1 = &points[IM_MAX(i, j)];
+                                x_deltas[delta_sum] = p0->x - p1->x;
+                                y_deltas[delta_sum] = p0->y - p1->y;
+                                delta_sum += 1;
+                            }
                         }
-                    }
 
-                    int mx = get_median(x_histogram, blob_pixels, ptr->w); // Output doesn't need adjustment.
-                    int my = get_median(y_histogram, blob_pixels, ptr->h); // Output doesn't need adjustment.
-                    int mdx = get_median_l(x_delta_histogram, delta_sum, 2 * ptr->w) - ptr->w; // Fix offset.
-                    int mdy = get_median_l(y_delta_histogram, delta_sum, 2 * ptr->h) - ptr->h; // Fix offset.
+                        if (delta_sum) {
+                            mdx = fselect(x_deltas, delta_sum, (delta_sum - 1) / 2);
+                            mdy = fselect(y_deltas, delta_sum, (delta_sum - 1) / 2);
+                        }
+                    } else {
+                        // The code below computes the average slope between all pairs of points.
+                        // This is a N^2 operation that can easily blow up if the image is not threshold carefully...
+                        for (int i = 0; i < points_count; i++) {
+                            point_t *p0 = &points[i];
+                            for (int j = i + 1; j < points_count; j++) {
+                                point_t *p1 = &points[j];
+                                // Note we allocated 1 extra above so we can do ptr->w instead of (ptr->w-1).
+                                x_delta_histogram[p0->x - p1->x + ptr->w]++;
+                                // Note we allocated 1 extra above so we can do ptr->h instead of (ptr->h-1).
+                                y_delta_histogram[p0->y - p1->y + ptr->h]++;
+                            }
+                        }
 
-                    float rotation = (mdx ? fast_atan2f(mdy, mdx) : 1.570796f) + 1.570796f; // PI/2
+                        delta_sum = (points_count * (points_count - 1)) / 2;
 
-                    out->theta = fast_roundf(rotation * 57.295780) % 180; // * (180 / PI)
-                    if (out->theta < 0) {
-                        out->theta += 180;
+                        if (delta_sum) {
+                            mdx = get_median_l(x_delta_histogram, delta_sum, 2 * ptr->w) - ptr->w; // Fix offset.
+                            mdy = get_median_l(y_delta_histogram, delta_sum, 2 * ptr->h) - ptr->h; // Fix offset.
+                        }
                     }
-                    out->rho = fast_roundf(((mx - roi->x) * cos_table[out->theta]) + ((my - roi->y) * sin_table[out->theta]));
 
-                    out->magnitude = fast_roundf(fast_sqrtf((mdx * mdx) + (mdy * mdy)));
+                    if (delta_sum) {
+                        int mx = get_median(x_histogram, blob_pixels, ptr->w); // Output doesn't need adjustment.
+                        int my = get_median(y_histogram, blob_pixels, ptr->h); // Output doesn't need adjustment.
 
-                    if ((45 <= out->theta) && (out->theta < 135)) {
-                        // y = (r - x cos(t)) / sin(t)
-                        out->line.x1 = 0;
-                        out->line.y1 = fast_roundf((out->rho - (out->line.x1 * cos_table[out->theta])) / sin_table[out->theta]);
-                        out->line.x2 = roi->w - 1;
-                        out->line.y2 = fast_roundf((out->rho - (out->line.x2 * cos_table[out->theta])) / sin_table[out->theta]);
-                    } else {
-                        // x = (r - y sin(t)) / cos(t);
-                        out->line.y1 = 0;
-                        out->line.x1 = fast_roundf((out->rho - (out->line.y1 * sin_table[out->theta])) / cos_table[out->theta]);
-                        out->line.y2 = roi->h - 1;
-                        out->line.x2 = fast_roundf((out->rho - (out->line.y2 * sin_table[out->theta])) / cos_table[out->theta]);
-                    }
+                        float rotation = (mdx ? fast_atan2f(mdy, mdx) : 1.570796f) + 1.570796f; // PI/2
 
-                    if (lb_clip_line(&out->line, 0, 0, roi->w, roi->h)) {
-                        out->line.x1 += roi->x;
-                        out->line.y1 += roi->y;
-                        out->line.x2 += roi->x;
-                        out->line.y2 += roi->y;
-                        // Move rho too.
-                        out->rho += fast_roundf((roi->x * cos_table[out->theta]) + (roi->y * sin_table[out->theta]));
-                        result = true;
-                    } else {
-                        memset(out, 0, sizeof(find_lines_list_lnk_data_t));
+                        out->theta = fast_roundf(rotation * 57.295780) % 180; // * (180 / PI)
+                        if (out->theta < 0) {
+                            out->theta += 180;
+                        }
+                        out->rho = fast_roundf(((mx - roi->x) * cos_table[out->theta]) +
+                                               ((my - roi->y) * sin_table[out->theta]));
+
+                        out->magnitude = fast_roundf(fast_sqrtf((mdx * mdx) + (mdy * mdy)));
+
+                        result = regression_line(out, roi);
                     }
                 }
             }
         }
 
         fb_free(); // points
+        if (method == REGRESSION_THEIL_SEN_SAMPLED) {
+            fb_free(); // y_deltas
+            fb_free(); // x_deltas
+        }
         fb_free(); // y_delta_histogram
         fb_free(); // x_delta_histogram
         fb_free(); // y_histogram
@@ -7,231 +7,237 @@
  * This work is licensed under the MIT license, see the file LICENSE for details.
  *
  * Stero Image Disparity
+ *
+ * Each view is census transformed (5x5 window, 24 bits) and the matching cost is the Hamming
+ * distance between census codes. The costs are aggregated with semi-global matching (Hirschmuller
+ * "Stereo Processing by Semiglobal Matching and Mutual Information") along the top-to-bottom,
+ * left-to-right and right-to-left paths which only need a rolling row of the cost volume. The
+ * disparity with the smallest aggregated cost wins.
  */
 #include "imlib.h"
+#include "simd.h"
 
 #ifdef IMLIB_ENABLE_STEREO_DISPARITY
 
-#define BLOCK_W       4
-#define BLOCK_H       4
-
-#define BLOCK_W_L     (((BLOCK_W) / 2) - 1)
-#define BLOCK_W_R     ((BLOCK_W) / 2)
-#define BLOCK_H_U     (((BLOCK_H) / 2) - 1)
-#define BLOCK_H_D     ((BLOCK_H) / 2)
-
-#define BLOCK_SIZE    ((BLOCK_W) *(BLOCK_H))
-
-static inline void shift(uint8_t *data, image_t *img, int x, int y) {
-#if defined(ARM_MATH_DSP) && (!(BLOCK_SIZE % 4))
-    int x_2 = x + BLOCK_W_R;
-    uint32_t *data_32 = (uint32_t *) data;
-
-    #if BLOCK_SIZE == 4
-    uint32_t temp = __UXTB16_RORn(*data_32, 8);
-    temp |= IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y) << 8;
-    temp |= IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y + 1) << 24;
-    *data_32 = temp;
-    #elif BLOCK_SIZE == 16
-    data_32[0] = (data_32[0] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y - 1) << 24);
-    data_32[1] = (data_32[1] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y) << 24);
-    data_32[2] = (data_32[2] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y + 1) << 24);
-    data_32[3] = (data_32[3] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y + 2) << 24);
-    #elif BLOCK_SIZE == 64
-    data_32[0] = (data_32[0] >> 8) | (data_32[1] << 24);
-    data_32[1] = (data_32[1] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y - 3) << 24);
-    data_32[2] = (data_32[2] >> 8) | (data_32[3] << 24);
-    data_32[3] = (data_32[3] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y - 2) << 24);
-    data_32[4] = (data_32[4] >> 8) | (data_32[5] << 24);
-    data_32[5] = (data_32[5] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y - 1) << 24);
-    data_32[6] = (data_32[6] >> 8) | (data_32[7] << 24);
-    data_32[7] = (data_32[7] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y) << 24);
-    data_32[8] = (data_32[8] >> 8) | (data_32[9] << 24);
-    data_32[9] = (data_32[9] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y + 1) << 24);
-    data_32[10] = (data_32[10] >> 8) | (data_32[11] << 24);
-    data_32[11] = (data_32[11] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y + 2) << 24);
-    data_32[12] = (data_32[12] >> 8) | (data_32[13] << 24);
-    data_32[13] = (data_32[13] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y + 3) << 24);
-    data_32[14] = (data_32[14] >> 8) | (data_32[15] << 24);
-    data_32[15] = (data_32[15] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y + 4) << 24);
-    #else
-    for (int j = -BLOCK_H_U, last = (BLOCK_W / sizeof(uint32_t)) - 1; j <= BLOCK_H_D; j++, data_32 += last + 1) {
-        for (int i = 0; i < last; i++) {
-            data_32[i] = (data_32[i] >> 8) | (data_32[i + 1] << 24);
+#define CENSUS_R          (2)
+#define CENSUS_ROWS       ((CENSUS_R * 2) + 1)
+#define CENSUS_PLANES     (3) // 24 bits stored as 3 byte planes.
+#define CENSUS_COST_MAX   (CENSUS_PLANES * 8)
+
+#define SGM_P1            (3) // Penalty for a disparity change of 1.
+#define SGM_P2            (20) // Penalty for larger disparity changes.
+
+// A path cost never exceeds CENSUS_COST_MAX + SGM_P2 so the sum of the 3 paths fits in a byte.
+
+typedef struct stereo_view {
+    int offset;
+    uint8_t *lines[CENSUS_ROWS];
+    uint8_t *census[CENSUS_PLANES];
+} stereo_view_t;
+
+static void stereo_load_line(stereo_view_t *view, image_t *img, int w, int line_w, int y) {
+    uint8_t *line = view->lines[(y + CENSUS_R) % CENSUS_ROWS];
+    uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, IM_CLAMP(y, 0, img->h - 1)) + view->offset;
+
+    memset(line, row_ptr[0], CENSUS_R);
+    memcpy(line + CENSUS_R, row_ptr, w);
+    memset(line + CENSUS_R + w, row_ptr[w - 1], line_w - CENSUS_R - w);
+}
+
+static void stereo_census(stereo_view_t *view, int w_v, int y) {
+    uint8_t *lines[CENSUS_ROWS];
+    v128_t one = vdup_u8(1);
+
+    for (int i = 0; i < CENSUS_ROWS; i++) {
+        lines[i] = view->lines[(y + i) % CENSUS_ROWS];
+    }
+
+    for (int x = 0; x < w_v; x += UINT8_VECTOR_SIZE) {
+        v128_t center = vldr_u8(lines[CENSUS_R] + x + CENSUS_R);
+        v128_t planes[CENSUS_PLANES];
+
+        for (int p = 0; p < CENSUS_PLANES; p++) {
+            planes[p] = vdup_u8(0);
+        }
+
+        for (int j = 0, b = 0; j < CENSUS_ROWS; j++) {
+            for (int i = 0; i < CENSUS_ROWS; i++) {
+                if ((j == CENSUS_R) && (i == CENSUS_R)) {
+                    continue;
+                }
+
+                // The bit is set when the neighbor is darker than the center.
+                v128_t bit = vmin_u8(vqsub_u8(center, vldr_u8(lines[j] + x + i)), one);
+                planes[b / 8] = vsli_u8(bit, planes[b / 8], 1);
+                b++;
+            }
+        }
+
+        for (int p = 0; p < CENSUS_PLANES; p++) {
+            vstr_u8(view->census[p] + x, planes[p]);
         }
-        data_32[last] = (data_32[last] >> 8) | (IMAGE_GET_GRAYSCALE_PIXEL(img, x_2, y + j) << 24);
     }
-    #endif
-#else
-    for (int i = 0, j = -BLOCK_H_U; j <= BLOCK_H_D; j++) {
-        int y_p = y + j;
-        uint8_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y_p);
-        for (int k = -BLOCK_W_L; k <= BLOCK_W_R; k++) {
-            int x_p = x + k;
-            data[i++] = IMAGE_GET_GRAYSCALE_PIXEL_FAST(k_row_ptr, x_p);
+}
+
+// Computes one row of the cost volume, stored disparity major.
+static void stereo_cost(uint8_t *cost, stereo_view_t *l, stereo_view_t *r, int w, int w_v, int n_d) {
+    v128_t m1 = vdup_u8(0x55);
+    v128_t m2 = vdup_u8(0x33);
+    v128_t m4 = vdup_u8(0x0F);
+
+    for (int d = 0; d < n_d; d++, cost += w_v) {
+        for (int x = 0; x < w_v; x += UINT8_VECTOR_SIZE) {
+            v128_t sum = vdup_u8(0);
+
+            // Per byte popcount, the 3 planes are summed in the nibbles (max 12) before folding.
+            for (int p = 0; p < CENSUS_PLANES; p++) {
+                v128_t v = veor_u32(vldr_u8(l->census[p] + x), vldr_u8(r->census[p] + x + d));
+                v = vsub_u8(v, vand_u32(vlsr_u32(v, 1), m1));
+                v = vqadd_u8(vand_u32(v, m2), vand_u32(vlsr_u32(v, 2), m2));
+                sum = vqadd_u8(sum, v);
+            }
+
+            vstr_u8(cost + x, vqadd_u8(vand_u32(sum, m4), vand_u32(vlsr_u32(sum, 4), m4)));
         }
+
+        // Matches that fall outside of the other view get the worst cost.
+        memset(cost + w - d, CENSUS_COST_MAX, w_v - w + d);
     }
-#endif
 }
 
-static inline uint32_t sad(uint8_t *data_l, uint8_t *data_r) {
-    uint32_t diff = 0;
-
-#if defined(ARM_MATH_DSP) && (!(BLOCK_SIZE % 4))
-    uint32_t *data_l_32 = (uint32_t *) data_l;
-    uint32_t *data_r_32 = (uint32_t *) data_r;
-
-    #if BLOCK_SIZE == 4
-    diff = __USADA8(*data_l_32, *data_r_32, diff);
-    #elif BLOCK_SIZE == 16
-    diff = __USADA8(data_l_32[0], data_r_32[0], diff);
-    diff = __USADA8(data_l_32[1], data_r_32[1], diff);
-    diff = __USADA8(data_l_32[2], data_r_32[2], diff);
-    diff = __USADA8(data_l_32[3], data_r_32[3], diff);
-    #elif BLOCK_SIZE == 64
-    diff = __USADA8(data_l_32[0],  data_r_32[0],  diff);
-    diff = __USADA8(data_l_32[1],  data_r_32[1],  diff);
-    diff = __USADA8(data_l_32[2],  data_r_32[2],  diff);
-    diff = __USADA8(data_l_32[3],  data_r_32[3],  diff);
-    diff = __USADA8(data_l_32[4],  data_r_32[4],  diff);
-    diff = __USADA8(data_l_32[5],  data_r_32[5],  diff);
-    diff = __USADA8(data_l_32[6],  data_r_32[6],  diff);
-    diff = __USADA8(data_l_32[7],  data_r_32[7],  diff);
-    diff = __USADA8(data_l_32[8],  data_r_32[8],  diff);
-    diff = __USADA8(data_l_32[9],  data_r_32[9],  diff);
-    diff = __USADA8(data_l_32[10], data_r_32[10], diff);
-    diff = __USADA8(data_l_32[11], data_r_32[11], diff);
-    diff = __USADA8(data_l_32[12], data_r_32[12], diff);
-    diff = __USADA8(data_l_32[13], data_r_32[13], diff);
-    diff = __USADA8(data_l_32[14], data_r_32[14], diff);
-    diff = __USADA8(data_l_32[15], data_r_32[15], diff);
-    #else
-    for (int i = 0; i < (BLOCK_SIZE / sizeof(uint32_t)); i++) {
-        diff = __USADA8(data_l_32[i], data_r_32[i], diff);
+// Top-to-bottom path, updated in place for all columns at once.
+static void stereo_path_vertical(uint8_t *path, uint8_t *path_min, uint8_t *cost, int w_v, int n_d) {
+    v128_t p1 = vdup_u8(SGM_P1);
+    v128_t p2 = vdup_u8(SGM_P2);
+
+    for (int x = 0; x < w_v; x += UINT8_VECTOR_SIZE) {
+        v128_t prev_min = vldr_u8(path_min + x);
+        v128_t prev_min_p2 = vqadd_u8(prev_min, p2);
+        v128_t new_min = vdup_u8(UINT8_MAX);
+        v128_t last = vdup_u8(UINT8_MAX);
+        v128_t curr = vldr_u8(path + x);
+
+        for (int d = 0, i = x; d < n_d; d++, i += w_v) {
+            v128_t next = ((d + 1) < n_d) ? vldr_u8(path + i + w_v) : vdup_u8(UINT8_MAX);
+            v128_t m = vmin_u8(vmin_u8(curr, vqadd_u8(vmin_u8(last, next), p1)), prev_min_p2);
+            v128_t l = vqadd_u8(vldr_u8(cost + i), vsub_u8(m, prev_min));
+            vstr_u8(path + i, l);
+            new_min = vmin_u8(new_min, l);
+            last = curr;
+            curr = next;
+        }
+
+        vstr_u8(path_min + x, new_min);
     }
-    #endif
-#else
-    for (int i = 0; i < BLOCK_SIZE; i++) {
-        int d = data_l[i] - data_r[i];
-        diff += abs(d);
+}
+
+// Advances a horizontal path by one column, returns the new minimum.
+static inline int stereo_path_step(uint8_t *path, int path_min, uint8_t *cost, int w_v, int n_d) {
+    int new_min = UINT8_MAX;
+    int last = UINT8_MAX;
+    int curr = path[0];
+
+    for (int d = 0; d < n_d; d++, cost += w_v) {
+        int next = ((d + 1) < n_d) ? path[d + 1] : UINT8_MAX;
+        int m = IM_MIN(IM_MIN(curr, IM_MIN(last, next) + SGM_P1), path_min + SGM_P2);
+        int l = *cost + m - path_min;
+        path[d] = l;
+        new_min = IM_MIN(new_min, l);
+        last = curr;
+        curr = next;
     }
-#endif
 
-    return diff;
+    return new_min;
 }
 
 void imlib_stereo_disparity(image_t *img, bool reversed, int max_disparity, int threshold) {
-    int width_2 = img->w / 2, width_2_m_1 = width_2 - 1;
-    int height_1 = img->h, height_1_m_1 = height_1 - 1;
-
-    int xl_offset = 0;
-    int xr_offset = width_2;
-
-    if (reversed) {
-        xl_offset = xr_offset;
-        xr_offset = 0;
+    if (img->pixfmt != PIXFORMAT_GRAYSCALE) {
+        return;
     }
 
+    int w = img->w / 2;
+    int w_v = ((w + UINT8_VECTOR_SIZE - 1) / UINT8_VECTOR_SIZE) * UINT8_VECTOR_SIZE;
+    int line_w = w_v + (CENSUS_R * 2);
+    int n_d = IM_MIN(max_disparity, w - 1) + 1;
     float disparity_scale = COLOR_GRAYSCALE_MAX / max_disparity;
 
-    image_t buf;
-    buf.w = width_2;
-    buf.h = BLOCK_H_D;
-    buf.pixfmt = img->pixfmt;
+    stereo_view_t views[2] = {
+        { .offset = reversed ? w : 0 },
+        { .offset = reversed ? 0 : w },
+    };
 
-    switch (img->pixfmt) {
-        case PIXFORMAT_BINARY: {
-            break;
+    for (int v = 0; v < 2; v++) {
+        for (int i = 0; i < CENSUS_ROWS; i++) {
+            views[v].lines[i] = fb_alloc(line_w, FB_ALLOC_PREFER_TCM);
         }
-        case PIXFORMAT_GRAYSCALE: {
-            buf.data = fb_alloc(IMAGE_GRAYSCALE_LINE_LEN_BYTES(&buf) * BLOCK_H_D, FB_ALLOC_NO_HINT);
-            uint8_t *data_l = fb_alloc(BLOCK_SIZE, FB_ALLOC_NO_HINT);
-            uint8_t *data_r = fb_alloc(BLOCK_SIZE, FB_ALLOC_NO_HINT);
-
-            for (int y = 0, yy = height_1 - BLOCK_H_D; y < height_1; y++) {
-                for (int xl = 0, xx = width_2 - BLOCK_W_R; xl < width_2; xl++) {
-                    if ((xl >= BLOCK_W_L) && (xl < xx) && (y >= BLOCK_H_U) && (y < yy)) {
-                        // fast way
-                        shift(data_l, img, xl + xl_offset, y);
-                    } else {
-                        // slow way
-                        for (int i = 0, j = -BLOCK_H_U; j <= BLOCK_H_D; j++) {
-                            int y_p = y + j;
-                            int y = IM_CLAMP(y_p, 0, height_1_m_1);
-                            uint8_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                            for (int k = -BLOCK_W_L; k <= BLOCK_W_R; k++) {
-                                int x_p = xl + k;
-                                int x = IM_CLAMP(x_p, 0, width_2_m_1) + xl_offset;
-                                data_l[i++] = IMAGE_GET_GRAYSCALE_PIXEL_FAST(k_row_ptr, x);
-                            }
-                        }
-                    }
-
-                    uint32_t min_diff = UINT32_MAX;
-                    int min_disparity = 0;
-
-                    for (int xr = xl, disparity = 0;
-                         (xr < width_2) && (disparity <= max_disparity); xr++, disparity++) {
-                        if (disparity && (xr >= BLOCK_W_L) && (xr < xx) && (y >= BLOCK_H_U) && (y < yy)) {
-                            // fast way
-                            shift(data_r, img, xr + xr_offset, y);
-                        } else {
-                            // slow way
-                            for (int i = 0, j = -BLOCK_H_U; j <= BLOCK_H_D; j++) {
-                                int y_p = y + j;
-                                int y = IM_CLAMP(y_p, 0, height_1_m_1);
-                                uint8_t *k_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y);
-                                for (int k = -BLOCK_W_L; k <= BLOCK_W_R; k++) {
-                                    int x_p = xr + k;
-                                    int x = IM_CLAMP(x_p, 0, width_2_m_1) + xr_offset;
-                                    data_r[i++] = IMAGE_GET_GRAYSCALE_PIXEL_FAST(k_row_ptr, x);
-                                }
-                            }
-                        }
-
-                        // Record the closest matching block in the scan line.
-                        uint32_t diff = sad(data_l, data_r);
-                        if (diff < min_diff) {
-                            min_diff = diff;
-                            min_disparity = disparity;
-                        }
-
-                        if (min_diff <= threshold) {
-                            break;
-                        }
-                    }
-
-                    uint8_t *buf_row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % BLOCK_H_D));
-                    IMAGE_PUT_GRAYSCALE_PIXEL_FAST(buf_row_ptr, xl, fast_floorf(min_disparity * disparity_scale));
-                }
 
-                if (y >= BLOCK_H_U) {
-                    // Transfer buffer lines...
-                    memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, (y - BLOCK_H_U)) + xr_offset,
-                           IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, ((y - BLOCK_H_U) % BLOCK_H_D)),
-                           IMAGE_GRAYSCALE_LINE_LEN_BYTES(&buf));
-                }
+        // The second view is read up to n_d pixels past the row.
+        for (int p = 0; p < CENSUS_PLANES; p++) {
+            views[v].census[p] = fb_alloc0(w_v + n_d, FB_ALLOC_PREFER_TCM);
+        }
+    }
+
+    uint8_t *cost = fb_alloc(n_d * w_v, FB_ALLOC_PREFER_TCM);
+    uint8_t *sum = fb_alloc(n_d * w_v, FB_ALLOC_PREFER_TCM);
+    uint8_t *path_v = fb_alloc0(n_d * w_v, FB_ALLOC_PREFER_TCM);
+    uint8_t *path_v_min = fb_alloc0(w_v, FB_ALLOC_PREFER_TCM);
+    uint8_t *path_h = fb_alloc(n_d, FB_ALLOC_PREFER_TCM);
+
+    for (int y = -CENSUS_R; y < CENSUS_R; y++) {
+        stereo_load_line(&views[0], img, w, line_w, y);
+        stereo_load_line(&views[1], img, w, line_w, y);
+    }
+
+    for (int y = 0; y < img->h; y++) {
+        // The source rows are buffered so the output can overwrite the second view in place.
+        stereo_load_line(&views[0], img, w, line_w, y + CENSUS_R);
+        stereo_load_line(&views[1], img, w, line_w, y + CENSUS_R);
+        stereo_census(&views[0], w_v, y);
+        stereo_census(&views[1], w_v, y);
+
+        stereo_cost(cost, &views[0], &views[1], w, w_v, n_d);
+        stereo_path_vertical(path_v, path_v_min, cost, w_v, n_d);
+
+        // Left-to-right path.
+        memset(path_h, 0, n_d);
+        for (int x = 0, path_min = 0; x < w; x++) {
+            path_min = stereo_path_step(path_h, path_min, cost + x, w_v, n_d);
+            for (int d = 0, i = x; d < n_d; d++, i += w_v) {
+                sum[i] = path_v[i] + path_h[d];
             }
+        }
 
-            // Copy any remaining lines from the buffer image...
-            for (int y = IM_MAX(height_1 - BLOCK_H_U, 0); y < height_1; y++) {
-                memcpy(IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y) + xr_offset,
-                       IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(&buf, (y % BLOCK_H_D)),
-                       IMAGE_GRAYSCALE_LINE_LEN_BYTES(&buf));
+        // Right-to-left path and winner-takes-all.
+        uint8_t *row_ptr = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, y) + views[1].offset;
+        memset(path_h, 0, n_d);
+        for (int x = w - 1, path_min = 0; x >= 0; x--) {
+            path_min = stereo_path_step(path_h, path_min, cost + x, w_v, n_d);
+
+            int min_cost = INT_MAX;
+            int min_disparity = 0;
+            for (int d = 0, i = x; d < n_d; d++, i += w_v) {
+                int c = sum[i] + path_h[d];
+                if (c < min_cost) {
+                    min_cost = c;
+                    min_disparity = d;
+                }
             }
 
-            fb_free(); // data_r
-            fb_free(); // data_l
-            fb_free(); // buf
-            break;
-        }
-        case PIXFORMAT_RGB565: {
-            break;
-        }
-        default: {
-            break;
+            // Matches that are too weak are marked invalid.
+            IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row_ptr, x,
+                                           (min_cost <= threshold) ? fast_floorf(min_disparity * disparity_scale) : 0);
         }
     }
+
+    fb_free(); // path_h
+    fb_free(); // path_v_min
+    fb_free(); // path_v
+    fb_free(); // sum
+    fb_free(); // cost
+
+    for (int i = 0; i < (2 * (CENSUS_ROWS + CENSUS_PLANES)); i++) {
+        fb_free(); // census, lines
+    }
 }
 
 #endif // IMLIB_ENABLE_STEREO_DISPARITY
@@ -19,6 +19,14 @@
 
 #include "imlib.h"
 #include "xalloc.h"
+#include "fb_alloc.h"
+#include "fft.h"
+
+// Largest search area the FFT path handles (fft.c supports 1024 point real and 512 point complex FFTs).
+#define TEMPLATE_FFT_MAX_W      (1024)
+#define TEMPLATE_FFT_MAX_H      (512)
+// Rough cost of one FFT stage per spectrum float relative to one integer multiply-accumulate.
+#define TEMPLATE_FFT_COST       (1)
 
 static void set_dsp(int cx, int cy, point_t *pts, bool sdsp, int step) {
     if (sdsp) {
@@ -217,20 +225,11 @@ float imlib_template_match_ds(image_t *f, image_t *t, rectangle_t *r) {
  * NOTE: only the denominator is optimized.
  *
  */
-float imlib_template_match_ex(image_t *f, image_t *t, rectangle_t *roi, int step, rectangle_t *r) {
+static float template_match_ex_spatial(image_t *f, image_t *t, rectangle_t *roi, int step,
+                                       i_image_t *sum, i_image_t *sumsq, rectangle_t *r) {
     int den_b = 0;
     float corr = 0.0f;
 
-    // Integral images
-    i_image_t sum;
-    i_image_t sumsq;
-
-    imlib_integral_image_alloc(&sum, f->w, f->h);
-    imlib_integral_image_alloc(&sumsq, f->w, f->h);
-
-    imlib_integral_image(f, &sum);
-    imlib_integral_image_sq(f, &sumsq);
-
     // Normalized sum of squares of the template
     int t_mean = 0;
     imlib_image_mean(t, &t_mean, &t_mean, &t_mean);
@@ -244,8 +243,8 @@ float imlib_template_match_ex(image_t *f, image_t *t, rectangle_t *roi, int step
         for (int u = roi->x; u <= (roi->x + roi->w - t->w); u += step) {
             int num = 0;
             // The mean of the current patch
-            uint32_t f_sum = imlib_integral_lookup(&sum, u, v, t->w, t->h);
-            uint32_t f_sumsq = imlib_integral_lookup(&sumsq, u, v, t->w, t->h);
+            uint32_t f_sum = imlib_integral_lookup(sum, u, v, t->w, t->h);
+            uint32_t f_sumsq = imlib_integral_lookup(sumsq, u, v, t->w, t->h);
             uint32_t f_mean = f_sum / (float) (t->w * t->h);
 
             // Normalized sum of squares of the image
@@ -272,7 +271,129 @@ float imlib_template_match_ex(image_t *f, image_t *t, rectangle_t *roi, int step
         }
     }
 
-    imlib_integral_image_free(&sum);
+    return corr;
+}
+
+/* Computes the NCC numerator for every position at once in the frequency domain. The frame
+ * is transformed once and correlated against each template spectrum (F * conj(T)). Because
+ * the template's mean is removed analytically, sum((f - f_mean) * (t - t_mean)) becomes
+ * sum(f * t) - t_sum * f_sum / n, where f_sum comes from the integral image.
+ *
+ * See J. P. Lewis "Fast normalized cross-correlation".
+ */
+static void template_match_ex_fft(image_t *f, image_t **t, int n, rectangle_t *roi, int step,
+                                  i_image_t *sum, i_image_t *sumsq, rectangle_t *r, float *corr) {
+    fft2d_controller_t fft_f, fft_t;
+    fft2d_alloc(&fft_f, f, roi);
+    fft2d_run(&fft_f);
+
+    int row_len = 2 << fft_f.w_pow2;
+    int len = row_len << fft_f.h_pow2;
+
+    for (int i = 0; i < n; i++) {
+        image_t *ti = t[i];
+        int area = ti->w * ti->h;
+
+        uint32_t t_sum = 0, t_sumsq = 0;
+        for (int j = 0; j < area; j++) {
+            t_sum += ti->data[j];
+            t_sumsq += ti->data[j] * ti->data[j];
+        }
+
+        float t_mean = t_sum / (float) area;
+        float den_b = t_sumsq - (t_sum * t_mean);
+
+        // Zero padded to the frame transform size.
+        rectangle_t t_rect = {0, 0, ti->w, ti->h};
+        fft2d_alloc_pad(&fft_t, ti, &t_rect, roi->w, roi->h);
+        fft2d_run(&fft_t);
+
+        for (int j = 0; j < len; j += 2) {
+            float f_r = fft_f.data[j + 0], f_i = fft_f.data[j + 1];
+            float t_r = fft_t.data[j + 0], t_i = fft_t.data[j + 1];
+            fft_t.data[j + 0] = (f_r * t_r) + (f_i * t_i);
+            fft_t.data[j + 1] = (f_i * t_r) - (f_r * t_i);
+        }
+
+        ifft2d_run(&fft_t);
+
+        corr[i] = 0.0f;
+        for (int v = 0; v <= (roi->h - ti->h); v += step) {
+            float *row = fft_t.data + (v * row_len);
+            for (int u = 0; u <= (roi->w - ti->w); u += step) {
+                uint32_t f_sum = imlib_integral_lookup(sum, roi->x + u, roi->y + v, ti->w, ti->h);
+                uint32_t f_sumsq = imlib_integral_lookup(sumsq, roi->x + u, roi->y + v, ti->w, ti->h);
+                float den_a = f_sumsq - f_sum * (f_sum / (float) area);
+                float num = row[u] - (f_sum * t_mean);
+
+                // Find normalized cross-correlation
+                float c = num / (fast_sqrtf(den_a) * fast_sqrtf(den_b));
+
+                if (c > corr[i]) {
+                    corr[i] = c;
+                    r[i].x = roi->x + u;
+                    r[i].y = roi->y + v;
+                    r[i].w = ti->w;
+                    r[i].h = ti->h;
+                }
+            }
+        }
+
+        fft2d_dealloc(); // fft_t
+    }
+
+    fft2d_dealloc(); // fft_f
+}
+
+// The FFT path wins once the spatial search costs more than the transforms, and it needs two
+// full size spectrums (frame and template) in the frame buffer.
+static bool template_match_use_fft(image_t **t, int n, rectangle_t *roi, int step) {
+    if ((roi->w > TEMPLATE_FFT_MAX_W) || (roi->h > TEMPLATE_FFT_MAX_H)) {
+        return false;
+    }
+
+    size_t len = fft2d_data_len(roi->w, roi->h);
+    // Frame and template spectrums plus a row of scratch for the transforms.
+    if (fb_avail() < (((len * 2) + (len / 2)) * sizeof(float))) {
+        return false;
+    }
+
+    uint64_t spatial_cost = 0;
+    for (int i = 0; i < n; i++) {
+        uint32_t positions = (((roi->w - t[i]->w) / step) + 1) * (((roi->h - t[i]->h) / step) + 1);
+        spatial_cost += (uint64_t) positions * t[i]->w * t[i]->h;
+    }
+
+    // One frame transform plus a forward and an inverse transform per template.
+    int log2_len = 31 - __CLZ(len);
+    uint64_t fft_cost = (uint64_t) len * log2_len * ((n * 2) + 1) * TEMPLATE_FFT_COST;
+    return spatial_cost > fft_cost;
+}
+
+void imlib_template_match_ex_n(image_t *f, image_t **t, int n, rectangle_t *roi, int step, rectangle_t *r, float *corr) {
+    // Integral images
+    i_image_t sum;
+    i_image_t sumsq;
+
+    imlib_integral_image_alloc(&sum, f->w, f->h);
+    imlib_integral_image_alloc(&sumsq, f->w, f->h);
+
+    imlib_integral_image_ss(f, &sum, &sumsq);
+
+    if (template_match_use_fft(t, n, roi, step)) {
+        template_match_ex_fft(f, t, n, roi, step, &sum, &sumsq, r, corr);
+    } else {
+        for (int i = 0; i < n; i++) {
+            corr[i] = template_match_ex_spatial(f, t[i], roi, step, &sum, &sumsq, &r[i]);
+        }
+    }
+
     imlib_integral_image_free(&sumsq);
+    imlib_integral_image_free(&sum);
+}
+
+float imlib_template_match_ex(image_t *f, image_t *t, rectangle_t *roi, int step, rectangle_t *r) {
+    float corr;
+    imlib_template_match_ex_n(f, &t, 1, roi, step, r, &corr);
     return corr;
 }
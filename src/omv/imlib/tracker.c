@@ -0,0 +1,213 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Multi-object tracker.
+ *
+ * Detections are associated with the predicted position of the tracks greedily, the pairs with
+ * the largest overlap (IoU) are matched first, then the pairs that don't overlap but whose
+ * centroids are close. Unmatched detections start new tracks and tracks that aren't matched
+ * for too long are removed. Each centroid axis is optionally predicted with a constant velocity
+ * Kalman filter. The track table is preallocated by the caller.
+ */
+#include <stdlib.h>
+#include "imlib.h"
+#include "fb_alloc.h"
+
+#ifdef IMLIB_ENABLE_TRACKER
+typedef struct tracker_pair {
+    float score;
+    uint16_t track;
+    uint16_t detection;
+} tracker_pair_t;
+
+static int tracker_pair_compare(const void *a, const void *b) {
+    float sa = ((const tracker_pair_t *) a)->score;
+    float sb = ((const tracker_pair_t *) b)->score;
+    return (sa < sb) - (sa > sb);
+}
+
+static float tracker_iou(imlib_tracker_track_t *track, rectangle_t *r) {
+    float x0 = IM_MAX(track->x - (track->w / 2.0f), (float) r->x);
+    float y0 = IM_MAX(track->y - (track->h / 2.0f), (float) r->y);
+    float x1 = IM_MIN(track->x + (track->w / 2.0f), (float) (r->x + r->w));
+    float y1 = IM_MIN(track->y + (track->h / 2.0f), (float) (r->y + r->h));
+
+    if ((x1 <= x0) || (y1 <= y0)) {
+        return 0.0f;
+    }
+
+    float intersection = (x1 - x0) * (y1 - y0);
+    return intersection / ((track->w * track->h) + (r->w * r->h) - intersection);
+}
+
+// Constant velocity model, the state is moved by one update.
+static void tracker_predict_axis(float *x, float *v, float *p, float q) {
+    *x += *v;
+    p[0] += (2.0f * p[1]) + p[2] + (q / 4.0f);
+    p[1] += p[2] + (q / 2.0f);
+    p[2] += q;
+}
+
+static void tracker_correct_axis(float *x, float *v, float *p, float z, float r) {
+    float s = p[0] + r;
+    float k0 = p[0] / s;
+    float k1 = p[1] / s;
+    float e = z - *x;
+
+    *x += k0 * e;
+    *v += k1 * e;
+    p[2] -= k1 * p[1];
+    p[1] -= k0 * p[1];
+    p[0] -= k0 * p[0];
+}
+
+static void tracker_correct(imlib_tracker_t *tracker, imlib_tracker_track_t *track, imlib_tracker_detection_t *d) {
+    float cx = d->rect.x + (d->rect.w / 2.0f);
+    float cy = d->rect.y + (d->rect.h / 2.0f);
+
+    if (tracker->kalman) {
+        tracker_correct_axis(&track->x, &track->vx, track->p[0], cx, tracker->measurement_noise);
+        tracker_correct_axis(&track->y, &track->vy, track->p[1], cy, tracker->measurement_noise);
+    } else {
+        track->x = cx;
+        track->y = cy;
+    }
+
+    track->w = d->rect.w;
+    track->h = d->rect.h;
+    track->index = d->index;
+    track->hits += (track->hits < UINT16_MAX);
+    track->misses = 0;
+}
+
+static void tracker_add(imlib_tracker_t *tracker, imlib_tracker_detection_t *d) {
+    imlib_tracker_track_t *track = &tracker->tracks[tracker->n_tracks++];
+
+    track->id = tracker->next_id++;
+    track->label = d->label;
+    track->index = d->index;
+    track->hits = 1;
+    track->misses = 0;
+    track->x = d->rect.x + (d->rect.w / 2.0f);
+    track->y = d->rect.y + (d->rect.h / 2.0f);
+    track->vx = 0.0f;
+    track->vy = 0.0f;
+    track->w = d->rect.w;
+    track->h = d->rect.h;
+
+    // The position is as good as the detection, the velocity is unknown.
+    for (int i = 0; i < 2; i++) {
+        track->p[i][0] = tracker->measurement_noise;
+        track->p[i][1] = 0.0f;
+        track->p[i][2] = tracker->measurement_noise;
+    }
+}
+
+void imlib_tracker_init(imlib_tracker_t *tracker, imlib_tracker_track_t *tracks, size_t max_tracks) {
+    tracker->tracks = tracks;
+    tracker->max_tracks = max_tracks;
+    tracker->max_misses = 5;
+    tracker->iou_threshold = 0.3f;
+    tracker->max_distance = 0.0f;
+    tracker->kalman = true;
+    tracker->process_noise = 1.0f;
+    tracker->measurement_noise = 10.0f;
+    imlib_tracker_reset(tracker);
+}
+
+void imlib_tracker_reset(imlib_tracker_t *tracker) {
+    tracker->n_tracks = 0;
+    tracker->next_id = 1;
+}
+
+void imlib_tracker_update(imlib_tracker_t *tracker, imlib_tracker_detection_t *detections, size_t n) {
+    fb_alloc_mark();
+
+    size_t n_pairs = 0;
+    tracker_pair_t *pairs = fb_alloc(tracker->n_tracks * n * sizeof(tracker_pair_t), FB_ALLOC_PREFER_SPEED);
+    uint8_t *matched = fb_alloc0(tracker->n_tracks + n, FB_ALLOC_NO_HINT);
+    uint8_t *detection_matched = matched + tracker->n_tracks;
+    float max_distance_2 = tracker->max_distance * tracker->max_distance;
+
+    for (size_t i = 0; i < tracker->n_tracks; i++) {
+        imlib_tracker_track_t *track = &tracker->tracks[i];
+
+        if (tracker->kalman) {
+            tracker_predict_axis(&track->x, &track->vx, track->p[0], tracker->process_noise);
+            tracker_predict_axis(&track->y, &track->vy, track->p[1], tracker->process_noise);
+        }
+
+        // Overlapping pairs are scored by IoU, close pairs by the negated distance so they come after.
+        for (size_t j = 0; j < n; j++) {
+            imlib_tracker_detection_t *d = &detections[j];
+
+            if (d->label != track->label) {
+                continue;
+            }
+
+            float iou = tracker_iou(track, &d->rect);
+
+            if ((iou > 0.0f) && (iou >= tracker->iou_threshold)) {
+                pairs[n_pairs++] = (tracker_pair_t) { iou, i, j };
+            } else if (max_distance_2 > 0.0f) {
+                float dx = d->rect.x + (d->rect.w / 2.0f) - track->x;
+                float dy = d->rect.y + (d->rect.h / 2.0f) - track->y;
+                float distance_2 = (dx * dx) + (dy * dy);
+
+                if (distance_2 <= max_distance_2) {
+                    pairs[n_pairs++] = (tracker_pair_t) { -fast_sqrtf(distance_2), i, j };
+                }
+            }
+        }
+    }
+
+    qsort(pairs, n_pairs, sizeof(tracker_pair_t), tracker_pair_compare);
+
+    for (size_t i = 0; i < n_pairs; i++) {
+        if ((!matched[pairs[i].track]) && (!detection_matched[pairs[i].detection])) {
+            matched[pairs[i].track] = 1;
+            detection_matched[pairs[i].detection] = 1;
+            tracker_correct(tracker, &tracker->tracks[pairs[i].track], &detections[pairs[i].detection]);
+        }
+    }
+
+    // Remove the lost tracks, the table is compacted in order so ids stay sorted by age.
+    size_t n_tracks = 0;
+    for (size_t i = 0; i < tracker->n_tracks; i++) {
+        imlib_tracker_track_t *track = &tracker->tracks[i];
+
+        if (!matched[i]) {
+            track->index = -1;
+            track->misses += (track->misses < UINT16_MAX);
+        }
+
+        if (track->misses <= tracker->max_misses) {
+            tracker->tracks[n_tracks++] = *track;
+        }
+    }
+
+    tracker->n_tracks = n_tracks;
+
+    for (size_t j = 0; (j < n) && (tracker->n_tracks < tracker->max_tracks); j++) {
+        if (!detection_matched[j]) {
+            tracker_add(tracker, &detections[j]);
+        }
+    }
+
+    fb_alloc_free_till_mark();
+}
+
+void imlib_tracker_track_rect(imlib_tracker_track_t *track, bool predicted, rectangle_t *r) {
+    float x = track->x + (predicted ? track->vx : 0.0f);
+    float y = track->y + (predicted ? track->vy : 0.0f);
+    r->x = fast_roundf(x - (track->w / 2.0f));
+    r->y = fast_roundf(y - (track->h / 2.0f));
+    r->w = fast_roundf(track->w);
+    r->h = fast_roundf(track->h);
+}
+#endif // IMLIB_ENABLE_TRACKER
@@ -1,3 +1,4 @@
+#include <stdint.h>
 const float xyz_table[256] = {
     0.000000f,  0.030353f,  0.060705f,  0.091058f,  0.121411f,  0.151763f,  0.182116f,  0.212469f,
     0.242822f,  0.273174f,  0.303527f,  0.334654f,  0.367651f,  0.402472f,  0.439144f,  0.477695f,
@@ -32,3 +33,59 @@ const float xyz_table[256] = {
     87.136712f, 87.962240f, 88.792312f, 89.626935f, 90.466117f, 91.309865f, 92.158186f, 93.011086f,
     93.868573f, 94.730654f, 95.597335f, 96.468625f, 97.344529f, 98.225055f, 99.110210f, 100.000000f
 };
+
+// RGB565 channels (R5/B5 and G6) to linear light scaled to 0-65535.
+const uint16_t xyz_lin5_table[32] = {
+        0,   159,   340,   599,   997,  1453,  2013,  2681,
+     3570,  4488,  5530,  6700,  8177,  9635, 11235, 12980,
+    15122, 17187, 19407, 21787, 24658, 27386, 30282, 33350,
+    37008, 40449, 44069, 47871, 52369, 56567, 60955, 65535
+};
+
+const uint16_t xyz_lin6_table[64] = {
+        0,    80,   159,   241,   340,   458,   599,   761,
+      947,  1156,  1391,  1651,  1937,  2250,  2592,  2961,
+     3464,  3900,  4366,  4864,  5392,  5953,  6547,  7174,
+     7834,  8528,  9258, 10022, 10822, 11658, 12530, 13440,
+    14629, 15623, 16656, 17727, 18837, 19987, 21177, 22407,
+    23678, 24990, 26344, 27739, 29176, 30656, 32179, 33745,
+    35764, 37429, 39138, 40891, 42690, 44534, 46423, 48359,
+    50341, 52369, 54445, 56567, 58737, 60955, 63221, 65535
+};
+
+// CIELAB f(t) for t = i/256, scaled to 0-65535 (interpolated between entries).
+const uint16_t lab_f_table[257] = {
+     9039, 11033, 13026, 14886, 16384, 17649, 18755, 19744,
+    20643, 21469, 22237, 22954, 23630, 24269, 24876, 25454,
+    26008, 26539, 27049, 27541, 28016, 28476, 28921, 29352,
+    29772, 30180, 30577, 30964, 31341, 31710, 32071, 32423,
+    32768, 33106, 33437, 33762, 34080, 34393, 34700, 35002,
+    35298, 35590, 35877, 36160, 36438, 36712, 36982, 37248,
+    37510, 37769, 38024, 38276, 38524, 38770, 39012, 39251,
+    39488, 39721, 39952, 40181, 40406, 40630, 40850, 41069,
+    41285, 41499, 41711, 41920, 42128, 42333, 42537, 42739,
+    42938, 43136, 43332, 43526, 43719, 43910, 44099, 44287,
+    44473, 44658, 44841, 45022, 45202, 45381, 45558, 45734,
+    45909, 46082, 46254, 46424, 46594, 46762, 46929, 47095,
+    47260, 47423, 47586, 47747, 47907, 48066, 48224, 48381,
+    48538, 48693, 48847, 49000, 49152, 49303, 49454, 49603,
+    49751, 49899, 50046, 50192, 50337, 50481, 50624, 50767,
+    50909, 51050, 51190, 51330, 51468, 51606, 51744, 51880,
+    52016, 52151, 52285, 52419, 52552, 52685, 52816, 52947,
+    53078, 53208, 53337, 53465, 53593, 53720, 53847, 53973,
+    54099, 54224, 54348, 54472, 54595, 54718, 54840, 54962,
+    55083, 55203, 55323, 55443, 55562, 55680, 55798, 55916,
+    56032, 56149, 56265, 56381, 56496, 56610, 56724, 56838,
+    56951, 57064, 57176, 57288, 57400, 57511, 57621, 57731,
+    57841, 57951, 58059, 58168, 58276, 58384, 58491, 58598,
+    58705, 58811, 58917, 59022, 59127, 59232, 59336, 59440,
+    59543, 59647, 59749, 59852, 59954, 60056, 60157, 60258,
+    60359, 60460, 60560, 60659, 60759, 60858, 60957, 61055,
+    61153, 61251, 61349, 61446, 61543, 61640, 61736, 61832,
+    61928, 62023, 62118, 62213, 62308, 62402, 62496, 62590,
+    62683, 62776, 62869, 62962, 63054, 63146, 63238, 63329,
+    63420, 63511, 63602, 63693, 63783, 63873, 63963, 64052,
+    64141, 64230, 64319, 64407, 64496, 64584, 64671, 64759,
+    64846, 64933, 65020, 65107, 65193, 65279, 65365, 65451,
+    65535
+};
@@ -22,7 +22,29 @@ void imlib_deyuv_line(int x_start, int x_end, int y_row, void *dst_row_ptr, pixf
     int shift = (src->pixfmt == PIXFORMAT_YUV422) ? 16 : 0;
     int src_w = src->w, w_limit = src_w - 1;
 
-    uint16_t *rowptr_yuv = ((uint16_t *) src->data) + (y_row * src_w);
+    uint16_t *rowptr_yuv = IMAGE_COMPUTE_YUV_PIXEL_ROW_PTR(src, y_row);
+
+    if (pixfmt == PIXFORMAT_GRAYSCALE) {
+        // Luma is the low byte of every pixel so it's gathered 4 pixels at a time without
+        // touching the chroma.
+        uint8_t *row_ptr_8 = (uint8_t *) dst_row_ptr;
+        int x = x_start;
+
+        for (; (x + 4) <= x_end; x += 4) {
+            uint32_t p01 = *((uint32_t *) (rowptr_yuv + x));
+            uint32_t p23 = *((uint32_t *) (rowptr_yuv + x + 2));
+            row_ptr_8[x + 0] = p01;
+            row_ptr_8[x + 1] = p01 >> 16;
+            row_ptr_8[x + 2] = p23;
+            row_ptr_8[x + 3] = p23 >> 16;
+        }
+
+        for (; x < x_end; x++) {
+            IMAGE_PUT_GRAYSCALE_PIXEL_FAST(row_ptr_8, x, rowptr_yuv[x] & 0xff);
+        }
+
+        return;
+    }
 
     // If the image is an odd width this will go for the last loop and we drop the last column.
     for (int x = x_start; x < x_end; x += 2) {
@@ -131,3 +153,44 @@ void imlib_deyuv_image(image_t *dst, image_t *src) {
         imlib_deyuv_line(0, src_w, y, row_ptr, dst->pixfmt, src);
     }
 }
+
+// Thresholds YUV pixels without converting them. LMin/LMax bound Y, AMin/AMax bound U and
+// BMin/BMax bound V with the chroma centered on zero. Each pair of pixels shares its chroma so
+// it's only tested once per pair. Passing pixels are set in dst_row_ptr, others are untouched.
+void imlib_yuv_threshold_line(int x_start, int x_end, int y_row, uint32_t *dst_row_ptr, image_t *src,
+                              color_thresholds_list_lnk_data_t *threshold, bool invert) {
+    bool yuyv = src->pixfmt == PIXFORMAT_YUV422;
+    int w_limit = src->w - 1;
+
+    uint16_t *rowptr_yuv = IMAGE_COMPUTE_YUV_PIXEL_ROW_PTR(src, y_row);
+
+    for (int x = x_start & ~1; x < x_end; x += 2) {
+        uint32_t pixels;
+
+        if (x < w_limit) {
+            pixels = *((uint32_t *) (rowptr_yuv + x));
+        } else if (x) {
+            // The last column of an odd width image borrows the chroma of the previous pixel.
+            pixels = (rowptr_yuv[x - 1] << 16) | rowptr_yuv[x];
+        } else {
+            pixels = 0x80000000 | rowptr_yuv[x];
+        }
+
+        int c0 = (int8_t) ((pixels >> 8) ^ 0x80);
+        int c1 = (int8_t) ((pixels >> 24) ^ 0x80);
+        int u = yuyv ? c0 : c1;
+        int v = yuyv ? c1 : c0;
+        bool uv = (threshold->AMin <= u) && (u <= threshold->AMax) &&
+                  (threshold->BMin <= v) && (v <= threshold->BMax);
+
+        int y0 = pixels & 0xff;
+        if ((x >= x_start) && ((uv && (threshold->LMin <= y0) && (y0 <= threshold->LMax)) ^ invert)) {
+            IMAGE_SET_BINARY_PIXEL_FAST(dst_row_ptr, x);
+        }
+
+        int y1 = (pixels >> 16) & 0xff;
+        if (((x + 1) < x_end) && ((uv && (threshold->LMin <= y1) && (y1 <= threshold->LMax)) ^ invert)) {
+            IMAGE_SET_BINARY_PIXEL_FAST(dst_row_ptr, x + 1);
+        }
+    }
+}
@@ -1609,6 +1609,8 @@ struct zbar_image_scanner_s {
     unsigned ean_config;
     int configs[NUM_SCN_CFGS];  /* int valued configurations */
     int sym_configs[1][NUM_SYMS]; /* per-symbology configurations */
+    int early_exit;             /* OpenMV: stop at the first confirmed symbol */
+    imlib_deadline_t *deadline; /* OpenMV: stop scanning once out of time */
 
 #ifndef NO_STATS
     int stat_syms_new;
@@ -2140,6 +2142,25 @@ static inline void quiet_border (zbar_image_scanner_t *iscn)
         p += (dx) + ((uintptr_t)(dy) * w);       \
     } while(0);
 
+/* OpenMV: a symbol is confirmed once it would survive the result filter
+ * at the end of zbar_scan_image()
+ */
+static inline int scan_confirmed (zbar_image_scanner_t *iscn,
+                                  char filter)
+{
+    const zbar_symbol_t *sym;
+    for(sym = iscn->syms->head; sym; sym = sym->next) {
+        if(((sym->type < ZBAR_COMPOSITE && sym->type > ZBAR_PARTIAL) ||
+            sym->type == ZBAR_DATABAR ||
+            sym->type == ZBAR_DATABAR_EXP ||
+            sym->type == ZBAR_CODABAR) &&
+           (sym->type == ZBAR_CODABAR || filter) && sym->quality < 4)
+            continue;
+        return(1);
+    }
+    return(0);
+}
+
 int zbar_scan_image (zbar_image_scanner_t *iscn,
                      zbar_image_t *img)
 {
@@ -2190,6 +2211,14 @@ int zbar_scan_image (zbar_image_scanner_t *iscn,
 
     zbar_scanner_new_scan(scn);
 
+    char early_filter = (!iscn->enable_cache &&
+                         (CFG(iscn, ZBAR_CFG_X_DENSITY) == 1 ||
+                          CFG(iscn, ZBAR_CFG_Y_DENSITY) == 1));
+#define EARLY_EXIT() \
+    if((iscn->early_exit && scan_confirmed(iscn, early_filter)) || \
+       imlib_deadline_expired(iscn->deadline)) \
+        goto scan_done;
+
     density = CFG(iscn, ZBAR_CFG_Y_DENSITY);
     if(density > 0) {
         const uint8_t *p = data;
@@ -2220,6 +2249,7 @@ int zbar_scan_image (zbar_image_scanner_t *iscn,
             ASSERT_POS;
             quiet_border(iscn);
             svg_path_end();
+            EARLY_EXIT();
 
             movedelta(-1, density);
             iscn->v = y;
@@ -2238,6 +2268,7 @@ int zbar_scan_image (zbar_image_scanner_t *iscn,
             ASSERT_POS;
             quiet_border(iscn);
             svg_path_end();
+            EARLY_EXIT();
 
             movedelta(1, density);
             iscn->v = y;
@@ -2274,6 +2305,7 @@ int zbar_scan_image (zbar_image_scanner_t *iscn,
             ASSERT_POS;
             quiet_border(iscn);
             svg_path_end();
+            EARLY_EXIT();
 
             movedelta(density, -1);
             iscn->v = x;
@@ -2292,12 +2324,17 @@ int zbar_scan_image (zbar_image_scanner_t *iscn,
             ASSERT_POS;
             quiet_border(iscn);
             svg_path_end();
+            EARLY_EXIT();
 
             movedelta(density, 1);
             iscn->v = x;
         }
         svg_group_end();
     }
+scan_done:
+#undef EARLY_EXIT
+    density = CFG(iscn, ZBAR_CFG_X_DENSITY);
+    iscn->dx = 0;
     iscn->dy = 0;
     iscn->img = NULL;
 
@@ -8723,12 +8760,162 @@ void zbar_scanner_get_state (const zbar_scanner_t *scn,
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi)
+// Localization cell size in pixels and the minimum average gradient difference per pixel.
+#define BARCODE_LOCALIZE_CELL_SIZE  (16)
+#define BARCODE_LOCALIZE_THRESHOLD  (8)
+
+// Adds the symbols found by the last scan of image to the output list.
+static void imlib_find_barcodes_add_symbols(list_t *out, zbar_image_t *image, int x_offset, int y_offset)
+{
+    for (const zbar_symbol_t *symbol = (image->syms) ? image->syms->head : NULL; symbol; symbol = zbar_symbol_next(symbol)) {
+        if (zbar_symbol_get_loc_size(symbol) > 0) {
+            find_barcodes_list_lnk_data_t lnk_data;
+
+            rectangle_init(&(lnk_data.rect),
+                           zbar_symbol_get_loc_x(symbol, 0) + x_offset,
+                           zbar_symbol_get_loc_y(symbol, 0) + y_offset,
+                           (zbar_symbol_get_loc_size(symbol) == 1) ? 1 : 0,
+                           (zbar_symbol_get_loc_size(symbol) == 1) ? 1 : 0);
+
+            for (size_t k = 1, l = zbar_symbol_get_loc_size(symbol); k < l; k++) {
+                rectangle_t temp;
+                rectangle_init(&temp, zbar_symbol_get_loc_x(symbol, k) + x_offset,
+                        zbar_symbol_get_loc_y(symbol, k) + y_offset, 0, 0);
+                rectangle_united(&(lnk_data.rect), &temp);
+            }
+
+            // Add corners...
+            lnk_data.corners[0].x = lnk_data.rect.x;                   // top-left
+            lnk_data.corners[0].y = lnk_data.rect.y;                   // top-left
+            lnk_data.corners[1].x = lnk_data.rect.x + lnk_data.rect.w; // top-right
+            lnk_data.corners[1].y = lnk_data.rect.y;                   // top-right
+            lnk_data.corners[2].x = lnk_data.rect.x + lnk_data.rect.w; // bottom-right
+            lnk_data.corners[2].y = lnk_data.rect.y + lnk_data.rect.h; // bottom-right
+            lnk_data.corners[3].x = lnk_data.rect.x;                   // bottom-left
+            lnk_data.corners[3].y = lnk_data.rect.y + lnk_data.rect.h; // bottom-left
+
+            // Payload is already null terminated.
+            lnk_data.payload_len = zbar_symbol_get_data_length(symbol);
+            lnk_data.payload = xalloc(zbar_symbol_get_data_length(symbol));
+            memcpy(lnk_data.payload, zbar_symbol_get_data(symbol), zbar_symbol_get_data_length(symbol));
+
+            switch (zbar_symbol_get_type(symbol)) {
+                case ZBAR_EAN2: lnk_data.type = BARCODE_EAN2; break;
+                case ZBAR_EAN5: lnk_data.type = BARCODE_EAN5; break;
+                case ZBAR_EAN8: lnk_data.type = BARCODE_EAN8; break;
+                case ZBAR_UPCE: lnk_data.type = BARCODE_UPCE; break;
+                case ZBAR_ISBN10: lnk_data.type = BARCODE_ISBN10; break;
+                case ZBAR_UPCA: lnk_data.type = BARCODE_UPCA; break;
+                case ZBAR_EAN13: lnk_data.type = BARCODE_EAN13; break;
+                case ZBAR_ISBN13: lnk_data.type = BARCODE_ISBN13; break;
+                case ZBAR_I25: lnk_data.type = BARCODE_I25; break;
+                case ZBAR_DATABAR: lnk_data.type = BARCODE_DATABAR; break;
+                case ZBAR_DATABAR_EXP: lnk_data.type = BARCODE_DATABAR_EXP; break;
+                case ZBAR_CODABAR: lnk_data.type = BARCODE_CODABAR; break;
+                case ZBAR_CODE39: lnk_data.type = BARCODE_CODE39; break;
+                case ZBAR_PDF417: lnk_data.type = BARCODE_PDF417; break;
+                case ZBAR_CODE93: lnk_data.type = BARCODE_CODE93; break;
+                case ZBAR_CODE128: lnk_data.type = BARCODE_CODE128; break;
+                default: continue;
+            }
+
+            switch (zbar_symbol_get_orientation(symbol)) {
+                case ZBAR_ORIENT_UP: lnk_data.rotation = 0; break;
+                case ZBAR_ORIENT_RIGHT: lnk_data.rotation = 270; break;
+                case ZBAR_ORIENT_DOWN: lnk_data.rotation = 180; break;
+                case ZBAR_ORIENT_LEFT: lnk_data.rotation = 90; break;
+                default: continue;
+            }
+
+            lnk_data.quality = zbar_symbol_get_quality(symbol);
+
+            list_push_back(out, &lnk_data);
+        }
+    }
+}
+
+// Finds areas of the grayscale image with strong gradients in one direction and weak
+// gradients in the other, which is what a linear barcode looks like along the enabled
+// scan directions. Candidate cells are grouped with find_blobs() and returned padded by
+// a cell for the quiet zone, in the grayscale image coordinates.
+static void imlib_find_barcodes_localize(list_t *rects, image_t *img, rectangle_t *roi,
+                                         int x_stride, int y_stride)
+{
+    int cell = BARCODE_LOCALIZE_CELL_SIZE;
+    int gw = roi->w / cell, gh = roi->h / cell;
+    list_init(rects, sizeof(rectangle_t));
+
+    if ((gw < 1) || (gh < 1)) {
+        return;
+    }
+
+    image_t cells;
+    image_init(&cells, gw, gh, PIXFORMAT_BINARY, 0, NULL);
+    cells.data = fb_alloc0(image_size(&cells), FB_ALLOC_NO_HINT);
+    int threshold = BARCODE_LOCALIZE_THRESHOLD * (cell - 1) * (cell - 1);
+
+    for (int cy = 0; cy < gh; cy++) {
+        uint32_t *cells_row = IMAGE_COMPUTE_BINARY_PIXEL_ROW_PTR(&cells, cy);
+
+        for (int cx = 0; cx < gw; cx++) {
+            int sum_gx = 0, sum_gy = 0;
+
+            for (int y = 0; y < (cell - 1); y++) {
+                uint8_t *row = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(img, roi->y + (cy * cell) + y) + roi->x + (cx * cell);
+                uint8_t *next_row = row + img->w;
+
+                for (int x = 0; x < (cell - 1); x++) {
+                    sum_gx += abs(row[x + 1] - row[x]);
+                    sum_gy += abs(next_row[x] - row[x]);
+                }
+            }
+
+            // Horizontal scan lines (y_stride) read vertical bars, which have strong x gradients.
+            int score = INT_MIN;
+            if (y_stride) {
+                score = sum_gx - sum_gy;
+            }
+            if (x_stride) {
+                score = IM_MAX(score, sum_gy - sum_gx);
+            }
+
+            if (score > threshold) {
+                IMAGE_SET_BINARY_PIXEL_FAST(cells_row, cx);
+            }
+        }
+    }
+
+    list_t thresholds;
+    list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
+    color_thresholds_list_lnk_data_t lnk_data = { .LMin = 1, .LMax = 1 };
+    list_push_back(&thresholds, &lnk_data);
+
+    list_t blobs;
+    rectangle_t cells_roi = { 0, 0, gw, gh };
+    imlib_find_blobs(&blobs, &cells, &cells_roi, 1, 1, &thresholds, false, 1, 1,
+                     true, 1, NULL, NULL, NULL, NULL, 0, 0);
+    list_free(&thresholds);
+    fb_free(); // cells
+
+    while (list_size(&blobs)) {
+        find_blobs_list_lnk_data_t blob;
+        list_pop_front(&blobs, &blob);
+
+        rectangle_t rect;
+        rectangle_init(&rect, roi->x + ((blob.rect.x - 1) * cell), roi->y + ((blob.rect.y - 1) * cell),
+                       (blob.rect.w + 2) * cell, (blob.rect.h + 2) * cell);
+        rectangle_intersected(&rect, roi);
+        list_push_back(rects, &rect);
+    }
+}
+
+void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi, int x_stride, int y_stride,
+                         bool first_only, bool localize, imlib_deadline_t *deadline)
 {
     uint8_t *grayscale_image = (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->data : fb_alloc(roi->w * roi->h, FB_ALLOC_NO_HINT);
 
     if (ptr->pixfmt != PIXFORMAT_GRAYSCALE) {
-        image_t img;
+        image_t img = {};
         img.w = roi->w;
         img.h = roi->h;
         img.pixfmt = PIXFORMAT_GRAYSCALE;
@@ -8736,95 +8923,69 @@ void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi)
         imlib_draw_image(&img, ptr, 0, 0, 1.f, 1.f, roi, -1, 256, NULL, NULL, 0, NULL, NULL, NULL);
     }
 
+    // The grayscale image is either the whole source image cropped to the roi or a copy of the roi.
+    image_t gray = {};
+    gray.w = (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->w : roi->w;
+    gray.h = (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->h : roi->h;
+    gray.pixfmt = PIXFORMAT_GRAYSCALE;
+    gray.data = grayscale_image;
+
+    rectangle_t crop;
+    rectangle_init(&crop, (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? roi->x : 0,
+                   (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? roi->y : 0, roi->w, roi->h);
+
+    // Localization has to be done before the umm heap takes the rest of the frame buffer.
+    list_t rects;
+    if (localize) {
+        imlib_find_barcodes_localize(&rects, &gray, &crop, x_stride, y_stride);
+    } else {
+        list_init(&rects, sizeof(rectangle_t));
+        list_push_back(&rects, &crop);
+    }
+
     umm_init_x(fb_avail());
 
     zbar_image_scanner_t *scanner = zbar_image_scanner_create();
     zbar_image_scanner_set_config(scanner, 0, ZBAR_CFG_ENABLE, 1);
+    zbar_image_scanner_set_config(scanner, 0, ZBAR_CFG_X_DENSITY, x_stride);
+    zbar_image_scanner_set_config(scanner, 0, ZBAR_CFG_Y_DENSITY, y_stride);
+    scanner->early_exit = first_only;
+    scanner->deadline = deadline;
 
     zbar_image_t image;
     image.format = *((int *) "Y800");
-    image.width = (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->w : roi->w;
-    image.height = (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->h : roi->h;
+    image.width = gray.w;
+    image.height = gray.h;
     image.data = grayscale_image;
-    image.datalen = ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->w : roi->w) * ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? ptr->h : roi->h);
-    image.crop_x = (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? roi->x : 0;
-    image.crop_y = (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? roi->y : 0;
-    image.crop_w = roi->w;
-    image.crop_h = roi->h;
+    image.datalen = gray.w * gray.h;
     image.userdata = 0;
     image.seq = 0;
     image.syms = 0;
 
     list_init(out, sizeof(find_barcodes_list_lnk_data_t));
 
-    if (zbar_scan_image(scanner, &image) > 0) {
-        for (const zbar_symbol_t *symbol = (image.syms) ? image.syms->head : NULL; symbol; symbol = zbar_symbol_next(symbol)) {
-            if (zbar_symbol_get_loc_size(symbol) > 0) {
-                find_barcodes_list_lnk_data_t lnk_data;
-
-                rectangle_init(&(lnk_data.rect),
-                               zbar_symbol_get_loc_x(symbol, 0) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->x),
-                               zbar_symbol_get_loc_y(symbol, 0) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->y),
-                               (zbar_symbol_get_loc_size(symbol) == 1) ? 1 : 0,
-                               (zbar_symbol_get_loc_size(symbol) == 1) ? 1 : 0);
-
-                for (size_t k = 1, l = zbar_symbol_get_loc_size(symbol); k < l; k++) {
-                    rectangle_t temp;
-                    rectangle_init(&temp, zbar_symbol_get_loc_x(symbol, k) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->x),
-                            zbar_symbol_get_loc_y(symbol, k) + ((ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->y), 0, 0);
-                    rectangle_united(&(lnk_data.rect), &temp);
-                }
+    while (list_size(&rects) && !imlib_deadline_expired(deadline)) {
+        rectangle_t rect;
+        list_pop_front(&rects, &rect);
 
-                // Add corners...
-                lnk_data.corners[0].x = lnk_data.rect.x;                   // top-left
-                lnk_data.corners[0].y = lnk_data.rect.y;                   // top-left
-                lnk_data.corners[1].x = lnk_data.rect.x + lnk_data.rect.w; // top-right
-                lnk_data.corners[1].y = lnk_data.rect.y;                   // top-right
-                lnk_data.corners[2].x = lnk_data.rect.x + lnk_data.rect.w; // bottom-right
-                lnk_data.corners[2].y = lnk_data.rect.y + lnk_data.rect.h; // bottom-right
-                lnk_data.corners[3].x = lnk_data.rect.x;                   // bottom-left
-                lnk_data.corners[3].y = lnk_data.rect.y + lnk_data.rect.h; // bottom-left
-
-                // Payload is already null terminated.
-                lnk_data.payload_len = zbar_symbol_get_data_length(symbol);
-                lnk_data.payload = xalloc(zbar_symbol_get_data_length(symbol));
-                memcpy(lnk_data.payload, zbar_symbol_get_data(symbol), zbar_symbol_get_data_length(symbol));
-
-                switch (zbar_symbol_get_type(symbol)) {
-                    case ZBAR_EAN2: lnk_data.type = BARCODE_EAN2; break;
-                    case ZBAR_EAN5: lnk_data.type = BARCODE_EAN5; break;
-                    case ZBAR_EAN8: lnk_data.type = BARCODE_EAN8; break;
-                    case ZBAR_UPCE: lnk_data.type = BARCODE_UPCE; break;
-                    case ZBAR_ISBN10: lnk_data.type = BARCODE_ISBN10; break;
-                    case ZBAR_UPCA: lnk_data.type = BARCODE_UPCA; break;
-                    case ZBAR_EAN13: lnk_data.type = BARCODE_EAN13; break;
-                    case ZBAR_ISBN13: lnk_data.type = BARCODE_ISBN13; break;
-                    case ZBAR_I25: lnk_data.type = BARCODE_I25; break;
-                    case ZBAR_DATABAR: lnk_data.type = BARCODE_DATABAR; break;
-                    case ZBAR_DATABAR_EXP: lnk_data.type = BARCODE_DATABAR_EXP; break;
-                    case ZBAR_CODABAR: lnk_data.type = BARCODE_CODABAR; break;
-                    case ZBAR_CODE39: lnk_data.type = BARCODE_CODE39; break;
-                    case ZBAR_PDF417: lnk_data.type = BARCODE_PDF417; break;
-                    case ZBAR_CODE93: lnk_data.type = BARCODE_CODE93; break;
-                    case ZBAR_CODE128: lnk_data.type = BARCODE_CODE128; break;
-                    default: continue;
-                }
+        image.crop_x = rect.x;
+        image.crop_y = rect.y;
+        image.crop_w = rect.w;
+        image.crop_h = rect.h;
 
-                switch (zbar_symbol_get_orientation(symbol)) {
-                    case ZBAR_ORIENT_UP: lnk_data.rotation = 0; break;
-                    case ZBAR_ORIENT_RIGHT: lnk_data.rotation = 270; break;
-                    case ZBAR_ORIENT_DOWN: lnk_data.rotation = 180; break;
-                    case ZBAR_ORIENT_LEFT: lnk_data.rotation = 90; break;
-                    default: continue;
-                }
+        if (zbar_scan_image(scanner, &image) > 0) {
+            imlib_find_barcodes_add_symbols(out, &image,
+                                            (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->x,
+                                            (ptr->pixfmt == PIXFORMAT_GRAYSCALE) ? 0 : roi->y);
 
-                lnk_data.quality = zbar_symbol_get_quality(symbol);
-
-                list_push_back(out, &lnk_data);
+            if (first_only && list_size(out)) {
+                break;
             }
         }
     }
 
+    list_free(&rects);
+
     for (;;) { // Merge overlapping.
         bool merge_occured = false;
 
@@ -8869,6 +9030,7 @@ void imlib_find_barcodes(list_t *out, image_t *ptr, rectangle_t *roi)
     }
 
     zbar_image_scanner_destroy(scanner);
+    umm_deinit();
     fb_free(); // umm_init_x();
     if (ptr->pixfmt != PIXFORMAT_GRAYSCALE) {
         fb_free(); // grayscale_image;
@@ -27,9 +27,9 @@ CXXFLAGS_USERMOD += \
         -fmessage-length=0 \
         $(filter-out -std=gnu99,$(CFLAGS))
 
-# Add CubeAI module if enabled.
+# Add the CubeAI ml backend if enabled.
 ifeq ($(MICROPY_PY_CUBEAI), 1)
-SRC_USERMOD += $(OMV_MOD_DIR)/../../stm32cubeai/py_st_nn.c
+SRC_USERMOD += $(OMV_MOD_DIR)/../../stm32cubeai/ml_backend_cubeai.c
 endif
 
 ifeq ($(MICROPY_PY_ULAB), 1)
@@ -177,6 +177,60 @@ static mp_obj_t py_display_write(uint n_args, const mp_obj_t *pos_args, mp_map_t
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_display_write_obj, 2, py_display_write);
 
+static mp_obj_t py_display_dirty(uint n_args, const mp_obj_t *args) {
+    py_display_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    image_t bounds = { .w = self->width, .h = self->height };
+    rectangle_t roi = py_helper_arg_to_roi((n_args > 1) ? args[1] : mp_const_none, &bounds);
+    py_display_p_t *display_p = (py_display_p_t *) MP_OBJ_TYPE_GET_SLOT(self->base.type, protocol);
+    if (display_p->dirty != NULL) {
+        display_p->dirty(self, &roi);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_display_dirty_obj, 1, 2, py_display_dirty);
+
+static mp_obj_t py_display_overlay(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_image, ARG_x, ARG_y, ARG_alpha, ARG_color_palette, ARG_transparent };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_image, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_x, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 0 } },
+        { MP_QSTR_y, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 0 } },
+        { MP_QSTR_alpha, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 256 } },
+        { MP_QSTR_color_palette, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_transparent, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 0 } },
+    };
+
+    // Parse args.
+    py_display_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    py_display_p_t *display_p = (py_display_p_t *) MP_OBJ_TYPE_GET_SLOT(self->base.type, protocol);
+    if (display_p->overlay == NULL) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Display does not support overlays."));
+    }
+
+    if (args[ARG_alpha].u_int < 0 || args[ARG_alpha].u_int > 256) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Alpha ranges between 0 and 256"));
+    }
+
+    // The overlay is scanned out directly from the image, which is kept alive by the display.
+    image_t *image = NULL;
+    if (args[ARG_image].u_obj != mp_const_none) {
+        image = py_image_cobj(args[ARG_image].u_obj);
+        if ((image->pixfmt != PIXFORMAT_GRAYSCALE) && (image->pixfmt != PIXFORMAT_RGB565)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Overlay must be GRAYSCALE or RGB565"));
+        }
+    }
+
+    const uint16_t *color_palette = py_helper_arg_to_palette(args[ARG_color_palette].u_obj, PIXFORMAT_RGB565);
+    display_p->overlay(self, image, args[ARG_x].u_int, args[ARG_y].u_int, args[ARG_alpha].u_int,
+                       color_palette, args[ARG_transparent].u_int);
+    self->overlay = args[ARG_image].u_obj;
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_display_overlay_obj, 2, py_display_overlay);
+
 static mp_obj_t py_display_bus_write(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_cmd, ARG_args, ARG_dcs };
     static const mp_arg_t allowed_args[] = {
@@ -254,6 +308,8 @@ static const mp_rom_map_elem_t py_display_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_clear),               MP_ROM_PTR(&py_display_clear_obj)         },
     { MP_ROM_QSTR(MP_QSTR_backlight),           MP_ROM_PTR(&py_display_backlight_obj)     },
     { MP_ROM_QSTR(MP_QSTR_write),               MP_ROM_PTR(&py_display_write_obj)         },
+    { MP_ROM_QSTR(MP_QSTR_dirty),               MP_ROM_PTR(&py_display_dirty_obj)         },
+    { MP_ROM_QSTR(MP_QSTR_overlay),             MP_ROM_PTR(&py_display_overlay_obj)       },
     { MP_ROM_QSTR(MP_QSTR_bus_write),           MP_ROM_PTR(&py_display_bus_write_obj)     },
     { MP_ROM_QSTR(MP_QSTR_bus_read),            MP_ROM_PTR(&py_display_bus_read_obj)      },
 };
@@ -53,10 +53,20 @@ typedef struct _py_display_obj_t {
     bool portrait;
     mp_obj_t controller;
     mp_obj_t bl_controller;
+    mp_obj_t overlay;
     #if defined(OMV_SPI_DISPLAY_CONTROLLER)
     omv_spi_t spi_bus;
     bool spi_tx_running;
+    volatile bool spi_tx_busy;
     uint32_t spi_baudrate;
+    // Damage tracking, only the window that changed is sent.
+    bool spi_refresh;
+    rectangle_t spi_dirty;
+    uint8_t *spi_tx_row;
+    uint8_t *spi_tx_addr;
+    size_t spi_tx_count;
+    size_t spi_tx_row_count;
+    size_t spi_tx_rows;
     #endif
     bool triple_buffer;
     uint32_t framebuffer_tail;
@@ -72,6 +82,9 @@ typedef struct _py_display_p_t {
                    float x_scale, float y_scale, rectangle_t *roi, int rgb_channel, int alpha,
                    const uint16_t *color_palette, const uint8_t *alpha_palette, image_hint_t hint);
     void (*set_backlight) (py_display_obj_t *self, uint32_t intensity);
+    void (*dirty) (py_display_obj_t *self, rectangle_t *rect);
+    void (*overlay) (py_display_obj_t *self, image_t *img, int x, int y, int alpha,
+                     const uint16_t *color_palette, int transparent);
     int (*bus_write) (py_display_obj_t *self, uint8_t cmd, uint8_t *args, size_t n_args, bool dcs);
     int (*bus_read) (py_display_obj_t *self, uint8_t cmd, uint8_t *args, size_t n_args, uint8_t *buf, size_t len, bool dcs);
 } py_display_p_t;
@@ -8,6 +8,7 @@
  *
  * FIR Python module.
  */
+#include <string.h>
 #include "py/runtime.h"
 #include "py/objlist.h"
 #include "omv_boardconfig.h"
@@ -51,6 +52,8 @@
 #define MLX90640_HEIGHT                 24
 #define MLX90640_EEPROM_DATA_SIZE       832
 #define MLX90640_FRAME_DATA_SIZE        834
+#define MLX90640_STATUS_REGISTER        0x8000
+#define MLX90640_STATUS_DATA_READY      0x0008
 
 #define MLX90641_ADDR                   0x33
 #define MLX90641_WIDTH                  16
@@ -77,6 +80,16 @@
         __value & 0x87FF;                     \
     })
 
+#if (OMV_FIR_MLX90640_ENABLE == 1)
+// Calibration parameters and the latest frame, sub-pages are converted as they arrive.
+typedef struct fir_mlx90640_state {
+    paramsMLX90640 params;
+    uint32_t subpages;
+    float Ta;
+    float To[MLX90640_WIDTH * MLX90640_HEIGHT];
+} fir_mlx90640_state_t;
+#endif
+
 static omv_i2c_t fir_bus = {};
 
 typedef enum fir_sensor_type {
@@ -150,23 +163,32 @@ static void fir_MLX90621_get_frame(float *Ta, float *To) {
 
 #if (OMV_FIR_MLX90640_ENABLE == 1)
 static void fir_MLX90640_get_frame(float *Ta, float *To) {
+    fir_mlx90640_state_t *state = MP_STATE_PORT(fir_mlx_data);
     uint16_t *data = fb_alloc(MLX90640_FRAME_DATA_SIZE * sizeof(uint16_t), FB_ALLOC_NO_HINT);
 
-    // Wait for a new data to be available before calling GetFrameData.
-    MLX90640_SynchFrame(MLX90640_ADDR);
+    // Each measurement updates one sub-page of the cached frame. A sub-page is only read if the
+    // sensor has one ready, otherwise the latest frame is returned without waiting. The first
+    // call waits until both sub-pages have been read.
+    for (;;) {
+        uint16_t status;
+        PY_ASSERT_TRUE_MSG(MLX90640_I2CRead(MLX90640_ADDR, MLX90640_STATUS_REGISTER, 1, &status) == 0,
+                           "Failed to read the MLX90640 sensor data!");
 
-    // Calculate 1st sub-frame...
-    PY_ASSERT_TRUE_MSG(MLX90640_GetFrameData(MLX90640_ADDR, data) >= 0,
-                       "Failed to read the MLX90640 sensor data!");
-    *Ta = MLX90640_GetTa(data, MP_STATE_PORT(fir_mlx_data));
-    MLX90640_CalculateTo(data, MP_STATE_PORT(fir_mlx_data), 0.95f, *Ta - 8, To);
+        if (status & MLX90640_STATUS_DATA_READY) {
+            PY_ASSERT_TRUE_MSG(MLX90640_GetFrameData(MLX90640_ADDR, data) >= 0,
+                               "Failed to read the MLX90640 sensor data!");
+            state->Ta = MLX90640_GetTa(data, &state->params);
+            MLX90640_CalculateTo(data, &state->params, 0.95f, state->Ta - 8, state->To);
+            state->subpages |= 1 << data[833];
+        }
 
-    // Calculate 2nd sub-frame...
-    PY_ASSERT_TRUE_MSG(MLX90640_GetFrameData(MLX90640_ADDR, data) >= 0,
-                       "Failed to read the MLX90640 sensor data!");
-    *Ta = MLX90640_GetTa(data, MP_STATE_PORT(fir_mlx_data));
-    MLX90640_CalculateTo(data, MP_STATE_PORT(fir_mlx_data), 0.95f, *Ta - 8, To);
+        if (state->subpages == 0x3) {
+            break;
+        }
+    }
 
+    *Ta = state->Ta;
+    memcpy(To, state->To, sizeof(state->To));
     fb_free();
 }
 #endif
@@ -448,7 +470,9 @@ mp_obj_t py_fir_init(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
             ir_fresh_rate = __CLZ(__RBIT((ir_fresh_rate > 64) ? 64 : ((ir_fresh_rate < 1) ? 1 : ir_fresh_rate))) + 1;
             adc_resolution = ((adc_resolution > 19) ? 19 : ((adc_resolution < 16) ? 16 : adc_resolution)) - 16;
 
-            MP_STATE_PORT(fir_mlx_data) = xalloc(sizeof(paramsMLX90640));
+            fir_mlx90640_state_t *state = xalloc(sizeof(fir_mlx90640_state_t));
+            state->subpages = 0;
+            MP_STATE_PORT(fir_mlx_data) = state;
 
             fir_sensor = FIR_MLX90640;
             FIR_MLX90640_RETRY:
@@ -460,7 +484,7 @@ mp_obj_t py_fir_init(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
             int error = MLX90640_DumpEE(MLX90640_ADDR, eeprom);
             error |= MLX90640_SetRefreshRate(MLX90640_ADDR, ir_fresh_rate);
             error |= MLX90640_SetResolution(MLX90640_ADDR, adc_resolution);
-            error |= MLX90640_ExtractParameters(eeprom, MP_STATE_PORT(fir_mlx_data));
+            error |= MLX90640_ExtractParameters(eeprom, &state->params);
             fb_alloc_free_till_mark();
 
             if (error != 0) {
@@ -983,14 +1007,22 @@ mp_obj_t py_fir_snapshot(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Alpha ranges between 0 and 256"));
     }
 
-    if ((args[ARG_pixformat].u_int != PIXFORMAT_GRAYSCALE) && (args[ARG_pixformat].u_int != PIXFORMAT_RGB565)) {
+    if ((args[ARG_pixformat].u_int != PIXFORMAT_GRAYSCALE) &&
+        (args[ARG_pixformat].u_int != PIXFORMAT_GRAYSCALE16) &&
+        (args[ARG_pixformat].u_int != PIXFORMAT_RGB565)) {
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid pixformat"));
     }
 
+    // GRAYSCALE16 images are the unscaled frame in centi-kelvin.
+    bool gray16 = args[ARG_pixformat].u_int == PIXFORMAT_GRAYSCALE16;
+    if (gray16 && args[ARG_copy_to_fb].u_bool) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("GRAYSCALE16 can't be copied to the frame buffer"));
+    }
+
     image_t src_img = {
         .w = args[ARG_transpose].u_bool ? fir_height : fir_width,
         .h = args[ARG_transpose].u_bool ? fir_width : fir_height,
-        .pixfmt = PIXFORMAT_GRAYSCALE,
+        .pixfmt = gray16 ? PIXFORMAT_GRAYSCALE16 : PIXFORMAT_GRAYSCALE,
         //.data is allocated later.
     };
 
@@ -1007,7 +1039,7 @@ mp_obj_t py_fir_snapshot(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
     };
     if (args[ARG_copy_to_fb].u_bool) {
         py_helper_set_to_framebuffer(&dst_img);
-    } else {
+    } else if (!gray16) {
         dst_img.data = xalloc(image_size(&dst_img));
     }
 
@@ -1020,7 +1052,11 @@ mp_obj_t py_fir_snapshot(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
 
     fb_alloc_mark();
     // Allocate source image data.
-    src_img.data = fb_alloc(src_img.w * src_img.h * sizeof(uint8_t), FB_ALLOC_NO_HINT);
+    if (gray16) {
+        src_img.data = xalloc(image_size(&src_img));
+    } else {
+        src_img.data = fb_alloc(image_size(&src_img), FB_ALLOC_NO_HINT);
+    }
 
     switch (fir_sensor) {
         #if (OMV_FIR_MLX90621_ENABLE == 1)
@@ -1085,6 +1121,11 @@ mp_obj_t py_fir_snapshot(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
         }
     }
 
+    if (gray16) {
+        fb_alloc_free_till_mark();
+        return py_image_from_struct(&src_img);
+    }
+
     imlib_draw_image(&dst_img, &src_img, 0, 0, x_scale, y_scale, &roi,
                      args[ARG_channel].u_int, args[ARG_alpha].u_int, color_palette, alpha_palette,
                      (args[ARG_hint].u_int & (~IMAGE_HINT_CENTER)) | IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
@@ -34,6 +34,9 @@
 static volatile int framebuffer_tail = 0;
 static int framebuffer_head = 0;
 static uint16_t *framebuffers[FRAMEBUFFER_COUNT] = {};
+// Raw min/max of each frame, tracked while the packets are received.
+static uint16_t framebuffer_min[FRAMEBUFFER_COUNT] = {};
+static uint16_t framebuffer_max[FRAMEBUFFER_COUNT] = {};
 
 static int fir_lepton_rad_en = false;
 static bool fir_lepton_3 = false;
@@ -66,6 +69,8 @@ static soft_timer_entry_t flir_lepton_spi_rx_timer = {};
 static int fir_lepton_spi_rx_cb_tail = 0;
 static int fir_lepton_spi_rx_cb_expected_pid = 0;
 static int fir_lepton_spi_rx_cb_expected_sid = 0;
+static uint16_t fir_lepton_spi_rx_cb_min = 0;
+static uint16_t fir_lepton_spi_rx_cb_max = 0;
 static uint16_t OMV_ATTR_SECTION(OMV_ATTR_ALIGNED_DMA(fir_lepton_buf[VOSPI_BUFFER_SIZE]), ".dma_buffer");
 static void fir_lepton_spi_callback(omv_spi_t *spi, void *userdata, void *buf);
 
@@ -157,10 +162,28 @@ void fir_lepton_spi_callback(omv_spi_t *spi, void *userdata, void *buf) {
         return;
     }
 
-    memcpy(framebuffers[fir_lepton_spi_rx_cb_tail]
-           + (fir_lepton_spi_rx_cb_expected_pid * VOSPI_PID_SIZE_PIXELS)
-           + (fir_lepton_spi_rx_cb_expected_sid * VOSPI_SID_SIZE_PIXELS),
-           base + VOSPI_HEADER_WORDS, VOSPI_PID_SIZE_PIXELS * sizeof(uint16_t));
+    if ((fir_lepton_spi_rx_cb_expected_pid == 0) && (fir_lepton_spi_rx_cb_expected_sid == 0)) {
+        fir_lepton_spi_rx_cb_min = UINT16_MAX;
+        fir_lepton_spi_rx_cb_max = 0;
+    }
+
+    // Copy the packet and update the frame's min/max in the same pass.
+    const uint16_t *src = base + VOSPI_HEADER_WORDS;
+    uint16_t *dst = framebuffers[fir_lepton_spi_rx_cb_tail]
+                    + (fir_lepton_spi_rx_cb_expected_pid * VOSPI_PID_SIZE_PIXELS)
+                    + (fir_lepton_spi_rx_cb_expected_sid * VOSPI_SID_SIZE_PIXELS);
+    int min = fir_lepton_spi_rx_cb_min;
+    int max = fir_lepton_spi_rx_cb_max;
+
+    for (int i = 0; i < VOSPI_PID_SIZE_PIXELS; i++) {
+        int value = src[i];
+        dst[i] = value;
+        min = IM_MIN(min, value);
+        max = IM_MAX(max, value);
+    }
+
+    fir_lepton_spi_rx_cb_min = min;
+    fir_lepton_spi_rx_cb_max = max;
 
     fir_lepton_spi_rx_cb_expected_pid += 1;
     if (fir_lepton_spi_rx_cb_expected_pid == VOSPI_PIDS_PER_SID) {
@@ -182,6 +205,8 @@ void fir_lepton_spi_callback(omv_spi_t *spi, void *userdata, void *buf) {
 
         if (frame_ready) {
             // Update tail which means a new image is ready.
+            framebuffer_min[fir_lepton_spi_rx_cb_tail] = fir_lepton_spi_rx_cb_min;
+            framebuffer_max[fir_lepton_spi_rx_cb_tail] = fir_lepton_spi_rx_cb_max;
             framebuffer_tail = fir_lepton_spi_rx_cb_tail;
 
             // For triple buffering we are never drawing where tail or head
@@ -520,37 +545,42 @@ void fir_lepton_fill_image(image_t *img, int w, int h, bool auto_range, float mi
                            bool mirror, bool flip, bool transpose, int timeout) {
     int kelvin = fir_lepton_get_temperature();
     const uint16_t *data = fir_lepton_get_frame(timeout);
+    // Without radiometry the raw values are relative to the FPA temperature.
+    int offset = fir_lepton_rad_en ? 0 : (kelvin - 8192);
     int new_min;
     int new_max;
 
-    if (auto_range) {
-        new_min = INT_MAX;
-        new_max = INT_MIN;
+    if (img->pixfmt == PIXFORMAT_GRAYSCALE16) {
+        // Keeps the full precision, the pixels are in centi-kelvin.
+        uint16_t *pixels = (uint16_t *) img->data;
 
-        for (int i = 0, ii = w * h; i < ii; i++) {
-            int temp = data[i];
+        for (int y = 0; y < h; y++) {
+            int y_dst = flip ? (h - 1 - y) : y;
+            const uint16_t *raw_row = data + (y * w);
 
-            if (!fir_lepton_rad_en) {
-                temp = (temp - 8192) + kelvin;
+            for (int x = 0; x < w; x++) {
+                int x_dst = mirror ? (w - 1 - x) : x;
+                pixels[transpose ? ((x_dst * h) + y_dst) : ((y_dst * w) + x_dst)] = __USAT(raw_row[x] + offset, 16);
             }
+        }
 
-            if (temp < new_min) {
-                new_min = temp;
-            }
+        return;
+    }
 
-            if (temp > new_max) {
-                new_max = temp;
-            }
-        }
+    if (auto_range) {
+        // The range was tracked when the frame was received.
+        new_min = framebuffer_min[framebuffer_head];
+        new_max = framebuffer_max[framebuffer_head];
     } else {
         float tmp = min;
         min = (min < max) ? min : max;
         max = (max > tmp) ? max : tmp;
-        new_min = fast_roundf((min + 273.15f) * 100.f); // to kelvin
-        new_max = fast_roundf((max + 273.15f) * 100.f); // to kelvin
+        new_min = fast_roundf((min + 273.15f) * 100.f) - offset; // to raw kelvin
+        new_max = fast_roundf((max + 273.15f) * 100.f) - offset; // to raw kelvin
     }
 
-    float diff = 255.f / (new_max - new_min);
+    // Maps [new_min, new_max] to [0, 255] in Q16.
+    int scale = (new_max > new_min) ? ((255 << 16) / (new_max - new_min)) : 0;
     int w_1 = w - 1;
     int h_1 = h - 1;
 
@@ -562,22 +592,8 @@ void fir_lepton_fill_image(image_t *img, int w, int h, bool auto_range, float mi
 
         for (int x = 0; x < w; x++) {
             int x_dst = mirror ? (w_1 - x) : x;
-            int raw = raw_row[x];
-
-            if (!fir_lepton_rad_en) {
-                raw = (raw - 8192) + kelvin;
-            }
-
-            if (raw < new_min) {
-                raw = new_min;
-            }
-
-            if (raw > new_max) {
-                raw = new_max;
-            }
-
-            int pixel = fast_roundf((raw - new_min) * diff);
-            pixel = __USAT(pixel, 8);
+            int raw = IM_CLAMP(raw_row[x], new_min, new_max);
+            int pixel = __USAT((((raw - new_min) * scale) + 0x8000) >> 16, 8);
 
             if (!transpose) {
                 row_pointer[x_dst] = pixel;
@@ -69,9 +69,10 @@ static mp_obj_t py_gif_loop(mp_obj_t self_in) {
 static MP_DEFINE_CONST_FUN_OBJ_1(py_gif_loop_obj, py_gif_loop);
 
 static mp_obj_t py_gif_add_frame(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_delay };
+    enum { ARG_delay, ARG_adaptive_palette };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_delay, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 10 } },
+        { MP_QSTR_adaptive_palette, MP_ARG_BOOL | MP_ARG_KW_ONLY,  {.u_bool = false } },
     };
 
     // Parse args.
@@ -88,7 +89,9 @@ static mp_obj_t py_gif_add_frame(uint n_args, const mp_obj_t *pos_args, mp_map_t
         mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Image format is not supported"));
     }
 
-    gif_add_frame(&self->fp, image, args[ARG_delay].u_int);
+    fb_alloc_mark();
+    gif_add_frame(&self->fp, image, args[ARG_delay].u_int, args[ARG_adaptive_palette].u_bool);
+    fb_alloc_free_till_mark();
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_gif_add_frame_obj, 2, py_gif_add_frame);
@@ -18,6 +18,7 @@
 #endif
 
 extern void *py_image_cobj(mp_obj_t img_obj);
+extern void py_image_unshare(mp_obj_t img_obj);
 
 mp_obj_t py_func_unavailable(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     PY_ASSERT_TRUE_MSG(false, "This function is unavailable on your OpenMV Cam.");
@@ -25,6 +26,12 @@ mp_obj_t py_func_unavailable(uint n_args, const mp_obj_t *args, mp_map_t *kw_arg
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(py_func_unavailable_obj, 0, py_func_unavailable);
 
+static bool py_helper_image_is_mutable(image_t *image, uint32_t flags) {
+    return image->is_mutable
+           || ((flags & ARG_IMAGE_GRAYSCALE16) && (image->pixfmt == PIXFORMAT_GRAYSCALE16))
+           || ((flags & ARG_IMAGE_YUV) && (image->is_yuv));
+}
+
 image_t *py_helper_arg_to_image(const mp_obj_t arg, uint32_t flags) {
     image_t *image = NULL;
     if ((flags & ARG_IMAGE_ALLOC) && MP_OBJ_IS_STR(arg)) {
@@ -42,9 +49,13 @@ image_t *py_helper_arg_to_image(const mp_obj_t arg, uint32_t flags) {
         #endif // IMLIB_ENABLE_IMAGE_FILE_IO
     } else {
         image = py_image_cobj(arg);
+        if ((flags & ARG_IMAGE_MUTABLE) && py_helper_image_is_mutable(image, flags)) {
+            // Detach views before their pixels are modified.
+            py_image_unshare(arg);
+        }
     }
     if (flags) {
-        if ((flags & ARG_IMAGE_MUTABLE) && !image->is_mutable) {
+        if ((flags & ARG_IMAGE_MUTABLE) && !py_helper_image_is_mutable(image, flags)) {
             mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected a mutable image"));
         } else if ((flags & ARG_IMAGE_UNCOMPRESSED) && image->is_compressed) {
             mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected an uncompressed image"));
@@ -416,6 +427,26 @@ void py_helper_arg_to_thresholds(const mp_obj_t arg, list_t *thresholds) {
     }
 }
 
+void py_helper_arg_to_gray16_thresholds(const mp_obj_t arg, list_t *thresholds) {
+    mp_uint_t arg_thresholds_len;
+    mp_obj_t *arg_thresholds;
+    mp_obj_get_array(arg, &arg_thresholds_len, &arg_thresholds);
+    for (mp_uint_t i = 0; i < arg_thresholds_len; i++) {
+        mp_uint_t arg_threshold_len;
+        mp_obj_t *arg_threshold;
+        mp_obj_get_array(arg_thresholds[i], &arg_threshold_len, &arg_threshold);
+        if (arg_threshold_len) {
+            int min = __USAT(mp_obj_get_int(arg_threshold[0]), 16);
+            int max = (arg_threshold_len > 1) ? __USAT(mp_obj_get_int(arg_threshold[1]), 16) : COLOR_GRAYSCALE16_MAX;
+            gray16_thresholds_list_lnk_data_t lnk_data = {
+                .min = IM_MIN(min, max),
+                .max = IM_MAX(min, max),
+            };
+            list_push_back(thresholds, &lnk_data);
+        }
+    }
+}
+
 void py_helper_keyword_thresholds(uint n_args, const mp_obj_t *args, uint arg_index,
                                   mp_map_t *kw_args, list_t *thresholds) {
     mp_map_elem_t *kw_arg = mp_map_lookup(kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_thresholds), MP_MAP_LOOKUP);
@@ -17,7 +17,9 @@ typedef enum py_helper_arg_image_flags {
     ARG_IMAGE_MUTABLE      = (1 << 0),
     ARG_IMAGE_UNCOMPRESSED = (1 << 1),
     ARG_IMAGE_GRAYSCALE    = (1 << 2),
-    ARG_IMAGE_ALLOC        = (1 << 3)
+    ARG_IMAGE_ALLOC        = (1 << 3),
+    ARG_IMAGE_GRAYSCALE16  = (1 << 4), // Accept GRAYSCALE16 images as mutable.
+    ARG_IMAGE_YUV          = (1 << 5)  // Accept YUV422 images as mutable.
 } py_helper_arg_image_flags_t;
 
 extern const mp_obj_fun_builtin_var_t py_func_unavailable_obj;
@@ -55,6 +57,7 @@ uint py_helper_consume_array(uint n_args, const mp_obj_t *args, uint arg_index,
 int py_helper_keyword_color(image_t *img, uint n_args, const mp_obj_t *args, uint arg_index,
                             mp_map_t *kw_args, int default_val);
 void py_helper_arg_to_thresholds(const mp_obj_t arg, list_t *thresholds);
+void py_helper_arg_to_gray16_thresholds(const mp_obj_t arg, list_t *thresholds);
 void py_helper_keyword_thresholds(uint n_args, const mp_obj_t *args, uint arg_index,
                                   mp_map_t *kw_args, list_t *thresholds);
 int py_helper_arg_to_ksize(const mp_obj_t arg);
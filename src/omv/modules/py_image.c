@@ -20,6 +20,8 @@
 #include "py/objtype.h"
 #include "py/runtime.h"
 #include "py/mphal.h"
+#include "py/stream.h"
+#include "py/mperrno.h"
 
 #include "imlib.h"
 #include "array.h"
@@ -31,6 +33,9 @@
 #include "py_helper.h"
 #include "py_image.h"
 #include "omv_boardconfig.h"
+#if MICROPY_PY_SENSOR
+#include "sensor.h"
+#endif
 #if defined(IMLIB_ENABLE_IMAGE_IO)
 #include "py_imageio.h"
 #endif
@@ -79,6 +84,7 @@ static MP_DEFINE_CONST_OBJ_TYPE(
 typedef struct _py_kp_obj_t {
     mp_obj_base_t base;
     array_t *kpts;
+    orb_index_t *index;
     int threshold;
     bool normalized;
 } py_kp_obj_t;
@@ -291,6 +297,8 @@ static MP_DEFINE_CONST_OBJ_TYPE(
 typedef struct _py_image_obj_t {
     mp_obj_base_t base;
     image_t _cobj;
+    mp_obj_t parent;    // The image owning the pixels of a view, or NULL.
+    mp_obj_t owner;     // The ndarray owning the pixels of an image aliasing it, or NULL.
 } py_image_obj_t;
 
 typedef struct _mp_obj_py_image_it_t {
@@ -305,6 +313,18 @@ void *py_image_cobj(mp_obj_t img_obj) {
     return &((py_image_obj_t *) img_obj)->_cobj;
 }
 
+// Views share their parent's pixels until they are modified, the pixels are copied then.
+void py_image_unshare(mp_obj_t img_obj) {
+    py_image_obj_t *self = MP_OBJ_TO_PTR(img_obj);
+    if (self->parent != MP_OBJ_NULL) {
+        size_t size = image_size(&self->_cobj);
+        uint8_t *data = xalloc(size);
+        memcpy(data, self->_cobj.data, size);
+        self->_cobj.data = data;
+        self->parent = MP_OBJ_NULL;
+    }
+}
+
 mp_obj_t py_image_unary_op(mp_unary_op_t op, mp_obj_t self_in) {
     py_image_obj_t *self = MP_OBJ_TO_PTR(self_in);
     switch (op) {
@@ -511,6 +531,7 @@ static mp_obj_t py_image_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value
         }
     } else {
         // store
+        py_image_unshare(self);
         switch (image->pixfmt) {
             case PIXFORMAT_BINARY: {
                 if (MP_OBJ_IS_TYPE(index, &mp_type_slice)) {
@@ -663,18 +684,42 @@ static mp_obj_t py_image_subscr(mp_obj_t self_in, mp_obj_t index, mp_obj_t value
 
 static mp_int_t py_image_get_buffer(mp_obj_t self_in, mp_buffer_info_t *bufinfo, mp_uint_t flags) {
     py_image_obj_t *self = self_in;
-    if (flags == MP_BUFFER_READ) {
-        bufinfo->buf = self->_cobj.data;
-        bufinfo->len = image_size(&self->_cobj);
-        bufinfo->typecode = 'b';
-        return 0;
-    } else {
-        // Can't write to an image!
+    image_t *image = &self->_cobj;
+
+    if ((flags & MP_BUFFER_WRITE) && image->is_compressed) {
+        // Can't write to a compressed image!
         bufinfo->buf = NULL;
         bufinfo->len = 0;
         bufinfo->typecode = -1;
         return 1;
     }
+
+    if (flags & MP_BUFFER_WRITE) {
+        py_image_unshare(self_in);
+    }
+
+    bufinfo->buf = image->data;
+    bufinfo->len = image_size(image);
+
+    // The typecode is the pixel type so the buffer can be indexed by pixel.
+    switch (image->pixfmt) {
+        case PIXFORMAT_GRAYSCALE: {
+            bufinfo->typecode = 'B';
+            break;
+        }
+        case PIXFORMAT_GRAYSCALE16:
+        case PIXFORMAT_RGB565:
+        case PIXFORMAT_YUV_ANY: {
+            bufinfo->typecode = 'H';
+            break;
+        }
+        default: {
+            bufinfo->typecode = 'b';
+            break;
+        }
+    }
+
+    return 0;
 }
 
 ////////////////
@@ -698,6 +743,8 @@ static mp_obj_t py_image_format(mp_obj_t img_obj) {
             return mp_obj_new_int(PIXFORMAT_BINARY);
         case PIXFORMAT_GRAYSCALE:
             return mp_obj_new_int(PIXFORMAT_GRAYSCALE);
+        case PIXFORMAT_GRAYSCALE16:
+            return mp_obj_new_int(PIXFORMAT_GRAYSCALE16);
         case PIXFORMAT_RGB565:
             return mp_obj_new_int(PIXFORMAT_RGB565);
         case PIXFORMAT_BAYER_ANY:
@@ -727,10 +774,11 @@ static MP_DEFINE_CONST_FUN_OBJ_1(py_image_bytearray_obj, py_image_bytearray);
 
 #if defined(MODULE_ULAB_ENABLED) && (ULAB_MAX_DIMS == 4)
 static mp_obj_t py_image_to_ndarray(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_dtype, ARG_buffer };
+    enum { ARG_dtype, ARG_buffer, ARG_copy };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_dtype, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_rom_obj = MP_ROM_NONE } },
         { MP_QSTR_buffer, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_copy, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true} },
     };
 
     image_t *image = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_ANY);
@@ -749,6 +797,54 @@ static mp_obj_t py_image_to_ndarray(uint n_args, const mp_obj_t *pos_args, mp_ma
         dtype_code = mp_obj_str_get_str(args[ARG_dtype].u_obj)[0];
     }
 
+    if (!args[ARG_copy].u_bool) {
+        // The ndarray aliases the pixels, writes to either one show up in the other. Only
+        // pixel types ulab has a dtype for can be aliased.
+        int native_code;
+        switch (image->pixfmt) {
+            case PIXFORMAT_GRAYSCALE: {
+                native_code = NDARRAY_UINT8;
+                break;
+            }
+            case PIXFORMAT_GRAYSCALE16:
+            case PIXFORMAT_RGB565: {
+                native_code = NDARRAY_UINT16;
+                break;
+            }
+            default: {
+                mp_raise_ValueError(MP_ERROR_TEXT("Unsupported pixformat"));
+                break;
+            }
+        }
+
+        if (dtype_code != native_code) {
+            mp_raise_ValueError(MP_ERROR_TEXT("dtype must match the pixformat"));
+        }
+
+        if (args[ARG_buffer].u_obj != mp_const_none) {
+            mp_raise_ValueError(MP_ERROR_TEXT("Incompatible arguments!"));
+        }
+
+        py_image_unshare(pos_args[0]);
+
+        size_t itemsize = (native_code == NDARRAY_UINT8) ? 1 : 2;
+        size_t shape[ULAB_MAX_DIMS] = {0, 0, image->h, image->w};
+        size_t strides[ULAB_MAX_DIMS] = {0, 0, image_row_stride(image), itemsize};
+
+        ndarray_obj_t *ndarray = m_new_obj(ndarray_obj_t);
+        ndarray->base.type = &ulab_ndarray_type;
+        ndarray->dtype = native_code;
+        ndarray->boolean = NDARRAY_NUMERIC;
+        ndarray->ndim = 2;
+        ndarray->len = image->w * image->h;
+        ndarray->itemsize = itemsize;
+        memcpy(ndarray->shape, shape, sizeof(shape));
+        memcpy(ndarray->strides, strides, sizeof(strides));
+        ndarray->array = image->data;
+        ndarray->origin = image->data;
+        return MP_OBJ_FROM_PTR(ndarray);
+    }
+
     switch (dtype_code) {
         case 'b':
         case 'B': {
@@ -904,6 +1000,18 @@ static mp_obj_t py_image_get_pixel(uint n_args, const mp_obj_t *args, mp_map_t *
                 return mp_obj_new_int(IMAGE_GET_GRAYSCALE_PIXEL(arg_img, arg_x, arg_y));
             }
         }
+        case PIXFORMAT_GRAYSCALE16: {
+            if (arg_rgbtuple) {
+                int pixel = IMAGE_GET_GRAYSCALE16_PIXEL(arg_img, arg_x, arg_y) >> 8;
+                mp_obj_t pixel_tuple[3];
+                pixel_tuple[0] = mp_obj_new_int(COLOR_RGB565_TO_R8(COLOR_GRAYSCALE_TO_RGB565(pixel)));
+                pixel_tuple[1] = mp_obj_new_int(COLOR_RGB565_TO_G8(COLOR_GRAYSCALE_TO_RGB565(pixel)));
+                pixel_tuple[2] = mp_obj_new_int(COLOR_RGB565_TO_B8(COLOR_GRAYSCALE_TO_RGB565(pixel)));
+                return mp_obj_new_tuple(3, pixel_tuple);
+            } else {
+                return mp_obj_new_int(IMAGE_GET_GRAYSCALE16_PIXEL(arg_img, arg_x, arg_y));
+            }
+        }
         case PIXFORMAT_RGB565: {
             if (arg_rgbtuple) {
                 int pixel = IMAGE_GET_RGB565_PIXEL(arg_img, arg_x, arg_y);
@@ -969,6 +1077,10 @@ static mp_obj_t py_image_set_pixel(uint n_args, const mp_obj_t *args, mp_map_t *
             IMAGE_PUT_GRAYSCALE_PIXEL(arg_img, arg_x, arg_y, arg_c);
             return args[0];
         }
+        case PIXFORMAT_GRAYSCALE16: {
+            IMAGE_PUT_GRAYSCALE16_PIXEL(arg_img, arg_x, arg_y, arg_c);
+            return args[0];
+        }
         case PIXFORMAT_RGB565:
         case PIXFORMAT_YUV_ANY: {
             // re-use
@@ -984,7 +1096,7 @@ static mp_obj_t py_image_to(pixformat_t pixfmt, mp_rom_obj_t default_color_palet
                             uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum {
         ARG_x_scale, ARG_y_scale, ARG_roi, ARG_channel, ARG_alpha, ARG_color_palette, ARG_alpha_palette, ARG_hint,
-        ARG_copy, ARG_copy_to_fb, ARG_quality, ARG_encode_for_ide, ARG_subsampling
+        ARG_copy, ARG_copy_to_fb, ARG_quality, ARG_encode_for_ide, ARG_subsampling, ARG_effort, ARG_pool
     };
     const mp_arg_t allowed_args[] = {
         { MP_QSTR_x_scale, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
@@ -1000,6 +1112,8 @@ static mp_obj_t py_image_to(pixformat_t pixfmt, mp_rom_obj_t default_color_palet
         { MP_QSTR_quality, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 90} },
         { MP_QSTR_encode_for_ide, MP_ARG_BOOL | MP_ARG_KW_ONLY,  {.u_bool = false} },
         { MP_QSTR_subsampling, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = JPEG_SUBSAMPLING_AUTO} },
+        { MP_QSTR_effort, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = PNG_EFFORT_BEST} },
+        { MP_QSTR_pool, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
     };
 
     // Parse args.
@@ -1021,6 +1135,10 @@ static mp_obj_t py_image_to(pixformat_t pixfmt, mp_rom_obj_t default_color_palet
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Quality ranges between 0 and 100"));
     }
 
+    if (args[ARG_effort].u_int < PNG_EFFORT_STORED || args[ARG_effort].u_int > PNG_EFFORT_BEST) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Effort ranges between 0 and 2"));
+    }
+
     float x_scale = 1.0f;
     float y_scale = 1.0f;
     py_helper_arg_to_scale(args[ARG_x_scale].u_obj, args[ARG_y_scale].u_obj, &x_scale, &y_scale);
@@ -1033,6 +1151,11 @@ static mp_obj_t py_image_to(pixformat_t pixfmt, mp_rom_obj_t default_color_palet
                                                      IMAGE_HINT_SCALE_ASPECT_EXPAND |
                                                      IMAGE_HINT_SCALE_ASPECT_IGNORE)) | IMAGE_HINT_BLACK_BACKGROUND;
 
+    // Copying to a pool image implies copy=True.
+    if (args[ARG_pool].u_obj != mp_const_none) {
+        args[ARG_copy].u_bool = true;
+    }
+
     if (args[ARG_copy_to_fb].u_bool) {
         framebuffer_update_jpeg_buffer();
     }
@@ -1064,6 +1187,16 @@ static mp_obj_t py_image_to(pixformat_t pixfmt, mp_rom_obj_t default_color_palet
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Only copying/cropping is supported for Bayer/YUV!"));
     }
 
+    if ((dst_img.pixfmt == PIXFORMAT_GRAYSCALE16) &&
+        ((src_img->pixfmt != PIXFORMAT_GRAYSCALE16) ||
+         (x_scale != 1.0f) || (y_scale != 1.0f) || transposed ||
+         (args[ARG_hint].u_int & (IMAGE_HINT_HMIRROR | IMAGE_HINT_VFLIP)) ||
+         (args[ARG_channel].u_int != -1) ||
+         (args[ARG_alpha].u_int != 256) ||
+         (color_palette != NULL) || (alpha_palette != NULL))) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Only copying/cropping is supported for GRAYSCALE16!"));
+    }
+
     if (dst_img.is_bayer) {
         dst_img.pixfmt = imlib_bayer_shift(dst_img.pixfmt, roi.x, roi.y, transposed);
         args[ARG_hint].u_int &= ~(IMAGE_HINT_AREA |
@@ -1098,7 +1231,7 @@ static mp_obj_t py_image_to(pixformat_t pixfmt, mp_rom_obj_t default_color_palet
                       (!transposed);
 
         if ((dst_img.pixfmt != src_img->pixfmt) || (!simple)) {
-            image_t temp;
+            image_t temp = {};
             memcpy(&temp, src_img, sizeof(image_t));
 
             if (src_img->is_compressed || (!simple)) {
@@ -1114,7 +1247,7 @@ static mp_obj_t py_image_to(pixformat_t pixfmt, mp_rom_obj_t default_color_palet
 
             if (((dst_img.pixfmt == PIXFORMAT_JPEG) &&
                  jpeg_compress(&temp, &dst_img_tmp, args[ARG_quality].u_int, false, args[ARG_subsampling].u_int))
-                || ((dst_img.pixfmt == PIXFORMAT_PNG) && png_compress(&temp, &dst_img_tmp))) {
+                || ((dst_img.pixfmt == PIXFORMAT_PNG) && png_compress(&temp, &dst_img_tmp, args[ARG_effort].u_int))) {
                 mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Compression Failed!"));
             }
         } else if (args[ARG_encode_for_ide].u_bool) {
@@ -1136,11 +1269,15 @@ static mp_obj_t py_image_to(pixformat_t pixfmt, mp_rom_obj_t default_color_palet
     if (args[ARG_copy_to_fb].u_bool) {
         // Convert to FB.
         py_helper_set_to_framebuffer(&dst_img);
+    } else if (args[ARG_pool].u_obj != mp_const_none) {
+        // Copy to a preallocated pool image.
+        dst_img.data = py_image_pool_alloc(args[ARG_pool].u_obj, size);
     } else if (args[ARG_copy].u_bool) {
         // Create dynamic copy.
         dst_img.data = xalloc(size);
     } else {
         // Convert in place.
+        py_image_unshare(pos_args[0]);
         bool fb = py_helper_is_equal_to_framebuffer(src_img);
         size_t buf_size = fb ? framebuffer_get_buffer_size() : image_size(src_img);
         PY_ASSERT_TRUE_MSG((size <= buf_size), "The image doesn't fit in the frame buffer!");
@@ -1154,11 +1291,27 @@ static mp_obj_t py_image_to(pixformat_t pixfmt, mp_rom_obj_t default_color_palet
             memcpy(dst_img.data, dst_img_tmp.data, dst_img.size);
         }
         fb_alloc_free_till_mark();
+    } else if (dst_img.pixfmt == PIXFORMAT_GRAYSCALE16) {
+        imlib_gray16_copy(&dst_img, src_img, &roi);
     } else {
+        bool simple = (x_scale == 1.0f) &&
+                      (y_scale == 1.0f) &&
+                      (roi.x == 0) &&
+                      (roi.y == 0) &&
+                      (roi.w == src_img->w) &&
+                      (roi.h == src_img->h) &&
+                      (args[ARG_channel].u_int == -1) &&
+                      (args[ARG_alpha].u_int == 256) &&
+                      (alpha_palette == NULL) &&
+                      (!transposed) &&
+                      (!(args[ARG_hint].u_int & (IMAGE_HINT_HMIRROR | IMAGE_HINT_VFLIP)));
+
         fb_alloc_mark();
-        imlib_draw_image(&dst_img, src_img, 0, 0, x_scale, y_scale, &roi,
-                         args[ARG_channel].u_int, args[ARG_alpha].u_int, color_palette, alpha_palette,
-                         args[ARG_hint].u_int, NULL, NULL, NULL);
+        if (!(simple && imlib_convert(&dst_img, src_img, color_palette))) {
+            imlib_draw_image(&dst_img, src_img, 0, 0, x_scale, y_scale, &roi,
+                             args[ARG_channel].u_int, args[ARG_alpha].u_int, color_palette, alpha_palette,
+                             args[ARG_hint].u_int, NULL, NULL, NULL);
+        }
         fb_alloc_free_till_mark();
     }
 
@@ -1205,6 +1358,112 @@ static mp_obj_t py_image_to_png(uint n_args, const mp_obj_t *args, mp_map_t *kw_
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_to_png_obj, 1, py_image_to_png);
 
+typedef struct py_image_compress_stream_state {
+    mp_obj_t callback;
+    mp_obj_array_t *chunk;
+    uint32_t size;
+    bool aborted;
+} py_image_compress_stream_state_t;
+
+static bool py_image_compress_stream_cb(void *arg, const uint8_t *data, uint32_t size) {
+    py_image_compress_stream_state_t *state = arg;
+
+    // The chunk is only valid until the callback returns, so it's passed by reference.
+    state->chunk->items = (void *) data;
+    state->chunk->len = size;
+    state->size += size;
+
+    if (mp_call_function_1(state->callback, MP_OBJ_FROM_PTR(state->chunk)) == mp_const_false) {
+        state->aborted = true;
+        return false;
+    }
+
+    return true;
+}
+
+static mp_obj_t py_image_compress_stream(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_callback, ARG_quality, ARG_subsampling, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_callback, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_quality, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 90} },
+        { MP_QSTR_subsampling, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = JPEG_SUBSAMPLING_AUTO} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 4096} },
+    };
+
+    // Parse args.
+    image_t *src_img = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_UNCOMPRESSED);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (!mp_obj_is_callable(args[ARG_callback].u_obj)) {
+        mp_raise_msg(&mp_type_TypeError, MP_ERROR_TEXT("Expected a callable object"));
+    }
+
+    if (args[ARG_quality].u_int < 1 || args[ARG_quality].u_int > 100) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Quality ranges between 0 and 100"));
+    }
+
+    if (args[ARG_buffer_size].u_int < JPEG_STREAM_BUFFER_MIN) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Buffer size must be at least 512 bytes"));
+    }
+
+    py_image_compress_stream_state_t state = {
+        .callback = args[ARG_callback].u_obj,
+        .chunk = MP_OBJ_TO_PTR(mp_obj_new_bytearray_by_ref(0, NULL)),
+        .size = 0,
+        .aborted = false,
+    };
+
+    fb_alloc_mark();
+    uint8_t *buf = fb_alloc(args[ARG_buffer_size].u_int, FB_ALLOC_PREFER_SPEED | FB_ALLOC_CACHE_ALIGN);
+
+    if (jpeg_compress_stream(src_img, args[ARG_quality].u_int, args[ARG_subsampling].u_int,
+                             buf, args[ARG_buffer_size].u_int, py_image_compress_stream_cb, &state)
+        && (!state.aborted)) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Compression Failed!"));
+    }
+
+    fb_alloc_free_till_mark();
+    return mp_obj_new_int(state.size);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_compress_stream_obj, 2, py_image_compress_stream);
+
+static void py_image_write_to_stream(mp_obj_t stream, const void *buf, size_t len) {
+    int errcode = MP_EIO;
+    if (mp_stream_rw(stream, (void *) buf, len, &errcode, MP_STREAM_RW_WRITE) != len) {
+        mp_raise_OSError(errcode);
+    }
+}
+
+static mp_obj_t py_image_write_to(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_stream, ARG_header };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_header, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+    };
+
+    // Parse args.
+    image_t *src_img = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_ANY);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t stream = args[ARG_stream].u_obj;
+    mp_get_stream_raise(stream, MP_STREAM_OP_WRITE);
+    size_t size = image_size(src_img);
+
+    // The header and the image are written from their own buffers, nothing is copied.
+    if (args[ARG_header].u_obj != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(args[ARG_header].u_obj, &bufinfo, MP_BUFFER_READ);
+        py_image_write_to_stream(stream, bufinfo.buf, bufinfo.len);
+        size += bufinfo.len;
+    }
+
+    py_image_write_to_stream(stream, src_img->data, image_size(src_img));
+    return mp_obj_new_int(size);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_write_to_obj, 2, py_image_write_to);
+
 static mp_obj_t py_image_copy(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     return py_image_to(PIXFORMAT_INVALID, MP_ROM_NONE, true, n_args, args, kw_args);
 }
@@ -1215,6 +1474,63 @@ static mp_obj_t py_image_crop(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_crop_obj, 1, py_image_crop);
 
+static mp_obj_t py_image_view(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_roi };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_roi, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+    };
+
+    // Parse args.
+    py_image_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    image_t *src_img = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_UNCOMPRESSED);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    rectangle_t roi = py_helper_arg_to_roi(args[ARG_roi].u_obj, src_img);
+    image_t dst_img = *src_img;
+    dst_img.w = roi.w;
+    dst_img.h = roi.h;
+
+    if ((roi.x != 0) || (roi.w != src_img->w)) {
+        // Rows of a partial width ROI are not contiguous, copy the ROI.
+        dst_img.data = xalloc(image_size(&dst_img));
+        fb_alloc_mark();
+        imlib_draw_image(&dst_img, src_img, 0, 0, 1.0f, 1.0f, &roi, -1, 256,
+                         NULL, NULL, IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
+        fb_alloc_free_till_mark();
+        return py_image_from_struct(&dst_img);
+    }
+
+    // A full width ROI is a contiguous range of rows, so the view points into the parent.
+    dst_img.data = src_img->data + (roi.y * image_line_size(src_img));
+
+    // The bayer pattern of the view starts on an odd row.
+    if (roi.y % 2) {
+        switch (src_img->pixfmt) {
+            case PIXFORMAT_BAYER_BGGR:
+                dst_img.pixfmt = PIXFORMAT_BAYER_GRBG;
+                break;
+            case PIXFORMAT_BAYER_GBRG:
+                dst_img.pixfmt = PIXFORMAT_BAYER_RGGB;
+                break;
+            case PIXFORMAT_BAYER_GRBG:
+                dst_img.pixfmt = PIXFORMAT_BAYER_BGGR;
+                break;
+            case PIXFORMAT_BAYER_RGGB:
+                dst_img.pixfmt = PIXFORMAT_BAYER_GBRG;
+                break;
+            default:
+                break;
+        }
+    }
+
+    py_image_obj_t *view = MP_OBJ_TO_PTR(py_image_from_struct(&dst_img));
+    // Keep a reference to the image that owns the pixels, not to an intermediate view.
+    view->parent = (self->parent != MP_OBJ_NULL) ? self->parent : pos_args[0];
+    return MP_OBJ_FROM_PTR(view);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_view_obj, 1, py_image_view);
+
 #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
 static mp_obj_t py_image_save(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     image_t *arg_img = py_image_cobj(args[0]);
@@ -1387,6 +1703,56 @@ static mp_obj_t py_image_draw_string(uint n_args, const mp_obj_t *args, mp_map_t
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_draw_string_obj, 2, py_image_draw_string);
 
+// Draws a list of (x, y, text) or (x, y, text, color) tuples with the same style.
+static mp_obj_t py_image_draw_strings(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+
+    size_t n_items;
+    mp_obj_t *items;
+    mp_obj_get_array(args[1], &n_items, &items);
+    uint offset = 2;
+
+    int arg_c =
+        py_helper_keyword_color(arg_img, n_args, args, offset + 0, kw_args, -1); // White.
+    float arg_scale =
+        py_helper_keyword_float(n_args, args, offset + 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_scale), 1.0);
+    PY_ASSERT_TRUE_MSG(0 < arg_scale, "Error: 0 < scale!");
+    int arg_x_spacing =
+        py_helper_keyword_int(n_args, args, offset + 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_spacing), 0);
+    int arg_y_spacing =
+        py_helper_keyword_int(n_args, args, offset + 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_spacing), 0);
+    bool arg_mono_space =
+        py_helper_keyword_int(n_args, args, offset + 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_mono_space), true);
+    int arg_char_rotation =
+        py_helper_keyword_int(n_args, args, offset + 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_char_rotation), 0);
+    int arg_char_hmirror =
+        py_helper_keyword_int(n_args, args, offset + 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_char_hmirror), false);
+    int arg_char_vflip =
+        py_helper_keyword_int(n_args, args, offset + 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_char_vflip), false);
+    int arg_string_rotation =
+        py_helper_keyword_int(n_args, args, offset + 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_string_rotation), 0);
+    int arg_string_hmirror =
+        py_helper_keyword_int(n_args, args, offset + 9, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_string_hmirror), false);
+    int arg_string_vflip =
+        py_helper_keyword_int(n_args, args, offset + 10, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_string_vflip), false);
+
+    for (size_t i = 0; i < n_items; i++) {
+        size_t item_len;
+        mp_obj_t *item;
+        mp_obj_get_array(items[i], &item_len, &item);
+        PY_ASSERT_TRUE_MSG((item_len == 3) || (item_len == 4), "Expected (x, y, text) or (x, y, text, color)!");
+
+        // The optional 4th element overrides the color.
+        int c = py_helper_keyword_color(arg_img, item_len, item, 3, NULL, arg_c);
+        imlib_draw_string(arg_img, mp_obj_get_int(item[0]), mp_obj_get_int(item[1]), mp_obj_str_get_str(item[2]),
+                          c, arg_scale, arg_x_spacing, arg_y_spacing, arg_mono_space,
+                          arg_char_rotation, arg_char_hmirror, arg_char_vflip,
+                          arg_string_rotation, arg_string_hmirror, arg_string_vflip);
+    }
+    return args[0];
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_draw_strings_obj, 2, py_image_draw_strings);
+
 static mp_obj_t py_image_draw_cross(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
 
@@ -1562,7 +1928,7 @@ static mp_obj_t py_image_mask_rectangle(uint n_args, const mp_obj_t *args, mp_ma
     }
 
     fb_alloc_mark();
-    image_t temp;
+    image_t temp = {};
     temp.w = arg_img->w;
     temp.h = arg_img->h;
     temp.pixfmt = PIXFORMAT_BINARY;
@@ -1595,7 +1961,7 @@ static mp_obj_t py_image_mask_circle(uint n_args, const mp_obj_t *args, mp_map_t
     }
 
     fb_alloc_mark();
-    image_t temp;
+    image_t temp = {};
     temp.w = arg_img->w;
     temp.h = arg_img->h;
     temp.pixfmt = PIXFORMAT_BINARY;
@@ -1634,7 +2000,7 @@ static mp_obj_t py_image_mask_ellipse(uint n_args, const mp_obj_t *args, mp_map_
     }
 
     fb_alloc_mark();
-    image_t temp;
+    image_t temp = {};
     temp.w = arg_img->w;
     temp.h = arg_img->h;
     temp.pixfmt = PIXFORMAT_BINARY;
@@ -1800,9 +2166,10 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_draw_image_obj, 1, py_image_draw_imag
 //////////////
 
 static mp_obj_t py_awb(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_max };
+    enum { ARG_max, ARG_step };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_max, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_step, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1} },
     };
 
     // Parse args.
@@ -1814,6 +2181,12 @@ static mp_obj_t py_awb(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
 
     if (args[ARG_max].u_bool) {
         imlib_awb_rgb_max(image, &r_out, &g_out, &b_out); // white patch algorithm
+    } else if (args[ARG_step].u_int > 1) {
+        imlib_isp_stats_t stats;
+        imlib_isp_stats(image, args[ARG_step].u_int, &stats); // sparse gray world
+        r_out = stats.r_avg;
+        g_out = stats.g_avg;
+        b_out = stats.b_avg;
     } else {
         imlib_awb_rgb_avg(image, &r_out, &g_out, &b_out); // gray world algorithm
     }
@@ -1823,10 +2196,36 @@ static mp_obj_t py_awb(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args)
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_awb_obj, 1, py_awb);
 
-static mp_obj_t py_ccm(mp_obj_t img_obj, mp_obj_t ccm_obj) {
-    image_t *image = py_helper_arg_to_image(img_obj, ARG_IMAGE_MUTABLE);
+static mp_obj_t py_image_get_isp_stats(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_step };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_step, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 8} },
+    };
 
-    float ccm[12] = {};
+    // Parse args.
+    image_t *image = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_UNCOMPRESSED);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    imlib_isp_stats_t stats;
+    imlib_isp_stats(image, args[ARG_step].u_int, &stats);
+
+    mp_obj_list_t *hist = mp_obj_new_list(IMLIB_ISP_STATS_BINS, NULL);
+    for (int i = 0; i < IMLIB_ISP_STATS_BINS; i++) {
+        hist->items[i] = mp_obj_new_int(stats.histogram[i]);
+    }
+
+    return mp_obj_new_tuple(6, (mp_obj_t []) {mp_obj_new_int(stats.r_avg),
+                                              mp_obj_new_int(stats.g_avg),
+                                              mp_obj_new_int(stats.b_avg),
+                                              mp_obj_new_int(stats.y_avg),
+                                              mp_obj_new_int(stats.focus),
+                                              MP_OBJ_FROM_PTR(hist)});
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_isp_stats_obj, 1, py_image_get_isp_stats);
+
+// Parses a color correction matrix into ccm[12], returns true if it has offsets.
+static bool py_image_arg_to_ccm(mp_obj_t ccm_obj, float *ccm) {
     bool offset = false;
 
     size_t len;
@@ -1869,6 +2268,15 @@ static mp_obj_t py_ccm(mp_obj_t img_obj, mp_obj_t ccm_obj) {
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unexpected matrix dimensions!"));
     }
 
+    return offset;
+}
+
+static mp_obj_t py_ccm(mp_obj_t img_obj, mp_obj_t ccm_obj) {
+    image_t *image = py_helper_arg_to_image(img_obj, ARG_IMAGE_MUTABLE);
+
+    float ccm[12] = {};
+    bool offset = py_image_arg_to_ccm(ccm_obj, ccm);
+
     imlib_ccm(image, ccm, offset);
     return img_obj;
 }
@@ -1898,6 +2306,68 @@ static mp_obj_t py_image_gamma(uint n_args, const mp_obj_t *pos_args, mp_map_t *
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_gamma_obj, 1, py_image_gamma);
 
+static mp_obj_t py_image_isp(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_awb, ARG_step, ARG_ccm, ARG_gamma, ARG_contrast, ARG_brightness };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_awb, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true} },
+        { MP_QSTR_step, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1} },
+        { MP_QSTR_ccm, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_gamma, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_contrast, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE } },
+        { MP_QSTR_brightness, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE } },
+    };
+
+    // Parse args.
+    image_t *image = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_MUTABLE);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (image->pixfmt != PIXFORMAT_RGB565) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected an RGB565 image!"));
+    }
+
+    float gains[3], *gains_ptr = NULL;
+
+    if (args[ARG_awb].u_bool) {
+        uint32_t r_out, g_out, b_out;
+
+        if (args[ARG_step].u_int > 1) {
+            imlib_isp_stats_t stats;
+            imlib_isp_stats(image, args[ARG_step].u_int, &stats); // sparse gray world
+            r_out = stats.r_avg;
+            g_out = stats.g_avg;
+            b_out = stats.b_avg;
+        } else {
+            imlib_awb_rgb_avg(image, &r_out, &g_out, &b_out); // gray world algorithm
+        }
+
+        // Same gains as imlib_awb().
+        gains[0] = IM_MIN(IM_DIV(g_out * 32, r_out), 128U) / 32.0f;
+        gains[1] = 1.0f;
+        gains[2] = IM_MIN(IM_DIV(g_out * 32, b_out), 128U) / 32.0f;
+        gains_ptr = gains;
+    }
+
+    float ccm[12] = {}, *ccm_ptr = NULL;
+
+    if (args[ARG_ccm].u_obj != mp_const_none) {
+        py_image_arg_to_ccm(args[ARG_ccm].u_obj, ccm);
+        ccm_ptr = ccm;
+    }
+
+    float gamma = py_helper_arg_to_float(args[ARG_gamma].u_obj, 1.0f);
+    float contrast = py_helper_arg_to_float(args[ARG_contrast].u_obj, 1.0f);
+    float brightness = py_helper_arg_to_float(args[ARG_brightness].u_obj, 0.0f);
+
+    fb_alloc_mark();
+    imlib_isp_params_t *params = fb_alloc(sizeof(imlib_isp_params_t), FB_ALLOC_NO_HINT);
+    imlib_isp_params_init(params, gains_ptr, ccm_ptr, gamma, contrast, brightness);
+    imlib_isp(image, image, params);
+    fb_alloc_free_till_mark();
+    return pos_args[0];
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_isp_obj, 1, py_image_isp);
+
 #endif // IMLIB_ENABLE_ISP_OPS
 
 #ifdef IMLIB_ENABLE_BINARY_OPS
@@ -1917,10 +2387,14 @@ static mp_obj_t py_image_binary(uint n_args, const mp_obj_t *pos_args, mp_map_t
     };
 
     // Parse args.
-    image_t *image = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_MUTABLE);
+    image_t *image = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_MUTABLE | ARG_IMAGE_GRAYSCALE16 | ARG_IMAGE_YUV);
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
+    if (image->is_yuv && (!args[ARG_to_bitmap].u_int)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("YUV images can only be thresholded to a bitmap!"));
+    }
+
     if (args[ARG_to_bitmap].u_int && (image->pixfmt != PIXFORMAT_BINARY) &&
         (args[ARG_zero].u_int || (args[ARG_mask].u_obj != mp_const_none))) {
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Incompatible arguments!"));
@@ -1932,7 +2406,9 @@ static mp_obj_t py_image_binary(uint n_args, const mp_obj_t *pos_args, mp_map_t
                 PY_ASSERT_TRUE_MSG((image->w >= 4), "Can't convert to bitmap in place!");
                 break;
             }
-            case PIXFORMAT_RGB565: {
+            case PIXFORMAT_RGB565:
+            case PIXFORMAT_GRAYSCALE16:
+            case PIXFORMAT_YUV_ANY: {
                 PY_ASSERT_TRUE_MSG((image->w >= 2), "Can't convert to bitmap in place!");
                 break;
             }
@@ -1943,10 +2419,15 @@ static mp_obj_t py_image_binary(uint n_args, const mp_obj_t *pos_args, mp_map_t
     }
 
     list_t thresholds;
-    list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
-    py_helper_arg_to_thresholds(args[ARG_thresholds].u_obj, &thresholds);
+    if (image->pixfmt == PIXFORMAT_GRAYSCALE16) {
+        list_init(&thresholds, sizeof(gray16_thresholds_list_lnk_data_t));
+        py_helper_arg_to_gray16_thresholds(args[ARG_thresholds].u_obj, &thresholds);
+    } else {
+        list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
+        py_helper_arg_to_thresholds(args[ARG_thresholds].u_obj, &thresholds);
+    }
 
-    image_t out;
+    image_t out = {};
     out.w = image->w;
     out.h = image->h;
     out.pixfmt = args[ARG_to_bitmap].u_int ? PIXFORMAT_BINARY : image->pixfmt;
@@ -1958,7 +2439,11 @@ static mp_obj_t py_image_binary(uint n_args, const mp_obj_t *pos_args, mp_map_t
         mask = py_helper_arg_to_image(args[ARG_mask].u_obj, ARG_IMAGE_MUTABLE | ARG_IMAGE_ALLOC);
     }
 
-    imlib_binary(&out, image, &thresholds, args[ARG_invert].u_int, args[ARG_zero].u_int, mask);
+    if (image->pixfmt == PIXFORMAT_GRAYSCALE16) {
+        imlib_gray16_binary(&out, image, &thresholds, args[ARG_invert].u_int, args[ARG_zero].u_int, mask);
+    } else {
+        imlib_binary(&out, image, &thresholds, args[ARG_invert].u_int, args[ARG_zero].u_int, mask);
+    }
     fb_alloc_free_till_mark();
 
     list_free(&thresholds);
@@ -1972,9 +2457,61 @@ static mp_obj_t py_image_binary(uint n_args, const mp_obj_t *pos_args, mp_map_t
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_binary_obj, 1, py_image_binary);
 
-static mp_obj_t py_image_invert(mp_obj_t img_obj) {
-    imlib_invert(py_helper_arg_to_image(img_obj, ARG_IMAGE_MUTABLE));
-    return img_obj;
+static mp_obj_t py_image_adaptive_threshold(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_window, ARG_k, ARG_method, ARG_invert, ARG_copy };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_window, MP_ARG_INT, {.u_int = 15} },
+        { MP_QSTR_k, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_method, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = ADAPTIVE_BRADLEY} },
+        { MP_QSTR_invert, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_copy, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+    };
+
+    // Parse args.
+    image_t *image = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_MUTABLE);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    adaptive_method_t method = args[ARG_method].u_int;
+    // The squared window sums must fit in 32-bits.
+    int window = args[ARG_window].u_int;
+    PY_ASSERT_TRUE_MSG((window >= 3) && (window <= 255), "Window must be between 3 and 255!");
+    PY_ASSERT_TRUE_MSG((method == ADAPTIVE_BRADLEY) || (method == ADAPTIVE_SAUVOLA), "Invalid method!");
+    PY_ASSERT_TRUE_MSG((image->pixfmt == PIXFORMAT_GRAYSCALE) || (image->pixfmt == PIXFORMAT_RGB565),
+                       "Image must be grayscale or RGB565!");
+
+    float k = (method == ADAPTIVE_SAUVOLA) ? 0.34f : 0.15f;
+    if (args[ARG_k].u_obj != mp_const_none) {
+        k = mp_obj_get_float(args[ARG_k].u_obj);
+    }
+
+    if (!args[ARG_copy].u_int) {
+        PY_ASSERT_TRUE_MSG((image->w >= ((image->pixfmt == PIXFORMAT_GRAYSCALE) ? 4 : 2)),
+                           "Can't convert to bitmap in place!");
+    }
+
+    image_t out = {};
+    out.w = image->w;
+    out.h = image->h;
+    out.pixfmt = PIXFORMAT_BINARY;
+    out.data = args[ARG_copy].u_int ? xalloc(image_size(&out)) : image->pixels;
+
+    fb_alloc_mark();
+    imlib_adaptive_threshold(&out, image, window, k, method, args[ARG_invert].u_int);
+    fb_alloc_free_till_mark();
+
+    if (!args[ARG_copy].u_int) {
+        image->pixfmt = PIXFORMAT_BINARY;
+        py_helper_update_framebuffer(&out);
+    }
+
+    return py_image_from_struct(&out);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_adaptive_threshold_obj, 1, py_image_adaptive_threshold);
+
+static mp_obj_t py_image_invert(mp_obj_t img_obj) {
+    imlib_invert(py_helper_arg_to_image(img_obj, ARG_IMAGE_MUTABLE));
+    return img_obj;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(py_image_invert_obj, py_image_invert);
 
@@ -2088,6 +2625,25 @@ static mp_obj_t py_image_difference(uint n_args, const mp_obj_t *pos_args, mp_ma
     return py_image_line_op(n_args, pos_args, kw_args, imlib_difference_line_op);
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_difference_obj, 1, py_image_difference);
+
+static mp_obj_t py_image_hdr_fuse(size_t n_args, const mp_obj_t *args) {
+    image_t *image = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+    image_t *others[IMLIB_HDR_MAX_EXPOSURES - 1];
+
+    PY_ASSERT_TRUE_MSG((image->pixfmt == PIXFORMAT_GRAYSCALE) || (image->pixfmt == PIXFORMAT_RGB565),
+                       "Only GRAYSCALE and RGB565 images are supported!");
+
+    for (size_t i = 1; i < n_args; i++) {
+        others[i - 1] = py_helper_arg_to_image(args[i], ARG_IMAGE_ANY);
+        PY_ASSERT_TRUE_MSG((others[i - 1]->w == image->w) && (others[i - 1]->h == image->h) &&
+                           (others[i - 1]->pixfmt == image->pixfmt),
+                           "The exposures must have the same size and pixel format!");
+    }
+
+    imlib_hdr_fuse(image, others, n_args - 1);
+    return args[0];
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_image_hdr_fuse_obj, 2, IMLIB_HDR_MAX_EXPOSURES, py_image_hdr_fuse);
 #endif // IMLIB_ENABLE_MATH_OPS
 
 #if defined(IMLIB_ENABLE_MATH_OPS) && defined(IMLIB_ENABLE_BINARY_OPS)
@@ -2130,7 +2686,7 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_histeq_obj, 1, py_image_histeq);
 #ifdef IMLIB_ENABLE_MEAN
 static mp_obj_t py_image_mean(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     image_t *arg_img =
-        py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+        py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE | ARG_IMAGE_GRAYSCALE16);
     int arg_ksize =
         py_helper_arg_to_ksize(args[1]);
     bool arg_threshold =
@@ -2143,7 +2699,11 @@ static mp_obj_t py_image_mean(uint n_args, const mp_obj_t *args, mp_map_t *kw_ar
         py_helper_keyword_to_image(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_mask), NULL);
 
     fb_alloc_mark();
-    imlib_mean_filter(arg_img, arg_ksize, arg_threshold, arg_offset, arg_invert, arg_msk);
+    if (arg_img->pixfmt == PIXFORMAT_GRAYSCALE16) {
+        imlib_gray16_mean_filter(arg_img, arg_ksize, arg_threshold, arg_offset, arg_invert, arg_msk);
+    } else {
+        imlib_mean_filter(arg_img, arg_ksize, arg_threshold, arg_offset, arg_invert, arg_msk);
+    }
     fb_alloc_free_till_mark();
     return args[0];
 }
@@ -2153,7 +2713,7 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_mean_obj, 2, py_image_mean);
 #ifdef IMLIB_ENABLE_MEDIAN
 static mp_obj_t py_image_median(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     image_t *arg_img =
-        py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+        py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE | ARG_IMAGE_GRAYSCALE16);
     int arg_ksize =
         py_helper_arg_to_ksize(args[1]);
     float arg_percentile =
@@ -2167,9 +2727,16 @@ static mp_obj_t py_image_median(uint n_args, const mp_obj_t *args, mp_map_t *kw_
         py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_invert), false);
     image_t *arg_msk =
         py_helper_keyword_to_image(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_mask), NULL);
+    bool arg_fast =
+        py_helper_keyword_int(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fast), false);
 
     fb_alloc_mark();
-    imlib_median_filter(arg_img, arg_ksize, arg_percentile, arg_threshold, arg_offset, arg_invert, arg_msk);
+    if (arg_img->pixfmt == PIXFORMAT_GRAYSCALE16) {
+        imlib_gray16_median_filter(arg_img, arg_ksize, arg_percentile, arg_threshold, arg_offset, arg_invert, arg_msk);
+    } else {
+        imlib_median_filter(arg_img, arg_ksize, arg_percentile, arg_threshold, arg_offset, arg_invert, arg_msk,
+                            arg_fast);
+    }
     fb_alloc_free_till_mark();
     return args[0];
 }
@@ -2225,6 +2792,60 @@ static mp_obj_t py_image_midpoint(uint n_args, const mp_obj_t *args, mp_map_t *k
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_midpoint_obj, 2, py_image_midpoint);
 #endif // IMLIB_ENABLE_MIDPOINT
 
+// Shrinks the image in place by integer factors, each output pixel reduces an x_div x y_div block.
+static image_t *py_image_pool_args(mp_obj_t img_obj, mp_obj_t x_div_obj, mp_obj_t y_div_obj,
+                                   int *x_div, int *y_div, image_t *out) {
+    image_t *arg_img = py_helper_arg_to_image(img_obj, ARG_IMAGE_MUTABLE);
+    PY_ASSERT_TRUE_MSG((arg_img->pixfmt == PIXFORMAT_GRAYSCALE) || (arg_img->pixfmt == PIXFORMAT_RGB565),
+                       "Only grayscale and RGB565 images are supported");
+
+    *x_div = mp_obj_get_int(x_div_obj);
+    *y_div = mp_obj_get_int(y_div_obj);
+    PY_ASSERT_TRUE_MSG((*x_div >= 1) && (*x_div <= arg_img->w), "Width divisor must be between 1 and the width");
+    PY_ASSERT_TRUE_MSG((*y_div >= 1) && (*y_div <= arg_img->h), "Height divisor must be between 1 and the height");
+    PY_ASSERT_TRUE_MSG(*y_div <= 256, "Height divisor must be <= 256");
+
+    *out = *arg_img;
+    out->w = arg_img->w / *x_div;
+    out->h = arg_img->h / *y_div;
+    return arg_img;
+}
+
+static mp_obj_t py_image_mean_pool(mp_obj_t img_obj, mp_obj_t x_div_obj, mp_obj_t y_div_obj) {
+    int x_div, y_div;
+    image_t out;
+    image_t *arg_img = py_image_pool_args(img_obj, x_div_obj, y_div_obj, &x_div, &y_div, &out);
+
+    fb_alloc_mark();
+    imlib_mean_pool(arg_img, &out, x_div, y_div);
+    fb_alloc_free_till_mark();
+
+    arg_img->w = out.w;
+    arg_img->h = out.h;
+    py_helper_update_framebuffer(arg_img);
+    return img_obj;
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(py_image_mean_pool_obj, py_image_mean_pool);
+
+static mp_obj_t py_image_midpoint_pool(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    int x_div, y_div;
+    image_t out;
+    image_t *arg_img = py_image_pool_args(args[0], args[1], args[2], &x_div, &y_div, &out);
+    float arg_bias =
+        py_helper_keyword_float(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_bias), 0.5f);
+    PY_ASSERT_TRUE_MSG((0 <= arg_bias) && (arg_bias <= 1), "Error: 0 <= bias <= 1!");
+
+    fb_alloc_mark();
+    imlib_midpoint_pool(arg_img, &out, x_div, y_div, fast_roundf(arg_bias * 256));
+    fb_alloc_free_till_mark();
+
+    arg_img->w = out.w;
+    arg_img->h = out.h;
+    py_helper_update_framebuffer(arg_img);
+    return args[0];
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_midpoint_pool_obj, 3, py_image_midpoint_pool);
+
 #ifdef IMLIB_ENABLE_MORPH
 static mp_obj_t py_image_morph(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
     enum { ARG_mul, ARG_add, ARG_threshold, ARG_offset, ARG_invert, ARG_mask };
@@ -2361,8 +2982,13 @@ static mp_obj_t py_image_gaussian(uint n_args, const mp_obj_t *pos_args, mp_map_
     float mul = py_helper_arg_to_float(args[ARG_mul].u_obj, 1.0f);
     float add = py_helper_arg_to_float(args[ARG_add].u_obj, 0.0f);
 
-    imlib_morph(image, ksize, krn, mul / sum, add, args[ARG_threshold].u_bool,
-                args[ARG_offset].u_int, args[ARG_invert].u_bool, mask);
+    // Large plain blurs use constant-time stacked box blurs, everything else uses the exact kernel.
+    if (args[ARG_unsharp].u_bool || (mul != 1.0f) || (add != 0.0f) ||
+        !imlib_gaussian_filter(image, ksize, args[ARG_threshold].u_bool,
+                               args[ARG_offset].u_int, args[ARG_invert].u_bool, mask)) {
+        imlib_morph(image, ksize, krn, mul / sum, add, args[ARG_threshold].u_bool,
+                    args[ARG_offset].u_int, args[ARG_invert].u_bool, mask);
+    }
     fb_alloc_free_till_mark();
     return pos_args[0];
 }
@@ -2455,10 +3081,17 @@ static mp_obj_t py_image_bilateral(uint n_args, const mp_obj_t *args, mp_map_t *
         py_helper_keyword_int(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_invert), false);
     image_t *arg_msk =
         py_helper_keyword_to_image(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_mask), NULL);
+    bool arg_grid =
+        py_helper_keyword_int(n_args, args, 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_grid), false);
 
     fb_alloc_mark();
-    imlib_bilateral_filter(arg_img, arg_ksize, arg_color_sigma, arg_space_sigma, arg_threshold, arg_offset, arg_invert,
-                           arg_msk);
+    if (arg_grid) {
+        imlib_bilateral_grid(arg_img, arg_ksize, arg_color_sigma, arg_space_sigma, arg_threshold, arg_offset, arg_invert,
+                             arg_msk);
+    } else {
+        imlib_bilateral_filter(arg_img, arg_ksize, arg_color_sigma, arg_space_sigma, arg_threshold, arg_offset,
+                               arg_invert, arg_msk);
+    }
     fb_alloc_free_till_mark();
     return args[0];
 }
@@ -2504,6 +3137,61 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_logpolar_obj, 1, py_image_logpolar);
 #endif // IMLIB_ENABLE_LOGPOLAR
 
 #ifdef IMLIB_ENABLE_LENS_CORR
+// Lens Correction Object //
+typedef struct py_lens_corr_obj {
+    mp_obj_base_t base;
+    int w, h;
+    float strength, zoom;
+    int16_t *map;
+} py_lens_corr_obj_t;
+
+static void py_lens_corr_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_lens_corr_obj_t *self = self_in;
+    mp_printf(print, "{\"w\":%d, \"h\":%d, \"strength\":%f, \"zoom\":%f}",
+              self->w, self->h, (double) self->strength, (double) self->zoom);
+}
+
+static mp_obj_t py_lens_corr_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_width, ARG_height, ARG_strength, ARG_zoom };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_height, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_strength, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_zoom, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int w = args[ARG_width].u_int;
+    int h = args[ARG_height].u_int;
+    float strength = (args[ARG_strength].u_obj == mp_const_none) ? 1.8f : mp_obj_get_float(args[ARG_strength].u_obj);
+    float zoom = (args[ARG_zoom].u_obj == mp_const_none) ? 1.0f : mp_obj_get_float(args[ARG_zoom].u_obj);
+
+    PY_ASSERT_TRUE_MSG((w > 0) && (h > 0), "Width and height must be > 0!");
+    PY_ASSERT_FALSE_MSG(w % 2, "Width must be even!");
+    PY_ASSERT_FALSE_MSG(h % 2, "Height must be even!");
+    PY_ASSERT_TRUE_MSG(strength > 0.0f, "Strength must be > 0!");
+    PY_ASSERT_TRUE_MSG(zoom > 0.0f, "Zoom must be > 0!");
+
+    py_lens_corr_obj_t *o = mp_obj_malloc(py_lens_corr_obj_t, type);
+    o->w = w;
+    o->h = h;
+    o->strength = strength;
+    o->zoom = zoom;
+    o->map = m_new(int16_t, (w / 2) * (h / 2) * 2);
+    imlib_lens_corr_map_init(o->map, w, h, strength, zoom);
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_lens_corr_type,
+    MP_QSTR_LensCorrection,
+    MP_TYPE_FLAG_NONE,
+    print, py_lens_corr_print,
+    make_new, py_lens_corr_make_new
+    );
+
 static mp_obj_t py_image_lens_corr(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     image_t *arg_img =
         py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
@@ -2521,8 +3209,19 @@ static mp_obj_t py_image_lens_corr(uint n_args, const mp_obj_t *args, mp_map_t *
     float arg_y_corr =
         py_helper_keyword_float(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_corr), 0.0f);
 
+    // A precomputed LensCorrection map replaces the strength and zoom arguments.
+    const int16_t *map = NULL;
+    mp_obj_t corr_obj = py_helper_keyword_object(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_map), NULL);
+    if (corr_obj) {
+        PY_ASSERT_TYPE(corr_obj, &py_lens_corr_type);
+        py_lens_corr_obj_t *corr = MP_OBJ_TO_PTR(corr_obj);
+        PY_ASSERT_TRUE_MSG((corr->w == arg_img->w) && (corr->h == arg_img->h),
+                           "The lens correction map doesn't match the image size!");
+        map = corr->map;
+    }
+
     fb_alloc_mark();
-    imlib_lens_corr(arg_img, arg_strength, arg_zoom, arg_x_corr, arg_y_corr);
+    imlib_lens_corr(arg_img, arg_strength, arg_zoom, arg_x_corr, arg_y_corr, map);
     fb_alloc_free_till_mark();
     return args[0];
 }
@@ -2707,6 +3406,42 @@ static mp_obj_t py_image_get_similarity(uint n_args, const mp_obj_t *pos_args, m
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_similarity_obj, 1, py_image_get_similarity);
 #endif // IMLIB_ENABLE_GET_SIMILARITY
 
+static mp_obj_t py_image_get_hash(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_roi };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_roi, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+    };
+
+    // Parse args.
+    image_t *image = py_helper_arg_to_image(pos_args[0], ARG_IMAGE_MUTABLE);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    rectangle_t roi = py_helper_arg_to_roi(args[ARG_roi].u_obj, image);
+    return mp_obj_new_int_from_ull(imlib_get_hash(image, &roi));
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_hash_obj, 1, py_image_get_hash);
+
+// Hashes don't fit in a small int, larger ones are long ints.
+static uint64_t py_image_arg_to_hash(mp_obj_t arg) {
+    uint64_t hash = 0;
+
+    if (mp_obj_is_small_int(arg)) {
+        hash = MP_OBJ_SMALL_INT_VALUE(arg);
+    } else if (mp_obj_is_int(arg)) {
+        mp_obj_int_to_bytes_impl(arg, false, sizeof(hash), (byte *) &hash);
+    } else {
+        mp_raise_msg(&mp_type_TypeError, MP_ERROR_TEXT("Expected an int"));
+    }
+
+    return hash;
+}
+
+static mp_obj_t py_image_hash_distance(mp_obj_t a_obj, mp_obj_t b_obj) {
+    return mp_obj_new_int(imlib_hash_distance(py_image_arg_to_hash(a_obj), py_image_arg_to_hash(b_obj)));
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(py_image_hash_distance_obj, py_image_hash_distance);
+
 // Statistics Object //
 #define py_statistics_obj_size    24
 typedef struct py_statistics_obj {
@@ -2733,7 +3468,8 @@ static void py_statistics_print(const mp_print_t *print, mp_obj_t self_in, mp_pr
                       mp_obj_get_int(self->LUQ));
             break;
         }
-        case PIXFORMAT_GRAYSCALE: {
+        case PIXFORMAT_GRAYSCALE:
+        case PIXFORMAT_GRAYSCALE16: {
             mp_printf(print,
                       "{\"mean\":%d, \"median\":%d, \"mode\":%d, \"stdev\":%d, \"min\":%d, \"max\":%d, \"lq\":%d, \"uq\":%d}",
                       mp_obj_get_int(self->LMean),
@@ -3311,9 +4047,9 @@ mp_obj_t py_histogram_get_percentile(mp_obj_t self_in, mp_obj_t percentile) {
     hist.ABinCount = ((mp_obj_list_t *) ((py_histogram_obj_t *) self_in)->ABins)->len;
     hist.BBinCount = ((mp_obj_list_t *) ((py_histogram_obj_t *) self_in)->BBins)->len;
     fb_alloc_mark();
-    hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
-    hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_NO_HINT);
-    hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_NO_HINT);
+    hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+    hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+    hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
 
     for (int i = 0; i < hist.LBinCount; i++) {
         hist.LBins[i] = mp_obj_get_float(((mp_obj_list_t *) ((py_histogram_obj_t *) self_in)->LBins)->items[i]);
@@ -3349,9 +4085,9 @@ mp_obj_t py_histogram_get_threshold(mp_obj_t self_in) {
     hist.ABinCount = ((mp_obj_list_t *) ((py_histogram_obj_t *) self_in)->ABins)->len;
     hist.BBinCount = ((mp_obj_list_t *) ((py_histogram_obj_t *) self_in)->BBins)->len;
     fb_alloc_mark();
-    hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
-    hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_NO_HINT);
-    hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_NO_HINT);
+    hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+    hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+    hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
 
     for (int i = 0; i < hist.LBinCount; i++) {
         hist.LBins[i] = mp_obj_get_float(((mp_obj_list_t *) ((py_histogram_obj_t *) self_in)->LBins)->items[i]);
@@ -3387,9 +4123,9 @@ mp_obj_t py_histogram_get_statistics(mp_obj_t self_in) {
     hist.ABinCount = ((mp_obj_list_t *) ((py_histogram_obj_t *) self_in)->ABins)->len;
     hist.BBinCount = ((mp_obj_list_t *) ((py_histogram_obj_t *) self_in)->BBins)->len;
     fb_alloc_mark();
-    hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
-    hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_NO_HINT);
-    hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_NO_HINT);
+    hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+    hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+    hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
 
     for (int i = 0; i < hist.LBinCount; i++) {
         hist.LBins[i] = mp_obj_get_float(((mp_obj_list_t *) ((py_histogram_obj_t *) self_in)->LBins)->items[i]);
@@ -3475,6 +4211,11 @@ static mp_obj_t py_image_get_histogram(uint n_args, const mp_obj_t *args, mp_map
     rectangle_t roi;
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 3, kw_args, &roi);
 
+    int x_stride = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_stride), 1);
+    PY_ASSERT_TRUE_MSG(x_stride > 0, "x_stride must not be zero.");
+    int y_stride = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_stride), 1);
+    PY_ASSERT_TRUE_MSG(y_stride > 0, "y_stride must not be zero.");
+
     histogram_t hist;
     switch (arg_img->pixfmt) {
         case PIXFORMAT_BINARY: {
@@ -3486,10 +4227,10 @@ static mp_obj_t py_image_get_histogram(uint n_args, const mp_obj_t *args, mp_map
             hist.ABinCount = 0;
             hist.BBinCount = 0;
             fb_alloc_mark();
-            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
+            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
             hist.ABins = NULL;
             hist.BBins = NULL;
-            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other);
+            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other, x_stride, y_stride);
             list_free(&thresholds);
             break;
         }
@@ -3502,10 +4243,10 @@ static mp_obj_t py_image_get_histogram(uint n_args, const mp_obj_t *args, mp_map
             hist.ABinCount = 0;
             hist.BBinCount = 0;
             fb_alloc_mark();
-            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
+            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
             hist.ABins = NULL;
             hist.BBins = NULL;
-            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other);
+            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other, x_stride, y_stride);
             list_free(&thresholds);
             break;
         }
@@ -3526,10 +4267,10 @@ static mp_obj_t py_image_get_histogram(uint n_args, const mp_obj_t *args, mp_map
             hist.BBinCount = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_b_bins), b_bins);
             PY_ASSERT_TRUE_MSG(hist.BBinCount >= 2, "b_bins must be >= 2");
             fb_alloc_mark();
-            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
-            hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_NO_HINT);
-            hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_NO_HINT);
-            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other);
+            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+            hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+            hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other, x_stride, y_stride);
             list_free(&thresholds);
             break;
         }
@@ -3565,7 +4306,7 @@ static mp_obj_t py_image_get_histogram(uint n_args, const mp_obj_t *args, mp_map
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_histogram_obj, 1, py_image_get_histogram);
 
 static mp_obj_t py_image_get_statistics(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE | ARG_IMAGE_GRAYSCALE16);
 
     list_t thresholds;
     list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
@@ -3576,6 +4317,42 @@ static mp_obj_t py_image_get_statistics(uint n_args, const mp_obj_t *args, mp_ma
     rectangle_t roi;
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 3, kw_args, &roi);
 
+    int x_stride = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_stride), 1);
+    PY_ASSERT_TRUE_MSG(x_stride > 0, "x_stride must not be zero.");
+    int y_stride = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_stride), 1);
+    PY_ASSERT_TRUE_MSG(y_stride > 0, "y_stride must not be zero.");
+
+    if (arg_img->pixfmt == PIXFORMAT_GRAYSCALE16) {
+        bool simple = (!list_size(&thresholds)) && (!other);
+        list_free(&thresholds);
+        PY_ASSERT_TRUE_MSG(simple, "Thresholds and difference are not supported for GRAYSCALE16!");
+
+        // The statistics are computed from the 16-bit values instead of a histogram of bins.
+        gray16_statistics_t stats;
+        fb_alloc_mark();
+        imlib_gray16_get_statistics(&stats, arg_img, &roi, x_stride, y_stride);
+        fb_alloc_free_till_mark();
+
+        py_statistics_obj_t *o = m_new_obj(py_statistics_obj_t);
+        o->base.type = &py_statistics_type;
+        o->pixfmt = arg_img->pixfmt;
+
+        o->LMean = mp_obj_new_int(stats.mean);
+        o->LMedian = mp_obj_new_int(stats.median);
+        o->LMode = mp_obj_new_int(stats.mode);
+        o->LSTDev = mp_obj_new_int(stats.stdev);
+        o->LMin = mp_obj_new_int(stats.min);
+        o->LMax = mp_obj_new_int(stats.max);
+        o->LLQ = mp_obj_new_int(stats.lq);
+        o->LUQ = mp_obj_new_int(stats.uq);
+
+        for (mp_obj_t *it = &o->AMean; it <= &o->BUQ; it++) {
+            *it = mp_obj_new_int(0);
+        }
+
+        return o;
+    }
+
     histogram_t hist;
     switch (arg_img->pixfmt) {
         case PIXFORMAT_BINARY: {
@@ -3587,10 +4364,10 @@ static mp_obj_t py_image_get_statistics(uint n_args, const mp_obj_t *args, mp_ma
             hist.ABinCount = 0;
             hist.BBinCount = 0;
             fb_alloc_mark();
-            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
+            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
             hist.ABins = NULL;
             hist.BBins = NULL;
-            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other);
+            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other, x_stride, y_stride);
             list_free(&thresholds);
             break;
         }
@@ -3603,10 +4380,10 @@ static mp_obj_t py_image_get_statistics(uint n_args, const mp_obj_t *args, mp_ma
             hist.ABinCount = 0;
             hist.BBinCount = 0;
             fb_alloc_mark();
-            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
+            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
             hist.ABins = NULL;
             hist.BBins = NULL;
-            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other);
+            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other, x_stride, y_stride);
             list_free(&thresholds);
             break;
         }
@@ -3627,10 +4404,10 @@ static mp_obj_t py_image_get_statistics(uint n_args, const mp_obj_t *args, mp_ma
             hist.BBinCount = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_b_bins), b_bins);
             PY_ASSERT_TRUE_MSG(hist.BBinCount >= 2, "b_bins must be >= 2");
             fb_alloc_mark();
-            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_NO_HINT);
-            hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_NO_HINT);
-            hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_NO_HINT);
-            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other);
+            hist.LBins = fb_alloc(hist.LBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+            hist.ABins = fb_alloc(hist.ABinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+            hist.BBins = fb_alloc(hist.BBinCount * sizeof(float), FB_ALLOC_PREFER_TCM);
+            imlib_get_histogram(&hist, arg_img, &roi, &thresholds, invert, other, x_stride, y_stride);
             list_free(&thresholds);
             break;
         }
@@ -3676,6 +4453,96 @@ static mp_obj_t py_image_get_statistics(uint n_args, const mp_obj_t *args, mp_ma
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_statistics_obj, 1, py_image_get_statistics);
 
+static mp_obj_t py_image_get_dominant_colors(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+    int k = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_k), 4);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 2, kw_args, &roi);
+
+    int x_stride = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_stride), 4);
+    PY_ASSERT_TRUE_MSG(x_stride > 0, "x_stride must not be zero.");
+    int y_stride = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_stride), 4);
+    PY_ASSERT_TRUE_MSG(y_stride > 0, "y_stride must not be zero.");
+    int batch = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_batch), 0);
+    int iterations = py_helper_keyword_int(n_args, args, n_args, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_iterations), 32);
+
+    int n = ((roi.w + x_stride - 1) / x_stride) * ((roi.h + y_stride - 1) / y_stride);
+    PY_ASSERT_TRUE_MSG((k >= 1) && (k <= n), "k must be between 1 and the number of samples");
+    int dims = (arg_img->pixfmt == PIXFORMAT_RGB565) ? 3 : 1;
+
+    fb_alloc_mark();
+    int16_t *points = fb_alloc(n * dims * sizeof(int16_t), FB_ALLOC_NO_HINT);
+    uint16_t *labels = fb_alloc(n * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    uint32_t *counts = fb_alloc(k * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    float *centroids = fb_alloc(k * dims * sizeof(float), FB_ALLOC_NO_HINT);
+
+    // Colors are clustered in LAB space.
+    for (int y = roi.y, i = 0, yy = roi.y + roi.h; y < yy; y += y_stride) {
+        for (int x = roi.x, xx = roi.x + roi.w; x < xx; x += x_stride, i++) {
+            switch (arg_img->pixfmt) {
+                case PIXFORMAT_BINARY: {
+                    points[i] = COLOR_BINARY_TO_GRAYSCALE(IMAGE_GET_BINARY_PIXEL(arg_img, x, y));
+                    break;
+                }
+                case PIXFORMAT_GRAYSCALE: {
+                    points[i] = IMAGE_GET_GRAYSCALE_PIXEL(arg_img, x, y);
+                    break;
+                }
+                case PIXFORMAT_RGB565: {
+                    int pixel = IMAGE_GET_RGB565_PIXEL(arg_img, x, y);
+                    points[i] = COLOR_RGB565_TO_L(pixel);
+                    points[n + i] = COLOR_RGB565_TO_A(pixel);
+                    points[(n * 2) + i] = COLOR_RGB565_TO_B(pixel);
+                    break;
+                }
+                default: {
+                    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unsupported pixel format"));
+                }
+            }
+        }
+    }
+
+    imlib_kmeans(points, n, dims, k, batch, iterations, centroids, labels, counts);
+
+    // Returns (color, fraction) tuples sorted from the most to the least common color.
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (int i = 0; i < k; i++) {
+        int j = 0;
+        for (int m = 1; m < k; m++) {
+            if (counts[m] > counts[j]) {
+                j = m;
+            }
+        }
+
+        if (!counts[j]) {
+            break;
+        }
+
+        mp_obj_t color;
+        if (arg_img->pixfmt == PIXFORMAT_RGB565) {
+            int pixel = COLOR_LAB_TO_RGB565(fast_roundf(centroids[j]),
+                                            fast_roundf(centroids[k + j]),
+                                            fast_roundf(centroids[(k * 2) + j]));
+            color = mp_obj_new_tuple(3, (mp_obj_t []) {mp_obj_new_int(COLOR_RGB565_TO_R8(pixel)),
+                                                      mp_obj_new_int(COLOR_RGB565_TO_G8(pixel)),
+                                                      mp_obj_new_int(COLOR_RGB565_TO_B8(pixel))});
+        } else if (arg_img->pixfmt == PIXFORMAT_BINARY) {
+            color = mp_obj_new_int(COLOR_GRAYSCALE_TO_BINARY(fast_roundf(centroids[j])));
+        } else {
+            color = mp_obj_new_int(fast_roundf(centroids[j]));
+        }
+
+        mp_obj_t item[2] = { color, mp_obj_new_float(((float) counts[j]) / n) };
+        mp_obj_list_append(list, mp_obj_new_tuple(2, item));
+        counts[j] = 0;
+    }
+
+    fb_alloc_free_till_mark();
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_dominant_colors_obj, 1, py_image_get_dominant_colors);
+
 // Line Object //
 #define py_line_obj_size    8
 typedef struct py_line_obj {
@@ -3821,11 +4688,18 @@ static mp_obj_t py_image_get_regression(uint n_args, const mp_obj_t *args, mp_ma
                                                           MP_OBJ_NEW_QSTR(MP_QSTR_pixels_threshold),
                                                           10);
     bool robust = py_helper_keyword_int(n_args, args, 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_robust), false);
+    regression_method_t method = py_helper_keyword_int(n_args, args, 9, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_method),
+                                                       robust ? REGRESSION_THEIL_SEN : REGRESSION_LEAST_SQUARES);
+    PY_ASSERT_TRUE_MSG((method >= REGRESSION_LEAST_SQUARES) && (method <= REGRESSION_RANSAC), "Invalid method!");
+    // Random pairs for the sampled Theil-Sen estimator, hypotheses for RANSAC.
+    unsigned int iterations = py_helper_keyword_int(n_args, args, 10, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_iterations),
+                                                    (method == REGRESSION_RANSAC) ? 64 : 1024);
+    unsigned int tolerance = py_helper_keyword_int(n_args, args, 11, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_tolerance), 2);
 
     find_lines_list_lnk_data_t out;
     fb_alloc_mark();
-    bool result = imlib_get_regression(&out, arg_img, &roi, x_stride,
-                                       y_stride, &thresholds, invert, area_threshold, pixels_threshold, robust);
+    bool result = imlib_get_regression(&out, arg_img, &roi, x_stride, y_stride, &thresholds, invert,
+                                       area_threshold, pixels_threshold, method, iterations, tolerance);
     fb_alloc_free_till_mark();
     list_free(&thresholds);
     if (!result) {
@@ -3862,6 +4736,7 @@ typedef struct py_blob_obj {
     mp_obj_t x, y, w, h, pixels, cx, cy, rotation, code, count, perimeter, roundness;
     mp_obj_t x_hist_bins;
     mp_obj_t y_hist_bins;
+    mp_obj_t id;
 } py_blob_obj_t;
 
 static void py_blob_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
@@ -4284,6 +5159,11 @@ mp_obj_t py_blob_enclosed_ellipse(mp_obj_t self_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(py_blob_enclosed_ellipse_obj, py_blob_enclosed_ellipse);
 
+mp_obj_t py_blob_id(mp_obj_t self_in) {
+    return ((py_blob_obj_t *) self_in)->id;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_blob_id_obj, py_blob_id);
+
 static const mp_rom_map_elem_t py_blob_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_corners), MP_ROM_PTR(&py_blob_corners_obj) },
     { MP_ROM_QSTR(MP_QSTR_min_corners), MP_ROM_PTR(&py_blob_min_corners_obj) },
@@ -4316,7 +5196,8 @@ static const mp_rom_map_elem_t py_blob_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_major_axis_line), MP_ROM_PTR(&py_blob_major_axis_line_obj) },
     { MP_ROM_QSTR(MP_QSTR_minor_axis_line), MP_ROM_PTR(&py_blob_minor_axis_line_obj) },
     { MP_ROM_QSTR(MP_QSTR_enclosing_circle), MP_ROM_PTR(&py_blob_enclosing_circle_obj) },
-    { MP_ROM_QSTR(MP_QSTR_enclosed_ellipse), MP_ROM_PTR(&py_blob_enclosed_ellipse_obj) }
+    { MP_ROM_QSTR(MP_QSTR_enclosed_ellipse), MP_ROM_PTR(&py_blob_enclosed_ellipse_obj) },
+    { MP_ROM_QSTR(MP_QSTR_id), MP_ROM_PTR(&py_blob_id_obj) }
 };
 
 static MP_DEFINE_CONST_DICT(py_blob_locals_dict, py_blob_locals_dict_table);
@@ -4355,6 +5236,7 @@ static py_blob_obj_t *py_blob_new(find_blobs_list_lnk_data_t *blob) {
 
     o->perimeter = mp_obj_new_int(blob->perimeter);
     o->roundness = mp_obj_new_float(blob->roundness);
+    o->id = mp_const_none;
 
     o->x_hist_bins = mp_obj_new_list(blob->x_hist_bins_count, NULL);
     o->y_hist_bins = mp_obj_new_list(blob->y_hist_bins_count, NULL);
@@ -4393,101 +5275,575 @@ static bool py_image_find_blobs_merge_cb(void *fun_obj, find_blobs_list_lnk_data
     return mp_obj_is_true(mp_call_function_2(fun_obj, py_blob_new(blob0), py_blob_new(blob1)));
 }
 
-static mp_obj_t py_image_find_blobs(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+// Blob Tracker Object //
+typedef struct py_blob_tracker_obj {
+    mp_obj_base_t base;
+    find_blobs_tracker_t tracker;
+} py_blob_tracker_obj_t;
 
-    list_t thresholds;
-    list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
-    py_helper_arg_to_thresholds(args[1], &thresholds);
-    if (!list_size(&thresholds)) {
-        return mp_obj_new_list(0, NULL);
+static void py_blob_tracker_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_blob_tracker_obj_t *self = self_in;
+    mp_printf(print, "{\"blobs\":%d, \"full_scan_interval\":%d, \"search_margin\":%d}",
+              list_size(&self->tracker.tracks),
+              self->tracker.full_scan_interval,
+              self->tracker.search_margin);
+}
+
+static mp_obj_t py_blob_tracker_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_full_scan_interval, ARG_search_margin };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_full_scan_interval, MP_ARG_INT, {.u_int = 10 } },
+        { MP_QSTR_search_margin, MP_ARG_INT, {.u_int = 16 } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    PY_ASSERT_TRUE_MSG(args[ARG_search_margin].u_int >= 0, "search_margin must be >= 0.");
+
+    py_blob_tracker_obj_t *o = mp_obj_malloc(py_blob_tracker_obj_t, type);
+    list_init(&o->tracker.tracks, sizeof(find_blobs_track_t));
+    o->tracker.next_id = 0;
+    o->tracker.frames = 0;
+    o->tracker.full_scan_interval = IM_MAX(args[ARG_full_scan_interval].u_int, 0);
+    o->tracker.search_margin = args[ARG_search_margin].u_int;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static mp_obj_t py_blob_tracker_reset(mp_obj_t self_in) {
+    py_blob_tracker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    list_clear(&self->tracker.tracks);
+    self->tracker.frames = 0;
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_blob_tracker_reset_obj, py_blob_tracker_reset);
+
+static const mp_rom_map_elem_t py_blob_tracker_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&py_blob_tracker_reset_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_blob_tracker_locals_dict, py_blob_tracker_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_blob_tracker_type,
+    MP_QSTR_BlobTracker,
+    MP_TYPE_FLAG_NONE,
+    print, py_blob_tracker_print,
+    make_new, py_blob_tracker_make_new,
+    locals_dict, &py_blob_tracker_locals_dict
+    );
+
+// Motion Detector Object //
+typedef struct py_motion_obj {
+    mp_obj_base_t base;
+    imlib_motion_t motion;
+} py_motion_obj_t;
+
+static void py_motion_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_motion_obj_t *self = self_in;
+    mp_printf(print, "{\"w\":%d, \"h\":%d, \"cell\":%d, \"rate\":%d, \"threshold\":%d}",
+              self->motion.w, self->motion.h, 1 << self->motion.shift,
+              self->motion.rate, self->motion.threshold);
+}
+
+static mp_obj_t py_motion_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_width, ARG_height, ARG_pixformat, ARG_shift, ARG_rate, ARG_threshold };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_height, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_pixformat, MP_ARG_INT, {.u_int = PIXFORMAT_GRAYSCALE } },
+        { MP_QSTR_shift, MP_ARG_INT, {.u_int = 2 } },
+        { MP_QSTR_rate, MP_ARG_INT, {.u_int = 8 } },
+        { MP_QSTR_threshold, MP_ARG_INT, {.u_int = 16 } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int w = args[ARG_width].u_int;
+    int h = args[ARG_height].u_int;
+    pixformat_t pixfmt = args[ARG_pixformat].u_int;
+    int shift = args[ARG_shift].u_int;
+
+    PY_ASSERT_TRUE_MSG((pixfmt == PIXFORMAT_GRAYSCALE) || (pixfmt == PIXFORMAT_RGB565),
+                       "Only GRAYSCALE and RGB565 images are supported!");
+    PY_ASSERT_TRUE_MSG((shift >= 0) && (shift <= IMLIB_MOTION_MAX_SHIFT), "Shift must be between 0 and 4!");
+    PY_ASSERT_TRUE_MSG(((w >> shift) > 0) && ((h >> shift) > 0), "Width and height must be >= 1 << shift!");
+    PY_ASSERT_TRUE_MSG((args[ARG_rate].u_int > 0) && (args[ARG_rate].u_int <= 256), "Rate must be between 1 and 256!");
+    PY_ASSERT_TRUE_MSG(args[ARG_threshold].u_int >= 0, "Threshold must be >= 0!");
+
+    py_motion_obj_t *o = mp_obj_malloc(py_motion_obj_t, type);
+    size_t size = imlib_motion_init(&o->motion, w, h, pixfmt, shift, args[ARG_rate].u_int, args[ARG_threshold].u_int);
+    imlib_motion_set_buffer(&o->motion, m_new(uint8_t, size));
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static mp_obj_t py_motion_capture(mp_obj_t self_in, mp_obj_t enable_obj) {
+    #if MICROPY_PY_SENSOR
+    py_motion_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    if (mp_obj_is_true(enable_obj)) {
+        // Keep the detector alive while the capture IRQ references it.
+        MP_STATE_PORT(motion_capture) = self;
+        if (sensor_set_line_callback(imlib_motion_line_cb, 1 << self->motion.shift, &self->motion) != 0) {
+            MP_STATE_PORT(motion_capture) = NULL;
+            mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Line callbacks are not supported!"));
+        }
+    } else if (MP_STATE_PORT(motion_capture) == self) {
+        sensor_set_line_callback(NULL, 0, NULL);
+        MP_STATE_PORT(motion_capture) = NULL;
     }
-    bool invert = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_invert), false);
+    #else
+    mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Line callbacks are not supported!"));
+    #endif
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(py_motion_capture_obj, py_motion_capture);
 
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 3, kw_args, &roi);
+static mp_obj_t py_motion_update(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    py_motion_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    imlib_motion_t *motion = &self->motion;
 
-    unsigned int x_stride =
-        py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_stride), 2);
-    PY_ASSERT_TRUE_MSG(x_stride > 0, "x_stride must not be zero.");
-    unsigned int y_stride =
-        py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_stride), 1);
-    PY_ASSERT_TRUE_MSG(y_stride > 0, "y_stride must not be zero.");
     unsigned int area_threshold =
-        py_helper_keyword_int(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_area_threshold), 10);
+        py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_area_threshold), 1);
     unsigned int pixels_threshold =
-        py_helper_keyword_int(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_pixels_threshold), 10);
+        py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_pixels_threshold), 1);
     bool merge =
-        py_helper_keyword_int(n_args, args, 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_merge), false);
+        py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_merge), true);
     int margin =
-        py_helper_keyword_int(n_args, args, 9, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_margin), 0);
-    mp_obj_t threshold_cb =
-        py_helper_keyword_object(n_args, args, 10, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold_cb), NULL);
-    mp_obj_t merge_cb =
-        py_helper_keyword_object(n_args, args, 11, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_merge_cb), NULL);
-    unsigned int x_hist_bins_max =
-        py_helper_keyword_int(n_args, args, 12, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_hist_bins_max), 0);
-    unsigned int y_hist_bins_max =
-        py_helper_keyword_int(n_args, args, 13, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_hist_bins_max), 0);
+        py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_margin), 1);
+
+    // Without an image the mask comes from the capture line callback.
+    if ((n_args > 1) && (args[1] != mp_const_none)) {
+        image_t *img = py_helper_arg_to_image(args[1], ARG_IMAGE_ANY);
+        PY_ASSERT_TRUE_MSG((img->w == motion->w) && (img->h == motion->h) && (img->pixfmt == motion->pixfmt),
+                           "The image doesn't match the motion detector!");
+        imlib_motion_update(motion, img);
+    }
+
+    if (!motion->ready) {
+        return mp_obj_new_list(0, NULL);
+    }
+
+    motion->ready = false;
 
     list_t out;
     fb_alloc_mark();
-    imlib_find_blobs(&out,
-                     arg_img,
-                     &roi,
-                     x_stride,
-                     y_stride,
-                     &thresholds,
-                     invert,
-                     area_threshold,
-                     pixels_threshold,
-                     merge,
-                     margin,
-                     py_image_find_blobs_threshold_cb,
-                     threshold_cb,
-                     py_image_find_blobs_merge_cb,
-                     merge_cb,
-                     x_hist_bins_max,
-                     y_hist_bins_max);
+    imlib_motion_find_blobs(motion, &out, area_threshold, pixels_threshold, merge, margin);
     fb_alloc_free_till_mark();
-    list_free(&thresholds);
 
     mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
     for (size_t i = 0; list_size(&out); i++) {
         find_blobs_list_lnk_data_t lnk_data;
         list_pop_front(&out, &lnk_data);
         objects_list->items[i] = py_blob_new(&lnk_data);
-        if (lnk_data.x_hist_bins) {
-            xfree(lnk_data.x_hist_bins);
-        }
-        if (lnk_data.y_hist_bins) {
-            xfree(lnk_data.y_hist_bins);
-        }
     }
 
     return objects_list;
 }
-static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_blobs_obj, 2, py_image_find_blobs);
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_motion_update_obj, 1, py_motion_update);
 
-#ifdef IMLIB_ENABLE_FIND_LINES
-static mp_obj_t py_image_find_lines(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+static mp_obj_t py_motion_mask(mp_obj_t self_in) {
+    py_motion_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return py_image_from_struct(&self->motion.mask);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_motion_mask_obj, py_motion_mask);
 
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+static mp_obj_t py_motion_reset(mp_obj_t self_in) {
+    py_motion_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    imlib_motion_reset(&self->motion);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_motion_reset_obj, py_motion_reset);
 
-    unsigned int x_stride = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_stride), 2);
-    PY_ASSERT_TRUE_MSG(x_stride > 0, "x_stride must not be zero.");
-    unsigned int y_stride = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_stride), 1);
-    PY_ASSERT_TRUE_MSG(y_stride > 0, "y_stride must not be zero.");
-    uint32_t threshold = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 1000);
-    unsigned int theta_margin = py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_theta_margin), 25);
-    unsigned int rho_margin = py_helper_keyword_int(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_rho_margin), 25);
+static const mp_rom_map_elem_t py_motion_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&py_motion_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_mask), MP_ROM_PTR(&py_motion_mask_obj) },
+    { MP_ROM_QSTR(MP_QSTR_capture), MP_ROM_PTR(&py_motion_capture_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&py_motion_reset_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_motion_locals_dict, py_motion_locals_dict_table);
 
-    list_t out;
-    fb_alloc_mark();
-    imlib_find_lines(&out, arg_img, &roi, x_stride, y_stride, threshold, theta_margin, rho_margin);
-    fb_alloc_free_till_mark();
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_motion_type,
+    MP_QSTR_MotionDetector,
+    MP_TYPE_FLAG_NONE,
+    print, py_motion_print,
+    make_new, py_motion_make_new,
+    locals_dict, &py_motion_locals_dict
+    );
+
+// Pre-parsed find_blobs() arguments, shared by find_blobs() and the BlobFinder object.
+typedef struct py_find_blobs_args {
+    bool invert;
+    unsigned int x_stride;
+    unsigned int y_stride;
+    unsigned int area_threshold;
+    unsigned int pixels_threshold;
+    bool merge;
+    int margin;
+    mp_obj_t threshold_cb;
+    mp_obj_t merge_cb;
+    unsigned int x_hist_bins_max;
+    unsigned int y_hist_bins_max;
+    mp_obj_t tracker;
+} py_find_blobs_args_t;
+
+static mp_obj_t py_image_find_blobs_run(image_t *arg_img, rectangle_t *roi, list_t *thresholds,
+                                        py_find_blobs_args_t *blobs_args) {
+    bool invert = blobs_args->invert;
+    find_blobs_tracker_t *tracker = NULL;
+    if (blobs_args->tracker) {
+        tracker = &((py_blob_tracker_obj_t *) MP_OBJ_TO_PTR(blobs_args->tracker))->tracker;
+    }
+
+    list_t out, bmp_thresholds;
+    fb_alloc_mark();
+
+    // 16-bit images are thresholded to a bitmap first, all thresholds share the first code.
+    image_t bmp_img = {};
+    if (arg_img->pixfmt == PIXFORMAT_GRAYSCALE16) {
+        bmp_img.w = arg_img->w;
+        bmp_img.h = arg_img->h;
+        bmp_img.pixfmt = PIXFORMAT_BINARY;
+        bmp_img.data = fb_alloc(image_size(&bmp_img), FB_ALLOC_NO_HINT);
+        imlib_gray16_binary(&bmp_img, arg_img, thresholds, invert, false, NULL);
+
+        color_thresholds_list_lnk_data_t lnk_data = {
+            .LMin = COLOR_BINARY_MAX, .LMax = COLOR_BINARY_MAX,
+            .AMin = COLOR_A_MIN, .AMax = COLOR_A_MAX,
+            .BMin = COLOR_B_MIN, .BMax = COLOR_B_MAX,
+        };
+        list_init(&bmp_thresholds, sizeof(color_thresholds_list_lnk_data_t));
+        list_push_back(&bmp_thresholds, &lnk_data);
+        thresholds = &bmp_thresholds;
+        arg_img = &bmp_img;
+        invert = false;
+    }
+
+    if (tracker) {
+        imlib_track_blobs(tracker,
+                          &out,
+                          arg_img,
+                          roi,
+                          blobs_args->x_stride,
+                          blobs_args->y_stride,
+                          thresholds,
+                          invert,
+                          blobs_args->area_threshold,
+                          blobs_args->pixels_threshold,
+                          blobs_args->merge,
+                          blobs_args->margin,
+                          py_image_find_blobs_threshold_cb,
+                          blobs_args->threshold_cb,
+                          py_image_find_blobs_merge_cb,
+                          blobs_args->merge_cb,
+                          blobs_args->x_hist_bins_max,
+                          blobs_args->y_hist_bins_max);
+    } else {
+        imlib_find_blobs(&out,
+                         arg_img,
+                         roi,
+                         blobs_args->x_stride,
+                         blobs_args->y_stride,
+                         thresholds,
+                         invert,
+                         blobs_args->area_threshold,
+                         blobs_args->pixels_threshold,
+                         blobs_args->merge,
+                         blobs_args->margin,
+                         py_image_find_blobs_threshold_cb,
+                         blobs_args->threshold_cb,
+                         py_image_find_blobs_merge_cb,
+                         blobs_args->merge_cb,
+                         blobs_args->x_hist_bins_max,
+                         blobs_args->y_hist_bins_max);
+    }
+    fb_alloc_free_till_mark();
+
+    if (thresholds == &bmp_thresholds) {
+        list_free(&bmp_thresholds);
+    }
+
+    // The tracker keeps its tracks in the same order as the output list.
+    list_lnk_t *track_it = tracker ? tracker->tracks.head : NULL;
+
+    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
+    for (size_t i = 0; list_size(&out); i++) {
+        find_blobs_list_lnk_data_t lnk_data;
+        list_pop_front(&out, &lnk_data);
+        py_blob_obj_t *blob = py_blob_new(&lnk_data);
+        if (track_it) {
+            blob->id = mp_obj_new_int(((find_blobs_track_t *) list_get_data(track_it))->id);
+            track_it = track_it->next;
+        }
+        objects_list->items[i] = blob;
+        if (lnk_data.x_hist_bins) {
+            xfree(lnk_data.x_hist_bins);
+        }
+        if (lnk_data.y_hist_bins) {
+            xfree(lnk_data.y_hist_bins);
+        }
+    }
+
+    return objects_list;
+}
+
+static mp_obj_t py_image_find_blobs(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE | ARG_IMAGE_GRAYSCALE16 | ARG_IMAGE_YUV);
+    bool gray16 = arg_img->pixfmt == PIXFORMAT_GRAYSCALE16;
+
+    list_t thresholds;
+    list_init(&thresholds, gray16 ? sizeof(gray16_thresholds_list_lnk_data_t) :
+              sizeof(color_thresholds_list_lnk_data_t));
+    if (gray16) {
+        py_helper_arg_to_gray16_thresholds(args[1], &thresholds);
+    } else {
+        py_helper_arg_to_thresholds(args[1], &thresholds);
+    }
+    if (!list_size(&thresholds)) {
+        return mp_obj_new_list(0, NULL);
+    }
+
+    py_find_blobs_args_t blobs_args;
+    blobs_args.invert =
+        py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_invert), false);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 3, kw_args, &roi);
+
+    blobs_args.x_stride =
+        py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_stride), 2);
+    PY_ASSERT_TRUE_MSG(blobs_args.x_stride > 0, "x_stride must not be zero.");
+    blobs_args.y_stride =
+        py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_stride), 1);
+    PY_ASSERT_TRUE_MSG(blobs_args.y_stride > 0, "y_stride must not be zero.");
+    blobs_args.area_threshold =
+        py_helper_keyword_int(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_area_threshold), 10);
+    blobs_args.pixels_threshold =
+        py_helper_keyword_int(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_pixels_threshold), 10);
+    blobs_args.merge =
+        py_helper_keyword_int(n_args, args, 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_merge), false);
+    blobs_args.margin =
+        py_helper_keyword_int(n_args, args, 9, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_margin), 0);
+    blobs_args.threshold_cb =
+        py_helper_keyword_object(n_args, args, 10, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold_cb), NULL);
+    blobs_args.merge_cb =
+        py_helper_keyword_object(n_args, args, 11, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_merge_cb), NULL);
+    blobs_args.x_hist_bins_max =
+        py_helper_keyword_int(n_args, args, 12, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_hist_bins_max), 0);
+    blobs_args.y_hist_bins_max =
+        py_helper_keyword_int(n_args, args, 13, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_hist_bins_max), 0);
+    blobs_args.tracker =
+        py_helper_keyword_object(n_args, args, 14, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_tracker), NULL);
+
+    if (blobs_args.tracker == mp_const_none) {
+        blobs_args.tracker = NULL;
+    } else if (blobs_args.tracker) {
+        PY_ASSERT_TYPE(blobs_args.tracker, &py_blob_tracker_type);
+    }
+
+    mp_obj_t objects_list = py_image_find_blobs_run(arg_img, &roi, &thresholds, &blobs_args);
+    list_free(&thresholds);
+    return objects_list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_blobs_obj, 2, py_image_find_blobs);
+
+// Blob Finder Object //
+// Holds the parsed find_blobs() arguments so they are not parsed again for every frame.
+typedef struct py_blob_finder_obj {
+    mp_obj_base_t base;
+    list_t thresholds;
+    list_t gray16_thresholds;
+    py_find_blobs_args_t blobs_args;
+} py_blob_finder_obj_t;
+
+static void py_blob_finder_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_blob_finder_obj_t *self = self_in;
+    mp_printf(print, "{\"thresholds\":%d, \"x_stride\":%d, \"y_stride\":%d, \"merge\":%d}",
+              list_size(&self->thresholds),
+              self->blobs_args.x_stride,
+              self->blobs_args.y_stride,
+              self->blobs_args.merge);
+}
+
+static mp_obj_t py_blob_finder_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum {
+        ARG_thresholds, ARG_invert, ARG_x_stride, ARG_y_stride, ARG_area_threshold, ARG_pixels_threshold,
+        ARG_merge, ARG_margin, ARG_threshold_cb, ARG_merge_cb, ARG_x_hist_bins_max, ARG_y_hist_bins_max, ARG_tracker
+    };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_thresholds, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_invert, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false } },
+        { MP_QSTR_x_stride, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 2 } },
+        { MP_QSTR_y_stride, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1 } },
+        { MP_QSTR_area_threshold, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 10 } },
+        { MP_QSTR_pixels_threshold, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 10 } },
+        { MP_QSTR_merge, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false } },
+        { MP_QSTR_margin, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0 } },
+        { MP_QSTR_threshold_cb, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_merge_cb, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_x_hist_bins_max, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0 } },
+        { MP_QSTR_y_hist_bins_max, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0 } },
+        { MP_QSTR_tracker, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    PY_ASSERT_TRUE_MSG(args[ARG_x_stride].u_int > 0, "x_stride must not be zero.");
+    PY_ASSERT_TRUE_MSG(args[ARG_y_stride].u_int > 0, "y_stride must not be zero.");
+
+    if (args[ARG_tracker].u_obj != mp_const_none) {
+        PY_ASSERT_TYPE(args[ARG_tracker].u_obj, &py_blob_tracker_type);
+    }
+
+    py_blob_finder_obj_t *o = mp_obj_malloc(py_blob_finder_obj_t, type);
+
+    // Both threshold formats are parsed up front, the one used depends on the image.
+    list_init(&o->thresholds, sizeof(color_thresholds_list_lnk_data_t));
+    py_helper_arg_to_thresholds(args[ARG_thresholds].u_obj, &o->thresholds);
+    list_init(&o->gray16_thresholds, sizeof(gray16_thresholds_list_lnk_data_t));
+    py_helper_arg_to_gray16_thresholds(args[ARG_thresholds].u_obj, &o->gray16_thresholds);
+
+    o->blobs_args.invert = args[ARG_invert].u_bool;
+    o->blobs_args.x_stride = args[ARG_x_stride].u_int;
+    o->blobs_args.y_stride = args[ARG_y_stride].u_int;
+    o->blobs_args.area_threshold = args[ARG_area_threshold].u_int;
+    o->blobs_args.pixels_threshold = args[ARG_pixels_threshold].u_int;
+    o->blobs_args.merge = args[ARG_merge].u_bool;
+    o->blobs_args.margin = args[ARG_margin].u_int;
+    o->blobs_args.threshold_cb = (args[ARG_threshold_cb].u_obj != mp_const_none) ? args[ARG_threshold_cb].u_obj : NULL;
+    o->blobs_args.merge_cb = (args[ARG_merge_cb].u_obj != mp_const_none) ? args[ARG_merge_cb].u_obj : NULL;
+    o->blobs_args.x_hist_bins_max = args[ARG_x_hist_bins_max].u_int;
+    o->blobs_args.y_hist_bins_max = args[ARG_y_hist_bins_max].u_int;
+    o->blobs_args.tracker = (args[ARG_tracker].u_obj != mp_const_none) ? args[ARG_tracker].u_obj : NULL;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static mp_obj_t py_blob_finder_find(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    py_blob_finder_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    image_t *arg_img = py_helper_arg_to_image(args[1], ARG_IMAGE_MUTABLE | ARG_IMAGE_GRAYSCALE16 | ARG_IMAGE_YUV);
+    list_t *thresholds = (arg_img->pixfmt == PIXFORMAT_GRAYSCALE16) ? &self->gray16_thresholds : &self->thresholds;
+
+    if (!list_size(thresholds)) {
+        return mp_obj_new_list(0, NULL);
+    }
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 2, kw_args, &roi);
+
+    return py_image_find_blobs_run(arg_img, &roi, thresholds, &self->blobs_args);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_blob_finder_find_obj, 2, py_blob_finder_find);
+
+static const mp_rom_map_elem_t py_blob_finder_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_find), MP_ROM_PTR(&py_blob_finder_find_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_blob_finder_locals_dict, py_blob_finder_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_blob_finder_type,
+    MP_QSTR_BlobFinder,
+    MP_TYPE_FLAG_NONE,
+    print, py_blob_finder_print,
+    make_new, py_blob_finder_make_new,
+    locals_dict, &py_blob_finder_locals_dict
+    );
+
+// Gradients Object //
+typedef struct py_gradients_obj {
+    mp_obj_base_t base;
+    int img_w, img_h;
+    gradients_t gradients;
+} py_gradients_obj_t;
+
+static void py_gradients_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_gradients_obj_t *self = self_in;
+    mp_printf(print, "{\"x\":%d, \"y\":%d, \"w\":%d, \"h\":%d}",
+              self->gradients.roi.x, self->gradients.roi.y, self->gradients.roi.w, self->gradients.roi.h);
+}
+
+static mp_obj_t py_gradients_rect(mp_obj_t self_in) {
+    py_gradients_obj_t *self = self_in;
+    return mp_obj_new_tuple(4, (mp_obj_t []) {mp_obj_new_int(self->gradients.roi.x),
+                                              mp_obj_new_int(self->gradients.roi.y),
+                                              mp_obj_new_int(self->gradients.roi.w),
+                                              mp_obj_new_int(self->gradients.roi.h)});
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_gradients_rect_obj, py_gradients_rect);
+
+static const mp_rom_map_elem_t py_gradients_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_rect), MP_ROM_PTR(&py_gradients_rect_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_gradients_locals_dict, py_gradients_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_gradients_type,
+    MP_QSTR_Gradients,
+    MP_TYPE_FLAG_NONE,
+    print, py_gradients_print,
+    locals_dict, &py_gradients_locals_dict
+    );
+
+static mp_obj_t py_image_gradients(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+
+    py_gradients_obj_t *o = mp_obj_malloc(py_gradients_obj_t, &py_gradients_type);
+    o->img_w = arg_img->w;
+    o->img_h = arg_img->h;
+    o->gradients.roi = roi;
+    // The gradients outlive a single call so they can't live on the frame buffer stack.
+    o->gradients.data = m_new(gradient_t, roi.w * roi.h);
+
+    fb_alloc_mark();
+    imlib_find_gradients(arg_img, &roi, o->gradients.data);
+    fb_alloc_free_till_mark();
+    return MP_OBJ_FROM_PTR(o);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_gradients_obj, 1, py_image_gradients);
+
+// Returns the gradients passed with the "gradients" keyword, which must cover the ROI, or NULL.
+static gradients_t *py_helper_keyword_gradients(image_t *img, uint n_args, const mp_obj_t *args, uint arg_index,
+                                                mp_map_t *kw_args, rectangle_t *roi) {
+    mp_obj_t gradients_obj =
+        py_helper_keyword_object(n_args, args, arg_index, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_gradients), NULL);
+
+    if (!gradients_obj) {
+        return NULL;
+    }
+
+    PY_ASSERT_TYPE(gradients_obj, &py_gradients_type);
+    py_gradients_obj_t *o = MP_OBJ_TO_PTR(gradients_obj);
+    rectangle_t *r = &o->gradients.roi;
+    PY_ASSERT_TRUE_MSG((o->img_w == img->w) && (o->img_h == img->h),
+                       "The gradients don't match the image size!");
+    PY_ASSERT_TRUE_MSG((roi->x >= r->x) && (roi->y >= r->y) &&
+                       ((roi->x + roi->w) <= (r->x + r->w)) && ((roi->y + roi->h) <= (r->y + r->h)),
+                       "The gradients don't cover the ROI!");
+    return &o->gradients;
+}
+
+#ifdef IMLIB_ENABLE_FIND_LINES
+static mp_obj_t py_image_find_lines(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+
+    unsigned int x_stride = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_stride), 2);
+    PY_ASSERT_TRUE_MSG(x_stride > 0, "x_stride must not be zero.");
+    unsigned int y_stride = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_stride), 1);
+    PY_ASSERT_TRUE_MSG(y_stride > 0, "y_stride must not be zero.");
+    uint32_t threshold = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 1000);
+    unsigned int theta_margin = py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_theta_margin), 25);
+    unsigned int rho_margin = py_helper_keyword_int(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_rho_margin), 25);
+    gradients_t *gradients = py_helper_keyword_gradients(arg_img, n_args, args, 7, kw_args, &roi);
+
+    list_t out;
+    fb_alloc_mark();
+    imlib_find_lines(&out, arg_img, &roi, x_stride, y_stride, threshold, theta_margin, rho_margin, gradients);
+    fb_alloc_free_till_mark();
 
     mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
     for (size_t i = 0; list_size(&out); i++) {
@@ -4662,11 +6018,13 @@ static mp_obj_t py_image_find_circles(uint n_args, const mp_obj_t *args, mp_map_
     unsigned int r_max = IM_MIN(py_helper_keyword_int(n_args, args, 9, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_r_max),
                                                       IM_MIN((roi.w / 2), (roi.h / 2))), IM_MIN((roi.w / 2), (roi.h / 2)));
     unsigned int r_step = py_helper_keyword_int(n_args, args, 10, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_r_step), 2);
+    PY_ASSERT_TRUE_MSG(r_step > 0, "r_step must not be zero.");
+    gradients_t *gradients = py_helper_keyword_gradients(arg_img, n_args, args, 11, kw_args, &roi);
 
     list_t out;
     fb_alloc_mark();
     imlib_find_circles(&out, arg_img, &roi, x_stride, y_stride, threshold, x_margin, y_margin, r_margin,
-                       r_min, r_max, r_step);
+                       r_min, r_max, r_step, gradients);
     fb_alloc_free_till_mark();
 
     mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
@@ -4798,11 +6156,19 @@ static mp_obj_t py_image_find_rects(uint n_args, const mp_obj_t *args, mp_map_t
     rectangle_t roi;
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
 
-    uint32_t threshold = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 1000);
+    // Binary images are searched by following the borders of the set pixels, the threshold is
+    // then the minimum perimeter in pixels instead of the minimum edge magnitude.
+    bool binary = arg_img->pixfmt == PIXFORMAT_BINARY;
+    uint32_t threshold = py_helper_keyword_int(n_args, args, 2, kw_args,
+                                               MP_OBJ_NEW_QSTR(MP_QSTR_threshold), binary ? 40 : 1000);
 
     list_t out;
     fb_alloc_mark();
-    imlib_find_rects(&out, arg_img, &roi, threshold);
+    if (binary) {
+        imlib_find_binary_rects(&out, arg_img, &roi, threshold);
+    } else {
+        imlib_find_rects(&out, arg_img, &roi, threshold);
+    }
     fb_alloc_free_till_mark();
 
     mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
@@ -4839,6 +6205,21 @@ static mp_obj_t py_image_find_rects(uint n_args, const mp_obj_t *args, mp_map_t
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_rects_obj, 1, py_image_find_rects);
 #endif // IMLIB_ENABLE_FIND_RECTS
 
+// Set when the last 1/2D bar code detector call ran out of its timeout_us budget.
+static bool py_image_timed_out_flag;
+
+static mp_obj_t py_image_timed_out() {
+    return mp_obj_new_bool(py_image_timed_out_flag);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_image_timed_out_obj, py_image_timed_out);
+
+static void py_image_deadline_init(imlib_deadline_t *deadline, uint n_args, const mp_obj_t *args,
+                                   uint arg_index, mp_map_t *kw_args) {
+    int timeout_us = py_helper_keyword_int(n_args, args, arg_index, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_timeout_us), 0);
+    PY_ASSERT_TRUE_MSG(timeout_us >= 0, "timeout_us must be >= 0!");
+    imlib_deadline_init(deadline, timeout_us);
+}
+
 #ifdef IMLIB_ENABLE_QRCODES
 // QRCode Object //
 #define py_qrcode_obj_size    10
@@ -5007,21 +6388,11 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     locals_dict, &py_qrcode_locals_dict
     );
 
-static mp_obj_t py_image_find_qrcodes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    image_t *arg_img = py_image_cobj(args[0]);
-
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
-
-    list_t out;
-    fb_alloc_mark();
-    imlib_find_qrcodes(&out, arg_img, &roi);
-    fb_alloc_free_till_mark();
-
-    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
-    for (size_t i = 0; list_size(&out); i++) {
+static mp_obj_t py_qrcodes_list_new(list_t *out) {
+    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(out), NULL);
+    for (size_t i = 0; list_size(out); i++) {
         find_qrcodes_list_lnk_data_t lnk_data;
-        list_pop_front(&out, &lnk_data);
+        list_pop_front(out, &lnk_data);
 
         py_qrcode_obj_t *o = m_new_obj(py_qrcode_obj_t);
         o->base.type = &py_qrcode_type;
@@ -5055,6 +6426,27 @@ static mp_obj_t py_image_find_qrcodes(uint n_args, const mp_obj_t *args, mp_map_
 
     return objects_list;
 }
+
+static mp_obj_t py_image_find_qrcodes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_image_cobj(args[0]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+
+    int decimate = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_decimate), 1);
+    PY_ASSERT_TRUE_MSG((1 <= decimate) && (decimate <= 4), "decimate must be between 1 and 4!");
+
+    imlib_deadline_t deadline;
+    py_image_deadline_init(&deadline, n_args, args, 3, kw_args);
+
+    list_t out;
+    fb_alloc_mark();
+    imlib_find_qrcodes(&out, arg_img, &roi, decimate, &deadline);
+    fb_alloc_free_till_mark();
+    py_image_timed_out_flag = deadline.expired;
+
+    return py_qrcodes_list_new(&out);
+}
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_qrcodes_obj, 1, py_image_find_qrcodes);
 #endif // IMLIB_ENABLE_QRCODES
 
@@ -5282,37 +6674,66 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     locals_dict, &py_apriltag_locals_dict
     );
 
-static mp_obj_t py_image_find_apriltags(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    image_t *arg_img = py_image_cobj(args[0]);
+// AprilTag Tracker Object //
+typedef struct py_apriltag_tracker_obj {
+    mp_obj_base_t base;
+    find_apriltags_tracker_t tracker;
+} py_apriltag_tracker_obj_t;
 
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
-#ifndef IMLIB_ENABLE_HIGH_RES_APRILTAGS
-    PY_ASSERT_TRUE_MSG((roi.w * roi.h) < 65536, "The maximum supported resolution for find_apriltags() is < 64K pixels.");
-#endif
-    if ((roi.w < 4) || (roi.h < 4)) {
-        return mp_obj_new_list(0, NULL);
-    }
+static void py_apriltag_tracker_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_apriltag_tracker_obj_t *self = self_in;
+    mp_printf(print, "{\"tags\":%d, \"full_scan_interval\":%d, \"search_margin\":%d}",
+              list_size(&self->tracker.tracks),
+              self->tracker.full_scan_interval,
+              self->tracker.search_margin);
+}
 
-    apriltag_families_t families = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_families), TAG36H11);
-    // 2.8mm Focal Length w/ OV7725 sensor for reference.
-    float fx = py_helper_keyword_float(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fx), (2.8 / 3.984) * arg_img->w);
-    // 2.8mm Focal Length w/ OV7725 sensor for reference.
-    float fy = py_helper_keyword_float(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fy), (2.8 / 2.952) * arg_img->h);
-    // Use the image versus the roi here since the image should be projected from the camera center.
-    float cx = py_helper_keyword_float(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cx), arg_img->w * 0.5);
-    // Use the image versus the roi here since the image should be projected from the camera center.
-    float cy = py_helper_keyword_float(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cy), arg_img->h * 0.5);
+static mp_obj_t py_apriltag_tracker_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_full_scan_interval, ARG_search_margin };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_full_scan_interval, MP_ARG_INT, {.u_int = 10 } },
+        { MP_QSTR_search_margin, MP_ARG_INT, {.u_int = 16 } },
+    };
 
-    list_t out;
-    fb_alloc_mark();
-    imlib_find_apriltags(&out, arg_img, &roi, families, fx, fy, cx, cy);
-    fb_alloc_free_till_mark();
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    PY_ASSERT_TRUE_MSG(args[ARG_search_margin].u_int >= 0, "search_margin must be >= 0.");
 
-    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
-    for (size_t i = 0; list_size(&out); i++) {
+    py_apriltag_tracker_obj_t *o = mp_obj_malloc(py_apriltag_tracker_obj_t, type);
+    list_init(&o->tracker.tracks, sizeof(find_apriltags_track_t));
+    o->tracker.frames = 0;
+    o->tracker.full_scan_interval = IM_MAX(args[ARG_full_scan_interval].u_int, 0);
+    o->tracker.search_margin = args[ARG_search_margin].u_int;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static mp_obj_t py_apriltag_tracker_reset(mp_obj_t self_in) {
+    py_apriltag_tracker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    list_clear(&self->tracker.tracks);
+    self->tracker.frames = 0;
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_apriltag_tracker_reset_obj, py_apriltag_tracker_reset);
+
+static const mp_rom_map_elem_t py_apriltag_tracker_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&py_apriltag_tracker_reset_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_apriltag_tracker_locals_dict, py_apriltag_tracker_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_apriltag_tracker_type,
+    MP_QSTR_AprilTagTracker,
+    MP_TYPE_FLAG_NONE,
+    print, py_apriltag_tracker_print,
+    make_new, py_apriltag_tracker_make_new,
+    locals_dict, &py_apriltag_tracker_locals_dict
+    );
+
+static mp_obj_t py_apriltags_list_new(list_t *out) {
+    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(out), NULL);
+    for (size_t i = 0; list_size(out); i++) {
         find_apriltags_list_lnk_data_t lnk_data;
-        list_pop_front(&out, &lnk_data);
+        list_pop_front(out, &lnk_data);
 
         py_apriltag_obj_t *o = m_new_obj(py_apriltag_obj_t);
         o->base.type = &py_apriltag_type;
@@ -5353,7 +6774,153 @@ static mp_obj_t py_image_find_apriltags(uint n_args, const mp_obj_t *args, mp_ma
 
     return objects_list;
 }
+
+static mp_obj_t py_image_find_apriltags_run(image_t *arg_img, rectangle_t *roi, apriltag_families_t families,
+                                            float fx, float fy, float cx, float cy, int decimate,
+                                            mp_obj_t tracker_obj, imlib_deadline_t *deadline) {
+#ifndef IMLIB_ENABLE_HIGH_RES_APRILTAGS
+    PY_ASSERT_TRUE_MSG(((roi->w / decimate) * (roi->h / decimate)) < 65536,
+                       "The maximum supported resolution for find_apriltags() is < 64K pixels after decimation.");
+#endif
+    if ((roi->w < (4 * decimate)) || (roi->h < (4 * decimate))) {
+        return mp_obj_new_list(0, NULL);
+    }
+
+    find_apriltags_tracker_t *tracker = NULL;
+    if (tracker_obj) {
+        tracker = &((py_apriltag_tracker_obj_t *) MP_OBJ_TO_PTR(tracker_obj))->tracker;
+    }
+
+    list_t out;
+    fb_alloc_mark();
+    if (tracker) {
+        imlib_track_apriltags(tracker, &out, arg_img, roi, families, fx, fy, cx, cy, decimate, deadline);
+    } else {
+        imlib_find_apriltags(&out, arg_img, roi, families, fx, fy, cx, cy, decimate, deadline);
+    }
+    fb_alloc_free_till_mark();
+    py_image_timed_out_flag = deadline->expired;
+
+    return py_apriltags_list_new(&out);
+}
+
+static mp_obj_t py_image_find_apriltags(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_image_cobj(args[0]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+
+    int decimate = py_helper_keyword_int(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_decimate), 1);
+    PY_ASSERT_TRUE_MSG((1 <= decimate) && (decimate <= 4), "decimate must be between 1 and 4!");
+
+    apriltag_families_t families = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_families), TAG36H11);
+    // 2.8mm Focal Length w/ OV7725 sensor for reference.
+    float fx = py_helper_keyword_float(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fx), (2.8 / 3.984) * arg_img->w);
+    // 2.8mm Focal Length w/ OV7725 sensor for reference.
+    float fy = py_helper_keyword_float(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fy), (2.8 / 2.952) * arg_img->h);
+    // Use the image versus the roi here since the image should be projected from the camera center.
+    float cx = py_helper_keyword_float(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cx), arg_img->w * 0.5);
+    // Use the image versus the roi here since the image should be projected from the camera center.
+    float cy = py_helper_keyword_float(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cy), arg_img->h * 0.5);
+
+    mp_obj_t tracker_obj =
+        py_helper_keyword_object(n_args, args, 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_tracker), NULL);
+
+    if (tracker_obj == mp_const_none) {
+        tracker_obj = NULL;
+    } else if (tracker_obj) {
+        PY_ASSERT_TYPE(tracker_obj, &py_apriltag_tracker_type);
+    }
+
+    imlib_deadline_t deadline;
+    py_image_deadline_init(&deadline, n_args, args, 9, kw_args);
+
+    return py_image_find_apriltags_run(arg_img, &roi, families, fx, fy, cx, cy, decimate, tracker_obj, &deadline);
+}
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_apriltags_obj, 1, py_image_find_apriltags);
+
+// AprilTag Detector Object //
+// Holds the parsed find_apriltags() arguments so they are not parsed again for every frame.
+typedef struct py_apriltag_detector_obj {
+    mp_obj_base_t base;
+    apriltag_families_t families;
+    int decimate;
+    // None picks the default for the image size.
+    mp_obj_t fx, fy, cx, cy;
+    mp_obj_t tracker;
+} py_apriltag_detector_obj_t;
+
+static void py_apriltag_detector_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_apriltag_detector_obj_t *self = self_in;
+    mp_printf(print, "{\"families\":%d, \"decimate\":%d}", self->families, self->decimate);
+}
+
+static mp_obj_t py_apriltag_detector_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_families, ARG_fx, ARG_fy, ARG_cx, ARG_cy, ARG_decimate, ARG_tracker };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_families, MP_ARG_INT, {.u_int = TAG36H11 } },
+        { MP_QSTR_fx, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_fy, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_cx, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_cy, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_decimate, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1 } },
+        { MP_QSTR_tracker, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+    PY_ASSERT_TRUE_MSG((1 <= args[ARG_decimate].u_int) && (args[ARG_decimate].u_int <= 4),
+                       "decimate must be between 1 and 4!");
+
+    if (args[ARG_tracker].u_obj != mp_const_none) {
+        PY_ASSERT_TYPE(args[ARG_tracker].u_obj, &py_apriltag_tracker_type);
+    }
+
+    py_apriltag_detector_obj_t *o = mp_obj_malloc(py_apriltag_detector_obj_t, type);
+    o->families = args[ARG_families].u_int;
+    o->decimate = args[ARG_decimate].u_int;
+    o->fx = args[ARG_fx].u_obj;
+    o->fy = args[ARG_fy].u_obj;
+    o->cx = args[ARG_cx].u_obj;
+    o->cy = args[ARG_cy].u_obj;
+    o->tracker = (args[ARG_tracker].u_obj != mp_const_none) ? args[ARG_tracker].u_obj : NULL;
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static mp_obj_t py_apriltag_detector_detect(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    py_apriltag_detector_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    image_t *arg_img = py_image_cobj(args[1]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 2, kw_args, &roi);
+
+    imlib_deadline_t deadline;
+    py_image_deadline_init(&deadline, n_args, args, 3, kw_args);
+
+    // Same defaults as find_apriltags(), they depend on the image size.
+    float fx = (self->fx != mp_const_none) ? mp_obj_get_float(self->fx) : ((2.8 / 3.984) * arg_img->w);
+    float fy = (self->fy != mp_const_none) ? mp_obj_get_float(self->fy) : ((2.8 / 2.952) * arg_img->h);
+    float cx = (self->cx != mp_const_none) ? mp_obj_get_float(self->cx) : (arg_img->w * 0.5);
+    float cy = (self->cy != mp_const_none) ? mp_obj_get_float(self->cy) : (arg_img->h * 0.5);
+
+    return py_image_find_apriltags_run(arg_img, &roi, self->families, fx, fy, cx, cy,
+                                       self->decimate, self->tracker, &deadline);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_apriltag_detector_detect_obj, 2, py_apriltag_detector_detect);
+
+static const mp_rom_map_elem_t py_apriltag_detector_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_detect), MP_ROM_PTR(&py_apriltag_detector_detect_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_apriltag_detector_locals_dict, py_apriltag_detector_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_apriltag_detector_type,
+    MP_QSTR_AprilTagDetector,
+    MP_TYPE_FLAG_NONE,
+    print, py_apriltag_detector_print,
+    make_new, py_apriltag_detector_make_new,
+    locals_dict, &py_apriltag_detector_locals_dict
+    );
 #endif // IMLIB_ENABLE_APRILTAGS
 
 #ifdef IMLIB_ENABLE_DATAMATRICES
@@ -5500,23 +7067,11 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     locals_dict, &py_datamatrix_locals_dict
     );
 
-static mp_obj_t py_image_find_datamatrices(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    image_t *arg_img = py_image_cobj(args[0]);
-
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
-
-    int effort = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_effort), 200);
-
-    list_t out;
-    fb_alloc_mark();
-    imlib_find_datamatrices(&out, arg_img, &roi, effort);
-    fb_alloc_free_till_mark();
-
-    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
-    for (size_t i = 0; list_size(&out); i++) {
+static mp_obj_t py_datamatrices_list_new(list_t *out) {
+    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(out), NULL);
+    for (size_t i = 0; list_size(out); i++) {
         find_datamatrices_list_lnk_data_t lnk_data;
-        list_pop_front(&out, &lnk_data);
+        list_pop_front(out, &lnk_data);
 
         py_datamatrix_obj_t *o = m_new_obj(py_datamatrix_obj_t);
         o->base.type = &py_datamatrix_type;
@@ -5550,6 +7105,47 @@ static mp_obj_t py_image_find_datamatrices(uint n_args, const mp_obj_t *args, mp
 
     return objects_list;
 }
+
+static mp_obj_t py_image_find_datamatrices(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_image_cobj(args[0]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+
+    int effort = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_effort), 200);
+
+    imlib_deadline_t deadline;
+    py_image_deadline_init(&deadline, n_args, args, 3, kw_args);
+
+    // Candidate rects from a finder pass, each is scanned with its own effort.
+    list_t rois;
+    list_init(&rois, sizeof(rectangle_t));
+    mp_map_elem_t *rois_arg = mp_map_lookup(kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_rois), MP_MAP_LOOKUP);
+
+    if (rois_arg && (rois_arg->value != mp_const_none)) {
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_get_array(rois_arg->value, &len, &items);
+
+        for (size_t i = 0; i < len; i++) {
+            mp_obj_t *rect;
+            mp_obj_get_array_fixed_n(items[i], 4, &rect);
+            rectangle_t r = {mp_obj_get_int(rect[0]), mp_obj_get_int(rect[1]),
+                             mp_obj_get_int(rect[2]), mp_obj_get_int(rect[3])};
+            PY_ASSERT_TRUE_MSG((r.w >= 1) && (r.h >= 1), "Invalid ROI dimensions!");
+            list_push_back(&rois, &r);
+        }
+    }
+
+    list_t out;
+    fb_alloc_mark();
+    imlib_find_datamatrices(&out, arg_img, &roi, list_size(&rois) ? &rois : NULL, effort, &deadline);
+    fb_alloc_free_till_mark();
+    list_free(&rois);
+    py_image_timed_out_flag = deadline.expired;
+
+    return py_datamatrices_list_new(&out);
+}
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_datamatrices_obj, 1, py_image_find_datamatrices);
 #endif // IMLIB_ENABLE_DATAMATRICES
 
@@ -5681,21 +7277,11 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     locals_dict, &py_barcode_locals_dict
     );
 
-static mp_obj_t py_image_find_barcodes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
-    image_t *arg_img = py_image_cobj(args[0]);
-
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
-
-    list_t out;
-    fb_alloc_mark();
-    imlib_find_barcodes(&out, arg_img, &roi);
-    fb_alloc_free_till_mark();
-
-    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(&out), NULL);
-    for (size_t i = 0; list_size(&out); i++) {
+static mp_obj_t py_barcodes_list_new(list_t *out) {
+    mp_obj_list_t *objects_list = mp_obj_new_list(list_size(out), NULL);
+    for (size_t i = 0; list_size(out); i++) {
         find_barcodes_list_lnk_data_t lnk_data;
-        list_pop_front(&out, &lnk_data);
+        list_pop_front(out, &lnk_data);
 
         py_barcode_obj_t *o = m_new_obj(py_barcode_obj_t);
         o->base.type = &py_barcode_type;
@@ -5727,9 +7313,96 @@ static mp_obj_t py_image_find_barcodes(uint n_args, const mp_obj_t *args, mp_map
 
     return objects_list;
 }
+
+static mp_obj_t py_image_find_barcodes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_image_cobj(args[0]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+
+    // A stride of 0 disables scanning in that direction.
+    int x_stride = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_x_stride), 1);
+    int y_stride = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_y_stride), 1);
+    PY_ASSERT_TRUE_MSG((x_stride >= 0) && (y_stride >= 0), "Strides must be >= 0!");
+    PY_ASSERT_TRUE_MSG(x_stride || y_stride, "At least one stride must be > 0!");
+    bool first_only = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_first_only), false);
+    bool localize = py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_localize), false);
+
+    imlib_deadline_t deadline;
+    py_image_deadline_init(&deadline, n_args, args, 6, kw_args);
+
+    list_t out;
+    fb_alloc_mark();
+    imlib_find_barcodes(&out, arg_img, &roi, x_stride, y_stride, first_only, localize, &deadline);
+    fb_alloc_free_till_mark();
+    py_image_timed_out_flag = deadline.expired;
+
+    return py_barcodes_list_new(&out);
+}
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_barcodes_obj, 1, py_image_find_barcodes);
 #endif // IMLIB_ENABLE_BARCODES
 
+static void py_image_list_extend(mp_obj_t list, mp_obj_t items_list) {
+    size_t len;
+    mp_obj_t *items;
+    mp_obj_get_array(items_list, &len, &items);
+
+    for (size_t i = 0; i < len; i++) {
+        mp_obj_list_append(list, items[i]);
+    }
+}
+
+static mp_obj_t py_image_find_codes(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_image_cobj(args[0]);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+
+    find_codes_types_t types =
+        py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_types),
+                              FIND_CODES_QRCODES | FIND_CODES_APRILTAGS | FIND_CODES_DATAMATRICES | FIND_CODES_BARCODES);
+#ifndef IMLIB_ENABLE_HIGH_RES_APRILTAGS
+    PY_ASSERT_TRUE_MSG((!(types & FIND_CODES_APRILTAGS)) || ((roi.w * roi.h) < 65536),
+                       "The maximum supported resolution for AprilTags is < 64K pixels.");
+#endif
+
+    apriltag_families_t families = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_families), TAG36H11);
+    // 2.8mm Focal Length w/ OV7725 sensor for reference.
+    float fx = py_helper_keyword_float(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fx), (2.8 / 3.984) * arg_img->w);
+    // 2.8mm Focal Length w/ OV7725 sensor for reference.
+    float fy = py_helper_keyword_float(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fy), (2.8 / 2.952) * arg_img->h);
+    // Use the image versus the roi here since the image should be projected from the camera center.
+    float cx = py_helper_keyword_float(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cx), arg_img->w * 0.5);
+    // Use the image versus the roi here since the image should be projected from the camera center.
+    float cy = py_helper_keyword_float(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_cy), arg_img->h * 0.5);
+    int effort = py_helper_keyword_int(n_args, args, 8, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_effort), 200);
+
+    imlib_deadline_t deadline;
+    py_image_deadline_init(&deadline, n_args, args, 9, kw_args);
+
+    find_codes_t out;
+    fb_alloc_mark();
+    imlib_find_codes(&out, arg_img, &roi, types, families, fx, fy, cx, cy, effort, &deadline);
+    fb_alloc_free_till_mark();
+    py_image_timed_out_flag = deadline.expired;
+
+    mp_obj_t objects_list = mp_obj_new_list(0, NULL);
+    #ifdef IMLIB_ENABLE_QRCODES
+    py_image_list_extend(objects_list, py_qrcodes_list_new(&out.qrcodes));
+    #endif
+    #ifdef IMLIB_ENABLE_DATAMATRICES
+    py_image_list_extend(objects_list, py_datamatrices_list_new(&out.datamatrices));
+    #endif
+    #if defined(IMLIB_ENABLE_BARCODES) && (!defined(OMV_NO_GPL))
+    py_image_list_extend(objects_list, py_barcodes_list_new(&out.barcodes));
+    #endif
+    #ifdef IMLIB_ENABLE_APRILTAGS
+    py_image_list_extend(objects_list, py_apriltags_list_new(&out.apriltags));
+    #endif
+    return objects_list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_codes_obj, 1, py_image_find_codes);
+
 #ifdef IMLIB_ENABLE_FIND_DISPLACEMENT
 // Displacement Object //
 #define py_displacement_obj_size    5
@@ -5817,83 +7490,320 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     locals_dict, &py_displacement_locals_dict
     );
 
+static mp_obj_t py_displacement_new(float x, float y, float r, float s, float response) {
+    py_displacement_obj_t *o = m_new_obj(py_displacement_obj_t);
+    o->base.type = &py_displacement_type;
+    o->x_translation = mp_obj_new_float(x);
+    o->y_translation = mp_obj_new_float(y);
+    o->rotation = mp_obj_new_float(r);
+    o->scale = mp_obj_new_float(s);
+    o->response = mp_obj_new_float(response);
+    return o;
+}
+
 static mp_obj_t py_image_find_displacement(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
     image_t *arg_template_img = py_helper_arg_to_image(args[1], ARG_IMAGE_MUTABLE);
 
-    rectangle_t roi;
-    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 2, kw_args, &roi);
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 2, kw_args, &roi);
+
+    rectangle_t template_roi;
+    py_helper_keyword_rectangle(arg_template_img, n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_template_roi),
+                                &template_roi);
+
+    PY_ASSERT_FALSE_MSG((roi.w != template_roi.w) || (roi.h != template_roi.h), "ROI(w,h) != TEMPLATE_ROI(w,h)");
+
+    bool logpolar = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_logpolar), false);
+    bool fix_rotation_scale =
+        py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fix_rotation_scale), false);
+
+    float x, y, r, s, response;
+    fb_alloc_mark();
+    imlib_phasecorrelate(arg_img, arg_template_img, &roi, &template_roi, logpolar, fix_rotation_scale, &x, &y, &r, &s,
+                         &response);
+    fb_alloc_free_till_mark();
+
+    return py_displacement_new(x, y, r, s, response);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_displacement_obj, 2, py_image_find_displacement);
+
+// Phase Correlator Object //
+typedef struct py_phasecorr_obj {
+    mp_obj_base_t base;
+    imlib_phasecorr_t pc;
+} py_phasecorr_obj_t;
+
+static void py_phasecorr_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_phasecorr_obj_t *self = self_in;
+    mp_printf(print, "{\"w\":%d, \"h\":%d, \"logpolar\":%d}",
+              self->pc.w, self->pc.h, self->pc.logpolar);
+}
+
+static mp_obj_t py_phasecorr_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_width, ARG_height, ARG_logpolar };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_height, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_logpolar, MP_ARG_BOOL, {.u_bool = false } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int w = args[ARG_width].u_int;
+    int h = args[ARG_height].u_int;
+    PY_ASSERT_TRUE_MSG((w > 1) && (h > 1), "Width and height must be > 1!");
+
+    py_phasecorr_obj_t *o = mp_obj_malloc(py_phasecorr_obj_t, type);
+    size_t size = imlib_phasecorr_init(&o->pc, w, h, args[ARG_logpolar].u_bool);
+    imlib_phasecorr_set_buffer(&o->pc, m_new(uint8_t, size));
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static mp_obj_t py_phasecorr_update(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    py_phasecorr_obj_t *self = MP_OBJ_TO_PTR(args[0]);
+    image_t *arg_img = py_helper_arg_to_image(args[1], ARG_IMAGE_MUTABLE);
+
+    PY_ASSERT_TRUE_MSG((arg_img->pixfmt == PIXFORMAT_GRAYSCALE) || (arg_img->pixfmt == PIXFORMAT_RGB565),
+                       "Only GRAYSCALE and RGB565 images are supported!");
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 2, kw_args, &roi);
+    PY_ASSERT_FALSE_MSG((roi.w != self->pc.w) || (roi.h != self->pc.h), "ROI(w,h) != PhaseCorrelator(w,h)");
+
+    float x, y, r, s, response;
+    fb_alloc_mark();
+    bool valid = imlib_phasecorr_update(&self->pc, arg_img, &roi, &x, &y, &r, &s, &response);
+    fb_alloc_free_till_mark();
+
+    // The first frame after a reset has nothing to be compared against.
+    if (!valid) {
+        return mp_const_none;
+    }
+
+    return py_displacement_new(x, y, r, s, response);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_phasecorr_update_obj, 2, py_phasecorr_update);
+
+static mp_obj_t py_phasecorr_reset(mp_obj_t self_in) {
+    py_phasecorr_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    imlib_phasecorr_reset(&self->pc);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_phasecorr_reset_obj, py_phasecorr_reset);
+
+static const mp_rom_map_elem_t py_phasecorr_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&py_phasecorr_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&py_phasecorr_reset_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_phasecorr_locals_dict, py_phasecorr_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_phasecorr_type,
+    MP_QSTR_PhaseCorrelator,
+    MP_TYPE_FLAG_NONE,
+    print, py_phasecorr_print,
+    make_new, py_phasecorr_make_new,
+    locals_dict, &py_phasecorr_locals_dict
+    );
+
+// Optical Flow Object //
+typedef struct py_optflow_obj {
+    mp_obj_base_t base;
+    imlib_optflow_t of;
+} py_optflow_obj_t;
+
+static void py_optflow_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_optflow_obj_t *self = self_in;
+    mp_printf(print, "{\"w\":%d, \"h\":%d, \"levels\":%d, \"window\":%d, \"iterations\":%d}",
+              self->of.w, self->of.h, self->of.n_levels, (self->of.radius * 2) + 1, self->of.iterations);
+}
+
+static mp_obj_t py_optflow_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_width, ARG_height, ARG_levels, ARG_window, ARG_iterations };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_height, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_levels, MP_ARG_INT, {.u_int = 3 } },
+        { MP_QSTR_window, MP_ARG_INT, {.u_int = 15 } },
+        { MP_QSTR_iterations, MP_ARG_INT, {.u_int = 10 } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int w = args[ARG_width].u_int;
+    int h = args[ARG_height].u_int;
+    int levels = args[ARG_levels].u_int;
+    int window = args[ARG_window].u_int;
+    int iterations = args[ARG_iterations].u_int;
+
+    PY_ASSERT_TRUE_MSG((w >= IMLIB_OPTFLOW_MIN_SIZE) && (h >= IMLIB_OPTFLOW_MIN_SIZE),
+                       "Width and height must be >= 16!");
+    PY_ASSERT_TRUE_MSG((levels > 0) && (levels <= IMLIB_OPTFLOW_MAX_LEVELS), "Levels must be between 1 and 5!");
+    PY_ASSERT_TRUE_MSG((window >= 3) && (window <= 31) && (window % 2), "Window must be odd and between 3 and 31!");
+    PY_ASSERT_TRUE_MSG(iterations > 0, "Iterations must be > 0!");
+
+    py_optflow_obj_t *o = mp_obj_malloc(py_optflow_obj_t, type);
+    size_t size = imlib_optflow_init(&o->of, w, h, levels, window / 2, iterations);
+    // Both pyramids outlive a single call so they can't live on the frame buffer stack.
+    imlib_optflow_set_buffer(&o->of, m_new(uint8_t, size));
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static mp_obj_t py_optflow_update(mp_obj_t self_in, mp_obj_t img_obj, mp_obj_t points_obj) {
+    py_optflow_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    image_t *arg_img = py_helper_arg_to_image(img_obj, ARG_IMAGE_MUTABLE);
+
+    PY_ASSERT_TRUE_MSG((arg_img->pixfmt == PIXFORMAT_GRAYSCALE) || (arg_img->pixfmt == PIXFORMAT_RGB565),
+                       "Only GRAYSCALE and RGB565 images are supported!");
+    PY_ASSERT_TRUE_MSG((arg_img->w == self->of.w) && (arg_img->h == self->of.h),
+                       "The image doesn't match the OpticalFlow size!");
+
+    fb_alloc_mark();
+
+    // Points are either (x, y) tuples or keypoints from find_keypoints().
+    size_t n = 0;
+    imlib_optflow_point_t *points = NULL;
+    #ifdef IMLIB_ENABLE_FIND_KEYPOINTS
+    if (mp_obj_is_type(points_obj, &py_kp_type)) {
+        array_t *kpts = py_kpts_obj(points_obj)->kpts;
+        n = array_length(kpts);
+        points = fb_alloc(n * sizeof(imlib_optflow_point_t), FB_ALLOC_NO_HINT);
+        for (size_t i = 0; i < n; i++) {
+            kp_t *kp = array_at(kpts, i);
+            points[i].x = kp->x;
+            points[i].y = kp->y;
+        }
+    } else
+    #endif
+    {
+        mp_obj_t *items;
+        mp_obj_get_array(points_obj, &n, &items);
+        points = fb_alloc(n * sizeof(imlib_optflow_point_t), FB_ALLOC_NO_HINT);
+        for (size_t i = 0; i < n; i++) {
+            mp_obj_t *xy;
+            mp_obj_get_array_fixed_n(items[i], 2, &xy);
+            points[i].x = mp_obj_get_float(xy[0]);
+            points[i].y = mp_obj_get_float(xy[1]);
+        }
+    }
 
-    rectangle_t template_roi;
-    py_helper_keyword_rectangle(arg_template_img, n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_template_roi),
-                                &template_roi);
+    bool valid = imlib_optflow_update(&self->of, arg_img, points, n);
 
-    PY_ASSERT_FALSE_MSG((roi.w != template_roi.w) || (roi.h != template_roi.h), "ROI(w,h) != TEMPLATE_ROI(w,h)");
+    // The first frame after a reset has nothing to be compared against.
+    if (!valid) {
+        fb_alloc_free_till_mark();
+        return mp_const_none;
+    }
 
-    bool logpolar = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_logpolar), false);
-    bool fix_rotation_scale =
-        py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_fix_rotation_scale), false);
+    // Returns the (x, y, dx, dy) of each point in the current frame, or None if it was lost.
+    mp_obj_t list = mp_obj_new_list(n, NULL);
+    for (size_t i = 0; i < n; i++) {
+        imlib_optflow_point_t *pt = &points[i];
+        if (!pt->found) {
+            ((mp_obj_list_t *) list)->items[i] = mp_const_none;
+        } else {
+            ((mp_obj_list_t *) list)->items[i] =
+                mp_obj_new_tuple(4, (mp_obj_t []) {mp_obj_new_float(pt->x + pt->dx),
+                                                   mp_obj_new_float(pt->y + pt->dy),
+                                                   mp_obj_new_float(pt->dx),
+                                                   mp_obj_new_float(pt->dy)});
+        }
+    }
 
-    float x, y, r, s, response;
-    fb_alloc_mark();
-    imlib_phasecorrelate(arg_img, arg_template_img, &roi, &template_roi, logpolar, fix_rotation_scale, &x, &y, &r, &s,
-                         &response);
     fb_alloc_free_till_mark();
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_3(py_optflow_update_obj, py_optflow_update);
 
-    py_displacement_obj_t *o = m_new_obj(py_displacement_obj_t);
-    o->base.type = &py_displacement_type;
-    o->x_translation = mp_obj_new_float(x);
-    o->y_translation = mp_obj_new_float(y);
-    o->rotation = mp_obj_new_float(r);
-    o->scale = mp_obj_new_float(s);
-    o->response = mp_obj_new_float(response);
-
-    return o;
+static mp_obj_t py_optflow_reset(mp_obj_t self_in) {
+    py_optflow_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    imlib_optflow_reset(&self->of);
+    return mp_const_none;
 }
-static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_displacement_obj, 2, py_image_find_displacement);
+static MP_DEFINE_CONST_FUN_OBJ_1(py_optflow_reset_obj, py_optflow_reset);
+
+static const mp_rom_map_elem_t py_optflow_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_update), MP_ROM_PTR(&py_optflow_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset), MP_ROM_PTR(&py_optflow_reset_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_optflow_locals_dict, py_optflow_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_optflow_type,
+    MP_QSTR_OpticalFlow,
+    MP_TYPE_FLAG_NONE,
+    print, py_optflow_print,
+    make_new, py_optflow_make_new,
+    locals_dict, &py_optflow_locals_dict
+    );
 #endif // IMLIB_ENABLE_FIND_DISPLACEMENT
 
 #ifdef IMLIB_FIND_TEMPLATE
 static mp_obj_t py_image_find_template(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_GRAYSCALE);
-    image_t *arg_template = py_helper_arg_to_image(args[1], ARG_IMAGE_GRAYSCALE);
     float arg_thresh = mp_obj_get_float(args[2]);
 
+    // A list of templates is matched against the same frame transform.
+    bool multi = mp_obj_is_type(args[1], &mp_type_list) || mp_obj_is_type(args[1], &mp_type_tuple);
+    size_t n_templates = 1;
+    mp_obj_t *templates = (mp_obj_t *) &args[1];
+    if (multi) {
+        mp_obj_get_array(args[1], &n_templates, &templates);
+        PY_ASSERT_TRUE_MSG(n_templates > 0, "Expected at least one template!");
+    }
+
     rectangle_t roi;
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 3, kw_args, &roi);
 
-    // Make sure ROI is bigger than or equal to template size
-    PY_ASSERT_TRUE_MSG((roi.w >= arg_template->w && roi.h >= arg_template->h),
-                       "Region of interest is smaller than template!");
-
     // Make sure ROI is smaller than or equal to image size
     PY_ASSERT_TRUE_MSG(((roi.x + roi.w) <= arg_img->w && (roi.y + roi.h) <= arg_img->h),
                        "Region of interest is bigger than image!");
 
+    image_t **arg_templates = m_new(image_t *, n_templates);
+    for (size_t i = 0; i < n_templates; i++) {
+        arg_templates[i] = py_helper_arg_to_image(templates[i], ARG_IMAGE_GRAYSCALE);
+        // Make sure ROI is bigger than or equal to template size
+        PY_ASSERT_TRUE_MSG((roi.w >= arg_templates[i]->w && roi.h >= arg_templates[i]->h),
+                           "Region of interest is smaller than template!");
+    }
+
     int step = py_helper_keyword_int(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_step), 2);
     int search = py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_search), SEARCH_EX);
 
-    // Find template
-    rectangle_t r;
-    float corr;
+    // Find templates
+    rectangle_t *r = m_new(rectangle_t, n_templates);
+    float *corr = m_new(float, n_templates);
     fb_alloc_mark();
     if (search == SEARCH_DS) {
-        corr = imlib_template_match_ds(arg_img, arg_template, &r);
+        for (size_t i = 0; i < n_templates; i++) {
+            corr[i] = imlib_template_match_ds(arg_img, arg_templates[i], &r[i]);
+        }
     } else {
-        corr = imlib_template_match_ex(arg_img, arg_template, &roi, step, &r);
+        imlib_template_match_ex_n(arg_img, arg_templates, n_templates, &roi, step, r, corr);
     }
     fb_alloc_free_till_mark();
 
-    if (corr > arg_thresh) {
-        mp_obj_t rec_obj[4] = {
-            mp_obj_new_int(r.x),
-            mp_obj_new_int(r.y),
-            mp_obj_new_int(r.w),
-            mp_obj_new_int(r.h)
-        };
-        return mp_obj_new_tuple(4, rec_obj);
+    mp_obj_t matches = multi ? mp_obj_new_list(0, NULL) : mp_const_none;
+    for (size_t i = 0; i < n_templates; i++) {
+        mp_obj_t match = mp_const_none;
+        if (corr[i] > arg_thresh) {
+            mp_obj_t rec_obj[4] = {
+                mp_obj_new_int(r[i].x),
+                mp_obj_new_int(r[i].y),
+                mp_obj_new_int(r[i].w),
+                mp_obj_new_int(r[i].h)
+            };
+            match = mp_obj_new_tuple(4, rec_obj);
+        }
+        if (!multi) {
+            return match;
+        }
+        mp_obj_list_append(matches, match);
     }
-    return mp_const_none;
+    return matches;
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_template_obj, 3, py_image_find_template);
 #endif // IMLIB_FIND_TEMPLATE
@@ -5912,6 +7822,11 @@ static mp_obj_t py_image_find_features(uint n_args, const mp_obj_t *args, mp_map
     PY_ASSERT_TRUE_MSG((roi.w > cascade->window.w && roi.h > cascade->window.h),
                        "Region of interest is smaller than detector window!");
 
+    // When tracking, only the regions around the previous objects are searched, with a full scan
+    // every track frames or when the objects are lost.
+    cascade->track_interval = py_helper_keyword_int(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_track), 0);
+    PY_ASSERT_TRUE_MSG(cascade->track_interval >= 0, "track must be >= 0!");
+
     // Detect objects
     fb_alloc_mark();
     array_t *objects_array = imlib_detect_objects(arg_img, cascade, &roi);
@@ -5941,8 +7856,10 @@ static mp_obj_t py_image_find_eye(uint n_args, const mp_obj_t *args, mp_map_t *k
     rectangle_t roi;
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
 
+    gradients_t *gradients = py_helper_keyword_gradients(arg_img, n_args, args, 2, kw_args, &roi);
+
     point_t iris;
-    imlib_find_iris(arg_img, &iris, &roi);
+    imlib_find_iris(arg_img, &iris, &roi, gradients);
 
     mp_obj_t eye_obj[2] = {
         mp_obj_new_int(iris.x),
@@ -5969,6 +7886,82 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_lbp_obj, 2, py_image_find_lbp);
 #endif // IMLIB_ENABLE_FIND_LBP
 
 #ifdef IMLIB_ENABLE_FIND_KEYPOINTS
+// Pyramid Object //
+typedef struct py_pyramid_obj {
+    mp_obj_base_t base;
+    imlib_pyramid_t pyr;
+} py_pyramid_obj_t;
+
+static void py_pyramid_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_pyramid_obj_t *self = self_in;
+    mp_printf(print, "{\"w\":%d, \"h\":%d, \"scale\":%f, \"levels\":%d}",
+              self->pyr.w, self->pyr.h, (double) self->pyr.scale, self->pyr.n_levels);
+}
+
+static mp_obj_t py_pyramid_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_width, ARG_height, ARG_scale, ARG_levels };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_height, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_scale, MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_levels, MP_ARG_INT, {.u_int = IMLIB_PYRAMID_MAX_LEVELS } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int w = args[ARG_width].u_int;
+    int h = args[ARG_height].u_int;
+    float scale = (args[ARG_scale].u_obj == mp_const_none) ? 1.5f : mp_obj_get_float(args[ARG_scale].u_obj);
+    int levels = args[ARG_levels].u_int;
+
+    PY_ASSERT_TRUE_MSG((w > 0) && (h > 0), "Width and height must be > 0!");
+    PY_ASSERT_TRUE_MSG(scale > 1.0f, "Scale must be > 1!");
+    PY_ASSERT_TRUE_MSG(levels > 0, "Levels must be > 0!");
+
+    py_pyramid_obj_t *o = mp_obj_malloc(py_pyramid_obj_t, type);
+    size_t size = imlib_pyramid_init(&o->pyr, w, h, scale, levels);
+    // The levels outlive a single call so they can't live on the frame buffer stack.
+    imlib_pyramid_set_buffer(&o->pyr, m_new(uint8_t, size));
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static mp_obj_t py_pyramid_build(mp_obj_t self_in, mp_obj_t img_obj) {
+    py_pyramid_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    image_t *img = py_helper_arg_to_image(img_obj, ARG_IMAGE_MUTABLE);
+    PY_ASSERT_TRUE_MSG((self->pyr.w == img->w) && (self->pyr.h == img->h),
+                       "The pyramid doesn't match the image size!");
+
+    fb_alloc_mark();
+    imlib_pyramid_build(&self->pyr, img);
+    fb_alloc_free_till_mark();
+    return self_in;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(py_pyramid_build_obj, py_pyramid_build);
+
+static const mp_rom_map_elem_t py_pyramid_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_build), MP_ROM_PTR(&py_pyramid_build_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_pyramid_locals_dict, py_pyramid_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_pyramid_type,
+    MP_QSTR_Pyramid,
+    MP_TYPE_FLAG_NONE,
+    print, py_pyramid_print,
+    make_new, py_pyramid_make_new,
+    locals_dict, &py_pyramid_locals_dict
+    );
+
+static imlib_pyramid_t *py_pyramid_get(mp_obj_t pyramid_obj, image_t *img) {
+    PY_ASSERT_TYPE(pyramid_obj, &py_pyramid_type);
+    imlib_pyramid_t *pyr = &((py_pyramid_obj_t *) MP_OBJ_TO_PTR(pyramid_obj))->pyr;
+    PY_ASSERT_TRUE_MSG((pyr->w == img->w) && (pyr->h == img->h),
+                       "The pyramid doesn't match the image size!");
+    PY_ASSERT_TRUE_MSG(pyr->built, "The pyramid must be built first!");
+    return pyr;
+}
+
 static mp_obj_t py_image_find_keypoints(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
 
@@ -5986,6 +7979,13 @@ static mp_obj_t py_image_find_keypoints(uint n_args, const mp_obj_t *args, mp_ma
     corner_detector_t corner_detector =
         py_helper_keyword_int(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_corner_detector), CORNER_AGAST);
 
+    // A prebuilt Pyramid replaces the scale_factor argument.
+    imlib_pyramid_t *pyramid = NULL;
+    mp_obj_t pyramid_obj = py_helper_keyword_object(n_args, args, 7, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_pyramid), NULL);
+    if (pyramid_obj) {
+        pyramid = py_pyramid_get(pyramid_obj, arg_img);
+    }
+
     #ifndef IMLIB_ENABLE_FAST
     // Force AGAST when FAST is disabled.
     corner_detector = CORNER_AGAST;
@@ -5993,13 +7993,14 @@ static mp_obj_t py_image_find_keypoints(uint n_args, const mp_obj_t *args, mp_ma
 
     // Find keypoints
     fb_alloc_mark();
-    array_t *kpts = orb_find_keypoints(arg_img, normalized, threshold, scale_factor, max_keypoints, corner_detector, &roi);
+    array_t *kpts = orb_find_keypoints(arg_img, normalized, threshold, scale_factor, max_keypoints, corner_detector, &roi, pyramid);
     fb_alloc_free_till_mark();
 
     if (array_length(kpts)) {
         py_kp_obj_t *kp_obj = m_new_obj(py_kp_obj_t);
         kp_obj->base.type = &py_kp_type;
         kp_obj->kpts = kpts;
+        kp_obj->index = NULL;
         kp_obj->threshold = threshold;
         kp_obj->normalized = normalized;
         return kp_obj;
@@ -6027,6 +8028,8 @@ static mp_obj_t py_image_find_edges(uint n_args, const mp_obj_t *args, mp_map_t
         thresh[1] = mp_obj_get_int(thresh_array[1]);
     }
 
+    gradients_t *gradients = py_helper_keyword_gradients(arg_img, n_args, args, 4, kw_args, &roi);
+
     switch (edge_type) {
         case EDGE_SIMPLE: {
             fb_alloc_mark();
@@ -6036,7 +8039,7 @@ static mp_obj_t py_image_find_edges(uint n_args, const mp_obj_t *args, mp_map_t
         }
         case EDGE_CANNY: {
             fb_alloc_mark();
-            imlib_edge_canny(arg_img, &roi, thresh[0], thresh[1]);
+            imlib_edge_canny(arg_img, &roi, thresh[0], thresh[1], gradients);
             fb_alloc_free_till_mark();
             break;
         }
@@ -6056,25 +8059,76 @@ static mp_obj_t py_image_find_hog(uint n_args, const mp_obj_t *args, mp_map_t *k
     py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
 
     int size = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_size), 8);
+    gradients_t *gradients = py_helper_keyword_gradients(arg_img, n_args, args, 3, kw_args, &roi);
 
     fb_alloc_mark();
-    imlib_find_hog(arg_img, &roi, size);
+    imlib_find_hog(arg_img, &roi, size, gradients);
     fb_alloc_free_till_mark();
 
     return args[0];
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_find_hog_obj, 1, py_image_find_hog);
+
+static mp_obj_t py_image_get_hog(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    image_t *arg_img = py_helper_arg_to_image(args[0], ARG_IMAGE_GRAYSCALE);
+
+    rectangle_t roi;
+    py_helper_keyword_rectangle_roi(arg_img, n_args, args, 1, kw_args, &roi);
+
+    int size = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_size), 8);
+    int levels = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_levels), 1);
+    PY_ASSERT_TRUE_MSG(size >= 2, "Cell size must be >= 2!");
+    PY_ASSERT_TRUE_MSG(levels >= 1, "Levels must be >= 1!");
+    gradients_t *gradients = py_helper_keyword_gradients(arg_img, n_args, args, 4, kw_args, &roi);
+
+    int x_cells = roi.w / size;
+    int y_cells = roi.h / size;
+    PY_ASSERT_TRUE_MSG((x_cells >= 2) && (y_cells >= 2), "ROI must be at least 2x2 cells!");
+
+    fb_alloc_mark();
+    uint32_t *cells = fb_alloc(x_cells * y_cells * HOG_BINS * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    imlib_hog_cells(arg_img, &roi, size, cells, gradients);
+
+    // Returns a (blocks_x, blocks_y, bytearray) tuple per pyramid level, each block has
+    // HOG_BLOCK_BINS features and blocks overlap by one cell.
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (int i = 0; (i < levels) && (x_cells >= 2) && (y_cells >= 2); i++) {
+        if (i) {
+            imlib_hog_cells_downscale(&x_cells, &y_cells, cells);
+            if ((x_cells < 2) || (y_cells < 2)) {
+                break;
+            }
+        }
+
+        size_t len = (x_cells - 1) * (y_cells - 1) * HOG_BLOCK_BINS;
+        uint8_t *blocks = m_new(uint8_t, len);
+        imlib_hog_blocks(x_cells, y_cells, cells, blocks);
+
+        mp_obj_t level[3] = {
+            mp_obj_new_int(x_cells - 1),
+            mp_obj_new_int(y_cells - 1),
+            mp_obj_new_bytearray_by_ref(len, blocks)
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(3, level));
+    }
+
+    fb_alloc_free_till_mark();
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_get_hog_obj, 1, py_image_get_hog);
 #endif // IMLIB_ENABLE_HOG
 
 #ifdef IMLIB_ENABLE_SELECTIVE_SEARCH
 static mp_obj_t py_image_selective_search(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     image_t *img = py_helper_arg_to_image(args[0], ARG_IMAGE_MUTABLE);
+    PY_ASSERT_TRUE_MSG(img->pixfmt == PIXFORMAT_RGB565, "Only RGB565 images are supported");
     int t = py_helper_keyword_int(n_args, args, 1, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_threshold), 500);
     int s = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_size), 20);
     float a1 = py_helper_keyword_float(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_a1), 1.0f);
-    float a2 = py_helper_keyword_float(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_a1), 1.0f);
-    float a3 = py_helper_keyword_float(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_a1), 1.0f);
-    array_t *proposals_array = imlib_selective_search(img, t, s, a1, a2, a3);
+    float a2 = py_helper_keyword_float(n_args, args, 4, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_a2), 1.0f);
+    float a3 = py_helper_keyword_float(n_args, args, 5, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_a3), 1.0f);
+    int max_proposals = py_helper_keyword_int(n_args, args, 6, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_max_proposals), 0);
+    array_t *proposals_array = imlib_selective_search(img, t, s, a1, a2, a3, max_proposals);
 
     // Add proposals to a new Python list...
     mp_obj_t proposals_list = mp_obj_new_list(0, NULL);
@@ -6125,19 +8179,23 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_stereo_disparity_obj, 1, py_image_ste
 #endif // IMLIB_ENABLE_STEREO_DISPARITY
 
 mp_obj_t py_image_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    enum { ARG_arg, ARG_height, ARG_pixformat, ARG_buffer, ARG_copy_to_fb, ARG_shape, ARG_strides, ARG_scale};
+    enum { ARG_arg, ARG_height, ARG_pixformat, ARG_buffer, ARG_copy_to_fb, ARG_roi, ARG_scale, ARG_copy };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_arg,          MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_height,       MP_ARG_INT, {.u_int = -1} },
         { MP_QSTR_pixformat,    MP_ARG_INT, {.u_int = -1} },
         { MP_QSTR_buffer,       MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
         { MP_QSTR_copy_to_fb,   MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_roi,          MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_scale,        MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1} },
+        { MP_QSTR_copy,         MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true} },
     };
 
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     image_t image = {0};
+    mp_obj_t owner = MP_OBJ_NULL;
 
     if (mp_obj_is_str(args[ARG_arg].u_obj)) {
         #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
@@ -6145,22 +8203,86 @@ mp_obj_t py_image_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw
         img_read_settings_t rs;
         const char *path = mp_obj_str_get_str(args[ARG_arg].u_obj);
 
+        int scale = args[ARG_scale].u_int;
+        bool crop = (args[ARG_roi].u_obj != mp_const_none) || (scale != 1);
+
+        if ((scale != 1) && (scale != 2) && (scale != 4) && (scale != 8)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Scale must be 1, 2, 4 or 8"));
+        }
+
         fb_alloc_mark();
         imlib_read_geometry(&fp, &image, path, &rs);
         file_close(&fp);
 
+        rectangle_t roi;
+
+        if (crop) {
+            // Decode only the roi, scaled down, instead of the whole file.
+            roi = py_helper_arg_to_roi(args[ARG_roi].u_obj, &image);
+
+            if (args[ARG_pixformat].u_int != -1) {
+                image.pixfmt = args[ARG_pixformat].u_int;
+            } else if (image.is_compressed) {
+                image.pixfmt = PIXFORMAT_RGB565;
+            }
+
+            if ((image.pixfmt != PIXFORMAT_BINARY)
+                && (image.pixfmt != PIXFORMAT_GRAYSCALE)
+                && (image.pixfmt != PIXFORMAT_RGB565)) {
+                mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Pixel format is not set or unsupported"));
+            }
+
+            image.w = IM_MAX(roi.w / scale, 1);
+            image.h = IM_MAX(roi.h / scale, 1);
+        }
+
         if (args[ARG_copy_to_fb].u_bool) {
             py_helper_set_to_framebuffer(&image);
         } else {
             image.data = xalloc(image_size(&image));
         }
 
-        imlib_load_image(&image, path);
+        if (crop) {
+            imlib_load_image_roi(&image, path, &roi, scale);
+        } else {
+            imlib_load_image(&image, path);
+        }
         fb_alloc_free_till_mark();
         #else
         mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Image I/O is not supported"));
         #endif // IMLIB_ENABLE_IMAGE_FILE_IO
     #if defined(MODULE_ULAB_ENABLED) && (ULAB_MAX_DIMS >= 3)
+    } else if (MP_OBJ_IS_TYPE(args[ARG_arg].u_obj, &ulab_ndarray_type) && (!args[ARG_copy].u_bool)) {
+        ndarray_obj_t *array = MP_OBJ_TO_PTR(args[ARG_arg].u_obj);
+
+        // The image aliases the ndarray's memory, uint8 arrays are GRAYSCALE and uint16
+        // arrays are RGB565 or GRAYSCALE16.
+        if ((array->ndim != 2) || ((array->dtype != NDARRAY_UINT8) && (array->dtype != NDARRAY_UINT16))) {
+            mp_raise_msg(&mp_type_ValueError,
+                         MP_ERROR_TEXT("Expected a ndarray with dtype uint8 or uint16 and shape (height, width)"));
+        }
+
+        if (!ndarray_is_dense(array)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected a dense ndarray"));
+        }
+
+        if (args[ARG_copy_to_fb].u_bool || (args[ARG_buffer].u_obj != mp_const_none)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Incompatible arguments!"));
+        }
+
+        image.w = array->shape[ULAB_MAX_DIMS - 1];
+        image.h = array->shape[ULAB_MAX_DIMS - 2];
+
+        if (array->dtype == NDARRAY_UINT8) {
+            image.pixfmt = PIXFORMAT_GRAYSCALE;
+        } else if (args[ARG_pixformat].u_int == PIXFORMAT_GRAYSCALE16) {
+            image.pixfmt = PIXFORMAT_GRAYSCALE16;
+        } else {
+            image.pixfmt = PIXFORMAT_RGB565;
+        }
+
+        image.data = array->array;
+        owner = args[ARG_arg].u_obj;
     } else if (MP_OBJ_IS_TYPE(args[ARG_arg].u_obj, &ulab_ndarray_type)) {
         ndarray_obj_t *array = MP_OBJ_TO_PTR(args[ARG_arg].u_obj);
 
@@ -6260,7 +8382,10 @@ mp_obj_t py_image_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw
     if (args[ARG_copy_to_fb].u_bool) {
         framebuffer_update_jpeg_buffer();
     }
-    return py_image_from_struct(&image);
+
+    py_image_obj_t *o = MP_OBJ_TO_PTR(py_image_from_struct(&image));
+    o->owner = owner;
+    return MP_OBJ_FROM_PTR(o);
 }
 
 static const mp_rom_map_elem_t locals_dict_table[] = {
@@ -6283,9 +8408,12 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_to_jpeg),             MP_ROM_PTR(&py_image_to_jpeg_obj)},
     {MP_ROM_QSTR(MP_QSTR_to_png),              MP_ROM_PTR(&py_image_to_png_obj)},
     {MP_ROM_QSTR(MP_QSTR_compress),            MP_ROM_PTR(&py_image_to_jpeg_obj)},
+    {MP_ROM_QSTR(MP_QSTR_compress_stream),     MP_ROM_PTR(&py_image_compress_stream_obj)},
+    {MP_ROM_QSTR(MP_QSTR_write_to),            MP_ROM_PTR(&py_image_write_to_obj)},
     {MP_ROM_QSTR(MP_QSTR_copy),                MP_ROM_PTR(&py_image_copy_obj)},
     {MP_ROM_QSTR(MP_QSTR_crop),                MP_ROM_PTR(&py_image_crop_obj)},
     {MP_ROM_QSTR(MP_QSTR_scale),               MP_ROM_PTR(&py_image_crop_obj)},
+    {MP_ROM_QSTR(MP_QSTR_view),                MP_ROM_PTR(&py_image_view_obj)},
     #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
     {MP_ROM_QSTR(MP_QSTR_save),                MP_ROM_PTR(&py_image_save_obj)},
     #else
@@ -6299,6 +8427,7 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_draw_circle),         MP_ROM_PTR(&py_image_draw_circle_obj)},
     {MP_ROM_QSTR(MP_QSTR_draw_ellipse),        MP_ROM_PTR(&py_image_draw_ellipse_obj)},
     {MP_ROM_QSTR(MP_QSTR_draw_string),         MP_ROM_PTR(&py_image_draw_string_obj)},
+    {MP_ROM_QSTR(MP_QSTR_draw_strings),        MP_ROM_PTR(&py_image_draw_strings_obj)},
     {MP_ROM_QSTR(MP_QSTR_draw_cross),          MP_ROM_PTR(&py_image_draw_cross_obj)},
     {MP_ROM_QSTR(MP_QSTR_draw_arrow),          MP_ROM_PTR(&py_image_draw_arrow_obj)},
     {MP_ROM_QSTR(MP_QSTR_draw_edges),          MP_ROM_PTR(&py_image_draw_edges_obj)},
@@ -6317,16 +8446,21 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_awb),                 MP_ROM_PTR(&py_awb_obj)},
     {MP_ROM_QSTR(MP_QSTR_ccm),                 MP_ROM_PTR(&py_ccm_obj)},
     {MP_ROM_QSTR(MP_QSTR_gamma),               MP_ROM_PTR(&py_image_gamma_obj)},
+    {MP_ROM_QSTR(MP_QSTR_isp),                 MP_ROM_PTR(&py_image_isp_obj)},
+    {MP_ROM_QSTR(MP_QSTR_get_isp_stats),       MP_ROM_PTR(&py_image_get_isp_stats_obj)},
     {MP_ROM_QSTR(MP_QSTR_gamma_corr),          MP_ROM_PTR(&py_image_gamma_obj)},
     #else
     {MP_ROM_QSTR(MP_QSTR_awb),                 MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_ccm),                 MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_gamma),               MP_ROM_PTR(&py_func_unavailable_obj)},
+    {MP_ROM_QSTR(MP_QSTR_isp),                 MP_ROM_PTR(&py_func_unavailable_obj)},
+    {MP_ROM_QSTR(MP_QSTR_get_isp_stats),       MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_gamma_corr),          MP_ROM_PTR(&py_func_unavailable_obj)},
     #endif // IMLIB_ENABLE_ISP_OPS
     /* Binary Methods */
     #ifdef IMLIB_ENABLE_BINARY_OPS
     {MP_ROM_QSTR(MP_QSTR_binary),              MP_ROM_PTR(&py_image_binary_obj)},
+    {MP_ROM_QSTR(MP_QSTR_adaptive_threshold),  MP_ROM_PTR(&py_image_adaptive_threshold_obj)},
     {MP_ROM_QSTR(MP_QSTR_invert),              MP_ROM_PTR(&py_image_invert_obj)},
     {MP_ROM_QSTR(MP_QSTR_and),                 MP_ROM_PTR(&py_image_b_and_obj)},
     {MP_ROM_QSTR(MP_QSTR_b_and),               MP_ROM_PTR(&py_image_b_and_obj)},
@@ -6346,6 +8480,7 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_close),               MP_ROM_PTR(&py_image_close_obj)},
     #else
     {MP_ROM_QSTR(MP_QSTR_binary),              MP_ROM_PTR(&py_func_unavailable_obj)},
+    {MP_ROM_QSTR(MP_QSTR_adaptive_threshold),  MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_invert),              MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_and),                 MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_b_and),               MP_ROM_PTR(&py_func_unavailable_obj)},
@@ -6377,6 +8512,7 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_max),                 MP_ROM_PTR(&py_image_max_obj)},
     {MP_ROM_QSTR(MP_QSTR_difference),          MP_ROM_PTR(&py_image_difference_obj)},
     {MP_ROM_QSTR(MP_QSTR_blend),               MP_ROM_PTR(&py_image_draw_image_obj)},
+    {MP_ROM_QSTR(MP_QSTR_hdr_fuse),            MP_ROM_PTR(&py_image_hdr_fuse_obj)},
     #else
     {MP_ROM_QSTR(MP_QSTR_negate),              MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_assign),              MP_ROM_PTR(&py_func_unavailable_obj)},
@@ -6388,6 +8524,7 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_max),                 MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_difference),          MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_blend),               MP_ROM_PTR(&py_func_unavailable_obj)},
+    {MP_ROM_QSTR(MP_QSTR_hdr_fuse),            MP_ROM_PTR(&py_func_unavailable_obj)},
     #endif
     #if defined(IMLIB_ENABLE_MATH_OPS) && defined(IMLIB_ENABLE_BINARY_OPS)
     {MP_ROM_QSTR(MP_QSTR_top_hat),             MP_ROM_PTR(&py_image_top_hat_obj)},
@@ -6418,6 +8555,8 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     #else
     {MP_ROM_QSTR(MP_QSTR_midpoint),            MP_ROM_PTR(&py_func_unavailable_obj)},
     #endif
+    {MP_ROM_QSTR(MP_QSTR_mean_pool),           MP_ROM_PTR(&py_image_mean_pool_obj)},
+    {MP_ROM_QSTR(MP_QSTR_midpoint_pool),       MP_ROM_PTR(&py_image_midpoint_pool_obj)},
     #ifdef IMLIB_ENABLE_MORPH
     {MP_ROM_QSTR(MP_QSTR_morph),               MP_ROM_PTR(&py_image_morph_obj)},
     #else
@@ -6470,12 +8609,15 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_get_similarity),      MP_ROM_PTR(&py_func_unavailable_obj)},
     #endif
     {MP_ROM_QSTR(MP_QSTR_get_hist),            MP_ROM_PTR(&py_image_get_histogram_obj)},
+    {MP_ROM_QSTR(MP_QSTR_get_hash),            MP_ROM_PTR(&py_image_get_hash_obj)},
     {MP_ROM_QSTR(MP_QSTR_get_histogram),       MP_ROM_PTR(&py_image_get_histogram_obj)},
     {MP_ROM_QSTR(MP_QSTR_histogram),           MP_ROM_PTR(&py_image_get_histogram_obj)},
     {MP_ROM_QSTR(MP_QSTR_get_stats),           MP_ROM_PTR(&py_image_get_statistics_obj)},
     {MP_ROM_QSTR(MP_QSTR_get_statistics),      MP_ROM_PTR(&py_image_get_statistics_obj)},
     {MP_ROM_QSTR(MP_QSTR_statistics),          MP_ROM_PTR(&py_image_get_statistics_obj)},
+    {MP_ROM_QSTR(MP_QSTR_get_dominant_colors), MP_ROM_PTR(&py_image_get_dominant_colors_obj)},
     {MP_ROM_QSTR(MP_QSTR_get_regression),      MP_ROM_PTR(&py_image_get_regression_obj)},
+    {MP_ROM_QSTR(MP_QSTR_gradients),           MP_ROM_PTR(&py_image_gradients_obj)},
     /* Find Methods */
     {MP_ROM_QSTR(MP_QSTR_find_blobs),          MP_ROM_PTR(&py_image_find_blobs_obj)},
     #ifdef IMLIB_ENABLE_FIND_LINES
@@ -6518,6 +8660,7 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     #else
     {MP_ROM_QSTR(MP_QSTR_find_barcodes),       MP_ROM_PTR(&py_func_unavailable_obj)},
     #endif
+    {MP_ROM_QSTR(MP_QSTR_find_codes),          MP_ROM_PTR(&py_image_find_codes_obj)},
     #ifdef IMLIB_ENABLE_FIND_DISPLACEMENT
     {MP_ROM_QSTR(MP_QSTR_find_displacement),   MP_ROM_PTR(&py_image_find_displacement_obj)},
     #else
@@ -6551,8 +8694,10 @@ static const mp_rom_map_elem_t locals_dict_table[] = {
     #endif
     #ifdef IMLIB_ENABLE_HOG
     {MP_ROM_QSTR(MP_QSTR_find_hog),            MP_ROM_PTR(&py_image_find_hog_obj)},
+    {MP_ROM_QSTR(MP_QSTR_get_hog),             MP_ROM_PTR(&py_image_get_hog_obj)},
     #else
     {MP_ROM_QSTR(MP_QSTR_find_hog),            MP_ROM_PTR(&py_func_unavailable_obj)},
+    {MP_ROM_QSTR(MP_QSTR_get_hog),             MP_ROM_PTR(&py_func_unavailable_obj)},
     #endif
     #ifdef IMLIB_ENABLE_SELECTIVE_SEARCH
     {MP_ROM_QSTR(MP_QSTR_selective_search),    MP_ROM_PTR(&py_image_selective_search_obj)},
@@ -6811,6 +8956,9 @@ mp_obj_t py_image(int w, int h, pixformat_t pixfmt, uint32_t size, void *pixels)
     o->_cobj.size = size;
     o->_cobj.pixfmt = pixfmt;
     o->_cobj.pixels = pixels;
+    o->_cobj.stride = 0;
+    o->parent = MP_OBJ_NULL;
+    o->owner = MP_OBJ_NULL;
     return o;
 }
 
@@ -6818,6 +8966,8 @@ mp_obj_t py_image_from_struct(image_t *img) {
     py_image_obj_t *o = m_new_obj(py_image_obj_t);
     o->base.type = &py_image_type;
     o->_cobj = *img;
+    o->parent = MP_OBJ_NULL;
+    o->owner = MP_OBJ_NULL;
     return o;
 }
 
@@ -6894,8 +9044,16 @@ mp_obj_t py_image_load_descriptor(uint n_args, const mp_obj_t *args, mp_map_t *k
                 py_kp_obj_t *kp_obj = m_new_obj(py_kp_obj_t);
                 kp_obj->base.type = &py_kp_type;
                 kp_obj->kpts = kpts;
+                kp_obj->index = NULL;
                 kp_obj->threshold = 10;
                 kp_obj->normalized = false;
+
+                // Saved descriptors are matched against many frames, index large ones once.
+                size_t index_size = orb_index_size(kpts);
+                if (index_size) {
+                    kp_obj->index = m_new_obj(orb_index_t);
+                    orb_index_build(kp_obj->index, kpts, m_new(uint8_t, index_size));
+                }
                 desc = kp_obj;
             }
             break;
@@ -6978,6 +9136,45 @@ static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_save_descriptor_obj, 2, py_image_save
 
 static mp_obj_t py_image_match_descriptor(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     mp_obj_t match_obj = mp_const_none;
+
+    #if defined(IMLIB_ENABLE_FIND_LBP)
+    // Match one descriptor against a list of descriptors, returns the k closest.
+    if (mp_obj_is_type(args[1], &mp_type_list) || mp_obj_is_type(args[1], &mp_type_tuple)) {
+        PY_ASSERT_TYPE(args[0], &py_lbp_type);
+        int k = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_k), 1);
+        PY_ASSERT_TRUE_MSG(k > 0, "k must be > 0!");
+
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_get_array(args[1], &len, &items);
+        k = IM_MIN(k, len);
+
+        fb_alloc_mark();
+        uint8_t **gallery = fb_alloc(len * sizeof(uint8_t *), FB_ALLOC_NO_HINT);
+        int *index = fb_alloc(k * sizeof(int), FB_ALLOC_NO_HINT);
+        int *distance = fb_alloc(k * sizeof(int), FB_ALLOC_NO_HINT);
+
+        for (size_t i = 0; i < len; i++) {
+            PY_ASSERT_TYPE(items[i], &py_lbp_type);
+            gallery[i] = ((py_lbp_obj_t *) items[i])->hist;
+        }
+
+        int count = imlib_lbp_desc_match(((py_lbp_obj_t *) args[0])->hist, gallery, len, k, index, distance);
+
+        mp_obj_t match_list = mp_obj_new_list(0, NULL);
+        for (int i = 0; i < count; i++) {
+            mp_obj_t match[2] = {
+                mp_obj_new_int(index[i]),
+                mp_obj_new_int(distance[i]),
+            };
+            mp_obj_list_append(match_list, mp_obj_new_tuple(2, match));
+        }
+
+        fb_alloc_free_till_mark();
+        return match_list;
+    }
+    #endif //IMLIB_ENABLE_FIND_LBP
+
     const mp_obj_type_t *desc1_type = mp_obj_get_type(args[0]);
     const mp_obj_type_t *desc2_type = mp_obj_get_type(args[1]);
     PY_ASSERT_TRUE_MSG((desc1_type == desc2_type), "Descriptors have different types!");
@@ -7019,7 +9216,7 @@ static mp_obj_t py_image_match_descriptor(uint n_args, const mp_obj_t *args, mp_
             int *match = fb_alloc(array_length(kpts1->kpts) * sizeof(int) * 2, FB_ALLOC_NO_HINT);
 
             // Match the two keypoint sets
-            count = orb_match_keypoints(kpts1->kpts, kpts2->kpts, match, threshold, &r, &c, &theta);
+            count = orb_match_keypoints(kpts1->kpts, kpts1->index, kpts2->kpts, kpts2->index, match, threshold, &r, &c, &theta);
 
             // Add matching keypoints to Python list.
             for (int i = 0; i < count * 2; i += 2) {
@@ -7060,10 +9257,155 @@ static mp_obj_t py_image_match_descriptor(uint n_args, const mp_obj_t *args, mp_
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_match_descriptor_obj, 2, py_image_match_descriptor);
 #endif //IMLIB_ENABLE_DESCRIPTOR
 
+#ifdef IMLIB_ENABLE_BINARY_OPS
+// Pipeline Object //
+typedef struct py_pipeline_obj {
+    mp_obj_base_t base;
+    size_t n_stages;
+    imlib_pipeline_stage_t *stages;
+} py_pipeline_obj_t;
+
+static void py_pipeline_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_pipeline_obj_t *self = self_in;
+    mp_printf(print, "{\"stages\":%d}", self->n_stages);
+}
+
+static void py_pipeline_parse_kernel(imlib_pipeline_stage_t *stage, mp_obj_t kernel, float mul, float add) {
+    int n = (stage->ksize * 2) + 1;
+    int sum = 0;
+
+    size_t len;
+    mp_obj_t *items;
+    mp_obj_get_array(kernel, &len, &items);
+
+    if (len != (n * n)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unexpected kernel dimensions!"));
+    }
+
+    for (int i = 0; i < (n * n); i++) {
+        stage->krn[i] = mp_obj_get_int(items[i]);
+        sum += stage->krn[i];
+    }
+
+    if (sum == 0) {
+        sum = 1;
+    }
+
+    stage->m_int = fast_roundf(65536 * (mul / sum));
+    stage->b_int = fast_roundf(65536 * add);
+}
+
+static void py_pipeline_parse_stage(imlib_pipeline_stage_t *stage, mp_obj_t arg) {
+    size_t len;
+    mp_obj_t *items;
+    mp_obj_get_array(arg, &len, &items);
+    PY_ASSERT_TRUE_MSG(len >= 1, "Expected a (name, args...) tuple!");
+
+    qstr name = mp_obj_str_get_qstr(items[0]);
+    int ksize = (len > 1) ? py_helper_arg_to_ksize(items[1]) : 0;
+    int n = (ksize * 2) + 1;
+
+    if (n > 31) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Kernel size too large!"));
+    }
+
+    if ((name == MP_QSTR_gaussian) && (len == 2)) {
+        stage->op = IMLIB_PIPELINE_OP_MORPH;
+        stage->ksize = ksize;
+        stage->krn = m_new(int, n * n);
+
+        int pascal[n];
+        pascal[0] = 1;
+
+        for (int i = 0; i < (ksize * 2); i++) {
+            // Compute a row of pascal's triangle.
+            pascal[i + 1] = (pascal[i] * ((ksize * 2) - i)) / (i + 1);
+        }
+
+        int sum = 0;
+
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                int temp = pascal[i] * pascal[j];
+                stage->krn[(i * n) + j] = temp;
+                sum += temp;
+            }
+        }
+
+        stage->m_int = fast_roundf(65536 * (1.0f / sum));
+        stage->b_int = 0;
+    } else if ((name == MP_QSTR_morph) && (len >= 3) && (len <= 5)) {
+        stage->op = IMLIB_PIPELINE_OP_MORPH;
+        stage->ksize = ksize;
+        stage->krn = m_new(int, n * n);
+        py_pipeline_parse_kernel(stage, items[2],
+                                 (len > 3) ? mp_obj_get_float(items[3]) : 1.0f,
+                                 (len > 4) ? mp_obj_get_float(items[4]) : 0.0f);
+    } else if ((name == MP_QSTR_binary) && (len >= 2) && (len <= 4)) {
+        list_t thresholds;
+        list_init(&thresholds, sizeof(color_thresholds_list_lnk_data_t));
+        py_helper_arg_to_thresholds(items[1], &thresholds);
+        imlib_pipeline_lut_binary(stage, &thresholds,
+                                  (len > 2) ? mp_obj_is_true(items[2]) : false,
+                                  (len > 3) ? mp_obj_is_true(items[3]) : false);
+        list_free(&thresholds);
+    } else if ((name == MP_QSTR_invert) && (len == 1)) {
+        imlib_pipeline_lut_invert(stage);
+    } else if (((name == MP_QSTR_erode) || (name == MP_QSTR_dilate)) && (len >= 2) && (len <= 3)) {
+        stage->op = (name == MP_QSTR_erode) ? IMLIB_PIPELINE_OP_ERODE : IMLIB_PIPELINE_OP_DILATE;
+        stage->ksize = ksize;
+        stage->threshold = (len > 2) ? mp_obj_get_int(items[2]) : 0;
+    } else {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unsupported pipeline stage!"));
+    }
+}
+
+static mp_obj_t py_pipeline_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
+    mp_arg_check_num(n_args, n_kw, 1, 1, false);
+
+    size_t len;
+    mp_obj_t *items;
+    mp_obj_get_array(args[0], &len, &items);
+    PY_ASSERT_TRUE_MSG(len >= 1, "Pipeline must have at least one stage!");
+
+    py_pipeline_obj_t *o = mp_obj_malloc(py_pipeline_obj_t, type);
+    o->n_stages = len;
+    o->stages = m_new0(imlib_pipeline_stage_t, len);
+
+    for (size_t i = 0; i < len; i++) {
+        py_pipeline_parse_stage(&o->stages[i], items[i]);
+    }
+
+    return MP_OBJ_FROM_PTR(o);
+}
+
+static mp_obj_t py_pipeline_run(mp_obj_t self_in, mp_obj_t img_obj) {
+    py_pipeline_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    image_t *img = py_helper_arg_to_image(img_obj, ARG_IMAGE_GRAYSCALE);
+    imlib_pipeline(img, self->stages, self->n_stages);
+    return img_obj;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(py_pipeline_run_obj, py_pipeline_run);
+
+static const mp_rom_map_elem_t py_pipeline_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_run), MP_ROM_PTR(&py_pipeline_run_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_pipeline_locals_dict, py_pipeline_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_pipeline_type,
+    MP_QSTR_Pipeline,
+    MP_TYPE_FLAG_NONE,
+    print, py_pipeline_print,
+    make_new, py_pipeline_make_new,
+    locals_dict, &py_pipeline_locals_dict
+    );
+#endif // IMLIB_ENABLE_BINARY_OPS
+
 #if defined(IMLIB_ENABLE_FIND_KEYPOINTS) && defined(IMLIB_ENABLE_IMAGE_FILE_IO)
 int py_image_descriptor_from_roi(image_t *img, const char *path, rectangle_t *roi) {
     FIL fp;
-    array_t *kpts = orb_find_keypoints(img, false, 20, 1.5f, 100, CORNER_AGAST, roi);
+    array_t *kpts = orb_find_keypoints(img, false, 20, 1.5f, 100, CORNER_AGAST, roi, NULL);
     if (array_length(kpts)) {
         file_open(&fp, path, false, FA_WRITE | FA_CREATE_ALWAYS);
         FRESULT res = orb_save_descriptor(&fp, kpts);
@@ -7077,11 +9419,73 @@ int py_image_descriptor_from_roi(image_t *img, const char *path, rectangle_t *ro
 }
 #endif // IMLIB_ENABLE_KEYPOINTS && IMLIB_ENABLE_IMAGE_FILE_IO
 
+static mp_obj_t py_image_kmeans(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+    size_t n;
+    mp_obj_t *items;
+    mp_obj_get_array(args[0], &n, &items);
+    int k = mp_obj_get_int(args[1]);
+    int iterations = py_helper_keyword_int(n_args, args, 2, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_iterations), 32);
+    int batch = py_helper_keyword_int(n_args, args, 3, kw_args, MP_OBJ_NEW_QSTR(MP_QSTR_batch), 0);
+    PY_ASSERT_TRUE_MSG((k >= 1) && (k <= n), "k must be between 1 and the number of points");
+    PY_ASSERT_TRUE_MSG(k <= UINT16_MAX, "k is too large");
+
+    // Points are blobs (clustered by centroid) or tuples with up to 4 integer coordinates.
+    int dims = 2;
+    if (!mp_obj_is_type(items[0], &py_blob_type)) {
+        dims = mp_obj_get_int(mp_obj_len(items[0]));
+        PY_ASSERT_TRUE_MSG((dims >= 1) && (dims <= 4), "Points must have between 1 and 4 coordinates");
+    }
+
+    fb_alloc_mark();
+    int16_t *points = fb_alloc(n * dims * sizeof(int16_t), FB_ALLOC_NO_HINT);
+    uint16_t *labels = fb_alloc(n * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+    uint32_t *counts = fb_alloc(k * sizeof(uint32_t), FB_ALLOC_NO_HINT);
+    float *centroids = fb_alloc(k * dims * sizeof(float), FB_ALLOC_NO_HINT);
+
+    for (size_t i = 0; i < n; i++) {
+        if (mp_obj_is_type(items[i], &py_blob_type)) {
+            PY_ASSERT_TRUE_MSG(dims == 2, "Points must have the same number of coordinates");
+            points[i] = fast_roundf(mp_obj_get_float(((py_blob_obj_t *) items[i])->cx));
+            points[n + i] = fast_roundf(mp_obj_get_float(((py_blob_obj_t *) items[i])->cy));
+        } else {
+            size_t len;
+            mp_obj_t *coords;
+            mp_obj_get_array(items[i], &len, &coords);
+            PY_ASSERT_TRUE_MSG(len == dims, "Points must have the same number of coordinates");
+            for (int d = 0; d < dims; d++) {
+                points[(d * n) + i] = mp_obj_get_int(coords[d]);
+            }
+        }
+    }
+
+    imlib_kmeans(points, n, dims, k, batch, iterations, centroids, labels, counts);
+
+    // Returns the centroids and the cluster index of each point.
+    mp_obj_t centroids_list = mp_obj_new_list(k, NULL);
+    for (int j = 0; j < k; j++) {
+        mp_obj_t centroid[4];
+        for (int d = 0; d < dims; d++) {
+            centroid[d] = mp_obj_new_int(fast_roundf(centroids[(d * k) + j]));
+        }
+        ((mp_obj_list_t *) centroids_list)->items[j] = mp_obj_new_tuple(dims, centroid);
+    }
+
+    mp_obj_t labels_list = mp_obj_new_list(n, NULL);
+    for (size_t i = 0; i < n; i++) {
+        ((mp_obj_list_t *) labels_list)->items[i] = mp_obj_new_int(labels[i]);
+    }
+
+    fb_alloc_free_till_mark();
+    return mp_obj_new_tuple(2, (mp_obj_t []) {centroids_list, labels_list});
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_image_kmeans_obj, 2, py_image_kmeans);
+
 static const mp_rom_map_elem_t globals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR___name__),            MP_OBJ_NEW_QSTR(MP_QSTR_image)},
     // Pixel formats
     {MP_ROM_QSTR(MP_QSTR_BINARY),              MP_ROM_INT(PIXFORMAT_BINARY)},   /* 1BPP/BINARY*/
     {MP_ROM_QSTR(MP_QSTR_GRAYSCALE),           MP_ROM_INT(PIXFORMAT_GRAYSCALE)},/* 1BPP/GRAYSCALE*/
+    {MP_ROM_QSTR(MP_QSTR_GRAYSCALE16),         MP_ROM_INT(PIXFORMAT_GRAYSCALE16)},/* 2BPP/GRAYSCALE16*/
     {MP_ROM_QSTR(MP_QSTR_RGB565),              MP_ROM_INT(PIXFORMAT_RGB565)},   /* 2BPP/RGB565*/
     {MP_ROM_QSTR(MP_QSTR_BAYER),               MP_ROM_INT(PIXFORMAT_BAYER)},    /* 1BPP/RAW*/
     {MP_ROM_QSTR(MP_QSTR_YUV422),              MP_ROM_INT(PIXFORMAT_YUV422)},   /* 2BPP/YUV422*/
@@ -7109,12 +9513,25 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_JPEG_SUBSAMPLING_444), MP_ROM_INT(JPEG_SUBSAMPLING_444)},
     {MP_ROM_QSTR(MP_QSTR_JPEG_SUBSAMPLING_422), MP_ROM_INT(JPEG_SUBSAMPLING_422)},
     {MP_ROM_QSTR(MP_QSTR_JPEG_SUBSAMPLING_420), MP_ROM_INT(JPEG_SUBSAMPLING_420)},
+    {MP_ROM_QSTR(MP_QSTR_PNG_EFFORT_STORED),   MP_ROM_INT(PNG_EFFORT_STORED)},
+    {MP_ROM_QSTR(MP_QSTR_PNG_EFFORT_FAST),     MP_ROM_INT(PNG_EFFORT_FAST)},
+    {MP_ROM_QSTR(MP_QSTR_PNG_EFFORT_BEST),     MP_ROM_INT(PNG_EFFORT_BEST)},
     #ifdef IMLIB_FIND_TEMPLATE
     {MP_ROM_QSTR(MP_QSTR_SEARCH_EX),           MP_ROM_INT(SEARCH_EX)},
     {MP_ROM_QSTR(MP_QSTR_SEARCH_DS),           MP_ROM_INT(SEARCH_DS)},
     #endif
+    {MP_ROM_QSTR(MP_QSTR_QRCODES),             MP_ROM_INT(FIND_CODES_QRCODES)},
+    {MP_ROM_QSTR(MP_QSTR_APRILTAGS),           MP_ROM_INT(FIND_CODES_APRILTAGS)},
+    {MP_ROM_QSTR(MP_QSTR_DATAMATRICES),        MP_ROM_INT(FIND_CODES_DATAMATRICES)},
+    {MP_ROM_QSTR(MP_QSTR_BARCODES),            MP_ROM_INT(FIND_CODES_BARCODES)},
     {MP_ROM_QSTR(MP_QSTR_EDGE_CANNY),          MP_ROM_INT(EDGE_CANNY)},
     {MP_ROM_QSTR(MP_QSTR_EDGE_SIMPLE),         MP_ROM_INT(EDGE_SIMPLE)},
+    {MP_ROM_QSTR(MP_QSTR_ADAPTIVE_BRADLEY),    MP_ROM_INT(ADAPTIVE_BRADLEY)},
+    {MP_ROM_QSTR(MP_QSTR_ADAPTIVE_SAUVOLA),    MP_ROM_INT(ADAPTIVE_SAUVOLA)},
+    {MP_ROM_QSTR(MP_QSTR_REGRESSION_LEAST_SQUARES), MP_ROM_INT(REGRESSION_LEAST_SQUARES)},
+    {MP_ROM_QSTR(MP_QSTR_REGRESSION_THEIL_SEN), MP_ROM_INT(REGRESSION_THEIL_SEN)},
+    {MP_ROM_QSTR(MP_QSTR_REGRESSION_THEIL_SEN_SAMPLED), MP_ROM_INT(REGRESSION_THEIL_SEN_SAMPLED)},
+    {MP_ROM_QSTR(MP_QSTR_REGRESSION_RANSAC),   MP_ROM_INT(REGRESSION_RANSAC)},
     {MP_ROM_QSTR(MP_QSTR_CORNER_FAST),         MP_ROM_INT(CORNER_FAST)},
     {MP_ROM_QSTR(MP_QSTR_CORNER_AGAST),        MP_ROM_INT(CORNER_AGAST)},
     #ifdef IMLIB_ENABLE_APRILTAGS
@@ -7144,11 +9561,45 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_CODE128),             MP_ROM_INT(BARCODE_CODE128)},
     #endif
     {MP_ROM_QSTR(MP_QSTR_Image),               MP_ROM_PTR(&py_image_type)},
+    {MP_ROM_QSTR(MP_QSTR_Pool),                MP_ROM_PTR(&py_image_pool_type)},
+    {MP_ROM_QSTR(MP_QSTR_BlobTracker),         MP_ROM_PTR(&py_blob_tracker_type)},
+    {MP_ROM_QSTR(MP_QSTR_BlobFinder),          MP_ROM_PTR(&py_blob_finder_type)},
+    {MP_ROM_QSTR(MP_QSTR_MotionDetector),      MP_ROM_PTR(&py_motion_type)},
+    #ifdef IMLIB_ENABLE_FIND_DISPLACEMENT
+    {MP_ROM_QSTR(MP_QSTR_PhaseCorrelator),     MP_ROM_PTR(&py_phasecorr_type)},
+    {MP_ROM_QSTR(MP_QSTR_OpticalFlow),         MP_ROM_PTR(&py_optflow_type)},
+    #else
+    {MP_ROM_QSTR(MP_QSTR_PhaseCorrelator),     MP_ROM_PTR(&py_func_unavailable_obj)},
+    {MP_ROM_QSTR(MP_QSTR_OpticalFlow),         MP_ROM_PTR(&py_func_unavailable_obj)},
+    #endif
+    #ifdef IMLIB_ENABLE_APRILTAGS
+    {MP_ROM_QSTR(MP_QSTR_AprilTagTracker),     MP_ROM_PTR(&py_apriltag_tracker_type)},
+    {MP_ROM_QSTR(MP_QSTR_AprilTagDetector),    MP_ROM_PTR(&py_apriltag_detector_type)},
+    #else
+    {MP_ROM_QSTR(MP_QSTR_AprilTagTracker),     MP_ROM_PTR(&py_func_unavailable_obj)},
+    {MP_ROM_QSTR(MP_QSTR_AprilTagDetector),    MP_ROM_PTR(&py_func_unavailable_obj)},
+    #endif
+    #ifdef IMLIB_ENABLE_LENS_CORR
+    {MP_ROM_QSTR(MP_QSTR_LensCorrection),      MP_ROM_PTR(&py_lens_corr_type)},
+    #else
+    {MP_ROM_QSTR(MP_QSTR_LensCorrection),      MP_ROM_PTR(&py_func_unavailable_obj)},
+    #endif
     #if defined(IMLIB_ENABLE_IMAGE_IO)
     {MP_ROM_QSTR(MP_QSTR_ImageIO),             MP_ROM_PTR(&py_imageio_type) },
     #else
     {MP_ROM_QSTR(MP_QSTR_ImageIO),             MP_ROM_PTR(&py_func_unavailable_obj)},
     #endif
+    #ifdef IMLIB_ENABLE_FIND_KEYPOINTS
+    {MP_ROM_QSTR(MP_QSTR_Pyramid),             MP_ROM_PTR(&py_pyramid_type)},
+    #else
+    {MP_ROM_QSTR(MP_QSTR_Pyramid),             MP_ROM_PTR(&py_func_unavailable_obj)},
+    #endif
+    #ifdef IMLIB_ENABLE_BINARY_OPS
+    {MP_ROM_QSTR(MP_QSTR_Pipeline),            MP_ROM_PTR(&py_pipeline_type)},
+    #else
+    {MP_ROM_QSTR(MP_QSTR_Pipeline),            MP_ROM_PTR(&py_func_unavailable_obj)},
+    #endif
+    {MP_ROM_QSTR(MP_QSTR_timed_out),           MP_ROM_PTR(&py_image_timed_out_obj)},
     {MP_ROM_QSTR(MP_QSTR_binary_to_grayscale), MP_ROM_PTR(&py_image_binary_to_grayscale_obj)},
     {MP_ROM_QSTR(MP_QSTR_binary_to_rgb),       MP_ROM_PTR(&py_image_binary_to_rgb_obj)},
     {MP_ROM_QSTR(MP_QSTR_binary_to_lab),       MP_ROM_PTR(&py_image_binary_to_lab_obj)},
@@ -7179,6 +9630,8 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     {MP_ROM_QSTR(MP_QSTR_load_descriptor),     MP_ROM_PTR(&py_func_unavailable_obj)},
     {MP_ROM_QSTR(MP_QSTR_save_descriptor),     MP_ROM_PTR(&py_func_unavailable_obj)},
     #endif //IMLIB_ENABLE_DESCRIPTOR && IMLIB_ENABLE_IMAGE_FILE_IO
+    {MP_ROM_QSTR(MP_QSTR_kmeans),              MP_ROM_PTR(&py_image_kmeans_obj)},
+    {MP_ROM_QSTR(MP_QSTR_hash_distance),       MP_ROM_PTR(&py_image_hash_distance_obj)},
     #if defined(IMLIB_ENABLE_DESCRIPTOR)
     {MP_ROM_QSTR(MP_QSTR_match_descriptor),    MP_ROM_PTR(&py_image_match_descriptor_obj)}
     #else
@@ -7194,3 +9647,4 @@ const mp_obj_module_t image_module = {
 };
 
 MP_REGISTER_MODULE(MP_QSTR_image, image_module);
+MP_REGISTER_ROOT_POINTER(struct py_motion_obj *motion_capture);
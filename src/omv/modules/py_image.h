@@ -12,8 +12,11 @@
 #define __PY_IMAGE_H__
 #include "imlib.h"
 extern const mp_obj_type_t py_image_type;
+extern const mp_obj_type_t py_image_pool_type;
 mp_obj_t py_image(int width, int height, pixformat_t pixfmt, uint32_t size, void *pixels);
 mp_obj_t py_image_from_struct(image_t *img);
 void *py_image_cobj(mp_obj_t img_obj);
+void py_image_unshare(mp_obj_t img_obj);
 int py_image_descriptor_from_roi(image_t *img, const char *path, rectangle_t *roi);
+void *py_image_pool_alloc(mp_obj_t pool_obj, size_t size);
 #endif // __PY_IMAGE_H__
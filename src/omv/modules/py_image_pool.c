@@ -0,0 +1,181 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Image pool Python module.
+ *
+ * A pool preallocates a fixed number of image buffers of the same geometry once, and hands
+ * them out with acquire() or as the destination of copy()/crop()/to_*() (pool=...). Buffers
+ * are returned with release(). Since no pixel storage is allocated per frame the GC heap is
+ * not churned and collections don't stall the frame loop. The pool must outlive its images.
+ */
+#include <string.h>
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "py_assert.h"
+#include "py_helper.h"
+#include "py_image.h"
+#include "xalloc.h"
+#include "omv_common.h"
+
+#define IMAGE_POOL_MAX_COUNT    (32)
+
+typedef struct py_image_pool_obj {
+    mp_obj_base_t base;
+    image_t image;      // Geometry of the pool images.
+    uint8_t *buffer;    // Pool memory allocated once.
+    uint8_t *slots;     // First slot (aligned).
+    size_t slot_size;
+    uint32_t count;
+    uint32_t used;      // Bitmap of the acquired slots.
+} py_image_pool_obj_t;
+
+static void *py_image_pool_get_slot(py_image_pool_obj_t *pool) {
+    for (uint32_t i = 0; i < pool->count; i++) {
+        if (!(pool->used & (1 << i))) {
+            pool->used |= 1 << i;
+            return pool->slots + (i * pool->slot_size);
+        }
+    }
+
+    mp_raise_msg(&mp_type_MemoryError, MP_ERROR_TEXT("No free images in the pool"));
+}
+
+void *py_image_pool_alloc(mp_obj_t pool_obj, size_t size) {
+    if (!mp_obj_is_type(pool_obj, &py_image_pool_type)) {
+        mp_raise_msg(&mp_type_TypeError, MP_ERROR_TEXT("Expected an image pool"));
+    }
+
+    py_image_pool_obj_t *pool = MP_OBJ_TO_PTR(pool_obj);
+
+    if (size > pool->slot_size) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("The image doesn't fit in the pool!"));
+    }
+
+    return py_image_pool_get_slot(pool);
+}
+
+static void py_image_pool_print(const mp_print_t *print, mp_obj_t self, mp_print_kind_t kind) {
+    py_image_pool_obj_t *pool = MP_OBJ_TO_PTR(self);
+    mp_printf(print, "{\"w\":%d, \"h\":%d, \"pixformat\":%u, \"count\":%u, \"available\":%u, \"size\":%u}",
+              pool->image.w,
+              pool->image.h,
+              pool->image.pixfmt,
+              pool->count,
+              pool->count - __builtin_popcount(pool->used),
+              pool->slot_size);
+}
+
+static mp_obj_t py_image_pool_acquire(mp_obj_t self) {
+    py_image_pool_obj_t *pool = MP_OBJ_TO_PTR(self);
+    image_t image = pool->image;
+    image.data = py_image_pool_get_slot(pool);
+    return py_image_from_struct(&image);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_image_pool_acquire_obj, py_image_pool_acquire);
+
+static mp_obj_t py_image_pool_release(mp_obj_t self, mp_obj_t img_obj) {
+    py_image_pool_obj_t *pool = MP_OBJ_TO_PTR(self);
+    image_t *image = py_image_cobj(img_obj);
+    uint8_t *data = image->data;
+
+    if ((data < pool->slots)
+        || (data >= (pool->slots + (pool->count * pool->slot_size)))
+        || ((data - pool->slots) % pool->slot_size)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Image is not from this pool"));
+    }
+
+    uint32_t i = (data - pool->slots) / pool->slot_size;
+
+    if (!(pool->used & (1 << i))) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Image was already released"));
+    }
+
+    pool->used &= ~(1 << i);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(py_image_pool_release_obj, py_image_pool_release);
+
+static mp_obj_t py_image_pool_available(mp_obj_t self) {
+    py_image_pool_obj_t *pool = MP_OBJ_TO_PTR(self);
+    return mp_obj_new_int(pool->count - __builtin_popcount(pool->used));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_image_pool_available_obj, py_image_pool_available);
+
+static mp_obj_t py_image_pool_count(mp_obj_t self) {
+    py_image_pool_obj_t *pool = MP_OBJ_TO_PTR(self);
+    return mp_obj_new_int(pool->count);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_image_pool_count_obj, py_image_pool_count);
+
+static mp_obj_t py_image_pool_size(mp_obj_t self) {
+    py_image_pool_obj_t *pool = MP_OBJ_TO_PTR(self);
+    return mp_obj_new_int(pool->slot_size);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_image_pool_size_obj, py_image_pool_size);
+
+static mp_obj_t py_image_pool_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_width, ARG_height, ARG_pixformat, ARG_count };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_height, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+        { MP_QSTR_pixformat, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = PIXFORMAT_INVALID } },
+        { MP_QSTR_count, MP_ARG_REQUIRED | MP_ARG_INT, {.u_int = 0 } },
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    image_t image = {
+        .w = args[ARG_width].u_int,
+        .h = args[ARG_height].u_int,
+        .pixfmt = args[ARG_pixformat].u_int,
+        .size = 0,
+        .data = NULL,
+    };
+
+    PY_ASSERT_TRUE_MSG(image.w > 0, "Image width must be > 0");
+    PY_ASSERT_TRUE_MSG(image.h > 0, "Image height must be > 0");
+    PY_ASSERT_TRUE_MSG(IMLIB_PIXFORMAT_IS_VALID(image.pixfmt), "Pixel format is not set or unsupported");
+    PY_ASSERT_FALSE_MSG(image.is_compressed, "Compressed pixel formats are not supported");
+    PY_ASSERT_TRUE_MSG((args[ARG_count].u_int > 0) && (args[ARG_count].u_int <= IMAGE_POOL_MAX_COUNT),
+                       "Image count must be between 1 and 32");
+
+    py_image_pool_obj_t *pool = mp_obj_malloc(py_image_pool_obj_t, &py_image_pool_type);
+    pool->image = image;
+    pool->count = args[ARG_count].u_int;
+    pool->used = 0;
+
+    // Each slot starts on a cache line so the images can be used with DMA.
+    pool->slot_size = ((image_size(&image) + OMV_ALLOC_ALIGNMENT - 1) / OMV_ALLOC_ALIGNMENT) * OMV_ALLOC_ALIGNMENT;
+    pool->buffer = xalloc((pool->slot_size * pool->count) + OMV_ALLOC_ALIGNMENT - 1);
+    pool->slots = pool->buffer + ((OMV_ALLOC_ALIGNMENT - (((uint32_t) pool->buffer) % OMV_ALLOC_ALIGNMENT))
+                                  % OMV_ALLOC_ALIGNMENT);
+
+    return MP_OBJ_FROM_PTR(pool);
+}
+
+static const mp_rom_map_elem_t py_image_pool_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_acquire),         MP_ROM_PTR(&py_image_pool_acquire_obj)   },
+    { MP_ROM_QSTR(MP_QSTR_release),         MP_ROM_PTR(&py_image_pool_release_obj)   },
+    { MP_ROM_QSTR(MP_QSTR_available),       MP_ROM_PTR(&py_image_pool_available_obj) },
+    { MP_ROM_QSTR(MP_QSTR_count),           MP_ROM_PTR(&py_image_pool_count_obj)     },
+    { MP_ROM_QSTR(MP_QSTR_size),            MP_ROM_PTR(&py_image_pool_size_obj)      },
+};
+
+static MP_DEFINE_CONST_DICT(py_image_pool_locals_dict, py_image_pool_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    py_image_pool_type,
+    MP_QSTR_Pool,
+    MP_TYPE_FLAG_NONE,
+    print, py_image_pool_print,
+    make_new, py_image_pool_make_new,
+    locals_dict, &py_image_pool_locals_dict
+    );
@@ -26,6 +26,7 @@
 #endif
 #include "framebuffer.h"
 #include "omv_boardconfig.h"
+#include "omv_task.h"
 
 #define OLD_BINARY_BPP          0
 #define OLD_GRAYSCALE_BPP       1
@@ -36,10 +37,26 @@
 #define MAGIC_SIZE              16
 #define ALIGN_SIZE              16
 #define AFTER_SIZE_PADDING      12
+#define FRAME_HEADER_SIZE       (20 + AFTER_SIZE_PADDING)
 
 #define ORIGINAL_VER            10
 #define RGB565_FIXED_VER        11
 #define NEW_PIXFORMAT_VER       20
+#define FRAME_INDEX_VER         21
+
+// V2.1 files may end with a frame index which is an array of frame offsets followed by a
+// trailer holding the index magic and the frame count.
+#define INDEX_MAGIC             "OMV IMG IDX "
+#define INDEX_TRAILER_SIZE      16
+#define INDEX_GROW_SIZE         256
+#define PREFETCH_CHUNK_SIZE     (16 * 1024) // Bytes read ahead per background fill.
+#define PREFETCH_FILL_SIZE      (2 * 1024) // Bytes read ahead per step while pausing.
+
+// Frame compression, stored in the frame padding (zero in older files).
+#define IMAGE_IO_RAW            0
+#define IMAGE_IO_JPEG           1
+#define IMAGE_IO_PNG            2
+#define IMAGE_IO_RLE            3
 
 #ifndef __DCACHE_PRESENT
 #define IMAGE_ALIGNMENT         32 // Use 32-byte alignment on MCUs with no cache for DMA buffer alignment.
@@ -67,11 +84,25 @@ typedef struct py_imageio_obj {
     uint32_t count;
     uint32_t offset;
     uint32_t ms;
+    uint64_t hash;  // Hash of the last frame written with skip_threshold.
+    bool hashed;
     union {
         #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
         struct {
             FIL fp;
             int version;
+            uint32_t index_offset; // Offset of the frame index in the file or 0 if it has none.
+            uint32_t *index;       // Offsets of the frames written, written as the index on close.
+            uint32_t index_count;
+            uint32_t index_alloc;
+            bool index_enabled;
+            bool upgrade;
+            // Read-ahead ring holding the file data past the stream position.
+            uint8_t *ring;
+            uint32_t ring_size;
+            uint32_t ring_head;
+            uint32_t ring_tail;
+            uint32_t ring_used;
         };
         #endif
         struct {
@@ -91,6 +122,208 @@ static py_imageio_obj_t *py_imageio_obj(mp_obj_t self) {
     return stream;
 }
 
+#if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
+// The file stream that the background task fills the read-ahead ring of. This is not a root
+// pointer, if the stream is collected its finaliser closes it and clears this.
+static py_imageio_obj_t *py_imageio_prefetch_stream;
+static bool int_py_imageio_prefetch_task(omv_task_t *task);
+
+static omv_task_t py_imageio_prefetch_task_obj = {
+    .func = int_py_imageio_prefetch_task,
+    .priority = OMV_TASK_PRIORITY_LOW,
+};
+
+// The stream position, the file position is ahead of it by the read-ahead data.
+static uint32_t int_py_imageio_tell(py_imageio_obj_t *stream) {
+    return f_tell(&stream->fp) - stream->ring_used;
+}
+
+static bool int_py_imageio_eof(py_imageio_obj_t *stream) {
+    FIL *fp = &stream->fp;
+    uint32_t end = stream->index_offset ? stream->index_offset : f_size(fp);
+    return int_py_imageio_tell(stream) >= end;
+}
+
+static void int_py_imageio_seek(py_imageio_obj_t *stream, uint32_t offset) {
+    stream->ring_head = 0;
+    stream->ring_tail = 0;
+    stream->ring_used = 0;
+    file_seek(&stream->fp, offset);
+}
+
+// Drops the read-ahead data, the file position is the stream position afterwards.
+static void int_py_imageio_drop_prefetch(py_imageio_obj_t *stream) {
+    if (stream->ring_used) {
+        int_py_imageio_seek(stream, int_py_imageio_tell(stream));
+    }
+}
+
+// Reads up to max_size bytes ahead into the ring, returns false at the end of the file
+// or on errors (which are raised by the read that runs into them).
+static bool int_py_imageio_fill(py_imageio_obj_t *stream, uint32_t max_size) {
+    FIL *fp = &stream->fp;
+
+    // Only the frame data is read ahead, not the index.
+    uint32_t end = stream->index_offset ? stream->index_offset : f_size(fp);
+    uint32_t size = IM_MIN(stream->ring_size - stream->ring_used, stream->ring_size - stream->ring_head);
+    size = IM_MIN(IM_MIN(size, max_size), end - IM_MIN(f_tell(fp), end));
+
+    UINT bytes;
+    if ((!size) || (f_read(fp, stream->ring + stream->ring_head, size, &bytes) != FR_OK) || (!bytes)) {
+        return false;
+    }
+
+    stream->ring_head = (stream->ring_head + bytes) % stream->ring_size;
+    stream->ring_used += bytes;
+    return true;
+}
+
+static bool int_py_imageio_prefetch_task(omv_task_t *task) {
+    py_imageio_obj_t *stream = py_imageio_prefetch_stream;
+    return stream && int_py_imageio_fill(stream, PREFETCH_CHUNK_SIZE) && (stream->ring_used < stream->ring_size);
+}
+
+static void int_py_imageio_read(py_imageio_obj_t *stream, void *data, uint32_t size) {
+    uint8_t *ptr = data;
+
+    while (size && stream->ring) {
+        if ((!stream->ring_used) && ((size >= stream->ring_size) || (!int_py_imageio_fill(stream, UINT32_MAX)))) {
+            // Large reads go to the file directly, as do reads that fail.
+            break;
+        }
+
+        uint32_t part = IM_MIN(IM_MIN(size, stream->ring_used), stream->ring_size - stream->ring_tail);
+        memcpy(ptr, stream->ring + stream->ring_tail, part);
+        stream->ring_tail = (stream->ring_tail + part) % stream->ring_size;
+        stream->ring_used -= part;
+        ptr += part;
+        size -= part;
+    }
+
+    if (size) {
+        file_read(&stream->fp, ptr, size);
+    }
+}
+
+static void int_py_imageio_skip(py_imageio_obj_t *stream, uint32_t size) {
+    if (stream->ring && (size <= stream->ring_used)) {
+        stream->ring_tail = (stream->ring_tail + size) % stream->ring_size;
+        stream->ring_used -= size;
+    } else {
+        int_py_imageio_seek(stream, int_py_imageio_tell(stream) + size);
+    }
+}
+
+// Loads the frame index of a V2.1 file, files without one are walked frame by frame.
+static void int_py_imageio_read_index(py_imageio_obj_t *stream) {
+    FIL *fp = &stream->fp;
+    uint32_t size = f_size(fp);
+
+    if (size >= (MAGIC_SIZE + INDEX_TRAILER_SIZE)) {
+        char magic[sizeof(INDEX_MAGIC) - 1];
+        uint32_t count;
+        file_seek(fp, size - INDEX_TRAILER_SIZE);
+        file_read(fp, magic, sizeof(magic));
+        file_read(fp, &count, 4);
+
+        uint32_t index_size = (count * sizeof(uint32_t)) + INDEX_TRAILER_SIZE;
+
+        if ((!memcmp(magic, INDEX_MAGIC, sizeof(magic))) && (index_size <= (size - MAGIC_SIZE))) {
+            stream->index_offset = size - index_size;
+            stream->count = count;
+        }
+    }
+
+    file_seek(fp, MAGIC_SIZE);
+}
+
+// Appends the frame index and marks the file as V2.1 if needed.
+static void int_py_imageio_write_index(py_imageio_obj_t *stream) {
+    FIL *fp = &stream->fp;
+
+    if (stream->index_enabled && stream->index_count && (stream->index_count == stream->count)) {
+        // Writes truncate the file, so the frame data ends at the end of the file.
+        file_seek(fp, f_size(fp));
+        file_write(fp, stream->index, stream->index_count * sizeof(uint32_t));
+        file_write(fp, INDEX_MAGIC, sizeof(INDEX_MAGIC) - 1);
+        file_write_long(fp, stream->index_count);
+        stream->upgrade = true;
+    }
+
+    if (stream->upgrade && (stream->version < FRAME_INDEX_VER)) {
+        file_seek(fp, MAGIC_SIZE - 1);
+        file_write_byte(fp, '0' + (FRAME_INDEX_VER % 10));
+    }
+}
+
+// Lossless PackBits style compression of 1 or 2 byte elements. A control byte below 128
+// is followed by that many plus one literal elements, otherwise the next element repeats
+// (control - 126) times. Returns 0 if the output would not be smaller than the input.
+static uint32_t int_py_imageio_rle_encode(const uint8_t *src, uint32_t n, int esize, uint8_t *dst, uint32_t dst_size) {
+    uint32_t i = 0, o = 0;
+
+    while (i < n) {
+        uint32_t run = 1;
+        while (((i + run) < n) && (run < 129)
+               && (!memcmp(src + ((i + run) * esize), src + (i * esize), esize))) {
+            run += 1;
+        }
+
+        if (run >= 2) {
+            if ((o + 1 + esize) >= dst_size) {
+                return 0;
+            }
+            dst[o++] = run + 126;
+            memcpy(dst + o, src + (i * esize), esize);
+            o += esize;
+            i += run;
+        } else {
+            // Collect literals until the next repeat.
+            uint32_t lit = 1;
+            while (((i + lit) < n) && (lit < 128)
+                   && (((i + lit + 1) >= n)
+                       || memcmp(src + ((i + lit) * esize), src + ((i + lit + 1) * esize), esize))) {
+                lit += 1;
+            }
+
+            if ((o + 1 + (lit * esize)) >= dst_size) {
+                return 0;
+            }
+            dst[o++] = lit - 1;
+            memcpy(dst + o, src + (i * esize), lit * esize);
+            o += lit * esize;
+            i += lit;
+        }
+    }
+
+    return o;
+}
+
+static void int_py_imageio_rle_decode(const uint8_t *src, uint32_t size, int esize, uint8_t *dst, uint32_t n) {
+    for (uint32_t i = 0, o = 0; (i < size) && (o < n);) {
+        uint32_t c = src[i++];
+
+        if (c < 128) {
+            if ((i + ((c + 1) * esize)) > size) {
+                break;
+            }
+            uint32_t lit = IM_MIN(c + 1, n - o);
+            memcpy(dst + (o * esize), src + i, lit * esize);
+            i += (c + 1) * esize;
+            o += lit;
+        } else {
+            if ((i + esize) > size) {
+                break;
+            }
+            for (uint32_t run = IM_MIN(c - 126, n - o); run; run--, o++) {
+                memcpy(dst + (o * esize), src + i, esize);
+            }
+            i += esize;
+        }
+    }
+}
+#endif
+
 static void py_imageio_print(const mp_print_t *print, mp_obj_t self, mp_print_kind_t kind) {
     py_imageio_obj_t *stream = MP_OBJ_TO_PTR(self);
     mp_printf(print, "{\"type\":%s, \"closed\":%s, \"count\":%u, \"offset\":%u, "
@@ -170,9 +403,56 @@ static mp_obj_t py_imageio_size(mp_obj_t self) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(py_imageio_size_obj, py_imageio_size);
 
-static mp_obj_t py_imageio_write(mp_obj_t self, mp_obj_t img_obj) {
+static mp_obj_t py_imageio_write(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_compression, ARG_quality, ARG_skip_threshold };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_compression, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = IMAGE_IO_RAW } },
+        { MP_QSTR_quality, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 90 } },
+        { MP_QSTR_skip_threshold, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = -1 } },
+    };
+
+    // Parse args.
+    mp_obj_t self = pos_args[0];
     py_imageio_obj_t *stream = py_imageio_obj(self);
-    image_t *image = py_image_cobj(img_obj);
+    image_t *image = py_image_cobj(pos_args[1]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 2, pos_args + 2, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    int compression = args[ARG_compression].u_int;
+
+    if ((compression < IMAGE_IO_RAW) || (compression > IMAGE_IO_RLE)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid compression"));
+    }
+
+    if ((args[ARG_quality].u_int < 0) || (args[ARG_quality].u_int > 100)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Quality ranges between 0 and 100"));
+    }
+
+    // Already compressed images are stored as they are.
+    if (image->is_compressed) {
+        compression = IMAGE_IO_RAW;
+    }
+
+    if (((compression == IMAGE_IO_JPEG) || (compression == IMAGE_IO_PNG))
+        && (image->pixfmt != PIXFORMAT_BINARY)
+        && (image->pixfmt != PIXFORMAT_GRAYSCALE)
+        && (image->pixfmt != PIXFORMAT_RGB565)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected a binary, grayscale or RGB565 image"));
+    }
+
+    // Frames that look the same as the last frame written are not written, the time
+    // they were shown for is added to the next frame written.
+    if ((args[ARG_skip_threshold].u_int >= 0) && (!image->is_compressed)) {
+        rectangle_t roi = { 0, 0, image->w, image->h };
+        uint64_t hash = imlib_get_hash(image, &roi);
+
+        if (stream->hashed && (imlib_hash_distance(hash, stream->hash) <= args[ARG_skip_threshold].u_int)) {
+            return self;
+        }
+
+        stream->hash = hash;
+        stream->hashed = true;
+    }
 
     uint32_t ms = mp_hal_ticks_ms(), elapsed_ms = ms - stream->ms;
     stream->ms = ms;
@@ -182,6 +462,59 @@ static mp_obj_t py_imageio_write(mp_obj_t self, mp_obj_t img_obj) {
     } else if (stream->type == IMAGE_IO_FILE_STREAM) {
         FIL *fp = &stream->fp;
 
+        if ((compression != IMAGE_IO_RAW) && (stream->version < NEW_PIXFORMAT_VER)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Compression requires a V2.0 stream or later"));
+        }
+
+        int_py_imageio_drop_prefetch(stream);
+
+        // Compress the frame first, stored holds the data written to the file.
+        image_t stored = *image;
+        fb_alloc_mark();
+
+        if (compression == IMAGE_IO_JPEG) {
+            stored.pixfmt = PIXFORMAT_JPEG;
+            stored.size = 0;
+            stored.data = NULL;
+            if (jpeg_compress(image, &stored, args[ARG_quality].u_int, false, JPEG_SUBSAMPLING_AUTO)) {
+                mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Out of memory"));
+            }
+        } else if (compression == IMAGE_IO_PNG) {
+            stored.pixfmt = PIXFORMAT_PNG;
+            stored.size = 0;
+            stored.data = NULL;
+            // Streams favor speed over size.
+            if (png_compress(image, &stored, PNG_EFFORT_FAST)) {
+                mp_raise_msg(&mp_type_RuntimeError, MP_ERROR_TEXT("Out of memory"));
+            }
+        } else if (compression == IMAGE_IO_RLE) {
+            uint32_t raw_size = image_size(image);
+            int esize = (image->bpp == 2) ? 2 : 1;
+            stored.data = fb_alloc(raw_size, FB_ALLOC_NO_HINT);
+            stored.size = int_py_imageio_rle_encode(image->data, raw_size / esize, esize, stored.data, raw_size);
+            // Store the frame raw if it does not get smaller.
+            if (!stored.size) {
+                compression = IMAGE_IO_RAW;
+                stored = *image;
+            } else {
+                stream->upgrade = true;
+            }
+        }
+
+        // Record the frame offset for the index. Frames that were not written by this
+        // stream have no recorded offset, so no index is written in that case.
+        if (stream->index_enabled && (stream->offset <= stream->index_count)) {
+            if (stream->offset == stream->index_alloc) {
+                stream->index = m_renew(uint32_t, stream->index, stream->index_alloc,
+                                        stream->index_alloc + INDEX_GROW_SIZE);
+                stream->index_alloc += INDEX_GROW_SIZE;
+            }
+            stream->index[stream->offset] = f_tell(fp);
+            stream->index_count = stream->offset + 1;
+        } else {
+            stream->index_enabled = false;
+        }
+
         file_write_long(fp, elapsed_ms);
         file_write_long(fp, image->w);
         file_write_long(fp, image->h);
@@ -202,25 +535,37 @@ static mp_obj_t py_imageio_write(mp_obj_t self, mp_obj_t img_obj) {
             } else {
                 mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid image stream bpp"));
             }
-        } else {
+        } else if (compression == IMAGE_IO_RAW) {
             file_write_long(fp, image->pixfmt);
             file_write_long(fp, image->size);
             file_write(fp, padding, AFTER_SIZE_PADDING);
+        } else {
+            // JPEG/PNG frames are valid V2.0 frames, the padding holds what to decode them to.
+            file_write_long(fp, stored.pixfmt);
+            file_write_long(fp, stored.size);
+            file_write_long(fp, compression);
+            file_write_long(fp, image->pixfmt);
+            file_write(fp, padding, AFTER_SIZE_PADDING - 8);
         }
 
-        uint32_t size = image_size(image);
-        file_write(fp, image->data, size);
+        uint32_t size = (compression == IMAGE_IO_RAW) ? image_size(image) : stored.size;
+        file_write(fp, stored.data, size);
 
         if (size % ALIGN_SIZE) {
             file_write(fp, padding, ALIGN_SIZE - (size % ALIGN_SIZE));
         }
 
+        fb_alloc_free_till_mark();
+
         // Seeking to the middle of a file and writing data corrupts the remainder of the file. So,
         // truncate the rest of the file when this happens to prevent crashing because of this.
+        // This also drops the frame index of the file, if any.
         if (!f_eof(fp)) {
             file_truncate(fp);
         }
 
+        stream->index_offset = 0;
+
         stream->count = stream->offset + 1;
     #endif
     } else if (stream->type == IMAGE_IO_MEMORY_STREAM) {
@@ -228,6 +573,10 @@ static mp_obj_t py_imageio_write(mp_obj_t self, mp_obj_t img_obj) {
             mp_raise_msg(&mp_type_EOFError, MP_ERROR_TEXT("End of stream"));
         }
 
+        if (compression != IMAGE_IO_RAW) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Compression requires a file stream"));
+        }
+
         uint32_t size = image_size(image);
 
         if (stream->size < size) {
@@ -243,7 +592,7 @@ static mp_obj_t py_imageio_write(mp_obj_t self, mp_obj_t img_obj) {
 
     return self;
 }
-static MP_DEFINE_CONST_FUN_OBJ_2(py_imageio_write_obj, py_imageio_write);
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_imageio_write_obj, 2, py_imageio_write);
 
 static void int_py_imageio_pause(py_imageio_obj_t *stream, bool pause) {
     uint32_t elapsed_ms;
@@ -251,13 +600,20 @@ static void int_py_imageio_pause(py_imageio_obj_t *stream, bool pause) {
     if (0) {
     #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
     } else if (stream->type == IMAGE_IO_FILE_STREAM) {
-        file_read(&stream->fp, &elapsed_ms, 4);
+        int_py_imageio_read(stream, &elapsed_ms, 4);
     #endif
     } else if (stream->type == IMAGE_IO_MEMORY_STREAM) {
         elapsed_ms = *((uint32_t *) (stream->buffer + (stream->offset * stream->size)));
     }
 
     while (pause && ((mp_hal_ticks_ms() - stream->ms) < elapsed_ms)) {
+        #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
+        // Read ahead instead of idling.
+        if ((stream->type == IMAGE_IO_FILE_STREAM) && stream->ring
+            && int_py_imageio_fill(stream, PREFETCH_FILL_SIZE)) {
+            continue;
+        }
+        #endif
         __WFI();
     }
 
@@ -265,20 +621,23 @@ static void int_py_imageio_pause(py_imageio_obj_t *stream, bool pause) {
 }
 
 #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
-static void int_py_imageio_read_chunk(py_imageio_obj_t *stream, image_t *image, bool pause) {
-    FIL *fp = &stream->fp;
+// Reads a frame header, returns the frame compression and sets image to the stored frame.
+// For compressed frames decoded_pixfmt is set to the pixformat to decode them to.
+static int int_py_imageio_read_chunk(py_imageio_obj_t *stream, image_t *image, bool pause,
+                                     pixformat_t *decoded_pixfmt) {
+    int compression = IMAGE_IO_RAW;
 
-    if (f_eof(fp)) {
+    if (int_py_imageio_eof(stream)) {
         mp_raise_msg(&mp_type_EOFError, MP_ERROR_TEXT("End of stream"));
     }
 
     int_py_imageio_pause(stream, pause);
 
-    file_read(fp, &image->w, 4);
-    file_read(fp, &image->h, 4);
+    int_py_imageio_read(stream, &image->w, 4);
+    int_py_imageio_read(stream, &image->h, 4);
 
     uint32_t bpp;
-    file_read(fp, &bpp, 4);
+    int_py_imageio_read(stream, &bpp, 4);
 
     if (stream->version < NEW_PIXFORMAT_VER) {
         if (bpp < 0) {
@@ -300,11 +659,21 @@ static void int_py_imageio_read_chunk(py_imageio_obj_t *stream, image_t *image,
         }
 
         image->pixfmt = bpp;
-        file_read(fp, &image->size, 4);
+        int_py_imageio_read(stream, &image->size, 4);
 
-        char ignore[AFTER_SIZE_PADDING];
-        file_read(fp, ignore, AFTER_SIZE_PADDING);
+        uint32_t padding[AFTER_SIZE_PADDING / 4];
+        int_py_imageio_read(stream, padding, AFTER_SIZE_PADDING);
+
+        if ((padding[0] > IMAGE_IO_RAW) && (padding[0] <= IMAGE_IO_RLE)) {
+            if (!IMLIB_PIXFORMAT_IS_VALID(padding[1])) {
+                mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Invalid image stream pixformat"));
+            }
+            compression = padding[0];
+            *decoded_pixfmt = padding[1];
+        }
     }
+
+    return compression;
 }
 #endif
 
@@ -322,28 +691,36 @@ static mp_obj_t py_imageio_read(uint n_args, const mp_obj_t *pos_args, mp_map_t
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     image_t image = { 0 };
+    image_t stored = { 0 };
+    int compression = IMAGE_IO_RAW;
 
     if (0) {
     #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
     } else if (stream->type == IMAGE_IO_FILE_STREAM) {
-        FIL *fp = &stream->fp;
-
-        if (f_eof(fp)) {
+        if (int_py_imageio_eof(stream)) {
             if (args[ARG_loop].u_bool == false) {
                 return mp_const_none;
             }
             // Skip the header
-            file_seek(fp, MAGIC_SIZE);
+            int_py_imageio_seek(stream, MAGIC_SIZE);
 
             stream->offset = 0;
 
-            if (f_eof(fp)) {
+            if (int_py_imageio_eof(stream)) {
                 // Empty file
                 return mp_const_none;
             }
         }
 
-        int_py_imageio_read_chunk(stream, &image, args[ARG_pause].u_bool);
+        pixformat_t pixfmt;
+        compression = int_py_imageio_read_chunk(stream, &image, args[ARG_pause].u_bool, &pixfmt);
+
+        if (compression != IMAGE_IO_RAW) {
+            // The stored frame is decoded back to the original image below.
+            stored = image;
+            image.pixfmt = pixfmt;
+            image.size = 0;
+        }
     #endif
     } else if (stream->type == IMAGE_IO_MEMORY_STREAM) {
         if (stream->offset == stream->count) {
@@ -365,8 +742,26 @@ static mp_obj_t py_imageio_read(uint n_args, const mp_obj_t *pos_args, mp_map_t
     if (0) {
     #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
     } else if (stream->type == IMAGE_IO_FILE_STREAM) {
-        FIL *fp = &stream->fp;
-        file_read(fp, image.data, size);
+        if (compression == IMAGE_IO_RAW) {
+            int_py_imageio_read(stream, image.data, size);
+        } else {
+            fb_alloc_mark();
+            // The stored size of RLE frames is the size of the compressed data.
+            size = stored.size;
+            stored.data = fb_alloc(size, FB_ALLOC_NO_HINT);
+            int_py_imageio_read(stream, stored.data, size);
+
+            if (compression == IMAGE_IO_JPEG) {
+                jpeg_decompress(&image, &stored);
+            } else if (compression == IMAGE_IO_PNG) {
+                png_decompress(&image, &stored);
+            } else {
+                int esize = (image.bpp == 2) ? 2 : 1;
+                int_py_imageio_rle_decode(stored.data, size, esize, image.data, image_size(&image) / esize);
+            }
+
+            fb_alloc_free_till_mark();
+        }
 
         // Check if original byte reversed data.
         if ((image.pixfmt == PIXFORMAT_RGB565) && (stream->version == ORIGINAL_VER)) {
@@ -383,13 +778,17 @@ static mp_obj_t py_imageio_read(uint n_args, const mp_obj_t *pos_args, mp_map_t
         }
 
         if (size % ALIGN_SIZE) {
-            char ignore[ALIGN_SIZE];
-            file_read(fp, ignore, ALIGN_SIZE - (size % ALIGN_SIZE));
+            int_py_imageio_skip(stream, ALIGN_SIZE - (size % ALIGN_SIZE));
         }
 
         if (stream->offset >= stream->count) {
             stream->count = stream->offset + 1;
         }
+
+        // Refill the read-ahead ring in the background.
+        if (stream->ring && (py_imageio_prefetch_stream == stream)) {
+            omv_task_schedule(&py_imageio_prefetch_task_obj);
+        }
     #endif
     } else if (stream->type == IMAGE_IO_MEMORY_STREAM) {
         memcpy(image.data, stream->buffer + (stream->offset * stream->size) + IMAGE_T_SIZE_ALIGNED, size);
@@ -417,18 +816,34 @@ static mp_obj_t py_imageio_seek(mp_obj_t self, mp_obj_t offs) {
     #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
     if (stream->type == IMAGE_IO_FILE_STREAM) {
         FIL *fp = &stream->fp;
-        file_seek(fp, MAGIC_SIZE); // skip past the file header
+
+        if (stream->index_offset) {
+            if (stream->count <= offset) {
+                mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid stream offset"));
+            }
+
+            uint32_t frame_offset;
+            int_py_imageio_seek(stream, stream->index_offset + (offset * sizeof(uint32_t)));
+            file_read(fp, &frame_offset, 4);
+            int_py_imageio_seek(stream, frame_offset);
+            stream->offset = offset;
+            return self;
+        }
+
+        int_py_imageio_seek(stream, MAGIC_SIZE); // skip past the file header
 
         for (int i = 0; i < offset; i++) {
             image_t image = {};
-            int_py_imageio_read_chunk(stream, &image, false);
-            uint32_t size = image_size(&image);
+            pixformat_t pixfmt;
+            // Compressed frames store the size of the compressed data.
+            int compression = int_py_imageio_read_chunk(stream, &image, false, &pixfmt);
+            uint32_t size = (compression == IMAGE_IO_RAW) ? image_size(&image) : image.size;
 
             if (size % ALIGN_SIZE) {
                 size += ALIGN_SIZE - (size % ALIGN_SIZE);
             }
 
-            file_seek(fp, f_tell(fp) + size);
+            int_py_imageio_skip(stream, size);
         }
 
         if (stream->offset >= stream->count) {
@@ -462,7 +877,17 @@ static mp_obj_t py_imageio_close(mp_obj_t self) {
     if (0) {
     #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
     } else if (stream->type == IMAGE_IO_FILE_STREAM) {
+        int_py_imageio_drop_prefetch(stream);
+        int_py_imageio_write_index(stream);
         file_close(&stream->fp);
+
+        if (stream->ring) {
+            if (py_imageio_prefetch_stream == stream) {
+                py_imageio_prefetch_stream = NULL;
+            }
+            stream->ring = NULL;
+            fb_alloc_free_till_mark_past_mark_permanent();
+        }
     #endif
     } else if (stream->type == IMAGE_IO_MEMORY_STREAM) {
         fb_alloc_free_till_mark_past_mark_permanent();
@@ -474,25 +899,54 @@ static mp_obj_t py_imageio_close(mp_obj_t self) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(py_imageio_close_obj, py_imageio_close);
 
-static mp_obj_t py_imageio_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *args) {
-    mp_arg_check_num(n_args, n_kw, 2, 2, false);
+static mp_obj_t py_imageio_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_stream, ARG_mode, ARG_index, ARG_prefetch };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_stream, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_mode, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL } },
+        { MP_QSTR_index, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true } },
+        { MP_QSTR_prefetch, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0 } },
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
     py_imageio_obj_t *stream = mp_obj_malloc_with_finaliser(py_imageio_obj_t, &py_imageio_type);
     stream->closed = false;
+    stream->hashed = false;
 
     if (0) {
     #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
-    } else if (mp_obj_is_str(args[0])) {
+    } else if (mp_obj_is_str(args[ARG_stream].u_obj)) {
         // File Stream I/O
         FIL *fp = &stream->fp;
         stream->type = IMAGE_IO_FILE_STREAM;
         stream->count = 0;
+        stream->index_offset = 0;
+        stream->index = NULL;
+        stream->index_count = 0;
+        stream->index_alloc = 0;
+        stream->index_enabled = false;
+        stream->upgrade = false;
+        stream->ring = NULL;
+        stream->ring_size = 0;
+        stream->ring_head = 0;
+        stream->ring_tail = 0;
+        stream->ring_used = 0;
+
+        if (args[ARG_prefetch].u_int < 0) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Prefetch must be positive"));
+        }
 
-        char mode = mp_obj_str_get_str(args[1])[0];
+        char mode = mp_obj_str_get_str(args[ARG_mode].u_obj)[0];
 
         if ((mode == 'W') || (mode == 'w')) {
-            file_open(fp, mp_obj_str_get_str(args[0]), false, FA_READ | FA_WRITE | FA_OPEN_ALWAYS);
+            file_open(fp, mp_obj_str_get_str(args[ARG_stream].u_obj), false, FA_READ | FA_WRITE | FA_OPEN_ALWAYS);
             const char string[] = "OMV IMG STR V2.0";
             stream->version = NEW_PIXFORMAT_VER;
+            // The header is changed to V2.1 on close if the file gets an index.
+            stream->index_enabled = args[ARG_index].u_bool;
 
             // Overwrite if file is too small.
             if (f_size(fp) < MAGIC_SIZE) {
@@ -523,7 +977,7 @@ static mp_obj_t py_imageio_make_new(const mp_obj_type_t *type, size_t n_args, si
 
         if ((mode == 'R') || (mode == 'r')) {
             uint8_t version_hi, version_lo;
-            file_open(fp, mp_obj_str_get_str(args[0]), false, FA_READ | FA_WRITE | FA_OPEN_EXISTING);
+            file_open(fp, mp_obj_str_get_str(args[ARG_stream].u_obj), false, FA_READ | FA_WRITE | FA_OPEN_EXISTING);
             file_read_check(fp, "OMV IMG STR ", 12); // Magic
             file_read_check(fp, "V", 1);
             file_read(fp, &version_hi, 1);
@@ -534,19 +988,40 @@ static mp_obj_t py_imageio_make_new(const mp_obj_type_t *type, size_t n_args, si
 
             if ((stream->version != ORIGINAL_VER)
                 && (stream->version != RGB565_FIXED_VER)
-                && (stream->version != NEW_PIXFORMAT_VER)) {
-                mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected version V1.0, V1.1, or V2.0"));
+                && (stream->version != NEW_PIXFORMAT_VER)
+                && (stream->version != FRAME_INDEX_VER)) {
+                mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected version V1.0, V1.1, V2.0 or V2.1"));
+            }
+
+            if (stream->version >= FRAME_INDEX_VER) {
+                int_py_imageio_read_index(stream);
+            }
+
+            if (args[ARG_prefetch].u_int && (!int_py_imageio_eof(stream))) {
+                // Size the read-ahead ring using the first frame.
+                image_t image = {};
+                pixformat_t pixfmt;
+                int compression = int_py_imageio_read_chunk(stream, &image, false, &pixfmt);
+                uint32_t size = (compression == IMAGE_IO_RAW) ? image_size(&image) : image.size;
+                size = FRAME_HEADER_SIZE + (((size + ALIGN_SIZE - 1) / ALIGN_SIZE) * ALIGN_SIZE);
+                file_seek(fp, MAGIC_SIZE);
+
+                stream->ring_size = size * args[ARG_prefetch].u_int;
+                fb_alloc_mark();
+                stream->ring = fb_alloc(stream->ring_size, FB_ALLOC_PREFER_SIZE | FB_ALLOC_CACHE_ALIGN);
+                fb_alloc_mark_permanent();
+                py_imageio_prefetch_stream = stream;
             }
         } else if ((mode != 'W') && (mode != 'w')) {
             mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid stream mode, expected 'R/r' or 'W/w'"));
         }
     #endif
-    } else if (mp_obj_is_type(args[0], &mp_type_tuple)) {
+    } else if (mp_obj_is_type(args[ARG_stream].u_obj, &mp_type_tuple)) {
         // Memory Stream I/O
         stream->type = IMAGE_IO_MEMORY_STREAM;
 
         mp_obj_t *image_info;
-        mp_obj_get_array_fixed_n(args[0], 3, &image_info);
+        mp_obj_get_array_fixed_n(args[ARG_stream].u_obj, 3, &image_info);
         int w = mp_obj_get_int(image_info[0]);
         int h = mp_obj_get_int(image_info[1]);
         int pixfmt = mp_obj_get_int(image_info[2]);
@@ -563,7 +1038,7 @@ static mp_obj_t py_imageio_make_new(const mp_obj_type_t *type, size_t n_args, si
             image.pixfmt = PIXFORMAT_BINARY;
         }
 
-        stream->count = mp_obj_get_int(args[1]);
+        stream->count = mp_obj_get_int(args[ARG_mode].u_obj);
         stream->size = IMAGE_T_SIZE_ALIGNED + image_size_aligned(&image);
 
         fb_alloc_mark();
@@ -584,6 +1059,10 @@ static const mp_rom_map_elem_t py_imageio_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___del__),         MP_ROM_PTR(&py_imageio_close_obj)       },
     { MP_ROM_QSTR(MP_QSTR_FILE_STREAM),     MP_ROM_INT(IMAGE_IO_FILE_STREAM)        },
     { MP_ROM_QSTR(MP_QSTR_MEMORY_STREAM),   MP_ROM_INT(IMAGE_IO_MEMORY_STREAM)      },
+    { MP_ROM_QSTR(MP_QSTR_RAW),             MP_ROM_INT(IMAGE_IO_RAW)                },
+    { MP_ROM_QSTR(MP_QSTR_JPEG),            MP_ROM_INT(IMAGE_IO_JPEG)               },
+    { MP_ROM_QSTR(MP_QSTR_PNG),             MP_ROM_INT(IMAGE_IO_PNG)                },
+    { MP_ROM_QSTR(MP_QSTR_RLE),             MP_ROM_INT(IMAGE_IO_RLE)                },
     { MP_ROM_QSTR(MP_QSTR_type),            MP_ROM_PTR(&py_imageio_get_type_obj)    },
     { MP_ROM_QSTR(MP_QSTR_is_closed),       MP_ROM_PTR(&py_imageio_is_closed_obj)   },
     { MP_ROM_QSTR(MP_QSTR_count),           MP_ROM_PTR(&py_imageio_count_obj)       },
@@ -23,6 +23,10 @@
 #include "file_utils.h"
 #include "framebuffer.h"
 #include "omv_boardconfig.h"
+#include "omv_task.h"
+
+#define MJPEG_FLUSH_SIZE    (16 * 1024) // Bytes written to the file per background flush.
+#define MJPEG_SECTOR_SIZE   (512)
 
 static const mp_obj_type_t py_mjpeg_type;
 
@@ -34,18 +38,132 @@ typedef struct py_mjpeg_obj {
     uint32_t us_avg;
     uint32_t width;
     uint32_t height;
+    uint32_t dropped;
+    uint32_t skipped;
+    uint64_t hash;          // Hash of the last frame written with skip_threshold.
+    bool hashed;
     bool closed;
+    bool preallocated;
+    bool recorder;          // Created by Recorder(), the file is opened by trigger().
+    bool armed;             // Recorder waiting for the trigger, the oldest frames are overwritten.
+    uint32_t remaining;     // Frames still recorded after the trigger.
+    FRESULT error;          // Deferred error of the background flush.
+    uint8_t *buffer;        // Write-behind ring buffer used by write_async().
+    uint32_t buffer_size;
+    uint32_t buffer_head;
+    uint32_t buffer_tail;
+    uint32_t buffer_used;
+    uint32_t *index;        // Chunk sizes of the frames in the ring while armed.
+    uint32_t index_size;
+    uint32_t index_head;
+    uint32_t index_used;
     FIL fp;
 } py_mjpeg_obj_t;
 
+// Frames queued with write_async() are written to the file by a background task, and not
+// from an interrupt, because FatFs is not reentrant and the script may be using it. Only
+// one stream can have a background flush at a time.
+static bool py_mjpeg_flush_task(omv_task_t *task);
+
+static omv_task_t py_mjpeg_flush_task_obj = {
+    .func = py_mjpeg_flush_task,
+    .priority = OMV_TASK_PRIORITY_HIGH,
+};
+
+static uint32_t py_mjpeg_file_size(py_mjpeg_obj_t *self) {
+    if (self->armed) {
+        return self->buffer_used;
+    }
+    // Preallocated files are truncated on close, until then the size is the write position.
+    return (self->preallocated ? f_tell(&self->fp) : f_size(&self->fp)) + self->buffer_used;
+}
+
+// Writes up to max_size bytes of the ring buffer to the file. Unless all of it is going
+// out the writes end on a sector boundary so that the SD card only sees whole sectors.
+static void py_mjpeg_flush(py_mjpeg_obj_t *self, uint32_t max_size, bool all) {
+    while (self->buffer_used && (self->error == FR_OK) && max_size) {
+        uint32_t size = IM_MIN(self->buffer_used, self->buffer_size - self->buffer_tail);
+        bool wraps = size == (self->buffer_size - self->buffer_tail);
+        size = IM_MIN(size, max_size);
+
+        if ((!all) && (!wraps)) {
+            uint32_t remainder = (f_tell(&self->fp) + size) % MJPEG_SECTOR_SIZE;
+            if (size <= remainder) {
+                break;
+            }
+            size -= remainder;
+        }
+
+        UINT bytes;
+        FRESULT res = f_write(&self->fp, self->buffer + self->buffer_tail, size, &bytes);
+        if ((res == FR_OK) && (bytes != size)) {
+            res = FR_DENIED; // Disk full.
+        }
+        if (res != FR_OK) {
+            self->error = res;
+            break;
+        }
+
+        self->buffer_tail = (self->buffer_tail + size) % self->buffer_size;
+        self->buffer_used -= size;
+        max_size -= size;
+    }
+}
+
+static bool py_mjpeg_flush_task(omv_task_t *task) {
+    py_mjpeg_obj_t *self = MP_STATE_PORT(mjpeg_async_stream);
+
+    if (self) {
+        py_mjpeg_flush(self, MJPEG_FLUSH_SIZE, false);
+        // Keep going if there's still more than a flush worth of data.
+        return (self->buffer_used >= MJPEG_FLUSH_SIZE) && (self->error == FR_OK);
+    }
+
+    return false;
+}
+
+// Writes out everything and raises any error the background flush ran into.
+static void py_mjpeg_drain(py_mjpeg_obj_t *self) {
+    if (self->buffer) {
+        py_mjpeg_flush(self, UINT32_MAX, true);
+    }
+    if (self->error != FR_OK) {
+        FRESULT res = self->error;
+        self->error = FR_OK;
+        self->closed = true;
+        if (MP_STATE_PORT(mjpeg_async_stream) == self) {
+            MP_STATE_PORT(mjpeg_async_stream) = NULL;
+        }
+        file_raise_error(&self->fp, res);
+    }
+}
+
+static void py_mjpeg_update_rate(py_mjpeg_obj_t *self) {
+    uint32_t ticks = mp_hal_ticks_us();
+
+    if (self->frames > 1) {
+        uint32_t ticks_diff = mp_hal_ticks_us() - self->us_old;
+
+        if (self->frames <= 2) {
+            self->us_avg = ticks_diff;
+        } else {
+            uint64_t cumulative_average_n = ((uint64_t) self->us_avg) * (self->frames - 1);
+            self->us_avg = (cumulative_average_n + ticks_diff) / self->frames;
+        }
+    }
+
+    self->us_old = ticks;
+}
+
 static void py_mjpeg_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
     py_mjpeg_obj_t *self = MP_OBJ_TO_PTR(self_in);
-    mp_printf(print, "{\"closed\":%s, \"width\":%u, \"height\":%u, \"count\":%u, \"size\":%u}",
+    mp_printf(print, "{\"closed\":%s, \"width\":%u, \"height\":%u, \"count\":%u, \"dropped\":%u, \"size\":%u}",
               self->closed ? "\"true\"" : "\"false\"",
               self->width,
               self->height,
               self->frames,
-              f_size(&self->fp));
+              self->dropped,
+              py_mjpeg_file_size(self));
 }
 
 static mp_obj_t py_mjpeg_is_closed(mp_obj_t self_in) {
@@ -72,14 +190,48 @@ static mp_obj_t py_mjpeg_count(mp_obj_t self_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_count_obj, py_mjpeg_count);
 
+static mp_obj_t py_mjpeg_dropped(mp_obj_t self_in) {
+    py_mjpeg_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int(self->dropped);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_dropped_obj, py_mjpeg_dropped);
+
+static mp_obj_t py_mjpeg_skipped(mp_obj_t self_in) {
+    py_mjpeg_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int(self->skipped);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_skipped_obj, py_mjpeg_skipped);
+
 static mp_obj_t py_mjpeg_size(mp_obj_t self_in) {
     py_mjpeg_obj_t *self = MP_OBJ_TO_PTR(self_in);
-    return mp_obj_new_int(f_size(&self->fp));
+    return mp_obj_new_int(py_mjpeg_file_size(self));
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_size_obj, py_mjpeg_size);
 
-static mp_obj_t py_mjpeg_write(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_roi, ARG_channel, ARG_alpha, ARG_color_palette, ARG_alpha_palette, ARG_hint, ARG_quality };
+// Drops the oldest frame in the ring of an armed recorder.
+static void py_mjpeg_buffer_evict(py_mjpeg_obj_t *self) {
+    uint32_t tail = (self->index_head + self->index_size - self->index_used) % self->index_size;
+    uint32_t size = self->index[tail];
+    self->buffer_tail = (self->buffer_tail + size) % self->buffer_size;
+    self->buffer_used -= size;
+    self->index_used -= 1;
+    self->frames -= 1;
+    self->bytes -= size - 8;
+}
+
+static void py_mjpeg_buffer_put(py_mjpeg_obj_t *self, const void *data, uint32_t size) {
+    uint32_t part = IM_MIN(size, self->buffer_size - self->buffer_head);
+    memcpy(self->buffer + self->buffer_head, data, part);
+    memcpy(self->buffer, ((const uint8_t *) data) + part, size - part);
+    self->buffer_head = (self->buffer_head + size) % self->buffer_size;
+    self->buffer_used += size;
+}
+
+static mp_obj_t py_mjpeg_write_helper(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args, bool async) {
+    enum {
+        ARG_roi, ARG_channel, ARG_alpha, ARG_color_palette, ARG_alpha_palette, ARG_hint, ARG_quality,
+        ARG_skip_threshold
+    };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_roi, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
         { MP_QSTR_rgb_channel, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = -1 } },
@@ -88,6 +240,7 @@ static mp_obj_t py_mjpeg_write(uint n_args, const mp_obj_t *pos_args, mp_map_t *
         { MP_QSTR_alpha_palette, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
         { MP_QSTR_hint, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 0 } },
         { MP_QSTR_quality, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 90 } },
+        { MP_QSTR_skip_threshold, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = -1 } },
     };
 
     // Parse args.
@@ -118,34 +271,187 @@ static mp_obj_t py_mjpeg_write(uint n_args, const mp_obj_t *pos_args, mp_map_t *
     const uint16_t *color_palette = py_helper_arg_to_palette(args[ARG_color_palette].u_obj, PIXFORMAT_RGB565);
     const uint8_t *alpha_palette = py_helper_arg_to_palette(args[ARG_alpha_palette].u_obj, PIXFORMAT_GRAYSCALE);
 
-    mjpeg_write(&self->fp, self->width, self->height, &self->frames, &self->bytes,
-                image, args[ARG_quality].u_int, &roi, args[ARG_channel].u_int,
-                args[ARG_alpha].u_int, color_palette, alpha_palette, args[ARG_hint].u_int);
+    if (self->recorder && (!self->armed) && (!self->remaining)) {
+        // All the frames after the trigger have been recorded.
+        return mp_const_none;
+    }
 
-    uint32_t ticks = mp_hal_ticks_us();
+    // Frames that look the same as the last frame written are stored as empty chunks, which
+    // players show as a repeat of the previous frame, so the timing of the file is kept.
+    bool skip = false;
 
-    if (self->frames > 1) {
-        uint32_t ticks_diff = mp_hal_ticks_us() - self->us_old;
+    if ((args[ARG_skip_threshold].u_int >= 0) && (!image->is_compressed)) {
+        uint64_t hash = imlib_get_hash(image, &roi);
+        skip = self->hashed && (imlib_hash_distance(hash, self->hash) <= args[ARG_skip_threshold].u_int);
 
-        if (self->frames <= 2) {
-            self->us_avg = ticks_diff;
-        } else {
-            uint64_t cumulative_average_n = ((uint64_t) self->us_avg) * (self->frames - 1);
-            self->us_avg = (cumulative_average_n + ticks_diff) / self->frames;
+        if (!skip) {
+            self->hash = hash;
+            self->hashed = true;
         }
     }
 
-    self->us_old = ticks;
+    if ((!async) && (!self->recorder)) {
+        // Frames queued before must go out first.
+        py_mjpeg_drain(self);
+
+        if (skip) {
+            uint32_t header[2] = { 0x63643030, 0 }; // FOURCC "00dc" + DWORD cb.
+            file_write(&self->fp, header, sizeof(header));
+            self->frames += 1;
+            self->skipped += 1;
+            py_mjpeg_update_rate(self);
+            return mp_const_none;
+        }
+
+        mjpeg_write(&self->fp, self->width, self->height, &self->frames, &self->bytes,
+                    image, args[ARG_quality].u_int, &roi, args[ARG_channel].u_int,
+                    args[ARG_alpha].u_int, color_palette, alpha_palette, args[ARG_hint].u_int);
+        py_mjpeg_update_rate(self);
+        return mp_const_none;
+    }
+
+    if (self->error != FR_OK) {
+        py_mjpeg_drain(self);
+    }
+
+    if (!self->buffer) {
+        if (MP_STATE_PORT(mjpeg_async_stream)) {
+            mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Another MJPEG stream is writing asynchronously"));
+        }
+        self->buffer = m_new(uint8_t, self->buffer_size);
+        MP_STATE_PORT(mjpeg_async_stream) = self;
+    }
+
+    image_t dst_img = {};
+    fb_alloc_mark();
+
+    if (!skip) {
+        mjpeg_encode(&dst_img, self->width, self->height, image, args[ARG_quality].u_int, &roi,
+                     args[ARG_channel].u_int, args[ARG_alpha].u_int, color_palette, alpha_palette,
+                     args[ARG_hint].u_int);
+    }
+
+    uint32_t size_padded = (((dst_img.size + 3) / 4) * 4);
+
+    // Until the trigger the ring always holds the latest frames.
+    while (self->armed && self->index_used
+           && ((self->index_used == self->index_size)
+               || ((size_padded + 8) > (self->buffer_size - self->buffer_used)))) {
+        py_mjpeg_buffer_evict(self);
+    }
+
+    if (self->recorder && (!self->armed)) {
+        self->remaining -= 1;
+    }
+
+    if ((size_padded + 8) > (self->buffer_size - self->buffer_used)) {
+        // The SD card fell behind, drop the frame instead of stalling.
+        self->dropped += 1;
+    } else {
+        uint32_t header[2] = { 0x63643030, size_padded }; // FOURCC "00dc" + DWORD cb.
+        py_mjpeg_buffer_put(self, header, sizeof(header));
+        if (size_padded) {
+            py_mjpeg_buffer_put(self, dst_img.data, size_padded); // reading past okay
+        }
+        self->frames += 1;
+        self->skipped += skip;
+        self->bytes += size_padded;
+        py_mjpeg_update_rate(self);
+
+        if (self->armed) {
+            self->index[self->index_head] = size_padded + 8;
+            self->index_head = (self->index_head + 1) % self->index_size;
+            self->index_used += 1;
+        }
+    }
+
+    fb_alloc_free_till_mark();
+
+    if ((!self->armed) && (self->buffer_used >= MJPEG_FLUSH_SIZE)) {
+        omv_task_schedule(&py_mjpeg_flush_task_obj);
+    }
 
     return mp_const_none;
 }
+
+static mp_obj_t py_mjpeg_write(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return py_mjpeg_write_helper(n_args, pos_args, kw_args, false);
+}
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_mjpeg_write_obj, 2, py_mjpeg_write);
 
+static mp_obj_t py_mjpeg_write_async(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return py_mjpeg_write_helper(n_args, pos_args, kw_args, true);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_mjpeg_write_async_obj, 2, py_mjpeg_write_async);
+
+// Opens the file of an armed recorder, the frames in the ring are written out in the
+// background followed by the next frames written.
+static mp_obj_t py_mjpeg_trigger(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_frames, ARG_preallocate };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_frames, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 0 } },
+        { MP_QSTR_preallocate, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 0 } },
+    };
+
+    // Parse args.
+    py_mjpeg_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    const char *path = mp_obj_str_get_str(pos_args[1]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 2, pos_args + 2, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if (self->closed) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("MJPEG stream is closed"));
+    }
+
+    if (!self->armed) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("MJPEG recorder is not armed"));
+    }
+
+    if ((args[ARG_frames].u_int < 0) || (args[ARG_preallocate].u_int < 0)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Frames and preallocate size must be positive"));
+    }
+
+    if (MP_STATE_PORT(mjpeg_async_stream)) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Another MJPEG stream is writing asynchronously"));
+    }
+
+    file_open(&self->fp, path, false, FA_WRITE | FA_CREATE_ALWAYS);
+
+    if (args[ARG_preallocate].u_int) {
+        self->preallocated = mjpeg_preallocate(&self->fp, args[ARG_preallocate].u_int);
+    }
+
+    mjpeg_open(&self->fp, self->width, self->height);
+
+    self->armed = false;
+    self->remaining = args[ARG_frames].u_int;
+    MP_STATE_PORT(mjpeg_async_stream) = self;
+    omv_task_schedule(&py_mjpeg_flush_task_obj);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_mjpeg_trigger_obj, 2, py_mjpeg_trigger);
+
+static mp_obj_t py_mjpeg_is_armed(mp_obj_t self_in) {
+    py_mjpeg_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int(self->armed);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_is_armed_obj, py_mjpeg_is_armed);
+
+static mp_obj_t py_mjpeg_remaining(mp_obj_t self_in) {
+    py_mjpeg_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int(self->remaining);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_remaining_obj, py_mjpeg_remaining);
+
 static mp_obj_t py_mjpeg_sync(mp_obj_t self_in) {
     py_mjpeg_obj_t *self = MP_OBJ_TO_PTR(self_in);
     if (self->closed) {
         mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("MJPEG stream is closed"));
     }
+    if (self->armed) {
+        return mp_const_none;
+    }
+    py_mjpeg_drain(self);
     mjpeg_sync(&self->fp, self->frames, self->bytes, self->us_avg);
     return mp_const_none;
 }
@@ -153,19 +459,68 @@ static MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_sync_obj, py_mjpeg_sync);
 
 static mp_obj_t py_mjpeg_close(mp_obj_t self_in) {
     py_mjpeg_obj_t *self = MP_OBJ_TO_PTR(self_in);
-    if (!self->closed) {
+    if (self->armed) {
+        // Never triggered, there's no file.
+        self->closed = true;
+        self->armed = false;
+    } else if (!self->closed) {
+        py_mjpeg_drain(self);
+        if (MP_STATE_PORT(mjpeg_async_stream) == self) {
+            MP_STATE_PORT(mjpeg_async_stream) = NULL;
+        }
+        self->closed = true;
         mjpeg_close(&self->fp, self->frames, self->bytes, self->us_avg);
     }
-    self->closed = true;
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(py_mjpeg_close_obj, py_mjpeg_close);
 
+static py_mjpeg_obj_t *py_mjpeg_new(int width, int height, int buffer_size) {
+    py_mjpeg_obj_t *mjpeg = mp_obj_malloc_with_finaliser(py_mjpeg_obj_t, &py_mjpeg_type);
+    mjpeg->frames = 0;
+    mjpeg->bytes = 0;
+    mjpeg->us_old = 0;
+    mjpeg->us_avg = 0;
+    mjpeg->dropped = 0;
+    mjpeg->skipped = 0;
+    mjpeg->hash = 0;
+    mjpeg->hashed = false;
+    mjpeg->closed = 0;
+    mjpeg->preallocated = false;
+    mjpeg->recorder = false;
+    mjpeg->armed = false;
+    mjpeg->remaining = 0;
+    mjpeg->error = FR_OK;
+    mjpeg->width = (width == -1) ? framebuffer_get_width() : width;
+    mjpeg->height = (height == -1) ? framebuffer_get_height() : height;
+    // The ring buffer is allocated by the first write_async(), the default holds a few frames.
+    mjpeg->buffer = NULL;
+    mjpeg->buffer_size = IM_MAX(mjpeg->width * mjpeg->height, (uint32_t) (MJPEG_FLUSH_SIZE * 2));
+    if (buffer_size != -1) {
+        mjpeg->buffer_size = buffer_size;
+    }
+    mjpeg->buffer_head = 0;
+    mjpeg->buffer_tail = 0;
+    mjpeg->buffer_used = 0;
+    mjpeg->index = NULL;
+    mjpeg->index_size = 0;
+    mjpeg->index_head = 0;
+    mjpeg->index_used = 0;
+
+    if (mjpeg->buffer_size < MJPEG_FLUSH_SIZE) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Buffer size is too small"));
+    }
+
+    return mjpeg;
+}
+
 static mp_obj_t py_mjpeg_open(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_width, ARG_height };
+    enum { ARG_width, ARG_height, ARG_buffer_size, ARG_preallocate };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_width, MP_ARG_INT,  {.u_int = -1 } },
         { MP_QSTR_height, MP_ARG_INT,  {.u_int = -1 } },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = -1 } },
+        { MP_QSTR_preallocate, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = 0 } },
     };
 
     // Parse args.
@@ -173,21 +528,49 @@ static mp_obj_t py_mjpeg_open(uint n_args, const mp_obj_t *pos_args, mp_map_t *k
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
-    py_mjpeg_obj_t *mjpeg = mp_obj_malloc_with_finaliser(py_mjpeg_obj_t, &py_mjpeg_type);
-    mjpeg->frames = 0;
-    mjpeg->bytes = 0;
-    mjpeg->us_old = 0;
-    mjpeg->us_avg = 0;
-    mjpeg->closed = 0;
-    mjpeg->width = (args[ARG_width].u_int == -1) ? framebuffer_get_width() : args[ARG_width].u_int;
-    mjpeg->height = (args[ARG_height].u_int == -1) ? framebuffer_get_height() : args[ARG_height].u_int;
+    py_mjpeg_obj_t *mjpeg = py_mjpeg_new(args[ARG_width].u_int, args[ARG_height].u_int, args[ARG_buffer_size].u_int);
+
+    if (args[ARG_preallocate].u_int < 0) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Preallocate size must be positive"));
+    }
 
     file_open(&mjpeg->fp, path, false, FA_WRITE | FA_CREATE_ALWAYS);
+
+    if (args[ARG_preallocate].u_int) {
+        mjpeg->preallocated = mjpeg_preallocate(&mjpeg->fp, args[ARG_preallocate].u_int);
+    }
+
     mjpeg_open(&mjpeg->fp, mjpeg->width, mjpeg->height);
     return mjpeg;
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_mjpeg_open_obj, 1, py_mjpeg_open);
 
+// Creates an armed recorder that compresses the frames written into the ring, overwriting
+// the oldest ones, until trigger() is called. This keeps the seconds before an event in a
+// fraction of the memory raw frames would need.
+static mp_obj_t py_mjpeg_recorder(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_width, ARG_height, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_width, MP_ARG_INT,  {.u_int = -1 } },
+        { MP_QSTR_height, MP_ARG_INT,  {.u_int = -1 } },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY,  {.u_int = -1 } },
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    py_mjpeg_obj_t *mjpeg = py_mjpeg_new(args[ARG_width].u_int, args[ARG_height].u_int, args[ARG_buffer_size].u_int);
+    mjpeg->recorder = true;
+    mjpeg->armed = true;
+    // Compressed frames are larger than a sector, so this does not limit the frames held.
+    mjpeg->index_size = mjpeg->buffer_size / MJPEG_SECTOR_SIZE;
+    mjpeg->index = m_new(uint32_t, mjpeg->index_size);
+    mjpeg->buffer = m_new(uint8_t, mjpeg->buffer_size);
+    return mjpeg;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_mjpeg_recorder_obj, 0, py_mjpeg_recorder);
+
 static const mp_rom_map_elem_t py_mjpeg_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__),    MP_ROM_QSTR(MP_QSTR_Mjpeg)          },
     { MP_ROM_QSTR(MP_QSTR___del__),     MP_ROM_PTR(&py_mjpeg_close_obj)     },
@@ -195,9 +578,15 @@ static const mp_rom_map_elem_t py_mjpeg_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_width),       MP_ROM_PTR(&py_mjpeg_width_obj)     },
     { MP_ROM_QSTR(MP_QSTR_height),      MP_ROM_PTR(&py_mjpeg_height_obj)    },
     { MP_ROM_QSTR(MP_QSTR_count),       MP_ROM_PTR(&py_mjpeg_count_obj)     },
+    { MP_ROM_QSTR(MP_QSTR_dropped),     MP_ROM_PTR(&py_mjpeg_dropped_obj)   },
+    { MP_ROM_QSTR(MP_QSTR_skipped),     MP_ROM_PTR(&py_mjpeg_skipped_obj)   },
     { MP_ROM_QSTR(MP_QSTR_size),        MP_ROM_PTR(&py_mjpeg_size_obj)      },
     { MP_ROM_QSTR(MP_QSTR_add_frame),   MP_ROM_PTR(&py_mjpeg_write_obj)     },
     { MP_ROM_QSTR(MP_QSTR_write),       MP_ROM_PTR(&py_mjpeg_write_obj)     },
+    { MP_ROM_QSTR(MP_QSTR_write_async), MP_ROM_PTR(&py_mjpeg_write_async_obj) },
+    { MP_ROM_QSTR(MP_QSTR_trigger),     MP_ROM_PTR(&py_mjpeg_trigger_obj)   },
+    { MP_ROM_QSTR(MP_QSTR_is_armed),    MP_ROM_PTR(&py_mjpeg_is_armed_obj)  },
+    { MP_ROM_QSTR(MP_QSTR_remaining),   MP_ROM_PTR(&py_mjpeg_remaining_obj) },
     { MP_ROM_QSTR(MP_QSTR_sync),        MP_ROM_PTR(&py_mjpeg_sync_obj)      },
     { MP_ROM_QSTR(MP_QSTR_close),       MP_ROM_PTR(&py_mjpeg_close_obj)     },
 };
@@ -215,6 +604,7 @@ static MP_DEFINE_CONST_OBJ_TYPE(
 static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__),    MP_ROM_QSTR(MP_QSTR_mjpeg)      },
     { MP_ROM_QSTR(MP_QSTR_Mjpeg),       MP_ROM_PTR(&py_mjpeg_open_obj)  },
+    { MP_ROM_QSTR(MP_QSTR_Recorder),    MP_ROM_PTR(&py_mjpeg_recorder_obj) },
 };
 
 static MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
@@ -224,5 +614,6 @@ const mp_obj_module_t mjpeg_module = {
     .globals = (mp_obj_t) &globals_dict,
 };
 
+MP_REGISTER_ROOT_POINTER(struct py_mjpeg_obj *mjpeg_async_stream);
 MP_REGISTER_MODULE(MP_QSTR_mjpeg, mjpeg_module);
 #endif // IMLIB_ENABLE_IMAGE_FILE_IO
@@ -14,6 +14,8 @@
 #include "py/objlist.h"
 #include "py/objtuple.h"
 #include "py/binary.h"
+#include "py/stream.h"
+#include "py/builtin.h"
 
 #include "py_helper.h"
 #include "imlib_config.h"
@@ -49,11 +51,288 @@ static size_t pl_ml_dtype_size(char dtype) {
     }
 }
 
-static void py_ml_process_input(py_ml_model_obj_t *model, mp_obj_t arg) {
+// Image input normalization, same parameters as ml.preprocessing.Normalization.
+typedef struct py_ml_input_norm {
+    float scale[2];
+    float mean[3];
+    float stdev[3];
+} py_ml_input_norm_t;
+
+// Maps each 8-bit channel value to its normalized and quantized tensor value, so converting a
+// pixel is one table lookup per channel. Single channel tensors use the grayscale weighted mean
+// and stdev like ml.preprocessing.Normalization.
+static void *py_ml_input_lut(py_ml_input_norm_t *norm, int channels, int dtype, float input_scale, int zero_point) {
+    void *lut = fb_alloc(channels * 256 * pl_ml_dtype_size(dtype), FB_ALLOC_PREFER_SPEED);
+
+    for (int c = 0; c < channels; c++) {
+        float mean = norm->mean[c];
+        float stdev = norm->stdev[c];
+
+        if (channels == 1) {
+            mean = (norm->mean[0] * 0.299f) + (norm->mean[1] * 0.587f) + (norm->mean[2] * 0.114f);
+            stdev = (norm->stdev[0] * 0.299f) + (norm->stdev[1] * 0.587f) + (norm->stdev[2] * 0.114f);
+        }
+
+        float fscale = ((norm->scale[1] - norm->scale[0]) / 255.0f) / stdev;
+        float fadd = (norm->scale[0] - mean) / stdev;
+
+        for (int i = 0; i < 256; i++) {
+            float value = (i * fscale) + fadd;
+            if (dtype == 'f') {
+                ((float *) lut)[(c * 256) + i] = value;
+            } else if (dtype == 'b') {
+                ((int8_t *) lut)[(c * 256) + i] = IM_CLAMP(fast_roundf(value * input_scale) + zero_point, INT8_MIN, INT8_MAX);
+            } else {
+                ((uint8_t *) lut)[(c * 256) + i] = IM_CLAMP(fast_roundf(value * input_scale) + zero_point, 0, UINT8_MAX);
+            }
+        }
+    }
+
+    return lut;
+}
+
+// Converts pixels to tensor values using the lookup table built by py_ml_input_lut() if any.
+// Otherwise, integer tensors use the same encoding as Image.to_ndarray() and float tensors are
+// scaled to 0.0-1.0, which matches the default ml.preprocessing.Normalization.
+static void py_ml_convert_pixels(void *tensor, const void *pixels, size_t len, pixformat_t pixfmt, int dtype,
+                                 const void *lut) {
+    if (lut) {
+        if (pixfmt == PIXFORMAT_GRAYSCALE) {
+            const uint8_t *input_u8 = (const uint8_t *) pixels;
+            if (dtype == 'f') {
+                for (size_t i = 0; i < len; i++) {
+                    ((float *) tensor)[i] = ((const float *) lut)[input_u8[i]];
+                }
+            } else {
+                for (size_t i = 0; i < len; i++) {
+                    ((uint8_t *) tensor)[i] = ((const uint8_t *) lut)[input_u8[i]];
+                }
+            }
+        } else {
+            const uint16_t *input_u16 = (const uint16_t *) pixels;
+            if (dtype == 'f') {
+                const float *lut_f32 = (const float *) lut;
+                float *output_f32 = (float *) tensor;
+                for (size_t i = 0, j = 0; i < len; i++, j += 3) {
+                    int pixel = input_u16[i];
+                    output_f32[j + 0] = lut_f32[COLOR_RGB565_TO_R8(pixel)];
+                    output_f32[j + 1] = lut_f32[256 + COLOR_RGB565_TO_G8(pixel)];
+                    output_f32[j + 2] = lut_f32[512 + COLOR_RGB565_TO_B8(pixel)];
+                }
+            } else {
+                const uint8_t *lut_u8 = (const uint8_t *) lut;
+                uint8_t *output_u8 = (uint8_t *) tensor;
+                for (size_t i = 0, j = 0; i < len; i++, j += 3) {
+                    int pixel = input_u16[i];
+                    output_u8[j + 0] = lut_u8[COLOR_RGB565_TO_R8(pixel)];
+                    output_u8[j + 1] = lut_u8[256 + COLOR_RGB565_TO_G8(pixel)];
+                    output_u8[j + 2] = lut_u8[512 + COLOR_RGB565_TO_B8(pixel)];
+                }
+            }
+        }
+    } else if (pixfmt == PIXFORMAT_GRAYSCALE) {
+        const uint8_t *input_u8 = (const uint8_t *) pixels;
+        if (dtype == 'f') {
+            float *output_f32 = (float *) tensor;
+            for (size_t i = 0; i < len; i++) {
+                output_f32[i] = input_u8[i] * (1.0f / 255.0f);
+            }
+        } else {
+            uint8_t *output_u8 = (uint8_t *) tensor;
+            uint32_t shift = (dtype == 'b') ? 0x80808080 : 0x00000000;
+            size_t i = 0;
+
+            for (; (i + 4) <= len; i += 4) {
+                *((uint32_t *) (output_u8 + i)) = *((uint32_t *) (input_u8 + i)) ^ shift;
+            }
+
+            for (; i < len; i++) {
+                output_u8[i] = input_u8[i] ^ shift;
+            }
+        }
+    } else {
+        const uint16_t *input_u16 = (const uint16_t *) pixels;
+        if (dtype == 'f') {
+            float *output_f32 = (float *) tensor;
+            for (size_t i = 0, j = 0; i < len; i++, j += 3) {
+                int pixel = input_u16[i];
+                output_f32[j + 0] = COLOR_RGB565_TO_R8(pixel) * (1.0f / 255.0f);
+                output_f32[j + 1] = COLOR_RGB565_TO_G8(pixel) * (1.0f / 255.0f);
+                output_f32[j + 2] = COLOR_RGB565_TO_B8(pixel) * (1.0f / 255.0f);
+            }
+        } else {
+            imlib_rgb565_to_rgb888((uint8_t *) tensor, input_u16, len, (dtype == 'b') ? 0x80 : 0x00);
+        }
+    }
+}
+
+// Converts 8-bit channel values (grayscale or RGB888) to tensor values like py_ml_convert_pixels().
+static void py_ml_convert_bytes(void *tensor, const uint8_t *bytes, size_t len, int channels, int dtype,
+                                const void *lut) {
+    if (lut && (dtype == 'f')) {
+        for (size_t i = 0; i < len; i += channels) {
+            for (int c = 0; c < channels; c++) {
+                ((float *) tensor)[i + c] = ((const float *) lut)[(c * 256) + bytes[i + c]];
+            }
+        }
+    } else if (lut) {
+        for (size_t i = 0; i < len; i += channels) {
+            for (int c = 0; c < channels; c++) {
+                ((uint8_t *) tensor)[i + c] = ((const uint8_t *) lut)[(c * 256) + bytes[i + c]];
+            }
+        }
+    } else if (dtype == 'f') {
+        for (size_t i = 0; i < len; i++) {
+            ((float *) tensor)[i] = bytes[i] * (1.0f / 255.0f);
+        }
+    } else {
+        uint8_t shift = (dtype == 'b') ? 0x80 : 0x00;
+        for (size_t i = 0; i < len; i++) {
+            ((uint8_t *) tensor)[i] = bytes[i] ^ shift;
+        }
+    }
+}
+
+typedef struct py_ml_input_row_data {
+    void *tensor;
+    int dtype;
+    const void *lut;
+    int w;
+    int channels;
+} py_ml_input_row_data_t;
+
+// Called by imlib_mean_pool_rows() for each pooled row, which is converted straight into the tensor.
+static void py_ml_input_pool_row(int y, const void *row, void *arg) {
+    py_ml_input_row_data_t *data = (py_ml_input_row_data_t *) arg;
+    size_t len = data->w * data->channels;
+    py_ml_convert_bytes(((uint8_t *) data->tensor) + (y * len * pl_ml_dtype_size(data->dtype)),
+                        row, len, data->channels, data->dtype, data->lut);
+}
+
+// Called by imlib_draw_image() for each scaled row, which is converted straight into the tensor.
+static void py_ml_input_draw_row(int x_start, int x_end, int y_row, imlib_draw_row_data_t *data) {
+    py_ml_input_row_data_t *arg = (py_ml_input_row_data_t *) data->callback_arg;
+    image_t *dst_img = data->dst_img;
+    size_t channels = (dst_img->pixfmt == PIXFORMAT_GRAYSCALE) ? 1 : 3;
+    size_t pixel_size = (dst_img->pixfmt == PIXFORMAT_GRAYSCALE) ? sizeof(uint8_t) : sizeof(uint16_t);
+    size_t offset = ((y_row * dst_img->w) + x_start) * channels * pl_ml_dtype_size(arg->dtype);
+
+    py_ml_convert_pixels(((uint8_t *) arg->tensor) + offset,
+                         ((uint8_t *) data->dst_row_override) + (x_start * pixel_size),
+                         x_end - x_start, dst_img->pixfmt, arg->dtype, arg->lut);
+}
+
+// Writes an image roi into an input tensor with the shape (1, H, W, C) without going through an
+// intermediate image or ndarray. If the roi already has the tensor's size and format (e.g. the
+// sensor's windowing is set to the model's input size) it's converted directly from the frame
+// buffer. Otherwise, it's scaled to fit and each row is converted as it's drawn. With norm, the
+// pixels are normalized and quantized with the tensor's scale and zero point in the same pass.
+static void py_ml_process_image_input(void *input_buffer, mp_obj_tuple_t *input_shape, int input_dtype,
+                                      float input_scale, int input_zero_point, py_ml_input_norm_t *norm,
+                                      image_t *src_img, rectangle_t *roi) {
+    if (input_shape->len != 4 || mp_obj_get_int(input_shape->items[0]) != 1) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected input tensor with shape: (1, H, W, C)"));
+    }
+
+    int h = mp_obj_get_int(input_shape->items[1]);
+    int w = mp_obj_get_int(input_shape->items[2]);
+    int c = mp_obj_get_int(input_shape->items[3]);
+
+    if (c != 1 && c != 3) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected channels to be 1 or 3"));
+    }
+
+    if (input_dtype != 'b' && input_dtype != 'B' && input_dtype != 'f') {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unsupported input tensor dtype for an image"));
+    }
+
+    image_t dst_img = {.w = w, .h = h, .pixfmt = (c == 1) ? PIXFORMAT_GRAYSCALE : PIXFORMAT_RGB565};
+
+    fb_alloc_mark();
+
+    const void *lut = norm ? py_ml_input_lut(norm, c, input_dtype, input_scale, input_zero_point) : NULL;
+
+    if ((roi->x == 0) && (roi->y == 0) && (roi->w == w) && (roi->h == h) &&
+        (src_img->w == w) && (src_img->h == h) && (src_img->pixfmt == dst_img.pixfmt)) {
+        py_ml_convert_pixels(input_buffer, src_img->data, w * h, dst_img.pixfmt, input_dtype, lut);
+        fb_alloc_free_till_mark();
+        return;
+    }
+
+    // If the roi is an integer multiple of the tensor's size it's mean pooled straight into the
+    // tensor, which averages every pixel and is cheaper than scaling it.
+    int div = roi->w / w;
+    if ((div > 1) && (div <= 256) && (roi->w == (w * div)) && (roi->h == (h * div)) &&
+        ((src_img->pixfmt == PIXFORMAT_GRAYSCALE) || (src_img->pixfmt == PIXFORMAT_RGB565))) {
+        py_ml_input_row_data_t pool_data = {
+            .tensor = input_buffer, .dtype = input_dtype, .lut = lut, .w = w, .channels = c
+        };
+        imlib_mean_pool_rows(src_img, roi, div, div, (c == 1) ? IMLIB_POOL_OUT_GRAYSCALE : IMLIB_POOL_OUT_RGB888,
+                             py_ml_input_pool_row, &pool_data);
+        fb_alloc_free_till_mark();
+        return;
+    }
+
+    // Rows, or parts of rows, not covered by the image are left black.
+    if (!lut) {
+        memset(input_buffer, (input_dtype == 'b') ? 0x80 : 0x00, w * h * c * pl_ml_dtype_size(input_dtype));
+    } else if (input_dtype == 'f') {
+        for (size_t i = 0, n = w * h; i < n; i++) {
+            for (int j = 0; j < c; j++) {
+                ((float *) input_buffer)[(i * c) + j] = ((const float *) lut)[j * 256];
+            }
+        }
+    } else {
+        for (size_t i = 0, n = w * h; i < n; i++) {
+            for (int j = 0; j < c; j++) {
+                ((uint8_t *) input_buffer)[(i * c) + j] = ((const uint8_t *) lut)[j * 256];
+            }
+        }
+    }
+
+    py_ml_input_row_data_t row_data = {.tensor = input_buffer, .dtype = input_dtype, .lut = lut};
+    image_hint_t hint = IMAGE_HINT_BILINEAR | IMAGE_HINT_CENTER |
+                        IMAGE_HINT_SCALE_ASPECT_EXPAND | IMAGE_HINT_BLACK_BACKGROUND;
+    dst_img.data = fb_alloc0(image_line_size(&dst_img), FB_ALLOC_CACHE_ALIGN);
+
+    imlib_draw_image(&dst_img, src_img, 0, 0, 1.0f, 1.0f, roi, -1, 256, NULL, NULL,
+                     hint, py_ml_input_draw_row, &row_data, dst_img.data);
+
+    fb_alloc_free_till_mark();
+}
+
+// Returns NULL when no normalization is requested so that images use the default conversion.
+static py_ml_input_norm_t *py_ml_arg_to_norm(mp_obj_t scale, mp_obj_t mean, mp_obj_t stdev, py_ml_input_norm_t *norm) {
+    if ((scale == mp_const_none) && (mean == mp_const_none) && (stdev == mp_const_none)) {
+        return NULL;
+    }
+
+    *norm = (py_ml_input_norm_t) {
+        .scale = {0.0f, 1.0f}, .mean = {0.0f, 0.0f, 0.0f}, .stdev = {1.0f, 1.0f, 1.0f}
+    };
+
+    py_helper_arg_to_float_array(scale, norm->scale, 2);
+    py_helper_arg_to_float_array(mean, norm->mean, 3);
+    py_helper_arg_to_float_array(stdev, norm->stdev, 3);
+
+    for (int i = 0; i < 3; i++) {
+        if (norm->stdev[i] == 0.0f) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("stdev must be non-zero"));
+        }
+    }
+
+    return norm;
+}
+
+// The roi of the first image input is returned in window_roi, it's used to map detections back to
+// the image. It's left unchanged if there are no image inputs.
+static void py_ml_process_input(py_ml_model_obj_t *model, mp_obj_t arg, mp_obj_t roi_obj,
+                                py_ml_input_norm_t *norm, rectangle_t *window_roi) {
     mp_obj_list_t *input_list = MP_OBJ_TO_PTR(arg);
+    bool window_roi_set = false;
 
     for (size_t i = 0; i < model->inputs_size; i++) {
-        void *input_buffer = ml_backend_get_input(model, i);
+        void *input_buffer = model->backend->get_input(model, i);
         size_t input_size = py_ml_tuple_sum(MP_OBJ_TO_PTR(model->input_shape->items[i]));
         mp_obj_tuple_t *input_shape = MP_OBJ_TO_PTR(model->input_shape->items[i]);
         float input_scale = 1.0f / mp_obj_get_float(model->input_scale->items[i]);
@@ -69,6 +348,18 @@ static void py_ml_process_input(py_ml_model_obj_t *model, mp_obj_t arg) {
                 mp_obj_new_int(input_dtype)
             };
             mp_call_function_n_kw(input_arg, 3, 0, fargs);
+        } else if (MP_OBJ_IS_TYPE(input_arg, &py_image_type)) {
+            // Input is an image. The image is converted directly into the tensor buffer.
+            fb_alloc_mark();
+            image_t *image = py_helper_arg_to_image(input_arg, ARG_IMAGE_ANY | ARG_IMAGE_ALLOC);
+            rectangle_t roi = py_helper_arg_to_roi(roi_obj, image);
+            py_ml_process_image_input(input_buffer, input_shape, input_dtype, input_scale,
+                                      input_zero_point, norm, image, &roi);
+            if (!window_roi_set) {
+                *window_roi = roi;
+                window_roi_set = true;
+            }
+            fb_alloc_free_till_mark();
         } else if (MP_OBJ_IS_TYPE(input_arg, &ulab_ndarray_type)) {
             // Input is an ndarry. The input is converted and copied to the tensor buffer.
             ndarray_obj_t *input_array = MP_OBJ_TO_PTR(input_arg);
@@ -123,10 +414,37 @@ static void py_ml_process_input(py_ml_model_obj_t *model, mp_obj_t arg) {
     }
 }
 
+static void py_ml_dequantize_output(float *output, const void *model_output, size_t size,
+                                    int output_dtype, float output_scale, int output_zero_point) {
+    if (output_dtype == 'f') {
+        memcpy(output, model_output, size * sizeof(float));
+    } else if (output_dtype == 'b') {
+        for (size_t j = 0; j < size; j++) {
+            float v = (((int8_t *) model_output)[j] - output_zero_point);
+            output[j] = v * output_scale;
+        }
+    } else if (output_dtype == 'B') {
+        for (size_t j = 0; j < size; j++) {
+            float v = (((uint8_t *) model_output)[j] - output_zero_point);
+            output[j] = v * output_scale;
+        }
+    } else if (output_dtype == 'h') {
+        for (size_t j = 0; j < size; j++) {
+            float v = (((int16_t *) model_output)[j] - output_zero_point);
+            output[j] = v * output_scale;
+        }
+    } else if (output_dtype == 'H') {
+        for (size_t j = 0; j < size; j++) {
+            float v = (((uint16_t *) model_output)[j] - output_zero_point);
+            output[j] = v * output_scale;
+        }
+    }
+}
+
 static mp_obj_t py_ml_process_output(py_ml_model_obj_t *model) {
     mp_obj_list_t *output_list = MP_OBJ_TO_PTR(mp_obj_new_list(model->outputs_size, NULL));
     for (size_t i = 0; i < model->outputs_size; i++) {
-        void *model_output = ml_backend_get_output(model, i);
+        void *model_output = model->backend->get_output(model, i);
         size_t size = py_ml_tuple_sum(MP_OBJ_TO_PTR(model->output_shape->items[i]));
         mp_obj_tuple_t *output_shape = MP_OBJ_TO_PTR(model->output_shape->items[i]);
         float output_scale = mp_obj_get_float(model->output_scale->items[i]);
@@ -145,34 +463,321 @@ static mp_obj_t py_ml_process_output(py_ml_model_obj_t *model) {
         }
 
         ndarray_obj_t *ndarray = ndarray_new_dense_ndarray(output_shape->len, shape, NDARRAY_FLOAT);
+        py_ml_dequantize_output(ndarray->array, model_output, size, output_dtype, output_scale, output_zero_point);
+        output_list->items[i] = MP_OBJ_FROM_PTR(ndarray);
+    }
+
+    return MP_OBJ_FROM_PTR(output_list);
+}
+
+// Returns an ndarray that shares the output tensor's memory and keeps its dtype. It's only valid
+// until the next inference, the values are dequantized with the model's output_scale/zero_point.
+static mp_obj_t py_ml_output_view(py_ml_model_obj_t *model, size_t index) {
+    mp_obj_tuple_t *output_shape = MP_OBJ_TO_PTR(model->output_shape->items[index]);
+    int output_dtype = mp_obj_get_int(model->output_dtype->items[index]);
+    size_t itemsize = pl_ml_dtype_size(output_dtype);
+
+    if (ULAB_MAX_DIMS < output_shape->len) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Output shape has too many dimensions"));
+    }
+
+    ndarray_obj_t *ndarray = m_new_obj(ndarray_obj_t);
+    ndarray->base.type = &ulab_ndarray_type;
+    ndarray->dtype = output_dtype;
+    ndarray->boolean = NDARRAY_NUMERIC;
+    ndarray->ndim = output_shape->len;
+    ndarray->len = py_ml_tuple_sum(output_shape);
+    ndarray->itemsize = itemsize;
+    memset(ndarray->shape, 0, sizeof(ndarray->shape));
+    memset(ndarray->strides, 0, sizeof(ndarray->strides));
+
+    for (int j = ULAB_MAX_DIMS - 1, k = output_shape->len - 1, stride = itemsize; k >= 0; j--, k--) {
+        ndarray->shape[j] = mp_obj_get_int(output_shape->items[k]);
+        ndarray->strides[j] = stride;
+        stride *= ndarray->shape[j];
+    }
 
-        if (output_dtype == 'f') {
-            memcpy(ndarray->array, model_output, size * sizeof(float));
-        } else if (output_dtype == 'b') {
-            for (size_t j = 0; j < size; j++) {
-                float v = (((int8_t *) model_output)[j] - output_zero_point);
-                ((float *) ndarray->array)[j] = v * output_scale;
+    ndarray->array = model->backend->get_output(model, index);
+    ndarray->origin = ndarray->array;
+    return MP_OBJ_FROM_PTR(ndarray);
+}
+
+// Built-in detection post-processing, decoded straight from the (quantized) output tensor.
+#define PY_ML_POSTPROCESS_FOMO      (1)
+#define PY_ML_POSTPROCESS_YOLO_V5   (2)
+#define PY_ML_POSTPROCESS_YOLO_V8   (3)
+
+typedef struct py_ml_tensor {
+    const void *data;
+    int dtype;
+    float scale;
+    int zero_point;
+} py_ml_tensor_t;
+
+typedef struct py_ml_detection {
+    float x, y, w, h; // Box in window coordinates.
+    float score;
+    int label;
+} py_ml_detection_t;
+
+static void py_ml_output_tensor(py_ml_model_obj_t *model, size_t index, py_ml_tensor_t *t) {
+    t->data = model->backend->get_output(model, index);
+    t->dtype = mp_obj_get_int(model->output_dtype->items[index]);
+    t->scale = mp_obj_get_float(model->output_scale->items[index]);
+    t->zero_point = mp_obj_get_int(model->output_zero_point->items[index]);
+}
+
+static inline int py_ml_tensor_raw(const py_ml_tensor_t *t, size_t i) {
+    switch (t->dtype) {
+        case 'b':
+            return ((const int8_t *) t->data)[i];
+        case 'B':
+            return ((const uint8_t *) t->data)[i];
+        case 'h':
+            return ((const int16_t *) t->data)[i];
+        case 'H':
+            return ((const uint16_t *) t->data)[i];
+        default:
+            return 0;
+    }
+}
+
+static inline float py_ml_tensor_get(const py_ml_tensor_t *t, size_t i) {
+    if (t->dtype == 'f') {
+        return ((const float *) t->data)[i];
+    }
+    return (py_ml_tensor_raw(t, i) - t->zero_point) * t->scale;
+}
+
+// Score thresholds are compared in the quantized domain so rejected values are never dequantized.
+static inline int py_ml_tensor_quantize_threshold(const py_ml_tensor_t *t, float threshold) {
+    return (t->dtype == 'f') ? 0 : (fast_ceilf(threshold / t->scale) + t->zero_point);
+}
+
+static inline bool py_ml_tensor_ge(const py_ml_tensor_t *t, size_t i, int q_threshold, float threshold) {
+    return (t->dtype == 'f') ? (((const float *) t->data)[i] >= threshold) : (py_ml_tensor_raw(t, i) >= q_threshold);
+}
+
+// FOMO outputs a (1, H, W, C) heatmap per class, class 0 being the background. Each 8-connected
+// group of cells above the threshold is a detection, scored with the mean of its cells.
+static size_t py_ml_fomo_decode(const py_ml_tensor_t *t, mp_obj_tuple_t *shape, float threshold,
+                                py_ml_detection_t *dets, size_t max_dets) {
+    int h = mp_obj_get_int(shape->items[1]);
+    int w = mp_obj_get_int(shape->items[2]);
+    int c = mp_obj_get_int(shape->items[3]);
+    int q_threshold = py_ml_tensor_quantize_threshold(t, threshold);
+    size_t n = 0;
+
+    uint8_t *visited = fb_alloc(w * h, FB_ALLOC_NO_HINT);
+    uint16_t *stack = fb_alloc(w * h * sizeof(uint16_t), FB_ALLOC_NO_HINT);
+
+    for (int label = 1; label < c; label++) {
+        memset(visited, 0, w * h);
+
+        for (int i = 0; i < (w * h); i++) {
+            if (visited[i] || (!py_ml_tensor_ge(t, (i * c) + label, q_threshold, threshold))) {
+                continue;
+            }
+
+            int x_min = w, y_min = h, x_max = 0, y_max = 0, cells = 0, sp = 0;
+            float sum = 0.0f;
+            visited[i] = 1;
+            stack[sp++] = i;
+
+            while (sp) {
+                int cell = stack[--sp];
+                int cx = cell % w, cy = cell / w;
+                x_min = IM_MIN(x_min, cx);
+                y_min = IM_MIN(y_min, cy);
+                x_max = IM_MAX(x_max, cx);
+                y_max = IM_MAX(y_max, cy);
+                sum += py_ml_tensor_get(t, (cell * c) + label);
+                cells++;
+
+                for (int y = IM_MAX(cy - 1, 0); y <= IM_MIN(cy + 1, h - 1); y++) {
+                    for (int x = IM_MAX(cx - 1, 0); x <= IM_MIN(cx + 1, w - 1); x++) {
+                        int j = (y * w) + x;
+                        if ((!visited[j]) && py_ml_tensor_ge(t, (j * c) + label, q_threshold, threshold)) {
+                            visited[j] = 1;
+                            stack[sp++] = j;
+                        }
+                    }
+                }
             }
-        } else if (output_dtype == 'B') {
-            for (size_t j = 0; j < size; j++) {
-                float v = (((uint8_t *) model_output)[j] - output_zero_point);
-                ((float *) ndarray->array)[j] = v * output_scale;
+
+            if (n < max_dets) {
+                dets[n++] = (py_ml_detection_t) {
+                    x_min, y_min, x_max - x_min + 1, y_max - y_min + 1, sum / cells, label
+                };
             }
-        } else if (output_dtype == 'h') {
-            for (size_t j = 0; j < size; j++) {
-                float v = (((int16_t *) model_output)[j] - output_zero_point);
-                ((float *) ndarray->array)[j] = v * output_scale;
+        }
+    }
+
+    fb_free(); // stack
+    fb_free(); // visited
+    return n;
+}
+
+// YOLOv5 outputs (1, N, 5 + C) rows of (cx, cy, w, h, objectness, class scores...) and YOLOv8
+// outputs (1, 4 + C, N) columns of (cx, cy, w, h, class scores...). Boxes are normalized to the
+// input size.
+static size_t py_ml_yolo_decode(const py_ml_tensor_t *t, mp_obj_tuple_t *shape, bool v8, float threshold,
+                                int window_w, int window_h, py_ml_detection_t *dets, size_t max_dets) {
+    int rows = mp_obj_get_int(shape->items[1]);
+    int cols = mp_obj_get_int(shape->items[2]);
+    int anchors = v8 ? cols : rows;
+    int classes = (v8 ? rows : cols) - (v8 ? 4 : 5);
+    // Element stride between consecutive values of one anchor and between anchors.
+    int value_stride = v8 ? cols : 1;
+    int anchor_stride = v8 ? 1 : cols;
+    int class_offset = v8 ? 4 : 5;
+    int q_threshold = py_ml_tensor_quantize_threshold(t, threshold);
+    size_t n = 0;
+
+    for (int a = 0; (a < anchors) && (n < max_dets); a++) {
+        size_t base = a * anchor_stride;
+        float objectness = 1.0f;
+
+        if (!v8) {
+            // Scores are products with the objectness so most anchors are rejected here.
+            if (!py_ml_tensor_ge(t, base + (4 * value_stride), q_threshold, threshold)) {
+                continue;
             }
-        } else if (output_dtype == 'H') {
-            for (size_t j = 0; j < size; j++) {
-                float v = (((uint16_t *) model_output)[j] - output_zero_point);
-                ((float *) ndarray->array)[j] = v * output_scale;
+            objectness = py_ml_tensor_get(t, base + (4 * value_stride));
+        }
+
+        // Find the best class in the quantized domain, the scale is positive.
+        int label = 0;
+        size_t best = base + (class_offset * value_stride);
+        for (int k = 1; k < classes; k++) {
+            size_t i = base + ((class_offset + k) * value_stride);
+            if ((t->dtype == 'f') ? (((const float *) t->data)[i] > ((const float *) t->data)[best])
+                                  : (py_ml_tensor_raw(t, i) > py_ml_tensor_raw(t, best))) {
+                best = i;
+                label = k;
             }
         }
-        output_list->items[i] = MP_OBJ_FROM_PTR(ndarray);
+
+        float score = objectness * py_ml_tensor_get(t, best);
+        if (score < threshold) {
+            continue;
+        }
+
+        float bw = py_ml_tensor_get(t, base + (2 * value_stride)) * window_w;
+        float bh = py_ml_tensor_get(t, base + (3 * value_stride)) * window_h;
+        dets[n++] = (py_ml_detection_t) {
+            (py_ml_tensor_get(t, base) * window_w) - (bw / 2.0f),
+            (py_ml_tensor_get(t, base + value_stride) * window_h) - (bh / 2.0f),
+            bw, bh, score, label
+        };
     }
 
-    return MP_OBJ_FROM_PTR(output_list);
+    return n;
+}
+
+static int py_ml_detection_compare(const void *a, const void *b) {
+    float sa = ((const py_ml_detection_t *) a)->score;
+    float sb = ((const py_ml_detection_t *) b)->score;
+    return (sa < sb) - (sa > sb);
+}
+
+static float py_ml_detection_iou(const py_ml_detection_t *a, const py_ml_detection_t *b) {
+    float w = IM_MIN(a->x + a->w, b->x + b->w) - IM_MAX(a->x, b->x);
+    float h = IM_MIN(a->y + a->h, b->y + b->h) - IM_MAX(a->y, b->y);
+    if ((w <= 0.0f) || (h <= 0.0f)) {
+        return 0.0f;
+    }
+    float intersection = w * h;
+    return intersection / ((a->w * a->h) + (b->w * b->h) - intersection);
+}
+
+// Class-aware greedy NMS, then the boxes are mapped from the window back to the image roi like
+// ml.utils.NMS. Returns a list per class of ((x, y, w, h), score) tuples.
+static mp_obj_t py_ml_detections_to_list(py_ml_detection_t *dets, size_t n, int classes, float iou_threshold,
+                                         int window_w, int window_h, rectangle_t *roi) {
+    qsort(dets, n, sizeof(py_ml_detection_t), py_ml_detection_compare);
+
+    float scale = IM_MIN(roi->w / ((float) window_w), roi->h / ((float) window_h));
+    float x_offset = ((roi->w - (window_w * scale)) / 2.0f) + roi->x;
+    float y_offset = ((roi->h - (window_h * scale)) / 2.0f) + roi->y;
+
+    mp_obj_list_t *list = MP_OBJ_TO_PTR(mp_obj_new_list(classes, NULL));
+    for (int i = 0; i < classes; i++) {
+        list->items[i] = mp_obj_new_list(0, NULL);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        if (dets[i].score < 0.0f) {
+            continue; // Suppressed.
+        }
+
+        for (size_t j = i + 1; j < n; j++) {
+            if ((dets[j].label == dets[i].label) && (dets[j].score >= 0.0f) &&
+                (py_ml_detection_iou(&dets[i], &dets[j]) > iou_threshold)) {
+                dets[j].score = -1.0f;
+            }
+        }
+
+        mp_obj_t rect[4] = {
+            mp_obj_new_int(fast_floorf((dets[i].x * scale) + x_offset)),
+            mp_obj_new_int(fast_floorf((dets[i].y * scale) + y_offset)),
+            mp_obj_new_int(fast_floorf(dets[i].w * scale)),
+            mp_obj_new_int(fast_floorf(dets[i].h * scale))
+        };
+        mp_obj_t item[2] = { mp_obj_new_tuple(4, rect), mp_obj_new_float(dets[i].score) };
+        mp_obj_list_append(list->items[dets[i].label], mp_obj_new_tuple(2, item));
+    }
+
+    return MP_OBJ_FROM_PTR(list);
+}
+
+static mp_obj_t py_ml_postprocess(py_ml_model_obj_t *model, int postprocess, float threshold,
+                                  float iou_threshold, rectangle_t *roi) {
+    mp_obj_tuple_t *input_shape = MP_OBJ_TO_PTR(model->input_shape->items[0]);
+    mp_obj_tuple_t *output_shape = MP_OBJ_TO_PTR(model->output_shape->items[0]);
+    size_t expected_dims = (postprocess == PY_ML_POSTPROCESS_FOMO) ? 4 : 3;
+    py_ml_tensor_t t;
+
+    if ((input_shape->len != 4) || (output_shape->len != expected_dims)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unexpected tensor shape"));
+    }
+
+    py_ml_output_tensor(model, 0, &t);
+
+    bool fomo = postprocess == PY_ML_POSTPROCESS_FOMO;
+    bool v8 = postprocess == PY_ML_POSTPROCESS_YOLO_V8;
+    int window_w, window_h, classes;
+    size_t n, max_dets;
+
+    if (fomo) {
+        // Boxes are in output cells, which map to the whole input.
+        window_w = mp_obj_get_int(output_shape->items[2]);
+        window_h = mp_obj_get_int(output_shape->items[1]);
+        classes = mp_obj_get_int(output_shape->items[3]);
+        max_dets = ((window_w + 1) / 2) * ((window_h + 1) / 2) * IM_MAX(classes - 1, 0);
+    } else {
+        window_w = mp_obj_get_int(input_shape->items[2]);
+        window_h = mp_obj_get_int(input_shape->items[1]);
+        classes = mp_obj_get_int(output_shape->items[v8 ? 1 : 2]) - (v8 ? 4 : 5);
+        max_dets = mp_obj_get_int(output_shape->items[v8 ? 2 : 1]);
+    }
+
+    if (classes < 1) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unexpected output tensor shape"));
+    }
+
+    fb_alloc_mark();
+    py_ml_detection_t *dets = fb_alloc(max_dets * sizeof(py_ml_detection_t), FB_ALLOC_NO_HINT);
+
+    if (fomo) {
+        n = py_ml_fomo_decode(&t, output_shape, threshold, dets, max_dets);
+    } else {
+        n = py_ml_yolo_decode(&t, output_shape, v8, threshold, window_w, window_h, dets, max_dets);
+    }
+
+    mp_obj_t list = py_ml_detections_to_list(dets, n, classes, iou_threshold, window_w, window_h, roi);
+    fb_alloc_free_till_mark();
+    return list;
 }
 
 // TF Model Object.
@@ -210,10 +815,91 @@ static void py_ml_model_print(const mp_print_t *print, mp_obj_t self_in, mp_prin
     mp_printf(print, " }");
 }
 
-static mp_obj_t py_ml_model_predict(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_callback };
+// Pending or finished inference, returned by Model.predict_async().
+typedef struct py_ml_result_obj {
+    mp_obj_base_t base;
+    py_ml_model_obj_t *model;
+    mp_obj_t inputs;
+    mp_obj_t callback;
+    bool dequantize;
+    int postprocess;
+    float threshold;
+    float iou_threshold;
+    rectangle_t window_roi;
+    mp_obj_t output; // MP_OBJ_NULL until the result is processed.
+} py_ml_result_obj_t;
+
+static const mp_obj_type_t py_ml_result_type;
+
+// Processes the outputs once the inference is done, waits for it if needed.
+static mp_obj_t py_ml_result_finish(py_ml_result_obj_t *result) {
+    py_ml_model_obj_t *model = result->model;
+
+    if (result->output != MP_OBJ_NULL) {
+        return result->output;
+    }
+
+    OMV_PROFILE_START(ml_inference);
+    model->backend->wait_inference(model, true);
+    OMV_PROFILE_END(ml_inference);
+
+    model->pending = mp_const_none;
+
+    mp_obj_t output;
+
+    OMV_PROFILE_START(ml_postprocess);
+    if (result->postprocess) {
+        output = py_ml_postprocess(model, result->postprocess, result->threshold,
+                                   result->iou_threshold, &result->window_roi);
+    } else if (!result->dequantize) {
+        mp_obj_list_t *output_list = MP_OBJ_TO_PTR(mp_obj_new_list(model->outputs_size, NULL));
+        for (size_t i = 0; i < model->outputs_size; i++) {
+            output_list->items[i] = py_ml_output_view(model, i);
+        }
+        output = MP_OBJ_FROM_PTR(output_list);
+    } else {
+        output = py_ml_process_output(model);
+    }
+    OMV_PROFILE_END(ml_postprocess);
+
+    if (result->callback != mp_const_none) {
+        // Pass model, inputs, outputs to the post-processing callback.
+        mp_obj_t fargs[3] = { MP_OBJ_FROM_PTR(model), result->inputs, output };
+        output = mp_call_function_n_kw(result->callback, 3, 0, fargs);
+    }
+
+    result->output = output;
+    return output;
+}
+
+// Finishes the pending inference of this model, or of the model that last used the arena shared
+// with this model, before the tensors are overwritten.
+static void py_ml_model_acquire(py_ml_model_obj_t *model) {
+    py_ml_model_obj_t *owner = model->backend->acquire_arena(model);
+
+    if (owner && (owner->pending != mp_const_none)) {
+        py_ml_result_finish(MP_OBJ_TO_PTR(owner->pending));
+    }
+
+    if (model->pending != mp_const_none) {
+        py_ml_result_finish(MP_OBJ_TO_PTR(model->pending));
+    }
+}
+
+// Converts the inputs and starts the inference.
+static py_ml_result_obj_t *py_ml_model_start(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_callback, ARG_roi, ARG_scale, ARG_mean, ARG_stdev, ARG_dequantize, ARG_postprocess,
+           ARG_threshold, ARG_iou_threshold };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_callback, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_roi, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_scale, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_mean, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_stdev, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_dequantize, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true} },
+        { MP_QSTR_postprocess, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0} },
+        { MP_QSTR_threshold, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_iou_threshold, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
     };
 
     // Parse args.
@@ -221,31 +907,195 @@ static mp_obj_t py_ml_model_predict(uint n_args, const mp_obj_t *pos_args, mp_ma
     mp_arg_parse_all(n_args - 2, pos_args + 2, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
 
     py_ml_model_obj_t *model = MP_OBJ_TO_PTR(pos_args[0]);
+    int postprocess = args[ARG_postprocess].u_int;
+
+    if ((postprocess < 0) || (postprocess > PY_ML_POSTPROCESS_YOLO_V8)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid post-processing type"));
+    }
+
+    if (postprocess && ((model->inputs_size != 1) || (model->outputs_size != 1))) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Post-processing requires a model with one input and output"));
+    }
 
     if (!MP_OBJ_IS_TYPE(pos_args[1], &mp_type_list)) {
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Unsupported input type. Expected a list"));
     }
 
-    OMV_PROFILE_START(preprocess);
-    py_ml_process_input(model, pos_args[1]);
-    OMV_PROFILE_PRINT(preprocess);
+    py_ml_model_acquire(model);
 
-    OMV_PROFILE_START(inference);
-    ml_backend_run_inference(model);
-    OMV_PROFILE_PRINT(inference);
+    py_ml_result_obj_t *result = mp_obj_malloc(py_ml_result_obj_t, &py_ml_result_type);
+    result->model = model;
+    result->inputs = pos_args[1];
+    result->callback = args[ARG_callback].u_obj;
+    result->dequantize = args[ARG_dequantize].u_bool;
+    result->postprocess = postprocess;
+    result->threshold = py_helper_arg_to_float(args[ARG_threshold].u_obj, 0.4f);
+    result->iou_threshold = py_helper_arg_to_float(args[ARG_iou_threshold].u_obj, 0.45f);
+    result->output = MP_OBJ_NULL;
 
-    mp_obj_t output = py_ml_process_output(model);
+    py_ml_input_norm_t norm;
+    py_ml_input_norm_t *norm_ptr = py_ml_arg_to_norm(args[ARG_scale].u_obj, args[ARG_mean].u_obj,
+                                                     args[ARG_stdev].u_obj, &norm);
 
-    if (args[ARG_callback].u_obj != mp_const_none) {
-        // Pass model, inputs, outputs to the post-processing callback.
-        mp_obj_t fargs[3] = { MP_OBJ_FROM_PTR(model), pos_args[1], output };
-        output = mp_call_function_n_kw(args[ARG_callback].u_obj, 3, 0, fargs);
+    // Without an image input, detections are returned in input tensor coordinates.
+    mp_obj_tuple_t *input_shape = MP_OBJ_TO_PTR(model->input_shape->items[0]);
+    result->window_roi = (rectangle_t) {0, 0, 1, 1};
+    if (input_shape->len == 4) {
+        result->window_roi.w = mp_obj_get_int(input_shape->items[2]);
+        result->window_roi.h = mp_obj_get_int(input_shape->items[1]);
     }
 
-    return output;
+    OMV_PROFILE_START(ml_preprocess);
+    py_ml_process_input(model, pos_args[1], args[ARG_roi].u_obj, norm_ptr, &result->window_roi);
+    OMV_PROFILE_END(ml_preprocess);
+
+    model->backend->start_inference(model);
+    model->pending = MP_OBJ_FROM_PTR(result);
+    return result;
+}
+
+static mp_obj_t py_ml_model_predict(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return py_ml_result_finish(py_ml_model_start(n_args, pos_args, kw_args));
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_ml_model_predict_obj, 2, py_ml_model_predict);
 
+// Same as predict() but returns as soon as the inference is started. On backends that offload
+// inference (e.g. to an NPU) the CPU can capture and process the next frame in the meantime.
+static mp_obj_t py_ml_model_predict_async(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    return MP_OBJ_FROM_PTR(py_ml_model_start(n_args, pos_args, kw_args));
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_ml_model_predict_async_obj, 2, py_ml_model_predict_async);
+
+static mp_obj_t py_ml_result_done(mp_obj_t self_in) {
+    py_ml_result_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_bool((self->output != MP_OBJ_NULL) || self->model->backend->wait_inference(self->model, false));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_ml_result_done_obj, py_ml_result_done);
+
+static mp_obj_t py_ml_result_result(mp_obj_t self_in) {
+    return py_ml_result_finish(MP_OBJ_TO_PTR(self_in));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_ml_result_result_obj, py_ml_result_result);
+
+static const mp_rom_map_elem_t py_ml_result_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_done),                MP_ROM_PTR(&py_ml_result_done_obj) },
+    { MP_ROM_QSTR(MP_QSTR_result),              MP_ROM_PTR(&py_ml_result_result_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(py_ml_result_locals_dict, py_ml_result_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_ml_result_type,
+    MP_QSTR_ml_result,
+    MP_TYPE_FLAG_NONE,
+    locals_dict, &py_ml_result_locals_dict
+    );
+
+// Runs the model back to back on each roi of an image. Each roi is cropped, scaled and quantized
+// straight into the input tensor, and the outputs are packed into one ndarray per output tensor
+// with the number of rois as the first dimension.
+static mp_obj_t py_ml_model_predict_batch(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_rois, ARG_scale, ARG_mean, ARG_stdev };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_rois, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_scale, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_mean, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_stdev, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 2, pos_args + 2, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    py_ml_model_obj_t *model = MP_OBJ_TO_PTR(pos_args[0]);
+
+    if (model->inputs_size != 1) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Batched inference requires a model with one input"));
+    }
+
+    size_t n_rois;
+    mp_obj_t *rois;
+    mp_obj_get_array(args[ARG_rois].u_obj, &n_rois, &rois);
+
+    // Allocate the packed outputs.
+    mp_obj_list_t *output_list = MP_OBJ_TO_PTR(mp_obj_new_list(model->outputs_size, NULL));
+    for (size_t i = 0; i < model->outputs_size; i++) {
+        mp_obj_tuple_t *output_shape = MP_OBJ_TO_PTR(model->output_shape->items[i]);
+        size_t shape[ULAB_MAX_DIMS] = {};
+
+        if (ULAB_MAX_DIMS < output_shape->len) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Output shape has too many dimensions"));
+        }
+
+        if (mp_obj_get_int(output_shape->items[0]) != 1) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected output tensors with a batch size of 1"));
+        }
+
+        for (size_t j = 0; j < output_shape->len; j++) {
+            size_t ulab_offset = ULAB_MAX_DIMS - output_shape->len;
+            shape[ulab_offset + j] = (j == 0) ? n_rois : mp_obj_get_int(output_shape->items[j]);
+        }
+
+        output_list->items[i] = MP_OBJ_FROM_PTR(ndarray_new_dense_ndarray(output_shape->len, shape, NDARRAY_FLOAT));
+    }
+
+    py_ml_model_acquire(model);
+
+    fb_alloc_mark();
+
+    image_t *image = py_helper_arg_to_image(pos_args[1], ARG_IMAGE_ANY | ARG_IMAGE_ALLOC);
+    void *input_buffer = model->backend->get_input(model, 0);
+    mp_obj_tuple_t *input_shape = MP_OBJ_TO_PTR(model->input_shape->items[0]);
+    int input_dtype = mp_obj_get_int(model->input_dtype->items[0]);
+    float input_scale = 1.0f / mp_obj_get_float(model->input_scale->items[0]);
+    int input_zero_point = mp_obj_get_int(model->input_zero_point->items[0]);
+
+    py_ml_input_norm_t norm;
+    py_ml_input_norm_t *norm_ptr = py_ml_arg_to_norm(args[ARG_scale].u_obj, args[ARG_mean].u_obj,
+                                                     args[ARG_stdev].u_obj, &norm);
+
+    for (size_t r = 0; r < n_rois; r++) {
+        rectangle_t roi = py_helper_arg_to_roi(rois[r], image);
+        py_ml_process_image_input(input_buffer, input_shape, input_dtype, input_scale,
+                                  input_zero_point, norm_ptr, image, &roi);
+        model->backend->run_inference(model);
+
+        for (size_t i = 0; i < model->outputs_size; i++) {
+            ndarray_obj_t *ndarray = MP_OBJ_TO_PTR(output_list->items[i]);
+            size_t size = py_ml_tuple_sum(MP_OBJ_TO_PTR(model->output_shape->items[i]));
+            py_ml_dequantize_output(((float *) ndarray->array) + (r * size),
+                                    model->backend->get_output(model, i), size,
+                                    mp_obj_get_int(model->output_dtype->items[i]),
+                                    mp_obj_get_float(model->output_scale->items[i]),
+                                    mp_obj_get_int(model->output_zero_point->items[i]));
+        }
+    }
+
+    fb_alloc_free_till_mark();
+    return MP_OBJ_FROM_PTR(output_list);
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_ml_model_predict_batch_obj, 2, py_ml_model_predict_batch);
+
+// Returns a list of (operator, cycles, arena bytes) tuples for the last inference. Arena bytes are
+// the size of the operator's non-constant tensors.
+static mp_obj_t py_ml_model_profile(mp_obj_t self_in) {
+    py_ml_model_obj_t *model = MP_OBJ_TO_PTR(self_in);
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    ml_backend_op_profile_t profile;
+
+    for (size_t i = 0; model->backend->get_profile(model, i, &profile); i++) {
+        mp_obj_t tuple[3] = {
+            mp_obj_new_str(profile.name, strlen(profile.name)),
+            mp_obj_new_int_from_uint(profile.cycles),
+            mp_obj_new_int(profile.arena_bytes)
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(3, tuple));
+    }
+
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_ml_model_profile_obj, py_ml_model_profile);
+
 static void py_ml_model_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
     py_ml_model_obj_t *self = MP_OBJ_TO_PTR(self_in);
     if (dest[0] == MP_OBJ_NULL) {
@@ -292,11 +1142,39 @@ static void py_ml_model_attr(mp_obj_t self_in, qstr attr, mp_obj_t *dest) {
     }
 }
 
+#if MICROPY_VFS_ROM
+// Files on a ROM filesystem, which can be placed in memory-mapped QSPI/OSPI flash, are directly
+// addressable. Returns NULL if the file is not memory-mapped or can't be opened.
+static const void *py_ml_map_file(mp_obj_t path, size_t *size) {
+    const void *data = NULL;
+    nlr_buf_t nlr;
+
+    if (nlr_push(&nlr) == 0) {
+        mp_obj_t file = mp_call_function_2(MP_OBJ_FROM_PTR(&mp_builtin_open_obj), path, MP_OBJ_NEW_QSTR(MP_QSTR_rb));
+        mp_buffer_info_t bufinfo;
+        if (mp_get_buffer(file, &bufinfo, MP_BUFFER_READ)) {
+            data = bufinfo.buf;
+            *size = bufinfo.len;
+        }
+        mp_stream_close(file);
+        nlr_pop();
+    }
+
+    return data;
+}
+#endif
+
+// Returns true if the model data can be used in place. TFLM needs the flatbuffer to be aligned.
+static bool py_ml_model_in_place(const void *data) {
+    return !(((uintptr_t) data) & 15);
+}
+
 mp_obj_t py_ml_model_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
-    enum { ARG_path, ARG_load_to_fb };
+    enum { ARG_path, ARG_load_to_fb, ARG_shared_arena };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_path, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_load_to_fb, MP_ARG_REQUIRED | MP_ARG_BOOL },
+        { MP_QSTR_shared_arena, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
     };
 
     // Parse args.
@@ -305,12 +1183,44 @@ mp_obj_t py_ml_model_make_new(const mp_obj_type_t *type, size_t n_args, size_t n
 
     fb_alloc_mark();
 
-    const char *path = mp_obj_str_get_str(args[ARG_path].u_obj);
-
     py_ml_model_obj_t *model = mp_obj_malloc_with_finaliser(py_ml_model_obj_t, &py_ml_model_type);
+    model->backend = &ml_backend_tflm;
     model->data = NULL;
     model->fb_alloc = args[ARG_load_to_fb].u_int;
+    model->shared_arena = args[ARG_shared_arena].u_bool;
     model->labels = mp_const_none;
+    model->buffer = mp_const_none;
+    model->pending = mp_const_none;
+
+    mp_buffer_info_t bufinfo;
+    if ((!mp_obj_is_str(args[ARG_path].u_obj)) && mp_get_buffer(args[ARG_path].u_obj, &bufinfo, MP_BUFFER_READ)) {
+        // The model is passed as a buffer (e.g. a memoryview of memory-mapped flash). It's used in
+        // place if it's aligned, and a reference is kept so it's not collected.
+        if (!py_ml_model_in_place(bufinfo.buf)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Model buffer must be 16-byte aligned"));
+        }
+        model->size = bufinfo.len;
+        model->data = bufinfo.buf;
+        model->buffer = args[ARG_path].u_obj;
+        model->fb_alloc = false;
+        fb_alloc_free_till_mark();
+        model->backend->init_model(model);
+        return MP_OBJ_FROM_PTR(model);
+    }
+
+    const char *path = mp_obj_str_get_str(args[ARG_path].u_obj);
+
+    #if MICROPY_PY_CUBEAI
+    if (ml_backend_cubeai_find_model(path)) {
+        // The network's code and weights are in the firmware, there's no model data to load.
+        model->backend = &ml_backend_cubeai;
+        model->size = 0;
+        model->fb_alloc = false;
+        fb_alloc_free_till_mark();
+        model->backend->init_model(model);
+        return MP_OBJ_FROM_PTR(model);
+    }
+    #endif
 
     for (const tflm_builtin_model_t *_model = &tflm_builtin_models[0]; _model->name != NULL; _model++) {
         if (!strcmp(path, _model->name)) {
@@ -333,6 +1243,25 @@ mp_obj_t py_ml_model_make_new(const mp_obj_type_t *type, size_t n_args, size_t n
         }
     }
 
+    #if MICROPY_VFS_ROM
+    if (model->data == NULL) {
+        // Memory-mapped models are executed in place, only the tensor arena uses RAM. Unaligned
+        // files are copied like regular files.
+        size_t size;
+        const void *data = py_ml_map_file(args[ARG_path].u_obj, &size);
+        if (data) {
+            model->size = size;
+            if (py_ml_model_in_place(data)) {
+                model->data = (unsigned char *) data;
+                model->fb_alloc = false;
+            } else {
+                model->data = model->fb_alloc ? fb_alloc(size, FB_ALLOC_PREFER_SIZE) : xalloc(size);
+                memcpy(model->data, data, size);
+            }
+        }
+    }
+    #endif
+
     if (model->data == NULL) {
         #if defined(IMLIB_ENABLE_IMAGE_FILE_IO)
         FIL fp;
@@ -353,7 +1282,7 @@ mp_obj_t py_ml_model_make_new(const mp_obj_type_t *type, size_t n_args, size_t n
         fb_alloc_free_till_mark();
     }
 
-    ml_backend_init_model(model);
+    model->backend->init_model(model);
     return MP_OBJ_FROM_PTR(model);
 }
 
@@ -369,6 +1298,9 @@ static MP_DEFINE_CONST_FUN_OBJ_1(py_ml_model_deinit_obj, py_ml_model_deinit);
 static const mp_rom_map_elem_t py_ml_model_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___del__),             MP_ROM_PTR(&py_ml_model_deinit_obj) },
     { MP_ROM_QSTR(MP_QSTR_predict),             MP_ROM_PTR(&py_ml_model_predict_obj) },
+    { MP_ROM_QSTR(MP_QSTR_predict_async),       MP_ROM_PTR(&py_ml_model_predict_async_obj) },
+    { MP_ROM_QSTR(MP_QSTR_predict_batch),       MP_ROM_PTR(&py_ml_model_predict_batch_obj) },
+    { MP_ROM_QSTR(MP_QSTR_profile),             MP_ROM_PTR(&py_ml_model_profile_obj) },
 };
 
 static MP_DEFINE_CONST_DICT(py_ml_model_locals_dict, py_ml_model_locals_dict_table);
@@ -383,11 +1315,12 @@ static MP_DEFINE_CONST_OBJ_TYPE(
     locals_dict, &py_ml_model_locals_dict
     );
 
-extern const mp_obj_type_t py_ml_nms_type;
-
 static const mp_rom_map_elem_t py_ml_globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__),            MP_OBJ_NEW_QSTR(MP_QSTR_ml) },
     { MP_ROM_QSTR(MP_QSTR_Model),               MP_ROM_PTR(&py_ml_model_type) },
+    { MP_ROM_QSTR(MP_QSTR_FOMO),                MP_ROM_INT(PY_ML_POSTPROCESS_FOMO) },
+    { MP_ROM_QSTR(MP_QSTR_YOLO_V5),             MP_ROM_INT(PY_ML_POSTPROCESS_YOLO_V5) },
+    { MP_ROM_QSTR(MP_QSTR_YOLO_V8),             MP_ROM_INT(PY_ML_POSTPROCESS_YOLO_V8) },
 };
 
 static MP_DEFINE_CONST_DICT(py_ml_globals_dict, py_ml_globals_dict_table);
@@ -397,6 +1330,9 @@ const mp_obj_module_t ml_module = {
     .globals = (mp_obj_t) &py_ml_globals_dict
 };
 
+// Non-persistent tensor arena shared by the models loaded with shared_arena=True.
+MP_REGISTER_ROOT_POINTER(void *ml_shared_arena);
+
 // Alias for backwards compatibility
 MP_REGISTER_EXTENSIBLE_MODULE(MP_QSTR_tf, ml_module);
 MP_REGISTER_EXTENSIBLE_MODULE(MP_QSTR_ml, ml_module);
@@ -10,14 +10,18 @@
  */
 #ifndef __PY_ML_H__
 #define __PY_ML_H__
+struct ml_backend;
+
 // TF Model Object.
 typedef struct py_ml_model_obj {
     mp_obj_base_t base;
+    const struct ml_backend *backend;
     unsigned int size;
     unsigned char *data;
     size_t memory_size;
     uint32_t memory_addr;
     bool fb_alloc;
+    bool shared_arena; // Activations are in an arena shared with other models.
     size_t inputs_size;
     mp_obj_tuple_t *input_shape;
     mp_obj_tuple_t *input_scale;
@@ -29,18 +33,51 @@ typedef struct py_ml_model_obj {
     mp_obj_tuple_t *output_zero_point;
     mp_obj_tuple_t *output_dtype;
     mp_obj_t labels;
+    mp_obj_t buffer; // Model buffer used in place, if any.
+    mp_obj_t pending; // Result of the inference in progress, if any.
     void *state; // Private context for the backend.
 } py_ml_model_obj_t;
 
-// Initialize a model.
-int ml_backend_init_model(py_ml_model_obj_t *model);
+// Profile of an operator.
+typedef struct ml_backend_op_profile {
+    const char *name;
+    uint32_t cycles;
+    size_t arena_bytes;
+} ml_backend_op_profile_t;
+
+// Inference backend, selected per model.
+typedef struct ml_backend {
+    // Initialize a model.
+    int (*init_model) (py_ml_model_obj_t *model);
+
+    // Make the model the user of its shared arena. Returns the previous user, whose tensors are
+    // about to be overwritten, or NULL.
+    py_ml_model_obj_t *(*acquire_arena) (py_ml_model_obj_t *model);
+
+    // Run inference.
+    int (*run_inference) (py_ml_model_obj_t *model);
+
+    // Start inference, returns before it's done if the backend offloads it (e.g. to an NPU).
+    int (*start_inference) (py_ml_model_obj_t *model);
+
+    // Returns true if the started inference is done, waits for it to finish if block is true.
+    bool (*wait_inference) (py_ml_model_obj_t *model, bool block);
+
+    // Return the profile of an operator executed by the last inference, false if out of range.
+    bool (*get_profile) (py_ml_model_obj_t *model, size_t index, ml_backend_op_profile_t *profile);
+
+    // Return an input tensor by index.
+    void *(*get_input) (py_ml_model_obj_t *model, size_t index);
 
-// Run inference.
-int ml_backend_run_inference(py_ml_model_obj_t *model);
+    // Return an output tensor by index.
+    void *(*get_output) (py_ml_model_obj_t *model, size_t index);
+} ml_backend_t;
 
-// Return an input tensor by index.
-void *ml_backend_get_input(py_ml_model_obj_t *model, size_t index);
+extern const ml_backend_t ml_backend_tflm;
 
-// Return an output tensor by index.
-void *ml_backend_get_output(py_ml_model_obj_t *model, size_t index);
+#if MICROPY_PY_CUBEAI
+// Networks generated by STM32Cube.AI are linked into the firmware and looked up by name.
+extern const ml_backend_t ml_backend_cubeai;
+bool ml_backend_cubeai_find_model(const char *name);
+#endif
 #endif // __PY_ML_H__
@@ -12,8 +12,13 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include "py/obj.h"
+#include "py/objlist.h"
+#include "py/runtime.h"
 #include "usbdbg.h"
 #include "framebuffer.h"
+#include "fb_alloc.h"
+#include "umm_malloc.h"
+#include "probe.h"
 #include "omv_boardconfig.h"
 
 static mp_obj_t py_omv_version_string() {
@@ -57,6 +62,148 @@ static mp_obj_t py_omv_disable_fb(uint n_args, const mp_obj_t *args) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_omv_disable_fb_obj, 0, 1, py_omv_disable_fb);
 
+static mp_obj_t py_omv_preview_budget(uint n_args, const mp_obj_t *args) {
+    if (!n_args) {
+        return mp_obj_new_int(fb_get_preview_budget());
+    }
+    int percent = mp_obj_get_int(args[0]);
+    if ((percent < 0) || (percent > 100)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Preview budget must be between 0 and 100"));
+    }
+    fb_set_preview_budget(percent);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_omv_preview_budget_obj, 0, 1, py_omv_preview_budget);
+
+#if defined(FB_ALLOC_STATS)
+static mp_obj_t py_omv_fb_stats_sites(const fb_alloc_site_t *sites) {
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    for (int i = 0; i < FB_ALLOC_STATS_SITES && sites[i].caller; i++) {
+        mp_obj_t tuple[4] = {
+            mp_obj_new_int_from_uint(sites[i].caller),
+            mp_obj_new_int_from_uint(sites[i].count),
+            mp_obj_new_int_from_uint(sites[i].peak_bytes),
+            mp_obj_new_int_from_uint(sites[i].total_bytes)
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(4, tuple));
+    }
+    return list;
+}
+
+static void py_omv_fb_stats_store(mp_obj_t dict, qstr key, uint32_t value) {
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(key), mp_obj_new_int_from_uint(value));
+}
+
+static mp_obj_t py_omv_fb_stats(uint n_args, const mp_obj_t *args) {
+    const fb_alloc_stats_t *stats = fb_alloc_get_stats();
+    mp_obj_t dict = mp_obj_new_dict(0);
+
+    py_omv_fb_stats_store(dict, MP_QSTR_peak, stats->peak_bytes);
+    py_omv_fb_stats_store(dict, MP_QSTR_min_avail, (stats->min_avail == UINT32_MAX) ? 0 : stats->min_avail);
+    py_omv_fb_stats_store(dict, MP_QSTR_count, stats->alloc_count);
+    py_omv_fb_stats_store(dict, MP_QSTR_requested, stats->requested_bytes);
+    py_omv_fb_stats_store(dict, MP_QSTR_overhead, stats->overhead_bytes);
+    py_omv_fb_stats_store(dict, MP_QSTR_alloc_all_count, stats->alloc_all_count);
+    py_omv_fb_stats_store(dict, MP_QSTR_alloc_all_us, stats->alloc_all_us);
+    py_omv_fb_stats_store(dict, MP_QSTR_alloc_all_max_us, stats->alloc_all_max_us);
+    py_omv_fb_stats_store(dict, MP_QSTR_fail_caller, stats->fail_caller);
+    py_omv_fb_stats_store(dict, MP_QSTR_fail_size, stats->fail_bytes);
+    py_omv_fb_stats_store(dict, MP_QSTR_fail_avail, stats->fail_avail);
+    py_omv_fb_stats_store(dict, MP_QSTR_dropped, stats->dropped);
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_allocs), py_omv_fb_stats_sites(stats->allocs));
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_marks), py_omv_fb_stats_sites(stats->marks));
+
+    if (n_args && mp_obj_is_true(args[0])) {
+        fb_alloc_stats_reset();
+    }
+
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_omv_fb_stats_obj, 0, 1, py_omv_fb_stats);
+#endif
+
+#if defined(UMM_STATS)
+static void py_omv_umm_stats_store(mp_obj_t dict, qstr key, uint32_t value) {
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(key), mp_obj_new_int_from_uint(value));
+}
+
+static mp_obj_t py_omv_umm_stats(uint n_args, const mp_obj_t *args) {
+    const umm_stats_t *stats = umm_get_stats();
+    mp_obj_t dict = mp_obj_new_dict(0);
+
+    py_omv_umm_stats_store(dict, MP_QSTR_heap, stats->heap_bytes);
+    py_omv_umm_stats_store(dict, MP_QSTR_peak, stats->peak_bytes);
+    py_omv_umm_stats_store(dict, MP_QSTR_count, stats->malloc_count);
+    py_omv_umm_stats_store(dict, MP_QSTR_quick_count, stats->quick_count);
+    py_omv_umm_stats_store(dict, MP_QSTR_free_count, stats->free_count);
+    py_omv_umm_stats_store(dict, MP_QSTR_fail_count, stats->fail_count);
+    py_omv_umm_stats_store(dict, MP_QSTR_free, stats->free_bytes);
+    py_omv_umm_stats_store(dict, MP_QSTR_quick, stats->quick_bytes);
+    py_omv_umm_stats_store(dict, MP_QSTR_largest, stats->largest_bytes);
+
+    mp_obj_list_t *hist = mp_obj_new_list(UMM_STATS_BINS, NULL);
+    for (int i = 0; i < UMM_STATS_BINS; i++) {
+        hist->items[i] = mp_obj_new_int_from_uint(stats->histogram[i]);
+    }
+    mp_obj_dict_store(dict, MP_OBJ_NEW_QSTR(MP_QSTR_histogram), MP_OBJ_FROM_PTR(hist));
+
+    if (n_args && mp_obj_is_true(args[0])) {
+        umm_stats_reset();
+    }
+
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_omv_umm_stats_obj, 0, 1, py_omv_umm_stats);
+#endif
+
+#if OMV_PROFILE_ENABLE && (__ARM_ARCH >= 7)
+// Returns {name: (count, min_us, mean_us, p99_us)} for the probes recorded in the events ring.
+static mp_obj_t py_omv_probe_stats(uint n_args, const mp_obj_t *args) {
+    mp_obj_t dict = mp_obj_new_dict(0);
+    float us_per_cycle = 1000000.0f / SystemCoreClock;
+
+    for (uint32_t id = 0; id < OMV_PROBE_COUNT; id++) {
+        probe_stats_t stats;
+        if (probe_get_stats(id, &stats)) {
+            mp_obj_t tuple[4] = {
+                mp_obj_new_int_from_uint(stats.count),
+                mp_obj_new_float(stats.min_cycles * us_per_cycle),
+                mp_obj_new_float(stats.mean_cycles * us_per_cycle),
+                mp_obj_new_float(stats.p99_cycles * us_per_cycle)
+            };
+            const char *name = probe_name(id);
+            mp_obj_dict_store(dict, mp_obj_new_str(name, strlen(name)), mp_obj_new_tuple(4, tuple));
+        }
+    }
+
+    if (n_args && mp_obj_is_true(args[0])) {
+        probe_reset();
+    }
+
+    return dict;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_omv_probe_stats_obj, 0, 1, py_omv_probe_stats);
+#endif
+
+// Returns [(name, end_us, duration_us)] for the phases of the last boot.
+static mp_obj_t py_omv_boot_timeline() {
+    const boot_mark_t *marks;
+    uint32_t count = boot_timeline(&marks);
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+
+    for (uint32_t i = 0, start_us = 0; i < count; start_us = marks[i++].us) {
+        mp_obj_t tuple[3] = {
+            mp_obj_new_str(marks[i].name, strlen(marks[i].name)),
+            mp_obj_new_int_from_uint(marks[i].us),
+            mp_obj_new_int_from_uint(marks[i].us - start_us)
+        };
+        mp_obj_list_append(list, mp_obj_new_tuple(3, tuple));
+    }
+
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_omv_boot_timeline_obj, py_omv_boot_timeline);
+
 static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__),        MP_OBJ_NEW_QSTR(MP_QSTR_omv) },
     { MP_ROM_QSTR(MP_QSTR_version_major),   MP_ROM_INT(FIRMWARE_VERSION_MAJOR) },
@@ -66,7 +213,18 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_arch),            MP_ROM_PTR(&py_omv_arch_obj) },
     { MP_ROM_QSTR(MP_QSTR_board_type),      MP_ROM_PTR(&py_omv_board_type_obj) },
     { MP_ROM_QSTR(MP_QSTR_board_id),        MP_ROM_PTR(&py_omv_board_id_obj) },
-    { MP_ROM_QSTR(MP_QSTR_disable_fb),      MP_ROM_PTR(&py_omv_disable_fb_obj) }
+    { MP_ROM_QSTR(MP_QSTR_disable_fb),      MP_ROM_PTR(&py_omv_disable_fb_obj) },
+    { MP_ROM_QSTR(MP_QSTR_preview_budget),  MP_ROM_PTR(&py_omv_preview_budget_obj) },
+    { MP_ROM_QSTR(MP_QSTR_boot_timeline),   MP_ROM_PTR(&py_omv_boot_timeline_obj) },
+    #if defined(FB_ALLOC_STATS)
+    { MP_ROM_QSTR(MP_QSTR_fb_stats),        MP_ROM_PTR(&py_omv_fb_stats_obj) },
+    #endif
+    #if defined(UMM_STATS)
+    { MP_ROM_QSTR(MP_QSTR_umm_stats),       MP_ROM_PTR(&py_omv_umm_stats_obj) },
+    #endif
+    #if OMV_PROFILE_ENABLE && (__ARM_ARCH >= 7)
+    { MP_ROM_QSTR(MP_QSTR_probe_stats),     MP_ROM_PTR(&py_omv_probe_stats_obj) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
@@ -0,0 +1,90 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * RPC library helpers.
+ *
+ * Packets are framed as [magic (LE16) | payload | crc (LE16)], where the CRC-16/CCITT-FALSE
+ * covers the magic and the payload. Packing and checking packets is done here so the rpc
+ * library doesn't CRC every byte in Python.
+ */
+#include <string.h>
+#include "py/runtime.h"
+#include "py/objarray.h"
+
+#include "omv_crc.h"
+
+#define RPC_HEADER_SIZE     (2)
+#define RPC_FOOTER_SIZE     (2)
+
+static mp_obj_t py_rpc_crc16(size_t n_args, const mp_obj_t *args) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(args[0], &bufinfo, MP_BUFFER_READ);
+
+    size_t size = bufinfo.len;
+    if (n_args > 1) {
+        mp_int_t n = mp_obj_get_int(args[1]);
+        if (n >= 0) {
+            size = MIN(n, bufinfo.len);
+        }
+    }
+
+    return mp_obj_new_int(omv_crc16(bufinfo.buf, size));
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_rpc_crc16_obj, 1, 2, py_rpc_crc16);
+
+static mp_obj_t py_rpc_pack(mp_obj_t magic_obj, mp_obj_t payload_obj) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(payload_obj, &bufinfo, MP_BUFFER_READ);
+
+    size_t size = RPC_HEADER_SIZE + bufinfo.len;
+    mp_obj_array_t *packet = MP_OBJ_TO_PTR(mp_obj_new_bytearray(size + RPC_FOOTER_SIZE, NULL));
+    uint8_t *p = packet->items;
+    uint16_t magic = mp_obj_get_int(magic_obj);
+
+    p[0] = magic;
+    p[1] = magic >> 8;
+    memcpy(p + RPC_HEADER_SIZE, bufinfo.buf, bufinfo.len);
+
+    uint16_t crc = omv_crc16(p, size);
+    p[size + 0] = crc;
+    p[size + 1] = crc >> 8;
+    return MP_OBJ_FROM_PTR(packet);
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(py_rpc_pack_obj, py_rpc_pack);
+
+static mp_obj_t py_rpc_check(mp_obj_t magic_obj, mp_obj_t packet_obj) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(packet_obj, &bufinfo, MP_BUFFER_READ);
+
+    if (bufinfo.len < (RPC_HEADER_SIZE + RPC_FOOTER_SIZE)) {
+        return mp_const_false;
+    }
+
+    const uint8_t *p = bufinfo.buf;
+    size_t size = bufinfo.len - RPC_FOOTER_SIZE;
+    uint16_t magic = p[0] | (p[1] << 8);
+    uint16_t crc = p[size] | (p[size + 1] << 8);
+
+    return mp_obj_new_bool((magic == (uint16_t) mp_obj_get_int(magic_obj)) && (crc == omv_crc16(p, size)));
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(py_rpc_check_obj, py_rpc_check);
+
+static const mp_rom_map_elem_t globals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__),    MP_ROM_QSTR(MP_QSTR__rpc)      },
+    { MP_ROM_QSTR(MP_QSTR_crc16),       MP_ROM_PTR(&py_rpc_crc16_obj)  },
+    { MP_ROM_QSTR(MP_QSTR_pack),        MP_ROM_PTR(&py_rpc_pack_obj)   },
+    { MP_ROM_QSTR(MP_QSTR_check),       MP_ROM_PTR(&py_rpc_check_obj)  },
+};
+static MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
+
+const mp_obj_module_t rpc_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_t) &globals_dict,
+};
+
+MP_REGISTER_MODULE(MP_QSTR__rpc, rpc_module);
@@ -0,0 +1,319 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * RTP/JPEG (RFC 2435) packetizer module.
+ *
+ * The JPEG headers are stripped from the frame, the scan data is split into packets and the
+ * quantization tables are sent in-band (Q = 255) in the first packet, so the receiver decodes
+ * the frame with the tables the encoder used. Each packet is assembled in one buffer and sent
+ * with a single socket call, either written to a stream (TCP, interleaved) or with sendto().
+ */
+#include "py/mpconfig.h"
+#if MICROPY_PY_NETWORK
+
+#include "py/runtime.h"
+#include "py/stream.h"
+#include "py/objarray.h"
+#include "py/mperrno.h"
+
+#include "imlib.h"
+#include "py_helper.h"
+#include "py_image.h"
+
+#define RTP_INTERLEAVED_SIZE    (4)
+#define RTP_PAYLOAD_TYPE_JPEG   (26)
+#define RTP_JPEG_MAX_SIZE       (2040)
+#define RTP_MIN_PACKET_SIZE     (256)
+#define RTP_MAX_PACKET_SIZE     (1500)
+
+typedef struct rtp_jpeg {
+    uint8_t type;
+    uint8_t width;      // In units of 8 pixels.
+    uint8_t height;     // In units of 8 pixels.
+    const uint8_t *tables[2];
+    const uint8_t *data;
+    size_t size;
+} rtp_jpeg_t;
+
+typedef struct py_rtp_obj {
+    mp_obj_base_t base;
+    uint32_t ssrc;
+    uint16_t seq;
+    uint16_t mtu;
+    uint8_t *packet;
+    mp_obj_t packet_obj;    // bytearray over packet, passed to sendto().
+} py_rtp_obj_t;
+
+static inline uint16_t rtp_get_u16(const uint8_t *p) {
+    return (p[0] << 8) | p[1];
+}
+
+static inline uint8_t *rtp_put_u16(uint8_t *p, uint16_t v) {
+    *p++ = v >> 8;
+    *p++ = v;
+    return p;
+}
+
+static inline uint8_t *rtp_put_u32(uint8_t *p, uint32_t v) {
+    p = rtp_put_u16(p, v >> 16);
+    return rtp_put_u16(p, v);
+}
+
+// Finds the quantization tables, the sampling factors and the scan data of a baseline JPEG.
+static void rtp_jpeg_parse(image_t *img, rtp_jpeg_t *jpeg) {
+    const uint8_t *p = img->data, *end = img->data + img->size;
+    bool sof = false;
+
+    jpeg->tables[0] = jpeg->tables[1] = NULL;
+
+    if ((img->size < 4) || (rtp_get_u16(p) != 0xFFD8)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid JPEG"));
+    }
+
+    for (p += 2; (p + 4) <= end; ) {
+        if (p[0] != 0xFF) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid JPEG"));
+        }
+
+        uint8_t marker = p[1];
+        size_t length = rtp_get_u16(p + 2);
+        const uint8_t *segment = p + 4, *segment_end = p + 2 + length;
+
+        if ((length < 2) || (segment_end > end)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid JPEG"));
+        }
+
+        switch (marker) {
+            case 0xDB: { // DQT, may hold more than one table.
+                for (const uint8_t *t = segment; (t + 65) <= segment_end; t += 65) {
+                    if (((t[0] >> 4) != 0) || ((t[0] & 0xF) > 1)) {
+                        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Only 8-bit JPEG tables are supported"));
+                    }
+                    jpeg->tables[t[0] & 0xF] = t + 1;
+                }
+                break;
+            }
+            case 0xC0: { // SOF0
+                if (length < 17) {
+                    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Only YUV 4:2:2 and 4:2:0 JPEGs are supported"));
+                }
+                int h = rtp_get_u16(segment + 1), w = rtp_get_u16(segment + 3);
+                if ((segment[5] != 3) ||
+                    (segment[8] != 0) || (segment[10] != 0x11) || (segment[11] != 1) ||
+                    (segment[13] != 0x11) || (segment[14] != 1) ||
+                    ((segment[7] != 0x21) && (segment[7] != 0x22))) {
+                    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Only YUV 4:2:2 and 4:2:0 JPEGs are supported"));
+                }
+                if ((w >= RTP_JPEG_MAX_SIZE) || (h >= RTP_JPEG_MAX_SIZE)) {
+                    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Maximum size is 2040x2040"));
+                }
+                jpeg->type = (segment[7] == 0x21) ? 0 : 1;
+                jpeg->width = (w + 7) / 8;
+                jpeg->height = (h + 7) / 8;
+                sof = true;
+                break;
+            }
+            case 0xDD: { // DRI
+                if ((length >= 4) && rtp_get_u16(segment)) {
+                    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Restart markers are not supported"));
+                }
+                break;
+            }
+            case 0xDA: { // SOS, the scan data follows.
+                if (!sof || !jpeg->tables[0] || !jpeg->tables[1]) {
+                    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Only baseline JPEGs are supported"));
+                }
+                jpeg->data = segment_end;
+                jpeg->size = end - segment_end;
+                // Drop the EOI marker.
+                if ((jpeg->size >= 2) && (rtp_get_u16(end - 2) == 0xFFD9)) {
+                    jpeg->size -= 2;
+                }
+                return;
+            }
+            default: {
+                if ((0xC1 <= marker) && (marker <= 0xCF) && (marker != 0xC4) && (marker != 0xCC)) {
+                    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Only baseline JPEGs are supported"));
+                }
+                break;
+            }
+        }
+
+        p = segment_end;
+    }
+
+    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid JPEG"));
+}
+
+static void rtp_send_packet(py_rtp_obj_t *self, mp_obj_t sock, mp_obj_t addr, size_t size) {
+    if (addr == mp_const_none) {
+        int errcode = MP_EIO;
+        if (mp_stream_rw(sock, self->packet, size, &errcode, MP_STREAM_RW_WRITE) != size) {
+            mp_raise_OSError(errcode);
+        }
+    } else {
+        mp_obj_array_t *packet = MP_OBJ_TO_PTR(self->packet_obj);
+        packet->len = size;
+
+        mp_obj_t dest[4];
+        mp_load_method(sock, MP_QSTR_sendto, dest);
+        dest[2] = self->packet_obj;
+        dest[3] = addr;
+        mp_call_method_n_kw(2, 0, dest);
+    }
+}
+
+static mp_obj_t py_rtp_send(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_sock, ARG_image, ARG_timestamp, ARG_addr, ARG_channel };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_sock,      MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_image,     MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_timestamp, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_addr,      MP_ARG_KW_ONLY | MP_ARG_OBJ,  {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_channel,   MP_ARG_KW_ONLY | MP_ARG_INT,  {.u_int = -1} },
+    };
+
+    // Parse args.
+    py_rtp_obj_t *self = MP_OBJ_TO_PTR(pos_args[0]);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t sock = args[ARG_sock].u_obj;
+    mp_obj_t addr = args[ARG_addr].u_obj;
+    int channel = args[ARG_channel].u_int;
+    image_t *img = py_helper_arg_to_image(args[ARG_image].u_obj, ARG_IMAGE_ANY);
+
+    if (img->pixfmt != PIXFORMAT_JPEG) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Expected a JPEG image"));
+    }
+
+    if (addr == mp_const_none) {
+        // Without an address the packets are written to a (connected) stream socket.
+        mp_get_stream_raise(sock, MP_STREAM_OP_WRITE);
+    }
+
+    rtp_jpeg_t jpeg;
+    rtp_jpeg_parse(img, &jpeg);
+
+    uint32_t timestamp = mp_obj_get_int_truncated(args[ARG_timestamp].u_obj);
+    size_t offset = 0;
+
+    do {
+        uint8_t *p = self->packet;
+
+        // RTP over RTSP (TCP) interleaved frame header, the size is filled in below.
+        if (channel >= 0) {
+            *p++ = '$';
+            *p++ = channel;
+            p += 2;
+        }
+
+        // RTP header, the marker bit is set below on the last packet of the frame.
+        uint8_t *rtp_header = p;
+        *p++ = 0x80;
+        *p++ = RTP_PAYLOAD_TYPE_JPEG;
+        p = rtp_put_u16(p, self->seq++);
+        p = rtp_put_u32(p, timestamp);
+        p = rtp_put_u32(p, self->ssrc);
+
+        // JPEG header, Q = 255 means the tables are sent in-band.
+        p = rtp_put_u32(p, offset); // type-specific = 0 and fragment offset.
+        *p++ = jpeg.type;
+        *p++ = 255;
+        *p++ = jpeg.width;
+        *p++ = jpeg.height;
+
+        // Quantization table header and the luma and chroma tables in the first packet.
+        if (offset == 0) {
+            *p++ = 0; // MBZ
+            *p++ = 0; // 8-bit precision
+            p = rtp_put_u16(p, 128);
+            memcpy(p, jpeg.tables[0], 64);
+            memcpy(p + 64, jpeg.tables[1], 64);
+            p += 128;
+        }
+
+        size_t payload = IM_MIN(jpeg.size - offset, self->mtu - (p - self->packet));
+        memcpy(p, jpeg.data + offset, payload);
+        p += payload;
+        offset += payload;
+
+        if (offset == jpeg.size) {
+            rtp_header[1] |= 0x80;
+        }
+
+        size_t size = p - self->packet;
+        if (channel >= 0) {
+            rtp_put_u16(self->packet + 2, size - RTP_INTERLEAVED_SIZE);
+        }
+
+        rtp_send_packet(self, sock, addr, size);
+    } while (offset < jpeg.size);
+
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_rtp_send_obj, 4, py_rtp_send);
+
+static mp_obj_t py_rtp_sequence_number(mp_obj_t self_in) {
+    py_rtp_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    return mp_obj_new_int(self->seq);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_rtp_sequence_number_obj, py_rtp_sequence_number);
+
+static mp_obj_t py_rtp_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_ssrc, ARG_mtu, ARG_seq };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_ssrc, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_mtu,  MP_ARG_KW_ONLY | MP_ARG_INT,  {.u_int = 1400} },
+        { MP_QSTR_seq,  MP_ARG_KW_ONLY | MP_ARG_INT,  {.u_int = 0} },
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if ((args[ARG_mtu].u_int < RTP_MIN_PACKET_SIZE) || (args[ARG_mtu].u_int > RTP_MAX_PACKET_SIZE)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid MTU"));
+    }
+
+    py_rtp_obj_t *self = mp_obj_malloc(py_rtp_obj_t, type);
+    self->ssrc = mp_obj_get_int_truncated(args[ARG_ssrc].u_obj);
+    self->seq = args[ARG_seq].u_int;
+    self->mtu = args[ARG_mtu].u_int;
+    self->packet = m_new(uint8_t, self->mtu);
+    self->packet_obj = mp_obj_new_bytearray_by_ref(self->mtu, self->packet);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static const mp_rom_map_elem_t py_rtp_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_send),            MP_ROM_PTR(&py_rtp_send_obj)            },
+    { MP_ROM_QSTR(MP_QSTR_sequence_number), MP_ROM_PTR(&py_rtp_sequence_number_obj) },
+};
+static MP_DEFINE_CONST_DICT(py_rtp_locals_dict, py_rtp_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_rtp_jpeg_type,
+    MP_QSTR_JPEGPacketizer,
+    MP_TYPE_FLAG_NONE,
+    make_new, py_rtp_make_new,
+    locals_dict, &py_rtp_locals_dict
+    );
+
+static const mp_rom_map_elem_t globals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__),       MP_ROM_QSTR(MP_QSTR_rtp)         },
+    { MP_ROM_QSTR(MP_QSTR_JPEGPacketizer), MP_ROM_PTR(&py_rtp_jpeg_type)    },
+};
+static MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
+
+const mp_obj_module_t rtp_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_t) &globals_dict,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_rtp, rtp_module);
+#endif // MICROPY_PY_NETWORK
@@ -10,6 +10,7 @@
  */
 #include <stdarg.h>
 #include <stdio.h>
+#include <string.h>
 #include "py/mphal.h"
 #include "py/runtime.h"
 
@@ -27,11 +28,17 @@
 #include "omv_i2c.h"
 #include "py_helper.h"
 #include "framebuffer.h"
+#include "omv_common.h"
 
 extern sensor_t sensor;
 static mp_obj_t vsync_callback = mp_const_none;
 static mp_obj_t frame_callback = mp_const_none;
 
+// Capture-to-output latency histogram, the last bin counts everything above the range.
+#define SENSOR_LATENCY_BINS     (32)
+#define SENSOR_LATENCY_BIN_US   (1000)
+static uint32_t latency_histogram[SENSOR_LATENCY_BINS];
+
 #define sensor_raise_error(err) mp_raise_msg(&mp_type_RuntimeError, (mp_rom_error_text_t) sensor_strerror(err))
 #define sensor_print_error(op)  printf("\x1B[31mWARNING: %s control is not supported by this image sensor.\x1B[0m\n", op);
 
@@ -114,7 +121,15 @@ static mp_obj_t py_sensor_flush() {
 }
 static MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_flush_obj, py_sensor_flush);
 
-static mp_obj_t py_sensor_snapshot(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
+static mp_obj_t py_sensor_snapshot(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_blocking };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_blocking, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true} },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
     #if MICROPY_PY_IMU
     // +-10 degree dead-zone around pitch 90/270.
     // +-35 degree active-zone around roll 0/90/180/270/360.
@@ -123,15 +138,90 @@ static mp_obj_t py_sensor_snapshot(uint n_args, const mp_obj_t *args, mp_map_t *
     // We're not setting the full range on roll to prevent oscillation.
     #endif // MICROPY_PY_IMU
 
+    // In non-blocking mode the capture of the next frame continues in the background
+    // and None is returned until it's ready. With 2 or more frame buffers this allows
+    // processing the current frame while the next one is being captured.
+    uint32_t flags = args[ARG_blocking].u_bool ? SENSOR_SNAPSHOT_NO_FLAGS : SENSOR_SNAPSHOT_NONBLOCKING;
+
     mp_obj_t image = py_image(0, 0, 0, 0, 0);
-    int error = sensor.snapshot(&sensor, (image_t *) py_image_cobj(image), 0);
-    if (error != 0) {
+    int error = sensor.snapshot(&sensor, (image_t *) py_image_cobj(image), flags);
+
+    // With auto quality the quality was already lowered, so try again with the next frame.
+    for (int i = 0; (error == SENSOR_ERROR_JPEG_OVERFLOW) && sensor.auto_quality && (i < 8); i++) {
+        error = sensor.snapshot(&sensor, (image_t *) py_image_cobj(image), flags);
+    }
+
+    if (error == SENSOR_ERROR_WOULD_BLOCK) {
+        return mp_const_none;
+    } else if (error != 0) {
         sensor_raise_error(error);
     }
+    framebuffer->snapshot_us = mp_hal_ticks_us();
     return image;
 }
 static MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_snapshot_obj, 0, py_sensor_snapshot);
 
+static mp_obj_t py_sensor_get_timestamps() {
+    // Timestamps are in the time.ticks_us() domain so they can be matched with IMU samples.
+    return mp_obj_new_tuple(4, (mp_obj_t []) {mp_obj_new_int_from_uint(framebuffer->start_us),
+                                              mp_obj_new_int_from_uint(framebuffer->end_us),
+                                              mp_obj_new_int_from_uint(framebuffer->snapshot_us),
+                                              mp_obj_new_int_from_uint(framebuffer->trigger_us)});
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_timestamps_obj, py_sensor_get_timestamps);
+
+static mp_obj_t py_sensor_record_latency() {
+    // Time from the start of the last frame to now, call this once the frame has been output.
+    uint32_t latency = mp_hal_ticks_us() - framebuffer->start_us;
+    latency_histogram[OMV_MIN(latency / SENSOR_LATENCY_BIN_US, SENSOR_LATENCY_BINS - 1)] += 1;
+    return mp_obj_new_int_from_uint(latency);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_record_latency_obj, py_sensor_record_latency);
+
+static mp_obj_t py_sensor_get_latency_histogram(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_reset };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_reset, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_list_t *l = mp_obj_new_list(SENSOR_LATENCY_BINS, NULL);
+    for (uint32_t i = 0; i < SENSOR_LATENCY_BINS; i++) {
+        l->items[i] = mp_obj_new_int_from_uint(latency_histogram[i]);
+    }
+
+    if (args[ARG_reset].u_bool) {
+        memset(latency_histogram, 0, sizeof(latency_histogram));
+    }
+    return l;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_get_latency_histogram_obj, 0, py_sensor_get_latency_histogram);
+
+static mp_obj_t py_sensor_get_frame_stats(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_reset };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_reset, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    // Frames kept, frames read and dropped by the frame rate, frames skipped by the hardware.
+    mp_obj_t stats = mp_obj_new_tuple(3, (mp_obj_t []) {mp_obj_new_int_from_uint(sensor.frames_captured),
+                                                         mp_obj_new_int_from_uint(sensor.frames_dropped),
+                                                         mp_obj_new_int_from_uint(sensor.frames_skipped)});
+
+    if (args[ARG_reset].u_bool) {
+        sensor.frames_captured = 0;
+        sensor.frames_dropped = 0;
+        sensor.frames_skipped = 0;
+    }
+    return stats;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_sensor_get_frame_stats_obj, 0, py_sensor_get_frame_stats);
+
 static mp_obj_t py_sensor_skip_frames(uint n_args, const mp_obj_t *args, mp_map_t *kw_args) {
     mp_map_elem_t *kw_arg = mp_map_lookup(kw_args, MP_ROM_QSTR(MP_QSTR_time), MP_MAP_LOOKUP);
     mp_int_t time = 300; // OV Recommended.
@@ -145,7 +235,7 @@ static mp_obj_t py_sensor_skip_frames(uint n_args, const mp_obj_t *args, mp_map_
     if (!n_args) {
         while ((mp_hal_ticks_ms() - millis) < time) {
             // 32-bit math handles wrap around...
-            py_sensor_snapshot(0, NULL, NULL);
+            py_sensor_snapshot(0, NULL, (mp_map_t *) &mp_const_empty_map);
         }
     } else {
         for (int i = 0, j = mp_obj_get_int(args[0]); i < j; i++) {
@@ -153,7 +243,7 @@ static mp_obj_t py_sensor_skip_frames(uint n_args, const mp_obj_t *args, mp_map_
                 break;
             }
 
-            py_sensor_snapshot(0, NULL, NULL);
+            py_sensor_snapshot(0, NULL, (mp_map_t *) &mp_const_empty_map);
         }
     }
 
@@ -176,7 +266,7 @@ static mp_obj_t py_sensor_get_fb() {
         return mp_const_none;
     }
 
-    image_t image;
+    image_t image = {};
     framebuffer_init_image(&image);
     return py_image_from_struct(&image);
 }
@@ -324,6 +414,36 @@ static mp_obj_t py_sensor_set_windowing(uint n_args, const mp_obj_t *args) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_sensor_set_windowing_obj, 1, 4, py_sensor_set_windowing);
 
+static mp_obj_t py_sensor_set_ext_trigger(mp_obj_t enable) {
+    int error = sensor_set_ext_trigger(mp_obj_is_true(enable));
+    if (error != 0) {
+        sensor_raise_error(error);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_ext_trigger_obj, py_sensor_set_ext_trigger);
+
+static mp_obj_t py_sensor_wait_motion(uint n_args, const mp_obj_t *args) {
+    int timeout = (n_args == 0) ? 0 : mp_obj_get_int(args[0]);
+    int error = sensor_wait_motion(MAX(timeout, 0));
+    if (error == SENSOR_ERROR_CAPTURE_TIMEOUT) {
+        return mp_const_false;
+    } else if (error != 0) {
+        sensor_raise_error(error);
+    }
+    return mp_const_true;
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_sensor_wait_motion_obj, 0, 1, py_sensor_wait_motion);
+
+static mp_obj_t py_sensor_move_windowing(mp_obj_t x, mp_obj_t y) {
+    int error = sensor_move_windowing(mp_obj_get_int(x), mp_obj_get_int(y));
+    if (error != 0) {
+        sensor_raise_error(error);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(py_sensor_move_windowing_obj, py_sensor_move_windowing);
+
 static mp_obj_t py_sensor_get_windowing() {
     if (sensor.framesize == FRAMESIZE_INVALID) {
         sensor_raise_error(SENSOR_ERROR_INVALID_FRAMESIZE);
@@ -613,6 +733,34 @@ static mp_obj_t py_sensor_get_transpose() {
 }
 static MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_transpose_obj, py_sensor_get_transpose);
 
+static mp_obj_t py_sensor_set_auto_quality(mp_obj_t enable) {
+    int error = sensor_set_auto_quality(mp_obj_is_true(enable));
+    if (error != 0) {
+        sensor_raise_error(error);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_auto_quality_obj, py_sensor_set_auto_quality);
+
+static mp_obj_t py_sensor_get_auto_quality() {
+    return mp_obj_new_bool(sensor_get_auto_quality());
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_auto_quality_obj, py_sensor_get_auto_quality);
+
+static mp_obj_t py_sensor_set_jpeg_capture(mp_obj_t quality) {
+    int error = sensor_set_jpeg_capture(mp_obj_get_int(quality));
+    if (error != 0) {
+        sensor_raise_error(error);
+    }
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_sensor_set_jpeg_capture_obj, py_sensor_set_jpeg_capture);
+
+static mp_obj_t py_sensor_get_jpeg_capture() {
+    return mp_obj_new_int(sensor_get_jpeg_capture());
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_sensor_get_jpeg_capture_obj, py_sensor_get_jpeg_capture);
+
 static mp_obj_t py_sensor_set_auto_rotation(mp_obj_t enable) {
     int error = sensor_set_auto_rotation(mp_obj_is_true(enable));
     if (error != 0) {
@@ -926,7 +1074,7 @@ static mp_obj_t py_sensor_ioctl(uint n_args, const mp_obj_t *args) {
             break;
         }
 
-        #if (OMV_HM01B0_ENABLE == 1)
+        #if (OMV_HM01B0_ENABLE == 1) || (OMV_HM0360_ENABLE == 1)
         case IOCTL_HIMAX_MD_ENABLE: {
             if (n_args >= 2) {
                 error = sensor_ioctl(request, mp_obj_get_int(args[1]));
@@ -973,13 +1121,14 @@ static mp_obj_t py_sensor_ioctl(uint n_args, const mp_obj_t *args) {
             break;
         }
 
-        case IOCTL_HIMAX_OSC_ENABLE: {
+        case IOCTL_HIMAX_OSC_ENABLE:
+        case IOCTL_HIMAX_MD_LOW_POWER: {
             if (n_args >= 2) {
                 error = sensor_ioctl(request, mp_obj_get_int(args[1]));
             }
             break;
         }
-        #endif // (OMV_HM01B0_ENABLE == 1)
+        #endif // (OMV_HM01B0_ENABLE == 1) || (OMV_HM0360_ENABLE == 1)
 
         default: {
             sensor_raise_error(SENSOR_ERROR_CTL_UNSUPPORTED);
@@ -1147,12 +1296,13 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_IOCTL_LEPTON_GET_MEASUREMENT_MODE),   MP_ROM_INT(IOCTL_LEPTON_GET_MEASUREMENT_MODE)},
     { MP_ROM_QSTR(MP_QSTR_IOCTL_LEPTON_SET_MEASUREMENT_RANGE),  MP_ROM_INT(IOCTL_LEPTON_SET_MEASUREMENT_RANGE)},
     { MP_ROM_QSTR(MP_QSTR_IOCTL_LEPTON_GET_MEASUREMENT_RANGE),  MP_ROM_INT(IOCTL_LEPTON_GET_MEASUREMENT_RANGE)},
-    #if (OMV_HM01B0_ENABLE == 1)
+    #if (OMV_HM01B0_ENABLE == 1) || (OMV_HM0360_ENABLE == 1)
     { MP_ROM_QSTR(MP_QSTR_IOCTL_HIMAX_MD_ENABLE),       MP_ROM_INT(IOCTL_HIMAX_MD_ENABLE)},
     { MP_ROM_QSTR(MP_QSTR_IOCTL_HIMAX_MD_WINDOW),       MP_ROM_INT(IOCTL_HIMAX_MD_WINDOW)},
     { MP_ROM_QSTR(MP_QSTR_IOCTL_HIMAX_MD_THRESHOLD),    MP_ROM_INT(IOCTL_HIMAX_MD_THRESHOLD)},
     { MP_ROM_QSTR(MP_QSTR_IOCTL_HIMAX_MD_CLEAR),        MP_ROM_INT(IOCTL_HIMAX_MD_CLEAR)},
     { MP_ROM_QSTR(MP_QSTR_IOCTL_HIMAX_OSC_ENABLE),      MP_ROM_INT(IOCTL_HIMAX_OSC_ENABLE)},
+    { MP_ROM_QSTR(MP_QSTR_IOCTL_HIMAX_MD_LOW_POWER),    MP_ROM_INT(IOCTL_HIMAX_MD_LOW_POWER)},
     #endif
 
     // Sensor functions
@@ -1177,7 +1327,14 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_set_framerate),       MP_ROM_PTR(&py_sensor_set_framerate_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_framerate),       MP_ROM_PTR(&py_sensor_get_framerate_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_windowing),       MP_ROM_PTR(&py_sensor_set_windowing_obj) },
+    { MP_ROM_QSTR(MP_QSTR_move_windowing),      MP_ROM_PTR(&py_sensor_move_windowing_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_windowing),       MP_ROM_PTR(&py_sensor_get_windowing_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_ext_trigger),     MP_ROM_PTR(&py_sensor_set_ext_trigger_obj) },
+    { MP_ROM_QSTR(MP_QSTR_wait_motion),         MP_ROM_PTR(&py_sensor_wait_motion_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_timestamps),      MP_ROM_PTR(&py_sensor_get_timestamps_obj) },
+    { MP_ROM_QSTR(MP_QSTR_record_latency),      MP_ROM_PTR(&py_sensor_record_latency_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_latency_histogram), MP_ROM_PTR(&py_sensor_get_latency_histogram_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_frame_stats),     MP_ROM_PTR(&py_sensor_get_frame_stats_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_gainceiling),     MP_ROM_PTR(&py_sensor_set_gainceiling_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_contrast),        MP_ROM_PTR(&py_sensor_set_contrast_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_brightness),      MP_ROM_PTR(&py_sensor_set_brightness_obj) },
@@ -1198,6 +1355,10 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_get_vflip),           MP_ROM_PTR(&py_sensor_get_vflip_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_transpose),       MP_ROM_PTR(&py_sensor_set_transpose_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_transpose),       MP_ROM_PTR(&py_sensor_get_transpose_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_auto_quality),    MP_ROM_PTR(&py_sensor_set_auto_quality_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_auto_quality),    MP_ROM_PTR(&py_sensor_get_auto_quality_obj) },
+    { MP_ROM_QSTR(MP_QSTR_set_jpeg_capture),    MP_ROM_PTR(&py_sensor_set_jpeg_capture_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_jpeg_capture),    MP_ROM_PTR(&py_sensor_get_jpeg_capture_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_auto_rotation),   MP_ROM_PTR(&py_sensor_set_auto_rotation_obj) },
     { MP_ROM_QSTR(MP_QSTR_get_auto_rotation),   MP_ROM_PTR(&py_sensor_get_auto_rotation_obj) },
     { MP_ROM_QSTR(MP_QSTR_set_framebuffers),    MP_ROM_PTR(&py_sensor_set_framebuffers_obj) },
@@ -26,6 +26,8 @@
 #define LCD_COMMAND_DISPON          (0x29)
 #define LCD_COMMAND_RAMWR           (0x2C)
 #define LCD_COMMAND_SLPOUT          (0x11)
+#define LCD_COMMAND_CASET           (0x2A)
+#define LCD_COMMAND_RASET           (0x2B)
 #define LCD_COMMAND_MADCTL          (0x36)
 #define LCD_COMMAND_COLMOD          (0x3A)
 
@@ -87,34 +89,35 @@ static void spi_display_command(py_display_obj_t *self, uint8_t cmd, uint8_t arg
     spi_write(self, cmd, &arg, (arg > 0) ? 1 : 0, false);
 }
 
+static void spi_display_window(py_display_obj_t *self, rectangle_t *rect) {
+    int x_end = rect->x + rect->w - 1;
+    int y_end = rect->y + rect->h - 1;
+    spi_write(self, LCD_COMMAND_CASET, (uint8_t []) { rect->x >> 8, rect->x, x_end >> 8, x_end }, 4, false);
+    spi_write(self, LCD_COMMAND_RASET, (uint8_t []) { rect->y >> 8, rect->y, y_end >> 8, y_end }, 4, false);
+}
+
 static void spi_display_callback(omv_spi_t *spi, void *userdata, void *buf) {
     py_display_obj_t *self = (py_display_obj_t *) userdata;
 
-    static uint8_t *spi_state_write_addr = NULL;
-    static size_t spi_state_write_count = 0;
-
-    // If userdata is not null then it means that we are being kicked off.
-    if (buf == NULL) {
-        spi_state_write_count = 0;
-    }
-
-    if (!spi_state_write_count) {
-        spi_state_write_addr = (uint8_t *) self->framebuffers[self->framebuffer_tail];
-        spi_state_write_count = self->width * self->height;
-
-        if (self->byte_swap) {
-            spi_state_write_count *= 2;
+    // Move to the next row of the window once the current one has been sent.
+    if (!self->spi_tx_count) {
+        if (!self->spi_tx_rows) {
+            self->spi_tx_busy = false;
+            return;
         }
 
-        self->framebuffer_head = self->framebuffer_tail;
+        self->spi_tx_rows -= 1;
+        self->spi_tx_row += self->width * sizeof(uint16_t);
+        self->spi_tx_addr = self->spi_tx_row;
+        self->spi_tx_count = self->spi_tx_row_count;
     }
 
-    size_t spi_state_write_limit = (!self->byte_swap) ? OMV_SPI_MAX_16BIT_XFER : OMV_SPI_MAX_8BIT_XFER;
-    uint8_t *addr = spi_state_write_addr;
-    size_t count = IM_MIN(spi_state_write_count, spi_state_write_limit);
+    size_t spi_tx_limit = (!self->byte_swap) ? OMV_SPI_MAX_16BIT_XFER : OMV_SPI_MAX_8BIT_XFER;
+    uint8_t *addr = self->spi_tx_addr;
+    size_t count = IM_MIN(self->spi_tx_count, spi_tx_limit);
 
-    spi_state_write_addr += (!self->byte_swap) ? (count * 2) : count;
-    spi_state_write_count -= count;
+    self->spi_tx_addr += (!self->byte_swap) ? (count * 2) : count;
+    self->spi_tx_count -= count;
 
     // When starting the interrupt chain the first transfer is not executed in interrupt context.
     // So, disable interrupts for the first transfer so that it completes first and unlocks the
@@ -136,30 +139,114 @@ static void spi_display_callback(omv_spi_t *spi, void *userdata, void *buf) {
     }
 }
 
-static void spi_display_kick(py_display_obj_t *self) {
-    if (!self->spi_tx_running) {
-        spi_display_command(self, LCD_COMMAND_RAMWR, 0);
-        spi_switch_mode(self, (!self->byte_swap) ? 16 : 8, true);
-        omv_gpio_write(OMV_SPI_DISPLAY_SSEL_PIN, 0);
+// Waits for the last update to be sent and returns the bus to command mode.
+static void spi_display_wait(py_display_obj_t *self) {
+    if (self->spi_tx_running) {
+        while (self->spi_tx_busy) {
+            MICROPY_EVENT_POLL_HOOK
+        }
+        spi_switch_mode(self, 8, false);
+        omv_gpio_write(OMV_SPI_DISPLAY_SSEL_PIN, 1);
+        self->spi_tx_running = false;
+    }
+}
 
-        // Limit the transfer size to single lines as you cannot send more
-        // than 64KB per SPI transaction generally.
+static void spi_display_abort(py_display_obj_t *self) {
+    if (self->spi_tx_running) {
+        omv_spi_transfer_abort(&self->spi_bus);
+        self->spi_tx_busy = false;
+        self->spi_tx_running = false;
+        spi_switch_mode(self, 8, false);
+        omv_gpio_write(OMV_SPI_DISPLAY_SSEL_PIN, 1);
+    }
+}
+
+// Finds the window that changed between two frames, returns false if the frames are equal.
+static bool spi_display_damage(py_display_obj_t *self, uint16_t *old_fb, uint16_t *new_fb, rectangle_t *rect) {
+    int w = self->width;
+    int h = self->height;
+    int y_start = 0, y_end = h - 1;
+
+    while ((y_start < h) && !memcmp(old_fb + (y_start * w), new_fb + (y_start * w), w * sizeof(uint16_t))) {
+        y_start++;
+    }
+
+    if (y_start == h) {
+        return false;
+    }
+
+    while (!memcmp(old_fb + (y_end * w), new_fb + (y_end * w), w * sizeof(uint16_t))) {
+        y_end--;
+    }
+
+    // Only the columns outside of the current window need to be checked.
+    int x_start = w, x_end = -1;
+    for (int y = y_start; y <= y_end; y++) {
+        uint16_t *old_row = old_fb + (y * w);
+        uint16_t *new_row = new_fb + (y * w);
+
+        for (int x = 0; x < x_start; x++) {
+            if (old_row[x] != new_row[x]) {
+                x_start = x;
+                break;
+            }
+        }
+
+        for (int x = w - 1; x > x_end; x--) {
+            if (old_row[x] != new_row[x]) {
+                x_end = x;
+                break;
+            }
+        }
+    }
+
+    rectangle_init(rect, x_start, y_start, x_end - x_start + 1, y_end - y_start + 1);
+    return true;
+}
+
+static void spi_display_kick(py_display_obj_t *self, rectangle_t *rect) {
+    uint8_t *fb = (uint8_t *) self->framebuffers[self->framebuffer_tail];
+
+    spi_display_wait(self);
+    self->framebuffer_head = self->framebuffer_tail;
+    spi_display_window(self, rect);
+    spi_display_command(self, LCD_COMMAND_RAMWR, 0);
+    spi_switch_mode(self, (!self->byte_swap) ? 16 : 8, true);
+    omv_gpio_write(OMV_SPI_DISPLAY_SSEL_PIN, 0);
+
+    if (self->spi_refresh) {
+        // The first frame is sent before turning the display on. Limit the transfer size to
+        // single lines as you cannot send more than 64KB per SPI transaction generally.
         for (int i = 0; i < self->height; i++) {
-            uint8_t *buffer = (uint8_t *) (self->framebuffers[self->framebuffer_tail] + (self->width * i));
-            spi_transmit_16(self, buffer, self->width);
+            spi_transmit_16(self, fb + (self->width * i * sizeof(uint16_t)), self->width);
         }
 
         spi_switch_mode(self, 8, false);
         omv_gpio_write(OMV_SPI_DISPLAY_SSEL_PIN, 1);
         spi_display_command(self, LCD_COMMAND_DISPON, 0);
-        spi_display_command(self, LCD_COMMAND_RAMWR, 0);
-        spi_switch_mode(self, (!self->byte_swap) ? 16 : 8, true);
-        omv_gpio_write(OMV_SPI_DISPLAY_SSEL_PIN, 0);
+        self->spi_refresh = false;
+        return;
+    }
+
+    // Full width windows are contiguous and are sent in as few transfers as possible,
+    // otherwise the window is sent a row at a time.
+    size_t units = (!self->byte_swap) ? 1 : 2;
+    self->spi_tx_row = fb + (((rect->y * self->width) + rect->x) * sizeof(uint16_t));
+    self->spi_tx_addr = self->spi_tx_row;
 
-        // Kickoff interrupt driven image update.
-        self->spi_tx_running = true;
-        spi_display_callback(&self->spi_bus, self, NULL);
+    if (rect->w == self->width) {
+        self->spi_tx_count = rect->w * rect->h * units;
+        self->spi_tx_rows = 0;
+    } else {
+        self->spi_tx_row_count = rect->w * units;
+        self->spi_tx_count = self->spi_tx_row_count;
+        self->spi_tx_rows = rect->h - 1;
     }
+
+    // Kickoff interrupt driven window update.
+    self->spi_tx_busy = true;
+    self->spi_tx_running = true;
+    spi_display_callback(&self->spi_bus, self, NULL);
 }
 
 static void spi_display_draw_image_cb(int x_start, int x_end, int y_row, imlib_draw_row_data_t *data) {
@@ -170,7 +257,7 @@ static void spi_display_draw_image_cb(int x_start, int x_end, int y_row, imlib_d
 static void spi_display_write(py_display_obj_t *self, image_t *src_img, int dst_x_start, int dst_y_start,
                               float x_scale, float y_scale, rectangle_t *roi, int rgb_channel, int alpha,
                               const uint16_t *color_palette, const uint8_t *alpha_palette, image_hint_t hint) {
-    image_t dst_img;
+    image_t dst_img = {};
     dst_img.w = self->width;
     dst_img.h = self->height;
     dst_img.pixfmt = PIXFORMAT_RGB565;
@@ -266,25 +353,40 @@ static void spi_display_write(py_display_obj_t *self, image_t *src_img, int dst_
         SCB_CleanDCache_by_Addr((uint32_t *) dst_img.data, image_size(&dst_img));
         #endif
 
+        // The display holds the last frame sent, so only the window that changed since then
+        // has to be sent, unless the changes were marked with dirty().
+        rectangle_t rect = {0, 0, self->width, self->height};
+        bool changed = true;
+
+        if (self->spi_refresh) {
+            self->spi_dirty.w = 0;
+        } else if (self->spi_dirty.w) {
+            rectangle_copy(&rect, &self->spi_dirty);
+            self->spi_dirty.w = 0;
+        } else {
+            changed = spi_display_damage(self, self->framebuffers[self->framebuffer_tail],
+                                         self->framebuffers[new_framebuffer_tail], &rect);
+        }
+
         // Update tail which means a new image is ready.
         self->framebuffer_tail = new_framebuffer_tail;
 
         // Kick off an update of the display.
-        spi_display_kick(self);
+        if (changed) {
+            spi_display_kick(self, &rect);
+        }
     }
 }
 
 static void spi_display_clear(py_display_obj_t *self, bool display_off) {
     if (display_off) {
         // turns the display off (may not be black)
-        if (self->spi_tx_running) {
-            omv_spi_transfer_abort(&self->spi_bus);
-            self->spi_tx_running = false;
-            spi_switch_mode(self, 8, false);
-            omv_gpio_write(OMV_SPI_DISPLAY_SSEL_PIN, 1);
-        }
+        spi_display_abort(self);
     } else {
+        spi_display_wait(self);
         spi_display_command(self, LCD_COMMAND_DISPOFF, 0);
+        // The next frame is sent in full before turning the display back on.
+        self->spi_refresh = true;
         fb_alloc_mark();
         spi_display_write(self, NULL, 0, 0, 1.f, 1.f, NULL, 0, 0, NULL, NULL, 0);
         fb_alloc_free_till_mark();
@@ -298,9 +400,22 @@ static void spi_display_set_backlight(py_display_obj_t *self, uint32_t intensity
 }
 #endif
 
+static void spi_display_dirty(py_display_obj_t *self, rectangle_t *rect) {
+    if (!self->spi_dirty.w) {
+        rectangle_copy(&self->spi_dirty, rect);
+    } else {
+        rectangle_united(&self->spi_dirty, rect);
+    }
+}
+
+static int spi_display_bus_write(py_display_obj_t *self, uint8_t cmd, uint8_t *args, size_t n_args, bool dcs) {
+    spi_display_wait(self);
+    return spi_write(self, cmd, args, n_args, dcs);
+}
+
 static void spi_display_deinit(py_display_obj_t *self) {
     if (self->triple_buffer) {
-        omv_spi_transfer_abort(&self->spi_bus);
+        spi_display_abort(self);
         fb_alloc_free_till_mark_past_mark_permanent();
     }
 
@@ -353,6 +468,11 @@ mp_obj_t spi_display_make_new(const mp_obj_type_t *type, size_t n_args, size_t n
     self->byte_swap = args[ARG_byte_swap].u_bool;
     self->controller = args[ARG_controller].u_obj;
     self->bl_controller = args[ARG_backlight].u_obj;
+    self->overlay = mp_const_none;
+    self->spi_tx_running = false;
+    self->spi_tx_busy = false;
+    self->spi_refresh = true;
+    self->spi_dirty.w = 0;
 
     omv_spi_config_t spi_config;
     omv_spi_default_config(&spi_config, OMV_SPI_DISPLAY_CONTROLLER);
@@ -410,10 +530,11 @@ static const py_display_p_t py_display_p = {
     .deinit = spi_display_deinit,
     .clear = spi_display_clear,
     .write = spi_display_write,
+    .dirty = spi_display_dirty,
     #ifdef OMV_SPI_DISPLAY_BL_PIN
     .set_backlight = spi_display_set_backlight,
     #endif
-    .bus_write = spi_write,
+    .bus_write = spi_display_bus_write,
 };
 
 MP_DEFINE_CONST_OBJ_TYPE(
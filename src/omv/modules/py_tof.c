@@ -19,7 +19,10 @@
 #include "py_assert.h"
 #include "py_helper.h"
 #include "py_image.h"
+#include "py_tof.h"
 #include "framebuffer.h"
+#include "omv_task.h"
+#include "softtimer.h"
 
 #if (OMV_TOF_VL53L5CX_ENABLE == 1)
 #include "vl53l5cx_api.h"
@@ -29,6 +32,7 @@
 #define VL53L5CX_WIDTH              8
 #define VL53L5CX_HEIGHT             8
 #define VL53L5CX_FRAME_DATA_SIZE    64
+#define TOF_POLL_MS                 10
 
 static omv_i2c_t tof_bus = {};
 
@@ -51,8 +55,72 @@ static VL53L5CX_Configuration vl53l5cx_dev = {
         .address = VL53L5CX_ADDR,
     }
 };
+
+// Background ranging: a one-shot soft timer schedules a task every TOF_POLL_MS which reads
+// finished frames into the back buffer and swaps it with the front one. The task runs while
+// sensor.snapshot() waits for the camera, so the I2C transfers overlap with the frame capture.
+static bool tof_background = false;
+static bool tof_timer_pending = false;
+static uint32_t tof_frame_count = 0;    // Frames read by the background task.
+static uint32_t tof_frame_taken = 0;    // Frame count of the last frame returned.
+static int tof_frame_front = 0;
+static int16_t tof_frames[2][VL53L5CX_WIDTH * VL53L5CX_HEIGHT];
+// Too big for the stack of the scheduler, see tof_vl53l5cx_get_frame().
+static VL53L5CX_ResultsData tof_ranging_data;
+static soft_timer_entry_t tof_poll_timer = {};
+
+static bool tof_poll_task(omv_task_t *task);
+
+static omv_task_t tof_poll_task_obj = {
+    .func = tof_poll_task,
+    .priority = OMV_TASK_PRIORITY_NORMAL,
+};
+
+static void tof_poll_callback(soft_timer_entry_t *timer) {
+    tof_timer_pending = false;
+    if (tof_background) {
+        omv_task_schedule(&tof_poll_task_obj);
+    }
+}
+
+static void tof_poll_arm() {
+    // A pending timer is still in the queue after a soft-reset, and it must not be inserted twice.
+    if (!tof_timer_pending) {
+        tof_timer_pending = true;
+        tof_poll_timer.flags = 0;
+        tof_poll_timer.mode = SOFT_TIMER_MODE_ONE_SHOT;
+        tof_poll_timer.delta_ms = TOF_POLL_MS;
+        tof_poll_timer.c_callback = tof_poll_callback;
+        soft_timer_insert(&tof_poll_timer, TOF_POLL_MS);
+    }
+}
+
+static bool tof_poll_task(omv_task_t *task) {
+    uint8_t frame_ready = 0;
+
+    if (tof_background && (tof_sensor == TOF_VL53L5CX)) {
+        if ((vl53l5cx_check_data_ready(&vl53l5cx_dev, &frame_ready) == 0) && frame_ready &&
+            (vl53l5cx_get_ranging_data(&vl53l5cx_dev, &tof_ranging_data) == 0)) {
+            int16_t *frame = tof_frames[!tof_frame_front];
+            for (int i = 0, ii = VL53L5CX_WIDTH * VL53L5CX_HEIGHT; i < ii; i++) {
+                frame[i] = tof_ranging_data.distance_mm[i];
+            }
+            tof_frame_front = !tof_frame_front;
+            tof_frame_count += 1;
+        }
+        tof_poll_arm();
+    }
+
+    return false;
+}
 #endif
 
+void py_tof_init0() {
+    #if (OMV_TOF_VL53L5CX_ENABLE == 1)
+    tof_background = false;
+    #endif
+}
+
 // img->w == data_w && img->h == data_h && img->pixfmt == PIXFORMAT_GRAYSCALE
 static void tof_fill_image_float_obj(image_t *img, mp_obj_t *data, float min, float max) {
     float tmp = min;
@@ -84,10 +152,56 @@ static void tof_fill_image_float_obj(image_t *img, mp_obj_t *data, float min, fl
 }
 
 #if (OMV_TOF_VL53L5CX_ENABLE == 1)
-static void tof_vl53l5cx_get_depth(VL53L5CX_Configuration *vl53l5cx_dev, float *frame, uint32_t timeout) {
+// img->w * img->h == w * h, converts distances in mm to GRAYSCALE (scaled from min to max)
+// or GRAYSCALE16 (the distances as they are).
+static void tof_fill_image_from_mm(image_t *img, int w, int h, const int16_t *data, int min, int max,
+                                   bool mirror, bool flip, bool dst_transpose, bool src_transpose) {
+    int tmp = min;
+    min = (min < max) ? min : max;
+    max = (max > tmp) ? max : tmp;
+
+    int range = IM_MAX(max - min, 1);
+    int w_1 = w - 1;
+    int h_1 = h - 1;
+
+    for (int y = 0; y < h; y++) {
+        int y_dst = flip ? (h_1 - y) : y;
+
+        for (int x = 0; x < w; x++) {
+            int x_dst = mirror ? (w_1 - x) : x;
+            int raw = src_transpose ? data[(x * h) + y] : data[(y * w) + x];
+            int index = dst_transpose ? ((x_dst * h) + y_dst) : ((y_dst * w) + x_dst);
+
+            if (img->pixfmt == PIXFORMAT_GRAYSCALE16) {
+                ((uint16_t *) img->data)[index] = IM_MAX(raw, 0);
+            } else {
+                raw = IM_CLAMP(raw, min, max);
+                ((uint8_t *) img->data)[index] = (((raw - min) * 255) + (range / 2)) / range;
+            }
+        }
+    }
+}
+
+static void tof_vl53l5cx_get_frame(VL53L5CX_Configuration *vl53l5cx_dev, int16_t *frame, uint32_t timeout) {
+    if (tof_background) {
+        // Wait for a frame newer than the last one returned, the task runs while waiting. With a
+        // zero timeout the latest frame is returned if there's one.
+        for (mp_uint_t start = mp_hal_ticks_ms(); tof_frame_count == tof_frame_taken; mp_hal_delay_ms(1)) {
+            if ((timeout == 0) && tof_frame_count) {
+                break;
+            }
+
+            if ((mp_hal_ticks_ms() - start) >= timeout) {
+                mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("VL53L5CX ranging timeout"));
+            }
+        }
+
+        memcpy(frame, tof_frames[tof_frame_front], sizeof(tof_frames[0]));
+        tof_frame_taken = tof_frame_count;
+        return;
+    }
+
     uint8_t frame_ready = 0;
-    // Note depending on the config in platform.h, this struct can be too big to alloc on the stack.
-    VL53L5CX_ResultsData ranging_data;
 
     for (mp_uint_t start = mp_hal_ticks_ms(); !frame_ready; mp_hal_delay_ms(1)) {
         if (vl53l5cx_check_data_ready(vl53l5cx_dev, &frame_ready) != 0) {
@@ -99,12 +213,22 @@ static void tof_vl53l5cx_get_depth(VL53L5CX_Configuration *vl53l5cx_dev, float *
         }
     }
 
-    if (vl53l5cx_get_ranging_data(vl53l5cx_dev, &ranging_data) != 0) {
+    // Note depending on the config in platform.h, this struct can be too big to alloc on the stack.
+    if (vl53l5cx_get_ranging_data(vl53l5cx_dev, &tof_ranging_data) != 0) {
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("VL53L5CX ranging failed"));
     }
 
     for (int i = 0, ii = VL53L5CX_WIDTH * VL53L5CX_HEIGHT; i < ii; i++) {
-        frame[i] = (float) ranging_data.distance_mm[i];
+        frame[i] = tof_ranging_data.distance_mm[i];
+    }
+}
+
+static void tof_vl53l5cx_get_depth(VL53L5CX_Configuration *vl53l5cx_dev, float *frame, uint32_t timeout) {
+    int16_t mm[VL53L5CX_WIDTH * VL53L5CX_HEIGHT];
+    tof_vl53l5cx_get_frame(vl53l5cx_dev, mm, timeout);
+
+    for (int i = 0, ii = VL53L5CX_WIDTH * VL53L5CX_HEIGHT; i < ii; i++) {
+        frame[i] = (float) mm[i];
     }
 }
 
@@ -190,6 +314,8 @@ static mp_obj_t py_tof_deinit() {
     if (tof_sensor != TOF_NONE) {
         #if (OMV_TOF_VL53L5CX_ENABLE == 1)
         if (tof_sensor == TOF_VL53L5CX) {
+            tof_background = false;
+            omv_task_cancel(&tof_poll_task_obj);
             vl53l5cx_stop_ranging(&vl53l5cx_dev);
         }
         #endif
@@ -327,6 +453,27 @@ static mp_obj_t py_tof_height() {
 }
 static MP_DEFINE_CONST_FUN_OBJ_0(py_tof_height_obj, py_tof_height);
 
+static mp_obj_t py_tof_background(uint n_args, const mp_obj_t *args) {
+    switch (tof_sensor) {
+        #if (OMV_TOF_VL53L5CX_ENABLE == 1)
+        case TOF_VL53L5CX:
+            if (n_args) {
+                tof_background = mp_obj_is_true(args[0]);
+                if (tof_background) {
+                    tof_frame_count = tof_frame_taken = 0;
+                    tof_poll_arm();
+                } else {
+                    omv_task_cancel(&tof_poll_task_obj);
+                }
+            }
+            return mp_obj_new_bool(tof_background);
+        #endif
+        default:
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("TOF sensor is not initialized"));
+    }
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_tof_background_obj, 0, 1, py_tof_background);
+
 static mp_obj_t py_tof_refresh() {
     switch (tof_sensor) {
         #if (OMV_TOF_VL53L5CX_ENABLE == 1)
@@ -485,10 +632,21 @@ mp_obj_t py_tof_snapshot(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Alpha ranges between 0 and 256"));
     }
 
-    if ((args[ARG_pixformat].u_int != PIXFORMAT_GRAYSCALE) && (args[ARG_pixformat].u_int != PIXFORMAT_RGB565)) {
+    if ((args[ARG_pixformat].u_int != PIXFORMAT_GRAYSCALE) &&
+        (args[ARG_pixformat].u_int != PIXFORMAT_GRAYSCALE16) &&
+        (args[ARG_pixformat].u_int != PIXFORMAT_RGB565)) {
         mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid pixformat"));
     }
 
+    // GRAYSCALE16 snapshots hold the distances in mm, one pixel per zone.
+    bool raw = args[ARG_pixformat].u_int == PIXFORMAT_GRAYSCALE16;
+
+    if (raw && ((args[ARG_x_scale].u_obj != mp_const_none) ||
+                (args[ARG_y_scale].u_obj != mp_const_none) ||
+                (args[ARG_roi].u_obj != mp_const_none))) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("GRAYSCALE16 snapshots can't be scaled"));
+    }
+
     image_t src_img = {
         .w = args[ARG_transpose].u_bool ? tof_height : tof_width,
         .h = args[ARG_transpose].u_bool ? tof_width : tof_height,
@@ -522,20 +680,31 @@ mp_obj_t py_tof_snapshot(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
     const uint8_t *alpha_palette = py_helper_arg_to_palette(args[ARG_alpha_palette].u_obj, PIXFORMAT_GRAYSCALE);
 
     fb_alloc_mark();
-    // Allocate source image data.
-    src_img.data = fb_alloc(src_img.w * src_img.h * sizeof(uint8_t), FB_ALLOC_NO_HINT);
+    // Allocate source image data, GRAYSCALE16 snapshots are filled directly.
+    if (!raw) {
+        src_img.data = fb_alloc(src_img.w * src_img.h * sizeof(uint8_t), FB_ALLOC_NO_HINT);
+    }
 
     switch (tof_sensor) {
         #if (OMV_TOF_VL53L5CX_ENABLE == 1)
         case TOF_VL53L5CX: {
-            float *frame = fb_alloc(VL53L5CX_WIDTH * VL53L5CX_HEIGHT * sizeof(float), FB_ALLOC_PREFER_SPEED);
-            tof_vl53l5cx_get_depth(&vl53l5cx_dev, frame, args[ARG_timeout].u_int);
+            // The distances are converted to pixels directly, without going through floats.
+            int16_t frame[VL53L5CX_WIDTH * VL53L5CX_HEIGHT];
+            tof_vl53l5cx_get_frame(&vl53l5cx_dev, frame, args[ARG_timeout].u_int);
+            int frame_min = INT16_MAX;
+            int frame_max = INT16_MIN;
             if (args[ARG_scale].u_obj == mp_const_none) {
-                fast_get_min_max(frame, VL53L5CX_WIDTH * VL53L5CX_HEIGHT, &min, &max);
+                for (int i = 0, ii = VL53L5CX_WIDTH * VL53L5CX_HEIGHT; i < ii; i++) {
+                    frame_min = IM_MIN(frame_min, frame[i]);
+                    frame_max = IM_MAX(frame_max, frame[i]);
+                }
+            } else {
+                frame_min = fast_floorf(min);
+                frame_max = fast_ceilf(max);
             }
-            imlib_fill_image_from_float(&src_img, VL53L5CX_WIDTH, VL53L5CX_HEIGHT, frame, min, max,
-                                        !args[ARG_hmirror].u_bool, args[ARG_vflip].u_bool,
-                                        args[ARG_transpose].u_bool, true);
+            tof_fill_image_from_mm(raw ? &dst_img : &src_img, VL53L5CX_WIDTH, VL53L5CX_HEIGHT, frame,
+                                   frame_min, frame_max, !args[ARG_hmirror].u_bool, args[ARG_vflip].u_bool,
+                                   args[ARG_transpose].u_bool, true);
             break;
         }
         #endif
@@ -543,9 +712,11 @@ mp_obj_t py_tof_snapshot(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_arg
             mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("TOF sensor is not initialized"));
     }
 
-    imlib_draw_image(&dst_img, &src_img, 0, 0, x_scale, y_scale, &roi,
-                     args[ARG_channel].u_int, args[ARG_alpha].u_int, color_palette, alpha_palette,
-                     (args[ARG_hint].u_int & (~IMAGE_HINT_CENTER)) | IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
+    if (!raw) {
+        imlib_draw_image(&dst_img, &src_img, 0, 0, x_scale, y_scale, &roi,
+                         args[ARG_channel].u_int, args[ARG_alpha].u_int, color_palette, alpha_palette,
+                         (args[ARG_hint].u_int & (~IMAGE_HINT_CENTER)) | IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
+    }
 
     fb_alloc_free_till_mark();
 
@@ -566,12 +737,14 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_PALETTE_IRONBOW),     MP_ROM_INT(COLOR_PALETTE_IRONBOW)       },
     { MP_ROM_QSTR(MP_QSTR_GRAYSCALE),           MP_ROM_INT(PIXFORMAT_GRAYSCALE)         },
     { MP_ROM_QSTR(MP_QSTR_RGB565),              MP_ROM_INT(PIXFORMAT_RGB565)            },
+    { MP_ROM_QSTR(MP_QSTR_GRAYSCALE16),         MP_ROM_INT(PIXFORMAT_GRAYSCALE16)       },
     { MP_ROM_QSTR(MP_QSTR_init),                MP_ROM_PTR(&py_tof_init_obj)            },
     { MP_ROM_QSTR(MP_QSTR_deinit),              MP_ROM_PTR(&py_tof_deinit_obj)          },
     { MP_ROM_QSTR(MP_QSTR_type),                MP_ROM_PTR(&py_tof_type_obj)            },
     { MP_ROM_QSTR(MP_QSTR_width),               MP_ROM_PTR(&py_tof_width_obj)           },
     { MP_ROM_QSTR(MP_QSTR_height),              MP_ROM_PTR(&py_tof_height_obj)          },
     { MP_ROM_QSTR(MP_QSTR_refresh),             MP_ROM_PTR(&py_tof_refresh_obj)         },
+    { MP_ROM_QSTR(MP_QSTR_background),          MP_ROM_PTR(&py_tof_background_obj)      },
     { MP_ROM_QSTR(MP_QSTR_read_depth),          MP_ROM_PTR(&py_tof_read_depth_obj)      },
     { MP_ROM_QSTR(MP_QSTR_draw_depth),          MP_ROM_PTR(&py_tof_draw_depth_obj)      },
     { MP_ROM_QSTR(MP_QSTR_snapshot),            MP_ROM_PTR(&py_tof_snapshot_obj)        }
@@ -0,0 +1,210 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * Tracker Python module.
+ */
+#include "imlib_config.h"
+#if defined(IMLIB_ENABLE_TRACKER)
+
+#include "py/runtime.h"
+#include "py/obj.h"
+
+#include "imlib.h"
+#include "py_assert.h"
+#include "py_helper.h"
+
+static const mp_obj_type_t py_tracker_type;
+
+// Tracker object
+typedef struct py_tracker_obj {
+    mp_obj_base_t base;
+    imlib_tracker_t tracker;
+    imlib_tracker_detection_t *detections;
+    size_t max_detections;
+    uint32_t min_hits;
+} py_tracker_obj_t;
+
+static mp_obj_t py_tracker_rect_to_tuple(rectangle_t *r) {
+    mp_obj_t tuple[4] = {
+        mp_obj_new_int(r->x),
+        mp_obj_new_int(r->y),
+        mp_obj_new_int(r->w),
+        mp_obj_new_int(r->h)
+    };
+    return mp_obj_new_tuple(4, tuple);
+}
+
+// Accepts a rect tuple, an object with a rect() method (blobs, apriltags, barcodes, etc) or a
+// (rect, score) tuple as returned by the ML post-processing functions.
+static void py_tracker_add_detection(py_tracker_obj_t *self, size_t *n, mp_obj_t obj, int label, int index) {
+    mp_obj_t dest[2];
+    mp_load_method_maybe(obj, MP_QSTR_rect, dest);
+
+    if (dest[0] != MP_OBJ_NULL) {
+        obj = mp_call_method_n_kw(0, 0, dest);
+    } else {
+        size_t len;
+        mp_obj_t *items;
+        mp_obj_get_array(obj, &len, &items);
+
+        if (len == 2) {
+            obj = items[0];
+        }
+    }
+
+    if (*n >= self->max_detections) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Too many detections"));
+    }
+
+    mp_obj_t *rect;
+    mp_obj_get_array_fixed_n(obj, 4, &rect);
+
+    imlib_tracker_detection_t *d = &self->detections[(*n)++];
+    d->rect.x = mp_obj_get_int(rect[0]);
+    d->rect.y = mp_obj_get_int(rect[1]);
+    d->rect.w = mp_obj_get_int(rect[2]);
+    d->rect.h = mp_obj_get_int(rect[3]);
+    d->label = label;
+    d->index = index;
+}
+
+static void py_tracker_print(const mp_print_t *print, mp_obj_t self_in, mp_print_kind_t kind) {
+    py_tracker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    mp_printf(print, "<tracker tracks:%d max_tracks:%d next_id:%d>",
+              self->tracker.n_tracks, self->tracker.max_tracks, self->tracker.next_id);
+}
+
+static mp_obj_t py_tracker_update(mp_obj_t self_in, mp_obj_t detections_obj) {
+    py_tracker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+
+    size_t len, n = 0;
+    mp_obj_t *items;
+    mp_obj_get_array(detections_obj, &len, &items);
+
+    // A list of lists is a list of detections per class, the class index is the label.
+    for (size_t i = 0; i < len; i++) {
+        if (mp_obj_is_type(items[i], &mp_type_list)) {
+            size_t class_len;
+            mp_obj_t *class_items;
+            mp_obj_get_array(items[i], &class_len, &class_items);
+
+            for (size_t j = 0; j < class_len; j++) {
+                py_tracker_add_detection(self, &n, class_items[j], i, j);
+            }
+        } else {
+            py_tracker_add_detection(self, &n, items[i], 0, i);
+        }
+    }
+
+    imlib_tracker_update(&self->tracker, self->detections, n);
+
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+
+    for (size_t i = 0; i < self->tracker.n_tracks; i++) {
+        imlib_tracker_track_t *track = &self->tracker.tracks[i];
+
+        if (track->hits < self->min_hits) {
+            continue;
+        }
+
+        rectangle_t r, p;
+        imlib_tracker_track_rect(track, false, &r);
+        imlib_tracker_track_rect(track, true, &p);
+
+        mp_obj_t tuple[5] = {
+            mp_obj_new_int(track->id),
+            py_tracker_rect_to_tuple(&r),
+            py_tracker_rect_to_tuple(&p),
+            mp_obj_new_int(track->label),
+            mp_obj_new_int(track->index)
+        };
+
+        mp_obj_list_append(list, mp_obj_new_tuple(5, tuple));
+    }
+
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(py_tracker_update_obj, py_tracker_update);
+
+static mp_obj_t py_tracker_reset(mp_obj_t self_in) {
+    py_tracker_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    imlib_tracker_reset(&self->tracker);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_tracker_reset_obj, py_tracker_reset);
+
+static mp_obj_t py_tracker_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_max_tracks, ARG_max_detections, ARG_iou_threshold, ARG_max_distance, ARG_min_hits,
+           ARG_max_misses, ARG_kalman, ARG_process_noise, ARG_measurement_noise };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_max_tracks, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 32 } },
+        { MP_QSTR_max_detections, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 64 } },
+        { MP_QSTR_iou_threshold, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_max_distance, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_min_hits, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 1 } },
+        { MP_QSTR_max_misses, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 5 } },
+        { MP_QSTR_kalman, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = true } },
+        { MP_QSTR_process_noise, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_measurement_noise, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    // Track pairs are indexed with 16-bits.
+    if ((args[ARG_max_tracks].u_int <= 0) || (args[ARG_max_tracks].u_int > UINT16_MAX) ||
+        (args[ARG_max_detections].u_int <= 0) || (args[ARG_max_detections].u_int > INT16_MAX)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid max tracks or detections"));
+    }
+
+    py_tracker_obj_t *self = mp_obj_malloc(py_tracker_obj_t, &py_tracker_type);
+    self->max_detections = args[ARG_max_detections].u_int;
+    self->detections = m_new(imlib_tracker_detection_t, self->max_detections);
+    self->min_hits = IM_MAX(args[ARG_min_hits].u_int, 1);
+
+    imlib_tracker_track_t *tracks = m_new(imlib_tracker_track_t, args[ARG_max_tracks].u_int);
+    imlib_tracker_init(&self->tracker, tracks, args[ARG_max_tracks].u_int);
+
+    self->tracker.iou_threshold = py_helper_arg_to_float(args[ARG_iou_threshold].u_obj, 0.3f);
+    self->tracker.max_distance = py_helper_arg_to_float(args[ARG_max_distance].u_obj, 0.0f);
+    self->tracker.max_misses = IM_MAX(args[ARG_max_misses].u_int, 0);
+    self->tracker.kalman = args[ARG_kalman].u_bool;
+    self->tracker.process_noise = py_helper_arg_to_float(args[ARG_process_noise].u_obj, 1.0f);
+    self->tracker.measurement_noise = py_helper_arg_to_float(args[ARG_measurement_noise].u_obj, 10.0f);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static const mp_rom_map_elem_t py_tracker_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_update),          MP_ROM_PTR(&py_tracker_update_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset),           MP_ROM_PTR(&py_tracker_reset_obj)  },
+};
+static MP_DEFINE_CONST_DICT(py_tracker_locals_dict, py_tracker_locals_dict_table);
+
+static MP_DEFINE_CONST_OBJ_TYPE(
+    py_tracker_type,
+    MP_QSTR_Tracker,
+    MP_TYPE_FLAG_NONE,
+    make_new, py_tracker_make_new,
+    print, py_tracker_print,
+    locals_dict, &py_tracker_locals_dict
+    );
+
+static const mp_rom_map_elem_t globals_dict_table[] = {
+    { MP_OBJ_NEW_QSTR(MP_QSTR___name__),    MP_OBJ_NEW_QSTR(MP_QSTR_tracker)  },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_Tracker),     MP_ROM_PTR(&py_tracker_type)      },
+};
+static MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
+
+const mp_obj_module_t tracker_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_t) &globals_dict,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_tracker, tracker_module);
+#endif // IMLIB_ENABLE_TRACKER
@@ -426,7 +426,7 @@ static void spi_config_init(bool triple_buffer) {
 
     spi_config.baudrate = TV_BAUDRATE;
     spi_config.nss_enable = false;
-    spi_config.dma_flags = triple_buffer ? OMV_SPI_DMA_NORMAL : 0;
+    spi_config.dma_flags = OMV_SPI_DMA_NORMAL;
     omv_spi_init(&spi_bus, &spi_config);
 
     omv_gpio_write(OMV_SPI_DISPLAY_SSEL_PIN, 1);
@@ -571,16 +571,58 @@ static void spi_tv_draw_image_cb_convert_rgb565(uint16_t *row_pointer_i, uint8_t
     }
 }
 
+// Without triple buffering, lines are converted into two line buffers and sent with DMA, so the next
+// line is drawn and converted while the current line is sent.
+static uint8_t *tv_lines[2];
+static int tv_line_index;
+static volatile bool tv_line_busy;
+
+static void spi_tv_line_callback(omv_spi_t *spi, void *userdata, void *buf) {
+    tv_line_busy = false;
+}
+
+static void spi_tv_line_wait() {
+    while (tv_line_busy) {
+        // Waits for one line at most.
+    }
+}
+
+static void spi_tv_line_send(uint8_t *line) {
+    #ifdef __DCACHE_PRESENT
+    // Flush data for DMA
+    SCB_CleanDCache_by_Addr((uint32_t *) line, PICLINE_LENGTH_BYTES);
+    #endif
+
+    spi_tv_line_wait();
+    tv_line_busy = true;
+
+    omv_spi_transfer_t spi_xfer = {
+        .txbuf = line,
+        .size = PICLINE_LENGTH_BYTES,
+        .flags = OMV_SPI_XFER_DMA,
+        .callback = spi_tv_line_callback,
+    };
+    omv_spi_transfer_start(&spi_bus, &spi_xfer);
+}
+
+// Returns the line buffer that is not being sent.
+static uint8_t *spi_tv_line_next() {
+    tv_line_index ^= 1;
+    return tv_lines[tv_line_index];
+}
+
 static void spi_tv_draw_image_cb_grayscale(int x_start, int x_end, int y_row, imlib_draw_row_data_t *data) {
+    uint8_t *line = spi_tv_line_next();
     memset(((uint8_t *) data->dst_row_override) + x_end, 0, TV_WIDTH - x_end); // clear trailing bytes.
-    spi_tv_draw_image_cb_convert_grayscale((uint8_t *) data->dst_row_override, (uint8_t *) data->dst_row_override);
-    SpiTransmitReceivePacket(data->dst_row_override, NULL, PICLINE_LENGTH_BYTES, false);
+    spi_tv_draw_image_cb_convert_grayscale((uint8_t *) data->dst_row_override, line);
+    spi_tv_line_send(line);
 }
 
 static void spi_tv_draw_image_cb_rgb565(int x_start, int x_end, int y_row, imlib_draw_row_data_t *data) {
+    uint8_t *line = spi_tv_line_next();
     memset(data->dst_row_override, 0, x_start * sizeof(uint16_t)); // clear leading bytes.
-    spi_tv_draw_image_cb_convert_rgb565((uint16_t *) data->dst_row_override, (uint8_t *) data->dst_row_override);
-    SpiTransmitReceivePacket(data->dst_row_override, NULL, PICLINE_LENGTH_BYTES, false);
+    spi_tv_draw_image_cb_convert_rgb565((uint16_t *) data->dst_row_override, line);
+    spi_tv_line_send(line);
 }
 
 static void spi_tv_display(image_t *src_img, int dst_x_start, int dst_y_start, float x_scale, float y_scale,
@@ -590,7 +632,7 @@ static void spi_tv_display(image_t *src_img, int dst_x_start, int dst_y_start, f
     bool rgb565 = ((rgb_channel == -1) && src_img->is_color) || color_palette;
     imlib_draw_row_callback_t cb = rgb565 ? spi_tv_draw_image_cb_rgb565 : spi_tv_draw_image_cb_grayscale;
 
-    image_t dst_img;
+    image_t dst_img = {};
     dst_img.w = TV_WIDTH;
     dst_img.h = TV_HEIGHT;
     dst_img.pixfmt = rgb565 ? PIXFORMAT_RGB565 : PIXFORMAT_GRAYSCALE;
@@ -601,19 +643,23 @@ static void spi_tv_display(image_t *src_img, int dst_x_start, int dst_y_start, f
     bool black = p0.x == -1;
 
     if (!tv_triple_buffer) {
-        dst_img.data = fb_alloc0(TV_WIDTH_RGB565, FB_ALLOC_NO_HINT);
+        dst_img.data = fb_alloc0(TV_WIDTH_RGB565, FB_ALLOC_CACHE_ALIGN);
+        tv_lines[0] = fb_alloc0(PICLINE_LENGTH_BYTES, FB_ALLOC_CACHE_ALIGN);
+        tv_lines[1] = fb_alloc0(PICLINE_LENGTH_BYTES, FB_ALLOC_CACHE_ALIGN);
+        tv_line_index = 0;
 
         SpiTransmitReceivePacket((uint8_t *) write_sram, NULL, sizeof(write_sram), false);
 
+        // Both line buffers start zeroed.
         if (black) {
             // zero the whole image
             for (int i = 0; i < TV_HEIGHT; i++) {
-                SpiTransmitReceivePacket(dst_img.data, NULL, PICLINE_LENGTH_BYTES, false);
+                spi_tv_line_send(tv_lines[0]);
             }
         } else {
             // Zero the top rows
             for (int i = 0; i < p0.y; i++) {
-                SpiTransmitReceivePacket(dst_img.data, NULL, PICLINE_LENGTH_BYTES, false);
+                spi_tv_line_send(tv_lines[0]);
             }
 
             // Transmits left/right parts already zeroed...
@@ -623,16 +669,20 @@ static void spi_tv_display(image_t *src_img, int dst_x_start, int dst_y_start, f
 
             // Zero the bottom rows
             if (p1.y < TV_HEIGHT) {
-                memset(dst_img.data, 0, TV_WIDTH_RGB565);
-            }
+                uint8_t *line = spi_tv_line_next();
+                memset(line, 0, PICLINE_LENGTH_BYTES);
 
-            for (int i = p1.y; i < TV_HEIGHT; i++) {
-                SpiTransmitReceivePacket(dst_img.data, NULL, PICLINE_LENGTH_BYTES, false);
+                for (int i = p1.y; i < TV_HEIGHT; i++) {
+                    spi_tv_line_send(line);
+                }
             }
         }
 
+        spi_tv_line_wait();
         omv_gpio_write(OMV_SPI_DISPLAY_SSEL_PIN, 1);
-        fb_free();
+        fb_free(); // tv_lines[1]
+        fb_free(); // tv_lines[0]
+        fb_free(); // dst_img.data
     } else {
         // For triple buffering we are never drawing where head or tail (which may instantly update to
         // to be equal to head) is.
@@ -53,6 +53,8 @@
 
 #include "omv_boardconfig.h"
 #include "framebuffer.h"
+#include "omv_task.h"
+#include "probe.h"
 #include "sensor.h"
 #include "usbdbg.h"
 #include "tinyusb_debug.h"
@@ -73,6 +75,7 @@ int main(void) {
     pendsv_init();
 
 soft_reset:
+    boot_timeline_reset();
     led_init();
 
     // Initialize the stack and GC memory.
@@ -81,6 +84,7 @@ soft_reset:
 
     // Initialise MicroPython runtime.
     mp_init();
+    OMV_BOOT_MARK(runtime);
 
     // Initialise low-level sub-systems.
     py_fir_init0();
@@ -93,6 +97,7 @@ soft_reset:
     imlib_init_all();
     readline_init0();
     fb_alloc_init0();
+    omv_task_init0();
     framebuffer_init0();
     sensor_init0();
     //dma_alloc_init0();
@@ -108,6 +113,7 @@ soft_reset:
     machine_i2s_init0();
     #endif
     machine_rtc_start();
+    OMV_BOOT_MARK(peripherals);
 
     #if MICROPY_PY_LWIP
     // lwIP can only be initialized once, because the system timeout
@@ -138,12 +144,14 @@ soft_reset:
     #if MICROPY_PY_NETWORK
     mod_network_init();
     #endif
+    OMV_BOOT_MARK(network);
 
     #if MICROPY_PY_SENSOR
     if (first_soft_reset) {
         sensor_init();
     }
     #endif
+    OMV_BOOT_MARK(sensor);
 
     // Mount or create a fresh filesystem.
     mp_obj_t mount_point = MP_OBJ_NEW_QSTR(MP_QSTR__slash_);
@@ -182,11 +190,13 @@ soft_reset:
 
     // Mark the filesystem as an OpenMV storage.
     file_ll_touch(".openmv_disk");
+    OMV_BOOT_MARK(storage);
 
     // Initialize TinyUSB after the filesystem is mounted.
     if (!tusb_inited()) {
         tusb_init();
     }
+    OMV_BOOT_MARK(usb);
 
     // Run boot.py script.
     bool interrupted = mp_exec_bootscript("boot.py", true, false);
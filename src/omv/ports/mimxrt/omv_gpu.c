@@ -0,0 +1,229 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * GPU driver for mimxrt port.
+ *
+ * The PXP process surface is used to scale, mirror/flip and convert RGB565 or GRAYSCALE images
+ * to an RGB565 destination, and its background color is used to fill rectangles. The PXP scaler
+ * always filters, so scaled images without IMAGE_HINT_BILINEAR are left to the software path.
+ * Same format copies use the alpha surface, which is otherwise kept disabled.
+ */
+#include "omv_boardconfig.h"
+#if (OMV_GPU_ENABLE == 1)
+#include "py/mphal.h"
+#include "fsl_pxp.h"
+#include "imlib.h"
+#include "omv_gpu.h"
+
+#define OMV_GPU_TIMEOUT_MS  (1000)
+
+int omv_gpu_init() {
+    PXP_Init(PXP);
+    return 0;
+}
+
+void omv_gpu_deinit() {
+    PXP_Deinit(PXP);
+}
+
+// Cleans (and invalidates) the cache lines of rows of pixels before the PXP accesses them.
+static void omv_gpu_clean_rows(void *ptr, int rows, size_t len, size_t stride, bool invalidate) {
+    for (int i = 0; i < rows; i++, ptr = ((uint8_t *) ptr) + stride) {
+        if (invalidate) {
+            SCB_CleanInvalidateDCache_by_Addr(ptr, len);
+        } else {
+            SCB_CleanDCache_by_Addr(ptr, len);
+        }
+    }
+}
+
+// Drops any cached reads of rows written by the PXP.
+static void omv_gpu_invalidate_rows(void *ptr, int rows, size_t len, size_t stride) {
+    for (int i = 0; i < rows; i++, ptr = ((uint8_t *) ptr) + stride) {
+        SCB_InvalidateDCache_by_Addr(ptr, len);
+    }
+}
+
+// Resets the PXP to its initial state, with the alpha surface disabled.
+static void omv_gpu_reset() {
+    PXP_ResetControl(PXP);
+    PXP_SetAlphaSurfacePosition(PXP, 0xFFFFU, 0xFFFFU, 0U, 0U);
+}
+
+// Waits for the PXP to finish.
+static int omv_gpu_wait(void *dst, int rows, size_t len, size_t stride) {
+    int ret = 0;
+    for (mp_uint_t start = mp_hal_ticks_ms(); !(PXP_GetStatusFlags(PXP) & kPXP_CompleteFlag);) {
+        if ((mp_hal_ticks_ms() - start) > OMV_GPU_TIMEOUT_MS) {
+            omv_gpu_reset();
+            ret = -1;
+            break;
+        }
+    }
+
+    PXP_ClearStatusFlags(PXP, kPXP_CompleteFlag);
+    omv_gpu_invalidate_rows(dst, rows, len, stride);
+    return ret;
+}
+
+// Starts the PXP and waits for it to finish.
+static int omv_gpu_run(void *dst, int rows, size_t len, size_t stride) {
+    omv_gpu_clean_rows(dst, rows, len, stride, true);
+    PXP_Start(PXP);
+    return omv_gpu_wait(dst, rows, len, stride);
+}
+
+int omv_gpu_draw_image(image_t *src_img,
+                       rectangle_t *src_rect,
+                       image_t *dst_img,
+                       rectangle_t *dst_rect,
+                       int alpha,
+                       const uint16_t *color_palette,
+                       const uint8_t *alpha_palette,
+                       image_hint_t hint) {
+    if ((dst_rect->w <= 0) || (dst_rect->h <= 0) || (src_rect->w <= 0) || (src_rect->h <= 0)) {
+        return -1;
+    }
+
+    // The PXP can only draw on RGB565 buffers and read from RGB565 or GRAYSCALE buffers. The
+    // alpha surface isn't used, so the image can't be blended or have palettes.
+    if ((dst_img->pixfmt != PIXFORMAT_RGB565) ||
+        ((src_img->pixfmt != PIXFORMAT_RGB565) && (src_img->pixfmt != PIXFORMAT_GRAYSCALE)) ||
+        (alpha != 256) || color_palette || alpha_palette) {
+        return -1;
+    }
+
+    if (((dst_rect->w != src_rect->w) || (dst_rect->h != src_rect->h)) && (!(hint & IMAGE_HINT_BILINEAR))) {
+        return -1;
+    }
+
+    OMV_PROFILE_START(gpu_draw_image);
+
+    bool grayscale = (src_img->pixfmt == PIXFORMAT_GRAYSCALE);
+    size_t bpp = grayscale ? sizeof(uint8_t) : sizeof(uint16_t);
+    size_t src_stride = grayscale ? IMAGE_GRAYSCALE_ROW_STRIDE(src_img) : IMAGE_RGB565_ROW_STRIDE(src_img);
+    size_t dst_stride = IMAGE_RGB565_ROW_STRIDE(dst_img);
+    uint8_t *src8 = src_img->data + (src_rect->y * src_stride) + (src_rect->x * bpp);
+    uint16_t *dst16 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst_img, dst_rect->y) + dst_rect->x;
+
+    pxp_ps_buffer_config_t ps_config = {
+        .pixelFormat = grayscale ? kPXP_PsPixelFormatY8 : kPXP_PsPixelFormatRGB565,
+        .swapByte = false,
+        .bufferAddr = (uint32_t) src8,
+        .bufferAddrU = 0,
+        .bufferAddrV = 0,
+        .pitchBytes = src_stride,
+    };
+
+    pxp_output_buffer_config_t out_config = {
+        .pixelFormat = kPXP_OutputPixelFormatRGB565,
+        .interlacedMode = kPXP_OutputProgressive,
+        .buffer0Addr = (uint32_t) dst16,
+        .buffer1Addr = 0,
+        .pitchBytes = dst_stride,
+        .width = dst_rect->w,
+        .height = dst_rect->h,
+    };
+
+    pxp_flip_mode_t flip = kPXP_FlipDisable;
+    if (hint & IMAGE_HINT_HMIRROR) {
+        flip |= kPXP_FlipHorizontal;
+    }
+    if (hint & IMAGE_HINT_VFLIP) {
+        flip |= kPXP_FlipVertical;
+    }
+
+    // Grayscale is read as luma only and converted with the full range YUV to RGB transform.
+    PXP_SetCsc1Mode(PXP, kPXP_Csc1YUV2RGB);
+    PXP_EnableCsc1(PXP, grayscale);
+
+    PXP_SetProcessSurfaceBufferConfig(PXP, &ps_config);
+    PXP_SetProcessSurfaceScaler(PXP, src_rect->w, src_rect->h, dst_rect->w, dst_rect->h);
+    PXP_SetProcessSurfacePosition(PXP, 0, 0, dst_rect->w - 1, dst_rect->h - 1);
+    PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate0, flip);
+    PXP_SetOutputBufferConfig(PXP, &out_config);
+
+    omv_gpu_clean_rows(src8, src_rect->h, src_rect->w * bpp, src_stride, false);
+    int ret = omv_gpu_run(dst16, dst_rect->h, dst_rect->w * sizeof(uint16_t), dst_stride);
+
+    PXP_EnableCsc1(PXP, false);
+    PXP_SetRotateConfig(PXP, kPXP_RotateOutputBuffer, kPXP_Rotate0, kPXP_FlipDisable);
+
+    OMV_PROFILE_END(gpu_draw_image);
+    return ret;
+}
+
+int omv_gpu_fill_rect(image_t *dst_img, rectangle_t *rect, int color) {
+    if (dst_img->pixfmt != PIXFORMAT_RGB565) {
+        return -1;
+    }
+
+    size_t dst_stride = IMAGE_RGB565_ROW_STRIDE(dst_img);
+    uint16_t *dst16 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst_img, rect->y) + rect->x;
+
+    pxp_output_buffer_config_t out_config = {
+        .pixelFormat = kPXP_OutputPixelFormatRGB565,
+        .interlacedMode = kPXP_OutputProgressive,
+        .buffer0Addr = (uint32_t) dst16,
+        .buffer1Addr = 0,
+        .pitchBytes = dst_stride,
+        .width = rect->w,
+        .height = rect->h,
+    };
+
+    // With the process surface moved out of the output, the output is its background color.
+    PXP_SetProcessSurfaceBackGroundColor(PXP, (COLOR_RGB565_TO_R8(color) << 16) |
+                                         (COLOR_RGB565_TO_G8(color) << 8) |
+                                         COLOR_RGB565_TO_B8(color));
+    PXP_SetProcessSurfacePosition(PXP, 0xFFFFU, 0xFFFFU, 0U, 0U);
+    PXP_SetOutputBufferConfig(PXP, &out_config);
+
+    return omv_gpu_run(dst16, rect->h, rect->w * sizeof(uint16_t), dst_stride);
+}
+
+int omv_gpu_copy(void *dst, size_t dst_stride, const void *src, size_t src_stride, size_t w, size_t h, size_t bpp) {
+    size_t len = w * bpp;
+
+    // Rows are moved as ARGB8888 or RGB565 pixels, the widest unit that all addresses and
+    // lengths are aligned to, so the pixel size of the image doesn't matter.
+    uint32_t align = ((uint32_t) dst) | ((uint32_t) src) | dst_stride | src_stride | len;
+    size_t unit = (!(align & 3)) ? sizeof(uint32_t) : (!(align & 1)) ? sizeof(uint16_t) : 0;
+
+    if ((!unit) || (dst_stride > UINT16_MAX) || (src_stride > UINT16_MAX)) {
+        return -1;
+    }
+
+    pxp_pic_copy_config_t config = {
+        .srcPicBaseAddr = (uint32_t) src,
+        .srcPitchBytes = src_stride,
+        .srcOffsetX = 0,
+        .srcOffsetY = 0,
+        .destPicBaseAddr = (uint32_t) dst,
+        .destPitchBytes = dst_stride,
+        .destOffsetX = 0,
+        .destOffsetY = 0,
+        .width = len / unit,
+        .height = h,
+        .pixelFormat = (unit == sizeof(uint32_t)) ? kPXP_AsPixelFormatARGB8888 : kPXP_AsPixelFormatRGB565,
+    };
+
+    omv_gpu_clean_rows((void *) src, h, len, src_stride, false);
+    omv_gpu_clean_rows(dst, h, len, dst_stride, true);
+
+    // The copy is done by the alpha surface, which is disabled again for the other operations.
+    PXP_StartPictureCopy(PXP, &config);
+    int ret = omv_gpu_wait(dst, h, len, dst_stride);
+    omv_gpu_reset();
+    return ret;
+}
+
+// PXP can't draw lines.
+int omv_gpu_draw_line(image_t *dst_img, int x0, int y0, int x1, int y1, int color, int thickness) {
+    return -1;
+}
+#endif // (OMV_GPU_ENABLE == 1)
@@ -129,4 +129,7 @@ struct {                                                \
 
 #define OMV_I2C_MAX_8BIT_XFER   (1024U)
 #define OMV_I2C_MAX_16BIT_XFER  (512U)
+
+// The CSI driver mirrors and flips lines while copying them, for sensors without these controls.
+#define OMV_CSI_LINE_FLIP_ENABLE    (1)
 #endif // __OMV_PORTCONFIG_H__
@@ -162,6 +162,7 @@ int sensor_abort(bool fifo_flush, bool in_irq) {
     sensor.drop_frame = false;
     sensor.last_frame_ms = 0;
     sensor.last_frame_ms_valid = false;
+    sensor.last_frame_us = 0;
     if (fifo_flush) {
         framebuffer_flush_buffers(true);
     } else if (!sensor.disable_full_flush) {
@@ -205,7 +206,7 @@ void sensor_sof_callback() {
 }
 
 #if defined(OMV_CSI_DMA)
-int sensor_dma_memcpy(void *dma, void *dst, void *src, int bpp, bool transposed) {
+int sensor_dma_memcpy(void *dma, void *dst, void *src, int bpp, bool transposed, bool reversed) {
     // EMDA will not perform burst transfers for anything less than 32-byte chunks made of four 64-bit
     // beats. Additionally, the CSI hardware lacks cropping so we cannot align the source address.
     // Given this, performance will be lacking on cropped images. So much so that we do not use
@@ -214,6 +215,16 @@ int sensor_dma_memcpy(void *dma, void *dst, void *src, int bpp, bool transposed)
         return -1;
     }
 
+    // Transposed and reversed lines are written one pixel at a time, the source is still read
+    // in bursts. The signed destination offset moves down a column and/or backwards.
+    int dest_width = dest_inc_size;
+    int dest_offset = dest_inc_size;
+
+    if (transposed || reversed) {
+        dest_width = bpp;
+        dest_offset = (transposed ? (MAIN_FB()->v * bpp) : bpp) * (reversed ? -1 : 1);
+    }
+
     edma_handle_t *handle = dma;
     edma_transfer_config_t config;
     EDMA_PrepareTransferConfig(&config,
@@ -221,8 +232,8 @@ int sensor_dma_memcpy(void *dma, void *dst, void *src, int bpp, bool transposed)
                                src_size, // srcWidth
                                src_inc, // srcOffset
                                dst, // destAddr
-                               transposed ? bpp : dest_inc_size, // destWidth
-                               transposed ? (MAIN_FB()->v * bpp) : dest_inc_size, // destOffset
+                               dest_width, // destWidth
+                               dest_offset, // destOffset
                                MAIN_FB()->u * bpp, // bytesEachRequest
                                MAIN_FB()->u * bpp); // transferBytes
 
@@ -324,10 +335,16 @@ void sensor_line_callback(uint32_t addr) {
             bytes_per_pixel = 1;
         }
 
+        // Flipped images are written from the last row.
+        uint32_t row = buffer->offset - MAIN_FB()->y;
+        if (sensor.vflip_copy) {
+            row = MAIN_FB()->v - row - 1;
+        }
+
         if (sensor.transpose) {
-            dst += bytes_per_pixel * (buffer->offset - MAIN_FB()->y);
+            dst += bytes_per_pixel * row;
         } else {
-            dst += MAIN_FB()->u * bytes_per_pixel * (buffer->offset - MAIN_FB()->y);
+            dst += MAIN_FB()->u * bytes_per_pixel * row;
         }
 
         #if defined(OMV_CSI_DMA)
@@ -378,10 +395,6 @@ static void edma_config(sensor_t *sensor, uint32_t bytes_per_pixel) {
         }
     }
 
-    if (sensor->transpose) {
-        dest_inc_size = bytes_per_pixel;
-    }
-
     // YUV422 Source -> Y Destination
     if ((sensor->pixformat == PIXFORMAT_GRAYSCALE) && (sensor->mono_bpp == 2)) {
         src_inc = 2;
@@ -482,6 +495,11 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
     vbuffer_t *buffer = framebuffer_get_head(fb_flags);
     // Wait for the DMA to finish the transfer.
     for (mp_uint_t ticks = mp_hal_ticks_ms(); buffer == NULL;) {
+        // The capture keeps running in the background filling the next free buffer.
+        if (flags & SENSOR_SNAPSHOT_NONBLOCKING) {
+            return SENSOR_ERROR_WOULD_BLOCK;
+        }
+
         MICROPY_EVENT_POLL_HOOK
         if ((mp_hal_ticks_ms() - ticks) > SENSOR_TIMEOUT_MS) {
             sensor_abort(true, false);
@@ -506,6 +524,7 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
 
     // The JPEG in the frame buffer is actually invalid.
     if (buffer->jpeg_buffer_overflow) {
+        sensor_auto_quality_update(0, true);
         return SENSOR_ERROR_JPEG_OVERFLOW;
     }
 
@@ -528,7 +547,11 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
         case PIXFORMAT_BAYER:
             MAIN_FB()->pixfmt = PIXFORMAT_BAYER;
             MAIN_FB()->subfmt_id = sensor->cfa_format;
-            MAIN_FB()->pixfmt = imlib_bayer_shift(MAIN_FB()->pixfmt, MAIN_FB()->x, MAIN_FB()->y, sensor->transpose);
+            // Flipping moves the first pixel to the other end of the line or column.
+            MAIN_FB()->pixfmt = imlib_bayer_shift(MAIN_FB()->pixfmt,
+                                                  MAIN_FB()->x + (sensor->hmirror_copy ? (w - 1) : 0),
+                                                  MAIN_FB()->y + (sensor->vflip_copy ? (h - 1) : 0),
+                                                  sensor->transpose);
             break;
         case PIXFORMAT_YUV422: {
             MAIN_FB()->pixfmt = PIXFORMAT_YUV;
@@ -548,6 +571,7 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
             // Clean trailing data after 0xFFD9 at the end of the jpeg byte stream.
             MAIN_FB()->pixfmt = PIXFORMAT_JPEG;
             MAIN_FB()->size = jpeg_clean_trailing_bytes(size, buffer->data);
+            sensor_auto_quality_update(MAIN_FB()->size, false);
             break;
         }
         default:
@@ -87,6 +87,7 @@
 #include "usbdbg.h"
 #include "py_audio.h"
 #include "framebuffer.h"
+#include "omv_task.h"
 #include "omv_boardconfig.h"
 #include "omv_i2c.h"
 #include "sensor.h"
@@ -167,6 +168,7 @@ soft_reset:
     pin_init0();
 
     fb_alloc_init0();
+    omv_task_init0();
     framebuffer_init0();
 
     #if MICROPY_PY_SENSOR
@@ -114,13 +114,16 @@ FIRM_OBJ += $(addprefix $(BUILD)/$(OMV_DIR)/common/, \
 	ini.o                       \
 	ringbuf.o                   \
 	trace.o                     \
+	probe.o                     \
 	mutex.o                     \
 	pendsv.o                    \
+	omv_task.o                  \
 	usbdbg.o                    \
 	tinyusb_debug.o             \
 	file_utils.o                \
 	mp_utils.o                  \
 	sensor_utils.o              \
+	omv_i2c_regs.o              \
    )
 
 FIRM_OBJ += $(addprefix $(BUILD)/$(OMV_DIR)/sensors/,   \
@@ -145,6 +148,8 @@ FIRM_OBJ += $(addprefix $(BUILD)/$(OMV_DIR)/imlib/, \
 	bmp.o                       \
 	clahe.o                     \
 	collections.o               \
+	contour.o                   \
+	convert.o                   \
 	dmtx.o                      \
 	draw.o                      \
 	edge.o                      \
@@ -157,6 +162,8 @@ FIRM_OBJ += $(addprefix $(BUILD)/$(OMV_DIR)/imlib/, \
 	framebuffer.o               \
 	fsort.o                     \
 	gif.o                       \
+	gradient.o                  \
+	gray16.o                    \
 	haar.o                      \
 	hog.o                       \
 	hough.o                     \
@@ -168,6 +175,7 @@ FIRM_OBJ += $(addprefix $(BUILD)/$(OMV_DIR)/imlib/, \
 	jpege.o                     \
 	lodepng.o                   \
 	png.o                       \
+	pnge.o                      \
 	kmeans.o                    \
 	lab_tab.o                   \
 	lbp.o                       \
@@ -175,9 +183,13 @@ FIRM_OBJ += $(addprefix $(BUILD)/$(OMV_DIR)/imlib/, \
 	lsd.o                       \
 	mathop.o                    \
 	mjpeg.o                     \
+	optflow.o                   \
+	tracker.o                   \
 	orb.o                       \
 	phasecorrelation.o          \
 	point.o                     \
+	pool.o                      \
+	pyramid.o                   \
 	ppm.o                       \
 	qrcode.o                    \
 	qsort.o                     \
@@ -56,6 +56,7 @@
 
 #include "omv_boardconfig.h"
 #include "framebuffer.h"
+#include "omv_task.h"
 #include "omv_i2c.h"
 #include "sensor.h"
 #include "usbdbg.h"
@@ -170,6 +171,7 @@ soft_reset:
     usbdbg_init();
 
     fb_alloc_init0();
+    omv_task_init0();
     framebuffer_init0();
 
     py_fir_init0();
@@ -104,13 +104,17 @@ target_sources(${MICROPY_TARGET} PRIVATE
     ${TOP_DIR}/${OMV_DIR}/common/ini.c
     ${TOP_DIR}/${OMV_DIR}/common/ringbuf.c
     ${TOP_DIR}/${OMV_DIR}/common/trace.c
+    ${TOP_DIR}/${OMV_DIR}/common/profiler.c
+    ${TOP_DIR}/${OMV_DIR}/common/probe.c
     ${TOP_DIR}/${OMV_DIR}/common/mutex.c
     ${TOP_DIR}/${OMV_DIR}/common/pendsv.c
+    ${TOP_DIR}/${OMV_DIR}/common/omv_task.c
     ${TOP_DIR}/${OMV_DIR}/common/usbdbg.c
     ${TOP_DIR}/${OMV_DIR}/common/tinyusb_debug.c
     ${TOP_DIR}/${OMV_DIR}/common/file_utils.c
     ${TOP_DIR}/${OMV_DIR}/common/mp_utils.c
     ${TOP_DIR}/${OMV_DIR}/common/sensor_utils.c
+    ${TOP_DIR}/${OMV_DIR}/common/omv_i2c_regs.c
 
     ${TOP_DIR}/${OMV_DIR}/sensors/ov2640.c
     ${TOP_DIR}/${OMV_DIR}/sensors/ov5640.c
@@ -132,6 +136,8 @@ target_sources(${MICROPY_TARGET} PRIVATE
     ${TOP_DIR}/${OMV_DIR}/imlib/bmp.c
     ${TOP_DIR}/${OMV_DIR}/imlib/clahe.c
     ${TOP_DIR}/${OMV_DIR}/imlib/collections.c
+    ${TOP_DIR}/${OMV_DIR}/imlib/contour.c
+    ${TOP_DIR}/${OMV_DIR}/imlib/convert.c
     ${TOP_DIR}/${OMV_DIR}/imlib/dmtx.c
     ${TOP_DIR}/${OMV_DIR}/imlib/draw.c
     ${TOP_DIR}/${OMV_DIR}/imlib/edge.c
@@ -144,6 +150,8 @@ target_sources(${MICROPY_TARGET} PRIVATE
     ${TOP_DIR}/${OMV_DIR}/imlib/framebuffer.c
     ${TOP_DIR}/${OMV_DIR}/imlib/fsort.c
     ${TOP_DIR}/${OMV_DIR}/imlib/gif.c
+    ${TOP_DIR}/${OMV_DIR}/imlib/gradient.c
+    ${TOP_DIR}/${OMV_DIR}/imlib/gray16.c
     ${TOP_DIR}/${OMV_DIR}/imlib/haar.c
     ${TOP_DIR}/${OMV_DIR}/imlib/hog.c
     ${TOP_DIR}/${OMV_DIR}/imlib/hough.c
@@ -155,6 +163,7 @@ target_sources(${MICROPY_TARGET} PRIVATE
     ${TOP_DIR}/${OMV_DIR}/imlib/jpege.c
     ${TOP_DIR}/${OMV_DIR}/imlib/lodepng.c
     ${TOP_DIR}/${OMV_DIR}/imlib/png.c
+    ${TOP_DIR}/${OMV_DIR}/imlib/pnge.c
     ${TOP_DIR}/${OMV_DIR}/imlib/kmeans.c
     ${TOP_DIR}/${OMV_DIR}/imlib/lab_tab.c
     ${TOP_DIR}/${OMV_DIR}/imlib/lbp.c
@@ -162,9 +171,13 @@ target_sources(${MICROPY_TARGET} PRIVATE
     ${TOP_DIR}/${OMV_DIR}/imlib/lsd.c
     ${TOP_DIR}/${OMV_DIR}/imlib/mathop.c
     ${TOP_DIR}/${OMV_DIR}/imlib/mjpeg.c
+    ${TOP_DIR}/${OMV_DIR}/imlib/optflow.c
+    ${TOP_DIR}/${OMV_DIR}/imlib/tracker.c
     ${TOP_DIR}/${OMV_DIR}/imlib/orb.c
     ${TOP_DIR}/${OMV_DIR}/imlib/phasecorrelation.c
     ${TOP_DIR}/${OMV_DIR}/imlib/point.c
+    ${TOP_DIR}/${OMV_DIR}/imlib/pool.c
+    ${TOP_DIR}/${OMV_DIR}/imlib/pyramid.c
     ${TOP_DIR}/${OMV_DIR}/imlib/ppm.c
     ${TOP_DIR}/${OMV_DIR}/imlib/qrcode.c
     ${TOP_DIR}/${OMV_DIR}/imlib/qsort.c
@@ -25,6 +25,7 @@
 #include "hardware/irq.h"
 #include "omv_boardconfig.h"
 #include "unaligned_memcpy.h"
+#include "omv_task.h"
 #include "dcmi.pio.h"
 
 // Sensor struct.
@@ -181,6 +182,17 @@ int sensor_set_windowing(int x, int y, int w, int h) {
     return SENSOR_ERROR_CTL_UNSUPPORTED;
 }
 
+// Frames are captured by a single DMA transfer from the PIO FIFO, which can only write memory
+// sequentially. Transposing needs a column to be written per line, so it isn't supported.
+int sensor_set_transpose(bool enable) {
+    return enable ? SENSOR_ERROR_CTL_UNSUPPORTED : 0;
+}
+
+// Auto rotation transposes the image when rotated by 90 or 270 degrees.
+int sensor_set_auto_rotation(bool enable) {
+    return enable ? SENSOR_ERROR_CTL_UNSUPPORTED : 0;
+}
+
 static void dma_irq_handler() {
     if (dma_irqn_get_channel_status(OMV_CSI_DMA, OMV_CSI_DMA_CHANNEL)) {
         // Clear the interrupt request.
@@ -247,6 +259,8 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
 
     // Wait for the DMA to finish the transfer.
     for (mp_uint_t ticks = mp_hal_ticks_ms(); buffer == NULL;) {
+        // Run background work while waiting.
+        omv_task_run();
         buffer = framebuffer_get_head(FB_NO_FLAGS);
         if ((mp_hal_ticks_ms() - ticks) > 3000) {
             sensor_abort(true, false);
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * AXI QoS profiles.
+ *
+ * The AXI interconnect arbitrates between masters by their QoS priority (0-15, higher wins).
+ * DCMI DMA transfers go through the D2 AHB port, and the line capture offload through MDMA.
+ */
+#include STM32_HAL_H
+#include "omv_boardconfig.h"
+#include "axiqos.h"
+
+#if defined(MCU_SERIES_H7)
+#ifndef OMV_AXI_QOS_D2_AHB_R_PRI
+#define OMV_AXI_QOS_D2_AHB_R_PRI    (0)
+#endif
+#ifndef OMV_AXI_QOS_D2_AHB_W_PRI
+#define OMV_AXI_QOS_D2_AHB_W_PRI    (0)
+#endif
+#ifndef OMV_AXI_QOS_C_M7_R_PRI
+#define OMV_AXI_QOS_C_M7_R_PRI      (0)
+#endif
+#ifndef OMV_AXI_QOS_C_M7_W_PRI
+#define OMV_AXI_QOS_C_M7_W_PRI      (0)
+#endif
+#ifndef OMV_AXI_QOS_SDMMC1_R_PRI
+#define OMV_AXI_QOS_SDMMC1_R_PRI    (0)
+#endif
+#ifndef OMV_AXI_QOS_SDMMC1_W_PRI
+#define OMV_AXI_QOS_SDMMC1_W_PRI    (0)
+#endif
+#ifndef OMV_AXI_QOS_MDMA_R_PRI
+#define OMV_AXI_QOS_MDMA_R_PRI      (0)
+#endif
+#ifndef OMV_AXI_QOS_MDMA_W_PRI
+#define OMV_AXI_QOS_MDMA_W_PRI      (0)
+#endif
+#ifndef OMV_AXI_QOS_DMA2D_R_PRI
+#define OMV_AXI_QOS_DMA2D_R_PRI     (0)
+#endif
+#ifndef OMV_AXI_QOS_DMA2D_W_PRI
+#define OMV_AXI_QOS_DMA2D_W_PRI     (0)
+#endif
+#ifndef OMV_AXI_QOS_LTDC_R_PRI
+#define OMV_AXI_QOS_LTDC_R_PRI      (0)
+#endif
+#ifndef OMV_AXI_QOS_LTDC_W_PRI
+#define OMV_AXI_QOS_LTDC_W_PRI      (0)
+#endif
+
+typedef struct {
+    uint8_t d2_ahb;
+    uint8_t c_m7;
+    uint8_t sdmmc1;
+    uint8_t mdma;
+    uint8_t dma2d;
+    uint8_t ltdc;
+} axiqos_priorities_t;
+
+// Read and write priorities of each profile.
+static const axiqos_priorities_t axiqos_profiles[AXIQOS_PROFILE_COUNT][2] = {
+    [AXIQOS_PROFILE_DEFAULT] = {
+        { OMV_AXI_QOS_D2_AHB_R_PRI, OMV_AXI_QOS_C_M7_R_PRI, OMV_AXI_QOS_SDMMC1_R_PRI,
+          OMV_AXI_QOS_MDMA_R_PRI, OMV_AXI_QOS_DMA2D_R_PRI, OMV_AXI_QOS_LTDC_R_PRI },
+        { OMV_AXI_QOS_D2_AHB_W_PRI, OMV_AXI_QOS_C_M7_W_PRI, OMV_AXI_QOS_SDMMC1_W_PRI,
+          OMV_AXI_QOS_MDMA_W_PRI, OMV_AXI_QOS_DMA2D_W_PRI, OMV_AXI_QOS_LTDC_W_PRI },
+    },
+    // Capture writes and the line offload can't be stalled, the display and CPU can wait.
+    [AXIQOS_PROFILE_CAPTURE] = {
+        { 15, 0, 0, 15, 0, 13 },
+        { 15, 0, 0, 15, 0, 13 },
+    },
+    // The LTDC only reads, the DMA2D that draws the frames comes next.
+    [AXIQOS_PROFILE_DISPLAY] = {
+        { 13, 0, 0, 13, 14, 15 },
+        { 13, 0, 0, 13, 14, 15 },
+    },
+    // The CPU is ahead of the DMA masters, which still share the rest fairly.
+    [AXIQOS_PROFILE_COMPUTE] = {
+        { 14, 15, 0, 14, 0, 14 },
+        { 14, 15, 0, 14, 0, 14 },
+    },
+};
+
+static axiqos_profile_t axiqos_profile;
+axiqos_stats_t axiqos_stats;
+
+void axiqos_init0() {
+    axiqos_set_profile(AXIQOS_PROFILE_DEFAULT);
+    axiqos_stats = (axiqos_stats_t) { 0 };
+}
+
+void axiqos_set_profile(axiqos_profile_t profile) {
+    const axiqos_priorities_t *r = &axiqos_profiles[profile][0];
+    const axiqos_priorities_t *w = &axiqos_profiles[profile][1];
+
+    OMV_AXI_QOS_D2_AHB_R_SET(r->d2_ahb);
+    OMV_AXI_QOS_D2_AHB_W_SET(w->d2_ahb);
+    OMV_AXI_QOS_C_M7_R_SET(r->c_m7);
+    OMV_AXI_QOS_C_M7_W_SET(w->c_m7);
+    OMV_AXI_QOS_SDMMC1_R_SET(r->sdmmc1);
+    OMV_AXI_QOS_SDMMC1_W_SET(w->sdmmc1);
+    OMV_AXI_QOS_MDMA_R_SET(r->mdma);
+    OMV_AXI_QOS_MDMA_W_SET(w->mdma);
+    OMV_AXI_QOS_DMA2D_R_SET(r->dma2d);
+    OMV_AXI_QOS_DMA2D_W_SET(w->dma2d);
+    OMV_AXI_QOS_LTDC_R_SET(r->ltdc);
+    OMV_AXI_QOS_LTDC_W_SET(w->ltdc);
+
+    axiqos_profile = profile;
+}
+
+axiqos_profile_t axiqos_get_profile() {
+    return axiqos_profile;
+}
+#endif // defined(MCU_SERIES_H7)
@@ -10,6 +10,7 @@
  */
 #ifndef __AXIQOS_H__
 #define __AXIQOS_H__
+#include <stdint.h>
 
 #define OMV_AXI_GPV_BASE                0x51000000
 #define OMV_AXI_GPV_QOS_BASE            ((OMV_AXI_GPV_BASE) +0x41100)
@@ -52,4 +53,25 @@
 #define OMV_AXI_QOS_LTDC_W_ADDRESS      OMV_AXI_GPV_QOS_W_BASE(6)
 #define OMV_AXI_QOS_LTDC_W_SET(x)       *((volatile uint32_t *) (OMV_AXI_QOS_LTDC_W_ADDRESS)) = (x)
 
+// Runtime profiles, the default profile is the board's configuration.
+typedef enum {
+    AXIQOS_PROFILE_DEFAULT,
+    AXIQOS_PROFILE_CAPTURE,     // DCMI/MDMA capture first, frames are not dropped.
+    AXIQOS_PROFILE_DISPLAY,     // LTDC scan-out first, the display doesn't underrun.
+    AXIQOS_PROFILE_COMPUTE,     // CPU accesses first, imlib runs faster.
+    AXIQOS_PROFILE_COUNT
+} axiqos_profile_t;
+
+// Symptoms of bus contention, counted by the drivers.
+typedef struct {
+    uint32_t dcmi_overruns;     // DCMI FIFO overruns, each drops a frame.
+    uint32_t ltdc_underruns;    // Frames with LTDC FIFO underruns.
+} axiqos_stats_t;
+
+extern axiqos_stats_t axiqos_stats;
+
+// Restores the default profile and clears the stats.
+void axiqos_init0();
+void axiqos_set_profile(axiqos_profile_t profile);
+axiqos_profile_t axiqos_get_profile();
 #endif // __AXIQOS_H__
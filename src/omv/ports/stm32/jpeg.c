@@ -27,6 +27,7 @@
 #define JPEG_OUTPUT_FIFO_BYTES      (32)
 #define JPEG_MDMA_IN                (0)
 #define JPEG_MDMA_OUT               (1)
+#define JPEG_LINES_MCU_ROWS         (3) // MCU rows buffered by the line fed encoder.
 
 typedef struct jpeg_state {
     volatile uint32_t in_data_len;
@@ -34,8 +35,18 @@ typedef struct jpeg_state {
     volatile uint32_t out_data_len;
     volatile bool input_paused;
     volatile bool output_paused;
+    volatile bool busy;
     JPEG_HandleTypeDef jpeg_descr;
     MDMA_HandleTypeDef mdma_descr[2];
+    // Line fed encoder state.
+    jpeg_lines_callback_t lines_callback;
+    uint8_t *lines_data;
+    uint8_t *mcu_row_buffer;
+    uint32_t mcu_row_bytes;
+    int mcu_size;
+    int w, h;
+    volatile int rows_queued;
+    volatile int rows_done;
 } jpeg_state_t;
 
 static jpeg_state_t JPEG_state = {};
@@ -70,11 +81,127 @@ void jpeg_mdma_irq_handler(void) {
     }
 }
 
+// The JPEG core is shared with the camera driver which may be compressing frames in the
+// background. So, the core is claimed for the duration of each encode or decode.
+static bool jpeg_try_acquire() {
+    mp_uint_t irq_state = disable_irq();
+    bool busy = JPEG_state.busy;
+    JPEG_state.busy = true;
+    enable_irq(irq_state);
+
+    if (busy) {
+        return false;
+    }
+
+    imlib_jpeg_init();
+
+    // The line fed encoder leaves the core stalled if it ran out of output space.
+    if (HAL_JPEG_GetState(&JPEG_state.jpeg_descr) != HAL_JPEG_STATE_READY) {
+        memset(&JPEG_state.jpeg_descr.Conf, 0, sizeof(JPEG_ConfTypeDef));
+        HAL_JPEG_Abort(&JPEG_state.jpeg_descr);
+    }
+
+    return true;
+}
+
+static void jpeg_acquire() {
+    for (mp_uint_t tick_start = mp_hal_ticks_ms(); !jpeg_try_acquire(); ) {
+        if ((mp_hal_ticks_ms() - tick_start) > JPEG_CODEC_TIMEOUT) {
+            mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("JPEG codec busy"));
+        }
+        MICROPY_EVENT_POLL_HOOK
+    }
+}
+
+static void jpeg_release() {
+    JPEG_state.busy = false;
+}
+
+// Returns the size of the APP0 header with cache alignment padding.
+static int jpeg_compress_app0_size() {
+    int app0_size = sizeof(JPEG_APP0);
+    int app0_unalign_size = app0_size % __SCB_DCACHE_LINE_SIZE;
+    int app0_padding_size = app0_unalign_size ? (__SCB_DCACHE_LINE_SIZE - app0_unalign_size) : 0;
+    return app0_size + app0_padding_size;
+}
+
+// Injects the APP0 header in front of the encoded data and returns the final JPEG image size.
+static uint32_t jpeg_compress_finish(uint8_t *data, int app0_total_size) {
+    uint8_t *dma_buffer = data + app0_total_size;
+    int app0_padding_size = app0_total_size - sizeof(JPEG_APP0);
+    uint32_t size = JPEG_state.out_data_len;
+
+    // STM32H7 BUG FIX! The JPEG Encoder will occasionally trigger the EOCF interrupt before writing
+    // a final 0x000000D9 long into the output fifo as the end of the JPEG image. When this occurs
+    // the output fifo will have a single 0 value in it after the encoding process finishes.
+    if (__HAL_JPEG_GET_FLAG(&JPEG_state.jpeg_descr, JPEG_FLAG_OFNEF) && (!JPEG_state.jpeg_descr.Instance->DOR)) {
+        // The encoding output process always aborts before writing JPEG_OUTPUT_CHUNK_SIZE bytes
+        // to the end of the dma_buffer. So, it is always safe to add one extra byte.
+        dma_buffer[size++] = 0xD9;
+    }
+
+    // Update the JPEG image size by the new APP0 header and it's padding. However, we have to move
+    // the SOI header to the front of the image first...
+    size += app0_total_size;
+    memcpy(data, dma_buffer, sizeof(uint16_t)); // move SOI
+    memcpy(data + sizeof(uint16_t), JPEG_APP0, sizeof(JPEG_APP0)); // inject APP0
+
+    // Add on a comment header with 0 padding to ensure cache alignment after the APP0 header.
+    *((uint16_t *) (data + sizeof(uint16_t) + sizeof(JPEG_APP0))) = __REV16(app0_padding_size); // size
+    memset(data + sizeof(uint32_t) + sizeof(JPEG_APP0), 0, app0_padding_size - sizeof(uint16_t)); // data
+
+    // Clean trailing data after 0xFFD9 at the end of the jpeg byte stream.
+    return jpeg_clean_trailing_bytes(size, data);
+}
+
+// Ends the line fed encoder session and passes the JPEG image size to the callback.
+static void jpeg_compress_lines_end(bool overflow) {
+    jpeg_lines_callback_t callback = JPEG_state.lines_callback;
+    uint32_t size = 0;
+
+    if (!callback) {
+        return;
+    }
+
+    JPEG_state.lines_callback = NULL;
+
+    if (!overflow) {
+        size = jpeg_compress_finish(JPEG_state.lines_data, jpeg_compress_app0_size());
+        // The headers were written by the processor and the caller may invalidate the image.
+        SCB_CleanDCache_by_Addr((uint32_t *) JPEG_state.lines_data, size);
+        HAL_JPEG_UnRegisterDataReadyCallback(&JPEG_state.jpeg_descr);
+        HAL_JPEG_UnRegisterGetDataCallback(&JPEG_state.jpeg_descr);
+        HAL_JPEG_UnRegisterCallback(&JPEG_state.jpeg_descr, HAL_JPEG_ENCODE_CPLT_CB_ID);
+    }
+
+    // On overflow the core is left stalled and is aborted by the next user.
+    jpeg_release();
+    callback(size, overflow);
+}
+
 static void jpeg_compress_get_data(JPEG_HandleTypeDef *hjpeg, uint32_t NbDecodedData) {
     HAL_JPEG_Pause(hjpeg, JPEG_PAUSE_RESUME_INPUT);
     JPEG_state.input_paused = true;
 }
 
+static void jpeg_compress_lines_get_data(JPEG_HandleTypeDef *hjpeg, uint32_t NbDecodedData) {
+    int row = ++JPEG_state.rows_done;
+
+    if (row < JPEG_state.rows_queued) {
+        // The next row of MCUs was queued while this one was being read in.
+        HAL_JPEG_ConfigInputBuffer(hjpeg, JPEG_state.mcu_row_buffer +
+                                   (JPEG_state.mcu_row_bytes * (row % JPEG_LINES_MCU_ROWS)),
+                                   JPEG_state.mcu_row_bytes);
+    } else {
+        HAL_JPEG_Pause(hjpeg, JPEG_PAUSE_RESUME_INPUT);
+        JPEG_state.input_paused = true;
+    }
+}
+
+static void jpeg_compress_lines_encode_done(JPEG_HandleTypeDef *hjpeg) {
+    jpeg_compress_lines_end(false);
+}
+
 static void jpeg_compress_data_ready(JPEG_HandleTypeDef *hjpeg, uint8_t *pDataOut, uint32_t OutDataLength) {
     if ((!(((uint32_t) pDataOut) % __SCB_DCACHE_LINE_SIZE)) && (OutDataLength == JPEG_OUTPUT_CHUNK_SIZE)) {
         // Ensure any cached reads are dropped.
@@ -88,6 +215,9 @@ static void jpeg_compress_data_ready(JPEG_HandleTypeDef *hjpeg, uint8_t *pDataOu
         // We will overflow if we receive anymore data.
         HAL_JPEG_Pause(hjpeg, JPEG_PAUSE_RESUME_OUTPUT);
         JPEG_state.output_paused = true;
+
+        // Nothing is going to wait for the line fed encoder to free up space.
+        jpeg_compress_lines_end(true);
     } else {
         uint8_t *new_pDataOut = pDataOut + OutDataLength;
 
@@ -105,38 +235,35 @@ static void jpeg_compress_data_ready(JPEG_HandleTypeDef *hjpeg, uint8_t *pDataOu
     }
 }
 
-bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_subsampling_t subsampling) {
-    OMV_PROFILE_START();
-    HAL_JPEG_RegisterGetDataCallback(&JPEG_state.jpeg_descr, jpeg_compress_get_data);
-    HAL_JPEG_RegisterDataReadyCallback(&JPEG_state.jpeg_descr, jpeg_compress_data_ready);
-
-    int mcu_size = 0;
-    JPEG_ConfTypeDef JPEG_Info;
-    JPEG_Info.ImageWidth = src->w;
-    JPEG_Info.ImageHeight = src->h;
-    JPEG_Info.ImageQuality = quality;
+// Computes the JPEG core configuration and MCU size for src. Returns true if not supported.
+static bool jpeg_compress_config(image_t *src, int quality, jpeg_subsampling_t subsampling,
+                                 JPEG_ConfTypeDef *JPEG_Info, int *mcu_size) {
+    *mcu_size = 0;
+    JPEG_Info->ImageWidth = src->w;
+    JPEG_Info->ImageHeight = src->h;
+    JPEG_Info->ImageQuality = quality;
 
     switch (src->pixfmt) {
         case PIXFORMAT_BINARY:
         case PIXFORMAT_GRAYSCALE:
-            mcu_size = JPEG_444_GS_MCU_SIZE;
-            JPEG_Info.ColorSpace = JPEG_GRAYSCALE_COLORSPACE;
-            JPEG_Info.ChromaSubsampling = JPEG_444_SUBSAMPLING;
+            *mcu_size = JPEG_444_GS_MCU_SIZE;
+            JPEG_Info->ColorSpace = JPEG_GRAYSCALE_COLORSPACE;
+            JPEG_Info->ChromaSubsampling = JPEG_444_SUBSAMPLING;
             break;
         case PIXFORMAT_RGB565:
         case PIXFORMAT_BAYER_ANY:
         case PIXFORMAT_YUV_ANY:
-            mcu_size = JPEG_444_YCBCR_MCU_SIZE;
-            JPEG_Info.ColorSpace = JPEG_YCBCR_COLORSPACE;
-            JPEG_Info.ChromaSubsampling = JPEG_444_SUBSAMPLING;
+            *mcu_size = JPEG_444_YCBCR_MCU_SIZE;
+            JPEG_Info->ColorSpace = JPEG_YCBCR_COLORSPACE;
+            JPEG_Info->ChromaSubsampling = JPEG_444_SUBSAMPLING;
             if (subsampling == JPEG_SUBSAMPLING_AUTO) {
                 if (quality < 60) {
-                    mcu_size = JPEG_422_YCBCR_MCU_SIZE;
-                    JPEG_Info.ChromaSubsampling = JPEG_422_SUBSAMPLING;
+                    *mcu_size = JPEG_422_YCBCR_MCU_SIZE;
+                    JPEG_Info->ChromaSubsampling = JPEG_422_SUBSAMPLING;
                 }
             } else if (subsampling == JPEG_SUBSAMPLING_422) {
-                mcu_size = JPEG_422_YCBCR_MCU_SIZE;
-                JPEG_Info.ChromaSubsampling = JPEG_422_SUBSAMPLING;
+                *mcu_size = JPEG_422_YCBCR_MCU_SIZE;
+                JPEG_Info->ChromaSubsampling = JPEG_422_SUBSAMPLING;
             } else if (subsampling == JPEG_SUBSAMPLING_420) {
                 // not supported
                 return true;
@@ -146,6 +273,111 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
             break;
     }
 
+    return false;
+}
+
+// Converts the MCUs between x_start and x_end of the MCU row at y_offset in src.
+static void jpeg_compress_mcu_row(image_t *src, int y_offset, int dy, uint8_t *mcu_row_buffer_ptr,
+                                  int mcu_size, uint32_t chroma_subsampling, int x_start, int x_end) {
+    if (chroma_subsampling == JPEG_444_SUBSAMPLING) {
+        for (int x_offset = x_start; x_offset < x_end; x_offset += JPEG_MCU_W) {
+            int8_t *Y0 = (int8_t *) (mcu_row_buffer_ptr + (mcu_size * (x_offset / JPEG_MCU_W)));
+            int8_t *CB = Y0 + JPEG_444_GS_MCU_SIZE;
+            int8_t *CR = CB + JPEG_444_GS_MCU_SIZE;
+            int dx = IM_MIN(JPEG_MCU_W, src->w - x_offset);
+
+            // Copy 8x8 MCUs.
+            jpeg_get_mcu(src, x_offset, y_offset, dx, dy, Y0, CB, CR);
+        }
+    } else if (chroma_subsampling == JPEG_422_SUBSAMPLING) {
+        // color only
+        int8_t CB[JPEG_444_GS_MCU_SIZE * 2];
+        int8_t CR[JPEG_444_GS_MCU_SIZE * 2];
+
+        for (int x_offset = x_start; x_offset < x_end; ) {
+            int8_t *Y0 = (int8_t *) (mcu_row_buffer_ptr + (mcu_size * (x_offset / (JPEG_MCU_W * 2))));
+            int8_t *Y1 = Y0 + JPEG_444_GS_MCU_SIZE;
+            int8_t *CB_avg = Y1 + JPEG_444_GS_MCU_SIZE;
+            int8_t *CR_avg = CB_avg + JPEG_444_GS_MCU_SIZE;
+
+            for (int i = 0; i < (JPEG_444_GS_MCU_SIZE * 2);
+                 i += JPEG_444_GS_MCU_SIZE, x_offset += JPEG_MCU_W) {
+                int dx = IM_MIN(JPEG_MCU_W, src->w - x_offset);
+
+                if (dx > 0) {
+                    // Copy 8x8 MCUs.
+                    jpeg_get_mcu(src, x_offset, y_offset, dx, dy, Y0 + i, CB + i, CR + i);
+                } else {
+                    memset(Y0 + i, 0, JPEG_444_GS_MCU_SIZE);
+                    memset(CB + i, 0, JPEG_444_GS_MCU_SIZE);
+                    memset(CR + i, 0, JPEG_444_GS_MCU_SIZE);
+                }
+            }
+
+            // horizontal subsampling of U & V
+            uint32_t mask = 0x80808080;
+            uint32_t *CBp0 = (uint32_t *) CB;
+            uint32_t *CRp0 = (uint32_t *) CR;
+            uint32_t *CBp1 = (uint32_t *) (CB + JPEG_444_GS_MCU_SIZE);
+            uint32_t *CRp1 = (uint32_t *) (CR + JPEG_444_GS_MCU_SIZE);
+            for (int j = 0; j < JPEG_444_GS_MCU_SIZE; j += JPEG_MCU_W) {
+                uint32_t CBp0_3210 = *CBp0++ ^ mask;
+                uint32_t CBp0_avg_32_10 = __SHADD8(CBp0_3210, __UXTB16_RORn(CBp0_3210, 8)) ^ mask;
+                CB_avg[j] = CBp0_avg_32_10;
+                CB_avg[j + 1] = CBp0_avg_32_10 >> 16;
+
+                uint32_t CBp0_7654 = *CBp0++ ^ mask;
+                uint32_t CBp0_avg_76_54 = __SHADD8(CBp0_7654, __UXTB16_RORn(CBp0_7654, 8)) ^ mask;
+                CB_avg[j + 2] = CBp0_avg_76_54;
+                CB_avg[j + 3] = CBp0_avg_76_54 >> 16;
+
+                uint32_t CBp1_3210 = *CBp1++ ^ mask;
+                uint32_t CBp1_avg_32_10 = __SHADD8(CBp1_3210, __UXTB16_RORn(CBp1_3210, 8)) ^ mask;
+                CB_avg[j + 4] = CBp1_avg_32_10;
+                CB_avg[j + 5] = CBp1_avg_32_10 >> 16;
+
+                uint32_t CBp1_7654 = *CBp1++ ^ mask;
+                uint32_t CBp1_avg_76_54 = __SHADD8(CBp1_7654, __UXTB16_RORn(CBp1_7654, 8)) ^ mask;
+                CB_avg[j + 6] = CBp1_avg_76_54;
+                CB_avg[j + 7] = CBp1_avg_76_54 >> 16;
+
+                uint32_t CRp0_3210 = *CRp0++ ^ mask;
+                uint32_t CRp0_avg_32_10 = __SHADD8(CRp0_3210, __UXTB16_RORn(CRp0_3210, 8)) ^ mask;
+                CR_avg[j] = CRp0_avg_32_10;
+                CR_avg[j + 1] = CRp0_avg_32_10 >> 16;
+
+                uint32_t CRp0_7654 = *CRp0++ ^ mask;
+                uint32_t CRp0_avg_76_54 = __SHADD8(CRp0_7654, __UXTB16_RORn(CRp0_7654, 8)) ^ mask;
+                CR_avg[j + 2] = CRp0_avg_76_54;
+                CR_avg[j + 3] = CRp0_avg_76_54 >> 16;
+
+                uint32_t CRp1_3210 = *CRp1++ ^ mask;
+                uint32_t CRp1_avg_32_10 = __SHADD8(CRp1_3210, __UXTB16_RORn(CRp1_3210, 8)) ^ mask;
+                CR_avg[j + 4] = CRp1_avg_32_10;
+                CR_avg[j + 5] = CRp1_avg_32_10 >> 16;
+
+                uint32_t CRp1_7654 = *CRp1++ ^ mask;
+                uint32_t CRp1_avg_76_54 = __SHADD8(CRp1_7654, __UXTB16_RORn(CRp1_7654, 8)) ^ mask;
+                CR_avg[j + 6] = CRp1_avg_76_54;
+                CR_avg[j + 7] = CRp1_avg_76_54 >> 16;
+            }
+        }
+    }
+
+}
+
+static bool jpeg_compress_locked(image_t *src, image_t *dst, int quality, bool realloc, jpeg_subsampling_t subsampling) {
+    OMV_PROFILE_START(jpeg_compress);
+    HAL_JPEG_RegisterGetDataCallback(&JPEG_state.jpeg_descr, jpeg_compress_get_data);
+    HAL_JPEG_RegisterDataReadyCallback(&JPEG_state.jpeg_descr, jpeg_compress_data_ready);
+
+    int mcu_size = 0;
+    JPEG_ConfTypeDef JPEG_Info;
+
+    if (jpeg_compress_config(src, quality, subsampling, &JPEG_Info, &mcu_size)) {
+        return true;
+    }
+
     if (memcmp(&JPEG_state.jpeg_descr.Conf, &JPEG_Info, sizeof(JPEG_ConfTypeDef))) {
         HAL_JPEG_ConfigEncoding(&JPEG_state.jpeg_descr, &JPEG_Info);
     }
@@ -174,10 +406,7 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
     }
 
     // Compute size of the APP0 header with cache alignment padding.
-    int app0_size = sizeof(JPEG_APP0);
-    int app0_unalign_size = app0_size % __SCB_DCACHE_LINE_SIZE;
-    int app0_padding_size = app0_unalign_size ? (__SCB_DCACHE_LINE_SIZE - app0_unalign_size) : 0;
-    int app0_total_size = app0_size + app0_padding_size;
+    int app0_total_size = jpeg_compress_app0_size();
 
     if (dst->size < app0_total_size) {
         return true; // overflow
@@ -205,90 +434,8 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
         uint8_t *mcu_row_buffer_ptr = mcu_row_buffer + (src_w_mcus_bytes * ((y_offset / JPEG_MCU_H) % 2));
         int dy = IM_MIN(JPEG_MCU_H, src->h - y_offset);
 
-        if (JPEG_Info.ChromaSubsampling == JPEG_444_SUBSAMPLING) {
-            for (int x_offset = 0; x_offset < src->w; x_offset += JPEG_MCU_W) {
-                int8_t *Y0 = (int8_t *) (mcu_row_buffer_ptr + (mcu_size * (x_offset / JPEG_MCU_W)));
-                int8_t *CB = Y0 + JPEG_444_GS_MCU_SIZE;
-                int8_t *CR = CB + JPEG_444_GS_MCU_SIZE;
-                int dx = IM_MIN(JPEG_MCU_W, src->w - x_offset);
-
-                // Copy 8x8 MCUs.
-                jpeg_get_mcu(src, x_offset, y_offset, dx, dy, Y0, CB, CR);
-            }
-        } else if (JPEG_Info.ChromaSubsampling == JPEG_422_SUBSAMPLING) {
-            // color only
-            int8_t CB[JPEG_444_GS_MCU_SIZE * 2];
-            int8_t CR[JPEG_444_GS_MCU_SIZE * 2];
-
-            for (int x_offset = 0; x_offset < src->w; ) {
-                int8_t *Y0 = (int8_t *) (mcu_row_buffer_ptr + (mcu_size * (x_offset / (JPEG_MCU_W * 2))));
-                int8_t *Y1 = Y0 + JPEG_444_GS_MCU_SIZE;
-                int8_t *CB_avg = Y1 + JPEG_444_GS_MCU_SIZE;
-                int8_t *CR_avg = CB_avg + JPEG_444_GS_MCU_SIZE;
-
-                for (int i = 0; i < (JPEG_444_GS_MCU_SIZE * 2);
-                     i += JPEG_444_GS_MCU_SIZE, x_offset += JPEG_MCU_W) {
-                    int dx = IM_MIN(JPEG_MCU_W, src->w - x_offset);
-
-                    if (dx > 0) {
-                        // Copy 8x8 MCUs.
-                        jpeg_get_mcu(src, x_offset, y_offset, dx, dy, Y0 + i, CB + i, CR + i);
-                    } else {
-                        memset(Y0 + i, 0, JPEG_444_GS_MCU_SIZE);
-                        memset(CB + i, 0, JPEG_444_GS_MCU_SIZE);
-                        memset(CR + i, 0, JPEG_444_GS_MCU_SIZE);
-                    }
-                }
-
-                // horizontal subsampling of U & V
-                uint32_t mask = 0x80808080;
-                uint32_t *CBp0 = (uint32_t *) CB;
-                uint32_t *CRp0 = (uint32_t *) CR;
-                uint32_t *CBp1 = (uint32_t *) (CB + JPEG_444_GS_MCU_SIZE);
-                uint32_t *CRp1 = (uint32_t *) (CR + JPEG_444_GS_MCU_SIZE);
-                for (int j = 0; j < JPEG_444_GS_MCU_SIZE; j += JPEG_MCU_W) {
-                    uint32_t CBp0_3210 = *CBp0++ ^ mask;
-                    uint32_t CBp0_avg_32_10 = __SHADD8(CBp0_3210, __UXTB16_RORn(CBp0_3210, 8)) ^ mask;
-                    CB_avg[j] = CBp0_avg_32_10;
-                    CB_avg[j + 1] = CBp0_avg_32_10 >> 16;
-
-                    uint32_t CBp0_7654 = *CBp0++ ^ mask;
-                    uint32_t CBp0_avg_76_54 = __SHADD8(CBp0_7654, __UXTB16_RORn(CBp0_7654, 8)) ^ mask;
-                    CB_avg[j + 2] = CBp0_avg_76_54;
-                    CB_avg[j + 3] = CBp0_avg_76_54 >> 16;
-
-                    uint32_t CBp1_3210 = *CBp1++ ^ mask;
-                    uint32_t CBp1_avg_32_10 = __SHADD8(CBp1_3210, __UXTB16_RORn(CBp1_3210, 8)) ^ mask;
-                    CB_avg[j + 4] = CBp1_avg_32_10;
-                    CB_avg[j + 5] = CBp1_avg_32_10 >> 16;
-
-                    uint32_t CBp1_7654 = *CBp1++ ^ mask;
-                    uint32_t CBp1_avg_76_54 = __SHADD8(CBp1_7654, __UXTB16_RORn(CBp1_7654, 8)) ^ mask;
-                    CB_avg[j + 6] = CBp1_avg_76_54;
-                    CB_avg[j + 7] = CBp1_avg_76_54 >> 16;
-
-                    uint32_t CRp0_3210 = *CRp0++ ^ mask;
-                    uint32_t CRp0_avg_32_10 = __SHADD8(CRp0_3210, __UXTB16_RORn(CRp0_3210, 8)) ^ mask;
-                    CR_avg[j] = CRp0_avg_32_10;
-                    CR_avg[j + 1] = CRp0_avg_32_10 >> 16;
-
-                    uint32_t CRp0_7654 = *CRp0++ ^ mask;
-                    uint32_t CRp0_avg_76_54 = __SHADD8(CRp0_7654, __UXTB16_RORn(CRp0_7654, 8)) ^ mask;
-                    CR_avg[j + 2] = CRp0_avg_76_54;
-                    CR_avg[j + 3] = CRp0_avg_76_54 >> 16;
-
-                    uint32_t CRp1_3210 = *CRp1++ ^ mask;
-                    uint32_t CRp1_avg_32_10 = __SHADD8(CRp1_3210, __UXTB16_RORn(CRp1_3210, 8)) ^ mask;
-                    CR_avg[j + 4] = CRp1_avg_32_10;
-                    CR_avg[j + 5] = CRp1_avg_32_10 >> 16;
-
-                    uint32_t CRp1_7654 = *CRp1++ ^ mask;
-                    uint32_t CRp1_avg_76_54 = __SHADD8(CRp1_7654, __UXTB16_RORn(CRp1_7654, 8)) ^ mask;
-                    CR_avg[j + 6] = CRp1_avg_76_54;
-                    CR_avg[j + 7] = CRp1_avg_76_54 >> 16;
-                }
-            }
-        }
+        jpeg_compress_mcu_row(src, y_offset, dy, mcu_row_buffer_ptr, mcu_size,
+                              JPEG_Info.ChromaSubsampling, 0, src->w);
 
         // Flush the MCU row for DMA...
         SCB_CleanDCache_by_Addr((uint32_t *) mcu_row_buffer_ptr, src_w_mcus_bytes);
@@ -333,29 +480,7 @@ bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_s
     }
 
     // Set output size.
-    dst->size = JPEG_state.out_data_len;
-
-    // STM32H7 BUG FIX! The JPEG Encoder will occasionally trigger the EOCF interrupt before writing
-    // a final 0x000000D9 long into the output fifo as the end of the JPEG image. When this occurs
-    // the output fifo will have a single 0 value in it after the encoding process finishes.
-    if (__HAL_JPEG_GET_FLAG(&JPEG_state.jpeg_descr, JPEG_FLAG_OFNEF) && (!JPEG_state.jpeg_descr.Instance->DOR)) {
-        // The encoding output process always aborts before writing JPEG_OUTPUT_CHUNK_SIZE bytes
-        // to the end of the dma_buffer. So, it is always safe to add one extra byte.
-        dma_buffer[dst->size++] = 0xD9;
-    }
-
-    // Update the JPEG image size by the new APP0 header and it's padding. However, we have to move
-    // the SOI header to the front of the image first...
-    dst->size += app0_total_size;
-    memcpy(dst->data, dma_buffer, sizeof(uint16_t)); // move SOI
-    memcpy(dst->data + sizeof(uint16_t), JPEG_APP0, sizeof(JPEG_APP0)); // inject APP0
-
-    // Add on a comment header with 0 padding to ensure cache alignment after the APP0 header.
-    *((uint16_t *) (dst->data + sizeof(uint16_t) + sizeof(JPEG_APP0))) = __REV16(app0_padding_size); // size
-    memset(dst->data + sizeof(uint32_t) + sizeof(JPEG_APP0), 0, app0_padding_size - sizeof(uint16_t)); // data
-
-    // Clean trailing data after 0xFFD9 at the end of the jpeg byte stream.
-    dst->size = jpeg_clean_trailing_bytes(dst->size, dst->data);
+    dst->size = jpeg_compress_finish(dst->data, app0_total_size);
 
 exit_cleanup:
     // Cleanup jpeg state.
@@ -365,10 +490,181 @@ exit_cleanup:
 
     fb_free(); // mcu_row_buffer (after DMA is aborted)
 
-    OMV_PROFILE_PRINT();
+    OMV_PROFILE_END(jpeg_compress);
     return jpeg_overflow;
 }
 
+bool jpeg_compress(image_t *src, image_t *dst, int quality, bool realloc, jpeg_subsampling_t subsampling) {
+    jpeg_acquire();
+
+    nlr_buf_t nlr;
+    bool overflow = true;
+
+    if (nlr_push(&nlr) == 0) {
+        overflow = jpeg_compress_locked(src, dst, quality, realloc, subsampling);
+        nlr_pop();
+    } else {
+        // Release the core if compression was interrupted.
+        HAL_JPEG_Abort(&JPEG_state.jpeg_descr);
+        jpeg_release();
+        nlr_jump(nlr.ret_val);
+    }
+
+    jpeg_release();
+    return overflow;
+}
+
+bool jpeg_compress_stream(image_t *src, int quality, jpeg_subsampling_t subsampling,
+                          uint8_t *buf, uint32_t size, jpeg_stream_callback_t callback, void *arg) {
+    if (src->is_compressed || (size < JPEG_STREAM_BUFFER_MIN)) {
+        return true;
+    }
+
+    // The JPEG core doesn't emit restart markers, so the image is compressed into the
+    // frame buffer first and then handed to the callback in chunks of the buffer size
+    // straight from there (buf is only needed by the software encoder).
+    fb_alloc_mark();
+
+    image_t dst = {
+        .w = src->w,
+        .h = src->h,
+        .pixfmt = PIXFORMAT_JPEG,
+        .size = 0,
+        .data = NULL,
+    };
+
+    bool overflow = jpeg_compress(src, &dst, quality, false, subsampling);
+
+    for (uint32_t i = 0; (!overflow) && (i < dst.size); i += size) {
+        overflow = !callback(arg, dst.data + i, IM_MIN(size, dst.size - i));
+    }
+
+    fb_alloc_free_till_mark();
+    return overflow;
+}
+
+size_t jpeg_compress_lines_buffer_size(image_t *src, int quality) {
+    int mcu_size = 0;
+    JPEG_ConfTypeDef JPEG_Info;
+
+    if (jpeg_compress_config(src, quality, JPEG_SUBSAMPLING_AUTO, &JPEG_Info, &mcu_size)) {
+        return 0;
+    }
+
+    int mcu_w = (JPEG_Info.ChromaSubsampling == JPEG_444_SUBSAMPLING) ? JPEG_MCU_W : (JPEG_MCU_W * 2);
+    return ((src->w + mcu_w - 1) / mcu_w) * mcu_size * JPEG_LINES_MCU_ROWS;
+}
+
+bool jpeg_compress_lines_start(image_t *src, image_t *dst, int quality, uint8_t *buffer,
+                               jpeg_lines_callback_t callback) {
+    int app0_total_size = jpeg_compress_app0_size();
+    JPEG_ConfTypeDef JPEG_Info;
+    int mcu_size = 0;
+
+    // Destination is too small.
+    if ((dst->size < (app0_total_size + (JPEG_OUTPUT_CHUNK_SIZE * 2)))
+        || jpeg_compress_config(src, quality, JPEG_SUBSAMPLING_AUTO, &JPEG_Info, &mcu_size)
+        || (!jpeg_try_acquire())) {
+        return true;
+    }
+
+    if (memcmp(&JPEG_state.jpeg_descr.Conf, &JPEG_Info, sizeof(JPEG_ConfTypeDef))) {
+        HAL_JPEG_ConfigEncoding(&JPEG_state.jpeg_descr, &JPEG_Info);
+    }
+
+    HAL_JPEG_RegisterGetDataCallback(&JPEG_state.jpeg_descr, jpeg_compress_lines_get_data);
+    HAL_JPEG_RegisterDataReadyCallback(&JPEG_state.jpeg_descr, jpeg_compress_data_ready);
+    HAL_JPEG_RegisterCallback(&JPEG_state.jpeg_descr, HAL_JPEG_ENCODE_CPLT_CB_ID, jpeg_compress_lines_encode_done);
+
+    int mcu_w = (JPEG_Info.ChromaSubsampling == JPEG_444_SUBSAMPLING) ? JPEG_MCU_W : (JPEG_MCU_W * 2);
+    JPEG_state.mcu_size = mcu_size;
+    JPEG_state.mcu_row_bytes = ((src->w + mcu_w - 1) / mcu_w) * mcu_size;
+    JPEG_state.mcu_row_buffer = buffer;
+    JPEG_state.lines_data = dst->data;
+    JPEG_state.w = src->w;
+    JPEG_state.h = src->h;
+    JPEG_state.rows_queued = 0;
+    JPEG_state.rows_done = 0;
+    JPEG_state.out_data_len_max = dst->size - app0_total_size;
+    JPEG_state.out_data_len = 0;
+    JPEG_state.input_paused = false;
+    JPEG_state.output_paused = false;
+    JPEG_state.lines_callback = callback;
+    return false;
+}
+
+bool jpeg_compress_lines_put(image_t *strip, int y_offset, int part, int parts) {
+    // The session ended early because the output overflowed.
+    if (!JPEG_state.lines_callback) {
+        return true;
+    }
+
+    int row = y_offset / JPEG_MCU_H;
+
+    // The JPEG core fell behind and has not read in the row that used this buffer yet.
+    if ((row - JPEG_state.rows_done) >= JPEG_LINES_MCU_ROWS) {
+        return true;
+    }
+
+    uint32_t chroma_subsampling = JPEG_state.jpeg_descr.Conf.ChromaSubsampling;
+    int mcu_w = (chroma_subsampling == JPEG_444_SUBSAMPLING) ? JPEG_MCU_W : (JPEG_MCU_W * 2);
+    int w_mcus = (JPEG_state.w + mcu_w - 1) / mcu_w;
+    int x_start = ((w_mcus * part) / parts) * mcu_w;
+    int x_end = IM_MIN(((w_mcus * (part + 1)) / parts) * mcu_w, JPEG_state.w);
+    uint8_t *mcu_row_buffer_ptr = JPEG_state.mcu_row_buffer +
+                                  (JPEG_state.mcu_row_bytes * (row % JPEG_LINES_MCU_ROWS));
+
+    jpeg_compress_mcu_row(strip, 0, IM_MIN(JPEG_MCU_H, JPEG_state.h - y_offset), mcu_row_buffer_ptr,
+                          JPEG_state.mcu_size, chroma_subsampling, x_start, x_end);
+
+    if (part != (parts - 1)) {
+        return false;
+    }
+
+    // Flush the MCU row for DMA...
+    SCB_CleanDCache_by_Addr((uint32_t *) mcu_row_buffer_ptr, JPEG_state.mcu_row_bytes);
+
+    if (!row) {
+        uint8_t *dma_buffer = JPEG_state.lines_data + jpeg_compress_app0_size();
+        JPEG_state.rows_queued = 1;
+        // Invalidate the output buffer.
+        SCB_InvalidateDCache_by_Addr(dma_buffer, JPEG_OUTPUT_CHUNK_SIZE);
+        // Start the DMA process off on the first row of MCUs.
+        HAL_JPEG_Encode_DMA(&JPEG_state.jpeg_descr, mcu_row_buffer_ptr, JPEG_state.mcu_row_bytes, dma_buffer,
+                            JPEG_OUTPUT_CHUNK_SIZE);
+    } else {
+        mp_uint_t irq_state = disable_irq();
+        JPEG_state.rows_queued = row + 1;
+
+        // If the core already read in all previous rows restart it on this one. Otherwise, it's
+        // picked up when the core is done reading in the previous row.
+        if (JPEG_state.input_paused) {
+            JPEG_state.input_paused = false;
+            HAL_JPEG_ConfigInputBuffer(&JPEG_state.jpeg_descr, mcu_row_buffer_ptr, JPEG_state.mcu_row_bytes);
+            HAL_JPEG_Resume(&JPEG_state.jpeg_descr, JPEG_PAUSE_RESUME_INPUT);
+        }
+
+        enable_irq(irq_state);
+    }
+
+    return false;
+}
+
+void jpeg_compress_lines_abort() {
+    mp_uint_t irq_state = disable_irq();
+    bool active = JPEG_state.lines_callback != NULL;
+    JPEG_state.lines_callback = NULL;
+    enable_irq(irq_state);
+
+    if (active) {
+        HAL_JPEG_Abort(&JPEG_state.jpeg_descr);
+        HAL_JPEG_UnRegisterDataReadyCallback(&JPEG_state.jpeg_descr);
+        HAL_JPEG_UnRegisterGetDataCallback(&JPEG_state.jpeg_descr);
+        HAL_JPEG_UnRegisterCallback(&JPEG_state.jpeg_descr, HAL_JPEG_ENCODE_CPLT_CB_ID);
+        jpeg_release();
+    }
+}
+
 static void jpeg_decompress_data_ready_abort(JPEG_HandleTypeDef *hjpeg, uint8_t *pDataOut, uint32_t OutDataLength) {
     HAL_JPEG_Abort(hjpeg);
 }
@@ -396,8 +692,8 @@ static void jpeg_decompress_data_ready(JPEG_HandleTypeDef *hjpeg, uint8_t *pData
     }
 }
 
-void jpeg_decompress(image_t *dst, image_t *src) {
-    OMV_PROFILE_START();
+static void jpeg_decompress_locked(image_t *dst, image_t *src) {
+    OMV_PROFILE_START(jpeg_decompress);
 
     // Verify the jpeg image is not a non-baseline jpeg image and check that is has
     // valid headers up to the start-of-scan header (which cannot be trivially walked).
@@ -752,7 +1048,51 @@ exit_cleanup:
         fb_free(); // JPEG_state.jpeg_descr.pJpegInBuffPtr (after DMA is aborted)
     }
 
-    OMV_PROFILE_PRINT();
+    OMV_PROFILE_END(jpeg_decompress);
+}
+
+void jpeg_decompress(image_t *dst, image_t *src) {
+    jpeg_acquire();
+
+    nlr_buf_t nlr;
+
+    if (nlr_push(&nlr) == 0) {
+        jpeg_decompress_locked(dst, src);
+        nlr_pop();
+    } else {
+        // Release the core if decompression was interrupted.
+        HAL_JPEG_Abort(&JPEG_state.jpeg_descr);
+        jpeg_release();
+        nlr_jump(nlr.ret_val);
+    }
+
+    jpeg_release();
+}
+
+void jpeg_decompress_roi(image_t *dst, image_t *src, rectangle_t *roi, int scale) {
+    rectangle_t bounds = {0, 0, src->w, src->h};
+
+    if (!roi) {
+        roi = &bounds;
+    }
+
+    // The JPEG core always outputs the whole frame, so decode it into the frame buffer
+    // and then crop and area scale it down into the destination.
+    fb_alloc_mark();
+
+    image_t temp = {
+        .w = src->w,
+        .h = src->h,
+        .pixfmt = dst->pixfmt,
+    };
+
+    temp.data = fb_alloc(image_size(&temp), FB_ALLOC_PREFER_SIZE | FB_ALLOC_CACHE_ALIGN);
+    jpeg_decompress(&temp, src);
+
+    imlib_draw_image(dst, &temp, 0, 0, 1.0f / scale, 1.0f / scale, roi, -1, 256, NULL, NULL,
+                     IMAGE_HINT_AREA | IMAGE_HINT_BLACK_BACKGROUND, NULL, NULL, NULL);
+
+    fb_alloc_free_till_mark();
 }
 
 void imlib_hardware_jpeg_init() {
@@ -68,12 +68,17 @@
 
 #include "py_image.h"
 #include "py_fir.h"
+#include "py_tof.h"
 #include "py_tv.h"
 #include "py_buzzer.h"
 #include "py_imu.h"
+#include "py_cpufreq.h"
+#include "axiqos.h"
 #include "py_audio.h"
 
 #include "framebuffer.h"
+#include "omv_task.h"
+#include "probe.h"
 
 #include "ini.h"
 #include "omv_boardconfig.h"
@@ -259,6 +264,8 @@ int main(void) {
     __enable_irq();
 
 soft_reset:
+    boot_timeline_reset();
+
     #if defined(MICROPY_HW_LED4)
     led_state(LED_IR, 0);
     #endif
@@ -278,10 +285,18 @@ soft_reset:
 
     // Micro Python init
     mp_init();
+    OMV_BOOT_MARK(runtime);
 
     // Initialise low-level sub-systems. Here we need to do the very basic
     // things like zeroing out memory and resetting any of the sub-systems.
     py_fir_init0();
+    #if MICROPY_PY_TOF
+    py_tof_init0();
+    #endif
+    py_cpufreq_init0();
+    #if defined(MCU_SERIES_H7)
+    axiqos_init0();
+    #endif
     #if MICROPY_PY_TV
     py_tv_init0();
     #endif
@@ -300,6 +315,7 @@ soft_reset:
     spi_init0();
     uart_init0();
     fb_alloc_init0();
+    omv_task_init0();
     omv_gpio_init0();
     framebuffer_init0();
     sensor_init0();
@@ -315,6 +331,8 @@ soft_reset:
     sdcard_init();
     #endif
     rtc_init_start(false);
+    OMV_BOOT_MARK(peripherals);
+
     #if MICROPY_PY_LWIP
     // lwIP can only be initialized once, because the system timeout
     // list (next_timeout), is only ever reset by BSS clearing.
@@ -343,12 +361,14 @@ soft_reset:
 
     pyb_usb_init0();
     MP_STATE_PORT(pyb_stdio_uart) = NULL;
+    OMV_BOOT_MARK(network);
 
     // Initialize the sensor and check the result after
     // mounting the file-system to log errors (if any).
     if (first_soft_reset) {
         sensor_init();
     }
+    OMV_BOOT_MARK(sensor);
 
     #if MICROPY_PY_IMU
     py_imu_init();
@@ -426,6 +446,7 @@ else {
     vfs->next = NULL;
     MP_STATE_VM(vfs_mount_table) = vfs;
     MP_STATE_PORT(vfs_cur) = vfs;
+    OMV_BOOT_MARK(storage);
 
     // Mark the filesystem as an OpenMV storage.
     file_ll_touch("/.openmv_disk");
@@ -462,7 +483,7 @@ else {
     led_state(LED_RED, 0);
     led_state(LED_GREEN, 0);
     led_state(LED_BLUE, 0);
-
+    OMV_BOOT_MARK(config);
 
     // Run boot.py script.
     bool interrupted = mp_exec_bootscript("boot.py", true, false);
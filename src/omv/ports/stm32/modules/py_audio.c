@@ -25,6 +25,8 @@
 #include "omv_boardconfig.h"
 #include "omv_common.h"
 #include "dma_utils.h"
+#include "dma_alloc.h"
+#include "audio_frontend.h"
 
 #if MICROPY_PY_AUDIO
 
@@ -34,17 +36,19 @@ static SAI_HandleTypeDef hsai;
 static DMA_HandleTypeDef hdma_sai_rx;
 static PDM_Filter_Config_t PDM_FilterConfig[OMV_AUDIO_MAX_CHANNELS];
 static PDM_Filter_Handler_t PDM_FilterHandler[OMV_AUDIO_MAX_CHANNELS];
-// NOTE: BDMA can only access D3 SRAM4 memory.
+// NOTE: BDMA can only access D3 SRAM4 memory, allocated from the D3 DMA pool.
 #define PDM_BUFFER_SIZE      (16384)
-uint8_t OMV_ATTR_SECTION(OMV_ATTR_ALIGNED(PDM_BUFFER[PDM_BUFFER_SIZE], 32), ".d3_dma_buffer");
+#define PDM_BUFFER_PERIPH    (OMV_SAI)
+static uint8_t *PDM_BUFFER = NULL;
 #elif defined(OMV_DFSDM)
 static DFSDM_Channel_HandleTypeDef hdfsdm;
 // NOTE: Only 1 filter is supported right now.
 static DFSDM_Filter_HandleTypeDef hdfsdm_filter[OMV_AUDIO_MAX_CHANNELS];
 static DMA_HandleTypeDef hdma_filter[OMV_AUDIO_MAX_CHANNELS];
-// NOTE: placed in D2 memory.
+// NOTE: allocated from the D2 DMA pool.
 #define PDM_BUFFER_SIZE      (512 * 2)
-int32_t OMV_ATTR_SECTION(OMV_ATTR_ALIGNED(PDM_BUFFER[PDM_BUFFER_SIZE], 32), ".d2_dma_buffer");
+#define PDM_BUFFER_PERIPH    (OMV_DFSDM)
+static int32_t *PDM_BUFFER = NULL;
 #define DFSDM_GAIN_FRAC_BITS (3)
 static int32_t dfsdm_gain = 1;
 #else
@@ -54,8 +58,20 @@ static int32_t dfsdm_gain = 1;
 static volatile uint32_t xfer_status = 0;
 static int g_channels = OMV_AUDIO_MAX_CHANNELS;
 static uint32_t g_pdm_buffer_size = 0;
+static uint32_t g_samples_per_channel = 0;
+static uint32_t g_frequency = 0;
 static mp_sched_node_t audio_task_sched_node;
 
+// PCM blocks are converted in the DMA IRQ and queued in a single producer/single consumer ring,
+// so the scheduled callback can fall behind by up to n_buffers - 1 blocks without dropping samples.
+static uint32_t pcm_n_buffers = 0;
+static volatile uint32_t pcm_head = 0;
+static volatile uint32_t pcm_tail = 0;
+static volatile bool pcm_overflow = false;
+
+#define PCM_DEFAULT_BUFFERS        (8)
+#define NEXT_BUFFER(x)             (((x) + 1) % pcm_n_buffers)
+
 #define DMA_XFER_NONE              (0x00U)
 #define DMA_XFER_HALF              (0x01U)
 #define DMA_XFER_FULL              (0x04U)
@@ -74,6 +90,30 @@ void OMV_DFSDM_FLT0_IRQHandler() {
 }
 #endif  // defined(OMV_SAI)
 
+// Converts the PDM samples at offset into the PCM block at the tail of the ring.
+static void audio_pdm_to_pcm(uint32_t offset) {
+    int16_t *pcmbuf = &MP_STATE_PORT(audio_pcm_buffer)[pcm_tail * g_samples_per_channel * g_channels];
+
+    #if defined(OMV_SAI)
+    for (int i = 0; i < g_channels; i++) {
+        PDM_Filter(&((uint8_t *) PDM_BUFFER)[offset + i], &pcmbuf[i], &PDM_FilterHandler[i]);
+    }
+    #elif defined(OMV_DFSDM)
+    for (int i = 0; i < g_pdm_buffer_size / 2; i++) {
+        pcmbuf[i] = __SSAT_ASR((PDM_BUFFER[offset + i] >> 8) * dfsdm_gain, 16, DFSDM_GAIN_FRAC_BITS);
+    }
+    #endif
+
+    if (NEXT_BUFFER(pcm_tail) != pcm_head) {
+        pcm_tail = NEXT_BUFFER(pcm_tail);
+    } else {
+        // Keep overwriting the last block until the callback catches up.
+        pcm_overflow = true;
+    }
+
+    mp_sched_schedule_node(&audio_task_sched_node, audio_task_callback);
+}
+
 #if defined(OMV_SAI)
 void HAL_SAI_RxHalfCpltCallback(SAI_HandleTypeDef *hsai)
 #elif defined(OMV_DFSDM)
@@ -84,7 +124,7 @@ void HAL_DFSDM_FilterRegConvHalfCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_
     uint32_t pdm_buffer_size_bytes = (sizeof(PDM_BUFFER[0]) * g_pdm_buffer_size);
     SCB_InvalidateDCache_by_Addr((uint32_t *) (&PDM_BUFFER[0]), pdm_buffer_size_bytes);
     if (MP_STATE_PORT(audio_callback) != mp_const_none) {
-        mp_sched_schedule_node(&audio_task_sched_node, audio_task_callback);
+        audio_pdm_to_pcm(0);
     }
 }
 
@@ -98,7 +138,7 @@ void HAL_DFSDM_FilterRegConvCpltCallback(DFSDM_Filter_HandleTypeDef *hdfsdm_filt
     uint32_t pdm_buffer_size_bytes = (sizeof(PDM_BUFFER[0]) * g_pdm_buffer_size);
     SCB_InvalidateDCache_by_Addr((uint32_t *) (&PDM_BUFFER[g_pdm_buffer_size]), pdm_buffer_size_bytes / 2);
     if (MP_STATE_PORT(audio_callback) != mp_const_none) {
-        mp_sched_schedule_node(&audio_task_sched_node, audio_task_callback);
+        audio_pdm_to_pcm(g_pdm_buffer_size / 2);
     }
 }
 
@@ -118,13 +158,14 @@ static uint32_t get_decimation_factor(uint32_t decimation) {
 #endif
 
 static mp_obj_t py_audio_init(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
-    enum { ARG_channels, ARG_frequency, ARG_gain_db, ARG_highpass, ARG_samples };
+    enum { ARG_channels, ARG_frequency, ARG_gain_db, ARG_highpass, ARG_samples, ARG_buffers };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_channels, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = OMV_AUDIO_MAX_CHANNELS } },
         { MP_QSTR_frequency, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 16000 } },
         { MP_QSTR_gain_db, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 24 } },
         { MP_QSTR_highpass, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
         { MP_QSTR_samples, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = -1 } },
+        { MP_QSTR_buffers, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = PCM_DEFAULT_BUFFERS } },
     };
 
     // Parse args.
@@ -148,9 +189,18 @@ static mp_obj_t py_audio_init(uint n_args, const mp_obj_t *pos_args, mp_map_t *k
         RAISE_OS_EXCEPTION("Invalid number of channels!");
     }
 
+    if (args[ARG_buffers].u_int < 2) {
+        RAISE_OS_EXCEPTION("Invalid number of buffers!");
+    }
+
     // Default/max PDM buffer size;
     g_pdm_buffer_size = PDM_BUFFER_SIZE;
 
+    // The buffer is kept until deinit, so init can be called again.
+    if (PDM_BUFFER == NULL) {
+        PDM_BUFFER = dma_alloc(PDM_BUFFER_SIZE * sizeof(PDM_BUFFER[0]), PDM_BUFFER_PERIPH);
+    }
+
     #if defined(OMV_DFSDM)
     uint32_t samples_per_channel = PDM_BUFFER_SIZE / 2; // Half a transfer
     dfsdm_gain = __USAT(fast_roundf(expf((gain_db / 20.0f) * M_LN10) * (1 << DFSDM_GAIN_FRAC_BITS)), 15);
@@ -356,8 +406,15 @@ static mp_obj_t py_audio_init(uint n_args, const mp_obj_t *pos_args, mp_map_t *k
     HAL_NVIC_EnableIRQ(OMV_DFSDM_FLT0_IRQ);
     #endif  // defined(OMV_SAI)
 
-    // Allocate global PCM buffer.
-    MP_STATE_PORT(audio_pcm_buffer) = m_new(int16_t, samples_per_channel * g_channels);
+    g_samples_per_channel = samples_per_channel;
+    g_frequency = frequency;
+
+    // Allocate the PCM ring. To avoid copies, the same bytearray is passed to the callback and
+    // pointed to the block being consumed.
+    pcm_n_buffers = args[ARG_buffers].u_int;
+    pcm_head = pcm_tail = 0;
+    pcm_overflow = false;
+    MP_STATE_PORT(audio_pcm_buffer) = m_new(int16_t, pcm_n_buffers * samples_per_channel * g_channels);
     MP_STATE_PORT(audio_pcm_array) = mp_obj_new_bytearray_by_ref(samples_per_channel * g_channels * sizeof(int16_t),
                                                                  MP_STATE_PORT(audio_pcm_buffer));
 
@@ -404,61 +461,104 @@ void py_audio_deinit() {
     }
     #endif
 
+    dma_alloc_free(PDM_BUFFER);
+    PDM_BUFFER = NULL;
+
     g_channels = 0;
+    pcm_n_buffers = 0;
+    pcm_head = pcm_tail = 0;
     MP_STATE_PORT(audio_pcm_buffer) = NULL;
     MP_STATE_PORT(audio_pcm_array) = mp_const_none;
     MP_STATE_PORT(audio_callback) = mp_const_none;
+    MP_STATE_PORT(audio_features) = mp_const_none;
+    MP_STATE_PORT(audio_frontend) = NULL;
+}
+
+// Computes a feature frame from the new samples and appends it to the features buffer, which
+// holds the most recent frames in chronological order.
+static mp_obj_t audio_compute_features(int16_t *pcmbuf) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(MP_STATE_PORT(audio_features), &bufinfo, MP_BUFFER_WRITE);
+    int8_t *features = bufinfo.buf;
+
+    memmove(features, features + AUDIO_FRONTEND_CHANNELS, bufinfo.len - AUDIO_FRONTEND_CHANNELS);
+    audio_frontend_process(MP_STATE_PORT(audio_frontend), pcmbuf, g_samples_per_channel,
+                           features + bufinfo.len - AUDIO_FRONTEND_CHANNELS);
+    return MP_STATE_PORT(audio_features);
 }
 
 static void audio_task_callback(mp_sched_node_t *node) {
-    int16_t *pcmbuf = (int16_t *) MP_STATE_PORT(audio_pcm_buffer);
+    if (MP_STATE_PORT(audio_callback) == mp_const_none || pcm_head == pcm_tail) {
+        return;
+    }
 
-    // Check for half transfer complete.
-    if ((xfer_status & DMA_XFER_HALF)) {
-        // Clear buffer state.
-        xfer_status &= ~(DMA_XFER_HALF);
+    int16_t *pcmbuf = &MP_STATE_PORT(audio_pcm_buffer)[pcm_head * g_samples_per_channel * g_channels];
+    mp_obj_t arg = MP_STATE_PORT(audio_pcm_array);
 
-        #if defined(OMV_SAI)
-        // Convert PDM samples to PCM.
-        for (int i = 0; i < g_channels; i++) {
-            PDM_Filter(&((uint8_t *) PDM_BUFFER)[i], &pcmbuf[i], &PDM_FilterHandler[i]);
-        }
-        #elif defined(OMV_DFSDM)
-        for (int i = 0; i < g_pdm_buffer_size / 2; i++) {
-            pcmbuf[i] = __SSAT_ASR((PDM_BUFFER[i] >> 8) * dfsdm_gain, 16, DFSDM_GAIN_FRAC_BITS);
-        }
-        #endif
-    } else if ((xfer_status & DMA_XFER_FULL)) {
-        // Check for transfer complete.
-        // Clear buffer state.
-        xfer_status &= ~(DMA_XFER_FULL);
+    if (MP_STATE_PORT(audio_features) != mp_const_none) {
+        arg = audio_compute_features(pcmbuf);
+    } else {
+        ((mp_obj_array_t *) MP_OBJ_TO_PTR(arg))->items = pcmbuf;
+    }
 
-        #if defined(OMV_SAI)
-        // Convert PDM samples to PCM.
-        for (int i = 0; i < g_channels; i++) {
-            PDM_Filter(&((uint8_t *) PDM_BUFFER)[g_pdm_buffer_size / 2 + i], &pcmbuf[i], &PDM_FilterHandler[i]);
-        }
-        #elif defined(OMV_DFSDM)
-        for (int i = 0; i < g_pdm_buffer_size / 2; i++) {
-            pcmbuf[i] = __SSAT_ASR((PDM_BUFFER[g_pdm_buffer_size / 2 + i] >> 8) * dfsdm_gain, 16, DFSDM_GAIN_FRAC_BITS);
-        }
-        #endif
+    // Advance head to next buffer, the block is not reused until the ring wraps around.
+    pcm_head = NEXT_BUFFER(pcm_head);
+
+    // Re-schedule for the blocks queued while the callback was busy.
+    if (pcm_head != pcm_tail) {
+        mp_sched_schedule_node(&audio_task_sched_node, audio_task_callback);
     }
 
     // Call user callback
-    mp_call_function_1(MP_STATE_PORT(audio_callback), MP_STATE_PORT(audio_pcm_array));
+    mp_call_function_1(MP_STATE_PORT(audio_callback), arg);
 }
 
-static mp_obj_t py_audio_start_streaming(mp_obj_t callback_obj) {
+static mp_obj_t py_audio_start_streaming(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_callback, ARG_features };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_callback, MP_ARG_REQUIRED | MP_ARG_OBJ },
+        { MP_QSTR_features, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+    };
+
+    // Parse args.
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    mp_obj_t callback_obj = args[ARG_callback].u_obj;
     if (!mp_obj_is_callable(callback_obj)) {
         RAISE_OS_EXCEPTION("Invalid callback object!");
     }
 
+    // With a features buffer, the PCM samples are converted to log-mel features in C and the
+    // callback is passed the features buffer instead of the PCM samples.
+    mp_obj_t features_obj = args[ARG_features].u_obj;
+    if (features_obj != mp_const_none) {
+        mp_buffer_info_t bufinfo;
+        mp_get_buffer_raise(features_obj, &bufinfo, MP_BUFFER_WRITE);
+        if ((!bufinfo.len) || (bufinfo.len % AUDIO_FRONTEND_CHANNELS)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Features buffer size must be a multiple of FEATURE_CHANNELS"));
+        }
+        if ((g_channels != 1) || (g_frequency != AUDIO_FRONTEND_SAMPLE_RATE)) {
+            mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Features require 1 channel at 16KHz"));
+        }
+        if (MP_STATE_PORT(audio_frontend) == NULL) {
+            MP_STATE_PORT(audio_frontend) = m_new_obj(audio_frontend_t);
+            audio_frontend_init(MP_STATE_PORT(audio_frontend));
+        }
+        audio_frontend_reset(MP_STATE_PORT(audio_frontend));
+    }
+
+    pcm_head = pcm_tail = 0;
+    pcm_overflow = false;
+    MP_STATE_PORT(audio_features) = features_obj;
     MP_STATE_PORT(audio_callback) = callback_obj;
 
     // Clear DMA buffer status
     xfer_status &= DMA_XFER_NONE;
 
+    // Write back any dirty lines before the DMA starts writing to the buffer.
+    dma_alloc_to_device(PDM_BUFFER);
+
     #if defined(OMV_SAI)
     // Start DMA transfer
     if (HAL_SAI_Receive_DMA(&hsai, (uint8_t *) PDM_BUFFER, g_pdm_buffer_size / g_channels) != HAL_OK) {
@@ -474,7 +574,7 @@ static mp_obj_t py_audio_start_streaming(mp_obj_t callback_obj) {
 
     return mp_const_none;
 }
-static MP_DEFINE_CONST_FUN_OBJ_1(py_audio_start_streaming_obj, py_audio_start_streaming);
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_audio_start_streaming_obj, 1, py_audio_start_streaming);
 
 static mp_obj_t py_audio_stop_streaming() {
     #if defined(OMV_SAI)
@@ -487,11 +587,18 @@ static mp_obj_t py_audio_stop_streaming() {
         HAL_DFSDM_FilterRegularStop_DMA(&hdfsdm_filter[0]);
     }
     #endif
+    dma_alloc_to_cpu(PDM_BUFFER);
     MP_STATE_PORT(audio_callback) = mp_const_none;
+    MP_STATE_PORT(audio_features) = mp_const_none;
     return mp_const_none;
 }
 static MP_DEFINE_CONST_FUN_OBJ_0(py_audio_stop_streaming_obj, py_audio_stop_streaming);
 
+static mp_obj_t py_audio_overflow() {
+    return mp_obj_new_bool(pcm_overflow);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_audio_overflow_obj, py_audio_overflow);
+
 #if defined(OMV_SAI)
 static mp_obj_t py_audio_read_pdm(mp_obj_t buf_in) {
     mp_buffer_info_t pdmbuf;
@@ -509,6 +616,9 @@ static mp_obj_t py_audio_read_pdm(mp_obj_t buf_in) {
     // Clear DMA buffer status
     xfer_status &= DMA_XFER_NONE;
 
+    // Write back any dirty lines before the DMA starts writing to the buffer.
+    dma_alloc_to_device(PDM_BUFFER);
+
     // Start DMA transfer
     if (HAL_SAI_Receive_DMA(&hsai, (uint8_t *) PDM_BUFFER, g_pdm_buffer_size / g_channels) != HAL_OK) {
         RAISE_OS_EXCEPTION("SAI DMA transfer failed!");
@@ -520,6 +630,7 @@ static mp_obj_t py_audio_read_pdm(mp_obj_t buf_in) {
         while ((xfer_status & DMA_XFER_FULL) == 0) {
             if ((HAL_GetTick() - start) >= 1000) {
                 HAL_SAI_DMAStop(&hsai);
+                dma_alloc_to_cpu(PDM_BUFFER);
                 RAISE_OS_EXCEPTION("SAI DMA transfer timeout!");
             }
         }
@@ -541,6 +652,7 @@ static mp_obj_t py_audio_read_pdm(mp_obj_t buf_in) {
 
     // Stop SAI DMA.
     HAL_SAI_DMAStop(&hsai);
+    dma_alloc_to_cpu(PDM_BUFFER);
 
     return mp_const_none;
 }
@@ -552,6 +664,8 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_init),            MP_ROM_PTR(&py_audio_init_obj)           },
     { MP_ROM_QSTR(MP_QSTR_start_streaming), MP_ROM_PTR(&py_audio_start_streaming_obj)},
     { MP_ROM_QSTR(MP_QSTR_stop_streaming),  MP_ROM_PTR(&py_audio_stop_streaming_obj) },
+    { MP_ROM_QSTR(MP_QSTR_overflow),        MP_ROM_PTR(&py_audio_overflow_obj)       },
+    { MP_ROM_QSTR(MP_QSTR_FEATURE_CHANNELS), MP_ROM_INT(AUDIO_FRONTEND_CHANNELS)            },
     #if defined(OMV_SAI)
     { MP_ROM_QSTR(MP_QSTR_read_pdm),        MP_ROM_PTR(&py_audio_read_pdm_obj)       },
     #endif
@@ -567,5 +681,7 @@ const mp_obj_module_t audio_module = {
 MP_REGISTER_ROOT_POINTER(mp_obj_t audio_callback);
 MP_REGISTER_ROOT_POINTER(mp_obj_t audio_pcm_array);
 MP_REGISTER_ROOT_POINTER(int16_t * audio_pcm_buffer);
+MP_REGISTER_ROOT_POINTER(mp_obj_t audio_features);
+MP_REGISTER_ROOT_POINTER(struct audio_frontend *audio_frontend);
 MP_REGISTER_MODULE(MP_QSTR_audio, audio_module);
 #endif //MICROPY_PY_AUDIO
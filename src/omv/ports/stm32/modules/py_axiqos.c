@@ -0,0 +1,70 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * AXI QoS Python module.
+ */
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "omv_boardconfig.h"
+
+#if defined(MCU_SERIES_H7)
+#include "axiqos.h"
+
+static mp_obj_t py_axiqos_set_profile(mp_obj_t profile_obj) {
+    mp_int_t profile = mp_obj_get_int(profile_obj);
+    if ((profile < 0) || (profile >= AXIQOS_PROFILE_COUNT)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid profile"));
+    }
+    axiqos_set_profile(profile);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(py_axiqos_set_profile_obj, py_axiqos_set_profile);
+
+static mp_obj_t py_axiqos_get_profile() {
+    return mp_obj_new_int(axiqos_get_profile());
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_axiqos_get_profile_obj, py_axiqos_get_profile);
+
+// Returns the number of DCMI overruns and LTDC underrun frames since the last reset.
+static mp_obj_t py_axiqos_stats() {
+    mp_obj_t tuple[2] = {
+        mp_obj_new_int(axiqos_stats.dcmi_overruns),
+        mp_obj_new_int(axiqos_stats.ltdc_underruns),
+    };
+    return mp_obj_new_tuple(2, tuple);
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_axiqos_stats_obj, py_axiqos_stats);
+
+static mp_obj_t py_axiqos_reset_stats() {
+    axiqos_stats = (axiqos_stats_t) { 0 };
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(py_axiqos_reset_stats_obj, py_axiqos_reset_stats);
+
+static const mp_rom_map_elem_t globals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__),        MP_ROM_QSTR(MP_QSTR_axiqos) },
+    { MP_ROM_QSTR(MP_QSTR_DEFAULT),         MP_ROM_INT(AXIQOS_PROFILE_DEFAULT) },
+    { MP_ROM_QSTR(MP_QSTR_CAPTURE),         MP_ROM_INT(AXIQOS_PROFILE_CAPTURE) },
+    { MP_ROM_QSTR(MP_QSTR_DISPLAY),         MP_ROM_INT(AXIQOS_PROFILE_DISPLAY) },
+    { MP_ROM_QSTR(MP_QSTR_COMPUTE),         MP_ROM_INT(AXIQOS_PROFILE_COMPUTE) },
+    { MP_ROM_QSTR(MP_QSTR_set_profile),     MP_ROM_PTR(&py_axiqos_set_profile_obj) },
+    { MP_ROM_QSTR(MP_QSTR_get_profile),     MP_ROM_PTR(&py_axiqos_get_profile_obj) },
+    { MP_ROM_QSTR(MP_QSTR_stats),           MP_ROM_PTR(&py_axiqos_stats_obj) },
+    { MP_ROM_QSTR(MP_QSTR_reset_stats),     MP_ROM_PTR(&py_axiqos_reset_stats_obj) },
+};
+
+static MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
+
+const mp_obj_module_t axiqos_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_t) &globals_dict,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_axiqos, axiqos_module);
+#endif // defined(MCU_SERIES_H7)
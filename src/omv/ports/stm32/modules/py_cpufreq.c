@@ -124,6 +124,11 @@ mp_obj_t py_cpufreq_set_frequency(mp_obj_t cpufreq_obj) {
         mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("Unsupported frequency!"));
     }
 
+    #if defined(STM32H7)
+    // A fixed frequency disables the governor.
+    cpufreq_governor = CPUFREQ_GOVERNOR_PERFORMANCE;
+    #endif
+
     // Return if frequency hasn't changed.
     if (cpufreq == (cpufreq_get_cpuclk() / (1000000))) {
         return mp_const_true;
@@ -223,11 +228,135 @@ mp_obj_t py_cpufreq_set_frequency(mp_obj_t cpufreq_obj) {
     return mp_const_true;
 }
 
+#if defined(STM32H7)
+// The frame governor runs the CPU at half the maximum frequency when the script finishes its
+// per-frame work early enough. Only the D1CPRE and HPRE dividers are swapped, so HCLK and the
+// APB clocks (which clock the sensor XCLK timer, UARTs, I2C, etc.), the flash latency and the
+// PLL2 clocked FMC/SDRAM stay the same.
+#define CPUFREQ_GOVERNOR_FRAMES     (8)     // Frames averaged before a decision.
+#define CPUFREQ_GOVERNOR_MAX_US     (1000000)
+
+static uint32_t cpufreq_governor;
+static uint32_t cpufreq_governor_headroom;
+static uint32_t cpufreq_governor_frames;
+static uint32_t cpufreq_governor_busy_us;
+static uint32_t cpufreq_governor_period_us;
+
+static void cpufreq_governor_reset() {
+    cpufreq_governor_frames = 0;
+    cpufreq_governor_busy_us = 0;
+    cpufreq_governor_period_us = 0;
+}
+
+static int cpufreq_governor_set_half(bool half) {
+    RCC_ClkInitTypeDef RCC_ClkInitStruct;
+    uint32_t flatency;
+
+    HAL_RCC_GetClockConfig(&RCC_ClkInitStruct, &flatency);
+    RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_HCLK;
+    RCC_ClkInitStruct.SYSCLKDivider = half ? RCC_SYSCLK_DIV2 : RCC_SYSCLK_DIV1;  // D1CPRE
+    RCC_ClkInitStruct.AHBCLKDivider = half ? RCC_HCLK_DIV1 : RCC_HCLK_DIV2;      // HPRE
+
+    return (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, flatency) == HAL_OK) ? 0 : -1;
+}
+
+void cpufreq_governor_update(uint32_t busy_us, uint32_t wait_us) {
+    if (cpufreq_governor != CPUFREQ_GOVERNOR_FRAME) {
+        return;
+    }
+
+    // Ignore the frames after the script paused.
+    uint32_t period_us = busy_us + wait_us;
+    if (period_us > CPUFREQ_GOVERNOR_MAX_US) {
+        cpufreq_governor_reset();
+        return;
+    }
+
+    cpufreq_governor_busy_us += busy_us;
+    cpufreq_governor_period_us += period_us;
+
+    if ((++cpufreq_governor_frames) < CPUFREQ_GOVERNOR_FRAMES) {
+        return;
+    }
+
+    const uint32_t *cpufreq_freqs = cpufreq_get_frequencies();
+    uint32_t cpufreq = cpufreq_get_cpuclk() / 1000000;
+    uint32_t budget_us = (cpufreq_governor_period_us / 100) * (100 - cpufreq_governor_headroom);
+
+    if (cpufreq == cpufreq_freqs[N_FREQUENCIES - 1]) {
+        // Memory bound work doesn't get slower with the CPU clock, so twice the busy time is
+        // an upper bound of the busy time at half the frequency.
+        if ((cpufreq_governor_busy_us * 2) <= budget_us) {
+            cpufreq_governor_set_half(true);
+        }
+    } else if (cpufreq_governor_busy_us > budget_us) {
+        cpufreq_governor_set_half(false);
+    }
+
+    cpufreq_governor_reset();
+}
+
+void py_cpufreq_init0() {
+    if (cpufreq_governor != CPUFREQ_GOVERNOR_PERFORMANCE) {
+        cpufreq_governor = CPUFREQ_GOVERNOR_PERFORMANCE;
+        cpufreq_governor_set_half(false);
+    }
+}
+
+mp_obj_t py_cpufreq_set_governor(uint n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_governor, ARG_headroom };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_governor, MP_ARG_REQUIRED | MP_ARG_INT },
+        { MP_QSTR_headroom, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 10 } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    if ((args[ARG_governor].u_int != CPUFREQ_GOVERNOR_PERFORMANCE) &&
+        (args[ARG_governor].u_int != CPUFREQ_GOVERNOR_FRAME)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid governor"));
+    }
+
+    if ((args[ARG_headroom].u_int < 0) || (args[ARG_headroom].u_int > 50)) {
+        mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Headroom must be between 0 and 50 percent"));
+    }
+
+    // The governor starts from the maximum frequency.
+    if (args[ARG_governor].u_int == CPUFREQ_GOVERNOR_FRAME) {
+        const uint32_t *cpufreq_freqs = cpufreq_get_frequencies();
+        py_cpufreq_set_frequency(mp_obj_new_int(cpufreq_freqs[N_FREQUENCIES - 1]));
+    } else if (cpufreq_governor == CPUFREQ_GOVERNOR_FRAME) {
+        cpufreq_governor_set_half(false);
+    }
+
+    cpufreq_governor = args[ARG_governor].u_int;
+    cpufreq_governor_headroom = args[ARG_headroom].u_int;
+    cpufreq_governor_reset();
+    return mp_const_none;
+}
+
+mp_obj_t py_cpufreq_get_governor() {
+    return mp_obj_new_int(cpufreq_governor);
+}
+
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_cpufreq_set_governor_obj, 1, py_cpufreq_set_governor);
+static MP_DEFINE_CONST_FUN_OBJ_0(py_cpufreq_get_governor_obj, py_cpufreq_get_governor);
+#endif // defined(STM32H7)
+
 static MP_DEFINE_CONST_FUN_OBJ_1(py_cpufreq_set_frequency_obj, py_cpufreq_set_frequency);
 static MP_DEFINE_CONST_FUN_OBJ_0(py_cpufreq_get_current_frequencies_obj, py_cpufreq_get_current_frequencies);
 static MP_DEFINE_CONST_FUN_OBJ_0(py_cpufreq_get_supported_frequencies_obj, py_cpufreq_get_supported_frequencies);
 #endif // defined(STM32F7) || defined(STM32H7)
 
+#if !defined(STM32H7)
+void py_cpufreq_init0() {
+}
+
+void cpufreq_governor_update(uint32_t busy_us, uint32_t wait_us) {
+}
+#endif
+
 static const mp_map_elem_t globals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR___name__),                  MP_OBJ_NEW_QSTR(MP_QSTR_cpufreq) },
     #if defined(STM32F7) || defined(STM32H7)
@@ -239,6 +368,15 @@ static const mp_map_elem_t globals_dict_table[] = {
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_current_frequencies),   (mp_obj_t) &py_func_unavailable_obj },
     { MP_OBJ_NEW_QSTR(MP_QSTR_get_supported_frequencies), (mp_obj_t) &py_func_unavailable_obj },
     #endif
+    { MP_OBJ_NEW_QSTR(MP_QSTR_PERFORMANCE),               MP_OBJ_NEW_SMALL_INT(CPUFREQ_GOVERNOR_PERFORMANCE) },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_FRAME),                     MP_OBJ_NEW_SMALL_INT(CPUFREQ_GOVERNOR_FRAME) },
+    #if defined(STM32H7)
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_governor),              (mp_obj_t) &py_cpufreq_set_governor_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_governor),              (mp_obj_t) &py_cpufreq_get_governor_obj },
+    #else
+    { MP_OBJ_NEW_QSTR(MP_QSTR_set_governor),              (mp_obj_t) &py_func_unavailable_obj },
+    { MP_OBJ_NEW_QSTR(MP_QSTR_get_governor),              (mp_obj_t) &py_func_unavailable_obj },
+    #endif
     { NULL, NULL },
 };
 static MP_DEFINE_CONST_DICT(globals_dict, globals_dict_table);
@@ -10,5 +10,13 @@
  */
 #ifndef __PY_CPUFREQ_H__
 #define __PY_CPUFREQ_H__
+#include <stdint.h>
+
+#define CPUFREQ_GOVERNOR_PERFORMANCE    (0) // Fixed frequency.
+#define CPUFREQ_GOVERNOR_FRAME          (1) // Scales the frequency with the per-frame workload.
+
 void py_cpufreq_init0();
+// Called once per frame with the time the script spent on the last frame, and the time it
+// waited for this one.
+void cpufreq_governor_update(uint32_t busy_us, uint32_t wait_us);
 #endif // __PY_CPUFREQ_H__
@@ -22,6 +22,8 @@
 #include "py_image.h"
 #include "omv_gpio.h"
 #include "py_display.h"
+#include "framebuffer.h"
+#include "axiqos.h"
 
 #if defined(OMV_DSI_DISPLAY_BL_PIN)
 #define OMV_DISPLAY_BL_PIN OMV_DSI_DISPLAY_BL_PIN
@@ -56,6 +58,16 @@ typedef struct _display_state {
     DSI_HandleTypeDef hdsi;
     #endif
     LTDC_LayerCfgTypeDef framebuffer_layers[FRAMEBUFFER_COUNT];
+    // With zero copy, full frames in the sensor framebuffer are scanned out directly. Each layer
+    // config records the vbuffer it scans out from (or -1), which the sensor does not capture to.
+    bool zero_copy;
+    int32_t framebuffer_vbuffers[FRAMEBUFFER_COUNT];
+    // The overlay layer is blended over the framebuffer layer, and updated on the next reload.
+    volatile bool overlay_pending;
+    bool overlay_enabled;
+    int overlay_key;
+    LTDC_LayerCfgTypeDef overlay_layer;
+    uint32_t overlay_clut[256];
 } display_state_t;
 
 static display_state_t display;
@@ -377,6 +389,11 @@ static void ltdc_init(py_display_obj_t *self) {
     display.hltdc.Init.Backcolor.Red = 0;
     HAL_LTDC_Init(&display.hltdc);
 
+    #if defined(MCU_SERIES_H7)
+    // Count the frames that underrun, a sign of too little AXI bandwidth left for the LTDC.
+    __HAL_LTDC_ENABLE_IT(&display.hltdc, LTDC_IT_FU);
+    #endif
+
     NVIC_SetPriority(LTDC_IRQn, IRQ_PRI_LTDC);
     HAL_NVIC_EnableIRQ(LTDC_IRQn);
 
@@ -384,11 +401,54 @@ static void ltdc_init(py_display_obj_t *self) {
     HAL_LTDC_Reload(&display.hltdc, LTDC_RELOAD_VERTICAL_BLANKING);
 }
 
+#if defined(MCU_SERIES_H7)
+void HAL_LTDC_ErrorCallback(LTDC_HandleTypeDef *hltdc) {
+    // The HAL disables the interrupt, it's enabled again on the next reload.
+    if (hltdc->ErrorCode & HAL_LTDC_ERROR_FU) {
+        axiqos_stats.ltdc_underruns += 1;
+    }
+    hltdc->ErrorCode = HAL_LTDC_ERROR_NONE;
+}
+#endif
+
 void HAL_LTDC_ReloadEventCallback(LTDC_HandleTypeDef *hltdc) {
     py_display_obj_t *self = display.self;
 
+    #if defined(MCU_SERIES_H7)
+    __HAL_LTDC_ENABLE_IT(&display.hltdc, LTDC_IT_FU);
+    #endif
+
     HAL_LTDC_ConfigLayer_NoReload(&display.hltdc,
                                   &display.framebuffer_layers[self->framebuffer_tail], LTDC_LAYER_1);
+
+    if (display.zero_copy) {
+        // The last layer config is scanned out now, and the new one after the next reload.
+        int32_t active = display.framebuffer_vbuffers[self->framebuffer_head];
+        int32_t pending = display.framebuffer_vbuffers[self->framebuffer_tail];
+        framebuffer_set_scanout(((active >= 0) ? (1 << active) : 0) | ((pending >= 0) ? (1 << pending) : 0));
+    }
+
+    if (display.overlay_pending) {
+        if (!display.overlay_enabled) {
+            __HAL_LTDC_LAYER_DISABLE(&display.hltdc, LTDC_LAYER_2);
+        } else {
+            HAL_LTDC_ConfigLayer_NoReload(&display.hltdc, &display.overlay_layer, LTDC_LAYER_2);
+            if (display.overlay_layer.PixelFormat == LTDC_PIXEL_FORMAT_L8) {
+                HAL_LTDC_ConfigCLUT(&display.hltdc, display.overlay_clut, 256, LTDC_LAYER_2);
+                HAL_LTDC_EnableCLUT_NoReload(&display.hltdc, LTDC_LAYER_2);
+            } else {
+                HAL_LTDC_DisableCLUT_NoReload(&display.hltdc, LTDC_LAYER_2);
+            }
+            if (display.overlay_key >= 0) {
+                HAL_LTDC_ConfigColorKeying_NoReload(&display.hltdc, display.overlay_key, LTDC_LAYER_2);
+                HAL_LTDC_EnableColorKeying_NoReload(&display.hltdc, LTDC_LAYER_2);
+            } else {
+                HAL_LTDC_DisableColorKeying_NoReload(&display.hltdc, LTDC_LAYER_2);
+            }
+        }
+        display.overlay_pending = false;
+    }
+
     // Continue chain...
     HAL_LTDC_Reload(&display.hltdc, LTDC_RELOAD_VERTICAL_BLANKING);
 
@@ -401,10 +461,34 @@ void HAL_LTDC_ReloadEventCallback(LTDC_HandleTypeDef *hltdc) {
     self->framebuffer_head = self->framebuffer_tail;
 }
 
+// Returns the vbuffer to scan out from if the image is a full sensor frame drawn 1:1, or -1.
+static int32_t display_get_vbuffer(py_display_obj_t *self, image_t *src_img, float x_scale, float y_scale,
+                                   int rgb_channel, const uint16_t *color_palette, const uint8_t *alpha_palette,
+                                   image_hint_t hint, point_t *p0, point_t *p1) {
+    // The sensor only skips the vbuffers a display scans out from when triple buffered.
+    if (!display.zero_copy || (framebuffer->n_buffers != 3)) {
+        return -1;
+    }
+
+    if ((src_img->pixfmt != PIXFORMAT_RGB565) || (src_img->w != self->width) || (src_img->h != self->height) ||
+        (IMAGE_RGB565_ROW_STRIDE(src_img) != (src_img->w * sizeof(uint16_t))) ||
+        (x_scale != 1.0f) || (y_scale != 1.0f) || (rgb_channel != -1) || color_palette || alpha_palette ||
+        (hint & (IMAGE_HINT_HMIRROR | IMAGE_HINT_VFLIP | IMAGE_HINT_TRANSPOSE))) {
+        return -1;
+    }
+
+    // The image must cover the whole display, which also rules out an ROI.
+    if ((p0->x != 0) || (p0->y != 0) || (p1->x != self->width) || (p1->y != self->height)) {
+        return -1;
+    }
+
+    return framebuffer_get_buffer_index(src_img);
+}
+
 static void display_write(py_display_obj_t *self, image_t *src_img, int dst_x_start, int dst_y_start,
                           float x_scale, float y_scale, rectangle_t *roi, int rgb_channel, int alpha,
                           const uint16_t *color_palette, const uint8_t *alpha_palette, image_hint_t hint) {
-    image_t dst_img;
+    image_t dst_img = {};
     dst_img.w = self->width;
     dst_img.h = self->height;
     dst_img.pixfmt = PIXFORMAT_RGB565;
@@ -422,6 +506,35 @@ static void display_write(py_display_obj_t *self, image_t *src_img, int dst_x_st
     }
     dst_img.data = (uint8_t *) self->framebuffers[tail];
 
+    int32_t vbuffer = black ? -1 : display_get_vbuffer(self, src_img, x_scale, y_scale, rgb_channel,
+                                                       color_palette, alpha_palette, hint, &p0, &p1);
+    display.framebuffer_vbuffers[tail] = vbuffer;
+
+    if (vbuffer >= 0) {
+        // Scan out from the sensor framebuffer, the layer alpha blends it into black.
+        display.framebuffer_layers[tail].WindowX0 = 0;
+        display.framebuffer_layers[tail].WindowX1 = self->width;
+        display.framebuffer_layers[tail].WindowY0 = 0;
+        display.framebuffer_layers[tail].WindowY1 = self->height;
+        display.framebuffer_layers[tail].Alpha = fast_roundf((alpha * 255) / 256.f);
+        display.framebuffer_layers[tail].FBStartAdress = (uint32_t) src_img->data;
+        display.framebuffer_layers[tail].ImageWidth = self->width;
+        display.framebuffer_layers[tail].ImageHeight = self->height;
+
+        #ifdef __DCACHE_PRESENT
+        // Flush anything drawn on the frame for DMA
+        SCB_CleanDCache_by_Addr((uint32_t *) src_img->data, image_size(src_img));
+        #endif
+
+        // Hand the vbuffer to the display before the new image is ready, the reload IRQ takes
+        // the ownership over from here.
+        mp_uint_t irq_state = disable_irq();
+        framebuffer_set_scanout(framebuffer->scanout | (1 << vbuffer));
+        self->framebuffer_tail = tail;
+        enable_irq(irq_state);
+        return;
+    }
+
     // Set default values for the layer to display the whole framebuffer.
     display.framebuffer_layers[tail].WindowX0 = black ? 0 : p0.x;
     display.framebuffer_layers[tail].WindowX1 = black ? self->width : p1.x;
@@ -476,11 +589,79 @@ static void display_clear(py_display_obj_t *self, bool off) {
     display.framebuffer_layers[tail].FBStartAdress = (uint32_t) self->framebuffers[tail];
     display.framebuffer_layers[tail].ImageWidth = self->width;
     display.framebuffer_layers[tail].ImageHeight = self->height;
+    display.framebuffer_vbuffers[tail] = -1;
 
     // Update tail which means a new image is ready.
     self->framebuffer_tail = tail;
 }
 
+// Expands RGB565 like the LTDC does, by replicating the MSBs into the missing LSBs.
+static uint32_t rgb565_to_rgb888(uint16_t pixel) {
+    uint32_t r = COLOR_RGB565_TO_R5(pixel), g = COLOR_RGB565_TO_G6(pixel), b = COLOR_RGB565_TO_B5(pixel);
+    return (((r << 3) | (r >> 2)) << 16) | (((g << 2) | (g >> 4)) << 8) | ((b << 3) | (b >> 2));
+}
+
+static void display_overlay(py_display_obj_t *self, image_t *img, int x, int y, int alpha,
+                            const uint16_t *color_palette, int transparent) {
+    // Wait for the last overlay update to be applied.
+    while (display.overlay_pending) {
+        MICROPY_EVENT_POLL_HOOK
+    }
+
+    rectangle_t rect = {0, 0, 0, 0};
+    if (img) {
+        rectangle_t bounds = {0, 0, self->width, self->height};
+        rectangle_init(&rect, x, y, img->w, img->h);
+        if (!rectangle_overlap(&rect, &bounds)) {
+            img = NULL;
+        } else {
+            rectangle_intersected(&rect, &bounds);
+        }
+    }
+
+    display.overlay_enabled = (img != NULL);
+
+    if (img) {
+        // The layer scans out the visible part of the image, the pitch is the image width.
+        uint32_t bpp = (img->pixfmt == PIXFORMAT_GRAYSCALE) ? sizeof(uint8_t) : sizeof(uint16_t);
+        uint8_t *data = img->data + ((((rect.y - y) * img->w) + (rect.x - x)) * bpp);
+
+        display.overlay_layer.WindowX0 = rect.x;
+        display.overlay_layer.WindowX1 = rect.x + rect.w;
+        display.overlay_layer.WindowY0 = rect.y;
+        display.overlay_layer.WindowY1 = rect.y + rect.h;
+        display.overlay_layer.Alpha = fast_roundf((alpha * 255) / 256.f);
+        display.overlay_layer.Alpha0 = 0;
+        display.overlay_layer.BlendingFactor1 = LTDC_BLENDING_FACTOR1_PAxCA;
+        display.overlay_layer.BlendingFactor2 = LTDC_BLENDING_FACTOR2_PAxCA;
+        display.overlay_layer.FBStartAdress = (uint32_t) data;
+        display.overlay_layer.ImageWidth = img->w;
+        display.overlay_layer.ImageHeight = rect.h;
+        display.overlay_layer.Backcolor.Blue = 0;
+        display.overlay_layer.Backcolor.Green = 0;
+        display.overlay_layer.Backcolor.Red = 0;
+
+        // Color keying compares RGB888 colors, after the CLUT lookup for L8.
+        if (img->pixfmt == PIXFORMAT_GRAYSCALE) {
+            display.overlay_layer.PixelFormat = LTDC_PIXEL_FORMAT_L8;
+            for (int i = 0; i < 256; i++) {
+                display.overlay_clut[i] = color_palette ? rgb565_to_rgb888(color_palette[i]) : COLOR_Y_TO_RGB888(i);
+            }
+            display.overlay_key = (transparent >= 0) ? display.overlay_clut[transparent & 0xff] : -1;
+        } else {
+            display.overlay_layer.PixelFormat = LTDC_PIXEL_FORMAT_RGB565;
+            display.overlay_key = (transparent >= 0) ? rgb565_to_rgb888(transparent) : -1;
+        }
+
+        #ifdef __DCACHE_PRESENT
+        // Flush data for DMA
+        SCB_CleanDCache_by_Addr((uint32_t *) img->data, image_size(img));
+        #endif
+    }
+
+    display.overlay_pending = true;
+}
+
 #ifdef OMV_DISPLAY_BL_PIN
 static void display_set_backlight(py_display_obj_t *self, uint32_t intensity) {
     omv_gpio_config(OMV_DISPLAY_BL_PIN, OMV_GPIO_MODE_OUTPUT, OMV_GPIO_PULL_NONE, OMV_GPIO_SPEED_LOW, -1);
@@ -535,6 +716,12 @@ static void display_deinit(py_display_obj_t *self) {
     HAL_LTDC_DeInit(&display.hltdc);
     HAL_NVIC_DisableIRQ(LTDC_IRQn);
 
+    // Hand the scanned out vbuffers back to the sensor.
+    if (display.zero_copy) {
+        display.zero_copy = false;
+        framebuffer_set_scanout(0);
+    }
+
     __HAL_RCC_PLL3_DISABLE();
     uint32_t tickstart = mp_hal_ticks_ms();
     while (__HAL_RCC_GET_FLAG(RCC_FLAG_PLL3RDY)) {
@@ -553,7 +740,7 @@ static void display_deinit(py_display_obj_t *self) {
 mp_obj_t display_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
     enum {
         ARG_framesize, ARG_refresh, ARG_display_on, ARG_triple_buffer,
-        ARG_portrait, ARG_channel, ARG_controller, ARG_backlight
+        ARG_portrait, ARG_channel, ARG_controller, ARG_backlight, ARG_zero_copy
     };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_framesize,     MP_ARG_INT,  {.u_int = DISPLAY_RESOLUTION_FWVGA  } },
@@ -564,6 +751,7 @@ mp_obj_t display_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw,
         { MP_QSTR_channel,       MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 0  } },
         { MP_QSTR_controller,    MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
         { MP_QSTR_backlight,     MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_rom_obj = MP_ROM_NONE} },
+        { MP_QSTR_zero_copy,     MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
     };
 
     // Parse args.
@@ -601,6 +789,12 @@ mp_obj_t display_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw,
     }
     self->controller = args[ARG_controller].u_obj;
     self->bl_controller = args[ARG_backlight].u_obj;
+    self->overlay = mp_const_none;
+    display.overlay_pending = false;
+    display.zero_copy = args[ARG_zero_copy].u_bool;
+    for (int i = 0; i < FRAMEBUFFER_COUNT; i++) {
+        display.framebuffer_vbuffers[i] = -1;
+    }
 
     // Store state to access it from IRQ handlers or callbacks
     display.self = self;
@@ -633,6 +827,7 @@ static const py_display_p_t py_display_p = {
     .deinit = display_deinit,
     .clear = display_clear,
     .write = display_write,
+    .overlay = display_overlay,
     #ifdef OMV_DISPLAY_BL_PIN
     .set_backlight = display_set_backlight,
     #endif
@@ -353,6 +353,160 @@ static mp_obj_t py_imu_read_reg(mp_obj_t addr) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_1(py_imu_read_reg_obj, py_imu_read_reg);
 
+// FIFO batching: the sensor buffers accel/gyro samples in its FIFO at the selected rate and
+// read_fifo() drains them in bursts. Sample timestamps are reconstructed from the rate and the
+// time the FIFO level was read, they share the mp_hal_ticks_us() clock of sensor.get_timestamps().
+#define IMU_FIFO_BURST_WORDS    (48)
+#if defined(IMU_CHIP_LSM6DSOX)
+#define IMU_FIFO_WORD_SIZE      (7)     // Tag + X, Y, Z
+#define IMU_FIFO_SAMPLE_WORDS   (2)     // Gyro and accel words.
+#else
+#define IMU_FIFO_WORD_SIZE      (2)     // One axis.
+#define IMU_FIFO_SAMPLE_WORDS   (6)     // Gyro X, Y, Z then accel X, Y, Z.
+#endif
+
+// Indexed by the ODR/batch rate codes minus one, which are the same for both chips.
+static const float imu_fifo_rates[] = {
+    12.5f, 26.0f, 52.0f, 104.0f, 208.0f, 416.0f, 833.0f, 1666.0f, 3333.0f, 6666.0f
+};
+
+static uint32_t imu_fifo_period_us;
+static uint8_t imu_fifo_buf[IMU_FIFO_BURST_WORDS * IMU_FIFO_WORD_SIZE];
+
+static mp_obj_t py_imu_fifo_sample(uint32_t ticks_us, int16_t *xl, int16_t *gy) {
+    return mp_obj_new_tuple(3, (mp_obj_t [3]) {mp_obj_new_int_from_uint(ticks_us),
+                                               py_imu_tuple(lsm_from_fs8_to_mg(xl[0]),
+                                                            lsm_from_fs8_to_mg(xl[1]),
+                                                            lsm_from_fs8_to_mg(xl[2])),
+                                               py_imu_tuple(lsm_from_fs2000_to_mdps(gy[0]),
+                                                            lsm_from_fs2000_to_mdps(gy[1]),
+                                                            lsm_from_fs2000_to_mdps(gy[2]))});
+}
+
+static mp_obj_t py_imu_fifo(uint n_args, const mp_obj_t *args) {
+    error_on_not_ready();
+
+    float rate = n_args ? mp_obj_get_float(args[0]) : 0.0f;
+    int code = 0;
+
+    if (rate > 0.0f) {
+        // Select the lowest rate that's at least the requested one.
+        for (code = 1; code < MP_ARRAY_SIZE(imu_fifo_rates) && imu_fifo_rates[code - 1] < rate; code++) {
+        }
+    }
+
+    LSM_FUNC(fifo_mode_set) (&dev_ctx, LSM_CONST(BYPASS_MODE));
+
+    if (!code) {
+        imu_fifo_period_us = 0;
+        LSM_FUNC(xl_data_rate_set) (&dev_ctx, LSM_CONST(XL_ODR_52Hz));
+        LSM_FUNC(gy_data_rate_set) (&dev_ctx, LSM_CONST(GY_ODR_52Hz));
+        return mp_obj_new_float(0.0f);
+    }
+
+    LSM_FUNC(xl_data_rate_set) (&dev_ctx, code);
+    LSM_FUNC(gy_data_rate_set) (&dev_ctx, code);
+    #if defined(IMU_CHIP_LSM6DSOX)
+    LSM_FUNC(fifo_xl_batch_set) (&dev_ctx, code);
+    LSM_FUNC(fifo_gy_batch_set) (&dev_ctx, code);
+    #else
+    LSM_FUNC(fifo_xl_batch_set) (&dev_ctx, LSM_CONST(FIFO_XL_NO_DEC));
+    LSM_FUNC(fifo_gy_batch_set) (&dev_ctx, LSM_CONST(FIFO_GY_NO_DEC));
+    LSM_FUNC(fifo_data_rate_set) (&dev_ctx, code);
+    #endif
+    LSM_FUNC(fifo_mode_set) (&dev_ctx, LSM_CONST(STREAM_MODE));
+
+    imu_fifo_period_us = fast_roundf(1000000.0f / imu_fifo_rates[code - 1]);
+    return mp_obj_new_float(imu_fifo_rates[code - 1]);
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(py_imu_fifo_obj, 0, 1, py_imu_fifo);
+
+static mp_obj_t py_imu_read_fifo(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_max_samples };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_max_samples, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 256 } },
+    };
+
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args, pos_args, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    error_on_not_ready();
+
+    if (!imu_fifo_period_us) {
+        mp_raise_msg(&mp_type_OSError, MP_ERROR_TEXT("IMU FIFO is not enabled"));
+    }
+
+    uint16_t words = 0;
+    LSM_FUNC(fifo_data_level_get) (&dev_ctx, &words);
+    uint32_t ticks_us = mp_hal_ticks_us();
+
+    #if !defined(IMU_CHIP_LSM6DSOX)
+    // Drop the words of a partial sample to start reading at the gyro X word.
+    uint16_t pattern = 0;
+    LSM_FUNC(fifo_pattern_get) (&dev_ctx, &pattern);
+    for (uint32_t skip = (IMU_FIFO_SAMPLE_WORDS - pattern) % IMU_FIFO_SAMPLE_WORDS; skip && words; skip--, words--) {
+        LSM_FUNC(read_reg) (&dev_ctx, LSM_CONST(FIFO_DATA_OUT_L), imu_fifo_buf, IMU_FIFO_WORD_SIZE);
+    }
+    #endif
+
+    // The newest sample in the FIFO was taken within a period of reading the level.
+    uint32_t total = words / IMU_FIFO_SAMPLE_WORDS;
+    uint32_t count = IM_MIN(total, (uint32_t) IM_MAX(args[ARG_max_samples].u_int, 0));
+    words = count * IMU_FIFO_SAMPLE_WORDS;
+
+    mp_obj_t list = mp_obj_new_list(0, NULL);
+    int16_t xl[3] = {}, gy[3] = {};
+    uint32_t index = 0;
+    #if defined(IMU_CHIP_LSM6DSOX)
+    uint32_t have = 0;
+    #endif
+
+    while (words) {
+        uint32_t burst = IM_MIN(words, IMU_FIFO_BURST_WORDS);
+        // The sensor rolls the address back to the first FIFO output register after the last one.
+        #if defined(IMU_CHIP_LSM6DSOX)
+        LSM_FUNC(read_reg) (&dev_ctx, LSM_CONST(FIFO_DATA_OUT_TAG), imu_fifo_buf, burst * IMU_FIFO_WORD_SIZE);
+        #else
+        LSM_FUNC(read_reg) (&dev_ctx, LSM_CONST(FIFO_DATA_OUT_L), imu_fifo_buf, burst * IMU_FIFO_WORD_SIZE);
+        #endif
+        words -= burst;
+
+        #if defined(IMU_CHIP_LSM6DSOX)
+        for (uint32_t i = 0; i < burst; i++) {
+            uint8_t *word = imu_fifo_buf + (i * IMU_FIFO_WORD_SIZE);
+            uint8_t tag = word[0] >> 3;
+            if ((tag != LSM_CONST(XL_NC_TAG)) && (tag != LSM_CONST(GYRO_NC_TAG))) {
+                continue;
+            }
+            int16_t *axes = (tag == LSM_CONST(XL_NC_TAG)) ? xl : gy;
+            for (int j = 0; j < 3; j++) {
+                axes[j] = (int16_t) (word[1 + (j * 2)] | (word[2 + (j * 2)] << 8));
+            }
+            have |= (axes == xl) ? 1 : 2;
+            if (have == 3) {
+                uint32_t sample_us = ticks_us - ((total - 1 - index++) * imu_fifo_period_us);
+                mp_obj_list_append(list, py_imu_fifo_sample(sample_us, xl, gy));
+                have = 0;
+            }
+        }
+        #else
+        // Bursts are whole samples since IMU_FIFO_BURST_WORDS is a multiple of the sample size.
+        for (uint32_t i = 0; i < burst; i += IMU_FIFO_SAMPLE_WORDS) {
+            uint8_t *sample = imu_fifo_buf + (i * IMU_FIFO_WORD_SIZE);
+            for (int j = 0; j < 3; j++) {
+                gy[j] = (int16_t) (sample[j * 2] | (sample[(j * 2) + 1] << 8));
+                xl[j] = (int16_t) (sample[6 + (j * 2)] | (sample[7 + (j * 2)] << 8));
+            }
+            uint32_t sample_us = ticks_us - ((total - 1 - index++) * imu_fifo_period_us);
+            mp_obj_list_append(list, py_imu_fifo_sample(sample_us, xl, gy));
+        }
+        #endif
+    }
+
+    return list;
+}
+static MP_DEFINE_CONST_FUN_OBJ_KW(py_imu_read_fifo_obj, 0, py_imu_read_fifo);
+
 static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__),            MP_OBJ_NEW_QSTR(MP_QSTR_imu) },
     { MP_ROM_QSTR(MP_QSTR_acceleration_mg),     MP_ROM_PTR(&py_imu_acceleration_mg_obj) },
@@ -361,6 +515,8 @@ static const mp_rom_map_elem_t globals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_roll),                MP_ROM_PTR(&py_imu_roll_obj) },
     { MP_ROM_QSTR(MP_QSTR_pitch),               MP_ROM_PTR(&py_imu_pitch_obj) },
     { MP_ROM_QSTR(MP_QSTR_sleep),               MP_ROM_PTR(&py_imu_sleep_obj) },
+    { MP_ROM_QSTR(MP_QSTR_fifo),                MP_ROM_PTR(&py_imu_fifo_obj) },
+    { MP_ROM_QSTR(MP_QSTR_read_fifo),           MP_ROM_PTR(&py_imu_read_fifo_obj) },
     { MP_ROM_QSTR(MP_QSTR___write_reg),         MP_ROM_PTR(&py_imu_write_reg_obj) },
     { MP_ROM_QSTR(MP_QSTR___read_reg),          MP_ROM_PTR(&py_imu_read_reg_obj) },
 };
@@ -400,6 +556,8 @@ void py_imu_init() {
     }
 
     LSM_FUNC(block_data_update_set) (&dev_ctx, PROPERTY_ENABLE);
+    LSM_FUNC(fifo_mode_set) (&dev_ctx, LSM_CONST(BYPASS_MODE));
+    imu_fifo_period_us = 0;
 
     LSM_FUNC(xl_data_rate_set) (&dev_ctx, LSM_CONST(XL_ODR_52Hz));
     LSM_FUNC(gy_data_rate_set) (&dev_ctx, LSM_CONST(GY_ODR_52Hz));
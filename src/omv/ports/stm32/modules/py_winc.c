@@ -30,6 +30,18 @@
 #include "socket/include/socket.h"
 #include "driver/include/m2m_wifi.h"
 
+// Socket option (SOL_SOCKET level), coalesces small sends on stream sockets.
+#define PY_WINC_SO_TXBATCH      (0x100)
+#define PY_WINC_TX_BATCH_SIZE   (SOCKET_BUFFER_MAX_LENGTH)
+
+// Per-socket state. With TX batching, sends smaller than the batch buffer are copied into it and
+// sent as one HIF message when it fills up, or before the socket is read, reconfigured or closed.
+typedef struct _py_winc_socket_t {
+    winc_socket_buf_t rxbuf;
+    uint8_t *tx_buf;
+    uint32_t tx_size;
+} py_winc_socket_t;
+
 typedef struct _winc_obj_t {
     mp_obj_base_t base;
     uint8_t active;
@@ -392,15 +404,23 @@ static int py_winc_socket_socket(mod_network_socket_obj_t *socket, int *_errno)
 
     // store state of this socket
     socket->fileno = fd;
-    socket->_private = m_new0(winc_socket_buf_t, 1);
+    socket->_private = m_new0(py_winc_socket_t, 1);
     return 0;
 }
 
 static void py_winc_socket_close(mod_network_socket_obj_t *socket) {
     if (socket->fileno >= 0) {
+        py_winc_socket_t *state = socket->_private;
+        if (state->tx_buf) {
+            // Best effort, send out any batched data.
+            if (state->tx_size) {
+                winc_socket_send(socket->fileno, state->tx_buf, state->tx_size, socket->timeout);
+            }
+            m_del(uint8_t, state->tx_buf, PY_WINC_TX_BATCH_SIZE);
+        }
         winc_socket_close(socket->fileno);
         socket->fileno = -1; // Mark socket FD as invalid
-        m_del(winc_socket_buf_t, socket->_private, 1);
+        m_del(py_winc_socket_t, socket->_private, 1);
         socket->_private = NULL;
         socket->nic = MP_OBJ_NULL;
     }
@@ -444,7 +464,7 @@ static int py_winc_socket_accept(mod_network_socket_obj_t *socket,
 
     // Set default socket timeout.
     socket2->fileno = fd;
-    socket2->_private = m_new0(winc_socket_buf_t, 1);
+    socket2->_private = m_new0(py_winc_socket_t, 1);
     UNPACK_SOCKADDR((&addr), ip, *port);
 
     return 0;
@@ -461,7 +481,7 @@ static int py_winc_socket_connect(mod_network_socket_obj_t *socket, byte *ip, mp
     return 0;
 }
 
-static mp_uint_t py_winc_socket_send(mod_network_socket_obj_t *socket, const byte *buf, mp_uint_t len, int *_errno) {
+static mp_uint_t py_winc_socket_write(mod_network_socket_obj_t *socket, const byte *buf, mp_uint_t len, int *_errno) {
     int ret = winc_socket_send(socket->fileno, buf, len, socket->timeout);
     if (ret < 0) {
         *_errno = py_winc_mperrno(ret);
@@ -470,12 +490,61 @@ static mp_uint_t py_winc_socket_send(mod_network_socket_obj_t *socket, const byt
             py_winc_socket_close(socket);
         }
         ret = -1;
+    } else if (ret == 0 && len) {
+        // Nothing could be sent before the timeout (immediately for non-blocking sockets).
+        *_errno = socket->timeout ? MP_ETIMEDOUT : MP_EAGAIN;
+        ret = -1;
     }
     return ret;
 }
 
+// Sends the batched data, returns 0 once the batch buffer is empty.
+static mp_uint_t py_winc_socket_flush(mod_network_socket_obj_t *socket, int *_errno) {
+    py_winc_socket_t *state = socket->_private;
+
+    while (state->tx_buf && state->tx_size) {
+        mp_uint_t ret = py_winc_socket_write(socket, state->tx_buf, state->tx_size, _errno);
+        if (ret == -1) {
+            return -1;
+        }
+        if (socket->fileno < 0) {
+            return 0;
+        }
+        memmove(state->tx_buf, state->tx_buf + ret, state->tx_size - ret);
+        state->tx_size -= ret;
+    }
+
+    return 0;
+}
+
+static mp_uint_t py_winc_socket_send(mod_network_socket_obj_t *socket, const byte *buf, mp_uint_t len, int *_errno) {
+    py_winc_socket_t *state = socket->_private;
+
+    if (state->tx_buf == NULL) {
+        return py_winc_socket_write(socket, buf, len, _errno);
+    }
+
+    // Make room for the data, or send out the batch before a large send to keep the order.
+    if (((state->tx_size + len) > PY_WINC_TX_BATCH_SIZE) && py_winc_socket_flush(socket, _errno) != 0) {
+        return -1;
+    }
+
+    if (len >= PY_WINC_TX_BATCH_SIZE) {
+        return py_winc_socket_write(socket, buf, len, _errno);
+    }
+
+    memcpy(state->tx_buf + state->tx_size, buf, len);
+    state->tx_size += len;
+    return len;
+}
+
 static mp_uint_t py_winc_socket_recv(mod_network_socket_obj_t *socket, byte *buf, mp_uint_t len, int *_errno) {
-    int ret = winc_socket_recv(socket->fileno, buf, len, socket->_private, socket->timeout);
+    if (py_winc_socket_flush(socket, _errno) != 0) {
+        return -1;
+    }
+
+    py_winc_socket_t *state = socket->_private;
+    int ret = winc_socket_recv(socket->fileno, buf, len, &state->rxbuf, socket->timeout);
     if (ret <= 0) {
         // NOTE: 0 return from recv() means connection closed.
         *_errno = py_winc_mperrno(ret);
@@ -521,6 +590,28 @@ static mp_uint_t py_winc_socket_recvfrom(mod_network_socket_obj_t *socket,
 
 static int py_winc_socket_setsockopt(mod_network_socket_obj_t *socket, mp_uint_t
                                      level, mp_uint_t opt, const void *optval, mp_uint_t optlen, int *_errno) {
+    if (py_winc_socket_flush(socket, _errno) != 0) {
+        return -1;
+    }
+
+    if (level == SOL_SOCKET && opt == PY_WINC_SO_TXBATCH) {
+        py_winc_socket_t *state = socket->_private;
+        bool enable = (optlen >= sizeof(uint32_t)) ? *((const uint32_t *) optval) : *((const uint8_t *) optval);
+
+        if (socket->type != MOD_NETWORK_SOCK_STREAM) {
+            *_errno = MP_EOPNOTSUPP;
+            return -1;
+        }
+
+        if (enable && state->tx_buf == NULL) {
+            state->tx_buf = m_new(uint8_t, PY_WINC_TX_BATCH_SIZE);
+        } else if (!enable && state->tx_buf != NULL) {
+            m_del(uint8_t, state->tx_buf, PY_WINC_TX_BATCH_SIZE);
+            state->tx_buf = NULL;
+        }
+        return 0;
+    }
+
     int ret = winc_socket_setsockopt(socket->fileno, level, opt, optval, optlen);
     if (ret < 0) {
         *_errno = py_winc_mperrno(ret);
@@ -536,6 +627,9 @@ static int py_winc_socket_settimeout(mod_network_socket_obj_t *socket, mp_uint_t
 }
 
 static int py_winc_socket_ioctl(mod_network_socket_obj_t *socket, mp_uint_t request, mp_uint_t arg, int *_errno) {
+    if (request == MP_STREAM_FLUSH) {
+        return py_winc_socket_flush(socket, _errno);
+    }
     *_errno = MP_EIO;
     return -1;
 }
@@ -576,6 +670,7 @@ static const mp_rom_map_elem_t winc_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_802_1X),        MP_OBJ_NEW_SMALL_INT(M2M_WIFI_SEC_802_1X) }, // Network is secured with WPA/WPA2 Enterprise.
     { MP_ROM_QSTR(MP_QSTR_MODE_STA),      MP_OBJ_NEW_SMALL_INT(WINC_MODE_STA) },       // Start in Station mode.
     { MP_ROM_QSTR(MP_QSTR_MODE_AP),       MP_OBJ_NEW_SMALL_INT(WINC_MODE_AP) },        // Start in Access Point mode.
+    { MP_ROM_QSTR(MP_QSTR_SO_TXBATCH),    MP_OBJ_NEW_SMALL_INT(PY_WINC_SO_TXBATCH) },  // Coalesce small stream socket sends.
     { MP_ROM_QSTR(MP_QSTR_MODE_P2P),      MP_OBJ_NEW_SMALL_INT(WINC_MODE_P2P) },       // Start in P2P (WiFi Direct) mode.
     { MP_ROM_QSTR(MP_QSTR_MODE_BSP),      MP_OBJ_NEW_SMALL_INT(WINC_MODE_BSP) },       // Init BSP.
     { MP_ROM_QSTR(MP_QSTR_MODE_FIRMWARE), MP_OBJ_NEW_SMALL_INT(WINC_MODE_FIRMWARE) },  // Start in Firmware Upgrade mode.
@@ -0,0 +1,39 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+ * Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for details.
+ *
+ * CRC functions using the CRC unit.
+ */
+#include STM32_HAL_H
+#include "omv_crc.h"
+
+// Only CRC units with a programmable polynomial can compute the CRC-16.
+#if defined(CRC_POL_POL)
+uint16_t omv_crc16(const void *buf, size_t size) {
+    const uint8_t *p = buf;
+
+    __HAL_RCC_CRC_CLK_ENABLE();
+    CRC->POL = 0x1021;
+    CRC->INIT = 0xFFFF;
+    CRC->CR = CRC_CR_POLYSIZE_0 | CRC_CR_RESET;
+
+    // Feed single bytes until aligned, then 32-bit words (big-endian, the unit is not reflected).
+    for (; size && (((uintptr_t) p) & 3); size--) {
+        *((volatile uint8_t *) &CRC->DR) = *p++;
+    }
+
+    for (; size >= 4; size -= 4, p += 4) {
+        CRC->DR = __REV(*((const uint32_t *) p));
+    }
+
+    for (; size; size--) {
+        *((volatile uint8_t *) &CRC->DR) = *p++;
+    }
+
+    return CRC->DR & 0xFFFF;
+}
+#endif // defined(CRC_POL_POL)
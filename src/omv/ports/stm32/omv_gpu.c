@@ -12,8 +12,13 @@
 #if (OMV_GPU_ENABLE == 1)
 #include STM32_HAL_H
 #include "imlib.h"
+#include "fb_alloc.h"
 #include "dma.h"
 
+#ifndef OMV_GPU_TILE_SIZE
+#define OMV_GPU_TILE_SIZE   (8192)  // Bytes per tile, two tiles are used.
+#endif
+
 int omv_gpu_init() {
     return 0;
 }
@@ -24,6 +29,94 @@ void omv_gpu_deinit() {
     HAL_DMA2D_DeInit(&dma2d);
 }
 
+// Cleans (and invalidates) the cache lines of rows of pixels before the DMA2D accesses them.
+static void omv_gpu_clean_rows(void *ptr, int rows, size_t len, size_t stride, bool invalidate) {
+    #if __DCACHE_PRESENT
+    for (int i = 0; i < rows; i++, ptr = ((uint8_t *) ptr) + stride) {
+        if (invalidate) {
+            SCB_CleanInvalidateDCache_by_Addr(ptr, len);
+        } else {
+            SCB_CleanDCache_by_Addr(ptr, len);
+        }
+    }
+    #endif
+}
+
+// Drops any cached reads of rows written by the DMA2D.
+static void omv_gpu_invalidate_rows(void *ptr, int rows, size_t len, size_t stride) {
+    #if __DCACHE_PRESENT
+    for (int i = 0; i < rows; i++, ptr = ((uint8_t *) ptr) + stride) {
+        SCB_InvalidateDCache_by_Addr(ptr, len);
+    }
+    #endif
+}
+
+// Scales a source row to dst_w pixels, in the source pixel format. y_accum is the 16.16 source row.
+static void omv_gpu_scale_row(image_t *src_img, rectangle_t *src_rect, int dst_w,
+                              int32_t y_accum, int32_t x_frac, bool bilinear, bool hmirror, void *out) {
+    int x_start = hmirror ? (dst_w - 1) : 0;
+    int x_delta = hmirror ? -1 : 1;
+
+    if (!bilinear) {
+        int y = src_rect->y + (y_accum >> 16);
+        if (src_img->pixfmt == PIXFORMAT_GRAYSCALE) {
+            uint8_t *src8 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src_img, y) + src_rect->x;
+            uint8_t *dst8 = ((uint8_t *) out) + x_start;
+            for (int x = 0, x_accum = 0; x < dst_w; x++, x_accum += x_frac, dst8 += x_delta) {
+                *dst8 = src8[x_accum >> 16];
+            }
+        } else {
+            uint16_t *src16 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(src_img, y) + src_rect->x;
+            uint16_t *dst16 = ((uint16_t *) out) + x_start;
+            for (int x = 0, x_accum = 0; x < dst_w; x++, x_accum += x_frac, dst16 += x_delta) {
+                *dst16 = src16[x_accum >> 16];
+            }
+        }
+        return;
+    }
+
+    // Bilinear samples are centered on the pixels, like the software path.
+    int x_end = src_rect->w - 1;
+    y_accum = IM_MAX(y_accum - 0x8000, 0);
+    int y0 = src_rect->y + (y_accum >> 16);
+    int y1 = src_rect->y + IM_MIN((y_accum >> 16) + 1, src_rect->h - 1);
+
+    if (src_img->pixfmt == PIXFORMAT_GRAYSCALE) {
+        uint8_t *row0 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src_img, y0) + src_rect->x;
+        uint8_t *row1 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src_img, y1) + src_rect->x;
+        uint8_t *dst8 = ((uint8_t *) out) + x_start;
+        int wy = (y_accum >> 8) & 0xff;
+
+        for (int x = 0, x_accum = (x_frac / 2) - 0x8000; x < dst_w; x++, x_accum += x_frac, dst8 += x_delta) {
+            int sx = IM_MAX(x_accum, 0);
+            int x0 = sx >> 16, x1 = IM_MIN(x0 + 1, x_end), wx = (sx >> 8) & 0xff;
+            int p0 = (row0[x0] << 8) + ((row0[x1] - row0[x0]) * wx);
+            int p1 = (row1[x0] << 8) + ((row1[x1] - row1[x0]) * wx);
+            *dst8 = ((p0 << 8) + ((p1 - p0) * wy)) >> 16;
+        }
+    } else {
+        uint16_t *row0 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(src_img, y0) + src_rect->x;
+        uint16_t *row1 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(src_img, y1) + src_rect->x;
+        uint16_t *dst16 = ((uint16_t *) out) + x_start;
+        uint32_t wy = (y_accum >> 11) & 0x1f;
+
+        for (int x = 0, x_accum = (x_frac / 2) - 0x8000; x < dst_w; x++, x_accum += x_frac, dst16 += x_delta) {
+            int sx = IM_MAX(x_accum, 0);
+            int x0 = sx >> 16, x1 = IM_MIN(x0 + 1, x_end);
+            uint32_t wx = (sx >> 11) & 0x1f;
+            // Spread the channels as (G << 16) | R | B so all three are interpolated at once.
+            uint32_t p00 = (row0[x0] | (row0[x0] << 16)) & 0x07e0f81f;
+            uint32_t p01 = (row0[x1] | (row0[x1] << 16)) & 0x07e0f81f;
+            uint32_t p10 = (row1[x0] | (row1[x0] << 16)) & 0x07e0f81f;
+            uint32_t p11 = (row1[x1] | (row1[x1] << 16)) & 0x07e0f81f;
+            uint32_t p0 = (((p00 * (32 - wx)) + (p01 * wx)) >> 5) & 0x07e0f81f;
+            uint32_t p1 = (((p10 * (32 - wx)) + (p11 * wx)) >> 5) & 0x07e0f81f;
+            uint32_t p = (((p0 * (32 - wy)) + (p1 * wy)) >> 5) & 0x07e0f81f;
+            *dst16 = p | (p >> 16);
+        }
+    }
+}
+
 int omv_gpu_draw_image(image_t *src_img,
                        rectangle_t *src_rect,
                        image_t *dst_img,
@@ -32,10 +125,20 @@ int omv_gpu_draw_image(image_t *src_img,
                        const uint16_t *color_palette,
                        const uint8_t *alpha_palette,
                        image_hint_t hint) {
-    OMV_PROFILE_START();
+    OMV_PROFILE_START(gpu_draw_image);
+
+    if ((dst_rect->w <= 0) || (dst_rect->h <= 0) || (src_rect->w <= 0) || (src_rect->h <= 0)) {
+        return -1;
+    }
+
+    // DMA2D cannot scale or mirror, so the CPU scales into tiles in the source pixel format which
+    // the DMA2D converts and blends, while the CPU scales the next tile.
+    bool tiled = (dst_rect->w != src_rect->w) || (dst_rect->h != src_rect->h) ||
+                 (hint & (IMAGE_HINT_HMIRROR | IMAGE_HINT_VFLIP));
 
     // DMA2D can only draw on RGB565 buffers and the destination/source buffers must be accessible by DMA.
-    if ((dst_img->pixfmt != PIXFORMAT_RGB565) || (!DMA_BUFFER(dst_img->data)) || (!DMA_BUFFER(src_img->data))) {
+    if ((dst_img->pixfmt != PIXFORMAT_RGB565) || (!DMA_BUFFER(dst_img->data)) ||
+        ((!tiled) && (!DMA_BUFFER(src_img->data)))) {
         return -1;
     }
 
@@ -46,17 +149,6 @@ int omv_gpu_draw_image(image_t *src_img,
         return -1;
     }
 
-    // DMA2D cannot scale so ensure that the source and destination rectangles are the same size.
-    // The bilinear/nearest-neighbor flag doesn't matter since we can't scale.
-    if ((dst_rect->w != src_rect->w) || (dst_rect->h != src_rect->h)) {
-        return -1;
-    }
-
-    // DMA2D cannot hmirror or vflip.
-    if (hint & (IMAGE_HINT_HMIRROR | IMAGE_HINT_VFLIP)) {
-        return -1;
-    }
-
     // DMA2D must always fetch the background on the F4 and F7 series so do this in software.
     #if defined(MCU_SERIES_F4) || defined(MCU_SERIES_F7)
     if (hint & IMAGE_HINT_BLACK_BACKGROUND) {
@@ -64,6 +156,20 @@ int omv_gpu_draw_image(image_t *src_img,
     }
     #endif
 
+    int bpp = (src_img->pixfmt == PIXFORMAT_GRAYSCALE) ? sizeof(uint8_t) : sizeof(uint16_t);
+    int tile_lines = dst_rect->h;
+    uint8_t *tiles[2] = { NULL, NULL };
+
+    if (tiled) {
+        tile_lines = IM_MIN(IM_MAX(OMV_GPU_TILE_SIZE / (dst_rect->w * bpp), 1), dst_rect->h);
+        tiles[0] = fb_alloc(tile_lines * dst_rect->w * bpp * 2, FB_ALLOC_CACHE_ALIGN);
+        tiles[1] = tiles[0] + (tile_lines * dst_rect->w * bpp);
+        if (!DMA_BUFFER(tiles[0])) {
+            fb_free();
+            return -1;
+        }
+    }
+
     DMA2D_HandleTypeDef dma2d = {};
 
     dma2d.Instance = DMA2D;
@@ -82,12 +188,16 @@ int omv_gpu_draw_image(image_t *src_img,
     }
     #endif
 
+    size_t dst_stride = IMAGE_RGB565_ROW_STRIDE(dst_img);
+    size_t src_stride = (src_img->pixfmt == PIXFORMAT_GRAYSCALE) ?
+                        IMAGE_GRAYSCALE_ROW_STRIDE(src_img) : IMAGE_RGB565_ROW_STRIDE(src_img);
+
     dma2d.Init.ColorMode = DMA2D_OUTPUT_RGB565;
-    dma2d.Init.OutputOffset = dst_img->w - dst_rect->w;
+    dma2d.Init.OutputOffset = (dst_stride / sizeof(uint16_t)) - dst_rect->w;
 
     HAL_DMA2D_Init(&dma2d);
 
-    dma2d.LayerCfg[0].InputOffset = dst_img->w - dst_rect->w;
+    dma2d.LayerCfg[0].InputOffset = (dst_stride / sizeof(uint16_t)) - dst_rect->w;
     dma2d.LayerCfg[0].InputColorMode = DMA2D_INPUT_RGB565;
     dma2d.LayerCfg[0].AlphaMode = DMA2D_REPLACE_ALPHA;
     dma2d.LayerCfg[0].InputAlpha = 0xff;
@@ -143,75 +253,155 @@ int omv_gpu_draw_image(image_t *src_img,
         dma2d.LayerCfg[1].AlphaMode = DMA2D_REPLACE_ALPHA;
     }
 
-    dma2d.LayerCfg[1].InputOffset = src_img->w - src_rect->w;
+    // Tiles are packed, the source is read in place otherwise.
+    dma2d.LayerCfg[1].InputOffset = tiled ? 0 : ((src_stride / bpp) - src_rect->w);
     dma2d.LayerCfg[1].InputAlpha = (alpha * 255) / 256;
 
     HAL_DMA2D_ConfigLayer(&dma2d, 1);
 
     uint16_t *dst16 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst_img, dst_rect->y) + dst_rect->x;
+    size_t dst_len = dst_rect->w * sizeof(uint16_t);
+    int32_t x_frac = (src_rect->w << 16) / dst_rect->w;
+    int32_t y_frac = (src_rect->h << 16) / dst_rect->h;
+    uint16_t *busy_dst16 = NULL;
+    int busy_lines = 0;
+
+    for (int y = 0, t = 0; y < dst_rect->h; y += tile_lines, t ^= 1) {
+        int lines = IM_MIN(tile_lines, dst_rect->h - y);
+        uint16_t *tile_dst16 = (uint16_t *) (((uint8_t *) dst16) + (y * dst_stride));
+        uint32_t src;
+
+        if (tiled) {
+            for (int i = 0; i < lines; i++) {
+                int dst_y = (hint & IMAGE_HINT_VFLIP) ? (dst_rect->h - 1 - (y + i)) : (y + i);
+                int32_t y_accum = (dst_y * y_frac) + ((hint & IMAGE_HINT_BILINEAR) ? (y_frac / 2) : 0);
+                omv_gpu_scale_row(src_img, src_rect, dst_rect->w, y_accum, x_frac, hint & IMAGE_HINT_BILINEAR,
+                                  hint & IMAGE_HINT_HMIRROR, tiles[t] + (i * dst_rect->w * bpp));
+            }
+            src = (uint32_t) tiles[t];
+            omv_gpu_clean_rows(tiles[t], 1, lines * dst_rect->w * bpp, 0, false);
+        } else {
+            uint8_t *src8 = src_img->data + (src_rect->y * src_stride) + (src_rect->x * bpp);
+            src = (uint32_t) src8;
+            omv_gpu_clean_rows(src8, lines, src_rect->w * bpp, src_stride, false);
+        }
 
-    #if __DCACHE_PRESENT
-    // Ensures any cached writes to dst16 are flushed.
-    uint16_t *dst16_tmp = dst16;
-    for (int i = 0; i < dst_rect->h; i++) {
-        SCB_CleanInvalidateDCache_by_Addr(dst16_tmp, dst_rect->w * sizeof(uint16_t));
-        dst16_tmp += dst_img->w;
-    }
-    #endif
+        // Wait for the previous tile, its source buffer is reused by the next one.
+        if (busy_dst16) {
+            HAL_DMA2D_PollForTransfer(&dma2d, 1000);
+            omv_gpu_invalidate_rows(busy_dst16, busy_lines, dst_len, dst_stride);
+        }
 
-    uint32_t src;
+        // Ensures any cached writes to the destination are flushed.
+        omv_gpu_clean_rows(tile_dst16, lines, dst_len, dst_stride, true);
 
-    if (src_img->pixfmt == PIXFORMAT_GRAYSCALE) {
-        uint8_t *src8 = IMAGE_COMPUTE_GRAYSCALE_PIXEL_ROW_PTR(src_img, src_rect->y) + src_rect->x;
-        src = (uint32_t) src8;
+        uint32_t dst = (uint32_t) tile_dst16;
 
-        #if __DCACHE_PRESENT
-        uint8_t *src8_tmp = src8;
-        for (int i = 0; i < src_rect->h; i++) {
-            SCB_CleanDCache_by_Addr(src8_tmp, src_rect->w);
-            src8_tmp += src_img->w;
+        #if defined(MCU_SERIES_H7)
+        if (hint & IMAGE_HINT_BLACK_BACKGROUND) {
+            dst = 0;
         }
         #endif
-    } else {
-        uint16_t *src16 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(src_img, src_rect->y) + src_rect->x;
-        src = (uint32_t) src16;
 
-        #if __DCACHE_PRESENT
-        uint16_t *src16_tmp = src16;
-        for (int i = 0; i < src_rect->h; i++) {
-            SCB_CleanDCache_by_Addr(src16_tmp, src_rect->w * sizeof(uint16_t));
-            src16_tmp += src_img->w;
-        }
-        #endif
+        HAL_DMA2D_BlendingStart(&dma2d, src, dst, (uint32_t) tile_dst16, dst_rect->w, lines);
+        busy_dst16 = tile_dst16;
+        busy_lines = lines;
     }
 
-    uint32_t dst = (uint32_t) dst16;
+    HAL_DMA2D_PollForTransfer(&dma2d, 1000);
+    // Ensures any cached reads to the destination are dropped.
+    omv_gpu_invalidate_rows(busy_dst16, busy_lines, dst_len, dst_stride);
 
-    #if defined(MCU_SERIES_H7)
-    if (hint & IMAGE_HINT_BLACK_BACKGROUND) {
-        dst = 0;
+    HAL_DMA2D_DeInit(&dma2d);
+
+    if (src_img->pixfmt == PIXFORMAT_GRAYSCALE) {
+        fb_free(); // clut
     }
-    #endif
 
-    HAL_DMA2D_BlendingStart(&dma2d, src, dst, (uint32_t) dst16, dst_rect->w, dst_rect->h);
-    HAL_DMA2D_PollForTransfer(&dma2d, 1000);
+    if (tiled) {
+        fb_free(); // tiles
+    }
 
-    #if __DCACHE_PRESENT
-    // Ensures any cached reads to dst16 are dropped.
-    dst16_tmp = dst16;
-    for (int i = 0; i < dst_rect->h; i++) {
-        SCB_InvalidateDCache_by_Addr(dst16_tmp, dst_rect->w * sizeof(uint16_t));
-        dst16_tmp += dst_img->w;
+    OMV_PROFILE_END(gpu_draw_image);
+    return 0;
+}
+
+int omv_gpu_fill_rect(image_t *dst_img, rectangle_t *rect, int color) {
+    if ((dst_img->pixfmt != PIXFORMAT_RGB565) || (!DMA_BUFFER(dst_img->data))) {
+        return -1;
     }
-    #endif
+
+    DMA2D_HandleTypeDef dma2d = {};
+    size_t dst_stride = IMAGE_RGB565_ROW_STRIDE(dst_img);
+
+    dma2d.Instance = DMA2D;
+    dma2d.Init.Mode = DMA2D_R2M;
+    dma2d.Init.ColorMode = DMA2D_OUTPUT_RGB565;
+    dma2d.Init.OutputOffset = (dst_stride / sizeof(uint16_t)) - rect->w;
+
+    HAL_DMA2D_Init(&dma2d);
+
+    uint16_t *dst16 = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(dst_img, rect->y) + rect->x;
+    size_t dst_len = rect->w * sizeof(uint16_t);
+
+    // The HAL converts the ARGB8888 color to the output format.
+    uint32_t argb = (0xff << 24) |
+                    (COLOR_RGB565_TO_R8(color) << 16) |
+                    (COLOR_RGB565_TO_G8(color) << 8) |
+                    COLOR_RGB565_TO_B8(color);
+
+    omv_gpu_clean_rows(dst16, rect->h, dst_len, dst_stride, true);
+    HAL_DMA2D_Start(&dma2d, argb, (uint32_t) dst16, rect->w, rect->h);
+    HAL_DMA2D_PollForTransfer(&dma2d, 1000);
+    omv_gpu_invalidate_rows(dst16, rect->h, dst_len, dst_stride);
 
     HAL_DMA2D_DeInit(&dma2d);
+    return 0;
+}
 
-    if (src_img->pixfmt == PIXFORMAT_GRAYSCALE) {
-        fb_free(); // clut
+int omv_gpu_copy(void *dst, size_t dst_stride, const void *src, size_t src_stride, size_t w, size_t h, size_t bpp) {
+    size_t len = w * bpp;
+
+    if ((!DMA_BUFFER(dst)) || (!DMA_BUFFER(src))) {
+        return -1;
     }
 
-    OMV_PROFILE_PRINT();
-    return 0;
+    // Rows are moved as ARGB8888 or RGB565 pixels, the widest unit that all addresses and
+    // lengths are aligned to, so the pixel size of the image doesn't matter.
+    uint32_t align = ((uint32_t) dst) | ((uint32_t) src) | dst_stride | src_stride | len;
+    size_t unit = (!(align & 3)) ? sizeof(uint32_t) : (!(align & 1)) ? sizeof(uint16_t) : 0;
+
+    if (!unit) {
+        return -1;
+    }
+
+    DMA2D_HandleTypeDef dma2d = {};
+
+    dma2d.Instance = DMA2D;
+    dma2d.Init.Mode = DMA2D_M2M;
+    dma2d.Init.ColorMode = (unit == sizeof(uint32_t)) ? DMA2D_OUTPUT_ARGB8888 : DMA2D_OUTPUT_RGB565;
+    dma2d.Init.OutputOffset = (dst_stride - len) / unit;
+
+    HAL_DMA2D_Init(&dma2d);
+
+    dma2d.LayerCfg[1].InputOffset = (src_stride - len) / unit;
+    dma2d.LayerCfg[1].InputColorMode = (unit == sizeof(uint32_t)) ? DMA2D_INPUT_ARGB8888 : DMA2D_INPUT_RGB565;
+    dma2d.LayerCfg[1].AlphaMode = DMA2D_NO_MODIF_ALPHA;
+
+    HAL_DMA2D_ConfigLayer(&dma2d, 1);
+
+    omv_gpu_clean_rows((void *) src, h, len, src_stride, false);
+    omv_gpu_clean_rows(dst, h, len, dst_stride, true);
+    HAL_DMA2D_Start(&dma2d, (uint32_t) src, (uint32_t) dst, len / unit, h);
+    HAL_StatusTypeDef status = HAL_DMA2D_PollForTransfer(&dma2d, 1000);
+    omv_gpu_invalidate_rows(dst, h, len, dst_stride);
+
+    HAL_DMA2D_DeInit(&dma2d);
+    return (status == HAL_OK) ? 0 : -1;
+}
+
+// DMA2D can't draw lines.
+int omv_gpu_draw_line(image_t *dst_img, int x0, int y0, int x1, int y1, int color, int thickness) {
+    return -1;
 }
 #endif // (OMV_GPU_ENABLE == 1)
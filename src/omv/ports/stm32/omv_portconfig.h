@@ -100,4 +100,10 @@ typedef I2C_HandleTypeDef *omv_i2c_dev_t;
 
 #define OMV_I2C_MAX_8BIT_XFER   (65536U - 16U)
 #define OMV_I2C_MAX_16BIT_XFER  (65536U - 8U)
+
+// The CSI driver supports sensors that output the window only (see sensor_t::set_windowing).
+#define OMV_CSI_HW_WINDOWING_ENABLE (1)
+
+// The CSI driver mirrors and flips lines while copying them, for sensors without these controls.
+#define OMV_CSI_LINE_FLIP_ENABLE    (1)
 #endif // __OMV_PORTCONFIG_H__
@@ -20,6 +20,10 @@
 #include "omv_gpio.h"
 #include "omv_i2c.h"
 #include "dma_utils.h"
+#include "omv_task.h"
+#include "py_cpufreq.h"
+#include "axiqos.h"
+#include "rtc.h"
 
 #define MDMA_BUFFER_SIZE         (64)
 #define DMA_MAX_XFER_SIZE        (0xFFFF * 4)
@@ -28,10 +32,20 @@
 #define SENSOR_TIMEOUT_MS        (3000)
 #define ARRAY_SIZE(a)            (sizeof(a) / sizeof((a)[0]))
 
+// The probe cache uses 4 RTC backup registers, which keep their state
+// across resets and standby (deep sleep) as long as VBAT is present.
+#ifndef OMV_CSI_PROBE_CACHE_BKP_REG
+#define OMV_CSI_PROBE_CACHE_BKP_REG (16)
+#endif
+#define PROBE_CACHE_MAGIC       (0x50524F42)
+#define PROBE_CACHE_WORDS       (sizeof(sensor_probe_cache_t) / 4)
+
 sensor_t sensor = {};
 static TIM_HandleTypeDef TIMHandle = {};
 static DMA_HandleTypeDef DMAHandle = {};
 static DCMI_HandleTypeDef DCMIHandle = {};
+// When the last frame was returned, used to measure the per-frame workload.
+static uint32_t snapshot_end_us;
 #if defined(OMV_MDMA_CHANNEL_DCMI_0)
 static MDMA_HandleTypeDef DCMI_MDMA_Handle0;
 static MDMA_HandleTypeDef DCMI_MDMA_Handle1;
@@ -40,7 +54,40 @@ static MDMA_HandleTypeDef DCMI_MDMA_Handle1;
 extern uint8_t _line_buf;
 extern uint32_t hal_get_exti_gpio(uint32_t line);
 
+#if (OMV_JPEG_CODEC_ENABLE == 1)
+#define JPEG_CAPTURE_ALIGN(x)    (((x) + __SCB_DCACHE_LINE_SIZE - 1) & ~(__SCB_DCACHE_LINE_SIZE - 1))
+
+// JPEG capture mode compresses frames with the JPEG core while they are being received, so the
+// raw frame is never stored. Lines are copied into two strips of JPEG_MCU_H lines at the end of
+// the frame buffer. While one strip fills up, the MCUs of the other strip are converted a part
+// per line and queued to the JPEG core, which writes the JPEG image to the frame buffer.
+typedef enum {
+    JPEG_CAPTURE_IDLE,
+    JPEG_CAPTURE_ACTIVE,    // Receiving the frame.
+    JPEG_CAPTURE_FINISHING, // Waiting on the JPEG core to finish the frame.
+} jpeg_capture_state_t;
+
+static struct {
+    volatile jpeg_capture_state_t state;
+    volatile bool overflow;
+    uint32_t strip_size;
+    image_t strip[2];
+} jpeg_capture;
+#endif
+
+// Window position requested by sensor_move_windowing(), applied between frames.
+static struct {
+    volatile bool pending;
+    int32_t x;
+    int32_t y;
+} window_move;
+
 void DCMI_IRQHandler(void) {
+    #if defined(MCU_SERIES_H7)
+    if (DCMI->MISR & DCMI_MIS_OVR_MIS) {
+        axiqos_stats.dcmi_overruns += 1;
+    }
+    #endif
     HAL_DCMI_IRQHandler(&DCMIHandle);
 }
 
@@ -106,12 +153,51 @@ void sensor_init0() {
     }
 
     sensor.disable_delays = false;
+    sensor.jpeg_capture = 0;
 
     // Disable VSYNC IRQ and callback
     sensor_set_vsync_callback(NULL);
 
     // Disable Frame callback.
     sensor_set_frame_callback(NULL);
+
+    // Disable Line callback.
+    sensor_set_line_callback(NULL, 0, NULL);
+
+    // Disable the external trigger.
+    sensor_set_ext_trigger(false);
+}
+
+bool sensor_probe_cache_load(sensor_probe_cache_t *cache) {
+    uint32_t words[PROBE_CACHE_WORDS];
+    uint32_t check = PROBE_CACHE_MAGIC;
+
+    for (int i = 0; i < PROBE_CACHE_WORDS; i++) {
+        words[i] = HAL_RTCEx_BKUPRead(&RTCHandle, OMV_CSI_PROBE_CACHE_BKP_REG + i);
+        check ^= words[i];
+    }
+
+    if (check != HAL_RTCEx_BKUPRead(&RTCHandle, OMV_CSI_PROBE_CACHE_BKP_REG + PROBE_CACHE_WORDS)) {
+        return false;
+    }
+
+    memcpy(cache, words, sizeof(*cache));
+    return true;
+}
+
+void sensor_probe_cache_store(const sensor_probe_cache_t *cache) {
+    uint32_t words[PROBE_CACHE_WORDS];
+    uint32_t check = PROBE_CACHE_MAGIC;
+
+    memcpy(words, cache, sizeof(*cache));
+    HAL_PWR_EnableBkUpAccess();
+
+    for (int i = 0; i < PROBE_CACHE_WORDS; i++) {
+        HAL_RTCEx_BKUPWrite(&RTCHandle, OMV_CSI_PROBE_CACHE_BKP_REG + i, words[i]);
+        check ^= words[i];
+    }
+
+    HAL_RTCEx_BKUPWrite(&RTCHandle, OMV_CSI_PROBE_CACHE_BKP_REG + PROBE_CACHE_WORDS, check);
 }
 
 int sensor_init() {
@@ -220,9 +306,18 @@ int sensor_config(sensor_config_t config) {
     return 0;
 }
 
-int sensor_abort(bool fifo_flush, bool in_irq) {
-    // This stops the DCMI hardware from generating DMA requests immediately and then stops the DMA
-    // hardware. Note that HAL_DMA_Abort is a blocking operation. Do not use this in an interrupt.
+// Returns the frames the DCMI skips after each frame read. Frames the frame rate would drop are
+// skipped by the DCMI so they don't generate DMA requests. Only works in continuous mode.
+static int sensor_get_dcmi_frame_skip(sensor_t *sensor) {
+    if ((sensor->pixformat == PIXFORMAT_JPEG) && (sensor->chip_id == OV2640_ID)) {
+        return 0;
+    }
+    return sensor_get_frame_skip();
+}
+
+// This stops the DCMI hardware from generating DMA requests immediately and then stops the DMA
+// hardware. Note that HAL_DMA_Abort is a blocking operation. Do not use this in an interrupt.
+static void sensor_stop_capture(bool in_irq) {
     if (DCMI->CR & DCMI_CR_ENABLE) {
         DCMI->CR &= ~DCMI_CR_ENABLE;
         if (in_irq) {
@@ -245,8 +340,24 @@ int sensor_abort(bool fifo_flush, bool in_irq) {
         sensor.drop_frame = false;
         sensor.last_frame_ms = 0;
         sensor.last_frame_ms_valid = false;
+        sensor.last_frame_us = 0;
+    }
+}
+
+int sensor_abort(bool fifo_flush, bool in_irq) {
+    sensor_stop_capture(in_irq);
+
+    // Reconfiguring the capture from the thread drops any pending window move.
+    if (!in_irq) {
+        window_move.pending = false;
     }
 
+    #if (OMV_JPEG_CODEC_ENABLE == 1)
+    // Stop compressing the frame that was being captured.
+    jpeg_compress_lines_abort();
+    jpeg_capture.state = JPEG_CAPTURE_IDLE;
+    #endif
+
     if (fifo_flush) {
         framebuffer_flush_buffers(true);
     } else if (!sensor.disable_full_flush) {
@@ -373,12 +484,107 @@ int sensor_set_vsync_callback(vsync_cb_t vsync_cb) {
     return 0;
 }
 
+#if defined(OMV_CSI_TRIGGER_PIN) && defined(OMV_CSI_FSYNC_PIN)
+static void sensor_trigger_callback(void *data) {
+    sensor.trigger_us = mp_hal_ticks_us();
+    // Start the exposure. FSYNC is released on the first line of the frame.
+    omv_gpio_write(OMV_CSI_FSYNC_PIN, 1);
+}
+#endif
+
+int sensor_set_ext_trigger(bool enable) {
+    #if defined(OMV_CSI_TRIGGER_PIN) && defined(OMV_CSI_FSYNC_PIN)
+    if (enable && (!sensor.frame_sync)) {
+        return SENSOR_ERROR_CTL_UNSUPPORTED;
+    }
+
+    if (sensor.ext_trigger) {
+        omv_gpio_irq_enable(OMV_CSI_TRIGGER_PIN, false);
+        omv_gpio_write(OMV_CSI_FSYNC_PIN, 0);
+    }
+
+    sensor.ext_trigger = enable;
+
+    if (enable) {
+        omv_gpio_config(OMV_CSI_TRIGGER_PIN, OMV_GPIO_MODE_IT_RISE, OMV_GPIO_PULL_DOWN, OMV_GPIO_SPEED_LOW, -1);
+        omv_gpio_irq_register(OMV_CSI_TRIGGER_PIN, sensor_trigger_callback, NULL);
+        omv_gpio_irq_enable(OMV_CSI_TRIGGER_PIN, true);
+    }
+    return 0;
+    #else
+    if (enable) {
+        return SENSOR_ERROR_CTL_UNSUPPORTED;
+    }
+    sensor.ext_trigger = false;
+    return 0;
+    #endif
+}
+
+#if defined(OMV_CSI_MD_INT_PIN)
+static volatile bool sensor_motion = false;
+
+static void sensor_motion_callback(void *data) {
+    sensor_motion = true;
+}
+
+int sensor_wait_motion(uint32_t timeout_ms) {
+    int ret = 0;
+
+    // Nothing is captured while waiting, the sensor compares the frames on its own.
+    sensor_abort(true, false);
+
+    if (sensor_ioctl(IOCTL_HIMAX_MD_LOW_POWER, true) != 0) {
+        return SENSOR_ERROR_CTL_UNSUPPORTED;
+    }
+
+    sensor_motion = false;
+    omv_gpio_config(OMV_CSI_MD_INT_PIN, OMV_GPIO_MODE_IT_RISE, OMV_GPIO_PULL_DOWN, OMV_GPIO_SPEED_LOW, -1);
+    omv_gpio_irq_register(OMV_CSI_MD_INT_PIN, sensor_motion_callback, NULL);
+    omv_gpio_irq_enable(OMV_CSI_MD_INT_PIN, true);
+
+    // Clear the interrupt after the IRQ is enabled so the next rising edge isn't missed.
+    sensor_ioctl(IOCTL_HIMAX_MD_CLEAR);
+
+    // SysTick wakes up the core every ms, which allows us to timeout.
+    for (uint32_t tick_start = HAL_GetTick(); !sensor_motion; ) {
+        if (timeout_ms && ((HAL_GetTick() - tick_start) > timeout_ms)) {
+            ret = SENSOR_ERROR_CAPTURE_TIMEOUT;
+            break;
+        }
+        __WFI();
+    }
+
+    omv_gpio_irq_enable(OMV_CSI_MD_INT_PIN, false);
+
+    if (sensor_ioctl(IOCTL_HIMAX_MD_LOW_POWER, false) != 0) {
+        ret = SENSOR_ERROR_CTL_FAILED;
+    }
+
+    sensor_ioctl(IOCTL_HIMAX_MD_CLEAR);
+    return ret;
+}
+#endif
+
+// Returns the window offset in the sensor output, which starts at the window if the sensor crops it.
+static uint32_t get_window_x() {
+    return sensor.hw_window ? 0 : MAIN_FB()->x;
+}
+
+static uint32_t get_window_y() {
+    return sensor.hw_window ? 0 : MAIN_FB()->y;
+}
+
+// Returns the width of the sensor output.
+static uint32_t get_output_width() {
+    return sensor.hw_window ? MAIN_FB()->u : resolution[sensor.framesize][0];
+}
+
 // If we are cropping the image by more than 1 word in width we can align the line start to
 // a word address to improve copy performance. Do not crop by more than 1 word as this will
 // result in less time between DMA transfers complete interrupts on 16-byte boundaries.
 static uint32_t get_dcmi_hw_crop(uint32_t bytes_per_pixel) {
-    uint32_t byte_x_offset = (MAIN_FB()->x * bytes_per_pixel) % sizeof(uint32_t);
-    uint32_t width_remainder = (resolution[sensor.framesize][0] - (MAIN_FB()->x + MAIN_FB()->u)) * bytes_per_pixel;
+    uint32_t byte_x_offset = (get_window_x() * bytes_per_pixel) % sizeof(uint32_t);
+    uint32_t width_remainder = (get_output_width() - (get_window_x() + MAIN_FB()->u)) * bytes_per_pixel;
     uint32_t x_crop = 0;
 
     if (byte_x_offset && (width_remainder >= (sizeof(uint32_t) - byte_x_offset))) {
@@ -388,11 +594,329 @@ static uint32_t get_dcmi_hw_crop(uint32_t bytes_per_pixel) {
     return x_crop;
 }
 
+static bool sensor_jpeg_capture_enabled() {
+    #if (OMV_JPEG_CODEC_ENABLE == 1)
+    return sensor.jpeg_capture && (!sensor.transpose) && (!sensor.hmirror_copy) && (!sensor.vflip_copy) &&
+           ((sensor.pixformat == PIXFORMAT_GRAYSCALE) ||
+            (sensor.pixformat == PIXFORMAT_RGB565) ||
+            (sensor.pixformat == PIXFORMAT_YUV422));
+    #else
+    return false;
+    #endif
+}
+
+// Returns true if lines can be moved to the frame buffer by MDMA without line interrupts.
+static bool sensor_line_offload_enabled() {
+    return (!sensor.transpose) && (!sensor.hmirror_copy) && (!sensor.vflip_copy) &&
+           (!sensor_jpeg_capture_enabled()) && (sensor.line_callback == NULL);
+}
+
+// Returns true if the line callback can be called, the lines have to be stored in order.
+static bool sensor_line_callback_enabled() {
+    return sensor.line_callback && (!sensor.transpose) && (!sensor.vflip_copy);
+}
+
+int sensor_set_line_callback(line_cb_t line_cb, uint32_t lines, void *arg) {
+    if (line_cb && (!lines)) {
+        return SENSOR_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Disable any ongoing frame capture.
+    sensor_abort(true, false);
+
+    sensor.line_callback = line_cb;
+    sensor.line_callback_arg = arg;
+    sensor.line_callback_lines = lines;
+    return 0;
+}
+
+#if (OMV_JPEG_CODEC_ENABLE == 1)
+int sensor_set_jpeg_capture(int quality) {
+    if ((quality < 0) || (quality > 100)) {
+        return SENSOR_ERROR_INVALID_ARGUMENT;
+    }
+
+    // Check if the value has changed.
+    if (sensor.jpeg_capture == quality) {
+        return 0;
+    }
+
+    // Disable any ongoing frame capture.
+    sensor_abort(true, false);
+
+    if (quality && (sensor.transpose || (sensor.pixformat == PIXFORMAT_BAYER) ||
+                    (sensor.pixformat == PIXFORMAT_JPEG))) {
+        return SENSOR_ERROR_PIXFORMAT_UNSUPPORTED;
+    }
+
+    // Set the new control value.
+    sensor.jpeg_capture = quality;
+    return 0;
+}
+
+// Hands the frame off to snapshot.
+static void sensor_jpeg_capture_commit(uint32_t size, bool overflow) {
+    vbuffer_t *buffer = framebuffer_get_tail(FB_PEEK);
+
+    jpeg_capture.state = JPEG_CAPTURE_IDLE;
+
+    // Note that peeking resets the buffer state if the frame after this one was dropped.
+    if (buffer) {
+        buffer->offset = size;
+        buffer->jpeg_buffer_overflow = overflow;
+    }
+
+    framebuffer_get_tail(FB_NO_FLAGS);
+
+    if (sensor.frame_callback) {
+        sensor.frame_callback();
+    }
+}
+
+// Called from the JPEG interrupts when the JPEG image is finished or does not fit.
+static void sensor_jpeg_capture_done(uint32_t size, bool overflow) {
+    mp_uint_t irq_state = disable_irq();
+
+    if (jpeg_capture.state == JPEG_CAPTURE_ACTIVE) {
+        // The rest of the frame still has to be received.
+        jpeg_capture.overflow = true;
+    } else if (jpeg_capture.state == JPEG_CAPTURE_FINISHING) {
+        sensor_jpeg_capture_commit(size, overflow);
+    }
+
+    enable_irq(irq_state);
+}
+
+static void sensor_jpeg_capture_abort() {
+    jpeg_compress_lines_abort();
+    jpeg_capture.state = JPEG_CAPTURE_IDLE;
+}
+
+// Returns true if the JPEG core is not available for this frame.
+static bool sensor_jpeg_capture_start(vbuffer_t *buffer, uint32_t bytes_per_pixel) {
+    image_t src = {
+        .w = MAIN_FB()->u,
+        .h = MAIN_FB()->v,
+        .pixfmt = sensor.pixformat,
+    };
+
+    if (sensor.pixformat == PIXFORMAT_YUV422) {
+        src.pixfmt = PIXFORMAT_YUV;
+        src.subfmt_id = sensor.yuv_format;
+        src.pixfmt = imlib_yuv_shift(src.pixfmt, MAIN_FB()->x);
+    }
+
+    // The frame buffer is cache aligned. The JPEG image goes at the start and the MCU rows and
+    // strips go at the end.
+    uint32_t size = framebuffer_get_buffer_size() & ~(__SCB_DCACHE_LINE_SIZE - 1);
+    uint32_t mcu_size = JPEG_CAPTURE_ALIGN(jpeg_compress_lines_buffer_size(&src, sensor.jpeg_capture));
+    jpeg_capture.strip_size = JPEG_CAPTURE_ALIGN(src.w * bytes_per_pixel * JPEG_MCU_H);
+    uint32_t scratch_size = mcu_size + (jpeg_capture.strip_size * 2);
+
+    for (int i = 0; i < 2; i++) {
+        jpeg_capture.strip[i].w = src.w;
+        jpeg_capture.strip[i].h = JPEG_MCU_H;
+        jpeg_capture.strip[i].pixfmt = src.pixfmt;
+        jpeg_capture.strip[i].data = buffer->data + size - (jpeg_capture.strip_size * (2 - i));
+    }
+
+    // The frame is received anyway and reported as a JPEG overflow if there's no space.
+    jpeg_capture.overflow = size <= scratch_size;
+
+    if (!jpeg_capture.overflow) {
+        image_t dst = {
+            .w = src.w,
+            .h = src.h,
+            .pixfmt = PIXFORMAT_JPEG,
+            .size = size - scratch_size,
+            .data = buffer->data,
+        };
+
+        if (jpeg_compress_lines_start(&src, &dst, sensor.jpeg_capture,
+                                      buffer->data + size - scratch_size, sensor_jpeg_capture_done)) {
+            return true;
+        }
+    }
+
+    jpeg_capture.state = JPEG_CAPTURE_ACTIVE;
+    return false;
+}
+
+// Waits for the line copies into the strips to finish and drops stale cache lines.
+static void sensor_jpeg_capture_sync() {
+    #if defined(OMV_MDMA_CHANNEL_DCMI_0)
+    while ((DCMI_MDMA_Handle0.Instance->CCR & MDMA_CCR_EN) || (DCMI_MDMA_Handle1.Instance->CCR & MDMA_CCR_EN)) {
+    }
+    #endif
+
+    for (int i = 0; i < 2; i++) {
+        SCB_InvalidateDCache_by_Addr((uint32_t *) jpeg_capture.strip[i].data, jpeg_capture.strip_size);
+    }
+}
+
+// Converts part of the MCU row of the strip at y_offset. The frame is dropped if the
+// JPEG core can't keep up.
+static void sensor_jpeg_capture_put(int y_offset, int part) {
+    image_t *strip = &jpeg_capture.strip[(y_offset / JPEG_MCU_H) % 2];
+
+    if ((!jpeg_capture.overflow) && jpeg_compress_lines_put(strip, y_offset, part, JPEG_MCU_H)) {
+        mp_uint_t irq_state = disable_irq();
+
+        // The encoder also stops when the JPEG image overflows.
+        if (!jpeg_capture.overflow) {
+            sensor_jpeg_capture_abort();
+            sensor.drop_frame = true;
+        }
+
+        enable_irq(irq_state);
+    }
+}
+
+static void sensor_jpeg_capture_line(vbuffer_t *buffer, uint8_t *src, uint32_t bytes_per_pixel) {
+    // The JPEG core is still working on the previous frame.
+    if (jpeg_capture.state == JPEG_CAPTURE_FINISHING) {
+        sensor.drop_frame = true;
+        return;
+    }
+
+    if ((jpeg_capture.state == JPEG_CAPTURE_IDLE) && sensor_jpeg_capture_start(buffer, bytes_per_pixel)) {
+        sensor.drop_frame = true;
+        return;
+    }
+
+    int line = buffer->offset++;
+    int part = line % JPEG_MCU_H;
+    image_t *strip = &jpeg_capture.strip[(line / JPEG_MCU_H) % 2];
+
+    // The last line of the previous strip has to land before it's converted.
+    if (!part) {
+        sensor_jpeg_capture_sync();
+    }
+
+    #if defined(OMV_MDMA_CHANNEL_DCMI_0)
+    sensor_copy_line((line % 2) ? &DCMI_MDMA_Handle1 : &DCMI_MDMA_Handle0, src,
+                     strip->data + (MAIN_FB()->u * bytes_per_pixel * part));
+    #else
+    sensor_copy_line(NULL, src, strip->data + (MAIN_FB()->u * bytes_per_pixel * part));
+    #endif
+
+    if (line >= JPEG_MCU_H) {
+        sensor_jpeg_capture_put(line - part - JPEG_MCU_H, part);
+    }
+}
+
+// Converts the remaining MCU rows at the end of the frame. The frame is handed off once the
+// JPEG core is done with it.
+static void sensor_jpeg_capture_end(vbuffer_t *buffer) {
+    int h = buffer ? buffer->offset : 0;
+
+    // Lines went missing.
+    if (h != MAIN_FB()->v) {
+        sensor.drop_frame = true;
+        return;
+    }
+
+    int last = ((h - 1) / JPEG_MCU_H) * JPEG_MCU_H;
+
+    sensor_jpeg_capture_sync();
+
+    // The parts of the previous row that were not converted while receiving the last row.
+    for (int part = h - last; last && (part < JPEG_MCU_H); part++) {
+        sensor_jpeg_capture_put(last - JPEG_MCU_H, part);
+    }
+
+    for (int part = 0; part < JPEG_MCU_H; part++) {
+        sensor_jpeg_capture_put(last, part);
+    }
+
+    mp_uint_t irq_state = disable_irq();
+
+    if (sensor.drop_frame) {
+        // The JPEG core fell behind.
+    } else if (jpeg_capture.overflow) {
+        sensor_jpeg_capture_commit(0, true);
+    } else {
+        jpeg_capture.state = JPEG_CAPTURE_FINISHING;
+    }
+
+    enable_irq(irq_state);
+}
+#endif
+
+// Applies a pending window move. If the DCMI crop can be updated in place the capture continues
+// with the next frame, otherwise it's stopped and the next snapshot restarts it with the new crop.
+static void sensor_apply_window_move(bool in_irq) {
+    if (!window_move.pending) {
+        return;
+    }
+
+    window_move.pending = false;
+
+    uint32_t bytes_per_pixel = sensor_get_src_bpp();
+    uint32_t old_x_crop = get_dcmi_hw_crop(bytes_per_pixel);
+
+    MAIN_FB()->x = window_move.x;
+    MAIN_FB()->y = window_move.y;
+
+    if (DCMI->CR & DCMI_CR_ENABLE) {
+        uint32_t x_crop = get_dcmi_hw_crop(bytes_per_pixel);
+        // The DMA line width is one word shorter with an alignment crop, so that can't change.
+        if ((!x_crop) == (!old_x_crop)) {
+            DCMI->CWSTRTR = x_crop | (get_window_y() << DCMI_CWSTRT_VST_Pos);
+        } else {
+            sensor_stop_capture(in_irq);
+        }
+    }
+}
+
+int sensor_move_windowing(int x, int y) {
+    if (sensor.framesize == FRAMESIZE_INVALID) {
+        return SENSOR_ERROR_INVALID_FRAMESIZE;
+    }
+
+    if (sensor.pixformat == PIXFORMAT_JPEG) {
+        return SENSOR_ERROR_PIXFORMAT_UNSUPPORTED;
+    }
+
+    if ((x < 0) || (y < 0) ||
+        ((x + MAIN_FB()->u) > resolution[sensor.framesize][0]) ||
+        ((y + MAIN_FB()->v) > resolution[sensor.framesize][1])) {
+        return SENSOR_ERROR_INVALID_WINDOW;
+    }
+
+    window_move.pending = false;
+
+    if ((MAIN_FB()->x == x) && (MAIN_FB()->y == y)) {
+        return 0;
+    }
+
+    // If the sensor outputs the window it's moved on the sensor, the DCMI crop doesn't change.
+    if (sensor.hw_window) {
+        if (sensor.set_windowing(&sensor, x, y, MAIN_FB()->u, MAIN_FB()->v) != 0) {
+            return sensor_set_windowing(x, y, MAIN_FB()->u, MAIN_FB()->v);
+        }
+        MAIN_FB()->x = x;
+        MAIN_FB()->y = y;
+        return 0;
+    }
+
+    window_move.x = x;
+    window_move.y = y;
+    window_move.pending = true;
+
+    // Nothing is being captured, so the window can be moved now.
+    if (!(DCMI->CR & DCMI_CR_ENABLE)) {
+        sensor_apply_window_move(false);
+    }
+
+    return 0;
+}
+
 // Stop allowing new data in on the end of the frame and let snapshot know that the frame has been
 // received. Note that DCMI_DMAConvCpltUser() is called before DCMI_IT_FRAME is enabled by
 // DCMI_DMAXferCplt() so this means that the last line of data is *always* transferred before
 // moving the tail to the next buffer.
-void HAL_DCMI_FrameEventCallback(DCMI_HandleTypeDef *hdcmi) {
+static void sensor_frame_event() {
     // This can be executed at any time since this interrupt has a higher priority than DMA2_Stream1_IRQn.
     #if defined(OMV_MDMA_CHANNEL_DCMI_0)
     // Clear out any stale flags.
@@ -403,8 +927,24 @@ void HAL_DCMI_FrameEventCallback(DCMI_HandleTypeDef *hdcmi) {
 
     // Reset DCMI_DMAConvCpltUser frame drop state.
     sensor.first_line = false;
+
+    #if (OMV_JPEG_CODEC_ENABLE == 1)
+    // In JPEG capture mode the frame is handed off once it has been compressed.
+    if ((!sensor.drop_frame) && (jpeg_capture.state == JPEG_CAPTURE_ACTIVE)) {
+        sensor_jpeg_capture_end(framebuffer_get_tail(FB_PEEK));
+        if (!sensor.drop_frame) {
+            return;
+        }
+    }
+    #endif
+
     if (sensor.drop_frame) {
         sensor.drop_frame = false;
+        #if (OMV_JPEG_CODEC_ENABLE == 1)
+        if (jpeg_capture.state == JPEG_CAPTURE_ACTIVE) {
+            sensor_jpeg_capture_abort();
+        }
+        #endif
         // If the frame was dropped, the buffer will not change, so its state
         // must be reset.
         vbuffer_t *buffer = framebuffer_get_tail(FB_PEEK);
@@ -421,10 +961,22 @@ void HAL_DCMI_FrameEventCallback(DCMI_HandleTypeDef *hdcmi) {
     }
 }
 
+void HAL_DCMI_FrameEventCallback(DCMI_HandleTypeDef *hdcmi) {
+    sensor_frame_event();
+
+    // The frame has been received, so a window move can't tear it.
+    sensor_apply_window_move(true);
+}
+
 #if defined(OMV_MDMA_CHANNEL_DCMI_0)
-int sensor_dma_memcpy(void *dma, void *dst, void *src, int bpp, bool transposed) {
+int sensor_dma_memcpy(void *dma, void *dst, void *src, int bpp, bool transposed, bool reversed) {
     MDMA_HandleTypeDef *handle = dma;
 
+    // No MDMA channel, the line is copied by the CPU.
+    if (handle == NULL) {
+        return -1;
+    }
+
     // Drop the frame if MDMA is not keeping up as the image will be corrupt.
     if (handle->Instance->CCR & MDMA_CCR_EN) {
         sensor.drop_frame = true;
@@ -432,7 +984,7 @@ int sensor_dma_memcpy(void *dma, void *dst, void *src, int bpp, bool transposed)
     }
 
     // If MDMA is still running from a previous transfer HAL_MDMA_Start() will disable that transfer
-    // and start a new transfer.
+    // and start a new transfer. Reversed lines only differ in the channel config (see mdma_config).
     __HAL_UNLOCK(handle);
     handle->State = HAL_MDMA_STATE_READY;
     HAL_MDMA_Start(handle,
@@ -454,7 +1006,7 @@ void DCMI_DMAConvCpltUser(uint32_t addr) {
         // If we're dropping a frame in full offload mode it's safe to disable this interrupt saving
         // ourselves from having to service the DMA complete callback.
         #if defined(OMV_MDMA_CHANNEL_DCMI_0)
-        if (!sensor.transpose) {
+        if (sensor_line_offload_enabled()) {
             HAL_NVIC_DisableIRQ(DMA2_Stream1_IRQn);
         }
         #endif
@@ -470,6 +1022,15 @@ void DCMI_DMAConvCpltUser(uint32_t addr) {
         return;
     }
 
+    #if defined(OMV_CSI_TRIGGER_PIN) && defined(OMV_CSI_FSYNC_PIN)
+    // Tag the frame with its trigger and release FSYNC on the first line so that the next
+    // trigger can start the next exposure while this frame is being read out.
+    if (sensor.ext_trigger && (buffer->offset == 0)) {
+        buffer->trigger_us = sensor.trigger_us;
+        omv_gpio_write(OMV_CSI_FSYNC_PIN, 0);
+    }
+    #endif
+
     // We are transferring the image from the DCMI hardware to line buffers so that we have more
     // control to post process the image data before writing it to the frame buffer. This requires
     // more CPU, but, allows us to crop and rotate the image as the data is received.
@@ -523,23 +1084,30 @@ void DCMI_DMAConvCpltUser(uint32_t addr) {
     // DCMI_DMAXferCplt in the HAL DCMI driver always calls DCMI_DMAConvCpltUser with the other
     // MAR register. So, we have to fix the address in full MDMA offload mode...
     #if defined(OMV_MDMA_CHANNEL_DCMI_0)
-    if (!sensor.transpose) {
+    if (sensor_line_offload_enabled()) {
         addr = (uint32_t) &_line_buf;
     }
     #endif
 
     uint32_t bytes_per_pixel = sensor_get_src_bpp();
-    uint8_t *src = ((uint8_t *) addr) + (MAIN_FB()->x * bytes_per_pixel) - get_dcmi_hw_crop(bytes_per_pixel);
+    uint8_t *src = ((uint8_t *) addr) + (get_window_x() * bytes_per_pixel) - get_dcmi_hw_crop(bytes_per_pixel);
     uint8_t *dst = buffer->data;
 
     if (sensor.pixformat == PIXFORMAT_GRAYSCALE) {
         bytes_per_pixel = sizeof(uint8_t);
     }
 
+    #if (OMV_JPEG_CODEC_ENABLE == 1)
+    if (sensor_jpeg_capture_enabled()) {
+        sensor_jpeg_capture_line(buffer, src, bytes_per_pixel);
+        return;
+    }
+    #endif
+
     // For all non-JPEG and non-transposed modes we can completely offload image capture to MDMA
     // and we do not need to receive any line interrupts for the rest of the frame until it ends.
     #if defined(OMV_MDMA_CHANNEL_DCMI_0)
-    if (!sensor.transpose) {
+    if (sensor_line_offload_enabled()) {
         // NOTE: We're starting MDMA here because it gives the maximum amount of time before we
         // have to drop the frame if there's no space. If you use the FRAME/VSYNC callbacks then
         // you will have to drop the frame earlier than necessary if there's no space resulting
@@ -560,20 +1128,42 @@ void DCMI_DMAConvCpltUser(uint32_t addr) {
     }
     #endif
 
+    // Flipped images are written from the last row.
+    uint32_t row = buffer->offset++;
+    if (sensor.vflip_copy) {
+        row = MAIN_FB()->v - row - 1;
+    }
+
     if (!sensor.transpose) {
-        dst += MAIN_FB()->u * bytes_per_pixel * buffer->offset++;
+        dst += MAIN_FB()->u * bytes_per_pixel * row;
     } else {
-        dst += bytes_per_pixel * buffer->offset++;
+        dst += bytes_per_pixel * row;
     }
 
     #if defined(OMV_MDMA_CHANNEL_DCMI_0)
     // We're using two handles to give each channel the maximum amount of time possible to do the line
     // transfer. In most situations only one channel will be running at a time. However, if SDRAM is
     // backedup we don't have to disable the channel if it is flushing trailing data to SDRAM.
-    sensor_copy_line((buffer->offset % 2) ? &DCMI_MDMA_Handle1 : &DCMI_MDMA_Handle0, src, dst);
+    // With a line callback the CPU copies the line, so it's in the frame buffer for the callback.
+    if (sensor_line_callback_enabled()) {
+        sensor_copy_line(NULL, src, dst);
+    } else {
+        sensor_copy_line((buffer->offset % 2) ? &DCMI_MDMA_Handle1 : &DCMI_MDMA_Handle0, src, dst);
+    }
     #else
     sensor_copy_line(NULL, src, dst);
     #endif
+
+    // Call the line callback once a strip is complete, or at the last line of the frame.
+    if (sensor_line_callback_enabled()) {
+        uint32_t strip_lines = sensor.line_callback_lines;
+        if (((buffer->offset % strip_lines) == 0) || (buffer->offset == MAIN_FB()->v)) {
+            uint32_t lines = buffer->offset - (((buffer->offset - 1) / strip_lines) * strip_lines);
+            uint32_t line = buffer->offset - lines;
+            sensor.line_callback(buffer->data + (line * MAIN_FB()->u * bytes_per_pixel),
+                                 line, lines, sensor.line_callback_arg);
+        }
+    }
 }
 
 #if defined(OMV_MDMA_CHANNEL_DCMI_0)
@@ -597,12 +1187,15 @@ static void mdma_config(MDMA_InitTypeDef *init, sensor_t *sensor, uint32_t bytes
         init->Endianness = MDMA_LITTLE_ENDIANNESS_PRESERVE;
     }
 
-    uint32_t line_offset_bytes = (MAIN_FB()->x * bytes_per_pixel) - get_dcmi_hw_crop(bytes_per_pixel);
+    uint32_t line_offset_bytes = (get_window_x() * bytes_per_pixel) - get_dcmi_hw_crop(bytes_per_pixel);
     uint32_t line_width_bytes = MAIN_FB()->u * bytes_per_pixel;
 
+    // Transposed lines are written one pixel per block down a column, or up it if mirrored.
     if (sensor->transpose) {
         line_width_bytes = bytes_per_pixel;
-        init->DestBlockAddressOffset = (MAIN_FB()->v - 1) * bytes_per_pixel;
+        init->DestBlockAddressOffset = (sensor->hmirror_copy ? -(MAIN_FB()->v + 1) : (MAIN_FB()->v - 1)) * bytes_per_pixel;
+    } else if (sensor->hmirror_copy) {
+        line_width_bytes = bytes_per_pixel;
     }
 
     // YUV422 Source -> Y Destination
@@ -647,6 +1240,12 @@ static void mdma_config(MDMA_InitTypeDef *init, sensor_t *sensor, uint32_t bytes
         init->SourceInc = MDMA_SRC_INC_HALFWORD;
         init->SourceDataSize = MDMA_SRC_DATASIZE_BYTE;
     }
+
+    // Mirrored lines are written backwards one pixel at a time.
+    if (sensor->hmirror_copy && (!sensor->transpose)) {
+        init->DestinationInc = MDMA_CTCR_DINC | ((init->DestDataSize >> MDMA_CTCR_DSIZE_Pos) << MDMA_CTCR_DINCOS_Pos);
+        init->DestBurst = MDMA_DEST_BURST_SINGLE;
+    }
 }
 #endif
 
@@ -676,6 +1275,12 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
     // case. We know the transfer was stopped by checking DCMI_CR_ENABLE.
     framebuffer_free_current_buffer();
 
+    // The capture rate can't be changed while capturing, so restart the capture when the frame
+    // rate or the measured sensor frame period call for a different capture rate.
+    if ((DCMI->CR & DCMI_CR_ENABLE) && (sensor_get_dcmi_frame_skip(sensor) != sensor->frame_skip)) {
+        sensor_abort(false, false);
+    }
+
     // We can be in one of the following two states:
     // 1. No ongoing transfer, and DCMI_CR_ENABLE is cleared.
     // 2. A transfer is in progress and we are awaiting the reception of data.
@@ -688,6 +1293,9 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
     // wait for the start of the next frame when it's re-enabled again below. So, we do not
     // need to wait till there's no frame happening before enabling.
     if (!(DCMI->CR & DCMI_CR_ENABLE)) {
+        // Apply a window move that's still pending since the capture was stopped.
+        sensor_apply_window_move(false);
+
         framebuffer_setup_buffers();
 
         // Setup the size and address of the transfer
@@ -699,7 +1307,7 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
         }
 
         uint32_t x_crop = get_dcmi_hw_crop(bytes_per_pixel);
-        uint32_t dma_line_width_bytes = resolution[sensor->framesize][0] * bytes_per_pixel;
+        uint32_t dma_line_width_bytes = get_output_width() * bytes_per_pixel;
 
         // Shrink the captured pixel count by one word to allow cropping to fix alignment.
         if (x_crop) {
@@ -732,7 +1340,7 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
             HAL_MDMA_Init(&DCMI_MDMA_Handle0);
 
             // If we are not transposing the image we can fully offload image capture from the CPU.
-            if (!sensor->transpose) {
+            if (sensor_line_offload_enabled()) {
                 // MDMA will trigger on each TC from DMA and transfer one line to the frame buffer.
                 DCMI_MDMA_Handle1.Init.Request = MDMA_REQUEST_DMA2_Stream1_TC;
                 DCMI_MDMA_Handle1.Init.TransferTriggerMode = MDMA_BLOCK_TRANSFER;
@@ -747,10 +1355,19 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
         }
         #endif
 
+        // Skip the frames that would be dropped in hardware (1 in 2 or 3 in 4).
+        sensor->frame_skip = sensor_get_dcmi_frame_skip(sensor);
+        DCMI->CR &= ~DCMI_CR_FCRC;
+        if (sensor->frame_skip == 3) {
+            DCMI->CR |= DCMI_CR_ALTERNATE_4_FRAME;
+        } else if (sensor->frame_skip == 1) {
+            DCMI->CR |= DCMI_CR_ALTERNATE_2_FRAME;
+        }
+
         HAL_DCMI_DisableCrop(&DCMIHandle);
         if (sensor->pixformat != PIXFORMAT_JPEG) {
             // Vertically crop the image. Horizontal cropping is done in software.
-            HAL_DCMI_ConfigCrop(&DCMIHandle, x_crop, MAIN_FB()->y, dma_line_width_bytes - 1, h - 1);
+            HAL_DCMI_ConfigCrop(&DCMIHandle, x_crop, get_window_y(), dma_line_width_bytes - 1, h - 1);
             HAL_DCMI_EnableCrop(&DCMIHandle);
         }
 
@@ -791,7 +1408,7 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
             }
         #if defined(OMV_MDMA_CHANNEL_DCMI_0)
             // Special transfer mode with MDMA that completely offloads the line capture load.
-        } else if ((sensor->pixformat != PIXFORMAT_JPEG) && (!sensor->transpose)) {
+        } else if ((sensor->pixformat != PIXFORMAT_JPEG) && sensor_line_offload_enabled()) {
             // DMA to circular mode writing the same line over and over again.
             ((DMA_Stream_TypeDef *) DMAHandle.Instance)->CR |= DMA_SxCR_CIRC;
             // DCMI will transfer to same line and MDMA will move to final location.
@@ -808,9 +1425,9 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
         }
     }
 
-    // Let the camera know we want to trigger it now.
+    // Let the camera know we want to trigger it now, unless the trigger input does it.
     #if defined(OMV_CSI_FSYNC_PIN)
-    if (sensor->frame_sync) {
+    if (sensor->frame_sync && (!sensor->ext_trigger)) {
         omv_gpio_write(OMV_CSI_FSYNC_PIN, 1);
     }
     #endif
@@ -835,17 +1452,26 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
     #endif
 
     vbuffer_t *buffer = NULL;
+    uint32_t wait_start_us = mp_hal_ticks_us();
     // Wait for the frame data. __WFI() below will exit right on time because of DCMI_IT_FRAME.
     // While waiting SysTick will trigger allowing us to timeout.
     for (uint32_t tick_start = HAL_GetTick(); !(buffer = framebuffer_get_head(fb_flags)); ) {
-        __WFI();
+        // The capture keeps running in the background filling the next free buffer.
+        if (flags & SENSOR_SNAPSHOT_NONBLOCKING) {
+            return SENSOR_ERROR_WOULD_BLOCK;
+        }
+
+        // Run background work while waiting, otherwise sleep until the next interrupt.
+        if (!omv_task_run()) {
+            __WFI();
+        }
 
         // If we haven't exited this loop before the timeout then we need to abort the transfer.
         if ((HAL_GetTick() - tick_start) > SENSOR_TIMEOUT_MS) {
             sensor_abort(true, false);
 
             #if defined(OMV_CSI_FSYNC_PIN)
-            if (sensor->frame_sync) {
+            if (sensor->frame_sync && (!sensor->ext_trigger)) {
                 omv_gpio_write(OMV_CSI_FSYNC_PIN, 0);
             }
             #endif
@@ -854,6 +1480,11 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
         }
     }
 
+    // The time between frames that the script was busy decides the CPU frequency.
+    uint32_t wait_end_us = mp_hal_ticks_us();
+    cpufreq_governor_update(wait_start_us - snapshot_end_us, wait_end_us - wait_start_us);
+    snapshot_end_us = wait_end_us;
+
     // We have to abort the JPEG data transfer since it will be stuck waiting for data.
     // line will contain how many transfers we completed.
     // The DMA counter must be used to get the number of remaining words to be transferred.
@@ -863,13 +1494,14 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
 
     // We're done receiving data.
     #if defined(OMV_CSI_FSYNC_PIN)
-    if (sensor->frame_sync) {
+    if (sensor->frame_sync && (!sensor->ext_trigger)) {
         omv_gpio_write(OMV_CSI_FSYNC_PIN, 0);
     }
     #endif
 
     // The JPEG in the frame buffer is actually invalid.
     if (buffer->jpeg_buffer_overflow) {
+        sensor_auto_quality_update(0, true);
         return SENSOR_ERROR_JPEG_OVERFLOW;
     }
 
@@ -894,7 +1526,11 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
         case PIXFORMAT_BAYER:
             MAIN_FB()->pixfmt = PIXFORMAT_BAYER;
             MAIN_FB()->subfmt_id = sensor->cfa_format;
-            MAIN_FB()->pixfmt = imlib_bayer_shift(MAIN_FB()->pixfmt, MAIN_FB()->x, MAIN_FB()->y, sensor->transpose);
+            // Flipping moves the first pixel to the other end of the line or column.
+            MAIN_FB()->pixfmt = imlib_bayer_shift(MAIN_FB()->pixfmt,
+                                                  MAIN_FB()->x + (sensor->hmirror_copy ? (w - 1) : 0),
+                                                  MAIN_FB()->y + (sensor->vflip_copy ? (h - 1) : 0),
+                                                  sensor->transpose);
             break;
         case PIXFORMAT_YUV422: {
             MAIN_FB()->pixfmt = PIXFORMAT_YUV;
@@ -921,12 +1557,19 @@ int sensor_snapshot(sensor_t *sensor, image_t *image, uint32_t flags) {
             // Clean trailing data after 0xFFD9 at the end of the jpeg byte stream.
             MAIN_FB()->pixfmt = PIXFORMAT_JPEG;
             MAIN_FB()->size = jpeg_clean_trailing_bytes(size, buffer->data);
+            sensor_auto_quality_update(MAIN_FB()->size, false);
             break;
         }
         default:
             break;
     }
 
+    // The frame was compressed by the JPEG core while it was received.
+    if (sensor_jpeg_capture_enabled()) {
+        MAIN_FB()->pixfmt = PIXFORMAT_JPEG;
+        MAIN_FB()->size = buffer->offset;
+    }
+
     // Set the user image.
     framebuffer_init_image(image);
     return 0;
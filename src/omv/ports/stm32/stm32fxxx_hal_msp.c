@@ -71,6 +71,28 @@ void HAL_MspInit(void) {
         }
     }
 
+    #if defined(OMV_FB_WRITE_THROUGH) || defined(OMV_FB_NO_CACHE)
+    // Map the framebuffer memory write-through (no dirty lines to clean) or non-cacheable (no
+    // cache maintenance at all) for boards that mostly stream frames without processing them.
+    // The region is the smallest aligned power of 2 that covers it, and the DMA buffer regions
+    // above take precedence over it.
+    extern char _fb_memory_start, _fb_memory_end;
+    uint32_t fb_region_size = 32;
+    while (((((uint32_t) &_fb_memory_start) & ~(fb_region_size - 1)) + fb_region_size) <
+           ((uint32_t) &_fb_memory_end)) {
+        fb_region_size <<= 1;
+    }
+    MPU_InitStruct.Number = region_number--;
+    MPU_InitStruct.Enable = MPU_REGION_ENABLE;
+    MPU_InitStruct.BaseAddress = ((uint32_t) &_fb_memory_start) & ~(fb_region_size - 1);
+    MPU_InitStruct.Size = dma_utils_mpu_region_size(fb_region_size);
+    #if defined(OMV_FB_WRITE_THROUGH)
+    MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL0;
+    MPU_InitStruct.IsCacheable = MPU_ACCESS_CACHEABLE;
+    #endif
+    HAL_MPU_ConfigRegion(&MPU_InitStruct);
+    #endif
+
     // Enable the MPU.
     HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
     __DSB(); __ISB();
@@ -139,42 +161,9 @@ void HAL_MspInit(void) {
     HAL_NVIC_EnableIRQ(MDMA_IRQn);
     #endif
 
+    #if defined(MCU_SERIES_H7)
     // Setup AXI QoS
-    #if defined(OMV_AXI_QOS_D2_AHB_R_PRI)
-    OMV_AXI_QOS_D2_AHB_R_SET(OMV_AXI_QOS_D2_AHB_R_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_D2_AHB_W_PRI)
-    OMV_AXI_QOS_D2_AHB_W_SET(OMV_AXI_QOS_D2_AHB_W_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_C_M7_R_PRI)
-    OMV_AXI_QOS_C_M7_R_SET(OMV_AXI_QOS_C_M7_R_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_C_M7_W_PRI)
-    OMV_AXI_QOS_C_M7_W_SET(OMV_AXI_QOS_C_M7_W_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_SDMMC1_R_PRI)
-    OMV_AXI_QOS_SDMMC1_R_SET(OMV_AXI_QOS_SDMMC1_R_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_SDMMC1_W_PRI)
-    OMV_AXI_QOS_SDMMC1_W_SET(OMV_AXI_QOS_SDMMC1_W_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_MDMA_R_PRI)
-    OMV_AXI_QOS_MDMA_R_SET(OMV_AXI_QOS_MDMA_R_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_MDMA_W_PRI)
-    OMV_AXI_QOS_MDMA_W_SET(OMV_AXI_QOS_MDMA_W_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_DMA2D_R_PRI)
-    OMV_AXI_QOS_DMA2D_R_SET(OMV_AXI_QOS_DMA2D_R_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_DMA2D_W_PRI)
-    OMV_AXI_QOS_DMA2D_W_SET(OMV_AXI_QOS_DMA2D_W_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_LTDC_R_PRI)
-    OMV_AXI_QOS_LTDC_R_SET(OMV_AXI_QOS_LTDC_R_PRI);
-    #endif
-    #if defined(OMV_AXI_QOS_LTDC_W_PRI)
-    OMV_AXI_QOS_LTDC_W_SET(OMV_AXI_QOS_LTDC_W_PRI);
+    axiqos_init0();
     #endif
 
     #if defined(OMV_CSI_RESET_PIN)
@@ -140,6 +140,57 @@ static uint8_t uvc_header[2] = { 2, 0 };
 static uint8_t packet[VIDEO_PACKET_SIZE];
 uint32_t packet_size = VIDEO_PACKET_SIZE-2;
 
+// Sends the frame straight from the framebuffer, for formats that don't need to be byte swapped.
+// The payload header of each packet is written over the two bytes before its payload (the end of
+// the previous payload), which are restored once the previous packet has been sent.
+static void process_frame_direct(image_t *image, uint32_t xfer_size)
+{
+    uint8_t *header = NULL;
+    uint8_t saved[2];
+
+    for (uint32_t xfer_bytes = 0; xfer_bytes < xfer_size; ) {
+        uint32_t size = xfer_size - xfer_bytes;
+        if (size > packet_size) {
+            size = packet_size;
+        }
+
+        // Wait for the previous packet, the new header overwrites the end of its payload.
+        while (UVC_TxBusy_FS()) {
+            __WFI();
+        }
+
+        if (header != NULL) {
+            header[0] = saved[0];
+            header[1] = saved[1];
+        }
+
+        header = image->pixels + xfer_bytes - 2;
+        saved[0] = header[0];
+        saved[1] = header[1];
+        header[0] = uvc_header[0];
+        header[1] = uvc_header[1];
+        xfer_bytes += size;
+
+        if (xfer_bytes == xfer_size) {
+            header[1] |= 0x2;    // Flag end of frame
+            uvc_header[1] ^= 1;  // Toggle bit 0 for next new frame
+        }
+
+        while (UVC_Transmit_FS(header, size + 2) != USBD_OK) {
+            __WFI();
+        }
+    }
+
+    while (UVC_TxBusy_FS()) {
+        __WFI();
+    }
+
+    if (header != NULL) {
+        header[0] = saved[0];
+        header[1] = saved[1];
+    }
+}
+
 bool process_frame(image_t *image)
 {
     uint32_t xfer_size = 0;
@@ -148,6 +199,11 @@ bool process_frame(image_t *image)
 
     xfer_size = image->w * image->h * image->bpp;
 
+    if (videoCommitControl.bFormatIndex == VS_FMT_INDEX(GREY)) {
+        process_frame_direct(image, xfer_size);
+        xfer_bytes = xfer_size;
+    }
+
     while (xfer_bytes < xfer_size) {
         packet[0] = uvc_header[0];
         packet[1] = uvc_header[1];
@@ -395,4 +395,15 @@ uint8_t UVC_Transmit_FS(uint8_t* Buf, uint16_t Len)
   return result;
 }
 
+/**
+  * @brief  UVC_TxBusy_FS
+  *         Returns 1 while the last packet is being sent, its buffer can't be modified.
+  * @retval Transmit state
+  */
+uint8_t UVC_TxBusy_FS(void)
+{
+  USBD_UVC_HandleTypeDef *hcdc = (USBD_UVC_HandleTypeDef*) hUsbDevice_0->pClassData;
+  return (hcdc != NULL) && hcdc->TxState;
+}
+
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
@@ -44,6 +44,7 @@
 #define WIFIDBG_BCAST_STRING_SIZE    4 + 4 + 4 + 4 + 6 + WINC_MAX_BOARD_NAME_LEN + 1
 #define WIFIDBG_BCAST_INTERVAL_MS    (1000)
 #define WIFIDBG_POLL_INTERVAL_MS     (10)
+#define WIFIDBG_FRAME_TIMEOUT_MS     (1000)
 
 #define WIFIDBG_SOCKET_TIMEOUT(x)    (x == -ETIMEDOUT || x == SOCK_ERR_TIMEOUT)
 
@@ -57,6 +58,9 @@ typedef struct wifidbg {
     char bcast_packet[WIFIDBG_BCAST_STRING_SIZE];
     winc_socket_buf_t sockbuf;
     uint8_t *buf;
+    const uint8_t *frame;
+    uint32_t hold_start;
+    uint32_t hold_ms;
 } wifidbg_t;
 
 static wifidbg_t wifidbg;
@@ -68,6 +72,8 @@ void wifidbg_close_sockets(wifidbg_t *wifidbg) {
     wifidbg->client_fd = -1;
     wifidbg->server_fd = -1;
     wifidbg->bcast_fd = -1;
+    wifidbg->hold_ms = 0;
+    usbdbg_set_frame_hold(false);
 }
 
 int wifidbg_broadcast(wifidbg_t *wifidbg) {
@@ -87,6 +93,12 @@ static uint32_t dbg_write(const void *buf, uint32_t len) {
     return len;
 }
 
+// Frame data is sent from the JPEG buffer, the frame is not copied.
+static uint32_t dbg_write_frame(const void *buf, uint32_t len) {
+    wifidbg.frame = buf;
+    return len;
+}
+
 static uint32_t dbg_read(void *buf, uint32_t len) {
     memcpy(buf, wifidbg.buf, len);
     return len;
@@ -148,6 +160,12 @@ void wifidbg_pendsv_callback(void) {
         goto exit_dispatch;
     }
 
+    if (wifidbg.hold_ms && (systick_current_millis() - wifidbg.hold_start) >= wifidbg.hold_ms) {
+        // The socket had time to drain, report new frames again.
+        wifidbg.hold_ms = 0;
+        usbdbg_set_frame_hold(false);
+    }
+
     uint8_t cmdbuf[6];
     // We have a connected client
     ret = winc_socket_recv(wifidbg.client_fd, cmdbuf, 6, &wifidbg.sockbuf, 5);
@@ -163,6 +181,32 @@ void wifidbg_pendsv_callback(void) {
     usbdbg_control(NULL, request, xfer_length);
     wifidbg.buf = buf;
 
+    if (request == USBDBG_FRAME_DUMP && xfer_length) {
+        // The frame is sent straight from its JPEG buffer slot. The slot is released when it's
+        // dumped, but the script can't encode into it before this callback returns.
+        wifidbg.frame = NULL;
+        usbdbg_data_in(xfer_length, dbg_write_frame);
+        if (wifidbg.frame == NULL) {
+            goto exit_dispatch_error;
+        }
+
+        uint32_t ticks = systick_current_millis();
+        if (winc_socket_send(wifidbg.client_fd, wifidbg.frame, xfer_length, WIFIDBG_FRAME_TIMEOUT_MS) != xfer_length) {
+            // A partial frame can't be recovered from.
+            goto exit_dispatch_error;
+        }
+
+        // If the socket couldn't take the frame within a poll interval it's backpressured, skip
+        // the frames published while it drains instead of queuing them behind this one.
+        uint32_t elapsed = systick_current_millis() - ticks;
+        if (elapsed > WIFIDBG_POLL_INTERVAL_MS) {
+            wifidbg.hold_start = systick_current_millis();
+            wifidbg.hold_ms = elapsed;
+            usbdbg_set_frame_hold(true);
+        }
+        goto exit_dispatch;
+    }
+
     while (xfer_length) {
         if (request & 0x80) {
             // Device-to-host data phase
@@ -200,6 +244,10 @@ void wifidbg_systick_callback(uint32_t ticks_ms) {
         (ticks_ms - wifidbg.last_dispatch) > WIFIDBG_POLL_INTERVAL_MS) {
         pendsv_schedule_dispatch(PENDSV_DISPATCH_WINC, wifidbg_pendsv_callback);
         wifidbg.last_dispatch = systick_current_millis();
+    } else if (usb_cdc_debug_mode_enabled() && wifidbg.hold_ms) {
+        // Don't hold frames from the USB debugger.
+        wifidbg.hold_ms = 0;
+        usbdbg_set_frame_hold(false);
     }
 }
 
@@ -890,6 +890,17 @@ static int set_framesize(sensor_t *sensor, framesize_t framesize) {
     return ret;
 }
 
+static int set_windowing(sensor_t *sensor, int x, int y, int w, int h) {
+    // The crop window is applied after sub-sampling, so it's in output pixels. It must be
+    // even to keep the bayer/YUV pixel order, otherwise the full frame is output.
+    if ((x % 2) || (y % 2) || (w % 2) || (h % 2)) {
+        set_window(sensor, 0x91, 0, 0, resolution[sensor->framesize][0], resolution[sensor->framesize][1]);
+        return -1;
+    }
+
+    return set_window(sensor, 0x91, x, y, w, h);
+}
+
 static int set_hmirror(sensor_t *sensor, int enable) {
     int ret = 0;
     uint8_t reg;
@@ -992,6 +1003,7 @@ int gc2145_init(sensor_t *sensor) {
     sensor->write_reg = write_reg;
     sensor->set_pixformat = set_pixformat;
     sensor->set_framesize = set_framesize;
+    sensor->set_windowing = set_windowing;
     sensor->set_hmirror = set_hmirror;
     sensor->set_vflip = set_vflip;
     sensor->set_auto_exposure = set_auto_exposure;
@@ -30,6 +30,13 @@
 #define HIMAX_LINE_LEN_PCK_QQVGA    0x178
 #define HIMAX_FRAME_LENGTH_QQVGA    0x084
 
+// The frame length is stretched by this factor in the low-power motion detection mode.
+#define HIMAX_MD_LOW_POWER_SCALE    (4)
+
+static bool md_low_power = false;
+static uint8_t md_osc_div = 0;
+static uint16_t md_frame_len = 0;
+
 static const uint16_t default_regs[][2] = {
     {BLC_TGT,              0x08},          //  BLC target :8  at 8 bit mode
     {BLC2_TGT,             0x08},          //  BLI target :8  at 8 bit mode
@@ -125,6 +132,7 @@ static const uint16_t default_regs[][2] = {
 static int reset(sensor_t *sensor) {
     // Reset sensor.
     uint8_t reg = 0xff;
+    md_low_power = false;
     for (int retry = HIMAX_BOOT_RETRY; retry >= 0 && reg != HIMAX_MODE_STANDBY; retry--) {
         if (omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, SW_RESET, HIMAX_RESET) != 0) {
             return -1;
@@ -460,6 +468,38 @@ static int set_vflip(sensor_t *sensor, int enable) {
     return ret;
 }
 
+static int set_md_low_power(sensor_t *sensor, int enable) {
+    int ret = 0;
+    uint8_t frame_len_h = 0;
+    uint8_t frame_len_l = 0;
+
+    if (enable == md_low_power) {
+        return 0;
+    }
+
+    if (enable) {
+        // Run from the slowest clock with longer frames, the sensor keeps comparing frames and
+        // raises the INT pin on motion while drawing a fraction of its streaming power.
+        ret |= omv_i2c_readb2(&sensor->i2c_bus, sensor->slv_addr, OSC_CLK_DIV, &md_osc_div);
+        ret |= omv_i2c_readb2(&sensor->i2c_bus, sensor->slv_addr, FRAME_LEN_LINES_H, &frame_len_h);
+        ret |= omv_i2c_readb2(&sensor->i2c_bus, sensor->slv_addr, FRAME_LEN_LINES_L, &frame_len_l);
+        md_frame_len = (frame_len_h << 8) | frame_len_l;
+
+        uint32_t frame_len = MIN(md_frame_len * HIMAX_MD_LOW_POWER_SCALE, 0xFFFF);
+        ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, OSC_CLK_DIV, 0x08);
+        ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, FRAME_LEN_LINES_H, frame_len >> 8);
+        ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, FRAME_LEN_LINES_L, frame_len & 0xFF);
+    } else {
+        ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, OSC_CLK_DIV, md_osc_div);
+        ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, FRAME_LEN_LINES_H, md_frame_len >> 8);
+        ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, FRAME_LEN_LINES_L, md_frame_len & 0xFF);
+    }
+
+    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, GRP_PARAM_HOLD, 0x01);
+    md_low_power = (ret == 0) ? enable : md_low_power;
+    return ret;
+}
+
 static int ioctl(sensor_t *sensor, int request, va_list ap) {
     int ret = 0;
 
@@ -504,6 +544,12 @@ static int ioctl(sensor_t *sensor, int request, va_list ap) {
             break;
         }
 
+        case IOCTL_HIMAX_MD_LOW_POWER: {
+            uint32_t enable = va_arg(ap, uint32_t);
+            ret = set_md_low_power(sensor, !!enable);
+            break;
+        }
+
         default: {
             ret = -1;
             break;
@@ -660,25 +660,23 @@ static int reset(sensor_t *sensor) {
     mp_hal_delay_ms(5);
 
     // Write default registers
-    for (int i = 0; default_regs[i][0]; i++) {
-        int addr = (default_regs[i][0] << 8) | (default_regs[i][1] << 0);
-        int data = default_regs[i][2];
-
-        #if (OMV_OV5640_REV_Y_CHECK == 1)
-        // Rev V (480 MHz / 20) -> 24 MHz PCLK / 3 * 100 = 800 MHz / 10 = 80 MHz PCLK.
-        // Rev Y (400 MHz / 16) -> 25 MHz PCLK / 3 * 84 = 700 MHz / 10 = 70 MHz PCLK.
-        if (HAL_GetREVID() < 0x2003) {
-            // Is this REV Y?
-            if (addr == SC_PLL_CONTRL2) {
-                data = OMV_OV5640_REV_Y_CTRL2;
-            }
-            if (addr == SC_PLL_CONTRL3) {
-                data = OMV_OV5640_REV_Y_CTRL3;
-            }
+    #if (OMV_OV5640_REV_Y_CHECK == 1)
+    // Rev V (480 MHz / 20) -> 24 MHz PCLK / 3 * 100 = 800 MHz / 10 = 80 MHz PCLK.
+    // Rev Y (400 MHz / 16) -> 25 MHz PCLK / 3 * 84 = 700 MHz / 10 = 70 MHz PCLK.
+    if (HAL_GetREVID() < 0x2003) {
+        // Is this REV Y? Write the table around the PLL registers.
+        int pll = 0;
+        while (((default_regs[pll][0] << 8) | default_regs[pll][1]) != SC_PLL_CONTRL2) {
+            pll++;
         }
-        #endif
-
-        ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, addr, data);
+        ret |= omv_i2c_write_regs2(&sensor->i2c_bus, sensor->slv_addr, default_regs, pll);
+        ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, SC_PLL_CONTRL2, OMV_OV5640_REV_Y_CTRL2);
+        ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, SC_PLL_CONTRL3, OMV_OV5640_REV_Y_CTRL3);
+        ret |= omv_i2c_write_regs2(&sensor->i2c_bus, sensor->slv_addr, default_regs + pll + 2, -1);
+    } else
+    #endif
+    {
+        ret |= omv_i2c_write_regs2(&sensor->i2c_bus, sensor->slv_addr, default_regs, -1);
     }
 
     #if (OMV_OV5640_AF_ENABLE == 1)
@@ -693,13 +691,7 @@ static int reset(sensor_t *sensor) {
                                sizeof(af_firmware_regs),
                                OMV_I2C_XFER_NO_FLAGS);
 
-    for (int i = 0; af_firmware_command_regs[i][0]; i++) {
-        ret |=
-            omv_i2c_writeb2(&sensor->i2c_bus,
-                            sensor->slv_addr,
-                            (af_firmware_command_regs[i][0] << 8) | (af_firmware_command_regs[i][1] << 0),
-                            af_firmware_command_regs[i][2]);
-    }
+    ret |= omv_i2c_write_regs2(&sensor->i2c_bus, sensor->slv_addr, af_firmware_command_regs, -1);
 
     ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, SYSTEM_RESET_00, 0x00); // release mcu reset
     #endif
@@ -935,38 +927,33 @@ static int set_framesize(sensor_t *sensor, framesize_t framesize) {
 
     // Step 5: Write regs.
 
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_HS_H, sensor_ws >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_HS_L, sensor_ws);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_VS_H, sensor_hs >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_VS_L, sensor_hs);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_HW_H, sensor_we >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_HW_L, sensor_we);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_VH_H, sensor_he >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_VH_L, sensor_he);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_DVPHO_H, w >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_DVPHO_L, w);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_DVPVO_H, h >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_DVPVO_L, h);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_HTS_H, sensor_hts >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_HTS_L, sensor_hts);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_VTS_H, sensor_vts >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_VTS_L, sensor_vts);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_HOFFSET_H, x_off >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_HOFFSET_L, x_off);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_VOFFSET_H, y_off >> 8);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_VOFFSET_L, y_off);
-
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_X_INC, sensor_x_inc);
-    ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_Y_INC, sensor_y_inc);
+    // The timing registers are consecutive and are written in one transfer.
+    const uint8_t timing_regs[][3] = {
+        { TIMING_HS_H >> 8, TIMING_HS_H & 0xFF, sensor_ws >> 8 },
+        { TIMING_HS_L >> 8, TIMING_HS_L & 0xFF, sensor_ws },
+        { TIMING_VS_H >> 8, TIMING_VS_H & 0xFF, sensor_hs >> 8 },
+        { TIMING_VS_L >> 8, TIMING_VS_L & 0xFF, sensor_hs },
+        { TIMING_HW_H >> 8, TIMING_HW_H & 0xFF, sensor_we >> 8 },
+        { TIMING_HW_L >> 8, TIMING_HW_L & 0xFF, sensor_we },
+        { TIMING_VH_H >> 8, TIMING_VH_H & 0xFF, sensor_he >> 8 },
+        { TIMING_VH_L >> 8, TIMING_VH_L & 0xFF, sensor_he },
+        { TIMING_DVPHO_H >> 8, TIMING_DVPHO_H & 0xFF, w >> 8 },
+        { TIMING_DVPHO_L >> 8, TIMING_DVPHO_L & 0xFF, w },
+        { TIMING_DVPVO_H >> 8, TIMING_DVPVO_H & 0xFF, h >> 8 },
+        { TIMING_DVPVO_L >> 8, TIMING_DVPVO_L & 0xFF, h },
+        { TIMING_HTS_H >> 8, TIMING_HTS_H & 0xFF, sensor_hts >> 8 },
+        { TIMING_HTS_L >> 8, TIMING_HTS_L & 0xFF, sensor_hts },
+        { TIMING_VTS_H >> 8, TIMING_VTS_H & 0xFF, sensor_vts >> 8 },
+        { TIMING_VTS_L >> 8, TIMING_VTS_L & 0xFF, sensor_vts },
+        { TIMING_HOFFSET_H >> 8, TIMING_HOFFSET_H & 0xFF, x_off >> 8 },
+        { TIMING_HOFFSET_L >> 8, TIMING_HOFFSET_L & 0xFF, x_off },
+        { TIMING_VOFFSET_H >> 8, TIMING_VOFFSET_H & 0xFF, y_off >> 8 },
+        { TIMING_VOFFSET_L >> 8, TIMING_VOFFSET_L & 0xFF, y_off },
+        { TIMING_X_INC >> 8, TIMING_X_INC & 0xFF, sensor_x_inc },
+        { TIMING_Y_INC >> 8, TIMING_Y_INC & 0xFF, sensor_y_inc },
+    };
+
+    ret |= omv_i2c_write_regs2(&sensor->i2c_bus, sensor->slv_addr, timing_regs, OMV_ARRAY_SIZE(timing_regs));
 
     ret |= omv_i2c_readb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_TC_REG_20, &reg);
     ret |= omv_i2c_writeb2(&sensor->i2c_bus, sensor->slv_addr, TIMING_TC_REG_20, (reg & 0xFE) | (sensor_div > 1));
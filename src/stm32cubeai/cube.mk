@@ -20,8 +20,7 @@ FIRM_OBJ += $(addprefix $(BUILD)/stm32cubeai/data/,\
 	)
 
 FIRM_OBJ += $(addprefix $(BUILD)/stm32cubeai/,\
-	nn_st.o                         \
-	py_st_nn.o                      \
+	ml_backend_cubeai.o             \
 	)
 
 LIBS += -l:NetworkRuntime_CM7_GCC.a -Lstm32cubeai/AI/Lib -lc -lm
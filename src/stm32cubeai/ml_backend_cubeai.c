@@ -0,0 +1,264 @@
+/*
+ * This file is part of the OpenMV project.
+ *
+ * Copyright (c) 2019 STMicroelectronics
+ *
+ * This work is licensed under the MIT license, see the file LICENSE for
+ * details.
+ *
+ * STM32Cube.AI backend for the ml module.
+ *
+ * The network generated by STM32Cube.AI (network.c/network_data.c) is linked into the firmware and
+ * loaded with ml.Model(AI_NETWORK_MODEL_NAME). Each model owns its activations and I/O buffers, so
+ * images are converted straight into the input tensors and the outputs are returned in place, like
+ * with the TFLM backend. The generated code supports a single network instance, which is bound to
+ * the activations of the model that runs it.
+ */
+#include <string.h>
+#include "py/runtime.h"
+#include "py/obj.h"
+#include "py/objtuple.h"
+
+#include "omv_boardconfig.h"
+#include "py_ml.h"
+#include "ai_platform.h"
+#include "network.h"
+#include "network_data.h"
+
+#define AI_ALIGNMENT    (32 - 1)
+
+typedef struct ml_backend_cubeai_state {
+    void *activations;
+    void *activations_block;
+    ai_buffer inputs[AI_NETWORK_IN_NUM];
+    ai_buffer outputs[AI_NETWORK_OUT_NUM];
+    void *buffers[AI_NETWORK_IN_NUM + AI_NETWORK_OUT_NUM];
+} ml_backend_cubeai_state_t;
+
+static ai_handle ml_backend_cubeai_network = AI_HANDLE_NULL;
+static py_ml_model_obj_t *ml_backend_cubeai_owner = NULL;
+
+static void ml_backend_cubeai_raise(const char *fn) {
+    ai_error err = ai_network_get_error(ml_backend_cubeai_network);
+    mp_raise_msg_varg(&mp_type_RuntimeError,
+                      MP_ERROR_TEXT("%s failed, type=%d code=%d"), fn, err.type, err.code);
+}
+
+// The runtime library checks the CRC unit is enabled.
+static void ml_backend_cubeai_crc_init(void) {
+    CRC_HandleTypeDef hcrc = { 0 };
+
+    __HAL_RCC_CRC_CLK_ENABLE();
+
+    hcrc.Instance = CRC;
+    hcrc.Init.DefaultPolynomialUse = DEFAULT_POLYNOMIAL_ENABLE;
+    hcrc.Init.DefaultInitValueUse = DEFAULT_INIT_VALUE_ENABLE;
+    hcrc.Init.InputDataInversionMode = CRC_INPUTDATA_INVERSION_NONE;
+    hcrc.Init.OutputDataInversionMode = CRC_OUTPUTDATA_INVERSION_DISABLE;
+    hcrc.InputDataFormat = CRC_INPUTDATA_FORMAT_BYTES;
+    HAL_CRC_Init(&hcrc);
+}
+
+// Allocates an aligned buffer, the returned block pointer is kept to keep it from being collected.
+static void *ml_backend_cubeai_alloc(size_t size, void **block) {
+    *block = m_malloc(size + AI_ALIGNMENT);
+    return (void *) ((((uintptr_t) *block) + AI_ALIGNMENT) & ~AI_ALIGNMENT);
+}
+
+static char ml_backend_cubeai_map_dtype(const ai_buffer *buffer) {
+    uint32_t fmt = buffer->format;
+    if (AI_BUFFER_FMT_GET_TYPE(fmt) == AI_BUFFER_FMT_TYPE_FLOAT) {
+        return 'f';
+    } else if (AI_BUFFER_FMT_GET_BITS(fmt) == 8) {
+        return AI_BUFFER_FMT_GET_SIGN(fmt) ? 'b' : 'B';
+    } else if (AI_BUFFER_FMT_GET_BITS(fmt) == 16) {
+        return AI_BUFFER_FMT_GET_SIGN(fmt) ? 'h' : 'H';
+    }
+    mp_raise_msg_varg(&mp_type_ValueError, MP_ERROR_TEXT("Unsupported tensor format 0x%x"), fmt);
+}
+
+// Integer tensors either carry an affine quantization or are in the Qm.n fixed-point format.
+static void ml_backend_cubeai_quant_params(const ai_buffer *buffer, float *scale, int *zero_point) {
+    *scale = 1.0f;
+    *zero_point = 0;
+
+    if (AI_BUFFER_FMT_GET_TYPE(buffer->format) == AI_BUFFER_FMT_TYPE_FLOAT) {
+        return;
+    }
+
+    if (AI_BUFFER_META_INFO_INTQ(buffer->meta_info)) {
+        *scale = AI_BUFFER_META_INFO_INTQ_GET_SCALE(buffer->meta_info, 0);
+        *zero_point = AI_BUFFER_META_INFO_INTQ_GET_ZEROPOINT(buffer->meta_info, 0);
+    } else {
+        *scale = 1.0f / (1 << AI_BUFFER_FMT_GET_FBITS(buffer->format));
+    }
+}
+
+// Fills the shape, scale, zero point and dtype tuples of the model's inputs or outputs.
+static void ml_backend_cubeai_tensor_info(const ai_buffer *buffers, size_t n, mp_obj_tuple_t **shape,
+                                          mp_obj_tuple_t **scale, mp_obj_tuple_t **zero_point,
+                                          mp_obj_tuple_t **dtype) {
+    *shape = MP_OBJ_TO_PTR(mp_obj_new_tuple(n, NULL));
+    *scale = MP_OBJ_TO_PTR(mp_obj_new_tuple(n, NULL));
+    *zero_point = MP_OBJ_TO_PTR(mp_obj_new_tuple(n, NULL));
+    *dtype = MP_OBJ_TO_PTR(mp_obj_new_tuple(n, NULL));
+
+    for (size_t i = 0; i < n; i++) {
+        const ai_buffer *buffer = &buffers[i];
+        float s;
+        int zp;
+        ml_backend_cubeai_quant_params(buffer, &s, &zp);
+
+        // Cube.AI tensors are HWC, same as the NHWC tensors of TFLM models.
+        mp_obj_t dims[4] = {
+            mp_obj_new_int(1),
+            mp_obj_new_int(buffer->height),
+            mp_obj_new_int(buffer->width),
+            mp_obj_new_int(buffer->channels),
+        };
+        (*shape)->items[i] = mp_obj_new_tuple(4, dims);
+        (*scale)->items[i] = mp_obj_new_float(s);
+        (*zero_point)->items[i] = mp_obj_new_int(zp);
+        (*dtype)->items[i] = mp_obj_new_int(ml_backend_cubeai_map_dtype(buffer));
+    }
+}
+
+bool ml_backend_cubeai_find_model(const char *name) {
+    return !strcmp(name, AI_NETWORK_MODEL_NAME);
+}
+
+// Binds the network to the model's activations.
+static void ml_backend_cubeai_bind(py_ml_model_obj_t *model) {
+    ml_backend_cubeai_state_t *state = model->state;
+
+    if (ml_backend_cubeai_owner == model) {
+        return;
+    }
+
+    const ai_network_params params = {
+        AI_NETWORK_DATA_WEIGHTS(ai_network_data_weights_get()),
+        AI_NETWORK_DATA_ACTIVATIONS(state->activations)
+    };
+
+    if (!ai_network_init(ml_backend_cubeai_network, &params)) {
+        ml_backend_cubeai_owner = NULL;
+        ml_backend_cubeai_raise("ai_network_init");
+    }
+
+    ml_backend_cubeai_owner = model;
+}
+
+static int ml_backend_cubeai_init_model(py_ml_model_obj_t *model) {
+    ai_network_report report;
+
+    if (ml_backend_cubeai_network == AI_HANDLE_NULL) {
+        ml_backend_cubeai_crc_init();
+        ai_error err = ai_network_create(&ml_backend_cubeai_network, NULL);
+        if (err.type != AI_ERROR_NONE) {
+            ml_backend_cubeai_network = AI_HANDLE_NULL;
+            mp_raise_msg_varg(&mp_type_RuntimeError,
+                              MP_ERROR_TEXT("ai_network_create failed, type=%d code=%d"), err.type, err.code);
+        }
+    }
+
+    ml_backend_cubeai_state_t *state = m_new0(ml_backend_cubeai_state_t, 1);
+    model->state = state;
+
+    // The network has to be initialized before its report is complete.
+    state->activations = ml_backend_cubeai_alloc(AI_NETWORK_DATA_ACTIVATIONS_SIZE, &state->activations_block);
+    ml_backend_cubeai_owner = NULL;
+    ml_backend_cubeai_bind(model);
+
+    if (!ai_network_get_info(ml_backend_cubeai_network, &report)) {
+        ml_backend_cubeai_raise("ai_network_get_info");
+    }
+
+    model->data = (unsigned char *) ai_network_data_weights_get();
+    model->size = AI_NETWORK_DATA_WEIGHTS_SIZE;
+    model->memory_addr = (uint32_t) state->activations;
+    model->memory_size = AI_NETWORK_DATA_ACTIVATIONS_SIZE;
+    model->inputs_size = report.n_inputs;
+    model->outputs_size = report.n_outputs;
+
+    // Allocate the I/O buffers, the runtime doesn't place them in the activations buffer.
+    size_t n_buffers = 0;
+    for (size_t i = 0; i < model->inputs_size; i++, n_buffers++) {
+        state->inputs[i] = report.inputs[i];
+        state->inputs[i].n_batches = 1;
+        size_t size = AI_BUFFER_BYTE_SIZE(AI_BUFFER_SIZE(&state->inputs[i]), state->inputs[i].format);
+        state->inputs[i].data = AI_HANDLE_PTR(ml_backend_cubeai_alloc(size, &state->buffers[n_buffers]));
+        model->memory_size += size;
+    }
+
+    for (size_t i = 0; i < model->outputs_size; i++, n_buffers++) {
+        state->outputs[i] = report.outputs[i];
+        state->outputs[i].n_batches = 1;
+        size_t size = AI_BUFFER_BYTE_SIZE(AI_BUFFER_SIZE(&state->outputs[i]), state->outputs[i].format);
+        state->outputs[i].data = AI_HANDLE_PTR(ml_backend_cubeai_alloc(size, &state->buffers[n_buffers]));
+        model->memory_size += size;
+    }
+
+    ml_backend_cubeai_tensor_info(state->inputs, model->inputs_size, &model->input_shape,
+                                  &model->input_scale, &model->input_zero_point, &model->input_dtype);
+    ml_backend_cubeai_tensor_info(state->outputs, model->outputs_size, &model->output_shape,
+                                  &model->output_scale, &model->output_zero_point, &model->output_dtype);
+    return 0;
+}
+
+// Each model owns its activations.
+static py_ml_model_obj_t *ml_backend_cubeai_acquire_arena(py_ml_model_obj_t *model) {
+    return NULL;
+}
+
+static int ml_backend_cubeai_run_inference(py_ml_model_obj_t *model) {
+    ml_backend_cubeai_state_t *state = model->state;
+    ml_backend_cubeai_bind(model);
+
+    if (ai_network_run(ml_backend_cubeai_network, state->inputs, state->outputs) != 1) {
+        ml_backend_cubeai_raise("ai_network_run");
+    }
+
+    return 0;
+}
+
+// Inference runs on the CPU, so it's done when ml_backend_cubeai_start_inference() returns.
+static int ml_backend_cubeai_start_inference(py_ml_model_obj_t *model) {
+    return ml_backend_cubeai_run_inference(model);
+}
+
+static bool ml_backend_cubeai_wait_inference(py_ml_model_obj_t *model, bool block) {
+    return true;
+}
+
+// The generated network doesn't report per-layer timings.
+static bool ml_backend_cubeai_get_profile(py_ml_model_obj_t *model, size_t index,
+                                          ml_backend_op_profile_t *profile) {
+    return false;
+}
+
+static void *ml_backend_cubeai_get_input(py_ml_model_obj_t *model, size_t index) {
+    ml_backend_cubeai_state_t *state = model->state;
+    if (index < model->inputs_size) {
+        return state->inputs[index].data;
+    }
+    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid input tensor index"));
+}
+
+static void *ml_backend_cubeai_get_output(py_ml_model_obj_t *model, size_t index) {
+    ml_backend_cubeai_state_t *state = model->state;
+    if (index < model->outputs_size) {
+        return state->outputs[index].data;
+    }
+    mp_raise_msg(&mp_type_ValueError, MP_ERROR_TEXT("Invalid output tensor index"));
+}
+
+const ml_backend_t ml_backend_cubeai = {
+    ml_backend_cubeai_init_model,
+    ml_backend_cubeai_acquire_arena,
+    ml_backend_cubeai_run_inference,
+    ml_backend_cubeai_start_inference,
+    ml_backend_cubeai_wait_inference,
+    ml_backend_cubeai_get_profile,
+    ml_backend_cubeai_get_input,
+    ml_backend_cubeai_get_output,
+};
@@ -17,6 +17,10 @@ from PIL import Image
 
 __serial = None
 __FB_HDR_SIZE   =12
+__FB_RAW_HDR_SIZE=24
+
+# enable_fb() value for uncompressed, full resolution frames.
+FB_RAW          =2
 
 # USB Debug commands
 __USBDBG_CMD            = 48
@@ -38,6 +42,12 @@ __USBDBG_FB_ENABLE      = 0x0D
 __USBDBG_TX_BUF_LEN     = 0x8E
 __USBDBG_TX_BUF         = 0x8F
 __USBDBG_GET_STATE      = 0x93
+__USBDBG_PROFILE_SIZE   = 0x94
+__USBDBG_PROFILE_DUMP   = 0x95
+__USBDBG_PROFILE_RESET  = 0x16
+__USBDBG_FB_STATS_SIZE  = 0x96
+__USBDBG_FB_STATS_DUMP  = 0x97
+__USBDBG_FB_STATS_RESET = 0x17
 
 __USBDBG_STATE_FLAGS_SCRIPT = (1 << 0)
 __USBDBG_STATE_FLAGS_TEXT   = (1 << 1)
@@ -116,6 +126,25 @@ def read_state():
     return w, h, buff.reshape((h, w, 3)), num_bytes, text, fmt
 
 
+def fb_raw_dump():
+    # Reads the extended frame header: w, h, size (bytes), pixformat, sequence and timestamp.
+    # Frames are sent uncompressed after calling enable_fb(FB_RAW).
+    __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_FRAME_SIZE, __FB_RAW_HDR_SIZE))
+    w, h, size, pixfmt, seq, ticks_us = struct.unpack("<IIIIII", __serial.read(__FB_RAW_HDR_SIZE))
+
+    if not w:
+        # frame not ready
+        return None
+
+    # read fb data
+    __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_FRAME_DUMP, size))
+    buff = __serial.read(size)
+
+    if len(buff) != size:
+        return None
+
+    return w, h, pixfmt, seq, ticks_us, buff
+
 def fb_dump():
     size = fb_size()
 
@@ -217,6 +246,55 @@ def enable_fb(enable):
     __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_FB_ENABLE, 4))
     __serial.write(struct.pack("<I", enable))
 
+def profile_reset():
+    __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_PROFILE_RESET, 0))
+
+def profile_dump():
+    # Returns a list of (address, caller, calls, min, max, total, self) tuples.
+    __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_PROFILE_SIZE, 8))
+    count, size = struct.unpack("II", __serial.read(8))
+    if count == 0:
+        return []
+
+    __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_PROFILE_DUMP, count * size))
+    buff = __serial.read(count * size)
+
+    records = []
+    for i in range(count):
+        address, caller, calls, min_cycles, max_cycles, _, total_cycles, self_cycles = \
+            struct.unpack_from("<IIIIIIQQ", buff, i * size)
+        if address and calls:
+            records.append((address, caller, calls, min_cycles, max_cycles, total_cycles, self_cycles))
+    return records
+
+def fb_stats_reset():
+    __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_FB_STATS_RESET, 0))
+
+def fb_stats():
+    # Returns a dict of fb_alloc statistics or None if the firmware was built without
+    # FB_ALLOC_STATS. "allocs" and "marks" are lists of (caller, count, peak, total) tuples.
+    __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_FB_STATS_SIZE, 8))
+    size, sites = struct.unpack("II", __serial.read(8))
+    if size == 0:
+        return None
+
+    __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_FB_STATS_DUMP, size))
+    buff = __serial.read(size)
+
+    keys = ("peak", "min_avail", "count", "requested", "overhead", "alloc_all_count",
+            "alloc_all_us", "alloc_all_max_us", "fail_caller", "fail_size", "fail_avail", "dropped")
+    stats = dict(zip(keys, struct.unpack_from("<%dI" % len(keys), buff, 0)))
+    offset = len(keys) * 4
+    for name in ("allocs", "marks"):
+        records = []
+        for i in range(sites):
+            record = struct.unpack_from("<IIII", buff, offset + i * 16)
+            if record[0]:
+                records.append(record)
+        stats[name] = records
+        offset += sites * 16
+    return stats
+
 def arch_str():
     __serial.write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_ARCH_STR, 64))
     return __serial.read(64).split(b'\0', 1)[0]
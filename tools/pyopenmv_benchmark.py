@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+# This file is part of the OpenMV project.
+#
+# Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+# Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+#
+# This work is licensed under the MIT license, see the file LICENSE for details.
+#
+# This script runs the imlib benchmark on a camera and records the per-kernel
+# report. If a baseline report is given, kernels that got slower by more than
+# the tolerance are listed and the script exits with an error.
+
+import sys
+import csv
+import time
+import argparse
+import pyopenmv
+
+
+def read_report(path):
+    report = {}
+    with open(path, "r") as f:
+        for row in csv.DictReader(line for line in f if not line.startswith("#")):
+            report[(row["kernel"], row["format"], row["size"])] = float(row["cycles_per_pixel"])
+    return report
+
+
+def run_benchmark(port, script, timeout):
+    pyopenmv.init(port, baudrate=921600, timeout=0.050)
+    pyopenmv.set_timeout(0.500)
+    pyopenmv.stop_script()
+    pyopenmv.enable_fb(False)
+    pyopenmv.exec_script(script)
+
+    text = ""
+    start = time.time()
+    while True:
+        time.sleep(0.100)
+        tx_len = pyopenmv.tx_buf_len()
+        if tx_len:
+            text += pyopenmv.tx_buf(tx_len).decode()
+        elif not pyopenmv.script_running():
+            break
+        if (time.time() - start) > timeout:
+            pyopenmv.stop_script()
+            raise TimeoutError("Benchmark timed out")
+
+    pyopenmv.disconnect()
+    return text
+
+
+def main():
+    parser = argparse.ArgumentParser(description="openmv imlib benchmark")
+    parser.add_argument("-p", "--port", action="store", default="/dev/openmvcam", help="OpenMV serial port")
+    parser.add_argument("-s", "--script", action="store",
+                        default="../scripts/benchmark/imlib_benchmark.py", help="Benchmark script")
+    parser.add_argument("-o", "--output", action="store", default="benchmark.csv", help="Report output file")
+    parser.add_argument("-b", "--baseline", action="store", help="Baseline report to compare against")
+    parser.add_argument("-t", "--tolerance", action="store", type=float, default=5.0,
+                        help="Allowed slowdown in percent before a kernel is reported as a regression")
+    parser.add_argument("--timeout", action="store", type=float, default=600.0, help="Benchmark timeout in seconds")
+    args = parser.parse_args()
+
+    with open(args.script, "r") as f:
+        script = f.read()
+
+    text = run_benchmark(args.port, script, args.timeout)
+    if "Traceback" in text:
+        print(text)
+        sys.exit(1)
+
+    lines = [line for line in text.splitlines() if line.startswith("#") or line.count(",") == 4]
+    with open(args.output, "w") as f:
+        f.write("\n".join(lines) + "\n")
+    print("\n".join(lines))
+
+    if not args.baseline:
+        return
+
+    baseline = read_report(args.baseline)
+    current = read_report(args.output)
+    regressions = 0
+    for key, cpp in sorted(current.items()):
+        if key not in baseline or not baseline[key]:
+            continue
+        change = ((cpp - baseline[key]) * 100.0) / baseline[key]
+        if change > args.tolerance:
+            regressions += 1
+            print("REGRESSION %s %s %s: %.2f -> %.2f cycles/pixel (%+.1f%%)" %
+                  (key[0], key[1], key[2], baseline[key], cpp, change))
+
+    if regressions:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,99 @@
+#!/usr/bin/env python
+# This file is part of the OpenMV project.
+#
+# Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+# Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+#
+# This work is licensed under the MIT license, see the file LICENSE for details.
+#
+# Captures uncompressed frames to disk for dataset collection.
+#
+# The camera sends frames as they are captured, without JPEG compression or down-scaling, if they
+# fit in the JPEG buffer (frames that don't are sent as JPEG). Each frame is written as is to a
+# separate file, and the frame format and timestamp are appended to index.csv.
+
+import os
+import sys
+import time
+import argparse
+import pyopenmv
+
+# Pixel format ids (bits 16-23 of the pixel format).
+pixformats = {1: "binary", 2: "gray", 3: "rgb565", 4: "bayer", 5: "yuv422", 6: "jpeg", 7: "png"}
+
+capture_script = """
+import sensor, time
+sensor.reset()
+sensor.set_pixformat(sensor.%s)
+sensor.set_framesize(sensor.%s)
+sensor.skip_frames(time = 2000)
+
+while(True):
+    sensor.snapshot()
+"""
+
+def capture(port, script, out_dir, count):
+    pyopenmv.disconnect()
+    pyopenmv.init(port, baudrate=921600, timeout=0.050)
+
+    # Set higher timeout after connecting for lengthy transfers.
+    pyopenmv.set_timeout(2)
+    pyopenmv.stop_script()
+    pyopenmv.enable_fb(pyopenmv.FB_RAW)
+    pyopenmv.exec_script(script)
+
+    os.makedirs(out_dir, exist_ok=True)
+    index_path = os.path.join(out_dir, "index.csv")
+    new_index = not os.path.exists(index_path)
+    index = open(index_path, "a")
+    if new_index:
+        index.write("file,seq,ticks_us,w,h,pixformat,size\n")
+
+    frames = 0
+    start = time.time()
+
+    try:
+        while not count or frames < count:
+            frame = pyopenmv.fb_raw_dump()
+            if frame is None:
+                continue
+
+            w, h, pixfmt, seq, ticks_us, buff = frame
+            fmt = pixformats.get((pixfmt >> 16) & 0xFF, "raw")
+            name = "frame_%08d.%s" % (seq, fmt)
+
+            with open(os.path.join(out_dir, name), "wb") as f:
+                f.write(buff)
+
+            index.write("%s,%d,%d,%d,%d,%s,%d\n" % (name, seq, ticks_us, w, h, fmt, len(buff)))
+            frames += 1
+
+            if (frames % 100) == 0:
+                print("%d frames, %.2f FPS" % (frames, frames / (time.time() - start)))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        index.close()
+        pyopenmv.enable_fb(True)
+        pyopenmv.stop_script()
+        pyopenmv.disconnect()
+
+    print("Captured %d frames to %s" % (frames, out_dir))
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description='Capture raw frames from an OpenMV Cam')
+    parser.add_argument("--port", action="store", default="/dev/ttyACM0", help="OpenMV serial port")
+    parser.add_argument("--script", action="store", default=None, help="Run this script instead of the default one")
+    parser.add_argument("--pixformat", action="store", default="RGB565", help="Default script pixel format")
+    parser.add_argument("--framesize", action="store", default="QVGA", help="Default script frame size")
+    parser.add_argument("--count", action="store", type=int, default=0, help="Number of frames (0 until interrupted)")
+    parser.add_argument("out_dir", action="store", help="Output directory")
+    args = parser.parse_args()
+
+    if args.script:
+        with open(args.script, "r") as f:
+            script = f.read()
+    else:
+        script = capture_script % (args.pixformat, args.framesize)
+
+    capture(args.port, script, args.out_dir, args.count)
@@ -11,6 +11,8 @@
 import struct
 import sys,time
 import serial
+import threading
+import collections
 import platform
 import numpy as np
 from PIL import Image
@@ -19,6 +21,10 @@ __serial = []
 __port = []
 
 __FB_HDR_SIZE   =12
+__FB_RAW_HDR_SIZE=24
+
+# enable_fb() value for uncompressed, full resolution frames.
+FB_RAW          =2
 
 # USB Debug commands
 __USBDBG_CMD            = 48
@@ -126,6 +132,119 @@ def fb_dump(port):
     except:
         return None
 
+def fb_raw_dump(port):
+    # Reads the extended frame header: w, h, size (bytes), pixformat, sequence and timestamp.
+    try:
+        idx = __port.index(port)
+        __serial[idx].write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_FRAME_SIZE, __FB_RAW_HDR_SIZE))
+        w, h, size, pixfmt, seq, ticks_us = struct.unpack("<IIIIII", __serial[idx].read(__FB_RAW_HDR_SIZE))
+
+        if (not w):
+            # frame not ready
+            return None
+
+        # read fb data
+        __serial[idx].write(struct.pack("<BBI", __USBDBG_CMD, __USBDBG_FRAME_DUMP, size))
+        buff = __serial[idx].read(size)
+
+        if (len(buff) != size):
+            return None
+
+        return (w, h, pixfmt, seq, ticks_us, buff)
+    except:
+        return None
+
+class Frame:
+    def __init__(self, port, w, h, pixfmt, seq, timestamp, data):
+        self.port = port
+        self.w = w
+        self.h = h
+        self.pixfmt = pixfmt
+        self.seq = seq
+        self.timestamp = timestamp  # Host time (seconds) the frame was published on the camera.
+        self.data = data
+
+class MultiCapture:
+    # Reads frames from several cameras concurrently, one thread per camera, and returns sets
+    # with one frame per camera published within `tolerance` seconds of each other.
+    #
+    # The camera timestamps are mapped to host time with a per-camera offset, the smallest
+    # difference between the host time a frame is received at and its camera timestamp (the
+    # frame with the lowest transfer latency). Cameras must be connected with init() first.
+    def __init__(self, ports, tolerance=0.010, depth=8, raw=True):
+        self.ports = list(ports)
+        self.tolerance = tolerance
+        self.raw = raw
+        self.cond = threading.Condition()
+        self.queues = {p: collections.deque(maxlen=depth) for p in self.ports}
+        self.offsets = {p: None for p in self.ports}
+        self.running = False
+        self.threads = []
+
+    def start(self):
+        self.running = True
+        for port in self.ports:
+            enable_fb(port, FB_RAW if self.raw else True)
+            t = threading.Thread(target=self.__reader, args=(port,), daemon=True)
+            t.start()
+            self.threads.append(t)
+
+    def stop(self):
+        self.running = False
+        for t in self.threads:
+            t.join()
+        self.threads = []
+
+    def __reader(self, port):
+        wraps = 0
+        last_ticks = 0
+        while self.running:
+            frame = fb_raw_dump(port)
+            if frame is None:
+                time.sleep(0.001)
+                continue
+
+            now = time.monotonic()
+            w, h, pixfmt, seq, ticks_us, data = frame
+
+            # Unwrap the 32-bit microseconds counter.
+            if ticks_us < last_ticks:
+                wraps += 1
+            last_ticks = ticks_us
+            ticks = (ticks_us + (wraps << 32)) / 1000000.0
+
+            with self.cond:
+                offset = now - ticks
+                if self.offsets[port] is None or offset < self.offsets[port]:
+                    self.offsets[port] = offset
+                self.queues[port].append(Frame(port, w, h, pixfmt, seq, ticks + self.offsets[port], data))
+                self.cond.notify_all()
+
+    def __match(self):
+        # Returns a set of frames if the oldest frame of each camera is within the tolerance,
+        # otherwise drops the oldest frame that can't be part of a set.
+        while all(self.queues.values()):
+            heads = [self.queues[p][0] for p in self.ports]
+            oldest = min(heads, key=lambda f: f.timestamp)
+            newest = max(heads, key=lambda f: f.timestamp)
+            if (newest.timestamp - oldest.timestamp) <= self.tolerance:
+                return [self.queues[p].popleft() for p in self.ports]
+            self.queues[oldest.port].popleft()
+        return None
+
+    def read(self, timeout=None):
+        # Returns a list of frames (in the order of the ports) or None on timeout.
+        with self.cond:
+            frames = self.__match()
+            deadline = None if timeout is None else time.monotonic() + timeout
+            while frames is None:
+                remaining = None if deadline is None else deadline - time.monotonic()
+                if remaining is not None and remaining <= 0:
+                    return None
+                self.cond.wait(remaining)
+                frames = self.__match()
+            return frames
+
 def exec_script(port, buf):
     try:
         idx = __port.index(port)
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+# This file is part of the OpenMV project.
+#
+# Copyright (c) 2013-2024 Ibrahim Abdelkader <iabdalkader@openmv.io>
+# Copyright (c) 2013-2024 Kwabena W. Agyeman <kwagyeman@openmv.io>
+#
+# This work is licensed under the MIT license, see the file LICENSE for details.
+#
+# This script reads the function profiler records from a camera running a
+# firmware built with PROFILER=1, and prints the functions sorted by the time
+# spent in them. Function names are resolved using the firmware ELF file.
+
+import sys
+import bisect
+import argparse
+import subprocess
+import pyopenmv
+
+
+def load_symbols(elf, nm):
+    symbols = []
+    output = subprocess.check_output([nm, "--defined-only", "-n", elf]).decode()
+    for line in output.splitlines():
+        fields = line.split()
+        if len(fields) == 3 and fields[1] in "tTwW":
+            symbols.append((int(fields[0], 16), fields[2]))
+    return symbols
+
+
+def resolve(symbols, address):
+    # Thumb function addresses have the LSB set.
+    address &= ~1
+    i = bisect.bisect_right(symbols, (address, chr(0x10ffff))) - 1
+    return symbols[i][1] if i >= 0 else "0x%08x" % address
+
+
+def main():
+    parser = argparse.ArgumentParser(description="openmv function profiler")
+    parser.add_argument("-p", "--port", action="store", default="/dev/openmvcam", help="OpenMV serial port")
+    parser.add_argument("-e", "--elf", action="store", required=True, help="Firmware ELF file")
+    parser.add_argument("-n", "--nm", action="store", default="arm-none-eabi-nm", help="nm tool to use")
+    parser.add_argument("-c", "--count", action="store", type=int, default=40, help="Number of functions to print")
+    parser.add_argument("-s", "--sort", action="store", default="self", choices=["self", "total", "calls"],
+                        help="Sort key")
+    parser.add_argument("-r", "--reset", action="store_true", help="Reset the profiler after reading")
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.elf, args.nm)
+
+    pyopenmv.init(args.port, baudrate=921600, timeout=0.050)
+    pyopenmv.set_timeout(1.0)
+    records = pyopenmv.profile_dump()
+    if args.reset:
+        pyopenmv.profile_reset()
+    pyopenmv.disconnect()
+
+    if not records:
+        print("No profiler records (was the firmware built with PROFILER=1?)")
+        sys.exit(1)
+
+    key = {"calls": 2, "total": 5, "self": 6}[args.sort]
+    records.sort(key=lambda r: r[key], reverse=True)
+    total_self = sum(r[6] for r in records) or 1
+
+    print("%-40s %10s %14s %14s %6s %12s %12s" %
+          ("function", "calls", "total cycles", "self cycles", "self%", "min", "max"))
+    for address, caller, calls, min_cycles, max_cycles, total_cycles, self_cycles in records[:args.count]:
+        print("%-40s %10d %14d %14d %5.1f%% %12d %12d" %
+              (resolve(symbols, address)[:40], calls, total_cycles, self_cycles,
+               (self_cycles * 100.0) / total_self, min_cycles, max_cycles))
+
+
+if __name__ == "__main__":
+    main()
@@ -6,14 +6,80 @@
 #
 # This work is licensed under the MIT license, see the file LICENSE for details.
 #
-# This script stress-tests script execution.
+# This script stress-tests script execution. With --benchmark it runs the benchmark
+# suite once instead and compares the report against the board's stored baseline.
 
 import sys, os
+import csv
+import time
 import pyopenmv
 import argparse
 from time import sleep
 from random import randint
 
+BENCHMARK_SCRIPT = "../scripts/examples/50-OpenMV-Boards/99-Tests/benchmarks.py"
+BASELINE_DIR = "../scripts/unittest/baseline"
+
+def read_report(lines):
+    report = {}
+    for row in csv.DictReader(line for line in lines if not line.startswith("#")):
+        report[row["api"]] = (int(row["us"]), int(row["fb_peak"]))
+    return report
+
+def run_benchmark(script, timeout):
+    pyopenmv.enable_fb(False)
+    pyopenmv.stop_script()
+    pyopenmv.exec_script(script)
+
+    text = ""
+    start = time.time()
+    while True:
+        sleep(0.100)
+        tx_len = pyopenmv.tx_buf_len()
+        if tx_len:
+            text += pyopenmv.tx_buf(tx_len).decode()
+        elif not pyopenmv.script_running():
+            break
+        if (time.time() - start) > timeout:
+            pyopenmv.stop_script()
+            raise Exception("Benchmark timed out")
+
+    if "Traceback" in text:
+        print(text)
+        sys.exit(1)
+
+    return [line for line in text.splitlines() if line.startswith("#") or line.count(",") == 2]
+
+def check_benchmark(lines, baseline_dir, tolerance, update):
+    # The header is "# board=<type> ..." and selects the baseline file.
+    board = lines[0].split()[1].split("=")[1]
+    baseline_path = os.path.join(baseline_dir, board + ".csv")
+    print("\n".join(lines))
+
+    if update or not os.path.exists(baseline_path):
+        if not os.path.isdir(baseline_dir):
+            os.makedirs(baseline_dir)
+        with open(baseline_path, "w") as f:
+            f.write("\n".join(lines) + "\n")
+        print(">>>Baseline written to %s" %(baseline_path))
+        return 0
+
+    with open(baseline_path, "r") as f:
+        baseline = read_report(f.readlines())
+
+    regressions = 0
+    for api, (us, peak) in sorted(read_report(lines).items()):
+        if api not in baseline:
+            continue
+        base_us, base_peak = baseline[api]
+        if base_us and ((us - base_us) * 100.0) / base_us > tolerance:
+            regressions += 1
+            print("REGRESSION %s: %d -> %d us/call" %(api, base_us, us))
+        if peak > base_peak >= 0:
+            regressions += 1
+            print("REGRESSION %s: %d -> %d fb_alloc peak bytes" %(api, base_peak, peak))
+    return regressions
+
 def main():
     # CMD args parser
     parser = argparse.ArgumentParser(description='openmv stress test')
@@ -22,9 +88,16 @@ def main():
     parser.add_argument("-t", "--time",   action = "store", default = 100, help = "Max time before stopping the script")
     parser.add_argument("-s", "--script", action = "store",\
             default="../scripts/examples/00-HelloWorld/helloworld.py", help = "OpenMV script file")
+    parser.add_argument("-b", "--benchmark", action = "store_true", help = "Run the benchmark suite against a baseline")
+    parser.add_argument("--baseline-dir", action = "store", default = BASELINE_DIR, help = "Per-board baselines directory")
+    parser.add_argument("--tolerance", action = "store", type = float, default = 5.0,
+            help = "Allowed slowdown in percent before an API is reported as a regression")
+    parser.add_argument("--update-baseline", action = "store_true", help = "Overwrite the board's baseline")
 
     # Parse CMD args
     args = parser.parse_args()
+    if args.benchmark and args.script == parser.get_default("script"):
+        args.script = BENCHMARK_SCRIPT
 
     # init openmv
     if (args.port):
@@ -61,6 +134,11 @@ def main():
     # Set higher timeout after connecting.
     pyopenmv.set_timeout(0.500)
 
+    if args.benchmark:
+        lines = run_benchmark(script, 600)
+        pyopenmv.disconnect()
+        sys.exit(1 if check_benchmark(lines, args.baseline_dir, args.tolerance, args.update_baseline) else 0)
+
     # Enable/Disable framebuffer compression.
     print(">>>Enable FB JPEG compression %s" %(str(not args.disable_fb)))
     pyopenmv.enable_fb(not args.disable_fb)